@@ -3,6 +3,7 @@
 #include "../util/i18n.h"
 #include "../util/Random.h"
 #include "../util/Logger.h"
+#include "../util/MemoryUsage.h"
 #include "../util/AppInterface.h"
 #include "../util/SitRepEntry.h"
 #include "../universe/Building.h"
@@ -395,6 +396,39 @@ void Empire::UpdatePolicies() {
     PoliciesChangedSignal();
 }
 
+std::vector<std::pair<std::string, std::size_t>> Empire::ApproximateMemoryUsage() const {
+    using MemoryUsage::HeapBytes;
+
+    std::size_t policy_bytes = HeapBytes(m_policy_adoption_total_duration) + HeapBytes(m_available_policies);
+    for (const auto* adopted : {&m_adopted_policies, &m_initial_adopted_policies}) {
+        policy_bytes += adopted->size() *
+            (sizeof(std::pair<const std::string, PolicyAdoptionInfo>) + MemoryUsage::NODE_OVERHEAD);
+        for (const auto& [name, info] : *adopted)
+            policy_bytes += HeapBytes(name) + HeapBytes(info.category);
+    }
+
+    const std::size_t statistics_bytes =
+        HeapBytes(m_ship_names_used) + HeapBytes(m_species_ships_owned) + HeapBytes(m_ship_designs_owned) +
+        HeapBytes(m_ship_parts_owned) + HeapBytes(m_ship_part_class_owned) + HeapBytes(m_species_colonies_owned) +
+        HeapBytes(m_building_types_owned) + HeapBytes(m_ship_designs_in_production) +
+        HeapBytes(m_empire_ships_destroyed) + HeapBytes(m_ship_designs_destroyed) +
+        HeapBytes(m_species_ships_destroyed) + HeapBytes(m_species_planets_invaded) +
+        HeapBytes(m_species_ships_produced) + HeapBytes(m_ship_designs_produced) +
+        HeapBytes(m_species_ships_lost) + HeapBytes(m_ship_designs_lost) +
+        HeapBytes(m_species_ships_scrapped) + HeapBytes(m_ship_designs_scrapped) +
+        HeapBytes(m_species_planets_depoped) + HeapBytes(m_species_planets_bombed) +
+        HeapBytes(m_building_types_produced) + HeapBytes(m_building_types_scrapped);
+
+    return {
+        {"sitreps",         HeapBytes(m_sitrep_entries)},
+        {"policy history",  policy_bytes},
+        {"tech history",    HeapBytes(m_techs) + HeapBytes(m_newly_researched_techs) + HeapBytes(m_research_progress)},
+        {"statistics",      statistics_bytes},
+        {"supply",          HeapBytes(m_supply_system_ranges) + HeapBytes(m_supply_unobstructed_systems) +
+                            HeapBytes(m_preserved_system_exit_lanes) + HeapBytes(m_pending_system_exit_lanes)}
+    };
+}
+
 bool Empire::PolicyAdopted(const std::string& name) const
 { return m_adopted_policies.count(name); }
 
@@ -530,8 +564,8 @@ bool Empire::ResearchableTech(const std::string& name) const {
     const Tech* tech = GetTech(name);
     if (!tech)
         return false;
-    for (const auto& prereq : tech->Prerequisites()) {
-        if (!m_techs.count(prereq))
+    for (int prereq : tech->PrerequisiteIndices()) {
+        if (!TechResearched(prereq))
             return false;
     }
     return true;
@@ -543,8 +577,8 @@ bool Empire::HasResearchedPrereqAndUnresearchedPrereq(const std::string& name) c
         return false;
     bool one_unresearched = false;
     bool one_researched = false;
-    for (const auto& prereq : tech->Prerequisites()) {
-        if (m_techs.count(prereq))
+    for (int prereq : tech->PrerequisiteIndices()) {
+        if (TechResearched(prereq))
             one_researched = true;
         else
             one_unresearched = true;
@@ -572,6 +606,25 @@ const std::map<std::string, int>& Empire::ResearchedTechs() const
 bool Empire::TechResearched(const std::string& name) const
 { return m_techs.count(name); }
 
+bool Empire::TechResearched(int tech_index) const {
+    if (tech_index >= 0 && tech_index < static_cast<int>(m_researched_tech_indices.size()))
+        return m_researched_tech_indices.test(tech_index);
+    // techs loaded since m_researched_tech_indices was last updated
+    const Tech* tech = GetTechManager().GetTechByIndex(tech_index);
+    return tech && m_techs.count(tech->Name());
+}
+
+void Empire::UpdateResearchedTechIndices() {
+    const TechManager& tech_manager = GetTechManager();
+    m_researched_tech_indices.clear();
+    m_researched_tech_indices.resize(tech_manager.size());
+    for (const auto& name_turn : m_techs) {
+        const Tech* tech = tech_manager.GetTech(name_turn.first);
+        if (tech && tech->Index() >= 0 && tech->Index() < static_cast<int>(m_researched_tech_indices.size()))
+            m_researched_tech_indices.set(tech->Index());
+    }
+}
+
 TechStatus Empire::GetTechStatus(const std::string& name) const {
     if (TechResearched(name)) return TechStatus::TS_COMPLETE;
     if (ResearchableTech(name)) return TechStatus::TS_RESEARCHABLE;
@@ -892,6 +945,54 @@ bool Empire::ProducibleItem(const ProductionQueue::ProductionItem& item, int loc
     return false;
 }
 
+std::vector<int> Empire::ProducibleItemLocations(const ProductionQueue::ProductionItem& item,
+                                                 const ScriptingContext& context) const
+{
+    // the checks of ProducibleItem that don't depend on the location
+    const BuildingType* building_type = nullptr;
+    const ShipDesign* ship_design = nullptr;
+    if (item.build_type == BuildType::BT_BUILDING) {
+        building_type = GetBuildingType(item.name);
+        if (!BuildingTypeAvailable(item.name) || !building_type || !building_type->Producible())
+            return {};
+    } else if (item.build_type == BuildType::BT_SHIP) {
+        ship_design = context.ContextUniverse().GetShipDesign(item.design_id);
+        if (!ShipDesignAvailable(item.design_id) || !ship_design || !ship_design->Producible())
+            return {};
+    } else if (item.build_type != BuildType::BT_STOCKPILE) {
+        throw std::invalid_argument("Empire::ProducibleItemLocations was passed a ProductionItem with an invalid BuildType");
+    }
+
+    auto& cache = m_production_locations_cache;
+    const auto generation = context.ContextUniverse().MetersGeneration();
+    if (cache.turn != context.current_turn || cache.meters_generation != generation) {
+        cache.locations.clear();
+        cache.turn = context.current_turn;
+        cache.meters_generation = generation;
+    }
+    if (auto it = cache.locations.find(item); it != cache.locations.end())
+        return it->second;
+
+    // all planets owned by this empire are resource centres, so can produce
+    // stockpile projects
+    std::vector<std::shared_ptr<const UniverseObject>> candidates;
+    for (const auto& planet : context.ContextObjects().all<Planet>())
+        if (planet->OwnedBy(m_id))
+            candidates.push_back(planet);
+
+    if (building_type)
+        building_type->ProductionLocations(m_id, candidates, context);
+    else if (ship_design)
+        ship_design->ProductionLocations(m_id, candidates);
+
+    std::vector<int> retval;
+    retval.reserve(candidates.size());
+    for (const auto& candidate : candidates)
+        retval.push_back(candidate->ID());
+    std::sort(retval.begin(), retval.end());
+    return cache.locations.emplace(item, std::move(retval)).first->second;
+}
+
 bool Empire::EnqueuableItem(BuildType build_type, const std::string& name,
                             int location, const ScriptingContext& context) const
 {
@@ -1039,7 +1140,7 @@ void Empire::UpdateSystemSupplyRanges(const Universe& universe) {
     const ObjectMap& empire_known_objects = universe.EmpireKnownObjects(this->EmpireID());
 
     // get ids of objects partially or better visible to this empire.
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
+    const auto& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
 
     std::set<int> known_objects_set;
 
@@ -1050,26 +1151,49 @@ void Empire::UpdateSystemSupplyRanges(const Universe& universe) {
     UpdateSystemSupplyRanges(known_objects_set, empire_known_objects);
 }
 
-void Empire::UpdateUnobstructedFleets(ObjectMap& objects, const std::set<int>& known_destroyed_objects) {
-    for (const auto& system : objects.find<System>(m_supply_unobstructed_systems)) {
-        if (!system)
+void Empire::UpdateUnobstructedFleets(ObjectMap& objects, const ObjectIDBitmap& known_destroyed_objects) {
+    // one pass over all fleets, rather than looking up the fleets of each unobstructed system
+    for (auto& fleet : objects.all<Fleet>()) {
+        if (!fleet->OwnedBy(m_id) || known_destroyed_objects.count(fleet->ID()))
             continue;
+        const int system_id = fleet->SystemID();
+        if (system_id != INVALID_OBJECT_ID && m_supply_unobstructed_systems.count(system_id))
+            fleet->SetArrivalStarlane(system_id);
+    }
+}
 
-        for (auto& fleet : objects.find<Fleet>(system->FleetIDs())) {
-            if (known_destroyed_objects.count(fleet->ID()))
-                continue;
-            if (fleet->OwnedBy(m_id))
-                fleet->SetArrivalStarlane(system->ID());
-        }
+SupplyAffectingFleets::SupplyAffectingFleets(const ObjectMap& objects) {
+    for (auto& fleet : objects.all<::Fleet>()) {
+        int system_id = fleet->SystemID();
+        if (system_id == INVALID_OBJECT_ID)
+            continue;   // not in a system, so can't affect system obstruction
+
+        TraceLogger(supply) << "Fleet " << fleet->ID() << " is in system " << system_id
+                            << " with next system " << fleet->NextSystemID()
+                            << " and is owned by " << fleet->Owner()
+                            << " armed: " << fleet->HasArmedShips(objects)
+                            << " and obstructive: " << fleet->Obstructive();
+        if (fleet->NextSystemID() != INVALID_OBJECT_ID && fleet->NextSystemID() != system_id)
+            continue;   // trying to depart the system
+        if (!fleet->Obstructive() || !fleet->HasArmedShips(objects))
+            continue;
+
+        fleets.push_back({fleet->ID(), system_id, fleet->Owner(), fleet->MaxShipAgeInTurns(),
+                          fleet->ArrivalStarlane() == system_id});
     }
 }
 
-void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context, bool precombat /*=false*/) {
+void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context, bool precombat /*=false*/)
+{ UpdateSupplyUnobstructedSystems(context, SupplyAffectingFleets(context.ContextObjects()), precombat); }
+
+void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context, const SupplyAffectingFleets& fleets,
+                                             bool precombat)
+{
     const Universe& universe = context.ContextUniverse();
 
     // get ids of systems partially or better visible to this empire.
     // TODO: make a UniverseObjectVisitor for objects visible to an empire at a specified visibility or greater
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
+    const auto& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
 
     std::set<int> known_systems_set;
 
@@ -1077,11 +1201,12 @@ void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context, bo
     for (const auto& sys : universe.EmpireKnownObjects(this->EmpireID()).all<System>())
         if (!known_destroyed_objects.count(sys->ID()))
             known_systems_set.emplace(sys->ID());
-    UpdateSupplyUnobstructedSystems(context, known_systems_set, precombat);
+    UpdateSupplyUnobstructedSystems(context, known_systems_set, fleets, precombat);
 }
 
 void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context,
                                              const std::set<int>& known_systems,
+                                             const SupplyAffectingFleets& fleets,
                                              bool precombat)
 {
     TraceLogger(supply) << "UpdateSupplyUnobstructedSystems (allowing supply propagation) for empire " << m_id;
@@ -1098,13 +1223,6 @@ void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context,
     // get all fleets, or just those visible to this client's empire
     const auto& known_destroyed_objects = context.ContextUniverse().EmpireKnownDestroyedObjectIDs(this->EmpireID());
 
-    // get empire supply ranges
-    std::map<int, std::map<int, float>> empire_system_supply_ranges;
-    for (const auto& entry : context.Empires()) {
-        const auto& empire = entry.second;
-        empire_system_supply_ranges[entry.first] = empire->SystemSupplyRanges();
-    }
-
     // find systems that contain fleets that can either maintain supply or block supply.
     // to affect supply in either manner, a fleet must be armed & aggressive, & must be not
     // trying to depart the systme.  Qualifying enemy fleets will blockade if no friendly fleets
@@ -1120,46 +1238,34 @@ void Empire::UpdateSupplyUnobstructedSystems(const ScriptingContext& context,
     std::set<int> unrestricted_friendly_systems;
     std::set<int> systems_containing_obstructing_objects;
     std::set<int> unrestricted_obstruction_systems;
-    for (auto& fleet : context.ContextObjects().all<Fleet>()) {
-        int system_id = fleet->SystemID();
-        if (system_id == INVALID_OBJECT_ID) {
-            continue;   // not in a system, so can't affect system obstruction
-        } else if (known_destroyed_objects.count(fleet->ID())) {
+    for (const auto& fleet : fleets.fleets) {
+        const int system_id = fleet.system_id;
+        if (known_destroyed_objects.count(fleet.fleet_id))
             continue; //known to be destroyed so can't affect supply, important just in case being updated on client side
-        }
 
-        TraceLogger(supply) << "Fleet " << fleet->ID() << " is in system " << system_id
-                            << " with next system " << fleet->NextSystemID()
-                            << " and is owned by " << fleet->Owner()
-                            << " armed: " << fleet->HasArmedShips(context.ContextObjects())
-                            << " and obstructive: " << fleet->Obstructive();
-        if (fleet->HasArmedShips(context.ContextObjects()) && fleet->Obstructive()) {
-            if (fleet->OwnedBy(m_id)) {
-                if (fleet->NextSystemID() == INVALID_OBJECT_ID || fleet->NextSystemID() == fleet->SystemID()) {
-                    systems_containing_friendly_fleets.insert(system_id);
-                    if (fleet->ArrivalStarlane() == system_id)
-                        unrestricted_friendly_systems.emplace(system_id);
-                    else
-                        systems_with_lane_preserving_fleets.emplace(system_id);
-                }
-            } else if (fleet->NextSystemID() == INVALID_OBJECT_ID || fleet->NextSystemID() == fleet->SystemID()) {
-                int fleet_owner = fleet->Owner();
-                bool fleet_at_war = fleet_owner == ALL_EMPIRES ||
-                                    context.ContextDiploStatus(m_id, fleet_owner) == DiplomaticStatus::DIPLO_WAR;
-                // newly created ships are not allowed to block supply since they have not even potentially gone
-                // through a combat round at the present location.  Potential sources for such new ships are monsters
-                // created via Effect.  (Ships/fleets constructed by empires are currently created at a later stage of
-                // turn processing, but even if such were moved forward they should be similarly restricted.)  For
-                // checks after combat and prior to turn advancement, we check against age zero here.  For checks
-                // after turn advancement but prior to combat we check against age 1.  Because the
-                // fleets themselves may be created and/or destroyed purely as organizational matters, we check ship
-                // age not fleet age.
-                int cutoff_age = precombat ? 1 : 0;
-                if (fleet_at_war && fleet->MaxShipAgeInTurns() > cutoff_age) {
-                    systems_containing_obstructing_objects.emplace(system_id);
-                    if (fleet->ArrivalStarlane() == system_id)
-                        unrestricted_obstruction_systems.emplace(system_id);
-                }
+        if (fleet.owner == m_id) {
+            systems_containing_friendly_fleets.insert(system_id);
+            if (fleet.unrestricted)
+                unrestricted_friendly_systems.emplace(system_id);
+            else
+                systems_with_lane_preserving_fleets.emplace(system_id);
+        } else {
+            int fleet_owner = fleet.owner;
+            bool fleet_at_war = fleet_owner == ALL_EMPIRES ||
+                                context.ContextDiploStatus(m_id, fleet_owner) == DiplomaticStatus::DIPLO_WAR;
+            // newly created ships are not allowed to block supply since they have not even potentially gone
+            // through a combat round at the present location.  Potential sources for such new ships are monsters
+            // created via Effect.  (Ships/fleets constructed by empires are currently created at a later stage of
+            // turn processing, but even if such were moved forward they should be similarly restricted.)  For
+            // checks after combat and prior to turn advancement, we check against age zero here.  For checks
+            // after turn advancement but prior to combat we check against age 1.  Because the
+            // fleets themselves may be created and/or destroyed purely as organizational matters, we check ship
+            // age not fleet age.
+            int cutoff_age = precombat ? 1 : 0;
+            if (fleet_at_war && fleet.max_ship_age > cutoff_age) {
+                systems_containing_obstructing_objects.emplace(system_id);
+                if (fleet.unrestricted)
+                    unrestricted_obstruction_systems.emplace(system_id);
             }
         }
     }
@@ -1285,7 +1391,7 @@ const std::map<int, std::set<int>> Empire::KnownStarlanes() const {
     const Universe& universe = GetUniverse();
     TraceLogger(supply) << "Empire::KnownStarlanes for empire " << m_id;
 
-    const std::set<int>& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
+    const auto& known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(this->EmpireID());
     for (const auto& sys : Objects().all<System>())
     {
         int start_id = sys->ID();
@@ -1737,6 +1843,7 @@ void Empire::ApplyNewTechs() {
         }
     }
     m_newly_researched_techs.clear();
+    UpdateResearchedTechIndices();
 }
 
 void Empire::AddPolicy(const std::string& name) {
@@ -1905,8 +2012,10 @@ void Empire::AddSitRepEntry(const SitRepEntry& entry)
 void Empire::AddSitRepEntry(SitRepEntry&& entry)
 { m_sitrep_entries.push_back(std::move(entry)); }
 
-void Empire::RemoveTech(const std::string& name)
-{ m_techs.erase(name); }
+void Empire::RemoveTech(const std::string& name) {
+    m_techs.erase(name);
+    UpdateResearchedTechIndices();
+}
 
 void Empire::RemovePolicy(const std::string& name)
 { m_available_policies.erase(name); }
@@ -2329,6 +2438,9 @@ void Empire::CheckProductionProgress(ScriptingContext& context) {
 
             std::shared_ptr<Ship> ship;
 
+            // each ship is created with at most one new fleet
+            context.ContextUniverse().ReserveObjectIDs(2 * static_cast<std::size_t>(std::max(0, elem.blocksize)));
+
             for (int count = 0; count < elem.blocksize; count++) {
                 // create ship
                 ship = context.ContextUniverse().InsertNew<Ship>(m_id, elem.item.design_id, species_name, m_id);
@@ -2561,16 +2673,15 @@ void Empire::InitResourcePools(const ObjectMap& objects) {
 
 
     // inform the blockadeable resource pools about systems that can share
-    m_resource_pools[ResourceType::RE_INDUSTRY]->SetConnectedSupplyGroups(GetSupplyManager().ResourceSupplyGroups(m_id));
+    m_resource_pools[ResourceType::RE_INDUSTRY]->SetConnectedSupplyGroups(GetSupplyManager().ResourceSupplyGroupIDs(m_id));
 
     // set non-blockadeable resource pools to share resources between all systems
-    std::set<std::set<int>> sets_set;
-    std::set<int> all_systems_set;
+    boost::container::flat_map<int, int> all_systems_group;
+    all_systems_group.reserve(objects.ExistingSystems().size());
     for (const auto& entry : objects.ExistingSystems())
-        all_systems_set.insert(entry.first);
-    sets_set.insert(all_systems_set);
-    m_resource_pools[ResourceType::RE_RESEARCH]->SetConnectedSupplyGroups(sets_set);
-    m_resource_pools[ResourceType::RE_INFLUENCE]->SetConnectedSupplyGroups(sets_set);
+        all_systems_group.emplace_hint(all_systems_group.end(), entry.first, 0);
+    m_resource_pools[ResourceType::RE_RESEARCH]->SetConnectedSupplyGroups(all_systems_group);
+    m_resource_pools[ResourceType::RE_INFLUENCE]->SetConnectedSupplyGroups(std::move(all_systems_group));
 }
 
 void Empire::UpdateResourcePools() {
@@ -2597,6 +2708,15 @@ void Empire::UpdateProductionQueue() {
     m_resource_pools[ResourceType::RE_INDUSTRY]->ChangedSignal();
 }
 
+void Empire::SetAsyncProductionProjection(bool async)
+{ m_production_queue.SetAsyncProjection(async); }
+
+void Empire::SetProductionProjectionLimits(int max_turns, std::chrono::milliseconds max_time)
+{ m_production_queue.SetProjectionLimits(max_turns, max_time); }
+
+bool Empire::ApplyFinishedProductionProjection()
+{ return m_production_queue.ApplyFinishedProjection(); }
+
 void Empire::UpdateInfluenceSpending() {
     m_resource_pools[ResourceType::RE_INFLUENCE]->Update(); // recalculate total influence production
     m_influence_queue.Update();
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <string>
+#include <boost/dynamic_bitset.hpp>
 #include "InfluenceQueue.h"
 #include "PopulationPool.h"
 #include "ProductionQueue.h"
@@ -19,6 +20,8 @@ struct UnlockableItem;
 class ShipDesign;
 class SitRepEntry;
 class ResourcePool;
+class ObjectMap;
+class ObjectIDBitmap;
 
 FO_COMMON_API extern const int INVALID_DESIGN_ID;
 FO_COMMON_API extern const int INVALID_GAME_TURN;
@@ -28,6 +31,24 @@ FO_COMMON_API extern const int ALL_EMPIRES;
 
 typedef std::array<unsigned char, 4> EmpireColor;
 
+/** The fleets that can maintain or obstruct supply in the systems they are
+  * in: armed, obstructive fleets that are in a system and not trying to leave
+  * it.  Finding these requires looking at the ships of every fleet, so is done
+  * once and shared by the supply obstruction updates of all empires. */
+struct FO_COMMON_API SupplyAffectingFleets {
+    struct Fleet {
+        int     fleet_id = INVALID_OBJECT_ID;
+        int     system_id = INVALID_OBJECT_ID;
+        int     owner = ALL_EMPIRES;
+        int     max_ship_age = 0;
+        bool    unrestricted = false;   ///< whether the fleet arrived before any blockade, so has unrestricted lane access
+    };
+
+    explicit SupplyAffectingFleets(const ObjectMap& objects);
+
+    std::vector<Fleet> fleets;
+};
+
 
 //! Research status of techs, relating to whether they have been or can be
 //! researched
@@ -79,6 +100,11 @@ public:
 
     std::string         Dump() const;
 
+    /** Returns the approximate number of bytes of memory used by the sitreps,
+      * histories, statistics counters and supply state of this empire, by name
+      * of each. */
+    std::vector<std::pair<std::string, std::size_t>> ApproximateMemoryUsage() const;
+
     bool                            PolicyAdopted(const std::string& name) const;
     int                             TurnPolicyAdopted(const std::string& name) const;
     int                             SlotPolicyAdoptedIn(const std::string& name) const;
@@ -104,6 +130,11 @@ public:
       * which they were researched. */
     const std::map<std::string, int>&   ResearchedTechs() const;
 
+    /** Returns the researched techs as a set of bits indexed by Tech::Index().
+      * May be shorter than GetTechManager().size() if techs were loaded after
+      * this empire's researched techs were last changed. */
+    const boost::dynamic_bitset<>&      ResearchedTechIndices() const { return m_researched_tech_indices; }
+
     /** Returns the set of BuildingType names availble to this empire. */
     const std::set<std::string>&    AvailableBuildingTypes() const;
 
@@ -137,6 +168,7 @@ public:
     bool        ResearchableTech(const std::string& name) const;        ///< Returns true iff \a name is a tech that has not been researched, and has no unresearched prerequisites.
     float       ResearchProgress(const std::string& name) const;        ///< Returns the RPs spent towards tech \a name if it has partial research progress, or 0.0 if it is already researched.
     bool        TechResearched(const std::string& name) const;          ///< Returns true iff this tech has been completely researched.
+    bool        TechResearched(int tech_index) const;                   ///< Returns true iff the tech whose Tech::Index() is \a tech_index has been completely researched.
     bool        HasResearchedPrereqAndUnresearchedPrereq(const std::string& name) const;    ///< Returns true iff this tech has some but not all prerequisites researched
     TechStatus  GetTechStatus(const std::string& name) const;           ///< Returns the status (researchable, researched, unresearchable) for this tech for this
 
@@ -159,6 +191,14 @@ public:
     bool                    ProducibleItem(const ProductionQueue::ProductionItem& item, int location,
                                            const ScriptingContext& context = ScriptingContext{}) const;
 
+    /** Returns the ids of the planets owned by this empire at which it can
+      * produce \a item.  Rather than evaluating the item's location conditions
+      * for each planet, as ProducibleItem does, each is evaluated once for all
+      * the planets.  The results are kept until the turn changes or meters
+      * are updated. */
+    std::vector<int>        ProducibleItemLocations(const ProductionQueue::ProductionItem& item,
+                                                    const ScriptingContext& context = ScriptingContext{}) const;
+
     /** Return true iff this empire can enqueue the specified item at the specified location. */
     bool                    EnqueuableItem(BuildType build_type, const std::string& name, int location,
                                            const ScriptingContext& context = ScriptingContext{}) const;
@@ -325,16 +365,19 @@ public:
     /** Calculates ranges that systems can send fleet and resource supplies. */
     void UpdateSystemSupplyRanges(const Universe& universe = GetUniverse());
     /** Calculates systems that can propagate supply (fleet or resource) using
-      * the specified set of \a known_systems */
+      * the specified set of \a known_systems and the supply-affecting
+      * \a fleets in the universe of \a context */
     void UpdateSupplyUnobstructedSystems(const ScriptingContext& context, const std::set<int>& known_systems,
-                                         bool precombat = false);
+                                         const SupplyAffectingFleets& fleets, bool precombat = false);
     /** Calculates systems that can propagate supply using this empire's own /
       * internal list of explored systems. */
+    void UpdateSupplyUnobstructedSystems(const ScriptingContext& context, const SupplyAffectingFleets& fleets,
+                                         bool precombat = false);
     void UpdateSupplyUnobstructedSystems(const ScriptingContext& context, bool precombat = false);
     /** Updates fleet ArrivalStarlane to flag fleets of this empire that are not
       * blockaded post-combat must be done after *all* noneliminated empires
       * have updated their unobstructed systems */
-    void UpdateUnobstructedFleets(ObjectMap& objects, const std::set<int>& known_destroyed_objects);
+    void UpdateUnobstructedFleets(ObjectMap& objects, const ObjectIDBitmap& known_destroyed_objects);
     /** Records, in a list of pending updates, the start_system exit lane to the
       * specified destination as accessible to this empire*/
     void RecordPendingLaneUpdate(int start_system_id, int dest_system_id);
@@ -384,6 +427,16 @@ public:
     /** Calls Update() on empire's production queue, which recalculates the PPs
       * spent on and number of turns left for each project in the queue. */
     void UpdateProductionQueue();
+    /** Sets whether UpdateProductionQueue() projects the turns left for each
+      * project on another thread, so that it returns sooner. */
+    void SetAsyncProductionProjection(bool async);
+    /** Sets how many future turns, and how much time, UpdateProductionQueue()
+      * at most spends projecting the turns left for each project. */
+    void SetProductionProjectionLimits(int max_turns, std::chrono::milliseconds max_time);
+    /** If the production queue has finished projecting the turns left for
+      * each project on another thread, applies the projection and returns
+      * true. */
+    bool ApplyFinishedProductionProjection();
     /** Eventually: Calls appropriate subsystem Update to calculate influence
       * spent on social projects and maintenance of buildings.  Later call to
       * CheckInfluenceProgress() will then have the correct allocations of
@@ -490,6 +543,9 @@ public:
 private:
     void Init();
 
+    /** Sets m_researched_tech_indices from m_techs. */
+    void UpdateResearchedTechIndices();
+
     int         m_id = ALL_EMPIRES;         ///< Empire's unique numeric id
     std::string m_name;                     ///< Empire's name
     std::string m_player_name;              ///< Empire's Player's name
@@ -536,6 +592,7 @@ private:
 
     std::set<std::string>           m_newly_researched_techs;   ///< names of researched but not yet effective technologies, and turns on which they were acquired.
     std::map<std::string, int>      m_techs;                    ///< names of researched technologies, and turns on which they were acquired.
+    boost::dynamic_bitset<>         m_researched_tech_indices;  ///< Tech::Index() of each tech in m_techs, kept in step with it by UpdateResearchedTechIndices()
     std::map<std::string, Meter>    m_meters;                   ///< empire meters, including ratings scales used by species to judge empires
 
     ResearchQueue                   m_research_queue;           ///< the queue of techs being or waiting to be researched
@@ -601,6 +658,15 @@ private:
     bool                            m_ready = false;                ///< readiness status of empire
     int                             m_auto_turn_count = 0;          ///< auto-turn counter value
 
+    /** Results of ProducibleItemLocations, for one turn and generation of
+        meters. */
+    struct ProductionLocationsCache {
+        int         turn = INVALID_GAME_TURN;
+        std::size_t meters_generation = 0;
+        std::map<ProductionQueue::ProductionItem, std::vector<int>> locations;
+    };
+    mutable ProductionLocationsCache m_production_locations_cache;
+
     friend class boost::serialization::access;
     Empire();
     template <typename Archive>
@@ -23,6 +23,7 @@ EmpireManager& EmpireManager::operator=(EmpireManager&& other) noexcept {
         m_const_empire_map = std::move(other.m_const_empire_map);
         m_empire_diplomatic_statuses = std::move(other.m_empire_diplomatic_statuses);
         m_diplomatic_messages = std::move(other.m_diplomatic_messages);
+        UpdateDiplomaticStatusMatrix();
     }
     return *this;
 }
@@ -152,6 +153,7 @@ void EmpireManager::Clear() {
     m_const_empire_map.clear();
     m_empire_map.clear();
     m_empire_diplomatic_statuses.clear();
+    UpdateDiplomaticStatusMatrix();
 }
 
 const EmpireManager::DiploStatusMap& EmpireManager::GetDiplomaticStatuses() const
@@ -161,9 +163,15 @@ DiplomaticStatus EmpireManager::GetDiplomaticStatus(int empire1, int empire2) co
     if (empire1 == ALL_EMPIRES || empire2 == ALL_EMPIRES || empire1 == empire2)
         return DiplomaticStatus::INVALID_DIPLOMATIC_STATUS;
 
-    auto it = m_empire_diplomatic_statuses.find(DiploKey(empire1, empire2));
-    if (it != m_empire_diplomatic_statuses.end())
-        return it->second;
+    if (empire1 >= 0 && empire2 >= 0 && empire1 < m_diplo_matrix_size && empire2 < m_diplo_matrix_size) {
+        auto status = m_diplo_status_matrix[empire1 * m_diplo_matrix_size + empire2];
+        if (status != DiplomaticStatus::INVALID_DIPLOMATIC_STATUS)
+            return status;
+    } else {
+        auto it = m_empire_diplomatic_statuses.find(DiploKey(empire1, empire2));
+        if (it != m_empire_diplomatic_statuses.end())
+            return it->second;
+    }
     ErrorLogger() << "Couldn't find diplomatic status between empires " << empire1 << " and " << empire2;
     return DiplomaticStatus::INVALID_DIPLOMATIC_STATUS;
 }
@@ -205,6 +213,7 @@ void EmpireManager::SetDiplomaticStatus(int empire1, int empire2, DiplomaticStat
     DiplomaticStatus initial_status = GetDiplomaticStatus(empire1, empire2);
     if (status != initial_status) {
         m_empire_diplomatic_statuses[DiploKey(empire1, empire2)] = status;
+        UpdateDiplomaticStatusMatrix();
         DiplomaticStatusChangedSignal(empire1, empire2);
     }
 }
@@ -355,6 +364,24 @@ void EmpireManager::ResetDiplomacy() {
             m_empire_diplomatic_statuses[diplo_key] = DiplomaticStatus::DIPLO_WAR;
         }
     }
+    UpdateDiplomaticStatusMatrix();
+}
+
+void EmpireManager::UpdateDiplomaticStatusMatrix() {
+    int max_id = -1;
+    for (const auto& [ids, status] : m_empire_diplomatic_statuses)
+        if (ids.first <= MAX_DIPLO_MATRIX_EMPIRE_ID) // DiploKey puts the larger ID first
+            max_id = std::max(max_id, ids.first);
+
+    m_diplo_matrix_size = max_id + 1;
+    m_diplo_status_matrix.assign(m_diplo_matrix_size * m_diplo_matrix_size,
+                                 DiplomaticStatus::INVALID_DIPLOMATIC_STATUS);
+    for (const auto& [ids, status] : m_empire_diplomatic_statuses) {
+        if (ids.first > MAX_DIPLO_MATRIX_EMPIRE_ID || ids.second < 0)
+            continue;
+        m_diplo_status_matrix[ids.first * m_diplo_matrix_size + ids.second] = status;
+        m_diplo_status_matrix[ids.second * m_diplo_matrix_size + ids.first] = status;
+    }
 }
 
 void EmpireManager::GetDiplomaticMessagesToSerialize(std::map<std::pair<int, int>, DiplomaticMessage>& messages,
@@ -88,9 +88,24 @@ private:
     void GetDiplomaticMessagesToSerialize(std::map<std::pair<int, int>, DiplomaticMessage>& messages,
                                           int encoding_empire) const;
 
+    /** Sets m_diplo_status_matrix from m_empire_diplomatic_statuses. */
+    void UpdateDiplomaticStatusMatrix();
+
+    /** Empire IDs up to this have their statuses in m_diplo_status_matrix.
+        Empire IDs are handed out consecutively, so this is only exceeded in
+        unusual setups, whose statuses are then looked up in the map. */
+    static constexpr int MAX_DIPLO_MATRIX_EMPIRE_ID = 255;
+
     container_type                                   m_empire_map;
     const_container_type                             m_const_empire_map;
     DiploStatusMap                                   m_empire_diplomatic_statuses;
+
+    /** Copy of m_empire_diplomatic_statuses as a square matrix indexed by
+        both empires' IDs, in both orders, with INVALID_DIPLOMATIC_STATUS for
+        pairs that have no status.  Diplomatic statuses are looked up for
+        many pairs of objects' owners, so this saves a map search each time. */
+    std::vector<DiplomaticStatus>                    m_diplo_status_matrix;
+    int                                              m_diplo_matrix_size = 0;
     std::map<std::pair<int, int>, DiplomaticMessage> m_diplomatic_messages;
 
     friend class ClientApp;
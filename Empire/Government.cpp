@@ -16,6 +16,8 @@
 #include <boost/filesystem/fstream.hpp>
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_POLICIES{"RULE_CHEAP_POLICIES"};
+
     #define UserStringNop(key) key
 
     void AddRules(GameRules& rules) {
@@ -100,7 +102,7 @@ std::string Policy::Dump(unsigned short ntabs) const {
 float Policy::AdoptionCost(int empire_id, const ObjectMap& objects) const {
     const auto arbitrary_large_number = 999999.9f;
 
-    if (GetGameRules().Get<bool>("RULE_CHEAP_POLICIES") || !m_adoption_cost) {
+    if (RULE_CHEAP_POLICIES.Get() || !m_adoption_cost) {
         return 1.0;
 
     } else if (m_adoption_cost->ConstantExpr()) {
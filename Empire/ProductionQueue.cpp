@@ -14,12 +14,20 @@
 #include "../util/ScopedTimer.h"
 #include "../util/i18n.h"
 
-#include <boost/range/numeric.hpp>
-#include <boost/range/adaptor/map.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <tuple>
 #include <boost/uuid/uuid_io.hpp>
 
 
 namespace {
+    const RuleHandle<double> RULE_PRODUCTION_QUEUE_FRONTLOAD_FACTOR{"RULE_PRODUCTION_QUEUE_FRONTLOAD_FACTOR"};
+    const RuleHandle<double> RULE_PRODUCTION_QUEUE_TOPPING_UP_FACTOR{"RULE_PRODUCTION_QUEUE_TOPPING_UP_FACTOR"};
+    const RuleHandle<bool> RULE_STOCKPILE_IMPORT_LIMITED{"RULE_STOCKPILE_IMPORT_LIMITED"};
+
     const float EPSILON = 0.001f;
 
     void AddRules(GameRules& rules) {
@@ -72,13 +80,38 @@ namespace {
     // less than expected because of interactions with the ProductionQueue
     // Epsilon value (0.01)
 
+    /** The game rules that affect the allocation of PP to queue elements,
+      * looked up once per update rather than for every element of every
+      * simulated turn, and so that the simulation doesn't need to access the
+      * rules from another thread. */
+    struct ProductionRules {
+        static ProductionRules Current() {
+            ProductionRules retval;
+            retval.frontload_limit_factor = RULE_PRODUCTION_QUEUE_FRONTLOAD_FACTOR.Get() * 0.01;
+            // any allowed topping up is limited by how much frontloading was allowed
+            retval.topping_up_limit_factor =
+                std::max(0.0, RULE_PRODUCTION_QUEUE_TOPPING_UP_FACTOR.Get() * 0.01 - retval.frontload_limit_factor);
+            retval.stockpile_import_limited = RULE_STOCKPILE_IMPORT_LIMITED.Get();
+            return retval;
+        }
+
+        bool operator==(const ProductionRules& rhs) const {
+            return frontload_limit_factor == rhs.frontload_limit_factor &&
+                topping_up_limit_factor == rhs.topping_up_limit_factor &&
+                stockpile_import_limited == rhs.stockpile_import_limited;
+        }
+
+        float frontload_limit_factor = 0.0f;
+        float topping_up_limit_factor = 0.0f;
+        bool  stockpile_import_limited = false;
+    };
+
     float CalculateProductionPerTurnLimit(const ProductionQueue::Element& queue_element,
-                                          float item_cost, int build_turns)
+                                          float item_cost, int build_turns,
+                                          const ProductionRules& rules)
     {
-        const float frontload_limit_factor = GetGameRules().Get<double>("RULE_PRODUCTION_QUEUE_FRONTLOAD_FACTOR") * 0.01;
-        // any allowed topping up is limited by how much frontloading was allowed
-        const float topping_up_limit_factor =
-            std::max(0.0, GetGameRules().Get<double>("RULE_PRODUCTION_QUEUE_TOPPING_UP_FACTOR") * 0.01 - frontload_limit_factor);
+        const float frontload_limit_factor = rules.frontload_limit_factor;
+        const float topping_up_limit_factor = rules.topping_up_limit_factor;
 
         item_cost *= queue_element.blocksize;
         build_turns = std::max(build_turns, 1);
@@ -107,26 +140,109 @@ namespace {
         return retval;
     }
 
+    /** Amounts of PP for resource sharing groups of objects, indexed by the
+      * position of the group in ResourceGroups::groups.  Groups that no PP
+      * has been added for are distinguished from those that have had 0 added,
+      * as they would be by a map from group to amount. */
+    struct GroupAmounts {
+        explicit GroupAmounts(std::size_t num_groups = 0) :
+            amounts(num_groups, 0.0f),
+            present(num_groups, false)
+        {}
+
+        void Clear() {
+            std::fill(amounts.begin(), amounts.end(), 0.0f);
+            std::fill(present.begin(), present.end(), false);
+        }
+
+        void Add(std::size_t group, float amount) {
+            amounts[group] += amount;
+            present[group] = true;
+        }
+
+        float Get(std::size_t group) const
+        { return present[group] ? amounts[group] : 0.0f; }
+
+        float Sum() const
+        { return std::accumulate(amounts.begin(), amounts.end(), 0.0f); }
+
+        std::map<std::set<int>, float> ToMap(const std::vector<std::vector<int>>& groups) const {
+            std::map<std::set<int>, float> retval;
+            for (std::size_t group = 0; group < amounts.size(); ++group)
+                if (present[group])
+                    retval.emplace_hint(retval.end(), std::set<int>(groups[group].begin(), groups[group].end()),
+                                        amounts[group]);
+            return retval;
+        }
+
+        std::vector<float>  amounts;
+        std::vector<bool>   present;
+    };
+
+    /** The resource sharing groups of objects that PP are available in,
+      * numbered as the industry resource pool's groups are, after the empty
+      * group, so that amounts can be stored in vectors rather than in maps
+      * keyed by the groups themselves.  Queue elements whose locations aren't
+      * in any group are given the empty group, which no PP are available in. */
+    struct ResourceGroups {
+        ResourceGroups() = default;
+        explicit ResourceGroups(const ResourcePool* industry_pool) {
+            const auto num_groups = 1 + (industry_pool ? industry_pool->ObjectGroups().size() : 0u);
+            groups.reserve(num_groups);
+            available_pp.reserve(num_groups);
+            has_available_pp.reserve(num_groups);
+            groups.emplace_back();
+            available_pp.push_back(0.0f);
+            has_available_pp.push_back(false);
+            if (!industry_pool) {
+                ErrorLogger() << "ProductionQueue::Update passed invalid industry resource pool";
+                return;
+            }
+            pool = industry_pool;
+            for (const auto& group : industry_pool->ObjectGroups()) {
+                groups.push_back(group.object_ids);
+                available_pp.push_back(group.output);
+                has_available_pp.push_back(true);
+            }
+        }
+
+        /** Returns the number of the group containing the object with id
+          * \a location_id, or of the empty group if no group does.  Only
+          * valid while the pool this was made from is unchanged. */
+        std::size_t GroupOf(int location_id) const {
+            const int pool_group = pool ? pool->ObjectGroupIndex(location_id) : -1;
+            return pool_group < 0 ? EmptyGroup() : static_cast<std::size_t>(pool_group) + 1;
+        }
+
+        std::size_t EmptyGroup() const
+        { return 0; }   // the empty set is ordered before any other set
+
+        bool operator==(const ResourceGroups& rhs) const {
+            return groups == rhs.groups && available_pp == rhs.available_pp &&
+                has_available_pp == rhs.has_available_pp;
+        }
+
+        std::vector<std::vector<int>>   groups;             ///< object ids of each group, in increasing order
+        std::vector<float>              available_pp;
+        std::vector<bool>               has_available_pp;   ///< false for the empty group
+        const ResourcePool*             pool = nullptr;     ///< not compared, and not used by projections on other threads
+    };
+
     float CalculateNewStockpile(int empire_id, float starting_stockpile, float project_transfer_to_stockpile,
-                                const std::map<std::set<int>, float>& available_pp,
-                                const std::map<std::set<int>, float>& allocated_pp,
-                                const std::map<std::set<int>, float>& allocated_stockpile_pp)
+                                float stockpile_limit, const ProductionRules& rules,
+                                const ResourceGroups& groups,
+                                const GroupAmounts& allocated_pp,
+                                const GroupAmounts& allocated_stockpile_pp)
     {
         TraceLogger() << "CalculateNewStockpile for empire " << empire_id;
-        const Empire* empire = GetEmpire(empire_id);
-        if (!empire) {
-            ErrorLogger() << "CalculateStockpileContribution() passed null empire.  doing nothing.";
-            return 0.0f;
-        }
-        float stockpile_limit = empire->GetProductionQueue().StockpileCapacity();
-        float stockpile_used = boost::accumulate(allocated_stockpile_pp | boost::adaptors::map_values, 0.0f);
+        float stockpile_used = allocated_stockpile_pp.Sum();
         TraceLogger() << " ... stockpile limit: " << stockpile_limit << "  used: " << stockpile_used << "   starting: " << starting_stockpile;
         float new_contributions = 0.0f;
-        for (auto const& available_group : available_pp) {
-            auto alloc_it = allocated_pp.find(available_group.first);
-            float allocated_here = (alloc_it == allocated_pp.end())
-                ? 0.0f : alloc_it->second;
-            float excess_here = available_group.second - allocated_here;
+        for (std::size_t group = 0; group < groups.groups.size(); ++group) {
+            if (!groups.has_available_pp[group])
+                continue;
+            float allocated_here = allocated_pp.Get(group);
+            float excess_here = groups.available_pp[group] - allocated_here;
             if (excess_here < EPSILON)
                 continue;
             // Transfer excess to stockpile
@@ -137,7 +253,7 @@ namespace {
         }
 
         if ((new_contributions + project_transfer_to_stockpile) > stockpile_limit &&
-            GetGameRules().Get<bool>("RULE_STOCKPILE_IMPORT_LIMITED"))
+            rules.stockpile_import_limited)
         { new_contributions = stockpile_limit - project_transfer_to_stockpile; }
 
         return starting_stockpile + new_contributions + project_transfer_to_stockpile - stockpile_used;
@@ -155,15 +271,14 @@ namespace {
       * Returns the amount of PP which gets transferred to the stockpile using 
       * stockpile project build items. */
     float SetProdQueueElementSpending(
-        std::map<std::set<int>, float> available_pp, float available_stockpile, 
-        float stockpile_limit,
-        const std::vector<std::set<int>>& queue_element_resource_sharing_object_groups,
-        const std::map<std::pair<ProductionQueue::ProductionItem, int>,
-                       std::pair<float, int>>& queue_item_costs_and_times,
+        std::vector<float> available_pp, float available_stockpile,
+        float stockpile_limit, const ProductionRules& rules,
+        const std::vector<std::size_t>& queue_element_resource_sharing_object_groups,
+        const std::vector<std::pair<float, int>>& queue_element_costs_and_times,
         const std::vector<bool>& is_producible,
         ProductionQueue::QueueType& queue,
-        std::map<std::set<int>, float>& allocated_pp,
-        std::map<std::set<int>, float>& allocated_stockpile_pp,
+        GroupAmounts& allocated_pp,
+        GroupAmounts& allocated_stockpile_pp,
         int& projects_in_progress, bool simulating)
     {
         //DebugLogger() << "========SetProdQueueElementSpending========";
@@ -185,9 +300,8 @@ namespace {
         // DebugLogger() << "SetProdQueueElementSpending topping up factor " << topping_up_limit_factor;
 
         projects_in_progress = 0;
-        allocated_pp.clear();
-        allocated_stockpile_pp.clear();
-        float dummy_pp_source = 0.0f;
+        allocated_pp.Clear();
+        allocated_stockpile_pp.Clear();
         float stockpile_transfer = 0.0f;
         //DebugLogger() << "queue size: " << queue.size();
         int i = 0;
@@ -202,10 +316,8 @@ namespace {
             }
 
             // get resource sharing group and amount of resource available to build this item
-            const auto& group = queue_element_resource_sharing_object_groups[i];
-            auto available_pp_it = available_pp.find(group);
-            float& group_pp_available = (available_pp_it != available_pp.end()) ?
-                                        available_pp_it->second : dummy_pp_source;
+            const auto group = queue_element_resource_sharing_object_groups[i];
+            float& group_pp_available = available_pp[group];
 
             if ((group_pp_available <= 0) &&
                 (available_stockpile <= 0 || !queue_element.allowed_imperial_stockpile_use))
@@ -231,22 +343,11 @@ namespace {
             }
 
             // get max contribution per turn and turns to build at max contribution rate
-            int location_id = (queue_element.item.CostIsProductionLocationInvariant() ?
-                INVALID_OBJECT_ID : queue_element.location);
-            std::pair<ProductionQueue::ProductionItem, int> key(queue_element.item, location_id);
-            float item_cost = 1e6;  // dummy/default value, shouldn't ever really be needed
-            int build_turns = 1;    // dummy/default value, shouldn't ever really be needed
-            auto time_cost_it = queue_item_costs_and_times.find(key);
-            if (time_cost_it != queue_item_costs_and_times.end()) {
-                item_cost = time_cost_it->second.first;
-                build_turns = time_cost_it->second.second;
-            } else {
-                ErrorLogger() << "item: " << queue_element.item.name
-                              << "  somehow failed time cost lookup for location " << location_id;
-            }
+            float item_cost = queue_element_costs_and_times[i].first;
+            int build_turns = queue_element_costs_and_times[i].second;
             //DebugLogger() << "item " << queue_element.item.name << " costs " << item_cost << " for " << build_turns << " turns";
 
-            float element_this_turn_limit = CalculateProductionPerTurnLimit(queue_element, item_cost, build_turns);
+            float element_this_turn_limit = CalculateProductionPerTurnLimit(queue_element, item_cost, build_turns, rules);
 
             // determine how many pp to allocate to this queue element block this turn.  allocation is limited by the
             // item cost, which is the max number of PP per turn that can be put towards this item, and by the
@@ -261,7 +362,7 @@ namespace {
                          group_pp_available + stockpile_available_for_this));
 
             if (queue_element.item.build_type == BuildType::BT_STOCKPILE) {
-                if (GetGameRules().Get<bool>("RULE_STOCKPILE_IMPORT_LIMITED")) {
+                if (rules.stockpile_import_limited) {
                     float unused_limit = std::max(0.0f, stockpile_limit - stockpile_transfer);
                     allocation = std::min(allocation, unused_limit);
                 }
@@ -278,7 +379,7 @@ namespace {
             // record allocation from group
             float group_drawdown = std::min(allocation, group_pp_available);
 
-            allocated_pp[group] += group_drawdown;  // relies on default initial mapped value of 0.0f
+            allocated_pp.Add(group, group_drawdown);
             if (queue_element.item.build_type == BuildType::BT_STOCKPILE) {
                 stockpile_transfer += group_drawdown;
             }
@@ -297,7 +398,7 @@ namespace {
             // and dividing by a very very small stockpile_conversion_rate
             stockpile_drawdown = std::min(stockpile_drawdown, available_stockpile);
             if (stockpile_drawdown > 0) {
-                allocated_stockpile_pp[group] += stockpile_drawdown;
+                allocated_stockpile_pp.Add(group, stockpile_drawdown);
                 available_stockpile -= stockpile_drawdown;
             }
 
@@ -317,8 +418,170 @@ namespace {
         }
         return stockpile_transfer;
     }
+
+    /** Returns true iff \a lhs and \a rhs are the same element, and would be
+      * allocated the same PP in each simulated turn if their costs and the PP
+      * available to them are the same. */
+    bool SameProjectionState(const ProductionQueue::Element& lhs, const ProductionQueue::Element& rhs) {
+        return lhs.uuid == rhs.uuid &&
+            lhs.item.build_type == rhs.item.build_type &&
+            lhs.item.name == rhs.item.name &&
+            lhs.item.design_id == rhs.item.design_id &&
+            lhs.location == rhs.location &&
+            lhs.blocksize == rhs.blocksize &&
+            lhs.remaining == rhs.remaining &&
+            lhs.progress == rhs.progress &&
+            lhs.paused == rhs.paused &&
+            lhs.allowed_imperial_stockpile_use == rhs.allowed_imperial_stockpile_use;
+    }
+
+    /** Everything that a projection of future turns of production is
+      * determined from.  None of it refers to the universe or game rules, so
+      * a projection can be made on another thread. */
+    struct ProjectionInputs {
+        bool operator==(const ProjectionInputs& rhs) const {
+            return empire_id == rhs.empire_id &&
+                max_turns == rhs.max_turns &&
+                queue_uuids == rhs.queue_uuids &&
+                original_indices == rhs.original_indices &&
+                element_groups == rhs.element_groups &&
+                costs_and_times == rhs.costs_and_times &&
+                groups == rhs.groups &&
+                pp_in_stockpile == rhs.pp_in_stockpile &&
+                available_stockpile == rhs.available_stockpile &&
+                stockpile_limit == rhs.stockpile_limit &&
+                rules == rhs.rules &&
+                std::equal(queue.begin(), queue.end(), rhs.queue.begin(), rhs.queue.end(), SameProjectionState);
+        }
+
+        int                                 empire_id = ALL_EMPIRES;
+        std::vector<boost::uuids::uuid>     queue_uuids;        ///< of all elements of the queue, in order
+        ProductionQueue::QueueType          queue;              ///< elements to simulate: those that aren't paused and are producible
+        std::vector<unsigned int>           original_indices;   ///< index in the queue of each element to simulate
+        std::vector<std::size_t>            element_groups;     ///< resource sharing group of each element to simulate
+        std::vector<std::pair<float, int>>  costs_and_times;    ///< item cost and minimum build turns of each element to simulate
+        ResourceGroups                      groups;
+        float                               pp_in_stockpile = 0.0f;
+        float                               available_stockpile = 0.0f;
+        float                               stockpile_limit = 0.0f;
+        ProductionRules                     rules;
+        int                                 max_turns = ProductionQueue::DEFAULT_PROJECTION_TURNS;
+        std::chrono::milliseconds           max_time = ProductionQueue::DEFAULT_PROJECTION_TIME;
+    };
+
+    struct ProjectionResults {
+        std::vector<std::pair<int, int>>    turns_left;         ///< turns to next item and to completion of each element of the queue, or -1 if never
+        bool                                complete = false;   ///< false if the projection ran out of time or was cancelled
+    };
+
+    /** Simulates future turns of production to find when each element of the
+      * queue will produce its next item and be completed. Stops early if
+      * \a cancelled becomes true. */
+    ProjectionResults ProjectFutureProduction(ProjectionInputs inputs, const std::atomic<bool>* cancelled) {
+        ProjectionResults retval;
+        retval.turns_left.resize(inputs.queue_uuids.size(), {-1, -1});
+        retval.complete = true;
+
+        auto& sim_queue = inputs.queue;
+        auto& queue_element_groups = inputs.element_groups;
+        auto& costs_and_times = inputs.costs_and_times;
+        auto& sim_queue_original_indices = inputs.original_indices;
+        std::vector<bool> is_producible(sim_queue.size(), true);
+
+        const auto sim_time_start = std::chrono::steady_clock::now();
+        GroupAmounts allocated_pp(inputs.groups.groups.size());
+        GroupAmounts allocated_stockpile_pp(inputs.groups.groups.size());
+        float sim_available_stockpile = inputs.available_stockpile;
+        float sim_pp_in_stockpile = inputs.pp_in_stockpile;
+        int dummy_int = 0;
+
+        for (int sim_turn = 1; sim_turn <= inputs.max_turns; sim_turn ++) {
+            if (std::chrono::steady_clock::now() - sim_time_start >= inputs.max_time ||
+                (cancelled && cancelled->load(std::memory_order_relaxed)))
+            {
+                retval.complete = false;
+                break;
+            }
+
+            TraceLogger() << "sim turn: " << sim_turn << "  sim queue size: " << sim_queue.size();
+            if (sim_queue.empty() && sim_turn > 2)
+                break;
+
+            float sim_project_transfer_to_stockpile = SetProdQueueElementSpending(
+                inputs.groups.available_pp, sim_available_stockpile, inputs.stockpile_limit, inputs.rules,
+                queue_element_groups, costs_and_times, is_producible, sim_queue,
+                allocated_pp, allocated_stockpile_pp, dummy_int, true);
+
+            // check completion status and update results and sim_queue as appropriate
+            for (unsigned int i = 0; i < sim_queue.size(); i++) {
+                ProductionQueue::Element& sim_element = sim_queue[i];
+                auto& orig_turns_left = retval.turns_left[sim_queue_original_indices[i]];
+                if (sim_element.turns_left_to_next_item != 1)
+                    continue;
+                sim_element.progress = std::max(0.0f, sim_element.progress - 1.0f);
+                if (orig_turns_left.first == -1)
+                    orig_turns_left.first = sim_turn;
+                sim_element.turns_left_to_next_item = -1;
+
+                // if all repeats of item are complete, update completion time and remove from sim_queue
+                if (--sim_element.remaining == 0) {
+                    orig_turns_left.second = sim_turn;
+                    sim_queue.erase(sim_queue.begin() + i);
+                    is_producible.erase(is_producible.begin() + i);
+                    queue_element_groups.erase(queue_element_groups.begin() + i);
+                    costs_and_times.erase(costs_and_times.begin() + i);
+                    sim_queue_original_indices.erase(sim_queue_original_indices.begin() + i--);
+                }
+            }
+            sim_pp_in_stockpile = CalculateNewStockpile(
+                inputs.empire_id, sim_pp_in_stockpile, sim_project_transfer_to_stockpile,
+                inputs.stockpile_limit, inputs.rules, inputs.groups, allocated_pp, allocated_stockpile_pp);
+            sim_available_stockpile = std::min(sim_pp_in_stockpile, inputs.stockpile_limit);
+        }
+
+        const auto sim_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - sim_time_start).count();
+        if (!retval.complete)
+            DebugLogger() << "ProductionQueue::Update: Projections stopped after " << sim_time
+                          << " microseconds; all remaining items in queue marked completing 'Never'.";
+        DebugLogger() << "ProductionQueue::Update: Projections took " << sim_time << " microseconds";
+        return retval;
+    }
+
+    /** Sets the turns left of the elements of \a queue from \a results, which
+      * were projected from \a inputs.  Elements are matched by UUID, in case
+      * the queue has changed since the projection was started. */
+    void ApplyProjectionResults(ProductionQueue::QueueType& queue, const ProjectionInputs& inputs,
+                                const ProjectionResults& results)
+    {
+        const auto& uuids = inputs.queue_uuids;
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            auto& elem = queue[i];
+            std::size_t result_idx = i;
+            if (result_idx >= uuids.size() || uuids[result_idx] != elem.uuid) {
+                result_idx = std::find(uuids.begin(), uuids.end(), elem.uuid) - uuids.begin();
+                if (result_idx >= uuids.size())
+                    continue;
+            }
+            elem.turns_left_to_next_item = results.turns_left[result_idx].first;
+            elem.turns_left_to_completion = results.turns_left[result_idx].second;
+        }
+    }
 }
 
+struct ProductionQueue::ProjectionCache {
+    ProjectionInputs    inputs;
+    ProjectionResults   results;
+};
+
+struct ProductionQueue::ProjectionTask {
+    ~ProjectionTask()
+    { cancelled = true; }   // so that the future's destructor doesn't wait for the whole projection
+
+    std::atomic<bool>                                   cancelled{false};
+    std::future<std::shared_ptr<const ProjectionCache>> result;
+};
+
 
 ProductionQueue::ProductionItem::ProductionItem(BuildType build_type_) :
     build_type(build_type_)
@@ -363,8 +626,63 @@ bool ProductionQueue::ProductionItem::CostIsProductionLocationInvariant() const
     return false;
 }
 
+namespace {
+    /** Production costs and times by item, empire and location, or no
+      * location for items whose costs and times don't depend on it.  They
+      * are kept for one turn and generation of meters of one universe. */
+    struct CostAndTimeCache {
+        using Key = std::tuple<ProductionQueue::ProductionItem, int, int>;
+
+        std::mutex                              mutex;
+        const Universe*                         universe = nullptr;
+        int                                     turn = INVALID_GAME_TURN;
+        std::size_t                             meters_generation = 0;
+        std::map<Key, std::pair<float, int>>    values;
+    };
+
+    CostAndTimeCache& GetCostAndTimeCache() {
+        static CostAndTimeCache cache;
+        return cache;
+    }
+}
+
 std::pair<float, int> ProductionQueue::ProductionItem::ProductionCostAndTime(
     int empire_id, int location_id, const ScriptingContext& context) const
+{
+    if (build_type == BuildType::BT_STOCKPILE)
+        return {1.0, 1};
+
+    const Universe* universe = &context.ContextUniverse();
+    const auto generation = universe->MetersGeneration();
+    CostAndTimeCache::Key key{*this, empire_id,
+                              CostIsProductionLocationInvariant() ? INVALID_OBJECT_ID : location_id};
+
+    auto& cache = GetCostAndTimeCache();
+    {
+        std::scoped_lock lock(cache.mutex);
+        if (cache.universe != universe || cache.turn != context.current_turn ||
+            cache.meters_generation != generation)
+        {
+            cache.values.clear();
+            cache.universe = universe;
+            cache.turn = context.current_turn;
+            cache.meters_generation = generation;
+        } else if (auto it = cache.values.find(key); it != cache.values.end()) {
+            return it->second;
+        }
+    }
+
+    auto retval = EvalProductionCostAndTime(empire_id, location_id, context);
+
+    std::scoped_lock lock(cache.mutex);
+    if (cache.universe == universe && cache.turn == context.current_turn &&
+        cache.meters_generation == generation)
+    { cache.values.emplace(std::move(key), retval); }
+    return retval;
+}
+
+std::pair<float, int> ProductionQueue::ProductionItem::EvalProductionCostAndTime(
+    int empire_id, int location_id, const ScriptingContext& context) const
 {
     if (build_type == BuildType::BT_BUILDING) {
         const BuildingType* type = GetBuildingType(name);
@@ -713,84 +1031,80 @@ void ProductionQueue::Update() {
     update_timer.EnterSection("Get PP");
 
     auto industry_resource_pool = empire->GetResourcePool(ResourceType::RE_INDUSTRY);
-    auto available_pp = AvailablePP(industry_resource_pool);
+    const ResourceGroups groups(industry_resource_pool.get());
     float pp_in_stockpile = industry_resource_pool->Stockpile();
     TraceLogger() << "========= pp_in_stockpile:     " << pp_in_stockpile << " ========";
     float stockpile_limit = StockpileCapacity();
     float available_stockpile = std::min(pp_in_stockpile, stockpile_limit);
     TraceLogger() << "========= available_stockpile: " << available_stockpile << " ========";
+    const auto rules = ProductionRules::Current();
 
     update_timer.EnterSection("Queue Items -> Res Groups");
     // determine which resource sharing group each queue item is located in
-    std::vector<std::set<int>> queue_element_groups;
-    for (const auto& element : m_queue) {
-        // get location object for element
-        int location_id = element.location;
-
-        // search through groups to find object
-        for (auto groups_it = available_pp.begin(); true; ++groups_it) {
-            if (groups_it == available_pp.end()) {
-                // didn't find a group containing this object, so add an empty group as this element's queue element group
-                queue_element_groups.emplace_back();
-                break;
-            }
-
-            // check if location object id is in this group
-            const auto& group = groups_it->first;
-            auto set_it = group.find(location_id);
-            if (set_it != group.end()) {
-                // system is in this group.
-                queue_element_groups.emplace_back(group);   // record this discovery
-                break;                                      // stop searching for a group containing a system, since one has been found
-            }
-        }
-    }
+    std::vector<std::size_t> queue_element_groups;
+    queue_element_groups.reserve(m_queue.size());
+    for (const auto& element : m_queue)
+        queue_element_groups.push_back(groups.GroupOf(element.location));
 
     update_timer.EnterSection("Cacheing Costs");
     // cache producibility, and production item costs and times
     // initialize production queue item completion status to 'never'
     std::map<std::pair<ProductionQueue::ProductionItem, int>,
              std::pair<float, int>> queue_item_costs_and_times;
+    std::vector<std::pair<float, int>> queue_element_costs_and_times;
+    queue_element_costs_and_times.reserve(m_queue.size());
     std::vector<bool> is_producible;
+    // turns left from the previous projection, which are shown until a new
+    // projection made on another thread replaces them
+    std::vector<std::pair<int, int>> previous_turns_left;
+    previous_turns_left.reserve(m_queue.size());
     for (auto& elem : m_queue) {
         is_producible.push_back(empire->ProducibleItem(elem.item, elem.location));
         // for items that don't depend on location, only store cost/time once
         int location_id = (elem.item.CostIsProductionLocationInvariant() ? INVALID_OBJECT_ID : elem.location);
         auto key = std::pair{elem.item, location_id};
 
-        if (!queue_item_costs_and_times.count(key))
-            queue_item_costs_and_times[key] = elem.ProductionCostAndTime();
+        auto cost_it = queue_item_costs_and_times.find(key);
+        if (cost_it == queue_item_costs_and_times.end())
+            cost_it = queue_item_costs_and_times.emplace(std::move(key), elem.ProductionCostAndTime()).first;
+        queue_element_costs_and_times.push_back(cost_it->second);
 
+        previous_turns_left.emplace_back(elem.turns_left_to_next_item, elem.turns_left_to_completion);
         elem.turns_left_to_next_item = -1;
         elem.turns_left_to_completion = -1;
     }
 
     // duplicate production queue state for future simulation
-    QueueType sim_queue = m_queue;
-    std::vector<unsigned int> sim_queue_original_indices(sim_queue.size());
-    for (unsigned int i = 0; i < sim_queue_original_indices.size(); ++i)
-        sim_queue_original_indices[i] = i;
+    ProjectionInputs projection_inputs;
+    projection_inputs.empire_id = m_empire_id;
+    projection_inputs.queue_uuids.reserve(m_queue.size());
+    for (const auto& elem : m_queue)
+        projection_inputs.queue_uuids.push_back(elem.uuid);
+    projection_inputs.queue = m_queue;
 
     update_timer.EnterSection("Set Spending");
     // allocate pp to queue elements, returning updated available pp and updated
     // allocated pp for each group of resource sharing objects
+    GroupAmounts allocated_pp(groups.groups.size());
+    GroupAmounts allocated_stockpile_pp(groups.groups.size());
     float project_transfer_to_stockpile = SetProdQueueElementSpending(
-        available_pp, available_stockpile, stockpile_limit, queue_element_groups,
-        queue_item_costs_and_times, is_producible, m_queue,
-        m_object_group_allocated_pp, m_object_group_allocated_stockpile_pp,
-        m_projects_in_progress, false);
+        groups.available_pp, available_stockpile, stockpile_limit, rules, queue_element_groups,
+        queue_element_costs_and_times, is_producible, m_queue,
+        allocated_pp, allocated_stockpile_pp, m_projects_in_progress, false);
+    m_object_group_allocated_pp = allocated_pp.ToMap(groups.groups);
+    m_object_group_allocated_stockpile_pp = allocated_stockpile_pp.ToMap(groups.groups);
 
     //update expected new stockpile amount
     m_expected_new_stockpile_amount = CalculateNewStockpile(
-        m_empire_id, pp_in_stockpile, project_transfer_to_stockpile, available_pp, m_object_group_allocated_pp,
-        m_object_group_allocated_stockpile_pp);
+        m_empire_id, pp_in_stockpile, project_transfer_to_stockpile, stockpile_limit, rules,
+        groups, allocated_pp, allocated_stockpile_pp);
     m_expected_project_transfer_to_stockpile = project_transfer_to_stockpile;
 
     // if at least one resource-sharing system group have available PP, simulate
     // future turns to predict when build items will be finished
     bool simulate_future = false;
-    for (auto& available : available_pp) {
-        if (available.second > EPSILON) {
+    for (std::size_t group = 0; group < groups.groups.size(); ++group) {
+        if (groups.has_available_pp[group] && groups.available_pp[group] > EPSILON) {
             simulate_future = true;
             break;
         }
@@ -799,16 +1113,12 @@ void ProductionQueue::Update() {
     if (!simulate_future) {
         update_timer.EnterSection("Signal and Finish");
         DebugLogger() << "not enough PP to be worth simulating future turns production.  marking everything as never complete";
+        m_projection_task.reset();
         ProductionQueueChangedSignal();
         return;
     }
 
     // there are enough PP available in at least one group to make it worthwhile to simulate the future.
-    DebugLogger() << "ProductionQueue::Update: Simulating future turns of production queue";
-
-    constexpr int TOO_MANY_TURNS = 500;   // stop counting turns to completion after this long, to prevent seemingly endless loops
-    constexpr float TOO_LONG_TIME = 0.5f; // max time in seconds to spend simulating queue
-
 
     update_timer.EnterSection("Remove Unproducible");
     // remove from simulated queue any paused items and items that can't be built due to not
@@ -821,79 +1131,91 @@ void ProductionQueue::Update() {
     // chance, so for simplicity, it is assumed that building location
     // conditions evaluated at the present turn apply indefinitely.
     //
+    auto& sim_queue = projection_inputs.queue;
+    ProductionQueue::QueueType producible_sim_queue;
     for (unsigned int i = 0; i < sim_queue.size(); ++i) {
-        if (sim_queue[i].paused || !is_producible[i]) {
-            sim_queue.erase(sim_queue.begin() + i);
-            is_producible.erase(is_producible.begin() + i);
-            queue_element_groups.erase(queue_element_groups.begin() + i);
-            sim_queue_original_indices.erase(sim_queue_original_indices.begin() + i--);
-        }
+        if (sim_queue[i].paused || !is_producible[i])
+            continue;
+        producible_sim_queue.push_back(std::move(sim_queue[i]));
+        projection_inputs.original_indices.push_back(i);
+        projection_inputs.element_groups.push_back(queue_element_groups[i]);
+        projection_inputs.costs_and_times.push_back(queue_element_costs_and_times[i]);
     }
+    sim_queue = std::move(producible_sim_queue);
+    projection_inputs.groups = groups;
+    projection_inputs.pp_in_stockpile = pp_in_stockpile;
+    projection_inputs.available_stockpile = available_stockpile;
+    projection_inputs.stockpile_limit = stockpile_limit;
+    projection_inputs.rules = rules;
+    projection_inputs.max_turns = m_projection_max_turns;
+    projection_inputs.max_time = m_projection_max_time;
+
+    // if nothing the projection depends on has changed, reuse the previous one
+    if (m_projection_cache && m_projection_cache->inputs == projection_inputs) {
+        update_timer.EnterSection("Reuse Projection");
+        DebugLogger() << "ProductionQueue::Update: Reusing unchanged projection of future turns of production queue";
+        m_projection_task.reset();
+        ApplyProjectionResults(m_queue, m_projection_cache->inputs, m_projection_cache->results);
+        ProductionQueueChangedSignal();
+        return;
+    }
+
+    if (m_async_projection) {
+        update_timer.EnterSection("Start Projection");
+        DebugLogger() << "ProductionQueue::Update: Simulating future turns of production queue on another thread";
+        for (std::size_t i = 0; i < m_queue.size(); ++i) {
+            m_queue[i].turns_left_to_next_item = previous_turns_left[i].first;
+            m_queue[i].turns_left_to_completion = previous_turns_left[i].second;
+        }
 
-    boost::posix_time::ptime sim_time_start;
-    boost::posix_time::ptime sim_time_end;
-    long sim_time;
-    sim_time_start = boost::posix_time::ptime(boost::posix_time::microsec_clock::local_time()); 
-    std::map<std::set<int>, float>  allocated_pp;
-    float sim_available_stockpile = available_stockpile;
-    float sim_pp_in_stockpile = pp_in_stockpile;
-    std::map<std::set<int>, float>  allocated_stockpile_pp;
-    int dummy_int = 0;
+        // replacing any previous task cancels it
+        auto task = std::make_shared<ProjectionTask>();
+        task->result = std::async(std::launch::async,
+            [inputs{std::move(projection_inputs)}, cancelled{&task->cancelled}]() {
+                auto results = ProjectFutureProduction(inputs, cancelled);
+                return std::shared_ptr<const ProjectionCache>(
+                    std::make_shared<ProjectionCache>(ProjectionCache{inputs, std::move(results)}));
+            });
+        m_projection_task = std::move(task);
+        ProductionQueueChangedSignal();
+        return;
+    }
 
+    DebugLogger() << "ProductionQueue::Update: Simulating future turns of production queue";
     update_timer.EnterSection("Looping over Turns");
-    for (int sim_turn = 1; sim_turn <= TOO_MANY_TURNS; sim_turn ++) {
-        long sim_time_until_now = (boost::posix_time::ptime(boost::posix_time::microsec_clock::local_time()) - sim_time_start).total_microseconds();
-        if ((sim_time_until_now * 1e-6) >= TOO_LONG_TIME)
-            break;
+    m_projection_task.reset();
+    auto results = ProjectFutureProduction(projection_inputs, nullptr);
+    ApplyProjectionResults(m_queue, projection_inputs, results);
+    if (results.complete)
+        m_projection_cache = std::make_shared<ProjectionCache>(ProjectionCache{std::move(projection_inputs), std::move(results)});
+    DebugLogger() << "ProductionQueue::Update: Projected with "
+                  << empire->ResourceOutput(ResourceType::RE_INDUSTRY) << " industry output";
+    ProductionQueueChangedSignal();
+}
 
-        TraceLogger() << "sim turn: " << sim_turn << "  sim queue size: " << sim_queue.size();
-        if (sim_queue.empty() && sim_turn > 2)
-            break;
+void ProductionQueue::SetAsyncProjection(bool async)
+{ m_async_projection = async; }
 
-        allocated_pp.clear();
-        allocated_stockpile_pp.clear();
+void ProductionQueue::SetProjectionLimits(int max_turns, std::chrono::milliseconds max_time) {
+    m_projection_max_turns = max_turns;
+    m_projection_max_time = max_time;
+}
 
-        float sim_project_transfer_to_stockpile = SetProdQueueElementSpending(
-            available_pp, sim_available_stockpile, stockpile_limit, queue_element_groups,
-            queue_item_costs_and_times, is_producible, sim_queue,
-            allocated_pp, allocated_stockpile_pp, dummy_int, true);
+bool ProductionQueue::ProjectionPending() const
+{ return m_projection_task != nullptr; }
 
-        // check completion status and update m_queue and sim_queue as appropriate
-        for (unsigned int i = 0; i < sim_queue.size(); i++) {
-            ProductionQueue::Element& sim_element = sim_queue[i];
-            ProductionQueue::Element& orig_element = m_queue[sim_queue_original_indices[i]];
-            if (sim_element.turns_left_to_next_item != 1) 
-                continue;
-            sim_element.progress = std::max(0.0f, sim_element.progress - 1.0f);
-            if (orig_element.turns_left_to_next_item == -1)
-                orig_element.turns_left_to_next_item = sim_turn;
-            sim_element.turns_left_to_next_item = -1;
-
-            // if all repeats of item are complete, update completion time and remove from sim_queue
-            if (--sim_element.remaining == 0) {
-                orig_element.turns_left_to_completion = sim_turn;
-                sim_queue.erase(sim_queue.begin() + i);
-                is_producible.erase(is_producible.begin() + i);
-                queue_element_groups.erase(queue_element_groups.begin() + i);
-                sim_queue_original_indices.erase(sim_queue_original_indices.begin() + i--);
-            }
-        }
-        sim_pp_in_stockpile = CalculateNewStockpile(
-            m_empire_id, sim_pp_in_stockpile, sim_project_transfer_to_stockpile,
-            available_pp, allocated_pp, allocated_stockpile_pp);
-        sim_available_stockpile = std::min(sim_pp_in_stockpile, stockpile_limit);
-    }
+bool ProductionQueue::ApplyFinishedProjection() {
+    if (!m_projection_task ||
+        m_projection_task->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    { return false; }
 
-    sim_time_end = boost::posix_time::ptime(boost::posix_time::microsec_clock::local_time()); 
-    sim_time = (sim_time_end - sim_time_start).total_microseconds();
-    if ((sim_time * 1e-6) >= TOO_LONG_TIME) {
-        DebugLogger()  << "ProductionQueue::Update: Projections timed out after " << sim_time
-                       << " microseconds; all remaining items in queue marked completing 'Never'.";
-    }
-    DebugLogger() << "ProductionQueue::Update: Projections took "
-                  << ((sim_time_end - sim_time_start).total_microseconds()) << " microseconds with "
-                  << empire->ResourceOutput(ResourceType::RE_INDUSTRY) << " industry output";
+    auto projection = m_projection_task->result.get();
+    m_projection_task.reset();
+    ApplyProjectionResults(m_queue, projection->inputs, projection->results);
+    if (projection->results.complete)
+        m_projection_cache = std::move(projection);
     ProductionQueueChangedSignal();
+    return true;
 }
 
 void ProductionQueue::push_back(const Element& element) {
@@ -940,6 +1262,7 @@ ProductionQueue::Element& ProductionQueue::operator[](int i) {
 }
 
 void ProductionQueue::clear() {
+    m_projection_task.reset();
     m_queue.clear();
     m_projects_in_progress = 0;
     m_object_group_allocated_pp.clear();
@@ -5,6 +5,7 @@
 #include "../universe/Enums.h"
 #include "../universe/ScriptingContext.h"
 
+#include <chrono>
 #include <deque>
 #include <map>
 #include <memory>
@@ -53,10 +54,16 @@ struct FO_COMMON_API ProductionQueue {
 
         /** Returns the total cost per item (blocksize 1) and the minimum number of
           * turns required to produce the indicated item, or (-1.0, -1) if the item
-          * is unknown, unavailable, or invalid. */
+          * is unknown, unavailable, or invalid.  The results are kept until the
+          * turn changes or meters are updated. */
         std::pair<float, int> ProductionCostAndTime(int empire_id, int location_id,
                                                     const ScriptingContext& context = ScriptingContext{}) const;
 
+        /** Evaluates the total cost per item and minimum number of turns
+          * returned by ProductionCostAndTime. */
+        std::pair<float, int> EvalProductionCostAndTime(int empire_id, int location_id,
+                                                        const ScriptingContext& context) const;
+
         bool operator<(const ProductionItem& rhs) const;
 
         bool EnqueueConditionPassedAt(int location_id, const ScriptingContext& context) const;
@@ -177,9 +184,36 @@ struct FO_COMMON_API ProductionQueue {
       * the industry consumed by projects in each resource-sharing group of
       * systems.  Does not actually "spend" the PP; a later call to
       * empire->CheckProductionProgress(...) will actually spend PP, remove
-      * items from queue and create them in the universe. */
+      * items from queue and create them in the universe.
+      *
+      * The turns left are projected by simulating future turns of production,
+      * which is skipped if nothing it depends on has changed since the last
+      * projection.  If SetAsyncProjection(true) has been called, the
+      * projection is made on another thread, and the turns left are updated
+      * by a later call to ApplyFinishedProjection(). */
     void        Update();
 
+    /** Sets whether Update() projects the turns left for each project on
+      * another thread rather than before returning. */
+    void        SetAsyncProjection(bool async);
+
+    /** Sets how many future turns of production Update() simulates at most,
+      * and how long it may spend on them, after which the turns left are
+      * "never".  Servers reduce these when turns are taking too long. */
+    void        SetProjectionLimits(int max_turns, std::chrono::milliseconds max_time);
+
+    static constexpr int                        DEFAULT_PROJECTION_TURNS = 500;      ///< stop counting turns to completion after this long, to prevent seemingly endless loops
+    static constexpr std::chrono::milliseconds  DEFAULT_PROJECTION_TIME{500};        ///< max time to spend simulating queue
+
+    /** Returns true iff a projection started by Update() on another thread
+      * hasn't yet been applied by ApplyFinishedProjection(). */
+    bool        ProjectionPending() const;
+
+    /** If a projection started by Update() on another thread has finished,
+      * sets the turns left for each project from it, emits
+      * ProductionQueueChangedSignal, and returns true. */
+    bool        ApplyFinishedProjection();
+
     // STL container-like interface
     void        push_back(const Element& element);
     void        insert(iterator it, const Element& element);
@@ -204,6 +238,14 @@ private:
     float                           m_expected_project_transfer_to_stockpile = 0.0f;
     int                             m_empire_id = ALL_EMPIRES;
 
+    struct ProjectionCache;
+    struct ProjectionTask;
+    std::shared_ptr<const ProjectionCache>  m_projection_cache; ///< inputs and results of the most recent completed projection of future turns
+    std::shared_ptr<ProjectionTask>         m_projection_task;  ///< projection being made on another thread, if any
+    bool                                    m_async_projection = false;
+    int                                     m_projection_max_turns = DEFAULT_PROJECTION_TURNS;
+    std::chrono::milliseconds               m_projection_max_time = DEFAULT_PROJECTION_TIME;
+
     friend class boost::serialization::access;
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int version);
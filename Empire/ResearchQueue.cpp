@@ -4,23 +4,67 @@
 #include "../universe/Tech.h"
 #include "../util/AppInterface.h"
 
+#include <boost/dynamic_bitset.hpp>
+
 namespace {
     const float EPSILON = 0.01f;
 
+    /** Returns the status of each tech for \a empire, indexed by
+      * Tech::Index(). */
+    std::vector<TechStatus> TechStatuses(const Empire& empire) {
+        const TechManager& tech_manager = GetTechManager();
+        const int num_techs = static_cast<int>(tech_manager.size());
+
+        boost::dynamic_bitset<> researched = empire.ResearchedTechIndices();
+        if (static_cast<int>(researched.size()) != num_techs) {
+            researched.resize(num_techs);
+            for (int i = 0; i < num_techs; ++i)
+                researched[i] = empire.TechResearched(i);
+        }
+
+        std::vector<TechStatus> retval(num_techs, TechStatus::TS_UNRESEARCHABLE);
+        for (int i = 0; i < num_techs; ++i) {
+            if (researched[i]) {
+                retval[i] = TechStatus::TS_COMPLETE;
+                continue;
+            }
+            const Tech* tech = tech_manager.GetTechByIndex(i);
+            if (!tech)
+                continue;
+            bool one_unresearched = false;
+            bool one_researched = false;
+            for (int prereq : tech->PrerequisiteIndices()) {
+                if (researched[prereq])
+                    one_researched = true;
+                else
+                    one_unresearched = true;
+            }
+            if (!one_unresearched)
+                retval[i] = TechStatus::TS_RESEARCHABLE;
+            else if (one_researched)
+                retval[i] = TechStatus::TS_HAS_RESEARCHED_PREREQ;
+        }
+        return retval;
+    }
+
     /** sets the .allocated_rp, value for each Tech in the queue.  Only sets
       * nonzero funding to a Tech if it is researchable this turn.  Also
       * determines total number of spent RP (returning by reference in
-      * total_RPs_spent) */
+      * total_RPs_spent).  \a queue_techs, \a tech_costs and \a tech_min_turns
+      * hold the tech, its cost and its minimum research time for each element
+      * of \a queue, and \a research_status is indexed by Tech::Index(). */
     void SetTechQueueElementSpending(
         float RPs, const std::map<std::string, float>& research_progress,
-        const std::map<std::string, TechStatus>& research_status,
-        ResearchQueue::QueueType& queue, float& total_RPs_spent,
-        int& projects_in_progress, int empire_id)
+        const std::vector<TechStatus>& research_status,
+        const std::vector<const Tech*>& queue_techs, const std::vector<float>& tech_costs,
+        const std::vector<int>& tech_min_turns, ResearchQueue::QueueType& queue,
+        float& total_RPs_spent, int& projects_in_progress)
     {
         total_RPs_spent = 0.0f;
         projects_in_progress = 0;
 
-        for (ResearchQueue::Element& elem : queue) {
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            ResearchQueue::Element& elem = queue[i];
             elem.allocated_rp = 0.0f;    // default, may be modified below
 
             if (elem.paused) {
@@ -28,26 +72,24 @@ namespace {
             }
 
             // get details on what is being researched...
-            const Tech* tech = GetTech(elem.name);
+            const Tech* tech = queue_techs[i];
             if (!tech) {
                 ErrorLogger() << "SetTechQueueElementSpending found null tech on research queue?!";
                 continue;
             }
-            auto status_it = research_status.find(elem.name);
-            if (status_it == research_status.end()) {
-                ErrorLogger() << "SetTechQueueElementSpending couldn't find tech with name " << elem.name << " in the research status map";
+            if (tech->Index() < 0 || tech->Index() >= static_cast<int>(research_status.size())) {
+                ErrorLogger() << "SetTechQueueElementSpending couldn't find tech with name " << elem.name << " in the research status table";
                 continue;
             }
-            bool researchable = status_it->second == TechStatus::TS_RESEARCHABLE;
+            bool researchable = research_status[tech->Index()] == TechStatus::TS_RESEARCHABLE;
 
             if (researchable && !elem.paused) {
                 auto progress_it = research_progress.find(elem.name);
-                float tech_cost = tech->ResearchCost(empire_id);
+                float tech_cost = tech_costs[i];
                 float progress = progress_it == research_progress.end() ? 0.0f : progress_it->second;
                 float RPs_needed = tech_cost - progress*tech_cost;
-                int tech_min_turns = std::max(1, tech ? tech->ResearchTime(empire_id) : 1);
 
-                float RPs_per_turn_limit = tech ? (tech_cost / tech_min_turns) : 1.0f;
+                float RPs_per_turn_limit = tech_cost / tech_min_turns[i];
                 float RPs_to_spend = std::min(RPs_needed, RPs_per_turn_limit);
 
                 if (total_RPs_spent + RPs_to_spend <= RPs - EPSILON) {
@@ -161,14 +203,27 @@ void ResearchQueue::Update(float RPs, const std::map<std::string, float>& resear
         return;
     }
 
-    std::map<std::string, TechStatus> sim_tech_status_map;
-    for (const auto& tech : GetTechManager()) {
-        const std::string& tech_name = tech->Name();
-        sim_tech_status_map[tech_name] = empire->GetTechStatus(tech_name);
+    // tech statuses are indexed by Tech::Index(), and everything else by
+    // position in the queue
+    std::vector<TechStatus> dpsim_tech_status = TechStatuses(*empire);
+    const int num_techs = static_cast<int>(dpsim_tech_status.size());
+
+    // look up each queued tech and evaluate its cost and time once, rather
+    // than on every simulated turn
+    std::vector<const Tech*> queue_techs(m_queue.size(), nullptr);
+    std::vector<float> tech_costs(m_queue.size(), 0.0f);
+    std::vector<int> tech_min_turns(m_queue.size(), 1);
+    for (std::size_t i = 0; i < m_queue.size(); ++i) {
+        const Tech* tech = GetTech(m_queue[i].name);
+        if (!tech || tech->Index() < 0 || tech->Index() >= num_techs)
+            continue;
+        queue_techs[i] = tech;
+        tech_costs[i] = tech->ResearchCost(m_empire_id);
+        tech_min_turns[i] = std::max(1, tech->ResearchTime(m_empire_id));
     }
 
-    SetTechQueueElementSpending(RPs, research_progress, sim_tech_status_map, m_queue,
-                                m_total_RPs_spent, m_projects_in_progress, m_empire_id);
+    SetTechQueueElementSpending(RPs, research_progress, dpsim_tech_status, queue_techs, tech_costs,
+                                tech_min_turns, m_queue, m_total_RPs_spent, m_projects_in_progress);
 
     if (m_queue.empty()) {
         ResearchQueueChangedSignal();
@@ -186,141 +241,103 @@ void ResearchQueue::Update(float RPs, const std::map<std::string, float>& resear
         return;    // nothing more to do if not enough RP...
     }
 
-    boost::posix_time::ptime dp_time_start;
-    boost::posix_time::ptime dp_time_end;
-
     // "Dynamic Programming" version of research queue simulator -- copy the queue simulator containers
-    // perform dynamic programming calculation of completion times, then after regular simulation is done compare results (if both enabled)
+    // perform dynamic programming calculation of completion times
 
     //record original order & progress
-    // will take advantage of fact that sets (& map keys) are by default kept in sorted order lowest to highest
-    std::map<std::string, float> dp_prog = research_progress;
-    std::map<std::string, int> orig_queue_order;
-    std::map<int, float> dpsim_research_progress;
-    for (unsigned int i = 0; i < m_queue.size(); ++i) {
-        std::string tname = m_queue[i].name;
-        orig_queue_order[tname] = i;
-        dpsim_research_progress[i] = dp_prog[tname];
+    std::vector<int> orig_queue_order(num_techs, -1);
+    std::vector<float> dpsim_research_progress(m_queue.size(), 0.0f);
+    for (std::size_t i = 0; i < m_queue.size(); ++i) {
+        if (queue_techs[i])
+            orig_queue_order[queue_techs[i]->Index()] = static_cast<int>(i);
+        auto progress_it = research_progress.find(m_queue[i].name);
+        if (progress_it != research_progress.end())
+            dpsim_research_progress[i] = progress_it->second;
     }
 
-    std::map<std::string, TechStatus> dpsim_tech_status_map = std::move(sim_tech_status_map);
-
-    // initialize simulation_results with -1 for all techs, so that any techs that aren't
-    // finished in simulation by turn TOO_MANY_TURNS will be left marked as never to be finished
-    std::vector<int> dpsimulation_results(m_queue.size(), -1);
-
     constexpr int DP_TURNS = TOO_MANY_TURNS; // track up to this many turns
 
-    std::map<std::string, std::set<std::string>> waiting_for_prereqs;
-    std::set<int> dp_researchable_techs;
+    // number of not-yet-complete prerequisites of each tech that is waiting
+    // for prerequisites, and the queue positions of researchable techs
+    std::vector<int> unfinished_prereqs(num_techs, 0);
+    boost::dynamic_bitset<> waiting_for_prereqs(num_techs);
+    boost::dynamic_bitset<> dp_researchable_techs(m_queue.size());
 
-    for (unsigned int i = 0; i < m_queue.size(); ++i) {
-        std::string techname = m_queue[i].name;
+    for (std::size_t i = 0; i < m_queue.size(); ++i) {
         if (m_queue[i].paused)
             continue;
-        const Tech* tech = GetTech(techname);
+        const Tech* tech = queue_techs[i];
         if (!tech)
             continue;
-        if (dpsim_tech_status_map[techname] == TechStatus::TS_RESEARCHABLE) {
-            dp_researchable_techs.insert(i);
-        } else if (dpsim_tech_status_map[techname] == TechStatus::TS_UNRESEARCHABLE ||
-                   dpsim_tech_status_map[techname] == TechStatus::TS_HAS_RESEARCHED_PREREQ)
+        const int tech_idx = tech->Index();
+        const TechStatus status = dpsim_tech_status[tech_idx];
+        if (status == TechStatus::TS_RESEARCHABLE) {
+            dp_researchable_techs.set(i);
+        } else if (status == TechStatus::TS_UNRESEARCHABLE ||
+                   status == TechStatus::TS_HAS_RESEARCHED_PREREQ)
         {
-            std::set<std::string> these_prereqs = tech->Prerequisites();
-            for (auto ptech_it = these_prereqs.begin(); ptech_it != these_prereqs.end();) {
-                if (dpsim_tech_status_map[*ptech_it] != TechStatus::TS_COMPLETE) {
-                    ++ptech_it;
-                } else {
-                    auto erase_it = ptech_it;
-                    ++ptech_it;
-                    these_prereqs.erase(erase_it);
-                }
-            }
-            waiting_for_prereqs[techname] = these_prereqs;
+            unfinished_prereqs[tech_idx] = static_cast<int>(std::count_if(
+                tech->PrerequisiteIndices().begin(), tech->PrerequisiteIndices().end(),
+                [&dpsim_tech_status](int prereq) { return dpsim_tech_status[prereq] != TechStatus::TS_COMPLETE; }));
+            waiting_for_prereqs.set(tech_idx);
         }
     }
 
-    int dp_turns = 0;
-    //pp_still_available[turn-1] gives the RP still available in this resource pool at turn "turn"
-    std::vector<float> rp_still_available(DP_TURNS, RPs);  // initialize to the  full RP allocation for every turn
+    constexpr auto NO_TECH = boost::dynamic_bitset<>::npos;
+    boost::dynamic_bitset<> already_processed(m_queue.size());
 
-    while ((dp_turns < DP_TURNS) && !(dp_researchable_techs.empty())) {// if we haven't used up our turns and still have techs to process
+    int dp_turns = 0;
+    while ((dp_turns < DP_TURNS) && dp_researchable_techs.any()) {// if we haven't used up our turns and still have techs to process
         ++dp_turns;
-        std::map<int, bool> already_processed;
-        for (int tech_id : dp_researchable_techs) {
-            already_processed[tech_id] = false;
-        }
-        auto cur_tech_it = dp_researchable_techs.begin();
-        while ((rp_still_available[dp_turns-1] > EPSILON)) { // try to use up this turns RPs
-            if (cur_tech_it == dp_researchable_techs.end()) {
+        float rp_still_available = RPs;     // the full RP allocation is available every turn
+        already_processed.reset();
+        auto cur_tech = dp_researchable_techs.find_first();
+        while (rp_still_available > EPSILON) { // try to use up this turns RPs
+            if (cur_tech == NO_TECH) {
                 break; //will be wasting some RP this turn
             }
-            int cur_tech = *cur_tech_it;
+            auto next_res_tech = dp_researchable_techs.find_next(cur_tech);
             if (already_processed[cur_tech]) {
-                ++cur_tech_it;
+                cur_tech = next_res_tech;
                 continue;
             }
-            already_processed[cur_tech] = true;
-            const std::string& tech_name = m_queue[cur_tech].name;
-            const Tech* tech = GetTech(tech_name);
+            already_processed.set(cur_tech);
+            const Tech* tech = queue_techs[cur_tech];
             float progress = dpsim_research_progress[cur_tech];
-            float tech_cost = tech ? tech->ResearchCost(m_empire_id) : 0.0f;
-            int tech_min_turns = std::max(1, tech ? tech->ResearchTime(m_empire_id) : 1);
+            float tech_cost = tech_costs[cur_tech];
 
             float RPs_needed = tech ? tech_cost * (1.0f - std::min(progress, 1.0f)) : 0.0f;
-            float RPs_per_turn_limit = tech ? (tech_cost / tech_min_turns) : 1.0f;
+            float RPs_per_turn_limit = tech ? (tech_cost / tech_min_turns[cur_tech]) : 1.0f;
 
-            float RPs_to_spend = std::min(std::min(RPs_needed, RPs_per_turn_limit), rp_still_available[dp_turns-1]);
+            float RPs_to_spend = std::min(std::min(RPs_needed, RPs_per_turn_limit), rp_still_available);
             progress += RPs_to_spend / std::max(EPSILON, tech_cost);
             dpsim_research_progress[cur_tech] = progress;
-            rp_still_available[dp_turns-1] -= RPs_to_spend;
-            auto next_res_tech_it = cur_tech_it;
-            int next_res_tech_idx;
-            if (++next_res_tech_it == dp_researchable_techs.end()) {
-                next_res_tech_idx = m_queue.size()+1;
-            } else {
-                next_res_tech_idx = *(next_res_tech_it);
-            }
+            rp_still_available -= RPs_to_spend;
 
             if (tech_cost - EPSILON <= progress * tech_cost) {
-                dpsim_tech_status_map[tech_name] = TechStatus::TS_COMPLETE;
-                dpsimulation_results[cur_tech] = dp_turns;
-#ifndef ORIG_RES_SIMULATOR
                 m_queue[cur_tech].turns_left = dp_turns;
-#endif
-                dp_researchable_techs.erase(cur_tech_it);
-                std::set<std::string> unlocked_techs;
-                if (tech)
-                    unlocked_techs = tech->UnlockedTechs();
-                for (std::string u_tech_name : unlocked_techs) {
-                    auto prereq_tech_it = waiting_for_prereqs.find(u_tech_name);
-                    if (prereq_tech_it != waiting_for_prereqs.end() ){
-                        std::set<std::string>& these_prereqs = prereq_tech_it->second;
-                        auto just_finished_it = these_prereqs.find(tech_name);
-                        if (just_finished_it != these_prereqs.end() ) {  //should always find it
-                            these_prereqs.erase(just_finished_it);
-                            if (these_prereqs.empty()) { // tech now fully unlocked
-                                int this_tech_idx = orig_queue_order[u_tech_name];
-                                dp_researchable_techs.insert(this_tech_idx);
-                                waiting_for_prereqs.erase(prereq_tech_it);
-                                already_processed[this_tech_idx] = true;    //doesn't get any allocation on current turn
-                                if (this_tech_idx < next_res_tech_idx ) {
-                                    next_res_tech_idx = this_tech_idx;
-                                }
-                            }
-                        } else { //couldnt find tech_name in prereqs list
-                            DebugLogger() << "ResearchQueue::Update tech unlocking problem:"<< tech_name << "thought it was a prereq for " << u_tech_name << "but the latter disagreed";
-                        }
-                    } //else { //tech_name thinks itself a prereq for ytechName, but u_tech_name not in prereqs -- not a problem so long as u_tech_name not in our queue at all
-                      //  DebugLogger() << "ResearchQueue::Update tech unlocking problem:"<< tech_name << "thought it was a prereq for " << u_tech_name << "but the latter disagreed";
-                      //}
+                dp_researchable_techs.reset(cur_tech);
+
+                // techs queued more than once only unlock others the first time they complete
+                if (tech && dpsim_tech_status[tech->Index()] != TechStatus::TS_COMPLETE) {
+                    dpsim_tech_status[tech->Index()] = TechStatus::TS_COMPLETE;
+                    for (int u_tech_idx : tech->UnlockedTechIndices()) {
+                        // techs not waiting for prereqs aren't in the queue, or are paused
+                        if (!waiting_for_prereqs[u_tech_idx] || --unfinished_prereqs[u_tech_idx] > 0)
+                            continue;
+                        // tech now fully unlocked
+                        waiting_for_prereqs.reset(u_tech_idx);
+                        auto this_tech = static_cast<std::size_t>(orig_queue_order[u_tech_idx]);
+                        dp_researchable_techs.set(this_tech);
+                        already_processed.set(this_tech);    //doesn't get any allocation on current turn
+                        if (this_tech < next_res_tech)
+                            next_res_tech = this_tech;
+                    }
                 }
-            }// if (tech->ResearchCost() - EPSILON <= progress * tech_cost)
-            cur_tech_it = dp_researchable_techs.find(next_res_tech_idx);
-        }//while ((rp_still_available[dp_turns-1]> EPSILON))
-        //dp_time = dpsim_queue_timer.elapsed() * 1000;
-        // DebugLogger() << "ProductionQueue::Update queue dynamic programming sim time: " << dpsim_queue_timer.elapsed() * 1000.0;
-    } // while ((dp_turns < DP_TURNS ) && !(dp_researchable_techs.empty() ) )
+            }
+            cur_tech = next_res_tech;
+        }//while (rp_still_available > EPSILON)
+    } // while ((dp_turns < DP_TURNS ) && dp_researchable_techs.any())
 
     ResearchQueueChangedSignal();
 }
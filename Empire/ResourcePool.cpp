@@ -1,5 +1,6 @@
 #include "ResourcePool.h"
 
+#include <algorithm>
 #include <cassert>
 #include <boost/lexical_cast.hpp>
 #include "../universe/Enums.h"
@@ -66,20 +67,30 @@ float ResourcePool::Stockpile() const
 
 float ResourcePool::TotalOutput() const {
     float retval = 0.0f;
-    for (const auto& entry : m_connected_object_groups_resource_output)
-    { retval += entry.second; }
+    for (const auto& group : m_object_groups)
+    { retval += group.output; }
     return retval;
 }
 
-std::map<std::set<int>, float> ResourcePool::Output() const
-{ return m_connected_object_groups_resource_output; }
+std::map<std::set<int>, float> ResourcePool::Output() const {
+    // groups are ordered by their object ids, as sets of them are
+    std::map<std::set<int>, float> retval;
+    for (const auto& group : m_object_groups)
+        retval.emplace_hint(retval.end(), std::set<int>(group.object_ids.begin(), group.object_ids.end()),
+                            group.output);
+    return retval;
+}
+
+int ResourcePool::ObjectGroupIndex(int object_id) const {
+    auto it = m_object_group_indices.find(object_id);
+    return it != m_object_group_indices.end() ? it->second : -1;
+}
 
 float ResourcePool::GroupOutput(int object_id) const {
     // find group containing specified object
-    for (const auto& entry : m_connected_object_groups_resource_output) {
-        if (entry.first.count(object_id))
-            return entry.second;
-    }
+    const int group = ObjectGroupIndex(object_id);
+    if (group >= 0)
+        return m_object_groups[group].output;
 
     // default return case:
     //DebugLogger() << "ResourcePool::GroupOutput passed unknown object id: " << object_id;
@@ -88,17 +99,16 @@ float ResourcePool::GroupOutput(int object_id) const {
 
 float ResourcePool::TargetOutput() const {
     float retval = 0.0f;
-    for (const auto& entry : m_connected_object_groups_resource_target_output)
-    { retval += entry.second; }
+    for (const auto& group : m_object_groups)
+    { retval += group.target_output; }
     return retval;
 }
 
 float ResourcePool::GroupTargetOutput(int object_id) const {
     // find group containing specified object
-    for (const auto& entry : m_connected_object_groups_resource_target_output) {
-        if (entry.first.count(object_id))
-            return entry.second;
-    }
+    const int group = ObjectGroupIndex(object_id);
+    if (group >= 0)
+        return m_object_groups[group].target_output;
 
     // default return case:
     DebugLogger() << "ResourcePool::GroupTargetOutput passed unknown object id: " << object_id;
@@ -107,15 +117,13 @@ float ResourcePool::GroupTargetOutput(int object_id) const {
 
 float ResourcePool::TotalAvailable() const {
     float retval = m_stockpile;
-    for (const auto& entry : m_connected_object_groups_resource_output)
-    { retval += entry.second; }
+    for (const auto& group : m_object_groups)
+    { retval += group.output; }
     return retval;
 }
 
-std::map<std::set<int>, float> ResourcePool::Available() const {
-    auto retval = m_connected_object_groups_resource_output;
-    return retval;
-}
+std::map<std::set<int>, float> ResourcePool::Available() const
+{ return Output(); }
 
 float ResourcePool::GroupAvailable(int object_id) const {
     TraceLogger() << "ResourcePool::GroupAvailable(" << object_id << ")";
@@ -135,8 +143,8 @@ std::string ResourcePool::Dump() const {
 void ResourcePool::SetObjects(const std::vector<int>& object_ids)
 { m_object_ids = object_ids; }
 
-void ResourcePool::SetConnectedSupplyGroups(const std::set<std::set<int>>& connected_system_groups)
-{ m_connected_system_groups = connected_system_groups; }
+void ResourcePool::SetConnectedSupplyGroups(boost::container::flat_map<int, int> system_group_ids)
+{ m_system_group_ids = std::move(system_group_ids); }
 
 void ResourcePool::SetStockpile(float d)
 {
@@ -154,73 +162,62 @@ void ResourcePool::Update() {
         ErrorLogger() << "ResourcePool::Update() called when m_type can't be converted to a valid MeterType";
 
     // zero to start...
-    m_connected_object_groups_resource_output.clear();
-    m_connected_object_groups_resource_target_output.clear();
-
-    // temporary storage: indexed by group of systems, which objects
-    // are located in that system group?
-    std::map<std::set<int>, std::set<std::shared_ptr<const UniverseObject>>>
-        system_groups_to_object_groups;
+    m_object_groups.clear();
+    m_object_group_indices.clear();
 
+    // index in m_object_groups of the group of objects in each group of
+    // systems, by the number of that group of systems, or -1 if none yet
+    std::vector<int> system_group_object_groups;
 
     // for every object, find if a connected system group contains the object's
-    // system.  If a group does, place the object into that system group's set
-    // of objects.  If no group contains the object, place the object in its own
-    // single-object group.
+    // system.  If a group does, place the object into that system group's
+    // group of objects.  If no group contains the object, place the object in
+    // its own single-object group.  This will allow the object to use its own
+    // locally produced resource when, for instance, distributing pp
     for (auto& obj : Objects().find<const UniverseObject>(m_object_ids)) {
-        int object_id = obj->ID();
         int object_system_id = obj->SystemID();
         // can't generate resources when not in a system
         if (object_system_id == INVALID_OBJECT_ID)
             continue;
 
-        // is object's system in a system group?
-        std::set<int> object_system_group;
-        for (const auto& sys_group : m_connected_system_groups) {
-            if (sys_group.count(object_system_id)) {
-                object_system_group = sys_group;
-                break;
+        int object_group = -1;
+        auto system_group_it = m_system_group_ids.find(object_system_id);
+        if (system_group_it != m_system_group_ids.end() && system_group_it->second >= 0) {
+            const auto system_group = static_cast<std::size_t>(system_group_it->second);
+            if (system_group >= system_group_object_groups.size())
+                system_group_object_groups.resize(system_group + 1, -1);
+            object_group = system_group_object_groups[system_group];
+            if (object_group < 0) {
+                object_group = static_cast<int>(m_object_groups.size());
+                system_group_object_groups[system_group] = object_group;
+                m_object_groups.emplace_back();
             }
+        } else {
+            object_group = static_cast<int>(m_object_groups.size());
+            m_object_groups.emplace_back();
         }
 
-        // if object's system is not in a system group, add it as its
-        // own entry in m_connected_object_groups_resource_output and m_connected_object_groups_resource_target_output
-        // this will allow the object to use its own locally produced
-        // resource when, for instance, distributing pp
-        if (object_system_group.empty()) {
-            object_system_group.insert(object_id);  // just use this already-available set to store the object id, even though it is not likely actually a system
-
-            const auto* mmt = obj->GetMeter(meter_type);
-            m_connected_object_groups_resource_output[object_system_group] = mmt ? mmt->Current() : 0.0f;
-
-            const auto* mtmt = obj->GetMeter(target_meter_type);
-            m_connected_object_groups_resource_target_output[object_system_group] = mtmt ? mtmt->Current() : 0.0f;
-
-            continue;
-        }
-
-        // if resource center's system is in a system group, record which system
-        // group that is for later
-        system_groups_to_object_groups[object_system_group].insert(obj);
+        auto& group = m_object_groups[object_group];
+        group.object_ids.push_back(obj->ID());
+        if (const auto* m = obj->GetMeter(meter_type))
+            group.output += m->Current();
+        if (const auto* m = obj->GetMeter(target_meter_type))
+            group.target_output += m->Current();
     }
 
-    // sum the resource production for object groups, and store the total
-    // group production, indexed by group of object ids
-    for (auto& entry : system_groups_to_object_groups) {
-        const auto& object_group = entry.second;
-        std::set<int> object_group_ids;
-        float total_group_output = 0.0f;
-        float total_group_target_output = 0.0f;
-        for (auto& obj : object_group) {
-            if (const auto* m = obj->GetMeter(meter_type))
-                total_group_output += m->Current();
-            if (const auto* m = obj->GetMeter(target_meter_type))
-                total_group_target_output += m->Current();
-            object_group_ids.insert(obj->ID());
-        }
-        m_connected_object_groups_resource_output[object_group_ids] = total_group_output;
-        m_connected_object_groups_resource_target_output[object_group_ids] = total_group_target_output;
-    }
+    // order groups as sets of their object ids would be
+    for (auto& group : m_object_groups)
+        std::sort(group.object_ids.begin(), group.object_ids.end());
+    std::sort(m_object_groups.begin(), m_object_groups.end(),
+              [](const ObjectGroup& lhs, const ObjectGroup& rhs) { return lhs.object_ids < rhs.object_ids; });
+
+    std::vector<std::pair<int, int>> object_group_indices;
+    object_group_indices.reserve(m_object_ids.size());
+    for (std::size_t group = 0; group < m_object_groups.size(); ++group)
+        for (int object_id : m_object_groups[group].object_ids)
+            object_group_indices.emplace_back(object_id, static_cast<int>(group));
+    m_object_group_indices = boost::container::flat_map<int, int>(object_group_indices.begin(),
+                                                                  object_group_indices.end());
 
     ChangedSignal();
 }
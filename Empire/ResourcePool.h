@@ -2,8 +2,10 @@
 #define _ResourcePool_h_
 
 
+#include <map>
 #include <set>
 #include <vector>
+#include <boost/container/flat_map.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/version.hpp>
 #include <boost/signals2/signal.hpp>
@@ -36,6 +38,14 @@ FO_COMMON_API ResourceType MeterToResource(MeterType type);
   * of a particular resource (eg. research, industry). */
 class FO_COMMON_API ResourcePool {
 public:
+    /** A group of objects that can share resources, and how much of this
+      * pool's resource they are generating this turn. */
+    struct ObjectGroup {
+        std::vector<int>    object_ids;         ///< in increasing order
+        float               output = 0.0f;
+        float               target_output = 0.0f;
+    };
+
     ResourcePool(ResourceType type);
 
     const std::vector<int>&         ObjectIDs() const;                      ///< returns UniverseObject IDs in this ResourcePool
@@ -54,6 +64,14 @@ public:
     std::map<std::set<int>, float>  Available() const;
     float                           GroupAvailable(int object_id) const;    ///< returns amount of resource available in resource sharing group that contains the object with id \a object_id
 
+    /** Returns the groups of objects that can share resources, ordered as
+      * the keys of Output() are. */
+    const std::vector<ObjectGroup>& ObjectGroups() const { return m_object_groups; }
+
+    /** Returns the index in ObjectGroups() of the group containing the object
+      * with id \a object_id, or -1 if no group does. */
+    int                             ObjectGroupIndex(int object_id) const;
+
     std::string                     Dump() const;
 
     /** emitted after updating production, or called externally to indicate
@@ -61,9 +79,9 @@ public:
     mutable boost::signals2::signal<void ()> ChangedSignal;
 
     void        SetObjects(const std::vector<int>& object_ids);
-    /** specifies which sets systems can share resources.  any two sets should
-      * have no common systems. */
-    void        SetConnectedSupplyGroups(const std::set<std::set<int>>& connected_system_groups);
+    /** specifies which systems can share resources: those with the same
+      * group number, as given by SupplyManager::ResourceSupplyGroupIDs. */
+    void        SetConnectedSupplyGroups(boost::container::flat_map<int, int> system_group_ids);
 
     void        SetStockpile(float d);      ///< sets current sockpiled amount of resource
 
@@ -73,9 +91,9 @@ private:
     ResourcePool(); ///< default ctor needed for serialization
 
     std::vector<int>                m_object_ids;                                       ///< IDs of objects to consider in this pool
-    std::set<std::set<int>>         m_connected_system_groups;                          ///< sets of systems between and in which objects can share this pool's resource
-    std::map<std::set<int>, float>  m_connected_object_groups_resource_output;          ///< cached map from connected group of objects that can share resources, to how much resource is output by ResourceCenters in the group.  regenerated during update from other state information.
-    std::map<std::set<int>, float>  m_connected_object_groups_resource_target_output;   ///< cached map from connected group of objects that can share resources, to how much resource would, if all meters equaled their target meters, be output by ResourceCenters in the group.  regenerated during update from other state information.
+    boost::container::flat_map<int, int> m_system_group_ids;                            ///< number of the group of systems between and in which objects can share this pool's resource, by system id
+    std::vector<ObjectGroup>        m_object_groups;                                    ///< cached groups of objects that can share resources, and how much resource is and would, if all meters equaled their target meters, be output by ResourceCenters in each.  regenerated during update from other state information.
+    boost::container::flat_map<int, int> m_object_group_indices;                        ///< cached index in m_object_groups of the group of each object, by object id
     float                           m_stockpile = 0.0f;                                 ///< current stockpiled amount of resource
     ResourceType                    m_type;                                             ///< what kind of resource does this pool hold?
 
@@ -85,7 +103,7 @@ private:
 };
 
 
-BOOST_CLASS_VERSION(ResourcePool, 1)
+BOOST_CLASS_VERSION(ResourcePool, 2)
 
 
 template <typename Archive>
@@ -98,7 +116,36 @@ void ResourcePool::serialize(Archive& ar, const unsigned int version)
         int dummy = -1;
         ar  & boost::serialization::make_nvp("m_stockpile_object_id", dummy);
     }
-    ar  & BOOST_SERIALIZATION_NVP(m_connected_system_groups);
+    if (version < 2) {
+        // sets of systems, rather than numbers of the groups of systems
+        std::set<std::set<int>> connected_system_groups;
+        ar  & boost::serialization::make_nvp("m_connected_system_groups", connected_system_groups);
+        m_system_group_ids.clear();
+        int group_id = 0;
+        for (const auto& group : connected_system_groups) {
+            for (int system_id : group)
+                m_system_group_ids.emplace(system_id, group_id);
+            ++group_id;
+        }
+    } else {
+        std::vector<int> system_ids;
+        std::vector<int> group_ids;
+        if (Archive::is_saving::value) {
+            system_ids.reserve(m_system_group_ids.size());
+            group_ids.reserve(m_system_group_ids.size());
+            for (const auto& [system_id, group_id] : m_system_group_ids) {
+                system_ids.push_back(system_id);
+                group_ids.push_back(group_id);
+            }
+        }
+        ar  & boost::serialization::make_nvp("m_system_ids", system_ids)
+            & boost::serialization::make_nvp("m_system_group_ids", group_ids);
+        if (Archive::is_loading::value) {
+            m_system_group_ids.clear();
+            for (std::size_t i = 0; i < system_ids.size() && i < group_ids.size(); ++i)
+                m_system_group_ids.emplace(system_ids[i], group_ids[i]);
+        }
+    }
 }
 
 
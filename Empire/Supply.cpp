@@ -1,11 +1,13 @@
 #include "Supply.h"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-#include <boost/graph/connected_components.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <boost/dynamic_bitset.hpp>
 #include "Empire.h"
 #include "EmpireManager.h"
 #include "../universe/Fleet.h"
+#include "../universe/Pathfinder.h"
 #include "../universe/Planet.h"
 #include "../universe/System.h"
 #include "../universe/Universe.h"
@@ -25,6 +27,8 @@ SupplyManager& SupplyManager::operator=(const SupplyManager& rhs) {
         m_supply_starlane_obstructed_traversals = rhs.m_supply_starlane_obstructed_traversals;
         m_fleet_supplyable_system_ids =           rhs.m_fleet_supplyable_system_ids;
         m_resource_supply_groups =                rhs.m_resource_supply_groups;
+        m_resource_supply_group_ids =             rhs.m_resource_supply_group_ids;
+        m_last_update_inputs_valid =              false;
     }
     return *this;
 }
@@ -35,6 +39,8 @@ SupplyManager& SupplyManager::operator=(SupplyManager&& rhs) noexcept {
         m_supply_starlane_obstructed_traversals = std::move(rhs.m_supply_starlane_obstructed_traversals);
         m_fleet_supplyable_system_ids =           std::move(rhs.m_fleet_supplyable_system_ids);
         m_resource_supply_groups =                std::move(rhs.m_resource_supply_groups);
+        m_resource_supply_group_ids =             std::move(rhs.m_resource_supply_group_ids);
+        m_last_update_inputs_valid =              false;
     }
     return *this;
 }
@@ -42,6 +48,7 @@ SupplyManager& SupplyManager::operator=(SupplyManager&& rhs) noexcept {
 namespace {
     const std::set<int> EMPTY_INT_SET;
     const std::set<std::set<int>> EMPTY_INT_SET_SET;
+    const boost::container::flat_map<int, int> EMPTY_GROUP_IDS;
     const std::set<std::pair<int, int>> EMPTY_INT_PAIR_SET;
     const std::map<int, float> EMPTY_INT_FLOAT_MAP;
 }
@@ -112,6 +119,35 @@ const std::set<std::set<int>>& SupplyManager::ResourceSupplyGroups(int empire_id
     return EMPTY_INT_SET_SET;
 }
 
+const boost::container::flat_map<int, int>& SupplyManager::ResourceSupplyGroupIDs(int empire_id) const {
+    auto it = m_resource_supply_group_ids.find(empire_id);
+    if (it != m_resource_supply_group_ids.end())
+        return it->second;
+    return EMPTY_GROUP_IDS;
+}
+
+int SupplyManager::ResourceSupplyGroupID(int empire_id, int system_id) const {
+    const auto& group_ids = ResourceSupplyGroupIDs(empire_id);
+    auto it = group_ids.find(system_id);
+    return it != group_ids.end() ? it->second : -1;
+}
+
+void SupplyManager::UpdateResourceSupplyGroupIDs() {
+    m_resource_supply_group_ids.clear();
+    for (const auto& [empire_id, groups] : m_resource_supply_groups) {
+        std::vector<std::pair<int, int>> system_groups;
+        int group_id = 0;
+        for (const auto& group : groups) {
+            for (int system_id : group)
+                system_groups.emplace_back(system_id, group_id);
+            ++group_id;
+        }
+        std::sort(system_groups.begin(), system_groups.end());
+        m_resource_supply_group_ids[empire_id] = boost::container::flat_map<int, int>(
+            boost::container::ordered_unique_range, system_groups.begin(), system_groups.end());
+    }
+}
+
 const std::map<int, float>& SupplyManager::PropagatedSupplyRanges() const
 { return m_propagated_supply_ranges; }
 
@@ -296,15 +332,60 @@ namespace {
         double dy = obj2->Y() - obj1->Y();
         return static_cast<float>(std::sqrt(dx*dx + dy*dy));
     }
+
+    /** Bonus to break ties between empires' supply ranges in systems where
+      * they own planets: 0.5 for a populated planet or 0.3 for an outpost.
+      * Indexed by system id, then empire id. */
+    std::map<int, std::map<int, float>> SystemPlanetSupplyBonuses() {
+        std::map<int, std::map<int, float>> retval;
+        for (const auto& planet : Objects().all<Planet>()) {
+            if (planet->Unowned() || planet->SystemID() == INVALID_OBJECT_ID)
+                continue;
+            float& bonus = retval[planet->SystemID()][planet->Owner()];
+            bonus = std::max(bonus, planet->SpeciesName().empty() ? 0.3f : 0.5f);
+        }
+        return retval;
+    }
+
+    /** Disjoint sets of the integers 0 to size - 1, used to find which
+      * systems are connected by supply traversals. */
+    class UnionFind {
+    public:
+        explicit UnionFind(std::size_t size) :
+            m_parents(size)
+        { std::iota(m_parents.begin(), m_parents.end(), 0); }
+
+        std::size_t Find(std::size_t element) {
+            while (m_parents[element] != element) {
+                m_parents[element] = m_parents[m_parents[element]];
+                element = m_parents[element];
+            }
+            return element;
+        }
+
+        void Unite(std::size_t lhs, std::size_t rhs) {
+            lhs = Find(lhs);
+            rhs = Find(rhs);
+            if (lhs != rhs)
+                m_parents[std::max(lhs, rhs)] = std::min(lhs, rhs);
+        }
+
+    private:
+        std::vector<std::size_t> m_parents;
+    };
 }
 
-void SupplyManager::Update() {
-    m_supply_starlane_traversals.clear();
-    m_supply_starlane_obstructed_traversals.clear();
-    m_fleet_supplyable_system_ids.clear();
-    m_resource_supply_groups.clear();
-    m_propagated_supply_ranges.clear();
+bool SupplyManager::UpdateInputs::operator==(const UpdateInputs& rhs) const {
+    return system_supply_ranges == rhs.system_supply_ranges &&
+        supply_unobstructed_systems == rhs.supply_unobstructed_systems &&
+        system_supply_range_sums == rhs.system_supply_range_sums &&
+        total_supply_range_sums == rhs.total_supply_range_sums &&
+        visible_starlanes == rhs.visible_starlanes &&
+        system_planet_bonuses == rhs.system_planet_bonuses &&
+        allied_empire_ids == rhs.allied_empire_ids;
+}
 
+void SupplyManager::Update() {
     DebugLogger(supply) << "SupplyManager::Update";
 
     // for each empire, need to get a set of sets of systems that can exchange
@@ -421,26 +502,139 @@ void SupplyManager::Update() {
         }
     }
 
-    std::set<int> systems_with_supply_in_them;
+    std::map<int, std::map<int, float>> system_planet_bonuses = SystemPlanetSupplyBonuses();
+
+    std::set<std::pair<int, int>> allied_empire_ids;
+    for (const auto& entry1 : Empires()) {
+        for (const auto& entry2 : Empires()) {
+            if (entry1.first < entry2.first &&
+                Empires().GetDiplomaticStatus(entry1.first, entry2.first) == DiplomaticStatus::DIPLO_ALLIED)
+            { allied_empire_ids.emplace(entry1.first, entry2.first); }
+        }
+    }
+
+
+    // if nothing that supply is determined from has changed since the last
+    // update, the results of that update still apply
+    UpdateInputs inputs{empire_system_supply_ranges, empire_supply_unobstructed_systems,
+                        empire_system_supply_range_sums, empire_total_supply_range_sums,
+                        empire_visible_starlanes, system_planet_bonuses, allied_empire_ids};
+    if (m_last_update_inputs_valid && inputs == m_last_update_inputs) {
+        DebugLogger(supply) << "SupplyManager::Update: supply sources, obstructions, starlanes, planet ownership and alliances unchanged; keeping previous results";
+        return;
+    }
+    m_last_update_inputs = std::move(inputs);
+    m_last_update_inputs_valid = true;
+
+    m_supply_starlane_traversals.clear();
+    m_supply_starlane_obstructed_traversals.clear();
+    m_fleet_supplyable_system_ids.clear();
+    m_resource_supply_groups.clear();
+    m_propagated_supply_ranges.clear();
+
+
+    // propagation is run over arrays with an entry for each system, indexed as
+    // in the pathfinder's system graph, which is in order of increasing system
+    // id. any systems that aren't in that graph are added in id order too, so
+    // that systems are always processed in the same order.
+    std::vector<int> system_ids = GetUniverse().GetPathfinder()->SystemGraphSystemIDs();
+    {
+        const auto num_graph_systems = system_ids.size();
+        const auto add_if_missing = [&system_ids, num_graph_systems](int system_id) {
+            if (!std::binary_search(system_ids.begin(), system_ids.begin() + num_graph_systems, system_id))
+                system_ids.push_back(system_id);
+        };
+        for (const auto& empire_supply : empire_system_supply_ranges)
+            for (const auto& supply_range : empire_supply.second)
+                add_if_missing(supply_range.first);
+        for (const auto& empire_starlanes : empire_visible_starlanes) {
+            for (const auto& lanes : empire_starlanes.second) {
+                add_if_missing(lanes.first);
+                for (int lane_end_sys_id : lanes.second)
+                    add_if_missing(lane_end_sys_id);
+            }
+        }
+        if (system_ids.size() != num_graph_systems) {
+            std::sort(system_ids.begin(), system_ids.end());
+            system_ids.erase(std::unique(system_ids.begin(), system_ids.end()), system_ids.end());
+        }
+    }
+    const std::size_t num_systems = system_ids.size();
+    const auto system_index = [&system_ids](int system_id) -> std::size_t
+    { return std::lower_bound(system_ids.begin(), system_ids.end(), system_id) - system_ids.begin(); };
+
+    // empires are likewise indexed in order of increasing id
+    std::vector<int> empire_ids;
+    empire_ids.reserve(empire_system_supply_ranges.size());
+    for (const auto& empire_supply : empire_system_supply_ranges)
+        empire_ids.push_back(empire_supply.first);
+    const std::size_t num_empires = empire_ids.size();
+
+    // per-empire unobstructed systems and tie-breaking bonuses for each system
+    std::vector<boost::dynamic_bitset<>> unobstructed_systems(num_empires, boost::dynamic_bitset<>(num_systems));
+    std::vector<float> system_supply_range_sums(num_empires * num_systems, 0.0f);
+    std::vector<float> system_max_supply_range_sums(num_empires * num_systems, 0.0f);
+    std::vector<float> system_planet_bonus(num_empires * num_systems, 0.0f);
+    std::vector<float> total_supply_range_sums(num_empires, 0.0f);
+
+    for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+        int empire_id = empire_ids[empire_idx];
+        for (int system_id : empire_supply_unobstructed_systems[empire_id]) {
+            std::size_t sys_idx = system_index(system_id);
+            if (sys_idx < num_systems && system_ids[sys_idx] == system_id)
+                unobstructed_systems[empire_idx].set(sys_idx);
+        }
+        for (const auto& range_sums : empire_system_supply_range_sums[empire_id]) {
+            std::size_t sys_idx = system_index(range_sums.first);
+            system_supply_range_sums[empire_idx * num_systems + sys_idx] = range_sums.second.first;
+            system_max_supply_range_sums[empire_idx * num_systems + sys_idx] = range_sums.second.second;
+        }
+        total_supply_range_sums[empire_idx] = empire_total_supply_range_sums[empire_id];
+    }
+    for (const auto& sys_bonuses : system_planet_bonuses) {
+        if (!std::binary_search(system_ids.begin(), system_ids.end(), sys_bonuses.first))
+            continue;
+        std::size_t sys_idx = system_index(sys_bonuses.first);
+        for (const auto& empire_bonus : sys_bonuses.second) {
+            auto empire_it = std::lower_bound(empire_ids.begin(), empire_ids.end(), empire_bonus.first);
+            if (empire_it != empire_ids.end() && *empire_it == empire_bonus.first)
+                system_planet_bonus[(empire_it - empire_ids.begin()) * num_systems + sys_idx] = empire_bonus.second;
+        }
+    }
+
+    // propagating supply (range in jumps, and distance to supply source) of
+    // each empire in each system, and which systems each empire has supply in
+    struct PropagatingSupply {
+        std::vector<float>                  ranges;
+        std::vector<float>                  distances;
+        std::vector<boost::dynamic_bitset<>> has_supply;
+    };
+    PropagatingSupply propagating{std::vector<float>(num_empires * num_systems, 0.0f),
+                                  std::vector<float>(num_empires * num_systems, 0.0f),
+                                  std::vector<boost::dynamic_bitset<>>(num_empires, boost::dynamic_bitset<>(num_systems))};
+    // empires that have any unobstructed supply source, which are the only
+    // ones that supply is propagated for
+    std::vector<bool> empire_propagates(num_empires, false);
+
+    boost::dynamic_bitset<> systems_with_supply_in_them(num_systems);
 
     // store (supply range in jumps, and distance to supply source) of all
     // unobstructed systems before propagation, and add to list of systems
     // to propagate from.
-    std::map<int, std::map<int, std::pair<float, float>>> empire_propagating_supply_ranges;
     float max_range = 0.0f;
 
-    for (const auto& empire_supply : empire_system_supply_ranges) {
-        int empire_id = empire_supply.first;
-        const std::set<int>& unobstructed_systems = empire_supply_unobstructed_systems[empire_id];
-
-        for (const auto& supply_range : empire_supply.second) {
-            int system_id = supply_range.first;
-            if (unobstructed_systems.count(system_id)) {
-                // stored: first -> source supply range.  second -> distance to source (0 for the source itself)
-                empire_propagating_supply_ranges[empire_id][system_id] = {supply_range.second, 0.0f};
+    for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+        for (const auto& supply_range : empire_system_supply_ranges[empire_ids[empire_idx]]) {
+            std::size_t sys_idx = system_index(supply_range.first);
+            if (unobstructed_systems[empire_idx].test(sys_idx)) {
+                // stored: source supply range, and distance to source (0 for the source itself)
+                propagating.ranges[empire_idx * num_systems + sys_idx] = supply_range.second;
+                propagating.distances[empire_idx * num_systems + sys_idx] = 0.0f;
+                propagating.has_supply[empire_idx].set(sys_idx);
+                empire_propagates[empire_idx] = true;
                 if (supply_range.second > max_range)
                     max_range = supply_range.second;
-                systems_with_supply_in_them.insert(system_id);
+                systems_with_supply_in_them.set(sys_idx);
             }
         }
     }
@@ -454,59 +648,49 @@ void SupplyManager::Update() {
         TraceLogger(supply) << "Propagating at range " << range_to_spread;
 
         // update systems that have supply in them
-        for (const auto& empire_supply : empire_propagating_supply_ranges) {
-            for (const auto& supply_range : empire_supply.second)
-            { systems_with_supply_in_them.insert(supply_range.first); }
-        }
+        for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx)
+            systems_with_supply_in_them |= propagating.has_supply[empire_idx];
 
 
         // resolve supply fights between multiple empires in one system.
         // pass over all empire-supplied systems, removing supply for all
         // but the empire with the highest supply range in each system
-        for (const auto& sys : Objects().find<System>(systems_with_supply_in_them)) {
-            TraceLogger(supply) << "Determining top supply empire in system " << sys->Name() << " (" << sys->ID() << ")";
+        for (auto sys_idx = systems_with_supply_in_them.find_first();
+             sys_idx != boost::dynamic_bitset<>::npos;
+             sys_idx = systems_with_supply_in_them.find_next(sys_idx))
+        {
+            const int system_id = system_ids[sys_idx];
+            auto sys = Objects().get<System>(system_id);
+            if (!sys)
+                continue;
+            TraceLogger(supply) << "Determining top supply empire in system " << sys->Name() << " (" << system_id << ")";
             // sort empires by range in this system
             std::map<float, std::set<int>> empire_ranges_here;
-            for (auto& empire_supply : empire_propagating_supply_ranges) {
-                int empire_id = empire_supply.first;
-                auto empire_supply_it = empire_supply.second.find(sys->ID());
+            for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
                 // does this empire have any range in this system? if so, store it
-                if (empire_supply_it == empire_supply.second.end())
+                if (!empire_propagates[empire_idx] || !propagating.has_supply[empire_idx].test(sys_idx))
                     continue;
+                const std::size_t entry_idx = empire_idx * num_systems + sys_idx;
 
                 // stuff to break ties...
                 float bonus = 0.0f;
 
                 // empires with planets in system
-                bool has_outpost = false, has_colony = false;
-                for (auto& planet : Objects().find<Planet>(sys->PlanetIDs())) {
-                    if (!planet)
-                        continue;
-                    if (!planet->OwnedBy(empire_id))
-                        continue;
-                    if (!planet->SpeciesName().empty())
-                        has_colony = true;
-                    else
-                        has_outpost = true;
-                }
-                if (has_colony)
-                    bonus += 0.5f;
-                else if (has_outpost)
-                    bonus += 0.3f;
+                bonus += system_planet_bonus[entry_idx];
 
                 // sum of all supply sources in this system
-                bonus += empire_system_supply_range_sums[empire_id][sys->ID()].first / 1000.0f;
+                bonus += system_supply_range_sums[entry_idx] / 1000.0f;
                 // sum of max supply of sourses in this system
-                bonus += empire_system_supply_range_sums[empire_id][sys->ID()].second / 100000.0f;
-                bonus += empire_total_supply_range_sums[empire_id] / 100000000.0f;
+                bonus += system_max_supply_range_sums[entry_idx] / 100000.0f;
+                bonus += total_supply_range_sums[empire_idx] / 100000000.0f;
 
                 // distance to supply source from here
-                float propagated_distance_to_supply_source = std::max(1.0f, empire_supply_it->second.second);
+                float propagated_distance_to_supply_source = std::max(1.0f, propagating.distances[entry_idx]);
                 bonus += propagated_distance_to_supply_source / 10000.0f;
 
                 // store ids of empires indexed by adjusted propgated range, in order to sort by range
-                float propagated_range = empire_supply_it->second.first;
-                empire_ranges_here[propagated_range + bonus].insert(empire_id);
+                float propagated_range = propagating.ranges[entry_idx];
+                empire_ranges_here[propagated_range + bonus].insert(empire_ids[empire_idx]);
             }
 
             if (empire_ranges_here.empty()) {
@@ -570,50 +754,46 @@ void SupplyManager::Update() {
 
             // remove range entries and traversals for all but the top empire
             // (or all empires if there is no single top empire)
-            for (auto& empire_supply : empire_propagating_supply_ranges) {
-                int empire_id = empire_supply.first;
+            for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+                if (!empire_propagates[empire_idx])
+                    continue;
+                int empire_id = empire_ids[empire_idx];
                 if (empire_id == top_range_empire_id)
                     continue;   // this is the top empire, so leave as the sole empire supplying here
 
                 // remove from range entry...
-                auto& empire_ranges = empire_supply.second;
-                empire_ranges.erase(sys->ID());
+                propagating.has_supply[empire_idx].reset(sys_idx);
 
-                TraceLogger(supply) << "... removed empire " << empire_id << " system " << sys->ID() << " supply.";
+                TraceLogger(supply) << "... removed empire " << empire_id << " system " << system_id << " supply.";
 
                 // Remove from unobstructed systems
-                empire_supply_unobstructed_systems[empire_id].erase(sys->ID());
+                unobstructed_systems[empire_idx].reset(sys_idx);
 
                 auto& lane_traversals = m_supply_starlane_traversals[empire_id];
-                auto lane_traversals_initial = lane_traversals;
                 auto& obstructed_traversals = m_supply_starlane_obstructed_traversals[empire_id];
-                auto obstrcuted_traversals_initial = obstructed_traversals;
+
+                // remove obstructed traverals departing from this system
+                obstructed_traversals.erase(obstructed_traversals.lower_bound({system_id, std::numeric_limits<int>::min()}),
+                                            obstructed_traversals.upper_bound({system_id, std::numeric_limits<int>::max()}));
 
                 // remove from traversals departing from or going to this system for this empire,
                 // and set any traversals going to this system as obstructed
-                for (const auto& lane : lane_traversals_initial) {
-                    if (lane.first == sys->ID()) {
-                        lane_traversals.erase({sys->ID(), lane.second});
-                    }
-                    if (lane.second == sys->ID()) {
-                        lane_traversals.erase({lane.first, sys->ID()});
-                        obstructed_traversals.insert({lane.first, sys->ID()});
+                lane_traversals.erase(lane_traversals.lower_bound({system_id, std::numeric_limits<int>::min()}),
+                                      lane_traversals.upper_bound({system_id, std::numeric_limits<int>::max()}));
+                for (auto lane_it = lane_traversals.begin(); lane_it != lane_traversals.end();) {
+                    if (lane_it->second == system_id) {
+                        obstructed_traversals.insert(*lane_it);
+                        lane_it = lane_traversals.erase(lane_it);
+                    } else {
+                        ++lane_it;
                     }
                 }
-
-                // remove obstructed traverals departing from this system
-                for (const auto& lane : obstrcuted_traversals_initial) {
-                    if (lane.first == sys->ID())
-                        obstructed_traversals.erase({lane.first, lane.second});
-                }
             }
 
             //// DEBUG
-            for (auto& empire_supply : empire_propagating_supply_ranges) {
-                auto& system_ranges = empire_supply.second;
-                auto range_it = system_ranges.find(sys->ID());
-                if (range_it != system_ranges.end())
-                    TraceLogger(supply) << " ... after culling empires ranges at system " << sys->ID() << " : " << empire_supply.first << " : " << range_it->second.first;
+            for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+                if (propagating.has_supply[empire_idx].test(sys_idx))
+                    TraceLogger(supply) << " ... after culling empires ranges at system " << system_id << " : " << empire_ids[empire_idx] << " : " << propagating.ranges[empire_idx * num_systems + sys_idx];
             }
             //// END DEBUG
         }
@@ -622,22 +802,28 @@ void SupplyManager::Update() {
             break;
 
         // initialize next iteration with current supply distribution
-        auto empire_propagating_supply_ranges_next = empire_propagating_supply_ranges;
+        auto propagating_next = propagating;
 
 
         // for sources of supply of at least the minimum range for this
         // iteration that are in the current map, give adjacent systems one
         // less supply in the next iteration (unless as much or more is already
         // there)
-        for (const auto& empire_supply : empire_propagating_supply_ranges) {
-            int empire_id = empire_supply.first;
+        for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+            if (!empire_propagates[empire_idx])
+                continue;
+            int empire_id = empire_ids[empire_idx];
             TraceLogger(supply) << ">-< Doing supply propagation for empire " << empire_id << " >-<  at spread range: " << range_to_spread;
-            const auto& prev_sys_ranges = empire_supply.second;
-            const auto& unobstructed_systems = empire_supply_unobstructed_systems[empire_id];
-
-            for (const auto& supply_range : empire_supply.second) {
-                int system_id = supply_range.first;
-                float range = supply_range.second.first;
+            const auto& prev_has_supply = propagating.has_supply[empire_idx];
+            const auto& empire_unobstructed_systems = unobstructed_systems[empire_idx];
+            const auto& empire_starlanes = empire_visible_starlanes[empire_id];
+
+            for (auto sys_idx = prev_has_supply.find_first();
+                 sys_idx != boost::dynamic_bitset<>::npos;
+                 sys_idx = prev_has_supply.find_next(sys_idx))
+            {
+                int system_id = system_ids[sys_idx];
+                float range = propagating.ranges[empire_idx * num_systems + sys_idx];
                 TraceLogger(supply) << " ... for system " << system_id << " with range: " << range;
 
                 // does the source system have the correct supply range to propagate outwards in this iteration?
@@ -646,16 +832,22 @@ void SupplyManager::Update() {
                 float range_after_one_more_jump = range - 1.0f; // what to set adjacent systems' ranges to (at least)
 
                 // how far is this system from a source of supply for this empire?
-                float distance_to_supply_source = supply_range.second.second;
+                float distance_to_supply_source = propagating.distances[empire_idx * num_systems + sys_idx];
 
-                for (int lane_end_sys_id : empire_visible_starlanes[empire_id][system_id])
+                auto lanes_it = empire_starlanes.find(system_id);
+                if (lanes_it == empire_starlanes.end())
+                    continue;
+
+                for (int lane_end_sys_id : lanes_it->second)
                     TraceLogger(supply) << "Propagating from system " << system_id << " to " << lane_end_sys_id
                                         << " range: " << range << " and distance: " << distance_to_supply_source;
 
                 // attempt to propagate to all adjacent systems...
-                for (int lane_end_sys_id : empire_visible_starlanes[empire_id][system_id]) {
+                for (int lane_end_sys_id : lanes_it->second) {
+                    const std::size_t lane_end_idx = system_index(lane_end_sys_id);
+
                     // is propagation to the adjacent system obstructed?
-                    if (!unobstructed_systems.count(lane_end_sys_id)) {
+                    if (!empire_unobstructed_systems.test(lane_end_idx)) {
                         // propagation obstructed!
                         TraceLogger(supply) << "Added obstructed traversal from " << system_id << " to " << lane_end_sys_id << " due to not being on unobstructed systems";
                         m_supply_starlane_obstructed_traversals[empire_id].insert({system_id, lane_end_sys_id});
@@ -666,16 +858,14 @@ void SupplyManager::Update() {
 
                     // does another empire already have as much or more supply here from a previous iteration?
                     float other_empire_biggest_range = -10000.0f;   // arbitrary big numbeer
-                    for (const auto& other_empire_supply : empire_propagating_supply_ranges) {
-                        int other_empire_id = other_empire_supply.first;
-                        if (other_empire_id == empire_id)
+                    for (std::size_t other_empire_idx = 0; other_empire_idx < num_empires; ++other_empire_idx) {
+                        if (other_empire_idx == empire_idx || !empire_propagates[other_empire_idx])
                             continue;
-                        const auto& prev_other_empire_sys_ranges = other_empire_supply.second;
-                        auto prev_other_empire_range_it = prev_other_empire_sys_ranges.find(lane_end_sys_id);
-                        if (prev_other_empire_range_it == prev_other_empire_sys_ranges.end())
+                        if (!propagating.has_supply[other_empire_idx].test(lane_end_idx))
                             continue;
-                        if (prev_other_empire_range_it->second.first > other_empire_biggest_range)
-                            other_empire_biggest_range = prev_other_empire_range_it->second.first;
+                        float prev_other_empire_range = propagating.ranges[other_empire_idx * num_systems + lane_end_idx];
+                        if (prev_other_empire_range > other_empire_biggest_range)
+                            other_empire_biggest_range = prev_other_empire_range;
                     }
 
                     // if so, add a blocked traversal and continue
@@ -693,56 +883,44 @@ void SupplyManager::Update() {
 
                     // if propagating supply would increase the range of the adjacent system,
                     // or decrease the distance to the adjacent system from a supply source...
-                    auto prev_range_it = prev_sys_ranges.find(lane_end_sys_id);
-                    if (prev_range_it == prev_sys_ranges.end()) {
-                        empire_propagating_supply_ranges_next[empire_id][lane_end_sys_id] =
-                            {range_after_one_more_jump, distance_to_supply_source_after_next_lane};
-                        //TraceLogger(supply) << " ... default case: no previous entry.";
+                    const std::size_t lane_end_entry_idx = empire_idx * num_systems + lane_end_idx;
+                    if (!prev_has_supply.test(lane_end_idx)) {
+                        propagating_next.ranges[lane_end_entry_idx] = range_after_one_more_jump;
+                        propagating_next.distances[lane_end_entry_idx] = distance_to_supply_source_after_next_lane;
+                        propagating_next.has_supply[empire_idx].set(lane_end_idx);
 
                     } else {
-                        //TraceLogger(supply) << " ... previous entry values: " << prev_range_it->second.first << " and " << prev_range_it->second.second;
-
-                        if (range_after_one_more_jump > prev_range_it->second.first) {
-                            empire_propagating_supply_ranges_next[empire_id][lane_end_sys_id].first =
-                                range_after_one_more_jump;
-                            //TraceLogger(supply) << " ... range increased!";
-                        }
-                        if (distance_to_supply_source_after_next_lane < prev_range_it->second.second) {
-                            empire_propagating_supply_ranges_next[empire_id][lane_end_sys_id].second =
-                                distance_to_supply_source_after_next_lane;
-                            //TraceLogger(supply) << " ... distance decreased!";
-                        }
+                        if (range_after_one_more_jump > propagating.ranges[lane_end_entry_idx])
+                            propagating_next.ranges[lane_end_entry_idx] = range_after_one_more_jump;
+                        if (distance_to_supply_source_after_next_lane < propagating.distances[lane_end_entry_idx])
+                            propagating_next.distances[lane_end_entry_idx] = distance_to_supply_source_after_next_lane;
                     }
                     // always record a traversal, so connectivity is calculated properly
                     m_supply_starlane_traversals[empire_id].insert({system_id, lane_end_sys_id});
                     TraceLogger(supply) << "Added traversal from " << system_id << " to " << lane_end_sys_id;
 
                     // erase any previous obstructed traversal that just succeeded
-                    if (m_supply_starlane_obstructed_traversals[empire_id].count({system_id, lane_end_sys_id}))
-                    {
-                        //TraceLogger(supply) << "Removed obstructed traversal from " << system_id << " to " << lane_end_sys_id;
-                        m_supply_starlane_obstructed_traversals[empire_id].erase({system_id, lane_end_sys_id});
-                    }
-                    if (m_supply_starlane_obstructed_traversals[empire_id].count({lane_end_sys_id, system_id}))
-                    {
-                        //TraceLogger(supply) << "Removed obstructed traversal from " << lane_end_sys_id << " to " << system_id;
-                        m_supply_starlane_obstructed_traversals[empire_id].erase({lane_end_sys_id, system_id});
-                    }
+                    auto& obstructed_traversals = m_supply_starlane_obstructed_traversals[empire_id];
+                    obstructed_traversals.erase({system_id, lane_end_sys_id});
+                    obstructed_traversals.erase({lane_end_sys_id, system_id});
                 }
             }
         }
 
         // save propagated results for next iteration
-        empire_propagating_supply_ranges = std::move(empire_propagating_supply_ranges_next);
+        propagating = std::move(propagating_next);
     }
 
     //// DEBUG
     TraceLogger(supply) << "SupplyManager::Update: after removing conflicts, empires can provide supply to the following system ids (and ranges in jumps):";
-    for (auto& empire_supply : empire_propagating_supply_ranges) {
-        TraceLogger(supply) << " ... empire " << empire_supply.first << ":  " << [&]() {
+    for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+        if (!empire_propagates[empire_idx])
+            continue;
+        TraceLogger(supply) << " ... empire " << empire_ids[empire_idx] << ":  " << [&]() {
             std::stringstream ss;
-            for (auto& supply_range : empire_supply.second)
-                ss << supply_range.first << " (" << supply_range.second.first << "),  ";
+            const auto& has_supply = propagating.has_supply[empire_idx];
+            for (auto sys_idx = has_supply.find_first(); sys_idx != boost::dynamic_bitset<>::npos; sys_idx = has_supply.find_next(sys_idx))
+                ss << system_ids[sys_idx] << " (" << propagating.ranges[empire_idx * num_systems + sys_idx] << "),  ";
             return ss.str();
         }();
 
@@ -750,24 +928,30 @@ void SupplyManager::Update() {
     //// END DEBUG
 
     // record which systems are fleet supplyable by each empire (after resolving conflicts in each system)
-    for (const auto& empire_supply : empire_propagating_supply_ranges) {
-        int empire_id = empire_supply.first;
-        for (const auto& supply_range : empire_supply.second) {
-            if (supply_range.second.first < 0.0f)
+    for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+        if (!empire_propagates[empire_idx])
+            continue;
+        int empire_id = empire_ids[empire_idx];
+        const auto& has_supply = propagating.has_supply[empire_idx];
+        for (auto sys_idx = has_supply.find_first(); sys_idx != boost::dynamic_bitset<>::npos; sys_idx = has_supply.find_next(sys_idx)) {
+            const int system_id = system_ids[sys_idx];
+            const float range = propagating.ranges[empire_idx * num_systems + sys_idx];
+            const float distance = propagating.distances[empire_idx * num_systems + sys_idx];
+            if (range < 0.0f)
                 continue;   // negative supply doesn't count... zero does (it just reaches)
-            m_fleet_supplyable_system_ids[empire_id].insert(supply_range.first);
+            m_fleet_supplyable_system_ids[empire_id].insert(system_id);
 
             // should be only one empire per system at this point, but use max just to be safe...
-            m_propagated_supply_ranges[supply_range.first] =
-                std::max(supply_range.second.first, m_propagated_supply_ranges[supply_range.first]);
-            m_empire_propagated_supply_ranges[empire_id][supply_range.first] =
-                m_propagated_supply_ranges[supply_range.first];
+            m_propagated_supply_ranges[system_id] =
+                std::max(range, m_propagated_supply_ranges[system_id]);
+            m_empire_propagated_supply_ranges[empire_id][system_id] =
+                m_propagated_supply_ranges[system_id];
 
             // should be only one empire per system at this point, but use max just to be safe...
-            m_propagated_supply_distances[supply_range.first] =
-                std::max(supply_range.second.second, m_propagated_supply_distances[supply_range.first]);
-            m_empire_propagated_supply_distances[empire_id][supply_range.first] =
-                m_propagated_supply_distances[supply_range.first];
+            m_propagated_supply_distances[system_id] =
+                std::max(distance, m_propagated_supply_distances[system_id]);
+            m_empire_propagated_supply_distances[empire_id][system_id] =
+                m_propagated_supply_distances[system_id];
         }
 
         //TraceLogger(supply) << "For empire: " << empire_id << " system supply distances: ";
@@ -837,8 +1021,10 @@ void SupplyManager::Update() {
     // supply-exchanging systems as possible.  This requires finding the
     // connected components of an undirected graph, where the node
     // adjacency are the directly-connected systems determined above.
-    for (const auto& empire_supply : empire_propagating_supply_ranges) {
-        int empire_id = empire_supply.first;
+    for (std::size_t empire_idx = 0; empire_idx < num_empires; ++empire_idx) {
+        if (!empire_propagates[empire_idx])
+            continue;
+        int empire_id = empire_ids[empire_idx];
 
         // assemble all direct connections between systems from remaining traversals
         std::map<int, std::set<int>> supply_groups_map;
@@ -868,55 +1054,38 @@ void SupplyManager::Update() {
         }
 
 
-        // create graph
-        boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> graph;
-
-        // boost expects vertex labels to range from 0 to num vertices - 1, so need
-        // to map from system id to graph id and back when accessing vertices
+        // number the systems from 0 to num systems - 1, so that the connected
+        // groups can be found with a union-find over those numbers
         std::vector<int> graph_id_to_sys_id;
         graph_id_to_sys_id.reserve(supply_groups_map.size());
 
-        std::map<int, int> sys_id_to_graph_id;
-        int graph_id = 0;
+        std::map<int, std::size_t> sys_id_to_graph_id;
         for (auto& supply_group : supply_groups_map) {
-            int sys_id = supply_group.first;
-            boost::add_vertex(graph);   // should add with index = graph_id
-
-            graph_id_to_sys_id.push_back(sys_id);
-            sys_id_to_graph_id[sys_id] = graph_id;
-            ++graph_id;
+            sys_id_to_graph_id.emplace_hint(sys_id_to_graph_id.end(), supply_group.first, graph_id_to_sys_id.size());
+            graph_id_to_sys_id.push_back(supply_group.first);
         }
 
-        // add edges for all direct connections between systems
-        // and add edges from fleet supplyable systems to themselves
+        // join the groups of all directly connected systems
+        UnionFind components(graph_id_to_sys_id.size());
         for (auto& supply_group : supply_groups_map) {
-            int start_graph_id = sys_id_to_graph_id[supply_group.first];
-            for (int system_id : supply_group.second) {
-                int end_graph_id = sys_id_to_graph_id[system_id];
-                boost::add_edge(start_graph_id, end_graph_id, graph);
-            }
+            std::size_t start_graph_id = sys_id_to_graph_id[supply_group.first];
+            for (int system_id : supply_group.second)
+                components.Unite(start_graph_id, sys_id_to_graph_id[system_id]);
         }
 
-        // declare storage and fill with the component id (group id of connected systems)
-        // for each graph vertex
-        std::vector<int> components(boost::num_vertices(graph));
-        boost::connected_components(graph, &components[0]);
-
         // convert results back from graph id to system id, and into desired output format
         // output: std::map<int, std::set<std::set<int>>>& m_resource_supply_groups
 
-        // first, sort into a map from component id to set of system ids in component
-        std::map<int, std::set<int>> component_sets_map;
-        for (std::size_t comp_graph_id = 0; comp_graph_id != components.size(); ++comp_graph_id) {
-            int label = components[comp_graph_id];
-            int sys_id = graph_id_to_sys_id[comp_graph_id];
-            component_sets_map[label].insert(sys_id);
-        }
+        // first, sort into a map from group representative to set of system ids in group
+        std::map<std::size_t, std::set<int>> component_sets_map;
+        for (std::size_t comp_graph_id = 0; comp_graph_id != graph_id_to_sys_id.size(); ++comp_graph_id)
+            component_sets_map[components.Find(comp_graph_id)].insert(graph_id_to_sys_id[comp_graph_id]);
 
         // copy sets in map into set of sets
         for (auto& component_set : component_sets_map)
             m_resource_supply_groups[empire_id].insert(component_set.second);
     }
+    UpdateResourceSupplyGroupIDs();
 
     for (const auto& empire_pair : m_resource_supply_groups) {
         DebugLogger(supply) << "Connected supply groups for empire " << empire_pair.first << ":";
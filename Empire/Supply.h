@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <boost/container/flat_map.hpp>
 #include <boost/serialization/access.hpp>
 #include "../util/Export.h"
 
@@ -41,6 +42,16 @@ public:
     const std::map<int, std::set<std::set<int>>>&           ResourceSupplyGroups() const;
     const std::set<std::set<int>>&                          ResourceSupplyGroups(int empire_id) const;
 
+    /** Returns the number of the group, in the order of
+      * ResourceSupplyGroups(empire_id), that contains each system in one of
+      * the resource supply groups of the empire with id \a empire_id. */
+    const boost::container::flat_map<int, int>&             ResourceSupplyGroupIDs(int empire_id) const;
+
+    /** Returns the number of the resource supply group of the empire with id
+      * \a empire_id that contains the system with id \a system_id, or -1 if
+      * none does. */
+    int                                                     ResourceSupplyGroupID(int empire_id, int system_id) const;
+
     /** Returns the range from each system some empire can propagate supply.*/
     const std::map<int, float>&                             PropagatedSupplyRanges() const;
     /** Returns the range from each system that the empire with id \a empire_id
@@ -65,10 +76,29 @@ public:
 
     /** Calculates systems at which fleets of empires can be supplied, and
       * groups of systems that can exchange resources, and the starlane
-      * traversals used to do so. */
+      * traversals used to do so.  If none of the empires' supply sources,
+      * obstructions, known starlanes, planet ownership or alliances have
+      * changed since the previous call, the previous results are kept. */
     void    Update();
 
 private:
+    /** Numbers the systems in m_resource_supply_groups by group. */
+    void    UpdateResourceSupplyGroupIDs();
+
+    /** Everything that the results of Update() are determined from, so that
+        Update() can tell whether anything has changed since it last ran. */
+    struct UpdateInputs {
+        bool operator==(const UpdateInputs& rhs) const;
+
+        std::map<int, std::map<int, float>>                 system_supply_ranges;
+        std::map<int, std::set<int>>                        supply_unobstructed_systems;
+        std::map<int, std::map<int, std::pair<float, float>>> system_supply_range_sums;
+        std::map<int, float>                                total_supply_range_sums;
+        std::map<int, std::map<int, std::set<int>>>         visible_starlanes;
+        std::map<int, std::map<int, float>>                 system_planet_bonuses;  ///< indexed by system id, then empire id
+        std::set<std::pair<int, int>>                       allied_empire_ids;
+    };
+
     /** ordered pairs of system ids between which a starlane runs that can be
         used to convey resources between systems. indexed first by empire id. */
     std::map<int, std::set<std::pair<int, int>>>    m_supply_starlane_traversals;
@@ -87,6 +117,10 @@ private:
         by empire id. */
     std::map<int, std::set<std::set<int>>>          m_resource_supply_groups;
 
+    /** number of the group in m_resource_supply_groups that contains each
+        system, indexed by empire id and then by system id. not serialized. */
+    std::map<int, boost::container::flat_map<int, int>> m_resource_supply_group_ids;
+
     /** for whichever empire can propagate supply into this system, what is the
         additional range from this system that empire can propagate supply */
     std::map<int, float>                            m_propagated_supply_ranges;
@@ -108,6 +142,10 @@ private:
       * obstructed system) */
     std::map<int, std::map<int, float>>             m_empire_propagated_supply_distances;
 
+    /** inputs to the most recent Update(), if the results haven't since been
+        replaced by assignment or deserialization. not serialized. */
+    UpdateInputs                                    m_last_update_inputs;
+    bool                                            m_last_update_inputs_valid = false;
 
     friend class boost::serialization::access;
     template <typename Archive>
@@ -33,7 +33,9 @@ class TextControl;
     called.  The Wnd* parameter passed in this call is the window about which
     the BrowseInfoWnd is displaying info (the target Wnd); the BrowseInfoWnd
     can collect whatever information it requires from the target Wnd before it
-    is rendered.  Note that a BrowseInfoWnd should never be INTERACTIVE. */
+    is rendered.  A BrowseInfoWnd is only prerendered and updated while it is
+    displayed, so subclasses can defer generating their contents until
+    then.  Note that a BrowseInfoWnd should never be INTERACTIVE. */
 class GG_API BrowseInfoWnd : public Wnd
 {
 public:
@@ -71,6 +71,7 @@ public:
 
     void Show() override;
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
     void SizeMove(const Pt& ul, const Pt& lr) override;
 
     /** Sets the control's color; does not affect the text color. */
@@ -337,6 +338,7 @@ public:
     mutable ButtonChangedSignalType ButtonChangedSignal; ///< The button changed signal object for this RadioButtonGroup
 
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     /** Checks the index-th button, and unchecks all others.  If there is no
         index-th button, they are all unchecked, and the currently-checked
@@ -0,0 +1,159 @@
+//! GiGi - A GUI for OpenGL
+//!
+//!  Copyright (C) 2021 The FreeOrion Project
+//!
+//! Released under the GNU Lesser General Public License 2.1 or later.
+//! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
+//! SPDX-License-Identifier: LGPL-2.1-or-later
+
+//! @file GG/DrawBatch.h
+//!
+//! Contains the DrawBatch class, which collects the 2D geometry drawn by the
+//! GG drawing utilities and draws it with as few draw calls as possible.
+
+#ifndef _GG_DrawBatch_h_
+#define _GG_DrawBatch_h_
+
+
+#include <vector>
+#include <GG/Base.h>
+
+
+namespace GG {
+
+class GL2DVertexBuffer;
+class GLRGBAColorBuffer;
+class GLTexCoordBuffer;
+
+/** \brief Collects 2D geometry and draws it with as few draw calls as
+    possible.
+
+    The GG drawing utilities, and the text of TextControls, add their geometry
+    to the batch as triangles or lines with a color per vertex.  While the
+    batch is active, ie between the outermost Begin() and End(), geometry is
+    collected until End(), or until geometry that needs a different primitive,
+    texture or line width is added, or Flush() is called; it is then drawn
+    from one streaming vertex buffer with one draw call.  While the batch is
+    not active, geometry is drawn as soon as the utility adding it is done.
+
+    Geometry is drawn with the modelview and projection matrices, clipping,
+    blending and other GL state current when it is flushed, not when it was
+    added, so anything that changes that state or draws with GL directly must
+    flush the batch first.  GG does so when clipping, blitting textures,
+    rendering uncached text and activating GL buffers; GUI flushes the batch
+    before the Render() of each Wnd that does not declare with
+    Wnd::BatchesRendering() that it does so itself. */
+class GG_API DrawBatch
+{
+public:
+    /** Begins collecting geometry.  Calls may be nested; the batch is drawn on
+        the outermost End(). */
+    void Begin() noexcept { ++m_depth; }
+    void End();
+
+    /** Returns true between Begin() and End(). */
+    bool Active() const noexcept { return m_depth > 0; }
+
+    /** Draws and clears the geometry collected so far. */
+    void Flush();
+
+    /** Adds the \a count vertices of \a vertices starting at \a first, as
+        glDrawArrays(\a mode, \a first, \a count) would draw them, in \a color.
+        \a mode may be any of the triangle, quad, polygon or line modes; lines
+        are \a line_width wide. */
+    void AddArrays(GLenum mode, const GL2DVertexBuffer& vertices, std::size_t first,
+                   std::size_t count, Clr color, float line_width = 1.0f);
+
+    /** Adds the \a count vertices of \a vertices starting at \a first, as
+        glDrawArrays(\a mode, \a first, \a count) would draw them, in the colors
+        of \a colors. */
+    void AddArrays(GLenum mode, const GL2DVertexBuffer& vertices, const GLRGBAColorBuffer& colors,
+                   std::size_t first, std::size_t count, float line_width = 1.0f);
+
+    /** Adds the \a count vertices of \a vertices starting at \a first, offset
+        by \a offset, textured with \a texture at \a tex_coords, in the colors
+        of \a colors. */
+    void AddTexturedArrays(GLenum mode, GLuint texture, const GL2DVertexBuffer& vertices,
+                           const GLTexCoordBuffer& tex_coords, const GLRGBAColorBuffer& colors,
+                           std::size_t first, std::size_t count, Pt offset = Pt());
+
+private:
+    /** The primitive the batch is drawn as. */
+    enum class Primitive : GLenum {
+        TRIANGLES = GL_TRIANGLES,
+        LINES = GL_LINES
+    };
+
+    struct Vertex {
+        GLfloat x, y;
+        GLfloat u, v;
+        GLubyte r, g, b, a;
+    };
+
+    DrawBatch();
+
+    /** Flushes the batch if it has geometry that is drawn with a different
+        primitive, texture or line width, and sets them for what is added
+        next. */
+    void SetState(Primitive primitive, GLuint texture, float line_width);
+
+    /** Appends the indices into the arrays of the vertices of the triangles
+        or lines that \a mode draws from \a count vertices to m_indices, and
+        returns the primitive they are drawn as. */
+    Primitive Decompose(GLenum mode, std::size_t count);
+
+    void AddImpl(GLenum mode, const float* vertices, const float* tex_coords,
+                 const unsigned char* colors, std::size_t count, Clr color,
+                 GLuint texture, float line_width, Pt offset);
+
+    std::size_t             m_depth = 0;
+    std::vector<Vertex>     m_vertices;
+    std::vector<std::size_t> m_indices;
+    Primitive               m_primitive = Primitive::TRIANGLES;
+    GLuint                  m_texture = 0;
+    float                   m_line_width = 1.0f;
+    GLuint                  m_buffer = 0;
+
+    friend GG_API DrawBatch& GetDrawBatch();
+    friend class DrawBatchSuspension;
+};
+
+/** Returns the singleton DrawBatch instance. */
+GG_API DrawBatch& GetDrawBatch();
+
+/** Begins the draw batch on construction and ends it on destruction. */
+class ScopedDrawBatch
+{
+public:
+    ScopedDrawBatch() noexcept { GetDrawBatch().Begin(); }
+    ~ScopedDrawBatch() { GetDrawBatch().End(); }
+
+    ScopedDrawBatch(const ScopedDrawBatch&) = delete;
+    ScopedDrawBatch& operator=(const ScopedDrawBatch&) = delete;
+};
+
+/** Flushes the draw batch and makes it inactive for its lifetime, so that
+    anything drawn meanwhile is drawn as soon as it is added. */
+class DrawBatchSuspension
+{
+public:
+    DrawBatchSuspension() :
+        m_depth(GetDrawBatch().m_depth)
+    {
+        GetDrawBatch().Flush();
+        GetDrawBatch().m_depth = 0;
+    }
+    ~DrawBatchSuspension()
+    { GetDrawBatch().m_depth = m_depth; }
+
+    DrawBatchSuspension(const DrawBatchSuspension&) = delete;
+    DrawBatchSuspension& operator=(const DrawBatchSuspension&) = delete;
+
+private:
+    std::size_t m_depth;
+};
+
+}
+
+
+#endif
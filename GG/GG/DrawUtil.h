@@ -10,7 +10,8 @@
 //! @file GG/DrawUtil.h
 //!
 //! Contains numerous 2D rendering convenience functions, for rendering
-//! rectangles, circles, etc.
+//! rectangles, circles, etc.  The functions taking colors add their geometry
+//! to the DrawBatch; those drawing in the current GL color draw immediately.
 
 #ifndef _GG_DrawUtil_h_
 #define _GG_DrawUtil_h_
@@ -522,6 +522,11 @@ public:
     /** Render the glyphs from the \p cache.*/
     void RenderCachedText(RenderCache& cache) const;
 
+    /** Adds the glyphs from the \p cache, offset by \p offset, to the
+        DrawBatch instead of rendering them with the current modelview
+        matrix. */
+    void BatchCachedText(const RenderCache& cache, Pt offset) const;
+
     /** Sets \a render_state as if all the text before (<i>begin_line</i>,
         <i>begin_char</i>) had just been rendered. */
     void ProcessTagsBefore(const std::vector<LineData>& line_data, RenderState& render_state,
@@ -0,0 +1,125 @@
+//! GiGi - A GUI for OpenGL
+//!
+//!  Copyright (C) 2021 The FreeOrion Project
+//!
+//! Released under the GNU Lesser General Public License 2.1 or later.
+//! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
+//! SPDX-License-Identifier: LGPL-2.1-or-later
+
+//! @file GG/FrameProfiler.h
+//!
+//! Contains the FrameProfiler class, which collects per-frame rendering
+//! statistics of the GUI.
+
+#ifndef _GG_FrameProfiler_h_
+#define _GG_FrameProfiler_h_
+
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <GG/Base.h>
+
+
+namespace GG {
+
+class Wnd;
+
+/** \brief Collects per-frame rendering statistics of the GUI.
+
+    While enabled, GUI times the PreRender() and Render() of each top-level
+    Wnd, and measures the GPU time of its rendering with timer queries where
+    the GL implementation supports them.  The texture blits, text rendering
+    and buffer uploads of GG count their draw calls, texture binds and buffer
+    uploads here; GL calls made directly by application code are only counted
+    if it calls the Count functions as well. */
+class GG_API FrameProfiler
+{
+public:
+    using Duration = std::chrono::microseconds;
+
+    /** Time spent in a top-level Wnd and its descendents. */
+    struct WndTime {
+        std::string name;
+        Duration    prerender{0};
+        Duration    render{0};
+    };
+
+    struct FrameStats {
+        std::size_t             frame = 0;
+        Duration                prerender{0};
+        Duration                render{0};
+        /** GPU time of GUI::Render(), in ms, or negative if not known.  As
+            timer query results are read a few frames late to avoid stalling
+            the pipeline, this is for an earlier frame. */
+        double                  gpu_ms = -1.0;
+        std::size_t             draw_calls = 0;
+        std::size_t             texture_binds = 0;
+        std::size_t             buffer_uploads = 0;
+        std::vector<WndTime>    wnds;
+    };
+
+    bool Enabled() const noexcept { return m_enabled || m_trace_frames_left; }
+
+    /** Returns the statistics of the last completed frame. */
+    const FrameStats& LastFrame() const noexcept { return m_last_frame; }
+
+    /** Enables or disables the collection of statistics. */
+    void SetEnabled(bool enabled);
+
+    /** Records the next \a frames frames and then writes them to \a path as
+        tab-separated text.  Statistics are collected until then, even if
+        profiling is not enabled. */
+    void TraceFrames(std::size_t frames, std::string path);
+
+    void CountDrawCall(std::size_t n = 1) noexcept      { m_current.draw_calls += n; }
+    void CountTextureBind(std::size_t n = 1) noexcept   { m_current.texture_binds += n; }
+    void CountBufferUpload(std::size_t n = 1) noexcept  { m_current.buffer_uploads += n; }
+
+    /** Called by GUI around its PreRender() and Render(). */
+    void BeginPreRender();
+    void EndPreRender();
+    void BeginRender();
+    void EndRender();
+
+    /** Called by GUI with the time spent pre-rendering or rendering the
+        top-level Wnd \a wnd. */
+    void AddPreRenderTime(const Wnd& wnd, Duration time);
+    void AddRenderTime(const Wnd& wnd, Duration time);
+
+private:
+    FrameProfiler() = default;
+
+    WndTime& TimeOf(const Wnd& wnd);
+    void ReadGPUTime();
+    void WriteTrace() const;
+
+    static constexpr std::size_t NUM_QUERIES = 4;
+
+    bool                                m_enabled = false;
+    FrameStats                          m_current;
+    FrameStats                          m_last_frame;
+    std::size_t                         m_frame = 0;
+    std::chrono::steady_clock::time_point m_section_start;
+
+    std::array<GLuint, NUM_QUERIES>     m_queries{};
+    std::array<bool, NUM_QUERIES>       m_query_pending{};
+    std::size_t                         m_next_query = 0;
+    bool                                m_query_active = false;
+    double                              m_last_gpu_ms = -1.0;
+
+    std::size_t                         m_trace_frames_left = 0;
+    std::string                         m_trace_path;
+    std::vector<FrameStats>             m_trace;
+
+    friend GG_API FrameProfiler& GetFrameProfiler();
+};
+
+/** Returns the singleton FrameProfiler instance. */
+GG_API FrameProfiler& GetFrameProfiler();
+
+}
+
+
+#endif
@@ -55,6 +55,9 @@ public:
     std::size_t size() const;
     bool        empty() const;
 
+    // the stored item data, which is kept while a server buffer exists
+    const std::vector<vtype>& data() const noexcept { return b_data; }
+
     // pre-allocate space for item data
     void reserve(std::size_t num_items);
 
@@ -72,6 +75,12 @@ public:
     // clears the client side buffer
     void clear();
 
+    // returns true if both buffers store the same items
+    bool sameData(const GLClientAndServerBufferBase& other) const;
+
+    // exchanges stored items and server buffers with other
+    void swap(GLClientAndServerBufferBase& other);
+
 protected:
     std::vector<vtype>  b_data;
     std::size_t         b_size = 0;
@@ -79,7 +88,9 @@ protected:
 
     // used in derived classes to activate the buffer
     // implementations should use glBindBuffer, gl...Pointer if
-    // server buffer exists (b_name! = 0), just gl...Pointer otherwise
+    // server buffer exists (b_name! = 0), just gl...Pointer otherwise,
+    // and flush the draw batch first, so that what is drawn from the
+    // buffer is drawn after any geometry batched before it
     virtual void activate() const = 0;
 };
 
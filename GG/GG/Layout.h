@@ -120,6 +120,7 @@ public:
     void ChildrenDraggedAway(const std::vector<Wnd*>& wnds, const Wnd* destination) override;
     void SizeMove(const Pt& ul, const Pt& lr) override;
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     //! Inserts \a w into the layout in the indicated cell, expanding the
     //! layout grid as necessary.  \throw GG::Layout::AttemptedOverwrite
@@ -139,6 +139,7 @@ public:
         bool         IsNormalized() const;
 
         void         Render() override;
+        bool         BatchesRendering() const noexcept override { return true; }
 
         void         push_back(std::shared_ptr<Control> c); ///< adds a given Control to the end of the Row; this Control becomes property of the Row
         void         clear(); ///< removes and deletes all cells in this Row
@@ -313,6 +314,7 @@ public:
     void ChildrenDraggedAway(const std::vector<Wnd*>& wnds, const Wnd* destination) override;
     void PreRender() override;
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     /** Resizes the control, then resizes the scrollbars as needed. */
     void SizeMove(const Pt& ul, const Pt& lr) override;
@@ -502,6 +504,12 @@ protected:
     void Insert(const std::vector<std::shared_ptr<Row>>& rows, iterator it, bool dropped);
     void Insert(std::vector<std::shared_ptr<Row>>&& rows, iterator it, bool dropped);
 
+    /** Sorts \a rows and merges them into the sorted list, giving the same
+        order as inserting them one at a time, but comparing each row with
+        only about log(n) others.  All BeforeInsertRowSignals are emitted
+        before the merge, and all AfterInsertRowSignals after it. */
+    void InsertSorted(std::vector<std::shared_ptr<Row>>&& rows, iterator it);
+
     std::shared_ptr<Row> Erase(iterator it, bool removing_duplicate, bool signal); ///< erases the row at index \a idx, handling it as a duplicate removal (such as for drag-and-drops within a single ListBox) if indicated
     void BringCaretIntoView();  ///< makes sure caret is visible when scrolling occurs due to keystrokes etc.
     void ResetAutoScrollVars(); ///< resets all variables related to auto-scroll to their initial values
@@ -73,6 +73,7 @@ public:
     const boost::filesystem::path& GetTexturePath() const;
 
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     /** Sets the style flags, and perfroms sanity checking \see
         GraphicStyle */
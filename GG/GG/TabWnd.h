@@ -188,6 +188,7 @@ public:
     void MouseWheel(const Pt& pt, int move, Flags<ModKey> mod_keys) override;
     void SizeMove(const Pt& ul, const Pt& lr) override;
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     virtual void DoLayout();
 
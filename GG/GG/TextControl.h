@@ -180,6 +180,7 @@ public:
     Pt TextLowerRight() const;
 
     void Render() override;
+    bool BatchesRendering() const noexcept override { return true; }
 
     void SizeMove(const Pt& ul, const Pt& lr) override;
 
@@ -21,7 +21,11 @@
 #include <boost/filesystem/path.hpp>
 #include <GG/Base.h>
 #include <GG/Exception.h>
+#include <chrono>
+#include <future>
+#include <map>
 #include <mutex>
+#include <vector>
 
 
 namespace GG {
@@ -91,12 +95,30 @@ public:
         corner)*/
     void OrthoBlit(const Pt& pt) const;
 
+    /** Pixel data read from an image file, which can be decoded on any
+        thread and then loaded into a Texture on the OpenGL thread. */
+    struct DecodedImage {
+        boost::filesystem::path    path;
+        X                          width = GG::X0;
+        Y                          height = GG::Y0;
+        unsigned int               bytes_pp = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    /** Reads and decodes image file \a path, without using OpenGL.  \throw
+        GG::Texture::BadFile Throws if the file cannot be decoded. */
+    static DecodedImage Decode(const boost::filesystem::path& path);
+
     // intialization functions
     /** Frees any currently-held memory and loads a texture from file \a
         path.  \throw GG::Texture::BadFile Throws if the texture creation
         fails. */
     void Load(const boost::filesystem::path& path, bool mipmap = false);
 
+    /** Frees any currently-held memory and creates a texture from \a image,
+        as returned by Decode(). */
+    void Load(const DecodedImage& image, bool mipmap = false);
+
     /** Frees any currently-held memory and creates a texture from supplied
         array \a image.  \throw GG::Texture::Exception Throws applicable
         subclass if the texture creation fails in one of the specified
@@ -104,6 +126,11 @@ public:
     void Init(X width, Y height, const unsigned char* image, GLenum format, GLenum type,
               unsigned int bytes_per_pixel, bool mipmap = false);
 
+    /** Replaces the \a width x \a height region of the texture with upper
+        left corner at \a x, \a y with \a image, which must have this
+        texture's format and type. */
+    void SetSubImage(X x, Y y, X width, Y height, const unsigned char* image);
+
     void SetFilters(GLenum min, GLenum mag);  ///< sets the opengl min/mag filter modes associated with opengl texture m_opengl_id
     void Clear();  ///< frees the opengl texture object associated with this object
 
@@ -235,9 +262,39 @@ public:
 
     /** Returns a shared_ptr to the texture created from image file \a path.
         If the texture is not present in the manager's pool, it will be loaded
-        from disk. */
+        from disk.  If it is still being loaded in the background, loading is
+        completed before returning. */
     std::shared_ptr<Texture> GetTexture(const boost::filesystem::path& path, bool mipmap = false);
 
+    /** Returns a shared_ptr to the texture created from image file \a path,
+        without waiting for it to be loaded.  If the texture is not present in
+        the manager's pool, an empty placeholder texture is returned, the
+        image is decoded on a worker thread, and the placeholder is then
+        filled in by UploadPendingTextures(). */
+    std::shared_ptr<Texture> GetTextureAsync(const boost::filesystem::path& path, bool mipmap = false);
+
+    /** Starts decoding the images files in \a paths that aren't yet in the
+        manager's pool on worker threads, so that they are ready when later
+        requested. */
+    void                     PrefetchTextures(const std::vector<boost::filesystem::path>& paths,
+                                              bool mipmap = false);
+
+    /** Creates the OpenGL textures for images that have finished decoding
+        in the background, until \a budget has elapsed.  Must be called from
+        the OpenGL thread, and is called by GUI::Render() every frame. */
+    void                     UploadPendingTextures(std::chrono::microseconds budget =
+                                                   std::chrono::microseconds(4000));
+
+    /** Sets the largest images loaded from files that are also packed into
+        shared atlas textures.  Atlasing is disabled while either is zero,
+        which is the default. */
+    void                     SetMaxAtlasedSize(X width, Y height);
+
+    /** Returns the region of an atlas texture holding the same image as \a
+        texture, so that icons drawn from it share one OpenGL texture, or an
+        empty SubTexture if \a texture was not packed into an atlas. */
+    SubTexture               AtlasedTexture(const Texture& texture) const;
+
     /** Removes the manager's shared_ptr to the texture created from image
         file \a path, if it exists.  \note Due to shared_ptr semantics, the
         texture may not be deleted until much later. */
@@ -252,10 +309,48 @@ private:
     TextureManager();
     std::shared_ptr<Texture> LoadTexture(const boost::filesystem::path& path, bool mipmap);
 
+    /** Image files to decode on a worker thread, and where to put them. */
+    using DecodeQueue = std::vector<std::pair<boost::filesystem::path, std::promise<Texture::DecodedImage>>>;
+
+    std::shared_ptr<Texture> StartLoadingTexture(const boost::filesystem::path& path, bool mipmap,
+                                                 DecodeQueue& decodes);
+    void                     StartDecoding(DecodeQueue&& decodes);
+    void                     FinishLoadingTexture(const std::string& name);
+    void                     AddToAtlas(const std::string& name, const Texture::DecodedImage& image,
+                                        bool mipmap);
+
+    /** A placeholder texture whose image is being decoded in the
+        background. */
+    struct PendingTexture {
+        std::shared_ptr<Texture>            texture;
+        std::future<Texture::DecodedImage>  image;
+        bool                                mipmap = false;
+    };
+
     /** Indexed by string, not path, because some textures may be stored by a
         name and not loaded from a path. */
     std::map<std::string, std::shared_ptr<Texture>> m_textures;
 
+    /** Textures in m_textures that are still placeholders, by name. */
+    std::map<std::string, PendingTexture> m_pending_textures;
+
+    /** Worker tasks decoding images for m_pending_textures. */
+    std::vector<std::future<void>> m_decode_tasks;
+
+    /** A large RGBA texture into which small images are packed in rows. */
+    struct AtlasPage {
+        std::shared_ptr<Texture> texture;
+        bool mipmap = false;
+        X    row_x = GG::X0;        ///< left of the next image in the current row
+        Y    row_y = GG::Y0;        ///< top of the current row
+        Y    row_height = GG::Y0;   ///< height of the tallest image in the current row
+    };
+
+    std::vector<AtlasPage>              m_atlas_pages;
+    std::map<std::string, SubTexture>   m_atlased_textures;
+    X                                   m_max_atlased_width = GG::X0;
+    Y                                   m_max_atlased_height = GG::Y0;
+
     mutable std::mutex m_texture_access_guard;
 
     friend GG_API TextureManager& GetTextureManager();
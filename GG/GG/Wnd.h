@@ -470,10 +470,26 @@ public:
         window's client area. */
     virtual bool InClient(const Pt& pt) const;
 
+    /** Returns a screen-coordinate rectangle that contains every point for
+        which InWindow() returns true.  This is the window's rectangle by
+        default; windows that override InWindow() to also accept points
+        outside of it should override this as well. */
+    virtual Rect PickBounds() const;
+
     /** Returns child list; the list is const, but the children may be
         manipulated. */
     const std::list<std::shared_ptr<Wnd>>& Children() const;
 
+    /** Returns true iff this window indexes its children by location, for
+        picking.  \see SetChildPickIndexing(). */
+    bool ChildPickIndexing() const;
+
+    /** Returns the children whose PickBounds() contain screen-coordinate
+        point \a pt, the last-rendered (topmost) first.  Returns the same
+        children as filtering Children() would, but if ChildPickIndexing(),
+        only examines the children near \a pt. */
+    std::vector<std::shared_ptr<Wnd>> ChildrenInPickBounds(const Pt& pt) const;
+
     /** Returns the window's parent (may be null). */
     std::shared_ptr<Wnd> Parent() const;
 
@@ -578,6 +594,14 @@ public:
         its parent, for clipping purposes.  \see ChildClippingMode. */
     void NonClientChild(bool b);
 
+    /** Sets whether this Wnd indexes its children by the location of their
+        PickBounds(), so that finding the children under a point, as is done
+        for every mouse move, does not examine every child.  The index is
+        rebuilt when it is next used, after any child is attached, detached,
+        reordered, moved or resized.  Useful for windows with many
+        children. */
+    void SetChildPickIndexing(bool b);
+
     void MoveTo(const Pt& pt);     ///< Moves upper-left corner of window to \a pt.
     void OffsetMove(const Pt& pt); ///< Moves window by \a pt pixels.
 
@@ -693,6 +717,13 @@ public:
         GUI::GetGUI()->RenderingDragDropWnds(). */
     virtual void Render();
 
+    /** Returns true if Render() draws only with the GG drawing utilities,
+        Fonts and Textures, or flushes the DrawBatch before drawing with GL
+        directly or changing GL state.  GUI collects what such Wnds draw in
+        the DrawBatch, rather than drawing it as each Wnd is rendered; the
+        Render() of other Wnds is called with the batch suspended. */
+    virtual bool BatchesRendering() const noexcept { return false; }
+
     /** This executes a modal window and gives it its modality.  For non-modal
         windows, this function is a no-op.  It returns false if the window is
         non-modal, or true after successful modal execution.*/
@@ -994,6 +1025,12 @@ protected:
     virtual void DetachChildCore(Wnd* wnd);
 
 private:
+    class ChildPickIndex;
+
+    /** Discards the index of children for picking, if there is one, so that
+        it is rebuilt when next used. */
+    void InvalidateChildPickIndex() noexcept;
+
     /// m_parent may be expired or null if there is no parent.  m_parent will reset itself if expired.
     mutable std::weak_ptr<Wnd>      m_parent;
     std::string                     m_name;                     ///< A user-significant name for this Wnd
@@ -1018,6 +1055,9 @@ private:
     mutable std::weak_ptr<Layout>   m_containing_layout;        ///< The layout that contains this Wnd, if any
     std::vector<BrowseInfoMode>     m_browse_modes;             ///< The browse info modes for this window
 
+    /** Index of children by location, if SetChildPickIndexing(true). */
+    std::unique_ptr<ChildPickIndex> m_child_pick_index;
+
     /** The style factory to use when creating dialogs or child controls. */
     std::shared_ptr<StyleFactory>   m_style_factory;
 
@@ -0,0 +1,210 @@
+//! GiGi - A GUI for OpenGL
+//!
+//!  Copyright (C) 2021 The FreeOrion Project
+//!
+//! Released under the GNU Lesser General Public License 2.1 or later.
+//! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
+//! SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cstddef>
+#include <GG/DrawBatch.h>
+#include <GG/FrameProfiler.h>
+#include <GG/GLClientAndServerBuffer.h>
+
+
+using namespace GG;
+
+namespace {
+    /** Vertices reserved for the batch, enough for most frames' worth of
+        controls and text without reallocating. */
+    constexpr std::size_t INITIAL_CAPACITY = 1 << 16;
+}
+
+DrawBatch::DrawBatch()
+{
+    m_vertices.reserve(INITIAL_CAPACITY);
+    m_indices.reserve(INITIAL_CAPACITY);
+}
+
+void DrawBatch::End()
+{
+    if (m_depth && !--m_depth)
+        Flush();
+}
+
+void DrawBatch::Flush()
+{
+    if (m_vertices.empty())
+        return;
+
+    const bool textured = m_texture != 0;
+
+    // the batch may be flushed between any two GL calls of the code around
+    // it, so restores all the state it changes
+    glPushAttrib(GL_CURRENT_BIT | GL_ENABLE_BIT | GL_LINE_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+    GLint previous_texture = 0;
+    if (textured) {
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous_texture);
+        glBindTexture(GL_TEXTURE_2D, m_texture);
+        GetFrameProfiler().CountTextureBind();
+    }
+    if (textured)
+        glEnable(GL_TEXTURE_2D);
+    else
+        glDisable(GL_TEXTURE_2D);
+    if (m_primitive == Primitive::LINES)
+        glLineWidth(m_line_width);
+
+    if (!m_buffer)
+        glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    // respecifying the whole store orphans the one drawn by the last flush,
+    // so the driver need not wait for that draw to finish
+    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex),
+                 m_vertices.data(), GL_STREAM_DRAW);
+    GetFrameProfiler().CountBufferUpload();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex),
+                    reinterpret_cast<const GLvoid*>(offsetof(Vertex, x)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex),
+                   reinterpret_cast<const GLvoid*>(offsetof(Vertex, r)));
+    if (textured) {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(Vertex, u)));
+    } else {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+
+    glDrawArrays(static_cast<GLenum>(m_primitive), 0, static_cast<GLsizei>(m_vertices.size()));
+    GetFrameProfiler().CountDrawCall();
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (textured)
+        glBindTexture(GL_TEXTURE_2D, previous_texture);
+
+    glPopClientAttrib();
+    glPopAttrib();
+
+    m_vertices.clear();
+}
+
+void DrawBatch::AddArrays(GLenum mode, const GL2DVertexBuffer& vertices, std::size_t first,
+                          std::size_t count, Clr color, float line_width)
+{
+    AddImpl(mode, vertices.data().data() + 2 * first, nullptr, nullptr,
+            count, color, 0, line_width, Pt());
+}
+
+void DrawBatch::AddArrays(GLenum mode, const GL2DVertexBuffer& vertices, const GLRGBAColorBuffer& colors,
+                          std::size_t first, std::size_t count, float line_width)
+{
+    AddImpl(mode, vertices.data().data() + 2 * first, nullptr, colors.data().data() + 4 * first,
+            count, Clr(), 0, line_width, Pt());
+}
+
+void DrawBatch::AddTexturedArrays(GLenum mode, GLuint texture, const GL2DVertexBuffer& vertices,
+                                  const GLTexCoordBuffer& tex_coords, const GLRGBAColorBuffer& colors,
+                                  std::size_t first, std::size_t count, Pt offset)
+{
+    AddImpl(mode, vertices.data().data() + 2 * first, tex_coords.data().data() + 2 * first,
+            colors.data().data() + 4 * first, count, Clr(), texture, 1.0f, offset);
+}
+
+void DrawBatch::SetState(Primitive primitive, GLuint texture, float line_width)
+{
+    if (primitive != Primitive::LINES)
+        line_width = m_line_width;
+    if (primitive == m_primitive && texture == m_texture && line_width == m_line_width)
+        return;
+    Flush();
+    m_primitive = primitive;
+    m_texture = texture;
+    m_line_width = line_width;
+}
+
+DrawBatch::Primitive DrawBatch::Decompose(GLenum mode, std::size_t count)
+{
+    m_indices.clear();
+    switch (mode) {
+    case GL_TRIANGLES:
+        for (std::size_t i = 0; i + 2 < count; i += 3)
+            m_indices.insert(m_indices.end(), {i, i + 1, i + 2});
+        return Primitive::TRIANGLES;
+    case GL_TRIANGLE_STRIP:
+        for (std::size_t i = 0; i + 2 < count; ++i) {
+            if (i % 2)
+                m_indices.insert(m_indices.end(), {i + 1, i, i + 2});
+            else
+                m_indices.insert(m_indices.end(), {i, i + 1, i + 2});
+        }
+        return Primitive::TRIANGLES;
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON:
+        for (std::size_t i = 1; i + 1 < count; ++i)
+            m_indices.insert(m_indices.end(), {0, i, i + 1});
+        return Primitive::TRIANGLES;
+    case GL_QUADS:
+        for (std::size_t i = 0; i + 3 < count; i += 4)
+            m_indices.insert(m_indices.end(), {i, i + 1, i + 2, i, i + 2, i + 3});
+        return Primitive::TRIANGLES;
+    case GL_QUAD_STRIP:
+        for (std::size_t i = 0; i + 3 < count; i += 2)
+            m_indices.insert(m_indices.end(), {i, i + 1, i + 3, i, i + 3, i + 2});
+        return Primitive::TRIANGLES;
+    case GL_LINES:
+        for (std::size_t i = 0; i + 1 < count; i += 2)
+            m_indices.insert(m_indices.end(), {i, i + 1});
+        return Primitive::LINES;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        for (std::size_t i = 0; i + 1 < count; ++i)
+            m_indices.insert(m_indices.end(), {i, i + 1});
+        if (mode == GL_LINE_LOOP && count > 2)
+            m_indices.insert(m_indices.end(), {count - 1, 0});
+        return Primitive::LINES;
+    default:
+        return Primitive::TRIANGLES;
+    }
+}
+
+void DrawBatch::AddImpl(GLenum mode, const float* vertices, const float* tex_coords,
+                        const unsigned char* colors, std::size_t count, Clr color,
+                        GLuint texture, float line_width, Pt offset)
+{
+    const auto primitive = Decompose(mode, count);
+    if (m_indices.empty())
+        return;
+    SetState(primitive, texture, line_width);
+
+    const auto offset_x = static_cast<GLfloat>(Value(offset.x));
+    const auto offset_y = static_cast<GLfloat>(Value(offset.y));
+    for (auto i : m_indices) {
+        Vertex vertex{vertices[2 * i] + offset_x, vertices[2 * i + 1] + offset_y,
+                      0.0f, 0.0f, color.r, color.g, color.b, color.a};
+        if (tex_coords) {
+            vertex.u = tex_coords[2 * i];
+            vertex.v = tex_coords[2 * i + 1];
+        }
+        if (colors) {
+            vertex.r = colors[4 * i];
+            vertex.g = colors[4 * i + 1];
+            vertex.b = colors[4 * i + 2];
+            vertex.a = colors[4 * i + 3];
+        }
+        m_vertices.push_back(vertex);
+    }
+
+    if (!Active())
+        Flush();
+}
+
+DrawBatch& GG::GetDrawBatch()
+{
+    static DrawBatch batch;
+    return batch;
+}
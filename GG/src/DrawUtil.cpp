@@ -9,6 +9,7 @@
 
 #include <valarray>
 #include <GG/ClrConstants.h>
+#include <GG/DrawBatch.h>
 #include <GG/DrawUtil.h>
 #include <GG/GLClientAndServerBuffer.h>
 #include <GG/GUI.h>
@@ -62,34 +63,22 @@ void Rectangle(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_color2,
     verts.store(inner_x1,   inner_y2);
     verts.store(inner_x2,   inner_y2);
 
-    verts.activate();
-
-    glDisable(GL_TEXTURE_2D);
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
 
     // draw beveled edges
     if (bevel_thick && (border_color1 != CLR_ZERO || border_color2 != CLR_ZERO)) {
-        glColor(border_color1);
         if (border_color1 == border_color2) {
-            glDrawArrays(GL_QUAD_STRIP, 0, 10);
+            batch.AddArrays(GL_QUAD_STRIP, verts, 0, 10, border_color1);
         } else {
-            glDrawArrays(GL_QUAD_STRIP, 0, 6);
-            glColor(border_color2);
-            glDrawArrays(GL_QUAD_STRIP, 4, 6);
+            batch.AddArrays(GL_QUAD_STRIP, verts, 0, 6, border_color1);
+            batch.AddArrays(GL_QUAD_STRIP, verts, 4, 6, border_color2);
         }
     }
 
     // draw interior of rectangle
-    if (color != CLR_ZERO) {
-        glColor(color);
-        glDrawArrays(GL_QUADS, 10, 4);
-    }
-
-    glPopClientAttrib();
-    glEnable(GL_TEXTURE_2D);
+    if (color != CLR_ZERO)
+        batch.AddArrays(GL_QUADS, verts, 10, 4, color);
 }
 
 void Check(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
@@ -102,10 +91,11 @@ void Check(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
                           {-0.2f,  0.4f}, {-0.8f,  0.0f}, { -0.2f,  0.6f},
                           { 0.8f, -0.4f}, { 0.6f, -0.4f}, { 0.8f, -0.8f}};
 
-    glPushMatrix();
-    const float sf = 1.25f;                                                     // scale factor to make the check look right
-    glTranslatef(Value(ul.x + wd / 2.0f), Value(ul.y + ht / 2.0f * sf), 0.0f);  // move origin to the center of the rectangle
-    glScalef(Value(wd / 2.0f * sf), Value(ht / 2.0f * sf), 1.0f);               // map the range [-1,1] to the rectangle in both directions
+    const float sf = 1.25f;                                     // scale factor to make the check look right
+    const float center_x = Value(ul.x + wd / 2.0f);             // the origin is moved to the center of the rectangle
+    const float center_y = Value(ul.y + ht / 2.0f * sf);
+    const float scale_x = Value(wd / 2.0f * sf);                // and the range [-1,1] mapped to the rectangle in both directions
+    const float scale_y = Value(ht / 2.0f * sf);
 
     static std::size_t indices[22] = { 1,  4,  2,
                                        8,  0,  3,  7,
@@ -116,38 +106,25 @@ void Check(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
     GL2DVertexBuffer vert_buf;
     vert_buf.reserve(22);
     for (std::size_t i = 0; i < 22; ++i)
-        vert_buf.store(verts[indices[i]][0], verts[indices[i]][1]);
+        vert_buf.store(center_x + verts[indices[i]][0] * scale_x,
+                       center_y + verts[indices[i]][1] * scale_y);
 
-    glDisable(GL_TEXTURE_2D);
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    vert_buf.activate();
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
 
-    glColor(color3);
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-    glDrawArrays(GL_QUADS, 3, 4);
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 0, 3, color3);
+    batch.AddArrays(GL_QUADS, vert_buf, 3, 4, color3);
 
-    glColor(color2);
-    glDrawArrays(GL_QUADS, 7, 8);
+    batch.AddArrays(GL_QUADS, vert_buf, 7, 8, color2);
 
-    glColor(color1);
-    glDrawArrays(GL_TRIANGLES, 15, 3);
-    glDrawArrays(GL_QUADS, 18, 4);
-
-    glPopClientAttrib();
-
-    glPopMatrix();
-    glEnable(GL_TEXTURE_2D);
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 15, 3, color1);
+    batch.AddArrays(GL_QUADS, vert_buf, 18, 4, color1);
 }
 
 void XMark(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
 {
     X wd = lr.x - ul.x;
     Y ht = lr.y - ul.y;
-    glDisable(GL_TEXTURE_2D);
 
     // all vertices
     GLfloat verts[][2] = {{-0.4f, -0.6f}, {-0.6f, -0.4f}, {-0.4f, -0.4f}, {-0.2f,  0.0f}, {-0.6f,  0.4f},
@@ -155,10 +132,11 @@ void XMark(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
                           { 0.4f,  0.4f}, { 0.2f,  0.0f}, { 0.6f, -0.4f}, { 0.4f, -0.6f}, { 0.4f, -0.4f},
                           { 0.0f, -0.2f}, { 0.0f,  0.0f}};
 
-    glPushMatrix();
-    const float sf = 1.75f;                                                 // scale factor; the check wasn't the right size as drawn originally
-    glTranslatef(Value(ul.x + wd / 2.0f), Value(ul.y + ht / 2.0f), 0.0f);   // move origin to the center of the rectangle
-    glScalef(Value(wd / 2.0f * sf), Value(ht / 2.0f * sf), 1.0f);           // map the range [-1,1] to the rectangle in both directions
+    const float sf = 1.75f;                                     // scale factor; the check wasn't the right size as drawn originally
+    const float center_x = Value(ul.x + wd / 2.0f);             // the origin is moved to the center of the rectangle
+    const float center_y = Value(ul.y + ht / 2.0f);
+    const float scale_x = Value(wd / 2.0f * sf);                // and the range [-1,1] mapped to the rectangle in both directions
+    const float scale_y = Value(ht / 2.0f * sf);
 
     static std::size_t indices[44] = {12, 13, 14,
                                       15,  0,  2, 16,  9, 11, 16, 10,
@@ -170,38 +148,26 @@ void XMark(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3)
     GL2DVertexBuffer vert_buf;
     vert_buf.reserve(44);
     for (std::size_t i = 0; i < 44; ++i)
-        vert_buf.store(verts[indices[i]][0], verts[indices[i]][1]);
+        vert_buf.store(center_x + verts[indices[i]][0] * scale_x,
+                       center_y + verts[indices[i]][1] * scale_y);
 
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    vert_buf.activate();
-
-    glColor(color1);
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-    glDrawArrays(GL_QUADS, 3, 8);
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
 
-    glColor(color2);
-    glDrawArrays(GL_TRIANGLES, 11, 3);
-    glDrawArrays(GL_QUADS, 14, 8);
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 0, 3, color1);
+    batch.AddArrays(GL_QUADS, vert_buf, 3, 8, color1);
 
-    glColor(color3);
-    glDrawArrays(GL_TRIANGLES, 22, 6);
-    glDrawArrays(GL_QUADS, 28, 16);
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 11, 3, color2);
+    batch.AddArrays(GL_QUADS, vert_buf, 14, 8, color2);
 
-    glPopClientAttrib();
-
-    glPopMatrix();
-    glEnable(GL_TEXTURE_2D);
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 22, 6, color3);
+    batch.AddArrays(GL_QUADS, vert_buf, 28, 16, color3);
 }
 
 void BubbleArc(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3, double theta1, double theta2)
 {
     X wd = lr.x - ul.x;
     Y ht = lr.y - ul.y;
-    glDisable(GL_TEXTURE_2D);
 
     // correct theta* values to range [0, 2pi)
     if (theta1 < 0)
@@ -238,36 +204,38 @@ void BubbleArc(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3, double theta1,
         colors[j] = BlendClr(color2, color3, color_scale_factor);
     }
 
-    glPushMatrix();
-    glTranslatef(Value(ul.x + wd / 2.0), Value(ul.y + ht / 2.0), 0.0);   // move origin to the center of the rectangle
-    glScalef(Value(wd / 2.0), Value(ht / 2.0), 1.0);                 // map the range [-1,1] to the rectangle in both (x- and y-) directions
+    const float center_x = Value(ul.x + wd / 2.0);  // the origin is moved to the center of the rectangle
+    const float center_y = Value(ul.y + ht / 2.0);
+    const float scale_x = Value(wd / 2.0);          // and the range [-1,1] mapped to the rectangle in both (x- and y-) directions
+    const float scale_y = Value(ht / 2.0);
 
-    glColor(color1);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(0, 0);
+    GL2DVertexBuffer vert_buf;
+    GLRGBAColorBuffer colour_buf;
+    vert_buf.reserve(last_slice_idx - first_slice_idx + 4);
+    colour_buf.reserve(last_slice_idx - first_slice_idx + 4);
+    auto store = [&](double x, double y, Clr clr) {
+        vert_buf.store(static_cast<float>(center_x + x * scale_x), static_cast<float>(center_y + y * scale_y));
+        colour_buf.store(clr);
+    };
+
+    store(0, 0, color1);
     // point on circle at angle theta1
     double x = cos(-theta1);
     double y = sin(-theta1);
     double color_scale_factor = (SQRT2OVER2 * (x + y) + 1) / 2;
-    Clr clr = BlendClr(color2, color3, color_scale_factor);
-    glColor4ub(clr.r, clr.g, clr.b, clr.a);
-    glVertex2f(x, y);
+    store(x, y, BlendClr(color2, color3, color_scale_factor));
     // angles in between theta1 and theta2, if any
     for (int i = first_slice_idx; i <= last_slice_idx; ++i) {
         int X = (i > SLICES ? (i - SLICES) : i) * 2, Y = X + 1;
-        glColor(colors[i]);
-        glVertex2f(unit_vertices[X], unit_vertices[Y]);
+        store(unit_vertices[X], unit_vertices[Y], colors[i]);
     }
     // theta2
     x = cos(-theta2);
     y = sin(-theta2);
     color_scale_factor = (SQRT2OVER2 * (x + y) + 1) / 2;
-    clr = BlendClr(color2, color3, color_scale_factor);
-    glColor4ub(clr.r, clr.g, clr.b, clr.a);
-    glVertex2f(x, y);
-    glEnd();
-    glPopMatrix();
-    glEnable(GL_TEXTURE_2D);
+    store(x, y, BlendClr(color2, color3, color_scale_factor));
+
+    GetDrawBatch().AddArrays(GL_TRIANGLE_FAN, vert_buf, colour_buf, 0, vert_buf.size());
 }
 
 void CircleArc(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_color2,
@@ -276,7 +244,6 @@ void CircleArc(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_color2,
     //std::cout << "GG::CircleArc ul: " << ul << "  lr: " << lr << " bevel thick: " << bevel_thick << "  theta1: " << theta1 << "  theta2: " << theta2 << std::endl;
     X wd = lr.x - ul.x;
     Y ht = lr.y - ul.y;
-    glDisable(GL_TEXTURE_2D);
 
     // correct theta* values to range [0, 2pi)
     if (theta1 < 0)
@@ -313,53 +280,62 @@ void CircleArc(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_color2,
         colors[j] = BlendClr(border_color1, border_color2, color_scale_factor);
     }
 
-    glPushMatrix();
-    glTranslatef(Value(ul.x + wd / 2.0), Value(ul.y + ht / 2.0), 0.0);   // move origin to the center of the rectangle
-    glScalef(Value(wd / 2.0), Value(ht / 2.0), 1.0);                 // map the range [-1,1] to the rectangle in both (x- and y-) directions
+    const float center_x = Value(ul.x + wd / 2.0);  // the origin is moved to the center of the rectangle
+    const float center_y = Value(ul.y + ht / 2.0);
+    const float scale_x = Value(wd / 2.0);          // and the range [-1,1] mapped to the rectangle in both (x- and y-) directions
+    const float scale_y = Value(ht / 2.0);
+
+    GL2DVertexBuffer vert_buf;
+    GLRGBAColorBuffer colour_buf;
+    vert_buf.reserve(3 * (last_slice_idx - first_slice_idx) + 9);
+    colour_buf.reserve(3 * (last_slice_idx - first_slice_idx) + 9);
+    auto store = [&](double x, double y, Clr clr) {
+        vert_buf.store(static_cast<float>(center_x + x * scale_x), static_cast<float>(center_y + y * scale_y));
+        colour_buf.store(clr);
+    };
 
     double inner_radius = (std::min(Value(wd), Value(ht)) - 2.0 * bevel_thick) / std::min(Value(wd), Value(ht));
-    glColor(color);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(0, 0);
+    store(0, 0, color);
     // point on circle at angle theta1
     double theta1_x = cos(-theta1), theta1_y = sin(-theta1);
-    glVertex2f(theta1_x * inner_radius, theta1_y * inner_radius);
+    store(theta1_x * inner_radius, theta1_y * inner_radius, color);
     // angles in between theta1 and theta2, if any
     for (int i = first_slice_idx; i <= last_slice_idx; ++i) {
         int X = (i > SLICES ? (i - SLICES) : i) * 2, Y = X + 1;
-        glVertex2f(unit_vertices[X] * inner_radius, unit_vertices[Y] * inner_radius);
+        store(unit_vertices[X] * inner_radius, unit_vertices[Y] * inner_radius, color);
     }      // theta2
     double theta2_x = cos(-theta2), theta2_y = sin(-theta2);
-    glVertex2f(theta2_x * inner_radius, theta2_y * inner_radius);
-    glEnd();
-    glBegin(GL_QUAD_STRIP);
+    store(theta2_x * inner_radius, theta2_y * inner_radius, color);
+    const std::size_t fan_size = vert_buf.size();
+
     // point on circle at angle theta1
     double color_scale_factor = (SQRT2OVER2 * (theta1_x + theta1_y) + 1) / 2;
     Clr clr = BlendClr(border_color1, border_color2, color_scale_factor);
-    glColor4ub(clr.r, clr.g, clr.b, clr.a);
-    glVertex2f(theta1_x, theta1_y);
-    glVertex2f(theta1_x * inner_radius, theta1_y * inner_radius);
+    store(theta1_x, theta1_y, clr);
+    store(theta1_x * inner_radius, theta1_y * inner_radius, clr);
     // angles in between theta1 and theta2, if any
     for (int i = first_slice_idx; i <= last_slice_idx; ++i) {
         int X = (i > SLICES ? (i - SLICES) : i) * 2, Y = X + 1;
-        glColor(colors[i]);
-        glVertex2f(unit_vertices[X], unit_vertices[Y]);
-        glVertex2f(unit_vertices[X] * inner_radius, unit_vertices[Y] * inner_radius);
+        store(unit_vertices[X], unit_vertices[Y], colors[i]);
+        store(unit_vertices[X] * inner_radius, unit_vertices[Y] * inner_radius, colors[i]);
     }
     // theta2
     color_scale_factor = (SQRT2OVER2 * (theta2_x + theta2_y) + 1) / 2;
     clr = BlendClr(border_color1, border_color2, color_scale_factor);
-    glColor4ub(clr.r, clr.g, clr.b, clr.a);
-    glVertex2f(theta2_x, theta2_y);
-    glVertex2f(theta2_x * inner_radius, theta2_y * inner_radius);
-    glEnd();
-    glPopMatrix();
-    glEnable(GL_TEXTURE_2D);
+    store(theta2_x, theta2_y, clr);
+    store(theta2_x * inner_radius, theta2_y * inner_radius, clr);
+
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
+    batch.AddArrays(GL_TRIANGLE_FAN, vert_buf, colour_buf, 0, fan_size);
+    batch.AddArrays(GL_QUAD_STRIP, vert_buf, colour_buf, fan_size, vert_buf.size() - fan_size);
 }
 
 void RoundedRectangle(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_color2,
                         unsigned int corner_radius, int thick)
 {
+    ScopedDrawBatch batch_scope;
+
     int circle_diameter = corner_radius * 2;
     CircleArc(Pt(lr.x - circle_diameter, ul.y),                     Pt(lr.x, ul.y + circle_diameter),
               color, border_color2, border_color1, thick, 0, 0.5 * PI);  // ur corner
@@ -429,24 +405,13 @@ void RoundedRectangle(Pt ul, Pt lr, Clr color, Clr border_color1, Clr border_col
     for (unsigned int i = 0; i < 12; ++i)
         colour_buf.store(color);
 
-
-    glDisable(GL_TEXTURE_2D);
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    vert_buf.activate();
-    colour_buf.activate();
-
-    glDrawArrays(GL_QUADS, 0, vert_buf.size());
-
-    glPopClientAttrib();
-    glEnable(GL_TEXTURE_2D);
+    GetDrawBatch().AddArrays(GL_QUADS, vert_buf, colour_buf, 0, vert_buf.size());
 }
 
 void BubbleRectangle(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3, unsigned int corner_radius)
 {
+    ScopedDrawBatch batch_scope;
+
     int circle_diameter = corner_radius * 2;
     BubbleArc(Pt(lr.x - circle_diameter, ul.y), Pt(lr.x, ul.y + circle_diameter), color1, color3, color2, 0, 0.5 * PI);  // ur corner
     BubbleArc(Pt(ul.x, ul.y), Pt(ul.x + circle_diameter, ul.y + circle_diameter), color1, color3, color2, 0.5 * PI, PI); // ul corner
@@ -515,19 +480,7 @@ void BubbleRectangle(Pt ul, Pt lr, Clr color1, Clr color2, Clr color3, unsigned
     verts.store(ul.x + rad, lr.y - rad);
     verts.store(lr.x - rad, lr.y - rad);
 
-
-    glDisable(GL_TEXTURE_2D);
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    verts.activate();
-    colours.activate();
-    glDrawArrays(GL_QUADS, 0, verts.size());
-
-    glPopClientAttrib();
-    glEnable(GL_TEXTURE_2D);
+    GetDrawBatch().AddArrays(GL_QUADS, verts, colours, 0, verts.size());
 }
 
 }
@@ -554,6 +507,7 @@ Clr GG::DisabledColor(Clr clr)
 
 void GG::BeginScissorClipping(Pt ul, Pt lr)
 {
+    GetDrawBatch().Flush();
     if (g_scissor_clipping_rects.empty()) {
         glPushAttrib(GL_SCISSOR_BIT | GL_ENABLE_BIT);
         glEnable(GL_SCISSOR_TEST);
@@ -573,6 +527,7 @@ void GG::BeginScissorClipping(Pt ul, Pt lr)
 
 void GG::EndScissorClipping()
 {
+    GetDrawBatch().Flush();
     assert(!g_scissor_clipping_rects.empty());
     g_scissor_clipping_rects.pop_back();
     if (g_scissor_clipping_rects.empty()) {
@@ -595,6 +550,7 @@ Rect GG::ActiveScissorClippingRegion()
 
 void GG::BeginStencilClipping(Pt inner_ul, Pt inner_lr, Pt outer_ul, Pt outer_lr)
 {
+    GetDrawBatch().Flush();
     if (!g_stencil_bit) {
         glPushAttrib(GL_STENCIL_BUFFER_BIT | GL_ENABLE_BIT);
         glClearStencil(0);
@@ -653,6 +609,7 @@ void GG::BeginStencilClipping(Pt inner_ul, Pt inner_lr, Pt outer_ul, Pt outer_lr
 
 void GG::EndStencilClipping()
 {
+    GetDrawBatch().Flush();
     assert(g_stencil_bit);
     --g_stencil_bit;
     if (!g_stencil_bit) {
@@ -664,9 +621,11 @@ void GG::EndStencilClipping()
 
 void GG::Line(Pt pt1, Pt pt2, Clr color, float thick)
 {
-    glLineWidth(thick);
-    glColor(color);
-    Line(pt1.x, pt1.y, pt2.x, pt2.y);
+    GL2DVertexBuffer vert_buf;
+    vert_buf.reserve(2);
+    vert_buf.store(pt1);
+    vert_buf.store(pt2);
+    GetDrawBatch().AddArrays(GL_LINES, vert_buf, 0, 2, color, thick);
 }
 
 void GG::Line(X x1, Y y1, X x2, Y y2)
@@ -674,6 +633,8 @@ void GG::Line(X x1, Y y1, X x2, Y y2)
     GLfloat vertices[4] = {GLfloat(Value(x1)), GLfloat(Value(y1)),
                             GLfloat(Value(x2)), GLfloat(Value(y2))};
 
+    // drawn in the current color, so can't be batched
+    GetDrawBatch().Flush();
     glDisable(GL_TEXTURE_2D);
 
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
@@ -691,30 +652,17 @@ void GG::Line(X x1, Y y1, X x2, Y y2)
 
 void GG::Triangle(Pt pt1, Pt pt2, Pt pt3, Clr color, Clr border_color, float border_thick)
 {
-    GLfloat vertices[6] = {GLfloat(Value(pt1.x)), GLfloat(Value(pt1.y)), GLfloat(Value(pt2.x)),
-                            GLfloat(Value(pt2.y)), GLfloat(Value(pt3.x)), GLfloat(Value(pt3.y))};
-
-    glDisable(GL_TEXTURE_2D);
-
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    glVertexPointer(2, GL_FLOAT, 0, vertices);
-    glColor(color);
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-
-    if (border_color != GG::CLR_ZERO) {
-        glLineWidth(border_thick);
-        glColor(border_color);
-
-        glDrawArrays(GL_LINE_LOOP, 0, 3);
-        glLineWidth(1.0f);
-    }
-
-    glPopClientAttrib();
-    glEnable(GL_TEXTURE_2D);
+    GL2DVertexBuffer vert_buf;
+    vert_buf.reserve(3);
+    vert_buf.store(pt1);
+    vert_buf.store(pt2);
+    vert_buf.store(pt3);
+
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
+    batch.AddArrays(GL_TRIANGLES, vert_buf, 0, 3, color);
+    if (border_color != GG::CLR_ZERO)
+        batch.AddArrays(GL_LINE_LOOP, vert_buf, 0, 3, border_color, border_thick);
 }
 
 void GG::Triangle(X x1, Y y1, X x2, Y y2, X x3, Y y3, bool filled)
@@ -722,6 +670,8 @@ void GG::Triangle(X x1, Y y1, X x2, Y y2, X x3, Y y3, bool filled)
     GLfloat vertices[6] = {GLfloat(Value(x1)), GLfloat(Value(y1)), GLfloat(Value(x2)),
                             GLfloat(Value(y2)), GLfloat(Value(x3)), GLfloat(Value(y3))};
 
+    // drawn in the current color, so can't be batched
+    GetDrawBatch().Flush();
     glDisable(GL_TEXTURE_2D);
 
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
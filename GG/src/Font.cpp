@@ -20,7 +20,9 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <GG/Base.h>
+#include <GG/DrawBatch.h>
 #include <GG/Font.h>
+#include <GG/FrameProfiler.h>
 #include <GG/GLClientAndServerBuffer.h>
 #include <GG/GUI.h>
 #include <GG/StyleFactory.h>
@@ -1191,6 +1193,7 @@ void Font::PreRenderText(const Pt& ul, const Pt& lr, const std::string& text, Fl
 
 void Font::RenderCachedText(RenderCache& cache) const
 {
+    GetDrawBatch().Flush();
     glBindTexture(GL_TEXTURE_2D, m_texture->OpenGLId());
 
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
@@ -1202,6 +1205,8 @@ void Font::RenderCachedText(RenderCache& cache) const
     cache.coordinates->activate();
     cache.colors->activate();
     glDrawArrays(GL_QUADS, 0,  cache.vertices->size());
+    GetFrameProfiler().CountTextureBind();
+    GetFrameProfiler().CountDrawCall();
 
     glBindTexture(GL_TEXTURE_2D, 0);
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
@@ -1210,11 +1215,31 @@ void Font::RenderCachedText(RenderCache& cache) const
         cache.underline_vertices->activate();
         cache.underline_colors->activate();
         glDrawArrays(GL_QUADS, 0, cache.underline_vertices->size());
+        GetFrameProfiler().CountDrawCall();
     }
 
     glPopClientAttrib();
 }
 
+void Font::BatchCachedText(const RenderCache& cache, Pt offset) const
+{
+    ScopedDrawBatch batch_scope;
+    auto& batch = GetDrawBatch();
+
+    batch.AddTexturedArrays(GL_QUADS, m_texture->OpenGLId(), *cache.vertices, *cache.coordinates,
+                            *cache.colors, 0, cache.vertices->size(), offset);
+
+    if (!cache.underline_vertices->empty()) {
+        GL2DVertexBuffer underline_vertices;
+        underline_vertices.reserve(cache.underline_vertices->size());
+        const auto& data = cache.underline_vertices->data();
+        for (std::size_t i = 0; i + 1 < data.size(); i += 2)
+            underline_vertices.store(data[i] + Value(offset.x), data[i + 1] + Value(offset.y));
+        batch.AddArrays(GL_QUADS, underline_vertices, *cache.underline_colors,
+                        0, underline_vertices.size());
+    }
+}
+
 void Font::ProcessTagsBefore(const std::vector<LineData>& line_data, RenderState& render_state,
                              std::size_t begin_line, CPSize begin_char) const
 {
@@ -0,0 +1,172 @@
+//! GiGi - A GUI for OpenGL
+//!
+//!  Copyright (C) 2021 The FreeOrion Project
+//!
+//! Released under the GNU Lesser General Public License 2.1 or later.
+//! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
+//! SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <fstream>
+#include <iostream>
+#include <GG/FrameProfiler.h>
+#include <GG/Wnd.h>
+
+
+using namespace GG;
+
+namespace {
+    bool TimerQueriesSupported()
+    { return GLEW_VERSION_3_3 || GLEW_ARB_timer_query; }
+
+    FrameProfiler::Duration Since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<FrameProfiler::Duration>(
+            std::chrono::steady_clock::now() - start);
+    }
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (Enabled() || !m_queries[0])
+        return;
+
+    if (m_query_active)
+        glEndQuery(GL_TIME_ELAPSED);
+    m_query_active = false;
+    glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+    m_queries.fill(0);
+    m_query_pending.fill(false);
+    m_last_gpu_ms = -1.0;
+}
+
+void FrameProfiler::TraceFrames(std::size_t frames, std::string path)
+{
+    m_trace_frames_left = frames;
+    m_trace_path = std::move(path);
+    m_trace.clear();
+    m_trace.reserve(frames);
+}
+
+void FrameProfiler::BeginPreRender()
+{
+    if (!Enabled())
+        return;
+    m_current.frame = m_frame;
+    m_section_start = std::chrono::steady_clock::now();
+}
+
+void FrameProfiler::EndPreRender()
+{
+    if (Enabled())
+        m_current.prerender += Since(m_section_start);
+}
+
+void FrameProfiler::BeginRender()
+{
+    if (!Enabled())
+        return;
+    m_section_start = std::chrono::steady_clock::now();
+
+    if (TimerQueriesSupported()) {
+        ReadGPUTime();
+        if (!m_query_pending[m_next_query]) {
+            glBeginQuery(GL_TIME_ELAPSED, m_queries[m_next_query]);
+            m_query_active = true;
+        }
+    }
+}
+
+void FrameProfiler::EndRender()
+{
+    if (!Enabled()) {
+        ++m_frame;
+        return;
+    }
+
+    m_current.render += Since(m_section_start);
+
+    if (m_query_active) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_query_active = false;
+        m_query_pending[m_next_query] = true;
+        m_next_query = (m_next_query + 1) % NUM_QUERIES;
+    }
+    m_current.gpu_ms = m_last_gpu_ms;
+
+    m_last_frame = std::move(m_current);
+    m_current = FrameStats();
+    ++m_frame;
+
+    if (m_trace_frames_left) {
+        m_trace.push_back(m_last_frame);
+        if (--m_trace_frames_left == 0) {
+            WriteTrace();
+            m_trace.clear();
+            m_trace.shrink_to_fit();
+            SetEnabled(m_enabled);
+        }
+    }
+}
+
+void FrameProfiler::AddPreRenderTime(const Wnd& wnd, Duration time)
+{ TimeOf(wnd).prerender += time; }
+
+void FrameProfiler::AddRenderTime(const Wnd& wnd, Duration time)
+{ TimeOf(wnd).render += time; }
+
+FrameProfiler::WndTime& FrameProfiler::TimeOf(const Wnd& wnd)
+{
+    // there are few enough top-level Wnds that a linear search is fastest
+    for (auto& wnd_time : m_current.wnds)
+        if (wnd_time.name == wnd.Name())
+            return wnd_time;
+    m_current.wnds.push_back(WndTime{wnd.Name()});
+    return m_current.wnds.back();
+}
+
+void FrameProfiler::ReadGPUTime()
+{
+    if (!m_queries[0])
+        glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+
+    // read results in the order the queries were issued, without waiting
+    // for any that aren't available yet
+    for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+        std::size_t query = (m_next_query + i) % NUM_QUERIES;
+        if (!m_query_pending[query])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(m_queries[query], GL_QUERY_RESULT, &ns);
+        m_last_gpu_ms = ns / 1.0e6;
+        m_query_pending[query] = false;
+    }
+}
+
+void FrameProfiler::WriteTrace() const
+{
+    std::ofstream ofs(m_trace_path);
+    if (!ofs) {
+        std::cerr << "FrameProfiler unable to open frame trace file " << m_trace_path << std::endl;
+        return;
+    }
+
+    ofs << "frame\tprerender_us\trender_us\tgpu_ms\tdraw_calls\ttexture_binds\tbuffer_uploads\twnds (name:prerender_us/render_us)\n";
+    for (const auto& frame : m_trace) {
+        ofs << frame.frame << '\t' << frame.prerender.count() << '\t' << frame.render.count() << '\t'
+            << frame.gpu_ms << '\t' << frame.draw_calls << '\t' << frame.texture_binds << '\t'
+            << frame.buffer_uploads;
+        for (const auto& wnd : frame.wnds)
+            ofs << '\t' << wnd.name << ':' << wnd.prerender.count() << '/' << wnd.render.count();
+        ofs << '\n';
+    }
+}
+
+FrameProfiler& GG::GetFrameProfiler()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
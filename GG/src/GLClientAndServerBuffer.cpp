@@ -7,7 +7,10 @@
 //! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
 //! SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <GG/DrawBatch.h>
+#include <GG/FrameProfiler.h>
 #include <GG/GLClientAndServerBuffer.h>
+#include <utility>
 
 
 using namespace GG;
@@ -103,6 +106,7 @@ void GLClientAndServerBufferBase<vtype>::createServerBuffer()
                  b_data.empty() ? nullptr : &b_data[0],
                  GL_STATIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GetFrameProfiler().CountBufferUpload();
 }
 
 template <typename vtype>
@@ -113,6 +117,19 @@ void GLClientAndServerBufferBase<vtype>::clear()
     b_data.clear();
 }
 
+template <typename vtype>
+bool GLClientAndServerBufferBase<vtype>::sameData(const GLClientAndServerBufferBase& other) const
+{ return b_elements_per_item == other.b_elements_per_item && b_data == other.b_data; }
+
+template <typename vtype>
+void GLClientAndServerBufferBase<vtype>::swap(GLClientAndServerBufferBase& other)
+{
+    std::swap(b_name, other.b_name);
+    b_data.swap(other.b_data);
+    std::swap(b_size, other.b_size);
+    std::swap(b_elements_per_item, other.b_elements_per_item);
+}
+
 ///////////////////////////////////////////////////////////////////////////
 // GLRGBAColorBuffer
 ///////////////////////////////////////////////////////////////////////////
@@ -127,6 +144,7 @@ void GLRGBAColorBuffer::store(const Clr& color)
 
 void GLRGBAColorBuffer::activate() const
 {
+    GetDrawBatch().Flush();
     if (b_name) {
         glBindBuffer(GL_ARRAY_BUFFER, b_name);
         glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
@@ -162,6 +180,7 @@ void GL2DVertexBuffer::store(float x, float y)
 
 void GL2DVertexBuffer::activate() const
 {
+    GetDrawBatch().Flush();
     if (b_name) {
         glBindBuffer(GL_ARRAY_BUFFER, b_name);
         glVertexPointer(2, GL_FLOAT, 0, nullptr);
@@ -181,6 +200,7 @@ GLTexCoordBuffer::GLTexCoordBuffer() :
 
 void GLTexCoordBuffer::activate() const
 {
+    GetDrawBatch().Flush();
     if (b_name) {
         glBindBuffer(GL_ARRAY_BUFFER, b_name);
         glTexCoordPointer(2, GL_FLOAT, 0, nullptr);
@@ -203,6 +223,7 @@ void GL3DVertexBuffer::store(float x, float y, float z)
 
 void GL3DVertexBuffer::activate() const
 {
+    GetDrawBatch().Flush();
     if (b_name) {
         glBindBuffer(GL_ARRAY_BUFFER, b_name);
         glVertexPointer(3, GL_FLOAT, 0, nullptr);
@@ -225,6 +246,7 @@ void GLNormalBuffer::store(float x, float y, float z)
 
 void GLNormalBuffer::activate() const
 {
+    GetDrawBatch().Flush();
     if (b_name) {
         glBindBuffer(GL_ARRAY_BUFFER, b_name);
         glNormalPointer(GL_FLOAT, 0, nullptr);
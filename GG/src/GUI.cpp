@@ -34,7 +34,9 @@
 #endif
 #include <GG/BrowseInfoWnd.h>
 #include <GG/Cursor.h>
+#include <GG/DrawBatch.h>
 #include <GG/Edit.h>
+#include <GG/FrameProfiler.h>
 #include <GG/GUI.h>
 #include <GG/Layout.h>
 #include <GG/ListBox.h>
@@ -1605,7 +1607,12 @@ void GUI::RenderWindow(Wnd* wnd)
     if (!wnd || !wnd->Visible())
         return;
 
-    wnd->Render();
+    if (wnd->BatchesRendering()) {
+        wnd->Render();
+    } else {
+        DrawBatchSuspension suspension;
+        wnd->Render();
+    }
 
     Wnd::ChildClippingMode clip_mode = wnd->GetChildClippingMode();
 
@@ -1645,6 +1652,7 @@ void GUI::RenderWindow(Wnd* wnd)
     }
 
     if (wnd == GetGUI()->m_impl->m_save_as_png_wnd) {
+        GetDrawBatch().Flush();
         WriteWndToPNG(GetGUI()->m_impl->m_save_as_png_wnd, GetGUI()->m_impl->m_save_as_png_filename);
         GetGUI()->m_impl->m_save_as_png_wnd = nullptr;
         GetGUI()->m_impl->m_save_as_png_filename.clear();
@@ -1692,9 +1700,19 @@ void GUI::ProcessBrowseInfo()
 
 void GUI::PreRender()
 {
+    auto& profiler = GetFrameProfiler();
+    profiler.BeginPreRender();
+
     // pre-render normal windows back-to-front
     for (auto wnd : m_impl->m_zlist.RenderOrder()) {
-        PreRenderWindow(wnd.get());
+        if (wnd && profiler.Enabled()) {
+            auto start = std::chrono::steady_clock::now();
+            PreRenderWindow(wnd.get());
+            profiler.AddPreRenderTime(*wnd, std::chrono::duration_cast<FrameProfiler::Duration>(
+                std::chrono::steady_clock::now() - start));
+        } else {
+            PreRenderWindow(wnd.get());
+        }
     }
 
     // pre-render modal windows back-to-front (on top of non-modal Wnds rendered above)
@@ -1712,6 +1730,8 @@ void GUI::PreRender()
     for (const auto& drag_drop_wnd : m_impl->m_drag_drop_wnds) {
         PreRenderWindow(drag_drop_wnd.first.get());
     }
+
+    profiler.EndPreRender();
 }
 
 void GUI::Render()
@@ -1722,11 +1742,29 @@ void GUI::Render()
         timer->Update(ticks);
     }
 
+    auto& profiler = GetFrameProfiler();
+    profiler.BeginRender();
+
+    // fill in textures that finished loading in the background
+    GetTextureManager().UploadPendingTextures();
+
     Enter2DMode();
+    auto& batch = GetDrawBatch();
+    batch.Begin();
+
     // render normal windows back-to-front
     for (auto wnd : m_impl->m_zlist.RenderOrder()) {
-        if (wnd)
+        if (!wnd)
+            continue;
+        if (profiler.Enabled()) {
+            auto start = std::chrono::steady_clock::now();
             RenderWindow(wnd.get());
+            batch.Flush();  // so the time of drawing the batch is that of the Wnd it was collected from
+            profiler.AddRenderTime(*wnd, std::chrono::duration_cast<FrameProfiler::Duration>(
+                std::chrono::steady_clock::now() - start));
+        } else {
+            RenderWindow(wnd.get());
+        }
     }
 
     // render modal windows back-to-front (on top of non-modal Wnds rendered above)
@@ -1751,6 +1789,7 @@ void GUI::Render()
     }
 
     RenderDragDropWnds();
+    batch.End();
 
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_LIGHTING);
@@ -1762,6 +1801,8 @@ void GUI::Render()
     if (m_impl->m_render_cursor && m_impl->m_cursor && AppHasMouseFocus())
         m_impl->m_cursor->Render(m_impl->m_mouse_pos);
     Exit2DMode();
+
+    profiler.EndRender();
 }
 
 bool GUI::ProcessBrowseInfoImpl(Wnd* wnd)
@@ -7,6 +7,7 @@
 //! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
 //! SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
 #include <iterator>
 #include <numeric>
 #include <boost/cast.hpp>
@@ -1876,11 +1877,9 @@ ListBox::iterator ListBox::Insert(std::shared_ptr<Row> row, iterator it, bool dr
         retval = m_rows.begin();
     } else {
         if (!(m_style & LIST_NOSORT)) {
-            retval = m_rows.begin();
-            RowSorter cmp(m_sort_cmp, m_sort_col, m_style & LIST_SORTDESCENDING);
-            while (retval != m_rows.end() && !cmp(row.get(), retval->get())) {
-                ++retval;
-            }
+            // insert after any rows that sort equal to this one
+            retval = std::upper_bound(m_rows.begin(), m_rows.end(), row,
+                                      RowSorter(m_sort_cmp, m_sort_col, m_style & LIST_SORTDESCENDING));
         }
         retval = m_rows.insert(retval, row);
     }
@@ -1915,16 +1914,65 @@ ListBox::iterator ListBox::Insert(std::shared_ptr<Row> row, iterator it, bool dr
 
 void ListBox::Insert(const std::vector<std::shared_ptr<Row>>& rows, iterator it, bool dropped)
 {
+    if (!dropped && !(m_style & LIST_NOSORT) && rows.size() > 1) {
+        InsertSorted(std::vector<std::shared_ptr<Row>>(rows), it);
+        return;
+    }
     for (auto& row : rows)
         Insert(row, it, dropped);
 }
 
 void ListBox::Insert(std::vector<std::shared_ptr<Row>>&& rows, iterator it, bool dropped)
 {
+    if (!dropped && !(m_style & LIST_NOSORT) && rows.size() > 1) {
+        InsertSorted(std::move(rows), it);
+        return;
+    }
     for (auto& row : rows)
         Insert(std::move(row), it, dropped);
 }
 
+void ListBox::InsertSorted(std::vector<std::shared_ptr<Row>>&& rows, iterator it)
+{
+    std::list<std::shared_ptr<Row>> new_rows;
+    for (auto& row : rows) {
+        if (!row)
+            continue;
+
+        row->InstallEventFilter(shared_from_this());
+
+        BeforeInsertRowSignal(it);
+
+        AttachChild(row);
+
+        row->Hide();
+        row->Resize(Pt(std::max(ClientWidth(), X(1)), row->Height()));
+        row->RightClickedSignal.connect(
+            boost::bind(&ListBox::HandleRowRightClicked, this,
+                        boost::placeholders::_1, boost::placeholders::_2));
+
+        new_rows.emplace_back(std::move(row));
+    }
+    if (new_rows.empty())
+        return;
+    const std::size_t num_new_rows = new_rows.size();
+
+    // both sort and merge are stable, and merge puts rows already in the list
+    // before equal new rows, as inserting them one at a time would.  neither
+    // invalidates iterators to rows already in the list.
+    RowSorter cmp(m_sort_cmp, m_sort_col, m_style & LIST_SORTDESCENDING);
+    new_rows.sort(cmp);
+    m_rows.merge(new_rows, cmp);
+
+    if (m_first_row_shown == m_rows.end())
+        m_first_row_shown = m_rows.begin();
+
+    for (std::size_t i = 0; i < num_new_rows; ++i)
+        AfterInsertRowSignal(it);
+
+    RequirePreRender();
+}
+
 std::shared_ptr<ListBox::Row> ListBox::Erase(iterator it, bool removing_duplicate, bool signal)
 {
     if (it == m_rows.end())
@@ -2289,7 +2337,8 @@ void ListBox::AdjustScrolls(bool adjust_for_resize, const std::pair<bool, bool>&
         RequirePreRender();
         X row_width(std::max(ClientWidth(), X(1)));
         for (auto& row : m_rows) {
-            row->Resize(Pt(row_width, row->Height()));
+            if (row->Width() != row_width)
+                row->Resize(Pt(row_width, row->Height()));
         }
     }
 }
@@ -61,9 +61,12 @@ StaticGraphic::StaticGraphic(std::shared_ptr<Texture> texture,
     Control(X0, Y0, X1, Y1, flags),
     m_style(style)
 {
-    auto w = texture->DefaultWidth();
-    auto h = texture->DefaultHeight();
-    m_graphic = SubTexture(std::move(texture), X0, Y0, w, h);
+    m_graphic = GetTextureManager().AtlasedTexture(*texture);
+    if (m_graphic.Empty()) {
+        auto w = texture->DefaultWidth();
+        auto h = texture->DefaultHeight();
+        m_graphic = SubTexture(std::move(texture), X0, Y0, w, h);
+    }
 
     ValidateStyle();  // correct any disagreements in the style flags
     SetColor(CLR_WHITE);
@@ -191,7 +194,13 @@ void StaticGraphic::SetStyle(Flags<GraphicStyle> style)
 }
 
 void StaticGraphic::SetTexture(const std::shared_ptr<Texture>& texture)
-{ SetTexture(SubTexture(texture, X0, Y0, texture->DefaultWidth(), texture->DefaultHeight())); }
+{
+    auto atlased = GetTextureManager().AtlasedTexture(*texture);
+    if (!atlased.Empty())
+        SetTexture(atlased);
+    else
+        SetTexture(SubTexture(texture, X0, Y0, texture->DefaultWidth(), texture->DefaultHeight()));
+}
 
 void StaticGraphic::SetTexture(const SubTexture& subtexture)
 {
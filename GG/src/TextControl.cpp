@@ -7,9 +7,11 @@
 //! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
 //! SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <GG/DrawBatch.h>
 #include <GG/DrawUtil.h>
 #include <GG/TextControl.h>
 #include <GG/utf8/checked.h>
+#include <utility>
 
 
 using namespace GG;
@@ -184,11 +186,15 @@ void TextControl::Render()
         }
         if (m_clip_text)
             BeginClipping();
-        glPushMatrix();
         Pt ul = ClientUpperLeft();
-        glTranslated(Value(ul.x), Value(ul.y), 0);
-        m_font->RenderCachedText(*m_render_cache);
-        glPopMatrix();
+        if (GetDrawBatch().Active()) {
+            m_font->BatchCachedText(*m_render_cache, ul);
+        } else {
+            glPushMatrix();
+            glTranslated(Value(ul.x), Value(ul.y), 0);
+            m_font->RenderCachedText(*m_render_cache);
+            glPopMatrix();
+        }
         if (m_clip_text)
             EndClipping();
     }
@@ -208,6 +214,17 @@ void TextControl::SetText(std::string str)
 {
     if (!utf8::is_valid(str.begin(), str.end()))
         return;
+
+    // many controls are set to the text they already show each time they're
+    // refreshed, which needn't reparse it or redo its layout and render cache.
+    // the font and format setters, and edits of m_text in place, reset
+    // m_text before calling this, so always redo them.
+    if (m_font && !m_text_elements.empty() && str == m_text) {
+        if (m_format & FORMAT_NOWRAP)
+            Resize(m_text_lr - m_text_ul);
+        return;
+    }
+
     m_text = std::move(str);
 
     if (!m_font)
@@ -270,7 +287,7 @@ const std::shared_ptr<Font>& TextControl::GetFont() const
 void TextControl::SetFont(std::shared_ptr<Font> font)
 {
     m_font = font;
-    SetText(std::move(m_text));
+    SetText(std::exchange(m_text, std::string()));
 }
 
 void TextControl::SizeMove(const Pt& ul, const Pt& lr)
@@ -313,7 +330,7 @@ void TextControl::SetTextFormat(Flags<TextFormat> format)
     m_format = format;
     ValidateFormat();
     if (m_format != format)
-        SetText(std::move(m_text));
+        SetText(std::exchange(m_text, std::string()));
 }
 
 void TextControl::SetTextColor(Clr color)
@@ -377,7 +394,7 @@ void TextControl::Insert(std::size_t line, CPSize pos, char c)
     if (!detail::ValidUTFChar<char>()(c))
         return;
     m_text.insert(Value(StringIndexOf(line, pos, m_line_data)), 1, c);
-    SetText(std::move(m_text));
+    SetText(std::exchange(m_text, std::string()));
 }
 
 void TextControl::Insert(std::size_t line, CPSize pos, const std::string& s)
@@ -385,7 +402,7 @@ void TextControl::Insert(std::size_t line, CPSize pos, const std::string& s)
     if (!utf8::is_valid(s.begin(), s.end()))
         return;
     m_text.insert(Value(StringIndexOf(line, pos, m_line_data)), s);
-    SetText(std::move(m_text));
+    SetText(std::exchange(m_text, std::string()));
 }
 
 void TextControl::Erase(std::size_t line, CPSize pos, CPSize num/* = CP1*/)
@@ -395,7 +412,7 @@ void TextControl::Erase(std::size_t line, CPSize pos, CPSize num/* = CP1*/)
     if (it == end_it)
         return;
     m_text.erase(it, end_it);
-    SetText(std::move(m_text));
+    SetText(std::exchange(m_text, std::string()));
 }
 
 void TextControl::Erase(std::size_t line1, CPSize pos1, std::size_t line2, CPSize pos2)
@@ -410,7 +427,7 @@ void TextControl::Erase(std::size_t line1, CPSize pos1, std::size_t line2, CPSiz
     auto it = m_text.begin() + std::min(offset1, offset2);
     auto end_it = m_text.begin() + std::max(offset1, offset2);
     m_text.erase(it, end_it);
-    SetText(std::move(m_text));
+    SetText(std::exchange(m_text, std::string()));
 }
 
 const std::vector<Font::LineData>& TextControl::GetLineData() const
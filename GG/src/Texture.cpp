@@ -8,8 +8,10 @@
 //! SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <GG/Config.h>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/gil/extension/dynamic_image/any_image.hpp>
@@ -29,6 +31,8 @@
 #elif BOOST_VERSION >= 107000
 #include <boost/variant/get.hpp>
 #endif
+#include <GG/DrawBatch.h>
+#include <GG/FrameProfiler.h>
 #include <GG/GLClientAndServerBuffer.h>
 #include <GG/Texture.h>
 #include <GG/utf8/checked.h>
@@ -45,6 +49,30 @@ namespace {
             value *= 2;
         return value;
     }
+
+    constexpr int ATLAS_PAGE_SIZE = 2048;
+    constexpr int ATLAS_PADDING = 2;    // keeps neighbours from bleeding in when filtered
+
+    /** Returns \a image expanded to 4 bytes per pixel, as the GL would expand
+        it when used as a texture in its own format. */
+    std::vector<unsigned char> ToRGBA(const Texture::DecodedImage& image)
+    {
+        if (image.bytes_pp == 4)
+            return image.pixels;
+
+        const std::size_t num_pixels = image.pixels.size() / image.bytes_pp;
+        std::vector<unsigned char> retval;
+        retval.reserve(num_pixels * 4);
+        for (std::size_t i = 0; i < num_pixels; ++i) {
+            const unsigned char* pixel = &image.pixels[i * image.bytes_pp];
+            switch (image.bytes_pp) {
+            case 1:  retval.insert(retval.end(), {pixel[0], pixel[0], pixel[0], 255}); break;
+            case 2:  retval.insert(retval.end(), {pixel[0], pixel[0], pixel[0], pixel[1]}); break;
+            default: retval.insert(retval.end(), {pixel[0], pixel[1], pixel[2], 255}); break;
+            }
+        }
+        return retval;
+    }
 }
 
 ///////////////////////////////////////
@@ -102,6 +130,8 @@ void Texture::Blit(const GL2DVertexBuffer& vertex_buffer,
     if (m_opengl_id == 0)
         return;
 
+    GetDrawBatch().Flush();
+
     // HACK! This code ensures that unscaled textures are reproduced exactly, even
     // though they theoretically should be even when using non-GL_NEAREST* scaling.
     bool need_min_filter_change = !render_scaled && m_min_filter != GL_NEAREST;
@@ -123,6 +153,8 @@ void Texture::Blit(const GL2DVertexBuffer& vertex_buffer,
     vertex_buffer.activate();
     tex_coord_buffer.activate();
     glDrawArrays(GL_QUADS, 0, vertex_buffer.size());
+    GetFrameProfiler().CountTextureBind();
+    GetFrameProfiler().CountDrawCall();
 
     if (need_min_filter_change)
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_min_filter);
@@ -188,12 +220,41 @@ void Texture::OrthoBlit(const Pt& pt) const
 
 void Texture::Load(const boost::filesystem::path& path, bool mipmap/* = false*/)
 {
-    namespace gil = boost::gil;
-    namespace fs = boost::filesystem;
+    if (m_opengl_id)
+        Clear();
 
+    Load(Decode(path), mipmap);
+}
+
+void Texture::Load(const DecodedImage& image, bool mipmap/* = false*/)
+{
     if (m_opengl_id)
         Clear();
 
+    GLenum format = GL_INVALID_ENUM;
+    switch (image.bytes_pp) {
+    case 1:  format = GL_LUMINANCE; break;
+    case 2:  format = GL_LUMINANCE_ALPHA; break;
+    case 3:  format = GL_RGB; break;
+    case 4:  format = GL_RGBA; break;
+    default: throw BadFile("Texture file \"" + image.path.generic_string() + "\" does not have a supported number of color channels (1-4)");
+    }
+
+    m_path = image.path;
+    m_default_width = image.width;
+    m_default_height = image.height;
+    m_type = GL_UNSIGNED_BYTE;
+    m_bytes_pp = image.bytes_pp;
+    m_format = format;
+
+    Init(m_default_width, m_default_height, image.pixels.data(), m_format, m_type, m_bytes_pp, mipmap);
+}
+
+Texture::DecodedImage Texture::Decode(const boost::filesystem::path& path)
+{
+    namespace gil = boost::gil;
+    namespace fs = boost::filesystem;
+
     if (!fs::exists(path)) {
         std::cerr << "Texture::Load passed non-existant path: " << path.generic_string() << std::endl;
         throw BadFile("Texture file \"" + path.generic_string() + "\" does not exist");
@@ -276,29 +337,29 @@ void Texture::Load(const boost::filesystem::path& path, bool mipmap/* = false*/)
 #endif
     }
 
-    m_path = path;
-    m_default_width = X(image.width());
-    m_default_height = Y(image.height());
-    m_type = GL_UNSIGNED_BYTE;
+    DecodedImage retval;
+    retval.path = path;
+    retval.width = X(image.width());
+    retval.height = Y(image.height());
 
 #if BOOST_VERSION >= 107400
 #define IF_IMAGE_TYPE_IS(image_prefix)                                  \
     if (boost::variant2::get_if<image_prefix ## _image_t>(&image)) {    \
-        m_bytes_pp = sizeof(image_prefix ## _pixel_t);                  \
+        retval.bytes_pp = sizeof(image_prefix ## _pixel_t);             \
         image_data = interleaved_view_get_raw_data(                     \
             const_view(boost::variant2::get<image_prefix ## _image_t>(image))); \
     }
 #elif BOOST_VERSION >= 107000
 #define IF_IMAGE_TYPE_IS(image_prefix)                                  \
     if (boost::get<image_prefix ## _image_t>(&image)) {                 \
-        m_bytes_pp = sizeof(image_prefix ## _pixel_t);                  \
+        retval.bytes_pp = sizeof(image_prefix ## _pixel_t);             \
         image_data = interleaved_view_get_raw_data(                     \
             const_view(boost::get<image_prefix ## _image_t>(image)));   \
     }
 #else
 #define IF_IMAGE_TYPE_IS(image_prefix)                                  \
     if (image.current_type_is<image_prefix ## _image_t>()) {            \
-        m_bytes_pp = sizeof(image_prefix ## _pixel_t);                  \
+        retval.bytes_pp = sizeof(image_prefix ## _pixel_t);             \
         image_data = interleaved_view_get_raw_data(                     \
             const_view(image._dynamic_cast<image_prefix ## _image_t>())); \
     }
@@ -313,16 +374,12 @@ void Texture::Load(const boost::filesystem::path& path, bool mipmap/* = false*/)
 
 #undef IF_IMAGE_TYPE_IS
 
-    switch (m_bytes_pp) {
-    case 1:  m_format = GL_LUMINANCE; break;
-    case 2:  m_format = GL_LUMINANCE_ALPHA; break;
-    case 3:  m_format = GL_RGB; break;
-    case 4:  m_format = GL_RGBA; break;
-    default: throw BadFile("Texture file \"" + filename + "\" does not have a supported number of color channels (1-4)");
-    }
+    if (retval.bytes_pp < 1 || retval.bytes_pp > 4)
+        throw BadFile("Texture file \"" + filename + "\" does not have a supported number of color channels (1-4)");
 
     assert(image_data);
-    Init(m_default_width, m_default_height, image_data, m_format, m_type, m_bytes_pp, mipmap);
+    retval.pixels.assign(image_data, image_data + image.width() * image.height() * retval.bytes_pp);
+    return retval;
 }
 
 void Texture::Init(X width, Y height, const unsigned char* image, GLenum format, GLenum type,
@@ -346,6 +403,21 @@ void Texture::Init(X width, Y height, const unsigned char* image, GLenum format,
     glPopClientAttrib();
 }
 
+void Texture::SetSubImage(X x, Y y, X width, Y height, const unsigned char* image)
+{
+    if (!m_opengl_id || !image)
+        return;
+
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, m_opengl_id);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, Value(x), Value(y), Value(width), Value(height), m_format, m_type, image);
+    glPopClientAttrib();
+}
+
 void Texture::SetFilters(GLenum min, GLenum mag)
 {
     m_min_filter = min;
@@ -574,6 +646,8 @@ std::shared_ptr<Texture> TextureManager::StoreTexture(Texture* texture, std::str
 std::shared_ptr<Texture> TextureManager::StoreTexture(std::shared_ptr<Texture> texture, std::string texture_name)
 {
     std::scoped_lock lock(m_texture_access_guard);
+    m_pending_textures.erase(texture_name);
+    m_atlased_textures.erase(texture_name);
     m_textures[std::move(texture_name)] = texture;
     return texture;
 }
@@ -581,15 +655,80 @@ std::shared_ptr<Texture> TextureManager::StoreTexture(std::shared_ptr<Texture> t
 std::shared_ptr<Texture> TextureManager::GetTexture(const boost::filesystem::path& path, bool mipmap/* = false*/)
 {
     std::scoped_lock lock(m_texture_access_guard);
-    auto it = m_textures.find(path.generic_string());
+    auto name = path.generic_string();
+    auto it = m_textures.find(name);
     if (it == m_textures.end()) { // if no such texture was found, attempt to load it now, using name as the filename
         //std::cout << "TextureManager::GetTexture storing new texture under name: " << path.generic_string();
         return LoadTexture(path, mipmap);
-    } else { // otherwise, just return the found texture
+    } else { // otherwise, just return the found texture, once it has been loaded
+        try {
+            FinishLoadingTexture(name);
+        } catch (...) {
+            m_textures.erase(it);
+            throw;
+        }
         return it->second;
     }
 }
 
+std::shared_ptr<Texture> TextureManager::GetTextureAsync(const boost::filesystem::path& path, bool mipmap/* = false*/)
+{
+    std::scoped_lock lock(m_texture_access_guard);
+    DecodeQueue decodes;
+    auto retval = StartLoadingTexture(path, mipmap, decodes);
+    StartDecoding(std::move(decodes));
+    return retval;
+}
+
+void TextureManager::PrefetchTextures(const std::vector<boost::filesystem::path>& paths, bool mipmap/* = false*/)
+{
+    std::scoped_lock lock(m_texture_access_guard);
+    DecodeQueue decodes;
+    for (auto& path : paths)
+        StartLoadingTexture(path, mipmap, decodes);
+    if (decodes.empty())
+        return;
+
+    // decode on a few tasks, rather than one per image, so that a large
+    // prefetch doesn't start a thread for every file
+    const std::size_t num_tasks = std::min<std::size_t>(
+        decodes.size(), std::max(1u, std::thread::hardware_concurrency() / 2));
+    const std::size_t per_task = (decodes.size() + num_tasks - 1) / num_tasks;
+    for (std::size_t first = 0; first < decodes.size(); first += per_task) {
+        auto last = std::min(first + per_task, decodes.size());
+        StartDecoding({std::make_move_iterator(decodes.begin() + first),
+                       std::make_move_iterator(decodes.begin() + last)});
+    }
+}
+
+void TextureManager::UploadPendingTextures(std::chrono::microseconds budget)
+{
+    std::scoped_lock lock(m_texture_access_guard);
+
+    m_decode_tasks.erase(std::remove_if(m_decode_tasks.begin(), m_decode_tasks.end(),
+                                        [](const std::future<void>& task)
+                                        { return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }),
+                         m_decode_tasks.end());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto it = m_pending_textures.begin();
+         it != m_pending_textures.end() && std::chrono::steady_clock::now() - start < budget;)
+    {
+        if (it->second.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        auto name = it->first;
+        ++it;
+        try {
+            FinishLoadingTexture(name);
+        } catch (const std::exception& e) {
+            // leave the placeholder empty, as there's no caller to report to
+            std::cerr << "TextureManager unable to load texture \"" << name << "\": " << e.what() << std::endl;
+        }
+    }
+}
+
 void TextureManager::FreeTexture(const boost::filesystem::path& path)
 { FreeTexture(path.generic_string()); }
 
@@ -599,17 +738,134 @@ void TextureManager::FreeTexture(const std::string& name)
     auto it = m_textures.find(name);
     if (it != m_textures.end())
         m_textures.erase(it);
+    m_pending_textures.erase(name);
+    m_atlased_textures.erase(name);
+}
+
+void TextureManager::SetMaxAtlasedSize(X width, Y height)
+{
+    std::scoped_lock lock(m_texture_access_guard);
+    m_max_atlased_width = width;
+    m_max_atlased_height = height;
+}
+
+SubTexture TextureManager::AtlasedTexture(const Texture& texture) const
+{
+    std::scoped_lock lock(m_texture_access_guard);
+    auto name = texture.Path().generic_string();
+    auto it = m_atlased_textures.find(name);
+    if (it == m_atlased_textures.end())
+        return SubTexture();
+
+    // another texture may have since been stored under the same name
+    auto texture_it = m_textures.find(name);
+    if (texture_it == m_textures.end() || texture_it->second.get() != &texture)
+        return SubTexture();
+    return it->second;
 }
 
 std::shared_ptr<Texture> TextureManager::LoadTexture(const boost::filesystem::path& path, bool mipmap)
 {
     // only called from other TextureManager functions that should already have locked m_texture_access_guard
     auto temp = std::make_shared<Texture>();
-    temp->Load(path, mipmap);
+    auto image = Texture::Decode(path);
+    temp->Load(image, mipmap);
+    AddToAtlas(path.generic_string(), image, mipmap);
     m_textures[path.generic_string()] = temp;
     return temp;
 }
 
+std::shared_ptr<Texture> TextureManager::StartLoadingTexture(const boost::filesystem::path& path, bool mipmap,
+                                                             DecodeQueue& decodes)
+{
+    // only called from other TextureManager functions that should already have locked m_texture_access_guard
+    auto name = path.generic_string();
+    auto it = m_textures.find(name);
+    if (it != m_textures.end())
+        return it->second;
+
+    auto temp = std::make_shared<Texture>();
+    decodes.emplace_back(path, std::promise<Texture::DecodedImage>());
+    m_pending_textures[name] = {temp, decodes.back().second.get_future(), mipmap};
+    m_textures[std::move(name)] = temp;
+    return temp;
+}
+
+void TextureManager::StartDecoding(DecodeQueue&& decodes)
+{
+    // only called from other TextureManager functions that should already have locked m_texture_access_guard
+    if (decodes.empty())
+        return;
+    m_decode_tasks.push_back(std::async(std::launch::async, [decodes{std::move(decodes)}]() mutable {
+        for (auto& [path, promise] : decodes) {
+            try {
+                promise.set_value(Texture::Decode(path));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }));
+}
+
+void TextureManager::FinishLoadingTexture(const std::string& name)
+{
+    // only called from other TextureManager functions that should already have locked m_texture_access_guard
+    auto it = m_pending_textures.find(name);
+    if (it == m_pending_textures.end())
+        return;
+    auto pending = std::move(it->second);
+    m_pending_textures.erase(it);
+    auto image = pending.image.get();
+    pending.texture->Load(image, pending.mipmap);
+    AddToAtlas(name, image, pending.mipmap);
+}
+
+void TextureManager::AddToAtlas(const std::string& name, const Texture::DecodedImage& image, bool mipmap)
+{
+    // only called from other TextureManager functions that should already have locked m_texture_access_guard
+    if (image.width > m_max_atlased_width || image.height > m_max_atlased_height ||
+        image.width <= X0 || image.height <= Y0)
+    { return; }
+
+    const X padded_width = image.width + ATLAS_PADDING;
+    const Y padded_height = image.height + ATLAS_PADDING;
+
+    // pack into the latest page with the same mipmapping, moving to a new row
+    // or a new page when the image doesn't fit
+    auto page_it = std::find_if(m_atlas_pages.rbegin(), m_atlas_pages.rend(),
+                                [mipmap](const AtlasPage& page) { return page.mipmap == mipmap; });
+    if (page_it != m_atlas_pages.rend() && page_it->row_x + padded_width > ATLAS_PAGE_SIZE) {
+        page_it->row_x = X0;
+        page_it->row_y += page_it->row_height;
+        page_it->row_height = Y0;
+    }
+    if (page_it == m_atlas_pages.rend() || page_it->row_y + padded_height > ATLAS_PAGE_SIZE) {
+        AtlasPage page;
+        page.texture = std::make_shared<Texture>();
+        std::vector<unsigned char> zero_data(4 * ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE);
+        try {
+            page.texture->Init(X(ATLAS_PAGE_SIZE), Y(ATLAS_PAGE_SIZE), zero_data.data(),
+                               GL_RGBA, GL_UNSIGNED_BYTE, 4, mipmap);
+        } catch (const std::exception& e) {
+            std::cerr << "TextureManager unable to create texture atlas: " << e.what() << std::endl;
+            m_max_atlased_width = X0;
+            m_max_atlased_height = Y0;
+            return;
+        }
+        page.mipmap = mipmap;
+        m_atlas_pages.push_back(std::move(page));
+        page_it = m_atlas_pages.rbegin();
+    }
+
+    const X x = page_it->row_x;
+    const Y y = page_it->row_y;
+    page_it->texture->SetSubImage(x, y, image.width, image.height, ToRGBA(image).data());
+    page_it->row_x += padded_width;
+    page_it->row_height = std::max(page_it->row_height, padded_height);
+
+    m_atlased_textures[name] = SubTexture(page_it->texture, x, y, x + image.width, y + image.height);
+}
+
 TextureManager& GG::GetTextureManager()
 {
     static TextureManager manager;
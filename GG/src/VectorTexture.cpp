@@ -11,6 +11,7 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <GG/Config.h>
+#include <GG/DrawBatch.h>
 #include <GG/DrawUtil.h>
 #include <GG/GLClientAndServerBuffer.h>
 #include <GG/utf8/checked.h>
@@ -198,7 +199,10 @@ Pt VectorTexture::Size() const
 { return m_impl->Size(); }
 
 void VectorTexture::Render(const Pt& ul, const Pt& lr) const
-{ m_impl->Render(ul, lr); }
+{
+    GetDrawBatch().Flush();
+    m_impl->Render(ul, lr);
+}
 
 void VectorTexture::Load(const boost::filesystem::path& path)
 {
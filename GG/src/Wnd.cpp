@@ -7,6 +7,10 @@
 //! Some Rights Reserved.  See COPYING file or https://www.gnu.org/licenses/lgpl-2.1.txt
 //! SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -131,6 +135,93 @@ bool dummy = RegisterWndFlags();
 }
 
 
+///////////////////////////////////////
+// class GG::Wnd::ChildPickIndex
+///////////////////////////////////////
+/** A uniform grid over the PickBounds() of the children of a Wnd, relative to
+    its client area so that moving the Wnd itself doesn't invalidate it.  Each
+    cell lists the children whose bounds overlap it, by their position in the
+    child list.  Children that overlap very many cells are instead checked for
+    every point. */
+class Wnd::ChildPickIndex
+{
+public:
+    void Clear() noexcept {
+        m_valid = false;
+        m_children.clear();
+        m_bounds.clear();
+        m_cells.clear();
+        m_large_children.clear();
+    }
+
+    std::vector<std::shared_ptr<Wnd>> ChildrenInPickBounds(const Wnd& wnd, const Pt& pt) {
+        if (!m_valid)
+            Build(wnd);
+
+        const Pt client_pt = pt - wnd.ClientUpperLeft();
+        std::vector<std::uint32_t> candidates(m_large_children);
+        const auto cell_it = m_cells.find(CellKey(Cell(client_pt.x), Cell(client_pt.y)));
+        if (cell_it != m_cells.end())
+            candidates.insert(candidates.end(), cell_it->second.begin(), cell_it->second.end());
+        // topmost, so last in the child list, first
+        std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+        std::vector<std::shared_ptr<Wnd>> retval;
+        for (auto idx : candidates)
+            if (m_bounds[idx].Contains(client_pt))
+                retval.push_back(m_children[idx]);
+        return retval;
+    }
+
+private:
+    static constexpr int CELL_SIZE = 64;
+    static constexpr std::int64_t MAX_CELLS_PER_CHILD = 64;
+
+    static int Cell(int coord) noexcept
+    { return coord >= 0 ? coord / CELL_SIZE : (coord + 1) / CELL_SIZE - 1; }
+    static int Cell(X x) noexcept { return Cell(Value(x)); }
+    static int Cell(Y y) noexcept { return Cell(Value(y)); }
+
+    static std::uint64_t CellKey(int cell_x, int cell_y) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_x)) << 32) |
+                static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_y));
+    }
+
+    void Build(const Wnd& wnd) {
+        Clear();
+        const Pt client_ul = wnd.ClientUpperLeft();
+        m_children.assign(wnd.m_children.begin(), wnd.m_children.end());
+        m_bounds.reserve(m_children.size());
+
+        for (std::size_t idx = 0; idx < m_children.size(); ++idx) {
+            const auto bounds = m_children[idx]->PickBounds() - client_ul;
+            m_bounds.push_back(bounds);
+            if (bounds.lr.x <= bounds.ul.x || bounds.lr.y <= bounds.ul.y)
+                continue;
+
+            const int first_x = Cell(bounds.ul.x), last_x = Cell(bounds.lr.x - X1);
+            const int first_y = Cell(bounds.ul.y), last_y = Cell(bounds.lr.y - Y1);
+            const auto num_cells = static_cast<std::int64_t>(last_x - first_x + 1) * (last_y - first_y + 1);
+            if (num_cells > MAX_CELLS_PER_CHILD) {
+                m_large_children.push_back(static_cast<std::uint32_t>(idx));
+                continue;
+            }
+            for (int cell_x = first_x; cell_x <= last_x; ++cell_x)
+                for (int cell_y = first_y; cell_y <= last_y; ++cell_y)
+                    m_cells[CellKey(cell_x, cell_y)].push_back(static_cast<std::uint32_t>(idx));
+        }
+
+        m_valid = true;
+    }
+
+    bool                                                            m_valid = false;
+    std::vector<std::shared_ptr<Wnd>>                               m_children;         ///< in the order of the indexed Wnd's child list
+    std::vector<Rect>                                               m_bounds;           ///< PickBounds() of each child, relative to the client area
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>>   m_cells;            ///< indices of children overlapping each cell
+    std::vector<std::uint32_t>                                      m_large_children;   ///< indices of children overlapping more than MAX_CELLS_PER_CHILD cells
+};
+
+
 ///////////////////////////////////////
 // class GG::Wnd
 ///////////////////////////////////////
@@ -334,9 +425,27 @@ bool Wnd::InWindow(const Pt& pt) const
 bool Wnd::InClient(const Pt& pt) const
 { return pt >= ClientUpperLeft() && pt < ClientLowerRight(); }
 
+Rect Wnd::PickBounds() const
+{ return Rect(UpperLeft(), LowerRight()); }
+
 const std::list<std::shared_ptr<Wnd>>& Wnd::Children() const
 { return m_children; }
 
+bool Wnd::ChildPickIndexing() const
+{ return m_child_pick_index != nullptr; }
+
+std::vector<std::shared_ptr<Wnd>> Wnd::ChildrenInPickBounds(const Pt& pt) const
+{
+    if (m_child_pick_index)
+        return m_child_pick_index->ChildrenInPickBounds(*this, pt);
+
+    std::vector<std::shared_ptr<Wnd>> retval;
+    for (auto it = m_children.rbegin(); it != m_children.rend(); ++it)
+        if ((*it)->PickBounds().Contains(pt))
+            retval.push_back(*it);
+    return retval;
+}
+
 std::shared_ptr<Wnd> Wnd::Parent() const
 { return LockAndResetIfExpired(m_parent); }
 
@@ -493,6 +602,20 @@ void Wnd::SetChildClippingMode(ChildClippingMode mode)
 void Wnd::NonClientChild(bool b)
 { m_non_client_child = b; }
 
+void Wnd::SetChildPickIndexing(bool b)
+{
+    if (!b)
+        m_child_pick_index.reset();
+    else if (!m_child_pick_index)
+        m_child_pick_index = std::make_unique<ChildPickIndex>();
+}
+
+void Wnd::InvalidateChildPickIndex() noexcept
+{
+    if (m_child_pick_index)
+        m_child_pick_index->Clear();
+}
+
 void Wnd::MoveTo(const Pt& pt)
 { SizeMove(pt, pt + Size()); }
 
@@ -507,6 +630,10 @@ void Wnd::SizeMove(const Pt& ul_, const Pt& lr_)
     if (resized)
         ClampRectWithMinAndMaxSize(ul, lr);
 
+    if (ul != m_upperleft || lr != m_lowerright)
+        if (auto&& parent = Parent())
+            parent->InvalidateChildPickIndex();
+
     m_upperleft = ul;
     m_lowerright = lr;
     if (resized) {
@@ -565,6 +692,7 @@ void Wnd::AttachChild(std::shared_ptr<Wnd> wnd)
             wnd->m_containing_layout = this_as_layout;
 
         m_children.emplace_back(std::move(wnd));
+        InvalidateChildPickIndex();
 
     } catch (const std::bad_weak_ptr&) {
         std::cerr << "\nWnd::AttachChild called either during the constructor "
@@ -589,6 +717,7 @@ void Wnd::MoveChildUp(Wnd* wnd)
         return;
     m_children.emplace_back(std::move(*it));
     m_children.erase(it);
+    InvalidateChildPickIndex();
 }
 
 void Wnd::MoveChildDown(const std::shared_ptr<Wnd>& wnd)
@@ -605,6 +734,7 @@ void Wnd::MoveChildDown(Wnd* wnd)
 
     m_children.emplace_front(std::move(*found));
     m_children.erase(found);
+    InvalidateChildPickIndex();
 }
 
 void Wnd::DetachChild(const std::shared_ptr<Wnd>& wnd)
@@ -620,6 +750,7 @@ void Wnd::DetachChild(Wnd* wnd)
     DetachChildCore(wnd);
 
     m_children.erase(it);
+    InvalidateChildPickIndex();
 }
 
 void Wnd::DetachChildCore(Wnd* wnd)
@@ -643,6 +774,7 @@ void Wnd::DetachChildren()
         DetachChildCore(wnd.get());
     }
     m_children.clear();
+    InvalidateChildPickIndex();
 }
 
 void Wnd::InstallEventFilter(const std::shared_ptr<Wnd>& wnd)
@@ -20,14 +20,26 @@ std::shared_ptr<Wnd> PickWithinWindow(const Pt& pt, std::shared_ptr<Wnd> wnd,
 {
     // look through all the children of wnd, and determine whether pt lies in
     // any of them (or their children)
-    const auto& end_it = wnd->Children().rend();
-    for (auto it = wnd->Children().rbegin(); it != end_it; ++it) {
-        if (!(*it)->Visible())
-            continue;
-        if (!(*it)->InWindow(pt))
-            continue;
-        if (auto temp = PickWithinWindow(pt, *it, ignore))
-            return temp;
+    if (wnd->ChildPickIndexing()) {
+        // only look at the children that might contain pt
+        for (auto& child : wnd->ChildrenInPickBounds(pt)) {
+            if (!child->Visible())
+                continue;
+            if (!child->InWindow(pt))
+                continue;
+            if (auto temp = PickWithinWindow(pt, std::move(child), ignore))
+                return temp;
+        }
+    } else {
+        const auto& end_it = wnd->Children().rend();
+        for (auto it = wnd->Children().rbegin(); it != end_it; ++it) {
+            if (!(*it)->Visible())
+                continue;
+            if (!(*it)->InWindow(pt))
+                continue;
+            if (auto temp = PickWithinWindow(pt, *it, ignore))
+                return temp;
+        }
     }
 
     // if wnd is visible and clickable, return it if no child windows also catch pt
@@ -27,6 +27,7 @@
 #include <GG/Layout.h>
 #include <GG/StaticGraphic.h>
 
+#include <algorithm>
 #include <iterator>
 
 namespace {
@@ -38,6 +39,14 @@ namespace {
     { db.Add("ui." + PROD_PEDIA_WND_NAME + ".hidden.enabled", UserStringNop("OPTIONS_DB_PRODUCTION_PEDIA_HIDDEN"), false); }
     bool temp_bool = RegisterOptions(&AddOptions);
 
+    /** Returns true iff \a empire can produce \a item at \a location_id.  The
+      * locations of each item are evaluated for all the empire's planets at
+      * once and kept, so selecting other planets doesn't evaluate them again. */
+    bool ProducibleAt(const Empire& empire, const ProductionQueue::ProductionItem& item, int location_id) {
+        const auto locations = empire.ProducibleItemLocations(item);
+        return std::binary_search(locations.begin(), locations.end(), location_id);
+    }
+
     const int MAX_PRODUCTION_TURNS = 200;
     const float EPSILON = 0.001f;
 
@@ -543,7 +552,7 @@ namespace {
             m_panel = GG::Wnd::Create<ProductionItemPanel>(w, h, m_item, empire_id, location_id);
 
             if (const Empire* empire = GetEmpire(empire_id)) {
-                if (!empire->ProducibleItem(m_item, location_id)) {
+                if (!ProducibleAt(*empire, m_item, location_id)) {
                     this->Disable(true);
                     m_panel->Disable(true);
                 }
@@ -902,7 +911,7 @@ bool BuildDesignatorWnd::BuildSelector::BuildableItemVisible(BuildType build_typ
     if (!empire)
         return true;
 
-    return empire->ProducibleItem(build_type, m_production_location);
+    return ProducibleAt(*empire, ProductionQueue::ProductionItem(build_type), m_production_location);
 }
 
 bool BuildDesignatorWnd::BuildSelector::BuildableItemVisible(BuildType build_type,
@@ -925,7 +934,8 @@ bool BuildDesignatorWnd::BuildSelector::BuildableItemVisible(BuildType build_typ
     // check that item is both enqueuable and producible, since most buildings currently have
     // nonselective EnqueueLocation conditions
     bool enqueuable_here = empire->EnqueuableItem(BuildType::BT_BUILDING, name, m_production_location) &&
-                           empire->ProducibleItem(BuildType::BT_BUILDING, name, m_production_location);
+                           ProducibleAt(*empire, ProductionQueue::ProductionItem(BuildType::BT_BUILDING, name),
+                                        m_production_location);
 
     if (enqueuable_here)
         return m_availabilities_shown.first;
@@ -948,7 +958,8 @@ bool BuildDesignatorWnd::BuildSelector::BuildableItemVisible(BuildType build_typ
     if (!empire)
         return true;
 
-    bool producible_here = empire->ProducibleItem(BuildType::BT_SHIP, design_id, m_production_location);
+    bool producible_here = ProducibleAt(*empire, ProductionQueue::ProductionItem(BuildType::BT_SHIP, design_id),
+                                        m_production_location);
 
     if (producible_here)
         return m_availabilities_shown.first;
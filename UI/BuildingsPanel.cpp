@@ -364,11 +364,17 @@ void BuildingIndicator::Refresh() {
             texture, GG::GRAPHIC_FITGRAPHIC | GG::GRAPHIC_PROPSCALE);
         AttachChild(m_graphic);
 
-        std::string desc = UserString(type->Description());
-        if (building->GetMeter(MeterType::METER_STEALTH))
-            desc = UserString("METER_STEALTH") + boost::io::str(boost::format(": %3.1f\n\n") % building->GetMeter(MeterType::METER_STEALTH)->Current()) + desc;
-        if (GetOptionsDB().Get<bool>("resource.effects.description.shown") && !type->Effects().empty())
-            desc += "\n" + Dump(type->Effects());
+        // the description, with a dump of the effects, is only made if the
+        // tooltip is shown
+        auto desc = [type, building_id{m_building_id}]() {
+            std::string desc = UserString(type->Description());
+            auto building = Objects().get<Building>(building_id);
+            if (building && building->GetMeter(MeterType::METER_STEALTH))
+                desc = UserString("METER_STEALTH") + boost::io::str(boost::format(": %3.1f\n\n") % building->GetMeter(MeterType::METER_STEALTH)->Current()) + desc;
+            if (GetOptionsDB().Get<bool>("resource.effects.description.shown") && !type->Effects().empty())
+                desc += "\n" + Dump(type->Effects());
+            return desc;
+        };
 
         SetBrowseInfoWnd(GG::Wnd::Create<IconTextBrowseWnd>(
             std::move(texture), UserString(type->Name()), std::move(desc)));
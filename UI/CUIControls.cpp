@@ -7,6 +7,7 @@
 #include "Sound.h"
 #include "Hotkeys.h"
 #include "../client/human/GGHumanClientApp.h"
+#include "../util/Directories.h"
 #include "../util/i18n.h"
 #include "../util/Logger.h"
 #include "../util/OptionsDB.h"
@@ -16,6 +17,7 @@
 
 #include <GG/utf8/checked.h>
 #include <GG/dialogs/ColorDlg.h>
+#include <GG/FrameProfiler.h>
 #include <GG/GUI.h>
 #include <GG/Layout.h>
 
@@ -1172,6 +1174,7 @@ void CUILinkTextMultiEdit::CompleteConstruction() {
 
     FindLinks();
     MarkLinks();
+    LocateLinks();
 }
 
 const std::vector<GG::Font::LineData>& CUILinkTextMultiEdit::GetLineData() const
@@ -1268,8 +1271,12 @@ void CUILinkTextMultiEdit::SetText(std::string str) {
     // SetText
     if (!m_already_setting_text_so_dont_link) {
         m_already_setting_text_so_dont_link = true;
+        // setting the same text again, as when resizing, needs no reset of
+        // the control; the links of the text are found from it or its cache
+        const bool text_changed = str != m_raw_text;
         m_raw_text = std::move(str);
-        CUIMultiEdit::SetText(m_raw_text);  // so that line data is updated for use in FindLinks. intentionally not moving
+        if (text_changed)
+            CUIMultiEdit::SetText(m_raw_text);  // resets the control for the new text. intentionally not moving
         FindLinks();
         MarkLinks();
         m_already_setting_text_so_dont_link = false;
@@ -2257,6 +2264,84 @@ void FPSIndicator::UpdateEnabled() {
 }
 
 
+//////////////////////////////////////////////////
+// FrameProfilerOverlay
+//////////////////////////////////////////////////
+namespace {
+    constexpr unsigned int FRAME_PROFILER_UPDATE_INTERVAL = 500;    // ms
+    constexpr std::size_t FRAME_PROFILER_WNDS_SHOWN = 8;
+
+    std::string Ms(GG::FrameProfiler::Duration duration)
+    { return DoubleToString(duration.count() / 1000.0, 3, false); }
+}
+
+FrameProfilerOverlay::FrameProfilerOverlay() :
+    GG::TextControl(GG::X0, GG::Y0, GG::X1, GG::Y1, "", ClientUI::GetFont(),
+                    ClientUI::TextColor(), GG::FORMAT_LEFT | GG::FORMAT_TOP | GG::FORMAT_NOWRAP,
+                    GG::ONTOP)
+{
+    SetResetMinSize(true);
+    GetOptionsDB().OptionChangedSignal("video.profiler.shown").connect(
+        boost::bind(&FrameProfilerOverlay::UpdateEnabled, this));
+    GetOptionsDB().OptionChangedSignal("video.profiler.trace.frames").connect(
+        boost::bind(&FrameProfilerOverlay::StartTrace, this));
+    UpdateEnabled();
+    StartTrace();
+}
+
+void FrameProfilerOverlay::PreRender() {
+    GG::Wnd::PreRender();
+    if (!Visible())
+        return;
+    // keep updating each frame, but only re-layout the text occasionally so
+    // as not to distort the measurements much
+    RequirePreRender();
+    unsigned int ticks = GG::GUI::GetGUI()->Ticks();
+    if (ticks - m_last_update_ticks < FRAME_PROFILER_UPDATE_INTERVAL)
+        return;
+    m_last_update_ticks = ticks;
+
+    const auto& frame = GG::GetFrameProfiler().LastFrame();
+    std::string text = boost::io::str(FlexibleFormat(UserString("FRAME_PROFILER_SUMMARY"))
+        % frame.frame % Ms(frame.prerender) % Ms(frame.render)
+        % (frame.gpu_ms < 0.0 ? UserString("UNKNOWN_VALUE_SYMBOL") : DoubleToString(frame.gpu_ms, 3, false))
+        % frame.draw_calls % frame.texture_binds % frame.buffer_uploads);
+
+    auto wnds = frame.wnds;
+    std::sort(wnds.begin(), wnds.end(), [](const auto& lhs, const auto& rhs)
+              { return lhs.prerender + lhs.render > rhs.prerender + rhs.render; });
+    if (wnds.size() > FRAME_PROFILER_WNDS_SHOWN)
+        wnds.resize(FRAME_PROFILER_WNDS_SHOWN);
+    for (const auto& wnd : wnds)
+        text.append("\n").append(boost::io::str(FlexibleFormat(UserString("FRAME_PROFILER_WND"))
+            % (wnd.name.empty() ? UserString("UNKNOWN_VALUE_SYMBOL") : wnd.name)
+            % Ms(wnd.prerender) % Ms(wnd.render)));
+
+    SetText(std::move(text));
+}
+
+void FrameProfilerOverlay::UpdateEnabled() {
+    bool enabled = GetOptionsDB().Get<bool>("video.profiler.shown");
+    GG::GetFrameProfiler().SetEnabled(enabled);
+    if (enabled) {
+        m_last_update_ticks = 0;
+        Show();
+        RequirePreRender();
+    } else {
+        Hide();
+    }
+}
+
+void FrameProfilerOverlay::StartTrace() {
+    int frames = GetOptionsDB().Get<int>("video.profiler.trace.frames");
+    if (frames <= 0)
+        return;
+    const auto path = GetUserDataDir() / "frame_trace.tsv";
+    InfoLogger() << "Writing frame trace of " << frames << " frames to " << PathToString(path);
+    GG::GetFrameProfiler().TraceFrames(frames, PathToString(path));
+}
+
+
 //////////////////////////////////////////////////
 // MultiTextureStaticGraphic
 //////////////////////////////////////////////////
@@ -2439,7 +2524,7 @@ void RotatingGraphic::Render() {
 
     // set up texture coordinates for vertices
     GLfloat texture_coordinate_data[8];
-    const GLfloat* tex_coords = texture->DefaultTexCoords();
+    const GLfloat* tex_coords = GetTexture().TexCoords();
     texture_coordinate_data[2*0] =      tex_coords[0];
     texture_coordinate_data[2*0 + 1] =  tex_coords[1];
     texture_coordinate_data[2*1] =      tex_coords[2];
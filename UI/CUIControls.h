@@ -587,6 +587,22 @@ private:
     int m_displayed_FPS = 0;
 };
 
+/** Shows the per-frame rendering statistics of GG::FrameProfiler on top of
+  * all other windows, while the video.profiler.shown option is set.  Also
+  * starts frame traces when video.profiler.trace.frames is set. */
+class FrameProfilerOverlay : public GG::TextControl {
+public:
+    FrameProfilerOverlay();
+
+    void PreRender() override;
+
+private:
+    void UpdateEnabled();
+    void StartTrace();
+
+    unsigned int m_last_update_ticks = 0;
+};
+
 /** Functions like a StaticGraphic, except can have multiple textures rendered
   * on top of eachother, rather than just a single texture. */
 class MultiTextureStaticGraphic : public GG::Control {
@@ -635,6 +651,7 @@ public:
                     GG::Flags<GG::WndFlag> flags = GG::NO_WND_FLAGS);
 
     void Render() override;
+    bool BatchesRendering() const noexcept override { return false; }
 
     void SetRPM(float rpm)               { m_rpm = std::max(-3600.0f, std::min(3600.0f, rpm)); }
     void SetPhaseOffset(float degrees)   { m_phase_offset = degrees; }
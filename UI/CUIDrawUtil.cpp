@@ -5,6 +5,7 @@
 #include "../util/Directories.h"
 #include "../util/OptionsDB.h"
 
+#include <GG/DrawBatch.h>
 #include <GG/DrawUtil.h>
 
 #include <cmath>
@@ -214,34 +215,17 @@ void BufferStoreRectangle(GG::GL2DVertexBuffer& buffer,
 void AngledCornerRectangle(const GG::Pt& ul, const GG::Pt& lr, GG::Clr color, GG::Clr border, int angle_offset, int thick,
                            bool upper_left_angled/* = true*/, bool lower_right_angled/* = true*/, bool draw_bottom/* = true*/)
 {
-    glDisable(GL_TEXTURE_2D);
-
     GG::GL2DVertexBuffer vert_buf;
     vert_buf.reserve(14);
     GG::Pt thick_pt = GG::Pt(GG::X(thick), GG::Y(thick));
     BufferStoreAngledCornerRectangleVertices(vert_buf, ul + thick_pt, lr - thick_pt, angle_offset,
                                              upper_left_angled, lower_right_angled, draw_bottom);
 
-    glDisable(GL_TEXTURE_2D);
-    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    vert_buf.activate();
-
-    glColor(color);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, vert_buf.size());
-    if (thick > 0) {
-        glColor(border);
-        glLineWidth(thick);
-        glDrawArrays(GL_LINE_STRIP, 0, vert_buf.size());
-        glLineWidth(1.0f);
-    }
-
-    glPopClientAttrib();
-
-    glEnable(GL_TEXTURE_2D);
+    GG::ScopedDrawBatch batch_scope;
+    auto& batch = GG::GetDrawBatch();
+    batch.AddArrays(GL_TRIANGLE_FAN, vert_buf, 0, vert_buf.size(), color);
+    if (thick > 0)
+        batch.AddArrays(GL_LINE_STRIP, vert_buf, 0, vert_buf.size(), border, thick);
 }
 
 void BufferStoreAngledCornerRectangleVertices(GG::GL2DVertexBuffer& buffer, const GG::Pt& ul, const GG::Pt& lr,
@@ -585,10 +585,23 @@ void MessageWnd::HandleTextCommand(const std::string& text) {
         else
             client_ui->ZoomToContent(params, true);
     }
+    else if (boost::iequals(command, "generation")) {
+        // the server only accepts this from the host or a moderator
+        GGHumanClientApp::GetApp()->Networking().SendMessage(DebugCommandMessage("generation"));
+    }
     else if (boost::iequals(command, "help")) {
         *m_display += UserString("MESSAGES_HELP_COMMAND") + "\n";
         m_display_show_time = GG::GUI::GetGUI()->Ticks();
     }
+    else if (boost::iequals(command, "memory")) {
+        // the server only accepts this from the host or a moderator
+        GGHumanClientApp::GetApp()->Networking().SendMessage(DebugCommandMessage("memory"));
+    }
+    else if (boost::iequals(command, "native-effects")) {
+        // the server only accepts this from the host or a moderator
+        GGHumanClientApp::GetApp()->Networking().SendMessage(
+            DebugCommandMessage(params.empty() ? "native-effects" : "native-effects " + params));
+    }
     else if (boost::iequals(command, "pm")) {
         int player_id = ExtractPlayerID(params);
         std::string message = ExtractMessage(params);
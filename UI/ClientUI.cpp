@@ -41,6 +41,7 @@
 #include <GG/dialogs/ThreeButtonDlg.h>
 #include <GG/GUI.h>
 #include <GG/RichText/ImageBlock.h>
+#include <GG/Texture.h>
 #include <GG/UnicodeCharsets.h>
 
 #include <boost/spirit/include/qi.hpp>
@@ -490,6 +491,9 @@ namespace {
         db.Add("video.fps.max",                                         UserStringNop("OPTIONS_DB_MAX_FPS"),                        60.0,                           RangedStepValidator<double>(1.0, 0.0, 240.0));
         db.Add("video.fps.unfocused.enabled",                           UserStringNop("OPTIONS_DB_LIMIT_FPS_NO_FOCUS"),             true);
         db.Add("video.fps.unfocused",                                   UserStringNop("OPTIONS_DB_MAX_FPS_NO_FOCUS"),               15.0,                           RangedStepValidator<double>(0.125, 0.125, 30.0));
+        db.Add("video.profiler.shown",                                  UserStringNop("OPTIONS_DB_PROFILER_SHOWN"),                 false);
+        db.Add("video.profiler.trace.frames",                           UserStringNop("OPTIONS_DB_PROFILER_TRACE_FRAMES"),          0,                              RangedValidator<int>(0, 100000),    false);
+        db.Add("video.texture.atlas.size.max",                          UserStringNop("OPTIONS_DB_TEXTURE_ATLAS_SIZE_MAX"),         128,                            RangedValidator<int>(0, 512));
 
         // sound and music
         db.Add<std::string>("audio.music.path",                         UserStringNop("OPTIONS_DB_BG_MUSIC"),                       (GetRootDataDir() / "default" / "data" / "sound" / "artificial_intelligence_v3.ogg").string());
@@ -626,6 +630,10 @@ ClientUI::ClientUI() :
     if (GetOptionsDB().Get<bool>("window-reset"))
         CUIWnd::InvalidateUnusedOptions();
 
+    // pack small icons into shared textures as they are loaded
+    const int max_atlased_size = GetOptionsDB().Get<int>("video.texture.atlas.size.max");
+    GG::GetTextureManager().SetMaxAtlasedSize(GG::X(max_atlased_size), GG::Y(max_atlased_size));
+
     InitializeWindows();
 
     GetOptionsDB().OptionChangedSignal("video.fullscreen.width").connect(
@@ -654,6 +662,10 @@ ClientUI::ClientUI() :
 
     // Set the root path for image tags in rich text.
     GG::ImageBlock::SetDefaultImagePath(ArtDir().string());
+
+    m_frame_profiler_overlay = GG::Wnd::Create<FrameProfilerOverlay>();
+    m_frame_profiler_overlay->MoveTo(GG::Pt(GG::X(5), GG::Y(5) + ClientUI::GetFont()->Lineskip() * 2));
+    GG::GUI::GetGUI()->Register(m_frame_profiler_overlay);
 }
 
 ClientUI::~ClientUI()
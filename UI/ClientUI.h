@@ -16,6 +16,7 @@
 
 
 class Fleet;
+class FrameProfilerOverlay;
 class IntroScreen;
 class MapWnd;
 class MessageWnd;
@@ -221,6 +222,7 @@ private:
     std::shared_ptr<MultiPlayerLobbyWnd>    m_multiplayer_lobby_wnd;//!< the multiplayer lobby
     std::shared_ptr<SaveFileDialog>         m_savefile_dialog;
     std::shared_ptr<PasswordEnterWnd>       m_password_enter_wnd;   //!< the authentication window
+    std::shared_ptr<FrameProfilerOverlay>   m_frame_profiler_overlay;   //!< rendering statistics shown on top of everything
 
     //!< map key represents a directory and first part of a texture filename.
     //!< when textures are looked up with GetPrefixedTextures, the specified
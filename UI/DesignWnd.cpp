@@ -1267,7 +1267,7 @@ void PartControl::CompleteConstruction() {
     SetBrowseInfoWnd(GG::Wnd::Create<IconTextBrowseWnd>(
         ClientUI::PartIcon(m_part->Name()),
         UserString(m_part->Name()),
-        UserString(m_part->Description()) + "\n" + m_part->CapacityDescription()
+        [part{m_part}]() { return UserString(part->Description()) + "\n" + part->CapacityDescription(); }
     ));
 }
 
@@ -1335,10 +1335,23 @@ private:
     void CullSuperfluousParts(std::vector<const ShipPart*>& this_group,
                               ShipPartClass part_class, int empire_id, int loc_id) const;
 
+    /** The parts of a (class, slot) group that were culled as superfluous,
+      * and what remained of them. */
+    struct CulledPartGroup {
+        std::vector<const ShipPart*> parts;
+        std::vector<const ShipPart*> remaining_parts;
+    };
+
     std::set<ShipPartClass>     m_part_classes_shown;   // which part classes should be shown
     bool                        m_show_superfluous_parts = true;
     int                         m_previous_num_columns = -1;
     const AvailabilityManager&  m_availabilities_state;
+
+    /** Results of culling superfluous parts, which only change when the parts
+      * available in a group do, or with the turn, empire or location whose
+      * costs and times are compared, and so are kept across filter changes. */
+    std::map<std::pair<ShipPartClass, ShipSlotType>, CulledPartGroup>   m_culled_part_groups;
+    std::tuple<int, int, int>                                           m_culled_part_groups_turn_empire_loc{INVALID_GAME_TURN, ALL_EMPIRES, INVALID_OBJECT_ID};
 };
 
 PartsListBox::PartsListBoxRow::PartsListBoxRow(GG::X w, GG::Y h, const AvailabilityManager& availabilities_state) :
@@ -1555,23 +1568,37 @@ void PartsListBox::CullSuperfluousParts(std::vector<const ShipPart*>& this_group
         } catch (...) {}
     }
 
-    for (auto part_it = this_group.begin();
-         part_it != this_group.end(); ++part_it)
-    {
-        const ShipPart* checkPart = *part_it;
-        for (const ShipPart* ref_part : this_group) {
-            float cap_check = GetMainStat(checkPart);
-            float cap_ref = GetMainStat(ref_part);
-            if ((cap_check < 0.0f) || (cap_ref < 0.0f))
+    // evaluate the main stat, cost and time of each part once, rather than
+    // for each pair of parts compared
+    struct PartStats {
+        float cap;
+        float cost;
+        int   time;
+    };
+    std::vector<PartStats> stats;
+    stats.reserve(this_group.size());
+    for (const ShipPart* part : this_group)
+        stats.push_back({GetMainStat(part), part->ProductionCost(empire_id, loc_id),
+                         std::max(1, part->ProductionTime(empire_id, loc_id))});
+
+    // culled parts are not compared against the parts checked after them
+    std::vector<bool> culled(this_group.size(), false);
+    for (std::size_t check_idx = 0; check_idx < this_group.size(); ++check_idx) {
+        const ShipPart* checkPart = this_group[check_idx];
+        const auto& check = stats[check_idx];
+        for (std::size_t ref_idx = 0; ref_idx < this_group.size(); ++ref_idx) {
+            if (culled[ref_idx])
+                continue;
+            const ShipPart* ref_part = this_group[ref_idx];
+            const auto& ref = stats[ref_idx];
+            if ((check.cap < 0.0f) || (ref.cap < 0.0f))
                 continue;  // not intended to handle such cases
-            float cap_ratio = cap_ref / std::max(cap_check, 1e-4f) ;  // some part types currently have zero capacity, but need to reject if both are zero
-            float cost_check = checkPart->ProductionCost(empire_id, loc_id);
-            float cost_ref = ref_part->ProductionCost(empire_id, loc_id);
-            if ((cost_check < 0.0f) || (cost_ref < 0.0f))
+            float cap_ratio = ref.cap / std::max(check.cap, 1e-4f) ;  // some part types currently have zero capacity, but need to reject if both are zero
+            if ((check.cost < 0.0f) || (ref.cost < 0.0f))
                 continue;  // not intended to handle such cases
-            float cost_ratio = (cost_ref + 1e-4) / (cost_check + 1e-4);  // can accept if somehow they both have cost zero
+            float cost_ratio = (ref.cost + 1e-4) / (check.cost + 1e-4);  // can accept if somehow they both have cost zero
             float bargain_ratio = cap_ratio / std::max(cost_ratio, 1e-4f);
-            float time_ratio = float(std::max(1, ref_part->ProductionTime(empire_id, loc_id))) / std::max(1, checkPart->ProductionTime(empire_id, loc_id));
+            float time_ratio = float(ref.time) / check.time;
             // adjusting the max cost ratio to 1.4 or higher, will allow, for example, for
             // Zortium armor to make Standard armor redundant.  Setting a min_bargain_ratio higher than one can keep
             // trivial bargains from blocking lower valued parts.
@@ -1581,12 +1608,17 @@ void PartsListBox::CullSuperfluousParts(std::vector<const ShipPart*>& this_group
                 (time_ratio <= max_time_ratio) && PartALocationSubsumesPartB(checkPart, ref_part))
             {
                 //DebugLogger() << "Filtering " << checkPart->Name() << " because of " << ref_part->Name();
-                this_group.erase(part_it--);
+                culled[check_idx] = true;
                 break;
             }
         }
-
     }
+
+    std::size_t kept = 0;
+    for (std::size_t idx = 0; idx < this_group.size(); ++idx)
+        if (!culled[idx])
+            this_group[kept++] = this_group[idx];
+    this_group.resize(kept);
 }
 
 void PartsListBox::Populate() {
@@ -1635,11 +1667,25 @@ void PartsListBox::Populate() {
     }
 
     // if showing parts for a particular empire, cull redundant parts (if enabled)
-    if (empire) {
+    if (empire && !m_show_superfluous_parts) {
+        // reuse the culling of groups whose parts are unchanged, unless the
+        // costs and times compared may have changed
+        std::tuple<int, int, int> turn_empire_loc{CurrentTurn(), empire_id, loc_id};
+        if (turn_empire_loc != m_culled_part_groups_turn_empire_loc) {
+            m_culled_part_groups.clear();
+            m_culled_part_groups_turn_empire_loc = turn_empire_loc;
+        }
+
         for (auto& part_group : part_groups) {
-            ShipPartClass part_class = part_group.first.first;
-            if (!m_show_superfluous_parts)
+            auto& culled_group = m_culled_part_groups[part_group.first];
+            if (culled_group.parts != part_group.second) {
+                culled_group.parts = part_group.second;
+                ShipPartClass part_class = part_group.first.first;
                 CullSuperfluousParts(part_group.second, part_class, empire_id, loc_id);
+                culled_group.remaining_parts = part_group.second;
+            } else {
+                part_group.second = culled_group.remaining_parts;
+            }
         }
     }
 
@@ -1,7 +1,11 @@
 #include "EncyclopediaDetailPanel.h"
 
+#include <cstdint>
+#include <future>
+#include <numeric>
 #include <unordered_map>
 #include <boost/algorithm/clamp.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <GG/GUI.h>
@@ -50,22 +54,9 @@
 #include "../util/Logger.h"
 #include "../util/OptionsDB.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 #include "../util/VarText.h"
 
-#if BOOST_VERSION >= 106600
-#  include <boost/asio/thread_pool.hpp>
-#  include <boost/asio/post.hpp>
-#else
-namespace boost::asio {
-    // dummy implementation of thread_pool and post that just immediately executes the passed-in function
-    struct thread_pool {
-        thread_pool(int) {}
-        void join() {}
-    };
-    void post(const thread_pool&, std::function<void()> func) { func(); }
-}
-#endif
-
 using boost::io::str;
 
 namespace {
@@ -84,6 +75,10 @@ namespace {
     const std::string GRAPH = "data graph";
     const std::string TEXT_SEARCH_RESULTS = "dynamic generated text";
 
+    /** Starts indexing the text of pedia articles for searching, if it isn't
+      * already indexed for the current stringtable. */
+    void PreparePediaArticleTextIndex();
+
     /** @content_tag{CTRL_ALWAYS_REPORT} Always display a species on a planet suitability report. **/
     const std::string TAG_ALWAYS_REPORT = "CTRL_ALWAYS_REPORT";
     /** @content_tag{CTRL_EXTINCT} Added to both a species and their enabling tech.  Handles display in planet suitability report. **/
@@ -743,6 +738,11 @@ void EncyclopediaDetailPanel::CompleteConstruction() {
     auto search_edit = GG::Wnd::Create<SearchEdit>();
     m_search_edit = search_edit;
     search_edit->TextEnteredSignal.connect(boost::bind(&EncyclopediaDetailPanel::HandleSearchTextEntered, this));
+    // start indexing article text as soon as a search is being typed
+    search_edit->EditedSignal.connect([](const std::string&) {
+        if (GetOptionsDB().Get<bool>("ui.pedia.search.articles.enabled"))
+            PreparePediaArticleTextIndex();
+    });
 
     AttachChild(m_search_edit);
     AttachChild(m_graph);
@@ -3059,6 +3059,126 @@ namespace {
         }
     }
 
+    /** Lower-cased, translated descriptions of the pedia articles defined in
+      * content, with an index from each three-character sequence to the
+      * articles whose text contains it.  Any text containing the searched-for
+      * text contains all of its three-character sequences, so a search only
+      * needs to check the articles listed for all of those, rather than
+      * looking up and case-folding the text of every article.
+      *
+      * Built in the background when a search is started, and again when the
+      * stringtable changes. */
+    class PediaArticleTextIndex {
+    public:
+        using ArticleID = std::pair<std::string, std::string>;  // category and key
+
+        /** Starts building the index for the current stringtable, if it
+          * isn't already built or being built for it. */
+        void Prepare() {
+            auto stringtable = GetOptionsDB().Get<std::string>("resource.stringtable.path");
+            if (m_data.valid() && stringtable == m_stringtable)
+                return;
+            m_stringtable = std::move(stringtable);
+
+            // copy the description keys here, as the articles may still
+            // be pending parsing, which is only finished on this thread
+            std::vector<std::pair<ArticleID, std::string>> descriptions;
+            for (const auto& [category, articles] : GetEncyclopedia().Articles())
+                for (const auto& article : articles)
+                    if (!article.description.empty())
+                        descriptions.emplace_back(ArticleID{category, article.name}, article.description);
+
+            m_data = std::async(std::launch::async, [descriptions{std::move(descriptions)}]() {
+                auto data = std::make_shared<Data>();
+                data->texts.reserve(descriptions.size());
+                for (const auto& [id, description] : descriptions) {
+                    const auto [it, added] = data->articles.emplace(id, data->texts.size());
+                    if (!added)
+                        continue;   // only the first article with a category and key is looked up
+                    data->texts.push_back(boost::algorithm::to_lower_copy(UserString(description)));
+                    const auto& text = data->texts.back();
+                    const auto idx = static_cast<std::uint32_t>(data->texts.size() - 1);
+                    for (std::size_t pos = 0; pos + 3 <= text.size(); ++pos) {
+                        auto& articles = data->trigrams[Trigram(text, pos)];
+                        if (articles.empty() || articles.back() != idx)
+                            articles.push_back(idx);
+                    }
+                }
+                return std::shared_ptr<const Data>(std::move(data));
+            }).share();
+        }
+
+        /** Returns whether the article is described by content text, which is
+          * then what SearchText searches. */
+        bool Indexed(const ArticleID& id) const
+        { return m_data.valid() && m_data.get()->articles.count(id); }
+
+        /** Returns the articles whose text contains \a search_text, ignoring
+          * case.  Waits for the index to be built, if it is being built. */
+        std::set<ArticleID> SearchText(const std::string& search_text) const {
+            std::set<ArticleID> retval;
+            if (!m_data.valid() || search_text.empty())
+                return retval;
+            const auto& data = *m_data.get();
+            const auto lower_search_text = boost::algorithm::to_lower_copy(search_text);
+
+            // candidates are in the lists of all of the search text's sequences
+            std::vector<std::uint32_t> candidates;
+            if (lower_search_text.size() < 3) {
+                candidates.resize(data.texts.size());
+                std::iota(candidates.begin(), candidates.end(), 0u);
+            } else {
+                std::vector<const std::vector<std::uint32_t>*> lists;
+                for (std::size_t pos = 0; pos + 3 <= lower_search_text.size(); ++pos) {
+                    auto it = data.trigrams.find(Trigram(lower_search_text, pos));
+                    if (it == data.trigrams.end())
+                        return retval;
+                    lists.push_back(&it->second);
+                }
+                std::sort(lists.begin(), lists.end(), [](auto* lhs, auto* rhs) { return lhs->size() < rhs->size(); });
+                candidates = *lists.front();
+                for (auto list_it = lists.begin() + 1; list_it != lists.end() && !candidates.empty(); ++list_it) {
+                    std::vector<std::uint32_t> both;
+                    std::set_intersection(candidates.begin(), candidates.end(),
+                                          (*list_it)->begin(), (*list_it)->end(), std::back_inserter(both));
+                    candidates = std::move(both);
+                }
+            }
+
+            std::vector<bool> matched(data.texts.size(), false);
+            for (auto idx : candidates)
+                matched[idx] = data.texts[idx].find(lower_search_text) != std::string::npos;
+            for (const auto& [id, idx] : data.articles)
+                if (matched[idx])
+                    retval.insert(id);
+            return retval;
+        }
+
+    private:
+        struct Data {
+            std::map<ArticleID, std::size_t>                                articles;   // index in texts of each article
+            std::vector<std::string>                                        texts;
+            std::unordered_map<std::uint32_t, std::vector<std::uint32_t>>   trigrams;   // sorted indices in texts of the articles containing each sequence
+        };
+
+        static std::uint32_t Trigram(const std::string& text, std::size_t pos) {
+            return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+                   (static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+                    static_cast<std::uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+        }
+
+        std::string                                 m_stringtable;
+        std::shared_future<std::shared_ptr<const Data>> m_data;
+    };
+
+    PediaArticleTextIndex& GetPediaArticleTextIndex() {
+        static PediaArticleTextIndex index;
+        return index;
+    }
+
+    void PreparePediaArticleTextIndex()
+    { GetPediaArticleTextIndex().Prepare(); }
+
     void SearchPediaArticlesForWords(       std::string article_key,
                                             std::string article_directory,
                                             std::pair<std::string, std::string> article_name_link,
@@ -3068,6 +3188,8 @@ namespace {
                                             std::pair<std::string, std::string>& article_match,
                                             const std::string& search_text,
                                             const std::set<std::string>& words_in_search_text,
+                                            const PediaArticleTextIndex& text_index,
+                                            const std::set<PediaArticleTextIndex::ArticleID>& text_matches,
                                             std::size_t idx,
                                             bool search_article_text)
     {
@@ -3105,14 +3227,16 @@ namespace {
 
 
         // search for matches within article text
-        const auto& article_entry = GetEncyclopedia().GetArticleByCategoryAndKey(article_directory, article_key);
-        if (!article_entry.description.empty()) {
+        PediaArticleTextIndex::ArticleID article_id{std::move(article_directory), std::move(article_key)};
+        if (text_index.Indexed(article_id)) {
             // article present in pedia directly
-            if (boost::icontains(UserString(article_entry.description), search_text)) {
+            if (text_matches.count(article_id)) {
                 article_match = std::move(article_name_link);
                 return;
             }
         }
+        article_directory = std::move(article_id.first);
+        article_key = std::move(article_id.second);
 
 
         // article not in pedia. may be generated by GetRefreshDetailPanelInfo
@@ -3154,8 +3278,7 @@ void EncyclopediaDetailPanel::HandleSearchTextEntered() {
     SectionedScopedTimer timer("HandleSearchTextEntered");
     timer.EnterSection("Find words in search text");
 
-    const unsigned int num_threads = static_cast<unsigned int>(std::max(1, EffectsProcessingThreads()));
-    boost::asio::thread_pool thread_pool(num_threads);
+    TaskBatch task_batch("EncyclopediaDetailPanel::HandleSearchTextEntered");
 
     // search lists of articles for typed text
     const std::string& search_text = m_search_edit->Text();
@@ -3184,6 +3307,14 @@ void EncyclopediaDetailPanel::HandleSearchTextEntered() {
 
     bool search_desc = GetOptionsDB().Get<bool>("ui.pedia.search.articles.enabled");
 
+    std::set<PediaArticleTextIndex::ArticleID> text_matches;
+    auto& text_index = GetPediaArticleTextIndex();
+    if (search_desc) {
+        timer.EnterSection("search article text index");
+        text_index.Prepare();
+        text_matches = text_index.SearchText(search_text);
+    }
+
     timer.EnterSection("search subdirs dispatch");
     // assemble link text to all pedia entries, indexed by name
     std::size_t idx = -1;
@@ -3196,14 +3327,16 @@ void EncyclopediaDetailPanel::HandleSearchTextEntered() {
         auto& pmr{partial_match_report[idx]};
         auto& amr{article_match_report[idx]};
 
-        boost::asio::post(
-            thread_pool, [
+        task_batch.Post(
+            [
                 article_key{article_key_directory.first},
                 article_dir{article_key_directory.second},
                 article_name_link{std::move(article_name_link)},
                 &emr, &wmr, &pmr, &amr,
                 &search_text,
                 &words_in_search_text,
+                &text_index,
+                &text_matches,
                 idx,
                 search_desc
             ]() mutable {
@@ -3213,13 +3346,15 @@ void EncyclopediaDetailPanel::HandleSearchTextEntered() {
                                             emr, wmr, pmr, amr,
                                             search_text,
                                             words_in_search_text,
+                                            text_index,
+                                            text_matches,
                                             idx,
                                             search_desc);
             });
     }
 
     timer.EnterSection("search subdirs eval waiting");
-    thread_pool.join();
+    task_batch.Wait();
 
 
     timer.EnterSection("sort");
@@ -3327,23 +3462,60 @@ void EncyclopediaDetailPanel::RefreshImpl() {
         auto stat_name_it = stat_records.find(graph_id);
         if (stat_name_it != stat_records.end()) {
             const auto& empire_lines = stat_name_it->second;
-            m_graph->Clear();
+
+            std::vector<int> empire_ids;
+            empire_ids.reserve(empire_lines.size());
+            for (const auto& [empire_id, series] : empire_lines)
+                if (!series.empty())
+                    empire_ids.push_back(empire_id);
+
+            // keep the series already in the graph if it shows the same
+            // statistic for the same empires, and add only the turns recorded
+            // since, so that whole histories are not converted every refresh
+            if (graph_id != m_graph_stat_name || empire_ids != m_graph_empire_ids) {
+                m_graph->Clear();
+                m_graph_stat_name = graph_id;
+                m_graph_empire_ids = std::move(empire_ids);
+            }
 
             // add lines for each empire
-            for (const auto& empire_linemap : empire_lines) {
-                int empire_id = empire_linemap.first;
+            std::size_t series_idx = 0;
+            for (const auto& [empire_id, series] : empire_lines) {
+                if (series.empty())
+                    continue;
 
                 GG::Clr empire_clr = GG::CLR_WHITE;
                 if (const Empire* empire = GetEmpire(empire_id))
                     empire_clr = empire->Color();
 
+                const auto& turns = series.Turns();
+                const auto& values = series.Values();
+
+                // number of points of the series already in the graph, if
+                // those points are still the start of the series
+                std::size_t num_shown = 0;
+                if (series_idx < m_graph->NumSeries()) {
+                    const auto& shown_pts = m_graph->SeriesPoints(series_idx);
+                    num_shown = shown_pts.size();
+                    if (num_shown > series.size() ||
+                        (num_shown > 0 && (shown_pts.back().first != turns[num_shown - 1] ||
+                                           shown_pts.back().second != values[num_shown - 1])))
+                    { num_shown = 0; }
+                }
+
                 // convert formats...
                 std::vector<std::pair<double, double>> line_data_pts;
-                line_data_pts.reserve(empire_linemap.second.size());
-                for (const auto& entry : empire_linemap.second)
-                    line_data_pts.emplace_back(entry.first, entry.second);
-
-                m_graph->AddSeries(std::move(line_data_pts), empire_clr);
+                line_data_pts.reserve(series.size() - num_shown);
+                for (std::size_t idx = num_shown; idx < series.size(); ++idx)
+                    line_data_pts.emplace_back(turns[idx], values[idx]);
+
+                if (series_idx >= m_graph->NumSeries())
+                    m_graph->AddSeries(std::move(line_data_pts), empire_clr);
+                else if (num_shown == 0)
+                    m_graph->SetSeries(series_idx, std::move(line_data_pts), empire_clr);
+                else
+                    m_graph->AppendToSeries(series_idx, line_data_pts);
+                ++series_idx;
             }
 
             m_graph->AutoSetRange();
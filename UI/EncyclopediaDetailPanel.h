@@ -121,6 +121,8 @@ private:
     std::shared_ptr<GG::Button>         m_next_button;
     std::shared_ptr<GG::Edit>           m_search_edit;          // box to type to search
     std::shared_ptr<GraphControl>       m_graph;
+    std::string                         m_graph_stat_name;      // statistic whose series are in m_graph
+    std::vector<int>                    m_graph_empire_ids;     // empire of each series in m_graph
     bool                                m_needs_refresh = false;// Indicates that data is stale.
 };
 
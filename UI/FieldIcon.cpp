@@ -167,3 +167,11 @@ bool FieldIcon::InWindow(const GG::Pt& pt) const {
 
     return distx*distx + disty*disty <= RADIUS2;
 }
+
+GG::Rect FieldIcon::PickBounds() const {
+    const int RADIUS = Value(Width())/2;
+    GG::Pt ul = UpperLeft(), lr = LowerRight();
+    GG::Pt middle = ul + GG::Pt((lr.x - ul.x) / 2, (lr.y - ul.y) / 2);
+    GG::Pt radius{GG::X(RADIUS), GG::Y(RADIUS)};
+    return GG::Rect(middle - radius, middle + radius + GG::Pt(GG::X1, GG::Y1));
+}
@@ -20,6 +20,10 @@ public:
     /** Checks to see if point lies inside in-system fleet buttons before
         checking parent InWindow method. */
     bool InWindow(const GG::Pt& pt) const override;
+
+    /** Returns the square enclosing the circle that InWindow checks. */
+    GG::Rect PickBounds() const override;
+
     int  FieldID() const;                        //!< returns ID of system this icon represents
 
     /** Returns the field texture. */
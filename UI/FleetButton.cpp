@@ -282,6 +282,14 @@ bool FleetButton::InWindow(const GG::Pt& pt) const {
     return distx*distx + disty*disty <= RADIUS2;
 }
 
+GG::Rect FleetButton::PickBounds() const {
+    GG::Pt ul = UpperLeft(), lr = LowerRight();
+    GG::Pt middle((ul.x + lr.x) / 2, (ul.y + lr.y) / 2);
+    const int RADIUS = Value(Width()) / 2 + 1;
+    GG::Pt radius{GG::X(RADIUS), GG::Y(RADIUS)};
+    return GG::Rect(middle - radius, middle + radius + GG::Pt(GG::X1, GG::Y1));
+}
+
 void FleetButton::MouseHere(const GG::Pt& pt, GG::Flags<GG::ModKey> mod_keys) {
     const auto& map_wnd = ClientUI::GetClientUI()->GetMapWnd();
     if (!Disabled() && (!map_wnd || !map_wnd->InProductionViewMode())) {
@@ -33,9 +33,15 @@ public:
     /** Returns true if \a pt is within or over the button. */
     bool InWindow(const GG::Pt& pt) const override;
 
+    /** Returns the square enclosing the circle that InWindow checks. */
+    GG::Rect PickBounds() const override;
+
     const std::vector<int>& Fleets() const      { return m_fleets; }    ///< returns the fleets represented by this control
     bool                    Selected() const    { return m_selected; }  ///< returns whether this button has been marked selected
 
+    /** The pressed and rollover highlights are drawn with GL directly. */
+    bool BatchesRendering() const noexcept override { return false; }
+
     void MouseHere(const GG::Pt& pt, GG::Flags<GG::ModKey> mod_keys) override;
 
     void SizeMove(const GG::Pt& ul, const GG::Pt& lr) override;
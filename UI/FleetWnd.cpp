@@ -30,6 +30,7 @@
 #include <boost/cast.hpp>
 
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 
@@ -165,11 +166,55 @@ namespace {
     bool ClientPlayerIsModerator()
     { return GGHumanClientApp::GetApp()->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_MODERATOR; }
 
+    /** Statistics of a ship that are shown in the fleet window and its fleet
+      * and ship rows, each of which takes a pass over the ship's parts. */
+    struct ShipStats {
+        float   damage = 0.0f;          ///< Ship::TotalWeaponsDamage(0.0f, false)
+        float   fighters = 0.0f;        ///< Ship::FighterCount()
+        float   troops = 0.0f;          ///< Ship::TroopCapacity()
+        float   colony = 0.0f;          ///< Ship::ColonyCapacity()
+        bool    armed = false;          ///< Ship::IsArmed()
+        bool    has_fighters = false;   ///< Ship::HasFighters()
+    };
+
+    /** Returns the statistics of \a ship.  These are computed once per ship
+      * and kept until the turn or the universe's meters change, rather than
+      * for each of the rows and totals that show them, which for large fleets
+      * is many times over. */
+    const ShipStats& GetShipStats(const Ship& ship) {
+        static std::unordered_map<int, ShipStats> cached_stats;
+        static int cached_turn = INVALID_GAME_TURN;
+        static std::size_t cached_meters_generation = 0;
+
+        const auto meters_generation = GetUniverse().MetersGeneration();
+        const auto current_turn = CurrentTurn();
+        if (cached_turn != current_turn || cached_meters_generation != meters_generation) {
+            cached_stats.clear();
+            cached_turn = current_turn;
+            cached_meters_generation = meters_generation;
+        }
+
+        auto [it, added] = cached_stats.try_emplace(ship.ID());
+        if (added) {
+            auto& stats = it->second;
+            stats.damage = ship.TotalWeaponsDamage(0.0f, false);
+            stats.fighters = ship.FighterCount();
+            stats.troops = ship.TroopCapacity();
+            stats.colony = ship.ColonyCapacity();
+            const ShipDesign* design = ship.Design();
+            stats.has_fighters = design && design->HasFighters() && stats.fighters >= 1.0f;
+            stats.armed = stats.damage > 0.0f ||
+                (stats.has_fighters && ship.TotalWeaponsDamage(0.0f, true) > 0.0f);
+        }
+        return it->second;
+    }
+
     bool ContainsArmedShips(const std::vector<int>& ship_ids) {
         for (const auto& ship : Objects().find<Ship>(ship_ids)) {
             if (!ship)
                 continue;
-            if (ship->IsArmed() || ship->HasFighters())
+            const auto& stats = GetShipStats(*ship);
+            if (stats.armed || stats.has_fighters)
                 return true;
         }
         return false;
@@ -232,7 +277,7 @@ namespace {
                                             AggressionForFleet(aggression, ship_ids)));
     }
 
-    void CreateNewFleetFromShipsWithDesign(const std::set<int>& ship_ids,
+    void CreateNewFleetFromShipsWithDesign(const ObjectIDSet& ship_ids,
                                            int design_id,
                                            FleetAggression aggression)
     {
@@ -255,7 +300,7 @@ namespace {
         CreateNewFleetFromShips(ships_of_design_ids, aggression);
     }
 
-    void CreateNewFleetsFromShipsForEachDesign(const std::set<int>& ship_ids,
+    void CreateNewFleetsFromShipsForEachDesign(const ObjectIDSet& ship_ids,
                                                FleetAggression aggression)
     {
         DebugLogger() << "CreateNewFleetsFromShipsForEachDesign with "
@@ -312,7 +357,7 @@ namespace {
             if (fleet->ID() == target_fleet->ID() || fleet->ID() == INVALID_OBJECT_ID)
                 continue;   // no need to do things to target fleet's contents
 
-            const std::set<int>& fleet_ships = fleet->ShipIDs();
+            const auto& fleet_ships = fleet->ShipIDs();
             empire_system_ship_ids.insert(empire_system_ship_ids.end(),
                                           fleet_ships.begin(), fleet_ships.end());
             empire_system_fleet_ids.push_back(fleet->ID());
@@ -862,13 +907,13 @@ namespace {
     double ShipDataPanel::StatValue(MeterType stat_name) const {
         if (auto ship = Objects().get<Ship>(m_ship_id)) {
             if (stat_name == MeterType::METER_CAPACITY)
-                return ship->TotalWeaponsDamage(0.0f, false);
+                return GetShipStats(*ship).damage;
             else if (stat_name == MeterType::METER_TROOPS)
-                return ship->TroopCapacity();
+                return GetShipStats(*ship).troops;
             else if (stat_name == MeterType::METER_SECONDARY_STAT)
-                return ship->FighterCount();
+                return GetShipStats(*ship).fighters;
             else if (stat_name == MeterType::METER_POPULATION)
-                return ship->ColonyCapacity();
+                return GetShipStats(*ship).colony;
             else if (ship->UniverseObject::GetMeter(stat_name))
                 return ship->GetMeter(stat_name)->Initial();
 
@@ -936,11 +981,12 @@ namespace {
         std::vector<std::pair<MeterType, std::shared_ptr<GG::Texture>>> meters_icons;
         meters_icons.reserve(13);
         meters_icons.emplace_back(MeterType::METER_STRUCTURE,          ClientUI::MeterIcon(MeterType::METER_STRUCTURE));
-        if (ship->IsArmed())
+        const auto& stats = GetShipStats(*ship);
+        if (stats.armed)
             meters_icons.emplace_back(MeterType::METER_CAPACITY,       DamageIcon());
-        if (ship->HasFighters())
+        if (stats.has_fighters)
             meters_icons.emplace_back(MeterType::METER_SECONDARY_STAT, FightersIcon());
-        if (ship->HasTroops())
+        if (stats.troops > 0.0f)
             meters_icons.emplace_back(MeterType::METER_TROOPS,         TroopIcon());
         if (ship->CanColonize())
             meters_icons.emplace_back(MeterType::METER_POPULATION,     ColonyIcon());
@@ -1515,8 +1561,8 @@ void FleetDataPanel::SetStatIconValues() {
     const Universe& universe = GetUniverse();
     const ObjectMap& objects = universe.Objects();
 
-    const std::set<int>& this_client_known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(client_empire_id);
-    const std::set<int>& this_client_stale_object_info = universe.EmpireStaleKnowledgeObjectIDs(client_empire_id);
+    const auto& this_client_known_destroyed_objects = universe.EmpireKnownDestroyedObjectIDs(client_empire_id);
+    const auto& this_client_stale_object_info = universe.EmpireStaleKnowledgeObjectIDs(client_empire_id);
     int ship_count =        0;
     float damage_tally =    0.0f;
     float fighters_tally  = 0.0f;
@@ -1526,6 +1572,8 @@ void FleetDataPanel::SetStatIconValues() {
     float min_speed =       0.0f;
     float troops_tally =    0.0f;
     float colony_tally =    0.0f;
+    bool has_armed_ships =  false;
+    bool has_fighter_ships = false;
     std::vector<float> fuels;
     std::vector<float> speeds;
 
@@ -1535,6 +1583,11 @@ void FleetDataPanel::SetStatIconValues() {
     speeds.reserve(fleet->NumShips());
     for (auto& ship : objects.find<const Ship>(fleet->ShipIDs())) {
         int ship_id = ship->ID();
+        const auto& stats = GetShipStats(*ship);
+        // as Fleet::HasArmedShips and Fleet::HasFighterShips, over all ships
+        has_armed_ships = has_armed_ships || stats.armed;
+        has_fighter_ships = has_fighter_ships || stats.has_fighters;
+
         // skip known destroyed and stale info objects
         if (this_client_known_destroyed_objects.count(ship_id))
             continue;
@@ -1543,10 +1596,10 @@ void FleetDataPanel::SetStatIconValues() {
 
         if (ship->Design()) {
             ship_count++;
-            damage_tally += ship->TotalWeaponsDamage(0.0f, false);
-            fighters_tally += ship->FighterCount();
-            troops_tally += ship->TroopCapacity();
-            colony_tally += ship->ColonyCapacity();
+            damage_tally += stats.damage;
+            fighters_tally += stats.fighters;
+            troops_tally += stats.troops;
+            colony_tally += stats.colony;
             structure_tally += ship->GetMeter(MeterType::METER_STRUCTURE)->Initial();
             shield_tally += ship->GetMeter(MeterType::METER_SHIELD)->Initial();
             fuels.push_back(ship->GetMeter(MeterType::METER_FUEL)->Initial());
@@ -1567,12 +1620,12 @@ void FleetDataPanel::SetStatIconValues() {
             break;
         case MeterType::METER_CAPACITY:
             icon->SetValue(damage_tally);
-            if (fleet->HasArmedShips(objects))
+            if (has_armed_ships)
                 AttachChild(icon);
             break;
         case MeterType::METER_SECONDARY_STAT:
             icon->SetValue(fighters_tally);
-            if (fleet->HasFighterShips(objects))
+            if (has_fighter_ships)
                 AttachChild(icon);
             break;
         case MeterType::METER_TROOPS:
@@ -2260,12 +2313,12 @@ public:
         ManuallyManageColProps();
 
         int this_client_empire_id = GGHumanClientApp::GetApp()->EmpireID();
-        const std::set<int>& this_client_known_destroyed_objects =
+        const auto& this_client_known_destroyed_objects =
             GetUniverse().EmpireKnownDestroyedObjectIDs(this_client_empire_id);
-        const std::set<int>& this_client_stale_object_info =
+        const auto& this_client_stale_object_info =
             GetUniverse().EmpireStaleKnowledgeObjectIDs(this_client_empire_id);
 
-        const std::set<int>& ship_ids = fleet->ShipIDs();
+        const auto& ship_ids = fleet->ShipIDs();
         std::vector<std::shared_ptr<GG::ListBox::Row>> rows;
         rows.reserve(ship_ids.size());
         for (int ship_id : ship_ids) {
@@ -2883,8 +2936,8 @@ GG::Rect FleetWnd::CalculatePosition() const {
 
 void FleetWnd::SetStatIconValues() {
     int client_empire_id = GGHumanClientApp::GetApp()->EmpireID();
-    const std::set<int>& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(client_empire_id);
-    const std::set<int>& this_client_stale_object_info = GetUniverse().EmpireStaleKnowledgeObjectIDs(client_empire_id);
+    const auto& this_client_known_destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(client_empire_id);
+    const auto& this_client_stale_object_info = GetUniverse().EmpireStaleKnowledgeObjectIDs(client_empire_id);
     int ship_count =        0;
     float damage_tally =    0.0f;
     float fighters_tally  = 0.0f;
@@ -2907,13 +2960,14 @@ void FleetWnd::SetStatIconValues() {
                 continue;
 
             if (ship->Design()) {
+                const auto& stats = GetShipStats(*ship);
                 ship_count++;
-                damage_tally += ship->TotalWeaponsDamage(0.0f, false);
-                fighters_tally += ship->FighterCount();
+                damage_tally += stats.damage;
+                fighters_tally += stats.fighters;
                 structure_tally += ship->GetMeter(MeterType::METER_STRUCTURE)->Initial();
                 shield_tally += ship->GetMeter(MeterType::METER_SHIELD)->Initial();
-                troop_tally += ship->TroopCapacity();
-                colony_tally += ship->ColonyCapacity();
+                troop_tally += stats.troops;
+                colony_tally += stats.colony;
             }
         }
     }
@@ -3404,7 +3458,7 @@ void FleetWnd::FleetRightClicked(GG::ListBox::iterator it, const GG::Pt& pt, con
         return;
 
     auto system = Objects().get<System>(fleet->SystemID());
-    std::set<int> ship_ids_set = fleet->ShipIDs();
+    ObjectIDSet ship_ids_set = fleet->ShipIDs();
 
     std::vector<int> damaged_ship_ids;
     std::vector<int> unfueled_ship_ids;
@@ -3595,7 +3649,7 @@ void FleetWnd::FleetRightClicked(GG::ListBox::iterator it, const GG::Pt& pt, con
         && fleet->OwnedBy(client_empire_id))
     {
         auto scrap_action = [fleet, client_empire_id]() {
-            std::set<int> ship_ids = fleet->ShipIDs();
+            ObjectIDSet ship_ids = fleet->ShipIDs();
             for (int ship_id : ship_ids) {
                 GGHumanClientApp::GetApp()->Orders().IssueOrder(
                     std::make_shared<ScrapOrder>(client_empire_id, ship_id));
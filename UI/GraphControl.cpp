@@ -6,6 +6,8 @@
 
 #include <GG/ClrConstants.h>
 
+#include <cmath>
+
 
 GraphControl::GraphControl() :
     GG::Control(GG::X0, GG::Y0, GG::X1, GG::Y1)
@@ -19,44 +21,102 @@ GraphControl::GraphControl() :
     AutoSetRange();
 }
 
+GraphControl::Series::Series(std::vector<std::pair<double, double>> points_, const GG::Clr& clr_) :
+    points(std::move(points_)),
+    clr(clr_)
+{ UpdateBounds(0); }
+
+void GraphControl::Series::UpdateBounds(std::size_t first_point_idx) {
+    if (first_point_idx == 0) {
+        // large default values that are expected to be overwritten by the first seen value
+        x_min = 99999999.9;
+        y_min = 99999999.9;
+        x_max = -99999999.9;
+        y_max = -99999999.9;
+    }
+    for (std::size_t idx = first_point_idx; idx < points.size(); ++idx) {
+        const auto& [x, y] = points[idx];
+        x_min = std::min(x_min, x);
+        x_max = std::max(x_max, x);
+        y_min = std::min(y_min, y);
+        y_max = std::max(y_max, y);
+    }
+}
+
+bool GraphControl::LayoutParams::operator==(const LayoutParams& rhs) const {
+    return width == rhs.width && height == rhs.height &&
+        x_min == rhs.x_min && x_range == rhs.x_range &&
+        y_min == rhs.y_min && y_range == rhs.y_range &&
+        log_scale == rhs.log_scale;
+}
+
 void GraphControl::AddSeries(std::vector<std::pair<double, double>> data, const GG::Clr& clr) {
     if (!data.empty()) {
         m_data.emplace_back(std::move(data), clr);
-        DoLayout();
+        RequirePreRender();
     }
 }
 
+void GraphControl::SetSeries(std::size_t series_idx, std::vector<std::pair<double, double>> data,
+                             const GG::Clr& clr)
+{
+    if (series_idx >= m_data.size())
+        return;
+    auto& series = m_data[series_idx];
+    series.points = std::move(data);
+    series.clr = clr;
+    series.UpdateBounds(0);
+    series.vert_buf_current = false;
+    RequirePreRender();
+}
+
+void GraphControl::AppendToSeries(std::size_t series_idx, const std::vector<std::pair<double, double>>& data) {
+    if (series_idx >= m_data.size() || data.empty())
+        return;
+    auto& series = m_data[series_idx];
+    const auto old_size = series.points.size();
+    series.points.insert(series.points.end(), data.begin(), data.end());
+    series.UpdateBounds(old_size);
+    series.vert_buf_current = false;
+    RequirePreRender();
+}
+
+const std::vector<std::pair<double, double>>& GraphControl::SeriesPoints(std::size_t series_idx) const {
+    static const std::vector<std::pair<double, double>> EMPTY_POINTS;
+    return series_idx < m_data.size() ? m_data[series_idx].points : EMPTY_POINTS;
+}
+
 void GraphControl::Clear() {
     m_data.clear();
-    DoLayout();
+    RequirePreRender();
 }
 
 void GraphControl::SetXMin(double x_min) {
     double old_x_min = x_min;
     m_x_min = x_min;
     if (m_x_min != old_x_min)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::SetYMin(double y_min) {
     double old_y_min = y_min;
     m_y_min = y_min;
     if (m_y_min != old_y_min)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::SetXMax(double x_max) {
     double old_x_max = x_max;
     m_x_max = x_max;
     if (m_x_max != old_x_max)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::SetYMax(double y_max) {
     double old_y_max = y_max;
     m_y_max = y_max;
     if (m_y_max != old_y_max)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::SetRange(double x1, double x2, double y1, double y2) {
@@ -66,7 +126,7 @@ void GraphControl::SetRange(double x1, double x2, double y1, double y2) {
         m_x_max = x2;
         m_y_max = y2;
 
-        DoLayout();
+        RequirePreRender();
     }
 }
 
@@ -80,17 +140,11 @@ void GraphControl::AutoSetRange() {
     double x_max = -99999999.9;
     double y_max = -99999999.9;
 
-    for (const std::pair<std::vector<std::pair<double, double>>, GG::Clr>& curve : m_data) {
-        for (const std::pair<double, double>& curve_pt : curve.first) {
-            if (curve_pt.first < x_min)
-                x_min = curve_pt.first;
-            if (curve_pt.first > x_max)
-                x_max = curve_pt.first;
-            if (curve_pt.second < y_min)
-                y_min = curve_pt.second;
-            if (curve_pt.second > y_max)
-                y_max = curve_pt.second;
-        }
+    for (const auto& series : m_data) {
+        x_min = std::min(x_min, series.x_min);
+        x_max = std::max(x_max, series.x_max);
+        y_min = std::min(y_min, series.y_min);
+        y_max = std::max(y_max, series.y_max);
     }
 
     SetRange(x_min, x_max, y_min, y_max);
@@ -100,42 +154,47 @@ void GraphControl::ShowPoints(bool show/* = true*/) {
     bool old_show_points = m_show_points;
     m_show_points = show;
     if (show != old_show_points)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::ShowLines(bool show/* = true*/) {
     bool old_show_lines = m_show_lines;
     m_show_lines = show;
     if (show != old_show_lines)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::ShowScale(bool show/* = true*/) {
     bool old_show_scale = m_show_scale;
     m_show_scale = show;
     if (show != old_show_scale)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::UseLogScale(bool log/* = true*/) {
     bool old_log_scale = m_log_scale;
     m_log_scale = log;
     if (log != old_log_scale)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::ScaleToZero(bool zero/* = true*/) {
     bool old_zero = m_zero_in_range;
     m_zero_in_range = zero;
     if (zero != old_zero)
-        DoLayout();
+        RequirePreRender();
 }
 
 void GraphControl::SizeMove(const GG::Pt& ul, const GG::Pt& lr) {
     GG::Pt old_sz = Size();
     GG::Control::SizeMove(ul, lr);
     if (Size() != old_sz)
-        DoLayout();
+        RequirePreRender();
+}
+
+void GraphControl::PreRender() {
+    GG::Control::PreRender();
+    DoLayout();
 }
 
 void GraphControl::RClick(const GG::Pt& pt, GG::Flags<GG::ModKey> mod_keys) {
@@ -215,14 +274,25 @@ void GraphControl::Render() {
     glLineWidth(2.0f);
     glPointSize(5.0f);
 
-    m_vert_buf.activate();
-    m_colour_buf.activate();
-
-    if (m_show_lines)
+    // scale marker lines
+    if (!m_vert_buf.empty()) {
+        m_vert_buf.activate();
+        m_colour_buf.activate();
         glDrawArrays(GL_LINES, 0, m_vert_buf.size());
+    }
 
-    if (m_show_points)
-        glDrawArrays(GL_POINTS, 0, m_vert_buf.size());
+    // data series, each in its own colour
+    glDisableClientState(GL_COLOR_ARRAY);
+    for (const auto& series : m_data) {
+        if (series.vert_buf.empty())
+            continue;
+        glColor(series.clr);
+        series.vert_buf.activate();
+        if (m_show_lines)
+            glDrawArrays(GL_LINE_STRIP, 0, series.vert_buf.size());
+        if (m_show_points)
+            glDrawArrays(GL_POINTS, 0, series.vert_buf.size());
+    }
 
     glLineWidth(1.0f);
     glPointSize(1.0f);
@@ -303,50 +373,93 @@ void GraphControl::DoLayout() {
         }
     }
 
-    // plot lines connecting successive data points
-    for (auto& curve : m_data) {
-        auto curve_pts = curve.first;
-        if (curve_pts.empty())
-            continue;
-        if (m_log_scale) {
-            for (auto& pt : curve_pts)
-                pt.second = std::log10(std::max(1.0, std::abs(pt.second)));   // ignore sign of points, trunscate log scale at minimum 0 = log10(1.0)
-        }
-
-        const auto& curve_colour = curve.second;
-
-        // pairs of n and n+1 point, starting with first-second, to the second-last-last
-        for (auto curve_it = curve_pts.begin(); curve_it != curve_pts.end(); ++curve_it) {
-            auto next_it = curve_it;
-            ++next_it;
-            if (next_it == curve_pts.end())
-                break;
-
-            {
-                const auto& curve_x = curve_it->first;
-                const auto& screen_x = static_cast<float>((curve_x - shown_x_min) * WIDTH / x_range);
-                const auto& curve_y = curve_it->second;
-                const auto& screen_y = static_cast<float>((curve_y - shown_y_min) * HEIGHT / y_range);
-                m_vert_buf.store(screen_x, -screen_y);  // OpenGL is positive down / negative up
-                m_colour_buf.store(curve_colour);
-            }
-
-            {
-                const auto& curve_x = next_it->first;
-                const auto& screen_x = static_cast<float>((curve_x - shown_x_min) * WIDTH / x_range);
-                const auto& curve_y = next_it->second;
-                const auto& screen_y = static_cast<float>((curve_y - shown_y_min) * HEIGHT / y_range);
-                m_vert_buf.store(screen_x, -screen_y);  // OpenGL is positive down / negative up
-                m_colour_buf.store(curve_colour);
-            }
-        }
-    }
-
     m_vert_buf.createServerBuffer();
     m_colour_buf.createServerBuffer();
 
+    // lay out the lines of series whose points or layout have changed since
+    // they were last laid out
+    LayoutParams layout_params{WIDTH, HEIGHT, shown_x_min, x_range, shown_y_min, y_range, m_log_scale};
+    if (!(layout_params == m_layout_params)) {
+        m_layout_params = layout_params;
+        for (auto& series : m_data)
+            series.vert_buf_current = false;
+    }
+    for (auto& series : m_data) {
+        if (series.vert_buf_current)
+            continue;
+        LayoutSeries(series);
+        series.vert_buf.createServerBuffer();
+        series.vert_buf_current = true;
+    }
+
     // todo: determine screen and data points at which to draw scale ticks
     //
     // ticks should be placed at increments of powers of 10 multiplied by 2, 5, or 10.
     // eg. 4,6,8,10,12,14; -5,0,5,10,15,20; 0,10,20,30,40,50
 }
+
+void GraphControl::LayoutSeries(Series& series) const {
+    const auto& params = m_layout_params;
+    series.vert_buf.clear();
+    series.vert_buf.reserve(std::min(series.points.size(), 4u * static_cast<std::size_t>(std::max(params.width, 1))));
+
+    struct ScreenPoint {
+        std::size_t idx;
+        float       x;
+        float       y;
+    };
+
+    const auto to_screen = [&params, &series](std::size_t idx) -> ScreenPoint {
+        const auto& [x, y] = series.points[idx];
+        // ignore sign of points, truncate log scale at minimum 0 = log10(1.0)
+        const double shown_y = params.log_scale ? std::log10(std::max(1.0, std::abs(y))) : y;
+        return {idx, static_cast<float>((x - params.x_min) * params.width / params.x_range),
+                static_cast<float>((shown_y - params.y_min) * params.height / params.y_range)};
+    };
+
+    bool stored_any = false;
+    ScreenPoint last_stored{0, 0.0f, 0.0f};
+    const auto store = [&series, &stored_any, &last_stored](const ScreenPoint& pt) {
+        if (stored_any && pt.x == last_stored.x && pt.y == last_stored.y)
+            return;
+        series.vert_buf.store(pt.x, -pt.y); // OpenGL is positive down / negative up
+        last_stored = pt;
+        stored_any = true;
+    };
+
+    // points that fall in the same pixel column are reduced to the first and
+    // last of them and the lowest and highest, in the order they occur, which
+    // draws the same line as all the points would
+    ScreenPoint first{}, last{}, low{}, high{};
+    int column = 0;
+    const auto store_column = [&]() {
+        store(first);
+        if (low.idx < high.idx) {
+            store(low);
+            store(high);
+        } else {
+            store(high);
+            store(low);
+        }
+        store(last);
+    };
+
+    for (std::size_t idx = 0; idx < series.points.size(); ++idx) {
+        const auto pt = to_screen(idx);
+        const int pt_column = static_cast<int>(std::floor(pt.x));
+        if (idx == 0 || pt_column != column) {
+            if (idx != 0)
+                store_column();
+            column = pt_column;
+            first = last = low = high = pt;
+            continue;
+        }
+        last = pt;
+        if (pt.y < low.y)
+            low = pt;
+        if (pt.y > high.y)
+            high = pt;
+    }
+    if (!series.points.empty())
+        store_column();
+}
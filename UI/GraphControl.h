@@ -1,6 +1,7 @@
 #ifndef _GraphControl_h_
 #define _GraphControl_h_
 
+#include <deque>
 #include <vector>
 #include <GG/GGFwd.h>
 #include <GG/Control.h>
@@ -13,11 +14,20 @@ public:
     void SizeMove(const GG::Pt& ul, const GG::Pt& lr) override;
     void RClick(const GG::Pt& pt, GG::Flags<GG::ModKey> mod_keys) override;
 
+    void PreRender() override;
     void Render() override;
 
     void AddSeries(std::vector<std::pair<double, double>> data, const GG::Clr& clr);
+    /** Replaces the points and colour of the series at \a series_idx. */
+    void SetSeries(std::size_t series_idx, std::vector<std::pair<double, double>> data, const GG::Clr& clr);
+    /** Adds \a data to the end of the series at \a series_idx, so that
+      * histories that grow each turn need not be passed in whole again. */
+    void AppendToSeries(std::size_t series_idx, const std::vector<std::pair<double, double>>& data);
     void Clear();
 
+    std::size_t NumSeries() const { return m_data.size(); }
+    const std::vector<std::pair<double, double>>& SeriesPoints(std::size_t series_idx) const;
+
     void SetXMin(double x_min);
     void SetYMin(double y_min);
     void SetXMax(double x_max);
@@ -32,7 +42,34 @@ public:
     void ScaleToZero(bool zero = true);
 
 private:
+    /** A data series, with the screen geometry of its line, which has at most
+      * four vertices per pixel column however many points the series has. */
+    struct Series {
+        Series(std::vector<std::pair<double, double>> points_, const GG::Clr& clr_);
+        void UpdateBounds(std::size_t first_point_idx);
+
+        std::vector<std::pair<double, double>>  points;
+        GG::Clr                                 clr;
+        double                                  x_min, x_max, y_min, y_max;
+        GG::GL2DVertexBuffer                    vert_buf;
+        bool                                    vert_buf_current = false;
+    };
+
+    /** The screen size and data range that the series geometry is laid out
+      * for, which if changed requires all series to be laid out again. */
+    struct LayoutParams {
+        int     width = 0;
+        int     height = 0;
+        double  x_min = 0.0;
+        double  x_range = 1.0;
+        double  y_min = 0.0;
+        double  y_range = 1.0;
+        bool    log_scale = false;
+        bool operator==(const LayoutParams& rhs) const;
+    };
+
     void DoLayout();
+    void LayoutSeries(Series& series) const;
 
     bool    m_show_points = true;
     bool    m_show_lines = true;
@@ -44,8 +81,9 @@ private:
     double  m_x_max = 1.0f;
     double  m_y_min = 0.0f;
     double  m_y_max = 1.0f;
-    std::vector<std::pair<std::vector<std::pair<double, double>>, GG::Clr>> m_data;
+    std::deque<Series>  m_data; // deque, as the vertex buffers of series must not be copied
 
+    LayoutParams            m_layout_params;
     GG::GL2DVertexBuffer    m_vert_buf;
     GG::GLRGBAColorBuffer   m_colour_buf;
     std::map<GG::Y, double> m_y_scale_ticks;
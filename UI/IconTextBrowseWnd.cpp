@@ -25,6 +25,15 @@ IconTextBrowseWnd::IconTextBrowseWnd(std::shared_ptr<GG::Texture> texture,
     m_main_text(std::move(main_text))
 { RequirePreRender(); }
 
+IconTextBrowseWnd::IconTextBrowseWnd(std::shared_ptr<GG::Texture> texture,
+                                     std::string title_text,
+                                     std::function<std::string ()> main_text_generator) :
+    GG::BrowseInfoWnd(GG::X0, GG::Y0, ICON_BROWSE_TEXT_WIDTH + ICON_BROWSE_ICON_WIDTH, GG::Y1),
+    m_texture(std::move(texture)),
+    m_title_text(std::move(title_text)),
+    m_main_text_generator(std::move(main_text_generator))
+{ RequirePreRender(); }
+
 bool IconTextBrowseWnd::WndHasBrowseInfo(const Wnd* wnd, std::size_t mode) const {
     assert(mode <= wnd->BrowseModes().size());
     return true;
@@ -33,6 +42,11 @@ bool IconTextBrowseWnd::WndHasBrowseInfo(const Wnd* wnd, std::size_t mode) const
 void IconTextBrowseWnd::PreRender() {
     GG::Wnd::PreRender();
 
+    if (m_main_text_generator) {
+        m_main_text = m_main_text_generator();
+        m_main_text_generator = nullptr;
+    }
+
     m_icon = GG::Wnd::Create<GG::StaticGraphic>(m_texture, GG::GRAPHIC_FITGRAPHIC | GG::GRAPHIC_PROPSCALE, GG::INTERACTIVE);
     m_icon->Resize(GG::Pt(ICON_BROWSE_ICON_WIDTH, ICON_BROWSE_ICON_HEIGHT));
     AttachChild(m_icon);
@@ -1,6 +1,7 @@
 #ifndef _IconTextBrowseWnd_h_
 #define _IconTextBrowseWnd_h_
 
+#include <functional>
 #include <GG/GGFwd.h>
 #include <GG/BrowseInfoWnd.h>
 
@@ -11,6 +12,12 @@ public:
     IconTextBrowseWnd(std::shared_ptr<GG::Texture> texture, std::string title_text,
                       std::string main_text);
 
+    /** Gets the detail text from \a main_text_generator when first shown,
+      * so that text that is costly to produce is only produced for the
+      * tooltips that are actually looked at. */
+    IconTextBrowseWnd(std::shared_ptr<GG::Texture> texture, std::string title_text,
+                      std::function<std::string ()> main_text_generator);
+
     bool WndHasBrowseInfo(const Wnd* wnd, std::size_t mode) const override;
 
     void PreRender() override;
@@ -23,7 +30,8 @@ private:
     std::shared_ptr<GG::Label>          m_main_text_label;
     const std::shared_ptr<GG::Texture>  m_texture;
     const std::string                   m_title_text;
-    const std::string                   m_main_text;
+    std::string                         m_main_text;
+    std::function<std::string ()>       m_main_text_generator;  ///< if set, gives m_main_text when first shown
 };
 
 #endif
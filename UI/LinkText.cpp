@@ -17,6 +17,8 @@
 #include <boost/xpressive/xpressive.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <unordered_map>
+
 // TextLinker static(s)
 const std::string TextLinker::ENCYCLOPEDIA_TAG("encyclopedia");
 const std::string TextLinker::GRAPH_TAG("graph");
@@ -150,6 +152,7 @@ LinkText::LinkText(GG::X x, GG::Y y, GG::X w, const std::string& str, const std:
     Resize(TextLowerRight() - TextUpperLeft());
     FindLinks();
     MarkLinks();
+    LocateLinks();
 }
 
 LinkText::LinkText(GG::X x, GG::Y y, const std::string& str, const std::shared_ptr<GG::Font>& font,
@@ -160,6 +163,7 @@ LinkText::LinkText(GG::X x, GG::Y y, const std::string& str, const std::shared_p
 {
     FindLinks();
     MarkLinks();
+    LocateLinks();
 }
 
 void LinkText::Render() {
@@ -171,6 +175,7 @@ void LinkText::SetText(std::string str) {
     m_raw_text = std::move(str);
     FindLinks();
     MarkLinks();
+    LocateLinks();
 }
 
 void LinkText::SetLinkedText(std::string str)
@@ -402,10 +407,26 @@ void TextLinker::MouseLeave_() {
     MarkLinks();
 }
 
+namespace {
+    constexpr std::size_t MAX_CACHED_LINK_TEXTS = 512;
+}
+
 void TextLinker::FindLinks() {
+    // The links in a text depend only on the (raw) text, not on the font or
+    // the width it is laid out in, so are cached by text.  Texts are often
+    // set again unchanged, such as when controls are resized or recreated on
+    // refresh, which then needs no extra layout of the raw text to find them.
+    static std::unordered_map<std::string, std::vector<Link>> cached_links;
+
+    const std::string& raw_text = RawText();
+    auto cached_it = cached_links.find(raw_text);
+    if (cached_it != cached_links.end()) {
+        m_links = cached_it->second;
+        return;
+    }
+
     m_links.clear();
 
-    GG::Y y_posn(0); // y-coordinate of the top of the current line
     Link link;
 
     // control text needs to be updated so that the line data is calculated from
@@ -474,7 +495,9 @@ void TextLinker::FindLinks() {
         }
     }
 
-    LocateLinks();
+    if (cached_links.size() >= MAX_CACHED_LINK_TEXTS)
+        cached_links.clear();
+    cached_links.emplace(raw_text, m_links);
 }
 
 void TextLinker::LocateLinks() {
@@ -94,7 +94,7 @@ protected:
     virtual void                SetLinkedText(std::string str) = 0;
     virtual const std::string&  RawText() const = 0;    ///< returns text being displayed before any link formatting is added
 
-    void FindLinks();                       ///< finds the links in the text, with which to populate m_links.
+    void FindLinks();                       ///< finds the links in the text, with which to populate m_links. does not locate them, which should be done once the marked text is set.
     void LocateLinks();                     ///< calculates the physical locations of the links in m_links
     void MarkLinks();                       ///< wraps text for each link in text formatting tags so that the links appear visually distinct from other text
     int  GetLinkUnderPt(const GG::Pt& pt);  ///< returns the index of the link under screen coordinate \a pt, or -1 if none
@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <valarray>
 #include <vector>
+#include <boost/filesystem/operations.hpp>
 #include <boost/graph/graph_concepts.hpp>
 #include <boost/optional/optional.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -12,6 +13,7 @@
 #include <GG/Layout.h>
 #include <GG/MultiEdit.h>
 #include <GG/PtRect.h>
+#include <GG/Texture.h>
 #include <GG/WndEvent.h>
 #include "CensusBrowseWnd.h"
 #include "ChatWnd.h"
@@ -44,6 +46,7 @@
 #include "../Empire/Empire.h"
 #include "../network/Message.h"
 #include "../universe/Field.h"
+#include "../universe/FieldType.h"
 #include "../universe/Fleet.h"
 #include "../universe/Pathfinder.h"
 #include "../universe/Planet.h"
@@ -860,7 +863,7 @@ MapWnd::MovementLineData::MovementLineData() :
     colour(GG::CLR_ZERO)
 {}
 
-MapWnd::MovementLineData::MovementLineData(const std::list<MovePathNode>& path_,
+MapWnd::MovementLineData::MovementLineData(const std::vector<MovePathNode>& path_,
                                            const std::map<std::pair<int, int>, LaneEndpoints>& lane_end_points_map,
                                            GG::Clr colour_/*= GG::CLR_WHITE*/, int empireID /*= ALL_EMPIRES*/) :
     path(path_),
@@ -974,11 +977,41 @@ MapWnd::MapWnd() :
             GG::INTERACTIVE | GG::DRAGABLE)
 {}
 
+namespace {
+    /** Starts decoding the image files in \a dir in the background, so that
+        they are ready by the time they are first shown. */
+    void PrefetchTexturesInDir(const boost::filesystem::path& dir, bool mipmap) {
+        namespace fs = boost::filesystem;
+        std::vector<fs::path> paths;
+        try {
+            if (!fs::is_directory(dir))
+                return;
+            for (fs::directory_iterator it(dir), end_it; it != end_it; ++it) {
+                if (fs::is_regular_file(it->status()) && it->path().extension() == ".png")
+                    paths.push_back(it->path());
+            }
+        } catch (const fs::filesystem_error& e) {
+            ErrorLogger() << "PrefetchTexturesInDir unable to list " << dir << " : " << e.what();
+        }
+        GG::GetTextureManager().PrefetchTextures(paths, mipmap);
+    }
+}
+
 void MapWnd::CompleteConstruction() {
     GG::Wnd::CompleteConstruction();
 
     SetName("MapWnd");
 
+    // the map has an icon or button for every known system, field and group
+    // of fleets, which picking for every mouse move shouldn't all examine
+    SetChildPickIndexing(true);
+
+    // star textures and planet icons are shown for every system on the map
+    // and in the side panel, so start loading them before the game starts
+    PrefetchTexturesInDir(ClientUI::ArtDir() / "stars", false);
+    PrefetchTexturesInDir(ClientUI::ArtDir() / "icons" / "planet", true);
+    PrefetchTexturesInDir(ClientUI::ArtDir() / "icons" / "fleet", false);
+
     using boost::placeholders::_1;
     using boost::placeholders::_2;
 
@@ -1397,6 +1430,8 @@ void MapWnd::CompleteConstruction() {
     // and resource pools due to this will be in the same system
     SidePanel::ResourceCenterChangedSignal.connect(
         boost::bind(&MapWnd::UpdateSidePanelSystemObjectMetersAndResourcePools, this));
+    GGHumanClientApp::GetApp()->MeterEstimatesUpdatedSignal.connect(
+        boost::bind(&MapWnd::UpdateEmpireResourcePools, this));
 
     // situation report window
     m_sitrep_panel = GG::Wnd::Create<SitRepPanel>(SITREP_WND_NAME);
@@ -1991,7 +2026,7 @@ void MapWnd::RenderSystems() {
                     bool has_empire_planet = false;
                     bool has_neutrals = false;
                     std::map<int, int> colony_count_by_empire_id;
-                    const std::set<int>& known_destroyed_object_ids = GetUniverse().EmpireKnownDestroyedObjectIDs(GGHumanClientApp::GetApp()->EmpireID());
+                    const auto& known_destroyed_object_ids = GetUniverse().EmpireKnownDestroyedObjectIDs(GGHumanClientApp::GetApp()->EmpireID());
 
                     for (const auto& planet : Objects().find<const Planet>(system->PlanetIDs())) {
                         if (known_destroyed_object_ids.count(planet->ID()) > 0)
@@ -2139,14 +2174,42 @@ void MapWnd::RenderStarlanes(GG::GL2DVertexBuffer& vertices, GG::GLRGBAColorBuff
 }
 
 namespace {
+    // dots of all the movement lines drawn together, rather than a draw call per line
     GG::GL2DVertexBuffer dot_vertices_buffer;
+    GG::GLRGBAColorBuffer dot_colours_buffer;
     GG::GLTexCoordBuffer dot_star_texture_coords;
-    const unsigned int BUFFER_CAPACITY(512);    // should be long enough for most plausible fleet move lines
+    const unsigned int BUFFER_CAPACITY(512);    // dots per line; should be long enough for most plausible fleet move lines
 
     std::shared_ptr<GG::Texture> MoveLineDotTexture() {
         auto retval = ClientUI::GetTexture(ClientUI::ArtDir() / "misc" / "move_line_dot.png");
         return retval;
     }
+
+    /** Draws the dots added by MapWnd::BufferMovementLine in one call, and
+      * empties the buffers, keeping their storage for the next frame.
+      * Assumes that the dot texture has been bound, and that the vertex and
+      * texture coord array client states have been enabled. */
+    void RenderBufferedMovementLineDots() {
+        if (dot_vertices_buffer.empty())
+            return;
+
+        while (dot_star_texture_coords.size() < dot_vertices_buffer.size()) {
+            dot_star_texture_coords.store(0.0f, 0.0f);
+            dot_star_texture_coords.store(0.0f, 1.0f);
+            dot_star_texture_coords.store(1.0f, 1.0f);
+            dot_star_texture_coords.store(1.0f, 0.0f);
+        }
+
+        glEnableClientState(GL_COLOR_ARRAY);
+        dot_vertices_buffer.activate();
+        dot_colours_buffer.activate();
+        dot_star_texture_coords.activate();
+        glDrawArrays(GL_QUADS, 0, dot_vertices_buffer.size());
+        glDisableClientState(GL_COLOR_ARRAY);
+
+        dot_vertices_buffer.clear();
+        dot_colours_buffer.clear();
+    }
 }
 
 void MapWnd::RenderFleetMovementLines() {
@@ -2165,17 +2228,6 @@ void MapWnd::RenderFleetMovementLines() {
     auto move_line_dot_texture = MoveLineDotTexture();
     float dot_size = Value(move_line_dot_texture->DefaultWidth());
 
-    // texture coords
-    if (dot_star_texture_coords.empty()) {
-        dot_star_texture_coords.reserve(BUFFER_CAPACITY*4);
-        for (std::size_t i = 0; i < BUFFER_CAPACITY; ++i) {
-            dot_star_texture_coords.store(0.0f, 0.0f);
-            dot_star_texture_coords.store(0.0f, 1.0f);
-            dot_star_texture_coords.store(1.0f, 1.0f);
-            dot_star_texture_coords.store(1.0f, 0.0f);
-        }
-    }
-
 
     // dots rendered same size for all zoom levels, so do positioning in screen
     // space instead of universe space
@@ -2190,14 +2242,15 @@ void MapWnd::RenderFleetMovementLines() {
 
     glBindTexture(GL_TEXTURE_2D, move_line_dot_texture->OpenGLId());
     for (const auto& fleet_line : m_fleet_lines)
-    { RenderMovementLine(fleet_line.second, dot_size, dot_spacing, move_line_animation_shift); }
+    { BufferMovementLine(fleet_line.second, dot_size, dot_spacing, move_line_animation_shift); }
 
     // re-render selected fleets' movement lines in white
     for (int fleet_id : m_selected_fleet_ids) {
         auto line_it = m_fleet_lines.find(fleet_id);
         if (line_it != m_fleet_lines.end())
-            RenderMovementLine(line_it->second, dot_size, dot_spacing, move_line_animation_shift, GG::CLR_WHITE);
+            BufferMovementLine(line_it->second, dot_size, dot_spacing, move_line_animation_shift, GG::CLR_WHITE);
     }
+    RenderBufferedMovementLineDots();
 
     // render move line ETA indicators for selected fleets
     for (int fleet_id : m_selected_fleet_ids) {
@@ -2209,7 +2262,8 @@ void MapWnd::RenderFleetMovementLines() {
     // render projected move lines
     glBindTexture(GL_TEXTURE_2D, move_line_dot_texture->OpenGLId());
     for (const auto& fleet_line : m_projected_fleet_lines)
-    { RenderMovementLine(fleet_line.second, dot_size, dot_spacing, move_line_animation_shift, GG::CLR_WHITE); }
+    { BufferMovementLine(fleet_line.second, dot_size, dot_spacing, move_line_animation_shift, GG::CLR_WHITE); }
+    RenderBufferedMovementLineDots();
 
     // render projected move line ETA indicators
     for (const auto& eta_indicator : m_projected_fleet_lines)
@@ -2219,13 +2273,10 @@ void MapWnd::RenderFleetMovementLines() {
     glPopMatrix();
 }
 
-void MapWnd::RenderMovementLine(const MapWnd::MovementLineData& move_line, float dot_size,
+void MapWnd::BufferMovementLine(const MapWnd::MovementLineData& move_line, float dot_size,
                                 float dot_spacing, float dot_shift, GG::Clr clr)
 {
-    // assumes:
-    // - dot texture has already been bound
-    // - identity matrix has been loaded
-    // - vertex array and texture coord array client states ahve been enabled
+    // assumes identity matrix has been loaded, as dots are positioned in screen space
 
     const auto& vertices = move_line.vertices;
     if (vertices.empty())
@@ -2236,21 +2287,15 @@ void MapWnd::RenderMovementLine(const MapWnd::MovementLineData& move_line, float
     }
 
     // if no override colour specified, use line's own colour info
-    if (clr == GG::CLR_ZERO)
-        glColor(move_line.colour);
-    else
-        glColor(clr);
+    const GG::Clr dot_colour = (clr == GG::CLR_ZERO) ? move_line.colour : clr;
 
     float dot_half_sz = dot_size / 2.0f;
     float offset = dot_shift;  // step along line in by move_line_animation_shift to get position of first dot
 
 
     // movement line data changes every frame, so no use for a server buffer...
-    // so fill a client buffer each frame with latest vertex data for this line.
-    // however, want to avoid extra reallocations of buffer, so reserve space.
-    dot_vertices_buffer.clear();
-    dot_vertices_buffer.reserve(BUFFER_CAPACITY*4);
-
+    // so fill a client buffer each frame with latest vertex data for all lines.
+    // the buffers keep their storage between frames, avoiding reallocations.
     unsigned int dots_added_to_buffer = 0;
 
     // set vertex positions to outline a quad for each move line vertex
@@ -2291,6 +2336,8 @@ void MapWnd::RenderMovementLine(const MapWnd::MovementLineData& move_line, float
             dot_vertices_buffer.store(ul.first - dot_size,   ul.second + dot_size);
             dot_vertices_buffer.store(ul.first + dot_size,   ul.second + dot_size);
             dot_vertices_buffer.store(ul.first + dot_size,   ul.second - dot_size);
+            for (int corner = 0; corner < 4; ++corner)
+                dot_colours_buffer.store(dot_colour);
 
             // move offset to that for next dot
             offset += dot_spacing;
@@ -2298,11 +2345,6 @@ void MapWnd::RenderMovementLine(const MapWnd::MovementLineData& move_line, float
 
         offset -= length;   // so next segment's dots meld smoothly into this segment's
     }
-
-    // after adding all dots to buffer, render in one call
-    dot_vertices_buffer.activate();
-    dot_star_texture_coords.activate();
-    glDrawArrays(GL_QUADS, 0, dot_vertices_buffer.size());
 }
 
 void MapWnd::RenderMovementLineETAIndicators(const MapWnd::MovementLineData& move_line,
@@ -2665,6 +2707,10 @@ void MapWnd::InitTurn() {
         TraceLogger(effects) << obj->Dump();
 
     timer.EnterSection("meter estimates");
+    // objects change many times while their meters are estimated and orders
+    // are applied, but observers need only be notified once per object
+    universe.BatchUniverseObjectSignals(true);
+
     // update effect accounting and meter estimates
     universe.InitMeterEstimatesAndDiscrepancies(context);
 
@@ -2678,8 +2724,10 @@ void MapWnd::InitTurn() {
     // redo meter estimates with unowned planets marked as owned by player, so accurate predictions of planet
     // population is available for currently uncolonized planets
     GetUniverse().UpdateMeterEstimates(context);
+    GGHumanClientApp::GetApp()->ClearScheduledMeterEstimateUpdates();
 
     GetUniverse().ApplyAppearanceEffects(context);
+    universe.BatchUniverseObjectSignals(false);
 
     timer.EnterSection("init rendering");
     // set up system icons, starlanes, galaxy gas rendering
@@ -2884,6 +2932,28 @@ void MapWnd::MidTurnUpdate() {
         ShowSystemNames();
 }
 
+void MapWnd::PrefetchTurnTextures() const {
+    ScopedTimer timer("MapWnd::PrefetchTurnTextures");
+
+    // the textures that depend on which systems and fields are known, as
+    // opposed to those for every star and planet type prefetched on
+    // construction.  the mipmapping of each matches where it is used
+    std::vector<boost::filesystem::path> overlay_paths;
+    for (const auto* sys : Objects().allRaw<System>()) {
+        if (!sys->OverlayTexture().empty())
+            overlay_paths.push_back(ClientUI::ArtDir() / sys->OverlayTexture());
+    }
+    GG::GetTextureManager().PrefetchTextures(overlay_paths, false);
+
+    std::vector<boost::filesystem::path> field_paths;
+    for (const auto* field : Objects().allRaw<Field>()) {
+        const FieldType* type = GetFieldType(field->FieldTypeName());
+        if (type && !type->Graphic().empty())
+            field_paths.push_back(ClientUI::ArtDir() / type->Graphic());
+    }
+    GG::GetTextureManager().PrefetchTextures(field_paths, true);
+}
+
 void MapWnd::InitTurnRendering() {
     DebugLogger() << "MapWnd::InitTurnRendering";
     ScopedTimer timer("MapWnd::InitTurnRendering", true);
@@ -2907,12 +2977,25 @@ void MapWnd::InitTurnRendering() {
     const auto& this_client_stale_object_info = GetUniverse().EmpireStaleKnowledgeObjectIDs(client_empire_id);
     const ObjectMap& objects = Objects();
 
-    // remove old system icons
-    for (const auto& system_icon : m_system_icons)
-        DetachChild(system_icon.second);
-    m_system_icons.clear();
+    // remove system icons of systems that are gone, or whose star type has
+    // changed so that their textures need choosing again.  keep the rest, as
+    // creating icons for every system each turn is slow on large maps, but
+    // reset their names, which show the known state of the system's planets
+    for (auto it = m_system_icons.begin(); it != m_system_icons.end();) {
+        auto sys = objects.get<System>(it->first);
+        if (!sys || this_client_known_destroyed_objects.count(it->first) ||
+            sys->GetStarType() != it->second->IconStarType())
+        {
+            DetachChild(it->second);
+            it = m_system_icons.erase(it);
+        } else {
+            it->second->SetSelected(SidePanel::SystemID() == it->first);
+            it->second->ResetNames();
+            ++it;
+        }
+    }
 
-    // create system icons
+    // create system icons for systems without one
     for (auto& sys : objects.all<System>()) {
         int sys_id = sys->ID();
 
@@ -2920,6 +3003,10 @@ void MapWnd::InitTurnRendering() {
         if (this_client_known_destroyed_objects.count(sys_id))
             continue;
 
+        // skip systems with a kept icon
+        if (m_system_icons.count(sys_id))
+            continue;
+
         // create new system icon
         auto icon = GG::Wnd::Create<SystemIcon>(GG::X0, GG::Y0, GG::X(10), sys_id);
         m_system_icons[sys_id] = icon;
@@ -2950,12 +3037,22 @@ void MapWnd::InitTurnRendering() {
     DoSystemIconsLayout();
 
 
-    // remove old field icons
-    for (const auto& field_icon : m_field_icons)
-        DetachChild(field_icon.second);
-    m_field_icons.clear();
+    // remove field icons of fields that are gone or stale, and refresh the
+    // textures of the rest
+    for (auto it = m_field_icons.begin(); it != m_field_icons.end();) {
+        if (!objects.get<Field>(it->first) ||
+            this_client_known_destroyed_objects.count(it->first) ||
+            this_client_stale_object_info.count(it->first))
+        {
+            DetachChild(it->second);
+            it = m_field_icons.erase(it);
+        } else {
+            it->second->Refresh();
+            ++it;
+        }
+    }
 
-    // create field icons
+    // create field icons for fields without one
     for (auto& field : objects.all<Field>()) {
         int fld_id = field->ID();
 
@@ -2964,6 +3061,8 @@ void MapWnd::InitTurnRendering() {
             continue;
         if (this_client_stale_object_info.count(fld_id))
             continue;
+        if (m_field_icons.count(fld_id))
+            continue;
         // don't skip not visible but not stale fields; still expect these to be where last seen, or near there
         //if (field->GetVisibility(client_empire_id) <= Visibility::VIS_NO_VISIBILITY)
         //    continue;
@@ -3530,6 +3629,16 @@ namespace {
 
         std::set<std::pair<int, int>> already_rendered_full_lanes;
 
+        // colour of each lane along which an empire can transfer resources,
+        // keyed by (lower, higher) system id.  the first empire with the lane
+        // in its supply propagation lanes gives the colour
+        std::unordered_map<std::pair<int, int>, GG::Clr, boost::hash<std::pair<int, int>>> supply_lane_colours;
+        for (const auto& entry : Empires()) {
+            const auto empire_colour = entry.second->Color();
+            for (const auto& lane : GetSupplyManager().SupplyStarlaneTraversals(entry.first))
+                supply_lane_colours.emplace(std::minmax(lane.first, lane.second), empire_colour);
+        }
+
         for (const auto& id_icon : sys_icons) {
             int system_id = id_icon.first;
 
@@ -3575,21 +3684,9 @@ namespace {
                 // determine colour(s) for lane based on which empire(s) can transfer resources along the lane.
                 // todo: multiple rendered lanes (one for each empire) when multiple empires use the same lane.
                 GG::Clr lane_colour = UNOWNED_LANE_COLOUR;    // default colour if no empires transfer resources along starlane
-                for (const auto& entry : Empires()) {
-                    const auto& empire = entry.second;
-                    const auto& resource_supply_lanes = GetSupplyManager().SupplyStarlaneTraversals(entry.first);
-
-                    std::pair<int, int> lane_forward{start_system->ID(), dest_system->ID()};
-                    std::pair<int, int> lane_backward{dest_system->ID(), start_system->ID()};
-
-                    // see if this lane exists in this empire's supply propagation lanes set.  either direction accepted.
-                    if (resource_supply_lanes.count(lane_forward) ||
-                        resource_supply_lanes.count(lane_backward))
-                    {
-                        lane_colour = empire->Color();
-                        break;
-                    }
-                }
+                auto colour_it = supply_lane_colours.find(std::minmax(start_system->ID(), dest_system->ID()));
+                if (colour_it != supply_lane_colours.end())
+                    lane_colour = colour_it->second;
 
                 // vertex colours for starlane
                 starlane_colors.store(lane_colour);
@@ -3622,7 +3719,7 @@ namespace {
                            res_group_cores, res_group_core_members,
                            member_to_core, under_alloc_res_grp_core_members);
 
-        const std::set<int>& this_client_known_destroyed_objects =
+        const auto& this_client_known_destroyed_objects =
             GetUniverse().EmpireKnownDestroyedObjectIDs(GGHumanClientApp::GetApp()->EmpireID());
         //unused variable const GG::Clr UNOWNED_LANE_COLOUR = GetOptionsDB().Get<GG::Clr>("ui.map.starlane.color");
 
@@ -3705,14 +3802,21 @@ namespace {
         const auto& this_client_known_destroyed_objects =
             GetUniverse().EmpireKnownDestroyedObjectIDs(GGHumanClientApp::GetApp()->EmpireID());
 
+        // colour of each obstructed lane traversal, keyed by (start, end)
+        // system id.  the first empire with the traversal gives the colour
+        std::unordered_map<std::pair<int, int>, GG::Clr, boost::hash<std::pair<int, int>>> obstructed_lane_colours;
+        for (const auto& entry : Empires()) {
+            const auto empire_colour = entry.second->Color();
+            for (const auto& lane : GetSupplyManager().SupplyObstructedStarlaneTraversals(entry.first))
+                obstructed_lane_colours.emplace(lane, empire_colour);
+        }
+        if (obstructed_lane_colours.empty())
+            return;
+
 
         for (const auto& id_icon : sys_icons) {
             int system_id = id_icon.first;
 
-            // skip systems that don't actually exist
-            if (this_client_known_destroyed_objects.count(system_id))
-                continue;
-
             // skip systems that don't actually exist
             if (this_client_known_destroyed_objects.count(system_id))
                 continue;
@@ -3746,31 +3850,20 @@ namespace {
 
 
                 // add obstructed lane traversals as half lanes
-                for (const auto& entry : Empires()) {
-                    const auto& empire = entry.second;
-                    const auto& resource_obstructed_supply_lanes =
-                        GetSupplyManager().SupplyObstructedStarlaneTraversals(entry.first);
-
-                    // see if this lane exists in this empire's obstructed supply propagation lanes set.  either direction accepted.
-                    if (!resource_obstructed_supply_lanes.count({start_system->ID(), dest_system->ID()}))
-                        continue;
-
-                    // found an empire that has a half lane here, so add it.
-                    rendered_half_starlanes.emplace(start_system->ID(), dest_system->ID());  // inserted as ordered pair, so both directions can have different half-lanes
-
-                    LaneEndpoints lane_endpoints = StarlaneEndPointsFromSystemPositions(start_system->X(), start_system->Y(), dest_system->X(), dest_system->Y());
-                    starlane_vertices.store(lane_endpoints.X1, lane_endpoints.Y1);
-                    starlane_vertices.store((lane_endpoints.X1 + lane_endpoints.X2) * 0.5f,   // half way along starlane
-                                            (lane_endpoints.Y1 + lane_endpoints.Y2) * 0.5f);
+                auto colour_it = obstructed_lane_colours.find({start_system->ID(), dest_system->ID()});
+                if (colour_it == obstructed_lane_colours.end())
+                    continue;
 
-                    GG::Clr lane_colour = empire->Color();
-                    starlane_colors.store(lane_colour);
-                    starlane_colors.store(lane_colour);
+                // found an empire that has a half lane here, so add it.
+                rendered_half_starlanes.emplace(start_system->ID(), dest_system->ID());  // inserted as ordered pair, so both directions can have different half-lanes
 
-                    //std::cout << "Adding half lane between " << start_system->Name() << " to " << dest_system->Name() << " with colour of empire " << empire->Name() << std::endl;
+                LaneEndpoints lane_endpoints = StarlaneEndPointsFromSystemPositions(start_system->X(), start_system->Y(), dest_system->X(), dest_system->Y());
+                starlane_vertices.store(lane_endpoints.X1, lane_endpoints.Y1);
+                starlane_vertices.store((lane_endpoints.X1 + lane_endpoints.X2) * 0.5f,   // half way along starlane
+                                        (lane_endpoints.Y1 + lane_endpoints.Y2) * 0.5f);
 
-                    break;
-                }
+                starlane_colors.store(colour_it->second);
+                starlane_colors.store(colour_it->second);
             }
         }
     }
@@ -3781,7 +3874,7 @@ namespace {
 
         std::map<std::pair<int, int>, LaneEndpoints> retval;
 
-        const std::set<int>& this_client_known_destroyed_objects =
+        const auto& this_client_known_destroyed_objects =
             GetUniverse().EmpireKnownDestroyedObjectIDs(GGHumanClientApp::GetApp()->EmpireID());
 
         for (auto const& id_icon : sys_icons) {
@@ -3829,33 +3922,47 @@ void MapWnd::InitStarlaneRenderingBuffers() {
     DebugLogger() << "MapWnd::InitStarlaneRenderingBuffers";
     ScopedTimer timer("MapWnd::InitStarlaneRenderingBuffers", true);
 
-    ClearStarlaneRenderingBuffers();
-
     // todo: move this somewhere better... fill in starlane endpoint cache
     m_starlane_endpoints = CalculateStarlaneEndpoints(m_system_icons);
 
 
     // temp storage
     std::set<std::pair<int, int>> rendered_half_starlanes;  // stored as unaltered pairs, so that a each direction of traversal can be shown separately
+    GG::GL2DVertexBuffer starlane_vertices, RC_starlane_vertices;
+    GG::GLRGBAColorBuffer starlane_colors, RC_starlane_colors;
 
 
     // add vertices and colours to lane rendering buffers
-    PrepFullLanesToRender(m_system_icons, m_starlane_vertices, m_starlane_colors);
+    PrepFullLanesToRender(m_system_icons, starlane_vertices, starlane_colors);
     PrepResourceConnectionLanesToRender(m_system_icons, GGHumanClientApp::GetApp()->EmpireID(),
                                         rendered_half_starlanes,
-                                        m_RC_starlane_vertices, m_RC_starlane_colors);
+                                        RC_starlane_vertices, RC_starlane_colors);
     PrepObstructedLaneTraversalsToRender(m_system_icons, GGHumanClientApp::GetApp()->EmpireID(),
                                          rendered_half_starlanes,
-                                         m_starlane_vertices, m_starlane_colors);
-
-
-    // fill new buffers
-    m_starlane_vertices.createServerBuffer();
-    m_starlane_colors.createServerBuffer();
-    m_starlane_vertices.harmonizeBufferType(m_starlane_colors);
-    m_RC_starlane_vertices.createServerBuffer();
-    m_RC_starlane_colors.createServerBuffer();
-    m_RC_starlane_vertices.harmonizeBufferType(m_RC_starlane_colors);
+                                         starlane_vertices, starlane_colors);
+
+
+    // replace and fill only the buffers whose contents changed, as lanes
+    // usually differ little from one turn to the next, and supply changes
+    // often only recolour lanes, leaving the lane geometry as it was
+    auto replace_buffers = [](auto& vertices, auto& colors, auto& new_vertices, auto& new_colors) {
+        const bool same_vertices = vertices.sameData(new_vertices);
+        const bool same_colors = colors.sameData(new_colors);
+        if (!same_vertices) {
+            vertices.swap(new_vertices);
+            new_vertices.clear();
+            vertices.createServerBuffer();
+        }
+        if (!same_colors) {
+            colors.swap(new_colors);
+            new_colors.clear();
+            colors.createServerBuffer();
+        }
+        if (!same_vertices || !same_colors)
+            vertices.harmonizeBufferType(colors);
+    };
+    replace_buffers(m_starlane_vertices, m_starlane_colors, starlane_vertices, starlane_colors);
+    replace_buffers(m_RC_starlane_vertices, m_RC_starlane_colors, RC_starlane_vertices, RC_starlane_colors);
 }
 
 void MapWnd::ClearStarlaneRenderingBuffers() {
@@ -4849,8 +4956,8 @@ namespace {
     /** Return fleet if \p obj is not destroyed, not stale, a fleet and not empty.*/
     std::shared_ptr<const Fleet> IsQualifiedFleet(const std::shared_ptr<const UniverseObject>& obj,
                                                   int empire_id,
-                                                  const std::set<int>& known_destroyed_objects,
-                                                  const std::set<int>& stale_object_info)
+                                                  const ObjectIDBitmap& known_destroyed_objects,
+                                                  const ObjectIDBitmap& stale_object_info)
     {
         int object_id = obj->ID();
         if (obj->ObjectType() != UniverseObjectType::OBJ_FLEET)
@@ -5015,14 +5122,19 @@ void MapWnd::DeferredRefreshFleetButtons() {
         }
     }
 
+    // keep existing buttons, to reuse those for groups of fleets that are
+    // unchanged, then remove them all
+    FleetButtonsByFleets old_fleet_buttons;
+    for (const auto& id_and_fb : m_fleet_buttons)
+        old_fleet_buttons.emplace(id_and_fb.second->Fleets(), id_and_fb.second);
     DeleteFleetButtons();
 
     // create new fleet buttons for fleets...
     const auto FLEETBUTTON_SIZE = FleetButtonSizeType();
-    CreateFleetButtonsOfType(m_departing_fleet_buttons,  departing_fleets,  FLEETBUTTON_SIZE);
-    CreateFleetButtonsOfType(m_stationary_fleet_buttons, stationary_fleets, FLEETBUTTON_SIZE);
-    CreateFleetButtonsOfType(m_moving_fleet_buttons,     moving_fleets,     FLEETBUTTON_SIZE);
-    CreateFleetButtonsOfType(m_offroad_fleet_buttons,    offroad_fleets,    FLEETBUTTON_SIZE);
+    CreateFleetButtonsOfType(m_departing_fleet_buttons,  departing_fleets,  FLEETBUTTON_SIZE, old_fleet_buttons);
+    CreateFleetButtonsOfType(m_stationary_fleet_buttons, stationary_fleets, FLEETBUTTON_SIZE, old_fleet_buttons);
+    CreateFleetButtonsOfType(m_moving_fleet_buttons,     moving_fleets,     FLEETBUTTON_SIZE, old_fleet_buttons);
+    CreateFleetButtonsOfType(m_offroad_fleet_buttons,    offroad_fleets,    FLEETBUTTON_SIZE, old_fleet_buttons);
 
     // position fleetbuttons
     DoFleetButtonsLayout();
@@ -5038,8 +5150,13 @@ void MapWnd::DeferredRefreshFleetButtons() {
 template <typename FleetButtonMap, typename FleetsMap>
 void MapWnd::CreateFleetButtonsOfType(FleetButtonMap& type_fleet_buttons,
                                       const FleetsMap& fleets_map,
-                                      const FleetButton::SizeType& fleet_button_size)
+                                      const FleetButton::SizeType& fleet_button_size,
+                                      FleetButtonsByFleets& old_fleet_buttons)
 {
+    // fleets at the same position, bucketed by position
+    std::unordered_map<std::pair<double, double>, std::vector<int>,
+                       boost::hash<std::pair<double, double>>> fleet_positions_ids;
+
     for (const auto& fleets : fleets_map) {
         const auto& key = fleets.first.first;
 
@@ -5048,8 +5165,8 @@ void MapWnd::CreateFleetButtonsOfType(FleetButtonMap& type_fleet_buttons,
         if (fleet_IDs.empty())
             continue;
 
-        // sort fleets by position
-        std::map<std::pair<double, double>, std::vector<int>> fleet_positions_ids;
+        // group fleets by position
+        fleet_positions_ids.clear();
         for (const auto& fleet : Objects().find<Fleet>(fleet_IDs)) {
             if (!fleet)
                 continue;
@@ -5060,8 +5177,18 @@ void MapWnd::CreateFleetButtonsOfType(FleetButtonMap& type_fleet_buttons,
         for (auto& cluster : fleet_positions_ids) {
             auto& ids_in_cluster = cluster.second;
 
-            // create new fleetbutton for this cluster of fleets
-            auto fb = GG::Wnd::Create<FleetButton>(std::move(ids_in_cluster), fleet_button_size);
+            // reuse the existing button for this cluster of fleets, if there
+            // is one, or create a new one
+            auto old_it = old_fleet_buttons.find(ids_in_cluster);
+            const bool reused = old_it != old_fleet_buttons.end();
+            std::shared_ptr<FleetButton> fb;
+            if (reused) {
+                fb = std::move(old_it->second);
+                old_fleet_buttons.erase(old_it);
+                fb->Refresh(fleet_button_size);
+            } else {
+                fb = GG::Wnd::Create<FleetButton>(std::move(ids_in_cluster), fleet_button_size);
+            }
 
             // store per type of fleet button.
             type_fleet_buttons[key].emplace(fb);
@@ -5070,8 +5197,10 @@ void MapWnd::CreateFleetButtonsOfType(FleetButtonMap& type_fleet_buttons,
             for (int fleet_id : fb->Fleets())
                 m_fleet_buttons[fleet_id] = fb;
 
-            fb->LeftClickedSignal.connect(boost::bind(&MapWnd::FleetButtonLeftClicked, this, fb.get()));
-            fb->RightClickedSignal.connect(boost::bind(&MapWnd::FleetButtonRightClicked, this, fb.get()));
+            if (!reused) {
+                fb->LeftClickedSignal.connect(boost::bind(&MapWnd::FleetButtonLeftClicked, this, fb.get()));
+                fb->RightClickedSignal.connect(boost::bind(&MapWnd::FleetButtonRightClicked, this, fb.get()));
+            }
             AttachChild(std::move(fb));
         }
     }
@@ -5847,6 +5976,11 @@ void MapWnd::RefreshFleetButtonSelectionIndicators() {
             button->SetSelected(false);
     }
 
+    for (auto& offroad_fleet_button : m_offroad_fleet_buttons) {
+        for (auto& button : offroad_fleet_button.second)
+            button->SetSelected(false);
+    }
+
     // add new selection indicators
     for (int fleet_id : m_selected_fleet_ids) {
         const auto& button_it = m_fleet_buttons.find(fleet_id);
@@ -6872,9 +7006,9 @@ void MapWnd::RefreshPopulationIndicator() {
 }
 
 void MapWnd::UpdateSidePanelSystemObjectMetersAndResourcePools() {
-    ScriptingContext context{GetUniverse(), Empires(), GetGalaxySetupData(), GetSpeciesManager(), GetSupplyManager()};
-    GetUniverse().UpdateMeterEstimates(SidePanel::SystemID(), context, true);
-    UpdateEmpireResourcePools();
+    // done once after several quick focus changes, after which
+    // MeterEstimatesUpdatedSignal updates the resource pools
+    GGHumanClientApp::GetApp()->ScheduleMeterEstimateUpdate(SidePanel::SystemID(), true);
 }
 
 void MapWnd::UpdateEmpireResourcePools() {
@@ -7640,7 +7774,7 @@ void MapWnd::DispatchFleetsExploring() {
         return;
     }
     int max_routes_per_system = GetOptionsDB().Get<int>("ui.fleet.explore.system.route.limit");
-    auto destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(empire_id);
+    const auto& destroyed_objects = GetUniverse().EmpireKnownDestroyedObjectIDs(empire_id);
 
     FleetIDListType idle_fleets;
     /** all systems ID for which an exploring fleet is in route and the fleet assigned */
@@ -131,6 +131,7 @@ public:
     void EnableOrderIssuing(bool enable = true);                 //!< enables or disables order issuing and pressing the turn button.
 
     void InitTurn();                                             //!< called at the start of each turn
+    void PrefetchTurnTextures() const;                           //!< starts loading the textures of the known system overlays and fields, before InitTurn() needs them
     void MidTurnUpdate();                                        //!< called after receiving updated Universe during turn processing, but not when the full turn update is received
 
     void RestoreFromSaveData(const SaveGameUIData& data);        //!< restores the UI state that was saved in an earlier call to GetSaveGameUIData().
@@ -220,8 +221,9 @@ private:
     void RefreshPopulationIndicator();
     void RefreshDetectionIndicator();
 
-    /** update meter estimates for objects contained within the current system
-      * shown in the sidepanel, or all objects if there is no system shown */
+    /** schedules an update of meter estimates for objects contained within
+      * the current system shown in the sidepanel, or all objects if there is
+      * no system shown */
     void UpdateSidePanelSystemObjectMetersAndResourcePools();
     /** recalculates production and predicted changes of player's empire's
       * resource and population pools */
@@ -232,13 +234,13 @@ private:
     struct MovementLineData {
         struct Vertex;  // apparent universe positions of move line points, derived from actual universe positions contained in MovePathNodes
         MovementLineData();
-        MovementLineData(const std::list<MovePathNode>& path_,
+        MovementLineData(const std::vector<MovePathNode>& path_,
                          const std::map<std::pair<int, int>, LaneEndpoints>& lane_end_points_map,
                          GG::Clr colour_ = GG::CLR_WHITE, int empireID = ALL_EMPIRES);
 
-        std::list<MovePathNode> path;       // raw path data from which line rendering is determined
-        GG::Clr                 colour;     // colour of line
-        std::vector<Vertex>     vertices;   // cached apparent universe positions of starts and ends of line segments drawn to represent move path
+        std::vector<MovePathNode> path;       // raw path data from which line rendering is determined
+        GG::Clr                   colour;     // colour of line
+        std::vector<Vertex>       vertices;   // cached apparent universe positions of starts and ends of line segments drawn to represent move path
     };
 
     class MapScaleLine;
@@ -260,14 +262,20 @@ private:
       * per render interval.*/
     void DeferredRefreshFleetButtons();
 
+    /** Fleet buttons indexed by the ids of the fleets they represent. */
+    using FleetButtonsByFleets = std::map<std::vector<int>, std::shared_ptr<FleetButton>>;
+
     /** Use the vectors of fleet ids from \p fleets_map to create fleet buttons
       * in \p type_fleet_buttons and record the fleet buttons in
-      * \p m_fleet_buttons.*/
+      * \p m_fleet_buttons.  Buttons in \p old_fleet_buttons for the same
+      * fleets are refreshed and reused, and removed from it, instead of
+      * creating new buttons. */
     template <typename FleetButtonMap, typename FleetsMap>
     void CreateFleetButtonsOfType(
         FleetButtonMap& type_fleet_buttons,
         const FleetsMap& fleets_map,
-        const FleetButton::SizeType& fleet_button_size);
+        const FleetButton::SizeType& fleet_button_size,
+        FleetButtonsByFleets& old_fleet_buttons);
 
     /** Delete all fleet buttons.*/
     void DeleteFleetButtons();
@@ -320,10 +328,11 @@ private:
     /* renders the dashed lines indicating where each fleet is going */
     void RenderFleetMovementLines();
 
-    /* renders a single fleet movement line. if \a clr is GG::CLR_ZERO, the lane
-     * is rendered with the .colour attribute of \a move_line. assumes that the
-     * move dot texture has already been bound. */
-    void RenderMovementLine(const MapWnd::MovementLineData& move_line, float dot_size, float dot_spacing, float dot_shift,
+    /* adds the dots of a single fleet movement line to those that are drawn
+     * together in one call by RenderFleetMovementLines. if \a clr is
+     * GG::CLR_ZERO, the dots are coloured with the .colour attribute of
+     * \a move_line. */
+    void BufferMovementLine(const MapWnd::MovementLineData& move_line, float dot_size, float dot_spacing, float dot_shift,
                             GG::Clr clr = GG::CLR_ZERO);
 
     /* renders ETA indicators at end-of-turn positions for a single fleet movement
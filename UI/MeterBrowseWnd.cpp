@@ -243,7 +243,9 @@ namespace {
         }
 
         // get effect accounting info for this MeterBrowseWnd's object, aborting if non available
-        const Universe& universe = GetUniverse();
+        Universe& universe = GetUniverse();
+        ScriptingContext context{universe, Empires(), GetGalaxySetupData(), GetSpeciesManager(), GetSupplyManager()};
+        universe.UpdateMeterAccounting(obj_id, context);
         const auto& effect_accounting_map = universe.GetEffectAccountingMap();
         auto map_it = effect_accounting_map.find(obj_id);
         if (map_it == effect_accounting_map.end())
@@ -31,6 +31,8 @@
 
 #include <iterator>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 std::vector<std::string> SpecialNames();
 
@@ -1401,9 +1403,19 @@ public:
 
     int ObjectID() const { return m_object_id; }
 
+    /** Re-evaluates the shown values and icons of an already-initialized
+      * panel, without rebuilding its other controls. */
+    void RefreshValues() {
+        m_column_val_cache.clear();
+        m_values_stale = m_initialized;
+        RequirePreRender();
+    }
+
     void PreRender() override {
         GG::Control::PreRender();
         Init();
+        if (m_values_stale)
+            UpdateValues();
         DoLayout();
     }
 
@@ -1535,6 +1547,24 @@ private:
         RequirePreRender();
     }
 
+    void UpdateValues() {
+        m_values_stale = false;
+
+        GG::Flags<GG::GraphicStyle> style = GG::GRAPHIC_CENTER | GG::GRAPHIC_VCENTER |
+                                            GG::GRAPHIC_FITGRAPHIC | GG::GRAPHIC_PROPSCALE;
+        DetachChildAndReset(m_icon);
+        auto textures = ObjectTextures(Objects().get(m_object_id));
+        auto tx_size = textures.size();
+        m_icon = GG::Wnd::Create<MultiTextureStaticGraphic>(
+            std::move(textures), std::vector<GG::Flags<GG::GraphicStyle>>(tx_size, style));
+        AttachChild(m_icon);
+
+        // labels ignore being set to the text they already show
+        for (std::size_t i = 0; i < m_controls.size(); ++i)
+            if (auto label = std::dynamic_pointer_cast<GG::TextControl>(m_controls[i]))
+                label->SetText(SortKey(i));
+    }
+
     std::vector<std::shared_ptr<GG::Control>> GetControls() {
         std::vector<std::shared_ptr<GG::Control>> retval;
         retval.reserve(NUM_COLUMNS);
@@ -1549,6 +1579,7 @@ private:
     }
 
     bool    m_initialized = false;
+    bool    m_values_stale = false;
     int     m_object_id = INVALID_OBJECT_ID;
     int     m_indent = 1;
     bool    m_expanded = false;
@@ -1616,6 +1647,12 @@ public:
     const std::set<int>& ContainedPanels() const
     { return m_contained_object_panels; }
 
+    bool Expanded() const
+    { return m_expanded_init; }
+
+    int Indent() const
+    { return m_indent_init; }
+
     void SetContainedPanels(const std::set<int>& contained_object_panels) {
         m_contained_object_panels = contained_object_panels;
         m_panel->SetHasContents(!m_contained_object_panels.empty());
@@ -1625,6 +1662,9 @@ public:
     void Update()
     { m_panel->RequirePreRender(); }
 
+    void RefreshValues()
+    { m_panel->RefreshValues(); }
+
     void SizeMove(const GG::Pt& ul, const GG::Pt& lr) override {
         const GG::Pt old_size = Size();
         GG::ListBox::Row::SizeMove(ul, lr);
@@ -1979,9 +2019,15 @@ public:
         if (m_filter_condition && !m_filter_condition->Eval(obj))
             return false;
 
-        int object_id = obj->ID();
+        return VisibilityShown(*obj, assume_visible_without_checking);
+    }
+
+    /** Returns true if \a obj is shown with the visibility filters, ignoring
+      * the filter condition. */
+    bool VisibilityShown(const UniverseObject& obj, bool assume_visible_without_checking = false) {
+        int object_id = obj.ID();
         int client_empire_id = GGHumanClientApp::GetApp()->EmpireID();
-        UniverseObjectType type = obj->ObjectType();
+        UniverseObjectType type = obj.ObjectType();
 
         if (GetUniverse().EmpireKnownDestroyedObjectIDs(client_empire_id).count(object_id))
             return m_visibilities[type].count(VIS_DISPLAY::SHOW_DESTROYED);
@@ -1995,7 +2041,13 @@ public:
     void Refresh() {
         SectionedScopedTimer timer("ObjectListBox::Refresh");
         std::size_t first_visible_queue_row = std::distance(this->begin(), this->FirstRowShown());
-        ClearContents();
+
+        // keep the current rows, so that AddObjectRow can reuse those of
+        // objects that are still shown in the same place
+        for (auto& row : *this)
+            if (auto object_row = std::dynamic_pointer_cast<ObjectRow>(row))
+                m_reusable_rows.emplace(object_row->ObjectID(), std::move(object_row));
+        Clear();
         auto initial_style = this->Style();
         this->SetStyle(GG::LIST_NOSORT);    // to avoid sorting while inserting
 
@@ -2009,29 +2061,46 @@ public:
         std::map<int, std::set<std::shared_ptr<Building>>>  planet_buildings;
         std::map<int, std::set<std::shared_ptr<Field>>>     system_fields;
 
+        // evaluate the filter condition on all objects at once, which lets it
+        // narrow down its candidates, rather than separately for each object
+        timer.EnterSection("filter condition");
+        std::unordered_set<int> filter_matches;
+        if (m_filter_condition) {
+            const ScriptingContext context;
+            Condition::ObjectSet matches;
+            m_filter_condition->Eval(context, matches);
+            filter_matches.reserve(matches.size());
+            for (const auto& obj : matches)
+                filter_matches.insert(obj->ID());
+        }
+        auto shown = [this, &filter_matches](const auto& obj) {
+            return (!m_filter_condition || filter_matches.count(obj->ID())) &&
+                VisibilityShown(*obj);
+        };
+
         timer.EnterSection("object cast-sorting");
         for (const auto& obj : Objects().all<System>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 systems.insert(obj);
         }
         for (const auto& obj : Objects().all<Field>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 system_fields[obj->SystemID()].insert(obj);
         }
         for (const auto& obj : Objects().all<Fleet>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 system_fleets[obj->SystemID()].insert(obj);
         }
         for (const auto& obj : Objects().all<Ship>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 fleet_ships[obj->FleetID()].insert(obj);
         }
         for (const auto& obj : Objects().all<Planet>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 system_planets[obj->SystemID()].insert(obj);
         }
         for (const auto& obj : Objects().all<Building>()) {
-            if (ObjectShown(obj))
+            if (shown(obj))
                 planet_buildings[obj->PlanetID()].insert(obj);
         }
         // UniverseObjectType::OBJ_FIGHTER shouldn't exist outside combat, so ignored here
@@ -2193,6 +2262,11 @@ public:
                 AddObjectRow(field, sys_fields.first, id_range(), indent);
 
 
+        // drop rows of objects no longer shown
+        for (auto& [object_id, row] : m_reusable_rows)
+            m_object_change_connections[object_id].disconnect();
+        m_reusable_rows.clear();
+
         // sort added rows
         timer.EnterSection("sorting");
         this->SetStyle(initial_style);
@@ -2257,12 +2331,30 @@ private:
         if (!obj)
             return;
         const int OBJ_ID = obj->ID();
+        const GG::Pt ROW_SIZE = ListRowSize();
+
+        // reuse this object's row from before a refresh if it is laid out the
+        // same, updating only its values
+        auto reusable_it = m_reusable_rows.find(OBJ_ID);
+        if (reusable_it != m_reusable_rows.end()) {
+            auto object_row = std::move(reusable_it->second);
+            m_reusable_rows.erase(reusable_it);
+            if (object_row->ContainedByPanel() == container &&
+                object_row->Indent() == indent &&
+                object_row->Expanded() == !ObjectCollapsed(OBJ_ID) &&
+                object_row->ContainedPanels() == std::set<int>(contents.begin(), contents.end()))
+            {
+                object_row->RefreshValues();
+                object_row->Resize(ROW_SIZE);
+                this->Insert(std::move(object_row));
+                return;
+            }
+        }
 
         m_object_change_connections[OBJ_ID].disconnect();
         m_object_change_connections[OBJ_ID] = obj->StateChangedSignal.connect(
             boost::bind(&ObjectListBox::ObjectStateChanged, this, OBJ_ID), boost::signals2::at_front);
 
-        const GG::Pt ROW_SIZE = ListRowSize();
         auto object_row = GG::Wnd::Create<ObjectRow>(ROW_SIZE.x, ROW_SIZE.y, std::move(obj),
                                                      !ObjectCollapsed(OBJ_ID),
                                                      container, contents, indent);
@@ -2366,6 +2458,7 @@ private:
     { if (obj) RemoveObjectRow(obj->ID()); }
 
     std::map<int, boost::signals2::connection>          m_object_change_connections;
+    std::unordered_map<int, std::shared_ptr<ObjectRow>> m_reusable_rows;   // rows from before a Refresh, while it runs
     std::set<int>                                       m_collapsed_objects;
     std::unique_ptr<Condition::Condition>               m_filter_condition;
     std::map<UniverseObjectType, std::set<VIS_DISPLAY>> m_visibilities;
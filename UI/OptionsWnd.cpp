@@ -765,6 +765,7 @@ void OptionsWnd::CompleteConstruction() {
     BoolOption(current_page, 0, "save.format.xml.zlib.enabled",     UserString("OPTIONS_USE_XML_ZLIB_SERIALIZATION"));
     BoolOption(current_page, 0, "ui.map.sitrep.invalid.shown",      UserString("OPTIONS_VERBOSE_SITREP_DESC"));
     BoolOption(current_page, 0, "effects.accounting.enabled",       UserString("OPTIONS_EFFECT_ACCOUNTING"));
+    BoolOption(current_page, 0, "effects.accounting.on-demand",     UserString("OPTIONS_EFFECT_ACCOUNTING_ON_DEMAND"));
 
     // Create full state config button
     auto all_config_button = GG::Wnd::Create<CUIButton>(UserString("OPTIONS_WRITE_ALL_CONFIG"));
@@ -773,7 +774,7 @@ void OptionsWnd::CompleteConstruction() {
         GG::Wnd::Create<TextBrowseWnd>(UserString("OPTIONS_CREATE_ALL_CONFIG_TOOLTIP_TITLE"),
                                        UserString("OPTIONS_CREATE_ALL_CONFIG_TOOLTIP_DESC"), ROW_WIDTH));
     all_config_button->LeftClickedSignal.connect([]() {
-        if (GetOptionsDB().Commit(false, false))
+        if (GetOptionsDB().Commit(false, false) && GetOptionsDB().WaitForCommits())
             ClientUI::MessageBox(UserString("OPTIONS_CREATE_ALL_CONFIG_SUCCESS"));
         else
             ClientUI::MessageBox(UserString("OPTIONS_CREATE_ALL_CONFIG_FAILURE"));
@@ -1332,6 +1333,7 @@ void OptionsWnd::ResolutionOption(GG::ListBox* page, int indentation_level) {
 
     // fps
     BoolOption(page, indentation_level, "video.fps.shown", UserString("OPTIONS_SHOW_FPS"));
+    BoolOption(page, indentation_level, "video.profiler.shown", UserString("OPTIONS_SHOW_PROFILER"));
 
     //GG::StateButton* limit_FPS_button = BoolOption(page, indentation_level, "video.fps.max.enabled", UserString("OPTIONS_LIMIT_FPS"));
     //GG::Spin<double>* max_fps_spin =
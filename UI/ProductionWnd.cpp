@@ -899,6 +899,9 @@ void ProductionWnd::CompleteConstruction() {
     AttachChild(m_production_info_panel);
     AttachChild(m_queue_wnd);
     AttachChild(m_build_designator_wnd);
+
+    m_projection_timer.Stop();
+    m_projection_timer.Connect(this);
 }
 
 ProductionWnd::~ProductionWnd()
@@ -953,9 +956,12 @@ void ProductionWnd::Refresh() {
     // connections of signals emitted from the empire must be remade after
     // getting a turn update
     m_empire_connection.disconnect();
-    if (Empire* empire = GetEmpire(m_empire_shown_id))
+    if (Empire* empire = GetEmpire(m_empire_shown_id)) {
         m_empire_connection = empire->GetProductionQueue().ProductionQueueChangedSignal.connect(
             boost::bind(&ProductionWnd::ProductionQueueChangedSlot, this));
+        // project queue completion times without blocking the UI
+        empire->SetAsyncProductionProjection(true);
+    }
 
     UpdateInfoPanel();
     UpdateQueue();
@@ -1071,6 +1077,27 @@ void ProductionWnd::ProductionQueueChangedSlot() {
     UpdateInfoPanel();
     UpdateQueue();
     m_build_designator_wnd->Update();
+
+    // poll for the completion times being projected on another thread, if any
+    const Empire* empire = GetEmpire(m_empire_shown_id);
+    if (empire && empire->GetProductionQueue().ProjectionPending() && !m_projection_timer.Running()) {
+        m_projection_timer.Reset(GG::GUI::GetGUI()->Ticks());
+        m_projection_timer.Start();
+    }
+}
+
+void ProductionWnd::TimerFiring(unsigned int ticks, GG::Timer* timer) {
+    if (timer != &m_projection_timer)
+        return;
+    timer->Reset(ticks);
+
+    Empire* empire = GetEmpire(m_empire_shown_id);
+    if (!empire || !empire->GetProductionQueue().ProjectionPending()) {
+        m_projection_timer.Stop();
+        return;
+    }
+    // emits ProductionQueueChangedSignal if the projection has finished
+    empire->ApplyFinishedProductionProjection();
 }
 
 void ProductionWnd::UpdateQueue() {
@@ -6,6 +6,7 @@
 #include "../Empire/Empire.h"
 
 #include <GG/ListBox.h>
+#include <GG/Timer.h>
 
 class ResourceInfoPanel;
 class BuildDesignatorWnd;
@@ -28,6 +29,8 @@ public:
 
     void Render() override;
 
+    void TimerFiring(unsigned int ticks, GG::Timer* timer) override;
+
     void SetEmpireShown(int empire_id);
 
     void Refresh();
@@ -133,6 +136,7 @@ private:
     bool                        m_order_issuing_enabled = false;
     int                         m_empire_shown_id = ALL_EMPIRES;
     boost::signals2::connection m_empire_connection;
+    GG::Timer                   m_projection_timer{100};    //!< polls for production queue projections made on another thread
 };
 
 
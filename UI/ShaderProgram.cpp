@@ -3,6 +3,8 @@
 #include "../client/human/GGHumanClientApp.h"
 #include "../util/Logger.h"
 
+#include <GG/DrawBatch.h>
+
 
 namespace {
     void CHECK_ERROR(const char* fn, const char* e) {
@@ -299,10 +301,13 @@ bool ShaderProgram::AllValuesBound() {
 }
 
 void ShaderProgram::Use() {
+    GG::GetDrawBatch().Flush();
     glGetError();
     glUseProgram(m_program_id);
     CHECK_ERROR("ShaderProgram::Use", "glUseProgram()");
 }
 
-void ShaderProgram::stopUse()
-{ glUseProgram(0); }
+void ShaderProgram::stopUse() {
+    GG::GetDrawBatch().Flush();
+    glUseProgram(0);
+}
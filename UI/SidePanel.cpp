@@ -523,6 +523,12 @@ public:
     bool InWindow(const GG::Pt& pt) const override;
 
     int PlanetID() const { return m_planet_id; }
+    StarType GetStarType() const { return m_star_type; }
+
+    /** Returns true if this panel's controls exist, so that it can be
+      * refreshed to show its planet, which it can't if it was refreshed
+      * while its planet was not known. */
+    bool HasControls() const { return m_planet_name != nullptr; }
 
     void PreRender() override;
 
@@ -605,7 +611,9 @@ private:
 
 /** Container class that holds PlanetPanels.  Creates and destroys PlanetPanel
   * as necessary, and does layout of them after creation and in response to
-  * scrolling through them by the user. */
+  * scrolling through them by the user.  Panels for planets that are still
+  * shown when the planets are set again are kept and refreshed, rather than
+  * recreated. */
 class SidePanel::PlanetPanelContainer : public GG::Wnd {
 public:
     PlanetPanelContainer();
@@ -936,33 +944,11 @@ void SidePanel::PlanetPanel::CompleteConstruction() {
 
     SetBrowseModeTime(GetOptionsDB().Get<int>("ui.tooltip.delay"));
 
-    // create planet name text
-
-    // apply formatting tags around planet name to indicate:
-    //    Bold for capital(s)
-    bool capital = false;
-
-    // need to check all empires for capitals
-    for (const auto& entry : Empires()) {
-        const auto& empire = entry.second;
-        if (!empire) {
-            ErrorLogger() << "PlanetPanel::PlanetPanel got null empire pointer for id " << entry.first;
-            continue;
-        }
-        if (empire->CapitalID() == m_planet_id) {
-            capital = true;
-            break;
-        }
-    }
-
-    // determine font based on whether planet is a capital...
-    auto font{capital ? ClientUI::GetBoldFont(ClientUI::Pts()*4/3) : ClientUI::GetFont(ClientUI::Pts()*4/3)};
-
     GG::X panel_width = Width() - MaxPlanetDiameter() - 2*EDGE_PAD;
 
-    // create planet name control
+    // create planet name control.  its font is set in Refresh
     m_planet_name = GG::Wnd::Create<GG::TextControl>(
-        GG::X0, GG::Y0, GG::X1, GG::Y1, " ", font, ClientUI::TextColor());
+        GG::X0, GG::Y0, GG::X1, GG::Y1, " ", ClientUI::GetFont(ClientUI::Pts()*4/3), ClientUI::TextColor());
     m_planet_name->MoveTo(GG::Pt(GG::X(MaxPlanetDiameter() + EDGE_PAD), GG::Y0));
     m_planet_name->Resize(m_planet_name->MinUsableSize());
     AttachChild(m_planet_name);
@@ -1537,6 +1523,27 @@ void SidePanel::PlanetPanel::Refresh() {
 
     // set planet name, formatted to indicate presense of shipyards / homeworlds
 
+    // apply formatting tags around planet name to indicate:
+    //    Bold for capital(s)
+    bool capital = false;
+
+    // need to check all empires for capitals
+    for (const auto& entry : Empires()) {
+        const auto& empire = entry.second;
+        if (!empire) {
+            ErrorLogger() << "PlanetPanel::Refresh got null empire pointer for id " << entry.first;
+            continue;
+        }
+        if (empire->CapitalID() == m_planet_id) {
+            capital = true;
+            break;
+        }
+    }
+
+    // determine font based on whether planet is a capital...
+    m_planet_name->SetFont(capital ? ClientUI::GetBoldFont(ClientUI::Pts()*4/3) :
+                                     ClientUI::GetFont(ClientUI::Pts()*4/3));
+
     // apply formatting tags around planet name to indicate:
     //    Italic for homeworlds
     //    Underline for shipyard(s), and
@@ -2574,7 +2581,11 @@ void SidePanel::PlanetPanelContainer::Clear() {
 void SidePanel::PlanetPanelContainer::SetPlanets(const std::vector<int>& planet_ids, StarType star_type) {
     int initial_selected_planet_panel = m_selected_planet_id;
 
-    // remove old panels
+    // keep old panels that can show the same planets, and remove the rest
+    std::map<int, std::shared_ptr<PlanetPanel>> old_panels;
+    for (auto& panel : m_planet_panels)
+        if (panel->HasControls() && panel->GetStarType() == star_type)
+            old_panels.emplace(panel->PlanetID(), std::move(panel));
     Clear();
 
     std::multimap<int, int> orbits_planets;
@@ -2590,8 +2601,16 @@ void SidePanel::PlanetPanelContainer::SetPlanets(const std::vector<int>& planet_
         orbits_planets.insert({system->OrbitOfPlanet(planet->ID()), planet->ID()});
     }
 
-    // create new panels and connect their signals
+    // reattach kept panels and create new panels and connect their signals
     for (auto& orbit_planet : orbits_planets) {
+        if (auto old_it = old_panels.find(orbit_planet.second); old_it != old_panels.end()) {
+            old_it->second->Select(false);
+            AttachChild(old_it->second);
+            m_planet_panels.push_back(std::move(old_it->second));
+            old_panels.erase(old_it);
+            continue;
+        }
+
         auto planet_panel = GG::Wnd::Create<PlanetPanel>(Width() - m_vscroll->Width(),
                                                          orbit_planet.second, star_type);
         AttachChild(planet_panel);
@@ -3262,8 +3281,8 @@ void SidePanel::RefreshImpl() {
     ScopedTimer sidepanel_refresh_impl_timer("SidePanel::RefreshImpl", true);
     Sound::TempUISoundDisabler sound_disabler;
 
-    // clear out current contents
-    m_planet_panel_container->Clear();
+    // clear out current contents, except for the planet panels, which are
+    // kept for planets that are still in the system
     m_star_type_text->SetText("");
     DetachChildAndReset(m_star_graphic);
     DetachChildAndReset(m_system_resource_summary);
@@ -3273,8 +3292,10 @@ void SidePanel::RefreshImpl() {
 
     auto system = Objects().get<System>(s_system_id).get();
     // if no system object, there is nothing to populate with.  early abort.
-    if (!system)
+    if (!system) {
+        m_planet_panel_container->Clear();
         return;
+    }
 
     // (re)create top right star graphic
     auto graphic = ClientUI::GetClientUI()->GetModuloTexture(
@@ -17,6 +17,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <iterator>
+#include <unordered_map>
 
 
 namespace {
@@ -365,11 +366,15 @@ namespace {
                 boost::bind(&SitRepRow::RClick, this, ph::_1, ph::_2));
         }
 
-        const SitRepEntry& GetSitRepEntry() const { return m_panel->GetSitRepEntry(); }
+        const SitRepEntry& GetSitRepEntry() const { return m_sitrep; }
+
+        /** Replaces the shown sitrep with \a sitrep, which should have the
+          * same text and icon, such as the same sitrep from another turn. */
+        void SetSitRepEntry(const SitRepEntry& sitrep) { m_sitrep = sitrep; }
 
     private:
         std::shared_ptr<SitRepDataPanel>    m_panel;
-        const SitRepEntry                   m_sitrep;
+        SitRepEntry                         m_sitrep;
     };
 }
 
@@ -769,6 +774,17 @@ void SitRepPanel::Update() {
 
     std::size_t first_visible_row = std::distance(m_sitreps_lb->begin(),
                                                   m_sitreps_lb->FirstRowShown());
+
+    // keep the rows being shown, to reuse those of sitreps that are shown
+    // again with the same text and icon, rather than laying them out anew
+    std::unordered_multimap<std::string, std::shared_ptr<SitRepRow>> old_rows;
+    for (auto& row : *m_sitreps_lb) {
+        if (auto sitrep_row = std::dynamic_pointer_cast<SitRepRow>(row)) {
+            const SitRepEntry& sitrep = sitrep_row->GetSitRepEntry();
+            old_rows.emplace(sitrep.GetIcon() + sitrep.GetText(), std::move(sitrep_row));
+        }
+    }
+
     m_sitreps_lb->Clear();
     m_sitreps_lb->SetStyle(GG::LIST_NOSORT | GG::LIST_NOSEL);
     m_sitreps_lb->SetVScrollWheelIncrement(ClientUI::Pts()*4.5);
@@ -813,16 +829,25 @@ void SitRepPanel::Update() {
 
     // create UI rows for all sitrps
     GG::X width = m_sitreps_lb->ClientWidth();
+    auto insert_row = [this, width, &old_rows](const SitRepEntry& sitrep) {
+        auto old_row_it = old_rows.find(sitrep.GetIcon() + sitrep.GetText());
+        if (old_row_it == old_rows.end()) {
+            m_sitreps_lb->Insert(GG::Wnd::Create<SitRepRow>(width, GG::Y(ClientUI::Pts()*2), sitrep));
+            return;
+        }
+        auto row = std::move(old_row_it->second);
+        old_rows.erase(old_row_it);
+        row->SetSitRepEntry(sitrep);
+        if (row->Width() != width)
+            row->Resize(GG::Pt(width, row->Height()));
+        m_sitreps_lb->Insert(std::move(row));
+    };
     // first the ordered sitreps
-    for (const SitRepEntry& sitrep : ordered_sitreps) {
-        m_sitreps_lb->Insert(GG::Wnd::Create<SitRepRow>(width, GG::Y(ClientUI::Pts()*2),
-                                                        std::move(sitrep)));
-    }
+    for (const SitRepEntry& sitrep : ordered_sitreps)
+        insert_row(sitrep);
     // then the remaining unordered sitreps
-    for (SitRepEntry& sitrep : current_turn_sitreps) {
-        m_sitreps_lb->Insert(GG::Wnd::Create<SitRepRow>(width, GG::Y(ClientUI::Pts()*2),
-                                                        std::move(sitrep)));
-    }
+    for (const SitRepEntry& sitrep : current_turn_sitreps)
+        insert_row(sitrep);
 
 
     if (m_sitreps_lb->NumRows() > first_visible_row) {
@@ -84,22 +84,27 @@ void SpecialsPanel::Update() {
 
         graphic->SetBrowseModeTime(GetOptionsDB().Get<int>("ui.tooltip.delay"));
 
-        std::string desc = special->Description();
+        // the description, with a dump of the effects, is only made if the
+        // tooltip is shown
+        auto desc = [special, added_turn{entry.second.first}, capacity{entry.second.second}]() {
+            std::string desc = special->Description();
 
-        if (entry.second.second > 0.0f)
-            desc += "\n" + boost::io::str(FlexibleFormat(UserString("SPECIAL_CAPACITY")) % DoubleToString(entry.second.second, 2, false));
+            if (capacity > 0.0f)
+                desc += "\n" + boost::io::str(FlexibleFormat(UserString("SPECIAL_CAPACITY")) % DoubleToString(capacity, 2, false));
 
-        if (entry.second.first > 0)
-            desc += "\n" + boost::io::str(FlexibleFormat(UserString("ADDED_ON_TURN")) % entry.second.first);
-        else
-            desc += "\n" + UserString("ADDED_ON_INITIAL_TURN");
+            if (added_turn > 0)
+                desc += "\n" + boost::io::str(FlexibleFormat(UserString("ADDED_ON_TURN")) % added_turn);
+            else
+                desc += "\n" + UserString("ADDED_ON_INITIAL_TURN");
 
-        if (GetOptionsDB().Get<bool>("resource.effects.description.shown") && !special->Effects().empty()) {
-            desc += "\n" + Dump(special->Effects());
-        }
+            if (GetOptionsDB().Get<bool>("resource.effects.description.shown") && !special->Effects().empty()) {
+                desc += "\n" + Dump(special->Effects());
+            }
+            return desc;
+        };
 
         graphic->SetBrowseInfoWnd(GG::Wnd::Create<IconTextBrowseWnd>(
-            ClientUI::SpecialIcon(special->Name()), UserString(special->Name()), desc));
+            ClientUI::SpecialIcon(special->Name()), UserString(special->Name()), std::move(desc)));
         m_icons[entry.first] = graphic;
 
         auto special_name = entry.first;
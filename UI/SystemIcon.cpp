@@ -246,8 +246,10 @@ void SystemIcon::CompleteConstruction() {
     GG::Control::CompleteConstruction();
 
     ClientUI* ui = ClientUI::GetClientUI();
+    m_star_type = StarType::INVALID_STAR_TYPE;
     if (auto system = Objects().get<System>(m_system_id)) {
         StarType star_type = system->GetStarType();
+        m_star_type = star_type;
         m_disc_texture = ui->GetModuloTexture(ClientUI::ArtDir() / "stars",
                                               ClientUI::StarTypeFilePrefixes()[star_type],
                                               m_system_id);
@@ -325,6 +327,9 @@ const std::shared_ptr<GG::Texture>& SystemIcon::HaloTexture() const
 const std::shared_ptr<GG::Texture>& SystemIcon::TinyTexture() const
 { return m_tiny_texture; }
 
+StarType SystemIcon::IconStarType() const
+{ return m_star_type; }
+
 GG::Pt SystemIcon::NthFleetButtonUpperLeft(unsigned int button_number, bool moving) const {
     if (button_number < 1) {
         ErrorLogger() << "SystemIcon::NthFleetButtonUpperLeft passed button number less than 1... treating as if = 1";
@@ -439,8 +444,7 @@ void SystemIcon::SizeMove(const GG::Pt& ul, const GG::Pt& lr) {
     // tiny graphic?
     if (m_tiny_graphic && USE_TINY_GRAPHICS) {
         const GG::SubTexture& tiny_texture = m_tiny_graphic->GetTexture();
-        const GG::Texture* tiny_texture2 = tiny_texture.GetTexture();
-        GG::Pt tiny_size = GG::Pt(tiny_texture2->DefaultWidth(), tiny_texture2->DefaultHeight());
+        GG::Pt tiny_size = GG::Pt(tiny_texture.Width(), tiny_texture.Height());
         GG::Pt tiny_ul(static_cast<GG::X>(middle.x - tiny_size.x / 2.0),
                        static_cast<GG::Y>(middle.y - tiny_size.y / 2.0));
         m_tiny_graphic->SizeMove(tiny_ul, tiny_ul + tiny_size);
@@ -454,8 +458,7 @@ void SystemIcon::SizeMove(const GG::Pt& ul, const GG::Pt& lr) {
     // tiny selection indicator
     if (m_selected && m_tiny_selection_indicator && USE_TINY_GRAPHICS) {
         const GG::SubTexture& tiny_texture = m_tiny_selection_indicator->GetTexture();
-        const GG::Texture* tiny_texture2 = tiny_texture.GetTexture();
-        GG::Pt tiny_sel_ind_size = GG::Pt(tiny_texture2->DefaultWidth(), tiny_texture2->DefaultHeight());
+        GG::Pt tiny_sel_ind_size = GG::Pt(tiny_texture.Width(), tiny_texture.Height());
         GG::Pt tiny_sel_ind_ul(static_cast<GG::X>(middle.x - tiny_sel_ind_size.x / 2.0),
                                static_cast<GG::Y>(middle.y - tiny_sel_ind_size.y / 2.0));
         m_tiny_selection_indicator->SizeMove(tiny_sel_ind_ul, tiny_sel_ind_ul + tiny_sel_ind_size);
@@ -684,6 +687,13 @@ void SystemIcon::Refresh() {
         m_overlay_size = system->OverlaySize();
 }
 
+void SystemIcon::ResetNames() {
+    for (auto& pts_name_ptr : m_colored_names)
+        DetachChild(pts_name_ptr.second);
+    m_colored_names.clear();
+    Refresh();
+}
+
 void SystemIcon::ShowName() {
     m_showing_name = true;
 
@@ -734,3 +744,11 @@ bool SystemIcon::InWindow(const GG::Pt& pt) const {
 
     return distx*distx + disty*disty <= RADIUS2;
 }
+
+GG::Rect SystemIcon::PickBounds() const {
+    const int RADIUS = EnclosingCircleDiameter() / 2;
+    GG::Pt ul = UpperLeft(), lr = LowerRight();
+    GG::Pt middle = ul + GG::Pt((lr.x - ul.x) / 2, (lr.y - ul.y) / 2);
+    GG::Pt radius{GG::X(RADIUS), GG::Y(RADIUS)};
+    return GG::Rect(middle - radius, middle + radius + GG::Pt(GG::X1, GG::Y1));
+}
@@ -3,6 +3,7 @@
 
 #include <GG/GGFwd.h>
 #include <GG/Control.h>
+#include "../universe/EnumsFwd.h"
 
 #include <boost/signals2/signal.hpp>
 
@@ -50,6 +51,9 @@ public:
         checking parent InWindow method. */
     bool InWindow(const GG::Pt& pt) const override;
 
+    /** Returns the square enclosing the circle that InWindow checks. */
+    GG::Rect PickBounds() const override;
+
     int             SystemID() const;                           //!< returns ID of system this icon represents
 
     /** Returns the solid star disc texture. */
@@ -61,6 +65,9 @@ public:
     /** Returns the alternate texture shown when icon very small. */
     const std::shared_ptr<GG::Texture>& TinyTexture() const;
 
+    /** Returns the star type that the textures of this icon were chosen for. */
+    StarType        IconStarType() const;
+
     GG::Pt          NthFleetButtonUpperLeft(unsigned int button_number, bool moving) const; //!< returns upper left point of moving or stationary fleetbutton number \a button_number
     int             EnclosingCircleDiameter() const;        //!< returns diameter of circle enclosing icon around which other icons can be placed and within which the mouse is over the icon
 
@@ -89,6 +96,7 @@ public:
     void            SetSelected(bool selected = true);   //!< shows/hides the system selection indicator over this system
 
     void            Refresh();                      //!< Resets system name text and calls RefreshFleetButtons().  Should be called after an icon is attached to the map
+    void            ResetNames();                   //!< Discards the system name controls, which show planet ownership and the like, and refreshes so that they are recreated from the current known state of the system
 
     void            ShowName();                     //!< enables the system name text
     void            HideName();                     //!< disables the system name text
@@ -109,6 +117,7 @@ private:
     std::shared_ptr<GG::Texture> m_overlay_texture; //!< Extra texture drawn over / behind system
 
     int                                 m_system_id = -1;                   //!< the System associated with this SystemIcon
+    StarType                            m_star_type;                        //!< the star type of the System when the textures were chosen
     double                              m_overlay_size = 1.0;               //!< size of extra texture in universe units
     std::shared_ptr<GG::StaticGraphic>  m_tiny_graphic;                     //!< non-scaled texture shown when zoomed far enough out;
     std::shared_ptr<RotatingGraphic>    m_selection_indicator;              //!< shown to indicate system is selected in sidepanel
@@ -78,6 +78,7 @@ public:
 
     // Fill m_highlight_buffer with the lines that should be highlighted
     void RefreshHighlights() {
+        m_highlight_buffer.clear();
         std::set<std::string> highlights;
 
         // We highlight lines that lead to techs that are queued for research
@@ -165,3 +166,8 @@ void TechTreeArcs::Reset() {
 void TechTreeArcs::Reset(const TechTreeLayout& layout, const std::set< std::string >& techs_to_show) {
     m_impl.reset(new Impl(layout, techs_to_show));
 }
+
+void TechTreeArcs::RefreshHighlights() {
+    if (m_impl)
+        m_impl->RefreshHighlights();
+}
@@ -27,6 +27,8 @@ public:
     void Reset();
     /// Recalculates the arcs
     void Reset(const TechTreeLayout& layout, const std::set<std::string>& techs_to_show);
+    /// Recalculates which arcs are highlighted, keeping the others
+    void RefreshHighlights();
 
 private:
     class Impl;
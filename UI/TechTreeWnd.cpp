@@ -93,6 +93,8 @@ namespace {
 
     constexpr double PI = 3.1415926535897932384626433;
 
+    constexpr std::size_t MAX_CACHED_TECH_TREE_LAYOUTS = 16;
+
     bool TechVisible(const std::string& tech_name,
                      const std::set<std::string>& categories_shown,
                      const std::set<TechStatus>& statuses_shown)
@@ -528,6 +530,7 @@ public:
 
     void Update();  ///< update indicated \a tech panel or all panels if \a tech_name is an empty string, without redoing layout
     void Clear();                               ///< remove all tech panels
+    void ClearCache();                          ///< forget cached layouts and tech panels
     void Reset();                               ///< redo layout, recentre on a tech
     void SetScale(double scale);
     void ShowCategory(const std::string& category);
@@ -592,10 +595,22 @@ private:
     std::set<TechStatus>    m_tech_statuses_shown;
     std::string             m_selected_tech_name;
     std::string             m_browsed_tech_name;
-    TechTreeLayout          m_graph;
+    std::shared_ptr<TechTreeLayout> m_graph;
 
     std::map<std::string, std::shared_ptr<TechPanel>> m_techs;
-    TechTreeArcs                    m_dependency_arcs;
+    std::shared_ptr<TechTreeArcs>   m_dependency_arcs;
+
+    /** A computed layout of the techs shown, and its arcs. */
+    struct CachedLayout {
+        std::shared_ptr<TechTreeLayout> graph;
+        std::shared_ptr<TechTreeArcs>   arcs;
+    };
+
+    /** Layouts by the spacing and the names of the techs shown, so that
+      * changing back to earlier filters, or updating the tree without
+      * changing which techs are shown, doesn't redo the layout. */
+    std::map<std::string, CachedLayout>                 m_cached_layouts;
+    std::map<std::string, std::shared_ptr<TechPanel>>  m_cached_techs;  ///< panels of all techs shown so far, by name
 
     std::shared_ptr<LayoutSurface>  m_layout_surface;
     std::shared_ptr<GG::Scroll>     m_vscroll;
@@ -1158,7 +1173,8 @@ void TechTreeWnd::LayoutPanel::Render() {
     // render dependency arcs
     DoZoom(ClientUpperLeft());
 
-    m_dependency_arcs.Render(m_scale);
+    if (m_dependency_arcs)
+        m_dependency_arcs->Render(m_scale);
 
     EndClipping();
 
@@ -1207,17 +1223,22 @@ void TechTreeWnd::LayoutPanel::Clear() {
     GG::SignalScroll(*m_vscroll, true);
     GG::SignalScroll(*m_hscroll, true);
 
-    // delete all panels
+    // detach all panels; they are kept in m_cached_techs for reuse
     for (const auto& tech_panel: m_techs)
         m_layout_surface->DetachChild(tech_panel.second);
     m_techs.clear();
-    m_graph.Clear();
+    m_graph.reset();
 
-    m_dependency_arcs.Reset();
+    m_dependency_arcs.reset();
 
     m_selected_tech_name.clear();
 }
 
+void TechTreeWnd::LayoutPanel::ClearCache() {
+    m_cached_layouts.clear();
+    m_cached_techs.clear();
+}
+
 void TechTreeWnd::LayoutPanel::Reset() {
     // regenerate graph of panels and dependency lines
     Layout(false);
@@ -1356,62 +1377,85 @@ void TechTreeWnd::LayoutPanel::Layout(bool keep_position) {
 
     DebugLogger() << "Tech Tree Layout Preparing Tech Data";
 
-    // create a node for every tech
+    // find the shown techs, reusing the panels of techs shown before
     TechManager& manager = GetTechManager();
+    std::vector<const Tech*> shown_techs;
+    std::set<std::string> visible_techs;
+    std::string layout_key = std::to_string(WIDTH) + " " + std::to_string(HEIGHT) + " " +
+                             std::to_string(RANK_SEP) + " " + std::to_string(NODE_SEP) + "\n";
+    const GG::Pt tech_panel_size(TechPanelWidth(), TechPanelHeight());
     for (const auto& tech : manager) {
         if (!tech) continue;
         const std::string& tech_name = tech->Name();
         if (!TechVisible(tech_name, m_categories_shown, m_tech_statuses_shown)) continue;
-        m_techs[tech_name] = GG::Wnd::Create<TechPanel>(tech_name, this);
-        m_graph.AddNode(tech_name, m_techs[tech_name]->Width(), m_techs[tech_name]->Height());
-    }
 
-    // create an edge for every prerequisite
-    for (const auto& tech : manager) {
-        if (!tech) continue;
-        const std::string& tech_name = tech->Name();
-        if (!TechVisible(tech_name, m_categories_shown, m_tech_statuses_shown)) continue;
-        for (const std::string& prereq : tech->Prerequisites()) {
-            if (!TechVisible(prereq, m_categories_shown, m_tech_statuses_shown)) continue;
-            m_graph.AddEdge(prereq, tech_name);
+        auto& tech_panel = m_cached_techs[tech_name];
+        if (!tech_panel || tech_panel->Size() != tech_panel_size) {
+            tech_panel = GG::Wnd::Create<TechPanel>(tech_name, this);
+            tech_panel->TechLeftClickedSignal.connect(
+                boost::bind(&TechTreeWnd::LayoutPanel::SelectTech, this, boost::placeholders::_1));
+            tech_panel->TechDoubleClickedSignal.connect(TechDoubleClickedSignal);
+            tech_panel->TechPediaDisplaySignal.connect(TechPediaDisplaySignal);
+        } else {
+            tech_panel->Update();
         }
+        m_techs[tech_name] = tech_panel;
+
+        shown_techs.push_back(tech.get());
+        visible_techs.insert(tech_name);
+        layout_key.append(tech_name).push_back('\n');
     }
 
-    DebugLogger() << "Tech Tree Layout Doing Graph Layout";
+    auto cached_it = m_cached_layouts.find(layout_key);
+    if (cached_it == m_cached_layouts.end()) {
+        if (m_cached_layouts.size() >= MAX_CACHED_TECH_TREE_LAYOUTS)
+            m_cached_layouts.clear();
 
-    //calculate layout
-    m_graph.DoLayout(static_cast<int>(WIDTH + RANK_SEP),
-                     static_cast<int>(HEIGHT + NODE_SEP),
-                     static_cast<int>(X_MARGIN));
+        auto graph = std::make_shared<TechTreeLayout>();
 
-    DebugLogger() << "Tech Tree Layout Creating Panels";
+        // create a node for every tech
+        for (const Tech* tech : shown_techs)
+            graph->AddNode(tech->Name(), tech_panel_size.x, tech_panel_size.y);
 
-    std::set<std::string> visible_techs;
+        // create an edge for every prerequisite
+        for (const Tech* tech : shown_techs) {
+            for (const std::string& prereq : tech->Prerequisites()) {
+                if (!visible_techs.count(prereq)) continue;
+                graph->AddEdge(prereq, tech->Name());
+            }
+        }
 
-    // create new tech panels and new dependency arcs 
-    for (const auto& tech : manager) {
-        if (!tech) continue;
-        const std::string& tech_name = tech->Name();
-        if (!TechVisible(tech_name, m_categories_shown, m_tech_statuses_shown)) continue;
-        //techpanel
-        const TechTreeLayout::Node* node = m_graph.GetNode(tech_name);
-        //move TechPanel
-        auto& tech_panel = m_techs[tech_name];
-        tech_panel->MoveTo(GG::Pt(node->GetX(), node->GetY()));
-        m_layout_surface->AttachChild(tech_panel);
-        tech_panel->TechLeftClickedSignal.connect(
-            boost::bind(&TechTreeWnd::LayoutPanel::SelectTech, this, boost::placeholders::_1));
-        tech_panel->TechDoubleClickedSignal.connect(TechDoubleClickedSignal);
-        tech_panel->TechPediaDisplaySignal.connect(TechPediaDisplaySignal);
+        DebugLogger() << "Tech Tree Layout Doing Graph Layout";
 
-        visible_techs.insert(tech_name);
+        //calculate layout
+        graph->DoLayout(static_cast<int>(WIDTH + RANK_SEP),
+                        static_cast<int>(HEIGHT + NODE_SEP),
+                        static_cast<int>(X_MARGIN));
+
+        auto arcs = std::make_shared<TechTreeArcs>(*graph, visible_techs);
+        cached_it = m_cached_layouts.emplace(std::move(layout_key),
+                                             CachedLayout{std::move(graph), std::move(arcs)}).first;
+    } else {
+        DebugLogger() << "Tech Tree Layout Reusing Graph Layout";
+        // which arcs lead to queued techs may have changed
+        cached_it->second.arcs->RefreshHighlights();
     }
+    m_graph = cached_it->second.graph;
+    m_dependency_arcs = cached_it->second.arcs;
 
-    m_dependency_arcs.Reset(m_graph, visible_techs);
+    DebugLogger() << "Tech Tree Layout Placing Panels";
+
+    // move tech panels to their places in the layout
+    for (const Tech* tech : shown_techs) {
+        const TechTreeLayout::Node* node = m_graph->GetNode(tech->Name());
+        auto& tech_panel = m_techs[tech->Name()];
+        tech_panel->MoveTo(GG::Pt(node->GetX(), node->GetY()));
+        m_layout_surface->AttachChild(tech_panel);
+    }
 
     // format window
     GG::Pt client_sz = ClientSize();
-    GG::Pt layout_size(client_sz.x + m_graph.GetWidth(), client_sz.y + m_graph.GetHeight());
+    GG::Pt layout_size(client_sz.x + m_graph->GetWidth(), client_sz.y + m_graph->GetHeight());
     m_layout_surface->Resize(layout_size);
     // format scrollbar
     m_vscroll->SizeScroll(0, Value(layout_size.y - 1), std::max(50, Value(std::min(layout_size.y / 10, client_sz.y))), Value(client_sz.y));
@@ -2119,6 +2163,7 @@ void TechTreeWnd::Update() {
 void TechTreeWnd::Clear() {
     m_enc_detail_panel->OnIndex();
     m_layout_panel->Clear();
+    m_layout_panel->ClearCache();
 }
 
 void TechTreeWnd::Reset() {
@@ -10,9 +10,11 @@
 #include "../../util/AppInterface.h"
 #include "../../network/Message.h"
 #include "../../util/Random.h"
+#include "../../util/ScopedTimer.h"
 #include "../../util/Version.h"
 
 
+#include "../../universe/Pathfinder.h"
 #include "../../universe/System.h"
 #include "../../universe/Species.h"
 #include "../../universe/Universe.h"
@@ -100,9 +102,12 @@ AIClientApp::AIClientApp(const std::vector<std::string>& args) :
     if (!force_log_level.empty())
         OverrideAllLoggersThresholds(to_LogLevel(force_log_level));
 
-    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "AI");
+    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "AI",
+                      GetOptionsDB().Get<bool>("log-async"));
     InitLoggingOptionsDBSystem();
 
+    SetPathfinderCaller(PathfinderCaller::PATHFINDER_CALLER_AI);
+
     InfoLogger() << FreeOrionVersionString();
     DebugLogger() << PlayerName() + " ai client initialized.";
 }
@@ -132,6 +137,11 @@ const PythonAI* AIClientApp::GetAI()
 void AIClientApp::Run() {
     ConnectToServer();
 
+    // Start parsing content before starting the Python AI, so that parsing
+    // overlaps starting the interpreter and importing the AI package.
+    // Content is only used after joining, and waits for parsing if needed.
+    StartBackgroundParsing();
+
     try {
         StartPythonAI();
 
@@ -140,8 +150,7 @@ void AIClientApp::Run() {
                                                  Networking::ClientType::CLIENT_TYPE_AI_PLAYER,
                                                  boost::uuids::nil_uuid()));
 
-        // Start parsing content
-        StartBackgroundParsing();
+        FinishStartupTrace("AI client ready", FilenameToPath(GetOptionsDB().Get<std::string>("startup-trace.path")));
 
         // respond to messages until disconnected
         while (1) {
@@ -333,7 +342,8 @@ void AIClientApp::HandleMessage(const Message& msg) {
         //DebugLogger() << "AIClientApp::HandleMessage : extracting turn update message data";
         ExtractTurnUpdateMessageData(msg,                     m_empire_id,        m_current_turn,
                                      m_empires,               m_universe,         GetSpeciesManager(),
-                                     GetCombatLogManager(),   GetSupplyManager(), m_player_info);
+                                     GetCombatLogManager(),   GetSupplyManager(), m_player_info,
+                                     m_turn_update_delta_base);
         //DebugLogger() << "AIClientApp::HandleMessage : generating orders";
         m_universe.InitializeSystemGraph(m_empires, m_universe.Objects());
         m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithMainObjectMap(m_empires);
@@ -343,7 +353,7 @@ void AIClientApp::HandleMessage(const Message& msg) {
     }
 
     case Message::MessageType::TURN_PARTIAL_UPDATE:
-        ExtractTurnPartialUpdateMessageData(msg, m_empire_id, m_universe);
+        ExtractTurnPartialUpdateMessageData(msg, m_empire_id, m_universe, m_turn_update_delta_base);
         break;
 
     case Message::MessageType::TURN_PROGRESS: {
@@ -2,6 +2,8 @@
 
 #include "AIClientApp.h"
 #include "AIWrapper.h"
+#include "../ClientNetworking.h"
+#include "../../network/Message.h"
 #include "../../universe/BuildingType.h"
 #include "../../universe/Universe.h"
 #include "../../util/Directories.h"
@@ -75,6 +77,7 @@ BOOST_PYTHON_MODULE(freeOrionAIInterface)
 
     FreeOrionPython::SetWrapper<int>::Wrap("IntSet");
     FreeOrionPython::SetWrapper<std::string>::Wrap("StringSet");
+    FreeOrionPython::SetWrapper<int, ObjectIDBitmap>::Wrap("ObjectIDBitmap");
 }
 
 //////////////////////
@@ -85,6 +88,8 @@ auto PythonAI::Initialize() -> bool
     if (PythonBase::Initialize()) {
         BuildingTypeManager& temp = GetBuildingTypeManager();  // Ensure buildings are initialized
         (void)temp; // Hide unused variable warning
+        // AIWrapper invalidates the cache whenever the AI changes its empire
+        FreeOrionPython::EnableEmpireQueryCache(true);
         return true;
     }
     else
@@ -124,6 +129,8 @@ void PythonAI::GenerateOrders()
     DebugLogger() << "PythonAI::GenerateOrders : initializing turn";
 
     ScopedTimer order_timer;
+    FreeOrionPython::InvalidateEmpireQueries();
+    FreeOrionPython::BeginTurnBudget(GetOptionsDB().Get<double>("ai.turn.budget"));
     try {
         // call Python function that generates orders for current turn
         //DebugLogger() << "PythonAI::GenerateOrders : getting generate orders object";
@@ -131,14 +138,25 @@ void PythonAI::GenerateOrders()
         //DebugLogger() << "PythonAI::GenerateOrders : generating orders";
         generateOrdersPythonFunction();
     } catch (const py::error_already_set& err) {
-        HandleErrorAlreadySet();
-        if (!IsPythonRunning() || GetOptionsDB().Get<bool>("testing"))
-            throw;
-
-        ErrorLogger() << "PythonAI::GenerateOrders : Python error caught.  Partial orders sent to server";
+        if (FreeOrionPython::ClearTurnBudgetExceededError()) {
+            WarnLogger() << "PythonAI::GenerateOrders : turn budget exceeded.  Partial orders sent to server";
+        } else {
+            HandleErrorAlreadySet();
+            if (!IsPythonRunning() || GetOptionsDB().Get<bool>("testing")) {
+                FreeOrionPython::EndTurnBudget();
+                throw;
+            }
+
+            ErrorLogger() << "PythonAI::GenerateOrders : Python error caught.  Partial orders sent to server";
+        }
     }
 
     AIClientApp* app = AIClientApp::GetApp();
+    // report where the time went, ahead of the orders so that it arrives before turn processing starts
+    auto timings = FreeOrionPython::EndTurnBudget();
+    DebugLogger() << "PythonAI::GenerateOrders timings: " << timings;
+    app->Networking().SendMessage(AITurnTimingsMessage(timings));
+
     // encodes order sets and sends turn orders message.  "done" the turn for the client, but "starts" the turn for the server
     app->StartTurn(app->GetAI()->GetSaveStateString());
 
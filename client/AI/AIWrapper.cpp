@@ -2,7 +2,9 @@
 
 #include "AIClientApp.h"
 #include "../ClientNetworking.h"
+#include "../../combat/CombatSystem.h"
 #include "../../universe/Fleet.h"
+#include "../../universe/Pathfinder.h"
 #include "../../universe/Planet.h"
 #include "../../universe/ShipDesign.h"
 #include "../../universe/Tech.h"
@@ -19,6 +21,7 @@
 #include "../../Empire/Diplomacy.h"
 #include "../../Empire/Government.h"
 #include "../../python/SetWrapper.h"
+#include "../../python/CommonFramework.h"
 #include "../../python/CommonWrappers.h"
 
 #include <boost/python.hpp>
@@ -29,6 +32,18 @@
 #include <boost/python/extract.hpp>
 #include <boost/python/scope.hpp>
 #include <boost/uuid/random_generator.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 namespace py = boost::python;
 
@@ -40,6 +55,183 @@ namespace {
     // static string to save AI state
     static std::string s_save_state_string("");
 
+    // Python exception type raised in generateOrders when the turn budget is
+    // spent.  Derived from BaseException so that AI code catching Exception
+    // doesn't carry on regardless.  Never released, as it must outlive any
+    // static cleanup after the interpreter is finalized.
+    PyObject* s_turn_budget_exceeded = nullptr;
+
+    /** Wall-clock budget for, and timings of, one call of the Python AI's
+        generateOrders.  While it is active, a watchdog thread asks the
+        Python thread every SAMPLE_INTERVAL, via Py_AddPendingCall, to record
+        which Python function it is in, and to raise TurnBudgetExceeded once
+        the budget is spent.  Everything but the watchdog runs on the Python
+        thread while holding the GIL. */
+    class TurnBudget {
+    public:
+        using clock = std::chrono::steady_clock;
+        static constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(10);
+        static constexpr std::size_t REPORTED_HOTSPOTS = 5;
+
+        ~TurnBudget()
+        { StopWatchdog(); }
+
+        /** Starts timing a turn, with \p budget_seconds of wall-clock time,
+            or no limit if it is not positive. */
+        void Begin(double budget_seconds) {
+            End();
+            m_start = clock::now();
+            m_last_sample = m_start;
+            m_budget = std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<double>(std::max(0.0, budget_seconds)));
+            m_raised = false;
+            m_phase.clear();
+            m_phase_times.clear();
+            m_hotspots.clear();
+            m_active = true;
+            m_sample_pending = false;
+            m_watchdog = std::thread([this]() { Watch(); });
+        }
+
+        /** Stops timing the turn and returns a one-line summary of where
+            its time went. */
+        std::string End() {
+            if (!m_active)
+                return "";
+            StopWatchdog();
+            EndPhase(clock::now());
+
+            std::vector<std::pair<std::string, clock::duration>> hotspots{m_hotspots.begin(), m_hotspots.end()};
+            std::sort(hotspots.begin(), hotspots.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+            if (hotspots.size() > REPORTED_HOTSPOTS)
+                hotspots.resize(REPORTED_HOTSPOTS);
+
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << "turn " << CurrentTurn() << ": " << Seconds(m_phase_end - m_start) << " s";
+            if (m_budget > clock::duration::zero())
+                ss << " of " << Seconds(m_budget) << " s budget" << (m_raised ? " (exceeded)" : "");
+            ss << "; phases:";
+            for (auto& [phase, time] : m_phase_times)
+                ss << " " << phase << " " << Seconds(time) << " s";
+            ss << "; sampled hotspots:";
+            for (auto& [location, time] : hotspots)
+                ss << " " << location << " " << Seconds(time) << " s";
+            return ss.str();
+        }
+
+        /** Ends the current phase of the turn, if any, and starts timing
+            one named \p name. */
+        void BeginPhase(std::string name) {
+            if (!m_active)
+                return;
+            EndPhase(clock::now());
+            m_phase = std::move(name);
+        }
+
+        /** Seconds left of the turn budget, or infinity if there is none. */
+        double Remaining() const {
+            if (!m_active || m_budget <= clock::duration::zero())
+                return std::numeric_limits<double>::infinity();
+            return std::max(0.0, Seconds(m_budget - (clock::now() - m_start)));
+        }
+
+        bool Exceeded() const
+        { return m_active && m_budget > clock::duration::zero() && clock::now() - m_start > m_budget; }
+
+        bool Raised() const
+        { return m_raised; }
+
+    private:
+        static double Seconds(clock::duration duration)
+        { return std::chrono::duration<double>(duration).count(); }
+
+        void StopWatchdog() {
+            {
+                std::scoped_lock lock(m_mutex);
+                m_active = false;
+            }
+            m_stop.notify_all();
+            if (m_watchdog.joinable())
+                m_watchdog.join();
+        }
+
+        void EndPhase(clock::time_point now) {
+            auto phase_start = m_phase_times.empty() ? m_start : m_phase_end;
+            const auto& phase = m_phase.empty() ? UNNAMED_PHASE : m_phase;
+            auto it = std::find_if(m_phase_times.begin(), m_phase_times.end(),
+                                   [&phase](const auto& entry) { return entry.first == phase; });
+            if (it == m_phase_times.end())
+                m_phase_times.emplace_back(phase, now - phase_start);
+            else
+                it->second += now - phase_start;
+            m_phase_end = now;
+        }
+
+        /** Runs on the watchdog thread, posting one sample request at a time
+            so that requests don't pile up while Python is busy in C++. */
+        void Watch() {
+            std::unique_lock lock(m_mutex);
+            while (!m_stop.wait_for(lock, SAMPLE_INTERVAL, [this]() { return !m_active; })) {
+                if (!m_sample_pending.exchange(true))
+                    Py_AddPendingCall(&TurnBudget::Sample, this);
+            }
+        }
+
+        /** Pending call run by the Python thread.  Attributes the time since
+            the previous sample to the innermost Python frame, so time spent
+            in C++ is charged to the Python function that called it. */
+        static int Sample(void* arg) {
+            auto* budget = static_cast<TurnBudget*>(arg);
+            budget->m_sample_pending = false;
+            if (!budget->m_active)
+                return 0;
+
+            auto now = clock::now();
+            if (auto* frame = reinterpret_cast<PyObject*>(PyEval_GetFrame())) {
+                try {
+                    py::object code = py::object(py::handle<>(py::borrowed(frame))).attr("f_code");
+                    std::string filename = py::extract<std::string>(code.attr("co_filename"));
+                    std::string function = py::extract<std::string>(code.attr("co_name"));
+                    budget->m_hotspots[boost::filesystem::path(filename).stem().string() + ":" + function] +=
+                        now - budget->m_last_sample;
+                } catch (const py::error_already_set&) {
+                    PyErr_Clear();
+                }
+            }
+            budget->m_last_sample = now;
+
+            if (budget->m_raised || !budget->Exceeded())
+                return 0;
+            budget->m_raised = true;
+            PyErr_SetString(s_turn_budget_exceeded, "AI turn budget exceeded");
+            return -1;
+        }
+
+        inline static const std::string UNNAMED_PHASE = "unnamed";
+
+        clock::time_point                   m_start;
+        clock::time_point                   m_last_sample;
+        clock::time_point                   m_phase_end;
+        clock::duration                     m_budget = clock::duration::zero();
+        bool                                m_raised = false;
+        std::string                         m_phase;
+        std::vector<std::pair<std::string, clock::duration>> m_phase_times;  // in order of first use
+        std::map<std::string, clock::duration>              m_hotspots;     // "module:function" -> sampled time
+
+        std::atomic<bool>                   m_active = false;
+        std::atomic<bool>                   m_sample_pending = false;
+        std::mutex                          m_mutex;
+        std::condition_variable             m_stop;
+        std::thread                         m_watchdog;
+    };
+
+    TurnBudget& GetTurnBudget() {
+        static TurnBudget budget;
+        return budget;
+    }
+
     /** @brief Return the player name of the client identified by @a player_id
      *
      * @param player_id An client identifier.
@@ -127,6 +319,7 @@ namespace {
     }
 
     void InitMeterEstimatesAndDiscrepancies() {
+        GILReleasedForWriting gil_released;
         Universe& universe = GetUniverse();
         EmpireManager& empires = Empires();
         ScriptingContext context{universe, empires, GetGalaxySetupData(), GetSpeciesManager(), GetSupplyManager()};
@@ -142,6 +335,7 @@ namespace {
      *      estimated value for those planets.
      */
     void UpdateMeterEstimates(bool pretend_to_own_unowned_planets) {
+        GILReleasedForWriting gil_released;
         std::vector<std::shared_ptr<Planet>> unowned_planets;
         int player_id = -1;
         Universe& universe = AIClientApp::GetApp()->GetUniverse();
@@ -173,6 +367,7 @@ namespace {
         // update meter estimates with temporary ownership
         ScriptingContext context{universe, Empires(), GetGalaxySetupData(), GetSpeciesManager(), GetSupplyManager()};
         universe.UpdateMeterEstimates(context);
+        FreeOrionPython::InvalidateEmpireQueries();
 
         if (pretend_to_own_unowned_planets) {
             // remove temporary ownership added above
@@ -183,6 +378,7 @@ namespace {
     }
 
     void UpdateResourcePools() {
+        GILReleasedForWriting gil_released;
         int empire_id = AIClientApp::GetApp()->EmpireID();
         Empire* empire = ::GetEmpire(empire_id);
         if (!empire) {
@@ -190,9 +386,51 @@ namespace {
             return;
         }
         empire->UpdateResourcePools();
+        FreeOrionPython::InvalidateEmpireQueries();
+    }
+
+    /** Simulates the combat that would occur at the system with id
+      * \a system_id between the objects there that this client knows of. */
+    auto SimulateCombatAtSystem(int system_id, int num_simulations, unsigned int seed) -> CombatSimulationResults
+    {
+        GILReleasedForReading gil_released;
+        auto app = AIClientApp::GetApp();
+        if (!app->GetUniverse().Objects().get<System>(system_id)) {
+            ErrorLogger() << "SimulateCombatAtSystem : couldn't get system with id " << system_id;
+            return {};
+        }
+        const CombatInfo combat_info(system_id, app->CurrentTurn(), app->GetUniverse(), app->Empires(),
+                                     app->GetGalaxySetupData(), app->GetSpeciesManager(),
+                                     app->GetSupplyManager());
+        return SimulateCombat(combat_info, num_simulations, seed);
+    }
+
+    /** Returns a dict of the pathfinding queries made by this AI client so
+        far: counts and total milliseconds by kind of query and the hits and
+        misses of the jump distance cache. */
+    auto PathfinderStatisticsDict() -> py::dict
+    {
+        const auto stats = GetPathfinderStatistics();
+        const auto ms = [](std::uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+
+        py::dict queries;
+        for (std::size_t query = 0; query < stats.queries.size(); ++query) {
+            std::stringstream name;
+            name << static_cast<PathfinderQuery>(query);
+            queries[name.str()] = py::make_tuple(stats.queries[query].count, ms(stats.queries[query].nanoseconds));
+        }
+
+        py::dict retval;
+        retval["queries"] = queries;
+        retval["cacheHits"] = stats.cache_hits;
+        retval["cacheMisses"] = stats.cache_misses;
+        retval["rowsComputed"] = stats.rows_computed;
+        retval["rowsComputedMs"] = ms(stats.row_nanoseconds);
+        return retval;
     }
 
     void UpdateResearchQueue() {
+        GILReleasedForWriting gil_released;
         int empire_id = AIClientApp::GetApp()->EmpireID();
         Empire* empire = ::GetEmpire(empire_id);
         if (!empire) {
@@ -200,9 +438,11 @@ namespace {
             return;
         }
         empire->UpdateResearchQueue();
+        FreeOrionPython::InvalidateEmpireQueries();
     }
 
     void UpdateProductionQueue() {
+        GILReleasedForWriting gil_released;
         int empire_id = AIClientApp::GetApp()->EmpireID();
         Empire* empire = ::GetEmpire(empire_id);
         if (!empire) {
@@ -210,6 +450,7 @@ namespace {
             return;
         }
         empire->UpdateProductionQueue();
+        FreeOrionPython::InvalidateEmpireQueries();
     }
 
     auto GetUserStringList(const std::string& list_key) -> py::list
@@ -220,6 +461,13 @@ namespace {
         return ret_list;
     }
 
+    /** Issues \a order, and invalidates the cached empire queries that it may
+      * change. */
+    void IssueOrder(OrderPtr order) {
+        ClientApp::GetApp()->Orders().IssueOrder(std::move(order));
+        FreeOrionPython::InvalidateEmpireQueries();
+    }
+
     template<typename OrderType, typename... Args>
     auto Issue(Args &&... args) -> int
     {
@@ -228,7 +476,7 @@ namespace {
         if (!OrderType::Check(app->EmpireID(), std::forward<Args>(args)...))
             return 0;
 
-        app->Orders().IssueOrder(std::make_shared<OrderType>(app->EmpireID(), std::forward<Args>(args)...));
+        IssueOrder(std::make_shared<OrderType>(app->EmpireID(), std::forward<Args>(args)...));
 
         return 1;
     }
@@ -242,7 +490,7 @@ namespace {
 
         auto order = std::make_shared<NewFleetOrder>(app->EmpireID(), fleet_name, ship_ids,
                                                      FleetAggression::FLEET_OBSTRUCTIVE);
-        app->Orders().IssueOrder(order);
+        IssueOrder(order);
 
         return order->FleetID();
     }
@@ -263,7 +511,7 @@ namespace {
 
         int empire_id = AIClientApp::GetApp()->EmpireID();
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<ResearchQueueOrder>(empire_id, tech_name, position));
 
         return 1;
@@ -279,7 +527,7 @@ namespace {
 
         int empire_id = AIClientApp::GetApp()->EmpireID();
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<ResearchQueueOrder>(empire_id, tech_name));
 
         return 1;
@@ -311,7 +559,7 @@ namespace {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<PolicyOrder>(empire_id, policy_name, category, true, slot));
         return 1;
     }
@@ -330,7 +578,7 @@ namespace {
             return 0;
         }
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<PolicyOrder>(empire_id, policy_name, "", false));  // category and slot ignored for de-adtopting
         return 1;
 
@@ -357,7 +605,7 @@ namespace {
 
         auto item = ProductionQueue::ProductionItem(BuildType::BT_BUILDING, item_name);
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::PLACE_IN_QUEUE,
                                                    empire_id, item, 1, location_id));
 
@@ -380,7 +628,7 @@ namespace {
 
         auto item = ProductionQueue::ProductionItem(BuildType::BT_SHIP, design_id);
 
-        AIClientApp::GetApp()->Orders().IssueOrder(
+        IssueOrder(
             std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::PLACE_IN_QUEUE,
                                                    empire_id, item, 1, location_id));
 
@@ -409,7 +657,7 @@ namespace {
         auto queue_it = empire->GetProductionQueue().find(queue_index);
 
         if (queue_it != empire->GetProductionQueue().end())
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
                 std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::SET_QUANTITY_AND_BLOCK_SIZE,
                                                        empire_id, queue_it->uuid,
                                                        new_quantity, new_blocksize));
@@ -452,7 +700,7 @@ namespace {
         auto queue_it = empire->GetProductionQueue().find(old_queue_index);
 
         if (queue_it != empire->GetProductionQueue().end())
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
             std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::MOVE_ITEM_TO_INDEX,
                                                    empire_id, queue_it->uuid, new_queue_index));
 
@@ -477,7 +725,7 @@ namespace {
         auto queue_it = empire->GetProductionQueue().find(queue_index);
 
         if (queue_it != empire->GetProductionQueue().end())
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
                 std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::REMOVE_FROM_QUEUE,
                                                        empire_id, queue_it->uuid));
 
@@ -502,7 +750,7 @@ namespace {
         auto queue_it = empire->GetProductionQueue().find(queue_index);
 
         if (queue_it != empire->GetProductionQueue().end())
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
                 std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::PAUSE_PRODUCTION,
                                                        empire_id, queue_it->uuid));
 
@@ -527,7 +775,7 @@ namespace {
         auto queue_it = empire->GetProductionQueue().find(queue_index);
 
         if (queue_it != empire->GetProductionQueue().end())
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
                 std::make_shared<ProductionQueueOrder>(ProductionQueueOrder::ProdQueueOrderAction::ALLOW_STOCKPILE_USE,
                                                        empire_id, queue_it->uuid));
 
@@ -560,7 +808,7 @@ namespace {
             auto design = std::make_unique<ShipDesign>(std::invalid_argument(""), name, description, current_turn,
                                                        ClientApp::GetApp()->EmpireID(), hull, parts, icon, model,
                                                        name_desc_in_stringtable, false, uuid);
-            AIClientApp::GetApp()->Orders().IssueOrder(
+            IssueOrder(
                 std::make_shared<ShipDesignOrder>(empire_id, *design));
             return 1;
 
@@ -594,6 +842,20 @@ namespace FreeOrionPython {
     void ClearStaticSaveStateString()
     { s_save_state_string.clear(); }
 
+    void BeginTurnBudget(double budget_seconds)
+    { GetTurnBudget().Begin(budget_seconds); }
+
+    auto EndTurnBudget() -> std::string
+    { return GetTurnBudget().End(); }
+
+    auto ClearTurnBudgetExceededError() -> bool
+    {
+        if (!GetTurnBudget().Raised() || !s_turn_budget_exceeded || !PyErr_ExceptionMatches(s_turn_budget_exceeded))
+            return false;
+        PyErr_Clear();
+        return true;
+    }
+
     /** Expose game client to Python.
      *
      * CallPolicies:
@@ -659,6 +921,14 @@ namespace FreeOrionPython {
         py::def("updateMeterEstimates",                 UpdateMeterEstimates);
         py::def("updateResourcePools",                  UpdateResourcePools);
         py::def("updateResearchQueue",                  UpdateResearchQueue);
+        py::def("pathfinderStatistics",                 PathfinderStatisticsDict, "Returns a dict of the pathfinding queries made by this AI client since it started: queries, a dict from the kind of query (string) to a tuple of their count (int) and total milliseconds (float), and the distance cache's cacheHits (int), cacheMisses (int), rowsComputed (int) and rowsComputedMs (float). Subtract the values from an earlier call to get the queries made since then.");
+
+        py::class_<CombatSimulationResults>("combatSimulationResults", py::no_init)
+            .def_readonly("numSimulations",     &CombatSimulationResults::num_simulations)
+            .add_property("objectSurvival",     py::make_getter(&CombatSimulationResults::object_survival,  py::return_value_policy<py::return_by_value>()))
+            .add_property("objectHealth",       py::make_getter(&CombatSimulationResults::object_health,    py::return_value_policy<py::return_by_value>()))
+            .add_property("empireSurvival",     py::make_getter(&CombatSimulationResults::empire_survival,  py::return_value_policy<py::return_by_value>()));
+        py::def("simulateCombat",                       SimulateCombatAtSystem, "Resolves the combat that would occur at the system with id systemID (int) between the ships and planets there that this client knows of, numSimulations (int) times, in parallel and without changing the universe, using random seeds seed (int), seed + 1 and so on. Returns a combatSimulationResults with the fraction of simulations in which each object (objectSurvival) and each empire (empireSurvival) survived and the mean structure or defense, infrastructure and shields of each object afterwards (objectHealth).");
         py::def("updateProductionQueue",                UpdateProductionQueue);
 
         py::def("issueFleetMoveOrder",
@@ -754,6 +1024,20 @@ namespace FreeOrionPython {
                 +[]() -> const GalaxySetupData& { return AIClientApp::GetApp()->GetGalaxySetupData(); },
                 py::return_value_policy<py::copy_const_reference>());
 
+        py::def("beginTurnPhase",
+                +[](const std::string& name) { GetTurnBudget().BeginPhase(name); },
+                "Starts timing the named (string) phase of order generation, ending the previous one. Phase timings are reported to the server after each turn.");
+        py::def("turnTimeRemaining",
+                +[]() { return GetTurnBudget().Remaining(); },
+                "Returns the seconds (float) left of this turn's order generation budget, or infinity if there is no budget.");
+        py::def("turnBudgetExceeded",
+                +[]() { return GetTurnBudget().Exceeded(); },
+                "Returns True (boolean) if this turn's order generation budget is spent. Shortly after, TurnBudgetExceeded is raised, ending order generation and sending the orders issued so far.");
+
+        if (!s_turn_budget_exceeded)
+            s_turn_budget_exceeded = PyErr_NewException("freeOrionAIInterface.TurnBudgetExceeded", PyExc_BaseException, nullptr);
+        py::scope().attr("TurnBudgetExceeded") = py::object(py::handle<>(py::borrowed(s_turn_budget_exceeded)));
+
         py::scope().attr("INVALID_GAME_TURN") = INVALID_GAME_TURN;
     }
 }
@@ -9,6 +9,12 @@ namespace FreeOrionPython {
     void  SetStaticSaveStateString(const std::string& new_state_string);
     void  ClearStaticSaveStateString();
 
+    // wall-clock budget and timings of the AI's order generation each turn
+    void        BeginTurnBudget(double budget_seconds);
+    std::string EndTurnBudget();
+    // clears the pending Python error and returns true iff it was raised because the budget was spent
+    bool        ClearTurnBudgetExceededError();
+
     // AI interface wrapper
     void WrapAI();
 }
@@ -49,9 +49,9 @@ int wmain(int argc, wchar_t* argv[], wchar_t* envp[]) {
     GetOptionsDB().Add<std::string>('h', "help", UserStringNop("OPTIONS_DB_HELP"), "NOOP",
                                     Validator<std::string>(), false);
 
-    // if config.xml and persistent_config.xml are present, read and set options entries
-    GetOptionsDB().SetFromFile(GetConfigPath(), FreeOrionVersionString());
-    GetOptionsDB().SetFromFile(GetPersistentConfigPath());
+    // if config and persistent config files (or the xml config files of
+    // earlier versions) are present, read and set options entries
+    GetOptionsDB().SetFromConfigFiles(FreeOrionVersionString());
     GetOptionsDB().SetFromCommandLine(args);
 
     auto help_arg = GetOptionsDB().Get<std::string>("help");
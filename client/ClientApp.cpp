@@ -3,6 +3,7 @@
 #include "../util/Logger.h"
 #include "../universe/UniverseObject.h"
 #include "../universe/System.h"
+#include "../universe/ScriptingContext.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
 #include "../network/Networking.h"
@@ -109,11 +110,15 @@ void ClientApp::SetEmpireStatus(int empire_id, Message::PlayerStatus status) {
         empire->SetReady(status == Message::PlayerStatus::WAITING);
 }
 
-void ClientApp::StartTurn(const SaveGameUIData& ui_data)
-{ m_networking->SendMessage(TurnOrdersMessage(m_orders, ui_data)); }
+void ClientApp::StartTurn(const SaveGameUIData& ui_data) {
+    m_networking->SendMessage(TurnOrdersMessage(m_orders, ui_data,
+                                                m_networking->IsBinarySerializationUsed()));
+}
 
-void ClientApp::StartTurn(const std::string& save_state_string)
-{ m_networking->SendMessage(TurnOrdersMessage(m_orders, save_state_string)); }
+void ClientApp::StartTurn(const std::string& save_state_string) {
+    m_networking->SendMessage(TurnOrdersMessage(m_orders, save_state_string,
+                                                m_networking->IsBinarySerializationUsed()));
+}
 
 void ClientApp::SendPartialOrders() {
     if (!m_networking || !m_networking->IsTxConnected())
@@ -127,9 +132,63 @@ void ClientApp::SendPartialOrders() {
 void ClientApp::HandleTurnPhaseUpdate(Message::TurnProgressPhase phase_id) {
 }
 
+void ClientApp::ScheduleMeterEstimateUpdate(int object_id, bool update_contained_objects) {
+    m_last_meter_estimate_scheduled = std::chrono::steady_clock::now();
+    if (m_scheduled_all_meter_estimates)
+        return;
+    if (object_id == INVALID_OBJECT_ID) {
+        m_scheduled_all_meter_estimates = true;
+        m_scheduled_meter_estimate_ids.clear();
+        return;
+    }
+
+    std::vector<int> ids_to_add{object_id};
+    while (!ids_to_add.empty()) {
+        int id = ids_to_add.back();
+        ids_to_add.pop_back();
+        if (!m_scheduled_meter_estimate_ids.insert(id).second || !update_contained_objects)
+            continue;
+        if (auto obj = m_universe.Objects().get(id))
+            for (int contained_id : obj->ContainedObjectIDs())
+                ids_to_add.push_back(contained_id);
+    }
+}
+
+bool ClientApp::UpdateScheduledMeterEstimates(std::chrono::milliseconds debounce) {
+    if (!m_scheduled_all_meter_estimates && m_scheduled_meter_estimate_ids.empty())
+        return false;
+    if (std::chrono::steady_clock::now() - m_last_meter_estimate_scheduled < debounce)
+        return false;
+
+    ScriptingContext context{m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager};
+    // each meter estimate changes objects many times, but observers need
+    // only be notified once per object
+    m_universe.BatchUniverseObjectSignals(true);
+    if (m_scheduled_all_meter_estimates) {
+        m_universe.UpdateMeterEstimates(context);
+    } else {
+        std::vector<int> object_ids(m_scheduled_meter_estimate_ids.begin(),
+                                    m_scheduled_meter_estimate_ids.end());
+        m_universe.UpdateMeterEstimates(object_ids, context);
+    }
+    m_universe.BatchUniverseObjectSignals(false);
+    ClearScheduledMeterEstimateUpdates();
+
+    MeterEstimatesUpdatedSignal();
+    return true;
+}
+
+void ClientApp::ClearScheduledMeterEstimateUpdates() {
+    m_scheduled_meter_estimate_ids.clear();
+    m_scheduled_all_meter_estimates = false;
+}
+
 OrderSet& ClientApp::Orders()
 { return m_orders; }
 
+ObjectDeltaBase& ClientApp::TurnUpdateDeltaBase()
+{ return m_turn_update_delta_base; }
+
 ClientNetworking& ClientApp::Networking()
 { return *m_networking; }
 
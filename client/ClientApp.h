@@ -9,6 +9,12 @@
 #include "../util/OrderSet.h"
 #include "../util/AppInterface.h"
 #include "../util/MultiplayerCommon.h"
+#include "../util/ObjectDeltaBase.h"
+
+#include <boost/signals2/signal.hpp>
+
+#include <chrono>
+#include <unordered_set>
 
 class ClientNetworking;
 
@@ -97,6 +103,13 @@ public:
     const OrderSet& Orders() const;
     /** @} */
 
+    /** @brief Return the record of the last turn update received by this
+     *      client, against which the server may delta encode the next one
+     *
+     * @return A reference to the ::ObjectDeltaBase of this client.
+     */
+    ObjectDeltaBase& TurnUpdateDeltaBase();
+
     /** @brief Return the networking object of this clients player
      *
      * @return A reference to the ClientNetworking object of this client.
@@ -152,6 +165,30 @@ public:
         the orders. */
     virtual void HandleTurnPhaseUpdate(Message::TurnProgressPhase phase_id);
 
+    /** @brief Schedule an update of the meter estimates of @a object_id and,
+     *      if @a update_contained_objects, of the objects it contains
+     *
+     * Scheduled updates are done together by the next call to
+     * UpdateScheduledMeterEstimates, so that several orders issued in quick
+     * succession cause only one update.  If @a object_id is
+     * INVALID_OBJECT_ID, the meter estimates of all objects are updated.
+     */
+    void ScheduleMeterEstimateUpdate(int object_id, bool update_contained_objects = false);
+
+    /** @brief Do the scheduled meter estimate updates, if the most recent was
+     *      scheduled at least @a debounce ago
+     *
+     * @return true if meter estimates were updated, after which
+     *      MeterEstimatesUpdatedSignal has been emitted.
+     */
+    bool UpdateScheduledMeterEstimates(std::chrono::milliseconds debounce = std::chrono::milliseconds(0));
+
+    /** @brief Forget scheduled meter estimate updates without doing them */
+    void ClearScheduledMeterEstimateUpdates();
+
+    /** Emitted after UpdateScheduledMeterEstimates updates meter estimates. */
+    boost::signals2::signal<void ()> MeterEstimatesUpdatedSignal;
+
     /** @brief Return the set of known Empire s for this client
      *
      * @return The EmpireManager instance in charge of maintaining the Empire
@@ -231,6 +268,9 @@ protected:
     // client local order storage
     OrderSet                    m_orders;
 
+    // objects from the last turn update
+    ObjectDeltaBase             m_turn_update_delta_base;
+
     // other client local info
     std::shared_ptr<ClientNetworking>   m_networking;
     int                                 m_empire_id = ALL_EMPIRES;
@@ -238,6 +278,11 @@ protected:
     /** Indexed by player id, contains info about all players in the game */
 
     std::map<int, PlayerInfo>   m_player_info;
+
+private:
+    std::unordered_set<int>                 m_scheduled_meter_estimate_ids;
+    bool                                    m_scheduled_all_meter_estimates = false;
+    std::chrono::steady_clock::time_point   m_last_meter_estimate_scheduled;
 };
 
 
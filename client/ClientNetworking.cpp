@@ -167,6 +167,10 @@ public:
     /** Returns true iff the client is connected to send to the server. */
     bool IsTxConnected() const;
 
+    /** Returns true if the last game start or turn update received from the
+        server was binary serialized. */
+    bool IsBinarySerializationUsed() const;
+
     /** Returns the ID of the player on this client. */
     int PlayerID() const;
 
@@ -236,6 +240,7 @@ private:
     void HandleMessageHeaderRead(const std::shared_ptr<const ClientNetworking>& keep_alive,
                                  boost::system::error_code error, std::size_t bytes_transferred);
     void AsyncReadMessage(const std::shared_ptr<const ClientNetworking>& keep_alive);
+    void PushIncomingMessage(Message message);
     void HandleMessageWrite(boost::system::error_code error, std::size_t bytes_transferred);
     void AsyncWriteMessage();
     void SendMessageImpl(Message message);
@@ -256,6 +261,7 @@ private:
 
     bool                            m_rx_connected = false; // accessed from multiple threads
     bool                            m_tx_connected = false; // accessed from multiple threads
+    bool                            m_binary_serialization = false; // accessed from multiple threads
 
     MessageQueue                    m_incoming_messages;    // accessed from multiple threads, but its interface is threadsafe
     std::list<Message>              m_outgoing_messages;
@@ -291,6 +297,11 @@ bool ClientNetworking::Impl::IsTxConnected() const {
     return m_tx_connected;
 }
 
+bool ClientNetworking::Impl::IsBinarySerializationUsed() const {
+    std::scoped_lock lock(m_mutex);
+    return m_binary_serialization;
+}
+
 int ClientNetworking::Impl::PlayerID() const
 { return m_player_id; }
 
@@ -389,6 +400,17 @@ bool ClientNetworking::Impl::ConnectToServer(
                     // then deliver an OS dependent error when/if the other side of the connection
                     // times out or closes.
                     m_socket.set_option(boost::asio::socket_base::keep_alive(true));
+
+                    // large buffers let turn updates from a server on the same
+                    // machine arrive with few reads
+                    boost::system::error_code endpoint_error;
+                    const auto remote_endpoint = m_socket.remote_endpoint(endpoint_error);
+                    if (!endpoint_error && remote_endpoint.address().is_loopback()) {
+                        boost::system::error_code ignored_error;
+                        m_socket.set_option(boost::asio::socket_base::receive_buffer_size(Networking::LOCAL_SOCKET_BUFFER_SIZE), ignored_error);
+                        m_socket.set_option(boost::asio::socket_base::send_buffer_size(Networking::LOCAL_SOCKET_BUFFER_SIZE), ignored_error);
+                        m_socket.set_option(tcp::no_delay(true), ignored_error);
+                    }
                     DebugLogger(network) << "Connecting to server took "
                                          << std::chrono::duration_cast<std::chrono::milliseconds>(connection_time).count() << " ms.";
 
@@ -542,11 +564,32 @@ void ClientNetworking::Impl::HandleMessageBodyRead(const std::shared_ptr<const C
 
     assert(static_cast<int>(bytes_transferred) <= m_incoming_header[Message::Parts::SIZE]);
     if (static_cast<int>(bytes_transferred) == m_incoming_header[Message::Parts::SIZE]) {
-        m_incoming_messages.PushBack(m_incoming_message);
+        if (m_incoming_message.Compressed()) {
+            try {
+                PushIncomingMessage(DecompressMessage(m_incoming_message));
+            } catch (const std::exception& e) {
+                ErrorLogger(network) << "ClientNetworking::Impl::HandleMessageBodyRead dropping "
+                                     << m_incoming_message.Type() << " message: " << e.what();
+            }
+        } else {
+            PushIncomingMessage(m_incoming_message);
+        }
         AsyncReadMessage(keep_alive);
     }
 }
 
+void ClientNetworking::Impl::PushIncomingMessage(Message message) {
+    // the server sends binary serialized gamestate only to clients of its
+    // own version, which can then send it binary serialized orders too
+    if (message.Type() == Message::MessageType::GAME_START ||
+        message.Type() == Message::MessageType::TURN_UPDATE)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_binary_serialization = !IsXMLMessage(message);
+    }
+    m_incoming_messages.PushBack(std::move(message));
+}
+
 void ClientNetworking::Impl::HandleMessageHeaderRead(const std::shared_ptr<const ClientNetworking>& keep_alive,
                                                      boost::system::error_code error, std::size_t bytes_transferred)
 {
@@ -682,6 +725,9 @@ bool ClientNetworking::IsRxConnected() const
 bool ClientNetworking::IsTxConnected() const
 { return m_impl->IsTxConnected(); }
 
+bool ClientNetworking::IsBinarySerializationUsed() const
+{ return m_impl->IsBinarySerializationUsed(); }
+
 int ClientNetworking::PlayerID() const
 { return m_impl->PlayerID(); }
 
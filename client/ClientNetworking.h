@@ -54,6 +54,11 @@ public:
     /** Returns true iff the client is connected to send to the server. */
     bool IsTxConnected() const;
 
+    /** Returns true if the last game start or turn update received from the
+        server was binary serialized, meaning that the server also reads
+        binary serialized messages from this client. */
+    bool IsBinarySerializationUsed() const;
+
     /** Returns the ID of the player on this client. */
     int PlayerID() const;
 
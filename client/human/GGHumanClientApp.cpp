@@ -28,6 +28,7 @@
 #include "../../util/Directories.h"
 #include "../../util/Version.h"
 #include "../../util/ScopedTimer.h"
+#include "../../universe/Pathfinder.h"
 #include "../../universe/Planet.h"
 #include "../../universe/Species.h"
 #include "../../Empire/Empire.h"
@@ -95,6 +96,10 @@ void SigHandler(int sig) {
 namespace {
     constexpr bool INSTRUMENT_MESSAGE_HANDLING = false;
 
+    /** How long after the last scheduled meter estimate update to wait for
+      * further orders before doing the scheduled updates. */
+    constexpr std::chrono::milliseconds METER_ESTIMATE_UPDATE_DEBOUNCE{100};
+
     // command-line options
     void AddOptions(OptionsDB& db) {
         db.Add("save.auto.turn.start.enabled",              UserStringNop("OPTIONS_DB_AUTOSAVE_SINGLE_PLAYER_TURN_START"),  true,               Validator<bool>());
@@ -229,9 +234,12 @@ GGHumanClientApp::GGHumanClientApp(int width, int height, bool calculate_fps, st
     if (!force_log_level.empty())
         OverrideAllLoggersThresholds(to_LogLevel(force_log_level));
 
-    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "Client");
+    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "Client",
+                      GetOptionsDB().Get<bool>("log-async"));
     InitLoggingOptionsDBSystem();
 
+    SetPathfinderCaller(PathfinderCaller::PATHFINDER_CALLER_UI);
+
     // Force loggers to always appear in the config.xml and OptionsWnd even before their
     // initialization on first use.
     // This is not needed for the loggers to work correctly.
@@ -281,6 +289,7 @@ GGHumanClientApp::GGHumanClientApp(int width, int height, bool calculate_fps, st
 
     bool inform_user_sound_failed(false);
     try {
+        ScopedTimer timer("Sound initialization");
         if (GetOptionsDB().Get<bool>("audio.effects.enabled") || GetOptionsDB().Get<bool>("audio.music.enabled"))
             Sound::GetSound().Enable();
 
@@ -293,7 +302,10 @@ GGHumanClientApp::GGHumanClientApp(int width, int height, bool calculate_fps, st
         inform_user_sound_failed = true;
     }
 
-    m_ui = std::make_unique<ClientUI>();
+    {
+        ScopedTimer timer("ClientUI construction");
+        m_ui = std::make_unique<ClientUI>();
+    }
 
     EnableFPS();
     UpdateFPSLimit();
@@ -348,7 +360,10 @@ GGHumanClientApp::GGHumanClientApp(int width, int height, bool calculate_fps, st
     // Register LinkText tags with GG::Font
     RegisterLinkTags();
 
-    m_fsm->initiate();
+    {
+        ScopedTimer timer("HumanClientFSM initiate");
+        m_fsm->initiate();
+    }
 
     // Start parsing content
     StartBackgroundParsing();
@@ -454,6 +469,8 @@ void GGHumanClientApp::StartServer() {
     args.emplace_back("\"" + SERVER_CLIENT_EXE + "\"");
     args.emplace_back("--resource.path");
     args.emplace_back("\"" + GetOptionsDB().Get<std::string>("resource.path") + "\"");
+    args.emplace_back("--resource.parse-cache.path");
+    args.emplace_back("\"" + GetOptionsDB().Get<std::string>("resource.parse-cache.path") + "\"");
 
     auto force_log_level = GetOptionsDB().Get<std::string>("log-level");
     if (!force_log_level.empty()) {
@@ -982,8 +999,13 @@ void GGHumanClientApp::HandleSystemEvents() {
 }
 
 void GGHumanClientApp::RenderBegin() {
+    if (!m_startup_trace_finished) {
+        m_startup_trace_finished = true;
+        FinishStartupTrace("first frame", FilenameToPath(GetOptionsDB().Get<std::string>("startup-trace.path")));
+    }
     SDLGUI::RenderBegin();
     Sound::GetSound().DoFrame();
+    UpdateScheduledMeterEstimates(METER_ESTIMATE_UPDATE_DEBOUNCE);
 }
 
 void GGHumanClientApp::HandleMessage(Message&& msg) {
@@ -1419,6 +1441,7 @@ void GGHumanClientApp::ResetClientData(bool save_connection) {
     SetEmpireID(ALL_EMPIRES);
     m_ui->GetMapWnd()->Sanitize();
 
+    ClearScheduledMeterEstimateUpdates();
     m_universe.Clear();
     m_empires.Clear();
     m_orders.Reset();
@@ -128,6 +128,9 @@ public:
 protected:
     void Initialize() override;
 
+    bool ShowsContentText() const override
+    { return true; }
+
 private:
     /** Starts a server process on localhost.
 
@@ -188,6 +191,7 @@ private:
     bool m_connected = false;           ///< true if we are in a state in which we are supposed to be connected to the server
     int  m_auto_turns = 0;              ///< auto turn counter
     bool m_have_window_focus = true;
+    bool m_startup_trace_finished = false;
 
     /** Filenames of all in progress saves.  There maybe multiple saves in
         progress if a player and an autosave are initiated at the same time. */
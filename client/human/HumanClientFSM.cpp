@@ -10,7 +10,9 @@
 #include "../ClientNetworking.h"
 #include "../../util/i18n.h"
 #include "../util/GameRules.h"
+#include "../../util/Directories.h"
 #include "../../util/OptionsDB.h"
+#include "../../util/ScopedTimer.h"
 #include "../../UI/ChatWnd.h"
 #include "../../UI/PlayerListWnd.h"
 #include "../../UI/IntroScreen.h"
@@ -795,7 +797,10 @@ boost::statechart::result PlayingGame::react(const TurnProgress& msg) {
 boost::statechart::result PlayingGame::react(const TurnPartialUpdate& msg) {
     TraceLogger(FSM) << "(HumanClientFSM) PlayingGame.TurnPartialUpdate";
 
-    ExtractTurnPartialUpdateMessageData(msg.m_message,   Client().EmpireID(),    GetUniverse());
+    GetUniverse().BatchUniverseObjectSignals(true);
+    ExtractTurnPartialUpdateMessageData(msg.m_message,   Client().EmpireID(),    GetUniverse(),
+                                        Client().TurnUpdateDeltaBase());
+    GetUniverse().BatchUniverseObjectSignals(false);
 
     Client().GetClientUI().GetMapWnd()->MidTurnUpdate();
 
@@ -840,8 +845,8 @@ boost::statechart::result PlayingGame::react(const PlayerInfoMsg& msg) {
 // WaitingForGameStart
 ////////////////////////////////////////////////////////////
 struct WaitingForGameStart::GameStartDataUnpackedNotification::UnpackedData {
-    UnpackedData(std::string message) {
-        ExtractGameStartMessageData(std::move(message), single_player_game, empire_id,
+    UnpackedData(const Message& message) {
+        ExtractGameStartMessageData(message,            single_player_game, empire_id,
                                     current_turn,       empires,            universe,
                                     species,            combat_logs,        supply,
                                     player_info,        orders,             loaded_game_data,
@@ -884,20 +889,32 @@ WaitingForGameStart::~WaitingForGameStart()
 
 boost::statechart::result WaitingForGameStart::react(const GameStart& msg) {
     TraceLogger(FSM) << "(HumanClientFSM) WaitingForGameStart.GameStart";
+
+    // trace from here until the first turn is initialized in PlayingTurn
+    if (!GetOptionsDB().Get<std::string>("startup-trace.game-start.path").empty())
+        RestartStartupTrace();
+
     Client().GetClientUI().GetMapWnd()->ResetTimeoutClock(0);
     Client().Orders().Reset();
 
-    auto unpack_action = [message = msg.m_message.Text(), &client = Client()]() mutable -> void {
+    auto unpack_action = [message = msg.m_message, &client = Client()]() mutable -> void {
         TraceLogger(FSM) << "Unpacking TurnUpdate...";
+        ScopedTimer timer("GameStart unpacking");
 
         try {
-            auto unpacked_data = std::make_shared<GameStartDataUnpackedNotification::UnpackedData>(std::move(message));
+            auto unpacked_data = [&message]() {
+                ScopedTimer deserialization_timer("GameStart deserialization");
+                return std::make_shared<GameStartDataUnpackedNotification::UnpackedData>(message);
+            }();
             auto unpacking_finished_event =
                 boost::intrusive_ptr<const GameStartDataUnpackedNotification>(
                     new GameStartDataUnpackedNotification(unpacked_data), true);
 
-            unpacked_data->universe.InitializeSystemGraph(unpacked_data->empires, unpacked_data->universe.Objects());
-            unpacked_data->universe.UpdateEmpireVisibilityFilteredSystemGraphsWithMainObjectMap(unpacked_data->empires);
+            {
+                ScopedTimer graph_timer("GameStart system graph");
+                unpacked_data->universe.InitializeSystemGraph(unpacked_data->empires, unpacked_data->universe.Objects());
+                unpacked_data->universe.UpdateEmpireVisibilityFilteredSystemGraphsWithMainObjectMap(unpacked_data->empires);
+            }
 
             // TODO: meter updates? applying orders?
 
@@ -905,7 +922,6 @@ boost::statechart::result WaitingForGameStart::react(const GameStart& msg) {
 
         } catch (const std::exception& e) {
             ErrorLogger(FSM) << "WaitingForGameStart::react(const GameStart& msg) unpacking failed: " << e.what();
-            client.GetClientUI().GetMessageWnd()->HandleLogMessage(UserString("ERROR_PROCESSING_SERVER_MESSAGE") + "\n");
             boost::intrusive_ptr<const UnpackFailedNotification> unpacking_failed_event{
                 new UnpackFailedNotification(), true};
             client.PostDeferredEvent(std::move(unpacking_failed_event));
@@ -920,6 +936,8 @@ boost::statechart::result WaitingForGameStart::react(const GameStartDataUnpacked
     if (!data.unpacked)
         return transit<IntroMenu>();
 
+    ScopedTimer timer("GameStart starting game"); // includes the first turn's initialization in PlayingTurn
+
     try {
         GameStartDataUnpackedNotification::UnpackedData& unpacked{*data.unpacked};
 
@@ -941,6 +959,11 @@ boost::statechart::result WaitingForGameStart::react(const GameStartDataUnpacked
         Client().Players() = std::move(unpacked.player_info);
         Client().Orders() = std::move(unpacked.orders);
 
+        // decode the textures of what is on the map while the rest of the
+        // game is started and the first turn initialized, rather than
+        // one at a time as the map creates the icons showing them
+        Client().GetClientUI().GetMapWnd()->PrefetchTurnTextures();
+
         bool is_new_game = !(unpacked.loaded_game_data && unpacked.ui_data_available);
         Client().StartGame(is_new_game);
 
@@ -966,18 +989,20 @@ boost::statechart::result WaitingForGameStart::react(const GameStartDataUnpacked
     return transit<PlayingTurn>();
 }
 
-boost::statechart::result WaitingForGameStart::react(const UnpackFailedNotification&)
-{ return transit<IntroMenu>(); }
+boost::statechart::result WaitingForGameStart::react(const UnpackFailedNotification&) {
+    Client().GetClientUI().GetMessageWnd()->HandleLogMessage(UserString("ERROR_PROCESSING_SERVER_MESSAGE") + "\n");
+    return transit<IntroMenu>();
+}
 
 
 ////////////////////////////////////////////////////////////
 // WaitingForTurnData
 ////////////////////////////////////////////////////////////
 struct WaitingForTurnData::TurnDataUnpackedNotification::UnpackedData {
-    UnpackedData(std::string message, const int client_empire_id) {
-        ExtractTurnUpdateMessageData(std::move(message), client_empire_id, current_turn,
+    UnpackedData(const Message& message, const int client_empire_id, ObjectDeltaBase& delta_base) {
+        ExtractTurnUpdateMessageData(message,            client_empire_id, current_turn,
                                      empires, universe, species, combat_logs, supply,
-                                     player_info);
+                                     player_info, delta_base);
     }
 
     EmpireManager empires;
@@ -990,6 +1015,14 @@ struct WaitingForTurnData::TurnDataUnpackedNotification::UnpackedData {
     int current_turn = INVALID_GAME_TURN;
 };
 
+namespace {
+    /** Gamestate replaced by a turn update, to be destroyed on another thread. */
+    struct PreviousTurnState {
+        EmpireManager empires;
+        Universe universe;
+    };
+}
+
 WaitingForTurnData::WaitingForTurnData(my_context ctx) :
     Base(ctx)
 {
@@ -1021,11 +1054,11 @@ boost::statechart::result WaitingForTurnData::react(const TurnUpdate& msg) {
     Client().GetClientUI().GetMapWnd()->ResetTimeoutClock(0);
     Client().Orders().Reset();
 
-    auto unpack_action = [message = msg.m_message.Text(), &client = Client()]() mutable -> void {
+    auto unpack_action = [message = msg.m_message, &client = Client()]() mutable -> void {
         TraceLogger(FSM) << "Unpacking TurnUpdate...";
         try {
             auto unpacked_data = std::make_shared<TurnDataUnpackedNotification::UnpackedData>(
-                std::move(message), client.EmpireID());
+                message, client.EmpireID(), client.TurnUpdateDeltaBase());
             boost::intrusive_ptr<const TurnDataUnpackedNotification> unpacking_finished_event{
                 new TurnDataUnpackedNotification(unpacked_data), true};
 
@@ -1038,7 +1071,6 @@ boost::statechart::result WaitingForTurnData::react(const TurnUpdate& msg) {
 
         } catch (const std::exception& e) {
             ErrorLogger(FSM) << "WaitingForTurnData::react(const TurnUpdate& msg) unpacking failed: " << e.what();
-            client.GetClientUI().GetMessageWnd()->HandleLogMessage(UserString("ERROR_PROCESSING_SERVER_MESSAGE") + "\n");
             boost::intrusive_ptr<const UnpackFailedNotification> unpacking_failed_event{
                 new UnpackFailedNotification(), true};
             client.PostDeferredEvent(std::move(unpacking_failed_event));
@@ -1058,9 +1090,19 @@ boost::statechart::result WaitingForTurnData::react(const TurnDataUnpackedNotifi
 
         DebugLogger(FSM) << "Extracted TurnUpdate message for turn: " << unpacked.current_turn;
 
+        // the previous turn's universe and empires are moved out, rather than
+        // being destroyed while being replaced, so that they can be destroyed
+        // on another thread. in late game, freeing all the previous objects
+        // takes long enough to noticeably stall the UI
+        auto previous_state = std::make_unique<PreviousTurnState>();
+        previous_state->empires = std::move(Empires());
+        previous_state->universe = std::move(GetUniverse());
+
         Client().SetCurrentTurn(unpacked.current_turn);
         Empires() = std::move(unpacked.empires);
         GetUniverse() = std::move(unpacked.universe);
+        std::thread([previous_state{std::move(previous_state)}]() mutable { previous_state.reset(); }).detach();
+
         GetSpeciesManager() = std::move(unpacked.species);
         GetCombatLogManager() = std::move(unpacked.combat_logs);
         GetSupplyManager() = std::move(unpacked.supply);
@@ -1074,8 +1116,10 @@ boost::statechart::result WaitingForTurnData::react(const TurnDataUnpackedNotifi
     }
 }
 
-boost::statechart::result WaitingForTurnData::react(const UnpackFailedNotification&)
-{ return discard_event(); }
+boost::statechart::result WaitingForTurnData::react(const UnpackFailedNotification&) {
+    Client().GetClientUI().GetMessageWnd()->HandleLogMessage(UserString("ERROR_PROCESSING_SERVER_MESSAGE") + "\n");
+    return discard_event();
+}
 
 boost::statechart::result WaitingForTurnData::react(const TurnRevoked& msg) {
     TraceLogger(FSM) << "(HumanClientFSM) PlayingGame.TurnRevoked";
@@ -1110,6 +1154,9 @@ PlayingTurn::PlayingTurn(my_context ctx) :
     Client().Register(Client().GetClientUI().GetMapWnd());
     Client().GetClientUI().GetMapWnd()->InitTurn();
     Client().GetClientUI().GetMapWnd()->RegisterWindows(); // only useful at game start but InitTurn() takes a long time, don't want to display windows before content is ready.  could go in WaitingForGameStart dtor but what if it is given e.g. an error reaction?
+    // only writes a trace if one was restarted on receiving the game start
+    FinishStartupTrace("first turn initialized",
+                       FilenameToPath(GetOptionsDB().Get<std::string>("startup-trace.game-start.path")));
     // TODO: reselect last fleet if stored in save game ui data?
     Client().GetClientUI().GetMessageWnd()->HandleGameStatusUpdate(
         boost::io::str(FlexibleFormat(UserString("TURN_BEGIN")) % CurrentTurn()) + "\n");
@@ -2,6 +2,7 @@
 #include "../../util/OptionsDB.h"
 #include "../../util/Directories.h"
 #include "../../util/Logger.h"
+#include "../../util/ScopedTimer.h"
 #include "../../util/Version.h"
 #include "../../util/i18n.h"
 #include "../../UI/Hotkeys.h"
@@ -175,12 +176,16 @@ int mainConfigOptionsSetup(const std::vector<std::string>& args) {
         // Add the keyboard shortcuts
         Hotkey::AddOptions(GetOptionsDB());
 
-        // if config.xml and persistent_config.xml are present, read and set options entries
-        GetOptionsDB().SetFromFile(GetConfigPath(), FreeOrionVersionString());
-        GetOptionsDB().SetFromFile(GetPersistentConfigPath());
+        {
+            ScopedTimer timer("OptionsDB load");
+
+            // if config and persistent config files (or the xml config files of
+            // earlier versions) are present, read and set options entries
+            GetOptionsDB().SetFromConfigFiles(FreeOrionVersionString());
 
-        // override previously-saved and default options with command line parameters and flags
-        GetOptionsDB().SetFromCommandLine(args);
+            // override previously-saved and default options with command line parameters and flags
+            GetOptionsDB().SetFromCommandLine(args);
+        }
 
         CompleteXDGMigration();
 
@@ -268,8 +273,12 @@ int mainSetupAndRun() {
 #  endif
 #endif
 
+        // timed separately from the constructor body, to include the window
+        // and OpenGL setup done by SDLGUI
+        auto construction_timer = std::make_unique<ScopedTimer>("GGHumanClientApp construction");
         GGHumanClientApp app(width, height, true, "FreeOrion " + FreeOrionVersionString(),
                            left, top, fullscreen, fake_mode_change);
+        construction_timer.reset();
 
         if (GetOptionsDB().Get<bool>("quickstart")) {
             // immediately start the server, establish network connections, and
@@ -2,11 +2,55 @@
 #include "../universe/Meter.h"
 #include "../universe/UniverseObject.h"
 #include "../universe/Enums.h"
+#include "../util/Directories.h"
+#include "../util/i18n.h"
 #include "../util/Logger.h"
+#include "../util/MemoryUsage.h"
+#include "../util/OptionsDB.h"
+#include "../util/Serialize.h"
 #include "CombatEvents.h"
 
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <sstream>
+
 
 namespace {
+    void AddOptions(OptionsDB& db) {
+        db.Add("combat.log.retained-turns", UserStringNop("OPTIONS_DB_COMBAT_LOG_RETAINED_TURNS"),
+               0, RangedValidator<int>(0, 100000));
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
+
+    /** How many logs read back from the spill file are kept in memory. */
+    constexpr std::size_t MAX_FETCHED_LOGS = 8;
+
+    /** Approximate bytes used by \p event and the events it contains. Events
+        other than weapon fire are counted as being the size of a weapon fire
+        event, which is the most common kind and among the largest. */
+    std::size_t EventBytes(const CombatEvent& event) {
+        std::size_t retval = sizeof(WeaponFireEvent) + 2 * sizeof(void*);    // with the control block
+        if (const auto* fire_event = dynamic_cast<const WeaponFireEvent*>(&event))
+            retval += MemoryUsage::HeapBytes(fire_event->weapon_name);
+        for (const auto& sub_event : event.SubEvents(ALL_EMPIRES))
+            if (sub_event)
+                retval += sizeof(sub_event) + EventBytes(*sub_event);
+        return retval;
+    }
+
+    std::size_t LogBytes(const CombatLog& log) {
+        using MemoryUsage::HeapBytes;
+        std::size_t retval = HeapBytes(log.empire_ids) + HeapBytes(log.object_ids) +
+            HeapBytes(log.damaged_object_ids) + HeapBytes(log.destroyed_object_ids) +
+            HeapBytes(log.participant_states) + log.combat_events.capacity() * sizeof(CombatEventPtr);
+        for (const auto& event : log.combat_events)
+            if (event)
+                retval += EventBytes(*event);
+        return retval;
+    }
+
     static float MaxHealth(const UniverseObject& object) {
         if (object.ObjectType() == UniverseObjectType::OBJ_SHIP) {
             return object.GetMeter(MeterType::METER_MAX_STRUCTURE)->Current();
@@ -83,11 +127,154 @@ CombatLog::CombatLog(const CombatInfo& combat_info) :
 ////////////////////////////////////////////////
 // CombatLogManager
 ////////////////////////////////////////////////
+CombatLogManager::CombatLogManager(CombatLogManager&& rhs)
+{ *this = std::move(rhs); }
+
+CombatLogManager& CombatLogManager::operator=(CombatLogManager&& rhs) {
+    if (this == &rhs)
+        return *this;
+    Clear();
+
+    m_logs = std::move(rhs.m_logs);
+    m_incomplete_logs = std::move(rhs.m_incomplete_logs);
+    m_latest_log_id = rhs.m_latest_log_id;
+
+    // the spill file now belongs to this manager, so rhs mustn't remove it
+    m_spilled_logs = std::move(rhs.m_spilled_logs);
+    m_spill_file_path = std::move(rhs.m_spill_file_path);
+    m_spill_file_size = rhs.m_spill_file_size;
+    rhs.m_spilled_logs.clear();
+    rhs.m_spill_file_path.clear();
+    rhs.m_spill_file_size = 0;
+
+    std::scoped_lock lock(m_fetched_logs_mutex, rhs.m_fetched_logs_mutex);
+    m_fetched_logs = std::move(rhs.m_fetched_logs);
+    rhs.m_fetched_logs.clear();
+    return *this;
+}
+
+CombatLogManager::~CombatLogManager() {
+    if (m_spill_file_path.empty())
+        return;
+    boost::system::error_code ec;
+    boost::filesystem::remove(FilenameToPath(m_spill_file_path), ec);
+}
+
 boost::optional<const CombatLog&> CombatLogManager::GetLog(int log_id) const {
     auto it = m_logs.find(log_id);
     if (it != m_logs.end())
         return it->second;
-    return boost::none;
+
+    if (!m_spilled_logs.count(log_id))
+        return boost::none;
+
+    std::scoped_lock lock(m_fetched_logs_mutex);
+    auto fetched_it = std::find_if(m_fetched_logs.begin(), m_fetched_logs.end(),
+                                   [log_id](const auto& id_log) { return id_log.first == log_id; });
+    if (fetched_it != m_fetched_logs.end()) {
+        m_fetched_logs.splice(m_fetched_logs.begin(), m_fetched_logs, fetched_it);
+        return m_fetched_logs.front().second;
+    }
+
+    auto log = ReadSpilledLog(log_id);
+    if (!log)
+        return boost::none;
+    m_fetched_logs.emplace_front(log_id, std::move(*log));
+    if (m_fetched_logs.size() > MAX_FETCHED_LOGS)
+        m_fetched_logs.pop_back();
+    return m_fetched_logs.front().second;
+}
+
+boost::optional<CombatLog> CombatLogManager::ReadSpilledLog(int log_id) const {
+    auto spilled_it = m_spilled_logs.find(log_id);
+    if (spilled_it == m_spilled_logs.end())
+        return boost::none;
+    const auto& [offset, size] = spilled_it->second;
+
+    std::string bytes(size, '\0');
+    boost::filesystem::ifstream ifs(FilenameToPath(m_spill_file_path), std::ios_base::binary);
+    ifs.seekg(static_cast<std::streamoff>(offset));
+    ifs.read(bytes.data(), static_cast<std::streamsize>(size));
+    if (!ifs) {
+        ErrorLogger() << "CombatLogManager::ReadSpilledLog couldn't read log " << log_id
+                      << " from " << m_spill_file_path;
+        return boost::none;
+    }
+
+    CombatLog log;
+    try {
+        std::istringstream iss(bytes);
+        freeorion_bin_iarchive ia(iss);
+        ia >> boost::serialization::make_nvp("log", log);
+    } catch (const std::exception& e) {
+        ErrorLogger() << "CombatLogManager::ReadSpilledLog couldn't deserialize log " << log_id
+                      << ": " << e.what();
+        return boost::none;
+    }
+    return log;
+}
+
+void CombatLogManager::SpillOldLogs(int current_turn) {
+    const int retained_turns = GetOptionsDB().Get<int>("combat.log.retained-turns");
+    if (retained_turns <= 0)
+        return;
+
+    std::vector<int> old_log_ids;
+    for (const auto& [log_id, log] : m_logs)
+        if (log.turn < current_turn - retained_turns)
+            old_log_ids.push_back(log_id);
+    if (old_log_ids.empty())
+        return;
+    std::sort(old_log_ids.begin(), old_log_ids.end());
+
+    if (m_spill_file_path.empty())
+        m_spill_file_path = PathToString(boost::filesystem::unique_path(
+            GetUserDataDir() / "combat-logs-%%%%-%%%%-%%%%.bin"));
+
+    boost::filesystem::ofstream ofs(FilenameToPath(m_spill_file_path),
+                                    std::ios_base::binary | std::ios_base::app);
+    if (!ofs) {
+        ErrorLogger() << "CombatLogManager::SpillOldLogs couldn't open " << m_spill_file_path;
+        return;
+    }
+
+    for (int log_id : old_log_ids) {
+        std::ostringstream oss;
+        try {
+            freeorion_bin_oarchive oa(oss);
+            oa << boost::serialization::make_nvp("log", m_logs.at(log_id));
+        } catch (const std::exception& e) {
+            ErrorLogger() << "CombatLogManager::SpillOldLogs couldn't serialize log " << log_id
+                          << ": " << e.what();
+            continue;
+        }
+        const std::string bytes = oss.str();
+        ofs.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!ofs) {
+            ErrorLogger() << "CombatLogManager::SpillOldLogs couldn't write to " << m_spill_file_path;
+            break;
+        }
+
+        m_spilled_logs[log_id] = {m_spill_file_size, bytes.size()};
+        m_spill_file_size += bytes.size();
+        m_logs.erase(log_id);
+    }
+
+    DebugLogger() << "CombatLogManager::SpillOldLogs " << m_spilled_logs.size()
+                  << " logs spilled, " << m_logs.size() << " in memory";
+}
+
+std::size_t CombatLogManager::ApproximateMemoryUsage() const {
+    std::size_t retval = m_logs.bucket_count() * sizeof(void*) +
+        m_logs.size() * (sizeof(decltype(m_logs)::value_type) + MemoryUsage::HASH_NODE_OVERHEAD) +
+        MemoryUsage::HeapBytes(m_spilled_logs) + MemoryUsage::HeapBytes(m_incomplete_logs);
+    for (const auto& [log_id, log] : m_logs)
+        retval += LogBytes(log);
+
+    std::scoped_lock lock(m_fetched_logs_mutex);
+    for (const auto& [log_id, log] : m_fetched_logs)
+        retval += sizeof(std::pair<int, CombatLog>) + MemoryUsage::NODE_OVERHEAD + LogBytes(log);
+    return retval;
 }
 
 int CombatLogManager::AddNewLog(const CombatLog& log) {
@@ -117,6 +304,16 @@ void CombatLogManager::Clear() {
     m_logs.clear();
     m_incomplete_logs.clear();
     m_latest_log_id = -1;
+
+    m_spilled_logs.clear();
+    m_spill_file_size = 0;
+    if (!m_spill_file_path.empty()) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(FilenameToPath(m_spill_file_path), ec);
+        m_spill_file_path.clear();
+    }
+    std::scoped_lock lock(m_fetched_logs_mutex);
+    m_fetched_logs.clear();
 }
 
 boost::optional<std::vector<int>> CombatLogManager::IncompleteLogIDs() const {
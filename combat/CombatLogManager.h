@@ -7,7 +7,11 @@
 
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
 
 
 // A snapshot of the state of a participant of the combat
@@ -39,8 +43,14 @@ struct FO_COMMON_API CombatLog {
 class FO_COMMON_API CombatLogManager {
 public:
     CombatLogManager() = default;
-
-    /** Return the requested combat log or boost::none.*/
+    CombatLogManager(CombatLogManager&& rhs);
+    ~CombatLogManager();
+    CombatLogManager& operator=(CombatLogManager&& rhs);
+
+    /** Return the requested combat log or boost::none.  Logs that have been
+        spilled to the spill file are read back from it, and the returned
+        reference is only valid until a few other spilled logs have been
+        requested.*/
     boost::optional<const CombatLog&>  GetLog(int log_id) const;
 
     /** Return the ids of all incomplete logs or boost::none if they are all complete.*/
@@ -52,8 +62,33 @@ public:
     void CompleteLog(int id, const CombatLog& log);
     void Clear();
 
+    /** If the "combat.log.retained-turns" option is positive, moves logs of
+        combats more than that many turns before \p current_turn out of
+        memory and into a spill file, from which GetLog fetches them on
+        demand. */
+    void SpillOldLogs(int current_turn);
+
+    /** Returns the approximate number of bytes of memory used by the logs
+        that are in memory, including recently fetched spilled logs. */
+    [[nodiscard]] std::size_t ApproximateMemoryUsage() const;
+
 private:
+    struct SpilledLog {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    /** Reads the log with \p log_id from the spill file. */
+    [[nodiscard]] boost::optional<CombatLog> ReadSpilledLog(int log_id) const;
+
     std::unordered_map<int, CombatLog> m_logs;
+    //! Where in the spill file each log that is no longer in m_logs was written
+    std::map<int, SpilledLog>          m_spilled_logs;
+    std::string                        m_spill_file_path;
+    std::uint64_t                      m_spill_file_size = 0;
+    //! Recently fetched spilled logs, most recently used first
+    mutable std::list<std::pair<int, CombatLog>> m_fetched_logs;
+    mutable std::mutex                 m_fetched_logs_mutex;
     //! Set of logs ids that do not have bodies and need to be fetched from the server
     std::set<int>                      m_incomplete_logs;
     int                                m_latest_log_id = -1;
@@ -1,5 +1,6 @@
 #include "CombatSystem.h"
 #include "CombatEvents.h"
+#include "CombatLogManager.h"
 
 #include "../universe/Universe.h"
 #include "../util/GameRules.h"
@@ -20,16 +21,27 @@
 #include "../util/Logger.h"
 #include "../util/MultiplayerCommon.h"
 #include "../util/Random.h"
+#include "../util/ThreadPool.h"
 #include "../util/i18n.h"
 
 #include "../network/Message.h"
 
+#include <boost/container/flat_set.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
 
 namespace {
+    const RuleHandle<bool> RULE_AGGRESSIVE_SHIPS_COMBAT_VISIBLE{"RULE_AGGRESSIVE_SHIPS_COMBAT_VISIBLE"};
+    const RuleHandle<int> RULE_NUM_COMBAT_ROUNDS{"RULE_NUM_COMBAT_ROUNDS"};
+    const RuleHandle<bool> RULE_RESEED_PRNG_SERVER{"RULE_RESEED_PRNG_SERVER"};
+
     DeclareThreadSafeLogger(combat);
 }
 
@@ -50,7 +62,6 @@ CombatInfo::CombatInfo(int system_id_, int turn_,
     species(species_),
     supply(supply_),
     objects(std::make_unique<ObjectMap>()),
-    empire_object_visibility(universe_mutable_in.GetEmpireObjectVisibility()),
     turn(turn_),
     system_id(system_id_)
 {
@@ -83,6 +94,22 @@ CombatInfo::CombatInfo(int system_id_, int turn_,
         objects->insert(std::move(planet));
     }
 
+    // copy empires' visibilities of just the objects in this combat, rather
+    // than of every object in the universe
+    std::vector<int> object_ids;
+    object_ids.reserve(objects->size());
+    for (const auto& obj : objects->all())
+        object_ids.push_back(obj->ID());
+    std::sort(object_ids.begin(), object_ids.end());
+    for (const auto& [empire_id, universe_obj_vis] : universe_mutable_in.GetEmpireObjectVisibility()) {
+        auto& obj_vis = empire_object_visibility[empire_id];
+        for (int object_id : object_ids) {
+            auto it = universe_obj_vis.find(object_id);
+            if (it != universe_obj_vis.end())
+                obj_vis[object_id] = it->second;
+        }
+    }
+
     InitializeObjectVisibility();
 
     // after battle is simulated, any changes object visibility will be copied
@@ -95,6 +122,16 @@ std::shared_ptr<const System> CombatInfo::GetSystem() const
 std::shared_ptr<System> CombatInfo::GetSystem()
 { return this->objects->get<System>(this->system_id); }
 
+CombatInfo CombatInfo::CloneForSimulation() const {
+    CombatInfo retval;
+    retval.objects.reset(objects->Clone());
+    retval.empire_object_visibility = empire_object_visibility;
+    retval.turn = turn;
+    retval.system_id = system_id;
+    retval.empire_ids = empire_ids;
+    return retval;
+}
+
 float CombatInfo::GetMonsterDetection() const {
     float monster_detection = 0.0;
     for (const auto& obj : objects->all<Ship>())
@@ -260,7 +297,7 @@ void CombatInfo::InitializeObjectVisibility() {
                     DebugLogger() << "Ship " << obj->Name() << " visible empire stealth check: " << empire_detection
                                   << " >= " << obj->GetMeter(MeterType::METER_STEALTH)->Current();
                 }
-                if (vis < Visibility::VIS_PARTIAL_VISIBILITY && GetGameRules().Get<bool>("RULE_AGGRESSIVE_SHIPS_COMBAT_VISIBLE")) {
+                if (vis < Visibility::VIS_PARTIAL_VISIBILITY && RULE_AGGRESSIVE_SHIPS_COMBAT_VISIBLE.Get()) {
                     if (auto ship = std::dynamic_pointer_cast<Ship>(obj)) {
                         if (auto fleet = objects->get<Fleet>(ship->FleetID())) {
                             if (fleet->Aggressive()) {
@@ -944,6 +981,8 @@ namespace {
         std::map<std::string, int> part_fighter_launch_capacities;
         const ::Condition::Condition* fighter_combat_targets = nullptr;
 
+        const auto& part_meters = ship->PartMeters();
+
         // determine what ship does during combat, based on parts and their meters...
         for (const auto& part_name : design->Parts()) {
             const ShipPart* part = GetShipPart(part_name);
@@ -952,10 +991,17 @@ namespace {
             ShipPartClass part_class = part->Class();
             const ::Condition::Condition* part_combat_targets = part->CombatTargets();
 
+            // look up the part once for all of its meters
+            const auto part_idx = part_meters.PartIndex(part_name);
+            const auto current_value = [&part_meters, part_idx](MeterType type) {
+                const Meter* meter = part_meters.get(type, part_idx);
+                return meter ? meter->Current() : 0.0f;
+            };
+
             // direct weapon and fighter-related parts all handled differently...
             if (part_class == ShipPartClass::PC_DIRECT_WEAPON) {
-                float part_attack = ship->CurrentPartMeterValue(MeterType::METER_CAPACITY, part_name);
-                int shots = static_cast<int>(ship->CurrentPartMeterValue(MeterType::METER_SECONDARY_STAT, part_name)); // secondary stat is shots per attack)
+                float part_attack = current_value(MeterType::METER_CAPACITY);
+                int shots = static_cast<int>(current_value(MeterType::METER_SECONDARY_STAT)); // secondary stat is shots per attack)
                 if (part_attack > 0.0f && shots > 0) {
                     if (!part_combat_targets)
                         part_combat_targets = is_enemy_ship_fighter_or_armed_planet.get();
@@ -972,7 +1018,7 @@ namespace {
             } else if (part_class == ShipPartClass::PC_FIGHTER_HANGAR) {
                 // hangar max-capacity-modification effects stack, so only add capacity for each hangar type once
                 if (!seen_hangar_ship_parts.count(part_name)) {
-                    available_fighters += ship->CurrentPartMeterValue(MeterType::METER_CAPACITY, part_name);
+                    available_fighters += current_value(MeterType::METER_CAPACITY);
                     seen_hangar_ship_parts.insert(part_name);
 
                     if (!part_combat_targets)
@@ -987,11 +1033,11 @@ namespace {
                         fighter_name = UserString(part->Name() + "_FIGHTER");
 
                     // should only be one type of fighter per ship as of this writing
-                    fighter_attack = ship->CurrentPartMeterValue(MeterType::METER_SECONDARY_STAT, part_name);  // secondary stat is fighter damage
+                    fighter_attack = current_value(MeterType::METER_SECONDARY_STAT);  // secondary stat is fighter damage
                 }
 
             } else if (part_class == ShipPartClass::PC_FIGHTER_BAY) {
-                part_fighter_launch_capacities[part_name] += ship->CurrentPartMeterValue(MeterType::METER_CAPACITY, part_name);
+                part_fighter_launch_capacities[part_name] += current_value(MeterType::METER_CAPACITY);
             }
         }
 
@@ -1020,40 +1066,83 @@ namespace {
         return retval;
     }
 
-    // Information about a single empire during combat
-    struct EmpireCombatInfo {
-        std::set<int> attacker_ids;
+    /** Storage for the fighters launched during a combat, handed out from
+      * large blocks rather than allocated one fighter at a time, and freed all
+      * together once every fighter allocated from it is gone. */
+    class FighterArena {
+    public:
+        void* Allocate(std::size_t bytes, std::size_t alignment) {
+            m_used = (m_used + alignment - 1) / alignment * alignment;
+            if (m_blocks.empty() || m_used + bytes > m_block_size) {
+                m_block_size = std::max(BLOCK_SIZE, bytes);
+                m_blocks.push_back(std::make_unique<std::byte[]>(m_block_size));
+                m_used = 0;
+            }
+            void* retval = m_blocks.back().get() + m_used;
+            m_used += bytes;
+            return retval;
+        }
 
-        bool HasAttackers() const { return !attacker_ids.empty(); }
+    private:
+        static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
 
-        bool HasUnlauchedArmedFighters(const CombatInfo& combat_info) const {
-            // check each ship to see if it has any unlaunched armed fighters...
-            for (const auto& ship : combat_info.objects->find<Ship>(attacker_ids)) {
-                if (!ship)
-                    continue;   // discard invalid ship references
-                if (combat_info.destroyed_object_ids.count(ship->ID()))
-                    continue;   // destroyed objects can't launch fighters
+        std::vector<std::unique_ptr<std::byte[]>>   m_blocks;
+        std::size_t                                 m_block_size = 0;   // of the last block
+        std::size_t                                 m_used = 0;         // bytes of the last block handed out
+    };
 
-                auto weapons = ShipWeaponsStrengths(ship, combat_info.universe);
-                for (const PartAttackInfo& weapon : weapons) {
-                    if (weapon.part_class == ShipPartClass::PC_FIGHTER_BAY &&
-                        weapon.fighters_launched > 0 &&
-                        weapon.fighter_damage > 0.0f)
-                    { return true; }
-                }
-            }
+    /** Allocator for std::allocate_shared from a FighterArena, which each
+      * fighter's control block keeps alive. */
+    template <typename T>
+    struct FighterAllocator {
+        using value_type = T;
 
-            return false;
-        }
+        explicit FighterAllocator(std::shared_ptr<FighterArena> arena_) :
+            arena(std::move(arena_))
+        {}
+        template <typename U>
+        FighterAllocator(const FighterAllocator<U>& other) :
+            arena(other.arena)
+        {}
+
+        T* allocate(std::size_t n) { return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T))); }
+        void deallocate(T*, std::size_t) {}    // freed with the arena
+
+        template <typename U>
+        bool operator==(const FighterAllocator<U>& rhs) const { return arena == rhs.arena; }
+        template <typename U>
+        bool operator!=(const FighterAllocator<U>& rhs) const { return arena != rhs.arena; }
+
+        std::shared_ptr<FighterArena> arena;
+    };
+
+    // Information about a single empire during combat
+    struct EmpireCombatInfo {
+        boost::container::flat_set<int> attacker_ids;
+
+        bool HasAttackers() const { return !attacker_ids.empty(); }
     };
 
     /// A collection of information the autoresolution must keep around
     struct AutoresolveInfo {
-        std::set<int>                   valid_attacker_object_ids;  // all objects that can attack
+        boost::container::flat_set<int> valid_attacker_object_ids;  // all objects that can attack
         std::map<int, EmpireCombatInfo> empire_infos;               // empire specific information, indexed by empire id
         CombatInfo&                     combat_info;
         int                             next_fighter_id = -1000001; // give fighters negative ids so as to avoid clashes with any positive-id of persistent UniverseObjects
-        std::set<int>                   destroyed_object_ids;       // objects that have been destroyed so far during this combat
+        boost::container::flat_set<int> destroyed_object_ids;       // objects that have been destroyed so far during this combat
+        std::shared_ptr<FighterArena>   fighter_arena = std::make_shared<FighterArena>();
+        std::unordered_map<int, std::vector<PartAttackInfo>> ship_weapons; // weapons of ships, indexed by ship id, found when first needed during this combat
+        std::vector<PartAttackInfo>     uncached_weapons;           // weapons of the planet or fighter last passed to Weapons
+
+        /** Objects matching a pair of targeting conditions, as of the last
+          * attack in attacked_object_ids that has been accounted for. */
+        struct CachedTargets {
+            Condition::ObjectSet    matches;            // sorted by id
+            std::size_t             attacks_applied = 0;
+        };
+        using TargetsKey = std::tuple<int, UniverseObjectType, const Condition::Condition*, const Condition::Condition*>;
+        std::map<TargetsKey, CachedTargets> targets_cache;          // indexed by attacker owner and type, and species and weapon targeting conditions
+        std::vector<int>                attacked_object_ids;        // targets of attacks this bout, in order
 
         explicit AutoresolveInfo(CombatInfo& combat_info_) :
             combat_info(combat_info_)
@@ -1078,8 +1167,9 @@ namespace {
 
             for (int n = 0; n < number; ++n) {
                 // create / insert fighter into combat objectmap
-                auto fighter_ptr = std::make_shared<Fighter>(owner_empire_id, from_ship_id,
-                                                             species, damage, combat_targets);
+                auto fighter_ptr = std::allocate_shared<Fighter>(FighterAllocator<Fighter>(fighter_arena),
+                                                                 owner_empire_id, from_ship_id,
+                                                                 species, damage, combat_targets);
                 fighter_ptr->SetID(next_fighter_id--);
                 fighter_ptr->Rename(fighter_name);
                 combat_info.objects->insert(fighter_ptr);
@@ -1106,14 +1196,69 @@ namespace {
             return retval;
         }
 
+        /** Returns the weapons of \a attacker. Those of ships depend only on
+          * their part meters, which change during combat only when they launch
+          * fighters, so are found once per combat, and again after
+          * InvalidateWeapons. Those of planets and fighters are cheap to find,
+          * and planets' depend on their defense, which is shot down during
+          * combat, so are found on every call, and are valid only until the
+          * next call. */
+        const std::vector<PartAttackInfo>& Weapons(const std::shared_ptr<UniverseObject>& attacker);
+
+        /** Notes that the weapons of ship with id \a ship_id may have changed. */
+        void InvalidateWeapons(int ship_id) { ship_weapons.erase(ship_id); }
+
+        /** Returns the objects matching \a species_condition and
+          * \a weapon_condition with the source of \a context as source.
+          *
+          * Targeting conditions depend on the source only through its owner,
+          * type and species, and on their candidates through state that
+          * changes during a bout only when they are attacked, so matches are
+          * found once per bout for each owner, type and pair of conditions,
+          * and only objects attacked since are evaluated again for later
+          * shots. */
+        const Condition::ObjectSet& Targets(const ScriptingContext& context,
+                                            const Condition::Condition* species_condition,
+                                            const Condition::Condition* weapon_condition);
+
+        /** Notes that object with id \a object_id was attacked, which may
+          * change whether it matches targeting conditions. */
+        void RecordAttack(int object_id) { attacked_object_ids.push_back(object_id); }
+
+        /** Forgets cached targets, at the start of each bout, as objects are
+          * created, removed, and revealed between attacks of different bouts. */
+        void ClearTargets() {
+            targets_cache.clear();
+            attacked_object_ids.clear();
+        }
+
+        bool HasUnlaunchedArmedFighters(const EmpireCombatInfo& empire_info) {
+            // check each ship to see if it has any unlaunched armed fighters...
+            for (const auto& ship : combat_info.objects->find<Ship>(empire_info.attacker_ids)) {
+                if (!ship)
+                    continue;   // discard invalid ship references
+                if (combat_info.destroyed_object_ids.count(ship->ID()))
+                    continue;   // destroyed objects can't launch fighters
+
+                for (const PartAttackInfo& weapon : Weapons(ship)) {
+                    if (weapon.part_class == ShipPartClass::PC_FIGHTER_BAY &&
+                        weapon.fighters_launched > 0 &&
+                        weapon.fighter_damage > 0.0f)
+                    { return true; }
+                }
+            }
+
+            return false;
+        }
+
         // Return true if some empire has ships or fighters that can attack
         // Doesn't consider diplomacy or other empires, as parts have arbitrary
         // targeting conditions, including friendly fire
-        bool CanSomeoneAttackSomething() const {
+        bool CanSomeoneAttackSomething() {
             for (const auto& attacker_info : empire_infos) {
                 // does empire have something to attack with?
                 const EmpireCombatInfo& attacker_empire_info = attacker_info.second;
-                if (!attacker_empire_info.HasAttackers() && !attacker_empire_info.HasUnlauchedArmedFighters(combat_info))
+                if (!attacker_empire_info.HasAttackers() && !HasUnlaunchedArmedFighters(attacker_empire_info))
                     continue;
 
                 // TODO: check if any of these ships or fighters have targeting
@@ -1132,6 +1277,7 @@ namespace {
 
             std::vector<int> delete_list;
             delete_list.reserve(combat_info.objects->size());
+            bool any_destroyed = false;
 
             for (const auto& obj : combat_info.objects->all()) {
                 // Check if object is already noted as destroyed; don't need to re-record this
@@ -1141,6 +1287,7 @@ namespace {
                 if (!CheckDestruction(obj))
                     continue;
                 destroyed_object_ids.insert(obj->ID());
+                any_destroyed = true;
 
                 if (obj->ObjectType() == UniverseObjectType::OBJ_FIGHTER) {
                     fighters_destroyed_event->AddEvent(obj->Owner());
@@ -1154,6 +1301,10 @@ namespace {
                     incaps_event->AddEvent(incap_event);
                 }
             }
+            // once for all objects destroyed, rather than for each of them, as
+            // it checks every object
+            if (any_destroyed)
+                CleanEmpires();
 
             if (at_least_one_fighter_destroyed)
                 bout_event->AddEvent(fighters_destroyed_event);
@@ -1184,7 +1335,6 @@ namespace {
 
                     // Remove target from its empire's list of attackers
                     empire_infos[target->Owner()].attacker_ids.erase(target_id);
-                    CleanEmpires();
                     return fighter->Destroyed();
                 }
 
@@ -1207,7 +1357,6 @@ namespace {
 
                     // Remove target from its empire's list of attackers
                     empire_infos[target->Owner()].attacker_ids.erase(target_id);
-                    CleanEmpires();
                     return true;
                 }
 
@@ -1237,8 +1386,6 @@ namespace {
 
                     // Remove target from its empire's list of attackers
                     empire_infos[target->Owner()].attacker_ids.erase(target_id);
-
-                    CleanEmpires();
                     return true;
                 }
             }
@@ -1250,23 +1397,22 @@ namespace {
         /// If so, remove that empire's entry
         void CleanEmpires() {
             DebugLogger(combat) << "CleanEmpires";
-            auto temp = empire_infos;
-
-            std::set<int> empire_ids_with_objects;
+            boost::container::flat_set<int> empire_ids_with_objects;
             for (const auto& obj : combat_info.objects->all())
                 empire_ids_with_objects.insert(obj->Owner());
 
-            for (auto& empire : empire_infos) {
-                if (!empire_ids_with_objects.count(empire.first)) {
-                    temp.erase(empire.first);
-                    DebugLogger(combat) << "No objects left for empire with id: " << empire.first;
+            for (auto it = empire_infos.begin(); it != empire_infos.end();) {
+                if (!empire_ids_with_objects.count(it->first)) {
+                    DebugLogger(combat) << "No objects left for empire with id: " << it->first;
+                    it = empire_infos.erase(it);
+                } else {
+                    ++it;
                 }
             }
-            empire_infos = std::move(temp);
 
             if (!empire_infos.empty()) {
                 DebugLogger(combat) << "Empires with objects remaining:";
-                for (auto empire : empire_infos) {
+                for (const auto& empire : empire_infos) {
                     DebugLogger(combat) << " ... " << empire.first;
                     for (auto obj_id : empire.second.attacker_ids) {
                         TraceLogger(combat) << " ... ... " << obj_id;
@@ -1381,6 +1527,18 @@ namespace {
         return weapons;
     }
 
+    const std::vector<PartAttackInfo>& AutoresolveInfo::Weapons(const std::shared_ptr<UniverseObject>& attacker) {
+        if (attacker->ObjectType() != UniverseObjectType::OBJ_SHIP) {
+            uncached_weapons = GetWeapons(attacker, combat_info.universe);
+            return uncached_weapons;
+        }
+
+        auto it = ship_weapons.find(attacker->ID());
+        if (it == ship_weapons.end())
+            it = ship_weapons.emplace(attacker->ID(), GetWeapons(attacker, combat_info.universe)).first;
+        return it->second;
+    }
+
     const Condition::Condition* SpeciesTargettingCondition(
         const std::shared_ptr<UniverseObject>& attacker, const SpeciesManager& species_manager)
     {
@@ -1410,13 +1568,52 @@ namespace {
 
     }
 
+    const Condition::ObjectSet& AutoresolveInfo::Targets(const ScriptingContext& context,
+                                                         const Condition::Condition* species_condition,
+                                                         const Condition::Condition* weapon_condition)
+    {
+        static constexpr auto by_id = [](const auto& lhs, const auto& rhs) { return lhs->ID() < rhs->ID(); };
+
+        TargetsKey key{context.source->Owner(), context.source->ObjectType(), species_condition, weapon_condition};
+        auto it = targets_cache.find(key);
+        if (it == targets_cache.end()) {
+            CachedTargets cached;
+            Condition::ObjectSet rejected_targets;
+            AddAllObjectsSet(*combat_info.objects, cached.matches);
+            species_condition->Eval(context, cached.matches, rejected_targets, Condition::SearchDomain::MATCHES);
+            weapon_condition->Eval(context, cached.matches, rejected_targets, Condition::SearchDomain::MATCHES);
+            std::sort(cached.matches.begin(), cached.matches.end(), by_id);
+            cached.attacks_applied = attacked_object_ids.size();
+            return targets_cache.emplace(std::move(key), std::move(cached)).first->second.matches;
+        }
+
+        // evaluate objects attacked since the matches were last updated again
+        auto& cached = it->second;
+        for (; cached.attacks_applied < attacked_object_ids.size(); ++cached.attacks_applied) {
+            auto obj = combat_info.objects->get(attacked_object_ids[cached.attacks_applied]);
+            if (!obj)
+                continue;
+            Condition::ObjectSet candidate{obj}, rejected;
+            species_condition->Eval(context, candidate, rejected, Condition::SearchDomain::MATCHES);
+            weapon_condition->Eval(context, candidate, rejected, Condition::SearchDomain::MATCHES);
+
+            auto pos = std::lower_bound(cached.matches.begin(), cached.matches.end(), obj, by_id);
+            const bool was_match = pos != cached.matches.end() && (*pos)->ID() == obj->ID();
+            if (was_match && candidate.empty())
+                cached.matches.erase(pos);
+            else if (!was_match && !candidate.empty())
+                cached.matches.insert(pos, std::move(obj));
+        }
+        return cached.matches;
+    }
+
     void ShootAllWeapons(const std::shared_ptr<UniverseObject>& attacker,
                          AutoresolveInfo& combat_state, int round,
                          AttacksEventPtr& attacks_event,
                          WeaponsPlatformEvent::WeaponsPlatformEventPtr& platform_event,
                          std::shared_ptr<FightersAttackFightersEvent>& fighter_on_fighter_event)
     {
-        auto weapons = GetWeapons(attacker, combat_state.combat_info.universe);
+        const auto& weapons = combat_state.Weapons(attacker);
         if (weapons.empty()) {
             DebugLogger(combat) << "Attacker " << attacker->Name() << " ("
                                 << attacker->ID() << ") has no weapons, so can't attack";
@@ -1487,19 +1684,10 @@ namespace {
             }
 
 
-            Condition::ObjectSet targets, rejected_targets;
-            AddAllObjectsSet(*combat_state.combat_info.objects, targets);
-
-            // apply species targeting condition and then weapon targeting condition
+            // objects matching species targeting condition and weapon targeting condition
             TraceLogger(combat) << "Species targeting condition: " << species_targetting_condition->Dump();
-            species_targetting_condition->Eval(context, targets, rejected_targets, Condition::SearchDomain::MATCHES);
-            if (targets.empty()) {
-                DebugLogger(combat) << "No objects matched species targeting condition!";
-                continue;
-            }
-
             TraceLogger(combat) << "Weapon targeting condition: " << weapon.combat_targets->Dump();
-            weapon.combat_targets->Eval(context, targets, rejected_targets, Condition::SearchDomain::MATCHES);
+            const auto& targets = combat_state.Targets(context, species_targetting_condition, weapon.combat_targets);
             if (targets.empty()) {
                 DebugLogger(combat) << "No objects matched species and weapon targeting condition!";
                 continue;
@@ -1524,6 +1712,7 @@ namespace {
             Attack(attacker, weapon, targetx, combat_state.combat_info,
                    combat_state.combat_info.bout, round,
                    attacks_event, platform_event, fighter_on_fighter_event);
+            combat_state.RecordAttack(targetx->ID());
 
         } // end for over weapons
     }
@@ -1588,6 +1777,7 @@ namespace {
         int attacker_owner_id = attacker->Owner();
         const auto empire = GetEmpire(attacker_owner_id, combat_state.combat_info);
         const auto& empire_name = (empire ? empire->Name() : UserString("ENC_COMBAT_ROGUE"));
+        bool launched = false;
 
 
         for (const auto& weapon : weapons) {
@@ -1623,6 +1813,7 @@ namespace {
             int num_launched = new_fighter_ids.size();
             if (attacker_ship)
                 ReduceStoredFighterCount(attacker_ship, num_launched);
+            launched = num_launched > 0;
 
             // launching fighters counts as a ship being active in combat
             if (!new_fighter_ids.empty())
@@ -1630,6 +1821,10 @@ namespace {
 
             break;  // don't need to check any more weapons, as all fighters launched should have been contained in the single ShipPartClass::PC_FIGHTER_BAY entry
         } // end for over weapons
+
+        // fewer stored fighters remain to launch; weapons is invalid after this
+        if (launched)
+            combat_state.InvalidateWeapons(attacker->ID());
     }
 
     void IncreaseStoredFighterCount(std::shared_ptr<Ship>& ship, float recovered_fighters) {
@@ -1733,6 +1928,7 @@ namespace {
 
         std::vector<int> shuffled_attackers;
         combat_state.GetShuffledValidAttackerIDs(shuffled_attackers);
+        combat_state.ClearTargets();
 
         DebugLogger() << [&shuffled_attackers](){
             std::stringstream ss;
@@ -1750,11 +1946,7 @@ namespace {
         bout_event->AddEvent(fighter_on_fighter_event);
 
         int round = 1;  // counter of events during the current combat bout
-        const int NUM_COMBAT_ROUNDS = GetGameRules().Get<int>("RULE_NUM_COMBAT_ROUNDS");
-
-        // todo: cache results of GetWeapons(attacker) to avoid re-calling multiple times per combat.
-        // todo: and pass into ShootAllWeapons which also calls that function
-
+        const int NUM_COMBAT_ROUNDS = RULE_NUM_COMBAT_ROUNDS.Get();
 
         // Process planets attacks first so that they still have full power,
         // despite their attack power depending on something (their defence meter)
@@ -1816,7 +2008,7 @@ namespace {
                     DebugLogger() << "Attacker " << attacker->Name() << " could not attack.";
                     continue;
                 }
-                auto weapons = GetWeapons(attacker, combat_info.universe); // includes info about fighter launches with ShipPartClass::PC_FIGHTER_BAY part class, and direct fire weapons (ships, planets, or fighters) with ShipPartClass::PC_DIRECT_WEAPON part class
+                const auto& weapons = combat_state.Weapons(attacker); // includes info about fighter launches with ShipPartClass::PC_FIGHTER_BAY part class, and direct fire weapons (ships, planets, or fighters) with ShipPartClass::PC_DIRECT_WEAPON part class
 
                 LaunchFighters(attacker, weapons, combat_state, round++, launches_event);
 
@@ -1919,7 +2111,7 @@ void AutoResolveCombat(CombatInfo& combat_info) {
 
     // reasonably unpredictable but reproducible random seeding
     int base_seed = 123454321; // arbitrary number
-    if (GetGameRules().Get<bool>("RULE_RESEED_PRNG_SERVER")) {
+    if (RULE_RESEED_PRNG_SERVER.Get()) {
         base_seed += std::hash<std::string>{}(combat_info.galaxy_setup_data.GetSeed()); // probably not consistent across different platforms, but that's OK for this use
         base_seed += (*combat_info.objects->all().begin())->ID() + combat_info.turn;
     }
@@ -1934,8 +2126,8 @@ void AutoResolveCombat(CombatInfo& combat_info) {
     // run multiple combat "bouts" during which each combat object can take
     // action(s) such as shooting at target(s) or launching fighters
     int last_bout = 1;
-    for (int bout = 1; bout <= GetGameRules().Get<int>("RULE_NUM_COMBAT_ROUNDS"); ++bout) {
-        if (GetGameRules().Get<bool>("RULE_RESEED_PRNG_SERVER"))
+    for (int bout = 1; bout <= RULE_NUM_COMBAT_ROUNDS.Get(); ++bout) {
+        if (RULE_RESEED_PRNG_SERVER.Get())
             Seed(base_seed + bout);    // ensure each combat bout produces different results
 
         // empires may have valid targets, but nothing to attack with.  If all
@@ -1964,3 +2156,75 @@ void AutoResolveCombat(CombatInfo& combat_info) {
         DebugLogger(combat) << event->DebugString(*combat_info.objects);
     DebugLogger(combat) << "combat event log end:";
 }
+
+namespace {
+    bool SurvivedCombat(const UniverseObject& obj, const CombatInfo& combat_info) {
+        if (combat_info.destroyed_object_ids.count(obj.ID()))
+            return false;
+        // planets aren't destroyed in combat, but can be left defenceless
+        if (obj.ObjectType() == UniverseObjectType::OBJ_PLANET)
+            return CombatParticipantState(obj).current_health > 0.0f;
+        return true;
+    }
+}
+
+CombatSimulationResults SimulateCombat(const CombatInfo& combat_info, int num_simulations,
+                                       unsigned int seed)
+{
+    CombatSimulationResults retval;
+    if (num_simulations <= 0 || !combat_info.objects)
+        return retval;
+
+    // ships and planets, whose outcomes are reported, and their owners
+    std::vector<std::pair<int, int>> participant_ids_owners;
+    for (const auto& obj : combat_info.objects->all())
+        if (obj->ObjectType() == UniverseObjectType::OBJ_SHIP || obj->ObjectType() == UniverseObjectType::OBJ_PLANET)
+            participant_ids_owners.emplace_back(obj->ID(), obj->Owner());
+
+    struct Outcome {
+        std::vector<char>   survived;   // indexed as participant_ids_owners
+        std::vector<float>  health;
+    };
+    std::vector<Outcome> outcomes(static_cast<std::size_t>(num_simulations));
+
+    TaskBatch batch("SimulateCombat");
+    for (int sim = 0; sim < num_simulations; ++sim) {
+        batch.Post([&combat_info, &participant_ids_owners, &outcome = outcomes[sim],
+                    sim_seed{seed + static_cast<unsigned int>(sim)}]()
+        {
+            auto simulation = combat_info.CloneForSimulation();
+            {
+                ScopedThreadRandomStream random_stream(sim_seed);
+                AutoResolveCombat(simulation);
+            }
+            outcome.survived.reserve(participant_ids_owners.size());
+            outcome.health.reserve(participant_ids_owners.size());
+            for (const auto& [obj_id, owner] : participant_ids_owners) {
+                auto obj = simulation.objects->get(obj_id);
+                outcome.survived.push_back(obj && SurvivedCombat(*obj, simulation));
+                outcome.health.push_back(obj ? CombatParticipantState(*obj).current_health : 0.0f);
+            }
+        });
+    }
+    batch.Wait();
+
+    retval.num_simulations = num_simulations;
+    for (auto empire_id : combat_info.empire_ids)
+        retval.empire_survival[empire_id] = 0.0f;
+    const float weight = 1.0f / static_cast<float>(num_simulations);
+
+    for (const auto& outcome : outcomes) {
+        std::set<int> surviving_empire_ids;
+        for (std::size_t idx = 0; idx < participant_ids_owners.size(); ++idx) {
+            const auto& [obj_id, owner] = participant_ids_owners[idx];
+            retval.object_survival[obj_id] += outcome.survived[idx] ? weight : 0.0f;
+            retval.object_health[obj_id] += outcome.health[idx] * weight;
+            if (outcome.survived[idx])
+                surviving_empire_ids.insert(owner);
+        }
+        for (int empire_id : surviving_empire_ids)
+            retval.empire_survival[empire_id] += weight;
+    }
+
+    return retval;
+}
@@ -24,6 +24,10 @@ public:
     /** Returns System object in this CombatInfo's objects if one exists with id system_id. */
     std::shared_ptr<System> GetSystem();
 
+    /** Returns a copy of this CombatInfo whose objects are clones of this
+      * one's, so that resolving it doesn't change this one's objects. */
+    CombatInfo CloneForSimulation() const;
+
     const Universe&                                universe{GetUniverse()}; // universe in which combat occurs, used for general info getting, but not object state info
     const EmpireManager::const_container_type&     empires{const_cast<const EmpireManager&>(::Empires()).GetEmpires()}; // map from ID to empires, may include empires not actually participating in this combat
     const Universe::EmpireObjectVisibilityTurnMap& empire_object_vis_turns{GetUniverse().GetEmpireObjectVisibilityTurnMap()};
@@ -63,6 +67,20 @@ private:
 /** Auto-resolves a battle. */
 void AutoResolveCombat(CombatInfo& combat_info);
 
+/** Aggregate outcomes of resolving the same combat several times. */
+struct FO_COMMON_API CombatSimulationResults {
+    int                     num_simulations = 0;
+    std::map<int, float>    object_survival;    ///< by object id, fraction of simulations after which the object was neither destroyed nor, for planets, left without defense, infrastructure and shields
+    std::map<int, float>    object_health;      ///< by object id, mean structure of ships, or defense, infrastructure and shields of planets, after combat
+    std::map<int, float>    empire_survival;    ///< by empire id, fraction of simulations after which any object of the empire in the combat survived
+};
+
+/** Resolves clones of the combat in \a combat_info \a num_simulations times,
+  * in parallel, without changing \a combat_info or its objects.  Simulation
+  * number i draws random numbers from a stream seeded with \a seed + i. */
+FO_COMMON_API CombatSimulationResults SimulateCombat(const CombatInfo& combat_info, int num_simulations,
+                                                     unsigned int seed);
+
 
 
 #endif
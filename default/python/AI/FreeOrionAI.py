@@ -1,6 +1,6 @@
 """The FreeOrionAI module contains the methods which can be made by the C game client;
 these methods in turn activate other portions of the python AI code."""
-from logging import debug, info, error, fatal
+from logging import debug, info, warning, error, fatal
 from functools import wraps
 
 from common.configure_logging import redirect_logging_to_freeorion_logger
@@ -265,6 +265,7 @@ def generateOrders():  # pylint: disable=invalid-name
 
     # This code block is required for correct AI work.
     info("Meter / Resource Pool updating...")
+    fo.beginTurnPhase("meter_update")
     fo.initMeterEstimatesDiscrepancies()
     fo.updateMeterEstimates(False)
     fo.updateResourcePools()
@@ -343,12 +344,17 @@ def generateOrders():  # pylint: disable=invalid-name
                    ]
 
     for action in action_list:
+        if fo.turnBudgetExceeded():
+            warning("Turn budget exceeded, skipping %s and later AI modules" % action.__name__)
+            break
+        fo.beginTurnPhase(action.__name__)
         try:
             main_timer.start(action.__name__)
             action()
             main_timer.stop()
         except Exception as e:
             error("Exception %s while trying to %s" % (e, action.__name__), exc_info=True)
+    fo.beginTurnPhase("finish_turn")
     main_timer.stop_print_and_clear()
     turn_timer.stop_print_and_clear()
 
@@ -384,6 +384,26 @@ class MeterTypeStringPair:
         ...
 
 
+class ObjectIDBitmap:
+    def __contains__(self, number: int) -> bool:
+        ...
+
+    def __iter__(self) -> iter:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def count(self, number: int) -> int:
+        ...
+
+    def empty(self) -> bool:
+        ...
+
+    def size(self) -> int:
+        ...
+
+
 class Order:
     @property
     def empireID(self):
@@ -630,6 +650,10 @@ class TargetIDAccountingMapMap:
         ...
 
 
+class TurnBudgetExceeded(BaseException):
+    ...
+
+
 class UnlockableItem:
     @property
     def name(self)-> str:
@@ -723,6 +747,24 @@ class buildingType:
         ...
 
 
+class combatSimulationResults:
+    @property
+    def empireSurvival(self)-> IntFltMap:
+        ...
+
+    @property
+    def numSimulations(self)-> int:
+        ...
+
+    @property
+    def objectHealth(self)-> IntFltMap:
+        ...
+
+    @property
+    def objectSurvival(self)-> IntFltMap:
+        ...
+
+
 class diplomaticMessage:
     @property
     def recipient(self)-> int:
@@ -1021,6 +1063,52 @@ class meter:
         """
 
 
+class objectSnapshot:
+    @property
+    def ids(self)-> memoryview:
+        """
+        The ids of the objects in this snapshot, as an int array indexed by handle.
+        """
+
+    def __len__(self) -> int:
+        ...
+
+    def currentMeterValues(self, obj: object, meter_type: meterType) -> memoryview:
+        """
+        Returns a float array of the current values of the given meter (meterType) of the objects with each of the listed handles, 0 for objects without that meter.
+        """
+
+    def handle(self, number: int) -> int:
+        """
+        Returns the handle (int) of the object with the given id (int), or -1 if it isn't in this snapshot.
+        """
+
+    def handles(self, obj: object) -> memoryview:
+        """
+        Returns an int array of the handles, as handle returns, of the objects with each of the listed ids.
+        """
+
+    def initialMeterValues(self, obj: object, meter_type: meterType) -> memoryview:
+        """
+        Returns a float array of the initial values of the given meter (meterType) of the objects with each of the listed handles, 0 for objects without that meter.
+        """
+
+    def object(self, number: int) -> universeObject:
+        """
+        Returns the object (universeObject) with the given handle (int), or None. It stays valid for as long as this snapshot is kept.
+        """
+
+    def owners(self, obj: object) -> memoryview:
+        """
+        Returns an int array of the owners of the objects with each of the listed handles.
+        """
+
+    def systemIDs(self, obj: object) -> memoryview:
+        """
+        Returns an int array of the system ids of the objects with each of the listed handles.
+        """
+
+
 class policy:
     @property
     def category(self):
@@ -1613,12 +1701,27 @@ class universe:
     def systemIDs(self)-> IntVec:
         ...
 
-    def destroyedObjectIDs(self, number: int) -> IntSet:
+    def buildingColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known buildings, each an array in one memoryview.
+        """
+
+    def destroyedObjectIDs(self, number: int) -> ObjectIDBitmap:
         ...
 
     def dump(self) -> None:
         ...
 
+    def fieldColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known fields, each an array in one memoryview.
+        """
+
+    def fleetColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known fleets, each an array in one memoryview.
+        """
+
     def getBuilding(self, number: int) -> building:
         ...
 
@@ -1662,12 +1765,42 @@ class universe:
         If two system ids are passed or both objects are within a system, return the jump distance between the two systems. If one object (e.g. a fleet) is on a starlane, then calculate the jump distance from both ends of the starlane to the target system and return the smaller one.
         """
 
+    def jumpDistanceMatrix(self, obj1: object, obj2: object) -> memoryview:
+        """
+        Returns a 2D int array of the jump distances, as jumpDistance returns, from each of the first listed objects (rows) to each of the second listed objects (columns), computed in parallel.
+        """
+
+    def jumpDistancesFrom(self, number: int, obj: object) -> memoryview:
+        """
+        Returns an int array of the jump distances, as jumpDistance returns, from object (number) to each of the listed objects, computed in parallel.
+        """
+
     def leastJumpsPath(self, number1: int, number2: int, number3: int) -> IntVec:
         ...
 
+    def leastJumpsPaths(self, number1: int, obj: object, number2: int) -> tuple:
+        """
+        Returns the least jumps paths, as leastJumpsPath finds them, from System (number1) to each of the listed Systems known to Empire (number2), computed in parallel, as a tuple of arrays: the System ids of all paths in order, the offset of each path's first System in those plus the end of the last path, and the path jumps, -1 where there is no path.
+        """
+
     def linearDistance(self, number1: int, number2: int) -> float:
         ...
 
+    def objectSnapshot(self) -> objectSnapshot:
+        """
+        Returns a snapshot (objectSnapshot) of the known objects, that gives each a handle for this turn. The same snapshot is returned until the turn or the number of objects changes.
+        """
+
+    def planetColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions, species and current and initial values of the listed meters (meterType) of all known planets, each an array in one memoryview.
+        """
+
+    def shipColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions, species and current and initial values of the listed meters (meterType) of all known ships, each an array in one memoryview.
+        """
+
     def shortestNonHostilePath(self, number1: int, number2: int, number3: int) -> IntVec:
         """
         Shortest sequence of System ids and distance from System (number1) to System (number2) with no hostile Fleets as determined by visibility of Empire (number3).  (number3) must be a valid empire.
@@ -1679,11 +1812,26 @@ class universe:
     def shortestPathDistance(self, number1: int, number2: int) -> float:
         ...
 
+    def shortestPathDistanceMatrix(self, obj1: object, obj2: object) -> memoryview:
+        """
+        Returns a 2D float array of the shortest path distances, as shortestPathDistance returns, from each of the first listed objects (rows) to each of the second listed objects (columns), computed in parallel.
+        """
+
+    def shortestPaths(self, number1: int, obj: object, number2: int) -> tuple:
+        """
+        Returns the shortest paths, as shortestPath finds them, from System (number1) to each of the listed Systems known to Empire (number2), computed in parallel, as a tuple of arrays: the System ids of all paths in order, the offset of each path's first System in those plus the end of the last path, and the path distances, -1 where there is no path.
+        """
+
     def statRecords(self) -> StatRecordsMap:
         """
         Empire statistics recorded by the server each turn. Indexed first by staistic name (string), then by empire id (int), then by turn number (int), pointing to the statisic value (double).
         """
 
+    def systemColumns(self, obj: object) -> dict:
+        """
+        Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known systems, each an array in one memoryview.
+        """
+
     def systemHasStarlane(self, number1: int, number2: int) -> bool:
         ...
 
@@ -2682,6 +2830,12 @@ def appendFleetMoveOrder(number1: int, number2: int)  -> int:
     """
 
 
+def beginTurnPhase(string: str)  -> None:
+    """
+    Starts timing the named (string) phase of order generation, ending the previous one. Phase timings are reported to the server after each turn.
+    """
+
+
 def currentTurn()  -> int:
     """
     Returns the current game turn (int).
@@ -2977,6 +3131,12 @@ def issueScrapOrder(number: int)  -> int:
     """
 
 
+def pathfinderStatistics()  -> dict:
+    """
+    Returns a dict of the pathfinding queries made by this AI client since it started: queries, a dict from the kind of query (string) to a tuple of their count (int) and total milliseconds (float), and the distance cache's cacheHits (int), cacheMisses (int), rowsComputed (int) and rowsComputedMs (float). Subtract the values from an earlier call to get the queries made since then.
+    """
+
+
 def playerEmpireID(number: int)  -> int:
     """
     Returns the empire ID (int) of the player with the specified player ID (int).
@@ -3036,6 +3196,12 @@ def setSaveStateString(string: str)  -> None:
     """
 
 
+def simulateCombat(number1: int, number2: int, number3: int)  -> combatSimulationResults:
+    """
+    Resolves the combat that would occur at the system with id systemID (int) between the ships and planets there that this client knows of, numSimulations (int) times, in parallel and without changing the universe, using random seeds seed (int), seed + 1 and so on. Returns a combatSimulationResults with the fraction of simulations in which each object (objectSurvival) and each empire (empireSurvival) survived and the mean structure or defense, infrastructure and shields of each object afterwards (objectHealth).
+    """
+
+
 def techs()  -> StringVec:
     """
     Returns the names of all techs (StringVec).
@@ -3048,6 +3214,18 @@ def techsInCategory(string: str)  -> StringVec:
     """
 
 
+def turnBudgetExceeded()  -> bool:
+    """
+    Returns True (boolean) if this turn's order generation budget is spent. Shortly after, TurnBudgetExceeded is raised, ending order generation and sending the orders issued so far.
+    """
+
+
+def turnTimeRemaining()  -> float:
+    """
+    Returns the seconds (float) left of this turn's order generation budget, or infinity if there is no budget.
+    """
+
+
 def updateMeterEstimates(boolean: bool)  -> None:
     ...
 
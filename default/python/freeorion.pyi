@@ -409,6 +409,26 @@ class MonsterFleetPlan:
         ...
 
 
+class ObjectIDBitmap:
+    def __contains__(self, number: int) -> bool:
+        ...
+
+    def __iter__(self) -> iter:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def count(self, number: int) -> int:
+        ...
+
+    def empty(self) -> bool:
+        ...
+
+    def size(self) -> int:
+        ...
+
+
 class PairIntInt_IntMap:
     def __contains__(self, obj: object) -> bool:
         ...
@@ -1626,7 +1646,7 @@ class universe:
     def systemIDs(self)-> IntVec:
         ...
 
-    def destroyedObjectIDs(self, number: int) -> IntSet:
+    def destroyedObjectIDs(self, number: int) -> ObjectIDBitmap:
         ...
 
     def dump(self) -> None:
@@ -2713,6 +2733,12 @@ def create_planet(planet_size: planetSize, planet_type: planetType, number1: int
     ...
 
 
+def create_planets(obj1: object, obj2: object, obj3: object, obj4: object)  -> list:
+    """
+    Creates unnamed planets with the sizes (planetSize) and types (planetType) in the orbits (int) of the systems (int) in the four sequences, and returns a list of their ids (int), each invalid_object() if that planet could not be created.
+    """
+
+
 def create_ship(string1: str, string2: str, string3: str, number: int)  -> int:
     ...
 
@@ -2721,10 +2747,22 @@ def create_system(star_type: starType, string: str, floating_number1: float, flo
     ...
 
 
+def create_systems(obj1: object, obj2: object, obj3: object)  -> list:
+    """
+    Creates unnamed systems with the star types (starType) at the x and y coordinates (float) in the three sequences, and returns a list of their ids (int), each invalid_object() if that system could not be created.
+    """
+
+
 def current_turn()  -> int:
     ...
 
 
+def delaunay_triangulation(obj: object)  -> list:
+    """
+    Returns a list of the triangles of a Delaunay triangulation of the sequence of (x, y) positions, each a tuple of the indices of its corners in the sequence.
+    """
+
+
 def design_create(string1: str, string2: str, string3: str, item_list: list, string4: str, string5: str, boolean: bool)  -> bool:
     ...
 
@@ -2977,6 +3015,12 @@ def load_unlockable_item_list()  -> list:
     ...
 
 
+def nearest_neighbours(obj: object, number: int)  -> list:
+    """
+    Returns a list with, for each of the sequence of (x, y) positions, a list of the indices of the k (int) others nearest to it, nearest first.
+    """
+
+
 def objs_get_systems(item_list: list)  -> list:
     ...
 
@@ -3097,6 +3141,12 @@ def sys_add_starlane(number1: int, number2: int)  -> None:
     ...
 
 
+def sys_default_num_orbits()  -> int:
+    """
+    Returns the number of orbits (int) of newly created systems.
+    """
+
+
 def sys_free_orbits(number: int)  -> list:
     ...
 
@@ -3137,6 +3187,12 @@ def sys_set_star_type(number: int, star_type: starType)  -> None:
     ...
 
 
+def systems_nearest_by_jumps(obj: object)  -> dict:
+    """
+    Returns a dict from the id of each system connected by starlanes to any of the systems in the sequence of ids, to a list of those systems the fewest jumps from it.
+    """
+
+
 def systems_within_jumps_unordered(number: int, item_list: list)  -> list:
     """
     Return all systems within ''jumps'' of the systems with ids ''sys_ids''
@@ -11,11 +11,29 @@ import freeorion as fo
 from universe_tables import MONSTER_FREQUENCY
 
 
+def turn_event_triggers():
+    """
+    Declare the functions of this module that the server calls each turn, and when.
+
+    Maps each function name to a dict with any of the keys "first" and "last",
+    the range of turns on which the function may be called, "every", the
+    interval in turns from "first", and "turns", a list of the only turns on
+    which it is called. The server only calls into Python on turns that some
+    function is triggered on, and logs the time each function takes.
+    Without this function, execute_turn_events is called every turn.
+    """
+    return {
+        "create_fields": {"every": 1},
+        "create_monsters": {"every": 1},
+    }
+
+
 def execute_turn_events():
     print("Executing turn events for turn", fo.current_turn())
+    return all([create_fields(), create_monsters()])
 
-    # creating fields
-    systems = fo.get_systems()
+
+def create_fields():
     radius = fo.get_universe_width() / 2.0
     field_types = [
         "FLD_MOLECULAR_CLOUD",
@@ -37,7 +55,11 @@ def execute_turn_events():
         if fo.create_field(field_type, x, y, size) == fo.invalid_object():
             print("Turn events: couldn't create new field", file=sys.stderr)
 
-    # creating monsters
+    return True
+
+
+def create_monsters():
+    systems = fo.get_systems()
     gsd = fo.get_galaxy_setup_data()
     monster_freq = MONSTER_FREQUENCY[gsd.monsterFrequency]
     # monster freq ranges from 1/30 (= one monster per 30 systems) to 1/3 (= one monster per 3 systems)
@@ -554,18 +554,8 @@ def home_system_layout(home_systems, systems):
     """
     # for each system found nearest home systems
     # maybe multiple if home worlds placed on the same jump distnace
-    system_hs = {}
-    for system in systems:
-        nearest_hs = set()
-        nearest_dist = None
-        for hs in home_systems:
-            dist = fo.jump_distance(system, hs)
-            if nearest_dist is None or nearest_dist > dist:
-                nearest_dist = dist
-                nearest_hs = {hs}
-            elif nearest_dist == dist:
-                nearest_hs.add(hs)
-        system_hs[system] = nearest_hs
+    nearest_home_systems = fo.systems_nearest_by_jumps(home_systems)
+    system_hs = {system: set(nearest_home_systems.get(system, [])) for system in systems}
 
     # homeworld is connected to the other
     # if both are nearest for some system
@@ -102,17 +102,29 @@ def calc_planet_type(star_type, orbit, planet_size):
         return fo.planetType.unknown
 
 
-def generate_a_planet(system, star_type, orbit, planet_density, galaxy_shape):
+def plan_a_planet(star_type, orbit, planet_density, galaxy_shape):
     """
-    Place a planet in an orbit of a system. Return True on success
+    Decide whether to place a planet in an orbit of a system with the star type.
+    Return its size and type, or None if there should be no planet.
     """
     planet_size = calc_planet_size(star_type, orbit, planet_density, galaxy_shape)
     if planet_size not in planet_sizes:
-        return False
-    # ok, we want a planet, determine planet type and generate the planet
+        return None
+    # ok, we want a planet, determine planet type
     planet_type = calc_planet_type(star_type, orbit, planet_size)
     if planet_type == fo.planetType.unknown:
+        return None
+    return planet_size, planet_type
+
+
+def generate_a_planet(system, star_type, orbit, planet_density, galaxy_shape):
+    """
+    Place a planet in an orbit of a system. Return True on success
+    """
+    planned = plan_a_planet(star_type, orbit, planet_density, galaxy_shape)
+    if planned is None:
         return False
+    planet_size, planet_type = planned
     if fo.create_planet(planet_size, planet_type, system, orbit, "") == fo.invalid_object():
         # create planet failed, report an error
         util.report_error("Python generate_systems: create planet in system %d failed" % system)
@@ -78,19 +78,19 @@ def can_have_no_planets(star_type):
 def generate_systems(pos_list, gsd):
     """
     Generates and populates star systems at all positions in specified list.
+
+    Star types and planets are all decided first, in the same order as they
+    would be when creating each system in turn, and then created with one call
+    for all systems and one for all planets.
     """
-    sys_list = []
-    for position in pos_list:
+    system_star_types = []
+    planned_planets = []  # (index into pos_list, planet size, planet type, orbit)
+    num_orbits = fo.sys_default_num_orbits()
+    for index, position in enumerate(pos_list):
         star_type = pick_star_type(gsd.age)
-        system = fo.create_system(star_type, "", position[0], position[1])
-        if system == fo.invalid_object():
-            # create system failed, report an error and try to continue with next position
-            util.report_error("Python generate_systems: create system at position (%f, %f) failed"
-                              % (position[0], position[1]))
-            continue
-        sys_list.append(system)
+        system_star_types.append(star_type)
 
-        orbits = list(range(fo.sys_get_num_orbits(system)))
+        orbits = list(range(num_orbits))
 
         if not planets.can_have_planets(star_type, orbits, gsd.planet_density, gsd.shape):
             continue
@@ -103,7 +103,9 @@ def generate_systems(pos_list, gsd):
         at_least_one_planet = False
         random.shuffle(orbits)
         for orbit in orbits:
-            if planets.generate_a_planet(system, star_type, orbit, gsd.planet_density, gsd.shape):
+            planned = planets.plan_a_planet(star_type, orbit, gsd.planet_density, gsd.shape)
+            if planned is not None:
+                planned_planets.append((index,) + planned + (orbit,))
                 at_least_one_planet = True
 
         if at_least_one_planet or can_have_no_planets(star_type):
@@ -111,11 +113,33 @@ def generate_systems(pos_list, gsd):
 
         recursion_limit = 1000
         for _, orbit in product(range(recursion_limit), orbits):
-            if planets.generate_a_planet(system, star_type, orbit, gsd.planet_density, gsd.shape):
+            planned = planets.plan_a_planet(star_type, orbit, gsd.planet_density, gsd.shape)
+            if planned is not None:
+                planned_planets.append((index,) + planned + (orbit,))
                 break
         else:
             # Intentionally non-modal.  Should be a warning.
-            print(("Python generate_systems: place planets in system %d at position (%.2f, %.2f) failed"
-                   % (system, position[0], position[1])), file=sys.stderr)
+            print(("Python generate_systems: place planets in system at position (%.2f, %.2f) failed"
+                   % (position[0], position[1])), file=sys.stderr)
+
+    systems = fo.create_systems(system_star_types, [pos[0] for pos in pos_list], [pos[1] for pos in pos_list])
+    sys_list = []
+    for system, position in zip(systems, pos_list):
+        if system == fo.invalid_object():
+            # create system failed, report an error and continue with the other systems
+            util.report_error("Python generate_systems: create system at position (%f, %f) failed"
+                              % (position[0], position[1]))
+            continue
+        sys_list.append(system)
+
+    planned_planets = [planet for planet in planned_planets if systems[planet[0]] != fo.invalid_object()]
+    planet_systems = [systems[index] for index, _, _, _ in planned_planets]
+    created_planets = fo.create_planets([size for _, size, _, _ in planned_planets],
+                                        [planet_type for _, _, planet_type, _ in planned_planets],
+                                        planet_systems,
+                                        [orbit for _, _, _, orbit in planned_planets])
+    for planet, system in zip(created_planets, planet_systems):
+        if planet == fo.invalid_object():
+            util.report_error("Python generate_systems: create planet in system %d failed" % system)
 
     return sys_list
@@ -6,6 +6,7 @@
 #include "../Empire/Diplomacy.h"
 #include "../util/Logger.h"
 #include "../util/ModeratorAction.h"
+#include "../util/ObjectDeltaBase.h"
 #include "../util/SaveGamePreviewUtils.h"
 #include "../universe/Species.h"
 #include "../universe/Universe.h"
@@ -29,16 +30,113 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <streambuf>
+#include <string_view>
 #include <map>
 
 
 namespace {
     const std::string DUMMY_EMPTY_MESSAGE = "Lathanda";
+
+    /** Stream buffer that archives write into directly, growing a shared
+      * char array which the resulting Message adopts without copying. */
+    class MessageOutBuffer : public std::streambuf {
+    public:
+        std::size_t Size() const
+        { return static_cast<std::size_t>(pptr() - pbase()); }
+
+        Message ToMessage(Message::MessageType type) {
+            const auto size = Size();
+            setp(nullptr, nullptr);
+            m_capacity = 0;
+            return Message(type, std::move(m_buffer), size);
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+            Reserve(Size() + 1);
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+            return ch;
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize count) override {
+            if (count <= 0)
+                return 0;
+            Reserve(Size() + static_cast<std::size_t>(count));
+            std::memcpy(pptr(), s, static_cast<std::size_t>(count));
+            pbump(static_cast<int>(count));
+            return count;
+        }
+
+    private:
+        static constexpr std::size_t INITIAL_CAPACITY = 4096;
+
+        void Reserve(std::size_t min_capacity) {
+            if (min_capacity <= m_capacity)
+                return;
+            const auto size = Size();
+            const auto capacity = std::max({min_capacity, m_capacity * 2, INITIAL_CAPACITY});
+            boost::shared_array<char> buffer(new char[capacity]);
+            if (size > 0)
+                std::memcpy(buffer.get(), m_buffer.get(), size);
+            m_buffer = std::move(buffer);
+            m_capacity = capacity;
+            setp(m_buffer.get(), m_buffer.get() + capacity);
+            pbump(static_cast<int>(size));
+        }
+
+        boost::shared_array<char> m_buffer;
+        std::size_t               m_capacity = 0;
+    };
+
+    /** Stream for serializing a message's contents straight into its buffer. */
+    class MessageOStream : public std::ostream {
+    public:
+        MessageOStream() :
+            std::ostream(nullptr)
+        { rdbuf(&m_buffer); }
+
+        Message ToMessage(Message::MessageType type)
+        { return m_buffer.ToMessage(type); }
+
+    private:
+        MessageOutBuffer m_buffer;
+    };
+
+    /** Read-only stream buffer over an existing char array. */
+    class MessageInBuffer : public std::streambuf {
+    public:
+        MessageInBuffer(const char* data, std::size_t size) {
+            char* begin = const_cast<char*>(data); // get area is never written to
+            setg(begin, begin, begin + size);
+        }
+    };
+
+    /** Stream for deserializing a message's contents straight from its
+      * buffer, without first copying them into a std::string. */
+    class MessageIStream : public std::istream {
+    public:
+        explicit MessageIStream(const Message& msg) :
+            std::istream(nullptr),
+            m_buffer(msg.Data(), msg.Size())
+        { rdbuf(&m_buffer); }
+
+    private:
+        MessageInBuffer m_buffer;
+    };
 }
 
+bool IsXMLMessage(const Message& msg)
+{ return msg.Size() >= 5 && !std::strncmp(msg.Data(), "<?xml", 5); }
+
 ////////////////////////////////////////////////
 // Free Functions
 ////////////////////////////////////////////////
@@ -61,6 +159,14 @@ Message::Message(MessageType type, const std::string& text) :
     m_message_text(new char[text.size()])
 { std::copy(text.begin(), text.end(), m_message_text.get()); }
 
+Message::Message(MessageType type, boost::shared_array<char> text, std::size_t size,
+                 bool compressed) :
+    m_type(type),
+    m_message_size(static_cast<int>(size)),
+    m_message_text(std::move(text)),
+    m_compressed(compressed)
+{}
+
 Message::MessageType Message::Type() const
 { return m_type; }
 
@@ -73,6 +179,9 @@ const char* Message::Data() const
 std::string Message::Text() const
 { return std::string(m_message_text.get(), m_message_size); }
 
+bool Message::Compressed() const
+{ return m_compressed; }
+
 void Message::Resize(std::size_t size) {
     m_message_size = size;
     m_message_text.reset(new char[m_message_size]);
@@ -85,12 +194,14 @@ void Message::Swap(Message& rhs) {
     std::swap(m_type, rhs.m_type);
     std::swap(m_message_size, rhs.m_message_size);
     std::swap(m_message_text, rhs.m_message_text);
+    std::swap(m_compressed, rhs.m_compressed);
 }
 
 void Message::Reset() {
     m_type = MessageType::UNDEFINED;
     m_message_size = 0;
     m_message_text.reset();
+    m_compressed = false;
 }
 
 bool operator==(const Message& lhs, const Message& rhs) {
@@ -106,57 +217,112 @@ void swap(Message& lhs, Message& rhs)
 { lhs.Swap(rhs); }
 
 void BufferToHeader(const Message::HeaderBuffer& buffer, Message& message) {
-    message.m_type = static_cast<Message::MessageType>(buffer[Message::Parts::TYPE]);
+    const int type = buffer[Message::Parts::TYPE];
+    message.m_type = static_cast<Message::MessageType>(type & ~Message::COMPRESSED_HEADER_FLAG);
+    message.m_compressed = (type & Message::COMPRESSED_HEADER_FLAG) != 0;
     message.m_message_size = buffer[Message::Parts::SIZE];
 }
 
 void HeaderToBuffer(const Message& message, Message::HeaderBuffer& buffer) {
-    buffer[Message::Parts::TYPE] = int(message.Type());
+    buffer[Message::Parts::TYPE] = int(message.Type()) |
+        (message.Compressed() ? Message::COMPRESSED_HEADER_FLAG : 0);
     buffer[Message::Parts::SIZE] = int(message.Size());
 }
 
+namespace {
+    // compressed bodies start with the uncompressed size, least significant byte first
+    constexpr std::size_t COMPRESSED_SIZE_PREFIX = 4;
+}
+
+Message CompressMessage(const Message& message) {
+    if (message.Compressed())
+        return message;
+
+    const auto size = message.Size();
+    uLongf compressed_size = compressBound(static_cast<uLong>(size));
+    boost::shared_array<char> buffer(new char[COMPRESSED_SIZE_PREFIX + compressed_size]);
+    for (std::size_t idx = 0; idx < COMPRESSED_SIZE_PREFIX; ++idx)
+        buffer[idx] = static_cast<char>((size >> (8 * idx)) & 0xFF);
+
+    const int result = compress2(reinterpret_cast<Bytef*>(buffer.get() + COMPRESSED_SIZE_PREFIX),
+                                 &compressed_size,
+                                 reinterpret_cast<const Bytef*>(message.Data()),
+                                 static_cast<uLong>(size), Z_BEST_SPEED);
+    if (result != Z_OK) {
+        ErrorLogger() << "CompressMessage failed to compress " << message.Type()
+                      << " message: zlib error " << result;
+        return message;
+    }
+
+    return Message(message.Type(), std::move(buffer),
+                   COMPRESSED_SIZE_PREFIX + compressed_size, true);
+}
+
+Message DecompressMessage(const Message& message) {
+    if (!message.Compressed())
+        return message;
+
+    if (message.Size() < COMPRESSED_SIZE_PREFIX)
+        throw std::runtime_error("DecompressMessage: compressed message too short");
+
+    std::size_t size = 0;
+    for (std::size_t idx = 0; idx < COMPRESSED_SIZE_PREFIX; ++idx)
+        size |= static_cast<std::size_t>(static_cast<unsigned char>(message.Data()[idx])) << (8 * idx);
+
+    boost::shared_array<char> buffer(new char[std::max<std::size_t>(size, 1)]);
+    uLongf decompressed_size = static_cast<uLongf>(size);
+    const int result = uncompress(reinterpret_cast<Bytef*>(buffer.get()), &decompressed_size,
+                                  reinterpret_cast<const Bytef*>(message.Data() + COMPRESSED_SIZE_PREFIX),
+                                  static_cast<uLong>(message.Size() - COMPRESSED_SIZE_PREFIX));
+    if (result != Z_OK || decompressed_size != size)
+        throw std::runtime_error("DecompressMessage: corrupt compressed message, zlib error " +
+                                 std::to_string(result));
+
+    return Message(message.Type(), std::move(buffer), size);
+}
+
 ////////////////////////////////////////////////
 // Message named ctors
 ////////////////////////////////////////////////
 Message ErrorMessage(const std::string& problem, bool fatal/* = true*/,
                      int player_id/* = Networking::INVALID_PLAYER_ID*/) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(problem)
            << BOOST_SERIALIZATION_NVP(fatal)
            << BOOST_SERIALIZATION_NVP(player_id);
     }
-    return Message(Message::MessageType::ERROR_MSG, os.str());
+    return os.ToMessage(Message::MessageType::ERROR_MSG);
 }
 
 Message HostSPGameMessage(const SinglePlayerSetupData& setup_data) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         std::string client_version_string = FreeOrionVersionString();
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(setup_data)
            << BOOST_SERIALIZATION_NVP(client_version_string);
     }
-    return Message(Message::MessageType::HOST_SP_GAME, os.str());
+    return os.ToMessage(Message::MessageType::HOST_SP_GAME);
 }
 
 Message HostMPGameMessage(const std::string& host_player_name)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         std::string client_version_string = FreeOrionVersionString();
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(host_player_name)
            << BOOST_SERIALIZATION_NVP(client_version_string);
     }
-    return Message(Message::MessageType::HOST_MP_GAME, os.str());
+    return os.ToMessage(Message::MessageType::HOST_MP_GAME);
 }
 
 Message JoinGameMessage(const std::string& player_name,
                         Networking::ClientType client_type,
                         boost::uuids::uuid cookie) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         std::string client_version_string = FreeOrionVersionString();
@@ -165,7 +331,7 @@ Message JoinGameMessage(const std::string& player_name,
            << BOOST_SERIALIZATION_NVP(client_version_string)
            << BOOST_SERIALIZATION_NVP(cookie);
     }
-    return Message(Message::MessageType::JOIN_GAME, os.str());
+    return os.ToMessage(Message::MessageType::JOIN_GAME);
 }
 
 Message HostIDMessage(int host_player_id) {
@@ -181,7 +347,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
                          GalaxySetupData galaxy_setup_data,
                          bool use_binary_serialization)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         if (use_binary_serialization) {
             freeorion_bin_oarchive oa(os);
@@ -217,7 +383,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::MessageType::GAME_START, os.str());
+    return os.ToMessage(Message::MessageType::GAME_START);
 }
 
 Message GameStartMessage(bool single_player_game, int empire_id,
@@ -229,7 +395,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
                          GalaxySetupData galaxy_setup_data,
                          bool use_binary_serialization)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         if (use_binary_serialization) {
             freeorion_bin_oarchive oa(os);
@@ -286,7 +452,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::MessageType::GAME_START, os.str());
+    return os.ToMessage(Message::MessageType::GAME_START);
 }
 
 Message GameStartMessage(bool single_player_game, int empire_id,
@@ -298,7 +464,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
                          GalaxySetupData galaxy_setup_data,
                          bool use_binary_serialization)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         if (use_binary_serialization) {
             freeorion_bin_oarchive oa(os);
@@ -320,7 +486,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
             bool save_state_string_available = (save_state_string != nullptr);
             oa << BOOST_SERIALIZATION_NVP(save_state_string_available);
             if (save_state_string_available)
-                oa << boost::serialization::make_nvp("save_state_string", *save_state_string);
+                SerializeCompressible(oa, *save_state_string);
             galaxy_setup_data.encoding_empire = empire_id;
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         } else {
@@ -355,7 +521,7 @@ Message GameStartMessage(bool single_player_game, int empire_id,
             oa << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
         }
     }
-    return Message(Message::MessageType::GAME_START, os.str());
+    return os.ToMessage(Message::MessageType::GAME_START);
 }
 
 Message HostSPAckMessage(int player_id)
@@ -366,75 +532,92 @@ Message HostMPAckMessage(int player_id)
 
 Message JoinAckMessage(int player_id, boost::uuids::uuid cookie)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(player_id)
            << BOOST_SERIALIZATION_NVP(cookie);
     }
-    return Message(Message::MessageType::JOIN_GAME, os.str());
+    return os.ToMessage(Message::MessageType::JOIN_GAME);
 }
 
-Message TurnOrdersMessage(const OrderSet& orders, const SaveGameUIData& ui_data) {
-    std::ostringstream os;
+namespace {
+    template <typename Archive>
+    void SerializeTurnOrders(Archive& oa, const OrderSet& orders, const SaveGameUIData* ui_data,
+                             const std::string* save_state_string)
     {
-        freeorion_xml_oarchive oa(os);
         Serialize(oa, orders);
-        bool ui_data_available = true;
-        bool save_state_string_available = false;
-        oa << BOOST_SERIALIZATION_NVP(ui_data_available)
-           << BOOST_SERIALIZATION_NVP(ui_data)
-           << BOOST_SERIALIZATION_NVP(save_state_string_available);
+        bool ui_data_available = (ui_data != nullptr);
+        oa << BOOST_SERIALIZATION_NVP(ui_data_available);
+        if (ui_data_available)
+            oa << boost::serialization::make_nvp("ui_data", *ui_data);
+        bool save_state_string_available = (save_state_string != nullptr);
+        oa << BOOST_SERIALIZATION_NVP(save_state_string_available);
+        if (save_state_string_available) {
+            if constexpr (IsBinaryArchive<Archive>)
+                SerializeCompressible(oa, *save_state_string);
+            else
+                oa << boost::serialization::make_nvp("save_state_string", *save_state_string);
+        }
     }
-    return Message(Message::MessageType::TURN_ORDERS, os.str());
-}
 
-Message TurnOrdersMessage(const OrderSet& orders, const std::string& save_state_string) {
-    std::ostringstream os;
+    Message TurnOrdersMessageImpl(const OrderSet& orders, const SaveGameUIData* ui_data,
+                                  const std::string* save_state_string, bool use_binary_serialization)
     {
-        freeorion_xml_oarchive oa(os);
-        Serialize(oa, orders);
-        bool ui_data_available = false;
-        bool save_state_string_available = true;
-        oa << BOOST_SERIALIZATION_NVP(ui_data_available)
-           << BOOST_SERIALIZATION_NVP(save_state_string_available)
-           << BOOST_SERIALIZATION_NVP(save_state_string);
+        MessageOStream os;
+        {
+            if (use_binary_serialization) {
+                freeorion_bin_oarchive oa(os);
+                SerializeTurnOrders(oa, orders, ui_data, save_state_string);
+            } else {
+                freeorion_xml_oarchive oa(os);
+                SerializeTurnOrders(oa, orders, ui_data, save_state_string);
+            }
+        }
+        return os.ToMessage(Message::MessageType::TURN_ORDERS);
     }
-    return Message(Message::MessageType::TURN_ORDERS, os.str());
 }
 
+Message TurnOrdersMessage(const OrderSet& orders, const SaveGameUIData& ui_data,
+                          bool use_binary_serialization)
+{ return TurnOrdersMessageImpl(orders, &ui_data, nullptr, use_binary_serialization); }
+
+Message TurnOrdersMessage(const OrderSet& orders, const std::string& save_state_string,
+                          bool use_binary_serialization)
+{ return TurnOrdersMessageImpl(orders, nullptr, &save_state_string, use_binary_serialization); }
+
 Message TurnPartialOrdersMessage(const std::pair<OrderSet, std::set<int>>& orders_updates) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         Serialize(oa, orders_updates.first);
         oa << boost::serialization::make_nvp("deleted", orders_updates.second);
     }
-    return Message(Message::MessageType::TURN_PARTIAL_ORDERS, os.str());
+    return os.ToMessage(Message::MessageType::TURN_PARTIAL_ORDERS);
 }
 
 Message TurnTimeoutMessage(int timeout_remaining)
 { return Message(Message::MessageType::TURN_TIMEOUT, std::to_string(timeout_remaining)); }
 
 Message TurnProgressMessage(Message::TurnProgressPhase phase_id) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(phase_id);
     }
-    return Message(Message::MessageType::TURN_PROGRESS, os.str());
+    return os.ToMessage(Message::MessageType::TURN_PROGRESS);
 }
 
 Message PlayerStatusMessage(Message::PlayerStatus player_status,
                             int about_empire_id)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(player_status)
            << BOOST_SERIALIZATION_NVP(about_empire_id);
     }
-    return Message(Message::MessageType::PLAYER_STATUS, os.str());
+    return os.ToMessage(Message::MessageType::PLAYER_STATUS);
 }
 
 Message TurnUpdateMessage(int empire_id, int current_turn,
@@ -442,9 +625,10 @@ Message TurnUpdateMessage(int empire_id, int current_turn,
                           const SpeciesManager& species, CombatLogManager& combat_logs,
                           const SupplyManager& supply,
                           const std::map<int, PlayerInfo>& players,
+                          ObjectDeltaBase& delta_base, bool use_delta,
                           bool use_binary_serialization)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         if (use_binary_serialization) {
             freeorion_bin_oarchive oa(os);
@@ -454,7 +638,7 @@ Message TurnUpdateMessage(int empire_id, int current_turn,
             oa << BOOST_SERIALIZATION_NVP(species);
             SerializeIncompleteLogs(oa, combat_logs, 1);
             oa << BOOST_SERIALIZATION_NVP(supply);
-            Serialize(oa, universe);
+            SerializeDelta(oa, universe, delta_base, use_delta, current_turn);
             oa << BOOST_SERIALIZATION_NVP(players);
         } else {
             freeorion_xml_oarchive oa(os);
@@ -464,86 +648,114 @@ Message TurnUpdateMessage(int empire_id, int current_turn,
                << BOOST_SERIALIZATION_NVP(species);
             SerializeIncompleteLogs(oa, combat_logs, 1);
             oa << BOOST_SERIALIZATION_NVP(supply);
-            Serialize(oa, universe);
+            SerializeDelta(oa, universe, delta_base, use_delta, current_turn);
             oa << BOOST_SERIALIZATION_NVP(players);
         }
     }
-    return Message(Message::MessageType::TURN_UPDATE, os.str());
+    return os.ToMessage(Message::MessageType::TURN_UPDATE);
 }
 
 Message TurnPartialUpdateMessage(int empire_id, const Universe& universe,
-                                 bool use_binary_serialization) {
-    std::ostringstream os;
+                                 ObjectDeltaBase& delta_base, bool use_delta,
+                                 bool use_binary_serialization)
+{
+    // Only encode relative to a base that the recipient is known to have
+    // applied. Recipients apply partial updates in the order they are sent,
+    // so the base stays acknowledged after being replaced by this update.
+    const bool acknowledged = delta_base.acknowledged;
+    use_delta = use_delta && acknowledged && delta_base.turn != -1;
+    const int turn = delta_base.turn;
+
+    MessageOStream os;
     {
         if (use_binary_serialization) {
             freeorion_bin_oarchive oa(os);
             GlobalSerializationEncodingForEmpire() = empire_id;
-            Serialize(oa, universe);
+            oa << BOOST_SERIALIZATION_NVP(use_delta);
+            if (use_delta) {
+                oa << BOOST_SERIALIZATION_NVP(turn);
+                SerializeDelta(oa, universe, delta_base, true, turn);
+            } else {
+                Serialize(oa, universe);
+            }
         } else {
             freeorion_xml_oarchive oa(os);
             GlobalSerializationEncodingForEmpire() = empire_id;
-            Serialize(oa, universe);
+            oa << BOOST_SERIALIZATION_NVP(use_delta);
+            if (use_delta) {
+                oa << BOOST_SERIALIZATION_NVP(turn);
+                SerializeDelta(oa, universe, delta_base, true, turn);
+            } else {
+                Serialize(oa, universe);
+            }
         }
     }
-    return Message(Message::MessageType::TURN_PARTIAL_UPDATE, os.str());
+    delta_base.acknowledged = acknowledged;
+    return os.ToMessage(Message::MessageType::TURN_PARTIAL_UPDATE);
 }
 
 Message HostSaveGameInitiateMessage(const std::string& filename)
 { return Message(Message::MessageType::SAVE_GAME_INITIATE, filename); }
 
 Message ServerSaveGameCompleteMessage(const std::string& save_filename, int bytes_written) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(save_filename)
            << BOOST_SERIALIZATION_NVP(bytes_written);
     }
-    return Message(Message::MessageType::SAVE_GAME_COMPLETE, os.str());
+    return os.ToMessage(Message::MessageType::SAVE_GAME_COMPLETE);
 }
 
 Message DiplomacyMessage(const DiplomaticMessage& diplo_message) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(diplo_message);
     }
-    return Message(Message::MessageType::DIPLOMACY, os.str());
+    return os.ToMessage(Message::MessageType::DIPLOMACY);
 }
 
 Message DiplomaticStatusMessage(const DiplomaticStatusUpdateInfo& diplo_update) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(diplo_update.empire1_id)
            << BOOST_SERIALIZATION_NVP(diplo_update.empire2_id)
            << BOOST_SERIALIZATION_NVP(diplo_update.diplo_status);
     }
-    return Message(Message::MessageType::DIPLOMATIC_STATUS, os.str());
+    return os.ToMessage(Message::MessageType::DIPLOMATIC_STATUS);
 }
 
 Message EndGameMessage(Message::EndGameReason reason,
                        const std::string& reason_player_name/* = ""*/)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(reason)
            << BOOST_SERIALIZATION_NVP(reason_player_name);
     }
-    return Message(Message::MessageType::END_GAME, os.str());
+    return os.ToMessage(Message::MessageType::END_GAME);
 }
 
 Message AIEndGameAcknowledgeMessage()
 { return Message(Message::MessageType::AI_END_GAME_ACK, DUMMY_EMPTY_MESSAGE); }
 
+Message AITurnTimingsMessage(const std::string& timings)
+{ return Message(Message::MessageType::AI_TURN_TIMINGS, timings); }
+
+Message DebugCommandMessage(const std::string& command)
+{ return Message(Message::MessageType::DEBUG, command); }
+
 Message ModeratorActionMessage(const Moderator::ModeratorAction& action) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         const Moderator::ModeratorAction* mod_action = &action;
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(mod_action);
     }
-    return Message(Message::MessageType::MODERATOR_ACTION, os.str());
+    return os.ToMessage(Message::MessageType::MODERATOR_ACTION);
 }
 
 Message ShutdownServerMessage()
@@ -555,27 +767,27 @@ Message RequestSavePreviewsMessage(std::string relative_directory)
 
 /** returns the savegame previews to the client */
 Message DispatchSavePreviewsMessage(const PreviewInformation& previews) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(previews);
     }
-    return Message(Message::MessageType::DISPATCH_SAVE_PREVIEWS, os.str());
+    return os.ToMessage(Message::MessageType::DISPATCH_SAVE_PREVIEWS);
 }
 
 Message RequestCombatLogsMessage(const std::vector<int>& ids) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(ids);
     }
-    return Message(Message::MessageType::REQUEST_COMBAT_LOGS, os.str());
+    return os.ToMessage(Message::MessageType::REQUEST_COMBAT_LOGS);
 }
 
 Message DispatchCombatLogsMessage(const std::vector<std::pair<int, const CombatLog>>& logs,
                                   bool use_binary_serialization)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         try {
             if (use_binary_serialization) {
@@ -590,11 +802,11 @@ Message DispatchCombatLogsMessage(const std::vector<std::pair<int, const CombatL
         }
     }
 
-    return Message(Message::MessageType::DISPATCH_COMBAT_LOGS, os.str());
+    return os.ToMessage(Message::MessageType::DISPATCH_COMBAT_LOGS);
 }
 
 Message LoggerConfigMessage(int sender, const std::set<std::tuple<std::string, std::string, LogLevel>>& options) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         std::size_t size = options.size();
@@ -608,32 +820,32 @@ Message LoggerConfigMessage(int sender, const std::set<std::tuple<std::string, s
             oa << BOOST_SERIALIZATION_NVP(value);
         }
     }
-    return Message(Message::MessageType::LOGGER_CONFIG, os.str());
+    return os.ToMessage(Message::MessageType::LOGGER_CONFIG);
 }
 
 ////////////////////////////////////////////////
 // Multiplayer Lobby Message named ctors
 ////////////////////////////////////////////////
 Message LobbyUpdateMessage(const MultiplayerLobbyData& lobby_data) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(lobby_data);
     }
-    return Message(Message::MessageType::LOBBY_UPDATE, os.str());
+    return os.ToMessage(Message::MessageType::LOBBY_UPDATE);
 }
 
 Message ServerLobbyUpdateMessage(const MultiplayerLobbyData& lobby_data) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(lobby_data);
     }
-    return Message(Message::MessageType::LOBBY_UPDATE, os.str());
+    return os.ToMessage(Message::MessageType::LOBBY_UPDATE);
 }
 
 Message ChatHistoryMessage(const std::vector<std::reference_wrapper<const ChatHistoryEntity>>& chat_history) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         std::size_t size = chat_history.size();
@@ -642,24 +854,24 @@ Message ChatHistoryMessage(const std::vector<std::reference_wrapper<const ChatHi
             oa << boost::serialization::make_nvp(BOOST_PP_STRINGIZE(elem), elem.get());
         }
     }
-    return Message(Message::MessageType::CHAT_HISTORY, os.str());
+    return os.ToMessage(Message::MessageType::CHAT_HISTORY);
 }
 
 Message PlayerChatMessage(const std::string& data, std::set<int> recipients, bool pm) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(recipients)
            << BOOST_SERIALIZATION_NVP(data)
            << BOOST_SERIALIZATION_NVP(pm);
     }
-    return Message(Message::MessageType::PLAYER_CHAT, os.str());
+    return os.ToMessage(Message::MessageType::PLAYER_CHAT);
 }
 
 Message ServerPlayerChatMessage(int sender, const boost::posix_time::ptime& timestamp,
                                 const std::string& data, bool pm)
 {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(sender)
@@ -667,7 +879,7 @@ Message ServerPlayerChatMessage(int sender, const boost::posix_time::ptime& time
            << BOOST_SERIALIZATION_NVP(data)
            << BOOST_SERIALIZATION_NVP(pm);
     }
-    return Message(Message::MessageType::PLAYER_CHAT, os.str());
+    return os.ToMessage(Message::MessageType::PLAYER_CHAT);
 }
 
 Message StartMPGameMessage()
@@ -676,32 +888,32 @@ Message StartMPGameMessage()
 Message ContentCheckSumMessage() {
     auto checksums = CheckSumContent();
 
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(checksums);
     }
-    return Message(Message::MessageType::CHECKSUM, os.str());
+    return os.ToMessage(Message::MessageType::CHECKSUM);
 }
 
 Message AuthRequestMessage(const std::string& player_name, const std::string& auth) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(player_name)
            << BOOST_SERIALIZATION_NVP(auth);
     }
-    return Message(Message::MessageType::AUTH_REQUEST, os.str());
+    return os.ToMessage(Message::MessageType::AUTH_REQUEST);
 }
 
 Message AuthResponseMessage(const std::string& player_name, const std::string& auth) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(player_name)
            << BOOST_SERIALIZATION_NVP(auth);
     }
-    return Message(Message::MessageType::AUTH_RESPONSE, os.str());
+    return os.ToMessage(Message::MessageType::AUTH_RESPONSE);
 }
 
 Message SetAuthorizationRolesMessage(const Networking::AuthRoles& roles)
@@ -714,12 +926,12 @@ Message UnreadyMessage()
 { return Message(Message::MessageType::UNREADY, DUMMY_EMPTY_MESSAGE); }
 
 Message PlayerInfoMessage(const std::map<int, PlayerInfo>& players) {
-    std::ostringstream os;
+    MessageOStream os;
     {
         freeorion_xml_oarchive oa(os);
         oa << BOOST_SERIALIZATION_NVP(players);
     }
-    return Message(Message::MessageType::PLAYER_INFO, os.str());
+    return os.ToMessage(Message::MessageType::PLAYER_INFO);
 }
 
 Message AutoTurnMessage(int turns_count) {
@@ -732,7 +944,7 @@ Message AutoTurnMessage(int turns_count) {
 ////////////////////////////////////////////////
 void ExtractErrorMessageData(const Message& msg, int& player_id, std::string& problem, bool& fatal) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(problem)
            >> BOOST_SERIALIZATION_NVP(fatal)
@@ -748,7 +960,7 @@ void ExtractErrorMessageData(const Message& msg, int& player_id, std::string& pr
 
 void ExtractHostMPGameMessageData(const Message& msg, std::string& host_player_name, std::string& client_version_string) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(host_player_name)
            >> BOOST_SERIALIZATION_NVP(client_version_string);
@@ -763,7 +975,7 @@ void ExtractHostMPGameMessageData(const Message& msg, std::string& host_player_n
 
 void ExtractLobbyUpdateMessageData(const Message& msg, MultiplayerLobbyData& lobby_data) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(lobby_data);
 
@@ -777,7 +989,7 @@ void ExtractLobbyUpdateMessageData(const Message& msg, MultiplayerLobbyData& lob
 
 void ExtractChatHistoryMessage(const Message& msg, std::vector<ChatHistoryEntity>& chat_history) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         std::size_t size;
         ia >> BOOST_SERIALIZATION_NVP(size);
@@ -798,7 +1010,7 @@ void ExtractChatHistoryMessage(const Message& msg, std::vector<ChatHistoryEntity
 
 void ExtractPlayerChatMessageData(const Message& msg, std::set<int>& recipients, std::string& data, bool& pm) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(recipients)
            >> BOOST_SERIALIZATION_NVP(data)
@@ -817,7 +1029,7 @@ void ExtractServerPlayerChatMessageData(const Message& msg,
                                         std::string& data, bool& pm)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(sender)
            >> BOOST_SERIALIZATION_NVP(timestamp)
@@ -837,25 +1049,13 @@ void ExtractGameStartMessageData(const Message& msg, bool& single_player_game, i
                                  std::map<int, PlayerInfo>& players, OrderSet& orders, bool& loaded_game_data,
                                  bool& ui_data_available, SaveGameUIData& ui_data, bool& save_state_string_available,
                                  std::string& save_state_string, GalaxySetupData& galaxy_setup_data)
-{
-    ExtractGameStartMessageData(msg.Text(), single_player_game, empire_id, current_turn, empires, universe,
-                                species, combat_logs, supply, players, orders, loaded_game_data, ui_data_available,
-                                ui_data, save_state_string_available, save_state_string, galaxy_setup_data);
-}
-
-void ExtractGameStartMessageData(std::string text, bool& single_player_game, int& empire_id, int& current_turn,
-                                 EmpireManager& empires, Universe& universe, SpeciesManager& species,
-                                 CombatLogManager& combat_logs, SupplyManager& supply,
-                                 std::map<int, PlayerInfo>& players, OrderSet& orders, bool& loaded_game_data,
-                                 bool& ui_data_available, SaveGameUIData& ui_data, bool& save_state_string_available,
-                                 std::string& save_state_string, GalaxySetupData& galaxy_setup_data)
 {
     try {
         bool try_xml = false;
-        if (strncmp(text.c_str(), "<?xml", 5)) {
+        if (!IsXMLMessage(msg)) {
             try {
                 // first attempt binary deserialziation
-                std::istringstream is(text);
+                MessageIStream is(msg);
 
                 freeorion_bin_iarchive ia(is);
                 ia >> BOOST_SERIALIZATION_NVP(single_player_game)
@@ -886,7 +1086,7 @@ void ExtractGameStartMessageData(std::string text, bool& single_player_game, int
                         ia >> BOOST_SERIALIZATION_NVP(ui_data);
                     ia >> BOOST_SERIALIZATION_NVP(save_state_string_available);
                     if (save_state_string_available)
-                        ia >> BOOST_SERIALIZATION_NVP(save_state_string);
+                        DeserializeCompressible(ia, save_state_string);
                 } else {
                     ui_data_available = false;
                     save_state_string_available = false;
@@ -900,7 +1100,7 @@ void ExtractGameStartMessageData(std::string text, bool& single_player_game, int
         }
         if (try_xml) {
             // if binary deserialization failed, try more-portable XML deserialization
-            std::istringstream is(text);
+            MessageIStream is(msg);
 
             freeorion_xml_iarchive ia(is);
             ia >> BOOST_SERIALIZATION_NVP(single_player_game)
@@ -948,7 +1148,7 @@ void ExtractGameStartMessageData(std::string text, bool& single_player_game, int
     } catch (const std::exception& err) {
         ErrorLogger() << "ExtractGameStartMessageData(...) failed!  Message probably long, so not outputting to log.\n"
                       << "Error: " << err.what();
-        TraceLogger() << "Message: " << text;
+        TraceLogger() << "Message: " << std::string_view(msg.Data(), msg.Size());
         throw err;
     }
 }
@@ -961,7 +1161,7 @@ void ExtractJoinGameMessageData(const Message& msg, std::string& player_name,
     DebugLogger() << "ExtractJoinGameMessageData() from " << player_name
                   << " client type " << client_type;
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(player_name)
            >> BOOST_SERIALIZATION_NVP(client_type)
@@ -981,7 +1181,7 @@ void ExtractJoinAckMessageData(const Message& msg, int& player_id,
                                boost::uuids::uuid& cookie)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(player_id)
            >> BOOST_SERIALIZATION_NVP(cookie);
@@ -994,13 +1194,12 @@ void ExtractJoinAckMessageData(const Message& msg, int& player_id,
     }
 }
 
-void ExtractTurnOrdersMessageData(const Message& msg, OrderSet& orders, bool& ui_data_available,
-                                  SaveGameUIData& ui_data, bool& save_state_string_available,
-                                  std::string& save_state_string)
-{
-    try {
-        std::istringstream is(msg.Text());
-        freeorion_xml_iarchive ia(is);
+namespace {
+    template <typename Archive>
+    void DeserializeTurnOrders(Archive& ia, OrderSet& orders, bool& ui_data_available,
+                               SaveGameUIData& ui_data, bool& save_state_string_available,
+                               std::string& save_state_string)
+    {
         DebugLogger() << "deserializing orders";
         Deserialize(ia, orders);
         DebugLogger() << "checking for ui data";
@@ -1013,7 +1212,28 @@ void ExtractTurnOrdersMessageData(const Message& msg, OrderSet& orders, bool& ui
         ia >> BOOST_SERIALIZATION_NVP(save_state_string_available);
         if (save_state_string_available) {
             DebugLogger() << "deserializing save state string";
-            ia >> BOOST_SERIALIZATION_NVP(save_state_string);
+            if constexpr (IsBinaryArchive<Archive>)
+                DeserializeCompressible(ia, save_state_string);
+            else
+                ia >> BOOST_SERIALIZATION_NVP(save_state_string);
+        }
+    }
+}
+
+void ExtractTurnOrdersMessageData(const Message& msg, OrderSet& orders, bool& ui_data_available,
+                                  SaveGameUIData& ui_data, bool& save_state_string_available,
+                                  std::string& save_state_string)
+{
+    try {
+        MessageIStream is(msg);
+        if (IsXMLMessage(msg)) {
+            freeorion_xml_iarchive ia(is);
+            DeserializeTurnOrders(ia, orders, ui_data_available, ui_data,
+                                  save_state_string_available, save_state_string);
+        } else {
+            freeorion_bin_iarchive ia(is);
+            DeserializeTurnOrders(ia, orders, ui_data_available, ui_data,
+                                  save_state_string_available, save_state_string);
         }
 
     } catch (const std::exception& err) {
@@ -1025,7 +1245,7 @@ void ExtractTurnOrdersMessageData(const Message& msg, OrderSet& orders, bool& ui
 
 void ExtractTurnPartialOrdersMessageData(const Message& msg, OrderSet& added, std::set<int>& deleted) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         DebugLogger() << "deserializing partial orders";
         Deserialize(ia, added);
@@ -1039,24 +1259,17 @@ void ExtractTurnPartialOrdersMessageData(const Message& msg, OrderSet& added, st
 
 void ExtractTurnUpdateMessageData(const Message& msg, int empire_id, int& current_turn, EmpireManager& empires,
                                   Universe& universe, SpeciesManager& species, CombatLogManager& combat_logs,
-                                  SupplyManager& supply, std::map<int, PlayerInfo>& players)
-{
-    ExtractTurnUpdateMessageData(msg.Text(), empire_id, current_turn, empires,
-                                 universe, species, combat_logs, supply, players);
-}
-
-void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_turn, EmpireManager& empires,
-                                  Universe& universe, SpeciesManager& species, CombatLogManager& combat_logs,
-                                  SupplyManager& supply, std::map<int, PlayerInfo>& players)
+                                  SupplyManager& supply, std::map<int, PlayerInfo>& players,
+                                  ObjectDeltaBase& delta_base)
 {
     try {
         ScopedTimer timer("Turn Update Unpacking", true);
 
         bool try_xml = false;
-        if (std::strncmp(text.c_str(), "<?xml", 5)) {
+        if (!IsXMLMessage(msg)) {
             try {
                 // first attempt binary deserialization
-                std::istringstream is(text);
+                MessageIStream is(msg);
                 freeorion_bin_iarchive ia(is);
                 GlobalSerializationEncodingForEmpire() = empire_id;
                 ia >> BOOST_SERIALIZATION_NVP(current_turn)
@@ -1064,7 +1277,7 @@ void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_
                    >> BOOST_SERIALIZATION_NVP(species);
                 SerializeIncompleteLogs(ia, combat_logs, 1);
                 ia >> BOOST_SERIALIZATION_NVP(supply);
-                Deserialize(ia, universe);
+                DeserializeDelta(ia, universe, delta_base, current_turn);
                 ia >> BOOST_SERIALIZATION_NVP(players);
             } catch (...) {
                 try_xml = true;
@@ -1074,7 +1287,7 @@ void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_
         }
         if (try_xml) {
             // try again with more-portable XML deserialization
-            std::istringstream is(text);
+            MessageIStream is(msg);
             freeorion_xml_iarchive ia(is);
             GlobalSerializationEncodingForEmpire() = empire_id;
             ia >> BOOST_SERIALIZATION_NVP(current_turn)
@@ -1082,7 +1295,7 @@ void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_
                >> BOOST_SERIALIZATION_NVP(species);
             SerializeIncompleteLogs(ia, combat_logs, 1);
             ia >> BOOST_SERIALIZATION_NVP(supply);
-            Deserialize(ia, universe);
+            DeserializeDelta(ia, universe, delta_base, current_turn);
             ia >> BOOST_SERIALIZATION_NVP(players);
         }
 
@@ -1093,18 +1306,28 @@ void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_
     }
 }
 
-void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Universe& universe) {
+void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Universe& universe,
+                                         ObjectDeltaBase& delta_base)
+{
     try {
         ScopedTimer timer("Mid Turn Update Unpacking", true);
 
         bool try_xml = false;
-        if (std::strncmp(msg.Data(), "<?xml", 5)) {
+        bool use_delta = false;
+        int turn = -1;
+        if (!IsXMLMessage(msg)) {
             try {
                 // first attempt binary deserialization
-                std::istringstream is(msg.Text());
+                MessageIStream is(msg);
                 freeorion_bin_iarchive ia(is);
                 GlobalSerializationEncodingForEmpire() = empire_id;
-                Deserialize(ia, universe);
+                ia >> BOOST_SERIALIZATION_NVP(use_delta);
+                if (use_delta) {
+                    ia >> BOOST_SERIALIZATION_NVP(turn);
+                    DeserializeDelta(ia, universe, delta_base, turn);
+                } else {
+                    Deserialize(ia, universe);
+                }
             } catch (...) {
                 try_xml = true;
             }
@@ -1113,10 +1336,16 @@ void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Univ
         }
         if (try_xml) {
             // try again with more-portable XML deserialization
-            std::istringstream is(msg.Text());
+            MessageIStream is(msg);
             freeorion_xml_iarchive ia(is);
             GlobalSerializationEncodingForEmpire() = empire_id;
-            Deserialize(ia, universe);
+            ia >> BOOST_SERIALIZATION_NVP(use_delta);
+            if (use_delta) {
+                ia >> BOOST_SERIALIZATION_NVP(turn);
+                DeserializeDelta(ia, universe, delta_base, turn);
+            } else {
+                Deserialize(ia, universe);
+            }
         }
 
     } catch (const std::exception& err) {
@@ -1128,7 +1357,7 @@ void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Univ
 
 void ExtractTurnProgressMessageData(const Message& msg, Message::TurnProgressPhase& phase_id) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(phase_id);
 
@@ -1142,7 +1371,7 @@ void ExtractTurnProgressMessageData(const Message& msg, Message::TurnProgressPha
 
 void ExtractPlayerStatusMessageData(const Message& msg, Message::PlayerStatus& status, int& about_empire_id) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(status)
            >> BOOST_SERIALIZATION_NVP(about_empire_id);
@@ -1157,7 +1386,7 @@ void ExtractPlayerStatusMessageData(const Message& msg, Message::PlayerStatus& s
 
 void ExtractHostSPGameMessageData(const Message& msg, SinglePlayerSetupData& setup_data, std::string& client_version_string) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(setup_data)
            >> BOOST_SERIALIZATION_NVP(client_version_string);
@@ -1172,7 +1401,7 @@ void ExtractHostSPGameMessageData(const Message& msg, SinglePlayerSetupData& set
 
 void ExtractEndGameMessageData(const Message& msg, Message::EndGameReason& reason, std::string& reason_player_name) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(reason)
            >> BOOST_SERIALIZATION_NVP(reason_player_name);
@@ -1188,7 +1417,7 @@ void ExtractEndGameMessageData(const Message& msg, Message::EndGameReason& reaso
 
 void ExtractModeratorActionMessageData(const Message& msg, Moderator::ModeratorAction*& mod_action) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(mod_action);
 
@@ -1202,7 +1431,7 @@ void ExtractModeratorActionMessageData(const Message& msg, Moderator::ModeratorA
 
 void ExtractDiplomacyMessageData(const Message& msg, DiplomaticMessage& diplo_message) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(diplo_message);
 
@@ -1217,7 +1446,7 @@ void ExtractDiplomacyMessageData(const Message& msg, DiplomaticMessage& diplo_me
 
 void ExtractDiplomaticStatusMessageData(const Message& msg, DiplomaticStatusUpdateInfo& diplo_update) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(diplo_update.empire1_id)
            >> BOOST_SERIALIZATION_NVP(diplo_update.empire2_id)
@@ -1236,7 +1465,7 @@ void ExtractRequestSavePreviewsMessageData(const Message& msg, std::string& dire
 
 void ExtractDispatchSavePreviewsMessageData(const Message& msg, PreviewInformation& previews) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(previews);
 
@@ -1250,7 +1479,7 @@ void ExtractDispatchSavePreviewsMessageData(const Message& msg, PreviewInformati
 
 FO_COMMON_API void ExtractServerSaveGameCompleteMessageData(const Message& msg, std::string& save_filename, int& bytes_written) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(save_filename)
            >> BOOST_SERIALIZATION_NVP(bytes_written);
@@ -1265,7 +1494,7 @@ FO_COMMON_API void ExtractServerSaveGameCompleteMessageData(const Message& msg,
 
 FO_COMMON_API void ExtractRequestCombatLogsMessageData(const Message& msg, std::vector<int>& ids) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(ids);
     } catch(const std::exception& err) {
@@ -1281,10 +1510,10 @@ FO_COMMON_API void ExtractDispatchCombatLogsMessageData(
 {
     try {
         bool try_xml = false;
-        if (std::strncmp(msg.Data(), "<?xml", 5)) {
+        if (!IsXMLMessage(msg)) {
             try {
                 // first attempt binary deserialization
-                std::istringstream is(msg.Text());
+                MessageIStream is(msg);
                 freeorion_bin_iarchive ia(is);
                 ia >> BOOST_SERIALIZATION_NVP(logs);
             } catch (...) {
@@ -1295,7 +1524,7 @@ FO_COMMON_API void ExtractDispatchCombatLogsMessageData(
         }
         if (try_xml) {
             // try again with more-portable XML deserialization
-            std::istringstream is(msg.Text());
+            MessageIStream is(msg);
             freeorion_xml_iarchive ia(is);
             ia >> BOOST_SERIALIZATION_NVP(logs);
         }
@@ -1312,7 +1541,7 @@ FO_COMMON_API void ExtractLoggerConfigMessageData(const Message& msg,
                                                   std::set<std::tuple<std::string, std::string, LogLevel>>& options)
 {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         std::size_t size;
         ia >> BOOST_SERIALIZATION_NVP(size);
@@ -1337,7 +1566,7 @@ FO_COMMON_API void ExtractLoggerConfigMessageData(const Message& msg,
 void ExtractContentCheckSumMessageData(const Message& msg, std::map<std::string, unsigned int>& checksums) {
     checksums.clear();
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(checksums);
 
@@ -1351,7 +1580,7 @@ void ExtractContentCheckSumMessageData(const Message& msg, std::map<std::string,
 
 void ExtractAuthRequestMessageData(const Message& msg, std::string& player_name, std::string& auth) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(player_name)
            >> BOOST_SERIALIZATION_NVP(auth);
@@ -1366,7 +1595,7 @@ void ExtractAuthRequestMessageData(const Message& msg, std::string& player_name,
 
 void ExtractAuthResponseMessageData(const Message& msg, std::string& player_name, std::string& auth) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(player_name)
            >> BOOST_SERIALIZATION_NVP(auth);
@@ -1384,7 +1613,7 @@ void ExtractSetAuthorizationRolesMessage(const Message &msg, Networking::AuthRol
 
 void ExtractPlayerInfoMessageData(const Message &msg, std::map<int, PlayerInfo>& players) {
     try {
-        std::istringstream is(msg.Text());
+        MessageIStream is(msg);
         freeorion_xml_iarchive ia(is);
         ia >> BOOST_SERIALIZATION_NVP(players);
     } catch(const std::exception& err) {
@@ -28,6 +28,7 @@ struct CombatLog;
 class CombatLogManager;
 class Message;
 struct MultiplayerLobbyData;
+struct ObjectDeltaBase;
 struct ChatHistoryEntity;
 class OrderSet;
 struct PlayerInfo;
@@ -59,6 +60,11 @@ public:
     constexpr static size_t HeaderBufferSize =
         std::tuple_size<HeaderBuffer>::value* sizeof(HeaderBuffer::value_type);
 
+    /** Set in the TYPE part of a header when the message body is compressed.
+      * Folded into an existing part so that the header stays readable by
+      * clients that do not support compression; they are never sent any. */
+    constexpr static int COMPRESSED_HEADER_FLAG = 1 << 30;
+
     /** Represents the type of the message */
     FO_ENUM(
         (Message, MessageType),
@@ -108,6 +114,7 @@ public:
         ((TURN_TIMEOUT))           ///< sent by server to client to notify about remaining time before turn advance
         ((PLAYER_INFO))            ///< sent by server to client to notify about changes in the player data
         ((AUTO_TURN))              ///< sent by client to server to move into auto-turn state
+        ((AI_TURN_TIMINGS))        ///< sent by ai clients to server with a summary of the time taken to generate their orders
     )
 
     FO_ENUM(
@@ -139,12 +146,21 @@ public:
 
     Message() = default;
     Message(MessageType message_type, const std::string& text);
+    /** Adopts the first \a size chars of \a text, without copying them. */
+    Message(MessageType message_type, boost::shared_array<char> text, std::size_t size,
+            bool compressed = false);
+    Message(const Message&) = default;
+    Message(Message&&) = default;
     ~Message() = default;
 
+    Message& operator=(const Message&) = default;
+    Message& operator=(Message&&) = default;
+
     MessageType Type() const;               ///< Returns the type of the message.
     std::size_t Size() const;               ///< Returns the size of the underlying buffer.
     const char* Data() const;               ///< Returns the underlying buffer.
     std::string Text() const;               ///< Returns the underlying buffer as a std::string.
+    bool        Compressed() const;         ///< Returns true if the underlying buffer is compressed, see CompressMessage.
 
     void        Resize(std::size_t size);   ///< Resizes the underlying char buffer to \a size uninitialized bytes.
     char*       Data();                     ///< Returns the underlying buffer.
@@ -155,6 +171,7 @@ private:
     MessageType               m_type = MessageType::UNDEFINED;
     int                       m_message_size = 0;
     boost::shared_array<char> m_message_text;
+    bool                      m_compressed = false;
 
     friend FO_COMMON_API void BufferToHeader(const HeaderBuffer&, Message&);
 };
@@ -170,6 +187,18 @@ bool operator!=(const Message& lhs, const Message& rhs);
 
 FO_COMMON_API void swap(Message& lhs, Message& rhs); ///< Swaps the contents of \a lhs and \a rhs.  Does not throw.
 
+/** Returns a copy of \a message with its body zlib compressed, for sending
+  * over slow connections. */
+FO_COMMON_API Message CompressMessage(const Message& message);
+
+/** Returns a copy of \a message with its body decompressed. Throws
+  * std::runtime_error if the compressed body is corrupt. */
+FO_COMMON_API Message DecompressMessage(const Message& message);
+
+/** Returns true if the body of \a message is an XML archive, rather than
+  * a binary archive or not an archive. */
+FO_COMMON_API bool IsXMLMessage(const Message& message);
+
 
 ////////////////////////////////////////////////
 // Message stringification
@@ -243,11 +272,16 @@ FO_COMMON_API Message HostMPAckMessage(int player_id);
   * This message should only be sent by the server.*/
 FO_COMMON_API Message JoinAckMessage(int player_id, boost::uuids::uuid cookie);
 
-/** creates a TURN_ORDERS message, including UI data but without a state string. */
-FO_COMMON_API Message TurnOrdersMessage(const OrderSet& orders, const SaveGameUIData& ui_data);
+/** creates a TURN_ORDERS message, including UI data but without a state string.
+  * Binary serialization encodes the orders compactly, and should only be
+  * used if the server sends binary serialized messages to this client. */
+FO_COMMON_API Message TurnOrdersMessage(const OrderSet& orders, const SaveGameUIData& ui_data,
+                                        bool use_binary_serialization);
 
-/** creates a TURN_ORDERS message, without UI data but with a state string. */
-FO_COMMON_API Message TurnOrdersMessage(const OrderSet& orders, const std::string& save_state_string);
+/** creates a TURN_ORDERS message, without UI data but with a state string,
+  * which is compressed if binary serialization is used. */
+FO_COMMON_API Message TurnOrdersMessage(const OrderSet& orders, const std::string& save_state_string,
+                                        bool use_binary_serialization);
 
 /** creates a TURN_PARTIAL_ORDERS message with orders changes. */
 FO_COMMON_API Message TurnPartialOrdersMessage(const std::pair<OrderSet, std::set<int>>& orders_updates);
@@ -262,15 +296,24 @@ FO_COMMON_API Message TurnProgressMessage(Message::TurnProgressPhase phase_id);
 FO_COMMON_API Message PlayerStatusMessage(Message::PlayerStatus player_status,
                                           int about_empire_id);
 
-/** creates a TURN_UPDATE message. */
+/** creates a TURN_UPDATE message. If \a use_delta is true, objects that are
+  * unchanged since the update recorded in \a delta_base are sent as just
+  * their IDs. \a delta_base is updated to record this update. */
 FO_COMMON_API Message TurnUpdateMessage(int empire_id, int current_turn,
                                         const EmpireManager& empires, const Universe& universe,
                                         const SpeciesManager& species, CombatLogManager& combat_logs,
                                         const SupplyManager& supply,
-                                        const std::map<int, PlayerInfo>& players, bool use_binary_serialization);
-
-/** create a TURN_PARTIAL_UPDATE message. */
+                                        const std::map<int, PlayerInfo>& players,
+                                        ObjectDeltaBase& delta_base, bool use_delta,
+                                        bool use_binary_serialization);
+
+/** create a TURN_PARTIAL_UPDATE message. If \a use_delta is true and
+  * \a delta_base is acknowledged, objects that are unchanged since the update
+  * recorded in \a delta_base are sent as just their IDs, and \a delta_base is
+  * updated to record this update. Otherwise the whole universe is sent and
+  * \a delta_base is left as it is. */
 FO_COMMON_API Message TurnPartialUpdateMessage(int empire_id, const Universe& universe,
+                                               ObjectDeltaBase& delta_base, bool use_delta,
                                                bool use_binary_serialization);
 
 /** creates a SAVE_GAME_INITIATE request message.  This message should only be sent by
@@ -296,6 +339,14 @@ FO_COMMON_API Message EndGameMessage(Message::EndGameReason reason, const std::s
 /** creates an AI_END_GAME_ACK message used to indicate that the AI has shutdown. */
 FO_COMMON_API Message AIEndGameAcknowledgeMessage();
 
+/** creates an AI_TURN_TIMINGS message used to report where the time taken by
+  * an AI to generate its orders for a turn went. */
+FO_COMMON_API Message AITurnTimingsMessage(const std::string& timings);
+
+/** creates a DEBUG message asking the server to run debugging command
+  * \a command, such as "memory" to report its memory usage. */
+FO_COMMON_API Message DebugCommandMessage(const std::string& command);
+
 /** creates a MODERATOR_ACTION message used to implement moderator commands. */
 FO_COMMON_API Message ModeratorActionMessage(const Moderator::ModeratorAction& mod_action);
 
@@ -400,15 +451,6 @@ FO_COMMON_API void ExtractGameStartMessageData(const Message& msg, bool& single_
                                                SaveGameUIData& ui_data, bool& save_state_string_available,
                                                std::string& save_state_string, GalaxySetupData& galaxy_setup_data);
 
-FO_COMMON_API void ExtractGameStartMessageData(std::string text, bool& single_player_game, int& empire_id,
-                                               int& current_turn, EmpireManager& empires, Universe& universe,
-                                               SpeciesManager& species, CombatLogManager& combat_logs,
-                                               SupplyManager& supply,
-                                               std::map<int, PlayerInfo>& players, OrderSet& orders,
-                                               bool& loaded_game_data, bool& ui_data_available,
-                                               SaveGameUIData& ui_data, bool& save_state_string_available,
-                                               std::string& save_state_string, GalaxySetupData& galaxy_setup_data);
-
 FO_COMMON_API void ExtractJoinGameMessageData(const Message& msg, std::string& player_name,
                                               Networking::ClientType& client_type,
                                               std::string& version_string,
@@ -423,15 +465,19 @@ FO_COMMON_API void ExtractTurnOrdersMessageData(const Message& msg, OrderSet& or
 
 FO_COMMON_API void ExtractTurnPartialOrdersMessageData(const Message& msg, OrderSet& added, std::set<int>& deleted);
 
+/** Extracts the contents of a TURN_UPDATE message. Objects the message lists
+  * as unchanged are restored from \a delta_base, which is then updated to
+  * record this update. */
 FO_COMMON_API void ExtractTurnUpdateMessageData(const Message& msg, int empire_id, int& current_turn, EmpireManager& empires,
                                                 Universe& universe, SpeciesManager& species, CombatLogManager& combat_logs,
-                                                SupplyManager& supply, std::map<int, PlayerInfo>& players);
-
-FO_COMMON_API void ExtractTurnUpdateMessageData(std::string text, int empire_id, int& current_turn, EmpireManager& empires,
-                                                Universe& universe, SpeciesManager& species, CombatLogManager& combat_logs,
-                                                SupplyManager& supply, std::map<int, PlayerInfo>& players);
-
-FO_COMMON_API void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Universe& universe);
+                                                SupplyManager& supply, std::map<int, PlayerInfo>& players,
+                                                ObjectDeltaBase& delta_base);
+
+/** Extracts the contents of a TURN_PARTIAL_UPDATE message. If the message is
+  * encoded relative to \a delta_base, objects it lists as unchanged are
+  * restored from \a delta_base, which is then updated to record this update. */
+FO_COMMON_API void ExtractTurnPartialUpdateMessageData(const Message& msg, int empire_id, Universe& universe,
+                                                       ObjectDeltaBase& delta_base);
 
 FO_COMMON_API void ExtractTurnProgressMessageData(const Message& msg, Message::TurnProgressPhase& phase_id);
 
@@ -10,6 +10,10 @@ namespace Networking {
     FO_COMMON_API extern const std::string DISCOVERY_QUESTION;
     FO_COMMON_API extern const std::string DISCOVERY_ANSWER;
     FO_COMMON_API extern const int SOCKET_LINGER_TIME;
+    /** Send and receive buffer size requested for connections between a
+        server and a client on the same machine, which large messages such as
+        turn updates can then be written into with few system calls. */
+    constexpr int LOCAL_SOCKET_BUFFER_SIZE = 1 << 22;
     constexpr int INVALID_PLAYER_ID = -1;
     constexpr int NO_TEAM_ID = -1;
 
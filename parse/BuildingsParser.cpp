@@ -118,13 +118,11 @@ namespace {
 
 namespace parse {
     start_rule_payload buildings(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload building_types;
 
         ScopedTimer timer("Buildings Parsing", true);
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            detail::parse_file<grammar, start_rule_payload>(lexer, file, building_types);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), building_types, "BuildingType");
 
         return building_types;
     }
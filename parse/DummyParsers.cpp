@@ -76,6 +76,24 @@ namespace parse {
                                        std::set<boost::filesystem::path>& files_included)
     {}
 
+    void SetProfilingEnabled(bool enabled)
+    {}
+
+    bool ProfilingEnabled()
+    { return false; }
+
+    void ClearProfiles()
+    {}
+
+    std::vector<FileParseProfile> FileProfiles()
+    { return {}; }
+
+    std::string ProfileReport(const boost::filesystem::path& scripting_dir)
+    { return {}; }
+
+    std::string ProfileCategory(const boost::filesystem::path& file, const boost::filesystem::path& scripting_dir)
+    { return {}; }
+
     bool int_free_variable(std::string& text) { return false; }
     bool double_free_variable(std::string& text) { return false; }
     bool string_free_variable(std::string& text) { return false; }
@@ -112,13 +112,11 @@ namespace {
 
 namespace parse {
     start_rule_payload fields(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload field_types;
 
         ScopedTimer timer("Fields Parsing", true);
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            detail::parse_file<grammar, start_rule_payload>(lexer, file, field_types);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), field_types, "FieldType");
 
         return field_types;
     }
@@ -8,14 +8,29 @@
 
 #include "../universe/UnlockableItem.h"
 #include "../util/Logger.h"
+#include "../util/ScopedTimer.h"
 #include "../util/Directories.h"
+#include "../util/OptionsDB.h"
+#include "../util/Version.h"
 
-#include <boost/xpressive/xpressive.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/spirit/include/phoenix.hpp>
 #include <boost/algorithm/string/find_iterator.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#if !defined(FREEORION_WIN32)
+#  include <sys/resource.h>
+#endif
 
 #define DEBUG_PARSERS 0
 
@@ -27,151 +42,249 @@ namespace std {
 #endif
 
 namespace parse {
-    using namespace boost::xpressive;
-    const sregex MACRO_KEY = +_w;   // word character (alnum | _), one or more times, greedy
-    const sregex MACRO_TEXT = -*_;  // any character, zero or more times, not greedy
-    const sregex MACRO_DEFINITION = (s1 = MACRO_KEY) >> _n >> "'''" >> (s2 = MACRO_TEXT) >> "'''" >> _n;
-    const sregex MACRO_INSERTION = "[[" >> *space >> (s1 = MACRO_KEY) >> *space >> !("(" >> (s2 = +~(set = ')', '\n')) >> ")") >> "]]";
+    namespace {
+        bool is_word_char(char c)
+        { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+
+        bool is_space_char(char c)
+        { return std::isspace(static_cast<unsigned char>(c)); }
+
+        /** A macro insertion, [[MACRO_KEY]] or [[MACRO_KEY(arg1,arg2,...)]],
+          * in some text. */
+        struct MacroInsertion {
+            std::size_t begin = 0;  ///< position of the opening [[
+            std::size_t end = 0;    ///< position after the closing ]]
+            std::string key;
+            std::string params;     ///< text between the brackets, if any
+        };
+
+        /** Parses a macro insertion starting at \a begin, which should be the
+          * position of a [[ in \a text. */
+        bool parse_macro_insertion(const std::string& text, std::size_t begin, MacroInsertion& insertion) {
+            std::size_t pos = begin + 2;
+            while (pos < text.size() && is_space_char(text[pos]))
+                ++pos;
+            const std::size_t key_begin = pos;
+            while (pos < text.size() && is_word_char(text[pos]))
+                ++pos;
+            if (pos == key_begin)
+                return false;
+            const std::size_t key_end = pos;
+            while (pos < text.size() && is_space_char(text[pos]))
+                ++pos;
+
+            std::size_t params_begin = pos, params_end = pos;
+            if (pos < text.size() && text[pos] == '(') {
+                params_begin = pos + 1;
+                params_end = text.find_first_of(")\n", params_begin);
+                if (params_end != std::string::npos && params_end > params_begin && text[params_end] == ')')
+                    pos = params_end + 1;
+                else
+                    params_begin = params_end = pos;    // not parameters, so must be followed directly by ]]
+            }
 
-    void parse_and_erase_macro_definitions(std::string& text, std::map<std::string, std::string>& macros) {
-        try {
-            std::string::iterator text_it = text.begin();
-            while (true) {
-                // find next macro definition
-                smatch match;
-                if (!regex_search(text_it, text.end(), match, MACRO_DEFINITION, regex_constants::match_default))
-                    break;
+            if (text.compare(pos, 2, "]]") != 0)
+                return false;
 
-                //const std::string& matched_text = match.str();  // [[MACRO_KEY]] '''macro text'''
-                //DebugLogger() << "found macro definition:\n" << matched_text;
+            insertion.begin = begin;
+            insertion.end = pos + 2;
+            insertion.key = text.substr(key_begin, key_end - key_begin);
+            insertion.params = text.substr(params_begin, params_end - params_begin);
+            return true;
+        }
 
-                // get macro key and macro text from match
-                const std::string& macro_key = match[1];
-                assert(macro_key != "");
-                const std::string& macro_text = match[2];
-                assert(macro_text != "");
+        /** Calls \a fn for each macro insertion in \a text, in order. */
+        template <typename Fn>
+        void for_each_macro_insertion(const std::string& text, const Fn& fn) {
+            MacroInsertion insertion;
+            std::size_t pos = text.find("[[");
+            while (pos != std::string::npos) {
+                if (parse_macro_insertion(text, pos, insertion)) {
+                    fn(insertion);
+                    pos = text.find("[[", insertion.end);
+                } else {
+                    pos = text.find("[[", pos + 1);
+                }
+            }
+        }
 
-                //DebugLogger() << "key: " << macro_key;
-                //DebugLogger() << "text:\n" << macro_text;
+        /** Removes definitions of macros, MACRO_KEY followed by the macro text
+          * between lines of triple quotes, from \a text in one pass, and
+          * stores them in \a macros. Each definition is replaced by a newline. */
+        void parse_and_erase_macro_definitions(std::string& text, std::map<std::string, std::string>& macros) {
+            const std::string OPEN = "\n'''";
+            const std::string CLOSE = "'''\n";
+
+            std::string retval;
+            std::size_t copied_up_to = 0;   // position in text, up to which text is in retval
+            std::size_t pos = text.find(OPEN);
+            while (pos != std::string::npos) {
+                // key is the run of word characters directly before the newline
+                std::size_t key_begin = pos;
+                while (key_begin > copied_up_to && is_word_char(text[key_begin - 1]))
+                    --key_begin;
+                const std::size_t text_begin = pos + OPEN.size();
+                const std::size_t close = (key_begin < pos) ? text.find(CLOSE, text_begin) : std::string::npos;
+                if (close == std::string::npos) {
+                    // not a macro definition
+                    pos = text.find(OPEN, pos + 1);
+                    continue;
+                }
 
-                // store macro
-                if (!macros.count(macro_key)) {
-                    macros[macro_key] = macro_text;
-                } else {
+                std::string macro_key = text.substr(key_begin, pos - key_begin);
+                if (!macros.count(macro_key))
+                    macros.emplace(std::move(macro_key), text.substr(text_begin, close - text_begin));
+                else
                     ErrorLogger() << "Duplicate macro key foud: " << macro_key << ".  Ignoring duplicate.";
-                }
 
                 // remove macro definition from text by replacing with a newline that is ignored by later parsing
-                text.replace(text_it + match.position(), text_it + match.position() + match.length(), "\n");
-                // subsequent scanning starts after macro defininition
-                text_it = text.end() - match.suffix().length();
+                retval.append(text, copied_up_to, key_begin - copied_up_to);
+                retval.append("\n");
+                copied_up_to = close + CLOSE.size();
+                pos = text.find(OPEN, copied_up_to);
             }
-        } catch (const std::exception& e) {
-            ErrorLogger() << "Exception caught regex parsing script file: " << e.what();
-            std::cerr << "Exception caught regex parsing script file: " << e.what() << std::endl;
-            return;
+
+            if (copied_up_to == 0)
+                return;
+            retval.append(text, copied_up_to, std::string::npos);
+            text.swap(retval);
         }
-    }
 
-    std::set<std::string> macros_directly_referenced_in_text(const std::string& text) {
-        std::set<std::string> retval;
-        try {
-            std::size_t position = 0; // position in the text, past the already processed part
-            smatch match;
-            while (regex_search(text.begin() + position, text.end(), match, MACRO_INSERTION, regex_constants::match_default)) {
-                position += match.position() + match.length();
-                retval.insert(match[1]);
+        /** Expands macro insertions using a set of macro definitions. Each
+          * macro's own text is expanded at most once, when it is first
+          * inserted, and macros that eventually reference themselves are
+          * found once up front, rather than at each insertion. */
+        class MacroExpander {
+        public:
+            MacroExpander(const std::map<std::string, std::string>& macros,
+                          const boost::filesystem::path& file_path) :
+                m_macros(macros),
+                m_file_path(file_path)
+            { FindCyclicMacros(); }
+
+            /** Returns \a text with macro insertions replaced by the expanded
+              * text of the inserted macros. */
+            std::string Expand(const std::string& text, int depth = 0) {
+                std::string retval;
+                std::size_t copied_up_to = 0;
+                for_each_macro_insertion(text, [this, &text, &retval, &copied_up_to, depth](const MacroInsertion& insertion) {
+                    auto macro_it = m_macros.find(insertion.key);
+                    if (macro_it == m_macros.end()) {
+                        ErrorLogger() << m_file_path.generic_string() << ": Unresolved macro reference: " << insertion.key;
+                        return;
+                    }
+                    if (m_cyclic_macros.count(insertion.key)) {
+                        ErrorLogger() << m_file_path.generic_string() << ": Skipping cyclic macro reference: " << insertion.key;
+                        return;
+                    }
+                    if (depth >= MAX_DEPTH) {
+                        ErrorLogger() << m_file_path.generic_string() << ": Macro reference nested too deeply: " << insertion.key;
+                        return;
+                    }
+
+                    std::string replacement = ExpandedMacroText(macro_it->first);
+                    if (!insertion.params.empty()) { // found macro parameters
+                        int replace_number = 1;
+                        std::string macro_params = insertion.params; // arg1,arg2,arg3,etc.
+                        for (boost::split_iterator<std::string::iterator> it =
+                                boost::make_split_iterator(macro_params, boost::first_finder(",", boost::is_iequal()));
+                            it != boost::split_iterator<std::string::iterator>();
+                            ++it, ++replace_number)
+                        {
+                            // not using %1% (and boost::fmt) because the replaced text may itself have %s inside it that will get eaten
+                            boost::replace_all(replacement, "@" + std::to_string(replace_number) + "@", boost::copy_range<std::string>(*it));
+                        }
+                        // arguments may form new macro insertions
+                        replacement = Expand(replacement, depth + 1);
+                    }
+
+                    retval.append(text, copied_up_to, insertion.begin - copied_up_to);
+                    retval.append(replacement);
+                    copied_up_to = insertion.end;
+                });
+
+                if (copied_up_to == 0)
+                    return text;
+                retval.append(text, copied_up_to, std::string::npos);
+                return retval;
             }
-        } catch (const std::exception& e) {
-            ErrorLogger() << "Exception caught regex parsing script file: " << e.what();
-            std::cerr << "Exception caught regex parsing script file: " << e.what() << std::endl;
-            return retval;
-        }
-        return retval;
-    }
 
-    bool macro_deep_referenced_in_text(const std::string& macro_to_find, const std::string& text,
-                                       const std::map<std::string, std::string>& macros)
-    {
-        TraceLogger() << "Checking if " << macro_to_find << " deep referenced in text: " << text;
-        // check of text directly references macro_to_find
-        std::set<std::string> macros_directly_referenced_in_input_text = macros_directly_referenced_in_text(text);
-        if (macros_directly_referenced_in_input_text.empty())
-            return false;
-        if (macros_directly_referenced_in_input_text.count(macro_to_find))
-            return true;
-        // check if macros referenced in text reference macro_to_find
-        for (const std::string& direct_referenced_macro_key : macros_directly_referenced_in_input_text) {
-            // get text of directly referenced macro
-            auto macro_it = macros.find(direct_referenced_macro_key);
-            if (macro_it == macros.end()) {
-                ErrorLogger() << "macro_deep_referenced_in_text couldn't find referenced macro: " << direct_referenced_macro_key;
-                continue;
+        private:
+            static constexpr int MAX_DEPTH = 100;
+
+            /** Returns the text of macro \a key, with its own insertions of
+              * other macros expanded. */
+            const std::string& ExpandedMacroText(const std::string& key) {
+                auto expanded_it = m_expanded_macros.find(key);
+                if (expanded_it != m_expanded_macros.end())
+                    return expanded_it->second;
+                // macro is not cyclic, so expanding it will not recurse back to it
+                std::string expanded = Expand(m_macros.at(key));
+                return m_expanded_macros.emplace(key, std::move(expanded)).first->second;
             }
-            const std::string& macro_text = macro_it->second;
-            // check of text of directly referenced macro has any reference to the macro_to_find
-            if (macro_deep_referenced_in_text(macro_to_find, macro_text, macros))
-                return true;
-        }
-        // didn't locate macro_to_find in any of the macros referenced in this text
-        return false;
-    }
 
-    void check_for_cyclic_macro_references(const std::map<std::string, std::string>& macros) {
-        for (const auto& macro : macros) {
-            if (macro_deep_referenced_in_text(macro.first, macro.second, macros))
-                ErrorLogger() << "Cyclic macro found: " << macro.first << " references itself (eventually)";
-        }
-    }
+            /** Finds macros that eventually reference themselves, by finding
+              * the strongly connected components of the graph of references
+              * between macros. */
+            void FindCyclicMacros() {
+                std::map<std::string, std::set<std::string>> references;
+                for (const auto& [key, text] : m_macros) {
+                    auto& macro_references = references[key];
+                    for_each_macro_insertion(text, [this, &macro_references](const MacroInsertion& insertion) {
+                        if (m_macros.count(insertion.key))
+                            macro_references.insert(insertion.key);
+                    });
+                }
 
-    void replace_macro_references(std::string& text,
-                                  const std::map<std::string, std::string>& macros,
-                                  const boost::filesystem::path& file_path)
-    {
-        try {
-            std::size_t position = 0; // position in the text, past the already processed part
-            smatch match;
-            while (regex_search(text.begin() + position, text.end(), match, MACRO_INSERTION, regex_constants::match_default)) {
-                position += match.position();
-                const std::string& matched_text = match.str();  // [[MACRO_KEY]] or [[MACRO_KEY(foo,bar,...)]]
-                const std::string& macro_key = match[1];        // just MACRO_KEY
-                // look up macro key to insert
-                auto macro_lookup_it = macros.find(macro_key);
-                if (macro_lookup_it != macros.end()) {
-                    // verify that macro is safe: check for cyclic reference of macro to itself
-                    if (macro_deep_referenced_in_text(macro_key, macro_lookup_it->second, macros)) {
-                        ErrorLogger() << file_path.generic_string() << ": Skipping cyclic macro reference: " << macro_key;
-                        position += match.length();
-                    } else {
-                        // insert macro text in place of reference
-                        std::string replacement = macro_lookup_it->second;
-                        std::string macro_params = match[2]; // arg1,arg2,arg3,etc.
-                        if (!macro_params.empty()) { // found macro parameters
-                            int replace_number = 1;
-                            for (boost::split_iterator<std::string::iterator> it =
-                                    boost::make_split_iterator(macro_params, boost::first_finder(",", boost::is_iequal()));
-                                it != boost::split_iterator<std::string::iterator>();
-                                ++it, ++replace_number)
-                            {
-                                // not using %1% (and boost::fmt) because the replaced text may itself have %s inside it that will get eaten
-                                boost::replace_all(replacement, "@" + std::to_string(replace_number) + "@", boost::copy_range<std::string>(*it));
-                            }
+                // Tarjan's algorithm
+                std::map<std::string, std::pair<int, int>> index_and_lowlink;
+                std::vector<std::string> stack;
+                std::set<std::string> on_stack;
+                int next_index = 0;
+
+                std::function<void (const std::string&)> visit = [&](const std::string& key) {
+                    auto& [index, lowlink] = index_and_lowlink[key];
+                    index = lowlink = next_index++;
+                    stack.push_back(key);
+                    on_stack.insert(key);
+
+                    for (const auto& referenced : references[key]) {
+                        if (!index_and_lowlink.count(referenced)) {
+                            visit(referenced);
+                            index_and_lowlink[key].second = std::min(index_and_lowlink[key].second,
+                                                                     index_and_lowlink[referenced].second);
+                        } else if (on_stack.count(referenced)) {
+                            index_and_lowlink[key].second = std::min(index_and_lowlink[key].second,
+                                                                     index_and_lowlink[referenced].first);
                         }
-                        text.replace(position, matched_text.length(), replacement);
-                        // recursive replacement allowed, so don't skip past
-                        // start of replacement text, so that inserted text can
-                        // be matched on the next pass
                     }
-                } else {
-                    ErrorLogger() << file_path.generic_string() << ": Unresolved macro reference: " << macro_key;
-                    position += match.length();
-                }
+
+                    if (index_and_lowlink[key].second != index_and_lowlink[key].first)
+                        return;
+
+                    // key is the root of a component, which is on the stack above it
+                    auto component_begin = std::find(stack.begin(), stack.end(), key);
+                    const bool cyclic = std::distance(component_begin, stack.end()) > 1 || references[key].count(key);
+                    for (auto it = component_begin; it != stack.end(); ++it) {
+                        on_stack.erase(*it);
+                        if (cyclic) {
+                            ErrorLogger() << "Cyclic macro found: " << *it << " references itself (eventually)";
+                            m_cyclic_macros.insert(*it);
+                        }
+                    }
+                    stack.erase(component_begin, stack.end());
+                };
+
+                for (const auto& macro : m_macros)
+                    if (!index_and_lowlink.count(macro.first))
+                        visit(macro.first);
             }
-        } catch (const std::exception& e) {
-            ErrorLogger() << file_path.generic_string() << ": Exception caught regex parsing script file: " << e.what();
-            std::cerr << file_path.generic_string() << ": Exception caught regex parsing script file: " << e.what() << std::endl;
-            return;
-        }
+
+            const std::map<std::string, std::string>&   m_macros;
+            const boost::filesystem::path&              m_file_path;
+            std::set<std::string>                       m_cyclic_macros;
+            std::map<std::string, std::string>          m_expanded_macros;
+        };
     }
 
     void macro_substitution(std::string& text, const boost::filesystem::path& file_path) {
@@ -179,70 +292,114 @@ namespace parse {
         std::map<std::string, std::string> macros;
 
         parse_and_erase_macro_definitions(text, macros);
-        check_for_cyclic_macro_references(macros);
 
         //DebugLogger() << "after macro pasring text:" << text;
 
-        // recursively expand macro keys: replace [[MACRO_KEY]] in other macro
-        // text with the macro text corresponding to MACRO_KEY.
-        for (auto& macro : macros)
-            replace_macro_references(macro.second, macros, file_path);
-
         // substitute macro keys - replace [[MACRO_KEY]] in the input text with
-        // the macro text corresponding to MACRO_KEY
-        replace_macro_references(text, macros, file_path);
+        // the macro text corresponding to MACRO_KEY, recursively expanded
+        text = MacroExpander(macros, file_path).Expand(text);
 
         //DebugLogger() << "after macro substitution text: " << text;
     }
 
-    const sregex FILENAME_TEXT = -+_;   // any character, one or more times, not greedy
-    const sregex FILENAME_INSERTION = bol >> "#include" >> *space >> "\"" >> (s1 = FILENAME_TEXT) >> "\"" >> *space >> _n;
-
     std::set<std::string> missing_include_files;
+    std::mutex missing_include_files_mutex; // files are parsed on several threads at once
+
+    namespace {
+        /** Script files that have been read, by canonical path, as most files
+          * include the same few files. Included files don't change while they
+          * are being parsed, so are kept for the lifetime of the process. */
+        class IncludedFileCache {
+        public:
+            /** Reads \a canonical_path into \a contents, with a newline appended. */
+            bool Read(const boost::filesystem::path& canonical_path, std::string& contents) {
+                {
+                    std::scoped_lock lock(m_mutex);
+                    auto it = m_contents.find(canonical_path);
+                    if (it != m_contents.end()) {
+                        contents = it->second;
+                        return true;
+                    }
+                }
+                if (!ReadFile(canonical_path, contents))
+                    return false;
+                contents.append("\n");
+                std::scoped_lock lock(m_mutex);
+                m_contents.emplace(canonical_path, contents);
+                return true;
+            }
 
-    /** \brief Resolve script directives
-     *
-     * @param[in,out] text contents to search through
-     * @param[in] file_search_path base path of content
-     */
-    void file_substitution(std::string& text, const boost::filesystem::path& file_search_path) {
-        if (!boost::filesystem::is_directory(file_search_path)) {
-            ErrorLogger() << "File parsing include substitution given search path that is not a directory: "
-                          << file_search_path.string();
-            return;
+            /** Text of an included file with its own includes substituted, and
+              * the files that were included to produce it, including itself. */
+            struct Expansion {
+                std::string                         text;
+                std::set<boost::filesystem::path>   files_included;
+            };
+
+            std::shared_ptr<const Expansion> FindExpansion(const boost::filesystem::path& canonical_path) {
+                std::scoped_lock lock(m_mutex);
+                auto it = m_expansions.find(canonical_path);
+                return it == m_expansions.end() ? nullptr : it->second;
+            }
+
+            void StoreExpansion(const boost::filesystem::path& canonical_path, std::shared_ptr<const Expansion> expansion) {
+                std::scoped_lock lock(m_mutex);
+                m_expansions.emplace(canonical_path, std::move(expansion));
+            }
+
+        private:
+            std::mutex                                                              m_mutex;
+            std::map<boost::filesystem::path, std::string>                          m_contents;
+            std::map<boost::filesystem::path, std::shared_ptr<const Expansion>>     m_expansions;
+        };
+
+        IncludedFileCache& GetIncludedFileCache() {
+            static IncludedFileCache cache;
+            return cache;
         }
-        try {
-            std::set<boost::filesystem::path> files_included;
-            process_include_substitutions(text, file_search_path, files_included);
-        } catch (const std::exception& e) {
-            ErrorLogger() << "Exception caught regex parsing script file: " << e.what();
-            std::cerr << "Exception caught regex parsing script file: " << e.what() << std::endl;
-            return;
+
+        /** Parses an include directive, #include "filename" at the start of a
+          * line with nothing else on that line, starting at \a begin in \a text.
+          * If there is one, sets \a filename and \a end to the position after
+          * the directive's line. */
+        bool parse_include_directive(const std::string& text, std::size_t begin,
+                                     std::string& filename, std::size_t& end)
+        {
+            const std::string INCLUDE = "#include";
+            if (text.compare(begin, INCLUDE.size(), INCLUDE) != 0)
+                return false;
+            std::size_t pos = begin + INCLUDE.size();
+            while (pos < text.size() && text[pos] != '\n' && is_space_char(text[pos]))
+                ++pos;
+            if (pos >= text.size() || text[pos] != '"')
+                return false;
+            const std::size_t filename_begin = pos + 1;
+            const std::size_t filename_end = text.find_first_of("\"\n", filename_begin);
+            if (filename_end == std::string::npos || text[filename_end] != '"' || filename_end == filename_begin)
+                return false;
+            pos = filename_end + 1;
+            while (pos < text.size() && text[pos] != '\n' && is_space_char(text[pos]))
+                ++pos;
+            if (pos >= text.size() || text[pos] != '\n')
+                return false;
+
+            filename = text.substr(filename_begin, filename_end - filename_begin);
+            end = pos + 1;
+            return true;
         }
-    }
 
-    /** \brief Replace all include statements with contents of file
-     *
-     * Search for any include statements in *text* and replace them with the contents
-     * of the file given.  File lookup is relative to *file_search_path* and will not
-     * be included if found in *files_included*.
-     * Each included file is added to *files_included*.
-     * This is a recursive function, processing the contents of any included files.
-     *
-     * @param[in,out] text content to search through
-     * @param[in] file_search_path base path of content
-     * @param[in,out] files_included canonical path of any files previously included
-     * */
-    void process_include_substitutions(std::string& text, const boost::filesystem::path& file_search_path,
-                                       std::set<boost::filesystem::path>& files_included)
-    {
-        smatch match;
-        while (regex_search(text.begin(), text.end(), match, FILENAME_INSERTION, regex_constants::match_default)) {
-            const std::string& fn_match = match[1];
-            if (fn_match.empty()) {
-                continue;
-            }
-            const sregex INCL_ONCE_SEARCH = bol >> "#include" >> *space >> "\"" >> fn_match >> "\"" >> *space >> _n;
+        void expand_includes(const std::string& text, const boost::filesystem::path& file_search_path,
+                             std::set<boost::filesystem::path>& files_included, std::string& out);
+
+        /** Appends to \a out the contents of the file(s) included by
+          * #include "\a fn_match" in a file in \a file_search_path. Returns
+          * false if nothing was included, as the file was missing or had
+          * already been included. */
+        bool expand_include(const std::string& fn_match, const boost::filesystem::path& file_search_path,
+                            std::set<boost::filesystem::path>& files_included, std::string& out)
+        {
+            auto& cache = GetIncludedFileCache();
+
             boost::filesystem::path base_path;
             boost::filesystem::path match_path;
             // check for base path
@@ -254,10 +411,11 @@ namespace parse {
                 match_path = base_path / fn_match;
             }
             std::string fn_str = boost::filesystem::path(fn_match).filename().string();
+
             if (fn_str.substr(0, 1) == "*") {
                 if (match_path.parent_path().empty()) {
                     DebugLogger() << "Parse: " << match_path.parent_path().string() << " is empty, skipping.";
-                    continue;
+                    return false;
                 }
                 fn_str = fn_str.substr(1, fn_str.size() - 1);
                 std::set<boost::filesystem::path> match_list;
@@ -272,37 +430,139 @@ namespace parse {
                         }
                     }
                 }
-                // read in results
+                // read in results. their includes are relative to the
+                // including file, not to the included files
                 std::string dir_text;
                 for (const boost::filesystem::path& file : match_list) {
-                    if (files_included.insert(boost::filesystem::canonical(file)).second) {
+                    const auto canonical_file = boost::filesystem::canonical(file);
+                    if (files_included.insert(canonical_file).second) {
                         std::string new_text;
-                        if (ReadFile(file, new_text)) {
-                            new_text.append("\n");
+                        if (cache.Read(canonical_file, new_text))
                             dir_text.append(new_text);
-                        } else {
+                        else
                             ErrorLogger() << "Parse: Unable to read file " << file.string();
-                        }
                     }
                 }
-                text = regex_replace(text, INCL_ONCE_SEARCH, dir_text, regex_constants::format_first_only);
-            } else if (files_included.insert(boost::filesystem::canonical(match_path)).second) {
-                std::string file_content;
-                if (ReadFile(match_path, file_content)) {
-                    file_content.append("\n");
-                    process_include_substitutions(file_content, match_path.parent_path(), files_included);
-                    text = regex_replace(text, INCL_ONCE_SEARCH, file_content, regex_constants::format_first_only);
-                } else if (missing_include_files.insert(PathToString(match_path)).second) {
+                expand_includes(dir_text, file_search_path, files_included, out);
+                return true;
+            }
+
+            if (!boost::filesystem::exists(match_path)) {
+                std::scoped_lock lock(missing_include_files_mutex);
+                if (missing_include_files.insert(PathToString(match_path)).second) {
                     ErrorLogger() << "Parse: " << PathToString(match_path) << " was not found for inclusion (Path:"
                                   << PathToString(base_path) << ") (File:" << fn_str << ")";
                 }
+                return false;
+            }
+
+            const auto canonical_path = boost::filesystem::canonical(match_path);
+            if (!files_included.insert(canonical_path).second)
+                return false;   // each file is only included once
+
+            // an included file's expansion only depends on which of the files
+            // it includes have already been included, so its expansion on
+            // its own can be reused when none of those files have been
+            auto expansion = cache.FindExpansion(canonical_path);
+            if (!expansion) {
+                std::string file_content;
+                if (!cache.Read(canonical_path, file_content)) {
+                    ErrorLogger() << "Parse: Unable to read file " << PathToString(match_path);
+                    return false;
+                }
+                auto new_expansion = std::make_shared<IncludedFileCache::Expansion>();
+                new_expansion->files_included.insert(canonical_path);
+                expand_includes(file_content, match_path.parent_path(), new_expansion->files_included,
+                                new_expansion->text);
+                cache.StoreExpansion(canonical_path, new_expansion);
+                expansion = std::move(new_expansion);
+            }
+
+            const bool reusable = std::none_of(
+                expansion->files_included.begin(), expansion->files_included.end(),
+                [&files_included, &canonical_path](const auto& file)
+                { return file != canonical_path && files_included.count(file); });
+            if (reusable) {
+                files_included.insert(expansion->files_included.begin(), expansion->files_included.end());
+                out.append(expansion->text);
+            } else {
+                std::string file_content;
+                if (cache.Read(canonical_path, file_content))
+                    expand_includes(file_content, match_path.parent_path(), files_included, out);
+            }
+            return true;
+        }
+
+        /** Appends \a text to \a out, with include directives replaced by the
+          * contents of the included files, in one pass through \a text. */
+        void expand_includes(const std::string& text, const boost::filesystem::path& file_search_path,
+                             std::set<boost::filesystem::path>& files_included, std::string& out)
+        {
+            std::string filename;
+            std::size_t line_begin = 0;
+            std::size_t copied_up_to = 0;
+            while (line_begin < text.size()) {
+                std::size_t directive_end = 0;
+                if (text[line_begin] == '#' && parse_include_directive(text, line_begin, filename, directive_end)) {
+                    out.append(text, copied_up_to, line_begin - copied_up_to);
+                    // the directive's line is replaced by the included text,
+                    // which ends with a newline, or by just a newline
+                    if (!expand_include(filename, file_search_path, files_included, out))
+                        out.append("\n");
+                    copied_up_to = line_begin = directive_end;
+                    continue;
+                }
+                const std::size_t line_end = text.find('\n', line_begin);
+                if (line_end == std::string::npos)
+                    break;
+                line_begin = line_end + 1;
             }
-            // remove any remaining includes of this file
-            text = regex_replace(text, INCL_ONCE_SEARCH, "\n", regex_constants::match_default);
-            // TraceLogger() << "Parse: contents after scrub of " << fn_match << ":\n" << text;
+            out.append(text, copied_up_to, std::string::npos);
+        }
+    }
+
+    /** \brief Resolve script directives
+     *
+     * @param[in,out] text contents to search through
+     * @param[in] file_search_path base path of content
+     */
+    void file_substitution(std::string& text, const boost::filesystem::path& file_search_path) {
+        if (!boost::filesystem::is_directory(file_search_path)) {
+            ErrorLogger() << "File parsing include substitution given search path that is not a directory: "
+                          << file_search_path.string();
+            return;
+        }
+        try {
+            std::set<boost::filesystem::path> files_included;
+            process_include_substitutions(text, file_search_path, files_included);
+        } catch (const std::exception& e) {
+            ErrorLogger() << "Exception caught parsing includes in script file: " << e.what();
+            std::cerr << "Exception caught parsing includes in script file: " << e.what() << std::endl;
+            return;
         }
     }
 
+    /** \brief Replace all include statements with contents of file
+     *
+     * Search for any include statements in *text* and replace them with the contents
+     * of the file given.  File lookup is relative to *file_search_path* and will not
+     * be included if found in *files_included*.
+     * Each included file is added to *files_included*.
+     * Included files are processed the same way, in the same pass through *text*.
+     *
+     * @param[in,out] text content to search through
+     * @param[in] file_search_path base path of content
+     * @param[in,out] files_included canonical path of any files previously included
+     * */
+    void process_include_substitutions(std::string& text, const boost::filesystem::path& file_search_path,
+                                       std::set<boost::filesystem::path>& files_included)
+    {
+        std::string retval;
+        retval.reserve(text.size());
+        expand_includes(text, file_search_path, files_included, retval);
+        text.swap(retval);
+    }
+
     namespace detail {
     double_grammar::double_grammar(const parse::lexer& tok) :
         double_grammar::base_type(double_, "double_grammar")
@@ -472,6 +732,185 @@ namespace parse {
     }
 
 
+    namespace {
+        /** Directory of the script files whose preprocessed contents are cached. */
+        boost::filesystem::path scripting_dir()
+        { return GetResourceDir() / "scripting"; }
+
+        /** Returns a hash of the paths and contents of all the files in the
+          * scripting directory, combined with the FreeOrion version, or 0 if
+          * they could not all be read. Script files in that directory are
+          * preprocessed the same way while this is unchanged. */
+        std::size_t scripting_content_hash() {
+            static const std::size_t retval = []() -> std::size_t {
+                const auto dir = scripting_dir();
+                std::size_t hash = 0;
+                try {
+                    boost::hash_combine(hash, FreeOrionVersionString());
+                    boost::hash_combine(hash, PathToString(dir));
+                    std::vector<boost::filesystem::path> files;
+                    for (boost::filesystem::recursive_directory_iterator it(dir), end; it != end; ++it)
+                        if (boost::filesystem::is_regular_file(it->status()))
+                            files.push_back(it->path());
+                    std::sort(files.begin(), files.end());  // directory iteration order is unspecified
+                    for (const auto& file : files) {
+                        std::string contents;
+                        if (!ReadFile(file, contents))
+                            return 0;
+                        boost::hash_combine(hash, file.generic_string());
+                        boost::hash_combine(hash, contents);
+                    }
+                } catch (const std::exception& e) {
+                    ErrorLogger() << "Unable to hash scripting directory " << dir << ": " << e.what();
+                    return 0;
+                }
+                return hash ? hash : 1;
+            }();
+            return retval;
+        }
+
+        /** Returns the directory of the parse cache, or an empty path if
+          * caching is disabled. */
+        boost::filesystem::path parse_cache_dir() {
+            // the server passes its cache directory on to the AI clients it
+            // starts, so they reuse the files it preprocessed
+            if (!GetOptionsDB().OptionExists("resource.parse-cache.path"))
+                return {};
+            const auto cache_dir = GetOptionsDB().Get<std::string>("resource.parse-cache.path");
+            if (cache_dir.empty())
+                return {};
+            return FilenameToPath(cache_dir);
+        }
+
+        /** Returns the path of the file that caches the preprocessed contents
+          * of script file \a path, or an empty path if caching is disabled. */
+        boost::filesystem::path preprocessed_cache_path(const boost::filesystem::path& path) {
+            const auto cache_dir = parse_cache_dir();
+            if (cache_dir.empty())
+                return {};
+            std::ostringstream ss;
+            ss << std::hex << std::hash<std::string>{}(path.generic_string()) << ".focs.cache";
+            return cache_dir / ss.str();
+        }
+
+        /** Writes \a header and \a contents to the cache file \a cache_path.
+          * Failure to write the cache is not an error; what it caches is just
+          * recomputed next time. */
+        void write_cache_file(const boost::filesystem::path& cache_path, const std::string& header,
+                              const std::string& contents)
+        {
+            try {
+                boost::filesystem::create_directories(cache_path.parent_path());
+
+                // several processes may write the same cache file at once, so
+                // each writes its own temporary file which is then moved into place
+                const auto temp_path = cache_path.parent_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+                {
+                    boost::filesystem::ofstream ofs(temp_path, std::ios_base::binary);
+                    if (!ofs)
+                        return;
+                    ofs << header << contents;
+                    if (!ofs) {
+                        ofs.close();
+                        boost::filesystem::remove(temp_path);
+                        return;
+                    }
+                }
+                boost::system::error_code ec;
+                boost::filesystem::rename(temp_path, cache_path, ec);
+                if (ec)
+                    boost::filesystem::remove(temp_path, ec);
+            } catch (const std::exception& e) {
+                DebugLogger() << "Unable to write parse cache file " << cache_path << ": " << e.what();
+            }
+        }
+
+        /** Reads into \a file_contents the cached result of reading script file
+          * \a path and substituting its includes and macros, if it was cached
+          * while the scripting directory's contents were as they are now. */
+        bool read_cached_preprocessed_file(const boost::filesystem::path& path, std::string& file_contents) {
+            if (!IsInDir(scripting_dir(), path))
+                return false;
+            const std::size_t content_hash = scripting_content_hash();
+            if (!content_hash)
+                return false;
+
+            std::string cached;
+            const auto cache_path = preprocessed_cache_path(path);
+            if (cache_path.empty() || !boost::filesystem::exists(cache_path) || !ReadFile(cache_path, cached))
+                return false;
+
+            // first line of cache file is the content hash and script path it was cached for
+            const std::string expected_header = std::to_string(content_hash) + " " + path.generic_string() + "\n";
+            if (cached.compare(0, expected_header.size(), expected_header) != 0)
+                return false;
+
+            file_contents = cached.substr(expected_header.size());
+            return true;
+        }
+
+        /** Caches \a file_contents as the preprocessed contents of script file
+          * \a path. */
+        void write_cached_preprocessed_file(const boost::filesystem::path& path, const std::string& file_contents) {
+            if (!IsInDir(scripting_dir(), path))
+                return;
+            const std::size_t content_hash = scripting_content_hash();
+            if (!content_hash)
+                return;
+            const auto cache_path = preprocessed_cache_path(path);
+            if (cache_path.empty())
+                return;
+            write_cache_file(cache_path, std::to_string(content_hash) + " " + path.generic_string() + "\n",
+                             file_contents);
+        }
+
+        /** Returns the path of the file that caches the content checksums, or
+          * an empty path if caching is disabled. */
+        boost::filesystem::path content_checksums_cache_path() {
+            const auto cache_dir = parse_cache_dir();
+            return cache_dir.empty() ? boost::filesystem::path{} : cache_dir / "content_checksums.cache";
+        }
+    }
+
+    std::map<std::string, unsigned int> cached_content_checksums() {
+        std::map<std::string, unsigned int> retval;
+        const std::size_t content_hash = scripting_content_hash();
+        if (!content_hash)
+            return retval;
+
+        std::string cached;
+        const auto cache_path = content_checksums_cache_path();
+        if (cache_path.empty() || !boost::filesystem::exists(cache_path) || !ReadFile(cache_path, cached))
+            return retval;
+
+        // first line is the content hash the checksums were cached for,
+        // followed by a line with the name and checksum of each category
+        std::istringstream iss(cached);
+        std::size_t cached_hash = 0;
+        if (!(iss >> cached_hash) || cached_hash != content_hash)
+            return retval;
+        std::string name;
+        unsigned int checksum = 0;
+        while (iss >> name >> checksum)
+            retval[name] = checksum;
+        if (!iss.eof())
+            retval.clear();
+        return retval;
+    }
+
+    void cache_content_checksums(const std::map<std::string, unsigned int>& checksums) {
+        const std::size_t content_hash = scripting_content_hash();
+        if (!content_hash || checksums.empty())
+            return;
+        const auto cache_path = content_checksums_cache_path();
+        if (cache_path.empty())
+            return;
+        std::ostringstream ss;
+        for (const auto& [name, checksum] : checksums)
+            ss << name << " " << checksum << "\n";
+        write_cache_file(cache_path, std::to_string(content_hash) + "\n", ss.str());
+    }
+
     /** \brief Load and parse script file(s) from given path
         *
         * @param[in] path absolute path to a regular file
@@ -483,21 +922,33 @@ namespace parse {
         */
     void parse_file_common(const boost::filesystem::path& path, const parse::lexer& lexer,
                            std::string& filename, std::string& file_contents,
-                           parse::text_iterator& first, parse::text_iterator& last, parse::token_iterator& it)
+                           parse::text_iterator& first, parse::text_iterator& last, parse::token_iterator& it,
+                           file_parse_profiler& profiler)
     {
         filename = path.string();
 
-        bool read_success = ReadFile(path, file_contents);
-        if (!read_success) {
-            ErrorLogger() << "Unable to open data file " << filename;
-            return;
-        }
+        // substituting includes and macros takes much of the time to parse
+        // a file, so its result is cached between processes
+        if (read_cached_preprocessed_file(path, file_contents)) {
+            profiler.preprocessed(file_contents, true);
+        } else {
+            bool read_success = ReadFile(path, file_contents);
+            if (!read_success) {
+                ErrorLogger() << "Unable to open data file " << filename;
+                return;
+            }
 
-        // add newline at end to avoid errors when one is left out, but is expected by parsers
-        file_contents += "\n";
+            // add newline at end to avoid errors when one is left out, but is expected by parsers
+            file_contents += "\n";
 
-        file_substitution(file_contents, path.parent_path());
-        macro_substitution(file_contents, path);
+            ScopedTimer timer([&filename]() { return "Preprocessing " + filename; },
+                              std::chrono::milliseconds(10));
+            file_substitution(file_contents, path.parent_path());
+            macro_substitution(file_contents, path);
+
+            write_cached_preprocessed_file(path, file_contents);
+            profiler.preprocessed(file_contents, false);
+        }
 
         first = file_contents.begin();
         last = file_contents.end();
@@ -532,4 +983,145 @@ namespace parse {
 
         return parser_success && parse_length_good;
     }
-}}
+
+    namespace {
+        std::atomic<bool>               profiling_enabled = false;
+        std::vector<FileParseProfile>   file_profiles;
+        std::mutex                      file_profiles_mutex;
+
+        /** Returns the peak resident memory of this process, in bytes, or 0 if
+          * it is not known. */
+        std::size_t peak_resident_memory() {
+#if defined(FREEORION_WIN32)
+            return 0;   // would need linking to psapi
+#else
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+                return 0;
+#  if defined(FREEORION_MACOSX)
+            return static_cast<std::size_t>(usage.ru_maxrss);           // bytes
+#  else
+            return static_cast<std::size_t>(usage.ru_maxrss) * 1024;    // kilobytes
+#  endif
+#endif
+        }
+    }
+
+    file_parse_profiler::file_parse_profiler(const boost::filesystem::path& path) :
+        m_enabled(ProfilingEnabled())
+    {
+        if (!m_enabled)
+            return;
+        m_profile.path = path;
+        m_start = m_preprocessed = clock::now();
+    }
+
+    file_parse_profiler::~file_parse_profiler() {
+        if (!m_enabled)
+            return;
+        m_profile.parse_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - m_preprocessed);
+        m_profile.peak_memory = peak_resident_memory();
+        std::scoped_lock lock(file_profiles_mutex);
+        file_profiles.push_back(std::move(m_profile));
+    }
+
+    void file_parse_profiler::preprocessed(const std::string& file_contents, bool from_cache) {
+        if (!m_enabled)
+            return;
+        m_preprocessed = clock::now();
+        m_profile.preprocess_time = std::chrono::duration_cast<std::chrono::microseconds>(m_preprocessed - m_start);
+        m_profile.preprocessed_size = file_contents.size();
+        m_profile.preprocess_cached = from_cache;
+    }
+}
+
+    void SetProfilingEnabled(bool enabled)
+    { detail::profiling_enabled = enabled; }
+
+    bool ProfilingEnabled()
+    { return detail::profiling_enabled; }
+
+    void ClearProfiles() {
+        std::scoped_lock lock(detail::file_profiles_mutex);
+        detail::file_profiles.clear();
+    }
+
+    std::vector<FileParseProfile> FileProfiles() {
+        std::scoped_lock lock(detail::file_profiles_mutex);
+        return detail::file_profiles;
+    }
+
+    std::string ProfileCategory(const boost::filesystem::path& file, const boost::filesystem::path& scripting_dir) {
+        const auto relative = file.lexically_relative(scripting_dir);
+        if (relative.empty() || *relative.begin() == "..")
+            return file.parent_path().filename().string();    // not in the scripting directory
+        if (std::next(relative.begin()) == relative.end()) {
+            // file directly in scripting directory, named after its content
+            const auto filename = relative.filename().string();
+            return filename.substr(0, filename.find('.'));
+        }
+        return relative.begin()->string();
+    }
+
+    namespace {
+        std::string json_string(const std::string& str) {
+            std::string retval = "\"";
+            for (char c : str) {
+                if (c == '"' || c == '\\')
+                    retval.push_back('\\');
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    retval.push_back(c);
+            }
+            retval.push_back('"');
+            return retval;
+        }
+    }
+
+    std::string ProfileReport(const boost::filesystem::path& scripting_dir) {
+        struct CategoryTotals {
+            std::size_t                 num_files = 0;
+            std::chrono::microseconds   preprocess_time{0};
+            std::chrono::microseconds   parse_time{0};
+            std::size_t                 peak_memory = 0;
+        };
+
+        const auto profiles = FileProfiles();
+        std::map<std::string, CategoryTotals> categories;
+        std::size_t peak_memory = 0;
+
+        std::stringstream ss;
+        ss << "{\n  \"files\": [";
+        for (std::size_t idx = 0; idx < profiles.size(); ++idx) {
+            const auto& profile = profiles[idx];
+            const auto category = ProfileCategory(profile.path, scripting_dir);
+            auto& totals = categories[category];
+            ++totals.num_files;
+            totals.preprocess_time += profile.preprocess_time;
+            totals.parse_time += profile.parse_time;
+            totals.peak_memory = std::max(totals.peak_memory, profile.peak_memory);
+            peak_memory = std::max(peak_memory, profile.peak_memory);
+
+            ss << (idx ? ",\n" : "\n")
+               << "    {\"path\": " << json_string(profile.path.generic_string())
+               << ", \"category\": " << json_string(category)
+               << ", \"preprocess_us\": " << profile.preprocess_time.count()
+               << ", \"parse_us\": " << profile.parse_time.count()
+               << ", \"preprocessed_size\": " << profile.preprocessed_size
+               << ", \"preprocess_cached\": " << (profile.preprocess_cached ? "true" : "false")
+               << ", \"peak_memory\": " << profile.peak_memory << "}";
+        }
+        ss << "\n  ],\n  \"categories\": [";
+        bool first = true;
+        for (const auto& [name, totals] : categories) {
+            ss << (first ? "\n" : ",\n")
+               << "    {\"name\": " << json_string(name)
+               << ", \"files\": " << totals.num_files
+               << ", \"preprocess_us\": " << totals.preprocess_time.count()
+               << ", \"parse_us\": " << totals.parse_time.count()
+               << ", \"peak_memory\": " << totals.peak_memory << "}";
+            first = false;
+        }
+        ss << "\n  ],\n  \"peak_memory\": " << peak_memory << "\n}\n";
+        return ss.str();
+    }
+}
@@ -11,8 +11,10 @@
 #include <boost/uuid/uuid.hpp>
 
 #include <array>
+#include <chrono>
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 
 class BuildingType;
@@ -85,6 +87,46 @@ namespace parse {
     FO_PARSE_API bool int_free_variable(std::string& text);
     FO_PARSE_API bool double_free_variable(std::string& text);
     FO_PARSE_API bool string_free_variable(std::string& text);
+
+    /** Time spent on one script file, recorded while profiling is enabled.
+        Tokens are lexed on demand by the parser, so lexing time is included
+        in \a parse_time. */
+    struct FileParseProfile {
+        boost::filesystem::path     path;
+        std::chrono::microseconds   preprocess_time{0};
+        std::chrono::microseconds   parse_time{0};
+        std::size_t                 preprocessed_size = 0;  ///< characters, after substituting includes and macros
+        bool                        preprocess_cached = false;
+        std::size_t                 peak_memory = 0;        ///< bytes of peak resident memory of the process after parsing
+    };
+
+    /** Returns the content checksums, by category, that were cached while
+        the scripting directory's contents were as they are now, or an empty
+        map if there are none. */
+    FO_PARSE_API std::map<std::string, unsigned int> cached_content_checksums();
+
+    /** Caches \p checksums as the content checksums for the scripting
+        directory's current contents. */
+    FO_PARSE_API void cache_content_checksums(const std::map<std::string, unsigned int>& checksums);
+
+    /** Enables or disables recording a FileParseProfile for each parsed file. */
+    FO_PARSE_API void SetProfilingEnabled(bool enabled);
+    FO_PARSE_API bool ProfilingEnabled();
+    FO_PARSE_API void ClearProfiles();
+
+    /** Returns profiles of the files parsed since profiling was enabled or
+        profiles were last cleared, in the order parsing of each finished. */
+    FO_PARSE_API std::vector<FileParseProfile> FileProfiles();
+
+    /** Returns a JSON report of the recorded profiles, per file and totalled
+        per category. The category of a file is the first directory of its
+        path relative to \p scripting_dir, such as techs or species, or its
+        name without extensions for files directly in \p scripting_dir. */
+    FO_PARSE_API std::string ProfileReport(const boost::filesystem::path& scripting_dir);
+
+    /** Returns the category of \p file in the profile report. */
+    FO_PARSE_API std::string ProfileCategory(const boost::filesystem::path& file,
+                                             const boost::filesystem::path& scripting_dir);
 }
 
 #endif
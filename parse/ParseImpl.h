@@ -1,11 +1,17 @@
 #ifndef _ParseImpl_h_
 #define _ParseImpl_h_
 
+#include "Parse.h"
 #include "ReportParseError.h"
 #include "../util/Logger.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <exception>
+#include <vector>
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/filesystem/path.hpp>
@@ -150,13 +156,33 @@ namespace parse { namespace detail {
         color_rule_type start;
     };
 
+    /** Records a FileParseProfile for a script file, if profiling is enabled
+        when it is constructed, when it is destroyed. */
+    class file_parse_profiler {
+    public:
+        explicit file_parse_profiler(const boost::filesystem::path& path);
+        ~file_parse_profiler();
+
+        /** Marks the end of preprocessing, which produced \a file_contents. */
+        void preprocessed(const std::string& file_contents, bool from_cache);
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        const bool                  m_enabled;
+        FileParseProfile            m_profile;
+        clock::time_point           m_start;
+        clock::time_point           m_preprocessed;
+    };
+
     void parse_file_common(const boost::filesystem::path& path,
                            const lexer& lexer,
                            std::string& filename,
                            std::string& file_contents,
                            text_iterator& first,
                            text_iterator& last,
-                           token_iterator& it);
+                           token_iterator& it,
+                           file_parse_profiler& profiler);
 
     /** Report warnings about unparsed end of file and return true for a good
         parse. */
@@ -170,13 +196,14 @@ namespace parse { namespace detail {
     bool parse_file(const lexer& lexer, const boost::filesystem::path& path, Arg1& arg1) {
         ScopedTimer timer("parse_file \"" + path.filename().string()  + "\"", std::chrono::milliseconds(100));
 
+        file_parse_profiler profiler(path);
         std::string filename;
         std::string file_contents;
         text_iterator first;
         text_iterator last;
         token_iterator it;
 
-        parse_file_common(path, lexer, filename, file_contents, first, last, it);
+        parse_file_common(path, lexer, filename, file_contents, first, last, it, profiler);
 
         //TraceLogger() << "Parse: parsed contents for " << path.string() << " : \n" << file_contents;
 
@@ -194,13 +221,14 @@ namespace parse { namespace detail {
     bool parse_file(const lexer& lexer, const boost::filesystem::path& path, Arg1& arg1, Arg2& arg2) {
         ScopedTimer timer("parse_file \"" + path.filename().string()  + "\"", std::chrono::milliseconds(10));
 
+        file_parse_profiler profiler(path);
         std::string filename;
         std::string file_contents;
         text_iterator first;
         text_iterator last;
         token_iterator it;
 
-        parse_file_common(path, lexer, filename, file_contents, first, last, it);
+        parse_file_common(path, lexer, filename, file_contents, first, last, it, profiler);
 
         //TraceLogger() << "Parse: parsed contents for " << path.string() << " : \n" << file_contents;
 
@@ -214,6 +242,55 @@ namespace parse { namespace detail {
         return parse_file_end_of_file_warnings(path, success, file_contents, first, last);
     }
 
+    /** Calls \a parse_one(lexer, idx) for each index \a idx into \a files, in
+      * parallel. Each task has its own lexer, as a lexer should not be used by
+      * more than one thread at once. Rethrows the first exception thrown by
+      * any call, in the order of \a files. */
+    template <typename ParseOne>
+    void parse_files_in_parallel(const std::vector<boost::filesystem::path>& files, const ParseOne& parse_one) {
+        const std::size_t num_tasks = std::min(files.size(), std::max<std::size_t>(1, GetThreadPool().NumThreads()));
+        std::vector<std::exception_ptr> errors(files.size());
+
+        TaskBatch task_batch("parse files");
+        for (std::size_t task_idx = 0; task_idx < num_tasks; ++task_idx) {
+            task_batch.Post([&files, &parse_one, &errors, task_idx, num_tasks]() {
+                const lexer lexer;
+                // interleave files between tasks, so that directories of
+                // similar files are spread between them
+                for (std::size_t idx = task_idx; idx < files.size(); idx += num_tasks) {
+                    try {
+                        parse_one(lexer, idx);
+                    } catch (...) {
+                        errors[idx] = std::current_exception();
+                    }
+                }
+            });
+        }
+        task_batch.Wait();
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    /** Parses each of \a files with \a Grammar into its own map, in parallel,
+      * then moves the entries of those into \a map, in the order of \a files.
+      * As if the files had been parsed one after another into \a map, an
+      * entry whose name is already in \a map is dropped, and logged as a
+      * duplicate \a type. */
+    template <typename Grammar, typename Map>
+    void parse_files_into_map(const std::vector<boost::filesystem::path>& files, Map& map, const std::string& type) {
+        std::vector<Map> file_maps(files.size());
+        parse_files_in_parallel(files, [&files, &file_maps](const lexer& lexer, std::size_t idx)
+                                { parse_file<Grammar, Map>(lexer, files[idx], file_maps[idx]); });
+
+        for (auto& file_map : file_maps) {
+            for (auto& entry : file_map)
+                if (is_unique{}(map, type, entry.first))
+                    map.emplace(entry.first, std::move(entry.second));
+        }
+    }
+
 } }
 
 #endif
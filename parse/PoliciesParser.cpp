@@ -193,13 +193,11 @@ namespace {
 
 namespace parse {
     start_rule_payload policies(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload policies_;
 
         ScopedTimer timer("Policies Parsing", true);
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            detail::parse_file<grammar, start_rule_payload>(lexer, file, policies_);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), policies_, "Policy");
 
         return policies_;
     }
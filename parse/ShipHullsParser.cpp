@@ -208,11 +208,9 @@ struct ShipHullStats {
 
 namespace parse {
     start_rule_payload ship_hulls(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload hulls;
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            /*auto success =*/ detail::parse_file<grammar, start_rule_payload>(lexer, file, hulls);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), hulls, "Hull");
 
         return hulls;
     }
@@ -167,11 +167,9 @@ namespace {
 
 namespace parse {
     start_rule_payload ship_parts(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload parts;
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            /*auto success =*/ detail::parse_file<grammar, start_rule_payload>(lexer, file, parts);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), parts, "Part");
 
         return parts;
     }
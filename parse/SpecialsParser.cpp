@@ -142,11 +142,9 @@ namespace {
 
 namespace parse {
     start_rule_payload specials(const boost::filesystem::path& path) {
-        const lexer lexer;
         start_rule_payload specials_;
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            /*auto success =*/ detail::parse_file<grammar, start_rule_payload>(lexer, file, specials_);
+        detail::parse_files_into_map<grammar>(ListDir(path, IsFOCScript), specials_, "Special");
 
         return specials_;
     }
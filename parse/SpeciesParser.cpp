@@ -395,15 +395,17 @@ namespace parse {
 
         ScopedTimer timer("Species Parsing", true);
 
+        std::vector<boost::filesystem::path> species_files;
         for (const auto& file : ListDir(path, IsFOCScript)) {
             if (file.filename() == "SpeciesCensusOrdering.focs.txt" ) {
                 manifest_file = file;
                 continue;
             }
-
-            detail::parse_file<grammar, start_rule_payload::first_type>(lexer, file, species_);
+            species_files.push_back(file);
         }
 
+        detail::parse_files_into_map<grammar>(species_files, species_, "Species");
+
         if (!manifest_file.empty()) {
             try {
                 detail::parse_file<manifest_grammar, start_rule_payload::second_type>(
@@ -32,8 +32,9 @@ namespace std {
 namespace {
     const boost::phoenix::function<parse::detail::is_unique> is_unique_;
 
-    std::set<std::string>* g_categories_seen = nullptr;
-    std::map<std::string, std::unique_ptr<TechCategory>>* g_categories = nullptr;
+    // set for each file, which may be parsed in parallel with other files
+    thread_local std::set<std::string>* g_categories_seen = nullptr;
+    thread_local std::map<std::string, std::unique_ptr<TechCategory>>* g_categories = nullptr;
 
     /// Check if the tech will be unique.
     bool check_tech(TechManager::TechContainer& techs, const std::unique_ptr<Tech>& tech) {
@@ -233,20 +234,54 @@ namespace {
 namespace parse {
     template <typename T>
     T techs(const boost::filesystem::path& path) {
-        const lexer lexer;
         TechManager::TechContainer techs_;
         std::map<std::string, std::unique_ptr<TechCategory>> categories;
         std::set<std::string> categories_seen;
 
-        g_categories_seen = &categories_seen;
-        g_categories = &categories;
-
         ScopedTimer timer("Techs Parsing", true);
 
-        detail::parse_file<grammar, TechManager::TechContainer>(lexer, path / "Categories.inf", techs_);
+        {
+            const lexer lexer;
+            g_categories_seen = &categories_seen;
+            g_categories = &categories;
+            detail::parse_file<grammar, TechManager::TechContainer>(lexer, path / "Categories.inf", techs_);
+        }
 
-        for (const auto& file : ListDir(path, IsFOCScript))
-            detail::parse_file<grammar, TechManager::TechContainer>(lexer, file, techs_);
+        // parse each file's techs separately, in parallel, then merge them in file order
+        struct FileTechs {
+            TechManager::TechContainer                              techs;
+            std::map<std::string, std::unique_ptr<TechCategory>>    categories;
+            std::set<std::string>                                   categories_seen;
+        };
+        const auto files = ListDir(path, IsFOCScript);
+        std::vector<FileTechs> file_techs(files.size());
+        detail::parse_files_in_parallel(files, [&files, &file_techs](const lexer& lexer, std::size_t idx) {
+            auto& parsed = file_techs[idx];
+            g_categories_seen = &parsed.categories_seen;
+            g_categories = &parsed.categories;
+            detail::parse_file<grammar, TechManager::TechContainer>(lexer, files[idx], parsed.techs);
+        });
+        g_categories_seen = nullptr;
+        g_categories = nullptr;
+
+        for (auto& parsed : file_techs) {
+            // the container's elements are const, so are moved out with a
+            // const_cast. the emptied container is only iterated and cleared,
+            // which doesn't look at the elements' keys, so this is safe.
+            for (auto& const_tech : parsed.techs.template get<TechManager::NameIndex>()) {
+                auto tech = std::move(const_cast<std::unique_ptr<Tech>&>(const_tech));
+                if (techs_.get<TechManager::NameIndex>().count(tech->Name())) {
+                    ErrorLogger() <<  "More than one tech has the name " << tech->Name();
+                    continue;
+                }
+                categories_seen.emplace(tech->Category());
+                techs_.emplace(std::move(tech));
+            }
+            parsed.techs.clear();
+            for (auto& category : parsed.categories)
+                if (detail::is_unique{}(categories, "Category", category.first))
+                    categories.emplace(category.first, std::move(category.second));
+        }
 
         return std::make_tuple(std::move(techs_), std::move(categories), categories_seen);
     }
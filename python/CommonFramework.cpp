@@ -236,3 +236,8 @@ const std::string GetPythonDir()
 
 const std::string GetPythonCommonDir()
 { return GetPythonDir(); }
+
+std::shared_mutex& GILReleasedGameStateMutex() {
+    static std::shared_mutex mutex;
+    return mutex;
+}
@@ -5,6 +5,8 @@
 #include <boost/python.hpp>
 #include <boost/python/dict.hpp>
 
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 
@@ -64,5 +66,41 @@ const std::string GetPythonDir();
 // returns folder containing common Python modules used by all Python scripts
 const std::string GetPythonCommonDir();
 
+// guards game state while wrapped functions that release the GIL use it
+std::shared_mutex& GILReleasedGameStateMutex();
+
+/** Releases the Python GIL and then takes a Lock on
+    GILReleasedGameStateMutex() while it exists, so that other Python threads
+    can run while a wrapped function does lengthy work in C++.  No Python
+    objects may be used while it exists.  Wrapped functions that change game
+    state use GILReleasedForWriting, and those that only read it use
+    GILReleasedForReading, so that readers can run concurrently with each
+    other.  Wrapped functions that keep the GIL don't take the lock, so must
+    not be called from another Python thread while one that changes game
+    state is running. */
+template <typename Lock>
+class GILReleased {
+public:
+    GILReleased() :
+        m_thread_state(PyEval_SaveThread()),
+        m_lock(GILReleasedGameStateMutex())
+    {}
+
+    ~GILReleased() {
+        m_lock.unlock();
+        PyEval_RestoreThread(m_thread_state);
+    }
+
+    GILReleased(const GILReleased&) = delete;
+    GILReleased& operator=(const GILReleased&) = delete;
+
+private:
+    PyThreadState* const    m_thread_state;
+    Lock                    m_lock;
+};
+
+using GILReleasedForReading = GILReleased<std::shared_lock<std::shared_mutex>>;
+using GILReleasedForWriting = GILReleased<std::unique_lock<std::shared_mutex>>;
+
 
 #endif /* defined(__FreeOrion__Python__CommonFramework__) */
@@ -9,6 +9,14 @@ namespace FreeOrionPython {
     void WrapEmpire();
     void WrapLogger();
     void WrapConfig();
+
+    /** Enables caching of the costlier queries wrapped by WrapEmpire().  Only
+        processes that call InvalidateEmpireQueries() whenever they change an
+        empire between turns should enable it. */
+    void EnableEmpireQueryCache(bool enable);
+
+    /** Makes cached empire queries be rebuilt when next asked for. */
+    void InvalidateEmpireQueries();
 }
 
 #endif
@@ -10,6 +10,7 @@
 #include "../universe/Tech.h"
 #include "../util/AppInterface.h"
 #include "../util/Logger.h"
+#include "CommonWrappers.h"
 #include "SetWrapper.h"
 
 #include <boost/mpl/vector.hpp>
@@ -19,6 +20,7 @@
 #include <boost/python/tuple.hpp>
 #include <boost/python/to_python_converter.hpp>
 
+#include <atomic>
 #include <iterator>
 #include <memory>
 
@@ -154,9 +156,74 @@ namespace {
             retval.insert(entry.first);
         return retval;
     }
+
+    bool                        s_query_cache_enabled = false;
+    std::atomic<unsigned int>   s_query_generation{0};
+
+    /** Results of an Empire query that Python asks for many times per turn
+        but that is costly to rebuild, kept per empire.  A result is shared
+        with Python read-only, so that Python can keep using one after it has
+        been replaced, and is rebuilt once the turn changes or
+        FreeOrionPython::InvalidateEmpireQueries() is called. */
+    template <typename T>
+    class EmpireQueryCache {
+    public:
+        using Result = std::shared_ptr<const T>;
+
+        template <typename Query>
+        auto Get(const Empire& empire, Query&& query) -> Result
+        {
+            auto& entry = m_entries[empire.EmpireID()];
+            const int turn = CurrentTurn();
+            const unsigned int generation = s_query_generation;
+            if (!s_query_cache_enabled || !entry.result || entry.turn != turn || entry.generation != generation)
+                entry = {std::make_shared<const T>(query(empire)), turn, generation};
+            return entry.result;
+        }
+
+    private:
+        struct Entry {
+            Result          result;
+            int             turn = INVALID_GAME_TURN;
+            unsigned int    generation = 0;
+        };
+        std::map<int, Entry> m_entries;
+    };
+
+    auto CachedAvailableShipDesigns(const Empire& empire) -> std::shared_ptr<const std::set<int>>
+    {
+        static EmpireQueryCache<std::set<int>> cache;
+        return cache.Get(empire, [](const Empire& empire) { return empire.AvailableShipDesigns(); });
+    }
+
+    auto CachedFleetSupplyableSystemIDs(const Empire& empire) -> std::shared_ptr<const std::set<int>>
+    {
+        static EmpireQueryCache<std::set<int>> cache;
+        return cache.Get(empire, [](const Empire& empire) { return GetSupplyManager().FleetSupplyableSystemIDs(empire.EmpireID()); });
+    }
+
+    auto CachedResearchedTechNames(const Empire& empire) -> std::shared_ptr<const std::set<std::string>>
+    {
+        static EmpireQueryCache<std::set<std::string>> cache;
+        return cache.Get(empire, ResearchedTechNames);
+    }
+
+    auto CachedSupplyProjections(const Empire& empire) -> std::shared_ptr<const std::map<int, int>>
+    {
+        static EmpireQueryCache<std::map<int, int>> cache;
+        return cache.Get(empire, jumpsToSuppliedSystem);
+    }
 }
 
 namespace FreeOrionPython {
+    void EnableEmpireQueryCache(bool enable) {
+        s_query_cache_enabled = enable;
+        InvalidateEmpireQueries();
+    }
+
+    void InvalidateEmpireQueries()
+    { ++s_query_generation; }
+
     /**
      * CallPolicies:
      *
@@ -193,6 +260,11 @@ namespace FreeOrionPython {
 
         py::class_<ResourcePool, std::shared_ptr<ResourcePool>, boost::noncopyable>("resPool", py::no_init);
 
+        // cached query results, see EmpireQueryCache
+        py::register_ptr_to_python<std::shared_ptr<const std::set<int>>>();
+        py::register_ptr_to_python<std::shared_ptr<const std::set<std::string>>>();
+        py::register_ptr_to_python<std::shared_ptr<const std::map<int, int>>>();
+
         FreeOrionPython::SetWrapper<std::set<int>>::Wrap("IntSetSet");
 
         py::class_<std::map<std::set<int>, float>>("resPoolMap")
@@ -226,8 +298,8 @@ namespace FreeOrionPython {
             .def("buildingTypeAvailable",           &Empire::BuildingTypeAvailable)
             .add_property("availableBuildingTypes", make_function(&Empire::AvailableBuildingTypes,  py::return_internal_reference<>()))
             .def("shipDesignAvailable",             (bool (Empire::*)(int) const)&Empire::ShipDesignAvailable)
-            .add_property("allShipDesigns",         make_function(&Empire::ShipDesigns,             py::return_value_policy<py::return_by_value>()))
-            .add_property("availableShipDesigns",   make_function(&Empire::AvailableShipDesigns,    py::return_value_policy<py::return_by_value>()))
+            .add_property("allShipDesigns",         make_function(&Empire::ShipDesigns,             py::return_internal_reference<>()))
+            .add_property("availableShipDesigns",   CachedAvailableShipDesigns)
             .add_property("availableShipParts",     make_function(&Empire::AvailableShipParts,      py::return_value_policy<py::copy_const_reference>()))
             .add_property("availableShipHulls",     make_function(&Empire::AvailableShipHulls,      py::return_value_policy<py::copy_const_reference>()))
             .add_property("productionQueue",        make_function(&Empire::GetProductionQueue,      py::return_internal_reference<>()))
@@ -247,10 +319,7 @@ namespace FreeOrionPython {
                                                     ))
 
             .def("techResearched",                  &Empire::TechResearched)
-            .add_property("availableTechs",         make_function(
-                                                        ResearchedTechNames,
-                                                        py::return_value_policy<py::return_by_value>()
-                                                    ))
+            .add_property("availableTechs",         CachedResearchedTechNames)
             .def("getTechStatus",                   &Empire::GetTechStatus)
             .def("researchProgress",                &Empire::ResearchProgress)
             .add_property("researchQueue",          make_function(&Empire::GetResearchQueue,        py::return_internal_reference<>()))
@@ -268,6 +337,10 @@ namespace FreeOrionPython {
 
             .def("canBuild",                        +[](const Empire& empire, BuildType build_type, const std::string& name, int location) -> bool { return empire.ProducibleItem(build_type, name, location); })
             .def("canBuild",                        +[](const Empire& empire, BuildType build_type, int design, int location) -> bool { return empire.ProducibleItem(build_type, design, location); })
+            .def("buildLocations",                  +[](const Empire& empire, BuildType build_type, const std::string& name) -> std::vector<int> { return empire.ProducibleItemLocations(ProductionQueue::ProductionItem(build_type, name)); },
+                                                    "Returns the IDs of the planets (list of int) at which this empire can build the building type with the passed name (string). Evaluates the location condition once for all planets and keeps the result for the rest of the turn.")
+            .def("buildLocations",                  +[](const Empire& empire, BuildType build_type, int design) -> std::vector<int> { return empire.ProducibleItemLocations(ProductionQueue::ProductionItem(build_type, design)); },
+                                                    "Returns the IDs of the planets (list of int) at which this empire can build the ship design with the passed id (int).")
 
             .def("hasExploredSystem",               &Empire::HasExploredSystem)
             .add_property("exploredSystemIDs",      make_function(&Empire::ExploredSystems,         py::return_internal_reference<>()))
@@ -284,17 +357,13 @@ namespace FreeOrionPython {
             .def("population",                      &Empire::Population)
 
             .def("preservedLaneTravel",             &Empire::PreservedLaneTravel)
-            .add_property("fleetSupplyableSystemIDs",   make_function(
-                                                            +[](const Empire& empire) -> const std::set<int>& { return GetSupplyManager().FleetSupplyableSystemIDs(empire.EmpireID()); },
-                                                            py::return_value_policy<py::copy_const_reference>()
-                                                        ))
+            .add_property("fleetSupplyableSystemIDs",   CachedFleetSupplyableSystemIDs)
             .add_property("supplyUnobstructedSystems",  make_function(&Empire::SupplyUnobstructedSystems,   py::return_internal_reference<>()))
             .add_property("systemSupplyRanges",         make_function(&Empire::SystemSupplyRanges,          py::return_internal_reference<>()))
 
             .def("obstructedStarlanes",             obstructedStarlanes,
                                                     py::return_value_policy<py::return_by_value>())
-            .def("supplyProjections",               jumpsToSuppliedSystem,
-                                                    py::return_value_policy<py::return_by_value>())
+            .def("supplyProjections",               CachedSupplyProjections)
             .def("getMeter",                        +[](const Empire& empire, const std::string& name) -> const Meter* { return empire.GetMeter(name); },
                                                     py::return_internal_reference<>(),
                                                     "Returns the empire meter with the indicated name (string).")
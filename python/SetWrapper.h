@@ -10,11 +10,12 @@
 namespace FreeOrionPython {
     /* SetWrapper class encapsulates functions that expose the STL std::set<>
      * class to Python in a limited, read-only fashion.  The set can be iterated
-     * through in Python, and printed. */
-    template <typename ElementType>
+     * through in Python, and printed.  Other set types with the same interface,
+     * such as ObjectIDBitmap, can be exposed in the same way. */
+    template <typename ElementType, typename SetType = std::set<ElementType>>
     class SetWrapper {
     public:
-        typedef typename std::set<ElementType> Set;
+        typedef SetType Set;
         typedef typename Set::const_iterator SetIterator;
 
         static unsigned int size(const Set& self) {
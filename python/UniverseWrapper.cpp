@@ -3,6 +3,7 @@
 #include <boost/python/suite/indexing/map_indexing_suite.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 #include "../Empire/EmpireManager.h"
+#include "../Empire/Supply.h"
 #include "../universe/Building.h"
 #include "../universe/BuildingType.h"
 #include "../universe/Condition.h"
@@ -29,6 +30,10 @@
 #include "../util/GameRules.h"
 #include "../util/Logger.h"
 #include "../util/MultiplayerCommon.h"
+#include "../util/ThreadPool.h"
+#include "CommonFramework.h"
+
+#include <unordered_map>
 
 namespace py = boost::python;
 
@@ -66,12 +71,14 @@ namespace {
     {
         py::stl_input_iterator<int> begin(objIter), end;
         std::vector<int> objvec(begin, end);
+        GILReleasedForWriting gil_released;
         ScriptingContext context{universe, Empires(), GetGalaxySetupData(), GetSpeciesManager(), GetSupplyManager()};
         universe.UpdateMeterEstimates(context);
     }
 
     auto ShortestPath(const Universe& universe, int start_sys, int end_sys, int empire_id) -> std::vector<int>
     {
+        GILReleasedForReading gil_released;
         std::pair<std::list<int>, int> path = universe.GetPathfinder()->ShortestPath(
             start_sys, end_sys, empire_id, universe.EmpireKnownObjects(empire_id));
         return std::vector<int>{path.first.begin(), path.first.end()};
@@ -79,14 +86,26 @@ namespace {
 
     auto ShortestNonHostilePath(const Universe& universe, int start_sys, int end_sys, int empire_id) -> std::vector<int>
     {
+        GILReleasedForReading gil_released;
         auto fleet_pred = std::make_shared<HostileVisitor>(empire_id);
         std::pair<std::list<int>, int> path = universe.GetPathfinder()->ShortestPath(
             start_sys, end_sys, empire_id, fleet_pred, Empires(), universe.EmpireKnownObjects(empire_id));
         return std::vector<int>{path.first.begin(), path.first.end()};
     }
 
+    auto FuelLimitedShortestPath(const Universe& universe, int start_sys, int end_sys, int empire_id,
+                                 float fuel, float max_fuel) -> std::vector<int>
+    {
+        GILReleasedForReading gil_released;
+        std::pair<std::list<int>, double> path = universe.GetPathfinder()->FuelLimitedShortestPath(
+            start_sys, end_sys, empire_id, fuel, max_fuel,
+            GetSupplyManager().FleetSupplyableSystemIDs(empire_id, true));
+        return std::vector<int>{path.first.begin(), path.first.end()};
+    }
+
     auto LeastJumpsPath(const Universe& universe, int start_sys, int end_sys, int empire_id) -> std::vector<int>
     {
+        GILReleasedForReading gil_released;
         std::pair<std::list<int>, int> path = universe.GetPathfinder()->LeastJumpsPath(
             start_sys, end_sys, empire_id);
         return std::vector<int>{path.first.begin(), path.first.end()};
@@ -110,6 +129,17 @@ namespace {
         return retval;
     }
 
+    auto StatRecordsMap(const Universe& universe) -> std::map<std::string, std::map<int, std::map<int, double>>>
+    {
+        std::map<std::string, std::map<int, std::map<int, double>>> retval;
+        for (const auto& [stat_name, empire_series] : universe.GetStatRecords()) {
+            auto& empire_maps = retval[stat_name];
+            for (const auto& [empire_id, series] : empire_series)
+                empire_maps.emplace(empire_id, series.ToMap());
+        }
+        return retval;
+    }
+
     auto ObjectSpecials(const UniverseObject& object) -> std::vector<std::string>
     {
         std::vector<std::string> retval;
@@ -133,6 +163,331 @@ namespace {
         return 0.0f;
     }
 
+    /** Returns a memoryview of a copy of \a values, with the struct module
+        \a format of V, which can be used without copying by array.array or
+        numpy.asarray. */
+    template <typename V>
+    auto PackedArray(const std::vector<V>& values, const char* format) -> py::object
+    {
+        py::object bytes{py::handle<>(PyBytes_FromStringAndSize(
+            reinterpret_cast<const char*>(values.data()), static_cast<Py_ssize_t>(values.size() * sizeof(V))))};
+        py::object view{py::handle<>(PyMemoryView_FromObject(bytes.ptr()))};
+        return view.attr("cast")(format);
+    }
+
+    /** As PackedArray, but with \a values viewed as a \a rows by \a columns
+        matrix in row-major order, if neither is 0. */
+    template <typename V>
+    auto PackedMatrix(const std::vector<V>& values, const char* format,
+                      std::size_t rows, std::size_t columns) -> py::object
+    {
+        if (rows == 0 || columns == 0)
+            return PackedArray(values, format);
+        return PackedArray(values, "B").attr("cast")(format, py::make_tuple(rows, columns));
+    }
+
+    /** Calls \a query(idx) for each idx less than \a count, in parallel on
+        the thread pool.  \a query must not throw. */
+    template <typename Query>
+    void QueryInParallel(std::size_t count, const Query& query)
+    {
+        const std::size_t num_tasks = std::min(count, std::max<std::size_t>(1, GetThreadPool().NumThreads()));
+        TaskBatch batch("UniverseWrapper batch query");
+        for (std::size_t task_idx = 0; task_idx < num_tasks; ++task_idx) {
+            batch.Post([&query, task_idx, num_tasks, count]() {
+                for (std::size_t idx = task_idx; idx < count; idx += num_tasks)
+                    query(idx);
+            });
+        }
+        batch.Wait();
+    }
+
+    auto IDsFrom(const py::object& ids) -> std::vector<int>
+    {
+        py::stl_input_iterator<int> begin(ids), end;
+        return std::vector<int>(begin, end);
+    }
+
+    /** Returns an int array of the jump distances, as jumpDistance returns,
+        from the object with id \a object_id to each object in \a ids. */
+    auto JumpDistancesFrom(const Universe& universe, int object_id, const py::object& ids) -> py::object
+    {
+        const auto targets = IDsFrom(ids);
+        std::vector<int> distances(targets.size());
+        {
+            GILReleasedForReading gil_released;
+            const auto& pathfinder = *universe.GetPathfinder();
+            QueryInParallel(targets.size(), [&](std::size_t idx) {
+                distances[idx] = pathfinder.JumpDistanceBetweenObjects(object_id, targets[idx], universe.Objects());
+            });
+        }
+        return PackedArray(distances, "i");
+    }
+
+    /** Returns an int matrix of the jump distances, as jumpDistance returns,
+        from each object in \a ids1 (rows) to each object in \a ids2
+        (columns). */
+    auto JumpDistanceMatrix(const Universe& universe, const py::object& ids1, const py::object& ids2) -> py::object
+    {
+        const auto sources = IDsFrom(ids1);
+        const auto targets = IDsFrom(ids2);
+        std::vector<int> distances(sources.size() * targets.size());
+        {
+            GILReleasedForReading gil_released;
+            const auto& pathfinder = *universe.GetPathfinder();
+            QueryInParallel(sources.size(), [&](std::size_t row) {
+                for (std::size_t column = 0; column < targets.size(); ++column)
+                    distances[row * targets.size() + column] =
+                        pathfinder.JumpDistanceBetweenObjects(sources[row], targets[column], universe.Objects());
+            });
+        }
+        return PackedMatrix(distances, "i", sources.size(), targets.size());
+    }
+
+    /** Returns a double matrix of the shortest path distances, as
+        shortestPathDistance returns, from each object in \a ids1 (rows) to
+        each object in \a ids2 (columns). */
+    auto ShortestPathDistanceMatrix(const Universe& universe, const py::object& ids1, const py::object& ids2) -> py::object
+    {
+        const auto sources = IDsFrom(ids1);
+        const auto targets = IDsFrom(ids2);
+        std::vector<double> distances(sources.size() * targets.size());
+        {
+            GILReleasedForReading gil_released;
+            const auto& pathfinder = *universe.GetPathfinder();
+            QueryInParallel(sources.size(), [&](std::size_t row) {
+                for (std::size_t column = 0; column < targets.size(); ++column)
+                    distances[row * targets.size() + column] =
+                        pathfinder.ShortestPathDistance(sources[row], targets[column], universe.Objects());
+            });
+        }
+        return PackedMatrix(distances, "d", sources.size(), targets.size());
+    }
+
+    /** Returns a tuple of arrays describing the paths found by \a find_path
+        from \a start_sys to each of \a end_systems: the int system ids of all
+        the paths one after another, int offsets of each path's first system
+        in those with a final entry for the end of the last path, and the path
+        lengths, with -1 for no path.  A query for which \a find_path throws
+        is treated as having no path. */
+    template <typename Length, typename FindPath>
+    auto Paths(int start_sys, const py::object& end_systems, const char* length_format,
+               const FindPath& find_path) -> py::tuple
+    {
+        const auto ends = IDsFrom(end_systems);
+        std::vector<std::vector<int>> paths(ends.size());
+        std::vector<Length> lengths(ends.size(), Length(-1));
+        {
+            GILReleasedForReading gil_released;
+            QueryInParallel(ends.size(), [&](std::size_t idx) {
+                try {
+                    auto [path, length] = find_path(start_sys, ends[idx]);
+                    if (path.empty())
+                        return;
+                    paths[idx].assign(path.begin(), path.end());
+                    lengths[idx] = static_cast<Length>(length);
+                } catch (const std::exception&) {}
+            });
+        }
+
+        std::vector<int> systems, offsets;
+        offsets.reserve(paths.size() + 1);
+        for (const auto& path : paths) {
+            offsets.push_back(static_cast<int>(systems.size()));
+            systems.insert(systems.end(), path.begin(), path.end());
+        }
+        offsets.push_back(static_cast<int>(systems.size()));
+
+        return py::make_tuple(PackedArray(systems, "i"), PackedArray(offsets, "i"),
+                              PackedArray(lengths, length_format));
+    }
+
+    auto ShortestPaths(const Universe& universe, int start_sys, const py::object& end_systems, int empire_id) -> py::tuple
+    {
+        const auto& pathfinder = *universe.GetPathfinder();
+        const auto& known_objects = universe.EmpireKnownObjects(empire_id);
+        return Paths<double>(start_sys, end_systems, "d", [&](int sys1, int sys2)
+                             { return pathfinder.ShortestPath(sys1, sys2, empire_id, known_objects); });
+    }
+
+    auto LeastJumpsPaths(const Universe& universe, int start_sys, const py::object& end_systems, int empire_id) -> py::tuple
+    {
+        const auto& pathfinder = *universe.GetPathfinder();
+        return Paths<int>(start_sys, end_systems, "i", [&](int sys1, int sys2)
+                          { return pathfinder.LeastJumpsPath(sys1, sys2, empire_id); });
+    }
+
+    /** Returns a dict of columns of properties of all known objects of type
+      * T, so that the AI can get them in one call rather than one call per
+      * object and property. Each column is a memoryview with an entry per
+      * object, in the same order:
+      *  "id", "owner", "systemID": int
+      *  "x", "y": double
+      *  "species" (planets and ships): int index into the list
+      *      "speciesNames", or -1 for no species
+      *  "currentMeters", "initialMeters": dicts from each of \a meter_types
+      *      to float meter values, which are 0 for objects without that meter */
+    template <typename T>
+    auto ObjectColumns(const Universe& universe, const py::object& meter_types) -> py::dict
+    {
+        py::stl_input_iterator<MeterType> meter_types_begin(meter_types), meter_types_end;
+        const std::vector<MeterType> meters(meter_types_begin, meter_types_end);
+
+        const auto count = universe.Objects().size<T>();
+
+        std::vector<int> ids, owners, system_ids, species;
+        std::vector<double> xs, ys;
+        std::vector<std::vector<float>> current(meters.size()), initial(meters.size());
+        std::vector<std::string> species_names;
+        std::map<std::string_view, int> species_indices;
+
+        ids.reserve(count);
+        owners.reserve(count);
+        system_ids.reserve(count);
+        xs.reserve(count);
+        ys.reserve(count);
+        for (std::size_t idx = 0; idx < meters.size(); ++idx) {
+            current[idx].reserve(count);
+            initial[idx].reserve(count);
+        }
+
+        for (const auto& obj : universe.Objects().all<T>()) {
+            ids.push_back(obj->ID());
+            owners.push_back(obj->Owner());
+            system_ids.push_back(obj->SystemID());
+            xs.push_back(obj->X());
+            ys.push_back(obj->Y());
+
+            if constexpr (std::is_same_v<T, Planet> || std::is_same_v<T, Ship>) {
+                const auto& name = obj->SpeciesName();
+                auto it = species_indices.find(name);
+                if (it == species_indices.end() && !name.empty()) {
+                    it = species_indices.emplace(name, static_cast<int>(species_names.size())).first;
+                    species_names.push_back(name);
+                }
+                species.push_back(it == species_indices.end() ? -1 : it->second);
+            }
+
+            for (std::size_t idx = 0; idx < meters.size(); ++idx) {
+                const auto* meter = obj->GetMeter(meters[idx]);
+                current[idx].push_back(meter ? meter->Current() : 0.0f);
+                initial[idx].push_back(meter ? meter->Initial() : 0.0f);
+            }
+        }
+
+        py::dict retval;
+        retval["id"] = PackedArray(ids, "i");
+        retval["owner"] = PackedArray(owners, "i");
+        retval["systemID"] = PackedArray(system_ids, "i");
+        retval["x"] = PackedArray(xs, "d");
+        retval["y"] = PackedArray(ys, "d");
+        if constexpr (std::is_same_v<T, Planet> || std::is_same_v<T, Ship>) {
+            retval["species"] = PackedArray(species, "i");
+            py::list names;
+            for (const auto& name : species_names)
+                names.append(name);
+            retval["speciesNames"] = names;
+        }
+        py::dict current_meters, initial_meters;
+        for (std::size_t idx = 0; idx < meters.size(); ++idx) {
+            current_meters[meters[idx]] = PackedArray(current[idx], "f");
+            initial_meters[meters[idx]] = PackedArray(initial[idx], "f");
+        }
+        retval["currentMeters"] = current_meters;
+        retval["initialMeters"] = initial_meters;
+        return retval;
+    }
+
+    /** The objects known at one time, each with a handle that is its index
+      * in the snapshot, so that the AI can look objects up once per turn and
+      * then reach them and read their properties without ObjectMap lookups.
+      * The snapshot keeps its objects alive, so handles and the objects got
+      * with them stay valid for as long as the snapshot does, but objects
+      * added to the universe after it was taken aren't in it. */
+    class ObjectSnapshot {
+    public:
+        explicit ObjectSnapshot(const ObjectMap& objects) {
+            m_objects.reserve(objects.size());
+            m_ids.reserve(objects.size());
+            m_handles.reserve(objects.size());
+            for (const auto& obj : objects.all()) {
+                m_handles.emplace(obj->ID(), static_cast<int>(m_objects.size()));
+                m_ids.push_back(obj->ID());
+                m_objects.push_back(obj);
+            }
+        }
+
+        auto size() const -> std::size_t
+        { return m_objects.size(); }
+
+        /** Returns the handle of the object with id \a id, or -1 if it isn't
+          * in this snapshot. */
+        auto Handle(int id) const -> int {
+            auto it = m_handles.find(id);
+            return it == m_handles.end() ? -1 : it->second;
+        }
+
+        /** Returns the object with handle \a handle, or nullptr if there is
+          * none. */
+        auto Object(int handle) const -> const UniverseObject* {
+            if (handle < 0 || static_cast<std::size_t>(handle) >= m_objects.size())
+                return nullptr;
+            return m_objects[handle].get();
+        }
+
+        auto IDs() const -> const std::vector<int>&
+        { return m_ids; }
+
+        /** Returns an array of property \a get of the objects with each of
+          * \a handles, or \a none for handles of no object. */
+        template <typename V, typename Get>
+        auto Column(const py::object& handles, const char* format, V none, const Get& get) const -> py::object
+        {
+            std::vector<V> retval;
+            for (py::stl_input_iterator<int> it(handles), end; it != end; ++it) {
+                const auto* obj = Object(*it);
+                retval.push_back(obj ? get(*obj) : none);
+            }
+            return PackedArray(retval, format);
+        }
+
+    private:
+        std::vector<std::shared_ptr<const UniverseObject>>  m_objects;
+        std::vector<int>                                    m_ids;
+        std::unordered_map<int, int>                        m_handles;
+    };
+
+    /** Returns a snapshot of the objects in \a universe, which is only
+      * retaken when the turn or the number of objects has changed since it
+      * was last taken. */
+    auto GetObjectSnapshot(const Universe& universe) -> std::shared_ptr<ObjectSnapshot>
+    {
+        static std::shared_ptr<ObjectSnapshot> snapshot;
+        static int snapshot_turn = INVALID_GAME_TURN;
+        const auto& objects = universe.Objects();
+        if (!snapshot || snapshot_turn != CurrentTurn() || snapshot->size() != objects.size()) {
+            snapshot = std::make_shared<ObjectSnapshot>(objects);
+            snapshot_turn = CurrentTurn();
+        }
+        return snapshot;
+    }
+
+    auto SnapshotCurrentMeterValues(const ObjectSnapshot& snapshot, const py::object& handles, MeterType meter_type) -> py::object
+    {
+        return snapshot.Column(handles, "f", 0.0f, [meter_type](const UniverseObject& obj) {
+            const auto* meter = obj.GetMeter(meter_type);
+            return meter ? meter->Current() : 0.0f;
+        });
+    }
+
+    auto SnapshotInitialMeterValues(const ObjectSnapshot& snapshot, const py::object& handles, MeterType meter_type) -> py::object
+    {
+        return snapshot.Column(handles, "f", 0.0f, [meter_type](const UniverseObject& obj) {
+            const auto* meter = obj.GetMeter(meter_type);
+            return meter ? meter->Initial() : 0.0f;
+        });
+    }
+
     auto AttackStats(const ShipDesign& ship_design) -> std::vector<int>
     {
         std::vector<int> results;
@@ -187,7 +542,10 @@ namespace FreeOrionPython {
      *                                                  in a function that will go out of scope after being returned
      *
      * return_internal_reference<>                      when returning an object or data that is a member of the object
-     *                                                  on which the function is called (and shares its lifetime)
+     *                                                  on which the function is called (and shares its lifetime).  ID
+     *                                                  sets returned this way are read in place by Python rather than
+     *                                                  copied, and like the objects holding them, are only valid for
+     *                                                  the turn in which they were got
      *
      * return_value_policy<reference_existing_object>   when returning an object from a non-member function, or a
      *                                                  member function where the returned object's lifetime is not
@@ -221,13 +579,12 @@ namespace FreeOrionPython {
             .def(py::map_indexing_suite<std::map<MeterType, Meter>, true>())
         ;
 
-        // typedef std::map<std::pair<MeterType, std::string>, Meter> PartMeterMap;
         py::class_<std::pair<MeterType, std::string>>("MeterTypeStringPair")
             .add_property("meterType",  &std::pair<MeterType, std::string>::first)
             .add_property("string",     &std::pair<MeterType, std::string>::second)
         ;
-        py::class_<Ship::PartMeterMap>("ShipPartMeterMap")
-            .def(py::map_indexing_suite<Ship::PartMeterMap>())
+        py::class_<PartMeterMap::MapType>("ShipPartMeterMap")
+            .def(py::map_indexing_suite<PartMeterMap::MapType>())
         ;
 
         py::class_<std::map<std::string, std::map<int, std::map<int, double>>>>("StatRecordsMap")
@@ -306,8 +663,27 @@ namespace FreeOrionPython {
             .add_property("planetIDs",          make_function(ObjectIDs<Planet>,        py::return_value_policy<py::return_by_value>()))
             .add_property("shipIDs",            make_function(ObjectIDs<Ship>,          py::return_value_policy<py::return_by_value>()))
             .add_property("buildingIDs",        make_function(ObjectIDs<Building>,      py::return_value_policy<py::return_by_value>()))
+            .add_property("updatedObjectIDs",   make_function(
+                                                    +[](const Universe& universe) -> std::vector<int>
+                                                    { return universe.ObjectsUpdatedByLastLoad(); },
+                                                    py::return_value_policy<py::return_by_value>()),
+                                                "IDs of the objects that were new or changed in the last turn update; the others are the same objects as on the previous turn")
+            .def("planetColumns",               ObjectColumns<Planet>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions, species and current and initial values of the listed meters (meterType) of all known planets, each an array in one memoryview.")
+            .def("shipColumns",                 ObjectColumns<Ship>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions, species and current and initial values of the listed meters (meterType) of all known ships, each an array in one memoryview.")
+            .def("fleetColumns",                ObjectColumns<Fleet>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known fleets, each an array in one memoryview.")
+            .def("systemColumns",               ObjectColumns<System>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known systems, each an array in one memoryview.")
+            .def("fieldColumns",                ObjectColumns<Field>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known fields, each an array in one memoryview.")
+            .def("buildingColumns",             ObjectColumns<Building>,
+                                                "Returns a dict of columns of the IDs, owners, system IDs, positions and current and initial values of the listed meters (meterType) of all known buildings, each an array in one memoryview.")
             .def("destroyedObjectIDs",          &Universe::EmpireKnownDestroyedObjectIDs,
-                                                py::return_value_policy<py::return_by_value>())
+                                                py::return_internal_reference<>())
+            .def("objectSnapshot",              GetObjectSnapshot,
+                                                "Returns a snapshot (objectSnapshot) of the known objects, that gives each a handle for this turn. The same snapshot is returned until the turn or the number of objects changes.")
 
             .def("systemHasStarlane",           +[](const Universe& universe, int system_id, int empire_id) -> bool { return universe.GetPathfinder()->SystemHasVisibleStarlanes(system_id, EmpireKnownObjects(empire_id)); },
                                                 py::return_value_policy<py::return_by_value>())
@@ -319,7 +695,7 @@ namespace FreeOrionPython {
             .def("linearDistance",              +[](const Universe& universe, int system1_id, int system2_id) -> double { return universe.GetPathfinder()->LinearDistance(system1_id, system2_id, universe.Objects()); },
                                                 py::return_value_policy<py::return_by_value>())
 
-            .def("jumpDistance",                +[](const Universe& universe, int object1_id, int object2_id) -> int { return universe.GetPathfinder()->JumpDistanceBetweenObjects(object1_id, object2_id, universe.Objects()); },
+            .def("jumpDistance",                +[](const Universe& universe, int object1_id, int object2_id) -> int { GILReleasedForReading gil_released; return universe.GetPathfinder()->JumpDistanceBetweenObjects(object1_id, object2_id, universe.Objects()); },
                                                 py::return_value_policy<py::return_by_value>(),
                                                 "If two system ids are passed or both objects are within a system, "
                                                 "return the jump distance between the two systems. If one object "
@@ -336,15 +712,44 @@ namespace FreeOrionPython {
                                                 "System (number2) with no hostile Fleets as determined by visibility "
                                                 "of Empire (number3).  (number3) must be a valid empire.")
 
-            .def("shortestPathDistance",        +[](const Universe& universe, int object1_id, int object2_id) -> double { return universe.GetPathfinder()->ShortestPathDistance(object1_id, object2_id, universe.Objects()); },
+            .def("fuelLimitedShortestPath",     FuelLimitedShortestPath,
+                                                py::return_value_policy<py::return_by_value>(),
+                                                "Shortest sequence of System ids from System (number1) to System "
+                                                "(number2) known to Empire (number3) that a fleet with fuel "
+                                                "(number4) and maximum fuel (number5) can travel, refuelling in "
+                                                "systems where the empire or its allies can supply fleets.")
+
+            .def("shortestPathDistance",        +[](const Universe& universe, int object1_id, int object2_id) -> double { GILReleasedForReading gil_released; return universe.GetPathfinder()->ShortestPathDistance(object1_id, object2_id, universe.Objects()); },
                                                 py::return_value_policy<py::return_by_value>())
 
+            .def("jumpDistancesFrom",           JumpDistancesFrom,
+                                                "Returns an int array of the jump distances, as jumpDistance returns, from object (number) to each of the listed objects, computed in parallel.")
+            .def("jumpDistanceMatrix",          JumpDistanceMatrix,
+                                                "Returns a 2D int array of the jump distances, as jumpDistance returns, from each of the first listed objects (rows) to each of the second listed objects (columns), computed in parallel.")
+            .def("shortestPathDistanceMatrix",  ShortestPathDistanceMatrix,
+                                                "Returns a 2D float array of the shortest path distances, as shortestPathDistance returns, from each of the first listed objects (rows) to each of the second listed objects (columns), computed in parallel.")
+            .def("shortestPaths",               ShortestPaths,
+                                                "Returns the shortest paths, as shortestPath finds them, from System (number1) to each of the listed Systems known to Empire (number2), computed in parallel, as a tuple of arrays: the System ids of all paths in order, the offset of each path's first System in those plus the end of the last path, and the path distances, -1 where there is no path.")
+            .def("leastJumpsPaths",             LeastJumpsPaths,
+                                                "Returns the least jumps paths, as leastJumpsPath finds them, from System (number1) to each of the listed Systems known to Empire (number2), computed in parallel, as a tuple of arrays: the System ids of all paths in order, the offset of each path's first System in those plus the end of the last path, and the path jumps, -1 where there is no path.")
             .def("leastJumpsPath",              LeastJumpsPath,
                                                 py::return_value_policy<py::return_by_value>())
 
             .def("systemsConnected",            +[](const Universe& universe, int system1_id, int system2_id, int empire_id) -> bool { return universe.GetPathfinder()->SystemsConnected(system1_id, system2_id, empire_id); },
                                                 py::return_value_policy<py::return_by_value>())
 
+            .def("numRegions",                  +[](const Universe& universe) -> int { return universe.GetPathfinder()->NumRegions(); },
+                                                "Number of regions the system graph is partitioned into for "
+                                                "pathfinding, or 0 if it is not partitioned.")
+
+            .def("systemRegion",                +[](const Universe& universe, int system_id) -> int { return universe.GetPathfinder()->SystemRegion(system_id); },
+                                                "Region of System (number1), or -1 if the system graph is not "
+                                                "partitioned into regions.")
+
+            .def("regionSystems",               +[](const Universe& universe, int region) -> std::vector<int> { return universe.GetPathfinder()->RegionSystemIDs(region); },
+                                                py::return_value_policy<py::return_by_value>(),
+                                                "System ids in region (number1), in increasing order.")
+
             .def("getImmediateNeighbors",       ImmediateNeighbors,
                                                 py::return_value_policy<py::return_by_value>())
 
@@ -359,8 +764,8 @@ namespace FreeOrionPython {
 
             // Indexed by stat name (string), contains a map indexed by empire id,
             // contains a map from turn number (int) to stat value (double).
-            .def("statRecords",                 &Universe::GetStatRecords,
-                                                py::return_value_policy<py::reference_existing_object>(),
+            .def("statRecords",                 StatRecordsMap,
+                                                py::return_value_policy<py::return_by_value>(),
                                                 "Empire statistics recorded by the server each turn. Indexed first by "
                                                 "staistic name (string), then by empire id (int), then by turn "
                                                 "number (int), pointing to the statisic value (double).")
@@ -368,6 +773,35 @@ namespace FreeOrionPython {
             .def("dump",                        +[](const Universe& universe) { DebugLogger() << universe.Objects().Dump(); })
         ;
 
+        ////////////////////
+        // ObjectSnapshot //
+        ////////////////////
+        py::class_<ObjectSnapshot, std::shared_ptr<ObjectSnapshot>, boost::noncopyable>("objectSnapshot", py::no_init)
+            .def("__len__",                     &ObjectSnapshot::size)
+            .add_property("ids",                +[](const ObjectSnapshot& snapshot) { return PackedArray(snapshot.IDs(), "i"); },
+                                                "The ids of the objects in this snapshot, as an int array indexed by handle.")
+            .def("handle",                      &ObjectSnapshot::Handle,
+                                                "Returns the handle (int) of the object with the given id (int), or -1 if it isn't in this snapshot.")
+            .def("handles",                     +[](const ObjectSnapshot& snapshot, const py::object& ids) {
+                                                    std::vector<int> handles;
+                                                    for (py::stl_input_iterator<int> it(ids), end; it != end; ++it)
+                                                        handles.push_back(snapshot.Handle(*it));
+                                                    return PackedArray(handles, "i");
+                                                },
+                                                "Returns an int array of the handles, as handle returns, of the objects with each of the listed ids.")
+            .def("object",                      &ObjectSnapshot::Object,
+                                                py::return_internal_reference<>(),
+                                                "Returns the object (universeObject) with the given handle (int), or None. It stays valid for as long as this snapshot is kept.")
+            .def("owners",                      +[](const ObjectSnapshot& snapshot, const py::object& handles) { return snapshot.Column(handles, "i", ALL_EMPIRES, [](const UniverseObject& obj) { return obj.Owner(); }); },
+                                                "Returns an int array of the owners of the objects with each of the listed handles.")
+            .def("systemIDs",                   +[](const ObjectSnapshot& snapshot, const py::object& handles) { return snapshot.Column(handles, "i", INVALID_OBJECT_ID, [](const UniverseObject& obj) { return obj.SystemID(); }); },
+                                                "Returns an int array of the system ids of the objects with each of the listed handles.")
+            .def("currentMeterValues",          SnapshotCurrentMeterValues,
+                                                "Returns a float array of the current values of the given meter (meterType) of the objects with each of the listed handles, 0 for objects without that meter.")
+            .def("initialMeterValues",          SnapshotInitialMeterValues,
+                                                "Returns a float array of the initial values of the given meter (meterType) of the objects with each of the listed handles, 0 for objects without that meter.")
+        ;
+
         ////////////////////
         // UniverseObject //
         ////////////////////
@@ -387,7 +821,8 @@ namespace FreeOrionPython {
             .def("specialAddedOnTurn",          &UniverseObject::SpecialAddedOnTurn)
             .def("contains",                    &UniverseObject::Contains)
             .def("containedBy",                 &UniverseObject::ContainedBy)
-            .add_property("containedObjects",   make_function(&UniverseObject::ContainedObjectIDs,  py::return_value_policy<py::return_by_value>()))
+            .add_property("containedObjects",   make_function(+[](const UniverseObject& o) -> std::set<int> { return {o.ContainedObjectIDs().begin(), o.ContainedObjectIDs().end()}; },
+                                                                        py::return_value_policy<py::return_by_value>()))
             .add_property("containerObject",    &UniverseObject::ContainerObjectID)
             .def("currentMeterValue",           ObjectCurrentMeterValue,
                                                 py::return_value_policy<py::return_by_value>())
@@ -428,7 +863,8 @@ namespace FreeOrionPython {
             .add_property("hasTroopShips",             +[](const Fleet& fleet) -> bool { return fleet.HasTroopShips(Objects()); })
             .add_property("numShips",                  &Fleet::NumShips)
             .add_property("empty",                     &Fleet::Empty)
-            .add_property("shipIDs",                   make_function(&Fleet::ShipIDs,      py::return_internal_reference<>()))
+            .add_property("shipIDs",                   make_function(+[](const Fleet& f) -> std::set<int> { return {f.ShipIDs().begin(), f.ShipIDs().end()}; },
+                                                                               py::return_value_policy<py::return_by_value>()))
         ;
 
         //////////////////
@@ -458,8 +894,8 @@ namespace FreeOrionPython {
             .def("initialPartMeterValue",           &Ship::InitialPartMeterValue)
             .def("currentPartMeterValue",           &Ship::CurrentPartMeterValue)
             .add_property("partMeters",             make_function(
-                                                        +[](const Ship& ship) -> const Ship::PartMeterMap& { return ship.PartMeters(); },
-                                                        py::return_internal_reference<>()
+                                                        +[](const Ship& ship) -> PartMeterMap::MapType { return ship.PartMeters().ToMap(); },
+                                                        py::return_value_policy<py::return_by_value>()
                                                     ))
             .def("getMeter",                        +[](const Ship& ship, MeterType type, const std::string& part_name) -> const Meter* { return ship.GetPartMeter(type, part_name); },
                                                     py::return_internal_reference<>())
@@ -638,7 +1074,8 @@ namespace FreeOrionPython {
             .add_property("RotationalPeriod",               &Planet::RotationalPeriod)
             .add_property("LastTurnAttackedByShip",         &Planet::LastTurnAttackedByShip)
             .add_property("LastTurnConquered",              &Planet::LastTurnConquered)
-            .add_property("buildingIDs",                    make_function(&Planet::BuildingIDs,     py::return_internal_reference<>()))
+            .add_property("buildingIDs",                    make_function(+[](const Planet& p) -> std::set<int> { return {p.BuildingIDs().begin(), p.BuildingIDs().end()}; },
+                                                                                    py::return_value_policy<py::return_by_value>()))
             .add_property("habitableSize",                  &Planet::HabitableSize)
         ;
 
@@ -652,11 +1089,16 @@ namespace FreeOrionPython {
             .def("HasStarlaneToSystemID",       &System::HasStarlaneTo)
             .def("HasWormholeToSystemID",       &System::HasWormholeTo, "Currently unused.")
             .add_property("starlanesWormholes", make_function(&System::StarlanesWormholes,  py::return_value_policy<py::return_by_value>()), "Currently unused.")
-            .add_property("planetIDs",          make_function(&System::PlanetIDs,           py::return_value_policy<py::return_by_value>()))
-            .add_property("buildingIDs",        make_function(&System::BuildingIDs,         py::return_value_policy<py::return_by_value>()))
-            .add_property("fleetIDs",           make_function(&System::FleetIDs,            py::return_value_policy<py::return_by_value>()))
-            .add_property("shipIDs",            make_function(&System::ShipIDs,             py::return_value_policy<py::return_by_value>()))
-            .add_property("fieldIDs",           make_function(&System::FieldIDs,            py::return_value_policy<py::return_by_value>()))
+            .add_property("planetIDs",          make_function(+[](const System& s) -> std::set<int> { return {s.PlanetIDs().begin(), s.PlanetIDs().end()}; },
+                                                                py::return_value_policy<py::return_by_value>()))
+            .add_property("buildingIDs",        make_function(+[](const System& s) -> std::set<int> { return {s.BuildingIDs().begin(), s.BuildingIDs().end()}; },
+                                                                py::return_value_policy<py::return_by_value>()))
+            .add_property("fleetIDs",           make_function(+[](const System& s) -> std::set<int> { return {s.FleetIDs().begin(), s.FleetIDs().end()}; },
+                                                                py::return_value_policy<py::return_by_value>()))
+            .add_property("shipIDs",            make_function(+[](const System& s) -> std::set<int> { return {s.ShipIDs().begin(), s.ShipIDs().end()}; },
+                                                                py::return_value_policy<py::return_by_value>()))
+            .add_property("fieldIDs",           make_function(+[](const System& s) -> std::set<int> { return {s.FieldIDs().begin(), s.FieldIDs().end()}; },
+                                                                py::return_value_policy<py::return_by_value>()))
             .add_property("lastTurnBattleHere", &System::LastTurnBattleHere)
         ;
 
@@ -0,0 +1,323 @@
+#include "ObserverRelay.h"
+
+#include "../util/Directories.h"
+#include "../util/i18n.h"
+#include "../util/Logger.h"
+#include "../util/LoggerWithOptionsDB.h"
+#include "../util/OptionsDB.h"
+#include "../util/Version.h"
+
+#include <boost/bind/bind.hpp>
+#include <boost/uuid/nil_generator.hpp>
+
+#include <algorithm>
+#include <array>
+
+
+namespace {
+    DeclareThreadSafeLogger(network);
+
+    /** Types of message of which observers that join are sent the last one
+      * the game server sent, in the order they are sent. */
+    constexpr std::array<Message::MessageType, 4> SESSION_MESSAGE_TYPES{
+        Message::MessageType::CHECKSUM,         Message::MessageType::HOST_ID,
+        Message::MessageType::SET_AUTH_ROLES,   Message::MessageType::CHAT_HISTORY};
+
+    constexpr std::size_t RECENT_CHAT_LENGTH = 1000;
+}
+
+ObserverRelay::ObserverRelay() :
+    m_upstream_socket(m_io_context),
+    m_networking(m_io_context,
+                 boost::bind(&ObserverRelay::HandleNonPlayerMessage, this, boost::placeholders::_1, boost::placeholders::_2),
+                 boost::bind(&ObserverRelay::HandlePlayerMessage, this, boost::placeholders::_1, boost::placeholders::_2),
+                 boost::bind(&ObserverRelay::PlayerDisconnected, this, boost::placeholders::_1)),
+    m_recent_chat(RECENT_CHAT_LENGTH)
+{
+    if (GetOptionsDB().Get<std::string>("log-file").empty()) {
+        const std::string RELAY_LOG_FILENAME((GetUserDataDir() / "freeoriond-relay.log").string());
+        GetOptionsDB().Set("log-file", RELAY_LOG_FILENAME);
+    }
+    auto force_log_level = GetOptionsDB().Get<std::string>("log-level");
+    if (!force_log_level.empty())
+        OverrideAllLoggersThresholds(to_LogLevel(force_log_level));
+
+    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "Relay",
+                      GetOptionsDB().Get<bool>("log-async"));
+    InitLoggingOptionsDBSystem();
+
+    InfoLogger() << FreeOrionVersionString();
+}
+
+void ObserverRelay::Run() {
+    ConnectUpstream();
+    DebugLogger() << "FreeOrion observer relay waiting for network events";
+    while (m_io_context.run_one())
+        m_networking.HandleNextEvent();
+    m_networking.DisconnectAll();
+}
+
+void ObserverRelay::ConnectUpstream() {
+    const auto host = GetOptionsDB().Get<std::string>("network.relay.upstream");
+    const auto port = std::to_string(GetOptionsDB().Get<int>("network.relay.upstream.port"));
+    InfoLogger(network) << "ObserverRelay connecting to game server " << host << ":" << port;
+
+    boost::asio::ip::tcp::resolver resolver(m_io_context);
+    boost::asio::connect(m_upstream_socket, resolver.resolve(host, port));
+    m_upstream_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+    SendUpstream(JoinGameMessage(GetOptionsDB().Get<std::string>("network.relay.player-name"),
+                                 Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER,
+                                 boost::uuids::nil_uuid()));
+    AsyncReadUpstream();
+}
+
+void ObserverRelay::AsyncReadUpstream() {
+    boost::asio::async_read(m_upstream_socket, boost::asio::buffer(m_upstream_header),
+                            [this](boost::system::error_code error, std::size_t)
+    {
+        if (error) {
+            HandleUpstreamDisconnection(error);
+            return;
+        }
+        BufferToHeader(m_upstream_header, m_upstream_message);
+        try {
+            m_upstream_message.Resize(m_upstream_header[Message::Parts::SIZE]);
+        } catch (const std::exception& e) {
+            ErrorLogger(network) << "ObserverRelay::AsyncReadUpstream caught exception resizing message buffer to size "
+                                 << m_upstream_header[Message::Parts::SIZE] << " : " << e.what();
+            HandleUpstreamDisconnection(boost::asio::error::message_size);
+            return;
+        }
+        boost::asio::async_read(m_upstream_socket,
+                                boost::asio::buffer(m_upstream_message.Data(), m_upstream_message.Size()),
+                                [this](boost::system::error_code error, std::size_t)
+        {
+            if (error) {
+                HandleUpstreamDisconnection(error);
+                return;
+            }
+            Message message;
+            message.Swap(m_upstream_message);
+            HandleUpstreamMessage(std::move(message));
+            AsyncReadUpstream();
+        });
+    });
+}
+
+void ObserverRelay::SendUpstream(const Message& message) {
+    Message::HeaderBuffer header;
+    HeaderToBuffer(message, header);
+    std::array<boost::asio::const_buffer, 2> buffers{boost::asio::buffer(header),
+                                                     boost::asio::buffer(message.Data(), message.Size())};
+    boost::system::error_code error;
+    boost::asio::write(m_upstream_socket, buffers, error);
+    if (error)
+        ErrorLogger(network) << "ObserverRelay::SendUpstream error #" << error.value() << " \"" << error.message() << "\"";
+}
+
+void ObserverRelay::HandleUpstreamMessage(Message message) {
+    // observers are sent the same message, so it is decompressed or
+    // compressed once here, rather than for each of them
+    RelayedMessage relayed;
+    try {
+        if (message.Compressed()) {
+            relayed.message = DecompressMessage(message);
+            relayed.compressed = std::move(message);
+        } else {
+            const auto threshold = GetOptionsDB().Get<int>("network.server.compression.threshold");
+            if (threshold > 0 && message.Size() >= static_cast<std::size_t>(threshold))
+                relayed.compressed = CompressMessage(message);
+            relayed.message = std::move(message);
+        }
+    } catch (const std::exception& e) {
+        ErrorLogger(network) << "ObserverRelay::HandleUpstreamMessage couldn't decompress message of type "
+                             << message.Type() << " : " << e.what();
+        return;
+    }
+
+    switch (relayed.message.Type()) {
+    case Message::MessageType::JOIN_GAME: {
+        boost::uuids::uuid cookie;
+        try {
+            ExtractJoinAckMessageData(relayed.message, m_upstream_player_id, cookie);
+        } catch (const std::exception& e) {
+            ErrorLogger(network) << "ObserverRelay::HandleUpstreamMessage couldn't extract join ack: " << e.what();
+            return;
+        }
+        InfoLogger(network) << "ObserverRelay joined game server as player " << m_upstream_player_id;
+
+        auto pending_observers = std::move(m_pending_observers);
+        m_pending_observers.clear();
+        for (const auto& observer : pending_observers)
+            EstablishObserver(observer);
+        return;
+    }
+
+    case Message::MessageType::AUTH_REQUEST:
+        SendUpstream(AuthResponseMessage(GetOptionsDB().Get<std::string>("network.relay.player-name"),
+                                         GetOptionsDB().Get<std::string>("network.relay.password")));
+        return;
+
+    case Message::MessageType::ERROR_MSG: {
+        int player_id = Networking::INVALID_PLAYER_ID;
+        std::string problem;
+        bool fatal = false;
+        try {
+            ExtractErrorMessageData(relayed.message, player_id, problem, fatal);
+            ErrorLogger(network) << "ObserverRelay received error from game server: " << problem;
+        } catch (const std::exception&) {}
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    CacheMessage(relayed);
+    SendToObservers(relayed);
+}
+
+void ObserverRelay::HandleUpstreamDisconnection(const boost::system::error_code& error) {
+    InfoLogger(network) << "ObserverRelay disconnected from game server: error #" << error.value()
+                        << " \"" << error.message() << "\"";
+    const auto message = ErrorMessage(UserStringNop("SERVER_LOST"), true);
+    for (auto it = m_networking.established_begin(); it != m_networking.established_end(); ++it)
+        (*it)->SendMessage(message);
+    m_io_context.stop();
+}
+
+void ObserverRelay::HandleNonPlayerMessage(const Message& msg, PlayerConnectionPtr player_connection) {
+    if (msg.Type() != Message::MessageType::JOIN_GAME) {
+        ErrorLogger(network) << "ObserverRelay::HandleNonPlayerMessage : Received an invalid message type \""
+                             << msg.Type() << "\" for a non-player Message.  Terminating connection.";
+        m_networking.Disconnect(player_connection);
+        return;
+    }
+
+    PendingObserver observer{player_connection, {}, {}};
+    Networking::ClientType client_type = Networking::ClientType::INVALID_CLIENT_TYPE;
+    boost::uuids::uuid cookie;
+    try {
+        ExtractJoinGameMessageData(msg, observer.player_name, client_type, observer.client_version_string, cookie);
+    } catch (const std::exception&) {
+        client_type = Networking::ClientType::INVALID_CLIENT_TYPE;
+    }
+
+    // the relay passes on the game server's messages without reencoding them,
+    // so they must be readable by the observer as they are
+    if (observer.client_version_string != FreeOrionVersionString()) {
+        player_connection->SendMessage(ErrorMessage(UserStringNop("ERROR_INCOMPATIBLE_VERSION"), true));
+        m_networking.Disconnect(player_connection);
+        return;
+    }
+    if (client_type != Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER || observer.player_name.empty()) {
+        player_connection->SendMessage(ErrorMessage(UserStringNop("ERROR_CLIENT_TYPE_NOT_ALLOWED"), true));
+        m_networking.Disconnect(player_connection);
+        return;
+    }
+
+    if (m_upstream_player_id == Networking::INVALID_PLAYER_ID)
+        m_pending_observers.push_back(std::move(observer));
+    else
+        EstablishObserver(observer);
+}
+
+void ObserverRelay::HandlePlayerMessage(const Message& msg, PlayerConnectionPtr player_connection) {
+    TraceLogger(network) << "ObserverRelay dropping message of type " << msg.Type()
+                         << " from observer " << player_connection->PlayerName();
+}
+
+void ObserverRelay::PlayerDisconnected(PlayerConnectionPtr player_connection) {
+    m_pending_observers.erase(std::remove_if(m_pending_observers.begin(), m_pending_observers.end(),
+                                             [&player_connection](const PendingObserver& observer)
+                                             { return observer.connection == player_connection; }),
+                              m_pending_observers.end());
+    m_networking.Disconnect(player_connection);
+}
+
+void ObserverRelay::EstablishObserver(const PendingObserver& observer) {
+    // observers of the relay all follow the game as the relay's player
+    observer.connection->EstablishPlayer(m_upstream_player_id, observer.player_name,
+                                         Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER,
+                                         observer.client_version_string);
+    observer.connection->SendMessage(JoinAckMessage(m_upstream_player_id, boost::uuids::nil_uuid()));
+    DebugLogger(network) << "ObserverRelay established observer " << observer.player_name;
+
+    const bool compressed = observer.connection->IsCompressionUsed();
+    auto send = [&observer, compressed](const RelayedMessage& message) {
+        observer.connection->SendMessage(compressed && message.compressed.Size() > 0 ?
+                                         message.compressed : message.message);
+    };
+
+    for (const auto type : SESSION_MESSAGE_TYPES) {
+        auto it = m_session_messages.find(type);
+        if (it != m_session_messages.end())
+            send(it->second);
+    }
+    for (const auto& message : m_recent_chat)
+        send(message);
+    for (const auto& message : m_game_messages)
+        send(message);
+    auto player_info_it = m_session_messages.find(Message::MessageType::PLAYER_INFO);
+    if (player_info_it != m_session_messages.end())
+        send(player_info_it->second);
+    for (const auto& message : m_turn_messages)
+        send(message);
+}
+
+void ObserverRelay::CacheMessage(const RelayedMessage& message) {
+    switch (message.message.Type()) {
+    case Message::MessageType::CHECKSUM:
+    case Message::MessageType::HOST_ID:
+    case Message::MessageType::SET_AUTH_ROLES:
+    case Message::MessageType::PLAYER_INFO:
+        m_session_messages[message.message.Type()] = message;
+        break;
+
+    case Message::MessageType::CHAT_HISTORY:
+        m_session_messages[message.message.Type()] = message;
+        m_recent_chat.clear();
+        break;
+
+    case Message::MessageType::PLAYER_CHAT:
+        m_recent_chat.push_back(message);
+        break;
+
+    case Message::MessageType::GAME_START:
+        m_game_messages.assign(1, message);
+        m_turn_messages.clear();
+        break;
+
+    case Message::MessageType::TURN_UPDATE:
+        // turn updates to the relay are complete, so replace earlier ones
+        m_game_messages.resize(std::min<std::size_t>(m_game_messages.size(), 1));
+        m_game_messages.push_back(message);
+        m_turn_messages.clear();
+        break;
+
+    case Message::MessageType::TURN_PARTIAL_UPDATE:
+    case Message::MessageType::TURN_PROGRESS:
+    case Message::MessageType::PLAYER_STATUS:
+    case Message::MessageType::DIPLOMATIC_STATUS:
+        if (!m_game_messages.empty())
+            m_turn_messages.push_back(message);
+        break;
+
+    case Message::MessageType::END_GAME:
+        m_game_messages.clear();
+        m_turn_messages.clear();
+        break;
+
+    default:
+        break;
+    }
+}
+
+void ObserverRelay::SendToObservers(const RelayedMessage& message) {
+    for (auto it = m_networking.established_begin(); it != m_networking.established_end(); ++it) {
+        const auto& observer = *it;
+        observer->SendMessage(observer->IsCompressionUsed() && message.compressed.Size() > 0 ?
+                              message.compressed : message.message);
+    }
+}
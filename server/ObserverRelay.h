@@ -0,0 +1,94 @@
+#ifndef _ObserverRelay_h_
+#define _ObserverRelay_h_
+
+#include "ServerNetworking.h"
+
+#include <boost/asio.hpp>
+#include <boost/circular_buffer.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+/** Relays a game hosted by another freeoriond to observers.  The relay joins
+    the game server given by the network.relay.upstream option as a single
+    observer, and accepts observer connections of its own, which are sent
+    every message the game server sends to the relay.  The game server thus
+    serializes and sends one observer stream however many observers there
+    are, and each message is compressed at most once by the relay for all of
+    them.
+
+    The messages needed to follow the game from the current turn are cached,
+    so that observers that join late are sent them on joining without
+    involving the game server.  The game server is never sent turn orders by
+    the relay, so never delta encodes the turn updates it sends, and the last
+    one is a complete gamestate.  Anything observers send to the relay, such
+    as chat, is dropped, as it would need the game server to answer it. */
+class ObserverRelay {
+public:
+    ObserverRelay();
+    ObserverRelay(const ObserverRelay&) = delete;
+    ObserverRelay(ObserverRelay&&) = delete;
+
+    const ObserverRelay& operator=(const ObserverRelay&) = delete;
+    ObserverRelay& operator=(ObserverRelay&&) = delete;
+
+    /** Connects to the game server and relays its messages until it
+      * disconnects.  Throws if the game server can't be connected to. */
+    void Run();
+
+private:
+    /** A message from the game server, with the compressed form of it that
+      * is sent to observers that accept compressed messages, if it is large
+      * enough to be compressed. */
+    struct RelayedMessage {
+        Message message;
+        Message compressed;
+    };
+
+    /** An observer that connected before the relay joined the game server,
+      * and is established once it has. */
+    struct PendingObserver {
+        PlayerConnectionPtr connection;
+        std::string         player_name;
+        std::string         client_version_string;
+    };
+
+    void ConnectUpstream();
+    void AsyncReadUpstream();
+    void SendUpstream(const Message& message);
+    void HandleUpstreamMessage(Message message);
+    void HandleUpstreamDisconnection(const boost::system::error_code& error);
+
+    void HandleNonPlayerMessage(const Message& msg, PlayerConnectionPtr player_connection);
+    void HandlePlayerMessage(const Message& msg, PlayerConnectionPtr player_connection);
+    void PlayerDisconnected(PlayerConnectionPtr player_connection);
+
+    /** Establishes \a observer, and sends it the cached messages.  Requires
+      * the relay to have joined the game server. */
+    void EstablishObserver(const PendingObserver& observer);
+
+    /** Records \a message in the cache of messages for observers that join
+      * later, if it is needed to follow the game. */
+    void CacheMessage(const RelayedMessage& message);
+
+    /** Sends \a message to all established observers. */
+    void SendToObservers(const RelayedMessage& message);
+
+    boost::asio::io_context         m_io_context;
+    boost::asio::ip::tcp::socket    m_upstream_socket;
+    Message::HeaderBuffer           m_upstream_header = {};
+    Message                         m_upstream_message;
+    int                             m_upstream_player_id = Networking::INVALID_PLAYER_ID;
+    ServerNetworking                m_networking;
+    std::vector<PendingObserver>    m_pending_observers;
+
+    std::map<Message::MessageType, RelayedMessage>  m_session_messages;     ///< last message of each type that sets up an observer's session, such as the content checksum
+    boost::circular_buffer<RelayedMessage>          m_recent_chat;          ///< chat since the chat history of m_session_messages
+    std::vector<RelayedMessage>                     m_game_messages;        ///< last GAME_START and TURN_UPDATE of the game, if any
+    std::vector<RelayedMessage>                     m_turn_messages;        ///< messages about the current turn since the last of m_game_messages
+};
+
+
+#endif
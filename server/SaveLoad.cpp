@@ -3,7 +3,9 @@
 #include "ServerApp.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
+#include "../universe/ObjectMap.h"
 #include "../universe/Species.h"
+#include "../universe/Universe.h"
 #include "../util/Directories.h"
 #include "../util/base64_filter.h"
 #include "../util/i18n.h"
@@ -14,9 +16,11 @@
 #include "../util/SaveGamePreviewUtils.h"
 #include "../util/Serialize.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 #include "../combat/CombatLogManager.h"
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/format.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/deque.hpp>
 #include <boost/serialization/list.hpp>
@@ -24,15 +28,24 @@
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/iostreams/filter/counter.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/thread.hpp>
 
 #include <boost/serialization/shared_ptr.hpp>
 
+#include <exception>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <vector>
+
 
 namespace fs = boost::filesystem;
 
@@ -87,8 +100,387 @@ namespace {
 
     const std::string XML_COMPRESSED_MARKER("zlib-xml");
     const std::string XML_COMPRESSED_BASE64_MARKER("zb64-xml");
+    const std::string XML_COMPRESSED_SECTIONS_MARKER("zb64-xml-sections");
+    const std::string XML_COMPRESSED_KNOWN_OBJECTS_SECTIONS_MARKER("zb64-xml-sections-known");
+    const std::string XML_COMPRESSED_JOURNAL_MARKER("zb64-xml-journal");
     const std::string XML_DIRECT_MARKER("raw-xml");
     const std::string BINARY_MARKER("binary");
+
+    const std::string SAVE_JOURNAL_FILE_EXTENSION(".mpj");
+
+    /** One separately compressed section of the gamestate in a save file. */
+    struct CompressedSaveSection {
+        std::function<void (freeorion_xml_oarchive&)>  serialize;
+        std::string                                     uncompressed_str;   ///< only used when serializing and compressing are done separately
+        std::string                                     compressed_str;
+        std::size_t                                     uncompressed_size = 0;
+    };
+
+    /** Returns the sections of the gamestate that are compressed separately
+      * in a save file: the main sections, followed by one section for each
+      * empire in \a empire_manager, whose ids are put in \a known_objects_empire_ids.
+      * If \a journal is given, the sections are an entry of it for turn
+      * \a turn, with the universe's objects and the empires' latest known
+      * objects encoded against its previous entry. */
+    std::vector<CompressedSaveSection> MakeSaveSections(const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                                        const Universe& universe,
+                                                        const EmpireManager& empire_manager,
+                                                        const SpeciesManager& species_manager,
+                                                        const CombatLogManager& combat_log_manager,
+                                                        std::vector<int>& known_objects_empire_ids,
+                                                        SaveGameJournal* journal = nullptr,
+                                                        int turn = -1)
+    {
+        std::vector<CompressedSaveSection> sections{
+            {[&player_save_game_data](freeorion_xml_oarchive& xoa)
+             { xoa << BOOST_SERIALIZATION_NVP(player_save_game_data); }},
+            {[&empire_manager](freeorion_xml_oarchive& xoa)
+             { xoa << BOOST_SERIALIZATION_NVP(empire_manager); }},
+            {[&species_manager](freeorion_xml_oarchive& xoa)
+             { xoa << BOOST_SERIALIZATION_NVP(species_manager); }},
+            {[&combat_log_manager](freeorion_xml_oarchive& xoa)
+             { xoa << BOOST_SERIALIZATION_NVP(combat_log_manager); }},
+            {[&universe, journal, turn](freeorion_xml_oarchive& xoa) {
+                 if (journal)
+                     SerializeDeltaWithoutKnownObjects(xoa, universe, journal->objects_base, true, turn);
+                 else
+                     SerializeWithoutKnownObjects(xoa, universe);
+             }}
+        };
+        known_objects_empire_ids.clear();
+        for (const auto& [empire_id, empire] : empire_manager) {
+            (void)empire;
+            known_objects_empire_ids.push_back(empire_id);
+            ObjectDeltaBase* known_objects_base = journal ? &journal->known_objects_bases[empire_id] : nullptr;
+            sections.push_back({[&universe, empire_id{empire_id}, known_objects_base, turn](freeorion_xml_oarchive& xoa) {
+                                    if (known_objects_base)
+                                        SerializeEmpireKnownObjectsDelta(xoa, universe, empire_id, *known_objects_base, true, turn);
+                                    else
+                                        SerializeEmpireKnownObjects(xoa, universe, empire_id);
+                                }});
+        }
+        return sections;
+    }
+    const std::size_t NUM_MAIN_SAVE_SECTIONS = 5;
+
+    /** Writes the uncompressed headers to \a xoa2, with the sizes of the
+      * compressed \a sections, as made by MakeSaveSections, in the preview. */
+    void WriteSaveHeaders(freeorion_xml_oarchive& xoa2, SaveGamePreviewData& save_preview_data,
+                          const GalaxySetupData& galaxy_setup_data,
+                          const ServerSaveGameData& server_save_game_data,
+                          const std::vector<PlayerSaveHeaderData>& player_save_header_data,
+                          const std::map<int, SaveGameEmpireData>& empire_save_game_data,
+                          const std::vector<CompressedSaveSection>& sections)
+    {
+        save_preview_data.uncompressed_text_size = 0;
+        save_preview_data.compressed_text_size = 0;
+        for (const auto& section : sections) {
+            save_preview_data.uncompressed_text_size += section.uncompressed_size;
+            save_preview_data.compressed_text_size += section.compressed_str.size();
+        }
+
+        xoa2 << BOOST_SERIALIZATION_NVP(save_preview_data);
+        xoa2 << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
+        xoa2 << BOOST_SERIALIZATION_NVP(server_save_game_data);
+        xoa2 << BOOST_SERIALIZATION_NVP(player_save_header_data);
+        xoa2 << BOOST_SERIALIZATION_NVP(empire_save_game_data);
+    }
+
+    /** Writes the compressed \a sections, as made by MakeSaveSections, to
+      * \a xoa2. */
+    void WriteSaveSections(freeorion_xml_oarchive& xoa2, const std::vector<CompressedSaveSection>& sections,
+                           const std::vector<int>& known_objects_empire_ids)
+    {
+        xoa2 << boost::serialization::make_nvp("compressed_player_save_game_data", sections[0].compressed_str);
+        xoa2 << boost::serialization::make_nvp("compressed_empire_manager", sections[1].compressed_str);
+        xoa2 << boost::serialization::make_nvp("compressed_species_manager", sections[2].compressed_str);
+        xoa2 << boost::serialization::make_nvp("compressed_combat_log_manager", sections[3].compressed_str);
+        xoa2 << boost::serialization::make_nvp("compressed_universe", sections[4].compressed_str);
+        xoa2 << BOOST_SERIALIZATION_NVP(known_objects_empire_ids);
+        for (std::size_t idx = NUM_MAIN_SAVE_SECTIONS; idx < sections.size(); ++idx)
+            xoa2 << boost::serialization::make_nvp("compressed_empire_known_objects", sections[idx].compressed_str);
+    }
+
+    /** Writes the uncompressed headers, followed by the compressed \a sections,
+      * as made by MakeSaveSections, to \a os. */
+    void WriteCompressedSections(std::ostream& os, SaveGamePreviewData& save_preview_data,
+                                 const GalaxySetupData& galaxy_setup_data,
+                                 const ServerSaveGameData& server_save_game_data,
+                                 const std::vector<PlayerSaveHeaderData>& player_save_header_data,
+                                 const std::map<int, SaveGameEmpireData>& empire_save_game_data,
+                                 const std::vector<CompressedSaveSection>& sections,
+                                 const std::vector<int>& known_objects_empire_ids)
+    {
+        // write to save file: uncompressed header serialized data, with compressed main archive strings at end...
+        freeorion_xml_oarchive xoa2(os);
+        WriteSaveHeaders(xoa2, save_preview_data, galaxy_setup_data, server_save_game_data,
+                         player_save_header_data, empire_save_game_data, sections);
+        WriteSaveSections(xoa2, sections, known_objects_empire_ids);
+    }
+
+    /** Appends the compressed \a sections, as made by MakeSaveSections for
+      * a journal, to the journal file at \a path as its entry for turn
+      * \a turn.  Each entry is written as the length of its XML archive, on a
+      * line of its own, followed by the archive.  Returns the number of bytes
+      * written. */
+    std::size_t AppendJournalEntry(const fs::path& path, int turn,
+                                   const std::vector<CompressedSaveSection>& sections,
+                                   const std::vector<int>& known_objects_empire_ids)
+    {
+        std::ostringstream entry_os;
+        {
+            freeorion_xml_oarchive xoa(entry_os);
+            xoa << BOOST_SERIALIZATION_NVP(turn);
+            WriteSaveSections(xoa, sections, known_objects_empire_ids);
+        }
+        const std::string entry = entry_os.str();
+        const std::string length_line = std::to_string(entry.size()) + "\n";
+
+        fs::ofstream ofs(path, std::ios_base::binary | std::ios_base::app);
+        if (!ofs)
+            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+        ofs.write(length_line.data(), length_line.size());
+        ofs.write(entry.data(), entry.size());
+        ofs.flush();
+        if (!ofs)
+            throw std::runtime_error("Unable to write entry to save journal " + PathToString(path));
+        return length_line.size() + entry.size();
+    }
+
+    /** Reads the next entry of a journal file from \a is, as written by
+      * AppendJournalEntry. */
+    std::string ReadJournalEntry(std::istream& is) {
+        std::string length_line;
+        if (!std::getline(is, length_line))
+            throw std::runtime_error("Save journal ends before the entry to be loaded");
+        const auto length = static_cast<std::size_t>(std::stoull(length_line));
+        std::string entry(length, '\0');
+        if (!is.read(entry.data(), length))
+            throw std::runtime_error("Save journal entry is truncated");
+        return entry;
+    }
+
+    /** Serializes \a section into its own XML archive, which is compressed and
+      * base64 encoded as it is written, so that the uncompressed text is never
+      * stored. */
+    void CompressSaveSection(CompressedSaveSection& section) {
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::counter());
+        os.push(boost::iostreams::zlib_compressor());
+        os.push(boost::iostreams::base64_encoder());
+        os.push(boost::iostreams::back_inserter(section.compressed_str));
+        {
+            freeorion_xml_oarchive xoa(os);
+            section.serialize(xoa);
+        }
+        os.flush();
+        section.uncompressed_size = os.component<boost::iostreams::counter>(0)->characters();
+        os.reset(); // flushes and closes compressor
+    }
+
+    /** Serializes \a section into its own uncompressed XML archive, which is
+      * kept in memory to be compressed later by CompressSerializedSaveSection. */
+    void SerializeSaveSection(CompressedSaveSection& section) {
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::back_inserter(section.uncompressed_str));
+        {
+            freeorion_xml_oarchive xoa(os);
+            section.serialize(xoa);
+        }
+        os.flush();
+        section.serialize = nullptr; // may refer to objects that are modified after serializing
+    }
+
+    /** Compresses and base64 encodes the XML text of \a section, as serialized
+      * by SerializeSaveSection, then frees that text. */
+    void CompressSerializedSaveSection(CompressedSaveSection& section) {
+        boost::iostreams::filtering_ostream os;
+        os.push(boost::iostreams::zlib_compressor());
+        os.push(boost::iostreams::base64_encoder());
+        os.push(boost::iostreams::back_inserter(section.compressed_str));
+        os.write(section.uncompressed_str.data(), section.uncompressed_str.size());
+        os.reset(); // flushes and closes compressor
+        section.uncompressed_size = section.uncompressed_str.size();
+        section.uncompressed_str = std::string();
+    }
+
+    /** Does \a process to each of \a sections in parallel. Rethrows the first
+      * exception thrown while processing any section. */
+    void ProcessSaveSections(std::vector<CompressedSaveSection>& sections,
+                             void (*process)(CompressedSaveSection&),
+                             const std::string& batch_name)
+    {
+        std::vector<std::exception_ptr> errors(sections.size());
+        const int encoding_empire = GlobalSerializationEncodingForEmpire();
+        TaskBatch task_batch(batch_name);
+        for (std::size_t idx = 0; idx < sections.size(); ++idx) {
+            task_batch.Post([&section = sections[idx], &error = errors[idx], encoding_empire, process]() {
+                try {
+                    GlobalSerializationEncodingForEmpire() = encoding_empire;
+                    process(section);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }, "section " + std::to_string(idx));
+        }
+        task_batch.Wait();
+        task_batch.LogTimings();
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    /** Deserializes a section of the gamestate from \a compressed_str, as
+      * written by CompressSaveSection, decompressing it as it is read. */
+    void LoadCompressedSaveSection(const std::string& compressed_str,
+                                   const std::function<void (freeorion_xml_iarchive&)>& deserialize)
+    {
+        boost::iostreams::filtering_istream is;
+        is.push(boost::iostreams::zlib_decompressor());
+        is.push(boost::iostreams::base64_decoder());
+        is.push(boost::iostreams::array_source(compressed_str.data(), compressed_str.size()));
+        freeorion_xml_iarchive xia(is);
+        deserialize(xia);
+    }
+
+    /** Deserializes each empire's latest known objects from its own section in
+      * \a compressed_strs, in parallel, then gives them to \a universe.  If
+      * \a known_objects_bases is given, the sections are of a journal entry
+      * for turn \a turn, encoded against the empires' latest known objects of
+      * the previous entry, as recorded in \a known_objects_bases. */
+    void LoadEmpireKnownObjectsSections(const std::vector<int>& empire_ids,
+                                        const std::vector<std::string>& compressed_strs,
+                                        Universe& universe,
+                                        std::map<int, ObjectDeltaBase>* known_objects_bases = nullptr,
+                                        int turn = -1)
+    {
+        std::vector<ObjectMap> known_objects(empire_ids.size());
+        std::vector<std::exception_ptr> errors(empire_ids.size());
+        const int encoding_empire = GlobalSerializationEncodingForEmpire();
+        TaskBatch task_batch("LoadGame");
+        for (std::size_t idx = 0; idx < empire_ids.size(); ++idx) {
+            ObjectDeltaBase* known_objects_base = known_objects_bases ? &(*known_objects_bases)[empire_ids[idx]] : nullptr;
+            task_batch.Post([&compressed_str = compressed_strs[idx], &objects = known_objects[idx],
+                             &error = errors[idx], encoding_empire, known_objects_base, turn]()
+            {
+                try {
+                    GlobalSerializationEncodingForEmpire() = encoding_empire;
+                    LoadCompressedSaveSection(compressed_str, [&objects, known_objects_base, turn](freeorion_xml_iarchive& xia) {
+                        if (known_objects_base)
+                            DeserializeEmpireKnownObjectsDelta(xia, objects, *known_objects_base, turn);
+                        else
+                            DeserializeEmpireKnownObjects(xia, objects);
+                    });
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }, "empire " + std::to_string(empire_ids[idx]) + " known objects");
+        }
+        task_batch.Wait();
+        task_batch.LogTimings();
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        for (std::size_t idx = 0; idx < empire_ids.size(); ++idx)
+            universe.SetEmpireKnownObjects(empire_ids[idx], std::move(known_objects[idx]));
+    }
+
+    /** Loads the gamestate of an incremental save, which is the first
+      * \a num_entries entries of the journal file at \a path, by replaying
+      * them in order from its base snapshot.  Only the universe and latest
+      * known objects of each entry are needed to decode the next entry, so the
+      * other sections are only loaded from the last entry. */
+    void LoadJournal(const fs::path& path, int num_entries,
+                     std::vector<PlayerSaveGameData>& player_save_game_data,
+                     Universe& universe, EmpireManager& empire_manager,
+                     SpeciesManager& species_manager, CombatLogManager& combat_log_manager)
+    {
+        if (num_entries < 1)
+            throw std::runtime_error("Incremental save refers to no journal entries");
+        fs::ifstream ifs(path, std::ios_base::binary);
+        if (!ifs)
+            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+
+        ObjectDeltaBase objects_base;
+        std::map<int, ObjectDeltaBase> known_objects_bases;
+
+        for (int entry_idx = 0; entry_idx < num_entries; ++entry_idx) {
+            const bool last_entry = entry_idx + 1 == num_entries;
+            const std::string entry = ReadJournalEntry(ifs);
+            std::istringstream is(entry);
+            freeorion_xml_iarchive xia(is);
+
+            int turn = -1;
+            xia >> BOOST_SERIALIZATION_NVP(turn);
+            DebugLogger() << "LoadJournal : replaying entry " << entry_idx << " for turn " << turn;
+
+            std::string compressed_str;
+            xia >> boost::serialization::make_nvp("compressed_player_save_game_data", compressed_str);
+            if (last_entry)
+                LoadCompressedSaveSection(compressed_str, [&player_save_game_data](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(player_save_game_data); });
+            xia >> boost::serialization::make_nvp("compressed_empire_manager", compressed_str);
+            if (last_entry)
+                LoadCompressedSaveSection(compressed_str, [&empire_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(empire_manager); });
+            xia >> boost::serialization::make_nvp("compressed_species_manager", compressed_str);
+            if (last_entry)
+                LoadCompressedSaveSection(compressed_str, [&species_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(species_manager); });
+            xia >> boost::serialization::make_nvp("compressed_combat_log_manager", compressed_str);
+            if (last_entry)
+                LoadCompressedSaveSection(compressed_str, [&combat_log_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(combat_log_manager); });
+
+            xia >> boost::serialization::make_nvp("compressed_universe", compressed_str);
+            LoadCompressedSaveSection(compressed_str, [&universe, &objects_base, turn](freeorion_xml_iarchive& xia2)
+                                      { DeserializeDeltaWithoutKnownObjects(xia2, universe, objects_base, turn); });
+
+            std::vector<int> known_objects_empire_ids;
+            xia >> BOOST_SERIALIZATION_NVP(known_objects_empire_ids);
+            std::vector<std::string> compressed_known_objects(known_objects_empire_ids.size());
+            for (auto& known_objects_str : compressed_known_objects)
+                xia >> boost::serialization::make_nvp("compressed_empire_known_objects", known_objects_str);
+            LoadEmpireKnownObjectsSections(known_objects_empire_ids, compressed_known_objects, universe,
+                                           &known_objects_bases, turn);
+        }
+    }
+
+    /** Returns the path to which a save named \a filename should be written,
+      * making sure that it is in the server save directory for \a multiplayer
+      * games, and that directory exists. */
+    fs::path SaveFilePath(const std::string& filename, bool multiplayer) {
+        fs::path path = FilenameToPath(filename);
+
+        // A relative path should be relative to the save directory.
+        if (path.is_relative()) {
+            path = (multiplayer ? GetServerSaveDir() : GetSaveDir()) / path;
+            DebugLogger() << "Made save path relative to save dir. Is now: " << path;
+        }
+
+        if (multiplayer) {
+            // Make sure the path points into our save directory
+            if (!IsInDir(GetServerSaveDir(), path.parent_path())) {
+                WarnLogger() << "Path \"" << path << "\" is not in server save directory.";
+                path = GetServerSaveDir() / path.filename();
+                WarnLogger() << "Path changed to \"" << path << "\"";
+            } else {
+                try {
+                    // ensure save directory exists
+                    if (!exists(path.parent_path())) {
+                        WarnLogger() << "Creating save directories " << path.parent_path().string();
+                        boost::filesystem::create_directories(path.parent_path());
+                    }
+                } catch (const std::exception& e) {
+                    ErrorLogger() << "Server unable to check / create save directory: " << e.what();
+                }
+            }
+        }
+        return path;
+    }
 }
 
 std::map<int, SaveGameEmpireData> CompileSaveGameEmpireData() {
@@ -132,32 +524,7 @@ int SaveGame(const std::string& filename, const ServerSaveGameData& server_save_
 
     try {
         timer.EnterSection("path management");
-        fs::path path = FilenameToPath(filename);
-
-        // A relative path should be relative to the save directory.
-        if (path.is_relative()) {
-            path = (multiplayer ? GetServerSaveDir() : GetSaveDir()) / path;
-            DebugLogger() << "Made save path relative to save dir. Is now: " << path;
-        }
-
-        if (multiplayer) {
-            // Make sure the path points into our save directory
-            if (!IsInDir(GetServerSaveDir(), path.parent_path())) {
-                WarnLogger() << "Path \"" << path << "\" is not in server save directory.";
-                path = GetServerSaveDir() / path.filename();
-                WarnLogger() << "Path changed to \"" << path << "\"";
-            } else {
-                try {
-                    // ensure save directory exists
-                    if (!exists(path.parent_path())) {
-                        WarnLogger() << "Creating save directories " << path.parent_path().string();
-                        boost::filesystem::create_directories(path.parent_path());
-                    }
-                } catch (const std::exception& e) {
-                    ErrorLogger() << "Server unable to check / create save directory: " << e.what();
-                }
-            }
-        }
+        fs::path path = SaveFilePath(filename, multiplayer);
         timer.EnterSection("");
 
 
@@ -174,89 +541,34 @@ int SaveGame(const std::string& filename, const ServerSaveGameData& server_save_
             if (use_zlib_for_zml) {
                 // Attempt compressed XML serialization
                 try {
-                    timer.EnterSection("xml prep / allocation");
                     // Two-tier serialization:
                     // main archive is uncompressed serialized header data first
-                    // then contains a string for compressed second archive
-                    // that contains the main gamestate info
+                    // then contains strings for compressed second archives
+                    // that each contain one section of the main gamestate info.
+                    // Each empire's latest known objects, which together are
+                    // often larger than the rest of the universe, get their own
+                    // sections. The sections are serialized and compressed in
+                    // parallel.
                     save_preview_data.SetBinary(false);
-                    save_preview_data.save_format_marker = XML_COMPRESSED_BASE64_MARKER;
-
-                    // allocate buffers for serialized gamestate
-                    DebugLogger() << "Allocating buffers for XML serialization...";
-                    std::string serial_str, compressed_str;
-                    try {
-                        DebugLogger() << "String Max Size: " << serial_str.max_size();
-                        std::string::size_type capacity = std::min(serial_str.max_size(),
-                            static_cast<std::string::size_type>(std::pow(2.0, 29.0)));
-                        DebugLogger() << "Reserving Capacity:: " << capacity;
-                        serial_str.reserve(capacity);
-                        compressed_str.reserve(std::pow(2.0, 26.0));
-                    }
-                    catch (...) {
-                        DebugLogger() << "Unable to preallocate full serialization buffers. Attempting serialization with dynamic buffer allocation.";
-                    }
-
-                    // wrap buffer string in iostream::stream to receive serialized data
-                    typedef boost::iostreams::back_insert_device<std::string> InsertDevice;
-                    InsertDevice serial_inserter(serial_str);
-                    boost::iostreams::stream<InsertDevice> s_sink(serial_inserter);
-
-                    timer.EnterSection("");
-                    {
-                        // create archive with (preallocated) buffer...
-                        freeorion_xml_oarchive xoa(s_sink);
-                        // serialize main gamestate info
-                        timer.EnterSection("player data to xml");
-                        xoa << BOOST_SERIALIZATION_NVP(player_save_game_data);
-                        timer.EnterSection("empires to xml");
-                        xoa << BOOST_SERIALIZATION_NVP(empire_manager);
-                        timer.EnterSection("species to xml");
-                        xoa << BOOST_SERIALIZATION_NVP(species_manager);
-                        timer.EnterSection("combat logs to xml");
-                        xoa << BOOST_SERIALIZATION_NVP(combat_log_manager);
-                        timer.EnterSection("universe to xml");
-                        Serialize(xoa, universe);
-                        timer.EnterSection("");
-                    }
-
-                    s_sink.flush();
+                    save_preview_data.save_format_marker = XML_COMPRESSED_KNOWN_OBJECTS_SECTIONS_MARKER;
 
-                    timer.EnterSection("compression");
-                    // wrap gamestate string in iostream::stream to extract serialized data
-                    typedef boost::iostreams::basic_array_source<char> SourceDevice;
-                    SourceDevice source(serial_str.data(), serial_str.size());
-                    boost::iostreams::stream<SourceDevice> s_source(source);
+                    timer.EnterSection("gamestate to compressed xml");
+                    std::vector<int> known_objects_empire_ids;
+                    auto sections = MakeSaveSections(player_save_game_data, universe, empire_manager,
+                                                     species_manager, combat_log_manager,
+                                                     known_objects_empire_ids);
+                    ProcessSaveSections(sections, CompressSaveSection, "SaveGame");
 
-                    // wrap compresed buffer string in iostream::streams to receive compressed string
-                    InsertDevice compressed_inserter(compressed_str);
-                    boost::iostreams::stream<InsertDevice> c_sink(compressed_inserter);
-
-                    // compression-filter gamestate into compressed string
-                    boost::iostreams::filtering_ostreambuf o;
-                    o.push(boost::iostreams::zlib_compressor());
-                    o.push(boost::iostreams::base64_encoder());
-                    o.push(c_sink);
-                    boost::iostreams::copy(s_source, o);
-                    c_sink.flush();
-
-                    save_preview_data.uncompressed_text_size = serial_str.size();
-                    save_preview_data.compressed_text_size = compressed_str.size();
-
-                    timer.EnterSection("headers to xml");
-                    // write to save file: uncompressed header serialized data, with compressed main archive string at end...
-                    freeorion_xml_oarchive xoa2(ofs);
-                    // serialize uncompressed save header info
-                    xoa2 << BOOST_SERIALIZATION_NVP(save_preview_data);
-                    xoa2 << BOOST_SERIALIZATION_NVP(galaxy_setup_data);
-                    xoa2 << BOOST_SERIALIZATION_NVP(server_save_game_data);
-                    xoa2 << BOOST_SERIALIZATION_NVP(player_save_header_data);
-                    xoa2 << BOOST_SERIALIZATION_NVP(empire_save_game_data);
-                    // append compressed gamestate info
-                    xoa2 << BOOST_SERIALIZATION_NVP(compressed_str);
+                    timer.EnterSection("headers and compressed gamestate to file");
+                    WriteCompressedSections(ofs, save_preview_data, galaxy_setup_data, server_save_game_data,
+                                            player_save_header_data, empire_save_game_data,
+                                            sections, known_objects_empire_ids);
 
                     timer.EnterSection("");
                     save_completed_as_xml = true;
+                } catch (const std::exception& e) {
+                    ErrorLogger() << "SaveGame : compressed XML serialization failed: " << e.what();
+                    save_completed_as_xml = false;  // redundant, but here for clarity
                 } catch (...) {
                     save_completed_as_xml = false;  // redundant, but here for clarity
                 }
@@ -326,6 +638,214 @@ int SaveGame(const std::string& filename, const ServerSaveGameData& server_save_
     return bytes_written;
 }
 
+struct SaveGameSnapshot {
+    fs::path                                path;
+    SaveGamePreviewData                     save_preview_data;
+    GalaxySetupData                         galaxy_setup_data;
+    ServerSaveGameData                      server_save_game_data;
+    std::vector<PlayerSaveHeaderData>       player_save_header_data;
+    std::map<int, SaveGameEmpireData>       empire_save_game_data;
+    std::vector<CompressedSaveSection>      sections;
+    std::vector<int>                        known_objects_empire_ids;
+
+    fs::path                                journal_path;           ///< if set, sections are appended to this journal, and path refers to them
+    int                                     journal_entries = 0;    ///< number of entries of the journal once sections are appended
+    int                                     turn = -1;
+    std::shared_ptr<std::atomic<bool>>      journal_failed;
+};
+
+namespace {
+    /** Returns a snapshot with the headers of a save file of the gamestate to
+      * \a filename, but no sections yet. */
+    std::shared_ptr<SaveGameSnapshot> StartSnapshot(SectionedScopedTimer& timer, const std::string& filename,
+                                                    const ServerSaveGameData& server_save_game_data,
+                                                    const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                                    GalaxySetupData galaxy_setup_data, bool multiplayer)
+    {
+        auto snapshot = std::make_shared<SaveGameSnapshot>();
+        snapshot->server_save_game_data = server_save_game_data;
+
+        timer.EnterSection("compiling data");
+        snapshot->empire_save_game_data = CompileSaveGameEmpireData();
+        CompileSaveGamePreviewData(server_save_game_data, player_save_game_data,
+                                   snapshot->empire_save_game_data, snapshot->save_preview_data);
+        snapshot->save_preview_data.SetBinary(false);
+        snapshot->save_preview_data.save_format_marker = XML_COMPRESSED_KNOWN_OBJECTS_SECTIONS_MARKER;
+
+        snapshot->player_save_header_data.reserve(player_save_game_data.size());
+        for (const PlayerSaveGameData& psgd : player_save_game_data)
+            snapshot->player_save_header_data.push_back(psgd);
+
+        snapshot->galaxy_setup_data = std::move(galaxy_setup_data);
+        snapshot->galaxy_setup_data.encoding_empire = ALL_EMPIRES;
+
+        timer.EnterSection("path management");
+        snapshot->path = SaveFilePath(filename, multiplayer);
+
+        return snapshot;
+    }
+}
+
+std::shared_ptr<SaveGameSnapshot> SnapshotGame(const std::string& filename,
+                                               const ServerSaveGameData& server_save_game_data,
+                                               const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                               const Universe& universe, const EmpireManager& empire_manager,
+                                               const SpeciesManager& species_manager,
+                                               const CombatLogManager& combat_log_manager,
+                                               GalaxySetupData galaxy_setup_data, bool multiplayer)
+{
+    if (GetOptionsDB().Get<bool>("save.format.binary.enabled") ||
+        !GetOptionsDB().Get<bool>("save.format.xml.zlib.enabled"))
+    { return nullptr; }
+
+    SectionedScopedTimer timer("SnapshotGame");
+    DebugLogger() << "SnapshotGame filename: " << filename;
+    GlobalSerializationEncodingForEmpire() = ALL_EMPIRES;
+
+    auto snapshot = StartSnapshot(timer, filename, server_save_game_data, player_save_game_data,
+                                  std::move(galaxy_setup_data), multiplayer);
+
+    try {
+        timer.EnterSection("gamestate to xml");
+        snapshot->sections = MakeSaveSections(player_save_game_data, universe, empire_manager,
+                                              species_manager, combat_log_manager,
+                                              snapshot->known_objects_empire_ids);
+        ProcessSaveSections(snapshot->sections, SerializeSaveSection, "SnapshotGame");
+    } catch (const std::exception& e) {
+        ErrorLogger() << "SnapshotGame : XML serialization failed: " << e.what();
+        return nullptr;
+    }
+    timer.EnterSection("");
+
+    return snapshot;
+}
+
+std::shared_ptr<SaveGameSnapshot> SnapshotGameToJournal(SaveGameJournal& journal, const std::string& filename,
+                                                        const ServerSaveGameData& server_save_game_data,
+                                                        const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                                        const Universe& universe, const EmpireManager& empire_manager,
+                                                        const SpeciesManager& species_manager,
+                                                        const CombatLogManager& combat_log_manager,
+                                                        GalaxySetupData galaxy_setup_data, bool multiplayer)
+{
+    if (GetOptionsDB().Get<bool>("save.format.binary.enabled") ||
+        !GetOptionsDB().Get<bool>("save.format.xml.zlib.enabled"))
+    { return nullptr; }
+
+    SectionedScopedTimer timer("SnapshotGameToJournal");
+    DebugLogger() << "SnapshotGameToJournal filename: " << filename;
+    GlobalSerializationEncodingForEmpire() = ALL_EMPIRES;
+
+    auto snapshot = StartSnapshot(timer, filename, server_save_game_data, player_save_game_data,
+                                  std::move(galaxy_setup_data), multiplayer);
+    const int turn = server_save_game_data.current_turn;
+
+    // start a new journal, with a full snapshot as its first entry, if there
+    // is none yet, if appending to it failed, or if its chain of deltas is
+    // long enough that loading the latest entry would be slow
+    timer.EnterSection("journal management");
+    const fs::path journal_dir = snapshot->path.parent_path();
+    if (journal.path.empty() || !journal.failed || *journal.failed ||
+        FilenameToPath(journal.path).parent_path() != journal_dir ||
+        journal.num_entries >= GetOptionsDB().Get<int>("save.auto.incremental.base.interval"))
+    {
+        const std::string journal_filename = boost::io::str(boost::format("FreeOrion_journal_%04d_%s%s")
+                                                            % turn % FilenameTimestamp()
+                                                            % SAVE_JOURNAL_FILE_EXTENSION);
+        journal.path = PathToString(journal_dir / journal_filename);
+        journal.num_entries = 0;
+        journal.objects_base.Clear();
+        journal.known_objects_bases.clear();
+        journal.failed = std::make_shared<std::atomic<bool>>(false);
+        DebugLogger() << "SnapshotGameToJournal : starting save journal " << journal.path;
+    }
+
+    try {
+        timer.EnterSection("gamestate to xml");
+        snapshot->sections = MakeSaveSections(player_save_game_data, universe, empire_manager,
+                                              species_manager, combat_log_manager,
+                                              snapshot->known_objects_empire_ids, &journal, turn);
+        ProcessSaveSections(snapshot->sections, SerializeSaveSection, "SnapshotGameToJournal");
+    } catch (const std::exception& e) {
+        ErrorLogger() << "SnapshotGameToJournal : XML serialization failed: " << e.what();
+        // the delta bases may have been updated past the last entry, so the
+        // next snapshot starts a new journal
+        journal.path.clear();
+        return nullptr;
+    }
+    timer.EnterSection("");
+
+    snapshot->save_preview_data.save_format_marker = XML_COMPRESSED_JOURNAL_MARKER;
+    snapshot->journal_path = FilenameToPath(journal.path);
+    snapshot->journal_entries = ++journal.num_entries;
+    snapshot->turn = turn;
+    snapshot->journal_failed = journal.failed;
+
+    return snapshot;
+}
+
+int WriteGameSnapshot(SaveGameSnapshot& snapshot) {
+    SectionedScopedTimer timer("WriteGameSnapshot");
+    DebugLogger() << "WriteGameSnapshot path: " << snapshot.path;
+
+    int bytes_written = 0;
+    try {
+        timer.EnterSection("compressing gamestate");
+        ProcessSaveSections(snapshot.sections, CompressSerializedSaveSection, "WriteGameSnapshot");
+
+        if (!snapshot.journal_path.empty()) {
+            // entries are encoded against the previous entry, so none can be
+            // appended after one that failed
+            timer.EnterSection("journal entry to file");
+            if (*snapshot.journal_failed)
+                throw std::runtime_error("An earlier entry of save journal " + PathToString(snapshot.journal_path) +
+                                         " could not be written");
+            try {
+                bytes_written += static_cast<int>(AppendJournalEntry(snapshot.journal_path, snapshot.turn,
+                                                                     snapshot.sections,
+                                                                     snapshot.known_objects_empire_ids));
+            } catch (...) {
+                *snapshot.journal_failed = true;
+                throw;
+            }
+        }
+
+        timer.EnterSection("headers and compressed gamestate to file");
+        fs::ofstream ofs(snapshot.path, std::ios_base::binary);
+        if (!ofs)
+            throw std::runtime_error(UNABLE_TO_OPEN_FILE);
+        std::streampos pos_before_writing = ofs.tellp();
+
+        if (snapshot.journal_path.empty()) {
+            WriteCompressedSections(ofs, snapshot.save_preview_data, snapshot.galaxy_setup_data,
+                                    snapshot.server_save_game_data, snapshot.player_save_header_data,
+                                    snapshot.empire_save_game_data, snapshot.sections,
+                                    snapshot.known_objects_empire_ids);
+        } else {
+            // the save file only has the headers, and which entry of the journal it is
+            freeorion_xml_oarchive xoa(ofs);
+            WriteSaveHeaders(xoa, snapshot.save_preview_data, snapshot.galaxy_setup_data,
+                             snapshot.server_save_game_data, snapshot.player_save_header_data,
+                             snapshot.empire_save_game_data, snapshot.sections);
+            const std::string journal_filename = PathToString(snapshot.journal_path.filename());
+            const int journal_entries = snapshot.journal_entries;
+            xoa << BOOST_SERIALIZATION_NVP(journal_filename);
+            xoa << BOOST_SERIALIZATION_NVP(journal_entries);
+        }
+
+        ofs.flush();
+        bytes_written += ofs.tellp() - pos_before_writing;
+        timer.EnterSection("");
+
+    } catch (const std::exception& e) {
+        ErrorLogger() << UserString("UNABLE_TO_WRITE_SAVE_FILE") << " WriteGameSnapshot exception: " << e.what();
+        throw;
+    }
+    DebugLogger() << "WriteGameSnapshot : Successfully wrote save file";
+
+    return bytes_written;
+}
+
 void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_data,
               std::vector<PlayerSaveGameData>& player_save_game_data, Universe& universe,
               EmpireManager& empire_manager, SpeciesManager& species_manager,
@@ -408,6 +928,62 @@ void LoadGame(const std::string& filename, ServerSaveGameData& server_save_game_
                 timer.EnterSection("xml universe");
                 Deserialize(xia, universe);
 
+            } else if (ignored_save_preview_data.save_format_marker == XML_COMPRESSED_SECTIONS_MARKER ||
+                       ignored_save_preview_data.save_format_marker == XML_COMPRESSED_KNOWN_OBJECTS_SECTIONS_MARKER)
+            {
+                const bool known_objects_sections =
+                    ignored_save_preview_data.save_format_marker == XML_COMPRESSED_KNOWN_OBJECTS_SECTIONS_MARKER;
+
+                // each section of gamestate info is in its own compressed archive
+                std::string compressed_str;
+
+                timer.EnterSection("xml player data");
+                xia >> boost::serialization::make_nvp("compressed_player_save_game_data", compressed_str);
+                LoadCompressedSaveSection(compressed_str, [&player_save_game_data](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(player_save_game_data); });
+                timer.EnterSection("xml empires");
+                xia >> boost::serialization::make_nvp("compressed_empire_manager", compressed_str);
+                LoadCompressedSaveSection(compressed_str, [&empire_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(empire_manager); });
+                timer.EnterSection("xml species");
+                xia >> boost::serialization::make_nvp("compressed_species_manager", compressed_str);
+                LoadCompressedSaveSection(compressed_str, [&species_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(species_manager); });
+                timer.EnterSection("xml combat logs");
+                xia >> boost::serialization::make_nvp("compressed_combat_log_manager", compressed_str);
+                LoadCompressedSaveSection(compressed_str, [&combat_log_manager](freeorion_xml_iarchive& xia2)
+                                          { xia2 >> BOOST_SERIALIZATION_NVP(combat_log_manager); });
+                timer.EnterSection("xml universe");
+                xia >> boost::serialization::make_nvp("compressed_universe", compressed_str);
+                if (!known_objects_sections) {
+                    LoadCompressedSaveSection(compressed_str, [&universe](freeorion_xml_iarchive& xia2)
+                                              { Deserialize(xia2, universe); });
+                } else {
+                    LoadCompressedSaveSection(compressed_str, [&universe](freeorion_xml_iarchive& xia2)
+                                              { DeserializeWithoutKnownObjects(xia2, universe); });
+
+                    timer.EnterSection("xml empire known objects");
+                    std::vector<int> known_objects_empire_ids;
+                    xia >> BOOST_SERIALIZATION_NVP(known_objects_empire_ids);
+                    std::vector<std::string> compressed_known_objects(known_objects_empire_ids.size());
+                    for (auto& known_objects_str : compressed_known_objects)
+                        xia >> boost::serialization::make_nvp("compressed_empire_known_objects", known_objects_str);
+                    LoadEmpireKnownObjectsSections(known_objects_empire_ids, compressed_known_objects, universe);
+                }
+
+            } else if (ignored_save_preview_data.save_format_marker == XML_COMPRESSED_JOURNAL_MARKER) {
+                // the gamestate is an entry of a journal in the same directory
+                std::string journal_filename;
+                int journal_entries = 0;
+                xia >> BOOST_SERIALIZATION_NVP(journal_filename);
+                xia >> BOOST_SERIALIZATION_NVP(journal_entries);
+
+                timer.EnterSection("xml journal");
+                const fs::path journal_path = path.parent_path() / FilenameToPath(journal_filename).filename();
+                DebugLogger() << "Loading entry " << journal_entries << " of save journal " << journal_path;
+                LoadJournal(journal_path, journal_entries, player_save_game_data, universe,
+                            empire_manager, species_manager, combat_log_manager);
+
             } else {
                 // assume compressed XML
                 if (BOOST_VERSION >= 106600 && ignored_save_preview_data.save_format_marker == XML_COMPRESSED_MARKER)
@@ -1,9 +1,12 @@
 #ifndef _SaveLoad_h_
 #define _SaveLoad_h_
 
+#include <atomic>
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
+#include "../util/ObjectDeltaBase.h"
 
 class CombatLogManager;
 class EmpireManager;
@@ -13,8 +16,24 @@ struct GalaxySetupData;
 struct PlayerSaveGameData;
 struct PlayerSaveHeaderData;
 struct SaveGameEmpireData;
+struct SaveGameSnapshot;
 struct ServerSaveGameData;
 
+/** The journal that incremental saves are written to, as kept by the server
+  * between saves.  A journal file is a sequence of entries that each hold the
+  * gamestate of one save.  The first entry of a journal is a full base
+  * snapshot, and each later entry holds only the objects that have changed
+  * since the previous entry, and the ids of the others.  An incremental save
+  * file has the usual headers, followed by the name of its journal file and
+  * the number of entries of it that are replayed to load the save. */
+struct SaveGameJournal {
+    std::string                         path;               ///< of the journal file, or empty if none has been started
+    int                                 num_entries = 0;    ///< in the journal file, including those not yet written by WriteGameSnapshot
+    ObjectDeltaBase                     objects_base;       ///< universe objects of the last entry
+    std::map<int, ObjectDeltaBase>      known_objects_bases;///< empires' latest known objects of the last entry, by empire id
+    std::shared_ptr<std::atomic<bool>>  failed;             ///< set if writing an entry fails, so that no more are appended to the journal file
+};
+
 /** Prepared empire data for save game or lobby. */
 std::map<int, SaveGameEmpireData> CompileSaveGameEmpireData();
 
@@ -29,6 +48,45 @@ int SaveGame(const std::string& filename,
              GalaxySetupData galaxy_setup_data,
              bool multiplayer);
 
+/** Serializes the provided data to memory, to be compressed and written to
+  * savefile \a filename later by WriteGameSnapshot, possibly on another
+  * thread. Once this returns, the provided data may be modified without
+  * affecting the snapshot. Returns null if the snapshot could not be made,
+  * or the save format options require a format other than compressed XML,
+  * in which case SaveGame should be used instead. */
+std::shared_ptr<SaveGameSnapshot> SnapshotGame(const std::string& filename,
+                                               const ServerSaveGameData& server_save_game_data,
+                                               const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                               const Universe& universe,
+                                               const EmpireManager& empire_manager,
+                                               const SpeciesManager& species_manager,
+                                               const CombatLogManager& combat_log_manager,
+                                               GalaxySetupData galaxy_setup_data,
+                                               bool multiplayer);
+
+/** As SnapshotGame, but WriteGameSnapshot appends the snapshot as an entry to
+  * \a journal, and writes savefile \a filename as an incremental save that
+  * refers to that entry.  A new journal file is started, with a full base
+  * snapshot, if there is none yet in the directory of \a filename, if
+  * writing an entry to the last one failed, or once it has as many entries as
+  * the save.auto.incremental.base.interval option. */
+std::shared_ptr<SaveGameSnapshot> SnapshotGameToJournal(SaveGameJournal& journal,
+                                                        const std::string& filename,
+                                                        const ServerSaveGameData& server_save_game_data,
+                                                        const std::vector<PlayerSaveGameData>& player_save_game_data,
+                                                        const Universe& universe,
+                                                        const EmpireManager& empire_manager,
+                                                        const SpeciesManager& species_manager,
+                                                        const CombatLogManager& combat_log_manager,
+                                                        GalaxySetupData galaxy_setup_data,
+                                                        bool multiplayer);
+
+/** Compresses \a snapshot, as made by SnapshotGame or SnapshotGameToJournal,
+  * and writes it to its savefile, and journal if any. Returns the number of
+  * bytes written. Does not use any global game state, so may be called on any
+  * thread. */
+int WriteGameSnapshot(SaveGameSnapshot& snapshot);
+
 /** Loads the indicated data from savefile \a filename. */
 void LoadGame(const std::string& filename,
               ServerSaveGameData& server_save_game_data,
@@ -1,8 +1,20 @@
 #include "ServerApp.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <ctime>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <thread>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/date_time/posix_time/time_formatters.hpp>
 #include <boost/filesystem/exception.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -13,18 +25,26 @@
 #include <boost/uuid/uuid_io.hpp>
 #include "SaveLoad.h"
 #include "ServerFSM.h"
+#include "TurnReplay.h"
 #include "UniverseGenerator.h"
 #include "../combat/CombatEvents.h"
 #include "../combat/CombatLogManager.h"
 #include "../combat/CombatSystem.h"
 #include "../Empire/Empire.h"
+#include "../Empire/Government.h"
 #include "../parse/Parse.h"
 #include "../universe/Building.h"
+#include "../universe/BuildingType.h"
+#include "../universe/CompiledValueRef.h"
 #include "../universe/Condition.h"
+#include "../universe/FieldType.h"
 #include "../universe/Fleet.h"
 #include "../universe/FleetPlan.h"
+#include "../universe/Pathfinder.h"
 #include "../universe/Planet.h"
 #include "../universe/ShipDesign.h"
+#include "../universe/ShipHull.h"
+#include "../universe/ShipPart.h"
 #include "../universe/Ship.h"
 #include "../universe/Special.h"
 #include "../universe/Species.h"
@@ -46,6 +66,7 @@
 #include "../util/SaveGamePreviewUtils.h"
 #include "../util/ScopedTimer.h"
 #include "../util/SitRepEntry.h"
+#include "../util/ThreadPool.h"
 #include "../util/Version.h"
 
 
@@ -65,6 +86,31 @@ namespace {
         }
         return ALL_EMPIRES;
     }
+
+    /** Turn profiling is enabled while the timer logger, which ScopedTimers
+      * log to, is at the trace threshold, so that it can be toggled with the
+      * other log thresholds of a running server. */
+    void UpdateTurnProfiling(const std::set<std::tuple<std::string, std::string, LogLevel>>& options) {
+        for (const auto& [option_name, name, level] : options)
+            if (option_name == "logging.sources.timer")
+                SetTurnProfilingEnabled(level <= LogLevel::trace);
+    }
+
+    /** Adds the time for which it exists to a total. */
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(std::chrono::steady_clock::duration& total) :
+            m_total(total),
+            m_start(std::chrono::steady_clock::now())
+        {}
+
+        ~PhaseTimer()
+        { m_total += std::chrono::steady_clock::now() - m_start; }
+
+    private:
+        std::chrono::steady_clock::duration&        m_total;
+        const std::chrono::steady_clock::time_point m_start;
+    };
 };
 
 void Seed(unsigned int seed);
@@ -83,6 +129,8 @@ ServerApp::ServerApp() :
     m_fsm(new ServerFSM(*this)),
     m_chat_history(1000)
 {
+    ScopedTimer timer("ServerApp::ServerApp");
+
     // Force the log file if requested.
     if (GetOptionsDB().Get<std::string>("log-file").empty()) {
         const std::string SERVER_LOG_FILENAME((GetUserDataDir() / "freeoriond.log").string());
@@ -93,9 +141,13 @@ ServerApp::ServerApp() :
     if (!force_log_level.empty())
         OverrideAllLoggersThresholds(to_LogLevel(force_log_level));
 
-    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "Server");
+    InitLoggingSystem(GetOptionsDB().Get<std::string>("log-file"), "Server",
+                      GetOptionsDB().Get<bool>("log-async"));
     InitLoggingOptionsDBSystem();
 
+    SetPathfinderCaller(PathfinderCaller::PATHFINDER_CALLER_SERVER);
+    UpdateTurnProfiling(LoggerOptionsLabelsAndLevels(LoggerTypes::named));
+
     InfoLogger() << FreeOrionVersionString();
     LogDependencyVersions();
 
@@ -113,7 +165,10 @@ ServerApp::ServerApp() :
 
     // Initialize Python before FSM initialization
     // to be able use it for parsing
-    InitializePython();
+    {
+        ScopedTimer timer("ServerApp::InitializePython");
+        InitializePython();
+    }
     if (!m_python_server.IsPythonRunning())
         throw std::runtime_error("Python not initialized");
 
@@ -121,7 +176,10 @@ ServerApp::ServerApp() :
     // to have data initialized before autostart execution
     StartBackgroundParsing();
 
-    m_fsm->initiate();
+    {
+        ScopedTimer timer("ServerFSM initiate");
+        m_fsm->initiate();
+    }
 
     namespace ph = boost::placeholders;
 
@@ -139,6 +197,7 @@ ServerApp::~ServerApp() {
     // Calling Py_Finalize here causes segfault when m_python_server destructing with its python
     // object fields
 
+    WaitForBackgroundSave();
     CleanupAIs();
     delete m_fsm;
     DebugLogger() << "Server exited cleanly.";
@@ -168,6 +227,81 @@ namespace {
 #include <stdlib.h>
 #endif
 
+namespace {
+    /** Content categories that can be reparsed and replaced during a game,
+      * by their scripting subdirectory. */
+    const std::array<std::string_view, 8> RELOADABLE_CONTENT = {
+        "buildings", "fields", "policies", "specials", "species", "ship_parts", "ship_hulls", "techs"};
+
+    /** Returns a hash of the paths, sizes and modification times of the
+      * files in \a dir, and its subdirectories, that are or aren't macros
+      * files, depending on \a macros. */
+    std::size_t FilesFingerprint(const fs::path& dir, bool macros) {
+        std::size_t retval = 0;
+        boost::system::error_code ec;
+        if (!fs::is_directory(dir, ec))
+            return retval;
+        std::vector<fs::path> files;
+        for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (fs::is_regular_file(it->status()) && (it->path().extension() == ".macros") == macros)
+                files.push_back(it->path());
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            boost::hash_combine(retval, file.generic_string());
+            boost::hash_combine(retval, static_cast<uintmax_t>(fs::file_size(file, ec)));
+            boost::hash_combine(retval, static_cast<long long>(fs::last_write_time(file, ec)));
+        }
+        return retval;
+    }
+
+    /** Returns fingerprints of the script files of each reloadable content
+      * category.  Macros files may be included from any category, so they
+      * are all part of each category's fingerprint. */
+    std::map<std::string, std::size_t> ContentFingerprints(const fs::path& scripting_dir) {
+        const auto macros_fingerprint = FilesFingerprint(scripting_dir, true);
+        std::map<std::string, std::size_t> retval;
+        for (const auto category : RELOADABLE_CONTENT) {
+            auto fingerprint = FilesFingerprint(scripting_dir / std::string{category}, false);
+            boost::hash_combine(fingerprint, macros_fingerprint);
+            retval.emplace(category, fingerprint);
+        }
+        return retval;
+    }
+
+    bool NoContent(const Universe&) = delete;
+
+    template <typename T>
+    bool NoContent(const T& content)
+    { return content.empty(); }
+
+    template <typename T, typename U>
+    bool NoContent(const std::pair<T, U>& content)
+    { return content.first.empty(); }
+
+    template <typename... Ts>
+    bool NoContent(const std::tuple<Ts...>& content)
+    { return std::get<0>(content).empty(); }
+
+    /** Starts parsing \a path with \a parser, and returns a function that
+      * waits for the result and passes it as a completed Pending to
+      * \a install, unless parsing failed or found nothing. */
+    template <typename Parser, typename Install>
+    std::function<void ()> StartReparsing(const Parser& parser, const fs::path& path, Install install) {
+        using PendingContent = decltype(Pending::StartParsing(parser, path));
+        auto pending = std::make_shared<PendingContent>(Pending::StartParsing(parser, path));
+        return [pending, install, name{path.filename().string()}]() {
+            auto parsed = Pending::WaitForPendingUnlocked(std::move(*pending));
+            if (!parsed || NoContent(*parsed)) {
+                ErrorLogger() << "Reparsing " << name << " failed or found no content.  Keeping previous content.";
+                return;
+            }
+            install(Pending::Completed(std::move(*parsed), name));
+            InfoLogger() << "Replaced " << name << " with reparsed content";
+        };
+    }
+}
+
 void ServerApp::StartBackgroundParsing() {
     IApp::StartBackgroundParsing();
     const auto& rdir = GetResourceDir();
@@ -196,6 +330,181 @@ void ServerApp::StartBackgroundParsing() {
         m_universe.SetEmpireStats(Pending::StartParsing(parse::statistics, rdir / "scripting/empire_statistics"));
     else
         ErrorLogger() << "Background parse path doesn't exist: " << (rdir / "scripting/empire_statistics").string();
+
+    if (GetOptionsDB().Get<bool>("resource.reload.enabled"))
+        m_content_fingerprints = ContentFingerprints(rdir / "scripting");
+}
+
+void ServerApp::StartReloadingChangedContent() {
+    if (!GetOptionsDB().Get<bool>("resource.reload.enabled") || !m_content_reloads.empty())
+        return;
+
+    const auto scripting_dir = GetResourceDir() / "scripting";
+    auto fingerprints = ContentFingerprints(scripting_dir);
+
+    for (const auto& [category, fingerprint] : fingerprints) {
+        auto old_it = m_content_fingerprints.find(category);
+        if (old_it != m_content_fingerprints.end() && old_it->second == fingerprint)
+            continue;
+        DebugLogger() << "ServerApp::StartReloadingChangedContent reparsing changed " << category;
+
+        const auto dir = scripting_dir / category;
+        if (category == "buildings")
+            m_content_reloads.push_back(StartReparsing(parse::buildings, dir,
+                [](auto&& pending) { GetBuildingTypeManager().SetBuildingTypes(std::move(pending)); }));
+        else if (category == "fields")
+            m_content_reloads.push_back(StartReparsing(parse::fields, dir,
+                [](auto&& pending) { GetFieldTypeManager().SetFieldTypes(std::move(pending)); }));
+        else if (category == "policies")
+            m_content_reloads.push_back(StartReparsing(parse::policies, dir,
+                [](auto&& pending) { GetPolicyManager().SetPolicies(std::move(pending)); }));
+        else if (category == "specials")
+            m_content_reloads.push_back(StartReparsing(parse::specials, dir,
+                [](auto&& pending) { GetSpecialsManager().SetSpecialsTypes(std::move(pending)); }));
+        else if (category == "species")
+            m_content_reloads.push_back(StartReparsing(parse::species, dir,
+                [this](auto&& pending) { m_species_manager.SetSpeciesTypes(std::move(pending)); }));
+        else if (category == "ship_parts")
+            m_content_reloads.push_back(StartReparsing(parse::ship_parts, dir,
+                [](auto&& pending) { GetShipPartManager().SetShipParts(std::move(pending)); }));
+        else if (category == "ship_hulls")
+            m_content_reloads.push_back(StartReparsing(parse::ship_hulls, dir,
+                [](auto&& pending) { GetShipHullManager().SetShipHulls(std::move(pending)); }));
+        else if (category == "techs")
+            m_content_reloads.push_back(StartReparsing(parse::techs<TechManager::TechParseTuple>, dir,
+                [](auto&& pending) { GetTechManager().SetTechs(std::move(pending)); }));
+    }
+
+    m_content_fingerprints = std::move(fingerprints);
+}
+
+void ServerApp::InstallReloadedContent() {
+    if (m_content_reloads.empty())
+        return;
+    ScopedTimer timer("ServerApp::InstallReloadedContent", true);
+    for (auto& install : m_content_reloads)
+        install();
+    m_content_reloads.clear();
+}
+
+namespace {
+    /** Returns \a text quoted as a Prometheus label value. */
+    std::string MetricLabel(const std::string& text) {
+        std::string retval{"\""};
+        for (const char c : text) {
+            if (c == '\\' || c == '"')
+                retval.push_back('\\');
+            if (c == '\n')
+                retval.append("\\n");
+            else
+                retval.push_back(c);
+        }
+        retval.push_back('"');
+        return retval;
+    }
+
+    double Seconds(std::chrono::steady_clock::duration duration)
+    { return std::chrono::duration<double>(duration).count(); }
+}
+
+void ServerApp::WriteMetrics(const std::string& path) const {
+    const auto empire_labels = [this](int empire_id) {
+        const auto empire = m_empires.GetEmpire(empire_id);
+        const bool ai = GetEmpireClientType(empire_id) == Networking::ClientType::CLIENT_TYPE_AI_PLAYER;
+        return "empire_id=\"" + std::to_string(empire_id) + "\",empire=" +
+            MetricLabel(empire ? empire->Name() : "") + ",client=\"" + (ai ? "ai" : "human") + "\"";
+    };
+
+    std::stringstream ss;
+    ss << "# HELP freeorion_game_info The game being played.\n"
+       << "# TYPE freeorion_game_info gauge\n"
+       << "freeorion_game_info{uid=" << MetricLabel(m_galaxy_setup_data.game_uid) << "} 1\n"
+       << "# HELP freeorion_turn The current turn.\n"
+       << "# TYPE freeorion_turn gauge\n"
+       << "freeorion_turn " << m_current_turn << '\n';
+
+    ss << "# HELP freeorion_turn_phase_seconds Time taken by each phase of processing the last turn.\n"
+       << "# TYPE freeorion_turn_phase_seconds gauge\n";
+    for (const auto& [phase, duration] : {std::pair{"orders", m_turn_metrics.orders},
+                                          {"combat", m_turn_metrics.combat},
+                                          {"effects", m_turn_metrics.effects},
+                                          {"visibility", m_turn_metrics.visibility},
+                                          {"supply", m_turn_metrics.supply},
+                                          {"queues", m_turn_metrics.queues}})
+    { ss << "freeorion_turn_phase_seconds{phase=\"" << phase << "\"} " << Seconds(duration) << '\n'; }
+
+    ss << "# HELP freeorion_turn_event_seconds Time taken by each Python turn event function called on the last turn.\n"
+       << "# TYPE freeorion_turn_event_seconds gauge\n";
+    for (const auto& [function_name, duration] : m_turn_metrics.turn_events)
+        ss << "freeorion_turn_event_seconds{event=" << MetricLabel(function_name) << "} " << Seconds(duration) << '\n';
+
+    ss << "# HELP freeorion_turn_work_reduction Whether optional work was reduced to keep processing the last turn within its budget.\n"
+       << "# TYPE freeorion_turn_work_reduction gauge\n";
+    for (const auto& [reduction, applied] : {std::pair{"production_projection", m_turn_work_reductions.production_projection},
+                                             {"combat_log_events", m_turn_work_reductions.combat_log_events},
+                                             {"mid_combat_stale_knowledge", m_turn_work_reductions.mid_combat_stale_knowledge}})
+    { ss << "freeorion_turn_work_reduction{reduction=\"" << reduction << "\"} " << (applied ? 1 : 0) << '\n'; }
+
+    ss << "# HELP freeorion_turn_update_encoding_seconds Time taken to encode each empire's last turn update.\n"
+       << "# TYPE freeorion_turn_update_encoding_seconds gauge\n";
+    for (const auto& [empire_id, duration] : m_turn_metrics.turn_updates)
+        ss << "freeorion_turn_update_encoding_seconds{" << empire_labels(empire_id) << "} " << Seconds(duration) << '\n';
+
+    ss << "# HELP freeorion_orders_wait_seconds Time from sending the turn update before the last turn to receiving each empire's orders.\n"
+       << "# TYPE freeorion_orders_wait_seconds gauge\n";
+    for (const auto& [empire_id, duration] : m_turn_metrics.orders_wait)
+        ss << "freeorion_orders_wait_seconds{" << empire_labels(empire_id) << "} " << Seconds(duration) << '\n';
+
+    ss << "# HELP freeorion_orders_outstanding_seconds Time since the last turn update was sent, for each empire whose orders have not been received.\n"
+       << "# TYPE freeorion_orders_outstanding_seconds gauge\n";
+    for (const auto& [empire_id, empire] : m_empires) {
+        if (!empire->Eliminated() && !m_orders_wait.count(empire_id))
+            ss << "freeorion_orders_outstanding_seconds{" << empire_labels(empire_id) << "} "
+               << Seconds(std::chrono::steady_clock::now() - m_turn_updates_sent) << '\n';
+    }
+
+    ss << "# HELP freeorion_player_sent_bytes_total Bytes sent to each player.\n"
+       << "# TYPE freeorion_player_sent_bytes_total counter\n";
+    for (auto it = m_networking.established_begin(); it != m_networking.established_end(); ++it)
+        ss << "freeorion_player_sent_bytes_total{player=" << MetricLabel((*it)->PlayerName()) << "} "
+           << (*it)->BytesSent() << '\n';
+    ss << "# HELP freeorion_player_sent_messages_total Messages sent to each player.\n"
+       << "# TYPE freeorion_player_sent_messages_total counter\n";
+    for (auto it = m_networking.established_begin(); it != m_networking.established_end(); ++it)
+        ss << "freeorion_player_sent_messages_total{player=" << MetricLabel((*it)->PlayerName()) << "} "
+           << (*it)->MessagesSent() << '\n';
+
+    const auto& objects = m_universe.Objects();
+    ss << "# HELP freeorion_objects Objects in the universe.\n"
+       << "# TYPE freeorion_objects gauge\n"
+       << "freeorion_objects{type=\"all\"} " << objects.size() << '\n'
+       << "freeorion_objects{type=\"system\"} " << objects.size<System>() << '\n'
+       << "freeorion_objects{type=\"planet\"} " << objects.size<Planet>() << '\n'
+       << "freeorion_objects{type=\"building\"} " << objects.size<Building>() << '\n'
+       << "freeorion_objects{type=\"fleet\"} " << objects.size<Fleet>() << '\n'
+       << "freeorion_objects{type=\"ship\"} " << objects.size<Ship>() << '\n'
+       << "# HELP freeorion_peak_resident_memory_bytes Peak resident memory of the server.\n"
+       << "# TYPE freeorion_peak_resident_memory_bytes gauge\n"
+       << "freeorion_peak_resident_memory_bytes " << PeakResidentMemoryKB() * 1024 << '\n';
+
+    // write to a temporary file and rename it, so that a collector never
+    // reads a partly written file
+    const auto final_path = FilenameToPath(path);
+    auto temp_path = final_path;
+    temp_path += ".tmp";
+    try {
+        {
+            boost::filesystem::ofstream ofs(temp_path);
+            ofs << ss.str();
+            if (!ofs) {
+                ErrorLogger() << "ServerApp::WriteMetrics unable to write " << PathToString(temp_path);
+                return;
+            }
+        }
+        boost::filesystem::rename(temp_path, final_path);
+    } catch (const boost::filesystem::filesystem_error& e) {
+        ErrorLogger() << "ServerApp::WriteMetrics unable to replace " << path << ": " << e.what();
+    }
 }
 
 void ServerApp::CreateAIClients(const std::vector<PlayerSetupData>& player_setup_data, int max_aggression) {
@@ -241,6 +550,9 @@ void ServerApp::CreateAIClients(const std::vector<PlayerSetupData>& player_setup
     args.push_back(max_aggr_str.str());
     args.push_back("--resource.path");
     args.push_back("\"" + GetOptionsDB().Get<std::string>("resource.path") + "\"");
+    // share the server's preprocessed content cache, so AIs don't redo work the server already did
+    args.push_back("--resource.parse-cache.path");
+    args.push_back("\"" + GetOptionsDB().Get<std::string>("resource.parse-cache.path") + "\"");
 
     auto force_log_level = GetOptionsDB().Get<std::string>("log-level");
     if (!force_log_level.empty()) {
@@ -248,6 +560,9 @@ void ServerApp::CreateAIClients(const std::vector<PlayerSetupData>& player_setup
         args.push_back(GetOptionsDB().Get<std::string>("log-level"));
     }
 
+    if (GetOptionsDB().Get<bool>("log-async"))
+        args.push_back("--log-async");
+
     if (GetOptionsDB().Get<bool>("testing")) {
         args.push_back("--testing");
 #ifdef FREEORION_LINUX
@@ -262,6 +577,12 @@ void ServerApp::CreateAIClients(const std::vector<PlayerSetupData>& player_setup
     DebugLogger() << "starting AIs with " << AI_CLIENT_EXE ;
     DebugLogger() << "ai-aggression set to " << max_aggression;
     DebugLogger() << "ai-path set to '" << GetOptionsDB().Get<std::string>("ai-path") << "'";
+    auto ai_turn_budget = GetOptionsDB().Get<double>("ai.turn.budget");
+    if (ai_turn_budget > 0.0) {
+        args.push_back("--ai.turn.budget");
+        args.push_back(std::to_string(ai_turn_budget));
+        DebugLogger() << "ai.turn.budget set to " << ai_turn_budget << " s";
+    }
     std::string ai_config = GetOptionsDB().Get<std::string>("ai-config");
     if (!ai_config.empty()) {
         args.push_back("--ai-config");
@@ -330,6 +651,7 @@ std::string ServerApp::GetVisibleObjectName(std::shared_ptr<const UniverseObject
 }
 
 void ServerApp::Run() {
+    FinishStartupTrace("server ready", FilenameToPath(GetOptionsDB().Get<std::string>("startup-trace.path")));
     DebugLogger() << "FreeOrion server waiting for network events";
     try {
         while (1) {
@@ -421,11 +743,12 @@ void ServerApp::HandleMessage(const Message& msg, PlayerConnectionPtr player_con
     case Message::MessageType::ELIMINATE_SELF:           m_fsm->process_event(EliminateSelf(msg, player_connection));    break;
     case Message::MessageType::AUTO_TURN:                m_fsm->process_event(AutoTurn(msg, player_connection));         break;
 
-    case Message::MessageType::ERROR_MSG:
-    case Message::MessageType::DEBUG:                    break;
+    case Message::MessageType::ERROR_MSG:                break;
+    case Message::MessageType::DEBUG:                    HandleDebugCommand(msg, player_connection); break;
 
     case Message::MessageType::SHUT_DOWN_SERVER:         HandleShutdownMessage(msg, player_connection);  break;
     case Message::MessageType::AI_END_GAME_ACK:          m_fsm->process_event(LeaveGame(msg, player_connection));        break;
+    case Message::MessageType::AI_TURN_TIMINGS:          HandleAITurnTimings(msg, player_connection); break;
 
     case Message::MessageType::REQUEST_SAVE_PREVIEWS:    UpdateSavePreviews(msg, player_connection); break;
     case Message::MessageType::REQUEST_COMBAT_LOGS:      m_fsm->process_event(RequestCombatLogs(msg, player_connection));break;
@@ -449,6 +772,47 @@ void ServerApp::HandleShutdownMessage(const Message& msg, PlayerConnectionPtr pl
     m_fsm->process_event(ShutdownServer());
 }
 
+void ServerApp::HandleAITurnTimings(const Message& msg, PlayerConnectionPtr player_connection) {
+    if (player_connection->GetClientType() != Networking::ClientType::CLIENT_TYPE_AI_PLAYER) {
+        ErrorLogger() << "ServerApp::HandleAITurnTimings rejecting turn timings from non-AI player " << player_connection->PlayerName();
+        return;
+    }
+    InfoLogger() << "AI player " << player_connection->PlayerName() << " order generation " << msg.Text();
+}
+
+void ServerApp::HandleDebugCommand(const Message& msg, PlayerConnectionPtr player_connection) {
+    if (!m_networking.PlayerIsHost(player_connection->PlayerID()) &&
+        player_connection->GetClientType() != Networking::ClientType::CLIENT_TYPE_HUMAN_MODERATOR)
+    {
+        WarnLogger() << "ServerApp::HandleDebugCommand rejecting command from player " << player_connection->PlayerName()
+                     << " who is neither the host nor a moderator";
+        return;
+    }
+
+    std::string output;
+    if (msg.Text() == "memory") {
+        output = MemoryReport();
+    } else if (msg.Text() == "generation") {
+        output = UniverseGenerationReport();
+    } else if (boost::starts_with(msg.Text(), "native-effects")) {
+        static constexpr std::size_t DEFAULT_NATIVE_EFFECTS = 50;
+        std::size_t max_count = DEFAULT_NATIVE_EFFECTS;
+        const auto count_text = boost::trim_copy(msg.Text().substr(std::string_view{"native-effects"}.size()));
+        try {
+            if (!count_text.empty())
+                max_count = boost::lexical_cast<std::size_t>(count_text);
+        } catch (const boost::bad_lexical_cast&) {}
+        output = WriteNativeEffects(max_count);
+    } else {
+        output = "Unknown debug command: " + msg.Text();
+    }
+
+    InfoLogger() << "Debug command \"" << msg.Text() << "\" from " << player_connection->PlayerName() << ":\n" << output;
+    player_connection->SendMessage(ServerPlayerChatMessage(Networking::INVALID_PLAYER_ID,
+                                                           boost::posix_time::second_clock::universal_time(),
+                                                           output, true));
+}
+
 void ServerApp::HandleLoggerConfig(const Message& msg, PlayerConnectionPtr player_connection) {
     int player_id = player_connection->PlayerID();
     bool is_host = m_networking.PlayerIsHost(player_id);
@@ -462,6 +826,7 @@ void ServerApp::HandleLoggerConfig(const Message& msg, PlayerConnectionPtr playe
     ExtractLoggerConfigMessageData(msg, options);
 
     SetLoggerThresholds(options);
+    UpdateTurnProfiling(options);
 
     // Forward the message to all the AIs
     const auto relay_options_message = LoggerConfigMessage(Networking::INVALID_PLAYER_ID, options);
@@ -643,29 +1008,52 @@ void ServerApp::NewMPGameInit(const MultiplayerLobbyData& multiplayer_lobby_data
 }
 
 namespace {
+    /** Calls \a fn with each non-eliminated empire in \a empires, in
+      * parallel, and returns once all calls are done.  Each call may only
+      * change the empire it is given; changes to the universe, such as
+      * creating objects, must be made afterwards, one empire at a time in
+      * order of empire id, so that they don't depend on thread scheduling.
+      * The empires' cached sources are determined before starting, as
+      * evaluating content for one empire may look up another's source. */
+    template <typename Function>
+    void ForEachEmpireInParallel(EmpireManager& empires, const ObjectMap& objects,
+                                 const std::string& batch_name, Function fn)
+    {
+        TaskBatch batch(batch_name);
+        for ([[maybe_unused]] auto& [empire_id, empire] : empires) {
+            if (empire->Eliminated())
+                continue;
+            empire->Source(objects);
+            batch.Post([&fn, empire{empire.get()}]() { fn(*empire); },
+                       std::to_string(empire_id));
+        }
+        batch.Wait();
+        batch.LogTimings();
+    }
+
     void UpdateEmpireSupply(const ScriptingContext& context, EmpireManager& empires,
                             SupplyManager& supply, bool precombat = false)
     {
         // Determine initial supply distribution and exchanging and resource pools for empires
+        const SupplyAffectingFleets supply_affecting_fleets(context.ContextObjects());
         for ([[maybe_unused]] auto& [ignored_id, empire] : empires) {
             (void)ignored_id; // quiet unused variable warning
             if (empire->Eliminated())
                 continue;   // skip eliminated empires.  presumably this shouldn't be an issue when initializing a new game, but apparently I thought this was worth checking for...
 
-            empire->UpdateSupplyUnobstructedSystems(context, precombat); // determines which systems can propagate fleet and resource (same for both)
+            empire->UpdateSupplyUnobstructedSystems(context, supply_affecting_fleets, precombat); // determines which systems can propagate fleet and resource (same for both)
             empire->UpdateSystemSupplyRanges();                          // sets range systems can propagate fleet and resourse supply (separately)
         }
 
         supply.Update();
 
-        for ([[maybe_unused]] auto& [ignored_id, empire] : empires) {
-            (void)ignored_id; // quiet unused variable warning
-            if (empire->Eliminated())
-                continue;
-
-            empire->InitResourcePools();   // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
-            empire->UpdateResourcePools(); // determines how much of each resources is available in each resource sharing group
-        }
+        // each empire's resource pools and queues depend only on the universe
+        // and on that empire, so are updated for all empires at once
+        ForEachEmpireInParallel(empires, context.ContextObjects(), "UpdateEmpireSupply resource pools",
+                                [&context](Empire& empire) {
+            empire.InitResourcePools(context.ContextObjects()); // determines population centers and resource centers of empire, tells resource pools the centers and groups of systems that can share resources (note that being able to share resources doesn't mean a system produces resources)
+            empire.UpdateResourcePools();                       // determines how much of each resources is available in each resource sharing group
+        });
     }
 }
 
@@ -702,6 +1090,7 @@ void ServerApp::NewGameInitConcurrentWithJoiners(
     m_turn_sequence.clear();
     m_player_empire_ids.clear();
     m_empires.Clear();
+    m_save_game_journal = SaveGameJournal{};
 
     // set server state info for new game
     m_current_turn = BEFORE_FIRST_TURN;
@@ -722,6 +1111,7 @@ void ServerApp::NewGameInitConcurrentWithJoiners(
     m_current_turn = 0;
     ScriptingContext context{m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager};
     m_universe.ApplyGenerateSitRepEffects(context);
+    EndUniverseGenerationPhase("greeting sitreps");
 
     //can set current turn to 1 for start of game
     m_current_turn = 1;
@@ -745,13 +1135,24 @@ void ServerApp::NewGameInitConcurrentWithJoiners(
     // update visibility information to ensure data sent out is up-to-date
     DebugLogger() << "ServerApp::NewGameInitConcurrentWithJoiners: Updating first-turn Empire stuff";
     m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    EndUniverseGenerationPhase("empire known objects");
 
     // initialize empire owned object counters
     for (auto& entry : m_empires)
         entry.second->UpdateOwnedObjectCounters();
 
     UpdateEmpireSupply(context, m_empires, m_supply_manager);
+    EndUniverseGenerationPhase("supply");
     m_universe.UpdateStatRecords(m_empires);
+    EndUniverseGenerationPhase("statistics");
+
+    const auto report = UniverseGenerationReport();
+    InfoLogger() << "ServerApp::NewGameInitConcurrentWithJoiners universe generation times:\n" << report;
+    if (GetOptionsDB().Get<bool>("network.server.universe-generation.report")) {
+        const auto timestamp = boost::posix_time::second_clock::universal_time();
+        for (auto it = m_networking.established_begin(); it != m_networking.established_end(); ++it)
+            (*it)->SendMessage(ServerPlayerChatMessage(Networking::INVALID_PLAYER_ID, timestamp, report));
+    }
 }
 
 bool ServerApp::NewGameInitVerifyJoiners(const std::vector<PlayerSetupData>& player_setup_data) {
@@ -941,6 +1342,37 @@ namespace {
     }
 }
 
+void ServerApp::WriteGameSnapshotInBackground(std::shared_ptr<SaveGameSnapshot> snapshot,
+                                              std::string save_filename)
+{
+    WaitForBackgroundSave();
+
+    m_background_save = std::async(std::launch::async,
+        [this, snapshot{std::move(snapshot)}, save_filename{std::move(save_filename)}]()
+    {
+        int bytes_written = 0;
+        bool failed = false;
+        try {
+            bytes_written = WriteGameSnapshot(*snapshot);
+        } catch (const std::exception& error) {
+            ErrorLogger() << "While writing save in background, caught std::exception: " << error.what();
+            failed = true;
+        }
+
+        // inform players on the main thread, which owns the networking
+        boost::asio::post(m_io_context, [this, save_filename, bytes_written, failed]() {
+            if (failed)
+                m_networking.SendMessageAll(ErrorMessage(UserStringNop("UNABLE_TO_WRITE_SAVE_FILE"), false));
+            m_networking.SendMessageAll(ServerSaveGameCompleteMessage(save_filename, bytes_written));
+        });
+    });
+}
+
+void ServerApp::WaitForBackgroundSave() {
+    if (m_background_save.valid())
+        m_background_save.wait();
+}
+
 void ServerApp::UpdateSavePreviews(const Message& msg,
                                    PlayerConnectionPtr player_connection)
 {
@@ -1305,6 +1737,7 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
     // clear previous game player state info
     m_turn_sequence.clear();
     m_player_empire_ids.clear();
+    m_save_game_journal = SaveGameJournal{};
 
 
     // restore server state info from save
@@ -1455,7 +1888,164 @@ void ServerApp::LoadGameInit(const std::vector<PlayerSaveGameData>& player_save_
     }
 }
 
+TurnDigest ServerApp::CurrentTurnDigest() const
+{ return ComputeTurnDigest(m_universe, m_empires, m_supply_manager); }
+
+std::string ServerApp::MemoryReport() const {
+    auto parts = m_universe.ApproximateMemoryUsage();
+    for (auto& [name, bytes] : parts)
+        name = "universe " + name;
+
+    parts.emplace_back("combat logs", GetCombatLogManager().ApproximateMemoryUsage());
+
+    // summed over all empires, however many there are
+    std::map<std::string, std::size_t> empire_parts;
+    for (const auto& [empire_id, empire] : m_empires)
+        for (const auto& [name, bytes] : empire->ApproximateMemoryUsage())
+            empire_parts["empire " + name] += bytes;
+    parts.insert(parts.end(), empire_parts.begin(), empire_parts.end());
+
+    std::stable_sort(parts.begin(), parts.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+    std::size_t total = 0;
+    std::stringstream ss;
+    for (const auto& [name, bytes] : parts) {
+        ss << name << ": " << (bytes + 1023) / 1024 << " KiB\n";
+        total += bytes;
+    }
+    ss << "total: " << (total + 1023) / 1024 << " KiB";
+    return ss.str();
+}
+
+std::string ServerApp::UniverseGenerationReport() const {
+    if (m_universe_generation_phases.empty())
+        return "no universe has been generated";
+
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+
+    TurnMetrics::Duration total{0};
+    std::stringstream ss;
+    for (const auto& [phase, duration] : m_universe_generation_phases) {
+        ss << phase << ": " << duration_cast<milliseconds>(duration).count() << " ms\n";
+        total += duration;
+    }
+    ss << "total: " << duration_cast<milliseconds>(total).count() << " ms";
+    return ss.str();
+}
+
+std::string ServerApp::WriteNativeEffects(std::size_t max_count) const {
+    std::size_t num_generated = 0;
+    const auto source = ValueRef::CompiledValueRef::GenerateNativeSource(max_count, num_generated);
+
+    const auto path = GetUserDataDir() / "NativeValueRefTable.cpp";
+    try {
+        boost::filesystem::ofstream ofs(path);
+        ofs << source;
+        if (!ofs)
+            return "unable to write " + PathToString(path);
+    } catch (const boost::filesystem::filesystem_error& e) {
+        return "unable to write " + PathToString(path) + ": " + e.what();
+    }
+    return "wrote native code for " + std::to_string(num_generated) + " SetMeter values to " + PathToString(path);
+}
+
+int ServerApp::ReplayTurns(const std::string& save_file, const std::string& record_path, int num_turns) {
+    DebugLogger() << "ServerApp::ReplayTurns from " << save_file << " with orders recorded in " << record_path;
+
+    const auto record_dir = FilenameToPath(record_path);
+    const auto recorded_digests = ReadTurnDigests(record_dir / TURN_DIGESTS_FILENAME);
+    const auto replay_digests_path = record_dir / REPLAY_DIGESTS_FILENAME;
+
+    // don't overwrite the recording being replayed
+    GetOptionsDB().Set<std::string>("server.turn.record.path", "");
+
+    ServerSaveGameData server_save_game_data;
+    std::vector<PlayerSaveGameData> player_save_game_data;
+    try {
+        LoadGame(save_file,                 server_save_game_data,
+                 player_save_game_data,     m_universe,
+                 m_empires,                 m_species_manager,
+                 GetCombatLogManager(),     m_galaxy_setup_data);
+    } catch (const std::exception& e) {
+        ErrorLogger() << "ServerApp::ReplayTurns unable to load " << save_file << ": " << e.what();
+        return 1;
+    }
+
+    // set up the loaded game as LoadGameInit does, without any players
+    GetGameRules().SetFromStrings(m_galaxy_setup_data.GetGameRules());
+    unsigned int seed = 0;
+    try {
+        seed = boost::lexical_cast<unsigned int>(m_galaxy_setup_data.seed);
+    } catch (...) {
+        seed = static_cast<unsigned int>(boost::hash<std::string>{}(m_galaxy_setup_data.seed));
+    }
+    Seed(seed);
+
+    m_current_turn = server_save_game_data.current_turn;
+    m_turn_sequence.clear();
+    for (const auto& psgd : player_save_game_data) {
+        auto empire = m_empires.GetEmpire(psgd.empire_id);
+        if (empire && !empire->Eliminated())
+            AddEmpireTurn(psgd.empire_id, psgd);
+    }
+
+    m_universe.InitializeSystemGraph(m_empires, m_universe.Objects());
+    m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(m_empires);
+    ScriptingContext context{m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager};
+    UpdateEmpireSupply(context, m_empires, m_supply_manager, true);  // precombat supply update
+
+    if (num_turns <= 0)
+        num_turns = recorded_digests.empty() ? 0 : (recorded_digests.rbegin()->first - m_current_turn + 1);
+
+    boost::system::error_code ec;
+    fs::remove(replay_digests_path, ec);
+
+    int differing_turns = 0;
+    for (int i = 0; i < num_turns; ++i) {
+        const int turn = m_current_turn;
+
+        try {
+            for (auto& [empire_id, orders] : ReadTurnOrders(record_dir, turn)) {
+                auto it = m_turn_sequence.find(empire_id);
+                if (it != m_turn_sequence.end() && it->second)
+                    it->second->orders = std::move(orders);
+            }
+        } catch (const std::exception& e) {
+            ErrorLogger() << "ServerApp::ReplayTurns unable to read orders of turn " << turn << ": " << e.what();
+            return differing_turns + (num_turns - i);
+        }
+
+        PreCombatProcessTurns();
+        ProcessCombats();
+        PostCombatProcessTurns();
+
+        const auto digest = CurrentTurnDigest();
+        AppendTurnDigest(replay_digests_path, turn, digest);
+
+        auto recorded_it = recorded_digests.find(turn);
+        if (recorded_it == recorded_digests.end()) {
+            WarnLogger() << "ServerApp::ReplayTurns has no recorded digest for turn " << turn;
+        } else if (recorded_it->second != digest) {
+            ++differing_turns;
+            const auto& recorded = recorded_it->second;
+            ErrorLogger() << "ServerApp::ReplayTurns result of turn " << turn << " differs from the recording:"
+                          << (recorded.universe != digest.universe ? " universe" : "")
+                          << (recorded.empires != digest.empires ? " empires" : "")
+                          << (recorded.supply != digest.supply ? " supply" : "");
+        } else {
+            InfoLogger() << "ServerApp::ReplayTurns result of turn " << turn << " matches the recording";
+        }
+    }
+
+    return differing_turns;
+}
+
 void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_data) {
+    m_universe_generation_phases.clear();
+    m_universe_generation_phase_start = std::chrono::steady_clock::now();
+
     // Set game UID. Needs to be done first so we can use ClockSeed to
     // prevent reproducible UIDs.
     ClockSeed();
@@ -1502,6 +2092,7 @@ void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_da
     GetPredefinedShipDesignManager().AddShipDesignsToUniverse(); // TODO: pass in m_universe
     // Initialize empire objects for each player
     InitEmpires(player_setup_data);
+    EndUniverseGenerationPhase("empires and predefined designs");
 
     bool success{false};
     try {
@@ -1521,6 +2112,7 @@ void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_da
 
     if (!success)
         ServerApp::GetApp()->Networking().SendMessageAll(ErrorMessage(UserStringNop("SERVER_UNIVERSE_GENERATION_ERRORS"), false));
+    EndUniverseGenerationPhase("universe generation scripts");
 
     for (auto& empire : m_empires)
         empire.second->ApplyNewTechs();
@@ -1531,12 +2123,13 @@ void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_da
 
     // Apply effects for 1st turn.
     m_universe.ApplyAllEffectsAndUpdateMeters(context, false);
+    EndUniverseGenerationPhase("first turn effects");
 
     TraceLogger(effects) << "After First turn meter effect applying: " << m_universe.Objects().Dump();
     // Set active meters to targets or maxes after first meter effects application
     SetActiveMetersToTargetMaxCurrentValues(m_universe.Objects());
 
-    m_universe.UpdateMeterEstimates(context);
+    m_universe.UpdateMeterEstimates(context, false);
     m_universe.BackPropagateObjectMeters();
     SetActiveMetersToTargetMaxCurrentValues(m_universe.Objects());
     m_universe.BackPropagateObjectMeters();
@@ -1545,12 +2138,15 @@ void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_da
 
     m_universe.BackPropagateObjectMeters();
     m_empires.BackPropagateMeters();
+    EndUniverseGenerationPhase("initial meters and estimates");
 
     DebugLogger() << "Re-applying first turn meter effects and updating meters";
 
     // Re-apply meter effects, so that results depending on meter values can be
     // re-checked after initial setting of those meter values
     m_universe.ApplyMeterEffectsAndUpdateMeters(context, false);
+    EndUniverseGenerationPhase("first turn meter effects");
+
     // Re-set active meters to targets after re-application of effects
     SetActiveMetersToTargetMaxCurrentValues(m_universe.Objects());
     // Set the population of unowned planets to a random fraction of their target values.
@@ -1558,19 +2154,33 @@ void ServerApp::GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_da
 
     m_universe.BackPropagateObjectMeters();
     m_empires.BackPropagateMeters();
+    EndUniverseGenerationPhase("native populations");
 
     TraceLogger() << "!!!!!!!!!!!!!!!!!!! After setting active meters to targets";
     TraceLogger() << m_universe.Objects().Dump();
 
     m_universe.UpdateEmpireObjectVisibilities(m_empires);
+    EndUniverseGenerationPhase("empire visibilities");
+}
+
+void ServerApp::EndUniverseGenerationPhase(std::string phase) {
+    const auto now = std::chrono::steady_clock::now();
+    m_universe_generation_phases.emplace_back(std::move(phase), now - m_universe_generation_phase_start);
+    m_universe_generation_phase_start = now;
 }
 
 void ServerApp::ExecuteScriptedTurnEvents() {
+    // skip calling into Python on turns that no turn event is triggered on
+    if (!m_python_server.TurnEventsFire(m_current_turn)) {
+        DebugLogger() << "ServerApp::ExecuteScriptedTurnEvents : no turn events triggered on turn " << m_current_turn;
+        return;
+    }
+
     bool success(false);
     try {
         m_python_server.SetCurrentDir(GetPythonTurnEventsDir());
-        // Call the main Python turn events function
-        success = m_python_server.ExecuteTurnEvents();
+        // Call the Python turn events functions triggered this turn
+        success = m_python_server.ExecuteTurnEvents(m_current_turn, m_turn_metrics.turn_events);
     } catch (const boost::python::error_already_set& err) {
         success = false;
         m_python_server.HandleErrorAlreadySet();
@@ -1585,6 +2195,10 @@ void ServerApp::ExecuteScriptedTurnEvents() {
         }
     }
 
+    for (const auto& [function_name, duration] : m_turn_metrics.turn_events)
+        DebugLogger() << "ServerApp::ExecuteScriptedTurnEvents : " << function_name << " took "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms";
+
     if (!success) {
         ErrorLogger() << "Python scripted turn events failed.";
         ServerApp::GetApp()->Networking().SendMessageAll(ErrorMessage(UserStringNop("SERVER_TURN_EVENTS_ERRORS"), false));
@@ -1818,6 +2432,7 @@ bool ServerApp::EliminatePlayer(const PlayerConnectionPtr& player_connection) {
 
     // empire elimination
     empire->Eliminate();
+    InvalidateOrderIndependentTurnWork();
 
     // destroy owned ships
     for (auto& obj : m_universe.Objects().find<Ship>(OwnedVisitor(empire_id))) {
@@ -1841,12 +2456,7 @@ bool ServerApp::EliminatePlayer(const PlayerConnectionPtr& player_connection) {
 
     // notify other player that this empire finished orders
     // so them don't think player of eliminated empire is making its turn too long
-    for (auto player_it = m_networking.established_begin();
-        player_it != m_networking.established_end(); ++player_it)
-    {
-        PlayerConnectionPtr player_ctn = *player_it;
-        player_ctn->SendMessage(PlayerStatusMessage(Message::PlayerStatus::WAITING, empire_id));
-    }
+    m_networking.SendMessageAll(PlayerStatusMessage(Message::PlayerStatus::WAITING, empire_id));
 
     return true;
 }
@@ -2052,8 +2662,17 @@ void ServerApp::ClearEmpireTurnOrders() {
     }
 }
 
-void ServerApp::SetEmpireSaveGameData(int empire_id, std::unique_ptr<PlayerSaveGameData>&& save_game_data)
-{ m_turn_sequence[empire_id] = std::move(save_game_data); }
+void ServerApp::SetEmpireSaveGameData(int empire_id, std::unique_ptr<PlayerSaveGameData>&& save_game_data) {
+    m_turn_sequence[empire_id] = std::move(save_game_data);
+
+    if (m_turn_updates_sent == std::chrono::steady_clock::time_point{})
+        return;
+    m_orders_wait[empire_id] = std::chrono::steady_clock::now() - m_turn_updates_sent;
+    // update which empires' orders are outstanding
+    const auto& metrics_path = GetOptionsDB().Get<std::string>("network.server.metrics.path");
+    if (!metrics_path.empty())
+        WriteMetrics(metrics_path);
+}
 
 void ServerApp::UpdatePartialOrders(int empire_id, const OrderSet& added, const std::set<int>& deleted) {
     const auto& psgd = m_turn_sequence[empire_id];
@@ -2439,11 +3058,80 @@ namespace {
     {
         combats.clear();
         // for each system, find if a combat will occur in it, and if so, assemble
-        // necessary information about that combat in combats
-        for (const auto& sys : universe.Objects().all<System>()) {
-            if (CombatConditionsInSystem(sys->ID(), universe.Objects()))
-                combats.emplace_back(sys->ID(), CurrentTurn(), universe,
-                                     empires, setup_data, species, supply);
+        // necessary information about that combat.  systems are independent
+        // and assembling only reads the universe, so is done in parallel
+        std::vector<int> system_ids;
+        for (const auto& sys : universe.Objects().all<System>())
+            system_ids.push_back(sys->ID());
+        const int current_turn = CurrentTurn();
+        std::vector<std::optional<CombatInfo>> system_combats(system_ids.size());
+
+        TaskBatch batch("AssembleSystemCombatInfo");
+        for (std::size_t idx = 0; idx < system_ids.size(); ++idx) {
+            batch.Post([&, idx]() {
+                const int system_id = system_ids[idx];
+                if (CombatConditionsInSystem(system_id, universe.Objects()))
+                    system_combats[idx].emplace(system_id, current_turn, universe,
+                                                empires, setup_data, species, supply);
+            });
+        }
+        batch.Wait();
+
+        for (auto& system_combat : system_combats)
+            if (system_combat)
+                combats.push_back(std::move(*system_combat));
+    }
+
+    std::size_t CountCombatEvents(const std::vector<ConstCombatEventPtr>& events) {
+        std::size_t retval = events.size();
+        for (const auto& event : events)
+            if (event)
+                retval += CountCombatEvents(event->SubEvents(ALL_EMPIRES));
+        return retval;
+    }
+
+    /** Resolves each of \a combats \a repetitions times, each time starting
+      * from a clone of its initial objects and with its random stream seeded
+      * by the same seed in \a seeds, and logs how long resolving took.  The
+      * combats themselves are left unresolved. */
+    void BenchmarkCombats(const std::vector<CombatInfo>& combats,
+                          const std::vector<std::uint64_t>& seeds, int repetitions)
+    {
+        using clock = std::chrono::steady_clock;
+
+        for (std::size_t idx = 0; idx < combats.size(); ++idx) {
+            const CombatInfo& combat = combats[idx];
+            const std::size_t num_objects = combat.objects->size();
+
+            clock::duration total{0}, fastest{clock::duration::max()}, slowest{0};
+            int bouts = 0;
+            std::size_t events = 0;
+
+            for (int rep = 0; rep < repetitions; ++rep) {
+                auto replay = combat.CloneForSimulation();
+
+                const auto start = clock::now();
+                {
+                    ScopedThreadRandomStream random_stream(seeds[idx]);
+                    AutoResolveCombat(replay);
+                }
+                const auto elapsed = clock::now() - start;
+
+                total += elapsed;
+                fastest = std::min(fastest, elapsed);
+                slowest = std::max(slowest, elapsed);
+                bouts = replay.bout;
+                std::vector<ConstCombatEventPtr> replay_events{replay.combat_events.begin(), replay.combat_events.end()};
+                events = CountCombatEvents(replay_events);
+            }
+
+            const auto to_ms = [](clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+            const double mean_ms = to_ms(total) / std::max(1, repetitions);
+            InfoLogger() << "Combat benchmark at system " << combat.system_id << " on turn " << combat.turn
+                         << ": " << num_objects << " objects, " << combat.empire_ids.size() << " empires, "
+                         << repetitions << " repetitions, " << bouts << " bouts, " << events << " events; "
+                         << "mean " << mean_ms << " ms (" << mean_ms / std::max(1, bouts) << " ms per bout), "
+                         << "min " << to_ms(fastest) << " ms, max " << to_ms(slowest) << " ms";
         }
     }
 
@@ -2511,11 +3199,9 @@ namespace {
             // destroy, in main universe, objects that were destroyed in combat,
             // and any associated objects that should now logically also be
             // destroyed
-            std::set<int> all_destroyed_object_ids;
-            for (int destroyed_object_id : combat_info.destroyed_object_ids) {
-                auto dest_obj_ids = universe.RecursiveDestroy(destroyed_object_id);
-                all_destroyed_object_ids.insert(dest_obj_ids.begin(), dest_obj_ids.end());
-            }
+            const std::set<int> all_destroyed_object_ids = universe.RecursiveDestroy(
+                std::vector<int>(combat_info.destroyed_object_ids.begin(),
+                                 combat_info.destroyed_object_ids.end()));
 
 
             // after recursive object destruction, fleets might have been
@@ -2545,13 +3231,18 @@ namespace {
         }
     }
 
-    /** Creates sitreps for all empires involved in a combat. */
-    void CreateCombatSitReps(const std::vector<CombatInfo>& combats) {
+    /** Creates sitreps for all empires involved in a combat.  Unless
+      * \a log_events is true, the combat logs record only who took part in
+      * the combats and how they ended. */
+    void CreateCombatSitReps(const std::vector<CombatInfo>& combats, bool log_events) {
         CombatLogManager& log_manager = GetCombatLogManager();
 
         for (const CombatInfo& combat_info : combats) {
             // add combat log entry
-            int log_id = log_manager.AddNewLog(CombatLog(combat_info));
+            CombatLog log(combat_info);
+            if (!log_events)
+                log.combat_events.clear();
+            int log_id = log_manager.AddNewLog(log);
 
             // basic "combat occured" sitreps
             const std::set<int>& empire_ids = combat_info.empire_ids;
@@ -2667,21 +3358,47 @@ namespace {
     }
 
     /** Records info in Empires about where they invaded. */
-    void UpdateEmpireInvasionInfo(const std::map<int, std::map<int, double>>& planet_empire_invasion_troops) {
-        for (const auto& planet_empire_troops : planet_empire_invasion_troops) {
-            int planet_id = planet_empire_troops.first;
-            auto planet = Objects().get<Planet>(planet_id);
-            if (!planet)
-                continue;
+    /** Troops of one empire at one planet, for resolving ground combat. */
+    struct PlanetEmpireTroops {
+        std::shared_ptr<Planet> planet;
+        int                     empire_id = ALL_EMPIRES;
+        double                  troops = 0.0;
+    };
+
+    /** Sorts \a planet_empire_troops by planet and empire, and combines the
+      * troops of each empire at each planet into a single entry.  Troops of
+      * the same empire at the same planet are summed in the order in which
+      * they appear in \a planet_empire_troops. */
+    void CombineTroops(std::vector<PlanetEmpireTroops>& planet_empire_troops) {
+        std::stable_sort(planet_empire_troops.begin(), planet_empire_troops.end(),
+                         [](const auto& lhs, const auto& rhs) {
+                             return std::pair(lhs.planet->ID(), lhs.empire_id) <
+                                    std::pair(rhs.planet->ID(), rhs.empire_id);
+                         });
+
+        auto out_it = planet_empire_troops.begin();
+        for (auto it = planet_empire_troops.begin(); it != planet_empire_troops.end(); ++it) {
+            if (out_it != planet_empire_troops.begin() &&
+                std::prev(out_it)->planet == it->planet && std::prev(out_it)->empire_id == it->empire_id)
+            {
+                std::prev(out_it)->troops += it->troops;
+            } else {
+                if (out_it != it)
+                    *out_it = std::move(*it);
+                ++out_it;
+            }
+        }
+        planet_empire_troops.erase(out_it, planet_empire_troops.end());
+    }
+
+    /** Records in empires the planets they invaded, given the combined
+      * \a planet_empire_invasion_troops. */
+    void UpdateEmpireInvasionInfo(const std::vector<PlanetEmpireTroops>& planet_empire_invasion_troops) {
+        for (const auto& [planet, empire_id, troops] : planet_empire_invasion_troops) {
             if (planet->SpeciesName().empty())
                 continue;
-
-            for (const auto& empire_troops : planet_empire_troops.second) {
-                Empire* invader_empire = GetEmpire(empire_troops.first);
-                if (!invader_empire)
-                    continue;
+            if (Empire* invader_empire = GetEmpire(empire_id))
                 invader_empire->RecordPlanetInvaded(*planet);
-            }
         }
     }
 
@@ -2756,7 +3473,12 @@ namespace {
         auto& objects = universe.Objects();
 
         // collect, for each planet, what ships have been ordered to colonize it
-        std::map<int, std::map<int, std::set<int>>> planet_empire_colonization_ship_ids; // map from planet ID to map from empire ID to set of ship IDs
+        struct ColonizationIntent {
+            std::shared_ptr<Planet> planet;
+            int                     empire_id = ALL_EMPIRES;
+            int                     ship_id = INVALID_OBJECT_ID;
+        };
+        std::vector<ColonizationIntent> colonization_intents;
 
         for (auto& ship : objects.all<Ship>()) {
             if (ship->Unowned())
@@ -2781,33 +3503,36 @@ namespace {
 
             planet->ResetIsAboutToBeColonized();
 
-            planet_empire_colonization_ship_ids[colonize_planet_id][owner_empire_id].insert(ship_id);
+            colonization_intents.push_back({std::move(planet), owner_empire_id, ship_id});
         }
 
+        // group intents by planet, so that conflicting intents are adjacent
+        std::sort(colonization_intents.begin(), colonization_intents.end(),
+                  [](const auto& lhs, const auto& rhs) {
+                      return std::tuple(lhs.planet->ID(), lhs.empire_id, lhs.ship_id) <
+                             std::tuple(rhs.planet->ID(), rhs.empire_id, rhs.ship_id);
+                  });
+
 
         std::vector<int> newly_colonize_planet_ids;
 
         // execute colonization except when:
         // 1) an enemy empire has armed aggressive ships in the system
         // 2) multiple empires try to colonize a planet on the same turn
-        for (auto& planet_colonization : planet_empire_colonization_ship_ids) {
+        for (auto run_begin = colonization_intents.begin(); run_begin != colonization_intents.end();) {
+            auto run_end = std::find_if(run_begin, colonization_intents.end(),
+                                        [&planet = run_begin->planet](const auto& intent) { return intent.planet != planet; });
+            const auto first_intent = *run_begin;
             // can't colonize if multiple empires attempting to do so on same turn
-            auto& empires_ships_colonizing = planet_colonization.second;
-            if (empires_ships_colonizing.size() != 1)
+            const bool multiple_empires = std::prev(run_end)->empire_id != first_intent.empire_id;
+            run_begin = run_end;
+            if (multiple_empires)
                 continue;
-            int colonizing_empire_id = empires_ships_colonizing.begin()->first;
+            int colonizing_empire_id = first_intent.empire_id;
+            int colonizing_ship_id = first_intent.ship_id;  // lowest id of the empire's ships ordered to colonize
 
-            const auto& empire_ships_colonizing = empires_ships_colonizing.begin()->second;
-            if (empire_ships_colonizing.empty())
-                continue;
-            int colonizing_ship_id = *empire_ships_colonizing.begin();
-
-            int planet_id = planet_colonization.first;
-            auto planet = objects.get<Planet>(planet_id);
-            if (!planet) {
-                ErrorLogger() << "HandleColonization couldn't get planet with id " << planet_id;
-                continue;
-            }
+            const auto& planet = first_intent.planet;
+            int planet_id = planet->ID();
             int system_id = planet->SystemID();
             auto system = objects.get<System>(system_id);
             if (!system) {
@@ -2866,33 +3591,32 @@ namespace {
         }
     }
 
-    /** Given initial set of ground forces on planet, determine ground forces on
-      * planet after a turn of ground combat. */
-    void ResolveGroundCombat(std::map<int, double>& empires_troops) {
+    /** Given initial set of ground forces on planet, by empire id in increasing
+      * order, determine ground forces on planet after a turn of ground combat. */
+    void ResolveGroundCombat(std::vector<std::pair<int, double>>& empires_troops) {
         if (empires_troops.empty() || empires_troops.size() == 1)
             return;
 
-        std::multimap<double, int> inverted_empires_troops;
-        for (const auto& entry : empires_troops)
-            inverted_empires_troops.insert({entry.second, entry.first});
-
         // everyone but victor loses all troops.  victor's troops remaining are
         // what the victor started with minus what the second-largest troop
-        // amount was
-        auto victor_it = inverted_empires_troops.rbegin();
-        auto next_it = victor_it;
-        ++next_it;
-        int victor_id = victor_it->second;
-        double victor_troops = victor_it->first - next_it->first;
+        // amount was.  ties are won by the empire with the highest id
+        auto victor_it = empires_troops.begin();
+        for (auto it = empires_troops.begin(); it != empires_troops.end(); ++it)
+            if (it->second >= victor_it->second)
+                victor_it = it;
+        double next_troops = std::numeric_limits<double>::lowest();
+        for (auto it = empires_troops.begin(); it != empires_troops.end(); ++it)
+            if (it != victor_it)
+                next_troops = std::max(next_troops, it->second);
 
-        empires_troops.clear();
-        empires_troops[victor_id] = victor_troops;
+        const std::pair<int, double> victor{victor_it->first, victor_it->second - next_troops};
+        empires_troops.assign(1, victor);
     }
 
     /** Determines which ships ordered to invade planets, does invasion and
       * ground combat resolution */
     void HandleInvasion() {
-        std::map<int, std::map<int, double>> planet_empire_troops;  // map from planet ID to map from empire ID to pair consisting of set of ship IDs and amount of troops empires have at planet
+        std::vector<PlanetEmpireTroops> planet_empire_troops;
         std::vector<std::shared_ptr<Ship>> invade_ships;
 
         // collect ships that are invading and the troops they carry
@@ -2915,13 +3639,13 @@ namespace {
             if (ship->SystemID() == INVALID_OBJECT_ID)
                 continue;
 
-            // how many troops are invading?
-            planet_empire_troops[ship->OrderedInvadePlanet()][ship->Owner()] += ship->TroopCapacity();
-
             DebugLogger() << "HandleInvasion has accounted for "<< ship->TroopCapacity()
                           << " troops to invade " << planet->Name()
                           << " and is destroying ship " << ship->ID()
                           << " named " << ship->Name();
+
+            // how many troops are invading?
+            planet_empire_troops.push_back({std::move(planet), ship->Owner(), ship->TroopCapacity()});
         }
 
         // delete ships that invaded something
@@ -2944,6 +3668,7 @@ namespace {
         }
 
         // store invasion info in empires
+        CombineTroops(planet_empire_troops);
         UpdateEmpireInvasionInfo(planet_empire_troops);
 
         // check each planet for other troops, such as due to empire troops, native troops, or rebel troops
@@ -2954,25 +3679,32 @@ namespace {
             }
             if (planet->GetMeter(MeterType::METER_TROOPS)->Initial() > 0.0f) {
                 // empires may have garrisons on planets
-                planet_empire_troops[planet->ID()][planet->Owner()] += planet->GetMeter(MeterType::METER_TROOPS)->Initial() + 0.0001;    // small bonus to ensure ties are won by initial owner
+                planet_empire_troops.push_back({planet, planet->Owner(), planet->GetMeter(MeterType::METER_TROOPS)->Initial() + 0.0001});    // small bonus to ensure ties are won by initial owner
             }
             if (!planet->Unowned() && planet->GetMeter(MeterType::METER_REBEL_TROOPS)->Initial() > 0.0f) {
                 // rebels may be present on empire-owned planets
-                planet_empire_troops[planet->ID()][ALL_EMPIRES] += planet->GetMeter(MeterType::METER_REBEL_TROOPS)->Initial();
+                planet_empire_troops.push_back({planet, ALL_EMPIRES, planet->GetMeter(MeterType::METER_REBEL_TROOPS)->Initial()});
             }
         }
+        CombineTroops(planet_empire_troops);
+
+        // process each planet's ground combats.  the troops at each planet are
+        // a run of consecutive entries, in increasing order of empire id
+        std::vector<std::pair<int, double>> empires_troops;
+        for (auto run_begin = planet_empire_troops.begin(); run_begin != planet_empire_troops.end();) {
+            auto run_end = std::find_if(run_begin, planet_empire_troops.end(),
+                                        [&planet = run_begin->planet](const auto& entry) { return entry.planet != planet; });
+            auto planet = run_begin->planet;
+            const int planet_id = planet->ID();
+            empires_troops.clear();
+            for (auto it = run_begin; it != run_end; ++it)
+                empires_troops.emplace_back(it->empire_id, it->troops);
+            run_begin = run_end;
 
-        // process each planet's ground combats
-        for (auto& planet_combat : planet_empire_troops) {
-            int planet_id = planet_combat.first;
-            auto planet = Objects().get<Planet>(planet_id);
             std::set<int> all_involved_empires;
             int planet_initial_owner_id = planet->Owner();
 
-            auto& empires_troops = planet_combat.second;
-            if (empires_troops.empty())
-                continue;
-            else if (empires_troops.size() == 1) {
+            if (empires_troops.size() == 1) {
                 int empire_with_troops_id = empires_troops.begin()->first;
                 if (planet->Unowned() && empire_with_troops_id == ALL_EMPIRES)
                     continue;
@@ -3000,7 +3732,6 @@ namespace {
 
                 ResolveGroundCombat(empires_troops);
             }
-
             for (int empire_id : all_involved_empires) {
                 if (Empire* empire = GetEmpire(empire_id))
                     empire->AddSitRepEntry(CreateGroundCombatSitRep(planet_id, EnemyId(empire_id, all_involved_empires)));
@@ -3247,27 +3978,30 @@ namespace {
 
     /** Deletes empty fleets. */
     void CleanEmptyFleets() {
-        std::vector<std::shared_ptr<Fleet>> empty_fleets;
+        std::vector<int> empty_fleet_ids;
 
         for (auto& fleet : Objects().all<Fleet>()) {
             if (fleet->Empty())
-                empty_fleets.push_back(fleet);
+                empty_fleet_ids.push_back(fleet->ID());
         }
 
-        for (auto& fleet : empty_fleets) {
-            if (auto sys = Objects().get<System>(fleet->SystemID()))
-                sys->Remove(fleet->ID());
-
-            GetUniverse().RecursiveDestroy(fleet->ID());
-        }
+        // also removes the fleets from their systems
+        GetUniverse().RecursiveDestroy(empty_fleet_ids);
     }
 }
 
 void ServerApp::PreCombatProcessTurns() {
     ScopedTimer timer("ServerApp::PreCombatProcessTurns", true);
 
+    m_turn_processing_start = std::chrono::steady_clock::now();
+    m_turn_metrics = TurnMetrics{};
+    m_turn_metrics.orders_wait.swap(m_orders_wait);
+    PlanTurnWorkReductions();
+
     m_universe.ResetAllObjectMeters(false, true);   // revert current meter values to initial values prior to update after incrementing turn number during previous post-combat turn processing.
-    m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(Empires());
+    if (!m_order_independent_work_done)
+        m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(Empires());
+    m_order_independent_work_done = false;
 
     DebugLogger() << "ServerApp::ProcessTurns executing orders";
 
@@ -3278,7 +4012,49 @@ void ServerApp::PreCombatProcessTurns() {
     // determined by what orders set.
     CleanUpBombardmentStateInfo();
 
-    // execute orders
+    // record orders, so that the turn can be replayed with ReplayTurns
+    const auto& record_path = GetOptionsDB().Get<std::string>("server.turn.record.path");
+    if (!record_path.empty()) {
+        std::map<int, std::shared_ptr<OrderSet>> empire_orders;
+        for (const auto& [empire_id, save_game_data] : m_turn_sequence)
+            if (save_game_data && save_game_data->orders)
+                empire_orders.emplace(empire_id, save_game_data->orders);
+        WriteTurnOrders(FilenameToPath(record_path), m_current_turn, empire_orders);
+    }
+
+    // check the range of all empires' fleet move orders together, before any
+    // order changes the universe, which is the costly part of executing them
+    {
+        PhaseTimer orders_timer(m_turn_metrics.orders);
+        std::vector<const FleetMoveOrder*> move_orders;
+        for (const auto& [empire_id, save_game_data] : m_turn_sequence) {
+            if (!save_game_data || !save_game_data->orders)
+                continue;
+            for (const auto& [order_id, order] : *save_game_data->orders)
+                if (auto move_order = dynamic_cast<const FleetMoveOrder*>(order.get()))
+                    if (!move_order->Executed())
+                        move_orders.push_back(move_order);
+        }
+
+        const ScriptingContext context{m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager};
+        static constexpr std::size_t ORDERS_PER_TASK = 64;
+        TaskBatch range_batch("ServerApp::PreCombatProcessTurns fleet move ranges");
+        for (std::size_t first = 0; first < move_orders.size(); first += ORDERS_PER_TASK) {
+            range_batch.Post([&move_orders, &context, first]() {
+                const auto last = std::min(first + ORDERS_PER_TASK, move_orders.size());
+                for (auto idx = first; idx < last; ++idx)
+                    move_orders[idx]->CheckRange(context);
+            });
+        }
+        range_batch.Wait();
+    }
+
+    // execute orders.  this waits until all empires are ready, rather than
+    // applying orders as they arrive: until an empire is ready its orders may
+    // be replaced or rescinded, and most orders can't be undone.  orders that
+    // only change the issuing empire's queues still depend on other orders,
+    // such as production of a design created by a ShipDesignOrder, and are
+    // read by conditions like Enqueued, so they are applied in sequence too.
     for (const auto& empire_orders : m_turn_sequence) {
         auto& save_game_data = empire_orders.second;
         if (!save_game_data) {
@@ -3290,6 +4066,7 @@ void ServerApp::PreCombatProcessTurns() {
             continue;
         }
         DebugLogger() << "<<= Executing Orders for empire " << empire_orders.first << " =>>";
+        PhaseTimer orders_timer(m_turn_metrics.orders);
         save_game_data->orders->ApplyOrders();
     }
 
@@ -3308,10 +4085,20 @@ void ServerApp::PreCombatProcessTurns() {
     CleanEmptyFleets();
 
     // update production queues after order execution
-    for (auto& entry : Empires()) {
-        if (entry.second->Eliminated())
-            continue;   // skip eliminated empires
-        entry.second->UpdateProductionQueue();
+    static constexpr int REDUCED_PROJECTION_TURNS = 100;
+    static constexpr std::chrono::milliseconds REDUCED_PROJECTION_TIME{100};
+    {
+        PhaseTimer queues_timer(m_turn_metrics.queues);
+        const bool reduce_projection = m_turn_work_reductions.production_projection;
+        ForEachEmpireInParallel(m_empires, m_universe.Objects(), "PreCombatProcessTurns production queues",
+                                [reduce_projection](Empire& empire) {
+            if (reduce_projection)
+                empire.SetProductionProjectionLimits(REDUCED_PROJECTION_TURNS, REDUCED_PROJECTION_TIME);
+            else
+                empire.SetProductionProjectionLimits(ProductionQueue::DEFAULT_PROJECTION_TURNS,
+                                                     ProductionQueue::DEFAULT_PROJECTION_TIME);
+            empire.UpdateProductionQueue();
+        });
     }
 
     // player notifications
@@ -3337,36 +4124,34 @@ void ServerApp::PreCombatProcessTurns() {
     ScriptingContext context{m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager};
 
     // Update system-obstruction after orders, colonization, invasion, gifting, scrapping
-    for (auto& entry : m_empires) {
-        auto& empire = entry.second;
-        if (empire->Eliminated())
-            continue;
-        empire->UpdateSupplyUnobstructedSystems(context, true);
+    {
+        PhaseTimer supply_timer(m_turn_metrics.supply);
+        const SupplyAffectingFleets supply_affecting_fleets(context.ContextObjects());
+        for (auto& entry : m_empires) {
+            auto& empire = entry.second;
+            if (empire->Eliminated())
+                continue;
+            empire->UpdateSupplyUnobstructedSystems(context, supply_affecting_fleets, true);
+        }
     }
 
 
     // fleet movement
-    auto fleets = m_universe.Objects().all<Fleet>();
+    auto all_fleets = m_universe.Objects().all<Fleet>();
+    std::vector<std::shared_ptr<Fleet>> fleets(all_fleets.begin(), all_fleets.end());
     for (auto& fleet : fleets) {
         if (fleet)
             fleet->ClearArrivalFlag();
     }
-    // first move unowned fleets, or an empire fleet landing on them could wrongly
-    // blockade them before they move
-    for (auto& fleet : fleets) {
-        if (fleet && fleet->Unowned())
-            fleet->MovementPhase(context);
-    }
-    for (auto& fleet : fleets) {
-        // save for possible SitRep generation after moving...
-        if (fleet && !fleet->Unowned())
-            fleet->MovementPhase(context);
-    }
+    Fleet::MovementPhase(fleets, context);
 
     // post-movement visibility update
-    m_universe.UpdateEmpireObjectVisibilities(m_empires);
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
-    m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireObjectVisibilities(m_empires);
+        m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+        m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+    }
 
     // SitReps for fleets having arrived at destinations
     for (auto& fleet : fleets) {
@@ -3387,6 +4172,7 @@ void ServerApp::PreCombatProcessTurns() {
 
     // send partial turn updates to all players after orders and movement
     // exclude those without empire and who are not Observer or Moderator
+    const bool use_delta = GetOptionsDB().Get<bool>("network.server.turn-update.delta");
     for (auto player_it = m_networking.established_begin();
          player_it != m_networking.established_end(); ++player_it)
     {
@@ -3398,14 +4184,16 @@ void ServerApp::PreCombatProcessTurns() {
             player->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER)
         {
             bool use_binary_serialization = player->IsBinarySerializationUsed();
-            player->SendMessage(TurnPartialUpdateMessage(PlayerEmpireID(player->PlayerID()),
-                                                         m_universe, use_binary_serialization));
+            player->SendMessage(TurnPartialUpdateMessage(PlayerEmpireID(player->PlayerID()), m_universe,
+                                                         player->TurnUpdateDeltaBase(), use_delta,
+                                                         use_binary_serialization));
         }
     }
 }
 
 void ServerApp::ProcessCombats() {
     ScopedTimer timer("ServerApp::ProcessCombats", true);
+    PhaseTimer combat_timer(m_turn_metrics.combat);
     DebugLogger() << "ServerApp::ProcessCombats";
     m_networking.SendMessageAll(TurnProgressMessage(Message::TurnProgressPhase::COMBAT));
 
@@ -3415,9 +4203,30 @@ void ServerApp::ProcessCombats() {
     // collect data about locations where combat is to occur
     AssembleSystemCombatInfo(combats, m_universe, m_empires, m_galaxy_setup_data, m_species_manager, m_supply_manager);
 
+    // each combat draws random numbers from its own stream, so that results
+    // don't depend on the order in which combats are run in parallel.  when
+    // reseeding, the streams depend only on the system and turn
+    const bool reseed = GetGameRules().Get<bool>("RULE_RESEED_PRNG_SERVER");
+    const std::uint64_t random_base_seed = reseed ?
+        static_cast<std::uint64_t>(std::hash<std::string>{}(m_galaxy_setup_data.GetSeed())) :
+        SplitRandomSeed();
+    std::vector<std::uint64_t> combat_seeds;
+    combat_seeds.reserve(combats.size());
+    for (const CombatInfo& combat_info : combats) {
+        combat_seeds.push_back(RandomStreamSeed(random_base_seed, combat_info.turn, RandomStreamPhase::COMBAT,
+                                                static_cast<std::uint64_t>(combat_info.system_id)));
+    }
+
+    if (const int repetitions = GetOptionsDB().Get<int>("combat.benchmark.repetitions"); repetitions > 0)
+        BenchmarkCombats(combats, combat_seeds, repetitions);
+
     // loop through assembled combat infos, handling each combat to update the
-    // various systems' CombatInfo structs
-    for (CombatInfo& combat_info : combats) {
+    // various systems' CombatInfo structs.  combats in different systems
+    // involve different objects, so can be resolved in parallel
+    std::vector<std::exception_ptr> combat_exceptions(combats.size());
+    TaskBatch combat_batch("ServerApp::ProcessCombats");
+    for (std::size_t idx = 0; idx < combats.size(); ++idx) {
+        CombatInfo& combat_info = combats[idx];
         auto combat_system = combat_info.GetSystem();
         if (combat_system)
             combat_system->SetLastTurnBattleHere(CurrentTurn());
@@ -3425,8 +4234,20 @@ void ServerApp::ProcessCombats() {
         DebugLogger(combat) << "Processing combat at " << (combat_system ? combat_system->Name() : "(No System id: " + std::to_string(combat_info.system_id) + ")");
         TraceLogger(combat) << combat_info.objects->Dump();
 
-        AutoResolveCombat(combat_info);
+        combat_batch.Post([&combat_info, seed{combat_seeds[idx]}, &exception = combat_exceptions[idx]]() {
+            try {
+                ScopedThreadRandomStream random_stream(seed);
+                AutoResolveCombat(combat_info);
+            } catch (...) {
+                exception = std::current_exception();
+            }
+        });
     }
+    combat_batch.Wait();
+    combat_batch.LogTimings(std::chrono::milliseconds(10));
+    for (auto& exception : combat_exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
 
     BackProjectSystemCombatInfoObjectMeters(combats);
 
@@ -3437,9 +4258,53 @@ void ServerApp::ProcessCombats() {
     m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
     // update stale object info based on any mid- combat glimpses
     // before visibility is totally recalculated in the post combat processing
-    m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+    if (!m_turn_work_reductions.mid_combat_stale_knowledge)
+        m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+
+    CreateCombatSitReps(combats, !m_turn_work_reductions.combat_log_events);
+
+    // logs of long past combats are rarely viewed, so needn't be kept in memory
+    GetCombatLogManager().SpillOldLogs(CurrentTurn());
+}
+
+void ServerApp::PlanTurnWorkReductions() {
+    m_turn_work_reductions = TurnWorkReductions{};
+
+    const double budget = GetOptionsDB().Get<double>("network.server.turn-processing.budget");
+    if (budget <= 0.0 || m_last_turn_object_count == 0)
+        return;
+
+    // turns mostly take longer as the universe grows
+    const double growth = static_cast<double>(m_universe.Objects().size()) / m_last_turn_object_count;
+    const double projected = Seconds(m_last_turn_processing) * std::max(1.0, growth);
+    if (projected <= budget)
+        return;
 
-    CreateCombatSitReps(combats);
+    // reduce more work the more the budget is projected to be exceeded
+    const double overrun = projected / budget;
+    m_turn_work_reductions.production_projection = true;
+    m_turn_work_reductions.combat_log_events = overrun > 1.25;
+    m_turn_work_reductions.mid_combat_stale_knowledge = overrun > 1.5;
+
+    std::string reductions = "shorter production projections";
+    if (m_turn_work_reductions.combat_log_events)
+        reductions += ", combat logs without events";
+    if (m_turn_work_reductions.mid_combat_stale_knowledge)
+        reductions += ", no mid-combat stale knowledge updates";
+    InfoLogger() << "Turn " << m_current_turn << " is projected to take " << projected
+                 << " s, more than the budget of " << budget << " s; reducing work: " << reductions;
+}
+
+void ServerApp::PrecomputeOrderIndependentTurnWork() {
+    if (m_order_independent_work_done)
+        return;
+    ScopedTimer timer("ServerApp::PrecomputeOrderIndependentTurnWork");
+
+    // orders are executed after these graphs are updated, so the graphs only
+    // depend on the empires' latest known objects, which orders don't change
+    m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(Empires());
+
+    m_order_independent_work_done = true;
 }
 
 void ServerApp::UpdateMonsterTravelRestrictions() {
@@ -3491,8 +4356,11 @@ void ServerApp::PostCombatProcessTurns() {
     ScopedTimer timer("ServerApp::PostCombatProcessTurns", true);
 
     // post-combat visibility update
-    m_universe.UpdateEmpireObjectVisibilities(Empires());
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireObjectVisibilities(Empires());
+        m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    }
 
 
     // check for loss of empire capitals
@@ -3523,11 +4391,17 @@ void ServerApp::PostCombatProcessTurns() {
         static boost::hash<std::string> pcpt_string_hash;
         Seed(static_cast<unsigned int>(CurrentTurn()) + pcpt_string_hash(m_galaxy_setup_data.seed));
     }
-    m_universe.ApplyAllEffectsAndUpdateMeters(context, false);
+    {
+        PhaseTimer effects_timer(m_turn_metrics.effects);
+        m_universe.ApplyAllEffectsAndUpdateMeters(context, false);
+    }
 
-    // regenerate system connectivity graph after executing effects, which may
-    // have added or removed starlanes.
-    m_universe.InitializeSystemGraph(m_empires, m_universe.Objects());
+    // regenerate system connectivity graph after executing effects, if they
+    // added or removed starlanes or systems.
+    if (m_universe.SystemGraphOutOfDate())
+        m_universe.InitializeSystemGraph(m_empires, m_universe.Objects());
+    else
+        DebugLogger() << "ServerApp::PostCombatProcessTurns starlanes unchanged; reusing system graph";
     m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(m_empires);
 
     TraceLogger(effects) << "!!!!!!! AFTER TURN PROCESSING EFFECTS APPLICATION";
@@ -3537,10 +4411,16 @@ void ServerApp::PostCombatProcessTurns() {
 
     // now that we've had combat and applied Effects, update visibilities again, prior
     //  to updating system obstructions below.
-    m_universe.UpdateEmpireObjectVisibilities(m_empires);
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireObjectVisibilities(m_empires);
+        m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    }
 
-    UpdateEmpireSupply(context, m_empires, m_supply_manager);
+    {
+        PhaseTimer supply_timer(m_turn_metrics.supply);
+        UpdateEmpireSupply(context, m_empires, m_supply_manager);
+    }
 
     // Update fleet travel restrictions (monsters and empire fleets)
     UpdateMonsterTravelRestrictions();
@@ -3560,15 +4440,24 @@ void ServerApp::PostCombatProcessTurns() {
     // Consume distributed resources to planets and on queues, create new
     // objects for completed production and give techs to empires that have
     // researched them
-    for ([[maybe_unused]] auto& [empire_id, empire] : m_empires) {
-        (void)empire_id;    // unused variable warning
-        if (empire->Eliminated())
-            continue;   // skip eliminated empires
-
-        for (const auto& tech : empire->CheckResearchProgress())
-            empire->AddNewlyResearchedTechToGrantAtStartOfNextTurn(tech);
-        empire->CheckProductionProgress(context);
-        empire->CheckInfluenceProgress();
+    {
+        PhaseTimer queues_timer(m_turn_metrics.queues);
+
+        // research and influence progress only change the empire itself
+        ForEachEmpireInParallel(m_empires, m_universe.Objects(), "PostCombatProcessTurns queue progress",
+                                [](Empire& empire) {
+            for (const auto& tech : empire.CheckResearchProgress())
+                empire.AddNewlyResearchedTechToGrantAtStartOfNextTurn(tech);
+            empire.CheckInfluenceProgress();
+        });
+
+        // completed production creates objects, so is done one empire at a time
+        for ([[maybe_unused]] auto& [empire_id, empire] : m_empires) {
+            (void)empire_id;    // unused variable warning
+            if (empire->Eliminated())
+                continue;   // skip eliminated empires
+            empire->CheckProductionProgress(context);
+        }
     }
 
     TraceLogger(effects) << "!!!!!!! AFTER CHECKING QUEUE AND RESOURCE PROGRESS";
@@ -3581,15 +4470,37 @@ void ServerApp::PostCombatProcessTurns() {
     // UniverseObjects will have effects applied to them this turn, allowing
     // (for example) ships to have max fuel meters greater than 0 on the turn
     // they are created.
-    m_universe.ApplyMeterEffectsAndUpdateMeters(context, false);
+    {
+        PhaseTimer effects_timer(m_turn_metrics.effects);
+        m_universe.ApplyMeterEffectsAndUpdateMeters(context, false);
+    }
 
     TraceLogger(effects) << "!!!!!!! AFTER UPDATING METERS OF ALL OBJECTS";
     TraceLogger(effects) << m_universe.Objects().Dump();
 
-    // Planet depopulation, some in-C++ meter modifications
+    // Planet depopulation, some in-C++ meter modifications.  Population growth
+    // itself is done by content effects; what is left here may add sitreps to
+    // empires, so is done one object at a time.
+    std::vector<UniverseObject*> objects;
+    objects.reserve(m_universe.Objects().size());
     for (const auto& obj : m_universe.Objects().all()) {
         obj->PopGrowthProductionResearchPhase();
-        obj->ClampMeters();  // ensures no meters are over MAX.  probably redundant with ClampMeters() in Universe::ApplyMeterEffectsAndUpdateMeters()
+        objects.push_back(obj.get());
+    }
+
+    // ensures no meters are over MAX.  probably redundant with ClampMeters() in
+    // Universe::ApplyMeterEffectsAndUpdateMeters().  Clamping only changes the
+    // object's own meters, so is done for many objects at once.
+    {
+        constexpr std::size_t OBJECTS_PER_TASK = 256;
+        TaskBatch batch("ServerApp::PostCombatProcessTurns ClampMeters");
+        for (std::size_t first = 0; first < objects.size(); first += OBJECTS_PER_TASK) {
+            batch.Post([&objects, first, last{std::min(objects.size(), first + OBJECTS_PER_TASK)}]() {
+                for (std::size_t idx = first; idx < last; ++idx)
+                    objects[idx]->ClampMeters();
+            });
+        }
+        batch.Wait();
     }
 
     TraceLogger(effects) << "!!!!!!!!!!!!!!!!!!!!!!AFTER GROWTH AND CLAMPING";
@@ -3616,12 +4527,15 @@ void ServerApp::PostCombatProcessTurns() {
     // visibility update removes an empires ability to detect an object, the
     // empire will still know the latest state on the
     // turn when the empire did have detection ability for the object
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
 
-    // post-production and meter-effects visibility update
-    m_universe.UpdateEmpireObjectVisibilities(m_empires);
+        // post-production and meter-effects visibility update
+        m_universe.UpdateEmpireObjectVisibilities(m_empires);
 
-    m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+        m_universe.UpdateEmpireStaleObjectKnowledge(m_empires);
+    }
 
     // update empire-visibility filtered graphs after visiblity update
     m_universe.UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(Empires());
@@ -3639,7 +4553,10 @@ void ServerApp::PostCombatProcessTurns() {
 
 
     // new turn visibility update
-    m_universe.UpdateEmpireObjectVisibilities(m_empires);
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireObjectVisibilities(m_empires);
+    }
 
 
     DebugLogger() << "ServerApp::PostCombatProcessTurns applying Newly Added Techs";
@@ -3656,17 +4573,26 @@ void ServerApp::PostCombatProcessTurns() {
 
 
     // redo meter estimates to hopefully be consistent with what happens in clients
-    m_universe.UpdateMeterEstimates(context, false);
+    {
+        PhaseTimer effects_timer(m_turn_metrics.effects);
+        m_universe.UpdateMeterEstimates(context, false);
+    }
 
     TraceLogger(effects) << "ServerApp::PostCombatProcessTurns After Final Meter Estimate Update: ";
     TraceLogger(effects) << m_universe.Objects().Dump();
 
 
     // Re-determine supply distribution and exchanging and resource pools for empires
-    UpdateEmpireSupply(context, m_empires, m_supply_manager, true);
+    {
+        PhaseTimer supply_timer(m_turn_metrics.supply);
+        UpdateEmpireSupply(context, m_empires, m_supply_manager, true);
+    }
 
     // copy latest visible gamestate to each empire's known object state
-    m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    {
+        PhaseTimer visibility_timer(m_turn_metrics.visibility);
+        m_universe.UpdateEmpireLatestKnownObjectsAndVisibilityTurns();
+    }
 
 
     // misc. other updates and records
@@ -3700,25 +4626,89 @@ void ServerApp::PostCombatProcessTurns() {
     DebugLogger() << "ServerApp::PostCombatProcessTurns Sending turn updates to players";
     // send new-turn updates to all players
     // exclude those without empire and who are not Observer or Moderator
+    const bool allow_delta = GetOptionsDB().Get<bool>("network.server.turn-update.delta");
+    auto make_turn_update = [this, &players, allow_delta](const PlayerConnectionPtr& player, int empire_id) {
+        bool use_binary_serialization = player->IsBinarySerializationUsed();
+        auto& delta_base = player->TurnUpdateDeltaBase();
+        bool use_delta = allow_delta && delta_base.acknowledged;
+        return TurnUpdateMessage(empire_id, m_current_turn,
+                                 m_empires,                          m_universe,
+                                 GetSpeciesManager(),                GetCombatLogManager(),
+                                 GetSupplyManager(),                 players,
+                                 delta_base,                         use_delta,
+                                 use_binary_serialization);
+    };
+
+    // updates for players with an empire only read that empire's share of the
+    // gamestate, so are encoded in parallel, each task setting its own thread's
+    // encoding empire. observers and moderators are sent the full gamestate,
+    // which overlaps every empire's known objects, so are encoded afterwards.
+    std::vector<PlayerConnectionPtr> all_empires_players;
+    TaskBatch turn_update_batch("TurnUpdates");
     for (auto player_it = m_networking.established_begin();
          player_it != m_networking.established_end(); ++player_it)
     {
         PlayerConnectionPtr player = *player_it;
         int empire_id = PlayerEmpireID(player->PlayerID());
         auto empire = m_empires.GetEmpire(empire_id);
-        if (empire ||
-            player->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_MODERATOR ||
-            player->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER)
+        if (empire) {
+            // each task times into its own element, inserted before the tasks run
+            auto& encoding_time = m_turn_metrics.turn_updates[empire_id];
+            turn_update_batch.Post([&make_turn_update, &encoding_time, player, empire_id]() {
+                try {
+                    PhaseTimer encoding_timer(encoding_time);
+                    player->SendMessage(make_turn_update(player, empire_id));
+                } catch (const std::exception& e) {
+                    ErrorLogger() << "ServerApp::PostCombatProcessTurns failed to encode turn update for empire "
+                                  << empire_id << ": " << e.what();
+                }
+            }, player->PlayerName());
+
+        } else if (player->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_MODERATOR ||
+                   player->GetClientType() == Networking::ClientType::CLIENT_TYPE_HUMAN_OBSERVER)
         {
-            bool use_binary_serialization = player->IsBinarySerializationUsed();
-            player->SendMessage(TurnUpdateMessage(empire_id, m_current_turn,
-                                                  m_empires,                          m_universe,
-                                                  GetSpeciesManager(),                GetCombatLogManager(),
-                                                  GetSupplyManager(),                 players,
-                                                  use_binary_serialization));
+            all_empires_players.push_back(std::move(player));
+        }
+    }
+    turn_update_batch.Wait();
+    turn_update_batch.LogTimings();
+
+    // observers and moderators that use the same serialization format and
+    // whose delta bases record the same previous update would be sent
+    // identical updates, so each such group shares one encoded message
+    std::vector<std::vector<PlayerConnectionPtr>> shared_update_groups;
+    for (auto& player : all_empires_players) {
+        const bool binary = player->IsBinarySerializationUsed();
+        const auto& delta_base = player->TurnUpdateDeltaBase();
+        const bool use_delta = allow_delta && delta_base.acknowledged;
+        auto group_it = std::find_if(shared_update_groups.begin(), shared_update_groups.end(),
+                                     [&](const auto& group) {
+            const auto& other = group.front();
+            const auto& other_base = other->TurnUpdateDeltaBase();
+            return other->IsBinarySerializationUsed() == binary &&
+                (allow_delta && other_base.acknowledged) == use_delta &&
+                (!use_delta || (other_base.turn == delta_base.turn &&
+                                other_base.object_hashes == delta_base.object_hashes));
+        });
+        if (group_it == shared_update_groups.end())
+            shared_update_groups.push_back({std::move(player)});
+        else
+            group_it->push_back(std::move(player));
+    }
+
+    for (auto& group : shared_update_groups) {
+        const auto& first_player = group.front();
+        const auto message = make_turn_update(first_player, PlayerEmpireID(first_player->PlayerID()));
+        for (auto& player : group) {
+            if (player != first_player)
+                player->TurnUpdateDeltaBase() = first_player->TurnUpdateDeltaBase();
+            player->SendMessage(message);
         }
     }
+    m_turn_updates_sent = std::chrono::steady_clock::now();
     m_turn_expired = false;
+    m_last_turn_processing = m_turn_updates_sent - m_turn_processing_start;
+    m_last_turn_object_count = m_universe.Objects().size();
     DebugLogger() << "ServerApp::PostCombatProcessTurns done";
 }
 
@@ -1,9 +1,15 @@
 #ifndef _ServerApp_h_
 #define _ServerApp_h_
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include <boost/circular_buffer.hpp>
+#include "SaveLoad.h"
 #include "ServerFramework.h"
 #include "ServerNetworking.h"
 #include "../Empire/EmpireManager.h"
@@ -17,6 +23,8 @@
 
 class OrderSet;
 struct GalaxySetupData;
+struct SaveGameSnapshot;
+struct TurnDigest;
 struct SaveGameUIData;
 struct ServerFSM;
 
@@ -124,6 +132,18 @@ public:
       * fleet movements, and updates visibility before combats are handled. */
     void    PreCombatProcessTurns();
 
+    /** Does the parts of processing the next turn that don't depend on the
+      * orders issued for it, such as updating the empires' visibility-filtered
+      * system graphs and their distance indices, while the players are
+      * deciding those orders.  PreCombatProcessTurns reuses the results
+      * unless InvalidateOrderIndependentTurnWork was called since. */
+    void    PrecomputeOrderIndependentTurnWork();
+
+    /** Discards the results of PrecomputeOrderIndependentTurnWork.  Anything
+      * other than orders that changes the gamestate while waiting for orders
+      * must call this. */
+    void    InvalidateOrderIndependentTurnWork() noexcept { m_order_independent_work_done = false; }
+
     /** Determines which combats will occur, handles running the combats and
       * updating the universe after the results are available. */
     void    ProcessCombats();
@@ -197,6 +217,58 @@ public:
     /** Sets turn to be expired. Server doesn't wait for human player turns. */
     void ExpireTurn();
 
+    /** Writes \a snapshot, as made by SnapshotGame, to its savefile on a
+      * background thread, once any earlier background save has finished.
+      * Players are informed when the save is complete. */
+    void WriteGameSnapshotInBackground(std::shared_ptr<SaveGameSnapshot> snapshot,
+                                       std::string save_filename);
+
+    /** Blocks until any background save has finished. */
+    void WaitForBackgroundSave();
+
+    /** If content reloading is enabled, starts reparsing in the background
+      * the content categories with script files that have changed since they
+      * were last parsed. */
+    void StartReloadingChangedContent();
+
+    /** Replaces the content of categories being reparsed since the last
+      * StartReloadingChangedContent() with the reparsed content, waiting for
+      * it to be parsed if necessary.  Content that failed to parse is kept. */
+    void InstallReloadedContent();
+
+    /** Replaces the file at \a path with the metrics of the last processed
+      * turn, the traffic to each player, the empires whose orders for the
+      * current turn are outstanding and the size of the gamestate, in the
+      * Prometheus text exposition format. */
+    void WriteMetrics(const std::string& path) const;
+
+    /** Returns the digest of the current game state, for comparing the
+      * results of processing turns. */
+    TurnDigest CurrentTurnDigest() const;
+
+    /** Returns a report of the approximate memory used by each part of the
+      * game state, largest first. */
+    std::string MemoryReport() const;
+
+    /** Returns a report of the time taken by each phase of generating the
+      * universe of the current game, in order. */
+    std::string UniverseGenerationReport() const;
+
+    /** Writes NativeValueRefTable.cpp to the user data directory, with native
+      * code for up to \a max_count of the SetMeter values that have been
+      * evaluated for the most targets, to replace universe/NativeValueRefTable.cpp
+      * in a build.  Returns a report of what was written. */
+    std::string WriteNativeEffects(std::size_t max_count) const;
+
+    /** Loads the savefile \a save_file and then processes up to \a num_turns
+      * turns, or all recorded turns if \a num_turns is 0, with the orders
+      * recorded in directory \a record_path by a game run with the
+      * server.turn.record.path option.  The digest of the result of each turn
+      * is compared with the one recorded, and written to the replay digests
+      * file in \a record_path.  Returns the number of turns whose digests
+      * differ or that could not be replayed. */
+    int ReplayTurns(const std::string& save_file, const std::string& record_path, int num_turns);
+
     void UpdateSavePreviews(const Message& msg, PlayerConnectionPtr player_connection);
 
     /** Send the requested combat logs to the client.*/
@@ -248,6 +320,10 @@ private:
       * scripters to customize universe generation. */
     void    GenerateUniverse(std::map<int, PlayerSetupData>& player_setup_data);
 
+    /** Records the time since the previous phase of universe generation
+      * ended, or since it started, as the time taken by \a phase. */
+    void    EndUniverseGenerationPhase(std::string phase);
+
     /** Calls Python turn events script.
       * Supposed to be called every turn so it can be used by content scripters to
       * implement user customizable turn events. */
@@ -269,6 +345,13 @@ private:
       * cleanly shut down this server process. */
     void    HandleShutdownMessage(const Message& msg, PlayerConnectionPtr player_connection);
 
+    /** Logs the order generation timings reported by an AI player. */
+    void    HandleAITurnTimings(const Message& msg, PlayerConnectionPtr player_connection);
+
+    /** Runs the debugging command in a DEBUG message from the host or a
+      * moderator, and sends its output back to them as a chat message. */
+    void    HandleDebugCommand(const Message& msg, PlayerConnectionPtr player_connection);
+
     /** Checks validity of logger config message and then update logger and loggers of all AIs. */
     void    HandleLoggerConfig(const Message& msg, PlayerConnectionPtr player_connection);
 
@@ -301,6 +384,12 @@ private:
       * an empire is eliminated from the game */
     void    RemoveEmpireTurn(int empire_id);
 
+    /** Decides which optional work processing the current turn leaves out,
+      * if the "network.server.turn-processing.budget" option is set and
+      * processing the previous turn, scaled by the growth of the universe
+      * since, took longer than that budget. */
+    void    PlanTurnWorkReductions();
+
     boost::asio::io_context m_io_context;
     boost::asio::signal_set m_signals;
 
@@ -318,6 +407,43 @@ private:
     bool                    m_single_player_game = false;       ///< true when the game being played is single-player
     GalaxySetupData         m_galaxy_setup_data;                ///< stored setup data for the game currently being played
     boost::circular_buffer<ChatHistoryEntity> m_chat_history;   ///< Stored last chat messages.
+    std::future<void>       m_background_save;                  ///< save being written by WriteGameSnapshotInBackground, if any
+    SaveGameJournal         m_save_game_journal;                ///< journal that incremental autosaves are appended to
+    std::map<std::string, std::size_t>  m_content_fingerprints;    ///< fingerprints of the script files last parsed, by reloadable content category
+    std::vector<std::function<void ()>> m_content_reloads;         ///< install the content being reparsed by StartReloadingChangedContent
+
+    /** Times of the phases of processing a turn, for WriteMetrics. */
+    struct TurnMetrics {
+        using Duration = std::chrono::steady_clock::duration;
+
+        Duration                orders{0};          ///< executing orders
+        Duration                combat{0};
+        Duration                effects{0};         ///< applying effects and updating meters
+        Duration                visibility{0};      ///< updating empire visibilities and known objects
+        Duration                supply{0};
+        Duration                queues{0};          ///< updating and progressing research, production and influence queues
+        std::map<int, Duration> turn_updates;       ///< encoding the turn update of each empire
+        std::map<int, Duration> orders_wait;        ///< from sending the previous turn update to receiving each empire's orders
+        TurnEventTimings        turn_events;        ///< calling each Python turn event function
+    };
+    TurnMetrics                             m_turn_metrics;
+    std::map<int, TurnMetrics::Duration>    m_orders_wait;          ///< for the turn being played, by empire id
+    std::chrono::steady_clock::time_point   m_turn_updates_sent;    ///< when turn updates were last sent
+    bool                                    m_order_independent_work_done = false;  ///< whether PrecomputeOrderIndependentTurnWork results are current
+
+    /** Optional work that is reduced to keep processing a turn within the
+      * turn processing budget. */
+    struct TurnWorkReductions {
+        bool production_projection = false;     ///< production queues simulate fewer future turns
+        bool combat_log_events = false;         ///< combat logs don't record the events of combats
+        bool mid_combat_stale_knowledge = false;///< stale object knowledge isn't updated from glimpses during combat
+    };
+    TurnWorkReductions                      m_turn_work_reductions;
+    std::chrono::steady_clock::time_point   m_turn_processing_start;
+    TurnMetrics::Duration                   m_last_turn_processing{0};  ///< from starting PreCombatProcessTurns to finishing PostCombatProcessTurns
+    std::size_t                             m_last_turn_object_count = 0;
+    std::vector<std::pair<std::string, TurnMetrics::Duration>> m_universe_generation_phases;    ///< in order, for UniverseGenerationReport
+    std::chrono::steady_clock::time_point   m_universe_generation_phase_start;
 
 
     /** Turn sequence map is used for turn processing. Each empire is added at
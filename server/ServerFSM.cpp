@@ -3,8 +3,10 @@
 #include "SaveLoad.h"
 #include "ServerApp.h"
 #include "ServerNetworking.h"
+#include "TurnReplay.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
+#include "../universe/Ship.h"
 #include "../universe/System.h"
 #include "../universe/Species.h"
 #include "../network/Message.h"
@@ -15,7 +17,9 @@
 #include "../util/LoggerWithOptionsDB.h"
 #include "../util/Order.h"
 #include "../util/OrderSet.h"
+#include "../util/Process.h"
 #include "../util/Random.h"
+#include "../util/ScopedTimer.h"
 #include "../util/ModeratorAction.h"
 
 #include <boost/filesystem/path.hpp>
@@ -39,6 +43,98 @@ namespace {
     constexpr EmpireColor CLR_SERVER{{255, 255, 255, 255}};
     constexpr EmpireColor CLR_ZERO{{0, 0, 0, 0}};
 
+    /** Appends the phase times of processing \a turn, the size of the
+      * gamestate and the peak memory use of the server to \a path, as one
+      * JSON object per line, for tracking turn processing performance. */
+    void WriteTurnBenchmark(const std::string& path, int turn, ServerApp& server,
+                            double pre_combat_ms, double combat_ms, double post_combat_ms)
+    {
+        boost::filesystem::ofstream ofs(FilenameToPath(path), std::ios_base::out | std::ios_base::app);
+        if (!ofs) {
+            ErrorLogger(FSM) << "WriteTurnBenchmark unable to open " << path;
+            return;
+        }
+        const ObjectMap& objects = server.GetUniverse().Objects();
+        ofs << "{\"turn\":" << turn
+            << ",\"objects\":" << objects.size()
+            << ",\"systems\":" << objects.size<System>()
+            << ",\"ships\":" << objects.size<Ship>()
+            << ",\"empires\":" << server.Empires().NumEmpires()
+            << ",\"pre_combat_ms\":" << pre_combat_ms
+            << ",\"combat_ms\":" << combat_ms
+            << ",\"post_combat_ms\":" << post_combat_ms
+            << ",\"peak_rss_kb\":" << PeakResidentMemoryKB()
+            << "}\n";
+    }
+
+    /** Returns whether the server runs an accelerated simulation, which plays
+        a fixed number of turns without saving, and then exits. */
+    bool SimulationMode()
+    { return GetOptionsDB().Get<int>("server.simulation.turns") > 0; }
+
+    /** Returns whether a simulation has played all the turns it should, or
+        can't usefully continue because the game has been decided. */
+    bool SimulationFinished(ServerApp& server) {
+        if (server.CurrentTurn() > GetOptionsDB().Get<int>("server.simulation.turns"))
+            return true;
+        if (server.IsHaveWinner())
+            return true;
+        for (const auto& [empire_id, empire] : server.Empires())
+            if (!empire->Eliminated())
+                return false;
+        return true;
+    }
+
+    void WriteJsonString(std::ostream& os, const std::string& text) {
+        os << '"';
+        for (const char c : text) {
+            if (c == '"' || c == '\\')
+                os << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                os << ' ';
+            else
+                os << c;
+        }
+        os << '"';
+    }
+
+    /** Appends a line with the outcome of a simulated game to \a path: the
+        turn reached, and for each empire whether it won or was eliminated and
+        the latest value of each statistic recorded for it. */
+    void WriteSimulationResults(const std::string& path, ServerApp& server) {
+        boost::filesystem::ofstream ofs(FilenameToPath(path), std::ios_base::out | std::ios_base::app);
+        if (!ofs) {
+            ErrorLogger(FSM) << "WriteSimulationResults unable to open " << path;
+            return;
+        }
+        const auto& stat_records = server.GetUniverse().GetStatRecords();
+
+        ofs << "{\"seed\":";
+        WriteJsonString(ofs, server.GetGalaxySetupData().seed);
+        ofs << ",\"turn\":" << server.CurrentTurn() << ",\"empires\":[";
+        bool first_empire = true;
+        for (const auto& [empire_id, empire] : server.Empires()) {
+            ofs << (first_empire ? "" : ",") << "{\"id\":" << empire_id << ",\"name\":";
+            first_empire = false;
+            WriteJsonString(ofs, empire->Name());
+            ofs << ",\"won\":" << (empire->Won() ? "true" : "false")
+                << ",\"eliminated\":" << (empire->Eliminated() ? "true" : "false")
+                << ",\"stats\":{";
+            bool first_stat = true;
+            for (const auto& [stat_name, empire_series] : stat_records) {
+                auto series_it = empire_series.find(empire_id);
+                if (series_it == empire_series.end() || series_it->second.empty())
+                    continue;
+                ofs << (first_stat ? "" : ",");
+                first_stat = false;
+                WriteJsonString(ofs, stat_name);
+                ofs << ':' << series_it->second.Values().back();
+            }
+            ofs << "}}";
+        }
+        ofs << "]}\n";
+    }
+
     void SendMessageToAllPlayers(const Message& message) {
         ServerApp* server = ServerApp::GetApp();
         if (!server) {
@@ -410,6 +506,7 @@ void ServerFSM::HandleNonLobbyDisconnection(const Disconnection& d) {
                 int bytes_written = 0;
                 // save game...
                 try {
+                    m_server.WaitForBackgroundSave();
                     bytes_written = SaveGame(save_filename,     server_data,    m_server.GetPlayerSaveGameData(),
                                              GetUniverse(),     Empires(),      GetSpeciesManager(),
                                              GetCombatLogManager(),             m_server.m_galaxy_setup_data,
@@ -574,11 +671,12 @@ bool ServerFSM::EstablishPlayer(const PlayerConnectionPtr& player_connection,
             m_server.PushChatMessage(data, "", CLR_SERVER, timestamp);
 
             // send message to other players
+            const auto chat_message = ServerPlayerChatMessage(Networking::INVALID_PLAYER_ID, timestamp, data);
             for (auto it = m_server.m_networking.established_begin();
                  it != m_server.m_networking.established_end(); ++it)
             {
                 if (player_connection != (*it))
-                    (*it)->SendMessage(ServerPlayerChatMessage(Networking::INVALID_PLAYER_ID, timestamp, data));
+                    (*it)->SendMessage(chat_message);
             }
 
             std::vector<std::reference_wrapper<const ChatHistoryEntity>> chat_history;
@@ -2637,12 +2735,15 @@ sc::result PlayingGame::react(const ModeratorAct& msg) {
     if (action) {
         // execute action
         action->Execute();
+        server.InvalidateOrderIndependentTurnWork();
 
         // update player(s) of changed gamestate as result of action
         bool use_binary_serialization = sender->IsBinarySerializationUsed();
+        bool use_delta = GetOptionsDB().Get<bool>("network.server.turn-update.delta");
         sender->SendMessage(TurnProgressMessage(Message::TurnProgressPhase::DOWNLOADING));
-        sender->SendMessage(TurnPartialUpdateMessage(server.PlayerEmpireID(player_id),
-                                                     GetUniverse(), use_binary_serialization));
+        sender->SendMessage(TurnPartialUpdateMessage(server.PlayerEmpireID(player_id), GetUniverse(),
+                                                     sender->TurnUpdateDeltaBase(), use_delta,
+                                                     use_binary_serialization));
     }
 
     delete action;
@@ -2655,7 +2756,7 @@ sc::result PlayingGame::react(const ShutdownServer& msg) {
 
     ServerApp& server = Server();
 
-    if (server.IsHostless() &&
+    if (server.IsHostless() && !SimulationMode() &&
         GetOptionsDB().Get<bool>("save.auto.hostless.enabled") &&
         GetOptionsDB().Get<bool>("save.auto.exit.enabled"))
     {
@@ -2665,6 +2766,7 @@ sc::result PlayingGame::react(const ShutdownServer& msg) {
         int bytes_written = 0;
         // save game...
         try {
+            server.WaitForBackgroundSave();
             bytes_written = SaveGame(save_filename,     server_data,    server.GetPlayerSaveGameData(),
                                      GetUniverse(),     Empires(),      GetSpeciesManager(),
                                      GetCombatLogManager(),             server.m_galaxy_setup_data,
@@ -2950,15 +3052,10 @@ sc::result PlayingGame::react(const AutoTurn& msg) {
     empire->SetReady(turns_count != 0);
 
     // notify other player that this empire submitted orders
-    for (auto player_it = server.m_networking.established_begin();
-         player_it != server.m_networking.established_end(); ++player_it)
-    {
-        PlayerConnectionPtr player_ctn = *player_it;
-        player_ctn->SendMessage(PlayerStatusMessage(empire->Ready() ?
-                                                    Message::PlayerStatus::WAITING :
-                                                    Message::PlayerStatus::PLAYING_TURN,
-                                                    empire_id));
-    }
+    server.m_networking.SendMessageAll(PlayerStatusMessage(empire->Ready() ?
+                                                           Message::PlayerStatus::WAITING :
+                                                           Message::PlayerStatus::PLAYING_TURN,
+                                                           empire_id));
 
     if (empire->Ready()) {
         // check conditions for ending this turn
@@ -3037,7 +3134,7 @@ WaitingForTurnEnd::WaitingForTurnEnd(my_context c) :
     m_start(std::chrono::high_resolution_clock::now())
 {
     TraceLogger(FSM) << "(ServerFSM) WaitingForTurnEnd";
-    if (GetOptionsDB().Get<int>("save.auto.interval") > 0) {
+    if (GetOptionsDB().Get<int>("save.auto.interval") > 0 && !SimulationMode()) {
 #if BOOST_VERSION >= 106600
         m_timeout.expires_after(std::chrono::seconds(GetOptionsDB().Get<int>("save.auto.interval")));
 #else
@@ -3067,6 +3164,10 @@ WaitingForTurnEnd::WaitingForTurnEnd(my_context c) :
     } else {
         Server().Networking().SendMessageAll(TurnTimeoutMessage(0));
     }
+
+    // the players have the new turn and the server is idle until they send
+    // their orders, so do the work for the next turn that doesn't need them
+    Server().PrecomputeOrderIndependentTurnWork();
 }
 
 WaitingForTurnEnd::~WaitingForTurnEnd() {
@@ -3097,6 +3198,11 @@ sc::result WaitingForTurnEnd::react(const TurnOrders& msg) {
         return discard_event();
     }
 
+    // players only send orders after applying the turn update for the current
+    // turn, so the next turn update can be encoded relative to it
+    auto& delta_base = sender->TurnUpdateDeltaBase();
+    delta_base.acknowledged = (delta_base.turn == server.CurrentTurn());
+
     int player_id = sender->PlayerID();
     Networking::ClientType client_type = sender->GetClientType();
 
@@ -3174,12 +3280,7 @@ sc::result WaitingForTurnEnd::react(const TurnOrders& msg) {
         empire->SetReady(true);
 
         // notify other player that this empire submitted orders
-        for (auto player_it = server.m_networking.established_begin();
-             player_it != server.m_networking.established_end(); ++player_it)
-        {
-            PlayerConnectionPtr player_ctn = *player_it;
-            player_ctn->SendMessage(PlayerStatusMessage(Message::PlayerStatus::WAITING, empire_id));
-        }
+        server.m_networking.SendMessageAll(PlayerStatusMessage(Message::PlayerStatus::WAITING, empire_id));
     }
 
     // inform player who just submitted of their new status.  Note: not sure why
@@ -3321,12 +3422,7 @@ sc::result WaitingForTurnEnd::react(const RevokeReadiness& msg) {
         sender->SendMessage(msg.m_message);
 
         // notify other player that this empire revoked orders
-        for (auto player_it = server.m_networking.established_begin();
-             player_it != server.m_networking.established_end(); ++player_it)
-        {
-            PlayerConnectionPtr player_ctn = *player_it;
-            player_ctn->SendMessage(PlayerStatusMessage(Message::PlayerStatus::PLAYING_TURN, empire_id));
-        }
+        server.m_networking.SendMessageAll(PlayerStatusMessage(Message::PlayerStatus::PLAYING_TURN, empire_id));
     }
 
     return discard_event();
@@ -3354,7 +3450,9 @@ sc::result WaitingForTurnEnd::react(const CheckTurnEndConditions& c) {
     }
 
     // save game so orders from the player will be backuped
-    if (server.IsHostless() && GetOptionsDB().Get<bool>("save.auto.hostless.each-player.enabled")) {
+    if (server.IsHostless() && !SimulationMode() &&
+        GetOptionsDB().Get<bool>("save.auto.hostless.each-player.enabled"))
+    {
         PlayerConnectionPtr dummy_connection = nullptr;
         post_event(SaveGameRequest(HostSaveGameInitiateMessage(GetAutoSaveFileName(server.CurrentTurn())), dummy_connection));
     }
@@ -3379,12 +3477,37 @@ sc::result WaitingForTurnEnd::react(const SaveGameRequest& msg) {
 
     ServerSaveGameData server_data{server.m_current_turn};
 
+    // autosaves may be compressed and written to disk in the background,
+    // while the server continues, from an in-memory snapshot of the game,
+    // and may be appended to a journal of the changes since earlier autosaves
+    const bool background = GetOptionsDB().Get<bool>("save.auto.background.enabled");
+    const bool incremental = GetOptionsDB().Get<bool>("save.auto.incremental.enabled");
+    if (!player_connection && (background || incremental)) {
+        auto snapshot = incremental ?
+            SnapshotGameToJournal(server.m_save_game_journal, save_filename, server_data,
+                                  server.GetPlayerSaveGameData(), GetUniverse(), Empires(),
+                                  GetSpeciesManager(), GetCombatLogManager(),
+                                  server.m_galaxy_setup_data, !server.m_single_player_game) :
+            SnapshotGame(save_filename, server_data,    server.GetPlayerSaveGameData(),
+                         GetUniverse(), Empires(),      GetSpeciesManager(),
+                         GetCombatLogManager(),         server.m_galaxy_setup_data,
+                         !server.m_single_player_game);
+        if (snapshot) {
+            server.WriteGameSnapshotInBackground(std::move(snapshot), std::move(save_filename));
+            if (!background)
+                server.WaitForBackgroundSave();
+            return discard_event();
+        }
+        DebugLogger(FSM) << "WaitingForTurnEnd.SaveGameRequest : Unable to snapshot game; saving in foreground.";
+    }
+
     // retreive requested save name from Base state, which should have been
     // set in WaitingForTurnEnd::react(const SaveGameRequest& msg)
     int bytes_written = 0;
 
     // save game...
     try {
+        server.WaitForBackgroundSave();
         bytes_written = SaveGame(save_filename,     server_data,    server.GetPlayerSaveGameData(),
                                  GetUniverse(),     Empires(),      GetSpeciesManager(),
                                  GetCombatLogManager(),             server.m_galaxy_setup_data,
@@ -3444,26 +3567,55 @@ sc::result ProcessingTurn::react(const ProcessTurn& u) {
     // make sure all AI client processes are running with low priority
     server.SetAIsProcessPriorityToLow(true);
 
+    server.InstallReloadedContent();
+    const int processed_turn = server.CurrentTurn();
+    BeginTurnProfile(processed_turn);
+    const auto pre_combat_start = std::chrono::steady_clock::now();
     server.PreCombatProcessTurns();
+    const auto combat_start = std::chrono::steady_clock::now();
     server.ProcessCombats();
+    const auto post_combat_start = std::chrono::steady_clock::now();
     server.PostCombatProcessTurns();
+    const auto post_combat_end = std::chrono::steady_clock::now();
+    EndTurnProfile(GetUserDataDir() / ("turn_profile_" + std::to_string(processed_turn) + ".json"));
+    server.StartReloadingChangedContent();
+
+    const auto& benchmark_output = GetOptionsDB().Get<std::string>("turn.benchmark.output");
+    if (!benchmark_output.empty()) {
+        const auto to_ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+        WriteTurnBenchmark(benchmark_output, processed_turn, server,
+                           to_ms(combat_start - pre_combat_start),
+                           to_ms(post_combat_start - combat_start),
+                           to_ms(post_combat_end - post_combat_start));
+    }
+
+    const auto& metrics_path = GetOptionsDB().Get<std::string>("network.server.metrics.path");
+    if (!metrics_path.empty())
+        server.WriteMetrics(metrics_path);
+
+    const auto& record_path = GetOptionsDB().Get<std::string>("server.turn.record.path");
+    if (!record_path.empty())
+        AppendTurnDigest(FilenameToPath(record_path) / TURN_DIGESTS_FILENAME, processed_turn,
+                         server.CurrentTurnDigest());
 
     // update players that other empires are now playing their turn
     for (const auto& empire : server.Empires()) {
         // inform all players that this empire is playing a turn if not eliminated
-        for (auto recipient_player_it = server.m_networking.established_begin();
-            recipient_player_it != server.m_networking.established_end();
-            ++recipient_player_it)
-        {
-            const PlayerConnectionPtr& recipient_player_ctn = *recipient_player_it;
-            recipient_player_ctn->SendMessage(PlayerStatusMessage(empire.second->Eliminated() || empire.second->Ready() ?
-                                                                      Message::PlayerStatus::WAITING :
-                                                                      Message::PlayerStatus::PLAYING_TURN,
-                                                                  empire.first));
+        server.m_networking.SendMessageAll(PlayerStatusMessage(empire.second->Eliminated() || empire.second->Ready() ?
+                                                                   Message::PlayerStatus::WAITING :
+                                                                   Message::PlayerStatus::PLAYING_TURN,
+                                                               empire.first));
+    }
+
+    if (SimulationMode()) {
+        if (SimulationFinished(server)) {
+            DebugLogger(FSM) << "ProcessingTurn.ProcessTurn : simulation finished on turn " << server.CurrentTurn();
+            const auto& results_path = GetOptionsDB().Get<std::string>("server.simulation.results.path");
+            if (!results_path.empty())
+                WriteSimulationResults(results_path, server);
+            post_event(ShutdownServer());
         }
-    }
-
-    if (server.IsHostless() && GetOptionsDB().Get<bool>("save.auto.hostless.enabled")) {
+    } else if (server.IsHostless() && GetOptionsDB().Get<bool>("save.auto.hostless.enabled")) {
         PlayerConnectionPtr dummy_connection = nullptr;
         post_event(SaveGameRequest(HostSaveGameInitiateMessage(GetAutoSaveFileName(server.CurrentTurn())), dummy_connection));
     }
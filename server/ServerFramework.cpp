@@ -15,6 +15,7 @@
 #include <boost/python/docstring_options.hpp>
 #include <boost/python/stl_iterator.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace fs = boost::filesystem;
@@ -45,6 +46,7 @@ BOOST_PYTHON_MODULE(freeorion) {
 
     FreeOrionPython::SetWrapper<int>::Wrap("IntSet");
     FreeOrionPython::SetWrapper<std::string>::Wrap("StringSet");
+    FreeOrionPython::SetWrapper<int, ObjectIDBitmap>::Wrap("ObjectIDBitmap");
 }
 
 
@@ -77,8 +79,9 @@ auto PythonServer::InitModules() -> bool
     }
     AddToSysPath(GetPythonTurnEventsDir());
 
-    // import universe generator script file
+    // import turn events script file
     m_python_module_turn_events = py::import("turn_events");
+    LoadTurnEventTriggers();
 
     // Confirm existence of the directory containing the auth Python scripts
     // and add it to Pythons sys.path to make sure Python will find our scripts
@@ -302,14 +305,87 @@ auto PythonServer::CreateUniverse(std::map<int, PlayerSetupData>& player_setup_d
     return f(py_player_setup_data);
 }
 
-auto PythonServer::ExecuteTurnEvents() -> bool
+bool TurnEventTrigger::Fires(int turn) const {
+    if (turn < first_turn || turn > last_turn)
+        return false;
+    if (!turns.empty())
+        return std::binary_search(turns.begin(), turns.end(), turn);
+    return interval > 0 && (turn - first_turn) % interval == 0;
+}
+
+void PythonServer::LoadTurnEventTriggers() {
+    m_turn_event_triggers.reset();
+    if (!PyObject_HasAttrString(m_python_module_turn_events.ptr(), "turn_event_triggers")) {
+        DebugLogger() << "Turn events script declares no triggers; calling execute_turn_events every turn";
+        return;
+    }
+
+    // turn_event_triggers returns a dict from the name of each function to
+    // call to a dict with any of the keys first, last, every and turns
+    py::object r = m_python_module_turn_events.attr("turn_event_triggers")();
+    py::extract<py::dict> py_triggers(r);
+    if (!py_triggers.check()) {
+        ErrorLogger() << "Wrong turn event triggers: turn_event_triggers returns " << py::extract<std::string>(py::str(r))();
+        return;
+    }
+
+    std::vector<TurnEventTrigger> triggers;
+    py::list items = py_triggers().items();
+    for (py::ssize_t idx = 0; idx < py::len(items); ++idx) {
+        TurnEventTrigger trigger;
+        trigger.function_name = py::extract<std::string>(items[idx][0]);
+        py::dict spec = py::extract<py::dict>(items[idx][1]);
+        if (spec.has_key("first"))
+            trigger.first_turn = py::extract<int>(spec["first"]);
+        if (spec.has_key("last"))
+            trigger.last_turn = py::extract<int>(spec["last"]);
+        if (spec.has_key("every"))
+            trigger.interval = py::extract<int>(spec["every"]);
+        if (spec.has_key("turns")) {
+            py::stl_input_iterator<int> turns_begin(spec["turns"]), turns_end;
+            trigger.turns.assign(turns_begin, turns_end);
+            std::sort(trigger.turns.begin(), trigger.turns.end());
+        }
+        DebugLogger() << "Turn event " << trigger.function_name << " runs from turn " << trigger.first_turn
+                      << " to " << trigger.last_turn << " every " << trigger.interval << " turns, or on "
+                      << trigger.turns.size() << " listed turns";
+        triggers.push_back(std::move(trigger));
+    }
+    m_turn_event_triggers = std::move(triggers);
+}
+
+auto PythonServer::CallTurnEvent(const std::string& function_name, TurnEventTimings& timings) -> bool
 {
-    py::object f = m_python_module_turn_events.attr("execute_turn_events");
+    py::object f = m_python_module_turn_events.attr(function_name.c_str());
     if (!f) {
-        ErrorLogger() << "Unable to call Python function execute_turn_events ";
+        ErrorLogger() << "Unable to call Python function " << function_name;
         return false;
     }
-    return f();
+    const auto start = std::chrono::steady_clock::now();
+    const bool result(f());
+    timings.emplace_back(function_name, std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+auto PythonServer::TurnEventsFire(int current_turn) const -> bool
+{
+    if (!m_turn_event_triggers)
+        return true;
+    return std::any_of(m_turn_event_triggers->begin(), m_turn_event_triggers->end(),
+                       [current_turn](const TurnEventTrigger& trigger) { return trigger.Fires(current_turn); });
+}
+
+auto PythonServer::ExecuteTurnEvents(int current_turn, TurnEventTimings& timings) -> bool
+{
+    if (!m_turn_event_triggers)
+        return CallTurnEvent("execute_turn_events", timings);
+
+    bool success = true;
+    for (const auto& trigger : *m_turn_event_triggers) {
+        if (trigger.Fires(current_turn))
+            success = CallTurnEvent(trigger.function_name, timings) && success;
+    }
+    return success;
 }
 
 auto GetPythonUniverseGeneratorDir() -> const std::string
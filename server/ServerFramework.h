@@ -6,8 +6,32 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <chrono>
+#include <limits>
 #include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/** When a function of the turn events script is called, as declared by the
+  * script's turn_event_triggers function.  A trigger fires on the turns from
+  * first_turn to last_turn that are in turns, if it isn't empty, or else on
+  * every interval turns from first_turn. */
+struct TurnEventTrigger {
+    std::string         function_name;
+    int                 first_turn = 1;
+    int                 last_turn = std::numeric_limits<int>::max();
+    int                 interval = 1;
+    std::vector<int>    turns;          ///< sorted
+
+    [[nodiscard]] bool Fires(int turn) const;
+};
 
+/** Time taken by each turn events script function that was called, in
+  * order. */
+using TurnEventTimings = std::vector<std::pair<std::string, std::chrono::steady_clock::duration>>;
 
 class PythonServer : public PythonBase {
 public:
@@ -17,7 +41,8 @@ public:
     bool InitModules() override;
 
     bool CreateUniverse(std::map<int, PlayerSetupData>& player_setup_data); // Wraps call to the main Python universe generator function
-    bool ExecuteTurnEvents();    // Wraps call to the main Python turn events function
+    bool ExecuteTurnEvents(int current_turn, TurnEventTimings& timings); // Wraps calls to the Python turn events functions whose triggers fire on current_turn, timing each
+    bool TurnEventsFire(int current_turn) const; // Returns whether any Python turn events function is to be called on current_turn
     bool IsRequireAuthOrReturnRoles(const std::string& player_name, bool &result, Networking::AuthRoles& roles) const; // Wraps call to AuthProvider's method is_require_auth
     bool IsSuccessAuthAndReturnRoles(const std::string& player_name, const std::string& auth, bool &result, Networking::AuthRoles& roles) const; // Wraps call to AuthProvider's method is_success_auth
     bool FillListPlayers(std::list<PlayerSetupData>& players) const; // Wraps call to AuthProvider's method list_player
@@ -26,12 +51,24 @@ public:
     bool PutChatHistoryEntity(const ChatHistoryEntity& chat_history_entity); // Wraps call to ChatProvider's method put_history_entity
 
 private:
+    /** Reads the triggers declared by the turn events script, if it declares
+      * any.  Otherwise its execute_turn_events function is called every turn. */
+    void LoadTurnEventTriggers();
+
+    /** Calls the turn events script function \a function_name, and records
+      * the time it took in \a timings. */
+    bool CallTurnEvent(const std::string& function_name, TurnEventTimings& timings);
+
     // reference to imported Python universe generator module
     boost::python::object m_python_module_universe_generator;
 
     // reference to imported Python turn events module
     boost::python::object m_python_module_turn_events;
 
+    // triggers of the turn events script functions, read when it is imported,
+    // or none if the script doesn't declare any
+    std::optional<std::vector<TurnEventTrigger>> m_turn_event_triggers;
+
     // reference to imported Python auth module
     boost::python::object m_python_module_auth;
 
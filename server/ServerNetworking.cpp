@@ -160,8 +160,10 @@ PlayerConnection::PlayerConnection(boost::asio::io_context& io_context,
                                    MessageAndConnectionFn player_message_callback,
                                    ConnectionFn disconnected_callback) :
     m_service(io_context),
+    m_strand(io_context),
     m_socket(io_context),
     m_cookie(boost::uuids::nil_uuid()),
+    m_max_message_size(GetOptionsDB().Get<int>("network.server.client-message-size.max")),
     m_nonplayer_message_callback(nonplayer_message_callback),
     m_player_message_callback(player_message_callback),
     m_disconnected_callback(disconnected_callback)
@@ -230,14 +232,21 @@ bool PlayerConnection::IsLocalConnection() const
 { return (m_socket->remote_endpoint().address().is_loopback()); }
 
 void PlayerConnection::Start()
-{ AsyncReadMessage(); }
+{ m_strand.post(boost::bind(&PlayerConnection::AsyncReadMessage, shared_from_this())); }
 
 void PlayerConnection::SendMessage(const Message& message) {
     if (!m_valid) {
         ErrorLogger(network) << "PlayerConnection::SendMessage can't send message when not transmit connected";
         return;
     }
-    m_service.post(boost::bind(&PlayerConnection::SendMessageImpl, shared_from_this(), message));
+    const auto threshold = GetOptionsDB().Get<int>("network.server.compression.threshold");
+    if (threshold > 0 && message.Size() >= static_cast<std::size_t>(threshold) && IsCompressionUsed()) {
+        // compress on the sending thread, rather than blocking the networking thread
+        m_strand.post(boost::bind(&PlayerConnection::SendMessageImpl, shared_from_this(),
+                                  CompressMessage(message)));
+        return;
+    }
+    m_strand.post(boost::bind(&PlayerConnection::SendMessageImpl, shared_from_this(), message));
 }
 
 bool PlayerConnection::IsEstablished() const {
@@ -344,6 +353,16 @@ bool PlayerConnection::IsBinarySerializationUsed() const {
         && m_client_version_string == FreeOrionVersionString();
 }
 
+bool PlayerConnection::IsCompressionUsed() const {
+    if (GetOptionsDB().Get<int>("network.server.compression.threshold") <= 0)
+        return false;
+    if (m_client_version_string.empty() || m_client_version_string != FreeOrionVersionString())
+        return false;
+    boost::system::error_code ec;
+    const auto endpoint = m_socket->remote_endpoint(ec);
+    return !ec && !endpoint.address().is_loopback();
+}
+
 PlayerConnectionPtr PlayerConnection::NewConnection(boost::asio::io_context& io_context,
                                                     MessageAndConnectionFn nonplayer_message_callback,
                                                     MessageAndConnectionFn player_message_callback,
@@ -426,11 +445,14 @@ void PlayerConnection::HandleMessageBodyRead(boost::system::error_code error,
                                      << " and size " << m_incoming_message.Size();
                 //TraceLogger(network) << "     Full message: " << m_incoming_message;
             }
-            if (EstablishedPlayer()) {
-                EventSignal(boost::bind(m_player_message_callback, m_incoming_message, shared_from_this()));
-            } else {
-                EventSignal(boost::bind(m_nonplayer_message_callback, m_incoming_message, shared_from_this()));
-            }
+            // whether the player is established is decided when handling the
+            // message on the main thread, which is what establishes players
+            EventSignal([self{shared_from_this()}, message{std::move(m_incoming_message)}]() {
+                if (self->EstablishedPlayer())
+                    self->m_player_message_callback(message, self);
+                else
+                    self->m_nonplayer_message_callback(message, self);
+            });
             m_incoming_message.Reset();
             AsyncReadMessage();
         }
@@ -482,8 +504,7 @@ void PlayerConnection::HandleMessageHeaderRead(boost::system::error_code error,
             BufferToHeader(m_incoming_header_buffer, m_incoming_message);
             auto msg_size = m_incoming_header_buffer[Message::Parts::SIZE];
             TraceLogger(network) << "Server Handling Message maybe allocating buffer of size: " << msg_size;
-            if (GetOptionsDB().Get<int>("network.server.client-message-size.max") > 0 &&
-                msg_size > GetOptionsDB().Get<int>("network.server.client-message-size.max"))
+            if (m_max_message_size > 0 && msg_size > m_max_message_size)
             {
                 ErrorLogger(network) << "PlayerConnection::HandleMessageHeaderRead(): "
                                      << "too big message " << msg_size << " bytes ";
@@ -506,25 +527,24 @@ void PlayerConnection::HandleMessageHeaderRead(boost::system::error_code error,
             boost::asio::async_read(
                 *m_socket,
                 boost::asio::buffer(m_incoming_message.Data(), m_incoming_message.Size()),
-                boost::bind(&PlayerConnection::HandleMessageBodyRead, shared_from_this(),
-                            boost::asio::placeholders::error,
-                            boost::asio::placeholders::bytes_transferred));
+                m_strand.wrap(boost::bind(&PlayerConnection::HandleMessageBodyRead, shared_from_this(),
+                                          boost::asio::placeholders::error,
+                                          boost::asio::placeholders::bytes_transferred)));
         }
     }
 }
 
 void PlayerConnection::AsyncReadMessage() {
     boost::asio::async_read(*m_socket, boost::asio::buffer(m_incoming_header_buffer),
-                            boost::bind(&PlayerConnection::HandleMessageHeaderRead,
-                                        shared_from_this(),
-                                        boost::asio::placeholders::error,
-                                        boost::asio::placeholders::bytes_transferred));
+                            m_strand.wrap(boost::bind(&PlayerConnection::HandleMessageHeaderRead,
+                                                      shared_from_this(),
+                                                      boost::asio::placeholders::error,
+                                                      boost::asio::placeholders::bytes_transferred)));
 }
 
 void PlayerConnection::SendMessageImpl(PlayerConnectionPtr self, Message message) {
     bool start_write = self->m_outgoing_messages.empty();
-    self->m_outgoing_messages.push_back(Message());
-    swap(self->m_outgoing_messages.back(), message);
+    self->m_outgoing_messages.push_back(std::move(message));
     if (start_write)
         self->AsyncWriteMessage();
 }
@@ -542,9 +562,9 @@ void PlayerConnection::AsyncWriteMessage() {
     buffers.push_back(boost::asio::buffer(m_outgoing_messages.front().Data(),
                                           m_outgoing_messages.front().Size()));
     boost::asio::async_write(*m_socket, buffers,
-                             boost::bind(&PlayerConnection::HandleMessageWrite, shared_from_this(),
-                                         boost::asio::placeholders::error,
-                                         boost::asio::placeholders::bytes_transferred));
+                             m_strand.wrap(boost::bind(&PlayerConnection::HandleMessageWrite, shared_from_this(),
+                                                       boost::asio::placeholders::error,
+                                                       boost::asio::placeholders::bytes_transferred)));
 }
 
 void PlayerConnection::HandleMessageWrite(PlayerConnectionPtr self,
@@ -563,6 +583,8 @@ void PlayerConnection::HandleMessageWrite(PlayerConnectionPtr self,
     if (static_cast<int>(bytes_transferred) != static_cast<int>(Message::HeaderBufferSize) + self->m_outgoing_header[Message::Parts::SIZE])
         return;
 
+    self->m_bytes_sent += bytes_transferred;
+    ++self->m_messages_sent;
     self->m_outgoing_messages.pop_front();
     if (!self->m_outgoing_messages.empty())
         self->AsyncWriteMessage();
@@ -584,16 +606,50 @@ ServerNetworking::ServerNetworking(boost::asio::io_context& io_context,
                                    MessageAndConnectionFn nonplayer_message_callback,
                                    MessageAndConnectionFn player_message_callback,
                                    ConnectionFn disconnected_callback) :
+    m_io_context(io_context),
     m_host_player_id(Networking::INVALID_PLAYER_ID),
     m_discovery_server(new DiscoveryServer(io_context)),
     m_player_connection_acceptor(io_context),
     m_nonplayer_message_callback(nonplayer_message_callback),
     m_player_message_callback(player_message_callback),
     m_disconnected_callback(disconnected_callback)
-{ Init(); }
+{
+    // connections are created on the context they'll use while listening
+    // starts, before the threads are started
+    const auto num_threads = GetOptionsDB().Get<int>("network.server.io-threads");
+    if (num_threads > 0) {
+#if BOOST_VERSION >= 106600
+        m_connections_work.emplace(m_connections_io_context.get_executor());
+#else
+        m_connections_work.emplace(m_connections_io_context);
+#endif
+    }
+
+    Init();
+
+    for (int i = 0; i < num_threads; ++i) {
+        m_connections_threads.emplace_back([this]() {
+            while (true) {
+                try {
+                    m_connections_io_context.run();
+                    return;
+                } catch (const std::exception& e) {
+                    ErrorLogger(network) << "ServerNetworking caught exception handling player connections: " << e.what();
+                }
+            }
+        });
+    }
+    if (num_threads > 0)
+        DebugLogger(network) << "ServerNetworking handling player connections on " << num_threads << " thread(s)";
+}
 
-ServerNetworking::~ServerNetworking()
-{ delete m_discovery_server; }
+ServerNetworking::~ServerNetworking() {
+    m_connections_work.reset();
+    m_connections_io_context.stop();
+    for (auto& thread : m_connections_threads)
+        thread.join();
+    delete m_discovery_server;
+}
 
 bool ServerNetworking::empty() const
 { return m_player_connections.empty(); }
@@ -743,11 +799,15 @@ ServerNetworking::established_iterator ServerNetworking::established_end() {
 }
 
 void ServerNetworking::HandleNextEvent() {
-    if (!m_event_queue.empty()) {
-        std::function<void ()> f = m_event_queue.front();
+    NullaryFn f;
+    {
+        std::scoped_lock lock(m_event_queue_mutex);
+        if (m_event_queue.empty())
+            return;
+        f = std::move(m_event_queue.front());
         m_event_queue.pop();
-        f();
     }
+    f();
 }
 
 void ServerNetworking::SetHostPlayerID(int host_player_id)
@@ -837,11 +897,7 @@ void ServerNetworking::AcceptNextMessagingConnection() {
     using boost::placeholders::_1;
 
     auto next_connection = PlayerConnection::NewConnection(
-#if BOOST_VERSION >= 106600
-        m_player_connection_acceptor.get_executor().context(),
-#else
-        m_player_connection_acceptor.get_io_service(),
-#endif
+        ConnectionsContext(),
         m_nonplayer_message_callback,
         m_player_message_callback,
         boost::bind(&ServerNetworking::DisconnectImpl, this, _1));
@@ -860,6 +916,14 @@ void ServerNetworking::AcceptPlayerMessagingConnection(PlayerConnectionPtr playe
 {
     if (!error) {
         TraceLogger(network) << "ServerNetworking::AcceptPlayerMessagingConnection : connected to new player";
+        if (player_connection->IsLocalConnection()) {
+            // local clients get turn updates as they are, without compression,
+            // and have no network latency that delaying small messages helps
+            boost::system::error_code ignored_error;
+            player_connection->m_socket->set_option(boost::asio::socket_base::send_buffer_size(LOCAL_SOCKET_BUFFER_SIZE), ignored_error);
+            player_connection->m_socket->set_option(boost::asio::socket_base::receive_buffer_size(LOCAL_SOCKET_BUFFER_SIZE), ignored_error);
+            player_connection->m_socket->set_option(tcp::no_delay(true), ignored_error);
+        }
         m_player_connections.insert(player_connection);
         player_connection->Start();
         AcceptNextMessagingConnection();
@@ -875,5 +939,14 @@ void ServerNetworking::DisconnectImpl(PlayerConnectionPtr player_connection) {
     m_disconnected_callback(player_connection);
 }
 
-void ServerNetworking::EnqueueEvent(const NullaryFn& fn)
-{ m_event_queue.push(fn); }
+void ServerNetworking::EnqueueEvent(const NullaryFn& fn) {
+    {
+        std::scoped_lock lock(m_event_queue_mutex);
+        m_event_queue.push(fn);
+    }
+    // wake the main thread, which handles an event after each handler it runs
+    boost::asio::post(m_io_context, []() {});
+}
+
+boost::asio::io_context& ServerNetworking::ConnectionsContext()
+{ return m_connections_work ? m_connections_io_context : m_io_context; }
@@ -2,6 +2,7 @@
 #define _ServerNetworking_h_
 
 #include "../network/Message.h"
+#include "../util/ObjectDeltaBase.h"
 
 #include <boost/asio.hpp>
 #include <boost/iterator/filter_iterator.hpp>
@@ -10,11 +11,17 @@
 #include <boost/optional.hpp>
 #include <boost/uuid/nil_generator.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 class DiscoveryServer;
 class PlayerConnection;
@@ -57,7 +64,16 @@ namespace boost { namespace asio {
 /** Encapsulates the networking facilities of the server.  This class listens
     for incoming UDP LAN server-discovery requests and TCP player connections.
     The server also sends and receives messages over the TCP player
-    connections. */
+    connections.
+
+    Listening happens on the io_context passed to the constructor, which runs
+    on the server's main thread.  Reading and writing player connections
+    happens on a separate io_context, run by the number of threads given by
+    the network.server.io-threads option, so that messages are streamed while
+    the main thread processes a turn.  Received messages and disconnections
+    are queued as events, which are handled on the main thread by
+    HandleNextEvent.  With no networking threads all of this happens on the
+    main io_context. */
 class ServerNetworking {
 private:
     typedef std::set<PlayerConnectionPtr> PlayerConnections;
@@ -160,7 +176,9 @@ public:
     established_iterator established_end();
 
     /** Dequeues and executes the next event in the queue.  Results in a noop
-        if the queue is empty. */
+        if the queue is empty.  Each event that is queued also posts a handler
+        to the main io_context, so that running it is followed by a call to
+        this. */
     void HandleNextEvent();
 
     /** Sets Host player ID. */
@@ -185,6 +203,22 @@ private:
     void DisconnectImpl(PlayerConnectionPtr player_connection);
     void EnqueueEvent(const NullaryFn& fn);
 
+    /** Returns the io_context that player connections are read and written
+        on. */
+    boost::asio::io_context& ConnectionsContext();
+
+#if BOOST_VERSION >= 106600
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+#else
+    using WorkGuard = boost::asio::io_context::work;
+#endif
+
+    // declared first, so that the sockets of connections are destroyed before it
+    boost::asio::io_context         m_connections_io_context;
+    std::optional<WorkGuard>        m_connections_work;
+    std::vector<std::thread>        m_connections_threads;
+    boost::asio::io_context&        m_io_context;
+
     int                             m_host_player_id;
 
     DiscoveryServer*                m_discovery_server;
@@ -196,6 +230,7 @@ private:
 #endif
     PlayerConnections               m_player_connections;
     std::queue<NullaryFn>           m_event_queue;
+    std::mutex                      m_event_queue_mutex;
     std::unordered_map<boost::uuids::uuid, CookieData, boost::hash<boost::uuids::uuid>> m_cookies;
 
     MessageAndConnectionFn          m_nonplayer_message_callback;
@@ -238,6 +273,11 @@ public:
     /** Checks if the server will enable binary serialization for this client's connection. */
     bool IsBinarySerializationUsed() const;
 
+    /** Checks if the server will compress large messages sent to this
+      * client. Compression requires a client of the same version as the
+      * server, and is not used for local connections. */
+    bool IsCompressionUsed() const;
+
     /** Checks if client associated with this connection runs on the same
         physical machine as the server */
     bool IsLocalConnection() const;
@@ -254,7 +294,21 @@ public:
     /** Get cookie associated with this connection. */
     boost::uuids::uuid Cookie() const;
 
-    /** Starts the connection reading incoming messages on its socket. */
+    /** Returns the total size of the messages written to this connection,
+      * including their headers, after any compression.  Messages are written
+      * on a networking thread, so this may be behind what was sent. */
+    std::uint64_t BytesSent() const { return m_bytes_sent; }
+
+    /** Returns the number of messages written to this connection. */
+    std::uint64_t MessagesSent() const { return m_messages_sent; }
+
+    /** Returns the record of the last TURN_UPDATE sent on this connection,
+      * against which the next one can be delta encoded. A new connection has
+      * no record, so the first update sent on it is always complete. */
+    ObjectDeltaBase& TurnUpdateDeltaBase() { return m_turn_update_delta_base; }
+
+    /** Starts the connection reading incoming messages on its socket.  The
+        connection's socket is only used on its strand from then on. */
     void Start();
 
     /** Sends \a synchronous message to out on the connection. */
@@ -313,12 +367,13 @@ private:
                                   boost::system::error_code error);
 
     boost::asio::io_context&        m_service;
+    boost::asio::io_context::strand m_strand;
     boost::optional<boost::asio::ip::tcp::socket> m_socket;
     Message::HeaderBuffer           m_incoming_header_buffer = {};
     Message                         m_incoming_message;
     Message::HeaderBuffer           m_outgoing_header = {};
     std::list<Message>              m_outgoing_messages;
-    int                             m_ID = Networking::INVALID_PLAYER_ID;
+    std::atomic<int>                m_ID = Networking::INVALID_PLAYER_ID;
     std::string                     m_player_name;
     bool                            m_new_connection = true;
     Networking::ClientType          m_client_type = Networking::ClientType::INVALID_CLIENT_TYPE;
@@ -326,7 +381,11 @@ private:
     bool                            m_authenticated = false;
     Networking::AuthRoles           m_roles;
     boost::uuids::uuid              m_cookie = boost::uuids::nil_uuid();
-    bool                            m_valid = true;
+    std::atomic<bool>               m_valid = true;
+    ObjectDeltaBase                 m_turn_update_delta_base;
+    std::atomic<std::uint64_t>      m_bytes_sent = 0;
+    std::atomic<std::uint64_t>      m_messages_sent = 0;
+    int                             m_max_message_size = 0;     ///< largest message accepted from the client, or 0 for no limit
 
     MessageAndConnectionFn          m_nonplayer_message_callback;
     MessageAndConnectionFn          m_player_message_callback;
@@ -719,6 +719,97 @@ namespace {
         return planet->ID();
     }
 
+    template <typename T>
+    auto VectorFrom(const py::object& values) -> std::vector<T>
+    { return {py::stl_input_iterator<T>(values), py::stl_input_iterator<T>()}; }
+
+    /** Creates an unnamed system for each of the corresponding elements of
+        the sequences \a star_types, \a xs and \a ys, and returns a list of
+        their IDs, with INVALID_OBJECT_ID for each one that couldn't be
+        created, or an empty list if the sequences differ in length. */
+    auto CreateSystems(const py::object& star_types, const py::object& xs, const py::object& ys) -> py::list
+    {
+        const auto star_types_vec = VectorFrom<StarType>(star_types);
+        const auto xs_vec = VectorFrom<double>(xs);
+        const auto ys_vec = VectorFrom<double>(ys);
+        py::list py_systems;
+        if (xs_vec.size() != star_types_vec.size() || ys_vec.size() != star_types_vec.size()) {
+            ErrorLogger() << "CreateSystems : Got " << star_types_vec.size() << " star types for "
+                          << xs_vec.size() << " x and " << ys_vec.size() << " y coordinates";
+            return py_systems;
+        }
+        GetUniverse().ReserveObjectIDs(star_types_vec.size());
+        for (std::size_t i = 0; i < star_types_vec.size(); ++i)
+            py_systems.append(CreateSystem(star_types_vec[i], "", xs_vec[i], ys_vec[i]));
+        return py_systems;
+    }
+
+    /** Creates an unnamed planet for each of the corresponding elements of
+        the sequences \a sizes, \a planet_types, \a system_ids and \a orbits,
+        and returns a list of their IDs, with INVALID_OBJECT_ID for each one
+        that couldn't be created, or an empty list if the sequences differ in
+        length. */
+    auto CreatePlanets(const py::object& sizes, const py::object& planet_types,
+                       const py::object& system_ids, const py::object& orbits) -> py::list
+    {
+        const auto sizes_vec = VectorFrom<PlanetSize>(sizes);
+        const auto planet_types_vec = VectorFrom<PlanetType>(planet_types);
+        const auto system_ids_vec = VectorFrom<int>(system_ids);
+        const auto orbits_vec = VectorFrom<int>(orbits);
+        py::list py_planets;
+        if (planet_types_vec.size() != sizes_vec.size() || system_ids_vec.size() != sizes_vec.size() ||
+            orbits_vec.size() != sizes_vec.size())
+        {
+            ErrorLogger() << "CreatePlanets : Got " << sizes_vec.size() << " sizes for " << planet_types_vec.size()
+                          << " types, " << system_ids_vec.size() << " systems and " << orbits_vec.size() << " orbits";
+            return py_planets;
+        }
+        GetUniverse().ReserveObjectIDs(sizes_vec.size());
+        for (std::size_t i = 0; i < sizes_vec.size(); ++i)
+            py_planets.append(CreatePlanet(sizes_vec[i], planet_types_vec[i], system_ids_vec[i], orbits_vec[i], ""));
+        return py_planets;
+    }
+
+    auto PositionsFrom(const py::object& positions) -> std::vector<std::pair<double, double>>
+    {
+        std::vector<std::pair<double, double>> retval;
+        for (py::stl_input_iterator<py::object> it(positions), end; it != end; ++it)
+            retval.emplace_back(py::extract<double>((*it)[0]), py::extract<double>((*it)[1]));
+        return retval;
+    }
+
+    auto DelaunayTriangulation(const py::object& positions) -> py::list
+    {
+        py::list py_triangles;
+        for (const auto& [a, b, c] : DelauneyTriangles(PositionsFrom(positions)))
+            py_triangles.append(py::make_tuple(a, b, c));
+        return py_triangles;
+    }
+
+    auto PositionsNearestNeighbours(const py::object& positions, int k) -> py::list
+    {
+        py::list py_neighbours;
+        for (const auto& neighbours : NearestNeighbours(PositionsFrom(positions), std::max(0, k))) {
+            py::list py_point_neighbours;
+            for (int neighbour : neighbours)
+                py_point_neighbours.append(neighbour);
+            py_neighbours.append(py_point_neighbours);
+        }
+        return py_neighbours;
+    }
+
+    auto SystemsNearestByJumps(const py::object& source_system_ids) -> py::dict
+    {
+        py::dict py_nearest;
+        for (const auto& [system_id, sources] : NearestSystemsByJumps(VectorFrom<int>(source_system_ids))) {
+            py::list py_sources;
+            for (int source : sources)
+                py_sources.append(source);
+            py_nearest[system_id] = py_sources;
+        }
+        return py_nearest;
+    }
+
     auto CreateBuilding(const std::string& building_type, int planet_id, int empire_id) -> int
     {
         auto planet = Objects().get<Planet>(planet_id);
@@ -1092,6 +1183,7 @@ namespace {
         // add the starlane on both ends
         from_sys->AddStarlane(to_sys_id);
         to_sys->AddStarlane(from_sys_id);
+        GetUniverse().StarlaneTopologyChanged();
     }
 
     void SystemRemoveStarlane(int from_sys_id, int to_sys_id)
@@ -1110,6 +1202,7 @@ namespace {
         // remove the starlane from both ends
         from_sys->RemoveStarlane(to_sys_id);
         to_sys->RemoveStarlane(from_sys_id);
+        GetUniverse().StarlaneTopologyChanged();
     }
 
     // Wrapper for Planet class member functions
@@ -1366,10 +1459,15 @@ namespace FreeOrionPython {
         py::def("set_universe_width",               +[](double width) { GetUniverse().SetUniverseWidth(width); });
         py::def("linear_distance",                  +[](int system1_id, int system2_id) -> double { return GetUniverse().GetPathfinder()->LinearDistance(system1_id, system2_id, Objects()); });
         py::def("jump_distance",                    +[](int system1_id, int system2_id) -> int { return GetUniverse().GetPathfinder()->JumpDistanceBetweenSystems(system1_id, system2_id); });
+        py::def("delaunay_triangulation",           DelaunayTriangulation, "Returns a list of the triangles of a Delaunay triangulation of the sequence of (x, y) positions, each a tuple of the indices of its corners in the sequence.");
+        py::def("nearest_neighbours",               PositionsNearestNeighbours, "Returns a list with, for each of the sequence of (x, y) positions, a list of the indices of the k (int) others nearest to it, nearest first.");
+        py::def("systems_nearest_by_jumps",         SystemsNearestByJumps, "Returns a dict from the id of each system connected by starlanes to any of the systems in the sequence of ids, to a list of those systems the fewest jumps from it.");
         py::def("get_all_objects",                  GetAllObjects);
         py::def("get_systems",                      GetSystems);
         py::def("create_system",                    CreateSystem);
         py::def("create_planet",                    CreatePlanet);
+        py::def("create_systems",                   CreateSystems, "Creates unnamed systems with the star types (starType) at the x and y coordinates (float) in the three sequences, and returns a list of their ids (int), each invalid_object() if that system could not be created.");
+        py::def("create_planets",                   CreatePlanets, "Creates unnamed planets with the sizes (planetSize) and types (planetType) in the orbits (int) of the systems (int) in the four sequences, and returns a list of their ids (int), each invalid_object() if that planet could not be created.");
         py::def("create_building",                  CreateBuilding);
         py::def("create_fleet",                     CreateFleet);
         py::def("create_ship",                      CreateShip);
@@ -1385,6 +1483,7 @@ namespace FreeOrionPython {
         py::def("sys_get_star_type",                SystemGetStarType);
         py::def("sys_set_star_type",                SystemSetStarType);
         py::def("sys_get_num_orbits",               SystemGetNumOrbits);
+        py::def("sys_default_num_orbits",           +[]() -> int { return SYSTEM_ORBITS; }, "Returns the number of orbits (int) of newly created systems.");
         py::def("sys_free_orbits",                  SystemFreeOrbits);
         py::def("sys_orbit_occupied",               SystemOrbitOccupied);
         py::def("sys_orbit_of_planet",              SystemOrbitOfPlanet);
@@ -0,0 +1,117 @@
+#include "TurnReplay.h"
+
+#include "../Empire/EmpireManager.h"
+#include "../Empire/Supply.h"
+#include "../universe/Universe.h"
+#include "../util/Directories.h"
+#include "../util/Logger.h"
+#include "../util/OrderSet.h"
+#include "../util/Serialize.h"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/nvp.hpp>
+
+#include <stdexcept>
+
+namespace fs = boost::filesystem;
+
+namespace {
+    fs::path TurnOrdersPath(const fs::path& dir, int turn)
+    { return dir / ("orders_" + std::to_string(turn) + ".xml"); }
+}
+
+TurnDigest ComputeTurnDigest(const Universe& universe, const EmpireManager& empires,
+                             const SupplyManager& supply)
+{
+    // the dumps include all the state that turn processing changes, in an
+    // order that doesn't depend on how the processing was scheduled
+    TurnDigest retval;
+
+    boost::hash_combine(retval.universe, universe.Objects().Dump());
+    for (const auto& [empire_id, object_visibilities] : universe.GetEmpireObjectVisibility()) {
+        boost::hash_combine(retval.universe, empire_id);
+        for (const auto& [object_id, vis] : object_visibilities) {
+            boost::hash_combine(retval.universe, object_id);
+            boost::hash_combine(retval.universe, static_cast<int>(vis));
+        }
+    }
+
+    boost::hash_combine(retval.empires, empires.Dump());
+    boost::hash_combine(retval.supply, supply.Dump());
+
+    return retval;
+}
+
+void WriteTurnOrders(const fs::path& dir, int turn,
+                     const std::map<int, std::shared_ptr<OrderSet>>& empire_orders)
+{
+    try {
+        fs::create_directories(dir);
+        fs::ofstream ofs(TurnOrdersPath(dir, turn));
+        if (!ofs) {
+            ErrorLogger() << "WriteTurnOrders unable to open " << PathToString(TurnOrdersPath(dir, turn));
+            return;
+        }
+
+        freeorion_xml_oarchive oa(ofs);
+        int num_empires = static_cast<int>(empire_orders.size());
+        oa << BOOST_SERIALIZATION_NVP(num_empires);
+        for (const auto& [id, orders] : empire_orders) {
+            int empire_id = id;
+            oa << BOOST_SERIALIZATION_NVP(empire_id);
+            Serialize(oa, orders ? *orders : OrderSet());
+        }
+    } catch (const std::exception& e) {
+        ErrorLogger() << "WriteTurnOrders unable to record orders of turn " << turn << ": " << e.what();
+    }
+}
+
+std::map<int, std::shared_ptr<OrderSet>> ReadTurnOrders(const fs::path& dir, int turn) {
+    fs::ifstream ifs(TurnOrdersPath(dir, turn));
+    if (!ifs)
+        throw std::runtime_error("No recorded orders for turn " + std::to_string(turn) +
+                                 " in " + PathToString(dir));
+
+    std::map<int, std::shared_ptr<OrderSet>> retval;
+    freeorion_xml_iarchive ia(ifs);
+    int num_empires = 0;
+    ia >> BOOST_SERIALIZATION_NVP(num_empires);
+    for (int i = 0; i < num_empires; ++i) {
+        int empire_id = ALL_EMPIRES;
+        ia >> BOOST_SERIALIZATION_NVP(empire_id);
+        auto orders = std::make_shared<OrderSet>();
+        Deserialize(ia, *orders);
+        retval.emplace(empire_id, std::move(orders));
+    }
+    return retval;
+}
+
+void AppendTurnDigest(const fs::path& path, int turn, const TurnDigest& digest) {
+    const bool write_header = !fs::exists(path);
+    fs::ofstream ofs(path, std::ios_base::app);
+    if (!ofs) {
+        ErrorLogger() << "AppendTurnDigest unable to open " << PathToString(path);
+        return;
+    }
+    if (write_header)
+        ofs << "turn\tuniverse\tempires\tsupply\n";
+    ofs << turn << '\t' << digest.universe << '\t' << digest.empires << '\t' << digest.supply << '\n';
+}
+
+std::map<int, TurnDigest> ReadTurnDigests(const fs::path& path) {
+    std::map<int, TurnDigest> retval;
+    fs::ifstream ifs(path);
+    std::string header;
+    if (!ifs || !std::getline(ifs, header))
+        return retval;
+
+    // a turn recorded again, such as after reloading a save, replaces the
+    // earlier record of it
+    int turn = 0;
+    TurnDigest digest;
+    while (ifs >> turn >> digest.universe >> digest.empires >> digest.supply)
+        retval[turn] = digest;
+    return retval;
+}
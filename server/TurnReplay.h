@@ -0,0 +1,56 @@
+#ifndef _TurnReplay_h_
+#define _TurnReplay_h_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+class EmpireManager;
+class OrderSet;
+class SupplyManager;
+class Universe;
+
+/** Digest of the game state after processing a turn, used to check that
+  * replaying the turn with the same orders gives the same result. */
+struct TurnDigest {
+    std::size_t universe = 0;   ///< objects and their visibility to empires
+    std::size_t empires = 0;
+    std::size_t supply = 0;
+
+    bool operator==(const TurnDigest& rhs) const
+    { return universe == rhs.universe && empires == rhs.empires && supply == rhs.supply; }
+    bool operator!=(const TurnDigest& rhs) const
+    { return !(*this == rhs); }
+};
+
+/** Returns the digest of the current state of \a universe, \a empires and
+  * \a supply. */
+TurnDigest ComputeTurnDigest(const Universe& universe, const EmpireManager& empires,
+                             const SupplyManager& supply);
+
+/** Writes the orders of each empire issued for turn \a turn to a file in
+  * directory \a dir, from which ReadTurnOrders can read them. */
+void WriteTurnOrders(const boost::filesystem::path& dir, int turn,
+                     const std::map<int, std::shared_ptr<OrderSet>>& empire_orders);
+
+/** Returns the orders of each empire for turn \a turn written to directory
+  * \a dir by WriteTurnOrders. Throws std::runtime_error if there are none. */
+std::map<int, std::shared_ptr<OrderSet>> ReadTurnOrders(const boost::filesystem::path& dir, int turn);
+
+/** Appends \a digest of the state after processing turn \a turn to the
+  * digests file \a path, as a line of tab-separated text. */
+void AppendTurnDigest(const boost::filesystem::path& path, int turn, const TurnDigest& digest);
+
+/** Returns the digests by turn in the digests file \a path, or an empty map
+  * if it can't be read. */
+std::map<int, TurnDigest> ReadTurnDigests(const boost::filesystem::path& path);
+
+/** Names of the files in a turn record directory. */
+constexpr const char* TURN_DIGESTS_FILENAME = "digests.tsv";
+constexpr const char* REPLAY_DIGESTS_FILENAME = "replay_digests.tsv";
+
+
+#endif
@@ -5,6 +5,7 @@
 #include "../util/MultiplayerCommon.h"
 #include "../util/GameRules.h"
 #include "../util/AppInterface.h"
+#include "../util/ThreadPool.h"
 #include "../Empire/Empire.h"
 #include "../Empire/EmpireManager.h"
 
@@ -12,7 +13,9 @@
 #include "../universe/System.h"
 #include "../universe/Species.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 
 namespace {
     DeclareThreadSafeLogger(effects);
@@ -69,6 +72,9 @@ namespace Delauney {
         bool PointInCircumCircle(const Delauney::DTPoint &p);
         const std::vector<int>& Verts() {return verts;}
 
+        ///< returns the largest x coordinate of any point within the circumcircle of the triangle
+        double CircumCircleMaxX() const { return centre.x + std::sqrt(std::max(0.0, radius2)); }
+
     private:
         std::vector<int>    verts;      ///< indices of vertices of triangle
         Delauney::DTPoint   centre;     ///< location of circumcentre of triangle
@@ -135,53 +141,51 @@ namespace Delauney {
 
 
 
-    /** Runs a Delauney Triangulation on a set of 2D points corresponding
-      * to the locations of the systems in \a systems_vec */
-    std::list<Delauney::DTTriangle> DelauneyTriangulate(
-        const std::vector<std::shared_ptr<System>> &systems_vec)
+    /** Runs a Delauney Triangulation on \a points_vec, which must all lie
+      * within the square from (0, 0) to (\a width, \a width).  Returned
+      * triangles may have corners with indices up to points_vec.size() + 2,
+      * which are the corners of a triangle covering all the points. */
+    std::list<Delauney::DTTriangle> DelauneyTriangulate(std::vector<Delauney::DTPoint> points_vec, double width)
     {
-        // ensure a useful list of systems was passed...
-        if (systems_vec.empty()) {
-            ErrorLogger() << "Attempted to run Delauney Triangulation on empty array of systems";
+        // ensure a useful list of points was passed...
+        if (points_vec.empty()) {
+            ErrorLogger() << "Attempted to run Delauney Triangulation on empty array of points";
             return std::list<Delauney::DTTriangle>();
         }
 
+        if (points_vec.size() + 3 > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            ErrorLogger() << "Attempted to run Delauney Triangulation on " << points_vec.size()
+                          << " points.  The limit is " << std::numeric_limits<int>::max() - 3;
+            return std::list<Delauney::DTTriangle>();
+        }
 
-        // extract systems positions from system objects.
-        std::vector<Delauney::DTPoint> points_vec;
-        points_vec.reserve(systems_vec.size() + 3);
-        for (auto& system : systems_vec)
-            points_vec.push_back({system->X(), system->Y()});
-
-        // entries in points_vec correspond to entries in \a systems_vec
-        // so that the index of an item in systems_vec will have a
-        // corresponding points at that index in points_vec
-
+        // insert points in order of increasing x, so that once the current
+        // point is to the right of a triangle's circumcircle, no later point
+        // can be in it, and the triangle needn't be checked again
+        std::vector<int> insertion_order(points_vec.size());
+        std::iota(insertion_order.begin(), insertion_order.end(), 0);
+        std::sort(insertion_order.begin(), insertion_order.end(),
+                  [&points_vec](int lhs, int rhs) { return points_vec[lhs].x < points_vec[rhs].x; });
 
         // add points for covering triangle. the point positions should be big
         // enough to form a triangle that encloses all the points in points_vec
         // (or at least one whose circumcircle covers all points)
         points_vec.push_back({-1.0, -1.0});
-        points_vec.push_back({2.0 * (GetUniverse().UniverseWidth() + 1.0), -1.0});
-        points_vec.push_back({-1.0, 2.0 * (GetUniverse().UniverseWidth() + 1.0)});
+        points_vec.push_back({2.0 * (width + 1.0), -1.0});
+        points_vec.push_back({-1.0, 2.0 * (width + 1.0)});
 
 
         // initialize triangle_list.
         // add last three points into the first triangle, the "covering triangle"
         std::list<Delauney::DTTriangle> triangle_list;
+        std::list<Delauney::DTTriangle> completed_triangle_list;
         int num_points_in_vec = points_vec.size();
         triangle_list.push_front({num_points_in_vec - 1, num_points_in_vec - 2,
                                   num_points_in_vec - 3, points_vec});
 
-        if (points_vec.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
-            ErrorLogger() << "Attempted to run Delauney Triangulation on " << points_vec.size()
-                          << " points.  The limit is " << std::numeric_limits<int>::max();
-            return std::list<Delauney::DTTriangle>();
-        }
-
-        // loop through points generated from systems, excluding the final
-        // 3 points added for the covering triangle
-        for (std::size_t n = 0; n < points_vec.size() - 3; n++) {
+        // loop through points, excluding the final 3 points added for the
+        // covering triangle
+        for (int n : insertion_order) {
             // list of indices in vector of points extracted from removed
             // triangles that need to be retriangulated
             std::list<Delauney::SortValInt> point_idx_list;
@@ -195,6 +199,14 @@ namespace Delauney {
                 // get current triangle
                 Delauney::DTTriangle& tri = *cur_tri_it;
 
+                // triangles entirely to the left of the current point are final
+                if (tri.CircumCircleMaxX() < cur_point.x) {
+                    auto next_tri_it = std::next(cur_tri_it);
+                    completed_triangle_list.splice(completed_triangle_list.end(), triangle_list, cur_tri_it);
+                    cur_tri_it = next_tri_it;
+                    continue;
+                }
+
                 // check if point to be added to triangulation is within the
                 // circumcircle for the current triangle
                 if (!tri.PointInCircumCircle(cur_point)) {
@@ -258,7 +270,7 @@ namespace Delauney {
 
             // add triangle for last and first points and n
             triangle_list.push_front(
-                {static_cast<int>(n), (point_idx_list.front()).num, (point_idx_list.back()).num, points_vec});
+                {n, (point_idx_list.front()).num, (point_idx_list.back()).num, points_vec});
 
 
             // go through list of points, making new triangles out of them
@@ -269,18 +281,37 @@ namespace Delauney {
                 int num2 = num;
                 num = idx_list_it->num;
 
-                triangle_list.push_front({static_cast<int>(n), num2, num, points_vec});
+                triangle_list.push_front({n, num2, num, points_vec});
 
                 ++idx_list_it;
             } // end while
 
         } // end for
 
+        triangle_list.splice(triangle_list.begin(), completed_triangle_list);
+
         DebugLogger() << "DelauneyTriangulate generated list of "
                       << triangle_list.size() << " triangles";
 
         return triangle_list;
     }
+
+    /** Runs a Delauney Triangulation on a set of 2D points corresponding
+      * to the locations of the systems in \a systems_vec */
+    std::list<Delauney::DTTriangle> DelauneyTriangulate(
+        const std::vector<std::shared_ptr<System>> &systems_vec)
+    {
+        // extract systems positions from system objects.
+        // entries in points_vec correspond to entries in \a systems_vec
+        // so that the index of an item in systems_vec will have a
+        // corresponding points at that index in points_vec
+        std::vector<Delauney::DTPoint> points_vec;
+        points_vec.reserve(systems_vec.size() + 3);
+        for (auto& system : systems_vec)
+            points_vec.push_back({system->X(), system->Y()});
+
+        return DelauneyTriangulate(std::move(points_vec), GetUniverse().UniverseWidth());
+    }
 }
 
 namespace {
@@ -766,35 +797,190 @@ void GenerateStarlanes(int max_jumps_between_systems, int max_starlane_length) {
     GetUniverse().InitializeSystemGraph(Empires(), Objects());
 }
 
+std::vector<std::array<int, 3>> DelauneyTriangles(const std::vector<std::pair<double, double>>& points) {
+    std::vector<std::array<int, 3>> retval;
+    if (points.size() < 3)
+        return retval;
+
+    // translate points into the square from the origin the triangulation expects
+    auto [min_x_it, max_x_it] = std::minmax_element(points.begin(), points.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    auto [min_y_it, max_y_it] = std::minmax_element(points.begin(), points.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+    double min_x = min_x_it->first;
+    double min_y = min_y_it->second;
+    double width = std::max(max_x_it->first - min_x, max_y_it->second - min_y);
+
+    std::vector<Delauney::DTPoint> points_vec;
+    points_vec.reserve(points.size() + 3);
+    for (const auto& [x, y] : points)
+        points_vec.push_back({x - min_x, y - min_y});
+
+    int num_points = points.size();
+    for (auto& tri : Delauney::DelauneyTriangulate(std::move(points_vec), width)) {
+        const auto& verts = tri.Verts();
+        // skip triangles with corners of the covering triangle
+        if (std::any_of(verts.begin(), verts.end(), [num_points](int vert) { return vert < 0 || vert >= num_points; }))
+            continue;
+        retval.push_back({verts[0], verts[1], verts[2]});
+    }
+    return retval;
+}
+
+std::vector<std::vector<int>> NearestNeighbours(const std::vector<std::pair<double, double>>& points, std::size_t k) {
+    std::vector<std::vector<int>> retval(points.size());
+    if (points.size() < 2 || k == 0)
+        return retval;
+    k = std::min(k, points.size() - 1);
+
+    // bucket points into a square grid of cells, about two points per cell
+    auto [min_x_it, max_x_it] = std::minmax_element(points.begin(), points.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    auto [min_y_it, max_y_it] = std::minmax_element(points.begin(), points.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+    double min_x = min_x_it->first;
+    double min_y = min_y_it->second;
+    double width = std::max({max_x_it->first - min_x, max_y_it->second - min_y, 1.0});
+    int cells_per_side = std::max(1, static_cast<int>(std::sqrt(points.size() / 2.0)));
+    double cell_size = width / cells_per_side;
+
+    auto cell_of = [cells_per_side, cell_size](double offset)
+    { return std::clamp(static_cast<int>(offset / cell_size), 0, cells_per_side - 1); };
+
+    std::vector<std::vector<int>> cells(cells_per_side * cells_per_side);
+    for (std::size_t i = 0; i < points.size(); ++i)
+        cells[cell_of(points[i].second - min_y) * cells_per_side + cell_of(points[i].first - min_x)].push_back(i);
+
+    std::vector<std::pair<double, int>> candidates;  // squared distance and index
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const auto& [x, y] = points[i];
+        int cell_x = cell_of(x - min_x);
+        int cell_y = cell_of(y - min_y);
+        candidates.clear();
+
+        // search successive square rings of cells around the point's cell.
+        // points outside the rings searched so far are at least ring *
+        // cell_size away, so stop once the k nearest found are closer
+        for (int ring = 0; ring <= cells_per_side; ++ring) {
+            for (int cy = std::max(0, cell_y - ring); cy <= std::min(cells_per_side - 1, cell_y + ring); ++cy) {
+                bool edge_row = std::abs(cy - cell_y) == ring;
+                for (int cx = std::max(0, cell_x - ring); cx <= std::min(cells_per_side - 1, cell_x + ring); ++cx) {
+                    if (!edge_row && std::abs(cx - cell_x) != ring)
+                        continue;
+                    for (int j : cells[cy * cells_per_side + cx]) {
+                        if (static_cast<std::size_t>(j) == i)
+                            continue;
+                        double dx = points[j].first - x;
+                        double dy = points[j].second - y;
+                        candidates.emplace_back(dx * dx + dy * dy, j);
+                    }
+                }
+            }
+
+            if (candidates.size() < k)
+                continue;
+            std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+            double searched_radius = ring * cell_size;
+            if (candidates[k - 1].first <= searched_radius * searched_radius)
+                break;
+        }
+
+        std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+        retval[i].reserve(k);
+        for (std::size_t n = 0; n < k; ++n)
+            retval[i].push_back(candidates[n].second);
+    }
+    return retval;
+}
+
+std::map<int, std::vector<int>> NearestSystemsByJumps(const std::vector<int>& source_system_ids) {
+    // breadth-first search outwards from all sources at once, one jump at a
+    // time, so each system is first reached from its nearest sources
+    std::map<int, std::vector<int>> retval;
+    std::vector<int> frontier;
+    for (int system_id : source_system_ids) {
+        if (!Objects().get<System>(system_id) || retval.count(system_id))
+            continue;
+        retval[system_id] = {system_id};
+        frontier.push_back(system_id);
+    }
+
+    while (!frontier.empty()) {
+        std::map<int, std::vector<int>> next_frontier;
+        for (int system_id : frontier) {
+            auto system = Objects().get<System>(system_id);
+            if (!system)
+                continue;
+            const auto& sources = retval[system_id];
+            for (const auto& lane : system->StarlanesWormholes()) {
+                if (retval.count(lane.first))
+                    continue;
+                auto& lane_end_sources = next_frontier[lane.first];
+                lane_end_sources.insert(lane_end_sources.end(), sources.begin(), sources.end());
+            }
+        }
+
+        frontier.clear();
+        for (auto& [system_id, sources] : next_frontier) {
+            std::sort(sources.begin(), sources.end());
+            sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+            retval[system_id] = std::move(sources);
+            frontier.push_back(system_id);
+        }
+    }
+    return retval;
+}
+
 void SetActiveMetersToTargetMaxCurrentValues(ObjectMap& object_map) {
     TraceLogger(effects) << "SetActiveMetersToTargetMaxCurrentValues";
+    std::vector<UniverseObject*> objects;
+    objects.reserve(object_map.size());
+    for (const auto& object : object_map.all())
+        objects.push_back(object.get());
+
     // check for each pair of meter types.  if both exist, set active
-    // meter current value equal to target meter current value.
-    for (const auto& object : object_map.all()) {
-        TraceLogger(effects) << "  object: " << object->Name() << " (" << object->ID() << ")";
-        for (auto& entry : AssociatedMeterTypes()) {
-            if (Meter* meter = object->GetMeter(entry.first)) {
-                if (Meter* targetmax_meter = object->GetMeter(entry.second)) {
-                    TraceLogger(effects) << "    meter: " << entry.first
-                                         << "  before: " << meter->Current()
-                                         << "  set to: " << targetmax_meter->Current();
-                    meter->SetCurrent(targetmax_meter->Current());
+    // meter current value equal to target meter current value.  this only
+    // changes the object's own meters, so is done for many objects at once.
+    constexpr std::size_t OBJECTS_PER_TASK = 256;
+    TaskBatch batch("SetActiveMetersToTargetMaxCurrentValues");
+    for (std::size_t first = 0; first < objects.size(); first += OBJECTS_PER_TASK) {
+        batch.Post([&objects, first, last{std::min(objects.size(), first + OBJECTS_PER_TASK)}]() {
+            for (std::size_t idx = first; idx < last; ++idx) {
+                auto* object = objects[idx];
+                TraceLogger(effects) << "  object: " << object->Name() << " (" << object->ID() << ")";
+                for (auto& entry : AssociatedMeterTypes()) {
+                    if (Meter* meter = object->GetMeter(entry.first)) {
+                        if (Meter* targetmax_meter = object->GetMeter(entry.second)) {
+                            TraceLogger(effects) << "    meter: " << entry.first
+                                                 << "  before: " << meter->Current()
+                                                 << "  set to: " << targetmax_meter->Current();
+                            meter->SetCurrent(targetmax_meter->Current());
+                        }
+                    }
                 }
             }
-        }
+        });
     }
+    batch.Wait();
 }
 
 void SetNativePopulationValues(ObjectMap& object_map) {
-    for (const auto& object : object_map.all()) {
-        Meter* meter = object->GetMeter(MeterType::METER_POPULATION);
-        Meter* targetmax_meter = object->GetMeter(MeterType::METER_TARGET_POPULATION);
+    // only planets have population meters, so only they need be checked.
+    // they are in order of increasing ID, as they would be among all objects,
+    // so each gets the same random factor whichever objects there are.
+    std::vector<std::pair<Meter*, const Meter*>> native_meters;
+    for (const auto& planet : object_map.all<Planet>()) {
+        Meter* meter = planet->GetMeter(MeterType::METER_POPULATION);
+        const Meter* targetmax_meter = planet->GetMeter(MeterType::METER_TARGET_POPULATION);
         // only applies to unowned planets
-        if (meter && targetmax_meter && object->Unowned()) {
-            double r = RandZeroToOne();
-            double factor = (0.1 < r) ? r : 0.1;
-            meter->SetCurrent(targetmax_meter->Current() * factor);
-        }
+        if (meter && targetmax_meter && planet->Unowned())
+            native_meters.emplace_back(meter, targetmax_meter);
+    }
+
+    for (auto& [meter, targetmax_meter] : native_meters) {
+        double r = RandZeroToOne();
+        double factor = (0.1 < r) ? r : 0.1;
+        meter->SetCurrent(targetmax_meter->Current() * factor);
     }
 }
 
@@ -2,8 +2,11 @@
 #define _UniverseGenerator_h_
 
 
+#include <array>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 class Empire;
 class ObjectMap;
@@ -21,6 +24,18 @@ void SetNativePopulationValues(ObjectMap& object_map);
 //! Creates starlanes and adds them systems already generated.
 void GenerateStarlanes(int max_jumps_between_systems, int max_starlane_length);
 
+//! Returns the triangles of a Delauney triangulation of \a points, each as the
+//! indices in \a points of its corners.
+std::vector<std::array<int, 3>> DelauneyTriangles(const std::vector<std::pair<double, double>>& points);
+
+//! Returns, for each of \a points, the indices in \a points of the \a k
+//! others nearest to it, nearest first.
+std::vector<std::vector<int>> NearestNeighbours(const std::vector<std::pair<double, double>>& points, std::size_t k);
+
+//! Returns, for each system connected by starlanes to any of
+//! \a source_system_ids, those sources that are the fewest jumps from it.
+std::map<int, std::vector<int>> NearestSystemsByJumps(const std::vector<int>& source_system_ids);
+
 //! Sets empire homeworld
 //! This includes setting ownership, capital, species, preferred environment
 //! (planet type) for the species
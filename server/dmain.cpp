@@ -1,3 +1,4 @@
+#include "ObserverRelay.h"
 #include "ServerApp.h"
 
 #include <codecvt>
@@ -7,6 +8,7 @@
 #include "../util/Directories.h"
 #include "../util/i18n.h"
 #include "../util/Logger.h"
+#include "../util/ScopedTimer.h"
 #include "../util/Version.h"
 
 #include <boost/filesystem/fstream.hpp>
@@ -63,20 +65,60 @@ int wmain(int argc, wchar_t* argv[], wchar_t* envp[]) {
         GetOptionsDB().Add<int>("network.server.cookies.expire-minutes",                UserStringNop("OPTIONS_DB_COOKIES_EXPIRE"),             15);
         GetOptionsDB().Add<bool>("network.server.publish-statistics",                   UserStringNop("OPTIONS_DB_PUBLISH_STATISTICS"),         true);
         GetOptionsDB().Add<bool>("network.server.publish-seed",                         UserStringNop("OPTIONS_DB_PUBLISH_SEED"),               true);
+        GetOptionsDB().Add<int>("network.server.sitrep-history.turns",                  UserStringNop("OPTIONS_DB_SITREP_HISTORY_TURNS"),       0,
+                                RangedValidator<int>(0, 10000));
         GetOptionsDB().Add("network.server.binary.enabled",                             UserStringNop("OPTIONS_DB_SERVER_BINARY_SERIALIZATION"),true);
+        GetOptionsDB().Add<bool>("network.server.turn-update.delta",                    UserStringNop("OPTIONS_DB_SERVER_TURN_UPDATE_DELTA"),   false);
+        GetOptionsDB().Add<int>("network.server.compression.threshold",                 UserStringNop("OPTIONS_DB_SERVER_COMPRESSION_THRESHOLD"),1 << 16,
+                                RangedValidator<int>(0, 1 << 30));
         GetOptionsDB().Add<std::string>("network.server.turn-timeout.first-turn-time",  UserStringNop("OPTIONS_DB_FIRST_TURN_TIME"),            "");
         GetOptionsDB().Add<int>("network.server.turn-timeout.max-interval",             UserStringNop("OPTIONS_DB_TIMEOUT_INTERVAL"),           0);
         GetOptionsDB().Add<bool>("network.server.turn-timeout.fixed-interval",          UserStringNop("OPTIONS_DB_TIMEOUT_FIXED_INTERVAL"),     false);
+        GetOptionsDB().Add<double>("network.server.turn-processing.budget",             UserStringNop("OPTIONS_DB_TURN_PROCESSING_BUDGET"),     0.0,
+                                   RangedValidator<double>(0.0, 3600.0));
         GetOptionsDB().Add<std::string>("setup.game.uid",                               UserStringNop("OPTIONS_DB_GAMESETUP_UID"),              "");
         GetOptionsDB().Add<int>("network.server.client-message-size.max",               UserStringNop("OPTIONS_DB_CLIENT_MESSAGE_SIZE_MAX"),    0);
+        GetOptionsDB().Add<int>("network.server.io-threads",                            UserStringNop("OPTIONS_DB_SERVER_IO_THREADS"),          1,
+                                RangedValidator<int>(0, 16));
         GetOptionsDB().Add<bool>("network.server.drop-empire-ready",                    UserStringNop("OPTIONS_DB_DROP_EMPIRE_READY"),          true);
+        GetOptionsDB().Add<std::string>("network.relay.upstream",                       UserStringNop("OPTIONS_DB_RELAY_UPSTREAM"),             "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<int>("network.relay.upstream.port",                          UserStringNop("OPTIONS_DB_RELAY_UPSTREAM_PORT"),        12346,
+                                RangedValidator<int>(1025, 65535));
+        GetOptionsDB().Add<std::string>("network.relay.player-name",                    UserStringNop("OPTIONS_DB_RELAY_PLAYER_NAME"),          "Relay");
+        GetOptionsDB().Add<std::string>("network.relay.password",                       UserStringNop("OPTIONS_DB_RELAY_PASSWORD"),             "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<bool>("resource.reload.enabled",                             UserStringNop("OPTIONS_DB_CONTENT_RELOAD"),             false);
+        GetOptionsDB().Add<int>("combat.benchmark.repetitions",                         UserStringNop("OPTIONS_DB_COMBAT_BENCHMARK_REPETITIONS"),0,
+                                RangedValidator<int>(0, 10000));
+        GetOptionsDB().Add<std::string>("turn.benchmark.output",                        UserStringNop("OPTIONS_DB_TURN_BENCHMARK_OUTPUT"),      "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<std::string>("network.server.metrics.path",                  UserStringNop("OPTIONS_DB_SERVER_METRICS_PATH"),        "");
+        GetOptionsDB().Add<bool>("network.server.universe-generation.report",           UserStringNop("OPTIONS_DB_SERVER_UNIVERSE_GENERATION_REPORT"), false);
+        GetOptionsDB().Add<int>("server.simulation.turns",                              UserStringNop("OPTIONS_DB_SERVER_SIMULATION_TURNS"),    0,
+                                RangedValidator<int>(0, 100000),    false);
+        GetOptionsDB().Add<std::string>("server.simulation.results.path",               UserStringNop("OPTIONS_DB_SERVER_SIMULATION_RESULTS_PATH"), "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<std::string>("server.turn.record.path",                      UserStringNop("OPTIONS_DB_SERVER_TURN_RECORD_PATH"),    "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<std::string>("replay.save",                                  UserStringNop("OPTIONS_DB_REPLAY_SAVE"),                "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<std::string>("replay.record.path",                           UserStringNop("OPTIONS_DB_REPLAY_RECORD_PATH"),         "",
+                                        Validator<std::string>(),   false);
+        GetOptionsDB().Add<int>("replay.turns",                                         UserStringNop("OPTIONS_DB_REPLAY_TURNS"),               0,
+                                RangedValidator<int>(0, 100000),    false);
+        GetOptionsDB().AddFlag("replay.serial",                                         UserStringNop("OPTIONS_DB_REPLAY_SERIAL"),              false);
+
+        {
+            ScopedTimer timer("OptionsDB load");
 
-        // if config.xml and persistent_config.xml are present, read and set options entries
-        GetOptionsDB().SetFromFile(GetConfigPath(), FreeOrionVersionString());
-        GetOptionsDB().SetFromFile(GetPersistentConfigPath());
+            // if config and persistent config files (or the xml config files of
+            // earlier versions) are present, read and set options entries
+            GetOptionsDB().SetFromConfigFiles(FreeOrionVersionString());
 
-        // override previously-saved and default options with command line parameters and flags
-        GetOptionsDB().SetFromCommandLine(args);
+            // override previously-saved and default options with command line parameters and flags
+            GetOptionsDB().SetFromCommandLine(args);
+        }
 
         auto help_arg = GetOptionsDB().Get<std::string>("help");
         if (help_arg != "NOOP") {
@@ -92,6 +134,30 @@ int wmain(int argc, wchar_t* argv[], wchar_t* envp[]) {
             return 0;   // quit without actually starting server
         }
 
+        // replay recorded turns instead of running a game
+        const auto replay_save = GetOptionsDB().Get<std::string>("replay.save");
+        if (!replay_save.empty()) {
+            if (GetOptionsDB().Get<bool>("replay.serial"))
+                GetOptionsDB().Set<int>("effects.server.threads", 1);
+
+            ServerApp g_app;
+            const int differing_turns = g_app.ReplayTurns(replay_save,
+                                                          GetOptionsDB().Get<std::string>("replay.record.path"),
+                                                          GetOptionsDB().Get<int>("replay.turns"));
+            std::cout << "Replay of " << replay_save << ": " << differing_turns
+                      << " turns differ from the recording" << std::endl;
+            ShutdownLoggingSystemFileSink();
+            return differing_turns ? 1 : 0;
+        }
+
+        // relay the game of another server to observers instead of running a game
+        if (!GetOptionsDB().Get<std::string>("network.relay.upstream").empty()) {
+            ObserverRelay relay;
+            relay.Run();
+            ShutdownLoggingSystemFileSink();
+            return 0;
+        }
+
         ServerApp g_app;
         g_app(); // Calls ServerApp::Run() to run app (intialization and main process loop)
 
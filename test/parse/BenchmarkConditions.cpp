@@ -0,0 +1,266 @@
+#include <boost/filesystem/fstream.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Empire/Empire.h"
+#include "Empire/Government.h"
+#include "universe/BuildingType.h"
+#include "universe/Condition.h"
+#include "universe/Effect.h"
+#include "universe/Planet.h"
+#include "universe/ShipHull.h"
+#include "universe/ShipPart.h"
+#include "universe/Special.h"
+#include "universe/Species.h"
+#include "universe/System.h"
+#include "universe/Tech.h"
+#include "util/Directories.h"
+#include "util/OptionsDB.h"
+
+#include "ParserAppFixture.h"
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    constexpr int NUM_EMPIRES = 4;
+
+    std::size_t EnvOr(const char* name, std::size_t default_value) {
+        if (const char* value = std::getenv(name)) {
+            try {
+                return boost::lexical_cast<std::size_t>(value);
+            } catch (...) {
+                // ignore
+            }
+        }
+        return default_value;
+    }
+
+    /** Time taken to evaluate the condition or value ref at one script
+      * location, such as the scope of a tech's second EffectsGroup. */
+    struct Measurement {
+        std::string         location;
+        std::size_t         evaluations = 0;
+        clock::duration     time{0};
+    };
+}
+
+/** Parses the default content, and creates a universe of
+  * FO_BENCHMARK_SYSTEMS systems (200 by default) with three planets each,
+  * every fourth planet populated by a playable species and owned by one of
+  * four empires, in which the conditions and value refs of the content are
+  * evaluated. */
+struct ConditionBenchmarkFixture : public ParserAppFixture {
+    ConditionBenchmarkFixture() {
+        GetOptionsDB().Set<std::string>("resource.path", PathToString(GetBinDir() / "default"));
+        StartBackgroundParsing();
+        CreateUniverse(EnvOr("FO_BENCHMARK_SYSTEMS", 200));
+        m_repetitions = EnvOr("FO_BENCHMARK_REPETITIONS", 3);
+    }
+
+    void CreateUniverse(std::size_t num_systems) {
+        std::vector<std::string> species_names;
+        for (auto it = m_species_manager.playable_begin(); it != m_species_manager.playable_end(); ++it)
+            species_names.push_back(it->first);
+        BOOST_REQUIRE(!species_names.empty());
+
+        m_universe.ResetAllIDAllocation();
+        for (int empire_id = 1; empire_id <= NUM_EMPIRES; ++empire_id)
+            m_empires.CreateEmpire(empire_id, "Empire " + std::to_string(empire_id),
+                                   "Player " + std::to_string(empire_id), {{255, 255, 255, 255}}, false);
+
+        // systems on a square grid, with starlanes to their neighbours
+        const std::size_t side = static_cast<std::size_t>(std::ceil(std::sqrt(num_systems)));
+        std::vector<std::shared_ptr<System>> systems;
+        for (std::size_t i = 0; i < num_systems; ++i) {
+            auto system = m_universe.InsertNew<System>(StarType::STAR_YELLOW, "System " + std::to_string(i),
+                                                       100.0 * (i % side), 100.0 * (i / side));
+            if (i % side)
+                ConnectSystems(*system, *systems[i - 1]);
+            if (i >= side)
+                ConnectSystems(*system, *systems[i - side]);
+            systems.push_back(std::move(system));
+        }
+
+        std::size_t planet_count = 0;
+        for (auto& system : systems) {
+            for (int orbit = 0; orbit < 3; ++orbit, ++planet_count) {
+                auto planet = m_universe.InsertNew<Planet>(static_cast<PlanetType>(planet_count % 9),
+                                                           PlanetSize::SZ_MEDIUM);
+                system->Insert(planet, orbit);
+                if (planet_count % 4)
+                    continue;
+
+                const int empire_id = static_cast<int>((planet_count / 4) % NUM_EMPIRES) + 1;
+                planet->SetSpecies(species_names[(planet_count / 4) % species_names.size()]);
+                planet->SetOwner(empire_id);
+                planet->GetMeter(MeterType::METER_POPULATION)->Set(10.0f, 10.0f);
+                if (m_capital_ids.size() < static_cast<std::size_t>(empire_id)) {
+                    m_capital_ids.push_back(planet->ID());
+                    m_empires.GetEmpire(empire_id)->SetCapitalID(planet->ID(), m_universe.Objects());
+                }
+            }
+        }
+
+        for (int empire_id = 1; empire_id <= NUM_EMPIRES; ++empire_id)
+            for (const auto& obj : m_universe.Objects().all())
+                m_universe.SetEmpireObjectVisibility(empire_id, obj->ID(), Visibility::VIS_PARTIAL_VISIBILITY);
+
+        m_universe.InitializeSystemGraph(m_empires, m_universe.Objects());
+        BOOST_TEST_MESSAGE("Benchmark universe has " << m_universe.Objects().size() << " objects");
+    }
+
+    static void ConnectSystems(System& lhs, System& rhs) {
+        lhs.AddStarlane(rhs.ID());
+        rhs.AddStarlane(lhs.ID());
+    }
+
+    /** Evaluates \a evaluate m_repetitions times and adds the time taken to
+      * the measurement of \a location. */
+    template <typename F>
+    void Time(const std::string& location, F&& evaluate) {
+        auto& measurement = m_measurements[location];
+        measurement.location = location;
+        for (std::size_t rep = 0; rep < m_repetitions; ++rep) {
+            const auto start = clock::now();
+            evaluate();
+            measurement.time += clock::now() - start;
+            ++measurement.evaluations;
+        }
+    }
+
+    /** Times evaluating \a condition on all objects, with \a source. */
+    void TimeCondition(const std::string& location, const Condition::Condition* condition,
+                       const std::shared_ptr<const UniverseObject>& source)
+    {
+        if (!condition)
+            return;
+        const ScriptingContext context{source};
+        Time(location, [&]() {
+            Condition::ObjectSet matches;
+            condition->Eval(context, matches);
+        });
+    }
+
+    /** Times the activation condition of each of \a effects_groups on
+      * \a source and their scope conditions on all objects. */
+    void TimeEffectsGroups(const std::string& content,
+                           const std::vector<std::shared_ptr<Effect::EffectsGroup>>& effects_groups,
+                           const std::shared_ptr<const UniverseObject>& source)
+    {
+        for (std::size_t i = 0; i < effects_groups.size(); ++i) {
+            const auto& effects_group = effects_groups[i];
+            if (!effects_group)
+                continue;
+            const std::string location = content + " effectsgroup " + std::to_string(i);
+            if (const auto* activation = effects_group->Activation()) {
+                const ScriptingContext context{source};
+                Time(location + " activation", [&]() { activation->Eval(context, source); });
+            }
+            TimeCondition(location + " scope", effects_group->Scope(), source);
+        }
+    }
+
+    std::shared_ptr<const UniverseObject> Capital() const
+    { return m_universe.Objects().get(m_capital_ids.front()); }
+
+    /** Returns a planet with species \a species_name, or the first capital if
+      * there is none. */
+    std::shared_ptr<const UniverseObject> PlanetWithSpecies(const std::string& species_name) const {
+        for (const auto& planet : m_universe.Objects().all<Planet>())
+            if (planet->SpeciesName() == species_name)
+                return planet;
+        return Capital();
+    }
+
+    std::vector<int>                    m_capital_ids;
+    std::size_t                         m_repetitions = 3;
+    std::map<std::string, Measurement>  m_measurements;
+};
+
+BOOST_FIXTURE_TEST_SUITE(BenchmarkConditions, ConditionBenchmarkFixture)
+
+/**
+ * - Do evaluate the activation and scope conditions of every EffectsGroup, the location
+ *   conditions and the cost value refs of all default content in the benchmark universe.
+ * - Expect each to have been evaluated.
+ * - Do write the time taken at each script location, most expensive first, to
+ *   `FO_BENCHMARK_OUTPUT` (condition_benchmark.tsv by default) as tab-separated text.
+ */
+BOOST_AUTO_TEST_CASE(benchmark_content_conditions) {
+    const auto capital = Capital();
+    BOOST_REQUIRE(capital);
+    const int empire_id = capital->Owner();
+
+    for (const auto& [name, species] : m_species_manager) {
+        const auto source = PlanetWithSpecies(name);
+        TimeEffectsGroups("species " + name, species->Effects(), source);
+        TimeCondition("species " + name + " location", species->Location(), source);
+    }
+
+    for (const auto& tech : GetTechManager()) {
+        const std::string content = "tech " + tech->Name();
+        TimeEffectsGroups(content, tech->Effects(), capital);
+        Time(content + " research cost", [&]() { tech->ResearchCost(empire_id); });
+    }
+
+    for (const auto& [name, policy] : GetPolicyManager()) {
+        TimeEffectsGroups("policy " + name, policy->Effects(), capital);
+        Time("policy " + name + " adoption cost", [&]() { policy->AdoptionCost(empire_id); });
+    }
+
+    for (const auto& [name, building_type] : GetBuildingTypeManager()) {
+        const std::string content = "building " + name;
+        TimeEffectsGroups(content, building_type->Effects(), capital);
+        TimeCondition(content + " location", building_type->Location(), capital);
+        TimeCondition(content + " enqueue location", building_type->EnqueueLocation(), capital);
+        Time(content + " production cost", [&]() { building_type->ProductionCost(empire_id, capital->ID()); });
+    }
+
+    for (const auto& name : SpecialNames()) {
+        const Special* special = GetSpecial(name);
+        TimeEffectsGroups("special " + name, special->Effects(), capital);
+        TimeCondition("special " + name + " location", special->Location(), capital);
+    }
+
+    for (const auto& [name, part] : GetShipPartManager()) {
+        TimeEffectsGroups("ship part " + name, part->Effects(), capital);
+        TimeCondition("ship part " + name + " location", part->Location(), capital);
+        Time("ship part " + name + " production cost", [&]() { part->ProductionCost(empire_id, capital->ID()); });
+    }
+
+    for (const auto& [name, hull] : GetShipHullManager()) {
+        TimeEffectsGroups("ship hull " + name, hull->Effects(), capital);
+        TimeCondition("ship hull " + name + " location", hull->Location(), capital);
+        Time("ship hull " + name + " production cost", [&]() { hull->ProductionCost(empire_id, capital->ID()); });
+    }
+
+    BOOST_REQUIRE(!m_measurements.empty());
+
+    std::vector<Measurement> ranked;
+    ranked.reserve(m_measurements.size());
+    for (auto& [location, measurement] : m_measurements) {
+        BOOST_CHECK_EQUAL(measurement.evaluations, m_repetitions);
+        ranked.push_back(std::move(measurement));
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) { return lhs.time > rhs.time; });
+
+    const auto us = [](clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    const char* env_output = std::getenv("FO_BENCHMARK_OUTPUT");
+    boost::filesystem::ofstream output(FilenameToPath(env_output ? env_output : "condition_benchmark.tsv"));
+    BOOST_REQUIRE(output);
+    output << "location\tevaluations\ttotal_us\tmean_us\n";
+    for (const auto& measurement : ranked)
+        output << measurement.location << '\t' << measurement.evaluations << '\t' << us(measurement.time)
+               << '\t' << us(measurement.time) / std::max<std::size_t>(1, measurement.evaluations) << '\n';
+
+    for (std::size_t i = 0; i < std::min<std::size_t>(20, ranked.size()); ++i)
+        BOOST_TEST_MESSAGE(ranked[i].location << ": " << us(ranked[i].time) / m_repetitions << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,9 @@
 #include <array>
+#include <boost/filesystem/fstream.hpp>
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <map>
 #include <memory>
 
 #include "parse/Parse.h"
@@ -192,5 +195,44 @@ BOOST_AUTO_TEST_CASE(parse_techs) {
     BOOST_REQUIRE_EQUAL(2, categories_seen.size());
 }
 
+BOOST_AUTO_TEST_CASE(parse_profile_baseline) {
+    parse::ClearProfiles();
+    parse::SetProfilingEnabled(true);
+    Pending::WaitForPendingUnlocked(Pending::StartParsing(parse::game_rules, m_scripting_dir / "game_rules.focs.txt"));
+    Pending::WaitForPendingUnlocked(Pending::StartParsing(parse::techs<TechManager::TechParseTuple>, m_scripting_dir / "techs"));
+    parse::SetProfilingEnabled(false);
+
+    // number of files and total time to preprocess and parse them, per category
+    std::map<std::string, std::pair<std::size_t, std::chrono::microseconds>> category_totals;
+    for (const auto& profile : parse::FileProfiles()) {
+        BOOST_REQUIRE(profile.preprocessed_size > 0);
+        auto& [num_files, time] = category_totals[parse::ProfileCategory(profile.path, m_scripting_dir)];
+        ++num_files;
+        time += profile.preprocess_time + profile.parse_time;
+    }
+
+    // each line of the baseline is a category, its number of files and the
+    // most milliseconds that preprocessing and parsing them should take
+    boost::filesystem::ifstream baseline(m_scripting_dir / "parse_profile_baseline.txt");
+    BOOST_REQUIRE(baseline);
+    std::string category;
+    std::size_t num_files = 0;
+    long long max_milliseconds = 0;
+    std::size_t num_categories = 0;
+    while (baseline >> category >> num_files >> max_milliseconds) {
+        ++num_categories;
+        const auto totals_it = category_totals.find(category);
+        BOOST_REQUIRE_MESSAGE(category_totals.end() != totals_it, "No files profiled in category " << category);
+        BOOST_TEST_MESSAGE("Parsed " << category << " in " << totals_it->second.second.count() << " us");
+        BOOST_REQUIRE_EQUAL(num_files, totals_it->second.first);
+        BOOST_CHECK_LE(totals_it->second.second.count(), max_milliseconds * 1000);
+    }
+    BOOST_REQUIRE_EQUAL(category_totals.size(), num_categories);
+
+    const auto report = parse::ProfileReport(m_scripting_dir);
+    BOOST_REQUIRE(report.find("\"name\": \"techs\", \"files\": 3") != std::string::npos);
+    parse::ClearProfiles();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
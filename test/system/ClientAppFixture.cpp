@@ -223,7 +223,8 @@ bool ClientAppFixture::HandleMessage(Message& msg) {
     case Message::MessageType::TURN_UPDATE: {
         ExtractTurnUpdateMessageData(msg,                   EmpireID(),         m_current_turn,
                                      Empires(),             GetUniverse(),      GetSpeciesManager(),
-                                     GetCombatLogManager(), GetSupplyManager(), Players());
+                                     GetCombatLogManager(), GetSupplyManager(), Players(),
+                                     TurnUpdateDeltaBase());
         m_turn_done = true;
         BOOST_TEST_MESSAGE("Full turn update unpacked");
         return true;
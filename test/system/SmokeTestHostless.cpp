@@ -28,7 +28,8 @@ BOOST_FIXTURE_TEST_SUITE(SmokeTestHostless, ClientAppFixture)
 
 /**
  * - Do start a server with hostless mode if `FO_TEST_HOSTLESS_LAUNCH_SERVER` was set with save
- *   enabled if `FO_TEST_HOSTLESS_SAVE` was set.
+ *   enabled if `FO_TEST_HOSTLESS_SAVE` was set, and writing turn processing times to
+ *   `FO_TEST_HOSTLESS_BENCHMARK_OUTPUT` if it was set.
  * - Do connect to lobby to localhost server as a Player.
  * - Expect successfully connection to localhost server.
  * - Do add `FO_TEST_HOSTLESS_AIS` AIs to lobby (by default 2).
@@ -100,6 +101,8 @@ BOOST_AUTO_TEST_CASE(hostless_server) {
         }
     }
 
+    const char *env_benchmark_output = std::getenv("FO_TEST_HOSTLESS_BENCHMARK_OUTPUT");
+
     boost::optional<Process> server;
     if (launch_server) {
         BOOST_REQUIRE(!PingLocalHostServer());
@@ -126,6 +129,11 @@ BOOST_AUTO_TEST_CASE(hostless_server) {
             "--log-level", "info"
         };
 
+        if (env_benchmark_output) {
+            args.push_back("--turn.benchmark.output");
+            args.push_back(env_benchmark_output);
+        }
+
 #ifdef FREEORION_LINUX
         // Dirty hack to output log to console.
         args.push_back("--log-file");
@@ -21,6 +21,8 @@
                                         }   }
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION{"RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION"};
+
     #define UserStringNop(key) key
 
     void AddRules(GameRules& rules) {
@@ -202,7 +204,7 @@ std::string BuildingType::Dump(unsigned short ntabs) const {
 
 bool BuildingType::ProductionCostTimeLocationInvariant() const {
     // if rule is active, then scripted costs and times are ignored and actual costs are invariant
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION.Get())
         return true;
 
     // if cost or time are specified and not invariant, result is non-invariance
@@ -217,7 +219,7 @@ bool BuildingType::ProductionCostTimeLocationInvariant() const {
 float BuildingType::ProductionCost(int empire_id, int location_id,
                                    const ScriptingContext& context) const
 {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION") || !m_production_cost)
+    if (RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION.Get() || !m_production_cost)
         return 1.0f;
 
     ScopedTimer timer("BuildingType::ProductionCost: " + m_name);
@@ -258,7 +260,7 @@ float BuildingType::PerTurnCost(int empire_id, int location_id,
 int BuildingType::ProductionTime(int empire_id, int location_id,
                                  const ScriptingContext& context) const
 {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION") || !m_production_time)
+    if (RULE_CHEAP_AND_FAST_BUILDING_PRODUCTION.Get() || !m_production_time)
         return 1;
 
     ScopedTimer timer("BuildingType::ProductionTime: " + m_name, true, std::chrono::milliseconds(20));
@@ -306,6 +308,24 @@ bool BuildingType::ProductionLocation(int empire_id, int location_id, const Scri
     return m_location->Eval(source_context, std::move(location));
 }
 
+void BuildingType::ProductionLocations(int empire_id, std::vector<std::shared_ptr<const UniverseObject>>& candidates,
+                                       const ScriptingContext& context) const
+{
+    if (!m_location || candidates.empty())
+        return;
+
+    auto empire = context.GetEmpire(empire_id);
+    std::shared_ptr<const UniverseObject> source = empire ? empire->Source(context.ContextObjects()) : nullptr;
+    if (!source) {
+        candidates.clear();
+        return;
+    }
+
+    ScriptingContext source_context{std::move(source), context};
+    Condition::ObjectSet non_matches;
+    m_location->Eval(source_context, candidates, non_matches, Condition::SearchDomain::MATCHES);
+}
+
 bool BuildingType::EnqueueLocation(int empire_id, int location_id, const ScriptingContext& context) const {
     if (!m_enqueue_location)
         return true;
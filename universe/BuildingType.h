@@ -131,6 +131,12 @@ public:
     //! at the location with location_id
     auto ProductionLocation(int empire_id, int location_id, const ScriptingContext& context) const -> bool;
 
+    //! Removes from @p candidates the objects at which the empire with ID
+    //! empire_id can't produce this building.  The location condition is
+    //! evaluated once for all candidates.
+    void ProductionLocations(int empire_id, std::vector<std::shared_ptr<const UniverseObject>>& candidates,
+                             const ScriptingContext& context) const;
+
     //! Returns true iff the empire with ID empire_id meets the requirements of
     //! the EnqueueLocation() UI filter method for this building at the
     //! location with location_id
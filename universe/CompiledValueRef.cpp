@@ -0,0 +1,686 @@
+#include "CompiledValueRef.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_set>
+#include "ScriptingContext.h"
+#include "../util/Logger.h"
+
+
+namespace ValueRef {
+
+namespace {
+    bool Hoistable(const ValueRef<double>& node) {
+        return node.TargetInvariant() &&
+               node.LocalCandidateInvariant() &&
+               node.RootCandidateInvariant();
+    }
+
+    bool IsComparison(OpType op_type) {
+        switch (op_type) {
+        case OpType::COMPARE_EQUAL:
+        case OpType::COMPARE_GREATER_THAN:
+        case OpType::COMPARE_GREATER_THAN_OR_EQUAL:
+        case OpType::COMPARE_LESS_THAN:
+        case OpType::COMPARE_LESS_THAN_OR_EQUAL:
+        case OpType::COMPARE_NOT_EQUAL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /** Replaces the operands of \a op_type at the top of \a stack with the
+      * result, as Operation<double>::EvalImpl would calculate it.  Operands
+      * are in the order they are evaluated, with the last on top. */
+    void Apply(OpType op_type, std::size_t num_operands, std::vector<double>& stack) {
+        auto& top = stack.back();
+        switch (op_type) {
+        case OpType::NEGATE:        top = -top;             return;
+        case OpType::ABS:           top = std::abs(top);    return;
+        case OpType::LOGARITHM:     top = top <= 0.0 ? 0.0 : std::log(top); return;
+        case OpType::SINE:          top = std::sin(top);    return;
+        case OpType::COSINE:        top = std::cos(top);    return;
+        case OpType::ROUND_NEAREST: top = std::round(top);  return;
+        case OpType::ROUND_UP:      top = std::ceil(top);   return;
+        case OpType::ROUND_DOWN:    top = std::floor(top);  return;
+        case OpType::SIGN:          top = top < 0.0 ? -1.0 : top > 0.0 ? 1.0 : 0.0; return;
+        default:                    break;
+        }
+
+        if (op_type == OpType::MINIMUM || op_type == OpType::MAXIMUM) {
+            if (num_operands == 0) {
+                stack.push_back(0.0);
+                return;
+            }
+            const auto first = stack.end() - num_operands;
+            double result = *first;
+            for (auto it = first + 1; it != stack.end(); ++it) {
+                if (op_type == OpType::MINIMUM ? (*it < result) : (result < *it))
+                    result = *it;
+            }
+            stack.erase(first + 1, stack.end());
+            stack.back() = result;
+            return;
+        }
+
+        const double last = stack.back();
+        stack.pop_back();
+        auto& first = stack.back();
+        switch (op_type) {
+        case OpType::PLUS:      first = first + last;   return;
+        case OpType::MINUS:     first = first - last;   return;
+        case OpType::TIMES:     first = first * last;   return;
+        case OpType::DIVIDE:    first = last / first;   return; // divisor is evaluated first
+        case OpType::COMPARE_EQUAL:                 first = first == last;  return;
+        case OpType::COMPARE_GREATER_THAN:          first = first > last;   return;
+        case OpType::COMPARE_GREATER_THAN_OR_EQUAL: first = first >= last;  return;
+        case OpType::COMPARE_LESS_THAN:             first = first < last;   return;
+        case OpType::COMPARE_LESS_THAN_OR_EQUAL:    first = first <= last;  return;
+        case OpType::COMPARE_NOT_EQUAL:             first = first != last;  return;
+        default:                                    return;
+        }
+    }
+
+    /** The existing CompiledValueRefs, for GenerateNativeSource(). */
+    std::unordered_set<const CompiledValueRef*>& Registry() {
+        static std::unordered_set<const CompiledValueRef*> registry;
+        return registry;
+    }
+
+    std::mutex& RegistryMutex() {
+        static std::mutex registry_mutex;
+        return registry_mutex;
+    }
+
+    /** Returns a C++ expression with exactly the value \a value. */
+    std::string CppLiteral(double value) {
+        if (std::isnan(value))
+            return "std::numeric_limits<double>::quiet_NaN()";
+        if (std::isinf(value))
+            return value > 0.0 ? "std::numeric_limits<double>::infinity()" : "-std::numeric_limits<double>::infinity()";
+        std::ostringstream ss;
+        ss << std::hexfloat << value;
+        return ss.str();
+    }
+
+    /** Returns a C++ string literal of \a text, with a line of source for
+      * each of its lines, each indented by \a indent. */
+    std::string CppStringLiteral(const std::string& text, const std::string& indent) {
+        std::string retval = indent + "\"";
+        for (std::size_t idx = 0; idx < text.size(); ++idx) {
+            const char c = text[idx];
+            switch (c) {
+            case '\\':  retval += "\\\\";   break;
+            case '"':   retval += "\\\"";    break;
+            case '\t':  retval += "\\t";     break;
+            case '\r':  retval += "\\r";     break;
+            case '\n':
+                retval += "\\n\"";
+                if (idx + 1 < text.size())
+                    retval += "\n" + indent + "\"";
+                else
+                    return retval;
+                break;
+            default:    retval += c;        break;
+            }
+        }
+        return retval + "\"";
+    }
+
+    const char* ComparisonOperator(OpType op_type) {
+        switch (op_type) {
+        case OpType::COMPARE_EQUAL:                 return "==";
+        case OpType::COMPARE_GREATER_THAN:          return ">";
+        case OpType::COMPARE_GREATER_THAN_OR_EQUAL: return ">=";
+        case OpType::COMPARE_LESS_THAN:             return "<";
+        case OpType::COMPARE_LESS_THAN_OR_EQUAL:    return "<=";
+        case OpType::COMPARE_NOT_EQUAL:             return "!=";
+        default:                                    return nullptr;
+        }
+    }
+}
+
+CompiledValueRef::CompiledValueRef(const ValueRef<double>& value_ref) :
+    m_value_ref(value_ref)
+{
+    Compile(value_ref);
+    m_affine = FindAffineForm(value_ref);
+    FindNative();
+
+    std::scoped_lock lock(RegistryMutex());
+    Registry().insert(this);
+}
+
+CompiledValueRef::~CompiledValueRef() {
+    std::scoped_lock lock(RegistryMutex());
+    Registry().erase(this);
+}
+
+std::vector<double> CompiledValueRef::EvalHoisted(const ScriptingContext& context) const {
+    std::vector<double> retval;
+    retval.reserve(m_hoisted.size());
+    for (auto* node : m_hoisted)
+        retval.push_back(node->Eval(context));
+    return retval;
+}
+
+double CompiledValueRef::Eval(const ScriptingContext& context, const std::vector<double>& hoisted,
+                              std::vector<double>& stack) const
+{
+    if (m_native)
+        return m_native(context, hoisted.data(), m_leaves.data());
+
+    stack.clear();
+    for (std::size_t pc = 0; pc < m_code.size(); ++pc) {
+        const auto& instruction = m_code[pc];
+        switch (instruction.code) {
+        case Code::CONSTANT:
+            stack.push_back(instruction.value);
+            break;
+        case Code::HOISTED:
+            stack.push_back(hoisted[instruction.arg]);
+            break;
+        case Code::LEAF:
+            stack.push_back(instruction.leaf->Eval(context));
+            break;
+        case Code::APPLY:
+            Apply(instruction.op_type, instruction.arg, stack);
+            break;
+        case Code::SHORT_CIRCUIT_IF_ZERO:
+            if (stack.back() == 0.0) {
+                stack.back() = instruction.value;
+                pc = instruction.arg - 1;
+            }
+            break;
+        case Code::BRANCH_IF_ZERO: {
+            const bool zero = stack.back() == 0.0;
+            stack.pop_back();
+            if (zero)
+                pc = instruction.arg - 1;
+            break;
+        }
+        case Code::JUMP:
+            pc = instruction.arg - 1;
+            break;
+        case Code::POP:
+            stack.pop_back();
+            break;
+        }
+    }
+    return stack.back();
+}
+
+void CompiledValueRef::EvalAffine(const std::vector<double>& hoisted, std::vector<double>& values) const {
+    if (m_affine_scale.present) {
+        const double k = m_affine_scale.term.Get(hoisted);
+        if (m_affine_scale.op_type == OpType::DIVIDE) {
+            if (k == 0.0)
+                std::fill(values.begin(), values.end(), 0.0);
+            else
+                for (auto& v : values)
+                    v = v / k;
+
+        } else if (m_affine_scale.input_first) {
+            // TIMES gives zero for a zero left-hand operand, whatever the other
+            for (auto& v : values)
+                v = (v == 0.0) ? 0.0 : v * k;
+
+        } else {
+            if (k == 0.0)
+                std::fill(values.begin(), values.end(), 0.0);
+            else
+                for (auto& v : values)
+                    v = k * v;
+        }
+    }
+
+    if (m_affine_offset.present) {
+        const double c = m_affine_offset.term.Get(hoisted);
+        if (m_affine_offset.op_type == OpType::PLUS) {
+            for (auto& v : values)
+                v = v + c;
+        } else if (m_affine_offset.input_first) {
+            for (auto& v : values)
+                v = v - c;
+        } else {
+            for (auto& v : values)
+                v = c - v;
+        }
+    }
+}
+
+std::size_t CompiledValueRef::Emit(Code code, std::size_t arg, double value) {
+    m_code.push_back(Instruction{code, OpType::PLUS, arg, value, nullptr});
+    return m_code.size() - 1;
+}
+
+void CompiledValueRef::Compile(const ValueRef<double>& node) {
+    if (auto constant = dynamic_cast<const Constant<double>*>(&node)) {
+        Emit(Code::CONSTANT, 0, constant->Value());
+
+    } else if (Hoistable(node)) {
+        Emit(Code::HOISTED, m_hoisted.size());
+        m_hoisted.push_back(&node);
+
+    } else if (!CompileOperation(node)) {
+        Emit(Code::LEAF);
+        m_code.back().leaf = &node;
+        m_leaves.push_back(&node);
+    }
+}
+
+bool CompiledValueRef::CompileOperation(const ValueRef<double>& node) {
+    auto op = dynamic_cast<const Operation<double>*>(&node);
+    if (!op)
+        return false;
+
+    const auto op_type = op->GetOpType();
+    const auto operands = op->Operands();
+    auto has_operands = [&operands](std::size_t count) {
+        return operands.size() >= count &&
+            std::all_of(operands.begin(), operands.begin() + count, [](const auto* o) { return o; });
+    };
+    auto apply = [this, op_type](std::size_t num_operands) {
+        Emit(Code::APPLY, num_operands);
+        m_code.back().op_type = op_type;
+    };
+
+    switch (op_type) {
+    case OpType::PLUS:
+    case OpType::MINUS:
+        if (!has_operands(2))
+            return false;
+        Compile(*operands[0]);
+        Compile(*operands[1]);
+        apply(2);
+        break;
+
+    case OpType::TIMES: {
+        if (!has_operands(2))
+            return false;
+        Compile(*operands[0]);
+        const auto skip = Emit(Code::SHORT_CIRCUIT_IF_ZERO, 0, 0.0);
+        Compile(*operands[1]);
+        apply(2);
+        m_code[skip].arg = m_code.size();
+        break;
+    }
+
+    case OpType::DIVIDE: {
+        if (!has_operands(2))
+            return false;
+        Compile(*operands[1]);
+        const auto skip = Emit(Code::SHORT_CIRCUIT_IF_ZERO, 0, 0.0);
+        Compile(*operands[0]);
+        apply(2);
+        m_code[skip].arg = m_code.size();
+        break;
+    }
+
+    case OpType::NEGATE:
+    case OpType::ABS:
+    case OpType::LOGARITHM:
+    case OpType::SINE:
+    case OpType::COSINE:
+    case OpType::ROUND_NEAREST:
+    case OpType::ROUND_UP:
+    case OpType::ROUND_DOWN:
+    case OpType::SIGN:
+        if (!has_operands(1))
+            return false;
+        Compile(*operands[0]);
+        apply(1);
+        break;
+
+    case OpType::MINIMUM:
+    case OpType::MAXIMUM: {
+        std::size_t num_operands = 0;
+        for (auto* operand : operands) {
+            if (operand) {
+                Compile(*operand);
+                ++num_operands;
+            }
+        }
+        apply(num_operands);
+        break;
+    }
+
+    default: {
+        const auto num_operands = std::min<std::size_t>(operands.size(), 4);
+        if (!IsComparison(op_type) || num_operands < 2 || !has_operands(num_operands))
+            return false;
+
+        Compile(*operands[0]);
+        Compile(*operands[1]);
+        apply(2);
+        if (operands.size() == 3) {
+            // result is the third operand if the comparison is true, or zero
+            const auto skip = Emit(Code::SHORT_CIRCUIT_IF_ZERO, 0, 0.0);
+            Emit(Code::POP);
+            Compile(*operands[2]);
+            m_code[skip].arg = m_code.size();
+
+        } else if (operands.size() >= 4) {
+            // result is the third operand if the comparison is true, or the fourth
+            const auto branch = Emit(Code::BRANCH_IF_ZERO);
+            Compile(*operands[2]);
+            const auto jump = Emit(Code::JUMP);
+            m_code[branch].arg = m_code.size();
+            Compile(*operands[3]);
+            m_code[jump].arg = m_code.size();
+        }
+        break;
+    }
+    }
+
+    ++m_compiled_operations;
+    return true;
+}
+
+void CompiledValueRef::FindNative() {
+    const auto& native_value_refs = NativeValueRefs();
+    if (native_value_refs.empty() || m_compiled_operations == 0)
+        return;
+
+    // the checksum rules out all but the same script, or rare collisions,
+    // which the dump then rules out
+    const auto checksum = m_value_ref.GetCheckSum();
+    std::string dump;
+    for (const auto& native : native_value_refs) {
+        if (native.checksum != checksum || native.num_hoisted != m_hoisted.size() ||
+            native.num_leaves != m_leaves.size() || !native.function)
+        { continue; }
+        if (dump.empty())
+            dump = m_value_ref.Dump();
+        if (dump == native.dump) {
+            m_native = native.function;
+            return;
+        }
+    }
+}
+
+bool CompiledValueRef::GenerateNative(const ValueRef<double>& node, std::string& code, const std::string& indent,
+                                      std::size_t& num_vars, std::string& result) const
+{
+    auto new_var = [&num_vars]() { return "v" + std::to_string(num_vars++); };
+    auto declare = [&code, &indent, &result, &new_var](const std::string& expression) {
+        result = new_var();
+        code += indent + "const double " + result + " = " + expression + ";\n";
+    };
+    auto generate = [this, &code, &num_vars](const ValueRef<double>& operand, const std::string& operand_indent,
+                                             std::string& operand_result)
+    { return GenerateNative(operand, code, operand_indent, num_vars, operand_result); };
+    const std::string inner_indent = indent + "    ";
+
+    if (auto constant = dynamic_cast<const Constant<double>*>(&node)) {
+        result = CppLiteral(constant->Value());
+        return true;
+    }
+    if (auto it = std::find(m_hoisted.begin(), m_hoisted.end(), &node); it != m_hoisted.end()) {
+        result = "hoisted[" + std::to_string(std::distance(m_hoisted.begin(), it)) + "]";
+        return true;
+    }
+    if (auto it = std::find(m_leaves.begin(), m_leaves.end(), &node); it != m_leaves.end()) {
+        declare("leaves[" + std::to_string(std::distance(m_leaves.begin(), it)) + "]->Eval(context)");
+        return true;
+    }
+
+    // anything else was compiled as an Operation, so the statements follow
+    // the instructions that CompileOperation emitted for it
+    auto op = dynamic_cast<const Operation<double>*>(&node);
+    if (!op)
+        return false;
+    const auto op_type = op->GetOpType();
+    const auto operands = op->Operands();
+    std::string a, b;
+
+    switch (op_type) {
+    case OpType::PLUS:
+    case OpType::MINUS:
+        if (!generate(*operands[0], indent, a) || !generate(*operands[1], indent, b))
+            return false;
+        declare(a + (op_type == OpType::PLUS ? " + " : " - ") + b);
+        return true;
+
+    case OpType::TIMES:
+    case OpType::DIVIDE: {
+        // the operand that short-circuits on zero is the divisor of a DIVIDE
+        const auto* first = op_type == OpType::TIMES ? operands[0] : operands[1];
+        const auto* second = op_type == OpType::TIMES ? operands[1] : operands[0];
+        if (!generate(*first, indent, a))
+            return false;
+        const auto var = new_var();
+        code += indent + "double " + var + " = 0.0;\n" + indent + "if (" + a + " != 0.0) {\n";
+        if (!generate(*second, inner_indent, b))
+            return false;
+        code += inner_indent + var + " = " + (op_type == OpType::TIMES ? a + " * " + b : b + " / " + a) + ";\n" +
+                indent + "}\n";
+        result = var;
+        return true;
+    }
+
+    case OpType::NEGATE:        if (!generate(*operands[0], indent, a)) return false; declare("-" + a); return true;
+    case OpType::ABS:           if (!generate(*operands[0], indent, a)) return false; declare("std::abs(" + a + ")"); return true;
+    case OpType::LOGARITHM:     if (!generate(*operands[0], indent, a)) return false; declare(a + " <= 0.0 ? 0.0 : std::log(" + a + ")"); return true;
+    case OpType::SINE:          if (!generate(*operands[0], indent, a)) return false; declare("std::sin(" + a + ")"); return true;
+    case OpType::COSINE:        if (!generate(*operands[0], indent, a)) return false; declare("std::cos(" + a + ")"); return true;
+    case OpType::ROUND_NEAREST: if (!generate(*operands[0], indent, a)) return false; declare("std::round(" + a + ")"); return true;
+    case OpType::ROUND_UP:      if (!generate(*operands[0], indent, a)) return false; declare("std::ceil(" + a + ")"); return true;
+    case OpType::ROUND_DOWN:    if (!generate(*operands[0], indent, a)) return false; declare("std::floor(" + a + ")"); return true;
+    case OpType::SIGN:          if (!generate(*operands[0], indent, a)) return false; declare(a + " < 0.0 ? -1.0 : " + a + " > 0.0 ? 1.0 : 0.0"); return true;
+
+    case OpType::MINIMUM:
+    case OpType::MAXIMUM: {
+        std::vector<std::string> values;
+        for (auto* operand : operands) {
+            if (!operand)
+                continue;
+            if (!generate(*operand, indent, values.emplace_back()))
+                return false;
+        }
+        if (values.empty()) {
+            result = "0.0";
+            return true;
+        }
+        const auto var = new_var();
+        code += indent + "double " + var + " = " + values.front() + ";\n";
+        for (auto it = values.begin() + 1; it != values.end(); ++it) {
+            code += indent + "if (" + (op_type == OpType::MINIMUM ? *it + " < " + var : var + " < " + *it) +
+                    ")\n" + inner_indent + var + " = " + *it + ";\n";
+        }
+        result = var;
+        return true;
+    }
+
+    default: {
+        const char* comparison = ComparisonOperator(op_type);
+        if (!comparison || operands.size() < 2 ||
+            !generate(*operands[0], indent, a) || !generate(*operands[1], indent, b))
+        { return false; }
+        declare("(" + a + " " + comparison + " " + b + ") ? 1.0 : 0.0");
+        if (operands.size() == 2)
+            return true;
+
+        const auto compared = result;
+        const auto var = new_var();
+        std::string value;
+        if (operands.size() == 3) {
+            code += indent + "double " + var + " = 0.0;\n" + indent + "if (" + compared + " != 0.0) {\n";
+            if (!generate(*operands[2], inner_indent, value))
+                return false;
+            code += inner_indent + var + " = " + value + ";\n" + indent + "}\n";
+        } else {
+            code += indent + "double " + var + ";\n" + indent + "if (" + compared + " != 0.0) {\n";
+            if (!generate(*operands[2], inner_indent, value))
+                return false;
+            code += inner_indent + var + " = " + value + ";\n" + indent + "} else {\n";
+            if (!generate(*operands[3], inner_indent, value))
+                return false;
+            code += inner_indent + var + " = " + value + ";\n" + indent + "}\n";
+        }
+        result = var;
+        return true;
+    }
+    }
+}
+
+std::string CompiledValueRef::GenerateNativeSource(std::size_t max_count, std::size_t& num_generated) {
+    num_generated = 0;
+
+    std::scoped_lock lock(RegistryMutex());
+    std::vector<std::pair<std::size_t, const CompiledValueRef*>> ranked;
+    for (const auto* compiled : Registry()) {
+        const auto num_targets = compiled->m_num_targets.load(std::memory_order_relaxed);
+        if (num_targets > 0 && !compiled->m_native && compiled->m_compiled_operations > 0)
+            ranked.emplace_back(num_targets, compiled);
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    // the same script may be compiled more than once, such as for copies of
+    // content, but is only generated once
+    std::set<std::pair<unsigned int, std::string>> generated;
+    std::string functions, table;
+    for (const auto& [num_targets, compiled] : ranked) {
+        if (num_generated >= max_count)
+            break;
+        const auto checksum = compiled->m_value_ref.GetCheckSum();
+        auto dump = compiled->m_value_ref.Dump();
+        if (!generated.emplace(checksum, dump).second)
+            continue;
+
+        std::string code, result;
+        std::size_t num_vars = 0;
+        if (!compiled->GenerateNative(compiled->m_value_ref, code, "        ", num_vars, result)) {
+            ErrorLogger() << "CompiledValueRef::GenerateNativeSource couldn't generate code for: " << dump;
+            continue;
+        }
+
+        const auto name = "Native" + std::to_string(num_generated);
+        functions += "    // evaluated for " + std::to_string(num_targets) + " targets\n"
+                     "    double " + name + "([[maybe_unused]] const ScriptingContext& context,\n"
+                     "        [[maybe_unused]] const double* hoisted,\n"
+                     "        [[maybe_unused]] const ValueRef<double>* const* leaves)\n"
+                     "    {\n" + code +
+                     "        return " + result + ";\n"
+                     "    }\n\n";
+        table += "        {" + std::to_string(checksum) + "u, " + std::to_string(compiled->m_hoisted.size()) +
+                 ", " + std::to_string(compiled->m_leaves.size()) + ",\n" +
+                 CppStringLiteral(dump, "         ") + ",\n"
+                 "         &" + name + "},\n";
+        ++num_generated;
+    }
+
+    return "// Natively compiled ValueRefs, generated by the server's native-effects\n"
+           "// debug command from the SetMeter values that were evaluated for the most\n"
+           "// targets in a game.  Each is only used for a script with the same checksum\n"
+           "// and dump, so this can be regenerated or replaced at any time.\n"
+           "\n"
+           "#include \"NativeValueRefs.h\"\n"
+           "\n"
+           "#include <cmath>\n"
+           "#include <limits>\n"
+           "#include \"ScriptingContext.h\"\n"
+           "\n"
+           "\n"
+           "namespace ValueRef {\n"
+           "\n"
+           "namespace {\n" + functions +
+           "}\n"
+           "\n"
+           "const std::vector<NativeValueRef>& NativeValueRefs() {\n"
+           "    static const std::vector<NativeValueRef> native_value_refs{\n" + table +
+           "    };\n"
+           "    return native_value_refs;\n"
+           "}\n"
+           "\n"
+           "}\n";
+}
+
+bool CompiledValueRef::FindAffineForm(const ValueRef<double>& node) {
+    // offset, if any, is the outermost operation
+    auto op = dynamic_cast<const Operation<double>*>(&node);
+    if (op && (op->GetOpType() == OpType::PLUS || op->GetOpType() == OpType::MINUS)) {
+        if (!op->LHS() || !op->RHS())
+            return false;
+        m_affine_offset.present = true;
+        m_affine_offset.op_type = op->GetOpType();
+        if (FindTerm(*op->RHS(), m_affine_offset.term) && FindAffineScale(*op->LHS())) {
+            m_affine_offset.input_first = true;
+            return true;
+        }
+        m_affine_scale = AffineStep{};
+        if (FindTerm(*op->LHS(), m_affine_offset.term) && FindAffineScale(*op->RHS())) {
+            m_affine_offset.input_first = false;
+            return true;
+        }
+        m_affine_offset = AffineStep{};
+        m_affine_scale = AffineStep{};
+        return false;
+    }
+    return FindAffineScale(node);
+}
+
+bool CompiledValueRef::FindAffineScale(const ValueRef<double>& node) {
+    auto op = dynamic_cast<const Operation<double>*>(&node);
+    if (op && (op->GetOpType() == OpType::TIMES || op->GetOpType() == OpType::DIVIDE)) {
+        if (!op->LHS() || !op->RHS())
+            return false;
+        m_affine_scale.present = true;
+        m_affine_scale.op_type = op->GetOpType();
+        if (FindTerm(*op->RHS(), m_affine_scale.term) && FindAffineInput(*op->LHS())) {
+            m_affine_scale.input_first = true;
+            return true;
+        }
+        // the divisor must be the term
+        if (op->GetOpType() == OpType::TIMES &&
+            FindTerm(*op->LHS(), m_affine_scale.term) && FindAffineInput(*op->RHS()))
+        {
+            m_affine_scale.input_first = false;
+            return true;
+        }
+        return false;
+    }
+    return FindAffineInput(node);
+}
+
+bool CompiledValueRef::FindAffineInput(const ValueRef<double>& node) {
+    // exactly a Variable, not a Statistic or other class derived from it
+    if (typeid(node) != typeid(Variable<double>))
+        return false;
+    const auto& variable = static_cast<const Variable<double>&>(node);
+
+    if (variable.GetReferenceType() == ReferenceType::EFFECT_TARGET_VALUE_REFERENCE) {
+        m_affine_input = AffineInput{};
+        return true;
+    }
+
+    const auto& property_name = variable.PropertyName();
+    if (variable.GetReferenceType() != ReferenceType::EFFECT_TARGET_REFERENCE || property_name.size() != 1)
+        return false;
+    const auto meter = NameToMeter(property_name.front());
+    if (meter == MeterType::INVALID_METER_TYPE)
+        return false;
+    m_affine_input = AffineInput{false, meter, variable.ReturnImmediateValue()};
+    return true;
+}
+
+bool CompiledValueRef::FindTerm(const ValueRef<double>& node, Term& term) const {
+    if (auto constant = dynamic_cast<const Constant<double>*>(&node)) {
+        term = Term{true, constant->Value(), 0};
+        return true;
+    }
+    auto it = std::find(m_hoisted.begin(), m_hoisted.end(), &node);
+    if (it == m_hoisted.end())
+        return false;
+    term = Term{false, 0.0, static_cast<std::size_t>(std::distance(m_hoisted.begin(), it))};
+    return true;
+}
+
+}
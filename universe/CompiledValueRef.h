@@ -0,0 +1,170 @@
+#ifndef _CompiledValueRef_h_
+#define _CompiledValueRef_h_
+
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Enums.h"
+#include "NativeValueRefs.h"
+#include "ValueRefs.h"
+#include "../util/Export.h"
+
+
+struct ScriptingContext;
+
+namespace ValueRef {
+
+/** A double-valued ValueRef flattened into a sequence of instructions for a
+    simple stack machine, for evaluating it for many effect targets.
+
+    Operation nodes are compiled into instructions, rather than evaluated with
+    a virtual call for each node. Subexpressions that are the same for every
+    target (ie. are target, local and root candidate invariant) are evaluated
+    just once, with EvalHoisted(), and the results are passed to each Eval().
+    Other ValueRefs, such as Variables and Statistics, and any Operation that
+    can't be compiled, are evaluated as usual when reached.
+
+    Evaluation gives the same results as evaluating the ValueRef directly,
+    except that hoisted subexpressions are evaluated even when they are in
+    parts of the expression that would otherwise be skipped for some targets,
+    such as the untaken branch of a comparison.
+
+    If a NativeValueRef was built in for the same ValueRef, its function is
+    called instead of running the instructions.  GenerateNativeSource()
+    writes such functions for the CompiledValueRefs that exist, which have
+    been evaluated for the most targets.
+
+    Refers to the nodes of the ValueRef it is compiled from, which must
+    outlive it. */
+class FO_COMMON_API CompiledValueRef {
+public:
+    explicit CompiledValueRef(const ValueRef<double>& value_ref);
+    CompiledValueRef(const CompiledValueRef&) = delete;
+    ~CompiledValueRef();
+
+    CompiledValueRef& operator=(const CompiledValueRef&) = delete;
+
+    /** Returns the values of the subexpressions that are the same for all
+      * targets, to be passed to Eval() for each target. */
+    [[nodiscard]] std::vector<double> EvalHoisted(const ScriptingContext& context) const;
+
+    /** Returns the value of the compiled ValueRef in \a context. \a stack is
+      * working space, which can be reused between calls to avoid allocating. */
+    [[nodiscard]] double Eval(const ScriptingContext& context, const std::vector<double>& hoisted,
+                              std::vector<double>& stack) const;
+
+    /** Returns true iff any Operation was compiled, so that evaluating this is
+      * likely cheaper than evaluating the ValueRef directly. */
+    [[nodiscard]] bool CompiledAnyOperations() const noexcept { return m_compiled_operations > 0; }
+
+    /** Returns true iff a built in NativeValueRef is used to evaluate this. */
+    [[nodiscard]] bool IsNative() const noexcept { return m_native; }
+
+    /** Adds \a num_targets to the number of targets this has been evaluated
+      * for, by which GenerateNativeSource() ranks CompiledValueRefs. */
+    void CountTargets(std::size_t num_targets) const noexcept
+    { m_num_targets.fetch_add(num_targets, std::memory_order_relaxed); }
+
+    /** Returns the source of a NativeValueRefTable.cpp that defines
+      * NativeValueRefs() for up to \a max_count of the existing
+      * CompiledValueRefs that have been evaluated for the most targets, and
+      * are not already native.  \a num_generated is set to the number of
+      * NativeValueRefs in the source. */
+    [[nodiscard]] static std::string GenerateNativeSource(std::size_t max_count, std::size_t& num_generated);
+
+    /** The only target-dependent input of a compiled ValueRef that is an
+      * affine function of it, such as Value * k + c. */
+    struct AffineInput {
+        /** If true, the input is the current value of the meter being set
+          * (ie. Value), and otherwise it is the \a meter of the target. */
+        bool        current_value = true;
+        MeterType   meter = MeterType::INVALID_METER_TYPE;
+        bool        immediate = false;  ///< whether the target's meter's current rather than initial value is used
+    };
+
+    /** Returns the input of the compiled ValueRef, if it is an affine function
+      * of one number, or null otherwise. */
+    [[nodiscard]] const AffineInput* Affine() const noexcept { return m_affine ? &m_affine_input : nullptr; }
+
+    /** Replaces each of \a values, which are the inputs given by Affine() for
+      * a number of targets, with the value of the compiled ValueRef for that
+      * target.  The arithmetic is done in the same order as Eval() would, so
+      * the results are identical, but in simple loops over all the values. */
+    void EvalAffine(const std::vector<double>& hoisted, std::vector<double>& values) const;
+
+private:
+    enum class Code : unsigned char {
+        CONSTANT,               ///< push value
+        HOISTED,                ///< push hoisted value number arg
+        LEAF,                   ///< push leaf->Eval(context)
+        APPLY,                  ///< replace the top arg values (or fewer, as op_type requires) with the result of op_type
+        SHORT_CIRCUIT_IF_ZERO,  ///< if the top value is zero, replace it with value and jump to arg
+        BRANCH_IF_ZERO,         ///< pop the top value, and jump to arg if it is zero
+        JUMP,                   ///< jump to arg
+        POP                     ///< pop the top value
+    };
+
+    struct Instruction {
+        Code                    code = Code::CONSTANT;
+        OpType                  op_type = OpType::PLUS;
+        std::size_t             arg = 0;
+        double                  value = 0.0;
+        const ValueRef<double>* leaf = nullptr;
+    };
+
+    /** A constant or hoisted subexpression. */
+    struct Term {
+        bool        constant = true;
+        double      value = 0.0;
+        std::size_t hoisted_idx = 0;
+
+        [[nodiscard]] double Get(const std::vector<double>& hoisted) const
+        { return constant ? value : hoisted[hoisted_idx]; }
+    };
+
+    /** An optional operation of the input of an affine ValueRef and a term. */
+    struct AffineStep {
+        bool        present = false;
+        OpType      op_type = OpType::PLUS;
+        bool        input_first = true; ///< whether the input is the left-hand operand
+        Term        term;
+    };
+
+    void Compile(const ValueRef<double>& node);
+    bool CompileOperation(const ValueRef<double>& node);
+    std::size_t Emit(Code code, std::size_t arg = 0, double value = 0.0);
+
+    void FindNative();
+
+    /** Appends to \a code C++ statements, indented by \a indent, that
+      * evaluate \a node as the instructions compiled from it would, and sets
+      * \a result to an expression with its value.  Returns false if \a node
+      * wasn't compiled as expected. */
+    bool GenerateNative(const ValueRef<double>& node, std::string& code, const std::string& indent,
+                        std::size_t& num_vars, std::string& result) const;
+
+    bool FindAffineForm(const ValueRef<double>& node);
+    bool FindAffineScale(const ValueRef<double>& node);
+    bool FindAffineInput(const ValueRef<double>& node);
+    bool FindTerm(const ValueRef<double>& node, Term& term) const;
+
+    const ValueRef<double>&                 m_value_ref;
+    std::vector<Instruction>                m_code;
+    std::vector<const ValueRef<double>*>    m_hoisted;
+    std::vector<const ValueRef<double>*>    m_leaves;           ///< in the order of their LEAF instructions
+    std::size_t                             m_compiled_operations = 0;
+    NativeValueRef::Function                m_native = nullptr;
+    mutable std::atomic<std::size_t>        m_num_targets{0};
+
+    bool                                    m_affine = false;
+    AffineInput                             m_affine_input;
+    AffineStep                              m_affine_scale;     ///< TIMES or DIVIDE applied to the input, if present
+    AffineStep                              m_affine_offset;    ///< PLUS or MINUS applied to the scaled input, if present
+};
+
+}
+
+
+#endif
@@ -2,9 +2,11 @@
 #define _Condition_h_
 
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
+#include <boost/dynamic_bitset_fwd.hpp>
 #include "../util/Export.h"
 
 
@@ -19,6 +21,10 @@ namespace Condition {
 
 typedef std::vector<std::shared_ptr<const UniverseObject>> ObjectSet;
 
+/** Which objects in an ObjectSet of candidates are still being considered,
+  * or have matched, when evaluating conditions with Condition::EvalMask. */
+typedef boost::dynamic_bitset<> CandidateMask;
+
 enum class SearchDomain : int {
     NON_MATCHES,    ///< The Condition will only examine items in the non matches set; those that match the Condition will be inserted into the matches set.
     MATCHES         ///< The Condition will only examine items in the matches set; those that do not match the Condition will be inserted into the nonmatches set.
@@ -59,6 +65,13 @@ struct FO_COMMON_API Condition {
       * with empty ScriptingContext. If this condition is not invariant to */
     bool Eval(std::shared_ptr<const UniverseObject> candidate) const;
 
+    /** Tests those of \a candidates whose bits are set in \a mask, and
+      * clears the bits of those that don't match.  The candidates aren't moved
+      * between sets, so that And, Or and Not conditions can combine the
+      * results of their operands with bitwise operations on masks. */
+    virtual void EvalMask(const ScriptingContext& parent_context,
+                          const ObjectSet& candidates, CandidateMask& mask) const;
+
     virtual void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                    ObjectSet& condition_non_targets) const;
 
@@ -87,19 +100,46 @@ struct FO_COMMON_API Condition {
     bool SourceInvariant() const
     { return m_source_invariant; }
 
+    //! Returns true iff whether a candidate object matches this condition
+    //! depends only on the state of that candidate object, the objects that
+    //! directly contain it or are contained by it, and the source object.
+    //! Results of such conditions for unchanged candidates and sources can be
+    //! reused after other objects change.
+    virtual bool CandidateLocal() const
+    { return false; }
+
+    //! Returns true iff whether a candidate object matches this condition
+    //! depends only on the gamestate, the source object and that candidate,
+    //! not on which other candidates are being matched or on random chance.
+    //! Along with root candidate and target invariance, this allows the
+    //! objects matching this condition to be found once and reused while the
+    //! gamestate and source are unchanged. See ConditionMemo.
+    virtual bool Memoizable() const
+    { return CandidateLocal(); }
+
     virtual std::string Description(bool negated = false) const = 0;
     virtual std::string Dump(unsigned short ntabs = 0) const = 0;
     virtual void SetTopLevelContent(const std::string& content_name) = 0;
     virtual unsigned int GetCheckSum() const
     { return 0; }
 
+    //! Returns an id that is the same for all conditions that are equal to
+    //! this one, and different from that of any other condition.  It is found
+    //! on first use, by comparing this condition to others with the same
+    //! checksum, and then kept, so this condition must not be changed after.
+    [[nodiscard]] unsigned int InternedID() const;
+
     //! Makes a clone of this Condition in a new owning pointer. Required for
     //! Boost.Python, which doesn't support move semantics for returned values.
     [[nodiscard]] virtual std::unique_ptr<Condition> Clone() const = 0;
 
 protected:
     //! Copies invariants from other Condition
-    Condition(const Condition& rhs) = default;
+    Condition(const Condition& rhs) :
+        m_root_candidate_invariant(rhs.m_root_candidate_invariant),
+        m_target_invariant(rhs.m_target_invariant),
+        m_source_invariant(rhs.m_source_invariant)
+    {}
 
     bool m_root_candidate_invariant = false;
     bool m_target_invariant = false;
@@ -109,9 +149,16 @@ private:
     struct MatchHelper;
     friend struct MatchHelper;
 
+    mutable std::atomic<unsigned int> m_interned_id = 0; ///< 0 until InternedID() is first called
+
     virtual bool Match(const ScriptingContext& local_context) const;
 };
 
+/** Frees the storage that condition evaluations keep for reuse in later
+  * evaluations.  Storage kept by threads other than the calling thread is
+  * freed when they next evaluate conditions. */
+FO_COMMON_API void ReleaseScratchStorage();
+
 }
 
 
@@ -0,0 +1,70 @@
+#include "ConditionMemo.h"
+
+#include <mutex>
+#include "Condition.h"
+#include "ScriptingContext.h"
+#include "UniverseObject.h"
+
+
+namespace {
+    // limits the memory used for memoized matches, which is proportional to
+    // the number of entries times the number of objects
+    constexpr std::size_t MAX_ENTRIES = 4096;
+
+    int SourceID(const Condition::Condition& condition, const ScriptingContext& context)
+    { return (condition.SourceInvariant() || !context.source) ? INVALID_OBJECT_ID : context.source->ID(); }
+}
+
+ConditionMemo::ConditionMemo() = default;
+
+ConditionMemo::~ConditionMemo() = default;
+
+bool ConditionMemo::CanMemoize(const Condition::Condition& condition) {
+    return condition.Memoizable() && condition.RootCandidateInvariant() &&
+        condition.TargetInvariant();
+}
+
+std::shared_ptr<const ConditionMemo::Matches> ConditionMemo::Get(const Condition::Condition& condition,
+                                                                 const ScriptingContext& context)
+{
+    // equal conditions, such as those expanded from the same script macro,
+    // have the same interned id, and so share entries
+    const Key key{condition.InternedID(), SourceID(condition, context)};
+
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+            return it->second;
+        if (m_entries.size() >= MAX_ENTRIES)
+            return nullptr;
+    }
+
+    // evaluate without holding the lock, as other threads may also be
+    // evaluating conditions, including subconditions of this one
+    Condition::ObjectSet matched;
+    condition.Eval(context, matched);
+
+    auto matches = std::make_shared<Matches>();
+    const auto& existing_objects = context.ContextObjects().ExistingObjects();
+    if (!existing_objects.empty() && existing_objects.rbegin()->first >= 0)
+        matches->states.resize(existing_objects.rbegin()->first + 1, Matches::State::UNKNOWN);
+    for (const auto& [object_id, obj] : existing_objects) {
+        (void)obj;
+        if (object_id >= 0)
+            matches->states[object_id] = Matches::State::NO_MATCH;
+    }
+    for (const auto& obj : matched) {
+        if (obj && obj->ID() >= 0 && static_cast<std::size_t>(obj->ID()) < matches->states.size())
+            matches->states[obj->ID()] = Matches::State::MATCH;
+    }
+
+    std::unique_lock lock(m_mutex);
+    // if another thread got there first, returns its matches
+    return m_entries.emplace(key, std::move(matches)).first->second;
+}
+
+void ConditionMemo::Clear() {
+    std::unique_lock lock(m_mutex);
+    m_entries.clear();
+}
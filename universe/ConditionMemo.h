@@ -0,0 +1,75 @@
+#ifndef _ConditionMemo_h_
+#define _ConditionMemo_h_
+
+
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include "../util/Export.h"
+
+
+namespace Condition {
+    struct Condition;
+}
+struct ScriptingContext;
+
+/** Sets of objects that match conditions, each found once by evaluating a
+    condition on all objects, and then reused to match candidates in later
+    evaluations of an identical condition for the same source object.
+
+    Only conditions for which CanMemoize() is true are memoized.  These match
+    each candidate regardless of which other candidates are being matched, the
+    root candidate or the effect target, so only the source object and the
+    gamestate affect the results.  The memo doesn't detect changes to the
+    gamestate, so it must be cleared whenever objects' meters, ownership or
+    anything else about them is changed.
+
+    Safe to use from multiple threads concurrently, except for Clear(). */
+class FO_COMMON_API ConditionMemo {
+public:
+    /** Whether each object, indexed by object id, matched a condition. */
+    struct Matches {
+        enum class State : unsigned char {
+            UNKNOWN,    ///< object wasn't evaluated, eg. because it didn't exist
+            NO_MATCH,
+            MATCH
+        };
+
+        [[nodiscard]] State Get(int object_id) const {
+            return (object_id >= 0 && static_cast<std::size_t>(object_id) < states.size()) ?
+                states[object_id] : State::UNKNOWN;
+        }
+
+        std::vector<State> states;
+    };
+
+    ConditionMemo();
+    ~ConditionMemo();
+
+    /** Returns true iff the results of \a condition can be memoized. */
+    [[nodiscard]] static bool CanMemoize(const Condition::Condition& condition);
+
+    /** Returns the matches of \a condition in \a context, evaluating it on all
+      * objects if it hasn't been already.  Returns null if the memo is full,
+      * in which case \a condition should be evaluated directly.
+      * \a condition must be memoizable. */
+    [[nodiscard]] std::shared_ptr<const Matches> Get(const Condition::Condition& condition,
+                                                     const ScriptingContext& context);
+
+    /** Discards all memoized matches. */
+    void Clear();
+
+private:
+    /** Interned id of a condition, and id of the source object it was
+      * evaluated for, or INVALID_OBJECT_ID if it is source invariant. */
+    using Key = std::pair<unsigned int, int>;
+
+    std::shared_mutex                                                               m_mutex;
+    std::unordered_map<Key, std::shared_ptr<const Matches>, boost::hash<Key>>       m_entries;
+};
+
+
+#endif
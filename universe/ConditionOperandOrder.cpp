@@ -0,0 +1,69 @@
+#include "ConditionOperandOrder.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <boost/functional/hash.hpp>
+
+
+namespace {
+    std::size_t HashOrder(const std::vector<std::size_t>& order)
+    { return boost::hash_range(order.begin(), order.end()); }
+
+    std::vector<std::size_t> ScriptedOrder(std::size_t num_operands) {
+        std::vector<std::size_t> retval(num_operands);
+        std::iota(retval.begin(), retval.end(), 0);
+        return retval;
+    }
+}
+
+ConditionOperandOrder::ConditionOperandOrder(std::size_t num_operands, Combination combination) :
+    m_stats(std::make_unique<Stats[]>(num_operands)),
+    m_num_operands(num_operands),
+    m_combination(combination),
+    m_last_order_hash(HashOrder(ScriptedOrder(num_operands)))
+{}
+
+std::vector<std::size_t> ConditionOperandOrder::Order() const {
+    auto retval = ScriptedOrder(m_num_operands);
+    if (m_num_operands < 2)
+        return retval;
+
+    // estimate the cost of each operand per candidate that it removes from
+    // further consideration: for And, the candidates it doesn't match, and for
+    // Or, the candidates it does match. evaluating operands in increasing order
+    // of this cost minimizes the total expected cost of evaluating all of them.
+    std::vector<double> ranks(m_num_operands);
+    for (std::size_t i = 0; i < m_num_operands; ++i) {
+        const auto& stats = m_stats[i];
+        const auto candidates = stats.candidates.load(std::memory_order_relaxed);
+        if (candidates < MIN_MEASURED_CANDIDATES)
+            return retval;
+        const auto matches = std::min(stats.matches.load(std::memory_order_relaxed), candidates);
+        const auto removed = (m_combination == Combination::AND) ? (candidates - matches) : matches;
+
+        ranks[i] = (removed == 0) ? std::numeric_limits<double>::infinity() :
+            static_cast<double>(stats.nanoseconds.load(std::memory_order_relaxed)) / removed;
+    }
+
+    std::stable_sort(retval.begin(), retval.end(),
+                     [&ranks](std::size_t lhs, std::size_t rhs) { return ranks[lhs] < ranks[rhs]; });
+    return retval;
+}
+
+void ConditionOperandOrder::Record(std::size_t operand, std::size_t candidates, std::size_t matches,
+                                   std::chrono::nanoseconds duration)
+{
+    if (operand >= m_num_operands || candidates == 0)
+        return;
+    auto& stats = m_stats[operand];
+    stats.candidates.fetch_add(candidates, std::memory_order_relaxed);
+    stats.matches.fetch_add(matches, std::memory_order_relaxed);
+    stats.nanoseconds.fetch_add(static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0)),
+                                std::memory_order_relaxed);
+}
+
+bool ConditionOperandOrder::OrderChanged(const std::vector<std::size_t>& order) const {
+    const auto hash = HashOrder(order);
+    return m_last_order_hash.exchange(hash, std::memory_order_relaxed) != hash;
+}
@@ -0,0 +1,67 @@
+#ifndef _ConditionOperandOrder_h_
+#define _ConditionOperandOrder_h_
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../util/Export.h"
+
+
+/** Measured costs and selectivities of the operands of an And or Or
+    condition, which are used to evaluate the operands that are expected to
+    narrow down the candidates most cheaply first, rather than in the order
+    they are scripted in.
+
+    Only the operands of conditions whose operands are all memoizable should be
+    reordered, as those match each candidate regardless of which other
+    candidates are being matched or random chance, and so give the same
+    matches in any order.
+
+    Measurements accumulate over the lifetime of the condition, including over
+    many turns.  Safe to use from multiple threads concurrently. */
+class FO_COMMON_API ConditionOperandOrder {
+public:
+    enum class Combination : unsigned char {
+        AND,    ///< candidates that don't match an operand are removed before the next is evaluated
+        OR      ///< candidates that match an operand are removed before the next is evaluated
+    };
+
+    ConditionOperandOrder(std::size_t num_operands, Combination combination);
+
+    /** Returns the indices of the operands in the order they should be
+      * evaluated.  This is the scripted order until enough candidates have
+      * been evaluated by all operands to estimate their costs. */
+    [[nodiscard]] std::vector<std::size_t> Order() const;
+
+    /** Records that operand \a operand took \a duration to evaluate
+      * \a candidates candidate objects, of which \a matches matched. */
+    void Record(std::size_t operand, std::size_t candidates, std::size_t matches,
+                std::chrono::nanoseconds duration);
+
+    /** Returns true iff \a order differs from the order that was passed in the
+      * previous call, or if there was none and \a order isn't the scripted
+      * order, so that changes can be logged once each. */
+    [[nodiscard]] bool OrderChanged(const std::vector<std::size_t>& order) const;
+
+private:
+    // candidates that each operand must have evaluated before its cost is
+    // considered to be known
+    static constexpr std::uint64_t MIN_MEASURED_CANDIDATES = 256;
+
+    struct Stats {
+        std::atomic<std::uint64_t> candidates{0};
+        std::atomic<std::uint64_t> matches{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+    };
+
+    std::unique_ptr<Stats[]>            m_stats;
+    std::size_t                         m_num_operands = 0;
+    Combination                         m_combination = Combination::AND;
+    mutable std::atomic<std::size_t>    m_last_order_hash;
+};
+
+
+#endif
@@ -22,6 +22,8 @@ struct FO_COMMON_API Source final : public Condition {
     void SetTopLevelContent(const std::string& content_name) override
     {}
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override
+    { return true; }
 
     std::unique_ptr<Condition> Clone() const override;
 
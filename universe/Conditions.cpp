@@ -1,18 +1,29 @@
 #include "Conditions.h"
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 #include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/st_connected.hpp>
 #include "BuildingType.h"
 #include "Building.h"
+#include "ConditionMemo.h"
+#include "ConditionOperandOrder.h"
 #include "Fighter.h"
 #include "Fleet.h"
 #include "Meter.h"
+#include "ObjectIndex.h"
 #include "ObjectMap.h"
 #include "Pathfinder.h"
 #include "Planet.h"
+#include "PositionGrid.h"
 #include "ShipDesign.h"
 #include "ShipHull.h"
 #include "ShipPart.h"
@@ -20,6 +31,7 @@
 #include "Special.h"
 #include "Species.h"
 #include "System.h"
+#include "Tech.h"
 #include "UniverseObject.h"
 #include "Universe.h"
 #include "ValueRefs.h"
@@ -50,6 +62,27 @@ namespace {
 
     using boost::placeholders::_1;
 
+    /** Returns true iff all of the (ValueRef or Condition) pointers in
+      * \a ptrs are non-null and candidate local. */
+    template <typename Ptrs>
+    bool AllCandidateLocal(const Ptrs& ptrs) {
+        return std::all_of(ptrs.begin(), ptrs.end(),
+                           [](const auto& ptr) { return ptr && ptr->CandidateLocal(); });
+    }
+
+    /** Returns true iff all of the pointers in \a ptrs are non-null. */
+    template <typename Ptrs>
+    bool AllNonNull(const Ptrs& ptrs)
+    { return std::all_of(ptrs.begin(), ptrs.end(), [](const auto& ptr) { return !!ptr; }); }
+
+    /** Returns true iff all of the Condition pointers in \a ptrs are non-null
+      * and memoizable. */
+    template <typename Ptrs>
+    bool AllMemoizable(const Ptrs& ptrs) {
+        return std::all_of(ptrs.begin(), ptrs.end(),
+                           [](const auto& ptr) { return ptr && ptr->Memoizable(); });
+    }
+
     void AddAllObjectsSet(const ObjectMap& objects, Condition::ObjectSet& condition_non_targets) {
         condition_non_targets.reserve(condition_non_targets.size() + objects.ExistingObjects().size());
         for (const auto& obj : objects.ExistingObjects())
@@ -105,6 +138,116 @@ namespace {
             condition_non_targets.push_back(obj.second);
     }
 
+    /** Returns the index of the objects in \a context, or null if there is
+      * none, in which case initial candidates must be found by scanning. */
+    const ObjectIndex* ContextObjectIndex(const ScriptingContext& context) {
+        const auto& universe = context.ContextUniverse();
+        const auto* index = universe.ActiveObjectIndex();
+        return (index && &context.ContextObjects() == &universe.Objects()) ? index : nullptr;
+    }
+
+    void AddIndexedSet(const ObjectIndex::ObjectSet& objects, Condition::ObjectSet& condition_non_targets)
+    { condition_non_targets.insert(condition_non_targets.end(), objects.begin(), objects.end()); }
+
+    /** Sorts the objects in \a condition_non_targets from \a first onwards by
+      * id, so that candidates added from several indexed sets are in the same
+      * order as if they had been found by scanning the ObjectMap. */
+    void SortByID(Condition::ObjectSet& condition_non_targets, std::size_t first) {
+        std::sort(condition_non_targets.begin() + first, condition_non_targets.end(),
+                  [](const auto& lhs, const auto& rhs) { return lhs->ID() < rhs->ID(); });
+    }
+
+    /** Evaluates \a name_refs in \a context and puts the distinct names into
+      * \a names, if they are all invariant to the local candidate, and also to
+      * the root candidate if \a context has none.  Returns false, without
+      * evaluating any, if they aren't. */
+    template <typename Ptrs>
+    bool EvalInvariantNames(const Ptrs& name_refs, const ScriptingContext& context,
+                            bool root_candidate_invariant, std::vector<std::string>& names)
+    {
+        if (!context.condition_root_candidate && !root_candidate_invariant)
+            return false;
+        if (!std::all_of(name_refs.begin(), name_refs.end(),
+                         [](const auto& ref) { return ref && ref->LocalCandidateInvariant(); }))
+        { return false; }
+
+        names.reserve(name_refs.size());
+        for (auto& ref : name_refs)
+            names.push_back(ref->Eval(context));
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        return true;
+    }
+
+    // incremented to release the storage that threads' ScratchObjectSet
+    // pools keep, when each thread next uses its pool
+    std::atomic<unsigned int> scratch_generation{0};
+
+    /** A temporary ObjectSet whose storage is taken from a pool kept by each
+      * thread, and returned to it when the ScratchObjectSet is destroyed, so
+      * that conditions evaluated for many sources and candidates don't allocate
+      * and free storage for their intermediate sets of objects each time. */
+    class ScratchObjectSet {
+    public:
+        ScratchObjectSet() {
+            auto& pool = LocalPool();
+            if (!pool.sets.empty()) {
+                m_set.swap(pool.sets.back());
+                pool.sets.pop_back();
+            }
+        }
+
+        ~ScratchObjectSet() {
+            m_set.clear();
+            auto& pool = LocalPool();
+            if (pool.sets.size() < MAX_POOLED_SETS && m_set.capacity() <= MAX_POOLED_CAPACITY)
+                pool.sets.push_back(std::move(m_set));
+        }
+
+        ScratchObjectSet(const ScratchObjectSet&) = delete;
+        ScratchObjectSet& operator=(const ScratchObjectSet&) = delete;
+
+        Condition::ObjectSet& operator*() noexcept { return m_set; }
+        Condition::ObjectSet* operator->() noexcept { return &m_set; }
+
+        /** Frees the storage kept in the calling thread's pool. */
+        static void ReleaseLocalPool() { LocalPool().sets.clear(); }
+
+    private:
+        // limits the storage each thread keeps while it isn't being used
+        static constexpr std::size_t MAX_POOLED_SETS = 16;
+        static constexpr std::size_t MAX_POOLED_CAPACITY = 1 << 16;
+
+        struct Pool {
+            unsigned int                        generation = 0;
+            std::vector<Condition::ObjectSet>   sets;
+        };
+
+        static Pool& LocalPool() {
+            thread_local Pool pool;
+            const auto generation = scratch_generation.load(std::memory_order_relaxed);
+            if (pool.generation != generation) {
+                pool.sets.clear();
+                pool.generation = generation;
+            }
+            return pool;
+        }
+
+        Condition::ObjectSet m_set;
+    };
+
+    /** Moves all objects in \a from to the end of \a to, leaving \a from
+      * empty.  If \a to is empty, their storage is exchanged instead, so no
+      * objects need to be moved individually. */
+    void MoveAllObjects(Condition::ObjectSet& from, Condition::ObjectSet& to) {
+        if (to.empty()) {
+            to.swap(from);
+            return;
+        }
+        to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+        from.clear();
+    }
+
     /** Used by 4-parameter Condition::Eval function, and some of its
       * overrides, to scan through \a matches or \a non_matches set and apply
       * \a pred to each object, to test if it should remain in its current set
@@ -129,6 +272,203 @@ namespace {
                        from_set.end());
     }
 
+    /** Evaluates \a operand of an And or Or condition on the objects in the
+      * \a search_domain set, as Condition::Eval does, but using matches from
+      * the context universe's active ConditionMemo if \a operand can be
+      * memoized.  Objects that the memoized matches don't cover, such as ones
+      * that didn't exist when they were found, are evaluated directly. */
+    std::shared_ptr<const ConditionMemo::Matches> MemoizedMatches(const Condition::Condition& operand,
+                                                                  const ScriptingContext& parent_context)
+    {
+        const auto& universe = parent_context.ContextUniverse();
+        auto* memo = universe.ActiveConditionMemo();
+        if (memo && &parent_context.ContextObjects() == &universe.Objects() &&
+            ConditionMemo::CanMemoize(operand))
+        { return memo->Get(operand, parent_context); }
+        return nullptr;
+    }
+
+    void EvalOperand(const Condition::Condition& operand, const ScriptingContext& parent_context,
+                     Condition::ObjectSet& matches, Condition::ObjectSet& non_matches,
+                     Condition::SearchDomain search_domain)
+    {
+        auto memoized = MemoizedMatches(operand, parent_context);
+        if (!memoized) {
+            operand.Eval(parent_context, matches, non_matches, search_domain);
+            return;
+        }
+
+        using State = ConditionMemo::Matches::State;
+        const bool domain_matches = search_domain == Condition::SearchDomain::MATCHES;
+        auto& from_set = domain_matches ? matches : non_matches;
+        auto& to_set = domain_matches ? non_matches : matches;
+
+        ScratchObjectSet unknown_scratch;
+        auto& unknown = *unknown_scratch;
+        for (auto& obj : from_set) {
+            const auto state = memoized->Get(obj->ID());
+            if (state == State::UNKNOWN)
+                unknown.push_back(std::move(obj));
+            else if ((state == State::MATCH) != domain_matches)
+                to_set.push_back(std::move(obj));
+        }
+        from_set.erase(std::remove_if(from_set.begin(), from_set.end(), [](const auto& o) { return !o; }),
+                       from_set.end());
+
+        if (unknown.empty())
+            return;
+        if (domain_matches)
+            operand.Eval(parent_context, unknown, non_matches, search_domain);
+        else
+            operand.Eval(parent_context, matches, unknown, search_domain);
+        from_set.insert(from_set.end(), std::make_move_iterator(unknown.begin()),
+                        std::make_move_iterator(unknown.end()));
+    }
+
+    /** Evaluates \a operand with EvalMask on the \a candidates selected by
+      * \a mask, as EvalOperand does with Eval, using the active ConditionMemo
+      * if \a operand can be memoized. */
+    void EvalOperandMask(const Condition::Condition& operand, const ScriptingContext& parent_context,
+                         const Condition::ObjectSet& candidates, Condition::CandidateMask& mask)
+    {
+        auto memoized = MemoizedMatches(operand, parent_context);
+        if (!memoized) {
+            operand.EvalMask(parent_context, candidates, mask);
+            return;
+        }
+
+        using State = ConditionMemo::Matches::State;
+        Condition::CandidateMask unknown(mask.size());
+        for (auto idx = mask.find_first(); idx != Condition::CandidateMask::npos; idx = mask.find_next(idx)) {
+            const auto state = memoized->Get(candidates[idx]->ID());
+            if (state == State::UNKNOWN)
+                unknown.set(idx);
+            else if (state == State::NO_MATCH)
+                mask.reset(idx);
+        }
+
+        if (unknown.none())
+            return;
+        mask -= unknown;
+        operand.EvalMask(parent_context, candidates, unknown);
+        mask |= unknown;
+    }
+
+    /** Evaluates \a condition on the objects in the \a search_domain set using
+      * EvalMask, and then moves those that should be in the other set, giving
+      * the same results as Eval. */
+    void EvalWithMask(const Condition::Condition& condition, const ScriptingContext& parent_context,
+                      Condition::ObjectSet& matches, Condition::ObjectSet& non_matches,
+                      Condition::SearchDomain search_domain)
+    {
+        const bool domain_matches = search_domain == Condition::SearchDomain::MATCHES;
+        auto& from_set = domain_matches ? matches : non_matches;
+        auto& to_set = domain_matches ? non_matches : matches;
+
+        ScratchObjectSet candidates_scratch;
+        auto& candidates = *candidates_scratch;
+        candidates.swap(from_set);
+
+        Condition::CandidateMask mask(candidates.size());
+        mask.set();
+        condition.EvalMask(parent_context, candidates, mask);
+
+        to_set.reserve(to_set.size() + (domain_matches ? candidates.size() - mask.count() : mask.count()));
+        for (std::size_t idx = 0; idx < candidates.size(); ++idx)
+            (mask.test(idx) == domain_matches ? from_set : to_set).push_back(std::move(candidates[idx]));
+    }
+
+    // candidates that an And or Or must be evaluated on to use EvalMask for it
+    // and its operands, rather than moving candidates between sets for each
+    constexpr std::size_t MIN_MASK_CANDIDATES = 64;
+
+    /** Returns true iff an And or Or condition should be evaluated with
+      * EvalMask on the \a domain_set candidates. This is when there are many
+      * of them, and when a ConditionMemo is active, so that memoized operands
+      * can be evaluated by only checking the memoized matches. */
+    bool UseMaskEvaluation(const ScriptingContext& parent_context, const Condition::ObjectSet& domain_set) {
+        const auto& universe = parent_context.ContextUniverse();
+        return domain_set.size() >= MIN_MASK_CANDIDATES && universe.ActiveConditionMemo() &&
+            &parent_context.ContextObjects() == &universe.Objects();
+    }
+
+    /** Evaluates \a operand as EvalOperandMask does and, if \a operand_order
+      * isn't null, records in it how long that took and how many of the
+      * selected candidates matched. */
+    void EvalMeasuredOperandMask(ConditionOperandOrder* operand_order, std::size_t operand_idx,
+                                 const Condition::Condition& operand, const ScriptingContext& parent_context,
+                                 const Condition::ObjectSet& candidates, Condition::CandidateMask& mask)
+    {
+        if (!operand_order) {
+            EvalOperandMask(operand, parent_context, candidates, mask);
+            return;
+        }
+
+        const auto selected = mask.count();
+        const auto start = std::chrono::steady_clock::now();
+        EvalOperandMask(operand, parent_context, candidates, mask);
+        const auto duration = std::chrono::steady_clock::now() - start;
+        operand_order->Record(operand_idx, selected, mask.count(),
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    }
+
+    /** Evaluates \a operand as EvalOperand does and, if \a operand_order
+      * isn't null, records in it how long that took and how many of the
+      * candidates in the \a search_domain set matched. */
+    void EvalMeasuredOperand(ConditionOperandOrder* operand_order, std::size_t operand_idx,
+                             const Condition::Condition& operand, const ScriptingContext& parent_context,
+                             Condition::ObjectSet& matches, Condition::ObjectSet& non_matches,
+                             Condition::SearchDomain search_domain)
+    {
+        if (!operand_order) {
+            EvalOperand(operand, parent_context, matches, non_matches, search_domain);
+            return;
+        }
+
+        const bool domain_matches = search_domain == Condition::SearchDomain::MATCHES;
+        const auto& domain_set = domain_matches ? matches : non_matches;
+        const auto candidates = domain_set.size();
+
+        const auto start = std::chrono::steady_clock::now();
+        EvalOperand(operand, parent_context, matches, non_matches, search_domain);
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        // candidates that remain in the domain set are those that matched when
+        // searching matches, and those that didn't when searching non_matches
+        const auto remaining = std::min(domain_set.size(), candidates);
+        operand_order->Record(operand_idx, candidates, domain_matches ? remaining : candidates - remaining,
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    }
+
+    /** Returns the order in which to evaluate \a operands of an And or Or
+      * condition, which is that given by \a operand_order if it isn't null,
+      * or the order of \a operands otherwise.  Logs the order when it
+      * changes, for the content \a top_level_content. */
+    std::vector<std::size_t> OperandEvaluationOrder(
+        const ConditionOperandOrder* operand_order, const std::vector<std::unique_ptr<Condition::Condition>>& operands,
+        const char* combination, const std::string& top_level_content)
+    {
+        if (!operand_order) {
+            std::vector<std::size_t> retval(operands.size());
+            std::iota(retval.begin(), retval.end(), 0);
+            return retval;
+        }
+
+        auto retval = operand_order->Order();
+        if (operand_order->OrderChanged(retval)) {
+            std::stringstream ss;
+            for (auto idx : retval)
+                ss << " " << idx;
+            ss << ":\n";
+            for (auto& operand : operands)
+                ss << operand->Dump(1);
+            DebugLogger(conditions) << combination << " operands in "
+                                    << (top_level_content.empty() ? "(unknown content)" : top_level_content)
+                                    << " are now evaluated in order" << ss.str();
+        }
+        return retval;
+    }
+
     std::vector<const Condition::Condition*> FlattenAndNestedConditions(
         const std::vector<const Condition::Condition*>& input_conditions)
     {
@@ -169,6 +509,11 @@ namespace {
 }
 
 namespace Condition {
+void ReleaseScratchStorage() {
+    ++scratch_generation;
+    ScratchObjectSet::ReleaseLocalPool();
+}
+
 std::string ConditionFailedDescription(const std::vector<const Condition*>& conditions,
                                        std::shared_ptr<const UniverseObject> candidate_object/* = nullptr*/,
                                        std::shared_ptr<const UniverseObject> source_object/* = nullptr*/)
@@ -246,7 +591,7 @@ struct Condition::MatchHelper {
     {}
 
     bool operator()(const std::shared_ptr<const UniverseObject>& candidate) const {
-        ScriptingContext context{m_parent_context, candidate};
+        ScriptingContext context{ScriptingContext::LocalCandidateView{}, m_parent_context, candidate};
         return m_this->Match(context);
     }
 
@@ -266,11 +611,91 @@ bool Condition::operator==(const Condition& rhs) const {
     return true;
 }
 
+namespace {
+    /** Copies of distinct conditions that have been interned, and their ids. */
+    struct InternedConditions {
+        std::mutex                                                  mutex;
+        std::unordered_multimap<unsigned int, std::pair<std::unique_ptr<Condition>, unsigned int>>
+                                                                    by_checksum;
+        unsigned int                                                next_id = 1;
+    };
+
+    InternedConditions& GetInternedConditions() {
+        static InternedConditions interned;
+        return interned;
+    }
+}
+
+unsigned int Condition::InternedID() const {
+    if (const auto id = m_interned_id.load(std::memory_order_acquire))
+        return id;
+
+    const auto checksum = GetCheckSum();
+    auto& interned = GetInternedConditions();
+    unsigned int id = 0;
+    {
+        std::scoped_lock lock(interned.mutex);
+        auto [it, end_it] = interned.by_checksum.equal_range(checksum);
+        for (; it != end_it && !id; ++it) {
+            if (*it->second.first == *this)
+                id = it->second.second;
+        }
+        if (!id) {
+            id = interned.next_id++;
+            interned.by_checksum.emplace(checksum, std::pair{Clone(), id});
+        }
+    }
+
+    m_interned_id.store(id, std::memory_order_release);
+    return id;
+}
+
 void Condition::Eval(const ScriptingContext& parent_context,
                      ObjectSet& matches, ObjectSet& non_matches,
                      SearchDomain search_domain/* = SearchDomain::NON_MATCHES*/) const
 { EvalImpl(matches, non_matches, search_domain, MatchHelper(this, parent_context)); }
 
+void Condition::EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                         CandidateMask& mask) const
+{
+    // evaluate the selected candidates as the matches set, and then clear the
+    // bits of those that were moved into non_matches
+    std::vector<std::size_t> selected_indices;
+    selected_indices.reserve(mask.count());
+    ScratchObjectSet matches_scratch, non_matches_scratch;
+    auto& matches = *matches_scratch;
+    auto& non_matches = *non_matches_scratch;
+    for (auto idx = mask.find_first(); idx != CandidateMask::npos; idx = mask.find_next(idx)) {
+        selected_indices.push_back(idx);
+        matches.push_back(candidates[idx]);
+    }
+    if (matches.empty())
+        return;
+
+    Eval(parent_context, matches, non_matches, SearchDomain::MATCHES);
+    if (non_matches.empty())
+        return;
+
+    // most conditions keep matches in the order they were given, so the
+    // matches can usually be found by checking the selected candidates in order
+    std::size_t match_idx = 0;
+    for (auto idx : selected_indices) {
+        if (match_idx < matches.size() && matches[match_idx] == candidates[idx])
+            ++match_idx;
+        else
+            mask.reset(idx);
+    }
+    if (match_idx == matches.size())
+        return;
+
+    std::unordered_set<const UniverseObject*> matched_objects;
+    matched_objects.reserve(matches.size());
+    for (const auto& obj : matches)
+        matched_objects.insert(obj.get());
+    for (auto idx : selected_indices)
+        mask[idx] = matched_objects.count(candidates[idx].get()) > 0;
+}
+
 void Condition::Eval(const ScriptingContext& parent_context,
                      Effect::TargetSet& matches, Effect::TargetSet& non_matches,
                      SearchDomain search_domain/* = SearchDomain::NON_MATCHES*/) const
@@ -306,7 +731,8 @@ void Condition::Eval(const ScriptingContext& parent_context,
                      ObjectSet& matches) const
 {
     matches.clear();
-    ObjectSet condition_initial_candidates;
+    ScratchObjectSet initial_candidates_scratch;
+    auto& condition_initial_candidates = *initial_candidates_scratch;
 
     // evaluate condition only on objects that could potentially be matched by the condition
     GetDefaultInitialCandidateObjects(parent_context, condition_initial_candidates);
@@ -478,12 +904,10 @@ void Number::Eval(const ScriptingContext& parent_context,
         // number of matches was within the requested range.
         if (search_domain == SearchDomain::MATCHES && !in_range) {
             // move all objects from matches to non_matches
-            std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         } else if (search_domain == SearchDomain::NON_MATCHES && in_range) {
             // move all objects from non_matches to matches
-            std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         }
     }
 }
@@ -582,12 +1006,10 @@ void Turn::Eval(const ScriptingContext& parent_context,
         // current turn was within the requested range.
         if (search_domain == SearchDomain::MATCHES && !match) {
             // move all objects from matches to non_matches
-            std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         } else if (search_domain == SearchDomain::NON_MATCHES && match) {
             // move all objects from non_matches to matches
-            std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         }
     } else {
         // re-evaluate allowed turn range for each candidate object
@@ -948,17 +1370,17 @@ void SortedNumberOf::Eval(const ScriptingContext& parent_context,
                 // yes; move object to matches
                 *smnt_it = subcondition_matching_non_matches.back();
                 subcondition_matching_non_matches.pop_back();
-                matches.emplace_back(matched_object);   // TODO: can I std::move ?
+                matches.push_back(std::move(matched_object));
             }
         }
 
         // put remaining (non-matched) objects in subcondition_matching_non_matches back into non_matches
-        non_matches.insert( non_matches.end(), subcondition_matching_non_matches.begin(),      subcondition_matching_non_matches.end());
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_matching_non_matches.begin()),      std::make_move_iterator(subcondition_matching_non_matches.end()));
         // put objects in subcondition_non_matching_non_matches back into non_matches
-        non_matches.insert( non_matches.end(), subcondition_non_matching_non_matches.begin(),  subcondition_non_matching_non_matches.end());
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_non_matching_non_matches.begin()),  std::make_move_iterator(subcondition_non_matching_non_matches.end()));
         // put objects in subcondition_matching_matches and subcondition_non_matching_matches back into matches
-        matches.insert(     matches.end(),     subcondition_matching_matches.begin(),          subcondition_matching_matches.end());
-        matches.insert(     matches.end(),     subcondition_non_matching_matches.begin(),      subcondition_non_matching_matches.end());
+        matches.insert(     matches.end(),     std::make_move_iterator(subcondition_matching_matches.begin()),          std::make_move_iterator(subcondition_matching_matches.end()));
+        matches.insert(     matches.end(),     std::make_move_iterator(subcondition_non_matching_matches.begin()),      std::make_move_iterator(subcondition_non_matching_matches.end()));
         // this leaves the original contents of matches unchanged, other than
         // possibly having transferred some objects into matches from non_matches
 
@@ -972,17 +1394,17 @@ void SortedNumberOf::Eval(const ScriptingContext& parent_context,
                 // yes; move back into matches
                 *smt_it = subcondition_matching_matches.back();
                 subcondition_matching_matches.pop_back();
-                matches.emplace_back(matched_object);   // TODO: can I std::move ?
+                matches.push_back(std::move(matched_object));
             }
         }
 
         // put remaining (non-matched) objects in subcondition_matching_matches) into non_matches
-        non_matches.insert( non_matches.end(), subcondition_matching_matches.begin(),          subcondition_matching_matches.end());
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_matching_matches.begin()),          std::make_move_iterator(subcondition_matching_matches.end()));
         // put objects in subcondition_non_matching_matches into non_matches
-        non_matches.insert( non_matches.end(), subcondition_non_matching_matches.begin(),      subcondition_non_matching_matches.end());
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_non_matching_matches.begin()),      std::make_move_iterator(subcondition_non_matching_matches.end()));
         // put objects in subcondition_matching_non_matches and subcondition_non_matching_non_matches back into non_matches
-        non_matches.insert( non_matches.end(), subcondition_matching_non_matches.begin(),      subcondition_matching_non_matches.end());
-        non_matches.insert( non_matches.end(), subcondition_non_matching_non_matches.begin(),  subcondition_non_matching_non_matches.end());
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_matching_non_matches.begin()),      std::make_move_iterator(subcondition_matching_non_matches.end()));
+        non_matches.insert( non_matches.end(), std::make_move_iterator(subcondition_non_matching_non_matches.begin()),  std::make_move_iterator(subcondition_non_matching_non_matches.end()));
         // this leaves the original contents of non_matches unchanged, other than
         // possibly having transferred some objects into non_matches from matches
     }
@@ -1113,8 +1535,7 @@ void All::Eval(const ScriptingContext& parent_context,
 {
     if (search_domain == SearchDomain::NON_MATCHES) {
         // move all objects from non_matches to matches
-        std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-        non_matches.clear();
+        MoveAllObjects(non_matches, matches);
     }
     // if search_comain is MATCHES, do nothing: all objects in matches set
     // match this condition, so should remain in matches set
@@ -1161,8 +1582,7 @@ void None::Eval(const ScriptingContext& parent_context,
 {
     if (search_domain == SearchDomain::MATCHES) {
         // move all objects from matches to non_matches
-        std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-        matches.clear();
+        MoveAllObjects(matches, non_matches);
     }
     // if search domain is non_matches, no need to do anything since none of them match None.
 }
@@ -1444,6 +1864,28 @@ std::string EmpireAffiliation::Dump(unsigned short ntabs) const {
     return retval;
 }
 
+void EmpireAffiliation::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                          ObjectSet& condition_non_targets) const
+{
+    const auto* index = ContextObjectIndex(parent_context);
+    bool simple_eval_safe = (!m_empire_id || m_empire_id->ConstantExpr()) ||
+                            ((!m_empire_id || m_empire_id->LocalCandidateInvariant()) &&
+                            (parent_context.condition_root_candidate || RootCandidateInvariant()));
+    if (index && simple_eval_safe) {
+        if (m_affiliation == EmpireAffiliationType::AFFIL_SELF) {
+            // only objects owned by the specified empire can match
+            int empire_id = m_empire_id ? m_empire_id->Eval(parent_context) : ALL_EMPIRES;
+            if (empire_id != ALL_EMPIRES)
+                AddIndexedSet(index->OwnedBy(empire_id), condition_non_targets);
+            return;
+        } else if (m_affiliation == EmpireAffiliationType::AFFIL_NONE) {
+            AddIndexedSet(index->OwnedBy(ALL_EMPIRES), condition_non_targets);
+            return;
+        }
+    }
+    Condition::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+}
+
 bool EmpireAffiliation::Match(const ScriptingContext& local_context) const {
     auto& candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -1472,6 +1914,14 @@ unsigned int EmpireAffiliation::GetCheckSum() const {
     return retval;
 }
 
+bool EmpireAffiliation::CandidateLocal() const {
+    // other affiliation types depend on diplomatic statuses between empires
+    return (m_affiliation == EmpireAffiliationType::AFFIL_SELF ||
+            m_affiliation == EmpireAffiliationType::AFFIL_ANY ||
+            m_affiliation == EmpireAffiliationType::AFFIL_NONE) &&
+        (!m_empire_id || m_empire_id->CandidateLocal());
+}
+
 std::unique_ptr<Condition> EmpireAffiliation::Clone() const {
     return std::make_unique<EmpireAffiliation>(ValueRef::CloneUnique(m_empire_id),
                                                m_affiliation);
@@ -2182,6 +2632,9 @@ unsigned int Type::GetCheckSum() const {
     return retval;
 }
 
+bool Type::CandidateLocal() const
+{ return !m_type || m_type->CandidateLocal(); }
+
 std::unique_ptr<Condition> Type::Clone() const
 { return std::make_unique<Type>(ValueRef::CloneUnique(m_type)); }
 
@@ -2305,7 +2758,22 @@ std::string Building::Dump(unsigned short ntabs) const {
 
 void Building::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                  ObjectSet& condition_non_targets) const
-{ AddBuildingSet(parent_context.ContextObjects(), condition_non_targets); }
+{
+    std::vector<std::string> names;
+    const auto* index = ContextObjectIndex(parent_context);
+    if (index && !m_names.empty() &&
+        EvalInvariantNames(m_names, parent_context, RootCandidateInvariant(), names))
+    {
+        // only buildings of the specified types can match
+        const auto first = condition_non_targets.size();
+        for (auto& name : names)
+            AddIndexedSet(index->BuildingsOfType(name), condition_non_targets);
+        if (names.size() > 1)
+            SortByID(condition_non_targets, first);
+        return;
+    }
+    AddBuildingSet(parent_context.ContextObjects(), condition_non_targets);
+}
 
 bool Building::Match(const ScriptingContext& local_context) const {
     auto& candidate = local_context.condition_local_candidate;
@@ -2349,6 +2817,9 @@ unsigned int Building::GetCheckSum() const {
     return retval;
 }
 
+bool Building::CandidateLocal() const
+{ return AllCandidateLocal(m_names); }
+
 std::unique_ptr<Condition> Building::Clone() const
 { return std::make_unique<Building>(ValueRef::CloneUnique(m_names)); }
 
@@ -2601,6 +3072,14 @@ unsigned int HasSpecial::GetCheckSum() const {
     return retval;
 }
 
+bool HasSpecial::CandidateLocal() const {
+    return (!m_name || m_name->CandidateLocal()) &&
+        (!m_capacity_low || m_capacity_low->CandidateLocal()) &&
+        (!m_capacity_high || m_capacity_high->CandidateLocal()) &&
+        (!m_since_turn_low || m_since_turn_low->CandidateLocal()) &&
+        (!m_since_turn_high || m_since_turn_high->CandidateLocal());
+}
+
 std::unique_ptr<Condition> HasSpecial::Clone() const
 { return std::make_unique<HasSpecial>(*this); }
 
@@ -2705,6 +3184,21 @@ std::string HasTag::Dump(unsigned short ntabs) const {
     return retval;
 }
 
+void HasTag::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                               ObjectSet& condition_non_targets) const
+{
+    const auto* index = ContextObjectIndex(parent_context);
+    if (index && m_name && m_name->LocalCandidateInvariant() &&
+        (parent_context.condition_root_candidate || RootCandidateInvariant()))
+    {
+        // only objects with the specified tag can match
+        std::string name = boost::to_upper_copy<std::string>(m_name->Eval(parent_context));
+        AddIndexedSet(index->WithTag(name), condition_non_targets);
+        return;
+    }
+    Condition::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+}
+
 bool HasTag::Match(const ScriptingContext& local_context) const {
     auto& candidate = local_context.condition_local_candidate;
     if (!candidate) {
@@ -3062,6 +3556,9 @@ unsigned int Contains::GetCheckSum() const {
     return retval;
 }
 
+bool Contains::Memoizable() const
+{ return m_condition && m_condition->Memoizable(); }
+
 std::unique_ptr<Condition> Contains::Clone() const
 { return std::make_unique<Contains>(ValueRef::CloneUnique(m_condition)); }
 
@@ -3282,6 +3779,9 @@ unsigned int ContainedBy::GetCheckSum() const {
     return retval;
 }
 
+bool ContainedBy::Memoizable() const
+{ return m_condition && m_condition->Memoizable(); }
+
 std::unique_ptr<Condition> ContainedBy::Clone() const
 { return std::make_unique<ContainedBy>(ValueRef::CloneUnique(m_condition)); }
 
@@ -3398,6 +3898,11 @@ void InOrIsSystem::GetDefaultInitialCandidateObjects(const ScriptingContext& par
 
     // simple case of a single specified system id; can add just objects in that system
     int system_id = m_system_id->Eval(parent_context);
+    if (const auto* index = ContextObjectIndex(parent_context)) {
+        // includes system itself
+        AddIndexedSet(index->InSystem(system_id), condition_non_targets);
+        return;
+    }
     auto system = parent_context.ContextObjects().get<System>(system_id);
     if (!system)
         return;
@@ -3723,6 +4228,9 @@ unsigned int ObjectID::GetCheckSum() const {
     return retval;
 }
 
+bool ObjectID::CandidateLocal() const
+{ return !m_object_id || m_object_id->CandidateLocal(); }
+
 std::unique_ptr<Condition> ObjectID::Clone() const
 { return std::make_unique<ObjectID>(ValueRef::CloneUnique(m_object_id)); }
 
@@ -3891,6 +4399,9 @@ unsigned int PlanetType::GetCheckSum() const {
     return retval;
 }
 
+bool PlanetType::CandidateLocal() const
+{ return AllCandidateLocal(m_types); }
+
 std::unique_ptr<Condition> PlanetType::Clone() const
 { return std::make_unique<PlanetType>(ValueRef::CloneUnique(m_types)); }
 
@@ -4062,6 +4573,9 @@ unsigned int PlanetSize::GetCheckSum() const {
     return retval;
 }
 
+bool PlanetSize::CandidateLocal() const
+{ return AllCandidateLocal(m_sizes); }
+
 std::unique_ptr<Condition> PlanetSize::Clone() const
 { return std::make_unique<PlanetSize>(ValueRef::CloneUnique(m_sizes)); }
 
@@ -4419,6 +4933,22 @@ std::string Species::Dump(unsigned short ntabs) const {
 void Species::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                                 ObjectSet& condition_non_targets) const
 {
+    std::vector<std::string> names;
+    const auto* index = ContextObjectIndex(parent_context);
+    if (index && !m_names.empty() &&
+        EvalInvariantNames(m_names, parent_context, RootCandidateInvariant(), names))
+    {
+        // only planets, ships and buildings of the specified species can match
+        const auto first = condition_non_targets.size();
+        for (auto& name : names) {
+            if (!name.empty())
+                AddIndexedSet(index->WithSpecies(name), condition_non_targets);
+        }
+        if (names.size() > 1)
+            SortByID(condition_non_targets, first);
+        return;
+    }
+
     AddPlanetSet(parent_context.ContextObjects(), condition_non_targets);
     AddBuildingSet(parent_context.ContextObjects(), condition_non_targets);
     AddShipSet(parent_context.ContextObjects(), condition_non_targets);
@@ -4461,6 +4991,9 @@ unsigned int Species::GetCheckSum() const {
     return retval;
 }
 
+bool Species::CandidateLocal() const
+{ return AllCandidateLocal(m_names); }
+
 std::unique_ptr<Condition> Species::Clone() const
 { return std::make_unique<Species>(ValueRef::CloneUnique(m_names)); }
 
@@ -4962,6 +5495,9 @@ unsigned int FocusType::GetCheckSum() const {
     return retval;
 }
 
+bool FocusType::CandidateLocal() const
+{ return AllCandidateLocal(m_names); }
+
 std::unique_ptr<Condition> FocusType::Clone() const
 { return std::make_unique<FocusType>(ValueRef::CloneUnique(m_names)); }
 
@@ -6254,6 +6790,9 @@ unsigned int MeterValue::GetCheckSum() const {
     return retval;
 }
 
+bool MeterValue::CandidateLocal() const
+{ return (!m_low || m_low->CandidateLocal()) && (!m_high || m_high->CandidateLocal()); }
+
 std::unique_ptr<Condition> MeterValue::Clone() const {
     return std::make_unique<MeterValue>(m_meter,
                                         ValueRef::CloneUnique(m_low),
@@ -6493,12 +7032,10 @@ void EmpireMeterValue::Eval(const ScriptingContext& parent_context,
         // specified empire meter was in the requested range
         if (search_domain == SearchDomain::MATCHES && !match) {
             // move all objects from matches to non_matches
-            std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         } else if (search_domain == SearchDomain::NON_MATCHES && match) {
             // move all objects from non_matches to matches
-            std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         }
 
     } else {
@@ -6682,12 +7219,10 @@ void EmpireStockpileValue::Eval(const ScriptingContext& parent_context,
         // specified empire meter was in the requested range
         if (search_domain == SearchDomain::MATCHES && !match) {
             // move all objects from matches to non_matches
-            std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         } else if (search_domain == SearchDomain::NON_MATCHES && match) {
             // move all objects from non_matches to matches
-            std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         }
 
     } else {
@@ -6853,12 +7388,10 @@ void EmpireHasAdoptedPolicy::Eval(const ScriptingContext& parent_context,
         // specified empire meter was in the requested range
         if (match && search_domain == SearchDomain::NON_MATCHES) {
             // move all objects from non_matches to matches
-            matches.insert(matches.end(), non_matches.begin(), non_matches.end());
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         } else if (!match && search_domain == SearchDomain::MATCHES) {
             // move all objects from matches to non_matches
-            non_matches.insert(non_matches.end(), matches.begin(), matches.end());
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         }
 
     } else {
@@ -6986,7 +7519,10 @@ namespace {
             m_empire_id(empire_id),
             m_name(name),
             m_context(context)
-        {}
+        {
+            if (const Tech* tech = GetTech(name))
+                m_tech_index = tech->Index();
+        }
 
         bool operator()(const std::shared_ptr<const UniverseObject>& candidate) const {
             if (!candidate)
@@ -7003,11 +7539,12 @@ namespace {
             if (!empire)
                 return false;
 
-            return empire->TechResearched(m_name);
+            return m_tech_index >= 0 ? empire->TechResearched(m_tech_index) : empire->TechResearched(m_name);
         }
 
         int                     m_empire_id = ALL_EMPIRES;
         const std::string&      m_name;
+        int                     m_tech_index = -1;  // Tech::Index() of m_name, looked up once rather than per candidate
         const ScriptingContext& m_context;
     };
 }
@@ -7783,29 +8320,54 @@ bool WithinDistance::operator==(const Condition& rhs) const {
 }
 
 namespace {
+    // with fewer subcondition matches than this, it's faster to check each
+    // candidate against all of them than to index them in a PositionGrid
+    constexpr std::size_t MIN_INDEXED_WITHIN_DISTANCE_MATCHES = 16;
+
     struct WithinDistanceSimpleMatch {
         WithinDistanceSimpleMatch(const ObjectSet& from_objects, double distance) :
             m_from_objects(from_objects),
-            m_distance2(distance*distance)
+            m_distance(distance),
+            m_grid(IndexPositions(from_objects, distance))
         {}
 
-        bool operator()(const std::shared_ptr<const UniverseObject>& candidate) const {
-            if (!candidate)
-                return false;
+        bool operator()(const std::shared_ptr<const UniverseObject>& candidate) const
+        { return candidate && Near(*candidate, m_distance); }
+
+        /** Is \a candidate within \a distance of any of the passed-in objects? */
+        bool Near(const UniverseObject& candidate, double distance) const {
+            if (m_grid) {
+                // a negative distance has always matched within its magnitude
+                bool near = false;
+                m_grid->ForEachInRange(candidate.X(), candidate.Y(), std::abs(distance),
+                                       [&near](std::size_t) { near = true; return true; });
+                return near;
+            }
 
-            // is candidate object close enough to any of the passed-in objects?
+            double distance2 = distance*distance;
             for (auto& obj : m_from_objects) {
-                double delta_x = candidate->X() - obj->X();
-                double delta_y = candidate->Y() - obj->Y();
-                if (delta_x*delta_x + delta_y*delta_y <= m_distance2)
+                double delta_x = candidate.X() - obj->X();
+                double delta_y = candidate.Y() - obj->Y();
+                if (delta_x*delta_x + delta_y*delta_y <= distance2)
                     return true;
             }
 
             return false;
         }
 
+        static std::shared_ptr<const PositionGrid> IndexPositions(const ObjectSet& objects, double typical_range) {
+            if (objects.size() < MIN_INDEXED_WITHIN_DISTANCE_MATCHES)
+                return nullptr;
+            std::vector<PositionGrid::Position> positions;
+            positions.reserve(objects.size());
+            for (auto& obj : objects)
+                positions.emplace_back(obj->X(), obj->Y());
+            return std::make_shared<const PositionGrid>(std::move(positions), std::abs(typical_range));
+        }
+
         const ObjectSet& m_from_objects;
-        double m_distance2;
+        double m_distance;
+        std::shared_ptr<const PositionGrid> m_grid; // shared so that copies of this predicate are cheap
     };
 }
 
@@ -7826,6 +8388,26 @@ void WithinDistance::Eval(const ScriptingContext& parent_context,
 
         // need to check locations (with respect to subcondition matches) of candidates separately
         EvalImpl(matches, non_matches, search_domain, WithinDistanceSimpleMatch(subcondition_matches, distance));
+
+    } else if (m_condition->LocalCandidateInvariant() &&
+               (parent_context.condition_root_candidate || m_condition->RootCandidateInvariant()))
+    {
+        // only the distance depends on the candidate, so evaluate contained
+        // objects once and the distance for each candidate object
+        TraceLogger(conditions) << "WithinDistance::Eval per-candidate distance case";
+
+        ObjectSet subcondition_matches;
+        m_condition->Eval(parent_context, subcondition_matches);
+        WithinDistanceSimpleMatch near_match(subcondition_matches, 0.0);
+
+        EvalImpl(matches, non_matches, search_domain,
+                 [&near_match, &parent_context, this](const std::shared_ptr<const UniverseObject>& candidate) {
+                     if (!candidate)
+                         return false;
+                     ScriptingContext local_context{ScriptingContext::LocalCandidateView{}, parent_context, candidate};
+                     return near_match.Near(*candidate, m_distance->Eval(local_context));
+                 });
+
     } else {
         // re-evaluate contained objects for each candidate object
         TraceLogger(conditions) << "WithinDistance::Eval full case";
@@ -7833,6 +8415,42 @@ void WithinDistance::Eval(const ScriptingContext& parent_context,
     }
 }
 
+bool WithinDistance::InitialCandidatesIndexed(const ScriptingContext& parent_context) const {
+    // as for the simple case of Eval, the subcondition matches and distance
+    // must be the same for all candidates
+    return ContextObjectIndex(parent_context) && m_distance->LocalCandidateInvariant() &&
+           (parent_context.condition_root_candidate || RootCandidateInvariant());
+}
+
+void WithinDistance::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                                       ObjectSet& condition_non_targets) const
+{
+    if (!InitialCandidatesIndexed(parent_context)) {
+        Condition::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+    const auto* index = ContextObjectIndex(parent_context);
+
+    // only objects near a subcondition match can match, so add just those
+    ObjectSet subcondition_matches;
+    m_condition->Eval(parent_context, subcondition_matches);
+    // a negative distance has always matched within its magnitude
+    const double distance = std::abs(m_distance->Eval(parent_context));
+
+    std::vector<bool> added(index->NumPositioned(), false);
+    const auto first = condition_non_targets.size();
+    for (const auto& from_obj : subcondition_matches) {
+        index->ForEachWithinDistance(from_obj->X(), from_obj->Y(), distance,
+            [&added, &condition_non_targets](std::size_t pos_idx, const auto& obj) {
+                if (added[pos_idx])
+                    return;
+                added[pos_idx] = true;
+                condition_non_targets.push_back(obj);
+            });
+    }
+    SortByID(condition_non_targets, first);
+}
+
 std::string WithinDistance::Description(bool negated/* = false*/) const {
     std::string value_str = m_distance->ConstantExpr() ?
                                 std::to_string(m_distance->Eval()) :
@@ -8875,21 +9493,15 @@ namespace {
                 return false;
             if (m_from_objects.empty())
                 return false;
-            const auto& groups = GetSupplyManager().ResourceSupplyGroups(m_empire_id);  // TODO: put supply info in ScriptingContext
-            if (groups.empty())
+            const auto& group_ids = GetSupplyManager().ResourceSupplyGroupIDs(m_empire_id);  // TODO: put supply info in ScriptingContext
+            if (group_ids.empty())
                 return false;
 
             // is candidate object connected to a subcondition matching object by resource supply?
             // first check if candidate object is (or is a building on) a blockaded planet
             // "isolated" objects are anything not in a non-blockaded system
-            bool is_isolated = true;
-            for (const auto& group : groups) {
-                if (group.count(candidate->SystemID())) {
-                    is_isolated = false;
-                    break;
-                }
-            }
-            if (is_isolated) {
+            auto candidate_group_it = group_ids.find(candidate->SystemID());
+            if (candidate_group_it == group_ids.end()) {
                 // planets are still supply-connected to themselves even if blockaded
                 auto candidate_planet = std::dynamic_pointer_cast<const Planet>(candidate);
                 std::shared_ptr<const ::Building> building;
@@ -8912,19 +9524,9 @@ namespace {
             }
             // candidate is not blockaded, so check for system group matches
             for (auto& from_object : m_from_objects) {
-                for (const auto& group : groups) {
-                    if (group.count(from_object->SystemID())) {
-                        // found resource sharing group containing test object system.  Does it also contain candidate?
-                        if (group.count(candidate->SystemID()))
-                            return true;    // test object and candidate object are in same resourse sharing group
-                        else
-                            // test object is not in resource sharing group with candidate
-                            // as each object can be in only one group, no need to check the remaining groups
-                            break;
-                    }
-                    // current subcondition-matching object is not in this resource sharing group
-                }
-                // current subcondition-matching object is not in any resource sharing group for this empire
+                auto from_group_it = group_ids.find(from_object->SystemID());
+                if (from_group_it != group_ids.end() && from_group_it->second == candidate_group_it->second)
+                    return true;    // test object and candidate object are in same resourse sharing group
             }
 
             return false;
@@ -9472,12 +10074,10 @@ void ValueTest::Eval(const ScriptingContext& parent_context,
         // transfer objects to or from candidate set, according to whether the value comparisons were true
         if (search_domain == SearchDomain::MATCHES && !match) {
             // move all objects from matches to non_matches
-            std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-            matches.clear();
+            MoveAllObjects(matches, non_matches);
         } else if (search_domain == SearchDomain::NON_MATCHES && match) {
             // move all objects from non_matches to matches
-            std::move(non_matches.begin(), non_matches.end(), std::back_inserter(matches));
-            non_matches.clear();
+            MoveAllObjects(non_matches, matches);
         }
 
     } else {
@@ -9779,8 +10379,7 @@ void Location::Eval(const ScriptingContext& parent_context,
             // condition, match nothing
             if (search_domain == SearchDomain::MATCHES) {
                 // move all objects from matches to non_matches
-                std::move(matches.begin(), matches.end(), std::back_inserter(non_matches));
-                matches.clear();
+                MoveAllObjects(matches, non_matches);
             }
         }
 
@@ -9953,8 +10552,7 @@ void CombatTarget::Eval(const ScriptingContext& parent_context,
             // targetting condition (eg. in valid content type, or name of
             // a bit of content that doesn't exist), match nothing
             if (search_domain == SearchDomain::MATCHES) {
-                non_matches.insert(non_matches.end(), matches.begin(), matches.end());
-                matches.clear();
+                MoveAllObjects(matches, non_matches);
             }
         }
 
@@ -10045,6 +10643,8 @@ And::And(std::vector<std::unique_ptr<Condition>>&& operands) :
     m_root_candidate_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->RootCandidateInvariant(); });
     m_target_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->TargetInvariant(); });
     m_source_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->SourceInvariant(); });
+    if (m_operands.size() > 1 && AllMemoizable(m_operands))
+        m_operand_order = std::make_shared<ConditionOperandOrder>(m_operands.size(), ConditionOperandOrder::Combination::AND);
 }
 
 And::And(std::unique_ptr<Condition>&& operand1, std::unique_ptr<Condition>&& operand2,
@@ -10064,6 +10664,8 @@ And::And(std::unique_ptr<Condition>&& operand1, std::unique_ptr<Condition>&& ope
     m_root_candidate_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->RootCandidateInvariant(); });
     m_target_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->TargetInvariant(); });
     m_source_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->SourceInvariant(); });
+    if (m_operands.size() > 1 && AllMemoizable(m_operands))
+        m_operand_order = std::make_shared<ConditionOperandOrder>(m_operands.size(), ConditionOperandOrder::Combination::AND);
 }
 
 bool And::operator==(const Condition& rhs) const {
@@ -10097,6 +10699,11 @@ void And::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
         }
     }
 
+    if (UseMaskEvaluation(parent_context, search_domain == SearchDomain::MATCHES ? matches : non_matches)) {
+        EvalWithMask(*this, parent_context, matches, non_matches, search_domain);
+        return;
+    }
+
     auto ObjList = [](const ObjectSet& objs) -> std::string {
         std::stringstream ss;
         for (const auto& obj : objs)
@@ -10108,21 +10715,32 @@ void And::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
                             << " with input matches (" << matches.size() << "): " << ObjList(matches)
                             << " and input non_matches(" << non_matches.size() << "): " << ObjList(non_matches);
 
+    // evaluate operands in order of measured cost and selectivity, if they
+    // can be reordered
+    auto* operand_order = parent_context.ContextUniverse().ReorderConditionOperands() ?
+        m_operand_order.get() : nullptr;
+    const auto order = OperandEvaluationOrder(operand_order, m_operands, "And", m_top_level_content);
+
     if (search_domain == SearchDomain::NON_MATCHES) {
-        ObjectSet partly_checked_non_matches;
+        ScratchObjectSet partly_checked_scratch;
+        auto& partly_checked_non_matches = *partly_checked_scratch;
         partly_checked_non_matches.reserve(non_matches.size());
 
         // move items in non_matches set that pass first operand condition into
         // partly_checked_non_matches set
-        m_operands[0]->Eval(parent_context, partly_checked_non_matches, non_matches, SearchDomain::NON_MATCHES);
-        TraceLogger(conditions) << "Subcondition: " << m_operands[0]->Dump()
+        const auto& first_operand = m_operands[order[0]];
+        EvalMeasuredOperand(operand_order, order[0], *first_operand, parent_context,
+                            partly_checked_non_matches, non_matches, SearchDomain::NON_MATCHES);
+        TraceLogger(conditions) << "Subcondition: " << first_operand->Dump()
                                 <<"\npartly_checked_non_matches (" << partly_checked_non_matches.size() << "): " << ObjList(partly_checked_non_matches);
 
         // move items that don't pass one of the other conditions back to non_matches
-        for (unsigned int i = 1; i < m_operands.size(); ++i) {
+        for (std::size_t i = 1; i < order.size(); ++i) {
             if (partly_checked_non_matches.empty()) break;
-            m_operands[i]->Eval(parent_context, partly_checked_non_matches, non_matches, SearchDomain::MATCHES);
-            TraceLogger(conditions) << "Subcondition: " << m_operands[i]->Dump()
+            const auto& operand = m_operands[order[i]];
+            EvalMeasuredOperand(operand_order, order[i], *operand, parent_context,
+                                partly_checked_non_matches, non_matches, SearchDomain::MATCHES);
+            TraceLogger(conditions) << "Subcondition: " << operand->Dump()
                                     <<"\npartly_checked_non_matches (" << partly_checked_non_matches.size() << "): " << ObjList(partly_checked_non_matches);
         }
 
@@ -10137,9 +10755,10 @@ void And::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
         // check all operand conditions on all objects in the matches set, moving those
         // that don't pass a condition to the non-matches set
 
-        for (auto& operand : m_operands) {
+        for (auto idx : order) {
             if (matches.empty()) break;
-            operand->Eval(parent_context, matches, non_matches, SearchDomain::MATCHES);
+            const auto& operand = m_operands[idx];
+            EvalMeasuredOperand(operand_order, idx, *operand, parent_context, matches, non_matches, SearchDomain::MATCHES);
             TraceLogger(conditions) << "Subcondition: " << operand->Dump()
                                     <<"\nremaining matches (" << matches.size() << "): " << ObjList(matches);
         }
@@ -10151,6 +10770,27 @@ void And::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
                             << " and non_matches (" << non_matches.size() << "): " << ObjList(non_matches);
 }
 
+void And::EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                   CandidateMask& mask) const
+{
+    if (m_operands.empty() || !AllNonNull(m_operands)) {
+        ErrorLogger() << "And::EvalMask given no or null operands!";
+        mask.reset();
+        return;
+    }
+
+    auto* operand_order = parent_context.ContextUniverse().ReorderConditionOperands() ?
+        m_operand_order.get() : nullptr;
+    const auto order = OperandEvaluationOrder(operand_order, m_operands, "And", m_top_level_content);
+
+    // each operand clears the bits of the candidates it doesn't match
+    for (auto idx : order) {
+        if (mask.none())
+            break;
+        EvalMeasuredOperandMask(operand_order, idx, *m_operands[idx], parent_context, candidates, mask);
+    }
+}
+
 std::string And::Description(bool negated/* = false*/) const {
     std::string values_str;
     if (m_operands.size() == 1) {
@@ -10191,14 +10831,27 @@ std::string And::Dump(unsigned short ntabs) const {
 }
 
 void And::GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context, ObjectSet& condition_non_targets) const {
-    if (!m_operands.empty()) {
-        m_operands[0]->GetDefaultInitialCandidateObjects(parent_context, condition_non_targets); // gets condition_non_targets from first operand condition
-    } else {
+    if (m_operands.empty()) {
         Condition::GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+        return;
+    }
+
+    // all matches are in the candidates of every operand, so prefer an
+    // operand that can look up the objects near some others, such as those
+    // near the source of a field's effects, to one that may give all objects
+    for (const auto& operand : m_operands) {
+        const auto* within_distance = dynamic_cast<const WithinDistance*>(operand.get());
+        if (within_distance && within_distance->InitialCandidatesIndexed(parent_context)) {
+            within_distance->GetDefaultInitialCandidateObjects(parent_context, condition_non_targets);
+            return;
+        }
     }
+
+    m_operands[0]->GetDefaultInitialCandidateObjects(parent_context, condition_non_targets); // gets condition_non_targets from first operand condition
 }
 
 void And::SetTopLevelContent(const std::string& content_name) {
+    m_top_level_content = content_name;
     for (auto& operand : m_operands) {
         operand->SetTopLevelContent(content_name);
     }
@@ -10214,6 +10867,9 @@ unsigned int And::GetCheckSum() const {
     return retval;
 }
 
+bool And::CandidateLocal() const
+{ return AllCandidateLocal(m_operands); }
+
 std::vector<const Condition*> And::Operands() const {
     std::vector<const Condition*> retval;
     retval.reserve(m_operands.size());
@@ -10222,8 +10878,14 @@ std::vector<const Condition*> And::Operands() const {
     return retval;
 }
 
-std::unique_ptr<Condition> And::Clone() const
-{ return std::make_unique<And>(ValueRef::CloneUnique(m_operands)); }
+bool And::Memoizable() const
+{ return AllMemoizable(m_operands); }
+
+std::unique_ptr<Condition> And::Clone() const {
+    auto retval = std::make_unique<And>(ValueRef::CloneUnique(m_operands));
+    retval->m_top_level_content = m_top_level_content;
+    return retval;
+}
 
 ///////////////////////////////////////////////////////////
 // Or                                                    //
@@ -10235,6 +10897,8 @@ Or::Or(std::vector<std::unique_ptr<Condition>>&& operands) :
     m_root_candidate_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->RootCandidateInvariant(); });
     m_target_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->TargetInvariant(); });
     m_source_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->SourceInvariant(); });
+    if (m_operands.size() > 1 && AllMemoizable(m_operands))
+        m_operand_order = std::make_shared<ConditionOperandOrder>(m_operands.size(), ConditionOperandOrder::Combination::OR);
 }
 
 Or::Or(std::unique_ptr<Condition>&& operand1,
@@ -10256,6 +10920,8 @@ Or::Or(std::unique_ptr<Condition>&& operand1,
     m_root_candidate_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->RootCandidateInvariant(); });
     m_target_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->TargetInvariant(); });
     m_source_invariant = boost::algorithm::all_of(m_operands, [](auto& e){ return !e || e->SourceInvariant(); });
+    if (m_operands.size() > 1 && AllMemoizable(m_operands))
+        m_operand_order = std::make_shared<ConditionOperandOrder>(m_operands.size(), ConditionOperandOrder::Combination::OR);
 }
 
 bool Or::operator==(const Condition& rhs) const {
@@ -10289,35 +10955,50 @@ void Or::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
         }
     }
 
+    if (UseMaskEvaluation(parent_context, search_domain == SearchDomain::MATCHES ? matches : non_matches)) {
+        EvalWithMask(*this, parent_context, matches, non_matches, search_domain);
+        return;
+    }
+
+    // evaluate operands in order of measured cost and selectivity, if they
+    // can be reordered
+    auto* operand_order = parent_context.ContextUniverse().ReorderConditionOperands() ?
+        m_operand_order.get() : nullptr;
+    const auto order = OperandEvaluationOrder(operand_order, m_operands, "Or", m_top_level_content);
+
     if (search_domain == SearchDomain::NON_MATCHES) {
         // check each item in the non-matches set against each of the operand conditions
         // if a non-candidate item matches an operand condition, move the item to the
         // matches set.
 
-        for (auto& operand : m_operands) {
+        for (auto idx : order) {
             if (non_matches.empty()) break;
-            operand->Eval(parent_context, matches, non_matches, SearchDomain::NON_MATCHES);
+            EvalMeasuredOperand(operand_order, idx, *m_operands[idx], parent_context,
+                                matches, non_matches, SearchDomain::NON_MATCHES);
         }
 
         // items already in matches set are not checked and remain in the
         // matches set even if they fail all the operand conditions
 
     } else {
-        ObjectSet partly_checked_matches;
+        ScratchObjectSet partly_checked_scratch;
+        auto& partly_checked_matches = *partly_checked_scratch;
         partly_checked_matches.reserve(matches.size());
 
         // move items in matches set the fail the first operand condition into
         // partly_checked_matches set
-        m_operands[0]->Eval(parent_context, matches, partly_checked_matches, SearchDomain::MATCHES);
+        EvalMeasuredOperand(operand_order, order[0], *m_operands[order[0]], parent_context,
+                            matches, partly_checked_matches, SearchDomain::MATCHES);
 
         // move items that pass any of the other conditions back into matches
-        for (auto& operand : m_operands) {
+        for (auto idx : order) {
             if (partly_checked_matches.empty()) break;
-            operand->Eval(parent_context, matches, partly_checked_matches, SearchDomain::NON_MATCHES);
+            EvalMeasuredOperand(operand_order, idx, *m_operands[idx], parent_context,
+                                matches, partly_checked_matches, SearchDomain::NON_MATCHES);
         }
 
         // merge items that failed all operand conditions into non_matches
-        non_matches.insert(non_matches.end(), partly_checked_matches.begin(), partly_checked_matches.end());
+        non_matches.insert(non_matches.end(), std::make_move_iterator(partly_checked_matches.begin()), std::make_move_iterator(partly_checked_matches.end()));
 
         // items already in non_matches set are not checked and remain in
         // non_matches set even if they pass one or more of the operand
@@ -10325,6 +11006,32 @@ void Or::Eval(const ScriptingContext& parent_context, ObjectSet& matches,
     }
 }
 
+void Or::EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                  CandidateMask& mask) const
+{
+    if (m_operands.empty() || !AllNonNull(m_operands)) {
+        ErrorLogger() << "Or::EvalMask given no or null operands!";
+        mask.reset();
+        return;
+    }
+
+    auto* operand_order = parent_context.ContextUniverse().ReorderConditionOperands() ?
+        m_operand_order.get() : nullptr;
+    const auto order = OperandEvaluationOrder(operand_order, m_operands, "Or", m_top_level_content);
+
+    // each operand is evaluated on the candidates that no earlier operand matched
+    CandidateMask remaining{mask};
+    mask.reset();
+    for (auto idx : order) {
+        if (remaining.none())
+            break;
+        CandidateMask operand_matches{remaining};
+        EvalMeasuredOperandMask(operand_order, idx, *m_operands[idx], parent_context, candidates, operand_matches);
+        mask |= operand_matches;
+        remaining -= operand_matches;
+    }
+}
+
 std::string Or::Description(bool negated/* = false*/) const {
     std::string values_str;
     if (m_operands.size() == 1) {
@@ -10405,6 +11112,7 @@ std::string Or::Dump(unsigned short ntabs) const {
 }
 
 void Or::SetTopLevelContent(const std::string& content_name) {
+    m_top_level_content = content_name;
     for (auto& operand : m_operands) {
         operand->SetTopLevelContent(content_name);
     }
@@ -10420,8 +11128,17 @@ unsigned int Or::GetCheckSum() const {
     return retval;
 }
 
-std::unique_ptr<Condition> Or::Clone() const
-{ return std::make_unique<Or>(ValueRef::CloneUnique(m_operands)); }
+bool Or::CandidateLocal() const
+{ return AllCandidateLocal(m_operands); }
+
+bool Or::Memoizable() const
+{ return AllMemoizable(m_operands); }
+
+std::unique_ptr<Condition> Or::Clone() const {
+    auto retval = std::make_unique<Or>(ValueRef::CloneUnique(m_operands));
+    retval->m_top_level_content = m_top_level_content;
+    return retval;
+}
 
 ///////////////////////////////////////////////////////////
 // Not                                                   //
@@ -10467,6 +11184,20 @@ void Not::Eval(const ScriptingContext& parent_context, ObjectSet& matches, Objec
     }
 }
 
+void Not::EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                   CandidateMask& mask) const
+{
+    if (!m_operand) {
+        ErrorLogger() << "Not::EvalMask found no subcondition to evaluate!";
+        mask.reset();
+        return;
+    }
+
+    CandidateMask operand_matches{mask};
+    EvalOperandMask(*m_operand, parent_context, candidates, operand_matches);
+    mask -= operand_matches;
+}
+
 std::string Not::Description(bool negated/* = false*/) const
 { return m_operand->Description(!negated); }
 
@@ -10491,6 +11222,12 @@ unsigned int Not::GetCheckSum() const {
     return retval;
 }
 
+bool Not::CandidateLocal() const
+{ return m_operand && m_operand->CandidateLocal(); }
+
+bool Not::Memoizable() const
+{ return m_operand && m_operand->Memoizable(); }
+
 std::unique_ptr<Condition> Not::Clone() const
 { return std::make_unique<Not>(ValueRef::CloneUnique(m_operand)); }
 
@@ -10761,6 +11498,12 @@ unsigned int Described::GetCheckSum() const {
     return retval;
 }
 
+bool Described::CandidateLocal() const
+{ return m_condition && m_condition->CandidateLocal(); }
+
+bool Described::Memoizable() const
+{ return m_condition && m_condition->Memoizable(); }
+
 std::unique_ptr<Condition> Described::Clone() const {
     return std::make_unique<Described>(ValueRef::CloneUnique(m_condition),
                                        m_desc_stringtable_key);
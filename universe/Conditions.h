@@ -14,6 +14,8 @@
 #include "../util/Export.h"
 
 
+class ConditionOperandOrder;
+
 namespace ValueRef {
     template <typename T>
     struct ValueRef;
@@ -170,6 +172,8 @@ struct FO_COMMON_API None final : public Condition {
     void SetTopLevelContent(const std::string& content_name) override
     {}
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override
+    { return true; }
 
     std::unique_ptr<Condition> Clone() const override;
 };
@@ -203,8 +207,11 @@ struct FO_COMMON_API EmpireAffiliation final : public Condition {
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
     std::string Description(bool negated = false) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
+    void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                           ObjectSet& condition_non_targets) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -229,6 +236,8 @@ struct FO_COMMON_API RootCandidate final : public Condition {
     void SetTopLevelContent(const std::string& content_name) override
     {}
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override
+    { return true; }
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -348,6 +357,7 @@ struct FO_COMMON_API Type final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -371,6 +381,7 @@ struct FO_COMMON_API Building final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -400,6 +411,7 @@ struct FO_COMMON_API HasSpecial final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -424,6 +436,8 @@ struct FO_COMMON_API HasTag final : public Condition {
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
     std::string Description(bool negated = false) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
+    void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                           ObjectSet& condition_non_targets) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
 
@@ -471,6 +485,7 @@ struct FO_COMMON_API Contains final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -494,6 +509,7 @@ struct FO_COMMON_API ContainedBy final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -564,6 +580,7 @@ struct FO_COMMON_API ObjectID final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -588,6 +605,7 @@ struct FO_COMMON_API PlanetType final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -612,6 +630,7 @@ struct FO_COMMON_API PlanetSize final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -663,6 +682,7 @@ struct FO_COMMON_API Species final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -723,6 +743,7 @@ struct FO_COMMON_API FocusType final : public Condition {
                                            ObjectSet& condition_non_targets) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -924,6 +945,7 @@ struct FO_COMMON_API MeterValue final : public Condition {
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -1181,6 +1203,13 @@ struct FO_COMMON_API WithinDistance final : public Condition {
     bool operator==(const Condition& rhs) const override;
     void Eval(const ScriptingContext& parent_context, ObjectSet& matches,
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
+    void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
+                                           ObjectSet& condition_non_targets) const override;
+
+    /** Returns whether GetDefaultInitialCandidateObjects() looks up just the
+      * objects near the matches of the subcondition in the index of object
+      * positions, rather than giving all objects. */
+    [[nodiscard]] bool InitialCandidatesIndexed(const ScriptingContext& parent_context) const;
     std::string Description(bool negated = false) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
@@ -1514,6 +1543,8 @@ struct FO_COMMON_API And final : public Condition {
     bool operator==(const Condition& rhs) const override;
     void Eval(const ScriptingContext& parent_context, ObjectSet& matches,
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
+    void EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                  CandidateMask& mask) const override;
     void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                            ObjectSet& condition_non_targets) const override;
     std::string Description(bool negated = false) const override;
@@ -1521,11 +1552,15 @@ struct FO_COMMON_API And final : public Condition {
     void SetTopLevelContent(const std::string& content_name) override;
     std::vector<const Condition*> Operands() const;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
 private:
     std::vector<std::unique_ptr<Condition>> m_operands;
+    std::shared_ptr<ConditionOperandOrder>  m_operand_order;    ///< null if the operands can't be reordered
+    std::string                             m_top_level_content;
 };
 
 /** Matches all objects that match at least one Condition in \a operands. */
@@ -1539,17 +1574,23 @@ struct FO_COMMON_API Or final : public Condition {
     bool operator==(const Condition& rhs) const override;
     void Eval(const ScriptingContext& parent_context, ObjectSet& matches,
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
+    void EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                  CandidateMask& mask) const override;
     void GetDefaultInitialCandidateObjects(const ScriptingContext& parent_context,
                                            ObjectSet& condition_non_targets) const override;
     std::string Description(bool negated = false) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     virtual void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
 private:
     std::vector<std::unique_ptr<Condition>> m_operands;
+    std::shared_ptr<ConditionOperandOrder>  m_operand_order;    ///< null if the operands can't be reordered
+    std::string                             m_top_level_content;
 };
 
 /** Matches all objects that do not match the Condition \a operand. */
@@ -1559,10 +1600,14 @@ struct FO_COMMON_API Not final : public Condition {
     bool operator==(const Condition& rhs) const override;
     void Eval(const ScriptingContext& parent_context, ObjectSet& matches,
               ObjectSet& non_matches, SearchDomain search_domain = SearchDomain::NON_MATCHES) const override;
+    void EvalMask(const ScriptingContext& parent_context, const ObjectSet& candidates,
+                  CandidateMask& mask) const override;
     std::string Description(bool negated = false) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -1605,6 +1650,8 @@ struct FO_COMMON_API Described final : public Condition {
     { return m_condition ? m_condition->Dump(ntabs) : ""; }
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
+    bool Memoizable() const override;
 
     std::unique_ptr<Condition> Clone() const override;
 
@@ -118,6 +118,12 @@ namespace Effect {
         virtual bool            IsSitrepEffect() const { return false; }
         virtual bool            IsConditionalEffect() const { return false; }
 
+        /** Returns true iff executing this effect on a target only reads the
+          * source and that target, and only changes the target's meters, so
+          * that it can be executed concurrently with effects that act on
+          * other objects. */
+        virtual bool            TargetLocal() const { return false; }
+
         // TODO: source-invariant?
 
         virtual void            SetTopLevelContent(const std::string& content_name) = 0;
@@ -155,6 +161,8 @@ namespace Effect {
     * active in the current turn. */
     class FO_COMMON_API EffectsGroup {
     public:
+        static constexpr int NO_STACKING_GROUP = -1;
+
         EffectsGroup(std::unique_ptr<Condition::Condition>&& scope,
                      std::unique_ptr<Condition::Condition>&& activation,
                      std::vector<std::unique_ptr<Effect>>&& effects,
@@ -179,6 +187,12 @@ namespace Effect {
                      bool only_generate_sitrep_effects = false) const;
 
         const std::string&              StackingGroup() const       { return m_stacking_group; }
+
+        /** Returns a small non-negative number that identifies the stacking
+          * group of this EffectsGroup, or NO_STACKING_GROUP if it has none.
+          * EffectsGroups with the same stacking group have the same ID. */
+        int                             StackingGroupID() const     { return m_stacking_group_id; }
+
         Condition::Condition*           Scope() const               { return m_scope.get(); }
         Condition::Condition*           Activation() const          { return m_activation.get(); }
         const std::vector<Effect*>      EffectsList() const;
@@ -190,6 +204,9 @@ namespace Effect {
         bool                            HasAppearanceEffects() const;
         bool                            HasSitrepEffects() const;
 
+        /** Returns true iff all effects of this group are TargetLocal(). */
+        bool                            TargetLocal() const;
+
         void                            SetTopLevelContent(const std::string& content_name);
         const std::string&              TopLevelContent() const { return m_content_name; }
 
@@ -199,6 +216,7 @@ namespace Effect {
         std::unique_ptr<Condition::Condition>   m_scope;
         std::unique_ptr<Condition::Condition>   m_activation;
         std::string                             m_stacking_group;
+        int                                     m_stacking_group_id = NO_STACKING_GROUP;
         std::vector<std::unique_ptr<Effect>>    m_effects;
         std::string                             m_accounting_label;
         int                                     m_priority; // constructor sets this, so don't need a default value here
@@ -2,9 +2,11 @@
 
 #include <cctype>
 #include <iterator>
+#include <mutex>
 #include <boost/filesystem/fstream.hpp>
 #include "BuildingType.h"
 #include "Building.h"
+#include "CompiledValueRef.h"
 #include "Condition.h"
 #include "FieldType.h"
 #include "Field.h"
@@ -188,6 +190,20 @@ namespace {
         // generate hopefully unique name?
         return UserString("SYSTEM") + " " + std::to_string(RandInt(objects.size<System>(), objects.size<System>() + 10000));
     }
+
+    /** Returns a dense ID for the stacking group \a name, which is the same for
+      * all EffectsGroups with that stacking group.  Content is parsed on
+      * several threads, so the IDs are assigned under a lock. */
+    int InternStackingGroup(const std::string& name) {
+        if (name.empty())
+            return Effect::EffectsGroup::NO_STACKING_GROUP;
+
+        static std::mutex mutex;
+        static std::unordered_map<std::string, int> ids;
+
+        std::scoped_lock lock(mutex);
+        return ids.emplace(name, static_cast<int>(ids.size())).first->second;
+    }
 }
 
 namespace Effect {
@@ -204,6 +220,7 @@ EffectsGroup::EffectsGroup(std::unique_ptr<Condition::Condition>&& scope,
     m_scope(std::move(scope)),
     m_activation(std::move(activation)),
     m_stacking_group(std::move(stacking_group)),
+    m_stacking_group_id(InternStackingGroup(m_stacking_group)),
     m_effects(std::move(effects)),
     m_accounting_label(std::move(accounting_label)),
     m_priority(priority),
@@ -291,6 +308,12 @@ void EffectsGroup::Execute(ScriptingContext& context,
     }
 }
 
+bool EffectsGroup::TargetLocal() const {
+    return !m_effects.empty() &&
+        std::all_of(m_effects.begin(), m_effects.end(),
+                    [](const auto& effect) { return effect && effect->TargetLocal(); });
+}
+
 const std::vector<Effect*> EffectsGroup::EffectsList() const {
     std::vector<Effect*> retval;
     retval.reserve(m_effects.size());
@@ -482,6 +505,12 @@ SetMeter::SetMeter(MeterType meter,
 {
     if (accounting_label)
         m_accounting_label = std::move(*accounting_label);
+
+    if (m_value && !m_value->TargetInvariant() && !m_value->SimpleIncrement()) {
+        auto compiled_value = std::make_shared<ValueRef::CompiledValueRef>(*m_value);
+        if (compiled_value->CompiledAnyOperations())
+            m_compiled_value = std::move(compiled_value);
+    }
 }
 
 bool SetMeter::operator==(const Effect& rhs) const {
@@ -539,6 +568,13 @@ void SetMeter::Execute(ScriptingContext& context,
         info.custom_label =   (m_accounting_label.empty() ? effect_cause.custom_label : m_accounting_label);
         info.source_id =      context.source ? context.source->ID() : INVALID_OBJECT_ID;
 
+        // evaluate the parts of the value that are the same for all targets once
+        std::vector<double> hoisted_values, eval_stack;
+        if (m_compiled_value) {
+            m_compiled_value->CountTargets(targets.size());
+            hoisted_values = m_compiled_value->EvalHoisted(context);
+        }
+
         // process each target separately in order to do effect accounting for each
         for (auto& target : targets) {
             // get Meter for this effect and target
@@ -553,7 +589,9 @@ void SetMeter::Execute(ScriptingContext& context,
 
             // actually execute effect to modify meter
             ScriptingContext target_meter_context{context, target, meter->Current()};
-            meter->SetCurrent(m_value->Eval(target_meter_context));
+            meter->SetCurrent(m_compiled_value ?
+                              m_compiled_value->Eval(target_meter_context, hoisted_values, eval_stack) :
+                              m_value->Eval(target_meter_context));
 
             // update for meter change and new total
             info.meter_change = meter->Current() - info.running_meter_total;
@@ -613,6 +651,47 @@ void SetMeter::Execute(ScriptingContext& context, const TargetSet& targets) cons
                 m->AddToCurrent(increment);
         }
         return;
+
+    } else if (m_compiled_value) {
+        // evaluate the parts of the value that are the same for all targets
+        // once, and the rest of the compiled value for each target
+        m_compiled_value->CountTargets(targets.size());
+        const auto hoisted_values = m_compiled_value->EvalHoisted(context);
+
+        if (const auto* affine_input = m_compiled_value->Affine()) {
+            // value is an affine function of one meter of each target, so
+            // gather those meters' values and evaluate for all targets at once
+            std::vector<Meter*> meters;
+            std::vector<double> values;
+            meters.reserve(targets.size());
+            values.reserve(targets.size());
+            for (auto& target : targets) {
+                Meter* m = target->GetMeter(m_meter);
+                if (!m)
+                    continue;
+                meters.push_back(m);
+                if (affine_input->current_value) {
+                    values.push_back(m->Current());
+                } else {
+                    const Meter* input = target->GetMeter(affine_input->meter);
+                    values.push_back(!input ? 0.0 : affine_input->immediate ? input->Current() : input->Initial());
+                }
+            }
+
+            m_compiled_value->EvalAffine(hoisted_values, values);
+            for (std::size_t idx = 0; idx < meters.size(); ++idx)
+                meters[idx]->SetCurrent(values[idx]);
+            return;
+        }
+
+        std::vector<double> eval_stack;
+        for (auto& target : targets) {
+            if (Meter* m = target->GetMeter(m_meter)) {
+                ScriptingContext target_meter_context{context, target, m->Current()};
+                m->SetCurrent(m_compiled_value->Eval(target_meter_context, hoisted_values, eval_stack));
+            }
+        }
+        return;
     }
 
     // meter value depends on target non-trivially, so handle with default case of per-target ValueRef evaluation
@@ -668,6 +747,9 @@ std::string SetMeter::Dump(unsigned short ntabs) const {
     return retval;
 }
 
+bool SetMeter::TargetLocal() const
+{ return m_value && m_value->TargetLocal(); }
+
 void SetMeter::SetTopLevelContent(const std::string& content_name) {
     if (m_value)
         m_value->SetTopLevelContent(content_name);
@@ -1884,6 +1966,12 @@ void CreateShip::Execute(ScriptingContext& context) const {
     }
 }
 
+void CreateShip::Execute(ScriptingContext& context, const TargetSet& targets) const {
+    // each target gets a new ship, in a new fleet
+    context.ContextUniverse().ReserveObjectIDs(2 * targets.size());
+    Effect::Execute(context, targets);
+}
+
 std::string CreateShip::Dump(unsigned short ntabs) const {
     std::string retval = DumpIndent(ntabs) + "CreateShip";
     if (m_design_id)
@@ -2405,6 +2493,8 @@ void AddStarlanes::Execute(ScriptingContext& context) const {
         target_system->AddStarlane(endpoint_system->ID());
         endpoint_system->AddStarlane(target_system->ID());
     }
+    if (!endpoint_systems.empty())
+        context.ContextUniverse().StarlaneTopologyChanged();
 }
 
 std::string AddStarlanes::Dump(unsigned short ntabs) const
@@ -2476,6 +2566,8 @@ void RemoveStarlanes::Execute(ScriptingContext& context) const {
         target_system->RemoveStarlane(endpoint_system->ID());
         endpoint_system->RemoveStarlane(target_system_id);
     }
+    if (!endpoint_systems.empty())
+        context.ContextUniverse().StarlaneTopologyChanged();
 }
 
 std::string RemoveStarlanes::Dump(unsigned short ntabs) const
@@ -2792,6 +2884,7 @@ void MoveTo::Execute(ScriptingContext& context) const {
         // move target system to new destination, and insert destination object
         // and related objects into system
         system->MoveTo(destination);
+        context.ContextUniverse().StarlaneTopologyChanged();   // lane lengths changed
 
         if (destination->ObjectType() == UniverseObjectType::OBJ_FIELD)
             system->Insert(destination);
@@ -2908,6 +3001,7 @@ void MoveInOrbit::Execute(ScriptingContext& context) const {
 
     if (auto system = std::dynamic_pointer_cast<System>(target)) {
         system->MoveTo(new_x, new_y);
+        context.ContextUniverse().StarlaneTopologyChanged();   // lane lengths changed
         return;
 
     } else if (auto fleet = std::dynamic_pointer_cast<Fleet>(target)) {
@@ -3068,6 +3162,7 @@ void MoveTowards::Execute(ScriptingContext& context) const {
 
     if (auto system = std::dynamic_pointer_cast<System>(target)) {
         system->MoveTo(new_x, new_y);
+        context.ContextUniverse().StarlaneTopologyChanged();   // lane lengths changed
         for (auto& obj : context.ContextObjects().find<UniverseObject>(system->ObjectIDs()))
             obj->MoveTo(new_x, new_y);
 
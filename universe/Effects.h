@@ -14,6 +14,7 @@ namespace Condition {
 namespace ValueRef {
     template <typename T>
     struct ValueRef;
+    class CompiledValueRef;
 }
 
 namespace Effect {
@@ -58,6 +59,7 @@ public:
 
     std::string         Dump(unsigned short ntabs = 0) const override;
     bool                IsMeterEffect() const override { return true; }
+    bool                TargetLocal() const override;
     void                SetTopLevelContent(const std::string& content_name) override;
     MeterType           GetMeterType() const { return m_meter; };
     const std::string&  AccountingLabel() const { return m_accounting_label; }
@@ -68,6 +70,7 @@ public:
 private:
     MeterType m_meter;
     std::unique_ptr<ValueRef::ValueRef<double>> m_value;
+    std::shared_ptr<const ValueRef::CompiledValueRef> m_compiled_value; ///< m_value compiled for evaluating for many targets, or null if that wouldn't help
     std::string m_accounting_label;
 };
 
@@ -372,6 +375,7 @@ public:
                std::vector<std::unique_ptr<Effect>>&& effects_to_apply_after);
 
     void Execute(ScriptingContext& context) const override;
+    void Execute(ScriptingContext& context, const TargetSet& targets) const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
     unsigned int GetCheckSum() const override;
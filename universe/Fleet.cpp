@@ -13,6 +13,7 @@
 #include "../util/AppInterface.h"
 #include "../util/Logger.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 #include "../util/i18n.h"
 
 
@@ -109,6 +110,7 @@ void Fleet::Copy(std::shared_ptr<const UniverseObject> copied_object, int empire
     auto visible_specials = GetUniverse().GetObjectVisibleSpecialsByEmpire(copied_object_id, empire_id);
 
     UniverseObject::Copy(std::move(copied_object), vis, visible_specials);
+    std::atomic_store(&m_move_path_cache, std::shared_ptr<const MovePathCache>());
 
     if (vis >= Visibility::VIS_BASIC_VISIBILITY) {
         m_ships =                         copied_fleet->VisibleContainedObjectIDs(empire_id);
@@ -174,7 +176,7 @@ std::string Fleet::Dump(unsigned short ntabs) const {
 int Fleet::ContainerObjectID() const
 { return this->SystemID(); }
 
-const std::set<int>& Fleet::ContainedObjectIDs() const
+const ObjectIDSet& Fleet::ContainedObjectIDs() const
 { return m_ships; }
 
 bool Fleet::Contains(int object_id) const
@@ -220,13 +222,38 @@ int Fleet::MaxShipAgeInTurns() const { // TODO: pass ScriptingContext or ObjectM
 const std::list<int>& Fleet::TravelRoute() const
 { return m_travel_route; }
 
-std::list<MovePathNode> Fleet::MovePath(bool flag_blockades, const ScriptingContext& context) const
+std::vector<MovePathNode> Fleet::MovePath(bool flag_blockades, const ScriptingContext& context) const
 { return MovePath(TravelRoute(), flag_blockades, context); }
 
-std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_blockades,
-                                        const ScriptingContext& context) const
+/** The inputs from which a move path was last calculated, and the result.
+  * Blockades, preserved lanes and the positions and starlanes of systems are
+  * assumed not to change during a turn unless the supply or obstruction of
+  * systems also changes. */
+struct Fleet::MovePathCache {
+    std::vector<int>    route;
+    bool                flag_blockades = false;
+    int                 current_turn = INVALID_GAME_TURN;
+    const ObjectMap*    objects = nullptr;
+    double              x = 0.0;
+    double              y = 0.0;
+    int                 system_id = INVALID_OBJECT_ID;
+    int                 prev_system = INVALID_OBJECT_ID;
+    int                 next_system = INVALID_OBJECT_ID;
+    int                 arrival_starlane = INVALID_OBJECT_ID;
+    FleetAggression     aggression = FleetAggression::INVALID_FLEET_AGGRESSION;
+    float               speed = 0.0f;
+    float               fuel = 0.0f;
+    float               max_fuel = 0.0f;
+    std::set<int>       fleet_supplied_systems;
+    std::set<int>       unobstructed_systems;
+
+    std::vector<MovePathNode> path;
+};
+
+std::vector<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_blockades,
+                                          const ScriptingContext& context) const
 {
-    std::list<MovePathNode> retval;
+    std::vector<MovePathNode> retval;
 
     if (route.empty())
         return retval; // nowhere to go => empty path
@@ -234,7 +261,8 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
     //                        its final destination.  normal looping to read destination should work fine
     if (route.size() == 2 && route.front() == route.back())
         return retval; // nowhere to go => empty path
-    if (this->Speed(context.ContextObjects()) < FLEET_MOVEMENT_EPSILON) { // TODO: cache speed and reuse later in function?
+    const float speed = this->Speed(context.ContextObjects());
+    if (speed < FLEET_MOVEMENT_EPSILON) {
         retval.emplace_back(this->X(), this->Y(), true, ETA_NEVER,
                             this->SystemID(),
                             INVALID_OBJECT_ID,
@@ -246,16 +274,6 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
     float fuel = Fuel(context.ContextObjects());
     float max_fuel = MaxFuel(context.ContextObjects());
 
-    auto RouteNums = [route]() {
-        std::stringstream ss;
-        for (int waypoint : route)
-            ss << waypoint << " ";
-        return ss.str();
-    };
-    TraceLogger() << "Fleet::MovePath for Fleet " << this->Name() << " (" << this->ID()
-                  << ") fuel: " << fuel << " at sys id: " << this->SystemID() << "  route: "
-                  << RouteNums();
-
     // determine all systems where fleet(s) can be resupplied if fuel runs out
     auto empire = context.GetEmpire(this->Owner());
     auto fleet_supplied_systems = context.supply.FleetSupplyableSystemIDs(this->Owner(), ALLOW_ALLIED_SUPPLY);
@@ -273,6 +291,69 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
         return retval;      // can't move => path is just this system with explanatory ETA
     }
 
+    // reuse the last calculated path if nothing it depends on has changed
+    auto cache = std::atomic_load(&m_move_path_cache);
+    if (cache &&
+        cache->flag_blockades == flag_blockades &&
+        cache->current_turn == context.current_turn &&
+        cache->objects == &context.ContextObjects() &&
+        cache->x == this->X() && cache->y == this->Y() &&
+        cache->system_id == this->SystemID() &&
+        cache->prev_system == m_prev_system &&
+        cache->next_system == m_next_system &&
+        cache->arrival_starlane == m_arrival_starlane &&
+        cache->aggression == m_aggression &&
+        cache->speed == speed && cache->fuel == fuel && cache->max_fuel == max_fuel &&
+        cache->route.size() == route.size() &&
+        std::equal(route.begin(), route.end(), cache->route.begin()) &&
+        cache->fleet_supplied_systems == fleet_supplied_systems &&
+        cache->unobstructed_systems == unobstructed_systems)
+    { return cache->path; }
+
+    auto new_cache = std::make_shared<MovePathCache>();
+    new_cache->path = SimulateMovePath(route, flag_blockades, context, speed, fuel, max_fuel,
+                                       fleet_supplied_systems, unobstructed_systems);
+    retval = new_cache->path;
+
+    new_cache->route.assign(route.begin(), route.end());
+    new_cache->flag_blockades = flag_blockades;
+    new_cache->current_turn = context.current_turn;
+    new_cache->objects = &context.ContextObjects();
+    new_cache->x = this->X();
+    new_cache->y = this->Y();
+    new_cache->system_id = this->SystemID();
+    new_cache->prev_system = m_prev_system;
+    new_cache->next_system = m_next_system;
+    new_cache->arrival_starlane = m_arrival_starlane;
+    new_cache->aggression = m_aggression;
+    new_cache->speed = speed;
+    new_cache->fuel = fuel;
+    new_cache->max_fuel = max_fuel;
+    new_cache->fleet_supplied_systems = std::move(fleet_supplied_systems);
+    new_cache->unobstructed_systems = unobstructed_systems;
+    std::atomic_store(&m_move_path_cache, std::shared_ptr<const MovePathCache>(std::move(new_cache)));
+
+    return retval;
+}
+
+std::vector<MovePathNode> Fleet::SimulateMovePath(const std::list<int>& route, bool flag_blockades,
+                                                  const ScriptingContext& context, float speed, float fuel,
+                                                  float max_fuel, const std::set<int>& fleet_supplied_systems,
+                                                  const std::set<int>& unobstructed_systems) const
+{
+    std::vector<MovePathNode> retval;
+
+    auto RouteNums = [&route]() {
+        std::stringstream ss;
+        for (int waypoint : route)
+            ss << waypoint << " ";
+        return ss.str();
+    };
+    TraceLogger() << "Fleet::MovePath for Fleet " << this->Name() << " (" << this->ID()
+                  << ") fuel: " << fuel << " at sys id: " << this->SystemID() << "  route: "
+                  << RouteNums();
+
+    auto empire = context.GetEmpire(this->Owner());
 
     // get iterator pointing to std::shared_ptr<System> on route that is the
     // first after where this fleet is currently. if this fleet is in a system,
@@ -330,7 +411,7 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
 
     constexpr int TOO_LONG =            100; // limit on turns to simulate.  99 turns max keeps ETA to two digits, making UI work better
     int           turns_taken =         1;
-    double        turn_dist_remaining = this->Speed(context.ContextObjects()); // additional distance that can be travelled in current turn of fleet movement being simulated
+    double        turn_dist_remaining = speed; // additional distance that can be travelled in current turn of fleet movement being simulated
     double        cur_x =               this->X();
     double        cur_y =               this->Y();
     double        next_x =              next_system->X();
@@ -525,7 +606,7 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
         if (end_turn_at_cur_position) {
             //DebugLogger() << " ... end of simulated turn " << turns_taken;
             ++turns_taken;
-            turn_dist_remaining = this->Speed(context.ContextObjects());
+            turn_dist_remaining = speed;
         }
     }
 
@@ -551,21 +632,21 @@ std::list<MovePathNode> Fleet::MovePath(const std::list<int>& route, bool flag_b
 std::pair<int, int> Fleet::ETA(const ScriptingContext& context) const
 { return ETA(MovePath(false, context)); }
 
-std::pair<int, int> Fleet::ETA(const std::list<MovePathNode>& move_path) const {
+std::pair<int, int> Fleet::ETA(const std::vector<MovePathNode>& move_path) const {
     // check that path exists.  if empty, there was no valid route or some other problem prevented pathing
     if (move_path.empty())
         return {ETA_UNKNOWN, ETA_UNKNOWN};
 
     // check for single node in path.  return the single node's eta as both .first and .second (likely indicates that fleet couldn't move)
     if (move_path.size() == 1) {
-        const MovePathNode& node = *move_path.begin();
+        const MovePathNode& node = move_path.front();
         return {node.eta, node.eta};
     }
 
     // general case: there is a multi-node path.  return the ETA of the first object node, and the ETA of the last node
-    int last_stop_eta = move_path.rbegin()->eta;
+    int last_stop_eta = move_path.back().eta;
     int first_stop_eta = last_stop_eta;
-    for (auto it = ++(move_path.begin()); it != move_path.end(); ++it) {
+    for (auto it = std::next(move_path.begin()); it != move_path.end(); ++it) {
         const MovePathNode& node = *it;
         if (node.object_id != INVALID_OBJECT_ID) {
             first_stop_eta = node.eta;
@@ -636,7 +717,7 @@ int Fleet::FinalDestinationID() const {
 
 namespace {
     bool HasXShips(const std::function<bool(const std::shared_ptr<const Ship>&)>& pred,
-                   const std::set<int>& ship_ids,
+                   const ObjectIDSet& ship_ids,
                    const ObjectMap& objects)
     {
         // Searching for each Ship one at a time is possibly faster than
@@ -821,7 +902,60 @@ void Fleet::SetNextAndPreviousSystems(int next, int prev) {
     m_arrival_starlane = prev; // see comment for ArrivalStarlane()
 }
 
-void Fleet::MovementPhase(ScriptingContext& context) {
+void Fleet::MovementPhase(const std::vector<std::shared_ptr<Fleet>>& fleets, ScriptingContext& context) {
+    // if owner of fleet can resupply ships at the location of this fleet, then
+    // resupply all ships in this fleet. fleets' move paths depend on their
+    // ships' fuel, but not on the positions of other fleets, so all paths can
+    // be found before any fleet moves
+    for (auto& fleet : fleets) {
+        if (!fleet || !GetSupplyManager().SystemHasFleetSupply(fleet->SystemID(), fleet->Owner(), ALLOW_ALLIED_SUPPLY))
+            continue;
+        for (auto& ship : context.ContextObjects().find<Ship>(fleet->m_ships))
+            ship->Resupply();
+    }
+
+    // find move paths, and the properties of fleets that determine blockades
+    // which don't change as fleets move, in parallel
+    std::vector<std::vector<MovePathNode>> move_paths(fleets.size());
+    std::vector<BlockadeProperties> properties(fleets.size());
+    {
+        constexpr std::size_t FLEETS_PER_TASK = 64;
+        TaskBatch batch("Fleet::MovementPhase");
+        for (std::size_t first = 0; first < fleets.size(); first += FLEETS_PER_TASK) {
+            batch.Post([&fleets, &context, &move_paths, &properties, first,
+                        last{std::min(fleets.size(), first + FLEETS_PER_TASK)}]()
+            {
+                for (std::size_t idx = first; idx < last; ++idx) {
+                    if (!fleets[idx])
+                        continue;
+                    move_paths[idx] = fleets[idx]->MovePath(false, context);
+                    properties[idx] = fleets[idx]->GetBlockadeProperties(context.ContextObjects());
+                }
+            });
+        }
+        batch.Wait();
+    }
+
+    BlockadePropertiesMap fleet_properties;
+    fleet_properties.reserve(fleets.size());
+    for (std::size_t idx = 0; idx < fleets.size(); ++idx)
+        if (fleets[idx])
+            fleet_properties.emplace(fleets[idx]->ID(), properties[idx]);
+
+    // move fleets one at a time, as blockades depend on which fleets have
+    // already arrived at or left systems. first move unowned fleets, or an
+    // empire fleet landing on them could wrongly blockade them before they move
+    for (std::size_t idx = 0; idx < fleets.size(); ++idx)
+        if (fleets[idx] && fleets[idx]->Unowned())
+            fleets[idx]->MoveAlongPath(std::move(move_paths[idx]), context, fleet_properties);
+    for (std::size_t idx = 0; idx < fleets.size(); ++idx)
+        if (fleets[idx] && !fleets[idx]->Unowned())
+            fleets[idx]->MoveAlongPath(std::move(move_paths[idx]), context, fleet_properties);
+}
+
+void Fleet::MoveAlongPath(std::vector<MovePathNode> move_path, ScriptingContext& context,
+                          const BlockadePropertiesMap& fleet_properties)
+{
     auto empire = context.GetEmpire(Owner());
     std::set<int> supply_unobstructed_systems;
     if (empire)
@@ -830,16 +964,8 @@ void Fleet::MovementPhase(ScriptingContext& context) {
 
     auto ships = context.ContextObjects().find<Ship>(m_ships);
 
-    // if owner of fleet can resupply ships at the location of this fleet, then
-    // resupply all ships in this fleet
-    if (GetSupplyManager().SystemHasFleetSupply(SystemID(), Owner(), ALLOW_ALLIED_SUPPLY)) {
-        for (auto& ship : ships)
-            ship->Resupply();
-    }
-
     auto current_system = context.ContextObjects().get<System>(SystemID());
     auto initial_system = current_system;
-    auto move_path = MovePath(false, context);
 
     if (!move_path.empty()) {
         DebugLogger() << "Fleet::MovementPhase " << this->Name() << " (" << this->ID()
@@ -922,7 +1048,7 @@ void Fleet::MovementPhase(ScriptingContext& context) {
             } else {
                 next_sys_id = next_it->lane_end_id;
             }
-            stopped = BlockadedAtSystem(SystemID(), next_sys_id, context);
+            stopped = BlockadedAtSystem(SystemID(), next_sys_id, context, &fleet_properties);
         }
 
         if (stopped)
@@ -1198,6 +1324,24 @@ bool Fleet::Blockaded(const ScriptingContext& context) const {
 
 bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id,
                               const ScriptingContext& context) const
+{ return BlockadedAtSystem(start_system_id, dest_system_id, context, nullptr); }
+
+Fleet::BlockadeProperties Fleet::GetBlockadeProperties(const ObjectMap& objects) const {
+    BlockadeProperties retval;
+    for (auto& ship : objects.find<const Ship>(m_ships)) {
+        float ship_stealth = ship->GetMeter(MeterType::METER_STEALTH)->Current();
+        if (retval.lowest_ship_stealth > ship_stealth)
+            retval.lowest_ship_stealth = ship_stealth;
+        float cur_detection = ship->GetMeter(MeterType::METER_DETECTION)->Current();
+        if (cur_detection >= retval.highest_ship_detection)
+            retval.highest_ship_detection = cur_detection;
+    }
+    retval.armed_veteran = MaxShipAgeInTurns() > 1 && HasArmedShips(objects);
+    return retval;
+}
+
+bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id, const ScriptingContext& context,
+                              const BlockadePropertiesMap* fleet_properties) const
 {
     /** If a newly arrived fleet joins a non-blockaded fleet of the same empire
       * (perhaps should include allies?) already at the system, the newly
@@ -1244,24 +1388,24 @@ bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id,
         }
     }
 
-    float lowest_ship_stealth = 99999.9f; // arbitrary large number. actual stealth of ships should be less than this...
-    for (auto& ship : objects.find<const Ship>(this->ShipIDs())) {
-        float ship_stealth = ship->GetMeter(MeterType::METER_STEALTH)->Current();
-        if (lowest_ship_stealth > ship_stealth)
-            lowest_ship_stealth = ship_stealth;
-    }
+    // use the precalculated properties of fleets, if available
+    auto properties_of = [fleet_properties, &objects](const Fleet& fleet) {
+        if (fleet_properties) {
+            auto it = fleet_properties->find(fleet.ID());
+            if (it != fleet_properties->end())
+                return it->second;
+        }
+        return fleet.GetBlockadeProperties(objects);
+    };
+
+    const float lowest_ship_stealth = properties_of(*this).lowest_ship_stealth;
 
     float monster_detection = 0.0f;
     auto fleets = objects.find<const Fleet>(current_system->FleetIDs());
     for (auto& fleet : fleets) {
         if (!fleet->Unowned())
             continue;
-
-        for (auto& ship : objects.find<const Ship>(fleet->ShipIDs())) {
-            float cur_detection = ship->GetMeter(MeterType::METER_DETECTION)->Current();
-            if (cur_detection >= monster_detection)
-                monster_detection = cur_detection;
-        }
+        monster_detection = std::max(monster_detection, properties_of(*fleet).highest_ship_detection);
     }
 
     bool can_be_blockaded = false;
@@ -1298,10 +1442,8 @@ bool Fleet::BlockadedAtSystem(int start_system_id, int dest_system_id,
         // ageas since fleets can be created/destroyed as purely organizational matters.  Since these checks are
         // pertinent just during those stages of turn processing immediately following turn number advancement,
         // whereas the new ships were created just prior to turn advamcenemt, we require age greater than 1.
-        if (fleet->MaxShipAgeInTurns() <= 1)
-            continue;
         // These are the most costly checks.  Do them last
-        if (!fleet->HasArmedShips(objects))
+        if (!properties_of(*fleet).armed_veteran)
             continue;
 
         // don't exit early here, because blockade may yet be thwarted by ownership & presence check above
@@ -1,6 +1,7 @@
 #ifndef _Fleet_h_
 #define _Fleet_h_
 
+#include <unordered_map>
 #include "UniverseObject.h"
 #include "ScriptingContext.h"
 #include "../util/AppInterface.h"
@@ -56,7 +57,7 @@ public:
     std::string Dump(unsigned short ntabs = 0) const override;
 
     int ContainerObjectID() const override;
-    const std::set<int>& ContainedObjectIDs() const override;
+    const ObjectIDSet& ContainedObjectIDs() const override;
     bool Contains(int object_id) const override;
     bool ContainedBy(int object_id) const override;
 
@@ -64,7 +65,7 @@ public:
 
     std::shared_ptr<UniverseObject> Accept(const UniverseObjectVisitor& visitor) const override;
 
-    const std::set<int>&    ShipIDs() const { return m_ships; } ///< returns set of IDs of ships in fleet.
+    const ObjectIDSet&      ShipIDs() const { return m_ships; } ///< returns set of IDs of ships in fleet.
     int                     MaxShipAgeInTurns() const;          ///< Returns the age of the oldest ship in the fleet
 
     /** Returns the list of systems that this fleet will move through en route
@@ -81,13 +82,13 @@ public:
     /** Returns a list of locations at which notable events will occur along the fleet's path if it follows the
         specified route.  It is assumed in the calculation that the fleet starts its move path at its actual current
         location, however the fleet's current location will not be on the list, even if it is currently in a system. */
-    std::list<MovePathNode> MovePath(const std::list<int>& route, bool flag_blockades = false,
-                                     const ScriptingContext& context = ScriptingContext{}) const;
-    std::list<MovePathNode> MovePath(bool flag_blockades = false,
-                                     const ScriptingContext& context = ScriptingContext{}) const;   ///< Returns MovePath for fleet's current TravelRoute
+    std::vector<MovePathNode> MovePath(const std::list<int>& route, bool flag_blockades = false,
+                                       const ScriptingContext& context = ScriptingContext{}) const;
+    std::vector<MovePathNode> MovePath(bool flag_blockades = false,
+                                       const ScriptingContext& context = ScriptingContext{}) const; ///< Returns MovePath for fleet's current TravelRoute
 
     std::pair<int, int>     ETA(const ScriptingContext& context) const;         ///< Returns the number of turns which must elapse before the fleet arrives at its current final destination and the turns to the next system, respectively.
-    std::pair<int, int>     ETA(const std::list<MovePathNode>& move_path) const;///< Returns the number of turns which must elapse before the fleet arrives at the final destination and next system in the spepcified \a move_path
+    std::pair<int, int>     ETA(const std::vector<MovePathNode>& move_path) const;///< Returns the number of turns which must elapse before the fleet arrives at the final destination and next system in the spepcified \a move_path
 
     float   Damage(const ObjectMap& objects) const;                     ///< Returns total amount of damage this fleet has, which is the sum of the ships' damage
     float   Structure(const ObjectMap& objects) const;                  ///< Returns total amount of structure this fleet has, which is the sum of the ships' structure
@@ -131,8 +132,11 @@ public:
 
     void Copy(std::shared_ptr<const UniverseObject> copied_object, int empire_id = ALL_EMPIRES) override;
 
-    /** Moves fleet, its ships, and sets systems as explored for empires. */
-    void MovementPhase(ScriptingContext& context);
+    /** Moves \a fleets, their ships, and sets systems as explored for empires.
+      * Move paths are found for all fleets in parallel before any move, and
+      * then fleets are moved one at a time: first unowned fleets, and then
+      * the rest, each in the order given. */
+    static void MovementPhase(const std::vector<std::shared_ptr<Fleet>>& fleets, ScriptingContext& context);
 
     void ResetTargetMaxUnpairedMeters() override;
 
@@ -181,7 +185,36 @@ protected:
     Fleet* Clone(int empire_id = ALL_EMPIRES) const override;
 
 private:
-    std::set<int>               m_ships;
+    struct MovePathCache;
+
+    /** Properties of a fleet that determine whether it blockades or is
+      * blockaded by other fleets, and that don't change while fleets move. */
+    struct BlockadeProperties {
+        float   lowest_ship_stealth = 99999.9f; ///< arbitrary large number if there are no ships. actual stealth of ships should be less than this...
+        float   highest_ship_detection = 0.0f;
+        bool    armed_veteran = false;          ///< has armed ships, and ships more than one turn old
+    };
+    using BlockadePropertiesMap = std::unordered_map<int, BlockadeProperties>;
+
+    BlockadeProperties GetBlockadeProperties(const ObjectMap& objects) const;
+
+    /** Returns true iff this fleet's movement would be blockaded at system.
+      * Uses the properties of fleets in \a fleet_properties, if given, rather
+      * than calculating them. */
+    bool BlockadedAtSystem(int start_system_id, int dest_system_id, const ScriptingContext& context,
+                           const BlockadePropertiesMap* fleet_properties) const;
+
+    /** Moves fleet along \a move_path, which should be its MovePath. */
+    void MoveAlongPath(std::vector<MovePathNode> move_path, ScriptingContext& context,
+                       const BlockadePropertiesMap& fleet_properties);
+
+    /** Calculates the move path along \a route, which MovePath caches. */
+    std::vector<MovePathNode> SimulateMovePath(const std::list<int>& route, bool flag_blockades,
+                                               const ScriptingContext& context, float speed, float fuel,
+                                               float max_fuel, const std::set<int>& fleet_supplied_systems,
+                                               const std::set<int>& unobstructed_systems) const;
+
+    ObjectIDSet                 m_ships;
 
     // these two uniquely describe the starlane graph edge the fleet is on, if it it's on one
     int                         m_prev_system = INVALID_OBJECT_ID;  ///< the previous system in the route, if any
@@ -203,6 +236,8 @@ private:
     bool                        m_arrived_this_turn = false;
     int                         m_arrival_starlane = INVALID_OBJECT_ID; // see comment for ArrivalStarlane()
 
+    mutable std::shared_ptr<const MovePathCache> m_move_path_cache; ///< accessed with std::atomic_load and std::atomic_store, as MovePath may be called from several threads
+
     template <typename Archive>
     friend void serialize(Archive&, Fleet&, unsigned int const);
 };
@@ -1,5 +1,6 @@
 #include "IDAllocator.h"
 
+#include <algorithm>
 #include <limits>
 #include "../util/AppInterface.h"
 #include "../util/LoggerWithOptionsDB.h"
@@ -51,6 +52,16 @@ IDAllocator::IDAllocator(const int server_id,
 }
 
 int IDAllocator::NewID() {
+    if (m_next_reserved_id < m_reserved_ids.size()) {
+        const auto retval = m_reserved_ids[m_next_reserved_id++];
+        if (m_next_reserved_id == m_reserved_ids.size()) {
+            m_reserved_ids.clear();
+            m_next_reserved_id = 0;
+        }
+        TraceLogger(IDallocator) << "Allocating reserved id = " << retval << " for empire = " << m_empire_id;
+        return retval;
+    }
+
     // increment next id for this client until next id is not an already-used id
     IncrementNextAssignedId(m_empire_id, Objects().HighestObjectID());
     IncrementNextAssignedId(m_empire_id, GetUniverse().HighestDestroyedObjectID());
@@ -88,6 +99,95 @@ int IDAllocator::NewID() {
     return retval;
 }
 
+std::vector<IDAllocator::ID_t> IDAllocator::NewIDs(std::size_t count) {
+    std::vector<ID_t> retval;
+    if (count == 0)
+        return retval;
+    retval.reserve(count);
+
+    // take any reserved ids first, as NewID() would
+    while (retval.size() < count && m_next_reserved_id < m_reserved_ids.size())
+        retval.push_back(m_reserved_ids[m_next_reserved_id++]);
+    if (m_next_reserved_id == m_reserved_ids.size()) {
+        m_reserved_ids.clear();
+        m_next_reserved_id = 0;
+    }
+    if (retval.size() == count)
+        return retval;
+
+    IncrementNextAssignedId(m_empire_id, Objects().HighestObjectID());
+    IncrementNextAssignedId(m_empire_id, GetUniverse().HighestDestroyedObjectID());
+
+    auto&& it = m_empire_id_to_next_assigned_object_id.find(m_empire_id);
+    if (it == m_empire_id_to_next_assigned_object_id.end()) {
+        ErrorLogger() << "m_empire_id " << m_empire_id << " not in id manager table.";
+        retval.resize(count, m_invalid_id);
+        return retval;
+    }
+
+    auto& next_id = it->second;
+    if (AssigningEmpireForID(next_id) != m_empire_id)
+        ErrorLogger() << "m_empire_id " << m_empire_id << " does not match apparent assigning id "
+                      << AssigningEmpireForID(next_id) << " for id = " << next_id << " m_zero = " << m_zero
+                      << " stride = " << m_stride;
+
+    // NewID() returns the next id and then advances it, unless it is at or
+    // past the exhausted threshold, so that is the last one returned.
+    const std::size_t wanted = count - retval.size();
+    std::size_t available = 0;
+    if (next_id != m_invalid_id) {
+        const auto remaining = static_cast<long long>(m_exhausted_threshold) - next_id;
+        available = remaining <= 0 ? 1 : static_cast<std::size_t>(1 + (remaining + m_stride - 1) / m_stride);
+    }
+    const std::size_t allocated = std::min(wanted, available);
+
+    const auto first_id = next_id;
+    for (std::size_t ii = 0; ii < allocated; ++ii)
+        retval.push_back(static_cast<ID_t>(first_id + static_cast<long long>(ii) * m_stride));
+    next_id = (allocated == available) ? m_invalid_id :
+        static_cast<ID_t>(first_id + static_cast<long long>(allocated) * m_stride);
+
+    if (allocated > 0 && retval.back() >= m_warn_threshold)
+        WarnLogger() << "Object IDs are almost exhausted. Currently assigning id, " << retval.back();
+
+    if (allocated < wanted) {
+        ErrorLogger() << "Object IDs are exhausted.  No objects can be added to the Universe.";
+        retval.resize(count, m_invalid_id);
+    }
+
+    TraceLogger(IDallocator) << "Allocating " << allocated << " ids from " << first_id
+                             << " for empire = " << m_empire_id;
+    return retval;
+}
+
+void IDAllocator::Reserve(std::size_t count) {
+    const auto reserved = m_reserved_ids.size() - m_next_reserved_id;
+    if (count <= reserved)
+        return;
+
+    m_reserved_ids.erase(m_reserved_ids.begin(), m_reserved_ids.begin() + m_next_reserved_id);
+    m_next_reserved_id = 0;
+
+    // ids are reserved from after those already reserved
+    std::vector<ID_t> already_reserved;
+    already_reserved.swap(m_reserved_ids);
+    auto new_ids = NewIDs(count - reserved);
+    new_ids.erase(std::remove(new_ids.begin(), new_ids.end(), m_invalid_id), new_ids.end());
+
+    m_reserved_ids = std::move(already_reserved);
+    m_reserved_ids.insert(m_reserved_ids.end(), new_ids.begin(), new_ids.end());
+}
+
+void IDAllocator::ReleaseReservedIDs() {
+    if (m_next_reserved_id < m_reserved_ids.size()) {
+        auto it = m_empire_id_to_next_assigned_object_id.find(m_empire_id);
+        if (it != m_empire_id_to_next_assigned_object_id.end())
+            it->second = m_reserved_ids[m_next_reserved_id];
+    }
+    m_reserved_ids.clear();
+    m_next_reserved_id = 0;
+}
+
 std::pair<bool, bool> IDAllocator::IsIDValidAndUnused(const ID_t checked_id, const int checked_empire_id) {
     const std::pair<bool, bool> hard_fail = {false, false};
     const std::pair<bool, bool> complete_success = {true, true};
@@ -195,6 +295,9 @@ void IDAllocator::ObfuscateBeforeSerialization() {
     if (m_empire_id != m_server_id)
         return;;
 
+    // reserved ids would be in the id space of another empire afterwards
+    ReleaseReservedIDs();
+
     TraceLogger(IDallocator) << "Before obfuscation " << StateString();
 
     // Randomize the moduli
@@ -288,6 +391,9 @@ void IDAllocator::SerializeForEmpire(Archive& ar, const unsigned int version, in
                              << "IDAllocator()  server id = "
                              << m_server_id << " empire id = " << empire_id;
 
+    // reserved ids are not serialized, so record them as not allocated
+    ReleaseReservedIDs();
+
     ar  & BOOST_SERIALIZATION_NVP(m_invalid_id)
         & BOOST_SERIALIZATION_NVP(m_temp_id)
         & BOOST_SERIALIZATION_NVP(m_stride);
@@ -44,6 +44,20 @@ public:
     /// Return a valid new id.  This is used by both clients and servers.
     ID_t NewID();
 
+    /** Return \p count new ids, the ones that \p count calls to NewID()
+        would return, with a single lookup and check for exhaustion.  If ids
+        are exhausted before \p count ids are allocated, the rest are the
+        invalid id. */
+    std::vector<ID_t> NewIDs(std::size_t count);
+
+    /** Reserve the next \p count ids, in one call to NewIDs(), for the
+        following calls to NewID() to return, if fewer than \p count are
+        already reserved.  Used before creating many objects at once.  Ids
+        that are reserved but not returned are released before the next
+        obfuscation or serialization, so reserving more ids than are used
+        doesn't change which ids are allocated later. */
+    void Reserve(std::size_t count);
+
     /** Return {hard_success, soft_success} where \p hard_success determines if
         \p id is unused and valid and \p soft_success determines if \p id is in
         the id space of \p empire_id.  This allows errors that are probably due
@@ -77,6 +91,9 @@ private:
     /// Increment the next assigned id for an empire until it is past checked_id.
     void IncrementNextAssignedId(const int assigning_empire, const int checked_id);
 
+    /// Return the reserved ids not yet returned by NewID() to be allocated again.
+    void ReleaseReservedIDs();
+
     /// Return a string representing the state.
     std::string StateString() const;
 
@@ -107,6 +124,10 @@ private:
 
     /// Random number generator
     std::mt19937 m_random_generator;
+
+    /// ids reserved by Reserve(), in allocation order, and the next of them to return
+    std::vector<ID_t> m_reserved_ids;
+    std::size_t m_next_reserved_id = 0;
 };
 
 
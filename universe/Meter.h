@@ -2,6 +2,7 @@
 #define _Meter_h_
 
 
+#include <algorithm>
 #include <string>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
@@ -23,8 +24,8 @@ public:
         the initial value set to @p initial_value. */
     Meter(float current_value, float initial_value);
 
-    float Current() const;                  ///< returns the current value of the meter
-    float Initial() const;                  ///< returns the value of the meter as it was at the beginning of the turn
+    float Current() const noexcept { return m_current_value; }  ///< returns the current value of the meter
+    float Initial() const noexcept { return m_initial_value; }  ///< returns the value of the meter as it was at the beginning of the turn
 
     std::string Dump(unsigned short ntabs = 0) const;   ///< returns text of meter values
 
@@ -34,15 +35,15 @@ public:
     bool operator<(const Meter& rhs) const
     { return m_current_value < rhs.m_current_value || (m_current_value == rhs.m_current_value && m_initial_value < rhs.m_initial_value); }
 
-    void SetCurrent(float current_value);   ///< sets current value, leaving initial value unchanged
-    void Set(float current_value, float initial_value); ///< sets current and initial values
-    void ResetCurrent();                    ///< sets current value to DEFAULT_VALUE
-    void Reset();                           ///< sets current and initial values to DEFAULT_VALUE
+    void SetCurrent(float current_value) noexcept { m_current_value = current_value; }  ///< sets current value, leaving initial value unchanged
+    void Set(float current_value, float initial_value) noexcept;                        ///< sets current and initial values
+    void ResetCurrent() noexcept { m_current_value = DEFAULT_VALUE; }                   ///< sets current value to DEFAULT_VALUE
+    void Reset() noexcept;                                                              ///< sets current and initial values to DEFAULT_VALUE
 
-    void AddToCurrent(float adjustment);    ///< adds \a current to the current value of the Meter
-    void ClampCurrentToRange(float min = DEFAULT_VALUE, float max = LARGE_VALUE);   ///< ensures the current value falls in the range [\a min, \a max]
+    void AddToCurrent(float adjustment) noexcept { m_current_value += adjustment; }     ///< adds \a current to the current value of the Meter
+    void ClampCurrentToRange(float min = DEFAULT_VALUE, float max = LARGE_VALUE) noexcept;  ///< ensures the current value falls in the range [\a min, \a max]
 
-    void BackPropagate();                   ///< sets previous equal to initial, then sets initial equal to current
+    void BackPropagate() noexcept { m_initial_value = m_current_value; }                ///< sets previous equal to initial, then sets initial equal to current
 
     static constexpr float DEFAULT_VALUE = 0.0f;                        ///< value assigned to current or initial when resetting or when no value is specified in a constructor
     static constexpr float LARGE_VALUE = static_cast<float>(2 << 15);   ///< a very large number, which is useful to set current to when it will be later clamped, to ensure that the result is the max value in the clamp range
@@ -59,6 +60,21 @@ private:
 
 BOOST_CLASS_VERSION(Meter, 1)
 
+// defined here rather than in Meter.cpp so that passes over many meters can
+// inline and vectorize them
+inline void Meter::Set(float current_value, float initial_value) noexcept {
+    m_current_value = current_value;
+    m_initial_value = initial_value;
+}
+
+inline void Meter::Reset() noexcept {
+    m_current_value = DEFAULT_VALUE;
+    m_initial_value = DEFAULT_VALUE;
+}
+
+inline void Meter::ClampCurrentToRange(float min, float max) noexcept
+{ m_current_value = std::max(std::min(m_current_value, max), min); }
+
 
 template <typename Archive>
 void Meter::serialize(Archive& ar, const unsigned int version)
@@ -0,0 +1,141 @@
+#ifndef _MeterMap_h_
+#define _MeterMap_h_
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Enums.h"
+#include "Meter.h"
+
+
+/** The meters of a UniverseObject.  The meters are stored contiguously,
+    ordered by MeterType, with a table of slots indexed by MeterType that
+    holds the position of each meter, or ABSENT for types that the object
+    doesn't have.  Looking up a meter is thus an index into the table rather
+    than a search, and passes over all meters of an object are loops over
+    contiguous memory.
+
+    Iterating and looking up give (MeterType, Meter) pairs, as a map of meters
+    would.  Meters are only added, when an object is created or deserialized,
+    so adding is comparatively slow and keeps the meters in order. */
+class MeterMap {
+public:
+    using value_type = std::pair<MeterType, Meter>;
+    using container_type = std::vector<value_type>;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+
+    static constexpr std::int8_t ABSENT = -1;
+
+    MeterMap() noexcept
+    { m_slots.fill(ABSENT); }
+
+    /** Returns the meter of type \a type, or nullptr if there isn't one. */
+    [[nodiscard]] const Meter* get(MeterType type) const noexcept {
+        const auto slot = Slot(type);
+        return slot == ABSENT ? nullptr : &m_meters[slot].second;
+    }
+
+    [[nodiscard]] Meter* get(MeterType type) noexcept {
+        const auto slot = Slot(type);
+        return slot == ABSENT ? nullptr : &m_meters[slot].second;
+    }
+
+    [[nodiscard]] const_iterator find(MeterType type) const noexcept {
+        const auto slot = Slot(type);
+        return slot == ABSENT ? m_meters.end() : m_meters.begin() + slot;
+    }
+
+    [[nodiscard]] iterator find(MeterType type) noexcept {
+        const auto slot = Slot(type);
+        return slot == ABSENT ? m_meters.end() : m_meters.begin() + slot;
+    }
+
+    [[nodiscard]] std::size_t count(MeterType type) const noexcept
+    { return Slot(type) == ABSENT ? 0u : 1u; }
+
+    /** Returns the meter of type \a type, adding a default meter if there
+      * isn't one.  \a type must be a valid meter type. */
+    Meter& operator[](MeterType type)
+    { return emplace(type, Meter{}).first->second; }
+
+    /** Adds \a meter as the meter of type \a type if there isn't one yet.
+      * Returns the meter of that type and whether it was added.  \a type
+      * must be a valid meter type. */
+    std::pair<iterator, bool> emplace(MeterType type, Meter meter) {
+        if (auto it = find(type); it != m_meters.end())
+            return {it, false};
+
+        auto pos = LowerBound(type);
+        const auto idx = std::distance(m_meters.begin(), pos);
+        m_meters.emplace(pos, type, meter);
+        for (auto i = static_cast<std::size_t>(idx); i < m_meters.size(); ++i)
+            m_slots[static_cast<std::size_t>(m_meters[i].first)] = static_cast<std::int8_t>(i);
+        return {m_meters.begin() + idx, true};
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            emplace(first->first, first->second);
+    }
+
+    /** Sets the initial value of every meter to its current value. */
+    void BackPropagate() noexcept {
+        for (auto& entry : m_meters)
+            entry.second.BackPropagate();
+    }
+
+    /** Sets the current value of each meter with a type from \a first to
+      * \a last inclusive to its initial value. */
+    void ResetCurrentToInitial(MeterType first, MeterType last) noexcept {
+        for (auto it = LowerBound(first); it != m_meters.end() && it->first <= last; ++it)
+            it->second.SetCurrent(it->second.Initial());
+    }
+
+    void clear() noexcept {
+        m_meters.clear();
+        m_slots.fill(ABSENT);
+    }
+
+    void reserve(std::size_t n) { m_meters.reserve(n); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_meters.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_meters.empty(); }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_meters.capacity(); }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return m_meters.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_meters.end(); }
+    [[nodiscard]] iterator begin() noexcept { return m_meters.begin(); }
+    [[nodiscard]] iterator end() noexcept { return m_meters.end(); }
+
+    [[nodiscard]] std::size_t HeapBytes() const noexcept
+    { return m_meters.capacity() * sizeof(value_type); }
+
+    [[nodiscard]] static constexpr bool ValidType(MeterType type) noexcept {
+        return static_cast<int>(type) >= 0 &&
+               static_cast<int>(type) < static_cast<int>(MeterType::NUM_METER_TYPES);
+    }
+
+private:
+    [[nodiscard]] iterator LowerBound(MeterType type) noexcept {
+        return std::lower_bound(m_meters.begin(), m_meters.end(), type,
+                                [](const value_type& entry, MeterType t) { return entry.first < t; });
+    }
+
+    [[nodiscard]] std::int8_t Slot(MeterType type) const noexcept
+    { return ValidType(type) ? m_slots[static_cast<std::size_t>(type)] : ABSENT; }
+
+    static_assert(static_cast<int>(MeterType::NUM_METER_TYPES) <= 127,
+                  "meter slots are indexed with signed bytes");
+
+    container_type                                                          m_meters;
+    std::array<std::int8_t, static_cast<std::size_t>(MeterType::NUM_METER_TYPES)> m_slots;
+};
+
+
+#endif
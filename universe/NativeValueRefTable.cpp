@@ -0,0 +1,15 @@
+// Natively compiled ValueRefs, with none built in.  Replace this file with
+// the output of the server's native-effects debug command to build in the
+// SetMeter values that were evaluated for the most targets in a game.
+
+#include "NativeValueRefs.h"
+
+
+namespace ValueRef {
+
+const std::vector<NativeValueRef>& NativeValueRefs() {
+    static const std::vector<NativeValueRef> native_value_refs;
+    return native_value_refs;
+}
+
+}
@@ -0,0 +1,44 @@
+#ifndef _NativeValueRefs_h_
+#define _NativeValueRefs_h_
+
+
+#include <cstddef>
+#include <vector>
+#include "ValueRef.h"
+#include "../util/Export.h"
+
+
+struct ScriptingContext;
+
+namespace ValueRef {
+
+/** A double-valued ValueRef from the content scripts that has been compiled
+    ahead of time into a C++ function, which CompiledValueRef calls instead of
+    running its instructions.
+
+    The function is given the hoisted values and leaf ValueRefs of the
+    CompiledValueRef, in the order it found them, so it only replaces the
+    Operations between them.  It is used for a ValueRef with the same
+    checksum and Dump() as the one it was generated from, so any change to
+    the script falls back to evaluating it as usual. */
+struct NativeValueRef {
+    using Function = double (*)(const ScriptingContext& context, const double* hoisted,
+                                const ValueRef<double>* const* leaves);
+
+    unsigned int    checksum = 0;
+    std::size_t     num_hoisted = 0;
+    std::size_t     num_leaves = 0;
+    const char*     dump = "";          ///< Dump() of the ValueRef the function was generated from
+    Function        function = nullptr;
+};
+
+/** Returns the natively compiled ValueRefs that are built in.  These are
+  * defined in NativeValueRefTable.cpp, which is generated by the server's
+  * native-effects debug command from the SetMeter values that were
+  * evaluated for the most targets in a game. */
+[[nodiscard]] FO_COMMON_API const std::vector<NativeValueRef>& NativeValueRefs();
+
+}
+
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef _ObjectIDBitmap_h_
+#define _ObjectIDBitmap_h_
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+/** A set of object ids, stored as a compressed bitmap in the manner of a
+    Roaring bitmap.
+
+    Used like a std::set<int>.  Ids are split into chunks of 65536 ids that
+    share their high 16 bits, and the ids in each chunk are stored either as a
+    sorted array of their low 16 bits, while there are few of them, or as a
+    65536-bit bitmap once there are more than 4096, so that a chunk never
+    takes more than 8 kB.  Object ids are allocated densely, so most sets have
+    one or a few chunks, membership tests are a short search and an array or
+    bit lookup, and a set of many ids takes a bit or two bytes per id, rather
+    than a tree node each.
+
+    Iteration yields ids in increasing order, as for a std::set<int>. */
+class ObjectIDBitmap {
+public:
+    using key_type = int;
+    using value_type = int;
+    using size_type = std::size_t;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+    ObjectIDBitmap() = default;
+
+    template <typename It>
+    ObjectIDBitmap(It first, It last) { insert(first, last); }
+
+    ObjectIDBitmap(std::initializer_list<int> ids) { insert(ids.begin(), ids.end()); }
+
+    [[nodiscard]] const_iterator begin() const noexcept;
+    [[nodiscard]] const_iterator end() const noexcept;
+
+    [[nodiscard]] size_type count(int id) const noexcept { return contains(id) ? 1 : 0; }
+    [[nodiscard]] bool      contains(int id) const noexcept;
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+    [[nodiscard]] bool      empty() const noexcept { return m_size == 0; }
+
+    /** Returns the highest id in the set, which must not be empty. */
+    [[nodiscard]] int Max() const noexcept;
+
+    /** Adds \a id, and returns true if it was not already in the set. */
+    bool insert(int id);
+
+    template <typename It>
+    void insert(It first, It last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    size_type erase(int id);
+    void      clear() noexcept { m_chunks.clear(); m_size = 0; }
+
+    void swap(ObjectIDBitmap& rhs) noexcept {
+        m_chunks.swap(rhs.m_chunks);
+        std::swap(m_size, rhs.m_size);
+    }
+
+    [[nodiscard]] bool operator==(const ObjectIDBitmap& rhs) const noexcept
+    { return m_size == rhs.m_size && m_chunks == rhs.m_chunks; }
+    [[nodiscard]] bool operator!=(const ObjectIDBitmap& rhs) const noexcept
+    { return !(*this == rhs); }
+
+    /** Returns the approximate number of bytes of memory allocated for the
+      * ids in this set. */
+    [[nodiscard]] std::size_t HeapBytes() const noexcept {
+        std::size_t retval = m_chunks.capacity() * sizeof(Chunk);
+        for (const auto& chunk : m_chunks)
+            retval += chunk.values.capacity() * sizeof(std::uint16_t) +
+                      chunk.words.capacity() * sizeof(std::uint64_t);
+        return retval;
+    }
+
+private:
+    static constexpr std::uint32_t  CHUNK_BITS = 1u << 16;
+    static constexpr std::size_t    NUM_WORDS = CHUNK_BITS / 64;
+    static constexpr std::size_t    MAX_ARRAY_SIZE = 4096;  ///< a bitmap is the same size as an array of this many values
+
+    /** The ids with the same high 16 bits, as a sorted array of their low 16
+      * bits in \a values, or as a bitmap in \a words if \a words isn't empty.
+      * A chunk is never empty. */
+    struct Chunk {
+        std::uint16_t               high = 0;
+        std::uint32_t               cardinality = 0;
+        std::vector<std::uint16_t>  values;
+        std::vector<std::uint64_t>  words;
+
+        [[nodiscard]] bool IsBitmap() const noexcept { return !words.empty(); }
+        [[nodiscard]] bool Test(std::uint16_t low) const noexcept {
+            if (IsBitmap())
+                return (words[low >> 6] >> (low & 63)) & 1u;
+            return std::binary_search(values.begin(), values.end(), low);
+        }
+        [[nodiscard]] bool operator==(const Chunk& rhs) const noexcept {
+            return high == rhs.high && cardinality == rhs.cardinality &&
+                   values == rhs.values && words == rhs.words;
+        }
+    };
+
+    /** Ids are offset so that their unsigned order is their signed order,
+      * which keeps chunks of negative ids before those of positive ids. */
+    [[nodiscard]] static constexpr std::uint32_t Key(int id) noexcept
+    { return static_cast<std::uint32_t>(id) ^ 0x80000000u; }
+    [[nodiscard]] static constexpr int Id(std::uint16_t high, std::uint32_t low) noexcept
+    { return static_cast<int>(((static_cast<std::uint32_t>(high) << 16) | low) ^ 0x80000000u); }
+
+    /** Returns the index of the lowest set bit of \a word, which must not be
+      * zero, with a de Bruijn multiplication. */
+    [[nodiscard]] static constexpr unsigned int LowestBit(std::uint64_t word) noexcept {
+        constexpr std::uint64_t DE_BRUIJN = 0x03f79d71b4cb0a89ull;
+        constexpr auto TABLE = []() {
+            std::array<unsigned char, 64> table{};
+            for (unsigned int bit = 0; bit < 64; ++bit)
+                table[(DE_BRUIJN << bit) >> 58] = static_cast<unsigned char>(bit);
+            return table;
+        }();
+        return TABLE[((word & (~word + 1)) * DE_BRUIJN) >> 58];
+    }
+
+    [[nodiscard]] static constexpr unsigned int PopCount(std::uint64_t word) noexcept {
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast<unsigned int>((word * 0x0101010101010101ull) >> 56);
+    }
+
+    /** Returns the lowest set bit of the bitmap of \a chunk that is at or
+      * after \a bit, or CHUNK_BITS if there isn't one. */
+    [[nodiscard]] static std::uint32_t NextBit(const Chunk& chunk, std::uint32_t bit) noexcept {
+        if (bit >= CHUNK_BITS)
+            return CHUNK_BITS;
+        std::size_t word_idx = bit >> 6;
+        std::uint64_t word = chunk.words[word_idx] & (~std::uint64_t{0} << (bit & 63));
+        while (!word) {
+            if (++word_idx == NUM_WORDS)
+                return CHUNK_BITS;
+            word = chunk.words[word_idx];
+        }
+        return static_cast<std::uint32_t>(word_idx * 64 + LowestBit(word));
+    }
+
+    [[nodiscard]] std::vector<Chunk>::const_iterator FindChunk(std::uint16_t high) const noexcept {
+        return std::lower_bound(m_chunks.begin(), m_chunks.end(), high,
+                                [](const Chunk& chunk, std::uint16_t h) { return chunk.high < h; });
+    }
+
+    std::vector<Chunk>  m_chunks;   ///< sorted by high bits
+    size_type           m_size = 0;
+
+    template <typename Archive>
+    friend void serialize(Archive&, ObjectIDBitmap&, unsigned int const);
+};
+
+
+class ObjectIDBitmap::const_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = int;
+
+    const_iterator() = default;
+
+    [[nodiscard]] int operator*() const noexcept {
+        const auto& chunk = (*m_chunks)[m_chunk_idx];
+        return Id(chunk.high, chunk.IsBitmap() ? m_pos : chunk.values[m_pos]);
+    }
+
+    const_iterator& operator++() noexcept {
+        const auto& chunk = (*m_chunks)[m_chunk_idx];
+        if (chunk.IsBitmap()) {
+            m_pos = NextBit(chunk, m_pos + 1);
+            if (m_pos < CHUNK_BITS)
+                return *this;
+        } else if (++m_pos < chunk.values.size()) {
+            return *this;
+        }
+        ++m_chunk_idx;
+        m_pos = First();
+        return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+        auto retval = *this;
+        ++(*this);
+        return retval;
+    }
+
+    [[nodiscard]] bool operator==(const const_iterator& rhs) const noexcept
+    { return m_chunk_idx == rhs.m_chunk_idx && m_pos == rhs.m_pos; }
+    [[nodiscard]] bool operator!=(const const_iterator& rhs) const noexcept
+    { return !(*this == rhs); }
+
+private:
+    const_iterator(const std::vector<Chunk>& chunks, std::size_t chunk_idx) noexcept :
+        m_chunks(&chunks),
+        m_chunk_idx(chunk_idx),
+        m_pos(First())
+    {}
+
+    /** Returns the position of the first id in the current chunk, or zero
+      * if past the last chunk. */
+    [[nodiscard]] std::uint32_t First() const noexcept {
+        if (m_chunk_idx >= m_chunks->size())
+            return 0;
+        const auto& chunk = (*m_chunks)[m_chunk_idx];
+        return chunk.IsBitmap() ? NextBit(chunk, 0) : 0;
+    }
+
+    const std::vector<Chunk>*   m_chunks = nullptr;
+    std::size_t                 m_chunk_idx = 0;
+    std::uint32_t               m_pos = 0;  ///< index into values, or bit of the bitmap
+
+    friend class ObjectIDBitmap;
+};
+
+
+inline ObjectIDBitmap::const_iterator ObjectIDBitmap::begin() const noexcept
+{ return const_iterator(m_chunks, 0); }
+
+inline ObjectIDBitmap::const_iterator ObjectIDBitmap::end() const noexcept
+{ return const_iterator(m_chunks, m_chunks.size()); }
+
+inline bool ObjectIDBitmap::contains(int id) const noexcept {
+    const auto key = Key(id);
+    const auto high = static_cast<std::uint16_t>(key >> 16);
+    const auto it = FindChunk(high);
+    return it != m_chunks.end() && it->high == high && it->Test(static_cast<std::uint16_t>(key));
+}
+
+inline int ObjectIDBitmap::Max() const noexcept {
+    const auto& chunk = m_chunks.back();
+    if (!chunk.IsBitmap())
+        return Id(chunk.high, chunk.values.back());
+    auto word_idx = NUM_WORDS;
+    while (!chunk.words[--word_idx]) {}
+    const auto word = chunk.words[word_idx];
+    unsigned int bit = 63;
+    while (!((word >> bit) & 1u))
+        --bit;
+    return Id(chunk.high, static_cast<std::uint32_t>(word_idx * 64 + bit));
+}
+
+inline bool ObjectIDBitmap::insert(int id) {
+    const auto key = Key(id);
+    const auto high = static_cast<std::uint16_t>(key >> 16);
+    const auto low = static_cast<std::uint16_t>(key);
+
+    auto it = m_chunks.begin() + std::distance(m_chunks.cbegin(), FindChunk(high));
+    if (it == m_chunks.end() || it->high != high) {
+        it = m_chunks.insert(it, Chunk{});
+        it->high = high;
+    }
+    auto& chunk = *it;
+
+    if (chunk.IsBitmap()) {
+        auto& word = chunk.words[low >> 6];
+        const auto mask = std::uint64_t{1} << (low & 63);
+        if (word & mask)
+            return false;
+        word |= mask;
+
+    } else {
+        const auto value_it = std::lower_bound(chunk.values.begin(), chunk.values.end(), low);
+        if (value_it != chunk.values.end() && *value_it == low)
+            return false;
+        chunk.values.insert(value_it, low);
+
+        if (chunk.values.size() > MAX_ARRAY_SIZE) {
+            chunk.words.assign(NUM_WORDS, 0);
+            for (const auto value : chunk.values)
+                chunk.words[value >> 6] |= std::uint64_t{1} << (value & 63);
+            chunk.values.clear();
+            chunk.values.shrink_to_fit();
+        }
+    }
+
+    ++chunk.cardinality;
+    ++m_size;
+    return true;
+}
+
+inline ObjectIDBitmap::size_type ObjectIDBitmap::erase(int id) {
+    const auto key = Key(id);
+    const auto high = static_cast<std::uint16_t>(key >> 16);
+    const auto low = static_cast<std::uint16_t>(key);
+
+    const auto it = m_chunks.begin() + std::distance(m_chunks.cbegin(), FindChunk(high));
+    if (it == m_chunks.end() || it->high != high)
+        return 0;
+    auto& chunk = *it;
+
+    if (chunk.IsBitmap()) {
+        auto& word = chunk.words[low >> 6];
+        const auto mask = std::uint64_t{1} << (low & 63);
+        if (!(word & mask))
+            return 0;
+        word &= ~mask;
+
+        if (chunk.cardinality - 1 <= MAX_ARRAY_SIZE) {
+            chunk.values.reserve(chunk.cardinality - 1);
+            for (std::size_t word_idx = 0; word_idx < NUM_WORDS; ++word_idx)
+                for (auto bits = chunk.words[word_idx]; bits; bits &= bits - 1)
+                    chunk.values.push_back(static_cast<std::uint16_t>(word_idx * 64 + LowestBit(bits)));
+            chunk.words.clear();
+            chunk.words.shrink_to_fit();
+        }
+
+    } else {
+        const auto value_it = std::lower_bound(chunk.values.begin(), chunk.values.end(), low);
+        if (value_it == chunk.values.end() || *value_it != low)
+            return 0;
+        chunk.values.erase(value_it);
+    }
+
+    --m_size;
+    if (--chunk.cardinality == 0)
+        m_chunks.erase(it);
+    return 1;
+}
+
+
+#endif
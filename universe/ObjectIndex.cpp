@@ -0,0 +1,104 @@
+#include "ObjectIndex.h"
+
+#include "Building.h"
+#include "ObjectMap.h"
+#include "Planet.h"
+#include "Ship.h"
+#include "Species.h"
+#include "UniverseObject.h"
+#include "../util/AppInterface.h"
+
+
+namespace {
+    const ObjectIndex::ObjectSet EMPTY_OBJECT_SET;
+
+    template <typename Key>
+    const ObjectIndex::ObjectSet& Lookup(const std::unordered_map<Key, ObjectIndex::ObjectSet>& groups,
+                                         const Key& key)
+    {
+        auto it = groups.find(key);
+        return it != groups.end() ? it->second : EMPTY_OBJECT_SET;
+    }
+}
+
+ObjectIndex::ObjectIndex() = default;
+
+ObjectIndex::~ObjectIndex() = default;
+
+void ObjectIndex::Build(const ObjectMap& objects) {
+    Clear();
+
+    std::vector<PositionGrid::Position> positions;
+    positions.reserve(objects.ExistingObjects().size());
+    m_positioned.reserve(objects.ExistingObjects().size());
+
+    for (const auto& [object_id, obj] : objects.ExistingObjects()) {
+        (void)object_id;
+        if (!obj)
+            continue;
+
+        m_positioned.push_back(obj);
+        positions.emplace_back(obj->X(), obj->Y());
+
+        m_by_owner[obj->Owner()].push_back(obj);
+        if (obj->SystemID() != INVALID_OBJECT_ID)
+            m_by_system[obj->SystemID()].push_back(obj);
+
+        auto tags = obj->Tags();
+        const std::string* species_name = nullptr;
+
+        switch (obj->ObjectType()) {
+        case UniverseObjectType::OBJ_PLANET:
+            species_name = &static_cast<const Planet*>(obj.get())->SpeciesName();
+            break;
+        case UniverseObjectType::OBJ_SHIP: {
+            species_name = &static_cast<const Ship*>(obj.get())->SpeciesName();
+            // Ship::HasTag also checks the ship's species' tags, which Ship::Tags omits
+            if (const auto* species = GetSpecies(*species_name))
+                tags.insert(species->Tags().begin(), species->Tags().end());
+            break;
+        }
+        case UniverseObjectType::OBJ_BUILDING: {
+            auto* building = static_cast<const ::Building*>(obj.get());
+            m_by_building_type[building->BuildingTypeName()].push_back(obj);
+            if (auto planet = objects.get<Planet>(building->PlanetID()))
+                species_name = &planet->SpeciesName();
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (species_name && !species_name->empty())
+            m_by_species[*species_name].push_back(obj);
+        for (const auto& tag : tags)
+            m_by_tag[tag].push_back(obj);
+    }
+
+    m_positions = PositionGrid(std::move(positions));
+}
+
+void ObjectIndex::Clear() {
+    m_by_owner.clear();
+    m_by_species.clear();
+    m_by_building_type.clear();
+    m_by_system.clear();
+    m_by_tag.clear();
+    m_positioned.clear();
+    m_positions = PositionGrid();
+}
+
+const ObjectIndex::ObjectSet& ObjectIndex::OwnedBy(int empire_id) const
+{ return Lookup(m_by_owner, empire_id); }
+
+const ObjectIndex::ObjectSet& ObjectIndex::WithSpecies(const std::string& name) const
+{ return Lookup(m_by_species, name); }
+
+const ObjectIndex::ObjectSet& ObjectIndex::BuildingsOfType(const std::string& name) const
+{ return Lookup(m_by_building_type, name); }
+
+const ObjectIndex::ObjectSet& ObjectIndex::InSystem(int system_id) const
+{ return Lookup(m_by_system, system_id); }
+
+const ObjectIndex::ObjectSet& ObjectIndex::WithTag(const std::string& tag) const
+{ return Lookup(m_by_tag, tag); }
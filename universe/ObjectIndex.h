@@ -0,0 +1,80 @@
+#ifndef _ObjectIndex_h_
+#define _ObjectIndex_h_
+
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PositionGrid.h"
+#include "../util/Export.h"
+
+
+class ObjectMap;
+class UniverseObject;
+
+/** Existing objects in an ObjectMap, grouped by owner empire, species, building
+    type, containing system and tag, and indexed by position, so that the
+    objects that could match a condition on such a property, or on being near
+    some objects, can be looked up rather than found by scanning all objects.
+
+    Objects don't notify their ObjectMap when their owner or species changes,
+    so the groups aren't kept up to date as objects change.  Instead, they are
+    found again with Build() whenever the objects may have changed, such as
+    when a new ConditionMemo scope is entered. Until then, lookups return the
+    groups as they were when built. */
+class FO_COMMON_API ObjectIndex {
+public:
+    using ObjectSet = std::vector<std::shared_ptr<const UniverseObject>>;
+
+    ObjectIndex();
+    ~ObjectIndex();
+
+    /** Groups the existing objects in \a objects, replacing any previous groups. */
+    void Build(const ObjectMap& objects);
+
+    /** Discards all groups. */
+    void Clear();
+
+    /** Returns the objects owned by the empire with id \a empire_id, or the
+      * unowned objects if \a empire_id is ALL_EMPIRES. */
+    [[nodiscard]] const ObjectSet& OwnedBy(int empire_id) const;
+
+    /** Returns the planets and ships of the species \a name, and the
+      * buildings on planets of that species. */
+    [[nodiscard]] const ObjectSet& WithSpecies(const std::string& name) const;
+
+    /** Returns the buildings of the building type \a name. */
+    [[nodiscard]] const ObjectSet& BuildingsOfType(const std::string& name) const;
+
+    /** Returns the objects in the system with id \a system_id, including the
+      * system itself. */
+    [[nodiscard]] const ObjectSet& InSystem(int system_id) const;
+
+    /** Returns the objects for which HasTag(\a tag) is true. */
+    [[nodiscard]] const ObjectSet& WithTag(const std::string& tag) const;
+
+    /** Calls \a fn with the position index and each object within
+      * \a distance of (\a x, \a y).  Position indices are less than
+      * NumPositioned(), so callers can mark objects found by several queries
+      * in a vector. */
+    template <typename Fn>
+    void ForEachWithinDistance(double x, double y, double distance, Fn&& fn) const {
+        m_positions.ForEachInRange(x, y, distance,
+                                   [this, &fn](std::size_t idx) { fn(idx, m_positioned[idx]); });
+    }
+
+    [[nodiscard]] std::size_t NumPositioned() const noexcept { return m_positioned.size(); }
+
+private:
+    std::unordered_map<int, ObjectSet>          m_by_owner;
+    std::unordered_map<std::string, ObjectSet>  m_by_species;
+    std::unordered_map<std::string, ObjectSet>  m_by_building_type;
+    std::unordered_map<int, ObjectSet>          m_by_system;
+    std::unordered_map<std::string, ObjectSet>  m_by_tag;
+    ObjectSet                                   m_positioned;   ///< all the objects, in order of id
+    PositionGrid                                m_positions;    ///< positions of m_positioned, with the same indices
+};
+
+
+#endif
@@ -3,6 +3,7 @@
 #include "Building.h"
 #include "Field.h"
 #include "Fleet.h"
+#include "ObjectIDBitmap.h"
 #include "Planet.h"
 #include "Ship.h"
 #include "System.h"
@@ -10,18 +11,19 @@
 #include "Universe.h"
 #include "../util/AppInterface.h"
 #include "../util/Logger.h"
+#include "../util/MemoryUsage.h"
 
 
-#define FOR_EACH_SPECIALIZED_MAP(f, ...)  { f(m_resource_centers, ##__VA_ARGS__);   \
-                                            f(m_pop_centers, ##__VA_ARGS__);        \
-                                            f(m_ships, ##__VA_ARGS__);              \
-                                            f(m_fleets, ##__VA_ARGS__);             \
-                                            f(m_planets, ##__VA_ARGS__);            \
-                                            f(m_systems, ##__VA_ARGS__);            \
-                                            f(m_buildings, ##__VA_ARGS__);          \
-                                            f(m_fields, ##__VA_ARGS__); }
+#define FOR_EACH_SPECIALIZED_MAP(f, ...)  { f(m_resource_centers, m_resource_centers_index, ##__VA_ARGS__); \
+                                            f(m_pop_centers, m_pop_centers_index, ##__VA_ARGS__);           \
+                                            f(m_ships, m_ships_index, ##__VA_ARGS__);                       \
+                                            f(m_fleets, m_fleets_index, ##__VA_ARGS__);                     \
+                                            f(m_planets, m_planets_index, ##__VA_ARGS__);                   \
+                                            f(m_systems, m_systems_index, ##__VA_ARGS__);                   \
+                                            f(m_buildings, m_buildings_index, ##__VA_ARGS__);               \
+                                            f(m_fields, m_fields_index, ##__VA_ARGS__); }
 
-#define FOR_EACH_MAP(f, ...)              { f(m_objects, ##__VA_ARGS__);            \
+#define FOR_EACH_MAP(f, ...)              { f(m_objects, m_objects_index, ##__VA_ARGS__);                   \
                                             FOR_EACH_SPECIALIZED_MAP(f, ##__VA_ARGS__); }
 
 #define FOR_EACH_EXISTING_MAP(f, ...)     { f(m_existing_objects, ##__VA_ARGS__);          \
@@ -40,65 +42,73 @@ namespace {
     static void ClearMap(ObjectMap::container_type<T>& map)
     { map.clear(); }
 
-    template <typename T>
-    void TryInsertIntoMap(ObjectMap::container_type<T>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (dynamic_cast<T*>(item.get()))
-            map[item->ID()] = std::dynamic_pointer_cast<T, UniverseObject>(item);
+    template <typename T, typename IndexT>
+    static void ClearMap(ObjectMap::container_type<T>& map, IndexT& index) {
+        map.clear();
+        index.clear();
     }
 
+    template <typename T, typename IndexT>
+    static void RebuildIndex(ObjectMap::container_type<T>& map, IndexT& index)
+    { index.rebuild(map); }
+
+    template <typename T>
+    bool IsOfType(const UniverseObject* item)
+    { return dynamic_cast<const T*>(item); }
+
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<Ship>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_SHIP)
-            map[item->ID()] = std::static_pointer_cast<Ship>(item);
-    }
+    bool IsOfType<Ship>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_SHIP; }
 
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<Fleet>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_FLEET)
-            map[item->ID()] = std::static_pointer_cast<Fleet>(item);
-    }
+    bool IsOfType<Fleet>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_FLEET; }
 
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<Building>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_BUILDING)
-            map[item->ID()] = std::static_pointer_cast<Building>(item);
-    }
+    bool IsOfType<Building>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_BUILDING; }
 
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<Planet>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_PLANET)
-            map[item->ID()] = std::static_pointer_cast<Planet>(item);
-    }
+    bool IsOfType<Planet>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_PLANET; }
 
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<System>& map,
-                          std::shared_ptr<UniverseObject> item)
-    {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_SYSTEM)
-            map[item->ID()] = std::static_pointer_cast<System>(item);
-    }
+    bool IsOfType<System>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_SYSTEM; }
 
     template <>
-    void TryInsertIntoMap(ObjectMap::container_type<Field>& map,
+    bool IsOfType<Field>(const UniverseObject* item)
+    { return item && item->ObjectType() == UniverseObjectType::OBJ_FIELD; }
+
+    template <typename T>
+    std::shared_ptr<T> CastTo(std::shared_ptr<UniverseObject> item) {
+        if constexpr (std::is_base_of_v<UniverseObject, T>)
+            return std::static_pointer_cast<T>(std::move(item));
+        else
+            return std::dynamic_pointer_cast<T>(std::move(item));
+    }
+
+    template <typename T, typename IndexT>
+    void TryInsertIntoMap(ObjectMap::container_type<T>& map, IndexT& index,
                           std::shared_ptr<UniverseObject> item)
     {
-        if (item && item->ObjectType() == UniverseObjectType::OBJ_FIELD)
-            map[item->ID()] = std::static_pointer_cast<Field>(item);
+        if (!IsOfType<T>(item.get()))
+            return;
+        const int id = item->ID();
+        auto& entry = map[id];
+        entry = CastTo<T>(std::move(item));
+        index.insert(id, &entry, map.size());
     }
 
     template <typename T>
     void EraseFromMap(ObjectMap::container_type<T>& map, int id)
     { map.erase(id); }
+
+    template <typename T, typename IndexT>
+    void EraseFromMap(ObjectMap::container_type<T>& map, IndexT& index, int id) {
+        index.erase(id);
+        map.erase(id);
+    }
 }
 
 
@@ -108,6 +118,35 @@ namespace {
 ObjectMap::ObjectMap()
 {}
 
+ObjectMap::ObjectMap(const ObjectMap& rhs) :
+    m_objects(rhs.m_objects),
+    m_resource_centers(rhs.m_resource_centers),
+    m_pop_centers(rhs.m_pop_centers),
+    m_ships(rhs.m_ships),
+    m_fleets(rhs.m_fleets),
+    m_planets(rhs.m_planets),
+    m_systems(rhs.m_systems),
+    m_buildings(rhs.m_buildings),
+    m_fields(rhs.m_fields),
+    m_existing_objects(rhs.m_existing_objects),
+    m_existing_resource_centers(rhs.m_existing_resource_centers),
+    m_existing_pop_centers(rhs.m_existing_pop_centers),
+    m_existing_ships(rhs.m_existing_ships),
+    m_existing_fleets(rhs.m_existing_fleets),
+    m_existing_planets(rhs.m_existing_planets),
+    m_existing_systems(rhs.m_existing_systems),
+    m_existing_buildings(rhs.m_existing_buildings),
+    m_existing_fields(rhs.m_existing_fields)
+{ RebuildIndices(); }
+
+ObjectMap& ObjectMap::operator=(const ObjectMap& rhs) {
+    if (this != &rhs) {
+        ObjectMap copy(rhs);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
 ObjectMap::~ObjectMap()
 {}
 
@@ -127,6 +166,7 @@ void ObjectMap::CopyForSerialize(const ObjectMap& copied_map) {
 
     // note: the following relies upon only m_objects actually getting serialized by ObjectMap::serialize
     m_objects.insert(copied_map.m_objects.begin(), copied_map.m_objects.end());
+    m_objects_index.rebuild(m_objects);
 }
 
 void ObjectMap::CopyObject(std::shared_ptr<const UniverseObject> source, int empire_id) {
@@ -212,6 +252,7 @@ std::shared_ptr<UniverseObject> ObjectMap::erase(int id) {
     // object found, so store pointer for later...
     auto result = it->second;
     // and erase from pointer maps
+    m_objects_index.erase(id);
     m_objects.erase(it);
     FOR_EACH_SPECIALIZED_MAP(EraseFromMap, id);
     FOR_EACH_EXISTING_MAP(EraseFromMap, id);
@@ -234,7 +275,7 @@ std::vector<int> ObjectMap::FindExistingObjectIDs() const {
     return result;
 }
 
-void ObjectMap::UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_object_ids) {
+void ObjectMap::UpdateCurrentDestroyedObjects(const ObjectIDBitmap& destroyed_object_ids) {
     FOR_EACH_EXISTING_MAP(ClearMap);
     for (const auto& [id, obj] : m_objects) {
         if (!obj || destroyed_object_ids.count(id))
@@ -275,14 +316,14 @@ void ObjectMap::UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_obj
     }
 }
 
-void ObjectMap::AuditContainment(const std::set<int>& destroyed_object_ids) {
+void ObjectMap::AuditContainment(const ObjectIDBitmap& destroyed_object_ids) {
     // determine all objects that some other object thinks contains them
-    std::map<int, std::set<int>> contained_objs;
-    std::map<int, std::set<int>> contained_planets;
-    std::map<int, std::set<int>> contained_buildings;
-    std::map<int, std::set<int>> contained_fleets;
-    std::map<int, std::set<int>> contained_ships;
-    std::map<int, std::set<int>> contained_fields;
+    std::map<int, ObjectIDSet> contained_objs;
+    std::map<int, ObjectIDSet> contained_planets;
+    std::map<int, ObjectIDSet> contained_buildings;
+    std::map<int, ObjectIDSet> contained_fleets;
+    std::map<int, ObjectIDSet> contained_ships;
+    std::map<int, ObjectIDSet> contained_fields;
 
     for (const auto& contained : all()) {
         if (destroyed_object_ids.count(contained->ID()))
@@ -352,8 +393,12 @@ void ObjectMap::CopyObjectsToSpecializedMaps() {
     FOR_EACH_SPECIALIZED_MAP(ClearMap);
     for (const auto& entry : Map<UniverseObject>())
     { FOR_EACH_SPECIALIZED_MAP(TryInsertIntoMap, entry.second); }
+    m_objects_index.rebuild(m_objects);
 }
 
+void ObjectMap::RebuildIndices()
+{ FOR_EACH_MAP(RebuildIndex); }
+
 std::string ObjectMap::Dump(unsigned short ntabs) const {
     std::ostringstream dump_stream;
     dump_stream << "ObjectMap contains UniverseObjects: \n";
@@ -363,6 +408,42 @@ std::string ObjectMap::Dump(unsigned short ntabs) const {
     return dump_stream.str();
 }
 
+namespace {
+    std::size_t ObjectSize(const UniverseObject& obj) {
+        switch (obj.ObjectType()) {
+        case UniverseObjectType::OBJ_BUILDING:  return sizeof(Building);
+        case UniverseObjectType::OBJ_SHIP:      return sizeof(Ship);
+        case UniverseObjectType::OBJ_FLEET:     return sizeof(Fleet);
+        case UniverseObjectType::OBJ_PLANET:    return sizeof(Planet);
+        case UniverseObjectType::OBJ_SYSTEM:    return sizeof(System);
+        case UniverseObjectType::OBJ_FIELD:     return sizeof(Field);
+        default:                                return sizeof(UniverseObject);
+        }
+    }
+}
+
+std::size_t ObjectMap::HeapBytes() const {
+    std::size_t retval = 0;
+
+    const auto add_map = [&retval](const auto& map, const auto&... index) {
+        retval += map.size() * (sizeof(typename std::decay_t<decltype(map)>::value_type) + MemoryUsage::NODE_OVERHEAD);
+        ((retval += index.heap_bytes()), ...);
+    };
+    FOR_EACH_MAP(add_map);
+    FOR_EACH_EXISTING_MAP(add_map);
+
+    // objects and their control blocks, meters, specials and names.  the
+    // contents specific to each type of object aren't counted
+    for (const auto& [id, obj] : m_objects) {
+        if (!obj)
+            continue;
+        retval += ObjectSize(*obj) + 2 * sizeof(void*) + MemoryUsage::HeapBytes(obj->Meters()) +
+            MemoryUsage::HeapBytes(obj->Specials()) + MemoryUsage::HeapBytes(obj->Name());
+    }
+
+    return retval;
+}
+
 std::shared_ptr<const UniverseObject> ObjectMap::ExistingObject(int id) const {
     auto it = m_existing_objects.find(id);
     if (it != m_existing_objects.end())
@@ -449,3 +530,39 @@ ObjectMap::container_type<Building>& ObjectMap::Map()
 template <>
 ObjectMap::container_type<Field>& ObjectMap::Map()
 { return m_fields; }
+
+template <>
+const ObjectMap::DenseIndex<UniverseObject>& ObjectMap::Index() const
+{ return m_objects_index; }
+
+template <>
+const ObjectMap::DenseIndex<ResourceCenter>& ObjectMap::Index() const
+{ return m_resource_centers_index; }
+
+template <>
+const ObjectMap::DenseIndex<PopCenter>& ObjectMap::Index() const
+{ return m_pop_centers_index; }
+
+template <>
+const ObjectMap::DenseIndex<Ship>& ObjectMap::Index() const
+{ return m_ships_index; }
+
+template <>
+const ObjectMap::DenseIndex<Fleet>& ObjectMap::Index() const
+{ return m_fleets_index; }
+
+template <>
+const ObjectMap::DenseIndex<Planet>& ObjectMap::Index() const
+{ return m_planets_index; }
+
+template <>
+const ObjectMap::DenseIndex<System>& ObjectMap::Index() const
+{ return m_systems_index; }
+
+template <>
+const ObjectMap::DenseIndex<Building>& ObjectMap::Index() const
+{ return m_buildings_index; }
+
+template <>
+const ObjectMap::DenseIndex<Field>& ObjectMap::Index() const
+{ return m_fields_index; }
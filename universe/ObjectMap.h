@@ -2,6 +2,7 @@
 #define _Object_Map_h_
 
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -25,6 +26,7 @@ class Planet;
 class System;
 class Building;
 class Field;
+class ObjectIDBitmap;
 
 FO_COMMON_API extern const int ALL_EMPIRES;
 
@@ -36,8 +38,13 @@ public:
     using container_type = std::map<int, std::shared_ptr<T>>;
 
     ObjectMap();
+    ObjectMap(const ObjectMap& rhs);
+    ObjectMap(ObjectMap&& rhs) noexcept = default;
     ~ObjectMap();
 
+    ObjectMap& operator=(const ObjectMap& rhs);
+    ObjectMap& operator=(ObjectMap&& rhs) noexcept = default;
+
     /** Copies contents of this ObjectMap to a new ObjectMap, which is
       * returned.  Copies are limited to only duplicate information that the
       * empire with id \a empire_id would know about the copied objects. */
@@ -104,6 +111,15 @@ public:
     boost::select_second_mutable_range<container_type<T>> all()
     { return Map<T>() | boost::adaptors::map_values; }
 
+    /** Returns pointers to all the objects of type T, in order of increasing
+      * ID, stored contiguously. Faster to iterate over than all(), as doing
+      * so doesn't walk the map or copy any std::shared_ptr, but the returned
+      * pointers are only valid until objects are next added to or removed
+      * from this ObjectMap. */
+    template <typename T = UniverseObject>
+    const std::vector<const T*>& allRaw() const
+    { return Index<typename std::remove_const<T>::type>().objects(); }
+
     /** Returns the IDs of all objects not known to have been destroyed. */
     std::vector<int>        FindExistingObjectIDs() const;
 
@@ -112,6 +128,10 @@ public:
 
     std::string             Dump(unsigned short ntabs = 0) const;
 
+    /** Returns the approximate number of bytes of memory allocated for the
+      * objects in this ObjectMap and its maps and indices of them. */
+    std::size_t             HeapBytes() const;
+
     /**  */
     std::shared_ptr<const UniverseObject> ExistingObject(int id) const;
 
@@ -184,18 +204,63 @@ public:
     //void swap(ObjectMap& rhs);
 
     /** */
-    void UpdateCurrentDestroyedObjects(const std::set<int>& destroyed_object_ids);
+    void UpdateCurrentDestroyedObjects(const ObjectIDBitmap& destroyed_object_ids);
 
     /** Recalculates contained objects for all objects in this ObjectMap based
       * on what other objects exist in this ObjectMap. Useful to eliminate
       * cases where there are inconsistencies between whan an object thinks it
       * contains, and what other objects think they are contained by the first
       * object. */
-    void AuditContainment(const std::set<int>& destroyed_object_ids);
+    void AuditContainment(const ObjectIDBitmap& destroyed_object_ids);
 
 private:
+    /** Lookup table from object ID to entry in one of the maps of objects,
+      * and an array of the objects in that map in order of increasing ID.
+      * IDs are allocated fairly densely, so the table can be indexed
+      * directly by ID, which is much faster than looking up IDs in the map.
+      * Map entries aren't moved by inserting or erasing other entries, so
+      * the table only needs updating for the entries that are added to or
+      * removed from the map. */
+    template <typename T>
+    class DenseIndex {
+    public:
+        /** Returns the map entry for the object with ID \a id, or nullptr if
+          * that object isn't in the indexed map or isn't in the table. */
+        std::shared_ptr<T>* entry(int id) const noexcept {
+            return (id >= 0 && static_cast<std::size_t>(id) < m_slots.size())
+                ? m_slots[static_cast<std::size_t>(id)] : nullptr;
+        }
+
+        /** Returns true iff all entries of the indexed map are in the table,
+          * in which case objects not found with entry() are not in the map. */
+        bool complete() const noexcept { return m_complete; }
+
+        const std::vector<const T*>& objects() const noexcept { return m_objects; }
+
+        std::size_t heap_bytes() const noexcept {
+            return m_slots.capacity() * sizeof(std::shared_ptr<T>*) +
+                m_objects.capacity() * sizeof(const T*) + m_ids.capacity() * sizeof(int);
+        }
+
+        /** Adds or updates the table entry for the object with ID \a id, the
+          * map entry for which is \a map_entry. \a map_size is the number of
+          * entries in the map, which limits the size of the table. */
+        void insert(int id, std::shared_ptr<T>* map_entry, std::size_t map_size);
+        void erase(int id);
+        void clear();
+        void rebuild(container_type<T>& map);
+
+    private:
+        std::vector<std::shared_ptr<T>*>    m_slots;        ///< map entries, indexed by object ID (or nullptr)
+        std::vector<const T*>               m_objects;      ///< objects in the map, ordered by ID
+        std::vector<int>                    m_ids;          ///< IDs of the objects in m_objects
+        bool                                m_complete = true;
+    };
+
     void insertCore(std::shared_ptr<UniverseObject> item, int empire_id = ALL_EMPIRES);
 
+    void RebuildIndices();
+
     void CopyObjectsToSpecializedMaps();
 
     template <typename T>
@@ -207,6 +272,9 @@ private:
     template <typename T>
     static void SwapMap(container_type<T>& map, ObjectMap& rhs);
 
+    template <typename T>
+    const DenseIndex<T>& Index() const;
+
     container_type<UniverseObject>  m_objects;
     container_type<ResourceCenter>  m_resource_centers;
     container_type<PopCenter>       m_pop_centers;
@@ -217,6 +285,16 @@ private:
     container_type<Building>        m_buildings;
     container_type<Field>           m_fields;
 
+    DenseIndex<UniverseObject>      m_objects_index;
+    DenseIndex<ResourceCenter>      m_resource_centers_index;
+    DenseIndex<PopCenter>           m_pop_centers_index;
+    DenseIndex<Ship>                m_ships_index;
+    DenseIndex<Fleet>               m_fleets_index;
+    DenseIndex<Planet>              m_planets_index;
+    DenseIndex<System>              m_systems_index;
+    DenseIndex<Building>            m_buildings_index;
+    DenseIndex<Field>               m_fields_index;
+
     container_type<const UniverseObject>  m_existing_objects;
     container_type<const UniverseObject>  m_existing_resource_centers;
     container_type<const UniverseObject>  m_existing_pop_centers;
@@ -234,21 +312,27 @@ private:
 template <typename T>
 std::shared_ptr<const T> ObjectMap::get(int id) const
 {
-    auto it = Map<typename std::remove_const<T>::type>().find(id);
-    return std::shared_ptr<const T>(
-        it != Map<typename std::remove_const<T>::type>().end()
-            ? it->second
-            : nullptr);
+    typedef typename std::remove_const<T>::type mutableT;
+    const auto& index = Index<mutableT>();
+    if (const auto* entry = index.entry(id))
+        return *entry;
+    if (index.complete())
+        return nullptr;
+    auto it = Map<mutableT>().find(id);
+    return std::shared_ptr<const T>(it != Map<mutableT>().end() ? it->second : nullptr);
 }
 
 template <typename T>
 std::shared_ptr<T> ObjectMap::get(int id)
 {
-    auto it = Map<typename std::remove_const<T>::type>().find(id);
-    return std::shared_ptr<T>(
-        it != Map<typename std::remove_const<T>::type>().end()
-            ? it->second
-            : nullptr);
+    typedef typename std::remove_const<T>::type mutableT;
+    const auto& index = Index<mutableT>();
+    if (const auto* entry = index.entry(id))
+        return *entry;
+    if (index.complete())
+        return nullptr;
+    auto it = Map<mutableT>().find(id);
+    return std::shared_ptr<T>(it != Map<mutableT>().end() ? it->second : nullptr);
 }
 
 template <typename T>
@@ -256,11 +340,9 @@ std::vector<std::shared_ptr<const T>> ObjectMap::find(const id_range& object_ids
 {
     std::vector<std::shared_ptr<const T>> retval;
     retval.reserve(boost::size(object_ids));
-    typedef typename std::remove_const<T>::type mutableT;
     for (int object_id : object_ids) {
-        auto map_it = Map<mutableT>().find(object_id);
-        if (map_it != Map<mutableT>().end())
-            retval.emplace_back(map_it->second);
+        if (auto obj = get<T>(object_id))
+            retval.push_back(std::move(obj));
     }
     return retval;
 }
@@ -270,11 +352,9 @@ std::vector<std::shared_ptr<T>> ObjectMap::find(const id_range& object_ids)
 {
     std::vector<std::shared_ptr<T>> retval;
     retval.reserve(boost::size(object_ids));
-    typedef typename std::remove_const<T>::type mutableT;
     for (int object_id : object_ids) {
-        auto map_it = Map<mutableT>().find(object_id);
-        if (map_it != Map<mutableT>().end())
-            retval.emplace_back(map_it->second);
+        if (auto obj = get<T>(object_id))
+            retval.push_back(std::move(obj));
     }
     return retval;
 }
@@ -350,6 +430,72 @@ void ObjectMap::insert(std::shared_ptr<T> item, int empire_id)
     insertCore(std::move(item), empire_id);
 }
 
+template <typename T>
+void ObjectMap::DenseIndex<T>::insert(int id, std::shared_ptr<T>* map_entry, std::size_t map_size)
+{
+    // limit table size so that a stray huge ID, such as a temporary object's
+    // ID, doesn't allocate a huge, mostly empty, table.  small maps of a few
+    // objects with high IDs, such as those of combats, are left to the map
+    constexpr std::size_t MIN_SLOTS_LIMIT = 1 << 10;
+    constexpr std::size_t SLOTS_PER_OBJECT_LIMIT = 16;
+    const std::size_t slots_limit = std::max(MIN_SLOTS_LIMIT, SLOTS_PER_OBJECT_LIMIT * map_size);
+
+    if (id >= 0 && static_cast<std::size_t>(id) < slots_limit) {
+        if (static_cast<std::size_t>(id) >= m_slots.size())
+            m_slots.resize(static_cast<std::size_t>(id) + 1, nullptr);
+        m_slots[static_cast<std::size_t>(id)] = map_entry;
+    } else {
+        m_complete = false;
+    }
+
+    // IDs mostly increase as objects are created, so usually this appends
+    const T* obj = map_entry ? map_entry->get() : nullptr;
+    if (m_ids.empty() || m_ids.back() < id) {
+        m_ids.push_back(id);
+        m_objects.push_back(obj);
+        return;
+    }
+    auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+    auto pos = std::distance(m_ids.begin(), it);
+    if (it != m_ids.end() && *it == id) {
+        m_objects[pos] = obj;
+    } else {
+        m_ids.insert(it, id);
+        m_objects.insert(m_objects.begin() + pos, obj);
+    }
+}
+
+template <typename T>
+void ObjectMap::DenseIndex<T>::erase(int id)
+{
+    if (id >= 0 && static_cast<std::size_t>(id) < m_slots.size())
+        m_slots[static_cast<std::size_t>(id)] = nullptr;
+    auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+    if (it == m_ids.end() || *it != id)
+        return;
+    m_objects.erase(m_objects.begin() + std::distance(m_ids.begin(), it));
+    m_ids.erase(it);
+}
+
+template <typename T>
+void ObjectMap::DenseIndex<T>::clear()
+{
+    m_slots.clear();
+    m_objects.clear();
+    m_ids.clear();
+    m_complete = true;
+}
+
+template <typename T>
+void ObjectMap::DenseIndex<T>::rebuild(container_type<T>& map)
+{
+    clear();
+    m_objects.reserve(map.size());
+    m_ids.reserve(map.size());
+    for (auto& [id, obj] : map)
+        insert(id, &obj, map.size());
+}
+
 // template specializations
 
 template <>
@@ -406,4 +552,31 @@ FO_COMMON_API ObjectMap::container_type<Building>& ObjectMap::Map();
 template <>
 FO_COMMON_API ObjectMap::container_type<Field>& ObjectMap::Map();
 
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<UniverseObject>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<ResourceCenter>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<PopCenter>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<Ship>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<Fleet>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<Planet>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<System>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<Building>& ObjectMap::Index() const;
+
+template <>
+FO_COMMON_API const ObjectMap::DenseIndex<Field>& ObjectMap::Index() const;
+
 #endif
@@ -0,0 +1,87 @@
+#include "ObjectVisibilityTable.h"
+
+
+namespace {
+    // ids below this can always be stored densely
+    constexpr std::size_t MIN_DENSE_LIMIT = 1 << 16;
+
+    // ids up to this many times the number of entries can be stored densely,
+    // so that the dense range is never mostly empty slots
+    constexpr std::size_t DENSE_LIMIT_PER_ENTRY = 16;
+}
+
+ObjectVisibilityTable::size_type ObjectVisibilityTable::erase(int object_id) {
+    if (object_id >= 0 && static_cast<std::size_t>(object_id) < m_dense.size()) {
+        auto& slot = m_dense[object_id];
+        if (slot.first == ABSENT)
+            return 0;
+        slot = {ABSENT, Visibility::VIS_NO_VISIBILITY};
+        --m_size;
+        return 1;
+    }
+    const auto erased = m_overflow.erase(object_id);
+    m_size -= erased;
+    return erased;
+}
+
+void ObjectVisibilityTable::clear() noexcept {
+    m_dense.clear();
+    m_overflow.clear();
+    m_size = 0;
+}
+
+bool ObjectVisibilityTable::operator==(const ObjectVisibilityTable& rhs) const {
+    if (m_size != rhs.m_size)
+        return false;
+    for (const auto& [id, vis] : *this) {
+        const auto* rhs_slot = rhs.Slot(id);
+        if (!rhs_slot || rhs_slot->second != vis)
+            return false;
+    }
+    return true;
+}
+
+std::pair<ObjectVisibilityTable::value_type*, bool> ObjectVisibilityTable::Insert(int object_id) {
+    if (ReserveDense(object_id)) {
+        auto& slot = m_dense[object_id];
+        if (slot.first != ABSENT)
+            return {&slot, false};
+        slot = {object_id, Visibility::VIS_NO_VISIBILITY};
+        ++m_size;
+        return {&slot, true};
+    }
+
+    auto [it, inserted] = m_overflow.try_emplace(object_id, object_id, Visibility::VIS_NO_VISIBILITY);
+    if (inserted)
+        ++m_size;
+    return {&it->second, inserted};
+}
+
+bool ObjectVisibilityTable::ReserveDense(int object_id) {
+    if (object_id < 0)
+        return false;
+    const auto idx = static_cast<std::size_t>(object_id);
+    if (idx < m_dense.size())
+        return true;
+
+    const auto limit = std::max(MIN_DENSE_LIMIT, DENSE_LIMIT_PER_ENTRY * (m_size + 1));
+    if (idx >= limit)
+        return false;
+
+    // grow geometrically, so that inserting ids in increasing order is cheap
+    ResizeDense(std::min(limit, std::max(idx + 1, m_dense.size() * 2)));
+    return true;
+}
+
+void ObjectVisibilityTable::ResizeDense(std::size_t new_size) {
+    if (new_size <= m_dense.size())
+        return;
+    m_dense.resize(new_size, {ABSENT, Visibility::VIS_NO_VISIBILITY});
+
+    // move overflow entries that are now within the dense range
+    auto it = m_overflow.lower_bound(0);
+    while (it != m_overflow.end() && static_cast<std::size_t>(it->first) < new_size) {
+        m_dense[it->first] = it->second;
+        it = m_overflow.erase(it);
+    }
+}
@@ -0,0 +1,242 @@
+#ifndef _ObjectVisibilityTable_h_
+#define _ObjectVisibilityTable_h_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "UniverseObject.h"
+#include "../util/Export.h"
+
+
+/** Visibility levels of objects, by object id, for a single empire.
+
+    Used like a std::map<int, Visibility>, but most entries are stored in a
+    vector indexed directly by object id, which avoids a tree node allocation
+    per object and makes lookups a single array access.  Object ids are
+    allocated densely from zero, so a table that has entries for most objects
+    in a universe wastes little space on empty slots.  Ids that are negative or
+    far beyond the number of entries in the table are kept in a std::map
+    instead, so that a few stray large ids can't cause a huge allocation.
+
+    As with a map, objects that have no entry are distinct from objects with an
+    entry of VIS_NO_VISIBILITY.  Iteration yields entries in increasing id order
+    for ids in the dense range, followed by any others in increasing id order. */
+class FO_COMMON_API ObjectVisibilityTable {
+public:
+    using key_type = int;
+    using mapped_type = Visibility;
+    using value_type = std::pair<int, Visibility>;
+    using size_type = std::size_t;
+
+    template <bool is_const>
+    class Iterator;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    [[nodiscard]] iterator       begin();
+    [[nodiscard]] iterator       end();
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+
+    [[nodiscard]] iterator       find(int object_id);
+    [[nodiscard]] const_iterator find(int object_id) const;
+
+    [[nodiscard]] size_type count(int object_id) const { return Slot(object_id) ? 1 : 0; }
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+    [[nodiscard]] bool      empty() const noexcept { return m_size == 0; }
+
+    /** Returns the visibility of object \a object_id, or VIS_NO_VISIBILITY if
+      * the table has no entry for it. */
+    [[nodiscard]] Visibility Get(int object_id) const {
+        const auto* slot = Slot(object_id);
+        return slot ? slot->second : Visibility::VIS_NO_VISIBILITY;
+    }
+
+    /** Returns the visibility of object \a object_id, inserting an entry of
+      * VIS_NO_VISIBILITY if there isn't one yet. */
+    Visibility& operator[](int object_id) { return Insert(object_id).first->second; }
+
+    size_type erase(int object_id);
+    void      clear() noexcept;
+
+    /** Sets the visibility of each object in \a other in this table, if it is
+      * higher than this table's, or if this table has no entry for that object.
+      * \a on_changed is called with the object id and new visibility of each
+      * entry that is changed. */
+    template <typename Fn>
+    void MergeMax(const ObjectVisibilityTable& other, Fn&& on_changed);
+
+    /** Returns the approximate number of bytes of memory allocated for the
+      * entries of this table. */
+    [[nodiscard]] std::size_t HeapBytes() const noexcept {
+        return m_dense.capacity() * sizeof(value_type) +
+            m_overflow.size() * (sizeof(decltype(m_overflow)::value_type) + 4 * sizeof(void*));
+    }
+
+    [[nodiscard]] bool operator==(const ObjectVisibilityTable& rhs) const;
+    [[nodiscard]] bool operator!=(const ObjectVisibilityTable& rhs) const { return !(*this == rhs); }
+
+private:
+    /** Marks an unoccupied slot in m_dense. Entries with this id are stored
+      * in m_overflow, as are all other negative ids. */
+    static constexpr int ABSENT = -1;
+
+    [[nodiscard]] value_type*       Slot(int object_id);
+    [[nodiscard]] const value_type* Slot(int object_id) const;
+
+    /** Returns the entry for \a object_id and whether it was newly inserted. */
+    std::pair<value_type*, bool> Insert(int object_id);
+
+    /** Returns true if \a object_id can be stored in m_dense, enlarging
+      * m_dense if needed. */
+    bool ReserveDense(int object_id);
+    void ResizeDense(std::size_t new_size);
+
+    std::vector<value_type>     m_dense;    ///< indexed by object id; slots with first == ABSENT are empty
+    std::map<int, value_type>   m_overflow; ///< entries with ids outside the range of m_dense
+    size_type                   m_size = 0;
+};
+
+template <bool is_const>
+class ObjectVisibilityTable::Iterator {
+    using Table = std::conditional_t<is_const, const ObjectVisibilityTable, ObjectVisibilityTable>;
+    using OverflowIt = std::conditional_t<is_const, std::map<int, ObjectVisibilityTable::value_type>::const_iterator,
+                                                    std::map<int, ObjectVisibilityTable::value_type>::iterator>;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ObjectVisibilityTable::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<is_const, const value_type*, value_type*>;
+
+    Iterator() = default;
+
+    operator Iterator<true>() const { return Iterator<true>(m_table, m_idx, m_overflow_it); }
+
+    [[nodiscard]] reference operator*() const
+    { return m_idx < m_table->m_dense.size() ? m_table->m_dense[m_idx] : m_overflow_it->second; }
+    [[nodiscard]] pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+        if (m_idx < m_table->m_dense.size()) {
+            ++m_idx;
+            SkipAbsent();
+        } else {
+            ++m_overflow_it;
+        }
+        return *this;
+    }
+    Iterator operator++(int) {
+        auto retval = *this;
+        ++*this;
+        return retval;
+    }
+
+    [[nodiscard]] bool operator==(const Iterator& rhs) const
+    { return m_idx == rhs.m_idx && m_overflow_it == rhs.m_overflow_it; }
+    [[nodiscard]] bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+private:
+    friend class ObjectVisibilityTable;
+    friend class Iterator<!is_const>;
+
+    Iterator(Table* table, std::size_t idx, OverflowIt overflow_it) :
+        m_table(table),
+        m_idx(idx),
+        m_overflow_it(overflow_it)
+    {}
+
+    void SkipAbsent() {
+        const auto& dense = m_table->m_dense;
+        while (m_idx < dense.size() && dense[m_idx].first == ABSENT)
+            ++m_idx;
+    }
+
+    Table*      m_table = nullptr;
+    std::size_t m_idx = 0;          ///< index in m_dense, or m_dense.size() when iterating through m_overflow
+    OverflowIt  m_overflow_it{};    ///< m_overflow.begin() while iterating through m_dense
+};
+
+inline ObjectVisibilityTable::iterator ObjectVisibilityTable::begin() {
+    iterator retval{this, 0, m_overflow.begin()};
+    retval.SkipAbsent();
+    return retval;
+}
+
+inline ObjectVisibilityTable::iterator ObjectVisibilityTable::end()
+{ return iterator{this, m_dense.size(), m_overflow.end()}; }
+
+inline ObjectVisibilityTable::const_iterator ObjectVisibilityTable::begin() const {
+    const_iterator retval{this, 0, m_overflow.begin()};
+    retval.SkipAbsent();
+    return retval;
+}
+
+inline ObjectVisibilityTable::const_iterator ObjectVisibilityTable::end() const
+{ return const_iterator{this, m_dense.size(), m_overflow.end()}; }
+
+inline ObjectVisibilityTable::iterator ObjectVisibilityTable::find(int object_id) {
+    if (object_id >= 0 && static_cast<std::size_t>(object_id) < m_dense.size())
+        return m_dense[object_id].first == ABSENT ? end() : iterator{this, static_cast<std::size_t>(object_id), m_overflow.begin()};
+    auto it = m_overflow.find(object_id);
+    return it == m_overflow.end() ? end() : iterator{this, m_dense.size(), it};
+}
+
+inline ObjectVisibilityTable::const_iterator ObjectVisibilityTable::find(int object_id) const {
+    if (object_id >= 0 && static_cast<std::size_t>(object_id) < m_dense.size())
+        return m_dense[object_id].first == ABSENT ? end() : const_iterator{this, static_cast<std::size_t>(object_id), m_overflow.begin()};
+    auto it = m_overflow.find(object_id);
+    return it == m_overflow.end() ? end() : const_iterator{this, m_dense.size(), it};
+}
+
+inline ObjectVisibilityTable::value_type* ObjectVisibilityTable::Slot(int object_id) {
+    if (object_id >= 0 && static_cast<std::size_t>(object_id) < m_dense.size()) {
+        auto& slot = m_dense[object_id];
+        return slot.first == ABSENT ? nullptr : &slot;
+    }
+    auto it = m_overflow.find(object_id);
+    return it == m_overflow.end() ? nullptr : &it->second;
+}
+
+inline const ObjectVisibilityTable::value_type* ObjectVisibilityTable::Slot(int object_id) const
+{ return const_cast<ObjectVisibilityTable*>(this)->Slot(object_id); }
+
+template <typename Fn>
+void ObjectVisibilityTable::MergeMax(const ObjectVisibilityTable& other, Fn&& on_changed) {
+    if (other.m_dense.size() > m_dense.size())
+        ResizeDense(other.m_dense.size());
+
+    // bulk pass over the dense range of other, which is now within that of this
+    for (std::size_t idx = 0; idx < other.m_dense.size(); ++idx) {
+        const auto& [other_id, other_vis] = other.m_dense[idx];
+        if (other_id == ABSENT)
+            continue;
+        auto& slot = m_dense[idx];
+        if (slot.first == ABSENT) {
+            slot = {other_id, other_vis};
+            ++m_size;
+        } else if (slot.second < other_vis) {
+            slot.second = other_vis;
+        } else {
+            continue;
+        }
+        on_changed(other_id, other_vis);
+    }
+
+    for (const auto& [other_id, other_entry] : other.m_overflow) {
+        auto [slot, inserted] = Insert(other_id);
+        if (inserted || slot->second < other_entry.second) {
+            slot->second = other_entry.second;
+            on_changed(other_id, other_entry.second);
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef _OpinionMatrix_h_
+#define _OpinionMatrix_h_
+
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/container/flat_map.hpp>
+
+
+/** Opinions of species about rated things, such as empires or other species,
+    in a dense matrix with a row for each opinionated species and a column for
+    each rated thing.  Species and rated things are given their row and column
+    the first time an opinion of or about them is set, and keep them until the
+    matrix is cleared, so that looking up an opinion is two small searches and
+    an index, and the opinions of a species are contiguous.
+
+    An opinion that has not been set is distinct from one that has been set to
+    zero, so that exporting the opinions as a map gives only those that were
+    set. */
+template <typename RatedKey>
+class OpinionMatrix {
+public:
+    using MapType = std::map<std::string, std::map<RatedKey, float>>;
+
+    /** Returns the opinion of \a species about \a rated, or 0.0 if none has
+      * been set. */
+    [[nodiscard]] float Get(const std::string& species, const RatedKey& rated) const {
+        const auto row_it = m_rows.find(species);
+        if (row_it == m_rows.end())
+            return 0.0f;
+        const auto column_it = m_columns.find(rated);
+        if (column_it == m_columns.end())
+            return 0.0f;
+        const float value = m_values[Offset(row_it->second, column_it->second)];
+        return std::isnan(value) ? 0.0f : value;
+    }
+
+    void Set(const std::string& species, const RatedKey& rated, float opinion) {
+        const std::size_t row = Row(species);
+        const std::size_t column = Column(rated);
+        m_values[Offset(row, column)] = opinion;
+    }
+
+    void Clear() {
+        m_rows.clear();
+        m_columns.clear();
+        m_values.clear();
+    }
+
+    /** Returns the opinions that have been set, by species and then by rated
+      * thing. */
+    [[nodiscard]] MapType ToMap() const {
+        MapType retval;
+        for (const auto& [species, row] : m_rows) {
+            for (const auto& [rated, column] : m_columns) {
+                const float value = m_values[Offset(row, column)];
+                if (!std::isnan(value))
+                    retval[species].emplace(rated, value);
+            }
+        }
+        return retval;
+    }
+
+    /** Replaces all opinions with those in \a opinions. */
+    void Assign(const MapType& opinions) {
+        Clear();
+        for (const auto& [species, rated_opinions] : opinions)
+            for (const auto& [rated, opinion] : rated_opinions)
+                Set(species, rated, opinion);
+    }
+
+private:
+    static constexpr float UNSET = std::numeric_limits<float>::quiet_NaN();
+
+    [[nodiscard]] std::size_t Offset(std::size_t row, std::size_t column) const noexcept
+    { return row * m_columns.size() + column; }
+
+    /** Returns the row of \a species, adding one if there isn't one yet. */
+    std::size_t Row(const std::string& species) {
+        const auto [it, added] = m_rows.emplace(species, m_rows.size());
+        if (added)
+            m_values.resize(m_rows.size() * m_columns.size(), UNSET);
+        return it->second;
+    }
+
+    /** Returns the column of \a rated, adding one to every row if there isn't
+      * one yet. */
+    std::size_t Column(const RatedKey& rated) {
+        const auto [it, added] = m_columns.emplace(rated, m_columns.size());
+        if (added && !m_rows.empty()) {
+            const std::size_t old_num_columns = m_columns.size() - 1;
+            std::vector<float> values(m_rows.size() * m_columns.size(), UNSET);
+            for (std::size_t row = 0; row < m_rows.size(); ++row)
+                for (std::size_t column = 0; column < old_num_columns; ++column)
+                    values[Offset(row, column)] = m_values[row * old_num_columns + column];
+            m_values = std::move(values);
+        }
+        return it->second;
+    }
+
+    boost::container::flat_map<std::string, std::size_t>    m_rows;
+    boost::container::flat_map<RatedKey, std::size_t>       m_columns;
+    std::vector<float>                                      m_values;   ///< row-major, one row per species in m_rows
+};
+
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef _PartMeterMap_h_
+#define _PartMeterMap_h_
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Enums.h"
+#include "Meter.h"
+
+
+/** The part meters of a Ship.  Each distinct part name of the ship is given
+    an index when its first meter is added, and the meters are stored
+    contiguously at that index times the number of part meter types, plus the
+    slot of the meter type, with a mask of the meter types each part has.
+    Looking up a meter by part index is thus an index rather than a search
+    of a map keyed by strings, and a pass over the meters of a ship is a loop
+    over contiguous memory.
+
+    Part names are kept sorted, so part indices are ordered by name, and a
+    meter can also be looked up by name with a binary search, which callers
+    that look up several meters of one part can do once with PartIndex().
+    Meters are only added when a ship is created or deserialized. */
+class PartMeterMap {
+public:
+    using MapType = std::map<std::pair<MeterType, std::string>, Meter>;
+
+    static constexpr std::size_t NO_PART = std::numeric_limits<std::size_t>::max();
+
+    /** The types of meter that parts can have, in slot order. */
+    static constexpr std::array<MeterType, 4> METER_TYPES{
+        MeterType::METER_CAPACITY, MeterType::METER_MAX_CAPACITY,
+        MeterType::METER_SECONDARY_STAT, MeterType::METER_MAX_SECONDARY_STAT};
+    static constexpr std::size_t NUM_SLOTS = METER_TYPES.size();
+    static constexpr std::size_t NO_SLOT = NUM_SLOTS;
+
+    /** Returns the slot of meter type \a type, or NO_SLOT if it isn't a part
+      * meter type. */
+    [[nodiscard]] static constexpr std::size_t Slot(MeterType type) noexcept {
+        for (std::size_t slot = 0; slot < NUM_SLOTS; ++slot)
+            if (METER_TYPES[slot] == type)
+                return slot;
+        return NO_SLOT;
+    }
+
+    /** Returns the max meter type that is paired with the active meter type
+      * \a type, or INVALID_METER_TYPE if \a type isn't a paired active part
+      * meter type. */
+    [[nodiscard]] static constexpr MeterType PairedMaxType(MeterType type) noexcept {
+        switch (type) {
+        case MeterType::METER_CAPACITY:       return MeterType::METER_MAX_CAPACITY;
+        case MeterType::METER_SECONDARY_STAT: return MeterType::METER_MAX_SECONDARY_STAT;
+        default:                              return MeterType::INVALID_METER_TYPE;
+        }
+    }
+
+    /** Returns the index of the part named \a part_name, or NO_PART if this
+      * has no meters for such a part. */
+    [[nodiscard]] std::size_t PartIndex(std::string_view part_name) const noexcept {
+        const auto it = std::lower_bound(m_part_names.begin(), m_part_names.end(), part_name,
+                                         [](const std::string& name, std::string_view n) { return name < n; });
+        return (it == m_part_names.end() || *it != part_name) ?
+            NO_PART : static_cast<std::size_t>(std::distance(m_part_names.begin(), it));
+    }
+
+    [[nodiscard]] const std::vector<std::string>& PartNames() const noexcept { return m_part_names; }
+    [[nodiscard]] std::size_t NumParts() const noexcept { return m_part_names.size(); }
+
+    /** Returns the meter of type \a type of the part with index \a part_idx,
+      * or nullptr if there isn't one. */
+    [[nodiscard]] const Meter* get(MeterType type, std::size_t part_idx) const noexcept {
+        const auto offset = Offset(type, part_idx);
+        return offset == NO_PART ? nullptr : &m_meters[offset];
+    }
+
+    [[nodiscard]] Meter* get(MeterType type, std::size_t part_idx) noexcept {
+        const auto offset = Offset(type, part_idx);
+        return offset == NO_PART ? nullptr : &m_meters[offset];
+    }
+
+    [[nodiscard]] const Meter* get(MeterType type, std::string_view part_name) const noexcept
+    { return get(type, PartIndex(part_name)); }
+
+    [[nodiscard]] Meter* get(MeterType type, std::string_view part_name) noexcept
+    { return get(type, PartIndex(part_name)); }
+
+    [[nodiscard]] bool Has(MeterType type, std::size_t part_idx) const noexcept
+    { return Offset(type, part_idx) != NO_PART; }
+
+    /** Returns the meter of type \a type of the part named \a part_name,
+      * adding a default meter if there isn't one.  \a type must be one of
+      * METER_TYPES. */
+    Meter& operator[](const std::pair<MeterType, std::string>& key) {
+        const auto slot = Slot(key.first);
+        const auto part_idx = AddPart(key.second);
+        m_present[part_idx] |= static_cast<std::uint8_t>(1u << slot);
+        return m_meters[part_idx*NUM_SLOTS + slot];
+    }
+
+    /** Calls \a fn with the part index, meter type and meter of each meter,
+      * in order of part index and then slot. */
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+        for (std::size_t part_idx = 0; part_idx < m_part_names.size(); ++part_idx)
+            for (std::size_t slot = 0; slot < NUM_SLOTS; ++slot)
+                if (m_present[part_idx] & (1u << slot))
+                    fn(part_idx, METER_TYPES[slot], m_meters[part_idx*NUM_SLOTS + slot]);
+    }
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (std::size_t part_idx = 0; part_idx < m_part_names.size(); ++part_idx)
+            for (std::size_t slot = 0; slot < NUM_SLOTS; ++slot)
+                if (m_present[part_idx] & (1u << slot))
+                    fn(part_idx, METER_TYPES[slot], m_meters[part_idx*NUM_SLOTS + slot]);
+    }
+
+    template <typename Fn>
+    void ForEach(MeterType type, Fn&& fn) const {
+        const auto slot = Slot(type);
+        if (slot == NO_SLOT)
+            return;
+        for (std::size_t part_idx = 0; part_idx < m_part_names.size(); ++part_idx)
+            if (m_present[part_idx] & (1u << slot))
+                fn(part_idx, m_meters[part_idx*NUM_SLOTS + slot]);
+    }
+
+    /** Returns the number of meters. */
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t retval = 0;
+        for (const auto mask : m_present)
+            for (std::size_t slot = 0; slot < NUM_SLOTS; ++slot)
+                retval += (mask >> slot) & 1u;
+        return retval;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_part_names.empty(); }
+
+    void clear() noexcept {
+        m_part_names.clear();
+        m_meters.clear();
+        m_present.clear();
+    }
+
+    /** Returns the meters keyed by meter type and part name. */
+    [[nodiscard]] MapType ToMap() const {
+        MapType retval;
+        ForEach([this, &retval](std::size_t part_idx, MeterType type, const Meter& meter)
+                { retval.emplace(std::pair{type, m_part_names[part_idx]}, meter); });
+        return retval;
+    }
+
+    /** Replaces all meters with those in \a meters.  Entries with types that
+      * parts don't have are dropped. */
+    void Assign(const MapType& meters) {
+        clear();
+        for (const auto& [key, meter] : meters)
+            if (Slot(key.first) != NO_SLOT)
+                (*this)[key] = meter;
+    }
+
+    [[nodiscard]] std::size_t HeapBytes() const noexcept {
+        std::size_t retval = m_part_names.capacity() * sizeof(std::string) +
+                             m_meters.capacity() * sizeof(Meter) + m_present.capacity();
+        for (const auto& name : m_part_names)
+            if (name.capacity() > std::string{}.capacity())
+                retval += name.capacity() + 1;
+        return retval;
+    }
+
+private:
+    [[nodiscard]] std::size_t Offset(MeterType type, std::size_t part_idx) const noexcept {
+        const auto slot = Slot(type);
+        if (slot == NO_SLOT || part_idx >= m_part_names.size() || !(m_present[part_idx] & (1u << slot)))
+            return NO_PART;
+        return part_idx*NUM_SLOTS + slot;
+    }
+
+    /** Returns the index of the part named \a part_name, adding it if there
+      * isn't one yet, which moves the meters of parts with later names. */
+    std::size_t AddPart(const std::string& part_name) {
+        const auto it = std::lower_bound(m_part_names.begin(), m_part_names.end(), part_name);
+        const auto part_idx = static_cast<std::size_t>(std::distance(m_part_names.begin(), it));
+        if (it != m_part_names.end() && *it == part_name)
+            return part_idx;
+        m_part_names.insert(it, part_name);
+        m_meters.insert(m_meters.begin() + part_idx*NUM_SLOTS, NUM_SLOTS, Meter{});
+        m_present.insert(m_present.begin() + part_idx, 0u);
+        return part_idx;
+    }
+
+    static_assert(NUM_SLOTS <= 8, "part meter types are masked in a byte");
+
+    std::vector<std::string>    m_part_names;   ///< sorted, index is the part index
+    std::vector<Meter>          m_meters;       ///< NUM_SLOTS per part, some of which may be absent
+    std::vector<std::uint8_t>   m_present;      ///< for each part, a mask of the slots that have meters
+};
+
+
+#endif
@@ -1,8 +1,15 @@
 #include "Pathfinder.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <stdexcept>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/breadth_first_search.hpp>
@@ -13,25 +20,152 @@
 #include "Fleet.h"
 #include "Ship.h"
 #include "System.h"
+#include "SystemRegions.h"
 #include "UniverseObject.h"
 #include "Universe.h"
 #include "../Empire/EmpireManager.h"
+#include "../util/i18n.h"
 #include "../util/Logger.h"
+#include "../util/OptionsDB.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 
 
 namespace {
     const double    WORMHOLE_TRAVEL_DISTANCE = 0.1;         // the effective distance for ships travelling along a wormhole, for determining how much of their speed is consumed by the jump
+
+    void AddOptions(OptionsDB& db) {
+        db.Add("pathfinder.jumps.precompute.max-systems", UserStringNop("OPTIONS_DB_PATHFINDER_JUMPS_PRECOMPUTE_MAX_SYSTEMS"),
+               0, RangedValidator<int>(0, 100000));
+        db.Add("pathfinder.regions.min-systems", UserStringNop("OPTIONS_DB_PATHFINDER_REGIONS_MIN_SYSTEMS"),
+               0, RangedValidator<int>(0, 100000));
+    }
+    bool temp_bool = RegisterOptions(&AddOptions);
 }
 
 FO_COMMON_API extern const int ALL_EMPIRES;
 
 namespace {
-    /** distance_matrix_storage implements the storage and the mutexes
-        for distance in number of hops from system to system.
+    /** Pathfinding query counts of one thread.  Only that thread changes
+        them, so they are updated without read-modify-write operations. */
+    struct ThreadPathfinderCounters {
+        static constexpr auto NUM_QUERIES = static_cast<std::size_t>(PathfinderQuery::NUM_PATHFINDER_QUERIES);
+
+        std::array<std::atomic<std::uint64_t>, NUM_QUERIES> query_counts{};
+        std::array<std::atomic<std::uint64_t>, NUM_QUERIES> query_nanoseconds{};
+        std::atomic<std::uint64_t>  cache_hits{0};
+        std::atomic<std::uint64_t>  cache_misses{0};
+        std::atomic<std::uint64_t>  rows_computed{0};
+        std::atomic<std::uint64_t>  row_nanoseconds{0};
+
+        static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept
+        { counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); }
+    };
+
+    /** The counters of every thread that has made pathfinding queries.  They
+        are kept after their threads end, so that the totals don't drop. */
+    class PathfinderCounters {
+    public:
+        static PathfinderCounters& Get() {
+            static PathfinderCounters counters;
+            return counters;
+        }
+
+        ThreadPathfinderCounters& ThreadCounters() {
+            thread_local ThreadPathfinderCounters* t_counters = [this]() {
+                std::scoped_lock lock(m_mutex);
+                m_threads.push_back(std::make_unique<ThreadPathfinderCounters>());
+                return m_threads.back().get();
+            }();
+            return *t_counters;
+        }
+
+        PathfinderStatistics Total() {
+            PathfinderStatistics retval;
+            retval.caller = m_caller.load(std::memory_order_relaxed);
+            const auto sum = [](std::uint64_t& total, const std::atomic<std::uint64_t>& counter)
+            { total += counter.load(std::memory_order_relaxed); };
+
+            std::scoped_lock lock(m_mutex);
+            for (const auto& thread_counters : m_threads) {
+                for (std::size_t query = 0; query < ThreadPathfinderCounters::NUM_QUERIES; ++query) {
+                    sum(retval.queries[query].count, thread_counters->query_counts[query]);
+                    sum(retval.queries[query].nanoseconds, thread_counters->query_nanoseconds[query]);
+                }
+                sum(retval.cache_hits, thread_counters->cache_hits);
+                sum(retval.cache_misses, thread_counters->cache_misses);
+                sum(retval.rows_computed, thread_counters->rows_computed);
+                sum(retval.row_nanoseconds, thread_counters->row_nanoseconds);
+            }
+            return retval;
+        }
+
+        void SetCaller(PathfinderCaller caller) noexcept
+        { m_caller.store(caller, std::memory_order_relaxed); }
+
+    private:
+        PathfinderCounters() = default;
+
+        std::mutex                                              m_mutex;
+        std::vector<std::unique_ptr<ThreadPathfinderCounters>>  m_threads;
+        std::atomic<PathfinderCaller>                           m_caller = PathfinderCaller::PATHFINDER_CALLER_OTHER;
+    };
+
+    ThreadPathfinderCounters& ThreadCounters()
+    { return PathfinderCounters::Get().ThreadCounters(); }
+
+    std::uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    /** Counts a pathfinding query of type \p query and the time taken by it,
+        which is the lifetime of this object. */
+    class QueryCounter {
+    public:
+        explicit QueryCounter(PathfinderQuery query) :
+            m_query(static_cast<std::size_t>(query))
+        {}
+
+        ~QueryCounter() {
+            auto& counters = ThreadCounters();
+            ThreadPathfinderCounters::Add(counters.query_counts[m_query], 1);
+            ThreadPathfinderCounters::Add(counters.query_nanoseconds[m_query], NanosecondsSince(m_start));
+        }
+
+    private:
+        const std::size_t                           m_query;
+        const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+    };
+
+    void CountJumpDistanceQuery()
+    { ThreadPathfinderCounters::Add(ThreadCounters().query_counts[static_cast<std::size_t>(PathfinderQuery::JUMP_DISTANCE)], 1); }
 
-        For N systems there are N rows of N integer types T.
-        Each row has a mutex and the whole table has a mutex.
+    void CountCacheLookup(bool hit) {
+        auto& counters = ThreadCounters();
+        ThreadPathfinderCounters::Add(hit ? counters.cache_hits : counters.cache_misses, 1);
+    }
+
+    /** Logs the pathfinding queries made during turn profiles. */
+    const bool pathfinder_turn_report_added = []() {
+        auto turn_start = std::make_shared<PathfinderStatistics>();
+        AddTurnProfileReport([turn_start]() { *turn_start = GetPathfinderStatistics(); },
+                             [turn_start]() { return (GetPathfinderStatistics() - *turn_start).Dump(); });
+        return true;
+    }();
+    /** distance_matrix_storage implements the storage for distance in number
+        of hops from system to system.
+
+        For N systems there are N rows of N integer types T.  Each row is
+        filled at most once, by whichever thread first needs it, and is then
+        published by setting its filled flag.  Once the flag is set the row is
+        never modified again, so it can be read with no locking.  Each row also
+        has a mutex, which is only locked by threads filling that row, so that
+        it isn't filled more than once concurrently.
+
+        resize() discards all rows, and must not be called concurrently with
+        any other use of the storage.  It is only called when the system graph
+        is replaced, which must not happen concurrently with pathfinding anyway.
 
         The table is assumed symmetric.  If present row i element j will
         equal row j element i.
@@ -41,60 +175,60 @@ namespace {
         typedef T value_type;  ///< An integral type for number of hops.
         typedef std::vector<T>& row_ref;  ///< A reference to row type
 
-        distance_matrix_storage() {};
+        struct row_type {
+            std::vector<T>      data;
+            std::atomic<bool>   filled{false};
+            std::mutex          fill_mutex;
+        };
+
+        distance_matrix_storage() = default;
         distance_matrix_storage(const distance_matrix_storage<T>& src)
-        { resize(src.m_data.size()); };
-        //TODO C++11 Move Constructor.
+        { resize(src.size()); };
 
         /**Number of rows and columns. (N)*/
-        size_t size()
-        { return m_data.size(); }
+        size_t size() const noexcept
+        { return m_size; }
 
-        /**Resize and clear all mutexes.  Assumes that table is locked.*/
+        /**Resize and clear all rows.*/
         void resize(size_t a_size) {
-            m_data.clear();
-            m_data.resize(a_size);
-            m_row_mutexes.resize(a_size);
-            for (auto &row_mutex : m_row_mutexes)
-                row_mutex = std::make_shared<std::shared_mutex>();
+            m_rows = std::make_unique<row_type[]>(a_size);
+            m_size = a_size;
+        }
+
+        /**Approximate bytes allocated for the rows and the filled rows' data.*/
+        size_t heap_bytes() const {
+            size_t retval = m_size * sizeof(row_type);
+            for (size_t ii = 0; ii < m_size; ++ii)
+                if (m_rows[ii].filled.load(std::memory_order_acquire))
+                    retval += m_rows[ii].data.capacity() * sizeof(T);
+            return retval;
         }
 
-        /**N x N table of hop distances in row column form.*/
-        std::vector< std::vector<T>> m_data;
-        /**Per row mutexes.*/
-        std::vector< std::shared_ptr<std::shared_mutex>> m_row_mutexes;
-        /**Table mutex*/
-        std::shared_mutex m_mutex;
+        /**N rows of hop distances in row column form.*/
+        std::unique_ptr<row_type[]> m_rows;
+        size_t                      m_size = 0;
     };
 
 
     /**distance_matrix_cache is a cache of symmetric hop distances
        based on distance_matrix_storage.
 
-    It enforces the locking convention with get_T which returns either a single
-    integral value or calls a cache miss handler to fill an entire write locked
-    row with data and then returns the requested value.
+    It enforces the filling convention with get_T which returns either a single
+    integral value or calls a cache miss handler to fill an entire row with
+    data, publishes the row, and then returns the requested value.
 
-    All operations first lock the table and then when necessary the row.
+    Rows that have been published are read without locking.
     */
-    //TODO: Consider replacing this scheme with thread local storage.  It
-    //may be true that because this is a computed value that depends on
-    //the system topology that almost never changes that the
-    //synchronization costs way out-weigh the saved computation costs.
     template <typename Storage, typename T = typename Storage::value_type, typename Row = typename Storage::row_ref>
     class distance_matrix_cache {
         public:
         distance_matrix_cache(Storage& the_storage) : m_storage(the_storage) {}
-        /**Read lock the table and return the size N.*/
-        size_t size() {
-            std::shared_lock<std::shared_mutex> guard(m_storage.m_mutex);
-            return m_storage.size();
-        }
-        /**Write lock the table and resize to N = \p a_size.*/
-        void resize(size_t a_size) {
-            std::unique_lock<std::shared_mutex> guard(m_storage.m_mutex);
-            m_storage.resize(a_size);
-        }
+        /**Return the size N.*/
+        size_t size() const
+        { return m_storage.size(); }
+        /**Resize to N = \p a_size.  Must not be called concurrently with any other use of the storage.*/
+        void resize(size_t a_size)
+        { m_storage.resize(a_size); }
 
         public:
 
@@ -115,48 +249,28 @@ namespace {
           * Throws if either index is out of range or if \p fill_row
           * does not fill the row  on a cache miss.
           */
-        T get_T(size_t ii, size_t jj, cache_miss_handler fill_row) const {
-            std::shared_lock<std::shared_mutex> guard(m_storage.m_mutex);
-
+        T get_T(size_t ii, size_t jj, const cache_miss_handler& fill_row) const {
             size_t NN = m_storage.size();
             if ((ii >= NN) || (jj >= NN)) {
                 ErrorLogger() << "distance_matrix_cache::get_T passed invalid node indices: "
                               << ii << "," << jj << " matrix size: " << NN;
                 throw std::out_of_range("row and/or column index is invalid.");
             }
-            {
-                std::shared_lock<std::shared_mutex> row_guard(*m_storage.m_row_mutexes[ii]);
-                const Row &row_data = m_storage.m_data[ii];
 
-                if (NN == row_data.size())
-                    return row_data[jj];
+            auto& row = m_storage.m_rows[ii];
+            if (row.filled.load(std::memory_order_acquire)) {
+                CountCacheLookup(true);
+                return row.data[jj];
             }
-            {
-                std::shared_lock<std::shared_mutex> column_guard(*m_storage.m_row_mutexes[jj]);
-                const Row &column_data = m_storage.m_data[jj];
 
-                if (NN == column_data.size())
-                    return column_data[ii];
+            const auto& column = m_storage.m_rows[jj];
+            if (column.filled.load(std::memory_order_acquire)) {
+                CountCacheLookup(true);
+                return column.data[ii];
             }
-            {
-                std::unique_lock<std::shared_mutex> row_guard(*m_storage.m_row_mutexes[ii]);
-                Row &row_data = m_storage.m_data[ii];
 
-                if (NN == row_data.size()) {
-                    return row_data[jj];
-                } else {
-                    fill_row(ii, row_data);
-                    if (row_data.size() != NN) {
-                        std::stringstream ss;
-                        ss << "Cache miss handler only filled cache row with "
-                           << row_data.size() << " items when " << NN
-                           << " items where expected ";
-                        ErrorLogger() << ss.str();
-                        throw std::out_of_range(ss.str());
-                    }
-                    return row_data[jj];
-                }
-            }
+            CountCacheLookup(false);
+            return filled_row(ii, row, fill_row)[jj];
         }
 
         /** Retrieve a single row at \p ii.
@@ -166,44 +280,71 @@ namespace {
           * Throws if index is out of range or if \p fill_row
           * does not fill the row  on a cache miss.
           */
-        void examine_row(size_t ii, cache_miss_handler fill_row, cache_hit_handler use_row) const {
-            std::shared_lock<std::shared_mutex> guard(m_storage.m_mutex);
-
+        void examine_row(size_t ii, const cache_miss_handler& fill_row, const cache_hit_handler& use_row) const {
             size_t NN = m_storage.size();
             if (ii >= NN) {
                 ErrorLogger() << "distance_matrix_cache::get_row passed invalid index: "
                               << ii << " matrix size: " << NN;
                 throw std::out_of_range("row index is invalid.");
             }
-            {
-                std::shared_lock<std::shared_mutex> row_guard(*m_storage.m_row_mutexes[ii]);
-                const Row &row_data = m_storage.m_data[ii];
 
-                if (NN == row_data.size())
-                    return use_row(ii, row_data);
-            }
-            {
-                std::unique_lock<std::shared_mutex> row_guard(*m_storage.m_row_mutexes[ii]);
-                Row &row_data = m_storage.m_data[ii];
+            auto& row = m_storage.m_rows[ii];
+            const bool hit = row.filled.load(std::memory_order_acquire);
+            CountCacheLookup(hit);
+            if (hit)
+                return use_row(ii, row.data);
 
-                if (NN == row_data.size()) {
-                    return use_row(ii, row_data);
-                } else {
-                    fill_row(ii, row_data);
-                    if (row_data.size() != NN) {
-                        std::stringstream ss;
-                        ss << "Cache miss handler only filled cache row with "
-                           << row_data.size() << " items when " << NN
-                           << " items where expected ";
-                        ErrorLogger() << ss.str();
-                        throw std::range_error(ss.str());
+            return use_row(ii, filled_row(ii, row, fill_row));
+        }
+
+        /** Fill every row that hasn't been filled yet, in parallel. */
+        void fill_all(const cache_miss_handler& fill_row) const {
+            const size_t NN = m_storage.size();
+            if (NN == 0)
+                return;
+
+            // a row per task is too fine-grained for small graphs
+            const size_t rows_per_task = std::max<size_t>(1, 4096 / NN);
+
+            TaskBatch batch("distance_matrix_cache::fill_all");
+            for (size_t first_ii = 0; first_ii < NN; first_ii += rows_per_task) {
+                batch.Post([this, &fill_row, first_ii, last_ii{std::min(NN, first_ii + rows_per_task)}]() {
+                    for (size_t ii = first_ii; ii < last_ii; ++ii) {
+                        auto& row = m_storage.m_rows[ii];
+                        if (!row.filled.load(std::memory_order_acquire))
+                            filled_row(ii, row, fill_row);
                     }
-                    return use_row(ii, row_data);
-                }
+                });
             }
+            batch.Wait();
         }
 
     private:
+        /** Return the data of \p row, first filling it with \p fill_row and
+          * publishing it if no other thread has yet. */
+        Row filled_row(size_t ii, typename Storage::row_type& row, const cache_miss_handler& fill_row) const {
+            std::scoped_lock row_guard(row.fill_mutex);
+            if (row.filled.load(std::memory_order_relaxed))
+                return row.data;
+
+            const size_t NN = m_storage.size();
+            const auto start = std::chrono::steady_clock::now();
+            fill_row(ii, row.data);
+            auto& counters = ThreadCounters();
+            ThreadPathfinderCounters::Add(counters.rows_computed, 1);
+            ThreadPathfinderCounters::Add(counters.row_nanoseconds, NanosecondsSince(start));
+            if (row.data.size() != NN) {
+                std::stringstream ss;
+                ss << "Cache miss handler only filled cache row with "
+                   << row.data.size() << " items when " << NN
+                   << " items where expected ";
+                ErrorLogger() << ss.str();
+                throw std::out_of_range(ss.str());
+            }
+            row.filled.store(true, std::memory_order_release);
+            return row.data;
+        }
+
         Storage& m_storage;
     };
 }
@@ -298,19 +439,169 @@ namespace SystemPathing {
     ////////////////////////////////////////////////////////////////
     struct vertex_system_id_t {typedef boost::vertex_property_tag kind;}; ///< a system graph property map type
 
+    /** Shortest path distances from a few landmark vertices of a graph to
+      * every vertex.  By the triangle inequality, the difference between the
+      * distances of two vertices from any landmark is a lower bound on the
+      * distance between those vertices, which makes a good A* heuristic (ALT).
+      * The bounds are also valid for any subgraph with the same vertices. */
+    struct LandmarkDistances {
+        /** Returns a lower bound on the distance between vertices \a ii and
+          * \a jj, or infinity if there is no path between them. */
+        [[nodiscard]] double LowerBound(size_t ii, size_t jj) const {
+            double retval = 0.0;
+            const double* ii_distances = &distances[ii * num_landmarks];
+            const double* jj_distances = &distances[jj * num_landmarks];
+            for (size_t kk = 0; kk < num_landmarks; ++kk) {
+                const double ii_dist = ii_distances[kk], jj_dist = jj_distances[kk];
+                if (ii_dist == UNREACHABLE || jj_dist == UNREACHABLE) {
+                    // vertices in different components have no path between them
+                    if (ii_dist != jj_dist)
+                        return UNREACHABLE;
+                    continue;
+                }
+                retval = std::max(retval, std::abs(ii_dist - jj_dist));
+            }
+            return retval;
+        }
+
+        static constexpr double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+        size_t              num_landmarks = 0;
+        std::vector<double> distances;  ///< indexed by vertex * num_landmarks + landmark
+    };
+
+    constexpr size_t MAX_LANDMARKS = 8;
+
+    /** Returns distances from up to \a max_landmarks landmarks of \a graph,
+      * chosen to be far from each other.  Vertices unreachable from all
+      * landmarks chosen so far are preferred, so that each component of the
+      * graph gets a landmark if possible. */
+    template <typename Graph>
+    LandmarkDistances FindLandmarkDistances(const Graph& graph, size_t max_landmarks = MAX_LANDMARKS) {
+        typedef typename boost::property_map<Graph, boost::vertex_index_t>::const_type  ConstIndexPropertyMap;
+        typedef typename boost::property_map<Graph, boost::edge_weight_t>::const_type   ConstEdgeWeightPropertyMap;
+
+        const size_t num_vertices = boost::num_vertices(graph);
+        ConstIndexPropertyMap index_map = boost::get(boost::vertex_index, graph);
+        ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
+
+        std::vector<std::vector<double>> landmark_distances;
+        std::vector<double> nearest_landmark_distances(num_vertices, LandmarkDistances::UNREACHABLE);
+        std::vector<size_t> predecessors(num_vertices);
+        size_t landmark = 0;
+
+        while (landmark_distances.size() < std::min(max_landmarks, num_vertices)) {
+            auto& distances = landmark_distances.emplace_back(num_vertices, LandmarkDistances::UNREACHABLE);
+            boost::dijkstra_shortest_paths(
+                graph, landmark, &predecessors[0], &distances[0],
+                edge_weight_map, index_map, std::less<double>(), std::plus<double>(),
+                LandmarkDistances::UNREACHABLE, 0.0, boost::default_dijkstra_visitor());
+
+            for (size_t ii = 0; ii < num_vertices; ++ii)
+                nearest_landmark_distances[ii] = std::min(nearest_landmark_distances[ii], distances[ii]);
+
+            const auto farthest_it = std::max_element(nearest_landmark_distances.begin(),
+                                                      nearest_landmark_distances.end());
+            if (*farthest_it <= 0.0)
+                break;  // every vertex is a landmark or at no distance from one
+            landmark = static_cast<size_t>(std::distance(nearest_landmark_distances.begin(), farthest_it));
+        }
+
+        LandmarkDistances retval;
+        retval.num_landmarks = landmark_distances.size();
+        retval.distances.resize(num_vertices * retval.num_landmarks);
+        for (size_t ii = 0; ii < num_vertices; ++ii)
+            for (size_t kk = 0; kk < retval.num_landmarks; ++kk)
+                retval.distances[ii * retval.num_landmarks + kk] = landmark_distances[kk][ii];
+        return retval;
+    }
+
+    /** Returns the edges of \a graph, in the form used by SystemRegions. */
+    template <typename Graph>
+    SystemRegions::Adjacency AdjacencyOf(const Graph& graph) {
+        typedef typename boost::property_map<Graph, boost::vertex_index_t>::const_type  ConstIndexPropertyMap;
+        typedef typename boost::property_map<Graph, boost::edge_weight_t>::const_type   ConstEdgeWeightPropertyMap;
+
+        ConstIndexPropertyMap index_map = boost::get(boost::vertex_index, graph);
+        ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
+
+        SystemRegions::Adjacency retval(boost::num_vertices(graph));
+        typename boost::graph_traits<Graph>::vertex_iterator vertex_it, vertex_end;
+        for (std::tie(vertex_it, vertex_end) = boost::vertices(graph); vertex_it != vertex_end; ++vertex_it) {
+            auto& edges = retval[index_map[*vertex_it]];
+            typename boost::graph_traits<Graph>::out_edge_iterator edge_it, edge_end;
+            for (std::tie(edge_it, edge_end) = boost::out_edges(*vertex_it, graph); edge_it != edge_end; ++edge_it)
+                edges.push_back({static_cast<std::size_t>(index_map[boost::target(*edge_it, graph)]),
+                                 edge_weight_map[*edge_it]});
+        }
+        return retval;
+    }
+
+    /** Returns the shortest path between systems \a system1_id and
+      * \a system2_id from \a regions, in the same form as ShortestPathImpl.
+      * \throw std::out_of_range if either system isn't in the graph. */
+    std::pair<std::list<int>, double> RegionsShortestPath(
+        const SystemRegions& regions, int system1_id, int system2_id,
+        const boost::unordered_map<int, size_t>& id_to_graph_index,
+        const std::vector<int>& graph_index_to_id)
+    {
+        auto [indices, distance] = regions.ShortestPath(id_to_graph_index.at(system1_id),
+                                                        id_to_graph_index.at(system2_id));
+        std::pair<std::list<int>, double> retval{{}, distance};
+        for (auto index : indices)
+            retval.first.push_back(graph_index_to_id[index]);
+        return retval;
+    }
+
+    /** Per-thread buffers for ShortestPathImpl, kept between calls to avoid
+      * reallocating and reinitializing buffers sized to the whole graph. */
+    struct ShortestPathScratch {
+        /** Prepares for a search on a graph with \a num_vertices vertices. */
+        void Reset(size_t num_vertices) {
+            if (search_stamps.size() != num_vertices) {
+                distances.resize(num_vertices);
+                predecessors.resize(num_vertices);
+                search_stamps.assign(num_vertices, 0);
+                settled_stamps.assign(num_vertices, 0);
+                stamp = 0;
+            }
+            if (++stamp == 0) {
+                std::fill(search_stamps.begin(), search_stamps.end(), 0);
+                std::fill(settled_stamps.begin(), settled_stamps.end(), 0);
+                stamp = 1;
+            }
+            queue.clear();
+        }
+
+        [[nodiscard]] bool Reached(size_t ii) const { return search_stamps[ii] == stamp; }
+        [[nodiscard]] bool Settled(size_t ii) const { return settled_stamps[ii] == stamp; }
+
+        std::vector<double>                     distances;      ///< valid for vertices reached in the current search
+        std::vector<size_t>                     predecessors;   ///< valid for vertices reached in the current search
+        std::vector<uint32_t>                   search_stamps;  ///< equal to stamp for vertices reached in the current search
+        std::vector<uint32_t>                   settled_stamps; ///< equal to stamp for vertices settled in the current search
+        std::vector<std::pair<double, size_t>>  queue;          ///< min-heap of estimated path length through and vertex
+        uint32_t                                stamp = 0;
+    };
+
     /** Returns the path between vertices \a system1_id and \a system2_id of
       * \a graph that travels the shorest distance on starlanes, and the path
       * length.  If system1_id is the same vertex as system2_id, the path has
       * just that system in it, and the path lenth is 0.  If there is no path
       * between the two vertices, then the list is empty and the path length
-      * is -1.0 */
+      * is -1.0
+      *
+      * The search is A* guided by \a landmarks, which must have been found for
+      * \a graph or a supergraph of it, or plain Dijkstra if \a landmarks is
+      * null. */
     template <typename Graph>
     std::pair<std::list<int>, double> ShortestPathImpl(
         const Graph& graph, int system1_id, int system2_id,
-        double linear_distance, const boost::unordered_map<int, size_t>& id_to_graph_index)
+        double linear_distance, const boost::unordered_map<int, size_t>& id_to_graph_index,
+        const LandmarkDistances* landmarks)
     {
+        typedef typename Graph::out_edge_iterator OutEdgeIterator;
         typedef typename boost::property_map<Graph, vertex_system_id_t>::const_type     ConstSystemIDPropertyMap;
-        typedef typename boost::property_map<Graph, boost::vertex_index_t>::const_type  ConstIndexPropertyMap;
         typedef typename boost::property_map<Graph, boost::edge_weight_t>::const_type   ConstEdgeWeightPropertyMap;
 
         std::pair<std::list<int>, double> retval(std::list<int>(), -1.0);
@@ -333,54 +624,207 @@ namespace SystemPathing {
             return retval;
         }
 
-        /* initializing all vertices' predecessors to themselves prevents endless loops
-           when back traversing the tree in the case where one of the end systems is
-           system 0, because systems that are not connected to the root system (system2)
-           are not visited by the search, and so their predecessors are left unchanged.
-           Default initialization of the vector may be 0 or undefined which could lead
-           to out of bounds errors, or endless loops if a system's default predecessor
-           is 0 (debug mode), and 0's predecessor is that system */
-        std::vector<int> predecessors(boost::num_vertices(graph));
-        std::vector<double> distances(boost::num_vertices(graph));
-        for (unsigned int i = 0; i < boost::num_vertices(graph); ++i) {
-            predecessors[i] = i;
-            distances[i] = -1.0;
+        const size_t num_vertices = boost::num_vertices(graph);
+        if (landmarks && landmarks->distances.size() != num_vertices * landmarks->num_landmarks) {
+            ErrorLogger() << "ShortestPathImpl passed landmarks for a graph of a different size";
+            landmarks = nullptr;
         }
+        auto lower_bound = [landmarks, system2_index](size_t ii)
+        { return landmarks ? landmarks->LowerBound(ii, system2_index) : 0.0; };
 
+        if (lower_bound(system1_index) == LandmarkDistances::UNREACHABLE)
+            return retval;
 
-        ConstIndexPropertyMap index_map = boost::get(boost::vertex_index, graph);
         ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
 
+        thread_local ShortestPathScratch scratch;
+        scratch.Reset(num_vertices);
+        auto& queue = scratch.queue;
+        const auto queue_order = std::greater<std::pair<double, size_t>>();
 
-        // do the actual path finding using verbose boost magic...
-        try {
-            boost::dijkstra_shortest_paths(
-                graph, system1_index, &predecessors[0], &distances[0],
-                edge_weight_map, index_map, std::less<double>(), std::plus<double>(),
-                std::numeric_limits<int>::max(), 0,
-                boost::make_dijkstra_visitor(PathFindingShortCircuitingVisitor(system2_index)));
-        } catch (const PathFindingShortCircuitingVisitor::FoundDestination&) {
-            // catching this just means that the destination was found, and so
-            // the algorithm was exited early, via exception
+        scratch.search_stamps[system1_index] = scratch.stamp;
+        scratch.distances[system1_index] = 0.0;
+        scratch.predecessors[system1_index] = system1_index;
+        queue.emplace_back(lower_bound(system1_index), system1_index);
+
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), queue_order);
+            const size_t current = queue.back().second;
+            queue.pop_back();
+
+            // a vertex may have been queued several times as shorter paths to it were found
+            if (scratch.Settled(current))
+                continue;
+            scratch.settled_stamps[current] = scratch.stamp;
+            if (current == system2_index)
+                break;
+
+            const double current_distance = scratch.distances[current];
+            auto edges = boost::out_edges(current, graph);
+            for (OutEdgeIterator it = edges.first; it != edges.second; ++it) {
+                const size_t next = boost::target(*it, graph);
+                if (scratch.Settled(next))
+                    continue;
+                const double next_distance = current_distance + edge_weight_map[*it];
+                if (scratch.Reached(next) && scratch.distances[next] <= next_distance)
+                    continue;
+
+                const double next_bound = lower_bound(next);
+                if (next_bound == LandmarkDistances::UNREACHABLE)
+                    continue;
+
+                scratch.search_stamps[next] = scratch.stamp;
+                scratch.distances[next] = next_distance;
+                scratch.predecessors[next] = current;
+                queue.emplace_back(next_distance + next_bound, next);
+                std::push_heap(queue.begin(), queue.end(), queue_order);
+            }
         }
 
+        if (!scratch.Settled(system2_index))
+            return retval;  // there is no path between the specified nodes
 
-        int current_system = system2_index;
-        while (predecessors[current_system] != current_system) {
-            retval.first.push_front(sys_id_property_map[current_system]);
-            current_system = predecessors[current_system];
+        for (size_t current_system = system2_index; current_system != system1_index;
+             current_system = scratch.predecessors[current_system])
+        { retval.first.push_front(sys_id_property_map[current_system]); }
+        // add start system to path, as it wasn't added by traversing predecessors array
+        retval.first.push_front(sys_id_property_map[system1_index]);
+        retval.second = scratch.distances[system2_index];
+
+        return retval;
+    }
+
+    /** Returns the path between vertices \a system1_id and \a system2_id of
+      * \a graph that travels the shortest distance on starlanes that a fleet
+      * with \a fuel fuel and \a max_fuel maximum fuel can travel, and the
+      * path length.  Departing a system uses one unit of fuel, unless
+      * \a supplyable, indexed by graph index, is true for the system, in
+      * which case the fleet is first refuelled to \a max_fuel, as in
+      * Fleet::MovePath.  If there is no such path, then the list is empty and
+      * the path length is -1.0
+      *
+      * The search is over states that are pairs of a vertex and the whole
+      * units of fuel left there, guided by \a landmarks as in
+      * ShortestPathImpl. */
+    template <typename Graph>
+    std::pair<std::list<int>, double> FuelLimitedShortestPathImpl(
+        const Graph& graph, int system1_id, int system2_id, float fuel, float max_fuel,
+        const std::vector<bool>& supplyable, const boost::unordered_map<int, size_t>& id_to_graph_index,
+        const LandmarkDistances* landmarks)
+    {
+        typedef typename Graph::out_edge_iterator OutEdgeIterator;
+        typedef typename boost::property_map<Graph, vertex_system_id_t>::const_type     ConstSystemIDPropertyMap;
+        typedef typename boost::property_map<Graph, boost::edge_weight_t>::const_type   ConstEdgeWeightPropertyMap;
+
+        std::pair<std::list<int>, double> retval(std::list<int>(), -1.0);
+
+        ConstSystemIDPropertyMap sys_id_property_map = boost::get(vertex_system_id_t(), graph);
+
+        auto system1_it = id_to_graph_index.find(system1_id);
+        auto system2_it = id_to_graph_index.find(system2_id);
+        if (system1_it == id_to_graph_index.end() || system2_it == id_to_graph_index.end())
+            return retval;
+        const size_t system1_index = system1_it->second;
+        const size_t system2_index = system2_it->second;
+
+        if (system1_id == system2_id) {
+            retval.first.emplace_back(system2_id);
+            retval.second = 0.0;
+            return retval;
         }
-        retval.second = distances[system2_index];
 
-        if (retval.first.empty()) {
-            // there is no path between the specified nodes
-            retval.second = -1.0;
+        const size_t num_vertices = boost::num_vertices(graph);
+        if (supplyable.size() != num_vertices) {
+            ErrorLogger() << "FuelLimitedShortestPathImpl passed supply for a graph of a different size";
             return retval;
-        } else {
-            // add start system to path, as it wasn't added by traversing predecessors array
-            retval.first.push_front(sys_id_property_map[system1_index]);
+        }
+        if (landmarks && landmarks->distances.size() != num_vertices * landmarks->num_landmarks) {
+            ErrorLogger() << "FuelLimitedShortestPathImpl passed landmarks for a graph of a different size";
+            landmarks = nullptr;
+        }
+        auto lower_bound = [landmarks, system2_index](size_t ii)
+        { return landmarks ? landmarks->LowerBound(ii, system2_index) : 0.0; };
+
+        if (lower_bound(system1_index) == LandmarkDistances::UNREACHABLE)
+            return retval;
+
+        // more fuel than there are systems to jump to can never be used up
+        auto fuel_units = [num_vertices](float amount) {
+            return static_cast<size_t>(std::clamp(std::floor(amount), 0.0f,
+                                                  static_cast<float>(num_vertices)));
+        };
+        const size_t refuelled_units = fuel_units(max_fuel);
+        const size_t num_fuel_states = std::max(fuel_units(fuel), refuelled_units) + 1;
+        const size_t num_states = num_vertices * num_fuel_states;
+        auto state_of = [num_fuel_states](size_t vertex, size_t units) { return vertex * num_fuel_states + units; };
+
+        ConstEdgeWeightPropertyMap edge_weight_map = boost::get(boost::edge_weight, graph);
+
+        constexpr size_t NO_STATE = std::numeric_limits<size_t>::max();
+        std::vector<double> distances(num_states, std::numeric_limits<double>::infinity());
+        std::vector<size_t> predecessors(num_states, NO_STATE);
+        std::vector<bool> settled(num_states, false);
+        std::vector<std::pair<double, size_t>> queue;
+        const auto queue_order = std::greater<std::pair<double, size_t>>();
+
+        const size_t initial_state = state_of(system1_index, fuel_units(fuel));
+        distances[initial_state] = 0.0;
+        queue.emplace_back(lower_bound(system1_index), initial_state);
+
+        size_t final_state = NO_STATE;
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), queue_order);
+            const size_t current = queue.back().second;
+            queue.pop_back();
+
+            if (settled[current])
+                continue;
+            settled[current] = true;
+
+            const size_t current_vertex = current / num_fuel_states;
+            if (current_vertex == system2_index) {
+                final_state = current;
+                break;
+            }
+
+            // fuel left after departing the current system, if it can be departed
+            size_t departing_units = current % num_fuel_states;
+            if (supplyable[current_vertex])
+                departing_units = refuelled_units;
+            else if (departing_units >= 1)
+                --departing_units;
+            else
+                continue;
+
+            const double current_distance = distances[current];
+            auto edges = boost::out_edges(current_vertex, graph);
+            for (OutEdgeIterator it = edges.first; it != edges.second; ++it) {
+                const size_t next_vertex = boost::target(*it, graph);
+                const size_t next = state_of(next_vertex, departing_units);
+                if (settled[next])
+                    continue;
+                const double next_distance = current_distance + edge_weight_map[*it];
+                if (distances[next] <= next_distance)
+                    continue;
+
+                const double next_bound = lower_bound(next_vertex);
+                if (next_bound == LandmarkDistances::UNREACHABLE)
+                    continue;
+
+                distances[next] = next_distance;
+                predecessors[next] = current;
+                queue.emplace_back(next_distance + next_bound, next);
+                std::push_heap(queue.begin(), queue.end(), queue_order);
+            }
         }
 
+        if (final_state == NO_STATE)
+            return retval;  // there is no path the fleet has fuel for
+
+        for (size_t state = final_state; state != NO_STATE; state = predecessors[state])
+            retval.first.push_front(sys_id_property_map[state / num_fuel_states]);
+        retval.second = distances[final_state];
+
         return retval;
     }
 
@@ -493,27 +937,39 @@ namespace {
                                       vertex_property_t, edge_property_t> SystemGraph;
 
         struct EdgeVisibilityFilter {
+            /** pairs of ids of systems with lanes between them, lower id first */
+            typedef std::unordered_set<std::pair<int, int>, boost::hash<std::pair<int, int>>> EdgeSet;
+
             EdgeVisibilityFilter() = default;
 
             EdgeVisibilityFilter(const SystemGraph* graph, const ObjectMap& objects) :
-                m_graph(graph)
+                EdgeVisibilityFilter(graph, KnownEdges(objects))
+            {}
+
+            EdgeVisibilityFilter(const SystemGraph* graph, std::shared_ptr<const EdgeSet> known_edges) :
+                m_graph(graph),
+                edges(std::move(known_edges))
             {
                 if (!m_graph)
                     ErrorLogger() << "EdgeVisibilityFilter passed null graph pointer";
+            }
 
-                // record all edges in objects
+            /** Returns all edges in \a objects. */
+            static std::shared_ptr<const EdgeSet> KnownEdges(const ObjectMap& objects) {
+                auto retval = std::make_shared<EdgeSet>();
                 for (auto sys : objects.all<System>()) {
                     for (auto [lane_id, is_wormhole] : sys->StarlanesWormholes()) {
                         (void)is_wormhole; // quiet unused variable_warning
-                        edges.emplace(std::min(sys->ID(), lane_id), std::max(sys->ID(), lane_id));
+                        retval->emplace(std::min(sys->ID(), lane_id), std::max(sys->ID(), lane_id));
                     }
                 }
+                return retval;
             }
 
             template <typename EdgeDescriptor>
             bool operator()(const EdgeDescriptor& edge) const
             {
-                if (!m_graph)
+                if (!m_graph || !edges)
                     return false;
 
                 // get system ids from graph indices
@@ -524,12 +980,12 @@ namespace {
                 int sys_id_2 = sys_id_property_map[sys_graph_index_2];
 
                 // look up lane between systems
-                return edges.count({std::min(sys_id_1, sys_id_2), std::max(sys_id_1, sys_id_2)});
+                return edges->count({std::min(sys_id_1, sys_id_2), std::max(sys_id_1, sys_id_2)});
             }
 
         private:
-            const SystemGraph* m_graph = nullptr;
-            std::unordered_set<std::pair<int, int>, boost::hash<std::pair<int, int>>> edges;
+            const SystemGraph*              m_graph = nullptr;
+            std::shared_ptr<const EdgeSet>  edges;  ///< shared, as filtered graphs and their iterators copy their filter
         };
         typedef boost::filtered_graph<SystemGraph, EdgeVisibilityFilter> EmpireViewSystemGraph;
         typedef std::map<int, std::shared_ptr<EmpireViewSystemGraph>> EmpireViewSystemGraphMap;
@@ -637,6 +1093,14 @@ namespace {
         SystemGraph              system_graph;              ///< a graph in which the systems are vertices and the starlanes are edges
         EmpireViewSystemGraphMap empire_system_graph_views; ///< a map of empire IDs to the views of the system graph by those empires
         SystemPredicateGraphMap  system_pred_graph_views;   ///< Empire system graphs indexed by object predicate
+
+        std::shared_ptr<const LandmarkDistances>                system_graph_landmarks;             ///< for A* searches of system_graph or any of its views
+        std::map<int, std::shared_ptr<const LandmarkDistances>> empire_system_graph_view_landmarks; ///< for A* searches of empire_system_graph_views, indexed by empire ID
+
+        std::shared_ptr<const SystemRegions>                    system_graph_regions;               ///< null unless the galaxy is large enough to partition into regions
+        std::map<int, std::shared_ptr<const SystemRegions>>     empire_system_graph_view_regions;   ///< regions of empire_system_graph_views, with the same partition as system_graph_regions, indexed by empire ID
+
+        std::map<int, std::shared_ptr<const EdgeVisibilityFilter::EdgeSet>> empire_system_graph_view_edges; ///< edges known to each empire when its view was made, to reuse views when they haven't changed
     };
 }
 
@@ -658,6 +1122,9 @@ public:
     std::pair<std::list<int>, double> ShortestPath(
         int system1_id, int system2_id, int empire_id, const ObjectMap& objects,
         const EmpireManager& empires, const Pathfinder::SystemExclusionPredicateType& sys_pred) const;
+    std::pair<std::list<int>, double> FuelLimitedShortestPath(
+        int system1_id, int system2_id, int empire_id, float fuel, float max_fuel,
+        const std::set<int>& fleet_supplyable_system_ids) const;
     double ShortestPathDistance(int object1_id, int object2_id, const ObjectMap& objects) const;
     std::pair<std::list<int>, int> LeastJumpsPath(
         int system1_id, int system2_id, int empire_id = ALL_EMPIRES, int max_jumps = INT_MAX) const;
@@ -666,9 +1133,6 @@ public:
     std::multimap<double, int> ImmediateNeighbors(int system_id, int empire_id = ALL_EMPIRES) const;
 
     std::unordered_set<int> WithinJumps(size_t jumps, const std::vector<int>& candidates) const;
-    void WithinJumpsCacheHit(
-        std::unordered_set<int>* result, size_t jump_limit,
-        size_t ii, distance_matrix_storage<short>::row_ref row) const;
 
     std::pair<std::vector<std::shared_ptr<const UniverseObject>>, std::vector<std::shared_ptr<const UniverseObject>>>
     WithinJumpsOfOthers(
@@ -676,23 +1140,25 @@ public:
         const std::vector<std::shared_ptr<const UniverseObject>>& candidates,
         const std::vector<std::shared_ptr<const UniverseObject>>& stationary) const;
 
-    /** Return true if \p system_id is within \p jumps of any of \p others */
-    bool WithinJumpsOfOthers(
-        int jumps, int system_id, const ObjectMap& objects,
-        const std::vector<std::shared_ptr<const UniverseObject>>& others) const;
+    /** Returns the smallest number of jumps from the nearest of the systems
+        with graph indices \p source_indices to each system, indexed by graph
+        index, or SHRT_MAX for systems that can't be reached from any of them.
 
-    /** If any of \p others are within \p jumps of \p ii return true in \p answer.
-
-        The return value must be in a parameter so that after being bound to \p answer and \p jumps
-        the function signature is that required by the cache_hit_handler type.
-     */
-    void WithinJumpsOfOthersCacheHit(
-        bool& answer, int jumps, const ObjectMap& objects,
-        const std::vector<std::shared_ptr<const UniverseObject>>& others,
-        size_t ii, distance_matrix_storage<short>::row_ref row) const;
+        Found with a single breadth first search from all of the sources at
+        once, and cached until the system graph is next initialized, so that
+        conditions evaluated repeatedly for the same systems share it. */
+    std::shared_ptr<const std::vector<short>> JumpsFromNearest(std::vector<size_t> source_indices) const;
 
     int NearestSystemTo(double x, double y, const ObjectMap& objects) const;
 
+    const std::vector<int>& SystemGraphSystemIDs() const { return m_graph_index_to_system_id; }
+
+    int NumRegions() const;
+    int SystemRegion(int system_id) const;
+    std::vector<int> RegionSystemIDs(int region) const;
+
+    std::size_t DistanceCacheBytes() const;
+
     void InitializeSystemGraph(const ObjectMap& objects, const EmpireManager& empires);
 
     void UpdateEmpireVisibilityFilteredSystemGraphs(const EmpireManager& empires, const ObjectMap& objects);
@@ -707,6 +1173,13 @@ public:
     mutable distance_matrix_storage<short> m_system_jumps;             ///< indexed by system graph index (not system id), caches the smallest number of jumps to travel between all the systems
     std::shared_ptr<GraphImpl>             m_graph_impl;               ///< a graph in which the systems are vertices and the starlanes are edges
     boost::unordered_map<int, size_t>      m_system_id_to_graph_index;
+    std::vector<int>                       m_graph_index_to_system_id;
+    std::vector<int>                       m_system_graph_lanes;       ///< system ids, starlanes and options the system graph was initialized from
+    std::vector<double>                    m_system_graph_positions;   ///< positions of the systems the system graph was initialized from
+
+    using JumpsFromNearestCache = boost::unordered_map<std::vector<size_t>, std::shared_ptr<const std::vector<short>>>;
+    mutable JumpsFromNearestCache          m_jumps_from_nearest;       ///< indexed by sorted graph indices of source systems
+    mutable std::shared_mutex              m_jumps_from_nearest_mutex;
 };
 
 /////////////////////////////////////////////
@@ -732,7 +1205,7 @@ namespace {
     }
 }
 
-/** HandleCacheMiss requires that \p row be locked by exterior context. */
+/** HandleCacheMiss requires that \p row not be filled concurrently by any other thread. */
 void Pathfinder::PathfinderImpl::HandleCacheMiss(size_t ii, distance_matrix_storage<short>::row_ref row) const {
     typedef boost::iterator_property_map<std::vector<short>::iterator,
                                          boost::identity_property_map> DistancePropertyMap;
@@ -771,18 +1244,23 @@ double Pathfinder::PathfinderImpl::LinearDistance(int system1_id, int system2_id
     return std::sqrt(x_dist*x_dist + y_dist*y_dist);
 }
 
-short Pathfinder::JumpDistanceBetweenSystems(int system1_id, int system2_id) const
-{ return pimpl->JumpDistanceBetweenSystems(system1_id, system2_id); }
+short Pathfinder::JumpDistanceBetweenSystems(int system1_id, int system2_id) const {
+    CountJumpDistanceQuery();
+    return pimpl->JumpDistanceBetweenSystems(system1_id, system2_id);
+}
 
 short Pathfinder::PathfinderImpl::JumpDistanceBetweenSystems(int system1_id, int system2_id) const {
     if (system1_id == system2_id)
         return 0;
 
     try {
-        distance_matrix_cache< distance_matrix_storage<short>> cache(m_system_jumps);
-
         size_t system1_index = m_system_id_to_graph_index.at(system1_id);
         size_t system2_index = m_system_id_to_graph_index.at(system2_id);
+
+        if (const auto& regions = m_graph_impl->system_graph_regions)
+            return static_cast<short>(regions->Jumps(system1_index, system2_index));
+
+        distance_matrix_cache< distance_matrix_storage<short>> cache(m_system_jumps);
         size_t smaller_index = std::min(system1_index, system2_index);
         size_t other_index   = std::max(system1_index, system2_index);
 
@@ -951,8 +1429,10 @@ struct JumpDistanceSys1Visitor : public boost::static_visitor<int> {
     const GeneralizedLocationType& sys2_ids;
 };
 
-int Pathfinder::JumpDistanceBetweenObjects(int object1_id, int object2_id, const ObjectMap& objects) const
-{ return pimpl->JumpDistanceBetweenObjects(object1_id, object2_id, objects); }
+int Pathfinder::JumpDistanceBetweenObjects(int object1_id, int object2_id, const ObjectMap& objects) const {
+    CountJumpDistanceQuery();
+    return pimpl->JumpDistanceBetweenObjects(object1_id, object2_id, objects);
+}
 
 int Pathfinder::PathfinderImpl::JumpDistanceBetweenObjects(int object1_id, int object2_id,
                                                            const ObjectMap& objects) const
@@ -965,7 +1445,10 @@ int Pathfinder::PathfinderImpl::JumpDistanceBetweenObjects(int object1_id, int o
 
 std::pair<std::list<int>, double> Pathfinder::ShortestPath(
     int system1_id, int system2_id, int empire_id, const ObjectMap& objects) const
-{ return pimpl->ShortestPath(system1_id, system2_id, objects, empire_id); }
+{
+    QueryCounter counter(PathfinderQuery::SHORTEST_PATH);
+    return pimpl->ShortestPath(system1_id, system2_id, objects, empire_id);
+}
 
 std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::ShortestPath(
     int system1_id, int system2_id, const ObjectMap& objects, int empire_id) const
@@ -974,8 +1457,12 @@ std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::ShortestPath(
         // find path on full / complete system graph
         try {
             double linear_distance = LinearDistance(system1_id, system2_id, objects);
+            if (const auto& regions = m_graph_impl->system_graph_regions)
+                return RegionsShortestPath(*regions, system1_id, system2_id,
+                                           m_system_id_to_graph_index, m_graph_index_to_system_id);
             return ShortestPathImpl(m_graph_impl->system_graph, system1_id, system2_id,
-                                    linear_distance, m_system_id_to_graph_index);
+                                    linear_distance, m_system_id_to_graph_index,
+                                    m_graph_impl->system_graph_landmarks.get());
         } catch (const std::out_of_range&) {
             ErrorLogger() << "PathfinderImpl::ShortestPath passed invalid system id(s): "
                                    << system1_id << " & " << system2_id;
@@ -989,10 +1476,17 @@ std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::ShortestPath(
         ErrorLogger() << "PathfinderImpl::ShortestPath passed unknown empire id: " << empire_id;
         throw std::out_of_range("PathfinderImpl::ShortestPath passed unknown empire id");
     }
+    auto landmarks_it = m_graph_impl->empire_system_graph_view_landmarks.find(empire_id);
+    const auto* landmarks = landmarks_it != m_graph_impl->empire_system_graph_view_landmarks.end() ?
+        landmarks_it->second.get() : m_graph_impl->system_graph_landmarks.get();
+    auto regions_it = m_graph_impl->empire_system_graph_view_regions.find(empire_id);
     try {
         double linear_distance = LinearDistance(system1_id, system2_id, objects);
+        if (regions_it != m_graph_impl->empire_system_graph_view_regions.end())
+            return RegionsShortestPath(*regions_it->second, system1_id, system2_id,
+                                       m_system_id_to_graph_index, m_graph_index_to_system_id);
         return ShortestPathImpl(*graph_it->second, system1_id, system2_id,
-                                linear_distance, m_system_id_to_graph_index);
+                                linear_distance, m_system_id_to_graph_index, landmarks);
     } catch (const std::out_of_range&) {
         ErrorLogger() << "PathfinderImpl::ShortestPath passed invalid system id(s): "
                       << system1_id << " & " << system2_id;
@@ -1004,7 +1498,10 @@ std::pair<std::list<int>, double> Pathfinder::ShortestPath(
     int system1_id, int system2_id, int empire_id,
     const SystemExclusionPredicateType& system_predicate,
     const EmpireManager& empires, const ObjectMap& objects) const
-{ return pimpl->ShortestPath(system1_id, system2_id, empire_id, objects, empires, system_predicate); }
+{
+    QueryCounter counter(PathfinderQuery::SHORTEST_PATH);
+    return pimpl->ShortestPath(system1_id, system2_id, empire_id, objects, empires, system_predicate);
+}
 
 std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::ShortestPath(
     int system1_id, int system2_id, int empire_id, const ObjectMap& objects,
@@ -1031,17 +1528,58 @@ std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::ShortestPath(
     }
 
     try {
+        // predicate-filtered graphs are views of the whole system graph, so its landmarks work for them
         auto linear_distance = LinearDistance(system1_id, system2_id, objects);
         return ShortestPathImpl(*graph_it->second, system1_id, system2_id,
-                                linear_distance, m_system_id_to_graph_index);
+                                linear_distance, m_system_id_to_graph_index,
+                                m_graph_impl->system_graph_landmarks.get());
     } catch (const std::out_of_range&) {
         ErrorLogger() << "Invalid system id(s): " << system1_id << ", " << system2_id;
         throw;
     }
 }
 
-double Pathfinder::ShortestPathDistance(int object1_id, int object2_id, const ObjectMap& objects) const
-{ return pimpl->ShortestPathDistance(object1_id, object2_id, objects); }
+std::pair<std::list<int>, double> Pathfinder::FuelLimitedShortestPath(
+    int system1_id, int system2_id, int empire_id, float fuel, float max_fuel,
+    const std::set<int>& fleet_supplyable_system_ids) const
+{
+    QueryCounter counter(PathfinderQuery::FUEL_LIMITED_SHORTEST_PATH);
+    return pimpl->FuelLimitedShortestPath(system1_id, system2_id, empire_id, fuel, max_fuel, fleet_supplyable_system_ids);
+}
+
+std::pair<std::list<int>, double> Pathfinder::PathfinderImpl::FuelLimitedShortestPath(
+    int system1_id, int system2_id, int empire_id, float fuel, float max_fuel,
+    const std::set<int>& fleet_supplyable_system_ids) const
+{
+    // mark supplyable systems by graph index
+    std::vector<bool> supplyable(m_graph_index_to_system_id.size(), false);
+    for (int system_id : fleet_supplyable_system_ids) {
+        auto index_it = m_system_id_to_graph_index.find(system_id);
+        if (index_it != m_system_id_to_graph_index.end() && index_it->second < supplyable.size())
+            supplyable[index_it->second] = true;
+    }
+
+    if (empire_id == ALL_EMPIRES)
+        return FuelLimitedShortestPathImpl(m_graph_impl->system_graph, system1_id, system2_id,
+                                           fuel, max_fuel, supplyable, m_system_id_to_graph_index,
+                                           m_graph_impl->system_graph_landmarks.get());
+
+    auto graph_it = m_graph_impl->empire_system_graph_views.find(empire_id);
+    if (graph_it == m_graph_impl->empire_system_graph_views.end()) {
+        ErrorLogger() << "PathfinderImpl::FuelLimitedShortestPath passed unknown empire id: " << empire_id;
+        throw std::out_of_range("PathfinderImpl::FuelLimitedShortestPath passed unknown empire id");
+    }
+    auto landmarks_it = m_graph_impl->empire_system_graph_view_landmarks.find(empire_id);
+    const auto* landmarks = landmarks_it != m_graph_impl->empire_system_graph_view_landmarks.end() ?
+        landmarks_it->second.get() : m_graph_impl->system_graph_landmarks.get();
+    return FuelLimitedShortestPathImpl(*graph_it->second, system1_id, system2_id, fuel, max_fuel,
+                                       supplyable, m_system_id_to_graph_index, landmarks);
+}
+
+double Pathfinder::ShortestPathDistance(int object1_id, int object2_id, const ObjectMap& objects) const {
+    QueryCounter counter(PathfinderQuery::SHORTEST_PATH_DISTANCE);
+    return pimpl->ShortestPathDistance(object1_id, object2_id, objects);
+}
 
 double Pathfinder::PathfinderImpl::ShortestPathDistance(int object1_id, int object2_id,
                                                         const ObjectMap& objects) const
@@ -1096,7 +1634,10 @@ double Pathfinder::PathfinderImpl::ShortestPathDistance(int object1_id, int obje
 
 std::pair<std::list<int>, int> Pathfinder::LeastJumpsPath(
     int system1_id, int system2_id, int empire_id/* = ALL_EMPIRES*/, int max_jumps/* = INT_MAX*/) const
-{ return pimpl->LeastJumpsPath(system1_id, system2_id, empire_id, max_jumps); }
+{
+    QueryCounter counter(PathfinderQuery::LEAST_JUMPS_PATH);
+    return pimpl->LeastJumpsPath(system1_id, system2_id, empire_id, max_jumps);
+}
 
 std::pair<std::list<int>, int> Pathfinder::PathfinderImpl::LeastJumpsPath(
     int system1_id, int system2_id, int empire_id/* = ALL_EMPIRES*/, int max_jumps/* = INT_MAX*/) const
@@ -1170,131 +1711,85 @@ std::multimap<double, int> Pathfinder::PathfinderImpl::ImmediateNeighbors(
 }
 
 
-void Pathfinder::PathfinderImpl::WithinJumpsCacheHit(
-    std::unordered_set<int>* result, size_t jump_limit,
-    size_t ii, distance_matrix_storage<short>::row_ref row) const
-{
-    // Scan the LUT of system ids and add any result from the row within
-    // the neighborhood range to the results.
-    for (auto system_id_and_ii : m_system_id_to_graph_index) {
-        size_t hops = row[system_id_and_ii.second];
-        if (hops <= jump_limit)
-            result->insert(system_id_and_ii.first);
-    }
+namespace {
+    // each cached result has an entry per system, so this bounds the memory
+    // used to a few MB for the largest galaxies
+    constexpr size_t MAX_CACHED_JUMPS_FROM_NEAREST = 1024;
 }
 
-std::unordered_set<int> Pathfinder::WithinJumps(size_t jumps, const std::vector<int>& candidates) const
-{ return pimpl->WithinJumps(jumps, candidates); }
+std::unordered_set<int> Pathfinder::WithinJumps(size_t jumps, const std::vector<int>& candidates) const {
+    QueryCounter counter(PathfinderQuery::WITHIN_JUMPS);
+    return pimpl->WithinJumps(jumps, candidates);
+}
 
 std::unordered_set<int> Pathfinder::PathfinderImpl::WithinJumps(
     size_t jumps, const std::vector<int>& candidates) const
 {
-    std::unordered_set<int> near;
-    distance_matrix_cache< distance_matrix_storage<short>> cache(m_system_jumps);
+    std::vector<size_t> candidate_indices;
+    candidate_indices.reserve(candidates.size());
     for (auto candidate : candidates) {
-        size_t system_index;
-        try {
-            system_index = m_system_id_to_graph_index.at(candidate);
-        } catch (const std::out_of_range& e) {
+        auto it = m_system_id_to_graph_index.find(candidate);
+        if (it == m_system_id_to_graph_index.end()) {
             ErrorLogger() << "Passed invalid system id: " << candidate;
             continue;
         }
+        candidate_indices.push_back(it->second);
+    }
 
-        near.insert(candidate);
-        if (jumps == 0)
-            continue;
-
-        namespace ph = boost::placeholders;
+    std::unordered_set<int> near;
+    if (candidate_indices.empty())
+        return near;
 
-        cache.examine_row(system_index,
-                          boost::bind(&Pathfinder::PathfinderImpl::HandleCacheMiss, this, ph::_1, ph::_2),
-                          boost::bind(&Pathfinder::PathfinderImpl::WithinJumpsCacheHit, this,
-                                      &near, jumps, ph::_1, ph::_2));
+    const auto jumps_from_candidates = JumpsFromNearest(std::move(candidate_indices));
+    for (auto& [system_id, system_index] : m_system_id_to_graph_index) {
+        if (static_cast<size_t>((*jumps_from_candidates)[system_index]) <= jumps)
+            near.insert(system_id);
     }
     return near;
 }
 
+std::shared_ptr<const std::vector<short>> Pathfinder::PathfinderImpl::JumpsFromNearest(
+    std::vector<size_t> source_indices) const
+{
+    std::sort(source_indices.begin(), source_indices.end());
+    source_indices.erase(std::unique(source_indices.begin(), source_indices.end()), source_indices.end());
 
-/** Examine a single universe object and determine if it is within jumps
-    of any object in others.*/
-struct WithinJumpsOfOthersObjectVisitor : public boost::static_visitor<bool> {
-    WithinJumpsOfOthersObjectVisitor(const Pathfinder::PathfinderImpl& _pf,
-                                     int _jumps,
-                                     const ObjectMap& _objects,
-                                     const std::vector<std::shared_ptr<const UniverseObject>>& _others) :
-        pf(_pf),
-        jumps(_jumps),
-        objects(_objects),
-        others(_others)
-    {}
-
-    bool operator()(std::nullptr_t) const { return false; }
-    bool operator()(int sys_id) const {
-        bool retval = pf.WithinJumpsOfOthers(jumps, sys_id, objects, others);
-        return retval;
-    }
-    bool operator()(std::pair<int, int> prev_next) const {
-        return pf.WithinJumpsOfOthers(jumps, prev_next.first, objects, others)
-            || pf.WithinJumpsOfOthers(jumps, prev_next.second, objects, others);
+    {
+        std::shared_lock lock(m_jumps_from_nearest_mutex);
+        auto it = m_jumps_from_nearest.find(source_indices);
+        if (it != m_jumps_from_nearest.end())
+            return it->second;
     }
-    const Pathfinder::PathfinderImpl& pf;
-    int jumps;
-    const ObjectMap& objects;
-    const std::vector<std::shared_ptr<const UniverseObject>>& others;
-};
-
-/** Examine a single other in the cache to see if any of its locations
-    are within jumps*/
-struct WithinJumpsOfOthersOtherVisitor : public boost::static_visitor<bool> {
-    WithinJumpsOfOthersOtherVisitor(const Pathfinder::PathfinderImpl& _pf,
-                                    int _jumps,
-                                    distance_matrix_storage<short>::row_ref _row) :
-        pf(_pf), jumps(_jumps), row(_row)
-    {}
 
-    bool single_result(int other_id) const {
-        int index;
-        try {
-            index = pf.m_system_id_to_graph_index.at(other_id);
-        } catch (const std::out_of_range& e) {
-            ErrorLogger() << "Passed invalid system id: " << other_id;
-            return false;
-        }
-        bool retval = (row[index] <= jumps);
-        return retval;
-    }
+    const auto& graph = m_graph_impl->system_graph;
+    auto jumps = std::make_shared<std::vector<short>>(boost::num_vertices(graph), SHRT_MAX);
 
-    bool operator()(std::nullptr_t) const { return false; }
-    bool operator()(int sys_id) const {
-        return single_result(sys_id);
-    }
-    bool operator()(std::pair<int, int> prev_next) const {
-        return single_result(prev_next.first)
-            || single_result(prev_next.second);
+    // breadth first search outwards from all sources at once, so that each
+    // system is reached first from whichever source is nearest to it
+    std::vector<size_t> frontier, next_frontier;
+    for (auto source_index : source_indices) {
+        (*jumps)[source_index] = 0;
+        frontier.push_back(source_index);
     }
-    const Pathfinder::PathfinderImpl& pf;
-    int jumps;
-    distance_matrix_storage<short>::row_ref row;
-};
-
-
-void Pathfinder::PathfinderImpl::WithinJumpsOfOthersCacheHit(
-    bool& answer, int jumps,
-    const ObjectMap& objects,
-    const std::vector<std::shared_ptr<const UniverseObject>>& others,
-    size_t ii, distance_matrix_storage<short>::row_ref row) const
-{
-    // Check if any of the others are within jumps of candidate, by looping
-    // through all of the others and applying the WithinJumpsOfOthersOtherVisitor.
-    answer = false;
-    for (const auto& other : others) {
-        WithinJumpsOfOthersOtherVisitor check_if_location_is_within_jumps(*this, jumps, row);
-        GeneralizedLocationType location = GeneralizedLocation(other, objects);
-        if (boost::apply_visitor(check_if_location_is_within_jumps, location)) {
-            answer = true;
-            return;
+    for (short depth = 1; !frontier.empty() && depth < SHRT_MAX; ++depth) {
+        next_frontier.clear();
+        for (auto system_index : frontier) {
+            auto [adj_it, adj_end] = boost::adjacent_vertices(system_index, graph);
+            for (; adj_it != adj_end; ++adj_it) {
+                auto& adj_jumps = (*jumps)[*adj_it];
+                if (adj_jumps != SHRT_MAX)
+                    continue;
+                adj_jumps = depth;
+                next_frontier.push_back(*adj_it);
+            }
         }
+        frontier.swap(next_frontier);
     }
+
+    std::unique_lock lock(m_jumps_from_nearest_mutex);
+    if (m_jumps_from_nearest.size() >= MAX_CACHED_JUMPS_FROM_NEAREST)
+        m_jumps_from_nearest.clear();
+    return m_jumps_from_nearest.emplace(std::move(source_indices), std::move(jumps)).first->second;
 }
 
 std::pair<std::vector<std::shared_ptr<const UniverseObject>>,
@@ -1304,9 +1799,38 @@ Pathfinder::WithinJumpsOfOthers(
     const std::vector<std::shared_ptr<const UniverseObject>>& candidates,
     const std::vector<std::shared_ptr<const UniverseObject>>& stationary) const
 {
+    QueryCounter counter(PathfinderQuery::WITHIN_JUMPS_OF_OTHERS);
     return pimpl->WithinJumpsOfOthers(jumps, objects, candidates, stationary);
 }
 
+/** Adds the system graph indices of the systems at a generalized location,
+    which is one system, or both ends of the lane that a fleet is on. */
+struct GeneralizedLocationIndicesVisitor : public boost::static_visitor<> {
+    GeneralizedLocationIndicesVisitor(const boost::unordered_map<int, size_t>& _system_id_to_graph_index,
+                                      std::vector<size_t>& _indices) :
+        system_id_to_graph_index(_system_id_to_graph_index),
+        indices(_indices)
+    {}
+
+    void single_result(int sys_id) const {
+        auto it = system_id_to_graph_index.find(sys_id);
+        if (it == system_id_to_graph_index.end()) {
+            ErrorLogger() << "Passed invalid system id: " << sys_id;
+            return;
+        }
+        indices.push_back(it->second);
+    }
+
+    void operator()(std::nullptr_t) const {}
+    void operator()(int sys_id) const { single_result(sys_id); }
+    void operator()(std::pair<int, int> prev_next) const {
+        single_result(prev_next.first);
+        single_result(prev_next.second);
+    }
+    const boost::unordered_map<int, size_t>& system_id_to_graph_index;
+    std::vector<size_t>& indices;
+};
+
 std::pair<std::vector<std::shared_ptr<const UniverseObject>>,
           std::vector<std::shared_ptr<const UniverseObject>>>
 Pathfinder::PathfinderImpl::WithinJumpsOfOthers(
@@ -1314,21 +1838,43 @@ Pathfinder::PathfinderImpl::WithinJumpsOfOthers(
     const std::vector<std::shared_ptr<const UniverseObject>>& candidates,
     const std::vector<std::shared_ptr<const UniverseObject>>& stationary) const
 {
-    // Examine each candidate and copy those within jumps of the
-    // others into near and the rest into far.
-    WithinJumpsOfOthersObjectVisitor visitor(*this, jumps, objects, stationary);
-
     std::pair<std::vector<std::shared_ptr<const UniverseObject>>,
               std::vector<std::shared_ptr<const UniverseObject>>> retval;
     auto& near = retval.first;
     auto& far = retval.second;
+
+    // find the systems at which the stationary objects are, and from them the
+    // jumps to every system from the nearest of them
+    std::vector<size_t> stationary_indices;
+    stationary_indices.reserve(stationary.size());
+    GeneralizedLocationIndicesVisitor add_stationary_indices(m_system_id_to_graph_index, stationary_indices);
+    for (const auto& obj : stationary) {
+        GeneralizedLocationType location = GeneralizedLocation(obj, objects);
+        boost::apply_visitor(add_stationary_indices, location);
+    }
+
+    if (stationary_indices.empty() || jumps < 0) {
+        far = candidates;
+        return retval;
+    }
+
+    const auto jumps_from_stationary = JumpsFromNearest(std::move(stationary_indices));
+
+    // Examine each candidate and copy those within jumps of the
+    // others into near and the rest into far.
     near.reserve(candidates.size());
     far.reserve(candidates.size());
+    std::vector<size_t> candidate_indices;
+    GeneralizedLocationIndicesVisitor add_candidate_indices(m_system_id_to_graph_index, candidate_indices);
 
     for (const auto& candidate : candidates) {
+        candidate_indices.clear();
         GeneralizedLocationType candidate_systems = GeneralizedLocation(candidate, objects);
-        bool is_near = boost::apply_visitor(visitor, candidate_systems);
+        boost::apply_visitor(add_candidate_indices, candidate_systems);
 
+        bool is_near = std::any_of(candidate_indices.begin(), candidate_indices.end(),
+                                   [&jumps_from_stationary, jumps](size_t idx)
+                                   { return (*jumps_from_stationary)[idx] <= jumps; });
         if (is_near)
             near.emplace_back(candidate);
         else
@@ -1338,36 +1884,100 @@ Pathfinder::PathfinderImpl::WithinJumpsOfOthers(
     return retval; // was: {near, far}; //, wherever you are...
 }
 
-bool Pathfinder::PathfinderImpl::WithinJumpsOfOthers(
-    int jumps, int system_id,
-    const ObjectMap& objects,
-    const std::vector<std::shared_ptr<const UniverseObject>>& others) const
-{
-    if (others.empty())
-        return false;
+int Pathfinder::NearestSystemTo(double x, double y, const ObjectMap& objects) const
+{ return pimpl->NearestSystemTo(x, y, objects); }
 
-    size_t system_index;
-    try {
-        system_index = m_system_id_to_graph_index.at(system_id);
-    } catch (const std::out_of_range& e) {
-        ErrorLogger() << "Passed invalid system id: " << system_id;
-        return false;
+const std::vector<int>& Pathfinder::SystemGraphSystemIDs() const
+{ return pimpl->SystemGraphSystemIDs(); }
+
+int Pathfinder::NumRegions() const
+{ return pimpl->NumRegions(); }
+
+int Pathfinder::SystemRegion(int system_id) const
+{ return pimpl->SystemRegion(system_id); }
+
+std::vector<int> Pathfinder::RegionSystemIDs(int region) const
+{ return pimpl->RegionSystemIDs(region); }
+
+PathfinderStatistics PathfinderStatistics::operator-(const PathfinderStatistics& rhs) const {
+    PathfinderStatistics retval = *this;
+    for (std::size_t query = 0; query < queries.size(); ++query) {
+        retval.queries[query].count -= rhs.queries[query].count;
+        retval.queries[query].nanoseconds -= rhs.queries[query].nanoseconds;
     }
+    retval.cache_hits -= rhs.cache_hits;
+    retval.cache_misses -= rhs.cache_misses;
+    retval.rows_computed -= rhs.rows_computed;
+    retval.row_nanoseconds -= rhs.row_nanoseconds;
+    return retval;
+}
+
+std::string PathfinderStatistics::Dump() const {
+    const auto ms = [](std::uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+
+    std::stringstream ss;
+    ss << "Pathfinding queries by " << caller << " (count, total ms):";
+    for (std::size_t query = 0; query < queries.size(); ++query)
+        if (queries[query].count)
+            ss << "\n  " << static_cast<PathfinderQuery>(query) << "  " << queries[query].count
+               << "  " << ms(queries[query].nanoseconds);
+
+    const auto lookups = cache_hits + cache_misses;
+    ss << "\n  distance cache hits " << cache_hits << " misses " << cache_misses;
+    if (lookups)
+        ss << " (" << 100.0 * static_cast<double>(cache_hits) / static_cast<double>(lookups) << "% hits)";
+    ss << "  rows computed " << rows_computed << " in " << ms(row_nanoseconds) << " ms";
+    return ss.str();
+}
+
+PathfinderStatistics GetPathfinderStatistics()
+{ return PathfinderCounters::Get().Total(); }
 
-    namespace ph = boost::placeholders;
+void SetPathfinderCaller(PathfinderCaller caller)
+{ PathfinderCounters::Get().SetCaller(caller); }
 
-    // Examine the cache to see if \p system_id is within \p jumps of \p others
-    bool within_jumps(false);
-    distance_matrix_cache<distance_matrix_storage<short>> cache(m_system_jumps);
-    cache.examine_row(system_index,
-                      boost::bind(&Pathfinder::PathfinderImpl::HandleCacheMiss, this, ph::_1, ph::_2),
-                      boost::bind(&Pathfinder::PathfinderImpl::WithinJumpsOfOthersCacheHit, this,
-                                  std::ref(within_jumps), jumps, std::ref(objects), std::ref(others), ph::_1, ph::_2));
-    return within_jumps;
+std::size_t Pathfinder::DistanceCacheBytes() const
+{ return pimpl->DistanceCacheBytes(); }
+
+std::size_t Pathfinder::PathfinderImpl::DistanceCacheBytes() const {
+    std::size_t retval = m_system_jumps.heap_bytes();
+
+    std::shared_lock lock(m_jumps_from_nearest_mutex);
+    retval += m_jumps_from_nearest.bucket_count() * sizeof(void*);
+    for (const auto& [source_indices, jumps] : m_jumps_from_nearest) {
+        retval += sizeof(JumpsFromNearestCache::value_type) + 2 * sizeof(void*) +
+            source_indices.capacity() * sizeof(size_t);
+        if (jumps)
+            retval += sizeof(*jumps) + jumps->capacity() * sizeof(short);
+    }
+    return retval;
 }
 
-int Pathfinder::NearestSystemTo(double x, double y, const ObjectMap& objects) const
-{ return pimpl->NearestSystemTo(x, y, objects); }
+int Pathfinder::PathfinderImpl::NumRegions() const {
+    const auto& regions = m_graph_impl->system_graph_regions;
+    return regions ? static_cast<int>(regions->NumRegions()) : 0;
+}
+
+int Pathfinder::PathfinderImpl::SystemRegion(int system_id) const {
+    const auto& regions = m_graph_impl->system_graph_regions;
+    auto index_it = m_system_id_to_graph_index.find(system_id);
+    if (!regions || index_it == m_system_id_to_graph_index.end())
+        return -1;
+    auto region = regions->RegionOf(index_it->second);
+    return region == SystemRegions::NO_REGION ? -1 : static_cast<int>(region);
+}
+
+std::vector<int> Pathfinder::PathfinderImpl::RegionSystemIDs(int region) const {
+    std::vector<int> retval;
+    const auto& regions = m_graph_impl->system_graph_regions;
+    if (!regions || region < 0)
+        return retval;
+    const auto& indices = regions->RegionVertices(static_cast<size_t>(region));
+    retval.reserve(indices.size());
+    for (auto index : indices)
+        retval.push_back(m_graph_index_to_system_id[index]);
+    return retval;
+}
 
 int Pathfinder::PathfinderImpl::NearestSystemTo(double x, double y, const ObjectMap& objects) const {
     double min_dist2 = std::numeric_limits<double>::max();
@@ -1392,6 +2002,34 @@ void Pathfinder::InitializeSystemGraph(const ObjectMap& objects, const EmpireMan
 { return pimpl->InitializeSystemGraph(objects, empires); }
 
 void Pathfinder::PathfinderImpl::InitializeSystemGraph(const ObjectMap& objects, const EmpireManager& empires) {
+    // the graph and everything derived from it depend only on the systems,
+    // their positions and starlanes, and options, so keep them (and filtered
+    // views of them) if none of those changed, as after most turn updates
+    const auto regions_min_systems = GetOptionsDB().Get<int>("pathfinder.regions.min-systems");
+    const auto precompute_max_systems = GetOptionsDB().Get<int>("pathfinder.jumps.precompute.max-systems");
+    std::vector<int> lanes{regions_min_systems, precompute_max_systems};
+    std::vector<double> positions;
+    positions.reserve(objects.ExistingSystems().size() * 2);
+    for (auto& [sys_id, obj] : objects.ExistingSystems()) {
+        auto sys = objects.get<System>(sys_id);
+        if (!sys)
+            continue;
+        lanes.push_back(sys_id);
+        lanes.push_back(static_cast<int>(sys->StarlanesWormholes().size()));
+        for (const auto& [lane_dest_id, is_wormhole] : sys->StarlanesWormholes()) {
+            lanes.push_back(lane_dest_id);
+            lanes.push_back(is_wormhole);
+        }
+        positions.push_back(sys->X());
+        positions.push_back(sys->Y());
+    }
+    if (m_graph_impl && lanes == m_system_graph_lanes && positions == m_system_graph_positions) {
+        TraceLogger() << "Pathfinder::InitializeSystemGraph keeping unchanged graph of " << m_graph_index_to_system_id.size() << " systems";
+        return;
+    }
+    m_system_graph_lanes = std::move(lanes);
+    m_system_graph_positions = std::move(positions);
+
     auto new_graph_impl = std::make_shared<GraphImpl>();
 
     GraphImpl::SystemIDPropertyMap sys_id_property_map =
@@ -1449,10 +2087,39 @@ void Pathfinder::PathfinderImpl::InitializeSystemGraph(const ObjectMap& objects,
         }
     }
 
+    new_graph_impl->system_graph_landmarks = std::make_shared<LandmarkDistances>(
+        FindLandmarkDistances(new_graph_impl->system_graph));
+
+    // for large enough galaxies, partition the systems into regions, so that
+    // paths between distant systems can be looked up instead of searched for.
+    // regions of about N^(2/3) systems keep the table of distances between
+    // region border systems to about the same size as the graph squared
+    if (regions_min_systems > 0 && system_ids.size() >= static_cast<size_t>(regions_min_systems)) {
+        ScopedTimer timer("Pathfinder regions for " + std::to_string(system_ids.size()) + " systems", true);
+        const auto region_size = std::max<size_t>(16, static_cast<size_t>(
+            std::pow(static_cast<double>(system_ids.size()), 2.0 / 3.0)));
+        new_graph_impl->system_graph_regions = std::make_shared<const SystemRegions>(
+            AdjacencyOf(new_graph_impl->system_graph), region_size);
+        DebugLogger() << "Pathfinder partitioned " << system_ids.size() << " systems into "
+                      << new_graph_impl->system_graph_regions->NumRegions() << " regions with "
+                      << new_graph_impl->system_graph_regions->NumBorderVertices() << " border systems";
+    }
+
     new_graph_impl.swap(m_graph_impl);
-    // clear jumps distance cache
+    m_graph_index_to_system_id = system_ids;
+    // clear jumps distance caches
+    m_jumps_from_nearest.clear();
     // NOTE: re-filling the cache is O(#vertices * (#vertices + #edges)) in the worst case!
     m_system_jumps.resize(system_ids.size());
+
+    // for small enough galaxies, fill the whole cache now, in parallel, rather
+    // than a row at a time as rows are first needed
+    if (!system_ids.empty() && system_ids.size() <= static_cast<size_t>(precompute_max_systems)) {
+        ScopedTimer timer("Pathfinder precompute jumps for " + std::to_string(system_ids.size()) + " systems", true);
+        namespace ph = boost::placeholders;
+        distance_matrix_cache<distance_matrix_storage<short>> cache(m_system_jumps);
+        cache.fill_all(boost::bind(&Pathfinder::PathfinderImpl::HandleCacheMiss, this, ph::_1, ph::_2));
+    }
 }
 
 void Pathfinder::UpdateEmpireVisibilityFilteredSystemGraphs(const EmpireManager& empires, const ObjectMap& objects)
@@ -1465,27 +2132,77 @@ void Pathfinder::UpdateEmpireVisibilityFilteredSystemGraphs(const EmpireManager&
 void Pathfinder::PathfinderImpl::UpdateEmpireVisibilityFilteredSystemGraphs(
     const EmpireManager& empires, const ObjectMap& objects)
 {
+    auto old_views = std::move(m_graph_impl->empire_system_graph_views);
+    auto old_landmarks = std::move(m_graph_impl->empire_system_graph_view_landmarks);
+    auto old_regions = std::move(m_graph_impl->empire_system_graph_view_regions);
+    auto old_edges = std::move(m_graph_impl->empire_system_graph_view_edges);
     m_graph_impl->empire_system_graph_views.clear();
     m_graph_impl->system_pred_graph_views.clear();
+    m_graph_impl->empire_system_graph_view_landmarks.clear();
+    m_graph_impl->empire_system_graph_view_regions.clear();
+    m_graph_impl->empire_system_graph_view_edges.clear();
 
     // empires all use the same filtered graph
-    GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, objects);
-    auto filtered_graph_ptr = std::make_shared<GraphImpl::EmpireViewSystemGraph>(
-        m_graph_impl->system_graph, filter);
+    auto edges = GraphImpl::EdgeVisibilityFilter::KnownEdges(objects);
+
+    // reuse a previous view with the same edges, if there is one
+    std::shared_ptr<GraphImpl::EmpireViewSystemGraph> filtered_graph_ptr;
+    std::shared_ptr<const LandmarkDistances> landmarks;
+    std::shared_ptr<const SystemRegions> regions;
+    if (!old_views.empty()) {
+        const auto& [old_empire_id, old_graph_ptr] = *old_views.begin();
+        auto old_edges_it = old_edges.find(old_empire_id);
+        if (old_edges_it != old_edges.end() && *old_edges_it->second == *edges) {
+            filtered_graph_ptr = old_graph_ptr;
+            edges = old_edges_it->second;
+            landmarks = old_landmarks[old_empire_id];
+            regions = old_regions[old_empire_id];
+        }
+    }
+
+    if (!filtered_graph_ptr) {
+        GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, edges);
+        filtered_graph_ptr = std::make_shared<GraphImpl::EmpireViewSystemGraph>(
+            m_graph_impl->system_graph, filter);
+        landmarks = std::make_shared<const LandmarkDistances>(FindLandmarkDistances(*filtered_graph_ptr));
+        if (const auto& full_regions = m_graph_impl->system_graph_regions)
+            regions = std::make_shared<const SystemRegions>(AdjacencyOf(*filtered_graph_ptr), *full_regions);
+    }
 
     for (auto const& empire : empires) {
         int empire_id = empire.first;
         m_graph_impl->empire_system_graph_views[empire_id] = filtered_graph_ptr;
+        m_graph_impl->empire_system_graph_view_landmarks[empire_id] = landmarks;
+        m_graph_impl->empire_system_graph_view_edges[empire_id] = edges;
+        if (regions)
+            m_graph_impl->empire_system_graph_view_regions[empire_id] = regions;
     }
 }
 
 void Pathfinder::PathfinderImpl::UpdateEmpireVisibilityFilteredSystemGraphs(
     const EmpireManager& empires, const Universe::EmpireObjectMap& empire_object_maps)
 {
+    auto old_views = std::move(m_graph_impl->empire_system_graph_views);
+    auto old_landmarks = std::move(m_graph_impl->empire_system_graph_view_landmarks);
+    auto old_regions = std::move(m_graph_impl->empire_system_graph_view_regions);
+    auto old_edges = std::move(m_graph_impl->empire_system_graph_view_edges);
     m_graph_impl->empire_system_graph_views.clear();
     m_graph_impl->system_pred_graph_views.clear();
+    m_graph_impl->empire_system_graph_view_landmarks.clear();
+    m_graph_impl->empire_system_graph_view_regions.clear();
+    m_graph_impl->empire_system_graph_view_edges.clear();
 
     // each empire has its own filtered graph
+    struct EmpireView {
+        int                                                     empire_id = ALL_EMPIRES;
+        const ObjectMap*                                        objects = nullptr;
+        std::shared_ptr<const GraphImpl::EdgeVisibilityFilter::EdgeSet> edges;
+        std::shared_ptr<GraphImpl::EmpireViewSystemGraph>       graph;
+        std::shared_ptr<const LandmarkDistances>                landmarks;
+        std::shared_ptr<const SystemRegions>                    regions;
+    };
+    std::vector<EmpireView> empire_views;
+    empire_views.reserve(empires.NumEmpires());
     for (auto& empire_entry : empires) {
         int empire_id = empire_entry.first;
         auto map_it = empire_object_maps.find(empire_id);
@@ -1493,10 +2210,51 @@ void Pathfinder::PathfinderImpl::UpdateEmpireVisibilityFilteredSystemGraphs(
             ErrorLogger() << "UpdateEmpireVisibilityFilteredSystemGraphs can't find object map for empire with id " << empire_id;
             continue;
         }
-        const auto& empire_objects = map_it->second;
-        GraphImpl::EdgeVisibilityFilter filter(&m_graph_impl->system_graph, empire_objects);
-        auto filtered_graph_ptr = std::make_shared<GraphImpl::EmpireViewSystemGraph>(
-            m_graph_impl->system_graph, filter);
-        m_graph_impl->empire_system_graph_views[empire_id] = std::move(filtered_graph_ptr);
+        auto& view = empire_views.emplace_back();
+        view.empire_id = empire_id;
+        view.objects = &map_it->second;
+    }
+
+    // in parallel, find the edges each empire knows of, and if they have
+    // changed since its view was last made, make a new view and find its
+    // landmarks, and regions if the whole graph has them, as each takes a few
+    // searches of the whole graph
+    const auto& system_graph = m_graph_impl->system_graph;
+    const SystemRegions* full_regions = m_graph_impl->system_graph_regions.get();
+    TaskBatch batch("Pathfinder::UpdateEmpireVisibilityFilteredSystemGraphs");
+    for (auto& view : empire_views) {
+        auto old_edges_it = old_edges.find(view.empire_id);
+        auto old_view_it = old_views.find(view.empire_id);
+        const GraphImpl::EdgeVisibilityFilter::EdgeSet* previous_edges =
+            (old_edges_it != old_edges.end() && old_view_it != old_views.end()) ? old_edges_it->second.get() : nullptr;
+
+        batch.Post([&view, &system_graph, full_regions, previous_edges]() {
+            view.edges = GraphImpl::EdgeVisibilityFilter::KnownEdges(*view.objects);
+            if (previous_edges && *previous_edges == *view.edges)
+                return; // unchanged, so reuse the previous view
+
+            GraphImpl::EdgeVisibilityFilter filter(&system_graph, view.edges);
+            view.graph = std::make_shared<GraphImpl::EmpireViewSystemGraph>(system_graph, filter);
+            view.landmarks = std::make_shared<const LandmarkDistances>(FindLandmarkDistances(*view.graph));
+            if (full_regions)
+                view.regions = std::make_shared<const SystemRegions>(AdjacencyOf(*view.graph), *full_regions);
+        });
+    }
+    batch.Wait();
+
+    for (auto& view : empire_views) {
+        const int empire_id = view.empire_id;
+        if (!view.graph) {
+            view.graph = std::move(old_views[empire_id]);
+            view.edges = std::move(old_edges[empire_id]);
+            view.landmarks = std::move(old_landmarks[empire_id]);
+            view.regions = std::move(old_regions[empire_id]);
+        }
+        m_graph_impl->empire_system_graph_views.emplace(empire_id, std::move(view.graph));
+        m_graph_impl->empire_system_graph_view_edges.emplace(empire_id, std::move(view.edges));
+        if (view.landmarks)
+            m_graph_impl->empire_system_graph_view_landmarks.emplace(empire_id, std::move(view.landmarks));
+        if (view.regions)
+            m_graph_impl->empire_system_graph_view_regions.emplace(empire_id, std::move(view.regions));
     }
 }
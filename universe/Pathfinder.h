@@ -2,11 +2,15 @@
 #define _Pathfinder_h_
 
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <set>
+#include <string>
 #include <unordered_set>
 #include <vector>
 #include "UniverseObject.h"
+#include "../util/Enum.h"
 
 class ObjectMap;
 class EmpireManager;
@@ -71,6 +75,21 @@ public:
                                                    const SystemExclusionPredicateType& system_predicate,
                                                    const EmpireManager& empires, const ObjectMap& objects) const;
 
+    /** Returns the sequence of systems, including \a system1_id and
+      * \a system2_id, that defines the shortest path known to empire
+      * \a empire_id from \a system1_id to \a system2_id that a fleet with
+      * \a fuel fuel and \a max_fuel maximum fuel can travel, and the distance
+      * travelled to get there.  As in Fleet::MovePath, departing a system uses
+      * one unit of fuel, unless it is one of \a fleet_supplyable_system_ids,
+      * where the fleet is refuelled to \a max_fuel instead.  If no such path
+      * exists, the list will be empty.  Paths are found with a single search,
+      * rather than by checking the fuel needed along shortest paths.
+      * \throw std::out_of_range This function will throw if the empire ID is
+      * not known. */
+    std::pair<std::list<int>, double> FuelLimitedShortestPath(int system1_id, int system2_id, int empire_id,
+                                                              float fuel, float max_fuel,
+                                                              const std::set<int>& fleet_supplyable_system_ids) const;
+
     /** Returns the shortest starlane path distance between any two objects, accounting
       * for cases where one or the other are fleets / ships on starlanes between
       * systems. Returns -1 when no path exists, or either object does not
@@ -133,6 +152,27 @@ public:
       * (\a x, \a y) location on the map, by direct-line distance. */
     int NearestSystemTo(double x, double y, const ObjectMap& objects) const;
 
+    /** Returns the ids of the systems in the system graph, indexed by their
+      * graph index, which is in order of increasing system id.  Per-system
+      * data can be stored in arrays indexed the same way. */
+    const std::vector<int>& SystemGraphSystemIDs() const;
+
+    /** Returns the number of regions the system graph is partitioned into, or
+      * 0 if it isn't, which is the case unless the galaxy has at least
+      * "pathfinder.regions.min-systems" systems. */
+    int NumRegions() const;
+
+    /** Returns the region of system with id \a system_id, or -1 if there is no
+      * such system or the system graph isn't partitioned into regions. */
+    int SystemRegion(int system_id) const;
+
+    /** Returns the ids of the systems in region \a region, in increasing order. */
+    std::vector<int> RegionSystemIDs(int region) const;
+
+    /** Returns the approximate number of bytes used by the caches of jump
+      * distances between systems. */
+    std::size_t DistanceCacheBytes() const;
+
     /** Fills pathfinding data structure and determines least jumps distances
       * between systems. */
     void InitializeSystemGraph(const ObjectMap& objects, const EmpireManager& empires);
@@ -149,5 +189,55 @@ private:
     const std::unique_ptr<PathfinderImpl> pimpl;
 };
 
+//! Kinds of pathfinding queries counted by PathfinderStatistics
+FO_ENUM(
+    (PathfinderQuery),
+    ((SHORTEST_PATH))
+    ((FUEL_LIMITED_SHORTEST_PATH))
+    ((SHORTEST_PATH_DISTANCE))
+    ((LEAST_JUMPS_PATH))
+    ((JUMP_DISTANCE))
+    ((WITHIN_JUMPS))
+    ((WITHIN_JUMPS_OF_OTHERS))
+    ((NUM_PATHFINDER_QUERIES))
+)
+
+//! The part of the game making pathfinding queries in this process
+FO_ENUM(
+    (PathfinderCaller),
+    ((PATHFINDER_CALLER_OTHER))
+    ((PATHFINDER_CALLER_SERVER))
+    ((PATHFINDER_CALLER_AI))
+    ((PATHFINDER_CALLER_UI))
+)
+
+/** Counts of the pathfinding queries made by all Pathfinders in this process
+  * since it started.  Subtract two of them to get the counts between. */
+struct FO_COMMON_API PathfinderStatistics {
+    struct Queries {
+        std::uint64_t count = 0;
+        std::uint64_t nanoseconds = 0;  ///< not measured for JUMP_DISTANCE, which are mostly cache lookups
+    };
+
+    PathfinderCaller    caller = PathfinderCaller::PATHFINDER_CALLER_OTHER;
+    std::array<Queries, static_cast<std::size_t>(PathfinderQuery::NUM_PATHFINDER_QUERIES)> queries{};
+    std::uint64_t       cache_hits = 0;         ///< jump distances found in already computed rows of the distance matrix
+    std::uint64_t       cache_misses = 0;       ///< jump distances that needed a row of the distance matrix to be computed
+    std::uint64_t       rows_computed = 0;      ///< rows of the distance matrix computed
+    std::uint64_t       row_nanoseconds = 0;    ///< time spent computing them
+
+    [[nodiscard]] PathfinderStatistics operator-(const PathfinderStatistics& rhs) const;
+
+    /** Returns a line of text for each kind of query and for the cache. */
+    [[nodiscard]] std::string Dump() const;
+};
+
+/** Returns the pathfinding queries made in this process so far. */
+FO_COMMON_API PathfinderStatistics GetPathfinderStatistics();
+
+/** Sets which part of the game the pathfinding queries in this process are
+  * reported as being made by. */
+FO_COMMON_API void SetPathfinderCaller(PathfinderCaller caller);
+
 
 #endif
@@ -119,10 +119,15 @@ void Planet::Copy(std::shared_ptr<const UniverseObject> copied_object, int empir
             } else {
                 // copy system name if at partial visibility, as it won't be copied
                 // by UniverseObject::Copy unless at full visibility, but players
-                // should know planet names even if they don't own the planet
-                GetUniverse().InhibitUniverseObjectSignals(true);
+                // should know planet names even if they don't own the planet.
+                // if signals are already inhibited, eg. while latest known
+                // objects are updated in parallel, leave the flag alone
+                const bool already_inhibited = GetUniverse().UniverseObjectSignalsInhibited();
+                if (!already_inhibited)
+                    GetUniverse().InhibitUniverseObjectSignals(true);
                 this->Rename(copied_planet->Name());
-                GetUniverse().InhibitUniverseObjectSignals(false);
+                if (!already_inhibited)
+                    GetUniverse().InhibitUniverseObjectSignals(false);
             }
         }
     }
@@ -491,7 +496,7 @@ std::string Planet::CardinalSuffix() const {
 int Planet::ContainerObjectID() const
 { return this->SystemID(); }
 
-const std::set<int>& Planet::ContainedObjectIDs() const
+const ObjectIDSet& Planet::ContainedObjectIDs() const
 { return m_buildings; }
 
 bool Planet::Contains(int object_id) const
@@ -58,7 +58,7 @@ public:
     std::string             Dump(unsigned short ntabs = 0) const override;
 
     int                     ContainerObjectID() const override;
-    const std::set<int>&    ContainedObjectIDs() const override;
+    const ObjectIDSet&      ContainedObjectIDs() const override;
     bool                    Contains(int object_id) const override;
     bool                    ContainedBy(int object_id) const override;
 
@@ -98,7 +98,7 @@ public:
     /** @returns an angle in degree. */
     float AxialTilt() const;
 
-    const std::set<int>& BuildingIDs() const    { return m_buildings; }
+    const ObjectIDSet& BuildingIDs() const     { return m_buildings; }
 
     bool IsAboutToBeColonized() const           { return m_is_about_to_be_colonized; }
     bool IsAboutToBeInvaded() const             { return m_is_about_to_be_invaded; }
@@ -185,7 +185,7 @@ private:
     float           m_rotational_period = 1.0f;
     float           m_axial_tilt = 23.0f;
 
-    std::set<int>   m_buildings;
+    ObjectIDSet     m_buildings;
 
     int             m_turn_last_colonized = INVALID_GAME_TURN;
     int             m_turn_last_conquered = INVALID_GAME_TURN;
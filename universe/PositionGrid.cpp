@@ -0,0 +1,62 @@
+#include "PositionGrid.h"
+
+#include <algorithm>
+
+
+namespace {
+    // limit on cells per position, so that a small typical range over a large
+    // area doesn't produce a grid that is mostly empty cells
+    constexpr std::size_t MAX_CELLS_PER_POSITION = 4;
+}
+
+PositionGrid::PositionGrid(std::vector<Position> positions, double typical_range) :
+    m_positions(std::move(positions))
+{
+    if (m_positions.empty())
+        return;
+
+    double max_x = m_positions.front().first, max_y = m_positions.front().second;
+    m_min_x = max_x;
+    m_min_y = max_y;
+    for (const auto& [x, y] : m_positions) {
+        m_min_x = std::min(m_min_x, x);
+        m_min_y = std::min(m_min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+    const double width = std::max(max_x - m_min_x, 1.0);
+    const double height = std::max(max_y - m_min_y, 1.0);
+
+    // cells about the size of a typical query range means a typical query
+    // checks at most a 3x3 block of cells. enlarge cells if that would make
+    // too many of them for the number of positions being indexed.
+    const double max_cells = static_cast<double>(m_positions.size() * MAX_CELLS_PER_POSITION);
+    const double min_cell_size = std::sqrt(width * height / max_cells);
+    m_cell_size = std::max({typical_range, min_cell_size, 1.0});
+
+    m_cells_x = static_cast<std::size_t>(width / m_cell_size) + 1;
+    m_cells_y = static_cast<std::size_t>(height / m_cell_size) + 1;
+
+    // counting sort of position indices by cell
+    std::vector<std::size_t> position_cells;
+    position_cells.reserve(m_positions.size());
+    m_cell_starts.assign(m_cells_x * m_cells_y + 1, 0);
+    for (const auto& [x, y] : m_positions) {
+        const auto cell = CellY(y) * m_cells_x + CellX(x);
+        position_cells.push_back(cell);
+        ++m_cell_starts[cell + 1];
+    }
+    for (std::size_t cell = 1; cell < m_cell_starts.size(); ++cell)
+        m_cell_starts[cell] += m_cell_starts[cell - 1];
+
+    m_cell_entries.resize(m_positions.size());
+    auto next_entry = m_cell_starts;
+    for (std::size_t idx = 0; idx < position_cells.size(); ++idx)
+        m_cell_entries[next_entry[position_cells[idx]]++] = idx;
+}
+
+std::vector<std::size_t> PositionGrid::InRange(double x, double y, double range) const {
+    std::vector<std::size_t> retval;
+    ForEachInRange(x, y, range, [&retval](std::size_t idx) { retval.push_back(idx); });
+    return retval;
+}
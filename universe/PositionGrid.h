@@ -0,0 +1,105 @@
+#ifndef _PositionGrid_h_
+#define _PositionGrid_h_
+
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../util/Export.h"
+
+
+/** Uniform grid spatial index over a fixed set of 2D positions.
+
+    Built once from a list of positions, the grid can then be queried for the
+    positions within some range of a point.  Only positions in the grid cells
+    overlapped by the query range are tested, rather than every position, so
+    repeated queries (eg. one for each detector of each empire) are much
+    cheaper than a nested loop over all positions.
+
+    Positions are referred to by their index in the list the grid was built
+    from, so callers can keep parallel per-position data in a vector. */
+class FO_COMMON_API PositionGrid {
+public:
+    using Position = std::pair<double, double>;
+
+    PositionGrid() = default;
+
+    /** Builds a grid over \a positions. \a typical_range is the range that
+      * queries are expected to use, and determines the grid cell size. */
+    explicit PositionGrid(std::vector<Position> positions, double typical_range = 0.0);
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_positions.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_positions.empty(); }
+    [[nodiscard]] const Position& operator[](std::size_t idx) const { return m_positions[idx]; }
+    [[nodiscard]] const std::vector<Position>& Positions() const noexcept { return m_positions; }
+
+    /** Calls \a fn with the index of each position that is within \a range of
+      * (\a x, \a y). Returning true from \a fn stops the query early, so \a fn
+      * may return either bool or void. */
+    template <typename Fn>
+    void ForEachInRange(double x, double y, double range, Fn&& fn) const;
+
+    /** Returns indices of all positions within \a range of (\a x, \a y). */
+    [[nodiscard]] std::vector<std::size_t> InRange(double x, double y, double range) const;
+
+private:
+    [[nodiscard]] std::size_t CellX(double x) const noexcept;
+    [[nodiscard]] std::size_t CellY(double y) const noexcept;
+
+    std::vector<Position>       m_positions;
+    std::vector<std::size_t>    m_cell_starts;  ///< offset into m_cell_entries of first entry of each cell, plus one past last
+    std::vector<std::size_t>    m_cell_entries; ///< indices into m_positions, grouped by cell
+    double                      m_min_x = 0.0;
+    double                      m_min_y = 0.0;
+    double                      m_cell_size = 1.0;
+    std::size_t                 m_cells_x = 0;
+    std::size_t                 m_cells_y = 0;
+};
+
+inline std::size_t PositionGrid::CellX(double x) const noexcept {
+    if (!(x > m_min_x))
+        return 0;
+    const double cell = (x - m_min_x) / m_cell_size;
+    return cell < static_cast<double>(m_cells_x) ? static_cast<std::size_t>(cell) : m_cells_x - 1;
+}
+
+inline std::size_t PositionGrid::CellY(double y) const noexcept {
+    if (!(y > m_min_y))
+        return 0;
+    const double cell = (y - m_min_y) / m_cell_size;
+    return cell < static_cast<double>(m_cells_y) ? static_cast<std::size_t>(cell) : m_cells_y - 1;
+}
+
+template <typename Fn>
+void PositionGrid::ForEachInRange(double x, double y, double range, Fn&& fn) const {
+    if (m_positions.empty() || range < 0.0 || std::isnan(range))
+        return;
+
+    const double range2 = range * range;
+    const auto x_low = CellX(x - range), x_high = CellX(x + range);
+    const auto y_low = CellY(y - range), y_high = CellY(y + range);
+
+    for (auto cy = y_low; cy <= y_high; ++cy) {
+        for (auto cx = x_low; cx <= x_high; ++cx) {
+            const auto cell = cy * m_cells_x + cx;
+            for (auto e = m_cell_starts[cell]; e < m_cell_starts[cell + 1]; ++e) {
+                const auto idx = m_cell_entries[e];
+                const auto& pos = m_positions[idx];
+                const double dx = pos.first - x;
+                const double dy = pos.second - y;
+                if (dx*dx + dy*dy > range2)
+                    continue;
+                if constexpr (std::is_same_v<decltype(fn(idx)), bool>) {
+                    if (fn(idx))
+                        return;
+                } else {
+                    fn(idx);
+                }
+            }
+        }
+    }
+}
+
+
+#endif
@@ -45,6 +45,43 @@ struct ScriptingContext {
         diplo_statuses(           parent_context.diplo_statuses)
     {}
 
+    /** Tag selecting the constructor of contexts that view the objects of
+      * another context without sharing ownership of them. */
+    struct LocalCandidateView {};
+
+    /** Makes a context for evaluating with \a condition_local_candidate_ as
+      * the local candidate within \a parent_context, like the constructor
+      * above, for hot paths that make a context for each candidate.  The
+      * source, target and candidates are pointers that don't own their
+      * objects, so making and copying this context doesn't change any
+      * reference counts.  It must not outlive \a parent_context or
+      * \a condition_local_candidate_, and its objects must not be kept after
+      * evaluating with it. */
+    ScriptingContext(LocalCandidateView, const ScriptingContext& parent_context,
+                     const std::shared_ptr<const UniverseObject>& condition_local_candidate_) :
+        source(                   Unowned(parent_context.source)),
+        effect_target(            Unowned(parent_context.effect_target)),
+        condition_root_candidate( Unowned(parent_context.condition_root_candidate ?
+                                              parent_context.condition_root_candidate :
+                                              condition_local_candidate_)),
+        condition_local_candidate(Unowned(condition_local_candidate_)),
+        current_value(            parent_context.current_value),
+        combat_bout(              parent_context.combat_bout),
+        current_turn(             parent_context.current_turn),
+        galaxy_setup_data(        parent_context.galaxy_setup_data),
+        species(                  parent_context.species),
+        supply(                   parent_context.supply),
+        universe(                 parent_context.universe),
+        const_universe(           parent_context.const_universe),
+        objects(                  parent_context.objects),
+        const_objects(            parent_context.const_objects),
+        empire_object_vis(        parent_context.empire_object_vis),
+        empire_object_vis_turns(  parent_context.empire_object_vis_turns),
+        empires(                  parent_context.empires),
+        const_empires(            parent_context.const_empires),
+        diplo_statuses(           parent_context.diplo_statuses)
+    {}
+
     ScriptingContext(std::shared_ptr<const UniverseObject> source_) :
         source(           std::move(source_)),
         galaxy_setup_data(GetGalaxySetupData()),
@@ -230,6 +267,12 @@ struct ScriptingContext {
         throw std::runtime_error("ScriptingContext::ContextUniverse() asked for undefined mutable empires");
     }
 
+    /** Returns a pointer to the object of \a ptr that doesn't share ownership
+      * of it, so copying the pointer doesn't change any reference count. */
+    template <typename T>
+    static std::shared_ptr<T> Unowned(const std::shared_ptr<T>& ptr) noexcept
+    { return std::shared_ptr<T>(std::shared_ptr<T>{}, ptr.get()); }
+
     // script evaluation local state, some of which may vary during evaluation of an expression
     std::shared_ptr<const UniverseObject> source;
     std::shared_ptr<UniverseObject>       effect_target;
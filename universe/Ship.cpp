@@ -211,12 +211,9 @@ std::string Ship::Dump(unsigned short ntabs) const {
        << " last resupplied on turn: " << m_last_resupplied_on_turn;
     if (!m_part_meters.empty()) {
         os << " part meters: ";
-        for (const auto& entry : m_part_meters) {
-            const std::string part_name = entry.first.second;
-            MeterType meter_type = entry.first.first;
-            const Meter& meter = entry.second;
-            os << part_name << " " << meter_type << ": " << meter.Current() << "  ";
-        }
+        m_part_meters.ForEach([this, &os](std::size_t part_idx, MeterType meter_type, const Meter& meter) {
+            os << m_part_meters.PartNames()[part_idx] << " " << meter_type << ": " << meter.Current() << "  ";
+        });
     }
     return os.str();
 }
@@ -347,13 +344,8 @@ std::shared_ptr<UniverseObject> Ship::Accept(const UniverseObjectVisitor& visito
 const Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name) const
 { return const_cast<Ship*>(this)->GetPartMeter(type, part_name); }
 
-Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name) {
-    Meter* retval = nullptr;
-    auto it = m_part_meters.find({type, part_name});
-    if (it != m_part_meters.end())
-        retval = &it->second;
-    return retval;
-}
+Meter* Ship::GetPartMeter(MeterType type, const std::string& part_name)
+{ return m_part_meters.get(type, part_name); }
 
 float Ship::CurrentPartMeterValue(MeterType type, const std::string& part_name) const {
     if (const Meter* meter = GetPartMeter(type, part_name))
@@ -382,47 +374,38 @@ float Ship::SumCurrentPartMeterValuesForPartClass(MeterType type, ShipPartClass
     for (const std::string& part : parts)
         part_counts[part]++;
 
-    for (const auto& part_meter : m_part_meters) {
-        if (part_meter.first.first != type)
-            continue;
-        const std::string& part_name = part_meter.first.second;
+    m_part_meters.ForEach(type, [this, &part_counts, part_class, &retval](std::size_t part_idx, const Meter& meter) {
+        const std::string& part_name = m_part_meters.PartNames()[part_idx];
         if (part_counts[part_name] < 1)
-            continue;
+            return;
         const ShipPart* part = GetShipPart(part_name);
         if (!part)
-            continue;
+            return;
         if (part_class == part->Class())
-            retval += part_meter.second.Current() * part_counts[part_name];
-    }
+            retval += meter.Current() * part_counts[part_name];
+    });
 
     return retval;
 }
 
 float Ship::FighterCount() const {
     float retval = 0.0f;
-    for (const auto& entry : m_part_meters) {
-        if (entry.first.first != MeterType::METER_CAPACITY)
-            continue;
-        const ShipPart* part = GetShipPart(entry.first.second);
-        if (!part || part->Class() != ShipPartClass::PC_FIGHTER_HANGAR)
-            continue;
-        retval += entry.second.Current();
-    }
+    m_part_meters.ForEach(MeterType::METER_CAPACITY, [this, &retval](std::size_t part_idx, const Meter& meter) {
+        const ShipPart* part = GetShipPart(m_part_meters.PartNames()[part_idx]);
+        if (part && part->Class() == ShipPartClass::PC_FIGHTER_HANGAR)
+            retval += meter.Current();
+    });
 
     return retval;
 }
 
 float Ship::FighterMax() const {
     float retval = 0.0f;
-    for (const auto& entry : m_part_meters) {
-        //std::map<std::pair<MeterType, std::string>, Meter>
-        if (entry.first.first != MeterType::METER_MAX_CAPACITY)
-            continue;
-        const ShipPart* part = GetShipPart(entry.first.second);
-        if (!part || part->Class() != ShipPartClass::PC_FIGHTER_HANGAR)
-            continue;
-        retval += entry.second.Current();
-    }
+    m_part_meters.ForEach(MeterType::METER_MAX_CAPACITY, [this, &retval](std::size_t part_idx, const Meter& meter) {
+        const ShipPart* part = GetShipPart(m_part_meters.PartNames()[part_idx]);
+        if (part && part->Class() == ShipPartClass::PC_FIGHTER_HANGAR)
+            retval += meter.Current();
+    });
 
     return retval;
 }
@@ -437,6 +420,8 @@ float Ship::TotalWeaponsDamage(float shield_DR, bool include_fighters) const {
 }
 
 namespace {
+    const RuleHandle<int> RULE_NUM_COMBAT_ROUNDS{"RULE_NUM_COMBAT_ROUNDS"};
+
     std::vector<float> WeaponDamageImpl(const Ship* ship, const ShipDesign* design,
                                         float DR, bool max, bool include_fighters)
     {
@@ -455,6 +440,8 @@ namespace {
         int fighter_launch_capacity = 0;
         int available_fighters = 0;
 
+        const auto& part_meters = ship->PartMeters();
+
         retval.reserve(parts.size() + 1);
         // for each weapon part, get its damage meter value
         for (const auto& part_name : parts) {
@@ -463,21 +450,28 @@ namespace {
                 continue;
             ShipPartClass part_class = part->Class();
 
+            // look up the part once for all of its meters
+            const auto part_idx = part_meters.PartIndex(part_name);
+            const auto current_value = [&part_meters, part_idx](MeterType type) {
+                const Meter* meter = part_meters.get(type, part_idx);
+                return meter ? meter->Current() : 0.0f;
+            };
+
             // get the attack power for each weapon part.
             if (part_class == ShipPartClass::PC_DIRECT_WEAPON) {
-                float part_attack = ship->CurrentPartMeterValue(METER, part_name);  // used within loop that updates meters, so need current, not initial values
-                float part_shots = ship->CurrentPartMeterValue(SECONDARY_METER, part_name);
+                float part_attack = current_value(METER);  // used within loop that updates meters, so need current, not initial values
+                float part_shots = current_value(SECONDARY_METER);
                 if (part_attack > DR)
                     retval.emplace_back((part_attack - DR)*part_shots);
 
             } else if (part_class == ShipPartClass::PC_FIGHTER_BAY && include_fighters) {
                 // launch capacity determined by capacity of bay
-                fighter_launch_capacity += static_cast<int>(ship->CurrentPartMeterValue(METER, part_name));
+                fighter_launch_capacity += static_cast<int>(current_value(METER));
 
             } else if (part_class == ShipPartClass::PC_FIGHTER_HANGAR && include_fighters) {
                 // attack strength of a ship's fighters determined by the hangar...
-                fighter_damage = ship->CurrentPartMeterValue(SECONDARY_METER, part_name);  // assuming all hangars have the same damage...
-                available_fighters = std::max(0, static_cast<int>(ship->CurrentPartMeterValue(METER, part_name)));  // stacked meter
+                fighter_damage = current_value(SECONDARY_METER);  // assuming all hangars have the same damage...
+                available_fighters = std::max(0, static_cast<int>(current_value(METER)));  // stacked meter
             }
         }
 
@@ -487,7 +481,7 @@ namespace {
         int fighter_shots = std::min(available_fighters, fighter_launch_capacity);  // how many fighters launched in bout 1
         available_fighters -= fighter_shots;
         int launched_fighters = fighter_shots;
-        int num_bouts = GetGameRules().Get<int>("RULE_NUM_COMBAT_ROUNDS");
+        int num_bouts = RULE_NUM_COMBAT_ROUNDS.Get();
         int remaining_bouts = num_bouts - 2;  // no attack for first round, second round already added
         while (remaining_bouts > 0) {
             int fighters_launched_this_bout = std::min(available_fighters, fighter_launch_capacity);
@@ -544,8 +538,7 @@ void Ship::BackPropagateMeters() {
     UniverseObject::BackPropagateMeters();
 
     // ship part meter back propagation, since base class function doesn't do this...
-    for (auto& entry : m_part_meters)
-        entry.second.BackPropagate();
+    m_part_meters.ForEach([](std::size_t, MeterType, Meter& meter) { meter.BackPropagate(); });
 }
 
 void Ship::Resupply() {
@@ -563,27 +556,14 @@ void Ship::Resupply() {
     // set all part capacities equal to any associated max capacity
     // this "upgrades" any direct-fire weapon parts to their latest-allowed
     // strengths, and replaces any lost fighters
-    for (auto& entry : m_part_meters) {
-        const auto& part_name = entry.first.second;
-        MeterType meter_type = entry.first.first;
-        MeterType paired_meter_type = MeterType::INVALID_METER_TYPE;
-        switch(meter_type) {
-        case MeterType::METER_CAPACITY:       paired_meter_type = MeterType::METER_MAX_CAPACITY;         break;
-        case MeterType::METER_SECONDARY_STAT: paired_meter_type = MeterType::METER_MAX_SECONDARY_STAT;   break;
-        default:
-            break;
-        }
-        if (paired_meter_type == MeterType::INVALID_METER_TYPE)
-            continue;
-        auto max_it = m_part_meters.find({paired_meter_type, part_name});
-        if (max_it == m_part_meters.end())
-            continue;
-
-        const Meter& max_meter = max_it->second;
+    m_part_meters.ForEach([this](std::size_t part_idx, MeterType meter_type, Meter& meter) {
+        const Meter* max_meter = m_part_meters.get(PartMeterMap::PairedMaxType(meter_type), part_idx);
+        if (!max_meter)
+            return;
 
-        entry.second.SetCurrent(max_meter.Current());
-        entry.second.BackPropagate();
-    }
+        meter.SetCurrent(max_meter->Current());
+        meter.BackPropagate();
+    });
 }
 
 void Ship::SetSpecies(std::string species_name) {
@@ -641,31 +621,22 @@ void Ship::ResetTargetMaxUnpairedMeters() {
 
     // max meters are always treated as target/max meters.
     // other meters may be unpaired if there is no associated max or target meter
-    for (auto& entry : m_part_meters) {
-        const auto& part_name = entry.first.second;
-        MeterType meter_type = entry.first.first;
-        MeterType paired_meter_type = MeterType::INVALID_METER_TYPE;
-
+    m_part_meters.ForEach([this](std::size_t part_idx, MeterType meter_type, Meter& meter) {
         switch(meter_type) {
         case MeterType::METER_MAX_CAPACITY:
         case MeterType::METER_MAX_SECONDARY_STAT:
-            entry.second.ResetCurrent();
-            continue;
-            break;
-        case MeterType::METER_CAPACITY:        paired_meter_type = MeterType::METER_MAX_CAPACITY;         break;
-        case MeterType::METER_SECONDARY_STAT:  paired_meter_type = MeterType::METER_MAX_SECONDARY_STAT;   break;
+            meter.ResetCurrent();
+            return;
         default:
-            continue;
             break;
         }
 
-        auto max_it = m_part_meters.find({paired_meter_type, part_name});
-        if (max_it != m_part_meters.end())
-            continue;   // is a max/target meter associated with the meter, so don't treat this a target/max
+        if (m_part_meters.Has(PartMeterMap::PairedMaxType(meter_type), part_idx))
+            return;     // is a max/target meter associated with the meter, so don't treat this a target/max
 
         // no associated target/max meter, so treat this meter as unpaired
-        entry.second.ResetCurrent();
-    }
+        meter.ResetCurrent();
+    });
 }
 
 void Ship::ResetPairedActiveMeters() {
@@ -673,31 +644,14 @@ void Ship::ResetPairedActiveMeters() {
 
     // meters are paired only if they are not max/target meters, and there is an
     // associated max/target meter
-    for (auto& entry : m_part_meters) {
-        const auto& part_name = entry.first.second;
-        MeterType meter_type = entry.first.first;
-        MeterType paired_meter_type = MeterType::INVALID_METER_TYPE;
-
-        switch(meter_type) {
-        case MeterType::METER_MAX_CAPACITY:
-        case MeterType::METER_MAX_SECONDARY_STAT:
-            continue;   // is a max/target meter
-            break;
-        case MeterType::METER_CAPACITY:       paired_meter_type = MeterType::METER_MAX_CAPACITY;         break;
-        case MeterType::METER_SECONDARY_STAT: paired_meter_type = MeterType::METER_MAX_SECONDARY_STAT;   break;
-        default:
-            continue;   // no associated max/target meter
-            break;
-        }
-
-        auto max_it = m_part_meters.find({paired_meter_type, part_name});
-        if (max_it == m_part_meters.end())
-            continue;   // no associated max/target meter
+    m_part_meters.ForEach([this](std::size_t part_idx, MeterType meter_type, Meter& meter) {
+        // max meters have no paired max type, so are skipped here
+        if (!m_part_meters.Has(PartMeterMap::PairedMaxType(meter_type), part_idx))
+            return;     // no associated max/target meter
 
         // has an associated max/target meter.
-        //std::map<std::pair<MeterType, std::string>, Meter>::iterator
-        entry.second.SetCurrent(entry.second.Initial());
-    }
+        meter.SetCurrent(meter.Initial());
+    });
 }
 
 void Ship::SetShipMetersToMax() {
@@ -709,8 +663,7 @@ void Ship::SetShipMetersToMax() {
     UniverseObject::GetMeter(MeterType::METER_STRUCTURE)->SetCurrent(Meter::LARGE_VALUE);
 
     // some part capacity meters may have an associated max capacity...
-    for (auto& entry : m_part_meters)
-        entry.second.SetCurrent(Meter::LARGE_VALUE);
+    m_part_meters.ForEach([](std::size_t, MeterType, Meter& meter) { meter.SetCurrent(Meter::LARGE_VALUE); });
 }
 
 void Ship::ClampMeters() {
@@ -733,38 +686,22 @@ void Ship::ClampMeters() {
     UniverseObject::GetMeter(MeterType::METER_SPEED)->ClampCurrentToRange();
 
     // clamp most part meters to basic range limits
-    for (auto& entry : m_part_meters) {
-        MeterType meter_type = entry.first.first;
+    m_part_meters.ForEach([](std::size_t, MeterType meter_type, Meter& meter) {
         switch(meter_type) {
         case MeterType::METER_MAX_CAPACITY:
         case MeterType::METER_MAX_SECONDARY_STAT:
-            entry.second.ClampCurrentToRange();
+            meter.ClampCurrentToRange();
         default:
             break;
         }
-    }
+    });
 
     // special case extra clamping for paired active meters dependent
     // on their associated max meter...
-    for (auto& entry : m_part_meters) {
-        const auto& part_name = entry.first.second;
-        MeterType meter_type = entry.first.first;
-        MeterType paired_meter_type = MeterType::INVALID_METER_TYPE;
-        switch(meter_type) {
-        case MeterType::METER_CAPACITY:        paired_meter_type = MeterType::METER_MAX_CAPACITY;         break;
-        case MeterType::METER_SECONDARY_STAT:  paired_meter_type = MeterType::METER_MAX_SECONDARY_STAT;   break;
-        default:
-            break;
-        }
-        if (paired_meter_type == MeterType::INVALID_METER_TYPE)
-            continue;
-        auto max_it = m_part_meters.find({paired_meter_type, part_name});
-        if (max_it == m_part_meters.end())
-            continue;
-
-        const Meter& max_meter = max_it->second;
-        entry.second.ClampCurrentToRange(Meter::DEFAULT_VALUE, max_meter.Current());
-    }
+    m_part_meters.ForEach([this](std::size_t part_idx, MeterType meter_type, Meter& meter) {
+        if (const Meter* max_meter = m_part_meters.get(PartMeterMap::PairedMaxType(meter_type), part_idx))
+            meter.ClampCurrentToRange(Meter::DEFAULT_VALUE, max_meter->Current());
+    });
 }
 
 ////////////////////
@@ -3,6 +3,7 @@
 
 
 #include "Meter.h"
+#include "PartMeterMap.h"
 #include "UniverseObject.h"
 #include "../util/Export.h"
 
@@ -17,7 +18,7 @@ class ShipDesign;
 /** a class representing a single FreeOrion ship */
 class FO_COMMON_API Ship : public UniverseObject {
 public:
-    typedef std::map<std::pair<MeterType, std::string>, Meter> PartMeterMap;
+    using PartMeterMap = ::PartMeterMap;
 
     bool HostileToEmpire(int empire_id, const EmpireManager& empires) const override;
     std::set<std::string> Tags() const override;
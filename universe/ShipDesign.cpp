@@ -22,6 +22,9 @@ const int INVALID_DESIGN_ID = -1;
 //using boost::io::str;
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_AND_FAST_SHIP_PRODUCTION{"RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"};
+    const RuleHandle<int> RULE_NUM_COMBAT_ROUNDS{"RULE_NUM_COMBAT_ROUNDS"};
+
     void AddRules(GameRules& rules) {
         // makes all ships cost 1 PP and take 1 turn to produce
         rules.Add<bool>(UserStringNop("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"),
@@ -164,7 +167,7 @@ void ShipDesign::SetDescription(const std::string& description)
 { m_description = description; }
 
 bool ShipDesign::ProductionCostTimeLocationInvariant() const {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get())
         return true;
     // as seen in ShipDesign::ProductionCost, the production location is passed
     // as the local candidate in the ScriptingContext
@@ -184,7 +187,7 @@ bool ShipDesign::ProductionCostTimeLocationInvariant() const {
 }
 
 float ShipDesign::ProductionCost(int empire_id, int location_id) const {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get())
         return 1.0f;
 
     ScriptingContext context; // TODO: pass in and use, instead of creating here...
@@ -212,7 +215,7 @@ float ShipDesign::PerTurnCost(int empire_id, int location_id) const
 { return ProductionCost(empire_id, location_id) / std::max(1, ProductionTime(empire_id, location_id)); }
 
 int ShipDesign::ProductionTime(int empire_id, int location_id) const {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get())
         return 1;
 
     int time_accumulator = 1;
@@ -287,7 +290,7 @@ float ShipDesign::AdjustedAttack(float shield) const {
     int fighter_shots = std::min(available_fighters, fighter_launch_capacity);  // how many fighters launched in bout 1
     available_fighters -= fighter_shots;
     int launched_fighters = fighter_shots;
-    int num_bouts = GetGameRules().Get<int>("RULE_NUM_COMBAT_ROUNDS"); // TODO: get from ScriptingContext?
+    int num_bouts = RULE_NUM_COMBAT_ROUNDS.Get(); // TODO: get from ScriptingContext?
     int remaining_bouts = num_bouts - 2;  // no attack for first round, second round already added
     while (remaining_bouts > 0) {
         int fighters_launched_this_bout = std::min(available_fighters, fighter_launch_capacity);
@@ -411,6 +414,70 @@ bool ShipDesign::ProductionLocation(int empire_id, int location_id) const { // T
     return true;
 }
 
+void ShipDesign::ProductionLocations(int empire_id, std::vector<std::shared_ptr<const UniverseObject>>& candidates) const {
+    if (!GetEmpire(empire_id)) {
+        DebugLogger() << "ShipDesign::ProductionLocations: Unable to get pointer to empire " << empire_id;
+        candidates.clear();
+        return;
+    }
+
+    // the requirements of ProductionLocation other than location conditions
+    const auto cant_produce_at = [this, empire_id](const std::shared_ptr<const UniverseObject>& location) {
+        if (!location || !location->OwnedBy(empire_id))
+            return true;
+        const std::string* species_name = nullptr;
+        if (location->ObjectType() == UniverseObjectType::OBJ_PLANET)
+            species_name = &static_cast<const Planet*>(location.get())->SpeciesName();
+        else if (location->ObjectType() == UniverseObjectType::OBJ_SHIP)
+            species_name = &static_cast<const Ship*>(location.get())->SpeciesName();
+        if (!species_name || species_name->empty())
+            return true;
+        const Species* species = GetSpecies(*species_name);
+        return !species || !species->CanProduceShips() || (this->CanColonize() && !species->CanColonize());
+    };
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), cant_produce_at), candidates.end());
+
+    const ShipHull* hull = GetShipHull(m_hull);
+    if (!hull) {
+        ErrorLogger() << "ShipDesign::ProductionLocations  ShipDesign couldn't get its own hull with name " << m_hull;
+        candidates.clear();
+        return;
+    }
+    std::vector<const Condition::Condition*> location_conditions{hull->Location()};
+    for (const std::string& part_name : m_parts) {
+        if (part_name.empty())
+            continue;       // empty slots don't limit build location
+        const ShipPart* part = GetShipPart(part_name);
+        if (!part) {
+            ErrorLogger() << "ShipDesign::ProductionLocations  ShipDesign couldn't get part with name " << part_name;
+            candidates.clear();
+            return;
+        }
+        location_conditions.push_back(part->Location());
+    }
+
+    // conditions are evaluated using each location as the source, as it
+    // should be an object owned by this empire.  the result of those that
+    // don't depend on the source or target is the same with any source.
+    for (const Condition::Condition* condition : location_conditions) {
+        if (!condition || candidates.empty())
+            continue;
+        if (condition->SourceInvariant() && condition->TargetInvariant()) {
+            ScriptingContext context(candidates.front(), std::const_pointer_cast<UniverseObject>(candidates.front()));
+            Condition::ObjectSet non_matches;
+            condition->Eval(context, candidates, non_matches, Condition::SearchDomain::MATCHES);
+        } else {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [condition](const std::shared_ptr<const UniverseObject>& location) {
+                                                ScriptingContext location_as_source_context(
+                                                    location, std::const_pointer_cast<UniverseObject>(location));
+                                                return !condition->Eval(location_as_source_context, location);
+                                            }),
+                             candidates.end());
+        }
+    }
+}
+
 void ShipDesign::SetID(int id)
 { m_id = id; }
 
@@ -10,6 +10,8 @@
 #include "../util/Pending.h"
 
 
+class UniverseObject;
+
 FO_COMMON_API extern const int INVALID_DESIGN_ID;
 FO_COMMON_API extern const int ALL_EMPIRES;
 FO_COMMON_API extern const int INVALID_GAME_TURN;
@@ -162,6 +164,12 @@ public:
 
     bool                            ProductionLocation(int empire_id, int location_id) const;   ///< returns true iff the empire with ID empire_id can produce this design at the location with location_id
 
+    /** Removes from \a candidates the objects at which the empire with ID
+      * \a empire_id can't produce this design.  Each hull and part location
+      * condition that doesn't depend on the source or target object is
+      * evaluated once for all candidates that the previous ones matched. */
+    void                            ProductionLocations(int empire_id, std::vector<std::shared_ptr<const UniverseObject>>& candidates) const;
+
     void                            SetID(int id);                          ///< sets the ID number of the design to \a id .  Should only be used by Universe class when inserting new design into Universe.
     /** Set the UUID. */
     void                            SetUUID(const boost::uuids::uuid& uuid);
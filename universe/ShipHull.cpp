@@ -18,6 +18,10 @@
                                         }   }
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_AND_FAST_SHIP_PRODUCTION{"RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"};
+    const RuleHandle<double> RULE_SHIP_SPEED_FACTOR{"RULE_SHIP_SPEED_FACTOR"};
+    const RuleHandle<double> RULE_SHIP_STRUCTURE_FACTOR{"RULE_SHIP_STRUCTURE_FACTOR"};
+
     void AddRules(GameRules& rules) {
         rules.Add<double>(UserStringNop("RULE_SHIP_SPEED_FACTOR"),
                           UserStringNop("RULE_SHIP_SPEED_FACTOR_DESC"),
@@ -247,10 +251,10 @@ void ShipHull::Init(std::vector<std::unique_ptr<Effect::EffectsGroup>>&& effects
 }
 
 float ShipHull::Speed() const
-{ return m_speed * GetGameRules().Get<double>("RULE_SHIP_SPEED_FACTOR"); }
+{ return m_speed * RULE_SHIP_SPEED_FACTOR.Get(); }
 
 float ShipHull::Structure() const
-{ return m_structure * GetGameRules().Get<double>("RULE_SHIP_STRUCTURE_FACTOR"); }
+{ return m_structure * RULE_SHIP_STRUCTURE_FACTOR.Get(); }
 
 unsigned int ShipHull::NumSlots(ShipSlotType slot_type) const {
     unsigned int count = 0;
@@ -264,7 +268,7 @@ unsigned int ShipHull::NumSlots(ShipSlotType slot_type) const {
 // Chances are, the same is true of buildings and techs as well.
 // TODO: Eliminate duplication
 bool ShipHull::ProductionCostTimeLocationInvariant() const {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get())
         return true;
     if (m_production_cost && !m_production_cost->LocalCandidateInvariant())
         return false;
@@ -276,7 +280,7 @@ bool ShipHull::ProductionCostTimeLocationInvariant() const {
 float ShipHull::ProductionCost(int empire_id, int location_id,
                                const ScriptingContext& parent_context, int in_design_id) const
 {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION") || !m_production_cost)
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get() || !m_production_cost)
         return 1.0f;
 
     if (m_production_cost->ConstantExpr())
@@ -305,7 +309,7 @@ float ShipHull::ProductionCost(int empire_id, int location_id,
 int ShipHull::ProductionTime(int empire_id, int location_id,
                                const ScriptingContext& parent_context, int in_design_id) const
 {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION") || !m_production_time)
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get() || !m_production_time)
         return 1;
 
     if (m_production_time->ConstantExpr())
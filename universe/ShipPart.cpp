@@ -20,6 +20,12 @@
                                         }   }
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_AND_FAST_SHIP_PRODUCTION{"RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"};
+    const RuleHandle<double> RULE_FIGHTER_DAMAGE_FACTOR{"RULE_FIGHTER_DAMAGE_FACTOR"};
+    const RuleHandle<double> RULE_SHIP_SPEED_FACTOR{"RULE_SHIP_SPEED_FACTOR"};
+    const RuleHandle<double> RULE_SHIP_STRUCTURE_FACTOR{"RULE_SHIP_STRUCTURE_FACTOR"};
+    const RuleHandle<double> RULE_SHIP_WEAPON_DAMAGE_FACTOR{"RULE_SHIP_WEAPON_DAMAGE_FACTOR"};
+
     const int ARBITRARY_LARGE_TURNS = 999999;
     const float ARBITRARY_LARGE_COST = 999999.9f;
 
@@ -354,14 +360,14 @@ bool ShipPart::operator==(const ShipPart& rhs) const {
 float ShipPart::Capacity() const {
     switch (m_class) {
     case ShipPartClass::PC_ARMOUR:
-        return m_capacity * GetGameRules().Get<double>("RULE_SHIP_STRUCTURE_FACTOR");
+        return m_capacity * RULE_SHIP_STRUCTURE_FACTOR.Get();
         break;
     case ShipPartClass::PC_DIRECT_WEAPON:
     case ShipPartClass::PC_SHIELD:
-        return m_capacity * GetGameRules().Get<double>("RULE_SHIP_WEAPON_DAMAGE_FACTOR");
+        return m_capacity * RULE_SHIP_WEAPON_DAMAGE_FACTOR.Get();
         break;
     case ShipPartClass::PC_SPEED:
-        return m_capacity * GetGameRules().Get<double>("RULE_SHIP_SPEED_FACTOR");
+        return m_capacity * RULE_SHIP_SPEED_FACTOR.Get();
         break;
     default:
         return m_capacity;
@@ -371,7 +377,7 @@ float ShipPart::Capacity() const {
 float ShipPart::SecondaryStat() const {
     switch (m_class) {
     case ShipPartClass::PC_FIGHTER_HANGAR:
-        return m_capacity * GetGameRules().Get<double>("RULE_FIGHTER_DAMAGE_FACTOR");
+        return m_capacity * RULE_FIGHTER_DAMAGE_FACTOR.Get();
         break;
     default:
         return m_secondary_stat;
@@ -419,7 +425,7 @@ bool ShipPart::CanMountInSlotType(ShipSlotType slot_type) const {
 }
 
 bool ShipPart::ProductionCostTimeLocationInvariant() const {
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION"))
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get())
         return true;
     if (m_production_cost && !m_production_cost->TargetInvariant())
         return false;
@@ -429,7 +435,7 @@ bool ShipPart::ProductionCostTimeLocationInvariant() const {
 }
 
 float ShipPart::ProductionCost(int empire_id, int location_id, int in_design_id) const {    // TODO: pass in ScriptingContext
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION") || !m_production_cost)
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get() || !m_production_cost)
         return 1.0f;
 
     if (m_production_cost->ConstantExpr()) {
@@ -452,7 +458,7 @@ float ShipPart::ProductionCost(int empire_id, int location_id, int in_design_id)
 }
 
 int ShipPart::ProductionTime(int empire_id, int location_id, int in_design_id) const {  // TODO: pass in ScriptingContext
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_SHIP_PRODUCTION") || !m_production_time)
+    if (RULE_CHEAP_AND_FAST_SHIP_PRODUCTION.Get() || !m_production_time)
         return 1;
 
     if (m_production_time->ConstantExpr()) {
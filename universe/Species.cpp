@@ -472,18 +472,18 @@ void SpeciesManager::SetSpeciesHomeworlds(std::map<std::string, std::set<int>>&&
 { m_species_homeworlds = std::move(species_homeworld_ids); }
 
 void SpeciesManager::SetSpeciesEmpireOpinions(std::map<std::string, std::map<int, float>>&& species_empire_opinions)
-{ m_species_empire_opinions = std::move(species_empire_opinions); }
+{ m_species_empire_opinions.Assign(species_empire_opinions); }
 
 void SpeciesManager::SetSpeciesEmpireOpinion(const std::string& species_name, int empire_id, float opinion)
-{ m_species_empire_opinions[species_name][empire_id] = opinion; }
+{ m_species_empire_opinions.Set(species_name, empire_id, opinion); }
 
 void SpeciesManager::SetSpeciesSpeciesOpinions(std::map<std::string,
                                                std::map<std::string, float>>&& species_species_opinions)
-{ m_species_species_opinions = std::move(species_species_opinions); }
+{ m_species_species_opinions.Assign(species_species_opinions); }
 
 void SpeciesManager::SetSpeciesSpeciesOpinion(const std::string& opinionated_species,
                                               const std::string& rated_species, float opinion)
-{ m_species_species_opinions[opinionated_species][rated_species] = opinion; }
+{ m_species_species_opinions.Set(opinionated_species, rated_species, opinion); }
 
 std::map<std::string, std::set<int>> SpeciesManager::GetSpeciesHomeworldsMap(int encoding_empire/* = ALL_EMPIRES*/) const {
     if (encoding_empire == ALL_EMPIRES)
@@ -492,39 +492,22 @@ std::map<std::string, std::set<int>> SpeciesManager::GetSpeciesHomeworldsMap(int
     return m_species_homeworlds;
 }
 
-const std::map<std::string, std::map<int, float>>& SpeciesManager::GetSpeciesEmpireOpinionsMap(int encoding_empire/* = ALL_EMPIRES*/) const
-{ return m_species_empire_opinions; }
+std::map<std::string, std::map<int, float>> SpeciesManager::GetSpeciesEmpireOpinionsMap(int encoding_empire/* = ALL_EMPIRES*/) const
+{ return m_species_empire_opinions.ToMap(); }
 
-const std::map<std::string, std::map<std::string, float>>& SpeciesManager::GetSpeciesSpeciesOpinionsMap(int encoding_empire/* = ALL_EMPIRES*/) const
-{ return m_species_species_opinions; }
+std::map<std::string, std::map<std::string, float>> SpeciesManager::GetSpeciesSpeciesOpinionsMap(int encoding_empire/* = ALL_EMPIRES*/) const
+{ return m_species_species_opinions.ToMap(); }
 
-float SpeciesManager::SpeciesEmpireOpinion(const std::string& species_name, int empire_id) const {
-    auto sp_it = m_species_empire_opinions.find(species_name);
-    if (sp_it == m_species_empire_opinions.end())
-        return 0.0f;
-    const std::map<int, float>& emp_map = sp_it->second;
-    auto emp_it = emp_map.find(empire_id);
-    if (emp_it == emp_map.end())
-        return 0.0f;
-    return emp_it->second;
-}
+float SpeciesManager::SpeciesEmpireOpinion(const std::string& species_name, int empire_id) const
+{ return m_species_empire_opinions.Get(species_name, empire_id); }
 
 float SpeciesManager::SpeciesSpeciesOpinion(const std::string& opinionated_species_name,
                                             const std::string& rated_species_name) const
-{
-    auto sp_it = m_species_species_opinions.find(opinionated_species_name);
-    if (sp_it == m_species_species_opinions.end())
-        return 0.0f;
-    const auto& ra_sp_map = sp_it->second;
-    auto ra_sp_it = ra_sp_map.find(rated_species_name);
-    if (ra_sp_it == ra_sp_map.end())
-        return 0.0f;
-    return ra_sp_it->second;
-}
+{ return m_species_species_opinions.Get(opinionated_species_name, rated_species_name); }
 
 void SpeciesManager::ClearSpeciesOpinions() {
-    m_species_empire_opinions.clear();
-    m_species_species_opinions.clear();
+    m_species_empire_opinions.Clear();
+    m_species_species_opinions.Clear();
 }
 
 void SpeciesManager::AddSpeciesHomeworld(std::string species, int homeworld_id) {
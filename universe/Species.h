@@ -11,6 +11,7 @@
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/optional/optional.hpp>
 #include "EnumsFwd.h"
+#include "OpinionMatrix.h"
 #include "../util/Enum.h"
 #include "../util/Export.h"
 #include "../util/Pending.h"
@@ -224,7 +225,7 @@ public:
 
     /** returns a map from species name to a map from empire id to each the
       * species' opinion of the empire */
-    const std::map<std::string, std::map<int, float>>&
+    std::map<std::string, std::map<int, float>>
         GetSpeciesEmpireOpinionsMap(int encoding_empire = ALL_EMPIRES) const;
 
     /** returns opinion of species with name \a species_name about empire with
@@ -233,7 +234,7 @@ public:
 
     /** returns a map from species name to a map from other species names to the
       * opinion of the first species about the other species. */
-    const std::map<std::string, std::map<std::string, float>>&
+    std::map<std::string, std::map<std::string, float>>
         GetSpeciesSpeciesOpinionsMap(int encoding_empire = ALL_EMPIRES) const;
 
     /** returns opinion of species with name \a opinionated_species_name about
@@ -284,8 +285,8 @@ private:
     static void CheckPendingSpeciesTypes();
 
     std::map<std::string, std::set<int>>                m_species_homeworlds;
-    std::map<std::string, std::map<int, float>>         m_species_empire_opinions;
-    std::map<std::string, std::map<std::string, float>> m_species_species_opinions;
+    OpinionMatrix<int>                                  m_species_empire_opinions;
+    OpinionMatrix<std::string>                          m_species_species_opinions;
     std::map<std::string, std::map<int, float>>         m_species_object_populations;
     std::map<std::string, std::map<std::string, int>>   m_species_species_ships_destroyed;
 
@@ -0,0 +1,83 @@
+#ifndef _StatRecords_h_
+#define _StatRecords_h_
+
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+
+/** The values of one statistic for one empire, by turn.  Statistics are
+    recorded once each turn, so the turns and values are kept in two parallel
+    vectors ordered by turn, which recording a new turn appends to.  This is
+    much more compact than a map from turn to value, in memory and in saved
+    games, which include the whole history of every statistic. */
+class StatSeries {
+public:
+    /** Sets the value for turn \a turn, replacing any earlier value for it. */
+    void Set(int turn, double value) {
+        if (m_turns.empty() || m_turns.back() < turn) {
+            m_turns.push_back(turn);
+            m_values.push_back(value);
+            return;
+        }
+        auto it = std::lower_bound(m_turns.begin(), m_turns.end(), turn);
+        auto value_it = m_values.begin() + std::distance(m_turns.begin(), it);
+        if (*it == turn) {
+            *value_it = value;
+        } else {
+            m_turns.insert(it, turn);
+            m_values.insert(value_it, value);
+        }
+    }
+
+    [[nodiscard]] const std::vector<int>& Turns() const noexcept { return m_turns; }
+    [[nodiscard]] const std::vector<double>& Values() const noexcept { return m_values; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_turns.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_turns.empty(); }
+
+    /** Returns the values indexed by turn. */
+    [[nodiscard]] std::map<int, double> ToMap() const {
+        std::map<int, double> retval;
+        for (std::size_t i = 0; i < m_turns.size(); ++i)
+            retval.emplace_hint(retval.end(), m_turns[i], m_values[i]);
+        return retval;
+    }
+
+    [[nodiscard]] std::size_t HeapBytes() const noexcept
+    { return m_turns.capacity() * sizeof(int) + m_values.capacity() * sizeof(double); }
+
+private:
+    std::vector<int>    m_turns;
+    std::vector<double> m_values;
+
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int version);
+};
+
+/** Statistics recorded for empires, indexed by statistic name and then by
+    empire id. */
+using StatRecords = std::map<std::string, std::map<int, StatSeries>>;
+
+
+template <typename Archive>
+void StatSeries::serialize(Archive& ar, const unsigned int version)
+{
+    ar  & boost::serialization::make_nvp("t", m_turns)
+        & boost::serialization::make_nvp("v", m_values);
+    if (Archive::is_loading::value && m_turns.size() != m_values.size()) {
+        const auto size = std::min(m_turns.size(), m_values.size());
+        m_turns.resize(size);
+        m_values.resize(size);
+    }
+}
+
+
+#endif
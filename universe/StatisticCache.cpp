@@ -0,0 +1,48 @@
+#include "StatisticCache.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "../util/Logger.h"
+
+
+StatisticCache::StatisticCache() = default;
+
+StatisticCache::~StatisticCache() = default;
+
+void StatisticCache::Clear() {
+    std::unique_lock lock(m_mutex);
+    m_entries.clear();
+}
+
+void StatisticCache::LogHitRates() const {
+    struct Counts {
+        std::size_t evaluations = 0;
+        std::size_t hits = 0;
+    };
+    std::map<std::string, Counts> content_counts;
+    Counts total;
+    for (const auto& [key, entry] : m_entries) {
+        (void)key;
+        const std::size_t hits = entry.hits;
+        auto& counts = content_counts[entry.content_name];
+        counts.evaluations += hits + 1;
+        counts.hits += hits;
+        total.evaluations += hits + 1;
+        total.hits += hits;
+    }
+    if (total.evaluations == 0)
+        return;
+
+    DebugLogger() << "StatisticCache: " << m_entries.size() << " cached values reused for "
+                  << total.hits << " of " << total.evaluations << " evaluations";
+
+    // contents with the most reuse first, which are those that benefit most
+    std::vector<std::pair<std::string, Counts>> sorted_counts(content_counts.begin(), content_counts.end());
+    std::sort(sorted_counts.begin(), sorted_counts.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.second.hits > rhs.second.hits; });
+    for (const auto& [content_name, counts] : sorted_counts) {
+        TraceLogger() << "StatisticCache: " << (content_name.empty() ? "(unknown content)" : content_name)
+                      << " reused " << counts.hits << " of " << counts.evaluations << " evaluations";
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef _StatisticCache_h_
+#define _StatisticCache_h_
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+#include <boost/variant.hpp>
+#include "../util/Export.h"
+
+
+namespace ValueRef {
+    struct ValueRefBase;
+    template <typename T>
+    struct ValueRef;
+}
+
+/** Values of Statistic ValueRefs, each found once and then reused in later
+    evaluations of an identical Statistic for the same source object.
+
+    Only Statistics whose values don't depend on the target, root candidate or
+    anything other than the source object and the gamestate should be cached.
+    As with ConditionMemo, changes to the gamestate aren't detected, so the
+    cache must be cleared whenever objects change.
+
+    Counts how often each cached Statistic is reused, by the content that it
+    is part of, which can be logged with LogHitRates().
+
+    Safe to use from multiple threads concurrently, except for Clear() and
+    LogHitRates(). */
+class FO_COMMON_API StatisticCache {
+public:
+    StatisticCache();
+    ~StatisticCache();
+
+    /** Returns the value of \a statistic for the object with id \a source_id,
+      * calling \a eval to find it if it isn't cached. \a content_name is the
+      * content that \a statistic is part of, for reporting hit rates. */
+    template <typename T, typename EvalFn>
+    [[nodiscard]] T Get(const ValueRef::ValueRef<T>& statistic, int source_id,
+                        const std::string& content_name, EvalFn&& eval);
+
+    /** Discards all cached values. */
+    void Clear();
+
+    /** Logs how many evaluations of cached Statistics there have been since
+      * the last Clear(), for each content, and how many reused cached values. */
+    void LogHitRates() const;
+
+private:
+    using Value = boost::variant<int, double, std::string>;
+
+    // limits the memory used for cached values, so that the cache can't grow
+    // without bound if many distinct sources evaluate cached Statistics
+    static constexpr std::size_t MAX_ENTRIES = 65536;
+
+    struct Entry {
+        Entry(std::shared_ptr<const ValueRef::ValueRefBase> statistic_, int source_id_,
+              Value value_, const std::string& content_name_) :
+            statistic(std::move(statistic_)),
+            source_id(source_id_),
+            value(std::move(value_)),
+            content_name(content_name_)
+        {}
+
+        std::shared_ptr<const ValueRef::ValueRefBase> statistic;    ///< copy of the cached Statistic, to distinguish those with equal checksums
+        int                                           source_id;
+        Value                                         value;
+        std::string                                   content_name;
+        mutable std::atomic<std::size_t>              hits{0};
+    };
+
+    template <typename T>
+    [[nodiscard]] const Entry* Find(std::size_t key, const ValueRef::ValueRef<T>& statistic, int source_id) const;
+
+    std::shared_mutex                               m_mutex;
+    std::unordered_multimap<std::size_t, Entry>     m_entries;  ///< indexed by hash of Statistic checksum and source id
+};
+
+template <typename T>
+const StatisticCache::Entry* StatisticCache::Find(std::size_t key, const ValueRef::ValueRef<T>& statistic,
+                                                  int source_id) const
+{
+    auto [it, end_it] = m_entries.equal_range(key);
+    for (; it != end_it; ++it) {
+        const auto& entry = it->second;
+        if (entry.source_id != source_id)
+            continue;
+        auto entry_statistic = dynamic_cast<const ValueRef::ValueRef<T>*>(entry.statistic.get());
+        if (entry_statistic && *entry_statistic == statistic)
+            return &entry;
+    }
+    return nullptr;
+}
+
+template <typename T, typename EvalFn>
+T StatisticCache::Get(const ValueRef::ValueRef<T>& statistic, int source_id,
+                      const std::string& content_name, EvalFn&& eval)
+{
+    std::size_t key = statistic.GetCheckSum();
+    boost::hash_combine(key, source_id);
+
+    {
+        std::shared_lock lock(m_mutex);
+        if (const auto* entry = Find(key, statistic, source_id)) {
+            ++entry->hits;
+            return boost::get<T>(entry->value);
+        }
+    }
+
+    // evaluate without holding the lock, as evaluating the statistic may
+    // involve evaluating other cached statistics
+    T value = eval();
+
+    std::unique_lock lock(m_mutex);
+    if (const auto* entry = Find(key, statistic, source_id)) {
+        ++entry->hits;  // another thread got there first
+        return boost::get<T>(entry->value);
+    }
+    if (m_entries.size() < MAX_ENTRIES)
+        m_entries.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::shared_ptr<const ValueRef::ValueRef<T>>(statistic.Clone()),
+                                                source_id, value, content_name));
+    return value;
+}
+
+
+#endif
@@ -286,7 +286,7 @@ int System::Owner() const {
     return first_owner_found;
 }
 
-const std::set<int>& System::ContainedObjectIDs() const
+const ObjectIDSet& System::ContainedObjectIDs() const
 { return m_objects; }
 
 bool System::Contains(int object_id) const {
@@ -400,6 +400,35 @@ void System::Remove(int id) {
     if (id == INVALID_OBJECT_ID)
         return;
 
+    if (EraseObject(id)) {
+        if (auto fleet = Objects().get<Fleet>(id))
+            FleetsRemovedSignal({fleet});
+    }
+    StateChangedSignal();
+}
+
+void System::Remove(const std::vector<int>& ids) {
+    std::vector<std::shared_ptr<Fleet>> removed_fleets;
+    bool removed_any = false;
+
+    for (int id : ids) {
+        if (id == INVALID_OBJECT_ID)
+            continue;
+        removed_any = true;
+        if (EraseObject(id)) {
+            if (auto fleet = Objects().get<Fleet>(id))
+                removed_fleets.push_back(std::move(fleet));
+        }
+    }
+    if (!removed_any)
+        return;
+
+    if (!removed_fleets.empty())
+        FleetsRemovedSignal(removed_fleets);
+    StateChangedSignal();
+}
+
+bool System::EraseObject(int id) {
     bool removed_fleet = false;
 
     auto it = m_fleets.find(id);
@@ -421,11 +450,7 @@ void System::Remove(int id) {
     m_buildings.erase(id);
     m_objects.erase(id);
 
-    if (removed_fleet) {
-        if (auto fleet = Objects().get<Fleet>(id))
-            FleetsRemovedSignal({fleet});
-    }
-    StateChangedSignal();
+    return removed_fleet;
 }
 
 void System::SetStarType(StarType type) {
@@ -58,7 +58,7 @@ public:
 
     std::string Dump(unsigned short ntabs = 0) const override;
 
-    const std::set<int>& ContainedObjectIDs() const override;
+    const ObjectIDSet& ContainedObjectIDs() const override;
 
     bool Contains(int object_id) const override;
 
@@ -86,12 +86,12 @@ public:
     bool                    HasStarlaneTo(int id) const;                ///< returns true if there is a starlane from this system to the system with ID number \a id
     bool                    HasWormholeTo(int id) const;                ///< returns true if there is a wormhole from this system to the system with ID number \a id
 
-    const std::set<int>&    ObjectIDs() const               { return m_objects; }
-    const std::set<int>&    PlanetIDs() const               { return m_planets; }
-    const std::set<int>&    BuildingIDs() const             { return m_buildings; }
-    const std::set<int>&    FleetIDs() const                { return m_fleets; }
-    const std::set<int>&    ShipIDs() const                 { return m_ships; }
-    const std::set<int>&    FieldIDs() const                { return m_fields; }
+    const ObjectIDSet&      ObjectIDs() const               { return m_objects; }
+    const ObjectIDSet&      PlanetIDs() const               { return m_planets; }
+    const ObjectIDSet&      BuildingIDs() const             { return m_buildings; }
+    const ObjectIDSet&      FleetIDs() const                { return m_fleets; }
+    const ObjectIDSet&      ShipIDs() const                 { return m_ships; }
+    const ObjectIDSet&      FieldIDs() const                { return m_fields; }
     const std::vector<int>& PlanetIDsByOrbit() const        { return m_orbits; }
 
     int                     PlanetInOrbit(int orbit) const;             ///< returns the ID of the planet in the specified \a orbit, or INVALID_OBJECT_ID if there is no planet in that orbit or it is an invalid orbit
@@ -131,6 +131,10 @@ public:
     /** removes the object with ID number \a id from this system. */
     void Remove(int id);
 
+    /** removes the objects with ID numbers in \a ids from this system,
+      * signalling the removals once for all of them. */
+    void Remove(const std::vector<int>& ids);
+
     void SetStarType(StarType type);     ///< sets the type of the star in this Systems to \a StarType
     void AddStarlane(int id);            ///< adds a starlane between this system and the system with ID number \a id.  \note Adding a starlane to a system to which there is already a wormhole erases the wormhole; you may want to check for a wormhole before calling this function.
     void AddWormhole(int id);            ///< adds a wormhole between this system and the system with ID number \a id  \note Adding a wormhole to a system to which there is already a starlane erases the starlane; you may want to check for a starlane before calling this function.
@@ -158,14 +162,18 @@ protected:
     System* Clone(int empire_id = ALL_EMPIRES) const override;
 
 private:
+    /** removes the object with ID number \a id from this system's contents,
+      * without signalling. returns true if the object was a fleet. */
+    bool EraseObject(int id);
+
     StarType            m_star;
     std::vector<int>    m_orbits = std::vector<int>(SYSTEM_ORBITS, INVALID_OBJECT_ID);  ///< indexed by orbit number, indicates the id of the planet in that orbit
-    std::set<int>       m_objects;
-    std::set<int>       m_planets;
-    std::set<int>       m_buildings;
-    std::set<int>       m_fleets;
-    std::set<int>       m_ships;
-    std::set<int>       m_fields;
+    ObjectIDSet         m_objects;
+    ObjectIDSet         m_planets;
+    ObjectIDSet         m_buildings;
+    ObjectIDSet         m_fleets;
+    ObjectIDSet         m_ships;
+    ObjectIDSet         m_fields;
     std::map<int, bool> m_starlanes_wormholes;      ///< the ints represent the IDs of other connected systems; the bools indicate whether the connection is a wormhole (true) or a starlane (false)
     int                 m_last_turn_battle_here = INVALID_GAME_TURN;  ///< the turn on which there was last a battle in this system
 
@@ -0,0 +1,371 @@
+#include "SystemRegions.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include "../util/ThreadPool.h"
+
+
+namespace {
+    constexpr double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+    const std::vector<std::size_t> EMPTY_VERTICES;
+
+    /** Edge between border vertices, in the graph of border vertices. */
+    struct BorderEdge {
+        std::uint32_t   target = 0;
+        double          weight = 0.0;
+        std::int16_t    jumps = 0;
+    };
+
+    /** Runs \a function(ii) for each \a ii in [0, \a count), in parallel. */
+    void ParallelFor(std::size_t count, const std::function<void (std::size_t)>& function,
+                     const std::string& name)
+    {
+        constexpr std::size_t ITEMS_PER_TASK = 16;
+        TaskBatch batch(name);
+        for (std::size_t first = 0; first < count; first += ITEMS_PER_TASK) {
+            batch.Post([&function, first, last{std::min(count, first + ITEMS_PER_TASK)}]() {
+                for (std::size_t ii = first; ii < last; ++ii)
+                    function(ii);
+            });
+        }
+        batch.Wait();
+    }
+}
+
+SystemRegions::SystemRegions(const Adjacency& adjacency, std::size_t target_region_size) {
+    Partition(adjacency, std::max<std::size_t>(1, target_region_size));
+    Precompute(adjacency);
+}
+
+SystemRegions::SystemRegions(const Adjacency& adjacency, const SystemRegions& partition) :
+    m_region_of(partition.m_region_of),
+    m_region_pos(partition.m_region_pos),
+    m_regions(partition.m_regions)
+{
+    if (m_region_of.size() != adjacency.size()) {
+        // partition was made for a different graph, so make a new one
+        m_region_of.clear();
+        m_region_pos.clear();
+        m_regions.clear();
+        Partition(adjacency, partition.m_regions.empty() ? 1 :
+                  std::max<std::size_t>(1, partition.m_region_of.size() / partition.m_regions.size()));
+    }
+    Precompute(adjacency);
+}
+
+std::size_t SystemRegions::RegionOf(std::size_t vertex) const
+{ return vertex < m_region_of.size() ? m_region_of[vertex] : NO_REGION; }
+
+const std::vector<std::size_t>& SystemRegions::RegionVertices(std::size_t region) const
+{ return region < m_regions.size() ? m_regions[region] : EMPTY_VERTICES; }
+
+void SystemRegions::Partition(const Adjacency& adjacency, std::size_t target_region_size) {
+    const std::size_t num_vertices = adjacency.size();
+    m_region_of.assign(num_vertices, NO_REGION);
+    m_region_pos.assign(num_vertices, 0);
+
+    std::deque<std::size_t> frontier;
+    for (std::size_t seed = 0; seed < num_vertices; ++seed) {
+        if (m_region_of[seed] != NO_REGION)
+            continue;
+
+        const std::size_t region = m_regions.size();
+        auto& vertices = m_regions.emplace_back();
+        m_region_of[seed] = region;
+        vertices.push_back(seed);
+        frontier.assign(1, seed);
+
+        while (!frontier.empty() && vertices.size() < target_region_size) {
+            const std::size_t vertex = frontier.front();
+            frontier.pop_front();
+            for (const auto& edge : adjacency[vertex]) {
+                if (vertices.size() >= target_region_size)
+                    break;
+                if (edge.target >= num_vertices || m_region_of[edge.target] != NO_REGION)
+                    continue;
+                m_region_of[edge.target] = region;
+                vertices.push_back(edge.target);
+                frontier.push_back(edge.target);
+            }
+        }
+    }
+
+    for (auto& vertices : m_regions) {
+        std::sort(vertices.begin(), vertices.end());
+        for (std::size_t pos = 0; pos < vertices.size(); ++pos)
+            m_region_pos[vertices[pos]] = pos;
+    }
+}
+
+void SystemRegions::Precompute(const Adjacency& adjacency) {
+    const std::size_t num_vertices = adjacency.size();
+    const std::size_t num_regions = m_regions.size();
+
+    // within each region, find distances and jumps between all pairs of its
+    // vertices using only edges within the region
+    m_local_offsets.assign(num_regions, 0);
+    std::size_t local_size = 0;
+    for (std::size_t region = 0; region < num_regions; ++region) {
+        m_local_offsets[region] = local_size;
+        local_size += m_regions[region].size() * m_regions[region].size();
+    }
+    m_local_distances.assign(local_size, UNREACHABLE);
+    m_local_predecessors.assign(local_size, NO_PREDECESSOR);
+    m_local_jumps.assign(local_size, NO_JUMPS);
+
+    ParallelFor(num_regions, [this, &adjacency](std::size_t region) {
+        const auto& vertices = m_regions[region];
+        using QueueEntry = std::pair<double, std::uint32_t>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+        std::vector<bool> settled(vertices.size());
+        std::deque<std::uint32_t> frontier;
+
+        for (std::size_t source_pos = 0; source_pos < vertices.size(); ++source_pos) {
+            std::fill(settled.begin(), settled.end(), false);
+            m_local_distances[LocalIdx(region, source_pos, source_pos)] = 0.0;
+            queue.emplace(0.0, static_cast<std::uint32_t>(source_pos));
+            while (!queue.empty()) {
+                const auto [distance, pos] = queue.top();
+                queue.pop();
+                if (settled[pos])
+                    continue;
+                settled[pos] = true;
+                for (const auto& edge : adjacency[vertices[pos]]) {
+                    if (edge.target >= m_region_of.size() || m_region_of[edge.target] != region)
+                        continue;
+                    const auto next_pos = static_cast<std::uint32_t>(m_region_pos[edge.target]);
+                    const std::size_t idx = LocalIdx(region, source_pos, next_pos);
+                    if (settled[next_pos] || m_local_distances[idx] <= distance + edge.weight)
+                        continue;
+                    m_local_distances[idx] = distance + edge.weight;
+                    m_local_predecessors[idx] = pos;
+                    queue.emplace(distance + edge.weight, next_pos);
+                }
+            }
+
+            m_local_jumps[LocalIdx(region, source_pos, source_pos)] = 0;
+            frontier.assign(1, static_cast<std::uint32_t>(source_pos));
+            while (!frontier.empty()) {
+                const std::uint32_t pos = frontier.front();
+                frontier.pop_front();
+                const auto jumps = m_local_jumps[LocalIdx(region, source_pos, pos)];
+                for (const auto& edge : adjacency[vertices[pos]]) {
+                    if (edge.target >= m_region_of.size() || m_region_of[edge.target] != region)
+                        continue;
+                    const std::size_t idx = LocalIdx(region, source_pos, m_region_pos[edge.target]);
+                    if (m_local_jumps[idx] != NO_JUMPS)
+                        continue;
+                    m_local_jumps[idx] = jumps + 1;
+                    frontier.push_back(static_cast<std::uint32_t>(m_region_pos[edge.target]));
+                }
+            }
+        }
+    }, "SystemRegions::Precompute local");
+
+    // border vertices are those with an edge to another region
+    m_border_vertices.clear();
+    m_border_index.assign(num_vertices, NO_PREDECESSOR);
+    m_region_borders.assign(num_regions, {});
+    for (std::size_t vertex = 0; vertex < num_vertices; ++vertex) {
+        const bool border = std::any_of(adjacency[vertex].begin(), adjacency[vertex].end(),
+                                        [this, vertex](const Edge& edge) {
+                                            return edge.target < m_region_of.size() &&
+                                                   m_region_of[edge.target] != m_region_of[vertex];
+                                        });
+        if (!border)
+            continue;
+        m_border_index[vertex] = static_cast<std::uint32_t>(m_border_vertices.size());
+        m_region_borders[m_region_of[vertex]].push_back(m_border_vertices.size());
+        m_border_vertices.push_back(vertex);
+    }
+    const std::size_t num_borders = m_border_vertices.size();
+
+    // graph of border vertices, with edges between the border vertices of
+    // each region for the paths within the region between them, and for the
+    // edges between regions
+    std::vector<std::vector<BorderEdge>> border_adjacency(num_borders);
+    for (std::size_t border = 0; border < num_borders; ++border) {
+        const std::size_t vertex = m_border_vertices[border];
+        const std::size_t region = m_region_of[vertex];
+        for (std::size_t other_border : m_region_borders[region]) {
+            const std::size_t idx = LocalIdx(region, m_region_pos[vertex], m_region_pos[m_border_vertices[other_border]]);
+            if (other_border == border || m_local_distances[idx] == UNREACHABLE)
+                continue;
+            border_adjacency[border].push_back({static_cast<std::uint32_t>(other_border),
+                                                m_local_distances[idx], m_local_jumps[idx]});
+        }
+        for (const auto& edge : adjacency[vertex]) {
+            if (edge.target >= m_region_of.size() || m_region_of[edge.target] == region)
+                continue;
+            border_adjacency[border].push_back({m_border_index[edge.target], edge.weight, 1});
+        }
+    }
+
+    // distances and jumps between all pairs of border vertices
+    m_border_distances.assign(num_borders * num_borders, UNREACHABLE);
+    m_border_predecessors.assign(num_borders * num_borders, NO_PREDECESSOR);
+    m_border_jumps.assign(num_borders * num_borders, NO_JUMPS);
+
+    ParallelFor(num_borders, [this, &border_adjacency, num_borders](std::size_t source) {
+        using DistanceEntry = std::pair<double, std::uint32_t>;
+        std::priority_queue<DistanceEntry, std::vector<DistanceEntry>, std::greater<DistanceEntry>> queue;
+        std::vector<bool> settled(num_borders);
+
+        m_border_distances[BorderIdx(source, source)] = 0.0;
+        queue.emplace(0.0, static_cast<std::uint32_t>(source));
+        while (!queue.empty()) {
+            const auto [distance, border] = queue.top();
+            queue.pop();
+            if (settled[border])
+                continue;
+            settled[border] = true;
+            for (const auto& edge : border_adjacency[border]) {
+                const std::size_t idx = BorderIdx(source, edge.target);
+                if (settled[edge.target] || m_border_distances[idx] <= distance + edge.weight)
+                    continue;
+                m_border_distances[idx] = distance + edge.weight;
+                m_border_predecessors[idx] = border;
+                queue.emplace(distance + edge.weight, edge.target);
+            }
+        }
+
+        using JumpsEntry = std::pair<int, std::uint32_t>;
+        std::priority_queue<JumpsEntry, std::vector<JumpsEntry>, std::greater<JumpsEntry>> jumps_queue;
+        std::fill(settled.begin(), settled.end(), false);
+
+        m_border_jumps[BorderIdx(source, source)] = 0;
+        jumps_queue.emplace(0, static_cast<std::uint32_t>(source));
+        while (!jumps_queue.empty()) {
+            const auto [jumps, border] = jumps_queue.top();
+            jumps_queue.pop();
+            if (settled[border])
+                continue;
+            settled[border] = true;
+            for (const auto& edge : border_adjacency[border]) {
+                const std::size_t idx = BorderIdx(source, edge.target);
+                const int next_jumps = jumps + edge.jumps;
+                if (settled[edge.target] || m_border_jumps[idx] <= next_jumps || next_jumps >= NO_JUMPS)
+                    continue;
+                m_border_jumps[idx] = static_cast<std::int16_t>(next_jumps);
+                jumps_queue.emplace(next_jumps, edge.target);
+            }
+        }
+    }, "SystemRegions::Precompute borders");
+}
+
+void SystemRegions::AppendLocalPath(std::size_t source, std::size_t target, std::vector<std::size_t>& path) const {
+    const std::size_t region = m_region_of[source];
+    const auto& vertices = m_regions[region];
+    const std::size_t source_pos = m_region_pos[source];
+    const std::size_t first_appended = path.size();
+    for (std::size_t pos = m_region_pos[target]; pos != source_pos;
+         pos = m_local_predecessors[LocalIdx(region, source_pos, pos)])
+    { path.push_back(vertices[pos]); }
+    std::reverse(path.begin() + first_appended, path.end());
+}
+
+std::pair<std::vector<std::size_t>, double> SystemRegions::ShortestPath(std::size_t source,
+                                                                        std::size_t target) const
+{
+    std::pair<std::vector<std::size_t>, double> retval{{}, -1.0};
+    if (source >= m_region_of.size() || target >= m_region_of.size())
+        return retval;
+    if (source == target) {
+        retval.first.push_back(source);
+        retval.second = 0.0;
+        return retval;
+    }
+
+    const std::size_t source_region = m_region_of[source];
+    const std::size_t target_region = m_region_of[target];
+    const std::size_t source_pos = m_region_pos[source];
+    const std::size_t target_pos = m_region_pos[target];
+
+    // a path within the region, if both vertices are in the same one
+    double best_distance = (source_region == target_region) ?
+        m_local_distances[LocalIdx(source_region, source_pos, target_pos)] : UNREACHABLE;
+    std::size_t best_exit = NO_REGION, best_entry = NO_REGION;
+
+    // paths that leave the source region and enter the target region
+    for (std::size_t exit : m_region_borders[source_region]) {
+        const std::size_t exit_pos = m_region_pos[m_border_vertices[exit]];
+        const double exit_distance = m_local_distances[LocalIdx(source_region, source_pos, exit_pos)];
+        if (exit_distance >= best_distance)
+            continue;
+        for (std::size_t entry : m_region_borders[target_region]) {
+            const std::size_t entry_pos = m_region_pos[m_border_vertices[entry]];
+            const double distance = exit_distance + m_border_distances[BorderIdx(exit, entry)] +
+                m_local_distances[LocalIdx(target_region, entry_pos, target_pos)];
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_exit = exit;
+                best_entry = entry;
+            }
+        }
+    }
+
+    if (best_distance == UNREACHABLE)
+        return retval;
+
+    auto& path = retval.first;
+    path.push_back(source);
+    if (best_exit == NO_REGION) {
+        AppendLocalPath(source, target, path);
+    } else {
+        AppendLocalPath(source, m_border_vertices[best_exit], path);
+
+        // border vertices between the exit and entry, in reverse order
+        std::vector<std::size_t> borders;
+        for (std::size_t border = best_entry; border != best_exit;
+             border = m_border_predecessors[BorderIdx(best_exit, border)])
+        { borders.push_back(border); }
+
+        std::size_t previous = m_border_vertices[best_exit];
+        for (auto it = borders.rbegin(); it != borders.rend(); ++it) {
+            const std::size_t vertex = m_border_vertices[*it];
+            if (m_region_of[vertex] == m_region_of[previous])
+                AppendLocalPath(previous, vertex, path);
+            else
+                path.push_back(vertex);
+            previous = vertex;
+        }
+        AppendLocalPath(previous, target, path);
+    }
+    retval.second = best_distance;
+    return retval;
+}
+
+int SystemRegions::Jumps(std::size_t source, std::size_t target) const {
+    if (source >= m_region_of.size() || target >= m_region_of.size())
+        return -1;
+    if (source == target)
+        return 0;
+
+    const std::size_t source_region = m_region_of[source];
+    const std::size_t target_region = m_region_of[target];
+    const std::size_t source_pos = m_region_pos[source];
+    const std::size_t target_pos = m_region_pos[target];
+
+    int best_jumps = (source_region == target_region) ?
+        m_local_jumps[LocalIdx(source_region, source_pos, target_pos)] : NO_JUMPS;
+
+    for (std::size_t exit : m_region_borders[source_region]) {
+        const int exit_jumps = m_local_jumps[LocalIdx(source_region, source_pos, m_region_pos[m_border_vertices[exit]])];
+        if (exit_jumps >= best_jumps)
+            continue;
+        for (std::size_t entry : m_region_borders[target_region]) {
+            const int border_jumps = m_border_jumps[BorderIdx(exit, entry)];
+            const int entry_jumps = m_local_jumps[LocalIdx(target_region, m_region_pos[m_border_vertices[entry]], target_pos)];
+            if (border_jumps == NO_JUMPS || entry_jumps == NO_JUMPS)
+                continue;
+            best_jumps = std::min(best_jumps, exit_jumps + border_jumps + entry_jumps);
+        }
+    }
+
+    return best_jumps >= NO_JUMPS ? -1 : best_jumps;
+}
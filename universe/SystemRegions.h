@@ -0,0 +1,105 @@
+#ifndef _SystemRegions_h_
+#define _SystemRegions_h_
+
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../util/Export.h"
+
+
+/** Two-level hierarchy of a graph of systems, for answering shortest path and
+    jump distance queries on large graphs without searching the whole graph.
+
+    The vertices are partitioned into regions of connected vertices.  Within
+    each region, the distances and jumps between all pairs of its vertices are
+    precomputed, as are those between all pairs of border vertices, which are
+    the vertices with an edge to another region.  Any path between vertices
+    in different regions leaves the first region through one of its border
+    vertices and enters the last region through one of its border vertices,
+    so the shortest such path can be found from these tables alone, and is as
+    short as the shortest path found by searching the whole graph.
+
+    Immutable once constructed, so safe to query from multiple threads. */
+class FO_COMMON_API SystemRegions {
+public:
+    struct Edge {
+        std::size_t target = 0;
+        double      weight = 0.0;
+    };
+    /** edges out of each vertex, indexed by vertex.  edges of undirected
+      * graphs should appear in the adjacency of both of their vertices. */
+    using Adjacency = std::vector<std::vector<Edge>>;
+
+    static constexpr std::size_t NO_REGION = static_cast<std::size_t>(-1);
+
+    /** Partitions the vertices of \a adjacency into regions of up to about
+      * \a target_region_size vertices, and precomputes distances. */
+    SystemRegions(const Adjacency& adjacency, std::size_t target_region_size);
+
+    /** Uses the same regions as \a partition, which must have been made for
+      * a graph with the same vertices, such as a supergraph of
+      * \a adjacency, and precomputes distances on \a adjacency. */
+    SystemRegions(const Adjacency& adjacency, const SystemRegions& partition);
+
+    [[nodiscard]] std::size_t NumVertices() const { return m_region_of.size(); }
+    [[nodiscard]] std::size_t NumRegions() const { return m_regions.size(); }
+    [[nodiscard]] std::size_t NumBorderVertices() const { return m_border_vertices.size(); }
+
+    /** Returns the region of \a vertex, or NO_REGION if there is no such vertex. */
+    [[nodiscard]] std::size_t RegionOf(std::size_t vertex) const;
+
+    /** Returns the vertices in \a region, in increasing order, or nothing if
+      * there is no such region. */
+    [[nodiscard]] const std::vector<std::size_t>& RegionVertices(std::size_t region) const;
+
+    /** Returns the vertices on a shortest path from \a source to \a target,
+      * including both, and its length.  If there is no path, the vertices are
+      * empty and the length is -1.0 */
+    [[nodiscard]] std::pair<std::vector<std::size_t>, double> ShortestPath(std::size_t source,
+                                                                           std::size_t target) const;
+
+    /** Returns the fewest edges on any path from \a source to \a target, or
+      * -1 if there is no path. */
+    [[nodiscard]] int Jumps(std::size_t source, std::size_t target) const;
+
+private:
+    static constexpr std::uint32_t NO_PREDECESSOR = static_cast<std::uint32_t>(-1);
+    static constexpr std::int16_t  NO_JUMPS = INT16_MAX;
+
+    /** Assigns each vertex of \a adjacency to a region, by growing regions
+      * breadth first from the lowest unassigned vertex. */
+    void Partition(const Adjacency& adjacency, std::size_t target_region_size);
+    void Precompute(const Adjacency& adjacency);
+
+    /** Distance, predecessor and jump tables between the vertices of a region,
+      * indexed by source * size + target, where source and target are the
+      * vertices' positions in the region. */
+    [[nodiscard]] std::size_t LocalIdx(std::size_t region, std::size_t source_pos, std::size_t target_pos) const
+    { return m_local_offsets[region] + source_pos * m_regions[region].size() + target_pos; }
+    [[nodiscard]] std::size_t BorderIdx(std::size_t source_border, std::size_t target_border) const
+    { return source_border * m_border_vertices.size() + target_border; }
+
+    /** Appends the vertices after \a source on the shortest path within their
+      * region from \a source to \a target to \a path. */
+    void AppendLocalPath(std::size_t source, std::size_t target, std::vector<std::size_t>& path) const;
+
+    std::vector<std::size_t>                m_region_of;        ///< indexed by vertex
+    std::vector<std::size_t>                m_region_pos;       ///< position of each vertex in its region's vertices
+    std::vector<std::vector<std::size_t>>   m_regions;          ///< vertices of each region
+    std::vector<std::size_t>                m_local_offsets;    ///< indexed by region
+    std::vector<double>                     m_local_distances;
+    std::vector<std::uint32_t>              m_local_predecessors;   ///< region position of the predecessor of the target
+    std::vector<std::int16_t>               m_local_jumps;
+
+    std::vector<std::size_t>                m_border_vertices;
+    std::vector<std::uint32_t>              m_border_index;     ///< index into m_border_vertices of each vertex, or NO_PREDECESSOR if it isn't a border vertex
+    std::vector<std::vector<std::size_t>>   m_region_borders;   ///< indices into m_border_vertices of each region's border vertices
+    std::vector<double>                     m_border_distances;     ///< indexed by BorderIdx
+    std::vector<std::uint32_t>              m_border_predecessors;  ///< border index of the border vertex before the target
+    std::vector<std::int16_t>               m_border_jumps;
+};
+
+
+#endif
@@ -17,6 +17,8 @@
 
 
 namespace {
+    const RuleHandle<bool> RULE_CHEAP_AND_FAST_TECH_RESEARCH{"RULE_CHEAP_AND_FAST_TECH_RESEARCH"};
+
     #define UserStringNop(key) key
 
     void AddRules(GameRules& rules) {
@@ -282,7 +284,7 @@ std::string Tech::Dump(unsigned short ntabs) const {
 float Tech::ResearchCost(int empire_id) const {
     const auto ARBITRARY_LARGE_COST = 999999.9f;
 
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_TECH_RESEARCH") || !m_research_cost) {
+    if (RULE_CHEAP_AND_FAST_TECH_RESEARCH.Get() || !m_research_cost) {
         return 1.0;
 
     } else if (m_research_cost->ConstantExpr()) {
@@ -308,7 +310,7 @@ float Tech::PerTurnCost(int empire_id) const
 int Tech::ResearchTime(int empire_id) const {
     const auto ARBITRARY_LARGE_TURNS = 9999;
 
-    if (GetGameRules().Get<bool>("RULE_CHEAP_AND_FAST_TECH_RESEARCH") || !m_research_turns) {
+    if (RULE_CHEAP_AND_FAST_TECH_RESEARCH.Get() || !m_research_turns) {
         return 1;
 
     } else if (m_research_turns->ConstantExpr()) {
@@ -362,6 +364,13 @@ const Tech* TechManager::GetTech(const std::string& name) const {
     return it == m_techs.get<NameIndex>().end() ? nullptr : it->get();
 }
 
+const Tech* TechManager::GetTechByIndex(int index) const {
+    CheckPendingTechs();
+    if (index < 0 || index >= static_cast<int>(m_techs_by_index.size()))
+        return nullptr;
+    return m_techs_by_index[index];
+}
+
 const TechCategory* TechManager::GetTechCategory(const std::string& name) const {
     CheckPendingTechs();
     auto it = m_categories.find(name);
@@ -527,6 +536,26 @@ void TechManager::CheckPendingTechs() const {
         }
     }
 
+    // number techs in name order, and record their prerequisite and unlocked
+    // techs by number, for use by code that keeps per-tech data in vectors
+    m_techs_by_index.clear();
+    m_techs_by_index.reserve(m_techs.size());
+    for (const auto& tech : m_techs.get<NameIndex>()) {
+        const_cast<Tech*>(tech.get())->m_index = static_cast<int>(m_techs_by_index.size());
+        m_techs_by_index.push_back(tech.get());
+    }
+    for (const Tech* tech : m_techs_by_index) {
+        Tech* mutable_tech = const_cast<Tech*>(tech);
+        mutable_tech->m_prerequisite_indices.clear();
+        for (const std::string& prereq : tech->Prerequisites())
+            if (const Tech* prereq_tech = GetTech(prereq))
+                mutable_tech->m_prerequisite_indices.push_back(prereq_tech->m_index);
+        mutable_tech->m_unlocked_tech_indices.clear();
+        for (const std::string& unlocked : tech->UnlockedTechs())
+            if (const Tech* unlocked_tech = GetTech(unlocked))
+                mutable_tech->m_unlocked_tech_indices.push_back(unlocked_tech->m_index);
+    }
+
     std::string redundant_dependency = FindRedundantDependency();
     if (!redundant_dependency.empty())
         ErrorLogger() << redundant_dependency;
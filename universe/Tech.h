@@ -104,6 +104,15 @@ public:
 
     const std::set<std::string>&    UnlockedTechs() const { return m_unlocked_techs; }  //!< returns the set of names of all techs for which this one is a prerequisite
 
+    /** Returns the position of this tech among all techs loaded into the
+      * TechManager, which is in [0, GetTechManager().size()), or -1 if this
+      * tech hasn't been loaded.  Allows per-tech data to be held in vectors
+      * rather than in maps keyed by tech name. */
+    int                             Index() const { return m_index; }
+
+    const std::vector<int>&         PrerequisiteIndices() const { return m_prerequisite_indices; }  //!< returns the Index() of each of this tech's prerequisites
+    const std::vector<int>&         UnlockedTechIndices() const { return m_unlocked_tech_indices; } //!< returns the Index() of each tech for which this one is a prerequisite
+
     /** Returns a number, calculated from the contained data, which should be
       * different for different contained data, and must be the same for
       * the same contained data, and must be the same on different platforms
@@ -130,6 +139,9 @@ private:
     std::vector<UnlockableItem>     m_unlocked_items;
     std::string                     m_graphic;
     std::set<std::string>           m_unlocked_techs;
+    int                             m_index = -1;
+    std::vector<int>                m_prerequisite_indices;
+    std::vector<int>                m_unlocked_tech_indices;
 
     friend class TechManager;
 };
@@ -192,6 +204,9 @@ public:
     /** returns the tech with the name \a name; you should use the free function GetTech() instead */
     const Tech*                     GetTech(const std::string& name) const;
 
+    /** returns the tech whose Index() is \a index, or nullptr if there is no such tech */
+    const Tech*                     GetTechByIndex(int index) const;
+
     /** returns the tech category with the name \a name; you should use the free function GetTechCategory() instead */
     const TechCategory*             GetTechCategory(const std::string& name) const;
 
@@ -285,6 +300,7 @@ private:
 
     mutable TechCategoryMap m_categories;
     mutable TechContainer   m_techs;
+    mutable std::vector<const Tech*> m_techs_by_index;
 
     static TechManager*     s_instance;
 };
@@ -1,12 +1,15 @@
 #include "Universe.h"
 
 #include <boost/algorithm/string.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/property_map/property_map.hpp>
+#include <future>
+#include <mutex>
 #include "BuildingType.h"
 #include "Building.h"
 #include "Conditions.h"
 #include "Effect.h"
-#include "Encyclopedia.h"
 #include "FieldType.h"
 #include "Field.h"
 #include "FleetPlan.h"
@@ -15,6 +18,7 @@
 #include "NamedValueRefManager.h"
 #include "Pathfinder.h"
 #include "Planet.h"
+#include "PositionGrid.h"
 #include "ShipDesign.h"
 #include "ShipHull.h"
 #include "ShipPart.h"
@@ -30,34 +34,25 @@
 #include "../Empire/EmpireManager.h"
 #include "../Empire/Empire.h"
 #include "../Empire/Government.h"
+#include "../parse/Parse.h"
 #include "../util/CheckSums.h"
 #include "../util/GameRules.h"
 #include "../util/Logger.h"
+#include "../util/MemoryUsage.h"
 #include "../util/OptionsDB.h"
 #include "../util/Random.h"
 #include "../util/ScopedTimer.h"
+#include "../util/ThreadPool.h"
 #include "../util/i18n.h"
 
 
-#if BOOST_VERSION >= 106600
-#  include <boost/asio/thread_pool.hpp>
-#  include <boost/asio/post.hpp>
-#else
-#  include <boost/asio/io_service.hpp>
-#  include <boost/thread/thread.hpp>
-namespace boost::asio {
-    // dummy implementation of thread_pool and post that just immediately executes the passed-in function
-    struct thread_pool {
-        thread_pool(int) {}
-        void join() {}
-    };
-    void post(const thread_pool&, std::function<void()> func) { func(); }
-}
-#endif
-
 FO_COMMON_API extern const int INVALID_DESIGN_ID;
 
 namespace {
+    const RuleHandle<bool> RULE_ALL_OBJECTS_VISIBLE{"RULE_ALL_OBJECTS_VISIBLE"};
+    const RuleHandle<bool> RULE_ALL_SYSTEMS_VISIBLE{"RULE_ALL_SYSTEMS_VISIBLE"};
+    const RuleHandle<bool> RULE_UNSEEN_STEALTHY_PLANETS_INVISIBLE{"RULE_UNSEEN_STEALTHY_PLANETS_INVISIBLE"};
+
     DeclareThreadSafeLogger(effects);
     DeclareThreadSafeLogger(conditions);
 }
@@ -79,9 +74,29 @@ namespace {
                HardwareThreads(), RangedValidator<int>(1, 32));
         db.Add("effects.accounting.enabled", UserStringNop("OPTIONS_DB_EFFECT_ACCOUNTING"),
                true, Validator<bool>());
+        db.Add("effects.accounting.on-demand", UserStringNop("OPTIONS_DB_EFFECT_ACCOUNTING_ON_DEMAND"),
+               true, Validator<bool>());
+        db.Add("effects.targets.incremental", UserStringNop("OPTIONS_DB_EFFECTS_TARGETS_INCREMENTAL"),
+               false, Validator<bool>());
+        db.Add("effects.targets.memoize", UserStringNop("OPTIONS_DB_EFFECTS_TARGETS_MEMOIZE"),
+               false, Validator<bool>());
+        db.Add("effects.targets.reorder", UserStringNop("OPTIONS_DB_EFFECTS_TARGETS_REORDER"),
+               true, Validator<bool>());
+        db.Add("effects.execute.parallel", UserStringNop("OPTIONS_DB_EFFECTS_EXECUTE_PARALLEL"),
+               true, Validator<bool>());
+        db.Add("universe.visibility.check-propagation", UserStringNop("OPTIONS_DB_UNIVERSE_VISIBILITY_CHECK_PROPAGATION"),
+               false, Validator<bool>());
     }
     bool temp_bool = RegisterOptions(&AddOptions);
 
+    /** Returns whether effect accounting should be recorded when updating
+      * meters.  With on-demand accounting, it is only determined for objects
+      * whose accounting is displayed, by Universe::UpdateMeterAccounting. */
+    bool EagerAccounting() {
+        return GetOptionsDB().Get<bool>("effects.accounting.enabled") &&
+               !GetOptionsDB().Get<bool>("effects.accounting.on-demand");
+    }
+
     void AddRules(GameRules& rules) {
         // makes all PRNG be reseeded frequently
         rules.Add<bool>(UserStringNop("RULE_RESEED_PRNG_SERVER"),
@@ -141,6 +156,8 @@ Universe::Universe() :
 Universe& Universe::operator=(Universe&& other) noexcept {
     if (this != &other) {
         m_pathfinder = std::move(other.m_pathfinder);
+        m_starlane_topology_version = other.m_starlane_topology_version;
+        m_system_graph_starlane_topology_version = other.m_system_graph_starlane_topology_version;
         m_objects = std::move(other.m_objects);
         m_empire_latest_known_objects = std::move(other.m_empire_latest_known_objects);
         m_destroyed_object_ids = std::move(other.m_destroyed_object_ids);
@@ -150,10 +167,13 @@ Universe& Universe::operator=(Universe&& other) noexcept {
         m_empire_object_visible_specials = std::move(other.m_empire_object_visible_specials);
         m_empire_known_destroyed_object_ids = std::move(other.m_empire_known_destroyed_object_ids);
         m_empire_stale_knowledge_object_ids = std::move(other.m_empire_stale_knowledge_object_ids);
+        m_empire_stale_knowledge_detection = std::move(other.m_empire_stale_knowledge_detection);
         m_ship_designs = std::move(other.m_ship_designs);
         m_empire_known_ship_design_ids = std::move(other.m_empire_known_ship_design_ids);
         m_effect_accounting_map = std::move(other.m_effect_accounting_map);
         m_effect_discrepancy_map = std::move(other.m_effect_discrepancy_map);
+        m_meter_estimate_targets = std::move(other.m_meter_estimate_targets);
+        m_meter_estimate_targets_state = other.m_meter_estimate_targets_state;
         m_marked_destroyed = std::move(other.m_marked_destroyed);
         m_universe_width = std::move(other.m_universe_width);
         m_inhibit_universe_object_signals = std::move(other.m_inhibit_universe_object_signals);
@@ -163,6 +183,9 @@ Universe& Universe::operator=(Universe&& other) noexcept {
         m_unlocked_fleet_plans = std::move(other.m_unlocked_fleet_plans);
         m_monster_fleet_plans = std::move(other.m_monster_fleet_plans);
         m_empire_stats = std::move(other.m_empire_stats);
+        m_effects_targets_cache = std::move(other.m_effects_targets_cache);
+        m_effects_targets_cache_object_states = std::move(other.m_effects_targets_cache_object_states);
+        m_effects_targets_cache_turn = other.m_effects_targets_cache_turn;
         m_object_id_allocator = std::move(other.m_object_id_allocator);
         m_design_id_allocator = std::move(other.m_design_id_allocator);
     }
@@ -194,17 +217,27 @@ void Universe::Clear() {
     m_empire_known_destroyed_object_ids.clear();
     m_empire_latest_known_objects.clear();
     m_empire_stale_knowledge_object_ids.clear();
+    m_empire_stale_knowledge_detection.clear();
     m_empire_known_ship_design_ids.clear();
 
     m_effect_accounting_map.clear();
     m_effect_discrepancy_map.clear();
+    m_meter_estimate_targets.clear();
+    m_meter_estimate_targets_state = 0;
     m_effect_specified_empire_object_visibilities.clear();
 
     m_stat_records.clear();
+    m_objects_updated_by_last_load.clear();
+    ++m_meters_generation;
+
+    m_effects_targets_cache.clear();
+    m_effects_targets_cache_object_states.clear();
+    m_effects_targets_cache_turn = -1;
 
     m_universe_width = 1000.0;
 
     m_pathfinder = std::make_shared<Pathfinder>();
+    m_system_graph_starlane_topology_version = -1;
 }
 
 void Universe::ResetAllIDAllocation(const std::vector<int>& empire_ids) {
@@ -282,6 +315,15 @@ const ObjectMap& Universe::EmpireKnownObjects(int empire_id) const {
     return const_empty_map;
 }
 
+void Universe::SetEmpireKnownObjects(int empire_id, ObjectMap&& objects) {
+    auto& known_objects = m_empire_latest_known_objects[empire_id];
+    known_objects = std::move(objects);
+
+    auto destroyed_ids_it = m_empire_known_destroyed_object_ids.find(empire_id);
+    if (destroyed_ids_it != m_empire_known_destroyed_object_ids.end())
+        known_objects.UpdateCurrentDestroyedObjects(destroyed_ids_it->second);
+}
+
 ObjectMap& Universe::EmpireKnownObjects(int empire_id) {
     if (empire_id == ALL_EMPIRES)
         return *m_objects;
@@ -324,27 +366,27 @@ std::set<int> Universe::EmpireVisibleObjectIDs(int empire_id, const EmpireManage
     return retval;
 }
 
-const std::set<int>& Universe::DestroyedObjectIds() const
+const ObjectIDBitmap& Universe::DestroyedObjectIds() const
 { return m_destroyed_object_ids; }
 
 int Universe::HighestDestroyedObjectID() const {
     if (m_destroyed_object_ids.empty())
         return INVALID_OBJECT_ID;
-    return *m_destroyed_object_ids.rbegin();
+    return m_destroyed_object_ids.Max();
 }
 
-const std::set<int>& Universe::EmpireKnownDestroyedObjectIDs(int empire_id) const {
+const ObjectIDBitmap& Universe::EmpireKnownDestroyedObjectIDs(int empire_id) const {
     auto it = m_empire_known_destroyed_object_ids.find(empire_id);
     if (it != m_empire_known_destroyed_object_ids.end())
         return it->second;
     return m_destroyed_object_ids;
 }
 
-const std::set<int>& Universe::EmpireStaleKnowledgeObjectIDs(int empire_id) const {
+const ObjectIDBitmap& Universe::EmpireStaleKnowledgeObjectIDs(int empire_id) const {
     auto it = m_empire_stale_knowledge_object_ids.find(empire_id);
     if (it != m_empire_stale_knowledge_object_ids.end())
         return it->second;
-    static const std::set<int> empty_set;
+    static const ObjectIDBitmap empty_set;
     return empty_set;
 }
 
@@ -400,13 +442,7 @@ Visibility Universe::GetObjectVisibilityByEmpire(int object_id, int empire_id) c
     if (empire_it == m_empire_object_visibility.end())
         return Visibility::VIS_NO_VISIBILITY;
 
-    const ObjectVisibilityMap& vis_map = empire_it->second;
-
-    auto vis_map_it = vis_map.find(object_id);
-    if (vis_map_it == vis_map.end())
-        return Visibility::VIS_NO_VISIBILITY;
-
-    return vis_map_it->second;
+    return empire_it->second.Get(object_id);
 }
 
 const Universe::EmpireObjectVisibilityTurnMap& Universe::GetEmpireObjectVisibilityTurnMap() const
@@ -449,11 +485,60 @@ std::set<std::string> Universe::GetObjectVisibleSpecialsByEmpire(int object_id,
     }
 }
 
+std::vector<std::pair<std::string, std::size_t>> Universe::ApproximateMemoryUsage() const {
+    using MemoryUsage::HeapBytes;
+
+    std::size_t accounting_bytes = m_effect_accounting_map.bucket_count() * sizeof(void*) +
+        m_effect_accounting_map.size() * (sizeof(Effect::AccountingMap::value_type) + MemoryUsage::HASH_NODE_OVERHEAD);
+    for (const auto& [object_id, meters_accounting] : m_effect_accounting_map) {
+        accounting_bytes += meters_accounting.capacity() * sizeof(*meters_accounting.begin());
+        for (const auto& [meter_type, infos] : meters_accounting) {
+            accounting_bytes += infos.capacity() * sizeof(Effect::AccountingInfo);
+            for (const auto& info : infos)
+                accounting_bytes += HeapBytes(info.specific_cause) + HeapBytes(info.custom_label);
+        }
+    }
+
+    std::size_t meter_estimate_targets_bytes = 0;
+    for (const auto& [priority, setc] : m_meter_estimate_targets) {
+        meter_estimate_targets_bytes += sizeof(std::pair<const int, Effect::SourcesEffectsTargetsAndCausesVec>) +
+                                        MemoryUsage::NODE_OVERHEAD + setc.capacity() * sizeof(setc.front());
+        for (const auto& [sourced_effects_group, targets_and_cause] : setc)  // targeted objects are counted with the objects
+            meter_estimate_targets_bytes += targets_and_cause.target_set.capacity() * sizeof(Effect::TargetSet::value_type) +
+                                            HeapBytes(targets_and_cause.effect_cause.specific_cause) +
+                                            HeapBytes(targets_and_cause.effect_cause.custom_label);
+    }
+
+    // designs have several strings and vectors of part names, which are
+    // mostly short, so count only the designs themselves
+    const std::size_t design_bytes = m_ship_designs.size() *
+        (sizeof(ShipDesignMap::value_type) + MemoryUsage::NODE_OVERHEAD + sizeof(ShipDesign));
+
+    return {
+        {"objects",                     m_objects ? sizeof(ObjectMap) + m_objects->HeapBytes() : 0},
+        {"latest known objects",        HeapBytes(m_empire_latest_known_objects)},
+        {"object visibility",           HeapBytes(m_empire_object_visibility)},
+        {"object visibility turns",     HeapBytes(m_empire_object_visibility_turns)},
+        {"visible specials",            HeapBytes(m_empire_object_visible_specials)},
+        {"destroyed object ids",        HeapBytes(m_destroyed_object_ids) + HeapBytes(m_empire_known_destroyed_object_ids) +
+                                        HeapBytes(m_empire_stale_knowledge_object_ids)},
+        {"effect accounting",           accounting_bytes + HeapBytes(m_effect_discrepancy_map)},
+        {"stat records",                HeapBytes(m_stat_records)},
+        {"ship designs",                design_bytes + HeapBytes(m_empire_known_ship_design_ids)},
+        {"effects targets cache",       HeapBytes(m_effects_targets_cache) + HeapBytes(m_effects_targets_cache_object_states) +
+                                        meter_estimate_targets_bytes},
+        {"pathfinder distance cache",   m_pathfinder ? m_pathfinder->DistanceCacheBytes() : 0}
+    };
+}
+
 int Universe::GenerateObjectID() {
     auto new_id = m_object_id_allocator->NewID();
     return new_id;
 }
 
+void Universe::ReserveObjectIDs(std::size_t count)
+{ m_object_id_allocator->Reserve(count); }
+
 int Universe::GenerateDesignID() {
     auto new_id = m_design_id_allocator->NewID();
     return new_id;
@@ -484,6 +569,8 @@ void Universe::InsertIDCore(std::shared_ptr<UniverseObject> obj, int id) {
     }
 
     obj->SetID(id);
+    if (obj->ObjectType() == UniverseObjectType::OBJ_SYSTEM)
+        StarlaneTopologyChanged();
     m_objects->insert(std::move(obj));
 }
 
@@ -522,6 +609,7 @@ bool Universe::DeleteShipDesign(int design_id) {
 }
 
 void Universe::ResetAllObjectMeters(bool target_max_unpaired, bool active) {
+    ++m_meters_generation;
     for (const auto& object : m_objects->all()) {
         if (target_max_unpaired)
             object->ResetTargetMaxUnpairedMeters();
@@ -543,10 +631,11 @@ void Universe::ResetObjectMeters(const std::vector<std::shared_ptr<UniverseObjec
 
 void Universe::ApplyAllEffectsAndUpdateMeters(ScriptingContext& context, bool do_accounting) {
     ScopedTimer timer("Universe::ApplyAllEffectsAndUpdateMeters");
+    ++m_meters_generation;
 
     if (do_accounting) {
         // override if option disabled
-        do_accounting = GetOptionsDB().Get<bool>("effects.accounting.enabled");
+        do_accounting = EagerAccounting();
     }
 
     m_effect_specified_empire_object_visibilities.clear();
@@ -581,9 +670,10 @@ void Universe::ApplyMeterEffectsAndUpdateMeters(const std::vector<int>& object_i
     if (object_ids.empty())
         return;
     ScopedTimer timer("Universe::ApplyMeterEffectsAndUpdateMeters on " + std::to_string(object_ids.size()) + " objects");
+    ++m_meters_generation;
     if (do_accounting) {
         // override if disabled
-        do_accounting = GetOptionsDB().Get<bool>("effects.accounting.enabled");
+        do_accounting = EagerAccounting();
     }
     // cache all activation and scoping condition results before applying Effects, since the application of
     // these Effects may affect the activation and scoping evaluations
@@ -610,9 +700,10 @@ void Universe::ApplyMeterEffectsAndUpdateMeters(const std::vector<int>& object_i
 
 void Universe::ApplyMeterEffectsAndUpdateMeters(ScriptingContext& context, bool do_accounting) {
     ScopedTimer timer("Universe::ApplyMeterEffectsAndUpdateMeters on all objects");
+    ++m_meters_generation;
     if (do_accounting) {
         // override if disabled
-        do_accounting = GetOptionsDB().Get<bool>("effects.accounting.enabled");
+        do_accounting = EagerAccounting();
     }
 
     std::map<int, Effect::SourcesEffectsTargetsAndCausesVec> source_effects_targets_causes;
@@ -674,38 +765,56 @@ void Universe::ApplyGenerateSitRepEffects(ScriptingContext& context) {
     ExecuteEffects(source_effects_targets_causes, context, false, false, false, false, true);
 }
 
+namespace {
+    /** Compares Universe::MeterDiscrepancy by their object ids, to find the
+      * range of an object's discrepancies. */
+    struct DiscrepancyObjectLess {
+        template <typename Discrepancy>
+        bool operator()(const Discrepancy& lhs, int rhs) const noexcept { return lhs.object_id < rhs; }
+        template <typename Discrepancy>
+        bool operator()(int lhs, const Discrepancy& rhs) const noexcept { return lhs < rhs.object_id; }
+    };
+
+    /** Sorts Universe::MeterDiscrepancy by object id, and then by meter type. */
+    template <typename Discrepancies>
+    void SortDiscrepancies(Discrepancies& discrepancies) {
+        std::sort(discrepancies.begin(), discrepancies.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.object_id < rhs.object_id ||
+                (lhs.object_id == rhs.object_id && lhs.meter_type < rhs.meter_type);
+        });
+    }
+}
+
 void Universe::InitMeterEstimatesAndDiscrepancies(ScriptingContext& context) {
     DebugLogger(effects) << "Universe::InitMeterEstimatesAndDiscrepancies";
     ScopedTimer timer("Universe::InitMeterEstimatesAndDiscrepancies", true, std::chrono::microseconds(1));
 
+    const bool do_accounting = EagerAccounting();
+
     // clear old discrepancies and accounting
     m_effect_discrepancy_map.clear();
     m_effect_accounting_map.clear();
-    m_effect_discrepancy_map.reserve(m_objects->size());
     m_effect_accounting_map.reserve(m_objects->size());
 
     TraceLogger(effects) << "IMEAD: updating meter estimates";
 
-    // save starting meter vales
+    // save starting meter vales, as discrepancies from zero
     DiscrepancyMap starting_current_meter_values;
-    starting_current_meter_values.reserve(m_objects->size());
-    for (const auto& obj : m_objects->all()) {
-        auto& obj_discrep = starting_current_meter_values[obj->ID()];
-        obj_discrep.reserve(obj->Meters().size());
-        for (const auto& meter_pair : obj->Meters()) {
-            // inserting in order into initially-empty map should always put next item efficiently at end
-            obj_discrep.emplace_hint(obj_discrep.end(), meter_pair.first, meter_pair.second.Current());
-        }
-    }
+    for (const auto& obj : m_objects->all())
+        for (const auto& [type, meter] : obj->Meters())
+            starting_current_meter_values.push_back({obj->ID(), type, meter.Current()});
+    SortDiscrepancies(starting_current_meter_values);
 
 
-    // generate new estimates (normally uses discrepancies, but in this case will find none)
-    UpdateMeterEstimates(context);
+    // generate new estimates (normally uses discrepancies, but in this case
+    // will find none), keeping the effects' targets for the next update
+    for (int obj_id : m_objects->FindExistingObjectIDs())
+        m_effect_accounting_map[obj_id].clear();
+    UpdateMeterEstimatesImpl(std::vector<int>(), context, do_accounting, true);
 
 
     TraceLogger(effects) << "IMEAD: determining discrepancies";
-    TraceLogger(effects) << "Initial accounting map size: " << m_effect_accounting_map.size()
-                         << "   and discrepancy map size: " << m_effect_discrepancy_map.size();
+    TraceLogger(effects) << "Initial accounting map size: " << m_effect_accounting_map.size();
 
     // determine meter max discrepancies
     for (auto& [object_id, account_map] : m_effect_accounting_map) {
@@ -723,20 +832,15 @@ void Universe::InitMeterEstimatesAndDiscrepancies(ScriptingContext& context) {
 
         TraceLogger(effects) << "... discrepancies for " << obj->Name() << " (" << object_id << "):";
 
-        account_map.reserve(obj->Meters().size());
-
-        // discrepancies should be empty before this loop, so emplacing / assigning should be fine here (without overwriting existing data)
-        auto dis_map_it = m_effect_discrepancy_map.emplace_hint(m_effect_discrepancy_map.end(),
-                                                                object_id, boost::container::flat_map<MeterType, double>{});
-        auto& discrep_map = dis_map_it->second;
-        discrep_map.reserve(obj->Meters().size());
-
-        auto& start_map = starting_current_meter_values[object_id];
-        start_map.reserve(obj->Meters().size());
+        if (do_accounting)
+            account_map.reserve(obj->Meters().size());
 
-        TraceLogger(effects) << "For object " << object_id << " initial accounting map size: "
-                             << account_map.size() << "  discrep map size: " << discrep_map.size()
-                             << "  and starting meters map size: " << start_map.size();
+        // starting values of this object's meters, in the same order as its meters
+        auto start_it = std::lower_bound(starting_current_meter_values.begin(),
+                                         starting_current_meter_values.end(),
+                                         object_id, DiscrepancyObjectLess{});
+        const auto start_end = std::upper_bound(start_it, starting_current_meter_values.end(),
+                                                object_id, DiscrepancyObjectLess{});
 
         // every meter has a value at the start of the turn, and a value after
         // updating with known effects
@@ -745,30 +849,40 @@ void Universe::InitMeterEstimatesAndDiscrepancies(ScriptingContext& context) {
             if (type >= MeterType::METER_POPULATION && type <= MeterType::METER_TROOPS)
                 continue;
 
+            while (start_it != start_end && start_it->meter_type < type)
+                ++start_it;
+            const float start_value = (start_it != start_end && start_it->meter_type == type) ?
+                start_it->discrepancy : 0.0f;
+
             // discrepancy is the difference between expected and actual meter
             // values at start of turn. here "expected" is what the meter value
             // was before updating the meters, and actual is what it is now
             // after updating the meters based on the known universe.
-            float discrepancy = start_map[type] - meter.Current();
+            float discrepancy = start_value - meter.Current();
             if (discrepancy == 0.0f) continue;   // no discrepancy for this meter
 
-            // add to discrepancy map. as above, should have been empty before this loop.
-            discrep_map.emplace_hint(discrep_map.end(), type, discrepancy);
+            // add to discrepancies, which are sorted after this loop
+            m_effect_discrepancy_map.push_back({object_id, type, discrepancy});
 
             // correct current max meter estimate for discrepancy
             meter.AddToCurrent(discrepancy);
 
             // add discrepancy adjustment to meter accounting
-            account_map[type].emplace_back(INVALID_OBJECT_ID, EffectsCauseType::ECT_UNKNOWN_CAUSE,
-                                           discrepancy, meter.Current());
+            if (do_accounting)
+                account_map[type].emplace_back(INVALID_OBJECT_ID, EffectsCauseType::ECT_UNKNOWN_CAUSE,
+                                               discrepancy, meter.Current());
 
             TraceLogger(effects) << "... ... " << type << ": " << discrepancy;
         }
     }
+
+    SortDiscrepancies(m_effect_discrepancy_map);
+    m_effect_discrepancy_map.shrink_to_fit();
+    TraceLogger(effects) << "Discrepancies: " << m_effect_discrepancy_map.size();
 }
 
 void Universe::UpdateMeterEstimates(ScriptingContext& context)
-{ UpdateMeterEstimates(context, GetOptionsDB().Get<bool>("effects.accounting.enabled")); }
+{ UpdateMeterEstimates(context, EagerAccounting()); }
 
 void Universe::UpdateMeterEstimates(ScriptingContext& context, bool do_accounting) {
     for (int obj_id : m_objects->FindExistingObjectIDs())
@@ -825,7 +939,22 @@ void Universe::UpdateMeterEstimates(int object_id, ScriptingContext& context, bo
     std::vector<int> objects_vec;
     objects_vec.reserve(collected_ids.size());
     std::copy(collected_ids.begin(), collected_ids.end(), std::back_inserter(objects_vec));
-    UpdateMeterEstimatesImpl(objects_vec, context, GetOptionsDB().Get<bool>("effects.accounting.enabled"));
+    UpdateMeterEstimatesImpl(objects_vec, context, EagerAccounting());
+}
+
+void Universe::UpdateMeterAccounting(int object_id, ScriptingContext& context) {
+    if (!GetOptionsDB().Get<bool>("effects.accounting.enabled"))
+        return;
+    if (m_destroyed_object_ids.count(object_id) || !m_objects->get(object_id))
+        return;
+
+    auto& account_map = m_effect_accounting_map[object_id];
+    if (!account_map.empty())
+        return; // already known
+
+    // re-estimating the object's meters gives the same values as before, but
+    // records which effects produce them
+    UpdateMeterEstimatesImpl({object_id}, context, true);
 }
 
 void Universe::UpdateMeterEstimates(const std::vector<int>& objects_vec, ScriptingContext& context) {
@@ -842,15 +971,17 @@ void Universe::UpdateMeterEstimates(const std::vector<int>& objects_vec, Scripti
     final_objects_vec.reserve(objects_set.size());
     std::copy(objects_set.begin(), objects_set.end(), std::back_inserter(final_objects_vec));
     if (!final_objects_vec.empty())
-        UpdateMeterEstimatesImpl(final_objects_vec, context, GetOptionsDB().Get<bool>("effects.accounting.enabled"));
+        UpdateMeterEstimatesImpl(final_objects_vec, context, EagerAccounting());
 }
 
 void Universe::UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec,
-                                        ScriptingContext& context, bool do_accounting)
+                                        ScriptingContext& context, bool do_accounting,
+                                        bool keep_targets)
 {
     auto number_text = std::to_string(objects_vec.empty() ?
                                       context.ContextObjects().ExistingObjects().size() : objects_vec.size());
     ScopedTimer timer("Universe::UpdateMeterEstimatesImpl on " + number_text + " objects", true);
+    ++m_meters_generation;
 
     // get all pointers to objects once, to avoid having to do so repeatedly
     // when iterating over the list in the following code
@@ -894,13 +1025,34 @@ void Universe::UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec,
         TraceLogger(effects) << obj->Dump();
 
     // cache all activation and scoping condition results before applying Effects, since the application of
-    // these Effects may affect the activation and scoping evaluations
+    // these Effects may affect the activation and scoping evaluations.  when updating all objects, the
+    // results kept by InitMeterEstimatesAndDiscrepancies are reused if nothing has changed since then.
+    const bool all_objects = objects_vec.empty() && &context.ContextUniverse() == this;
+    std::size_t targets_state = 0;
+    if (all_objects && (keep_targets || !m_meter_estimate_targets.empty()))
+        targets_state = MeterEstimateTargetsState(context);
+
     std::map<int, Effect::SourcesEffectsTargetsAndCausesVec> source_effects_targets_causes;
-    GetEffectsAndTargets(source_effects_targets_causes, objects_vec, context, true);
+    if (all_objects && !m_meter_estimate_targets.empty() && targets_state == m_meter_estimate_targets_state) {
+        DebugLogger(effects) << "UpdateMeterEstimatesImpl reusing effects targets of InitMeterEstimatesAndDiscrepancies";
+        source_effects_targets_causes.swap(m_meter_estimate_targets);
+    } else {
+        GetEffectsAndTargets(source_effects_targets_causes, objects_vec, context, true);
+    }
+    if (all_objects)
+        m_meter_estimate_targets.clear();
 
-    // Apply and record effect meter adjustments
+    // Apply and record effect meter adjustments.  Executing effects removes
+    // targets from their target sets that were already acted on by effects in
+    // the same stacking group, which executing them again in the same order
+    // would also do, so the target sets can be reused afterwards
     ExecuteEffects(source_effects_targets_causes, context, do_accounting, true, false, false, false);
 
+    if (all_objects && keep_targets) {
+        m_meter_estimate_targets.swap(source_effects_targets_causes);
+        m_meter_estimate_targets_state = targets_state;
+    }
+
     TraceLogger(effects) << "UpdateMeterEstimatesImpl after executing effects objects:";
     for (auto& obj : object_ptrs)
         TraceLogger(effects) << obj->Dump();
@@ -908,20 +1060,21 @@ void Universe::UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec,
     // Apply known discrepancies between expected and calculated meter maxes at start of turn.  This
     // accounts for the unknown effects on the meter, and brings the estimate in line with the actual
     // max at the start of the turn
-    auto& discrepancy_map = context.ContextUniverse().m_effect_discrepancy_map;
-    if (!discrepancy_map.empty() && do_accounting) {
+    const auto& discrepancies = context.ContextUniverse().m_effect_discrepancy_map;
+    if (!discrepancies.empty() && do_accounting) {
         for (auto& obj : object_ptrs) {
             // check if this object has any discrepancies
-            auto dis_it = discrepancy_map.find(obj->ID());
-            if (dis_it == discrepancy_map.end())
+            const auto [dis_begin, dis_end] = std::equal_range(discrepancies.begin(), discrepancies.end(),
+                                                               obj->ID(), DiscrepancyObjectLess{});
+            if (dis_begin == dis_end)
                 continue;   // no discrepancy, so skip to next object
 
             auto& account_map = accounting_map[obj->ID()]; // reserving space now should be redundant with previous manipulations
 
             // apply all meters' discrepancies
-            for (auto& entry : dis_it->second) {
-                MeterType type = entry.first;
-                double discrepancy = entry.second;
+            for (auto dis_it = dis_begin; dis_it != dis_end; ++dis_it) {
+                MeterType type = dis_it->meter_type;
+                float discrepancy = dis_it->discrepancy;
 
                 //if (discrepancy == 0.0) continue;
 
@@ -959,6 +1112,110 @@ void Universe::BackPropagateObjectMeters() {
 }
 
 namespace {
+    /** Cached effects groups' scope condition results from a previous
+      * evaluation this turn, and the objects that have changed since then,
+      * for which those results may be out of date. */
+    struct IncrementalScopeInfo {
+        const std::unordered_map<const Effect::EffectsGroup*,
+                                 std::unordered_map<int, std::vector<int>>>& cached_targets;
+        std::unordered_set<int> dirty_object_ids;
+        Effect::TargetSet       dirty_objects;
+    };
+
+    /** Returns a hash of the state of \a obj that candidate-local scope
+      * conditions may depend on. Objects whose state hash is unchanged match
+      * the same candidate-local conditions as when the hash was computed. */
+    std::size_t ObjectStateHash(const UniverseObject& obj) {
+        std::size_t retval = 0;
+        boost::hash_combine(retval, obj.ID());
+        boost::hash_combine(retval, static_cast<int>(obj.ObjectType()));
+        boost::hash_combine(retval, obj.Owner());
+        boost::hash_combine(retval, obj.SystemID());
+        boost::hash_combine(retval, obj.X());
+        boost::hash_combine(retval, obj.Y());
+        boost::hash_combine(retval, obj.ContainerObjectID());
+
+        for (const auto& [special_name, turn_capacity] : obj.Specials()) {
+            boost::hash_combine(retval, special_name);
+            boost::hash_combine(retval, turn_capacity.first);
+            boost::hash_combine(retval, turn_capacity.second);
+        }
+        for (const auto& [meter_type, meter] : obj.Meters()) {
+            boost::hash_combine(retval, static_cast<int>(meter_type));
+            boost::hash_combine(retval, meter.Current());
+            boost::hash_combine(retval, meter.Initial());
+        }
+
+        switch (obj.ObjectType()) {
+        case UniverseObjectType::OBJ_PLANET: {
+            const auto& planet = static_cast<const Planet&>(obj);
+            boost::hash_combine(retval, planet.SpeciesName());
+            boost::hash_combine(retval, planet.Focus());
+            boost::hash_combine(retval, static_cast<int>(planet.Type()));
+            boost::hash_combine(retval, static_cast<int>(planet.OriginalType()));
+            boost::hash_combine(retval, static_cast<int>(planet.Size()));
+            break;
+        }
+        case UniverseObjectType::OBJ_SHIP: {
+            const auto& ship = static_cast<const Ship&>(obj);
+            boost::hash_combine(retval, ship.SpeciesName());
+            boost::hash_combine(retval, ship.DesignID());
+            boost::hash_combine(retval, ship.FleetID());
+            boost::hash_combine(retval, ship.ProducedByEmpireID());
+            break;
+        }
+        case UniverseObjectType::OBJ_BUILDING: {
+            const auto& building = static_cast<const Building&>(obj);
+            boost::hash_combine(retval, building.BuildingTypeName());
+            boost::hash_combine(retval, building.PlanetID());
+            boost::hash_combine(retval, building.ProducedByEmpireID());
+            break;
+        }
+        case UniverseObjectType::OBJ_FIELD:
+            boost::hash_combine(retval, static_cast<const Field&>(obj).FieldTypeName());
+            break;
+        default:
+            break;
+        }
+        return retval;
+    }
+
+    /** If \a scope is candidate-local and there is a cached result for it
+      * with \a source, puts the cached targets that haven't changed since
+      * then into \a matched_targets, re-evaluates \a scope on the changed
+      * objects, and returns true. Otherwise returns false and leaves
+      * \a matched_targets unchanged. */
+    bool EvalScopeIncrementally(const ScriptingContext& context,
+                                const Effect::EffectsGroup* effects_group,
+                                const Condition::Condition* scope,
+                                int source_id, const IncrementalScopeInfo& incremental,
+                                Effect::TargetSet& matched_targets)
+    {
+        if (incremental.dirty_object_ids.count(source_id) || !scope->CandidateLocal())
+            return false;
+        const auto eg_it = incremental.cached_targets.find(effects_group);
+        if (eg_it == incremental.cached_targets.end())
+            return false;
+        const auto source_it = eg_it->second.find(source_id);
+        if (source_it == eg_it->second.end())
+            return false;
+
+        const auto& objects = context.ContextObjects();
+        matched_targets.reserve(source_it->second.size());
+        for (int target_id : source_it->second) {
+            if (incremental.dirty_object_ids.count(target_id))
+                continue;
+            if (auto target = objects.get(target_id))
+                matched_targets.push_back(std::const_pointer_cast<UniverseObject>(std::move(target)));
+        }
+
+        if (!incremental.dirty_objects.empty()) {
+            Effect::TargetSet dirty_candidates{incremental.dirty_objects};
+            scope->Eval(context, matched_targets, dirty_candidates);
+        }
+        return true;
+    }
+
     /** Evaluate activation, and scope conditions of \a effects_group for
       * each of the objects in \a source_objects for the candidate target
       * objects in \a candidate_objects_in (unless it is empty, in which case
@@ -974,6 +1231,7 @@ namespace {
         const std::unordered_set<int>&              candidate_object_ids,   // TODO: Can this be removed along with scope is source test?
         Effect::TargetSet&                          candidate_objects_in,   // may be empty: indicates to test for full universe of objects
         Effect::SourcesEffectsTargetsAndCausesVec&  source_effects_targets_causes_out,
+        const IncrementalScopeInfo*                 incremental,            // may be null: indicates to evaluate scope on all candidates
         int n)
     {
         TraceLogger(effects) << [&]() -> std::string {
@@ -1030,8 +1288,11 @@ namespace {
 
             // move scope condition matches into output matches
             if (candidate_objects_in.empty()) {
-                // condition default candidates will be tested
-                scope->Eval(context, matched_targets);
+                // condition default candidates will be tested, unless the
+                // results of an earlier evaluation can be reused
+                if (!incremental || !EvalScopeIncrementally(context, effects_group, scope, source->ID(),
+                                                            *incremental, matched_targets))
+                { scope->Eval(context, matched_targets); }
 
             } else if (scope_is_just_source) {
                 // special case for condition that is just Source when a set of
@@ -1056,8 +1317,57 @@ namespace {
     }
 
 
+    /** When effects are only being found for a few potential targets, which
+      * effects groups' scopes could match any of those targets.  Each scope is
+      * judged by those of its top-level terms that depend only on the candidate
+      * being matched, not on the source object or other candidates, which are
+      * tested on the potential targets once for all sources.  Effects groups
+      * whose scopes can't match any potential target are skipped without
+      * evaluating their activation or scope conditions for their sources. */
+    class TargetedScopeFilter {
+    public:
+        TargetedScopeFilter(const ScriptingContext& context, const Condition::ObjectSet& potential_targets) :
+            m_context(context),
+            m_potential_targets(potential_targets)
+        { m_context.source = nullptr; }
+
+        /** Returns false if \a scope can't match any of the potential targets,
+          * for any source. Not thread-safe. */
+        bool CouldMatchAny(const Condition::Condition* scope) {
+            if (!scope)
+                return false;
+            auto [it, inserted] = m_could_match.try_emplace(scope, true);
+            if (!inserted)
+                return it->second;
+
+            std::vector<const Condition::Condition*> terms;
+            if (auto* and_condition = dynamic_cast<const Condition::And*>(scope))
+                terms = and_condition->Operands();
+            else
+                terms.push_back(scope);
+
+            Condition::ObjectSet matches = m_potential_targets;
+            Condition::ObjectSet rejected;
+            for (auto* term : terms) {
+                if (!term || !term->SourceInvariant() || !term->CandidateLocal())
+                    continue;
+                term->Eval(m_context, matches, rejected, Condition::SearchDomain::MATCHES);
+                if (matches.empty()) {
+                    it->second = false;
+                    break;
+                }
+            }
+            return it->second;
+        }
+
+    private:
+        ScriptingContext                                        m_context;
+        const Condition::ObjectSet&                             m_potential_targets;
+        std::unordered_map<const Condition::Condition*, bool>   m_could_match;
+    };
+
     /** Collect info for scope condition evaluations and dispatch those
-      * evaluations to \a thread_pool. Not thread-safe, but the individual
+      * evaluations to \a task_batch. Not thread-safe, but the individual
       * condition evaluations should be safe to evaluate in parallel. */
     void DispatchEffectsGroupScopeEvaluations(
         EffectsCauseType effect_cause_type,
@@ -1070,8 +1380,11 @@ namespace {
         const std::unordered_set<int>& potential_target_ids,
         std::list<std::pair<Effect::SourcesEffectsTargetsAndCausesVec,
                             Effect::SourcesEffectsTargetsAndCausesVec*>>& source_effects_targets_causes_reorder_buffer_out,
-        boost::asio::thread_pool& thread_pool,
-        int& n)
+        TaskBatch& task_batch,
+        const IncrementalScopeInfo* incremental,
+        TargetedScopeFilter* targeted,
+        int& n,
+        std::uint64_t random_base_seed)
     {
         std::vector<std::pair<Condition::Condition*, int>> already_evaluated_activation_condition_idx;
         already_evaluated_activation_condition_idx.reserve(effects_groups.size());
@@ -1094,6 +1407,8 @@ namespace {
                 continue;
             if (!effects_group->Scope())
                 continue;
+            if (targeted && !targeted->CouldMatchAny(effects_group->Scope()))
+                continue;   // leave no active sources, so the scope isn't evaluated either
 
             if (!effects_group->Activation()) {
                 // no activation condition, leave all sources active
@@ -1242,8 +1557,7 @@ namespace {
             }();
 
             // asynchronously evaluate targetset for effectsgroup for each source using worker threads
-            boost::asio::post(
-                thread_pool,
+            task_batch.Post(
                 [
                     context,
                     effects_group,
@@ -1253,18 +1567,46 @@ namespace {
                     &potential_target_ids,
                     potential_targets_copy, // by value, not reference, so each dispatched call has independent input TargetSet
                     &source_effects_targets_causes_vec_out = source_effects_targets_causes_reorder_buffer_out.back().first,
-                    n
+                    incremental,
+                    n,
+                    random_base_seed
                 ]() mutable
             {
+                // each evaluation draws random numbers (eg. for Chance
+                // conditions) from its own stream, identified by its dispatch
+                // number, so that results don't depend on scheduling
+                ScopedThreadRandomStream random_stream(RandomStreamSeed(
+                    random_base_seed, context.current_turn, RandomStreamPhase::EFFECTS_TARGETS,
+                    static_cast<std::uint64_t>(n)));
                 StoreTargetsAndCausesOfEffectsGroup(context, effects_group, active_source_objects,
                                                     effect_cause_type, specific_cause_name,
                                                     potential_target_ids, potential_targets_copy,
-                                                    source_effects_targets_causes_vec_out, n);
-            });
+                                                    source_effects_targets_causes_vec_out,
+                                                    incremental, n);
+            }, boost::lexical_cast<std::string>(effect_cause_type));
         }
     }
 }
 
+std::size_t Universe::MeterEstimateTargetsState(const ScriptingContext& context) const {
+    std::size_t retval = 0;
+    for (const auto& [obj_id, obj] : context.ContextObjects().ExistingObjects()) {
+        boost::hash_combine(retval, ObjectStateHash(*obj));
+        boost::hash_combine(retval, obj.get()); // target sets hold the objects themselves
+    }
+    for (const auto& [empire_id, empire] : context.Empires()) {
+        boost::hash_combine(retval, empire_id);
+        boost::hash_combine(retval, empire->CapitalID());
+        for (const auto& policy_name : empire->AdoptedPolicies())
+            boost::hash_combine(retval, policy_name);
+        for (const auto& [tech_name, turn] : empire->ResearchedTechs()) {
+            boost::hash_combine(retval, tech_name);
+            boost::hash_combine(retval, turn);
+        }
+    }
+    return retval;
+}
+
 void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsAndCausesVec>& source_effects_targets_causes,
                                     const ScriptingContext& context,
                                     bool only_meter_effects) const
@@ -1299,10 +1641,110 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
     std::list<std::pair<Effect::SourcesEffectsTargetsAndCausesVec,
                         Effect::SourcesEffectsTargetsAndCausesVec*>> source_effects_targets_causes_reorder_buffer;
 
-    const unsigned int num_threads = static_cast<unsigned int>(std::max(1, EffectsProcessingThreads()));
-    boost::asio::thread_pool thread_pool(num_threads);
+    // memoize matches of subconditions shared by many scope conditions and
+    // values of Statistics, and index objects by owner, species and so on to
+    // find initial condition candidates, which remain valid until this
+    // function returns, as no objects change while scopes are being evaluated.
+    // also reorder And and Or condition operands by their measured costs, and
+    // afterwards release storage kept for reuse between condition evaluations.
+    // declared before task_batch, so that the memo is only cleared after all
+    // evaluations are finished. not done when finding effects on only some
+    // objects, as indexing all objects would then cost more than it saves
+    struct ConditionMemoActivation {
+        ConditionMemoActivation(const Universe& universe, bool activate, bool reorder) :
+            m_universe(universe)
+        {
+            m_universe.m_condition_memo.Clear();
+            m_universe.m_statistic_cache.Clear();
+            if (activate)
+                m_universe.m_object_index.Build(m_universe.Objects());
+            m_universe.m_condition_memo_active = activate;
+            m_universe.m_reorder_condition_operands = reorder;
+        }
+        ~ConditionMemoActivation() {
+            m_universe.m_reorder_condition_operands = false;
+            m_universe.m_condition_memo_active = false;
+            m_universe.m_condition_memo.Clear();
+            m_universe.m_statistic_cache.LogHitRates();
+            m_universe.m_statistic_cache.Clear();
+            m_universe.m_object_index.Clear();
+            Condition::ReleaseScratchStorage();
+        }
+        const Universe& m_universe;
+    } condition_memo_activation(*this, &context.ContextUniverse() == this && target_object_ids.empty() &&
+                                       GetOptionsDB().Get<bool>("effects.targets.memoize"),
+                                &context.ContextUniverse() == this &&
+                                       GetOptionsDB().Get<bool>("effects.targets.reorder"));
+
+    TaskBatch task_batch("Universe::GetEffectsAndTargets");
 
     int n = 1;  // count dispatched condition evaluations
+    const auto random_base_seed = SplitRandomSeed();
+
+
+    // 0) determine which objects have changed since the scope conditions were
+    // last evaluated this turn, so that cached results can be reused for those
+    // that haven't changed
+    type_timer.EnterSection("incremental state");
+    const bool update_incremental_cache = target_object_ids.empty() && only_meter_effects &&
+        &context.ContextUniverse() == this &&
+        GetOptionsDB().Get<bool>("effects.targets.incremental");
+    std::unordered_map<int, std::size_t> object_states;
+    boost::optional<IncrementalScopeInfo> incremental;
+    if (update_incremental_cache) {
+        const auto& existing_objects = context.ContextObjects().ExistingObjects();
+        object_states.reserve(existing_objects.size());
+        for (const auto& [obj_id, obj] : existing_objects)
+            object_states.emplace(obj_id, ObjectStateHash(*obj));
+
+        if (m_effects_targets_cache_turn == context.current_turn && !m_effects_targets_cache.empty()) {
+            incremental.emplace(IncrementalScopeInfo{m_effects_targets_cache, {}, {}});
+            auto& dirty_ids = incremental->dirty_object_ids;
+
+            // new and changed objects
+            for (const auto& [obj_id, state] : object_states) {
+                auto old_it = m_effects_targets_cache_object_states.find(obj_id);
+                if (old_it == m_effects_targets_cache_object_states.end() || old_it->second != state)
+                    dirty_ids.insert(obj_id);
+            }
+            // removed objects
+            for (const auto& [obj_id, state] : m_effects_targets_cache_object_states) {
+                (void)state;
+                if (!object_states.count(obj_id))
+                    dirty_ids.insert(obj_id);
+            }
+            // objects whose container or contents have changed
+            std::vector<int> neighbour_ids;
+            for (int obj_id : dirty_ids) {
+                auto obj_it = existing_objects.find(obj_id);
+                if (obj_it == existing_objects.end())
+                    continue;
+                neighbour_ids.push_back(obj_it->second->ContainerObjectID());
+                const auto& contained_ids = obj_it->second->ContainedObjectIDs();
+                neighbour_ids.insert(neighbour_ids.end(), contained_ids.begin(), contained_ids.end());
+            }
+            dirty_ids.insert(neighbour_ids.begin(), neighbour_ids.end());
+            dirty_ids.erase(INVALID_OBJECT_ID);
+
+            for (int obj_id : dirty_ids) {
+                auto obj_it = existing_objects.find(obj_id);
+                if (obj_it != existing_objects.end())
+                    incremental->dirty_objects.push_back(std::const_pointer_cast<UniverseObject>(obj_it->second));
+            }
+
+            DebugLogger(effects) << "GetEffectsAndTargets incrementally re-evaluating candidate-local scopes for "
+                                 << incremental->dirty_objects.size() << " of " << existing_objects.size()
+                                 << " objects";
+        }
+    }
+    const IncrementalScopeInfo* incremental_info = incremental ? &*incremental : nullptr;
+
+    // when finding effects on only a few objects, skip the effects groups that
+    // can't affect those objects before evaluating their sources' activations
+    boost::optional<TargetedScopeFilter> targeted;
+    if (!target_object_ids.empty())
+        targeted.emplace(context, potential_targets);
+    TargetedScopeFilter* targeted_filter = targeted ? &*targeted : nullptr;
 
 
     // 1) EffectsGroups from Species
@@ -1352,7 +1794,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
 
 
@@ -1390,7 +1833,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
 
 
@@ -1420,7 +1864,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                                  context, potential_targets,
                                                  potential_ids_set,
                                                  source_effects_targets_causes_reorder_buffer,
-                                                 thread_pool, n);
+                                                 task_batch, incremental_info, targeted_filter, n,
+                                                 random_base_seed);
         }
     }
 
@@ -1448,7 +1893,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                                  context, potential_targets,
                                                  potential_ids_set,
                                                  source_effects_targets_causes_reorder_buffer,
-                                                 thread_pool, n);
+                                                 task_batch, incremental_info, targeted_filter, n,
+                                                 random_base_seed);
         }
     }
 
@@ -1484,7 +1930,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
 
 
@@ -1537,7 +1984,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
     // dispatch part condition evaluations
     for (const auto& [ship_part_name, ship_part] : GetShipPartManager()) {
@@ -1554,7 +2002,8 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
 
 
@@ -1591,13 +2040,36 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
                                              context, potential_targets,
                                              potential_ids_set,
                                              source_effects_targets_causes_reorder_buffer,
-                                             thread_pool, n);
+                                             task_batch, incremental_info, targeted_filter, n,
+                                             random_base_seed);
     }
 
 
     // wait for evaluation of conditions dispatched above
     type_timer.EnterSection("eval waiting");
-    thread_pool.join();
+    task_batch.Wait();
+    task_batch.LogTimings(std::chrono::milliseconds(10));
+
+
+    // store full-universe scope condition results for reuse later this turn
+    if (update_incremental_cache) {
+        type_timer.EnterSection("incremental caching");
+        m_effects_targets_cache.clear();
+        for (const auto& job_results : source_effects_targets_causes_reorder_buffer) {
+            if (job_results.second)
+                continue; // duplicate of an earlier entry
+            for (const auto& [sourced_effects_group, targets_and_cause] : job_results.first) {
+                auto& target_ids = m_effects_targets_cache[sourced_effects_group.effects_group]
+                                                          [sourced_effects_group.source_object_id];
+                target_ids.clear();
+                target_ids.reserve(targets_and_cause.target_set.size());
+                for (const auto& target : targets_and_cause.target_set)
+                    target_ids.push_back(target->ID());
+            }
+        }
+        m_effects_targets_cache_object_states = std::move(object_states);
+        m_effects_targets_cache_turn = context.current_turn;
+    }
 
 
     // add results to source_effects_targets_causes, sorted by effect priority, then in issue order
@@ -1633,6 +2105,80 @@ void Universe::GetEffectsAndTargets(std::map<int, Effect::SourcesEffectsTargetsA
     }
 }
 
+namespace {
+    /** The objects that the effects of each stacking group have acted on, as
+      * a bitset over object IDs for each stacking group ID. */
+    class StackingGroupTargets {
+    public:
+        /** Records that an effect of the stacking group \a group_id acts on
+          * the object with id \a object_id.  Returns false if one already
+          * did, in which case the effect should be skipped. */
+        bool Insert(int group_id, int object_id) {
+            if (object_id < 0)  // temporary objects
+                return m_negative_ids.emplace(group_id, object_id).second;
+
+            const auto group = static_cast<std::size_t>(group_id);
+            if (group >= m_acted_on.size())
+                m_acted_on.resize(group + 1);
+            auto& acted_on = m_acted_on[group];
+
+            const auto idx = static_cast<std::size_t>(object_id);
+            if (idx >= acted_on.size())
+                acted_on.resize(std::max(idx + 1, acted_on.size() * 2));
+            if (acted_on[idx])
+                return false;
+            acted_on[idx] = true;
+            return true;
+        }
+
+    private:
+        std::vector<std::vector<bool>>  m_acted_on;
+        std::set<std::pair<int, int>>   m_negative_ids;
+    };
+
+    using EffectsExecution = std::pair<Effect::SourcedEffectsGroup, Effect::TargetsAndCause>;
+
+    /** Minimum number of consecutive target-local effects group executions
+      * for it to be worth running them in parallel. */
+    constexpr std::size_t MIN_PARALLEL_EXECUTIONS = 16;
+
+    /** Splits \a executions into partitions such that no object is the source
+      * or a target of executions in more than one partition.  Each partition
+      * lists its executions in the order they have in \a executions. */
+    std::vector<std::vector<const EffectsExecution*>> PartitionByObjects(
+        std::vector<const EffectsExecution*>::const_iterator first,
+        std::vector<const EffectsExecution*>::const_iterator last)
+    {
+        // union-find over object ids, joining the sets of the source and
+        // targets of each execution
+        std::unordered_map<int, int> parents;
+        auto find_root = [&parents](int id) {
+            int root = parents.try_emplace(id, id).first->second;
+            for (int parent = parents[root]; parent != root; parent = parents[root])
+                root = parent;
+            while (id != root)
+                id = std::exchange(parents[id], root);
+            return root;
+        };
+
+        for (auto it = first; it != last; ++it) {
+            const int root = find_root((*it)->first.source_object_id);
+            for (const auto& target : (*it)->second.target_set)
+                parents[find_root(target->ID())] = root;
+        }
+
+        std::vector<std::vector<const EffectsExecution*>> retval;
+        std::unordered_map<int, std::size_t> root_partitions;
+        for (auto it = first; it != last; ++it) {
+            auto [root_it, added] = root_partitions.try_emplace(find_root((*it)->first.source_object_id), retval.size());
+            if (added)
+                retval.emplace_back();
+            retval[root_it->second].push_back(*it);
+        }
+        return retval;
+    }
+}
+
 void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCausesVec>& source_effects_targets_causes,
                               ScriptingContext& context,
                               bool update_effect_accounting,
@@ -1644,14 +2190,57 @@ void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCaus
     ScopedTimer timer("Universe::ExecuteEffects", true);
 
     context.ContextUniverse().m_marked_destroyed.clear();
-    std::map<std::string, std::set<int>> executed_nonstacking_effects;  // for each stacking group, which objects have had effects executed on them
+    StackingGroupTargets executed_nonstacking_effects;  // for each stacking group, which objects have had effects executed on them
+
+    // accounting isn't recorded concurrently, as all executions add to the same map
+    const bool parallel = !update_effect_accounting && GetOptionsDB().Get<bool>("effects.execute.parallel");
+
+    // each execution draws random numbers from its own stream, identified by
+    // its priority and position, so that results are the same whether and
+    // however executions are run in parallel
+    const auto random_base_seed = SplitRandomSeed();
+    const EffectsExecution* priority_executions_begin = nullptr;
+    std::uint64_t priority_random_id = 0;
+
+    auto execute = [&](const EffectsExecution& execution) {
+        const auto& [sourced_effects_group, targets_and_cause] = execution;
+        const Effect::EffectsGroup* effects_group = sourced_effects_group.effects_group;
+
+        const auto position = static_cast<std::uint64_t>(&execution - priority_executions_begin);
+        ScopedThreadRandomStream random_stream(RandomStreamSeed(
+            random_base_seed, context.current_turn, RandomStreamPhase::EFFECTS_EXECUTION,
+            priority_random_id | position));
+
+        TraceLogger(effects) << "\n\n * * * * * * * * * * * (new effects group log entry)(" << effects_group->TopLevelContent()
+                             << " " << effects_group->AccountingLabel() << " " << effects_group->StackingGroup() << ")";
+
+        // execute Effects in the EffectsGroup
+        auto source = context.ContextObjects().get(sourced_effects_group.source_object_id);
+        if (!source)
+            WarnLogger() << "No source found for ID: " << sourced_effects_group.source_object_id;
+        ScriptingContext source_context(std::move(source), context);
+        effects_group->Execute(source_context,
+                               targets_and_cause,
+                               update_effect_accounting ? &m_effect_accounting_map : nullptr,
+                               only_meter_effects,
+                               only_appearance_effects,
+                               include_empire_meter_effects,
+                               only_generate_sitrep_effects);
+    };
 
 
     // within each priority group, execute effects in dispatch order
     for (auto& [priority, setc] : source_effects_targets_causes) {
-        (void)priority; // quiet unused variable warning
+        priority_executions_begin = setc.data();
+        priority_random_id = static_cast<std::uint64_t>(static_cast<std::uint32_t>(priority)) << 32;
+
+        // which targets each execution acts on depends only on the order of
+        // executions, not their results, so can be determined up front
+        std::vector<const EffectsExecution*> executions;
+        executions.reserve(setc.size());
 
-        for (auto& [sourced_effects_group, targets_and_cause] : setc) {
+        for (auto& execution : setc) {
+            auto& [sourced_effects_group, targets_and_cause] = execution;
             Effect::TargetSet& target_set{targets_and_cause.target_set};
 
             const Effect::EffectsGroup* effects_group = sourced_effects_group.effects_group;
@@ -1663,28 +2252,22 @@ void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCaus
             if (only_generate_sitrep_effects && !effects_group->HasSitrepEffects())
                 continue;
 
-            const std::string& stacking_group{effects_group->StackingGroup()};
+            const int stacking_group_id = effects_group->StackingGroupID();
 
             // 1) If other EffectsGroups or sources with the same stacking group
             // have acted on some of the targets in the scope of the current
             // EffectsGroup, skip them.
             // 2) Add remaining objects to executed_nonstacking_effects, as effects
             // with the starting group are now acting on them
-            if (!stacking_group.empty()) {
-                std::set<int>& non_stacking_targets = executed_nonstacking_effects[stacking_group];
-
+            if (stacking_group_id != Effect::EffectsGroup::NO_STACKING_GROUP) {
                 // this is a set difference/union algorithm:
                 // targets              -= non_stacking_targets
                 // non_stacking_targets += targets
                 for (auto object_it = target_set.begin(); object_it != target_set.end();) {
-                    int object_id = (*object_it)->ID();
-                    auto it = non_stacking_targets.find(object_id);
-
-                    if (it != non_stacking_targets.end()) {
+                    if (!executed_nonstacking_effects.Insert(stacking_group_id, (*object_it)->ID())) {
                         *object_it = target_set.back();
                         target_set.pop_back();
                     } else {
-                        non_stacking_targets.insert(object_id);
                         ++object_it;
                     }
                 }
@@ -1694,21 +2277,40 @@ void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCaus
             if (target_set.empty())
                 continue;
 
-            TraceLogger(effects) << "\n\n * * * * * * * * * * * (new effects group log entry)(" << effects_group->TopLevelContent()
-                                 << " " << effects_group->AccountingLabel() << " " << effects_group->StackingGroup() << ")";
+            executions.push_back(&execution);
+        }
 
-            // execute Effects in the EffectsGroup
-            auto source = context.ContextObjects().get(sourced_effects_group.source_object_id);
-            if (!source)
-                WarnLogger() << "No source found for ID: " << sourced_effects_group.source_object_id;
-            ScriptingContext source_context(std::move(source), context);
-            effects_group->Execute(source_context,
-                                   targets_and_cause,
-                                   update_effect_accounting ? &m_effect_accounting_map : nullptr,
-                                   only_meter_effects,
-                                   only_appearance_effects,
-                                   include_empire_meter_effects,
-                                   only_generate_sitrep_effects);
+        // runs of target-local executions are split into partitions that act
+        // on disjoint objects, which are executed in parallel, each in
+        // dispatch order. other executions are done one at a time, in order.
+        for (auto it = executions.cbegin(); it != executions.cend();) {
+            auto run_end = it;
+            if (parallel)
+                run_end = std::find_if(it, executions.cend(),
+                                       [](const auto* e) { return !e->first.effects_group->TargetLocal(); });
+
+            if (static_cast<std::size_t>(std::distance(it, run_end)) >= MIN_PARALLEL_EXECUTIONS) {
+                auto partitions = PartitionByObjects(it, run_end);
+                if (partitions.size() > 1) {
+                    TaskBatch task_batch("Universe::ExecuteEffects");
+                    for (auto& partition : partitions) {
+                        task_batch.Post([&execute, partition{std::move(partition)}]() {
+                            for (const auto* execution : partition)
+                                execute(*execution);
+                        });
+                    }
+                    task_batch.Wait();
+                    it = run_end;
+                    continue;
+                }
+            }
+
+            // no parallelism to exploit: execute the run, or the next
+            // execution that isn't target-local, in order
+            if (run_end == it)
+                ++run_end;
+            for (; it != run_end; ++it)
+                execute(**it);
         }
     }
 
@@ -1719,6 +2321,8 @@ void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCaus
     // but, do now collect info about source objects for destruction, to sure
     // their info is available even if they are destroyed by the upcoming effect
     // destruction
+    std::vector<int> marked_destroyed_ids;
+    marked_destroyed_ids.reserve(context.ContextUniverse().m_marked_destroyed.size());
     for (auto& [obj_id, destructors] : context.ContextUniverse().m_marked_destroyed) {
         auto obj = m_objects->get(obj_id);
         if (!obj)
@@ -1737,9 +2341,11 @@ void Universe::ExecuteEffects(std::map<int, Effect::SourcesEffectsTargetsAndCaus
         // destroyed...  as of this writing there are no stats tracking
         // destruction of fleets.
 
-        // do actual recursive destruction.
-        RecursiveDestroy(obj_id);
+        marked_destroyed_ids.push_back(obj_id);
     }
+
+    // do actual recursive destruction, of all marked objects together
+    RecursiveDestroy(marked_destroyed_ids);
 }
 
 void Universe::CountDestructionInStats(int object_id, int source_object_id, ScriptingContext& context) {
@@ -1912,7 +2518,7 @@ namespace {
     auto GetEmpiresPositionDetectionRanges(const ObjectMap& objects) {
         std::map<int, std::map<std::pair<double, double>, float>> retval;
 
-        for (const auto& obj : objects.all()) {
+        for (const auto* obj : objects.allRaw()) {
             // skip unowned objects, which can't provide detection to any empire
             if (obj->Unowned())
                 continue;
@@ -1926,12 +2532,12 @@ namespace {
                 continue;
 
             // don't allow moving ships / fleets to give detection
-            std::shared_ptr<const Fleet> fleet;
+            const Fleet* fleet = nullptr;
             if (obj->ObjectType() == UniverseObjectType::OBJ_FLEET) {
-                fleet = std::dynamic_pointer_cast<const Fleet>(obj);
+                fleet = static_cast<const Fleet*>(obj);
             } else if (obj->ObjectType() == UniverseObjectType::OBJ_SHIP) {
-                if (auto ship = static_cast<const Ship*>(obj.get()))
-                    fleet = objects.get<Fleet>(ship->FleetID());
+                if (auto ship = static_cast<const Ship*>(obj))
+                    fleet = objects.get<Fleet>(ship->FleetID()).get();
             }
             if (fleet) {
                 int cur_id = fleet->SystemID();
@@ -1969,24 +2575,75 @@ namespace {
         return retval;
     }
 
+    /** mean of empires' detection ranges at all their detector positions,
+      * which is used to size the cells of position grids queried with those
+      * ranges */
+    double TypicalDetectionRange(
+        const std::map<int, std::map<std::pair<double, double>, float>>& empire_position_detection_ranges)
+    {
+        double range_sum = 0.0;
+        std::size_t range_count = 0;
+        for (const auto& position_ranges : empire_position_detection_ranges) {
+            for (const auto& position_range : position_ranges.second) {
+                range_sum += position_range.second;
+                ++range_count;
+            }
+        }
+        return range_count > 0 ? range_sum / range_count : 0.0;
+    }
+
+    /** Positions of objects that could be detected by empires, indexed in a
+      * grid for detector range queries, and for each empire, which objects at
+      * each of those positions have low enough stealth that the empire could
+      * detect them if it has a detector in range. The grid is built once and
+      * shared by all empires' detection range checks. */
+    struct DetectableObjectPositions {
+        PositionGrid grid;
+        /** for each empire: for each grid position index: potentially detectable objects */
+        std::map<int, std::vector<std::vector<int>>> empire_position_objects;
+        /** for each grid position index: fields at that position */
+        std::vector<std::vector<const Field*>> position_fields;
+    };
+
     /** for each empire: for each position, what objects have low enough stealth
       * that the empire could detect them if an detector owned by the empire is in
       * range? */
-    std::map<int, std::map<std::pair<double, double>, std::vector<int>>>
-        GetEmpiresPositionsPotentiallyDetectableObjects(const ObjectMap& objects, const EmpireManager& empires,
-                                                        int empire_id = ALL_EMPIRES)
+    DetectableObjectPositions GetEmpiresPositionsPotentiallyDetectableObjects(
+        const ObjectMap& objects, const EmpireManager& empires, double typical_detection_range,
+        int empire_id = ALL_EMPIRES)
     {
-        std::map<int, std::map<std::pair<double, double>, std::vector<int>>> retval;
+        DetectableObjectPositions retval;
 
         auto empire_detection_strengths = GetEmpiresDetectionStrengths(empires, empire_id);
 
-        // filter objects as detectors for this empire or detectable objects
-        for (const auto& obj : objects.all()) {
-            const Meter* stealth_meter = obj->GetMeter(MeterType::METER_STEALTH);
-            if (!stealth_meter)
+        // find distinct positions of objects that could be detected
+        std::map<std::pair<double, double>, std::size_t> position_indices;
+        std::vector<std::pair<double, double>> positions;
+        std::vector<std::pair<const UniverseObject*, std::size_t>> objects_position_indices;
+        objects_position_indices.reserve(objects.size());
+
+        for (const auto* obj : objects.allRaw()) {
+            if (!obj->GetMeter(MeterType::METER_STEALTH))
                 continue;
-            float object_stealth = stealth_meter->Current();
             std::pair<double, double> object_pos(obj->X(), obj->Y());
+            auto [pos_it, inserted] = position_indices.emplace(object_pos, positions.size());
+            if (inserted)
+                positions.push_back(object_pos);
+            objects_position_indices.emplace_back(obj, pos_it->second);
+        }
+
+        const auto num_positions = positions.size();
+        retval.grid = PositionGrid(std::move(positions), typical_detection_range);
+        retval.position_fields.resize(num_positions);
+        for (const auto& empire_strength : empire_detection_strengths)
+            retval.empire_position_objects[empire_strength.first].resize(num_positions);
+
+        // filter objects as detectors for this empire or detectable objects
+        for (const auto& [obj, pos_idx] : objects_position_indices) {
+            float object_stealth = obj->GetMeter(MeterType::METER_STEALTH)->Current();
+
+            if (obj->ObjectType() == UniverseObjectType::OBJ_FIELD)
+                retval.position_fields[pos_idx].push_back(static_cast<const Field*>(obj));
 
             // for each empire being checked for, check if each object could be
             // detected by the empire if the empire has a detector in range.
@@ -1994,7 +2651,7 @@ namespace {
             // low enough stealth (0 or below the empire's detection strength)
             for (const auto& [empire_id, detection_strength] : empire_detection_strengths) {
                 if (object_stealth <= detection_strength || object_stealth <= 0.0f || obj->OwnedBy(empire_id))
-                    retval[empire_id][object_pos].emplace_back(obj->ID());
+                    retval.empire_position_objects[empire_id][pos_idx].push_back(obj->ID());
             }
         }
         return retval;
@@ -2003,69 +2660,105 @@ namespace {
     /** filters set of objects at locations by which of those locations are
       * within range of a set of detectors and ranges */
     std::vector<int> FilterObjectPositionsByDetectorPositionsAndRanges(
-        const std::map<std::pair<double, double>, std::vector<int>>& object_positions,
+        const PositionGrid& object_positions_grid,
+        const std::vector<std::vector<int>>& position_objects,
         const std::map<std::pair<double, double>, float>& detector_position_ranges)
     {
         std::vector<int> retval;
-        // check each detector position and range against each object position
-        for (const auto& object_position_entry : object_positions) {
-            const auto& object_pos = object_position_entry.first;
-            const auto& objects = object_position_entry.second;
-            // search through detector positions until one is found in range
-            for (const auto& detector_position_entry : detector_position_ranges) {
-                // check range for this detector location for this detectables location
-                float detector_range2 = detector_position_entry.second * detector_position_entry.second;
-                const auto& detector_pos = detector_position_entry.first;
-                double x_dist = detector_pos.first - object_pos.first;
-                double y_dist = detector_pos.second - object_pos.second;
-                double dist2 = x_dist*x_dist + y_dist*y_dist;
-                if (dist2 > detector_range2)
-                    continue;   // object out of range
-                // add objects at position to return value
-                std::copy(objects.begin(), objects.end(), std::back_inserter(retval));
-                break;  // done searching for a detector position in range
-            }
+        if (position_objects.empty())
+            return retval;
+        std::vector<bool> position_in_range(object_positions_grid.size(), false);
+
+        // find object positions in range of each detector
+        for (const auto& [detector_pos, detector_range] : detector_position_ranges) {
+            object_positions_grid.ForEachInRange(detector_pos.first, detector_pos.second, detector_range,
+                [&](std::size_t pos_idx) {
+                    if (position_in_range[pos_idx])
+                        return; // objects at position already added for another detector
+                    position_in_range[pos_idx] = true;
+                    // add objects at position to return value
+                    const auto& objects = position_objects[pos_idx];
+                    retval.insert(retval.end(), objects.begin(), objects.end());
+                });
         }
         return retval;
     }
 
+    /** returns the ids of objects in \a id_positions whose positions are within
+      * range of any of a set of detectors and ranges */
+    std::vector<int> FilterObjectIDPositionsByDetectorPositionsAndRanges(
+        const std::vector<std::pair<int, std::pair<double, double>>>& id_positions,
+        const std::map<std::pair<double, double>, float>& detector_position_ranges,
+        double typical_detection_range)
+    {
+        if (id_positions.empty() || detector_position_ranges.empty())
+            return {};
+
+        std::map<std::pair<double, double>, std::size_t> position_indices;
+        std::vector<std::pair<double, double>> positions;
+        std::vector<std::vector<int>> position_objects;
+        for (const auto& [object_id, object_pos] : id_positions) {
+            auto [pos_it, inserted] = position_indices.emplace(object_pos, positions.size());
+            if (inserted) {
+                positions.push_back(object_pos);
+                position_objects.emplace_back();
+            }
+            position_objects[pos_it->second].push_back(object_id);
+        }
+
+        const PositionGrid grid(std::move(positions), typical_detection_range);
+        return FilterObjectPositionsByDetectorPositionsAndRanges(grid, position_objects,
+                                                                 detector_position_ranges);
+    }
+
     /** removes ids of objects that the indicated empire knows have been
       * destroyed */
     void FilterObjectIDsByKnownDestruction(std::vector<int>& object_ids, int empire_id,
-                                           const std::map<int, std::set<int>>& empire_known_destroyed_object_ids)
+                                           const std::map<int, ObjectIDBitmap>& empire_known_destroyed_object_ids)
     {
         if (empire_id == ALL_EMPIRES)
             return;
-        for (auto it = object_ids.begin(); it != object_ids.end();) {
-            int object_id = *it;
-            auto obj_it = empire_known_destroyed_object_ids.find(object_id);
-            if (obj_it == empire_known_destroyed_object_ids.end()) {
-                ++it;
-                continue;
-            }
-            const std::set<int>& empires_that_know = obj_it->second;
-            if (!empires_that_know.count(empire_id)) {
-                ++it;
-                continue;
-            }
-            // remove object from vector...
-            *it = object_ids.back();
-            object_ids.pop_back();
-        }
+        auto empire_it = empire_known_destroyed_object_ids.find(empire_id);
+        if (empire_it == empire_known_destroyed_object_ids.end())
+            return;
+        const ObjectIDBitmap& known_destroyed_ids = empire_it->second;
+        object_ids.erase(std::remove_if(object_ids.begin(), object_ids.end(),
+                                        [&known_destroyed_ids](int object_id)
+                                        { return known_destroyed_ids.contains(object_id); }),
+                         object_ids.end());
     }
 
     /** sets visibility of field objects for empires based on input locations
-      * and stealth of fields in supplied ObjectMap and input empire detection
-      * ranges at locations. the rules for detection of fields are more
-      * permissive than other object types, so a special function for them is
-      * needed in addition to SetEmpireObjectVisibilitiesFromRanges(...) */
+      * and stealth of fields in supplied DetectableObjectPositions and input
+      * empire detection ranges at locations. the rules for detection of
+      * fields are more permissive than other object types, so a special
+      * function for them is needed in addition to
+      * SetEmpireObjectVisibilitiesFromRanges(...) */
     void SetEmpireFieldVisibilitiesFromRanges(
         const std::map<int, std::map<std::pair<double, double>, float>>&
             empire_location_detection_ranges,
-        const ObjectMap& objects)
+        const DetectableObjectPositions& detectable_positions)
     {
         Universe& universe = GetUniverse();
 
+        // fields are few compared to all detectable objects, so they get their
+        // own grid. fields can be detected from further away than their
+        // position by up to their size, so grid queries need to be extended
+        // by the largest field size to not miss any that might be in range
+        std::vector<const Field*> fields;
+        std::vector<PositionGrid::Position> field_positions;
+        double max_field_size = 0.0;
+        for (const auto& position_fields : detectable_positions.position_fields) {
+            for (const Field* field : position_fields) {
+                fields.push_back(field);
+                field_positions.emplace_back(field->X(), field->Y());
+                max_field_size = std::max<double>(max_field_size, field->GetMeter(MeterType::METER_SIZE)->Current());
+            }
+        }
+        if (fields.empty())
+            return;
+        const PositionGrid field_grid(std::move(field_positions), max_field_size);
+
         for (const auto& detecting_empire_entry : empire_location_detection_ranges) {
             int detecting_empire_id = detecting_empire_entry.first;
             double detection_strength = 0.0;
@@ -2080,29 +2773,27 @@ namespace {
             // get empire's locations of detection ranges
             const auto& detector_position_ranges = detecting_empire_entry.second;
 
-            // for each field, try to find a detector position in range for this empire
-            for (auto& field : objects.all<Field>()) {
-                if (field->GetMeter(MeterType::METER_STEALTH)->Current() > detection_strength)
-                    continue;
-                double field_size = field->GetMeter(MeterType::METER_SIZE)->Current();
-                const std::pair<double, double> object_pos(field->X(), field->Y());
-
-                // search through detector positions until one is found in range
-                for (const auto& detector_position_entry : detector_position_ranges) {
-                    // check range for this detector location, for field of this
-                    // size, against distance between field and detector
-                    float detector_range = detector_position_entry.second;
-                    const auto& detector_pos = detector_position_entry.first;
-                    double x_dist = detector_pos.first - object_pos.first;
-                    double y_dist = detector_pos.second - object_pos.second;
-                    double dist = std::sqrt(x_dist*x_dist + y_dist*y_dist);
-                    double effective_dist = dist - field_size;
-                    if (effective_dist > detector_range)
-                        continue;   // object out of range
-
-                    universe.SetEmpireObjectVisibility(detecting_empire_id, field->ID(),
-                                                       Visibility::VIS_PARTIAL_VISIBILITY);
-                }
+            // for each detector position, find fields in range for this empire
+            for (const auto& [detector_pos, detector_range] : detector_position_ranges) {
+                field_grid.ForEachInRange(
+                    detector_pos.first, detector_pos.second, detector_range + max_field_size,
+                    [&](std::size_t field_idx) {
+                        const Field* field = fields[field_idx];
+                        if (field->GetMeter(MeterType::METER_STEALTH)->Current() > detection_strength)
+                            return;
+                        // check range for this detector location, for field of this
+                        // size, against distance between field and detector
+                        double field_size = field->GetMeter(MeterType::METER_SIZE)->Current();
+                        double x_dist = detector_pos.first - field->X();
+                        double y_dist = detector_pos.second - field->Y();
+                        double dist = std::sqrt(x_dist*x_dist + y_dist*y_dist);
+                        double effective_dist = dist - field_size;
+                        if (effective_dist > detector_range)
+                            return; // object out of range
+
+                        universe.SetEmpireObjectVisibility(detecting_empire_id, field->ID(),
+                                                           Visibility::VIS_PARTIAL_VISIBILITY);
+                    });
             }
         }
     }
@@ -2113,8 +2804,7 @@ namespace {
     void SetEmpireObjectVisibilitiesFromRanges(
         const std::map<int, std::map<std::pair<double, double>, float>>&
             empire_location_detection_ranges,
-        const std::map<int, std::map<std::pair<double, double>, std::vector<int>>>&
-            empire_location_potentially_detectable_objects)
+        const DetectableObjectPositions& detectable_positions)
     {
         Universe& universe = GetUniverse();
 
@@ -2124,8 +2814,8 @@ namespace {
             const auto& detector_position_ranges = detecting_empire_entry.second;
             // for this empire, get objects it could potentially detect
             const auto empire_detectable_objects_it =
-                empire_location_potentially_detectable_objects.find(detecting_empire_id);
-            if (empire_detectable_objects_it == empire_location_potentially_detectable_objects.end())
+                detectable_positions.empire_position_objects.find(detecting_empire_id);
+            if (empire_detectable_objects_it == detectable_positions.empire_position_objects.end())
                 continue;   // empire can't detect anything!
             const auto& detectable_position_objects = empire_detectable_objects_it->second;
             if (detectable_position_objects.empty())
@@ -2134,7 +2824,8 @@ namespace {
             // filter potentially detectable objects by which are within range
             // of a detector
             std::vector<int> in_range_detectable_objects =
-                FilterObjectPositionsByDetectorPositionsAndRanges(detectable_position_objects,
+                FilterObjectPositionsByDetectorPositionsAndRanges(detectable_positions.grid,
+                                                                  detectable_position_objects,
                                                                   detector_position_ranges);
             if (in_range_detectable_objects.empty())
                 continue;
@@ -2150,7 +2841,7 @@ namespace {
 
     /** sets visibility of objects that empires own for those objects */
     void SetEmpireOwnedObjectVisibilities(Universe& universe) {
-        for (const auto& obj : universe.Objects().all()) {
+        for (const auto* obj : universe.Objects().allRaw()) {
             if (!obj->Unowned())
                 universe.SetEmpireObjectVisibility(obj->Owner(), obj->ID(), Visibility::VIS_FULL_VISIBILITY);
         }
@@ -2159,7 +2850,7 @@ namespace {
     /** sets all objects visible to all empires */
     void SetAllObjectsVisibleToAllEmpires(Universe& universe) {
         // set every object visible to all empires
-        for (const auto& obj : universe.Objects().all()) {
+        for (const auto* obj : universe.Objects().allRaw()) {
             for (auto& empire_entry : Empires()) {
                 if (empire_entry.second->Eliminated())
                     continue;
@@ -2173,7 +2864,7 @@ namespace {
 
     /** sets all systems basically visible to all empires */
     void SetAllSystemsBasicallyVisibleToAllEmpires(Universe& universe) {
-        for (const auto& obj : universe.Objects().all<System>()) {
+        for (const auto* obj : universe.Objects().allRaw<System>()) {
             for (auto& empire_entry : Empires()) {
                 if (empire_entry.second->Eliminated())
                     continue;
@@ -2190,7 +2881,7 @@ namespace {
         // map from empire ID to ID of systems where those empires own at least one object
         std::map<int, std::set<int>> empires_systems_with_owned_objects;
         // get systems where empires have owned objects
-        for (const auto& obj : objects.all()) {
+        for (const auto* obj : objects.allRaw()) {
             if (obj->Unowned() || obj->SystemID() == INVALID_OBJECT_ID)
                 continue;
             empires_systems_with_owned_objects[obj->Owner()].insert(obj->SystemID());
@@ -2204,7 +2895,7 @@ namespace {
         }
 
         // get planets, check their locations, and whether they have ever been observed by the empire
-        for (const auto& planet : objects.all<Planet>()) {
+        for (const auto* planet : objects.allRaw<Planet>()) {
             int system_id = planet->SystemID();
             if (system_id == INVALID_OBJECT_ID)
                 continue;
@@ -2218,7 +2909,7 @@ namespace {
                 if (!empire_systems.count(system_id))
                     continue;   // no objects, don't grant any visibility
 
-                if (GetGameRules().Get<bool>("RULE_UNSEEN_STEALTHY_PLANETS_INVISIBLE")) {
+                if (RULE_UNSEEN_STEALTHY_PLANETS_INVISIBLE.Get()) {
                     // has the empire ever detected the planet?
                     auto& turns_seen_by_empire = universe.GetObjectVisibilityTurnMapByEmpire(planet->ID(), empire_id);
                     if (turns_seen_by_empire.empty())
@@ -2314,7 +3005,18 @@ namespace {
         }   // end for container objects
     }
 
-    void PropagateVisibilityToSystemsAlongStarlanes(
+    /** raises the visibility of object \a object_id in \a vis_map to at least
+      * basic visibility, adding an entry for it if there isn't one */
+    void SetAtLeastBasicVisibility(Universe::ObjectVisibilityMap& vis_map, int object_id) {
+        auto& vis = vis_map[object_id];
+        if (vis < Visibility::VIS_BASIC_VISIBILITY)
+            vis = Visibility::VIS_BASIC_VISIBILITY;
+    }
+
+    /** propagates visibility along starlanes as
+      * PropagateVisibilityToSystemsAlongStarlanes(...) does, by walking the
+      * starlanes of each system for each empire. used to check that function */
+    void PropagateVisibilityToSystemsAlongStarlanesByWalking(
         const ObjectMap& objects, Universe::EmpireObjectVisibilityMap& empire_object_visibility)
     {
         for (auto& system : objects.all<System>()) {
@@ -2356,6 +3058,111 @@ namespace {
 
     }
 
+    /** upgrades systems at the ends of starlanes from systems that an empire
+      * has at least partial visibility of to at least basic visibility for
+      * that empire, so that starlanes will be visible if either system they
+      * end at is partially visible or better.  the systems each system's
+      * starlanes reach are found once, and then for each system the set of
+      * empires that partially see it is OR'd into the sets of empires for
+      * which the systems at the ends of its starlanes become basically
+      * visible, for all empires at once. */
+    void PropagateVisibilityToSystemsAlongStarlanes(
+        const ObjectMap& objects, Universe::EmpireObjectVisibilityMap& empire_object_visibility)
+    {
+        if (empire_object_visibility.empty())
+            return;
+
+        std::vector<Universe::ObjectVisibilityMap*> vis_maps;
+        vis_maps.reserve(empire_object_visibility.size());
+        for (auto& empire_entry : empire_object_visibility)
+            vis_maps.push_back(&empire_entry.second);
+
+        // starlanes (not wormholes) of each system, as rows of lane end ids
+        std::vector<int> system_ids;
+        std::vector<std::size_t> lane_row_starts{0};
+        std::vector<int> lane_end_ids;
+        int max_lane_end_id = INVALID_OBJECT_ID;
+        for (auto& system : objects.all<System>()) {
+            system_ids.push_back(system->ID());
+            for (auto& [lane_end_id, is_wormhole] : system->StarlanesWormholes()) {
+                if (is_wormhole || lane_end_id < 0)
+                    continue;
+                lane_end_ids.push_back(lane_end_id);
+                max_lane_end_id = std::max(max_lane_end_id, lane_end_id);
+            }
+            lane_row_starts.push_back(lane_end_ids.size());
+        }
+        if (lane_end_ids.empty())
+            return;
+
+        // for each system id, the empires for which it is at the end of a
+        // starlane from a partially visible system
+        std::vector<boost::dynamic_bitset<>> reaching_empires(
+            static_cast<std::size_t>(max_lane_end_id) + 1, boost::dynamic_bitset<>(vis_maps.size()));
+        boost::dynamic_bitset<> partially_seeing_empires(vis_maps.size());
+
+        for (std::size_t system_idx = 0; system_idx < system_ids.size(); ++system_idx) {
+            const auto row_begin = lane_row_starts[system_idx], row_end = lane_row_starts[system_idx + 1];
+            if (row_begin == row_end)
+                continue;
+
+            // systems that aren't at least partially visible can't propagate visibility along starlanes
+            partially_seeing_empires.reset();
+            for (std::size_t empire_idx = 0; empire_idx < vis_maps.size(); ++empire_idx) {
+                if (vis_maps[empire_idx]->Get(system_ids[system_idx]) > Visibility::VIS_BASIC_VISIBILITY)
+                    partially_seeing_empires.set(empire_idx);
+            }
+            if (partially_seeing_empires.none())
+                continue;
+
+            for (auto lane_idx = row_begin; lane_idx < row_end; ++lane_idx)
+                reaching_empires[lane_end_ids[lane_idx]] |= partially_seeing_empires;
+        }
+
+        for (std::size_t lane_end_id = 0; lane_end_id < reaching_empires.size(); ++lane_end_id) {
+            const auto& empires = reaching_empires[lane_end_id];
+            for (auto empire_idx = empires.find_first(); empire_idx != boost::dynamic_bitset<>::npos;
+                 empire_idx = empires.find_next(empire_idx))
+            { SetAtLeastBasicVisibility(*vis_maps[empire_idx], static_cast<int>(lane_end_id)); }
+        }
+    }
+
+    /** propagates visibility along starlanes, and if the
+      * universe.visibility.check-propagation option is set, checks that the
+      * result is the same as walking the starlanes of each system */
+    void PropagateVisibilityToSystemsAlongStarlanesAndCheck(
+        const ObjectMap& objects, Universe::EmpireObjectVisibilityMap& empire_object_visibility)
+    {
+        if (!GetOptionsDB().Get<bool>("universe.visibility.check-propagation")) {
+            PropagateVisibilityToSystemsAlongStarlanes(objects, empire_object_visibility);
+            return;
+        }
+
+        auto walked_visibility = empire_object_visibility;
+        PropagateVisibilityToSystemsAlongStarlanesByWalking(objects, walked_visibility);
+        PropagateVisibilityToSystemsAlongStarlanes(objects, empire_object_visibility);
+
+        for (const auto& [empire_id, vis_map] : empire_object_visibility) {
+            const auto& walked_vis_map = walked_visibility[empire_id];
+            if (vis_map == walked_vis_map)
+                continue;
+            for (const auto& [object_id, vis] : vis_map) {
+                if (!walked_vis_map.count(object_id))
+                    ErrorLogger() << "PropagateVisibilityToSystemsAlongStarlanes gave empire " << empire_id
+                                  << " visibility " << vis << " of object " << object_id << " but walking starlanes gave none";
+                else if (walked_vis_map.Get(object_id) != vis)
+                    ErrorLogger() << "PropagateVisibilityToSystemsAlongStarlanes gave empire " << empire_id
+                                  << " visibility " << vis << " of object " << object_id << " but walking starlanes gave "
+                                  << walked_vis_map.Get(object_id);
+            }
+            for (const auto& [object_id, walked_vis] : walked_vis_map) {
+                if (!vis_map.count(object_id))
+                    ErrorLogger() << "PropagateVisibilityToSystemsAlongStarlanes gave empire " << empire_id
+                                  << " no visibility of object " << object_id << " but walking starlanes gave " << walked_vis;
+            }
+        }
+    }
+
     void SetTravelledStarlaneEndpointsVisible(const ObjectMap& objects,
                                               Universe::EmpireObjectVisibilityMap& empire_object_visibility)
     {
@@ -2375,22 +3182,8 @@ namespace {
             // ensure fleet's owner has at least basic visibility of the next
             // and previous systems on the fleet's path
             auto& vis_map = empire_object_visibility[fleet->Owner()];
-
-            auto system_vis_it = vis_map.find(prev);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[prev] = Visibility::VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < Visibility::VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = Visibility::VIS_BASIC_VISIBILITY;
-            }
-
-            system_vis_it = vis_map.find(next);
-            if (system_vis_it == vis_map.end()) {
-                vis_map[next] = Visibility::VIS_BASIC_VISIBILITY;
-            } else {
-                if (system_vis_it->second < Visibility::VIS_BASIC_VISIBILITY)
-                    system_vis_it->second = Visibility::VIS_BASIC_VISIBILITY;
-            }
+            SetAtLeastBasicVisibility(vis_map, prev);
+            SetAtLeastBasicVisibility(vis_map, next);
         }
     }
 
@@ -2478,18 +3271,12 @@ namespace {
                 // add allied visibilities to outer-loop empire visibilities
                 // whenever the ally has better visibility of an object
                 // (will do the reverse in another loop iteration)
-                for (auto const& allied_obj_id_vis_pair : allied_obj_vis_map) {
-                    int obj_id = allied_obj_id_vis_pair.first;
-                    Visibility allied_vis = allied_obj_id_vis_pair.second;
-                    auto it = obj_vis_map.find(obj_id);
-                    if (it == obj_vis_map.end() || it->second < allied_vis) {
-                        obj_vis_map[obj_id] = allied_vis;
-                        if (allied_vis < Visibility::VIS_PARTIAL_VISIBILITY)
-                            continue;
-                        if (auto ship = universe.Objects().get<Ship>(obj_id))
-                            universe.SetEmpireKnowledgeOfShipDesign(ship->DesignID(), empire_id);
-                    }
-                }
+                obj_vis_map.MergeMax(allied_obj_vis_map, [&universe, empire_id](int obj_id, Visibility allied_vis) {
+                    if (allied_vis < Visibility::VIS_PARTIAL_VISIBILITY)
+                        return;
+                    if (auto ship = universe.Objects().get<Ship>(obj_id))
+                        universe.SetEmpireKnowledgeOfShipDesign(ship->DesignID(), empire_id);
+                });
 
                 // add allied visibilities of specials to outer-loop empire
                 // visibilities as well
@@ -2519,10 +3306,10 @@ void Universe::UpdateEmpireObjectVisibilities(EmpireManager& empires) {
     m_empire_object_visibility.clear();
     m_empire_object_visible_specials.clear();
 
-    if (GetGameRules().Get<bool>("RULE_ALL_OBJECTS_VISIBLE")) {
+    if (RULE_ALL_OBJECTS_VISIBLE.Get()) {
         SetAllObjectsVisibleToAllEmpires(*this);
         return;
-    } else if (GetGameRules().Get<bool>("RULE_ALL_SYSTEMS_VISIBLE")) {
+    } else if (RULE_ALL_SYSTEMS_VISIBLE.Get()) {
         SetAllSystemsBasicallyVisibleToAllEmpires(*this);
     }
 
@@ -2530,12 +3317,14 @@ void Universe::UpdateEmpireObjectVisibilities(EmpireManager& empires) {
 
     auto empire_position_detection_ranges = GetEmpiresPositionDetectionRanges(*m_objects);
 
-    auto empire_position_potentially_detectable_objects =
-        GetEmpiresPositionsPotentiallyDetectableObjects(*m_objects, empires);
+    const auto empire_position_potentially_detectable_objects =
+        GetEmpiresPositionsPotentiallyDetectableObjects(
+            *m_objects, empires, TypicalDetectionRange(empire_position_detection_ranges));
 
     SetEmpireObjectVisibilitiesFromRanges(empire_position_detection_ranges,
                                           empire_position_potentially_detectable_objects);
-    SetEmpireFieldVisibilitiesFromRanges(empire_position_detection_ranges, *m_objects);
+    SetEmpireFieldVisibilitiesFromRanges(empire_position_detection_ranges,
+                                         empire_position_potentially_detectable_objects);
 
     SetSameSystemPlanetsVisible(*m_objects);
 
@@ -2543,7 +3332,7 @@ void Universe::UpdateEmpireObjectVisibilities(EmpireManager& empires) {
 
     PropagateVisibilityToContainerObjects(*m_objects, m_empire_object_visibility);
 
-    PropagateVisibilityToSystemsAlongStarlanes(*m_objects, m_empire_object_visibility);
+    PropagateVisibilityToSystemsAlongStarlanesAndCheck(*m_objects, m_empire_object_visibility);
 
     SetTravelledStarlaneEndpointsVisible(*m_objects, m_empire_object_visibility);
 
@@ -2558,8 +3347,8 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
 
     // assumes m_empire_object_visibility has been updated
 
-    //  for each object in universe
-    //      for each empire that can see object this turn
+    //  for each empire
+    //      for each object that empire can see this turn
     //          update empire's information about object, based on visibility
     //          update empire's visbilility turn history
 
@@ -2567,61 +3356,70 @@ void Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() {
     if (current_turn == INVALID_GAME_TURN)
         return;
 
-    // for each object in universe
-    for (const auto& full_object : m_objects->all()) {
-        if (!full_object) {
-            ErrorLogger() << "UpdateEmpireLatestKnownObjectsAndVisibilityTurns found null object in m_objects";
+    // each empire's latest known objects and visibility turns are updated
+    // independently of other empires', so empires are processed in parallel.
+    // the per-empire maps are created up front so that the tasks don't modify
+    // the maps containing them. the known objects' signals are inhibited for
+    // the duration, as nothing observes them and the flag isn't thread safe.
+    const bool signals_were_inhibited = m_inhibit_universe_object_signals;
+    m_inhibit_universe_object_signals = true;
+
+    TaskBatch task_batch("Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns");
+    for (auto& [empire_id, vis_map] : m_empire_object_visibility) {
+        const bool sees_any_object = std::any_of(vis_map.begin(), vis_map.end(), [](const auto& id_vis)
+                                                 { return id_vis.second > Visibility::VIS_NO_VISIBILITY; });
+        if (!sees_any_object)
             continue;
-        }
-        int object_id = full_object->ID();
 
-        // for each empire with a visibility map
-        for (auto& [empire_id, vis_map] : m_empire_object_visibility) {
-            // can empire see object?
-            auto vis_it = vis_map.find(object_id);
-            if (vis_it == vis_map.end())
-                continue;   // empire can't see current object, so move to next empire
-            const Visibility vis = vis_it->second;
-            if (vis <= Visibility::VIS_NO_VISIBILITY)
-                continue;   // empire can't see current object, so move to next empire
+        ObjectMap& known_object_map = m_empire_latest_known_objects[empire_id];        // creates empty map if none yet present
+        ObjectVisibilityTurnMap& object_vis_turn_map = m_empire_object_visibility_turns[empire_id];  // creates empty map if none yet present
 
-            // empire can see object.  need to update empire's latest known
-            // information about object, and historical turns on which object
-            // was seen at various visibility levels.
+        task_batch.Post([this, empire_id{empire_id}, &vis_map = vis_map, &known_object_map,
+                         &object_vis_turn_map, current_turn]()
+        {
+            // for each object the empire can see this turn
+            for (const auto& [object_id, vis] : vis_map) {
+                if (vis <= Visibility::VIS_NO_VISIBILITY)
+                    continue;   // empire can't see current object, so move to next object
 
-            ObjectMap&                  known_object_map = m_empire_latest_known_objects[empire_id];        // creates empty map if none yet present
-            ObjectVisibilityTurnMap&    object_vis_turn_map = m_empire_object_visibility_turns[empire_id];  // creates empty map if none yet present
-            VisibilityTurnMap&          vis_turn_map = object_vis_turn_map[object_id];                      // creates empty map if none yet present
+                auto full_object = m_objects->get(object_id);
+                if (!full_object)
+                    continue;
 
+                // empire can see object.  need to update empire's latest known
+                // information about object, and historical turns on which object
+                // was seen at various visibility levels.
 
-            // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
+                VisibilityTurnMap& vis_turn_map = object_vis_turn_map[object_id];   // creates empty map if none yet present
 
-            // is there already last known version of an UniverseObject stored for this empire?
-            if (auto known_obj = known_object_map.get(object_id)) {
-                known_obj->Copy(full_object, empire_id);                    // already a stored version of this object for this empire.  update it, limited by visibility this empire has for this object this turn
-            } else {
-                if (auto new_obj = std::shared_ptr<UniverseObject>(full_object->Clone(empire_id)))    // no previously-recorded version of this object for this empire.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
-                    known_object_map.insert(new_obj);
-            }
+                // update empire's latest known data about object, based on current visibility and historical visibility and knowledge of object
 
-            //DebugLogger() << "Empire " << empire_id << " can see object " << object_id << " with vis level " << vis;
+                // is there already last known version of an UniverseObject stored for this empire?
+                if (auto known_obj = known_object_map.get(object_id)) {
+                    known_obj->Copy(full_object, empire_id);                    // already a stored version of this object for this empire.  update it, limited by visibility this empire has for this object this turn
+                } else {
+                    if (auto new_obj = std::shared_ptr<UniverseObject>(full_object->Clone(empire_id)))    // no previously-recorded version of this object for this empire.  create a new one, copying only the information limtied by visibility, leaving the rest as default values
+                        known_object_map.insert(new_obj);
+                }
 
-            // update empire's visibility turn history for current vis, and lesser vis levels
-            if (vis >= Visibility::VIS_BASIC_VISIBILITY) {
-                vis_turn_map[Visibility::VIS_BASIC_VISIBILITY] = current_turn;
-                if (vis >= Visibility::VIS_PARTIAL_VISIBILITY) {
-                    vis_turn_map[Visibility::VIS_PARTIAL_VISIBILITY] = current_turn;
-                    if (vis >= Visibility::VIS_FULL_VISIBILITY) {
-                        vis_turn_map[Visibility::VIS_FULL_VISIBILITY] = current_turn;
+                // update empire's visibility turn history for current vis, and lesser vis levels
+                if (vis >= Visibility::VIS_BASIC_VISIBILITY) {
+                    vis_turn_map[Visibility::VIS_BASIC_VISIBILITY] = current_turn;
+                    if (vis >= Visibility::VIS_PARTIAL_VISIBILITY) {
+                        vis_turn_map[Visibility::VIS_PARTIAL_VISIBILITY] = current_turn;
+                        if (vis >= Visibility::VIS_FULL_VISIBILITY) {
+                            vis_turn_map[Visibility::VIS_FULL_VISIBILITY] = current_turn;
+                        }
                     }
+                } else {
+                    ErrorLogger() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() found invalid visibility for object with id " << object_id << " by empire with id " << empire_id;
                 }
-                //DebugLogger() << " ... Setting empire " << empire_id << " object " << full_object->Name() << " (" << object_id << ") vis " << vis << " (and higher) turn to " << current_turn;
-            } else {
-                ErrorLogger() << "Universe::UpdateEmpireLatestKnownObjectsAndVisibilityTurns() found invalid visibility for object with id " << object_id << " by empire with id " << empire_id;
-                continue;
             }
-        }
+        }, "empire " + std::to_string(empire_id));
     }
+    task_batch.Wait();
+
+    m_inhibit_universe_object_signals = signals_were_inhibited;
 }
 
 void Universe::UpdateEmpireStaleObjectKnowledge(EmpireManager& empires) {
@@ -2632,29 +3430,22 @@ void Universe::UpdateEmpireStaleObjectKnowledge(EmpireManager& empires) {
     // (including stealth and position) appears to be stale / out of date.
 
     const auto empire_location_detection_ranges = GetEmpiresPositionDetectionRanges(*m_objects);
+    const auto typical_detection_range = TypicalDetectionRange(empire_location_detection_ranges);
 
     for (const auto& empire_entry : m_empire_latest_known_objects) {
         int empire_id = empire_entry.first;
         const ObjectMap& latest_known_objects = empire_entry.second;
         const ObjectVisibilityMap& vis_map = m_empire_object_visibility[empire_id];
-        std::set<int>& stale_set = m_empire_stale_knowledge_object_ids[empire_id];
-        const std::set<int>& destroyed_set = m_empire_known_destroyed_object_ids[empire_id];
+        ObjectIDBitmap& stale_set = m_empire_stale_knowledge_object_ids[empire_id];
+        const ObjectIDBitmap& destroyed_set = m_empire_known_destroyed_object_ids[empire_id];
 
         // remove stale marking for any known destroyed or currently visible objects
-        for (auto stale_it = stale_set.begin(); stale_it != stale_set.end();) {
-            int object_id = *stale_it;
-            if (vis_map.count(object_id) || destroyed_set.count(object_id))
-                stale_it = stale_set.erase(stale_it);
-            else
-                ++stale_it;
-        }
-
-
-        // get empire latest known objects that are potentially detectable
-        auto empires_latest_known_objects_that_should_be_detectable =
-            GetEmpiresPositionsPotentiallyDetectableObjects(latest_known_objects, empires, empire_id);
-        auto& empire_latest_known_should_be_still_detectable_objects =
-            empires_latest_known_objects_that_should_be_detectable[empire_id];
+        std::vector<int> no_longer_stale_ids;
+        for (int object_id : stale_set)
+            if (vis_map.count(object_id) || destroyed_set.contains(object_id))
+                no_longer_stale_ids.push_back(object_id);
+        for (int object_id : no_longer_stale_ids)
+            stale_set.erase(object_id);
 
 
         // get empire detection ranges
@@ -2663,13 +3454,85 @@ void Universe::UpdateEmpireStaleObjectKnowledge(EmpireManager& empires) {
             continue;
         const auto& empire_detector_positions_ranges = empire_detectors_it->second;
 
+        auto& detection = m_empire_stale_knowledge_detection[empire_id];
+        ++detection.update;
+
+        // detectors that are new or have longer ranges than at the last update
+        // may be in range of objects that weren't before, and if any detector
+        // is gone or has a shorter range, objects that were in range may not be
+        std::map<std::pair<double, double>, float> extended_detector_positions_ranges;
+        for (const auto& [detector_pos, detector_range] : empire_detector_positions_ranges) {
+            auto it = detection.detector_ranges.find(detector_pos);
+            if (it == detection.detector_ranges.end() || it->second < detector_range)
+                extended_detector_positions_ranges.emplace(detector_pos, detector_range);
+        }
+        const bool any_detector_reduced = std::any_of(
+            detection.detector_ranges.begin(), detection.detector_ranges.end(),
+            [&empire_detector_positions_ranges](const auto& pos_range) {
+                auto it = empire_detector_positions_ranges.find(pos_range.first);
+                return it == empire_detector_positions_ranges.end() || it->second < pos_range.second;
+            });
+
+        // an object needs to be checked against all detectors if its latest
+        // known position changed, or if it was in range of a detector that may
+        // now be gone. otherwise, if it wasn't in range, it only needs to be
+        // checked against the detectors that are new or extended.
+        const auto empire_detection_strengths = GetEmpiresDetectionStrengths(empires, empire_id);
+        const auto strength_it = empire_detection_strengths.find(empire_id);
+        std::vector<std::pair<int, std::pair<double, double>>> recheck_all_detectors;
+        std::vector<std::pair<int, std::pair<double, double>>> recheck_extended_detectors;
 
-        // filter should-be-still-detectable objects by whether they are
-        // in range of a detector
-        std::vector<int> should_still_be_detectable_latest_known_objects =
-            FilterObjectPositionsByDetectorPositionsAndRanges(
-                empire_latest_known_should_be_still_detectable_objects,
-                empire_detector_positions_ranges);
+        for (const auto* obj : latest_known_objects.allRaw()) {
+            const Meter* stealth_meter = obj->GetMeter(MeterType::METER_STEALTH);
+            if (!stealth_meter)
+                continue;
+
+            auto [known_it, inserted] = detection.known_objects.try_emplace(obj->ID());
+            auto& known = known_it->second;
+            known.update = detection.update;
+
+            // being detectable by an empire requires the object to have
+            // low enough stealth (0 or below the empire's detection strength)
+            const float object_stealth = stealth_meter->Current();
+            known.detectable = strength_it != empire_detection_strengths.end() &&
+                (object_stealth <= strength_it->second || object_stealth <= 0.0f || obj->OwnedBy(empire_id));
+
+            if (inserted || known.x != obj->X() || known.y != obj->Y() ||
+                (known.in_detection_range && any_detector_reduced))
+            {
+                known.x = obj->X();
+                known.y = obj->Y();
+                known.in_detection_range = false;
+                recheck_all_detectors.emplace_back(obj->ID(), std::pair{obj->X(), obj->Y()});
+
+            } else if (!known.in_detection_range && !extended_detector_positions_ranges.empty()) {
+                recheck_extended_detectors.emplace_back(obj->ID(), std::pair{obj->X(), obj->Y()});
+            }
+        }
+
+        for (int object_id : FilterObjectIDPositionsByDetectorPositionsAndRanges(
+                 recheck_all_detectors, empire_detector_positions_ranges, typical_detection_range))
+        { detection.known_objects[object_id].in_detection_range = true; }
+        for (int object_id : FilterObjectIDPositionsByDetectorPositionsAndRanges(
+                 recheck_extended_detectors, extended_detector_positions_ranges, typical_detection_range))
+        { detection.known_objects[object_id].in_detection_range = true; }
+
+        detection.detector_ranges = empire_detector_positions_ranges;
+
+
+        // collect should-be-still-detectable objects that are in range of a
+        // detector, and forget objects that are no longer known
+        std::vector<int> should_still_be_detectable_latest_known_objects;
+        for (auto known_it = detection.known_objects.begin(); known_it != detection.known_objects.end();) {
+            const auto& [object_id, known] = *known_it;
+            if (known.update != detection.update) {
+                known_it = detection.known_objects.erase(known_it);
+                continue;
+            }
+            if (known.in_detection_range && known.detectable)
+                should_still_be_detectable_latest_known_objects.push_back(object_id);
+            ++known_it;
+        }
 
 
         // filter to exclude objects that are known to have been destroyed, as
@@ -2770,129 +3633,177 @@ void Universe::SetEmpireKnowledgeOfShipDesign(int ship_design_id, int empire_id)
     m_empire_known_ship_design_ids[empire_id].insert(ship_design_id);
 }
 
-void Universe::Destroy(int object_id, bool update_destroyed_object_knowers/* = true*/) {
-    // remove object from any containing UniverseObject
-    auto obj = m_objects->get(object_id);
-    if (!obj) {
-        ErrorLogger() << "Universe::Destroy called for nonexistant object with id: " << object_id;
-        return;
+void Universe::Destroy(int object_id, bool update_destroyed_object_knowers/* = true*/)
+{ Destroy(std::vector<int>{object_id}, update_destroyed_object_knowers); }
+
+void Universe::Destroy(const std::vector<int>& object_ids, bool update_destroyed_object_knowers/* = true*/) {
+    std::vector<std::shared_ptr<UniverseObject>> objs;
+    objs.reserve(object_ids.size());
+    for (int object_id : object_ids) {
+        auto obj = m_objects->get(object_id);
+        if (!obj) {
+            ErrorLogger() << "Universe::Destroy called for nonexistant object with id: " << object_id;
+            continue;
+        }
+        objs.push_back(std::move(obj));
     }
+    if (objs.empty())
+        return;
 
-    m_destroyed_object_ids.insert(object_id);
+    for (const auto& obj : objs)
+        m_destroyed_object_ids.insert(obj->ID());
 
     if (update_destroyed_object_knowers) {
-        // record empires that know this object has been destroyed
+        // record empires that know these objects have been destroyed
         for (auto& empire_entry : Empires()) {
             int empire_id = empire_entry.first;
-            if (obj->GetVisibility(empire_id) >= Visibility::VIS_BASIC_VISIBILITY) {
-                SetEmpireKnowledgeOfDestroyedObject(object_id, empire_id);
-                // TODO: Update m_empire_latest_known_objects somehow?
+            ObjectIDBitmap* known_destroyed_ids = nullptr;
+            for (const auto& obj : objs) {
+                if (obj->GetVisibility(empire_id) >= Visibility::VIS_BASIC_VISIBILITY) {
+                    if (!known_destroyed_ids)
+                        known_destroyed_ids = &m_empire_known_destroyed_object_ids[empire_id];
+                    known_destroyed_ids->insert(obj->ID());
+                    // TODO: Update m_empire_latest_known_objects somehow?
+                }
             }
         }
     }
 
-    // signal that an object has been deleted
-    UniverseObjectDeleteSignal(obj);
-    m_objects->erase(object_id);
+    if (std::any_of(objs.begin(), objs.end(), [](const auto& obj)
+                    { return obj->ObjectType() == UniverseObjectType::OBJ_SYSTEM; }))
+    { StarlaneTopologyChanged(); }
+
+    for (const auto& obj : objs) {
+        // signal that an object has been deleted
+        UniverseObjectDeleteSignal(obj);
+        m_objects->erase(obj->ID());
+    }
 }
 
-std::set<int> Universe::RecursiveDestroy(int object_id) {
-    std::set<int> retval;
+std::set<int> Universe::RecursiveDestroy(int object_id)
+{ return RecursiveDestroy(std::vector<int>{object_id}); }
 
-    auto obj = m_objects->get(object_id);
-    if (!obj) {
-        DebugLogger() << "Universe::RecursiveDestroy asked to destroy nonexistant object with id " << object_id;
-        return retval;
-    }
+std::set<int> Universe::RecursiveDestroy(const std::vector<int>& object_ids) {
+    // ids of objects to destroy, in the order they are found
+    std::vector<int> destroy_ids;
+    std::set<int> retval;
+    const auto add_to_destroy = [&destroy_ids, &retval](int id) {
+        if (retval.insert(id).second)
+            destroy_ids.push_back(id);
+    };
 
-    auto system = m_objects->get<System>(obj->SystemID());
+    // 1) find all objects to destroy, without yet changing any objects
+    std::vector<int> destroyed_system_ids;
+    const auto add_fleet_to_destroy = [&add_to_destroy](const Fleet& fleet) {
+        for (int ship_id : fleet.ShipIDs())
+            add_to_destroy(ship_id);
+        add_to_destroy(fleet.ID());
+    };
 
-    if (auto ship = std::dynamic_pointer_cast<Ship>(obj)) {
-        // if a ship is being deleted, and it is the last ship in its fleet, then the empty fleet should also be deleted
-        auto fleet = m_objects->get<Fleet>(ship->FleetID());
-        if (fleet) {
-            fleet->RemoveShips({ship->ID()});
-            if (fleet->Empty()) {
-                if (system)
-                    system->Remove(fleet->ID());
-                Destroy(fleet->ID());
-                retval.insert(fleet->ID());
-            }
+    for (int object_id : object_ids) {
+        auto obj = m_objects->get(object_id);
+        if (!obj) {
+            DebugLogger() << "Universe::RecursiveDestroy asked to destroy nonexistant object with id " << object_id;
+            continue;
         }
-        if (system)
-            system->Remove(object_id);
-        Destroy(object_id);
-        retval.insert(object_id);
-
-    } else if (auto obj_fleet = std::dynamic_pointer_cast<Fleet>(obj)) {
-        for (int ship_id : obj_fleet->ShipIDs()) {
-            if (system)
-                system->Remove(ship_id);
-            Destroy(ship_id);
-            retval.insert(ship_id);
-        }
-        if (system)
-            system->Remove(object_id);
-        Destroy(object_id);
-        retval.insert(object_id);
-
-    } else if (auto obj_planet = std::dynamic_pointer_cast<Planet>(obj)) {
-        for (int building_id : obj_planet->BuildingIDs()) {
-            if (system)
-                system->Remove(building_id);
-            Destroy(building_id);
-            retval.insert(building_id);
-        }
-        if (system)
-            system->Remove(object_id);
-        Destroy(object_id);
-        retval.insert(object_id);
-
-    } else if (auto obj_system = std::dynamic_pointer_cast<System>(obj)) {
-        // destroy all objects in system
-        for (int system_id : obj_system->ObjectIDs()) {
-            Destroy(system_id);
-            retval.insert(system_id);
-        }
-
-        // remove any starlane connections to this system
-        int this_sys_id = obj_system->ID();
+        if (retval.count(object_id))
+            continue;   // already being destroyed along with another object
+
+        switch (obj->ObjectType()) {
+        case UniverseObjectType::OBJ_SHIP:
+        case UniverseObjectType::OBJ_BUILDING:
+        case UniverseObjectType::OBJ_FIELD:
+            add_to_destroy(object_id);
+            break;
+
+        case UniverseObjectType::OBJ_FLEET:
+            add_fleet_to_destroy(static_cast<const Fleet&>(*obj));
+            break;
+
+        case UniverseObjectType::OBJ_PLANET:
+            for (int building_id : static_cast<const Planet*>(obj.get())->BuildingIDs())
+                add_to_destroy(building_id);
+            add_to_destroy(object_id);
+            break;
+
+        case UniverseObjectType::OBJ_SYSTEM:
+            // destroy all objects in system
+            for (int contained_id : static_cast<const System*>(obj.get())->ObjectIDs())
+                add_to_destroy(contained_id);
+            add_to_destroy(object_id);
+            destroyed_system_ids.push_back(object_id);
+            break;
+
+        default:
+            break;  // ??? object is of some type unknown as of this writing.
+        }
+    }
+
+    if (!destroyed_system_ids.empty()) {
+        // remove any starlane connections to destroyed systems
         for (auto& sys : m_objects->all<System>())
-            sys->RemoveStarlane(this_sys_id);
+            for (int destroyed_system_id : destroyed_system_ids)
+                sys->RemoveStarlane(destroyed_system_id);
 
-        // remove fleets / ships moving along destroyed starlane
-        std::vector<std::shared_ptr<Fleet>> fleets_to_destroy;
+        // remove fleets / ships moving along destroyed starlanes
+        const std::set<int> destroyed_systems{destroyed_system_ids.begin(), destroyed_system_ids.end()};
         for (auto& fleet : m_objects->all<Fleet>()) {
             if (fleet->SystemID() == INVALID_OBJECT_ID && (
-                fleet->NextSystemID() == this_sys_id ||
-                fleet->PreviousSystemID() == this_sys_id))
-            { fleets_to_destroy.emplace_back(fleet); }
-        }
-        for (auto& fleet : fleets_to_destroy)
-            RecursiveDestroy(fleet->ID());
-
-        // then destroy system itself
-        Destroy(object_id);
-        retval.insert(object_id);
-        // don't need to bother with removing things from system, fleets, or
-        // ships, since everything in system is being destroyed
-
-    } else if (auto building = std::dynamic_pointer_cast<Building>(obj)) {
-        auto planet = m_objects->get<Planet>(building->PlanetID());
-        if (planet)
-            planet->RemoveBuilding(object_id);
-        if (system)
-            system->Remove(object_id);
-        Destroy(object_id);
-        retval.insert(object_id);
-
-    } else if (obj->ObjectType() == UniverseObjectType::OBJ_FIELD) {
-        if (system)
-            system->Remove(object_id);
-        Destroy(object_id);
-        retval.insert(object_id);
-    }
-    // else ??? object is of some type unknown as of this writing.
+                destroyed_systems.count(fleet->NextSystemID()) ||
+                destroyed_systems.count(fleet->PreviousSystemID())))
+            { add_fleet_to_destroy(*fleet); }
+        }
+    }
+
+    // 2) remove destroyed objects from the fleets, planets and systems that
+    // contain them, if those aren't also being destroyed. fleets whose ships
+    // are all being destroyed would be left empty, so are destroyed as well
+    std::map<std::shared_ptr<Fleet>, std::vector<int>> fleets_removed_ships;
+    std::map<std::shared_ptr<System>, std::vector<int>> systems_removed_objects;
+    const auto remove_from_system = [this, &systems_removed_objects, &retval](const UniverseObject& obj) {
+        if (retval.count(obj.SystemID()))
+            return;
+        if (auto system = m_objects->get<System>(obj.SystemID()))
+            systems_removed_objects[std::move(system)].push_back(obj.ID());
+    };
+
+    const auto num_found_destroy_ids = destroy_ids.size();
+    for (std::size_t idx = 0; idx < num_found_destroy_ids; ++idx) {
+        auto obj = m_objects->get(destroy_ids[idx]);
+        if (!obj)
+            continue;
+        remove_from_system(*obj);
+
+        if (obj->ObjectType() == UniverseObjectType::OBJ_SHIP) {
+            auto ship = static_cast<const Ship*>(obj.get());
+            if (retval.count(ship->FleetID()))
+                continue;
+            if (auto fleet = m_objects->get<Fleet>(ship->FleetID()))
+                fleets_removed_ships[std::move(fleet)].push_back(ship->ID());
+
+        } else if (obj->ObjectType() == UniverseObjectType::OBJ_BUILDING) {
+            auto building = static_cast<const Building*>(obj.get());
+            if (retval.count(building->PlanetID()))
+                continue;
+            if (auto planet = m_objects->get<Planet>(building->PlanetID()))
+                planet->RemoveBuilding(building->ID());
+        }
+    }
+
+    for (auto& [fleet, ship_ids] : fleets_removed_ships) {
+        fleet->RemoveShips(ship_ids);
+        if (fleet->Empty()) {
+            add_to_destroy(fleet->ID());
+            remove_from_system(*fleet);
+        }
+    }
+
+    for (auto& [system, removed_ids] : systems_removed_objects)
+        system->Remove(removed_ids);
+
+    // 3) destroy all the objects together
+    Destroy(destroy_ids);
+
     return retval;
 }
 
@@ -2924,8 +3835,10 @@ void Universe::EffectDestroy(int object_id, int source_object_id) {
     m_marked_destroyed[object_id].insert(source_object_id);
 }
 
-void Universe::InitializeSystemGraph(const EmpireManager& empires, const ObjectMap& objects)
-{ m_pathfinder->InitializeSystemGraph(objects, empires); }
+void Universe::InitializeSystemGraph(const EmpireManager& empires, const ObjectMap& objects) {
+    m_pathfinder->InitializeSystemGraph(objects, empires);
+    m_system_graph_starlane_topology_version = m_starlane_topology_version;
+}
 
 void Universe::UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(const EmpireManager& empires)
 { m_pathfinder->UpdateEmpireVisibilityFilteredSystemGraphs(empires, m_empire_latest_known_objects); }
@@ -2942,6 +3855,38 @@ const bool& Universe::UniverseObjectSignalsInhibited()
 void Universe::InhibitUniverseObjectSignals(bool inhibit)
 { m_inhibit_universe_object_signals = inhibit; }
 
+void Universe::BatchUniverseObjectSignals(bool batch) {
+    if (batch) {
+        ++m_universe_object_signal_batch_depth;
+        return;
+    }
+    if (m_universe_object_signal_batch_depth <= 0) {
+        ErrorLogger() << "Universe::BatchUniverseObjectSignals asked to end a batch when none was started";
+        return;
+    }
+    if (--m_universe_object_signal_batch_depth > 0)
+        return;
+
+    // slots may change objects again, which now emits their signals directly
+    auto changed_objects = std::move(m_batched_changed_objects);
+    m_batched_changed_objects.clear();
+    m_batched_changed_object_indices.clear();
+
+    TraceLogger() << "Universe::BatchUniverseObjectSignals emitting signals of " << changed_objects.size() << " changed objects";
+    for (auto& weak_obj : changed_objects)
+        if (auto obj = weak_obj.lock())
+            obj->StateChangedSignal();
+}
+
+void Universe::RecordBatchedObjectChange(const UniverseObject& obj) {
+    auto weak_obj = obj.weak_from_this();
+    auto [it, added] = m_batched_changed_object_indices.try_emplace(&obj, m_batched_changed_objects.size());
+    if (added)
+        m_batched_changed_objects.push_back(std::move(weak_obj));
+    else if (m_batched_changed_objects[it->second].expired())
+        m_batched_changed_objects[it->second] = std::move(weak_obj);    // a new object at the address of a destroyed one
+}
+
 void Universe::UpdateStatRecords(EmpireManager& empires) {
     int current_turn = CurrentTurn();
     if (current_turn == INVALID_GAME_TURN)
@@ -2962,23 +3907,43 @@ void Universe::UpdateStatRecords(EmpireManager& empires) {
         empire_sources[empire_id] = std::move(source);
     }
 
-    // process each stat
-    const ScriptingContext context{*this, empires};
+    // each (stat, empire) pair is evaluated independently of the others, and
+    // only reads the gamestate, so the pairs are evaluated in parallel. the
+    // values are written to preallocated slots, and recorded once all are done
+    struct StatEvaluation {
+        const std::string*                      stat_name = nullptr;
+        const ValueRef::ValueRef<double>*       value_ref = nullptr;
+        int                                     empire_id = ALL_EMPIRES;
+        std::shared_ptr<const UniverseObject>   source;
+        double                                  value = 0.0;
+    };
+    std::vector<StatEvaluation> evaluations;
+    evaluations.reserve(EmpireStats().size() * empire_sources.size());
     for (auto& [stat_name, value_ref] : EmpireStats()) {
         if (!value_ref)
             continue;
-        auto& stat_records = m_stat_records[stat_name];
-
-        // calculate stat for each empire, store in records for current turn
-        for (auto& [empire_id, empire_source] : empire_sources) {
-            if (value_ref->SourceInvariant()) {
-                stat_records[empire_id][current_turn] = value_ref->Eval();
-            } else if (empire_source) {
-                ScriptingContext source_context{empire_source, context};
-                stat_records[empire_id][current_turn] = value_ref->Eval(source_context);
-            }
-        }
+        for (auto& [empire_id, empire_source] : empire_sources)
+            evaluations.push_back({&stat_name, value_ref.get(), empire_id, empire_source});
     }
+
+    const ScriptingContext context{*this, empires};
+    const auto evaluate = [&context](StatEvaluation& evaluation) {
+        if (evaluation.value_ref->SourceInvariant()) {
+            evaluation.value = evaluation.value_ref->Eval();
+        } else {
+            ScriptingContext source_context{evaluation.source, context};
+            evaluation.value = evaluation.value_ref->Eval(source_context);
+        }
+    };
+
+    TaskBatch task_batch("Universe::UpdateStatRecords");
+    for (auto& evaluation : evaluations)
+        task_batch.Post([&evaluate, &evaluation]() { evaluate(evaluation); });
+    task_batch.Wait();
+
+    // store in records for current turn
+    for (const auto& evaluation : evaluations)
+        m_stat_records[*evaluation.stat_name][evaluation.empire_id].Set(current_turn, evaluation.value);
 }
 
 void Universe::GetShipDesignsToSerialize(ShipDesignMap& designs_to_serialize, int encoding_empire) const {
@@ -3042,14 +4007,14 @@ void Universe::GetObjectsToSerialize(ObjectMap& objects, int encoding_empire) co
 
         auto destroyed_ids_it = m_empire_known_destroyed_object_ids.find(encoding_empire);
         bool map_avail = (destroyed_ids_it != m_empire_known_destroyed_object_ids.end());
-        const auto& destroyed_object_ids = map_avail ?
-            destroyed_ids_it->second : std::set<int>();
+        static const ObjectIDBitmap empty_set;
+        const auto& destroyed_object_ids = map_avail ? destroyed_ids_it->second : empty_set;
 
         objects.AuditContainment(destroyed_object_ids);
     }
 }
 
-void Universe::GetDestroyedObjectsToSerialize(std::set<int>& destroyed_object_ids,
+void Universe::GetDestroyedObjectsToSerialize(ObjectIDBitmap& destroyed_object_ids,
                                               int encoding_empire) const
 {
     if (&destroyed_object_ids == &m_destroyed_object_ids)
@@ -3166,22 +4131,57 @@ void Universe::GetEmpireStaleKnowledgeObjects(ObjectKnowledgeMap& empire_stale_k
         empire_stale_knowledge_object_ids[encoding_empire] = it->second;
 }
 
+namespace {
+    std::map<std::string, unsigned int> ComputeContentCheckSums() {
+        ScopedTimer timer("ComputeContentCheckSums", std::chrono::milliseconds(10));
+
+        // add entries for various content managers...
+        // (not the encyclopedia, which doesn't affect the game, and is not parsed
+        // by the server or AI clients unless it is used)
+        // the managers' content is independent, so is checksummed in parallel
+        std::vector<std::pair<std::string, std::future<unsigned int>>> pending_checksums;
+        auto add = [&pending_checksums](std::string name, unsigned int (*checksum)()) {
+            pending_checksums.emplace_back(std::move(name), std::async(std::launch::async, checksum));
+        };
+        add("BuildingTypeManager",          []() { return GetBuildingTypeManager().GetCheckSum(); });
+        add("FieldTypeManager",             []() { return GetFieldTypeManager().GetCheckSum(); });
+        add("ShipHullManager",              []() { return GetShipHullManager().GetCheckSum(); });
+        add("ShipPartManager",              []() { return GetShipPartManager().GetCheckSum(); });
+        add("PredefinedShipDesignManager",  []() { return GetPredefinedShipDesignManager().GetCheckSum(); });
+        add("SpeciesManager",               []() { return GetSpeciesManager().GetCheckSum(); });
+        add("SpecialsManager",              []() { return GetSpecialsManager().GetCheckSum(); });
+        add("TechManager",                  []() { return GetTechManager().GetCheckSum(); });
+
+        std::map<std::string, unsigned int> checksums;
+        for (auto& [name, pending] : pending_checksums)
+            checksums[name] = pending.get();
+
+        // NamedValueRefManager cant ensure that parsing is finished for registrations from other content
+        // So it needs to be added last, after all other managers ensured their content finished parsing
+        checksums["NamedValueRefManager"] = GetNamedValueRefManager().GetCheckSum();
+
+        return checksums;
+    }
+}
+
 std::map<std::string, unsigned int> CheckSumContent() {
-    std::map<std::string, unsigned int> checksums;
-
-    // add entries for various content managers...
-    checksums["BuildingTypeManager"] = GetBuildingTypeManager().GetCheckSum();
-    checksums["Encyclopedia"] = GetEncyclopedia().GetCheckSum();
-    checksums["FieldTypeManager"] = GetFieldTypeManager().GetCheckSum();
-    checksums["ShipHullManager"] = GetShipHullManager().GetCheckSum();
-    checksums["ShipPartManager"] = GetShipPartManager().GetCheckSum();
-    checksums["PredefinedShipDesignManager"] = GetPredefinedShipDesignManager().GetCheckSum();
-    checksums["SpeciesManager"] = GetSpeciesManager().GetCheckSum();
-    checksums["SpecialsManager"] = GetSpecialsManager().GetCheckSum();
-    checksums["TechManager"] = GetTechManager().GetCheckSum();
-    // NamedValueRefManager cant ensure that parsing is finished for registrations from other content
-    // So it needs to be added last, after all other managers ensured their content finished parsing
-    checksums["NamedValueRefManager"] = GetNamedValueRefManager().GetCheckSum();
+    // content is parsed once, so its checksums are computed once, and are
+    // cached with the preprocessed scripts, so that processes that parse the
+    // same scripts later don't compute them again
+    static std::mutex                           checksums_mutex;
+    static std::map<std::string, unsigned int>  checksums;
+
+    std::scoped_lock lock(checksums_mutex);
+    if (!checksums.empty())
+        return checksums;
+
+    checksums = parse::cached_content_checksums();
+    if (!checksums.empty()) {
+        DebugLogger() << "CheckSumContent using cached content checksums";
+        return checksums;
+    }
 
+    checksums = ComputeContentCheckSums();
+    parse::cache_content_checksums(checksums);
     return checksums;
 }
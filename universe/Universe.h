@@ -12,8 +12,14 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/signals2/signal.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include "ConditionMemo.h"
 #include "EnumsFwd.h"
+#include "ObjectIDBitmap.h"
+#include "ObjectIndex.h"
 #include "ObjectMap.h"
+#include "ObjectVisibilityTable.h"
+#include "StatisticCache.h"
+#include "StatRecords.h"
 #include "UniverseObject.h"
 #include "../util/Export.h"
 #include "../util/Pending.h"
@@ -69,7 +75,7 @@ public:
     typedef std::map<int, ObjectVisibilityTurnMap>  EmpireObjectVisibilityTurnMap;  ///< Each empire's most recent turns on which object information was known; keyed by empire id
 
 private:
-    typedef std::map<int, std::set<int>>            ObjectKnowledgeMap;             ///< IDs of Empires which know information about an object (or deleted object); keyed by object id
+    typedef std::map<int, ObjectIDBitmap>           ObjectKnowledgeMap;             ///< IDs of objects (or deleted objects) that an empire knows information about; keyed by empire id
 
     typedef const ValueRef::ValueRef<Visibility>*   VisValRef;
     typedef std::vector<std::pair<int, VisValRef>>  SrcVisValRefVec;
@@ -81,10 +87,17 @@ private:
       * available -> the unknown factor affecting the meter.  This is used
       * when generating effect accounting, in the case where the expected
       * and actual meter values don't match. */
-    typedef std::unordered_map<int, boost::container::flat_map<MeterType, double>> DiscrepancyMap;
+    struct MeterDiscrepancy {
+        int         object_id;
+        MeterType   meter_type;
+        float       discrepancy;
+    };
+    /** Discrepancies of all objects' meters, sorted by object id and then by
+      * meter type. */
+    typedef std::vector<MeterDiscrepancy> DiscrepancyMap;
 
 public:
-    typedef std::map<int, Visibility>               ObjectVisibilityMap;            ///< map from object id to Visibility level for a particular empire
+    typedef ObjectVisibilityTable                   ObjectVisibilityMap;            ///< map from object id to Visibility level for a particular empire
     typedef std::map<int, ObjectVisibilityMap>      EmpireObjectVisibilityMap;      ///< map from empire id to ObjectVisibilityMap for that empire
 
     typedef std::map<int, std::set<std::string>>    ObjectSpecialsMap;              ///< map from object id to names of specials on an object
@@ -117,8 +130,28 @@ public:
       * of on the current turn if \a empire_id = ALL_EMPIRES */
     std::set<int>           EmpireVisibleObjectIDs(int empire_id, const EmpireManager& empires) const;
 
+    /** Returns the memo of condition matches to use when evaluating
+      * conditions on objects in this Universe, or null if there is none,
+      * which is whenever objects may be changing. */
+    ConditionMemo*          ActiveConditionMemo() const { return m_condition_memo_active ? &m_condition_memo : nullptr; }
+
+    /** Returns the cache of Statistic values to use when evaluating
+      * Statistics on objects in this Universe, or null if there is none,
+      * which is whenever the ConditionMemo is inactive. */
+    StatisticCache*         ActiveStatisticCache() const { return m_condition_memo_active ? &m_statistic_cache : nullptr; }
+
+    /** Returns the index of objects in this Universe by owner, species and
+      * other properties, or null if there is none, which is whenever the
+      * ConditionMemo is inactive. */
+    const ObjectIndex*      ActiveObjectIndex() const { return m_condition_memo_active ? &m_object_index : nullptr; }
+
+    /** Returns true iff the operands of And and Or conditions evaluated on
+      * objects in this Universe should be evaluated in the order of their
+      * measured costs and selectivities, rather than in scripted order. */
+    bool                    ReorderConditionOperands() const { return m_reorder_condition_operands; }
+
     /** Returns IDs of objects that have been destroyed. */
-    const std::set<int>&    DestroyedObjectIds() const;
+    const ObjectIDBitmap&   DestroyedObjectIds() const;
     int                     HighestDestroyedObjectID() const;
 
     /** Returns IDs of objects that the Empire with id \a empire_id knows have
@@ -126,12 +159,12 @@ public:
       * last known information about each object, whether it has been destroyed
       * or not.  If \a empire_id = ALL_EMPIRES an empty set of IDs is
       * returned. */
-    const std::set<int>&    EmpireKnownDestroyedObjectIDs(int empire_id) const;
+    const ObjectIDBitmap&   EmpireKnownDestroyedObjectIDs(int empire_id) const;
 
     /** Returns IDs of objects that the Empire with id \a empire_id has stale
       * knowledge of in its latest known objects.  The latest known data about
       * these objects suggests that they should be visible, but they are not. */
-    const std::set<int>&    EmpireStaleKnowledgeObjectIDs(int empire_id) const;
+    const ObjectIDBitmap&   EmpireStaleKnowledgeObjectIDs(int empire_id) const;
 
     const ShipDesign*       GetShipDesign(int ship_design_id) const;    ///< returns the ship design with id \a ship_design id, or 0 if non exists
     void                    RenameShipDesign(int design_id, const std::string& name = "",
@@ -181,8 +214,22 @@ public:
     const Effect::AccountingMap& GetEffectAccountingMap() const { return m_effect_accounting_map; }
     Effect::AccountingMap& GetEffectAccountingMap() { return m_effect_accounting_map; }
 
-    const std::map<std::string, std::map<int, std::map<int, double>>>&
-    GetStatRecords() const { return m_stat_records; }
+    const StatRecords& GetStatRecords() const { return m_stat_records; }
+
+    /** Returns the ids of the objects that were created or changed by the last
+      * deserialization of this universe.  When that was a delta-encoded turn
+      * update, the other objects are the same objects as before it. */
+    const std::vector<int>& ObjectsUpdatedByLastLoad() const { return m_objects_updated_by_last_load; }
+
+    /** Returns a number that changes whenever meters or meter estimates are
+      * updated or reset, or the contents of this universe are replaced, so
+      * that results depending on them can be kept until it changes. */
+    std::size_t MetersGeneration() const noexcept { return m_meters_generation; }
+
+    /** Returns the approximate number of bytes of memory used by each part of
+      * the universe's state, by name of the part, so that the parts that use
+      * the most memory in large games can be found. */
+    std::vector<std::pair<std::string, std::size_t>> ApproximateMemoryUsage() const;
 
     mutable UniverseObjectDeleteSignalType UniverseObjectDeleteSignal; ///< the state changed signal object for this UniverseObject
 
@@ -205,6 +252,11 @@ public:
       * ShipDesign map. */
     void Clear();
 
+    /** Replaces the latest known objects of the empire with id \a empire_id
+      * with \a objects, which were deserialized separately from the rest of
+      * this Universe, and updates their destroyed state. */
+    void SetEmpireKnownObjects(int empire_id, ObjectMap&& objects);
+
     /** Resets meters */
     void ResetAllObjectMeters(bool target_max_unpaired = true, bool active = true);
 
@@ -236,7 +288,8 @@ public:
 
     /** For all objects and meters, determines discrepancies between actual meter
       * maxes and what the known universe should produce, and and stores in
-      * m_effect_discrepancy_map. */
+      * m_effect_discrepancy_map.  The meter effects' targets are kept for
+      * reuse by the next update of all objects' meter estimates. */
     void InitMeterEstimatesAndDiscrepancies(ScriptingContext& context);
 
     /** Based on (known subset of, if in a client) universe and any orders
@@ -254,6 +307,13 @@ public:
     void UpdateMeterEstimates(ScriptingContext& context);
     void UpdateMeterEstimates(ScriptingContext& context, bool do_accounting);
 
+    /** Determines the effect accounting of the meters of the object with id
+      * \a object_id, if it isn't already known, by re-estimating that
+      * object's meters.  Meter updates only record accounting for all objects
+      * if the effects.accounting.on-demand option is disabled, so this should
+      * be called before displaying accounting. */
+    void UpdateMeterAccounting(int object_id, ScriptingContext& context);
+
     /** Sets all objects' meters' initial values to their current values. */
     void BackPropagateObjectMeters();
 
@@ -290,7 +350,9 @@ public:
     /** Checks latest known information about each object for each empire and,
       * in cases when the latest known state (stealth and location) suggests
       * that the empire should be able to see the object, but the object can't
-      * be seen by the empire, updates the latest known state to note this. */
+      * be seen by the empire, updates the latest known state to note this.
+      * Only objects whose latest known positions changed, and detectors that
+      * changed, since the last update are checked against each other. */
     void UpdateEmpireStaleObjectKnowledge(EmpireManager& empires);
 
     /** Fills pathfinding data structure and determines least jumps distances
@@ -303,6 +365,15 @@ public:
     void UpdateEmpireVisibilityFilteredSystemGraphsWithOwnObjectMaps(const EmpireManager& empires);
     void UpdateEmpireVisibilityFilteredSystemGraphsWithMainObjectMap(const EmpireManager& empires);
 
+    /** Records that starlanes or wormholes were added or removed, or systems
+      * created, destroyed or moved, so that the system graph is out of date. */
+    void StarlaneTopologyChanged() { ++m_starlane_topology_version; }
+
+    /** Returns true if the starlane topology has changed since the system
+      * graph was last initialized, or if it hasn't been initialized. */
+    [[nodiscard]] bool SystemGraphOutOfDate() const
+    { return m_system_graph_starlane_topology_version != m_starlane_topology_version; }
+
     /** Adds the object ID \a object_id to the set of object ids for the empire
       * with id \a empire_id that the empire knows have been destroyed. */
     void SetEmpireKnowledgeOfDestroyedObject(int object_id, int empire_id);
@@ -325,12 +396,24 @@ public:
       * destroyed. */
     void Destroy(int object_id, bool update_destroyed_object_knowers = true);
 
+    /** Destroys the objects with IDs in \a object_ids, as Destroy(int, bool)
+      * does, but updates the destroyed object ids and empires' knowledge of
+      * destroyed objects once for all of them. */
+    void Destroy(const std::vector<int>& object_ids, bool update_destroyed_object_knowers = true);
+
     /** Destroys object with ID \a object_id, and destroys any associted
       * objects, such as contained buildings of planets, contained anything of
       * systems, or fleets if their last ship has id \a object_id and the fleet
       * is thus empty. Returns the ids of all destroyed objects. */
     std::set<int> RecursiveDestroy(int object_id);
 
+    /** Destroys the objects with IDs in \a object_ids and their associated
+      * objects, as RecursiveDestroy(int) does for each.  All objects to be
+      * destroyed are found first, then removed from the systems, fleets and
+      * planets that contain them in one pass, and then destroyed together.
+      * Returns the ids of all destroyed objects. */
+    std::set<int> RecursiveDestroy(const std::vector<int>& object_ids);
+
     /** Used by the Destroy effect to mark an object for destruction later
       * during turn processing. (objects can't be destroyed immediately as
       * other effects might depend on their existence) */
@@ -355,6 +438,20 @@ public:
     /** Returns true if UniverseOjbectSignals are inhibited, false otherwise. */
     const bool& UniverseObjectSignalsInhibited();
 
+    /** Starts batching UniverseObjectSignals if \a batch is true, or ends a
+      * batch if \a batch is false.  While batched, an object's
+      * StateChangedSignal isn't emitted when the object changes.  Instead,
+      * when the outermost batch ends, it is emitted once for each object
+      * that changed, in the order they first changed.  Batches can be nested,
+      * but each start must be matched by an end. */
+    void BatchUniverseObjectSignals(bool batch = true);
+
+    /** Returns true if UniverseObjectSignals are being batched. */
+    bool UniverseObjectSignalsBatched() const { return m_universe_object_signal_batch_depth > 0; }
+
+    /** Records that \a obj changed while UniverseObjectSignals are batched. */
+    void RecordBatchedObjectChange(const UniverseObject& obj);
+
     double UniverseWidth() const;
     void SetUniverseWidth(double width) { m_universe_width = width; }
 
@@ -366,6 +463,12 @@ public:
         return InsertID<T>(id, std::forward<Args>(args)...);
     }
 
+    /** Reserves new ids for \p count objects about to be created with
+        InsertNew, in one block from the id allocator.  The ids are those that
+        InsertNew would otherwise allocate one at a time, so reserving more
+        ids than are used doesn't change the ids of later objects. */
+    void ReserveObjectIDs(std::size_t count);
+
     /** InsertTemp constructs and inserts a temporary UniverseObject into the object map with a
         temporary id. It returns the new object. */
     template <typename T, typename... Args>
@@ -421,6 +524,9 @@ private:
      */
     std::shared_ptr<Pathfinder> m_pathfinder;
 
+    int m_starlane_topology_version = 0;                ///< incremented by StarlaneTopologyChanged
+    int m_system_graph_starlane_topology_version = -1;  ///< value of m_starlane_topology_version when the system graph was last initialized
+
     /** Generates an object ID for a future object. Usually used by the server
       * to service new ID requests. */
     int GenerateObjectID();
@@ -482,12 +588,17 @@ private:
       * processed objects_vec or whatever they were passed and cleared the
       * relevant effect accounting for those objects and meters. If an empty
       * vector is passed, it will instead update all existing objects. */
-    void UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec, ScriptingContext& context, bool do_accounting);
+    void UpdateMeterEstimatesImpl(const std::vector<int>& objects_vec, ScriptingContext& context,
+                                  bool do_accounting, bool keep_targets = false);
+
+    /** Returns a hash of the state of all objects and empires in \a context
+      * that meter estimate scope conditions may depend on. */
+    std::size_t MeterEstimateTargetsState(const ScriptingContext& context) const;
 
     std::unique_ptr<ObjectMap>      m_objects;                          ///< map from object id to UniverseObjects in the universe.  for the server: all of them, up to date and true information about object is stored;  for clients, only limited information based on what the client knows about is sent.
     EmpireObjectMap                 m_empire_latest_known_objects;      ///< map from empire id to (map from object id to latest known information about each object by that empire)
 
-    std::set<int>                   m_destroyed_object_ids;             ///< all ids of objects that have been destroyed (on server) or that a player knows were destroyed (on clients)
+    ObjectIDBitmap                  m_destroyed_object_ids;             ///< all ids of objects that have been destroyed (on server) or that a player knows were destroyed (on clients)
 
     EmpireObjectVisibilityMap       m_empire_object_visibility;         ///< map from empire id to (map from object id to visibility of that object for that empire)
     EmpireObjectVisibilityTurnMap   m_empire_object_visibility_turns;   ///< map from empire id to (map from object id to (map from Visibility rating to turn number on which the empire last saw the object at the indicated Visibility rating or higher)
@@ -499,6 +610,23 @@ private:
     ObjectKnowledgeMap              m_empire_known_destroyed_object_ids;///< map from empire id to (set of object ids that the empire knows have been destroyed)
     ObjectKnowledgeMap              m_empire_stale_knowledge_object_ids;///< map from empire id to (set of object ids that the empire has previously observed but has subsequently been unable to detect at its last known location despite expecting to be able to detect it based on stealth of the object and having detectors in range)
 
+    /** An empire's detectors and which of its latest known objects were in
+      * their ranges as of the last UpdateEmpireStaleObjectKnowledge, so that
+      * the next update can recheck only what changed since. */
+    struct StaleKnowledgeDetection {
+        struct KnownObject {
+            double  x = 0.0;
+            double  y = 0.0;
+            bool    in_detection_range = false;
+            bool    detectable = false;         ///< is the object's latest known stealth low enough for the empire to detect it
+            int     update = 0;                 ///< last update in which the object was among the empire's latest known objects
+        };
+        std::map<std::pair<double, double>, float>  detector_ranges;
+        std::unordered_map<int, KnownObject>         known_objects;
+        int                                          update = 0;
+    };
+    std::map<int, StaleKnowledgeDetection>  m_empire_stale_knowledge_detection;  ///< indexed by empire id
+
     ShipDesignMap                   m_ship_designs;                     ///< ship designs in the universe
     std::map<int, std::set<int>>    m_empire_known_ship_design_ids;     ///< ship designs known to each empire
 
@@ -510,13 +638,26 @@ private:
     /// affecting the meter.
     DiscrepancyMap                  m_effect_discrepancy_map;
 
+    /// target sets of the meter effects of all objects found by
+    /// InitMeterEstimatesAndDiscrepancies, and the state they were found for,
+    /// which are reused by the next update of all objects' meter estimates if
+    /// nothing has changed since, such as by orders being applied
+    std::map<int, Effect::SourcesEffectsTargetsAndCausesVec>    m_meter_estimate_targets;
+    std::size_t                                                 m_meter_estimate_targets_state = 0;
+
     std::map<int, std::set<int>>    m_marked_destroyed;                 ///< used while applying effects to cache objects that have been destroyed.  this allows to-be-destroyed objects to remain undestroyed until all effects have been processed, which ensures that to-be-destroyed objects still exist when other effects need to access them as a source object. key is destroyed object, and value set are the ids of objects that caused the destruction (may be multiples destroying a single target on a given turn)
 
     double                          m_universe_width = 1000.0;
     bool                            m_inhibit_universe_object_signals = false;
 
-    std::map<std::string, std::map<int, std::map<int, double>>>
-                                    m_stat_records;                     ///< storage for statistics calculated for empires. Indexed by stat name (string), contains a map indexed by empire id, contains a map from turn number (int) to stat value (double).
+    int                                                 m_universe_object_signal_batch_depth = 0;
+    std::vector<std::weak_ptr<const UniverseObject>>    m_batched_changed_objects;          ///< objects that changed during the current batch of signals, in order of first change
+    std::unordered_map<const UniverseObject*, std::size_t>
+                                                        m_batched_changed_object_indices;   ///< index in m_batched_changed_objects of each changed object
+
+    std::vector<int>                m_objects_updated_by_last_load;
+    std::size_t                     m_meters_generation = 0;
+    StatRecords                     m_stat_records;                     ///< storage for statistics calculated for empires. Indexed by stat name (string), contains a map indexed by empire id, contains the series of stat values (double) by turn number (int).
 
     //! @name Parsed items
     //! Various unlocked items are kept as a Pending::Pending while being parsed and
@@ -535,6 +676,28 @@ private:
     mutable EmpireStatsMap                                  m_empire_stats;
     //! @}
 
+    //! @name Incremental effects targets evaluation
+    //! Results of the last full-universe evaluation of effects groups' scope
+    //! conditions, and the object states they were evaluated against, used
+    //! to re-evaluate only the changed objects on later evaluations on the
+    //! same turn. Mutable to allow updating in GetEffectsAndTargets.
+    //! @{
+    using EffectsTargetsCache = std::unordered_map<const Effect::EffectsGroup*,
+                                                   std::unordered_map<int, std::vector<int>>>;
+    mutable EffectsTargetsCache                             m_effects_targets_cache;                ///< target object ids, indexed by effects group and source object id
+    mutable std::unordered_map<int, std::size_t>            m_effects_targets_cache_object_states;  ///< hash of state of each object when m_effects_targets_cache was last updated, indexed by object id
+    mutable int                                             m_effects_targets_cache_turn = -1;
+    //! @}
+
+    //! Memoized subcondition matches and Statistic values, shared by all
+    //! scope condition evaluations in a GetEffectsAndTargets call, during
+    //! which no objects change. Cleared and deactivated before it returns.
+    mutable ConditionMemo                                   m_condition_memo;
+    mutable StatisticCache                                  m_statistic_cache;
+    mutable ObjectIndex                                     m_object_index;
+    mutable bool                                            m_condition_memo_active = false;
+    mutable bool                                            m_reorder_condition_operands = false;
+
     /** Fills \a designs_to_serialize with ShipDesigns known to the empire with
       * the ID \a encoding empire.  If encoding_empire is ALL_EMPIRES, then all
       * designs are included. */
@@ -547,7 +710,7 @@ private:
     /** Fills \a destroyed_object_ids with ids of objects known to be destroyed
       * by the empire with ID \a encoding empire. If encoding_empire is
       * ALL_EMPIRES, then all destroyed objects are included. */
-    void GetDestroyedObjectsToSerialize(std::set<int>& destroyed_object_ids, int encoding_empire) const;
+    void GetDestroyedObjectsToSerialize(ObjectIDBitmap& destroyed_object_ids, int encoding_empire) const;
 
     /** Fills \a empire_latest_known_objects map with the latest known data
       * about UniverseObjects for the empire with id \a encoding_empire.  If
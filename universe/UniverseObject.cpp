@@ -15,15 +15,23 @@
 
 const int INVALID_OBJECT_ID = -1;
 
+bool StateChangedCombiner::Deferred(const UniverseObject& object) {
+    Universe& universe = GetUniverse();
+    if (universe.UniverseObjectSignalsInhibited())
+        return true;
+    if (!universe.UniverseObjectSignalsBatched())
+        return false;
+    universe.RecordBatchedObjectChange(object);
+    return true;
+}
+
 UniverseObject::UniverseObject() :
-    StateChangedSignal(blocking_combiner<boost::signals2::optional_last_value<void>>(
-        GetUniverse().UniverseObjectSignalsInhibited())),
+    StateChangedSignal(StateChangedCombiner(*this)),
     m_created_on_turn(CurrentTurn())
 {}
 
 UniverseObject::UniverseObject(std::string name, double x, double y) :
-    StateChangedSignal(blocking_combiner<boost::signals2::optional_last_value<void>>(
-        GetUniverse().UniverseObjectSignalsInhibited())),
+    StateChangedSignal(StateChangedCombiner(*this)),
     m_name(std::move(name)),
     m_x(x),
     m_y(y),
@@ -43,35 +51,27 @@ void UniverseObject::Copy(std::shared_ptr<const UniverseObject> copied_object,
         return;
     }
 
-    auto censored_meters = copied_object->CensoredMeters(vis);
-    for (const auto& entry : copied_object->m_meters) {
-        MeterType type = entry.first;
-
+    // meters are censored as they are copied, as CensoredMeters(vis) would,
+    // rather than making a censored copy of all the meters first
+    for (const auto& [type, copied_object_meter] : copied_object->m_meters) {
         // get existing meter in this object, or create a default one
-        auto m_meter_it = m_meters.find(type);
-        bool meter_already_known = (m_meter_it != m_meters.end());
-        if (!meter_already_known)
-            m_meters[type]; // default initialize to (0, 0).  Alternative: = Meter(Meter::INVALID_VALUE, Meter::INVALID_VALUE);
-        Meter& this_meter = m_meters[type];
-
-        // if there is an update to meter from censored meters, update this object's copy
-        auto censored_it = censored_meters.find(type);
-        if (censored_it != censored_meters.end()) {
-            const Meter& copied_object_meter = censored_it->second;
-
-            if (!meter_already_known) {
-                // have no previous info, so just use whatever is given
-                this_meter = copied_object_meter;
-
-            } else {
-                // don't want to override legit meter history with sentinel values used for insufficiently visible objects
-                if (copied_object_meter.Initial() != Meter::LARGE_VALUE ||
-                    copied_object_meter.Current() != Meter::LARGE_VALUE)
-                {
-                    // some new info available, so can overwrite only meter info
-                    this_meter = copied_object_meter;
-                }
-            }
+        // initialized to (0, 0).  Alternative: = Meter(Meter::INVALID_VALUE, Meter::INVALID_VALUE);
+        auto [this_meter_it, meter_added] = m_meters.emplace(type, Meter{});
+        Meter& this_meter = this_meter_it->second;
+
+        if (vis >= Visibility::VIS_PARTIAL_VISIBILITY) {
+            // if have no previous info, just use whatever is given, but don't
+            // want to override legit meter history with sentinel values used
+            // for insufficiently visible objects
+            if (meter_added ||
+                copied_object_meter.Initial() != Meter::LARGE_VALUE ||
+                copied_object_meter.Current() != Meter::LARGE_VALUE)
+            { this_meter = copied_object_meter; }
+
+        } else if (vis == Visibility::VIS_BASIC_VISIBILITY && type == MeterType::METER_STEALTH && meter_added) {
+            // basically visible objects' stealth is censored to a sentinel
+            // value, which only replaces the default of a new meter
+            this_meter = Meter{Meter::LARGE_VALUE, Meter::LARGE_VALUE};
         }
     }
 
@@ -81,10 +81,24 @@ void UniverseObject::Copy(std::shared_ptr<const UniverseObject> copied_object,
         this->m_x =                     copied_object->m_x;
         this->m_y =                     copied_object->m_y;
 
-        this->m_specials.clear();
+        // the visible specials rarely change, so are only copied if they did
+        auto known_special_it = this->m_specials.begin();
+        bool specials_changed = false;
         for (const auto& entry_special : copied_object->m_specials) {
-            if (visible_specials.count(entry_special.first))
-                this->m_specials[entry_special.first] = entry_special.second;
+            if (!visible_specials.count(entry_special.first))
+                continue;
+            if (known_special_it == this->m_specials.end() || *known_special_it != entry_special) {
+                specials_changed = true;
+                break;
+            }
+            ++known_special_it;
+        }
+        if (specials_changed || known_special_it != this->m_specials.end()) {
+            this->m_specials.clear();
+            for (const auto& entry_special : copied_object->m_specials) {
+                if (visible_specials.count(entry_special.first))
+                    this->m_specials[entry_special.first] = entry_special.second;
+            }
         }
 
         if (vis >= Visibility::VIS_PARTIAL_VISIBILITY) {
@@ -206,18 +220,21 @@ std::string UniverseObject::Dump(unsigned short ntabs) const {
 }
 
 namespace {
-    std::set<int> EMPTY_SET;
+    const ObjectIDSet EMPTY_SET;
 }
 
-const std::set<int>& UniverseObject::ContainedObjectIDs() const
+const ObjectIDSet& UniverseObject::ContainedObjectIDs() const
 { return EMPTY_SET; }
 
-std::set<int> UniverseObject::VisibleContainedObjectIDs(int empire_id) const {
-    std::set<int> retval;
+ObjectIDSet UniverseObject::VisibleContainedObjectIDs(int empire_id) const {
+    ObjectIDSet retval;
+    const auto& contained_ids = ContainedObjectIDs();
+    retval.reserve(contained_ids.size());
     const Universe& universe = GetUniverse();
-    for (int object_id : ContainedObjectIDs()) {
+    for (int object_id : contained_ids) {
+        // ids are visited in order, so each is appended
         if (universe.GetObjectVisibilityByEmpire(object_id, empire_id) >= Visibility::VIS_BASIC_VISIBILITY)
-            retval.insert(object_id);
+            retval.insert(retval.end(), object_id);
     }
     return retval;
 }
@@ -231,15 +248,11 @@ bool UniverseObject::Contains(int object_id) const
 bool UniverseObject::ContainedBy(int object_id) const
 { return false; }
 
-const Meter* UniverseObject::GetMeter(MeterType type) const {
-    auto it = m_meters.find(type);
-    if (it != m_meters.end())
-        return &(it->second);
-    return nullptr;
-}
+const Meter* UniverseObject::GetMeter(MeterType type) const
+{ return m_meters.get(type); }
 
 void UniverseObject::AddMeter(MeterType meter_type) {
-    if (MeterType::INVALID_METER_TYPE == meter_type)
+    if (!MeterMap::ValidType(meter_type))
         ErrorLogger() << "UniverseObject::AddMeter asked to add invalid meter type!";
     else
         m_meters[meter_type];
@@ -302,17 +315,11 @@ void UniverseObject::MoveTo(double x, double y) {
     StateChangedSignal();
 }
 
-Meter* UniverseObject::GetMeter(MeterType type) {
-    auto it = m_meters.find(type);
-    if (it != m_meters.end())
-        return &(it->second);
-    return nullptr;
-}
+Meter* UniverseObject::GetMeter(MeterType type)
+{ return m_meters.get(type); }
 
-void UniverseObject::BackPropagateMeters() {
-    for (auto& m : m_meters)
-        m.second.BackPropagate();
-}
+void UniverseObject::BackPropagateMeters()
+{ m_meters.BackPropagate(); }
 
 void UniverseObject::SetOwner(int id) {
     if (m_owner_empire_id != id) {
@@ -355,25 +362,18 @@ UniverseObject::MeterMap UniverseObject::CensoredMeters(Visibility vis) const {
 }
 
 void UniverseObject::ResetTargetMaxUnpairedMeters() {
-    auto it = m_meters.find(MeterType::METER_STEALTH);
-    if (it != m_meters.end())
-        it->second.ResetCurrent();
+    if (auto meter = m_meters.get(MeterType::METER_STEALTH))
+        meter->ResetCurrent();
 }
 
 void UniverseObject::ResetPairedActiveMeters() {
     // iterate over paired active meters (those that have an associated max or
     // target meter.  if another paired meter type is added to Enums.h, it
     // should be added here as well.
-    for (auto& m : m_meters) {
-        if (m.first > MeterType::METER_TROOPS)
-            break;
-        if (m.first >= MeterType::METER_POPULATION)
-            m.second.SetCurrent(m.second.Initial());
-    }
+    m_meters.ResetCurrentToInitial(MeterType::METER_POPULATION, MeterType::METER_TROOPS);
 }
 
 void UniverseObject::ClampMeters() {
-    auto it = m_meters.find(MeterType::METER_STEALTH);
-    if (it != m_meters.end())
-        it->second.ClampCurrentToRange();
+    if (auto meter = m_meters.get(MeterType::METER_STEALTH))
+        meter->ClampCurrentToRange();
 }
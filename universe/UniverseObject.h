@@ -6,18 +6,24 @@
 #include <string>
 #include <vector>
 #include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
 #include <boost/python/detail/destroy.hpp>
 #include <boost/signals2/optional_last_value.hpp>
 #include <boost/signals2/signal.hpp>
 #include "EnumsFwd.h"
 #include "Meter.h"
-#include "../util/blocking_combiner.h"
+#include "MeterMap.h"
 #include "../util/Enum.h"
 #include "../util/Export.h"
 
 
 using boost::container::flat_map;
 
+/** IDs of the objects contained in a System, Planet or Fleet.  These are kept
+    sorted in contiguous storage, as they are iterated much more often than
+    changed, and copying them is a single copy of their storage. */
+using ObjectIDSet = boost::container::flat_set<int>;
+
 class System;
 class SitRepEntry;
 class EmpireManager;
@@ -64,6 +70,37 @@ FO_ENUM(
 )
 
 
+class UniverseObject;
+
+/** Combiner of UniverseObject::StateChangedSignal.  Doesn't call the signal's
+  * slots while UniverseObject signals are inhibited, nor while they are
+  * batched, in which case it records that the object changed so that its
+  * signal is emitted when the batch ends.  See
+  * Universe::BatchUniverseObjectSignals(). */
+class FO_COMMON_API StateChangedCombiner {
+public:
+    typedef void result_type;
+
+    explicit StateChangedCombiner(const UniverseObject& object) :
+        m_object(&object)
+    {}
+
+    template <typename InputIterator>
+    void operator()(InputIterator first, InputIterator last) const {
+        // objects without slots, which are most of them, needn't be recorded
+        if (first == last || Deferred(*m_object))
+            return;
+        boost::signals2::optional_last_value<void>{}(first, last);
+    }
+
+private:
+    /** Returns true if signals are inhibited, or if they are batched, in
+      * which case \a object is recorded as changed. */
+    static bool Deferred(const UniverseObject& object);
+
+    const UniverseObject* m_object;
+};
+
 /** The abstract base class for all objects in the universe
   * The UniverseObject class itself has an ID number, a name, a position, an ID
   * of the system in which it is, a list of zero or more owners, and other
@@ -81,10 +118,9 @@ FO_ENUM(
   * that is being displayed has changed.*/
 class FO_COMMON_API UniverseObject : virtual public std::enable_shared_from_this<UniverseObject> {
 public:
-    //typedef flat_map<MeterType, Meter, std::less<MeterType>, std::vector<std::pair<MeterType, Meter>>> MeterMap;
-    typedef flat_map<MeterType, Meter, std::less<MeterType>> MeterMap;
+    typedef ::MeterMap MeterMap;
 
-    typedef boost::signals2::signal<void (), blocking_combiner<boost::signals2::optional_last_value<void>>> StateChangedSignalType;
+    typedef boost::signals2::signal<void (), StateChangedCombiner> StateChangedSignalType;
 
     typedef StateChangedSignalType::slot_type StateChangedSlotType;
 
@@ -123,7 +159,7 @@ public:
     virtual int                 ContainerObjectID() const;
 
     /** Returns ids of objects contained within this object. */
-    virtual const std::set<int>&ContainedObjectIDs() const;
+    virtual const ObjectIDSet&  ContainedObjectIDs() const;
 
     /** Returns true if there is an object with id \a object_id is contained
         within this UniverseObject. */
@@ -133,7 +169,7 @@ public:
        this UniverseObject. */
     virtual bool                ContainedBy(int object_id) const;
 
-    std::set<int>               VisibleContainedObjectIDs(int empire_id) const; ///< returns the subset of contained object IDs that is visible to empire with id \a empire_id
+    ObjectIDSet                 VisibleContainedObjectIDs(int empire_id) const; ///< returns the subset of contained object IDs that is visible to empire with id \a empire_id
 
     const MeterMap&             Meters() const { return m_meters; }             ///< returns this UniverseObject's meters
     const Meter*                GetMeter(MeterType type) const;                 ///< returns the requested Meter, or 0 if no such Meter of that type is found in this object
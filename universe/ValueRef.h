@@ -21,6 +21,18 @@ struct FO_COMMON_API ValueRefBase {
     virtual bool SimpleIncrement() const         { return false; }
     virtual bool ConstantExpr() const            { return false; }
 
+    //! Returns true iff this ValueRef's value depends only on the state of
+    //! the source and candidate objects it is evaluated on, and their own
+    //! properties, not on any other objects or gamestate. See
+    //! Condition::CandidateLocal().
+    virtual bool CandidateLocal() const          { return ConstantExpr(); }
+
+    //! Returns true iff this ValueRef's value, when evaluated in an effect,
+    //! depends only on the effect's source and target objects and their own
+    //! properties, and on the target's current value. See
+    //! Effect::Effect::TargetLocal().
+    virtual bool TargetLocal() const             { return ConstantExpr(); }
+
     std::string InvariancePattern() const;
     virtual std::string Description() const = 0;                    //! Returns a user-readable text description of this ValueRef
     virtual std::string EvalAsString() const = 0;                   //! Returns a textual representation of the evaluation result  with an empty/default context
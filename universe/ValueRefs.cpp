@@ -1,9 +1,11 @@
 #include "ValueRefs.h"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iomanip>
 #include <iterator>
+#include <string_view>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -291,6 +293,15 @@ MeterType NameToMeter(const std::string& name) {
     return retval;
 }
 
+bool IsCandidateLocalProperty(const std::string& property_name) {
+    static const std::array<std::string_view, 16> LOCAL_PROPERTIES{{
+        "ID", "Owner", "SystemID", "X", "Y", "PlanetID", "FleetID", "DesignID",
+        "ProducedByEmpireID", "Species", "Focus", "BuildingType", "FieldType",
+        "PlanetType", "OriginalType", "PlanetSize"}};
+    return std::find(LOCAL_PROPERTIES.begin(), LOCAL_PROPERTIES.end(), property_name) != LOCAL_PROPERTIES.end() ||
+        NameToMeter(property_name) != MeterType::INVALID_METER_TYPE;
+}
+
 const std::string& MeterToName(MeterType meter) {
     for (auto& [name, type] : GetMeterNameMap()) {
         if (type == meter)
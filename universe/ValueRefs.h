@@ -112,6 +112,8 @@ struct FO_COMMON_API Variable : public ValueRef<T>
     const std::vector<std::string>& PropertyName() const;
     bool ReturnImmediateValue() const;
     unsigned int GetCheckSum() const override;
+    bool CandidateLocal() const override;
+    bool TargetLocal() const override;
 
     std::unique_ptr<ValueRef<T>> Clone() const override
     { return std::make_unique<Variable<T>>(m_ref_type, m_property_name, m_return_immediate_value); }
@@ -141,6 +143,8 @@ struct FO_COMMON_API Statistic final : public Variable<T>
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void        SetTopLevelContent(const std::string& content_name) override;
+    bool        CandidateLocal() const override { return false; }
+    bool        TargetLocal() const override { return false; }
 
     StatisticType GetStatisticType() const
     { return m_stat_type; }
@@ -154,9 +158,11 @@ struct FO_COMMON_API Statistic final : public Variable<T>
     unsigned int GetCheckSum() const override;
 
     std::unique_ptr<ValueRef<T>> Clone() const override {
-        return std::make_unique<Statistic<T, V>>(CloneUnique(m_value_ref),
-                                                 m_stat_type,
-                                                 CloneUnique(m_sampling_condition));
+        auto retval = std::make_unique<Statistic<T, V>>(CloneUnique(m_value_ref),
+                                                        m_stat_type,
+                                                        CloneUnique(m_sampling_condition));
+        retval->m_top_level_content = m_top_level_content;
+        return retval;
     }
 
 protected:
@@ -171,9 +177,14 @@ protected:
                                  std::vector<V>& object_property_values) const;
 
 private:
+    /** Evaluates without using the Universe's StatisticCache. */
+    T EvalImpl(const ScriptingContext& context) const;
+
     StatisticType                         m_stat_type;
     std::unique_ptr<Condition::Condition> m_sampling_condition;
     std::unique_ptr<ValueRef<V>>          m_value_ref;
+    bool                                  m_cacheable = false;  ///< whether the value depends only on the source and gamestate, so can be cached
+    std::string                           m_top_level_content;  ///< for reporting StatisticCache hit rates
 };
 
 /** The complex variable ValueRef class. The value returned by this node
@@ -205,6 +216,8 @@ struct FO_COMMON_API ComplexVariable final : public Variable<T>
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
+    bool CandidateLocal() const override { return false; }
+    bool TargetLocal() const override { return false; }
     const ValueRef<int>* IntRef1() const;
     const ValueRef<int>* IntRef2() const;
     const ValueRef<int>* IntRef3() const;
@@ -246,6 +259,10 @@ struct FO_COMMON_API StaticCast final : public Variable<ToType>
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
+    bool CandidateLocal() const override
+    { return m_value_ref && m_value_ref->CandidateLocal(); }
+    bool TargetLocal() const override
+    { return m_value_ref && m_value_ref->TargetLocal(); }
 
     const ValueRef<FromType>* GetValueRef() const
     { return m_value_ref.get(); }
@@ -272,6 +289,10 @@ struct FO_COMMON_API StringCast final : public Variable<std::string>
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
+    bool CandidateLocal() const override
+    { return m_value_ref && m_value_ref->CandidateLocal(); }
+    bool TargetLocal() const override
+    { return m_value_ref && m_value_ref->TargetLocal(); }
 
     const ValueRef<FromType>* GetValueRef() const
     { return m_value_ref; }
@@ -296,6 +317,10 @@ struct FO_COMMON_API UserStringLookup final : public Variable<std::string> {
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
+    bool CandidateLocal() const override
+    { return m_value_ref && m_value_ref->CandidateLocal(); }
+    bool TargetLocal() const override
+    { return m_value_ref && m_value_ref->TargetLocal(); }
 
     const ValueRef<FromType>* GetValueRef() const
     { return m_value_ref; }
@@ -325,6 +350,8 @@ struct FO_COMMON_API NameLookup final : public Variable<std::string> {
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
+    bool CandidateLocal() const override { return false; }
+    bool TargetLocal() const override { return false; }
 
     const ValueRef<int>* GetValueRef() const
     { return m_value_ref.get(); }
@@ -394,6 +421,8 @@ struct FO_COMMON_API Operation final : public ValueRef<T>
     T Eval(const ScriptingContext& context) const override;
     bool SimpleIncrement() const override { return m_simple_increment; }
     bool ConstantExpr() const override { return m_constant_expr; }
+    bool CandidateLocal() const override;
+    bool TargetLocal() const override;
     std::string Description() const override;
     std::string Dump(unsigned short ntabs = 0) const override;
     void SetTopLevelContent(const std::string& content_name) override;
@@ -427,6 +456,12 @@ private:
 
 FO_COMMON_API MeterType             NameToMeter(const std::string& name);
 FO_COMMON_API const std::string&    MeterToName(MeterType meter);
+
+/** Returns true iff the object property \a property_name is a property of
+  * an object itself, which can be looked up without referring to any other
+  * objects or gamestate. */
+FO_COMMON_API bool                  IsCandidateLocalProperty(const std::string& property_name);
+
 FO_COMMON_API std::string           ReconstructName(const std::vector<std::string>& property_name,
                                                     ReferenceType ref_type,
                                                     bool return_immediate_value = false);
@@ -658,6 +693,29 @@ template <typename T>
 bool Variable<T>::ReturnImmediateValue() const
 { return m_return_immediate_value; }
 
+template <typename T>
+bool Variable<T>::CandidateLocal() const
+{
+    if (m_ref_type != ReferenceType::SOURCE_REFERENCE &&
+        m_ref_type != ReferenceType::CONDITION_LOCAL_CANDIDATE_REFERENCE &&
+        m_ref_type != ReferenceType::CONDITION_ROOT_CANDIDATE_REFERENCE)
+    { return false; }
+    // properties of objects referenced by the source or candidate, eg.
+    // Source.Planet.Owner, are not local to the source or candidate
+    return m_property_name.size() == 1 && IsCandidateLocalProperty(m_property_name.front());
+}
+
+template <typename T>
+bool Variable<T>::TargetLocal() const
+{
+    if (m_ref_type == ReferenceType::EFFECT_TARGET_VALUE_REFERENCE)
+        return true;
+    if (m_ref_type != ReferenceType::SOURCE_REFERENCE &&
+        m_ref_type != ReferenceType::EFFECT_TARGET_REFERENCE)
+    { return false; }
+    return m_property_name.size() == 1 && IsCandidateLocalProperty(m_property_name.front());
+}
+
 template <typename T>
 std::string Variable<T>::Description() const
 { return FormatedDescriptionPropertyNames(m_ref_type, m_property_name, m_return_immediate_value); }
@@ -734,6 +792,12 @@ Statistic<T, V>::Statistic(std::unique_ptr<ValueRef<V>>&& value_ref, StatisticTy
 
     this->m_source_invariant = (!m_sampling_condition || m_sampling_condition->SourceInvariant()) &&
                                (!m_value_ref || m_value_ref->SourceInvariant());
+
+    // the sampling condition and property are evaluated with their own local
+    // candidates, so needn't be invariant to that of the parent context
+    m_cacheable = this->m_root_candidate_invariant && this->m_target_invariant &&
+                  (!m_sampling_condition || ConditionMemo::CanMemoize(*m_sampling_condition)) &&
+                  (!m_value_ref || m_value_ref->CandidateLocal());
 }
 
 template <typename T, typename V>
@@ -790,7 +854,8 @@ void Statistic<T, V>::GetObjectPropertyValues(const ScriptingContext& context,
         // TODO: Can / should this be paralleized?
         object_property_values.reserve(objects.size());
         for (auto& object : objects)
-            object_property_values.push_back(m_value_ref->Eval(ScriptingContext(context, object)));
+            object_property_values.push_back(m_value_ref->Eval(
+                ScriptingContext(ScriptingContext::LocalCandidateView{}, context, object)));
     }
 }
 
@@ -841,6 +906,7 @@ std::string Statistic<T, V>::Dump(unsigned short ntabs) const
 template <typename T, typename V>
 void Statistic<T, V>::SetTopLevelContent(const std::string& content_name)
 {
+    m_top_level_content = content_name;
     if (m_sampling_condition)
         m_sampling_condition->SetTopLevelContent(content_name);
     if (m_value_ref)
@@ -1145,6 +1211,22 @@ T ReduceData(StatisticType stat_type, std::vector<V> object_property_values)
 
 template <typename T, typename V>
 T Statistic<T, V>::Eval(const ScriptingContext& context) const
+{
+    if (m_cacheable) {
+        const auto& universe = context.ContextUniverse();
+        auto* cache = universe.ActiveStatisticCache();
+        if (cache && &context.ContextObjects() == &universe.Objects()) {
+            const int source_id = (this->m_source_invariant || !context.source) ?
+                INVALID_OBJECT_ID : context.source->ID();
+            return cache->Get<T>(*this, source_id, m_top_level_content,
+                                 [this, &context]() { return EvalImpl(context); });
+        }
+    }
+    return EvalImpl(context);
+}
+
+template <typename T, typename V>
+T Statistic<T, V>::EvalImpl(const ScriptingContext& context) const
 {
     Condition::ObjectSet condition_matches;
     GetConditionMatches(context, condition_matches, m_sampling_condition.get());
@@ -1872,6 +1954,28 @@ const ValueRef<T>* Operation<T>::RHS() const
     }
 }
 
+template <typename T>
+bool Operation<T>::CandidateLocal() const
+{
+    if (m_constant_expr)
+        return true;
+    if (m_op_type == OpType::RANDOM_UNIFORM || m_op_type == OpType::RANDOM_PICK)
+        return false;
+    return std::all_of(m_operands.begin(), m_operands.end(),
+        [](const auto& operand) { return operand && operand->CandidateLocal(); });
+}
+
+template <typename T>
+bool Operation<T>::TargetLocal() const
+{
+    if (m_constant_expr)
+        return true;
+    if (m_op_type == OpType::RANDOM_UNIFORM || m_op_type == OpType::RANDOM_PICK)
+        return false;
+    return std::all_of(m_operands.begin(), m_operands.end(),
+        [](const auto& operand) { return operand && operand->TargetLocal(); });
+}
+
 template <typename T>
 const std::vector<ValueRef<T>*> Operation<T>::Operands() const
 {
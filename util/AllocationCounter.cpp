@@ -0,0 +1,153 @@
+#include "AllocationCounter.h"
+
+#if defined(FREEORION_ALLOCATION_PROFILING)
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // plain values, so that they are usable in allocations made before and
+    // while thread local storage is being initialized
+    thread_local std::uint64_t t_allocations = 0;
+    thread_local std::uint64_t t_bytes = 0;
+
+    void Count(std::size_t size) noexcept {
+        ++t_allocations;
+        t_bytes += size;
+    }
+
+    void* Allocate(std::size_t size) {
+        Count(size);
+        while (true) {
+            if (void* retval = std::malloc(size ? size : 1))
+                return retval;
+            auto handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+        Count(size);
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t padded_size = size ? (size + align - 1) / align * align : align;
+        while (true) {
+#if defined(_MSC_VER)
+            if (void* retval = _aligned_malloc(padded_size, align))
+#else
+            if (void* retval = std::aligned_alloc(align, padded_size))
+#endif
+                return retval;
+            auto handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void FreeAligned(void* ptr) noexcept {
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+FO_COMMON_API void* operator new(std::size_t size)
+{ return Allocate(size); }
+
+FO_COMMON_API void* operator new[](std::size_t size)
+{ return Allocate(size); }
+
+FO_COMMON_API void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+FO_COMMON_API void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return Allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+FO_COMMON_API void* operator new(std::size_t size, std::align_val_t alignment)
+{ return AllocateAligned(size, alignment); }
+
+FO_COMMON_API void* operator new[](std::size_t size, std::align_val_t alignment)
+{ return AllocateAligned(size, alignment); }
+
+FO_COMMON_API void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return AllocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+FO_COMMON_API void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return AllocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+FO_COMMON_API void operator delete(void* ptr) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete(void* ptr, std::size_t) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr, std::size_t) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+
+FO_COMMON_API void operator delete(void* ptr, std::align_val_t) noexcept
+{ FreeAligned(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr, std::align_val_t) noexcept
+{ FreeAligned(ptr); }
+
+FO_COMMON_API void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{ FreeAligned(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{ FreeAligned(ptr); }
+
+FO_COMMON_API void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{ FreeAligned(ptr); }
+
+FO_COMMON_API void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{ FreeAligned(ptr); }
+
+bool AllocationCountingEnabled() noexcept
+{ return true; }
+
+AllocationCounts ThreadAllocationCounts() noexcept
+{ return {t_allocations, t_bytes}; }
+
+#else
+
+bool AllocationCountingEnabled() noexcept
+{ return false; }
+
+AllocationCounts ThreadAllocationCounts() noexcept
+{ return {}; }
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef _AllocationCounter_h_
+#define _AllocationCounter_h_
+
+#include <cstdint>
+
+#include "Export.h"
+
+
+//! Numbers of heap allocations and of bytes requested by them.
+struct AllocationCounts {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+
+    AllocationCounts& operator+=(const AllocationCounts& rhs) noexcept {
+        allocations += rhs.allocations;
+        bytes += rhs.bytes;
+        return *this;
+    }
+
+    [[nodiscard]] AllocationCounts operator-(const AllocationCounts& rhs) const noexcept
+    { return {allocations - rhs.allocations, bytes - rhs.bytes}; }
+};
+
+//! Returns whether heap allocations are counted, which they are only in
+//! builds configured with BUILD_ALLOCATION_PROFILING.  These replace the
+//! global operator new to count the allocations of each thread.
+//!
+//! On Windows the replacement is only used by code in the common library,
+//! so allocations in the executables aren't counted.
+FO_COMMON_API bool AllocationCountingEnabled() noexcept;
+
+//! Returns the number of allocations made by the calling thread since it
+//! started, or zeros if allocations aren't counted.  The difference between
+//! two calls on the same thread is the allocations made between them.
+FO_COMMON_API AllocationCounts ThreadAllocationCounts() noexcept;
+
+
+#endif
@@ -15,6 +15,7 @@
 #include "../universe/Tech.h"
 #include "../util/Directories.h"
 #include "../util/GameRules.h"
+#include "../util/OptionsDB.h"
 #include "../util/Pending.h"
 
 #include <boost/filesystem.hpp>
@@ -36,8 +37,11 @@ IApp::IApp() {
     s_app = this;
 }
 
-IApp::~IApp()
-{ s_app = nullptr; }
+IApp::~IApp() {
+    if (parse::ProfilingEnabled())
+        InfoLogger() << "Content parsing profile:\n" << parse::ProfileReport(GetResourceDir() / "scripting");
+    s_app = nullptr;
+}
 
 IApp* IApp::GetApp()
 { return s_app; }
@@ -61,6 +65,9 @@ void IApp::StartBackgroundParsing() {
         return;
     }
 
+    if (GetOptionsDB().OptionExists("parse-profile") && GetOptionsDB().Get<bool>("parse-profile"))
+        parse::SetProfilingEnabled(true);
+
     // named value ref parsing can be done in parallel as the referencing happens after parsing
     if (fs::exists(rdir / "scripting/common"))
         GetNamedValueRefManager().SetNamedValueRefParse(Pending::StartParsing(parse::named_value_refs, rdir / "scripting/common"));
@@ -77,8 +84,11 @@ void IApp::StartBackgroundParsing() {
     else
         ErrorLogger() << "Background parse path doesn't exist: " << (rdir / "scripting/policies").string();
 
+    // encyclopedia articles are only text for players to read
     if (fs::exists(rdir / "scripting/encyclopedia"))
-        GetEncyclopedia().SetArticles(Pending::StartParsing(parse::encyclopedia_articles, rdir / "scripting/encyclopedia"));
+        GetEncyclopedia().SetArticles(ShowsContentText() ?
+                                      Pending::StartParsing(parse::encyclopedia_articles, rdir / "scripting/encyclopedia") :
+                                      Pending::ParseOnDemand(parse::encyclopedia_articles, rdir / "scripting/encyclopedia"));
     else
         ErrorLogger() << "Background parse path doesn't exist: " << (rdir / "scripting/encyclopedia").string();
 
@@ -23,6 +23,11 @@ class Building;
 class Field;
 struct GalaxySetupData;
 
+/** The application, which owns the gamestate of the one game it runs.  Game
+    logic throughout the common code, such as conditions, effects and orders,
+    reaches the gamestate through the singleton returned by GetApp(), so a
+    process can run only one game at a time.  Parsed content, such as techs,
+    species, hulls and parts, is held by process-wide managers instead. */
 class FO_COMMON_API IApp {
 protected:
     IApp();
@@ -86,6 +91,12 @@ public:
     virtual int EffectsProcessingThreads() const = 0;
 
 protected:
+    /** Returns whether this application shows content text that does not
+        affect the game, such as encyclopedia articles, to players.  If not,
+        that content is only parsed if it is used. */
+    virtual bool ShowsContentText() const
+    { return false; }
+
     static IApp* s_app; ///< a IApp pointer to the singleton instance of the app
 
     // NormalExitException is used to break out of the run loop, without calling
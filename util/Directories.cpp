@@ -540,11 +540,23 @@ auto GetResourceDir() -> fs::path const
 
 auto GetConfigPath() -> fs::path const
 {
-    static const fs::path p = GetUserConfigDir() / "config.xml";
+    static const fs::path p = GetUserConfigDir() / "config.txt";
     return p;
 }
 
 auto GetPersistentConfigPath() -> fs::path const
+{
+    static const fs::path p = GetUserConfigDir() / "persistent_config.txt";
+    return p;
+}
+
+auto GetLegacyConfigPath() -> fs::path const
+{
+    static const fs::path p = GetUserConfigDir() / "config.xml";
+    return p;
+}
+
+auto GetLegacyPersistentConfigPath() -> fs::path const
 {
     static const fs::path p = GetUserConfigDir() / "persistent_config.xml";
     return p;
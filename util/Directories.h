@@ -127,6 +127,13 @@ FO_COMMON_API auto GetConfigPath() -> boost::filesystem::path const;
 //! Returns the full path to the configfile.
 FO_COMMON_API auto GetPersistentConfigPath() -> boost::filesystem::path const;
 
+//! Returns the full path to the xml configfile of earlier versions, which is
+//! read if there is no configfile.
+FO_COMMON_API auto GetLegacyConfigPath() -> boost::filesystem::path const;
+
+//! Returns the full path to the xml persistent configfile of earlier versions.
+FO_COMMON_API auto GetLegacyPersistentConfigPath() -> boost::filesystem::path const;
+
 //! Returns the directory where save files are located.
 //!
 //! This is typically the directory "save" within the user directory.
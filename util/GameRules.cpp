@@ -5,6 +5,9 @@ namespace {
         static std::vector<GameRulesFn> game_rules_registry;
         return game_rules_registry;
     }
+
+    // starts at 1 so that a RuleHandle that hasn't got its value is out of date
+    std::atomic<std::uint64_t> game_rules_generation{1};
 }
 
 
@@ -121,14 +124,22 @@ void GameRules::ClearExternalRules() {
         else
             ++it;
     }
+    RulesChanged();
 }
 
 void GameRules::ResetToDefaults() {
     CheckPendingGameRules();
     for (auto& it : m_game_rules)
         it.second.SetToDefault();
+    RulesChanged();
 }
 
+std::uint64_t GameRules::Generation() noexcept
+{ return game_rules_generation.load(std::memory_order_acquire); }
+
+void GameRules::RulesChanged() noexcept
+{ game_rules_generation.fetch_add(1, std::memory_order_release); }
+
 std::map<std::string, std::string> GameRules::GetRulesAsStrings() const {
     CheckPendingGameRules();
     std::map<std::string, std::string> retval;
@@ -162,6 +173,7 @@ void GameRules::SetFromStrings(const std::map<std::string, std::string>& names_v
             ErrorLogger() << "Unable to set rule: " << name << " to value: " << value;
         }
     }
+    RulesChanged();
 
     DebugLogger() << "After Setting Rules:";
     for (auto& [name, value] : m_game_rules)
@@ -184,6 +196,7 @@ void GameRules::CheckPendingGameRules() const {
         }
         m_game_rules[name] = value;
     }
+    RulesChanged();
 
     DebugLogger() << "Registered and Parsed Game Rules:";
     for (auto& [name, value] : GetRulesAsStrings())
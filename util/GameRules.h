@@ -4,6 +4,10 @@
 #include "OptionsDB.h"
 #include "Pending.h"
 
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
 class GameRules;
 
 /////////////////////////////////////////////
@@ -77,6 +81,10 @@ public:
     /** returns all contained rules as map of name and value string. */
     std::map<std::string, std::string> GetRulesAsStrings() const;
 
+    /** returns a number that changes whenever a rule is added, removed, set or
+      * reset, after the change is made. */
+    static std::uint64_t Generation() noexcept;
+
     template <typename T>
     T Get(const std::string& name) const
     {
@@ -119,6 +127,7 @@ public:
         T value = GetOptionsDB().Get<T>("setup.rules." + name);
         m_game_rules[name] = Rule(RuleTypeForType(T()), name, value, value, description,
                                   validator.Clone(), engine_interal, category);
+        RulesChanged();
         DebugLogger() << "Added game rule named " << name << " with default value " << value;
     }
 
@@ -133,6 +142,7 @@ public:
         if (it == m_game_rules.end())
             throw std::runtime_error("GameRules::Set<>() : Attempted to set nonexistent rule \"" + name + "\".");
         it->second.SetFromValue(value);
+        RulesChanged();
     }
 
     void SetFromStrings(const std::map<std::string, std::string>& names_values);
@@ -148,6 +158,10 @@ private:
     /** Assigns any m_pending_rules to m_game_rules. */
     void CheckPendingGameRules() const;
 
+    /** Changes Generation(), so that RuleHandle%s get their rule's value
+      * again. */
+    static void RulesChanged() noexcept;
+
     /** Future rules being parsed by parser.  mutable so that it can
         be assigned to m_game_rules when completed.*/
     mutable boost::optional<Pending::Pending<GameRules>> m_pending_rules = boost::none;
@@ -157,5 +171,46 @@ private:
     friend FO_COMMON_API GameRules& GetGameRules();
 };
 
+/** Typed handle to a rule, for getting its value on hot paths.  The first
+  * Get() looks the rule up like GameRules::Get() does, and the value is then
+  * cached until GameRules::Generation() changes, so that a Get() usually only
+  * loads and compares that counter.  Handles may be used from multiple
+  * threads, and are usually declared at file scope where they are used:
+  *
+  *     const RuleHandle<int> NUM_COMBAT_ROUNDS{"RULE_NUM_COMBAT_ROUNDS"};
+  *
+  * GameRules::Get() remains for rules with names only known at runtime. */
+template <typename T>
+class RuleHandle {
+    static_assert(std::is_arithmetic_v<T>, "RuleHandle caches only toggle, int and double rules");
+
+public:
+    explicit RuleHandle(std::string name) :
+        m_name(std::move(name))
+    {}
+
+    T Get() const {
+        // Generation() changes after the rules do, so a value got after
+        // reading the generation is at least as new as the generation
+        const auto generation = GameRules::Generation();
+        if (m_generation.load(std::memory_order_acquire) != generation) {
+            m_value.store(GetGameRules().Get<T>(m_name), std::memory_order_relaxed);
+            m_generation.store(generation, std::memory_order_release);
+        }
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    T operator()() const
+    { return Get(); }
+
+    const std::string& Name() const noexcept
+    { return m_name; }
+
+private:
+    const std::string                       m_name;
+    mutable std::atomic<T>                  m_value{};
+    mutable std::atomic<std::uint64_t>      m_generation{0};
+};
+
 
 #endif
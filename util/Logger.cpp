@@ -6,10 +6,12 @@
 #include <boost/log/attributes/current_thread_id.hpp>
 #include <boost/log/attributes/value_extraction.hpp>
 #include <boost/log/expressions/keyword.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/unbounded_fifo_queue.hpp>
 #include <boost/log/sources/global_logger_storage.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/sources/severity_channel_logger.hpp>
@@ -21,6 +23,7 @@
 #include <boost/log/utility/setup/formatter_parser.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/phoenix/bind/bind_function.hpp>
 
 #ifdef _MSC_VER
 #  include <ctime>
@@ -50,6 +53,10 @@ namespace {
             (boost::log::keywords::channel = "log"));                   \
     }
 
+    const std::atomic<int>& FO_LOGGER_THRESHOLD_NAME(log)() {
+        static const std::atomic<int>& threshold = LoggerThreshold("log");
+        return threshold;
+    }
 
     // Compile time constant pointers to constant char arrays.
     constexpr const char* const log_level_names[] = {"trace", "debug", "info", "warn", "error"};
@@ -140,6 +147,17 @@ namespace {
     const std::string& DisplayName(const std::string& channel_name)
     { return (channel_name.empty() ? LocalUnnamedLoggerIdentifier() : channel_name); }
 
+    std::atomic<int>& MutableLoggerThreshold(const std::string& channel) {
+        // Allocated and never destroyed, so that loggers can still be used
+        // during static deinitialization.  References to the elements of an
+        // unordered_map remain valid when more are inserted.
+        static std::mutex mutex;
+        static auto* thresholds = new std::unordered_map<std::string, std::atomic<int>>();
+
+        std::scoped_lock lock(mutex);
+        return thresholds->try_emplace(channel, static_cast<int>(LogLevel::min)).first->second;
+    }
+
     boost::optional<LogLevel>& ForcedThreshold() {
         // Create forced threshold as a static function variable to avoid static initialization fiasco
         static boost::optional<LogLevel> forced_threshold = boost::none;
@@ -148,6 +166,16 @@ namespace {
 
     using LoggerTextFileSinkFrontend = boost::log::sinks::synchronous_sink<boost::log::sinks::text_file_backend>;
 
+    /** The single frontend used for all loggers when logging asynchronously.  Its thread
+        formats the records of all channels and writes them to the file backend. */
+    using LoggerAsyncFileSinkFrontend = boost::log::sinks::asynchronous_sink<
+        boost::log::sinks::text_file_backend, boost::log::sinks::unbounded_fifo_queue>;
+
+    boost::shared_ptr<LoggerAsyncFileSinkFrontend>& AsyncFileSinkFrontend() {
+        static boost::shared_ptr<LoggerAsyncFileSinkFrontend> sink_frontend;
+        return sink_frontend;
+    }
+
     using LoggerFileSinkFrontEndConfigurer = std::function<void(LoggerTextFileSinkFrontend& sink_frontend)>;
 
     boost::shared_ptr<LoggerTextFileSinkFrontend::sink_backend_type>& FileSinkBackend() {
@@ -235,7 +263,8 @@ namespace {
             std::scoped_lock lock(m_mutex);
 
             for (const auto& name_and_frontend : m_names_to_front_ends)
-                logging::core::get()->remove_sink(name_and_frontend.second);
+                if (name_and_frontend.second)
+                    logging::core::get()->remove_sink(name_and_frontend.second);
         }
 
     };
@@ -250,6 +279,13 @@ namespace {
                                          const std::string& channel_name,
                                          const LoggerFileSinkFrontEndConfigurer& configure_front_end)
     {
+        // The asynchronous frontend formats the records of all channels, so
+        // only the name is needed.
+        if (AsyncFileSinkFrontend()) {
+            GetLoggersToSinkFrontEnds().AddOrReplaceLoggerName(channel_name);
+            return;
+        }
+
         // Create a sink frontend for formatting.
         auto sink_frontend = boost::make_shared<LoggerTextFileSinkFrontend>(file_sink_backend);
 
@@ -275,6 +311,9 @@ void ApplyConfigurationToFileSinkFrontEnd(const std::string& channel_name,
     ConfigureToFileSinkFrontEndCore(file_sink_backend, channel_name, configure_front_end);
 }
 
+const std::atomic<int>& LoggerThreshold(const std::string& channel)
+{ return MutableLoggerThreshold(channel); }
+
 const std::string& DefaultExecLoggerName()
 { return LocalUnnamedLoggerIdentifier(); }
 
@@ -306,6 +345,7 @@ namespace {
             auto used_threshold = ForcedThreshold() ? *ForcedThreshold() : threshold;
             m_min_channel_severity[source] = used_threshold;
             logging::core::get()->set_filter(m_min_channel_severity);
+            MutableLoggerThreshold(source).store(static_cast<int>(used_threshold), std::memory_order_relaxed);
 
             return {DisplayName(source), used_threshold};
         }
@@ -335,6 +375,23 @@ namespace {
         // Set a filter to only format this channel
         sink_frontend.set_filter(log_channel == channel_name);
     }
+
+    std::string ChannelDisplayName(const logging::value_ref<std::string, tag::log_channel>& channel_name)
+    { return channel_name ? DisplayName(channel_name.get()) : std::string{}; }
+
+    void ConfigureAsyncFileSinkFrontEnd(LoggerAsyncFileSinkFrontend& sink_frontend) {
+        // Create the same format as ConfigureFileSinkFrontEnd, with the name
+        // of the channel of each record
+        sink_frontend.set_formatter(
+            expr::stream
+            << expr::format_date_time<boost::posix_time::ptime>("TimeStamp", "%H:%M:%S.%f")
+            << " {" << thread_id << "}"
+            << " [" << log_severity << "] "
+            << boost::phoenix::bind(&ChannelDisplayName, log_channel.or_none())
+            << " : " << log_src_filename << ":" << log_src_linenum << " : "
+            << expr::message
+        );
+    }
 }
 
 void SetLoggerThreshold(const std::string& source, LogLevel threshold) {
@@ -344,7 +401,9 @@ void SetLoggerThreshold(const std::string& source, LogLevel threshold) {
                     << "\" logger threshold to \"" << name_and_threshold.second << "\".";
 }
 
-void InitLoggingSystem(const std::string& log_file, const std::string& _unnamed_logger_identifier) {
+void InitLoggingSystem(const std::string& log_file, const std::string& _unnamed_logger_identifier,
+                       bool asynchronous)
+{
     auto& unnamed_logger_identifier = LocalUnnamedLoggerIdentifier();
     unnamed_logger_identifier = _unnamed_logger_identifier;
     std::transform(unnamed_logger_identifier.begin(), unnamed_logger_identifier.end(),
@@ -362,6 +421,15 @@ void InitLoggingSystem(const std::string& log_file, const std::string& _unnamed_
         keywords::auto_flush = true
     );
 
+    // The asynchronous frontend must exist before any per channel frontends
+    // would be created, and starts its thread when constructed.
+    if (asynchronous) {
+        auto& async_sink_frontend = AsyncFileSinkFrontend();
+        async_sink_frontend = boost::make_shared<LoggerAsyncFileSinkFrontend>(file_sink_backend);
+        ConfigureAsyncFileSinkFrontEnd(*async_sink_frontend);
+        logging::core::get()->add_sink(async_sink_frontend);
+    }
+
     // Create the frontend for formatting default records.
     ApplyConfigurationToFileSinkFrontEnd("", boost::bind(ConfigureFileSinkFrontEnd, boost::placeholders::_1, ""));
 
@@ -393,7 +461,8 @@ void InitLoggingSystem(const std::string& log_file, const std::string& _unnamed_
 
         char time_as_string_buf[100] = {};
         std::strftime(time_as_string_buf, sizeof(time_as_string_buf), "%c", &temp_tm);
-        InfoLogger(log) << "Logger initialized at " << time_as_string_buf;
+        InfoLogger(log) << "Logger initialized at " << time_as_string_buf
+                        << (asynchronous ? " with asynchronous output" : "");
     }
 }
 
@@ -408,6 +477,14 @@ void ShutdownLoggingSystemFileSink() {
     // When either ticket is fixed the ShutdownLoggingSystem() function can be removed.
 
     GetLoggersToSinkFrontEnds().ShutdownFileSinks();
+
+    // Write any queued records before stopping the thread of the asynchronous frontend.
+    if (auto& async_sink_frontend = AsyncFileSinkFrontend()) {
+        logging::core::get()->remove_sink(async_sink_frontend);
+        async_sink_frontend->stop();
+        async_sink_frontend->flush();
+        async_sink_frontend.reset();
+    }
 }
 
 void OverrideAllLoggersThresholds(const boost::optional<LogLevel>& threshold) {
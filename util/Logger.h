@@ -2,6 +2,7 @@
 #define _Logger_h_
 
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <boost/log/sources/global_logger_storage.hpp>
@@ -158,8 +159,13 @@ std::unordered_map<std::string, LogLevel> ValidNameToLogLevel();
 /** Initializes the logging system. Log to the \p log_file.  If \p log_file already exists it will
  * be deleted. \p unnamed_logger_identifier is the name used in the log file to identify logs from
  * the singular unnamed logger for this executable.  Logs from the named loggers are identified by
- * their own name.*/
-FO_COMMON_API void InitLoggingSystem(const std::string& log_file, const std::string& unnamed_logger_identifier);
+ * their own name.
+ *
+ * If \p asynchronous is true, records are queued and formatted and written to \p log_file by a
+ * dedicated thread, so that threads that log don't wait for each other or for the file.  Records
+ * still queued when the process crashes are lost.*/
+FO_COMMON_API void InitLoggingSystem(const std::string& log_file, const std::string& unnamed_logger_identifier,
+                                     bool asynchronous = false);
 
 /** Shutdown the file sink.  This should be called near the end of main() before the start of
     static de-initialization.
@@ -195,6 +201,10 @@ FO_COMMON_API void ConfigureLogger(NamedThreadedLogger& logger, const std::strin
 using LoggerCreatedSignalType = boost::signals2::signal<void (const std::string logger)>;
 FO_COMMON_API extern LoggerCreatedSignalType LoggerCreatedSignal;
 
+/** Returns the threshold of the logger \p channel, as an int, for FO_LOGGER to skip records
+    below it without creating them.  The reference remains valid for the life of the process. */
+FO_COMMON_API const std::atomic<int>& LoggerThreshold(const std::string& channel);
+
 // Return all loggers created since app start.  Used to provide the UI a complete list of global
 // loggers intialized during static initialization.
 FO_COMMON_API std::vector<std::string> CreatedLoggersNames();
@@ -214,6 +224,10 @@ FO_COMMON_API std::vector<std::string> CreatedLoggersNames();
 #define FO_GLOBAL_LOGGER_NAME(...)                             \
     fo_logger_global_ ## __VA_ARGS__
 
+// Name of the function returning the LoggerThreshold() of global logger \p name.
+#define FO_LOGGER_THRESHOLD_NAME(...)                          \
+    fo_logger_threshold_ ## __VA_ARGS__
+
 // Place in source file to create the previously defined global logger \p name
 #define DeclareThreadSafeLogger(...)   \
     BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(                          \
@@ -230,6 +244,17 @@ FO_COMMON_API std::vector<std::string> CreatedLoggersNames();
             (boost::log::keywords::channel = channel));           \
         ConfigureLogger(lg, channel);                             \
         return lg;                                                \
+    }                                                             \
+    inline const std::atomic<int>&                                \
+    FO_LOGGER_THRESHOLD_NAME(__VA_ARGS__)() {                     \
+        static const std::atomic<int>& threshold = LoggerThreshold( \
+            BOOST_PP_IF(                                          \
+                BOOST_PP_AND(                                     \
+                    FO_LOGGER_WIN32_WORKAROUND,                   \
+                    BOOST_PP_IS_EMPTY(__VA_ARGS__)),              \
+                "",                                               \
+                #__VA_ARGS__));                                   \
+        return threshold;                                         \
     }
 
 
@@ -240,10 +265,15 @@ DeclareThreadSafeLogger();
 #define __BASE_FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
 
 
-#define FO_LOGGER(lvl, ...)                         \
-    BOOST_LOG_STREAM_WITH_PARAMS(                   \
-        FO_GLOBAL_LOGGER_NAME(__VA_ARGS__)::get(),  \
-        (boost::log::keywords::severity = lvl))     \
+// Records below the threshold of the logger are skipped before boost::log
+// creates them, and before their stream arguments are evaluated.
+#define FO_LOGGER(lvl, ...)                                                 \
+    for (bool fo_logger_enabled = static_cast<int>(lvl) >=                  \
+             FO_LOGGER_THRESHOLD_NAME(__VA_ARGS__)().load(std::memory_order_relaxed); \
+         fo_logger_enabled; fo_logger_enabled = false)                      \
+        BOOST_LOG_STREAM_WITH_PARAMS(                                       \
+            FO_GLOBAL_LOGGER_NAME(__VA_ARGS__)::get(),                      \
+            (boost::log::keywords::severity = lvl))                         \
 
 
 #define TraceLogger(...) FO_LOGGER(LogLevel::trace, __VA_ARGS__)  \
@@ -19,6 +19,11 @@ namespace {
             (boost::log::keywords::channel = "log"));                   \
     }
 
+    const std::atomic<int>& FO_LOGGER_THRESHOLD_NAME(log)() {
+        static const std::atomic<int>& threshold = LoggerThreshold("log");
+        return threshold;
+    }
+
     constexpr LogLevel default_sink_level = default_log_level_threshold;
     constexpr LogLevel default_source_level = default_log_level_threshold;
 
@@ -0,0 +1,137 @@
+#ifndef _MemoryUsage_h_
+#define _MemoryUsage_h_
+
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+
+/** Approximations of the heap memory used by containers, for reporting which
+  * parts of the game state use the most memory.  HeapBytes(t) is the number of
+  * bytes allocated by \a t itself, not including sizeof(t), so that the memory
+  * used by nested containers adds up.  The overheads of nodes and allocations
+  * are estimates for typical 64 bit standard libraries. */
+namespace MemoryUsage {
+    /** Bytes of a node of a std::map, std::set or std::list beyond its value:
+      * links, colour and allocator bookkeeping. */
+    constexpr std::size_t NODE_OVERHEAD = 4 * sizeof(void*);
+
+    /** Bytes of a node of an unordered container beyond its value, excluding
+      * its bucket. */
+    constexpr std::size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+    // types that don't allocate, such as numbers, enums and Meters
+    template <typename T, std::enable_if_t<std::is_trivially_copyable_v<T>>* = nullptr>
+    constexpr std::size_t HeapBytes(const T&) noexcept
+    { return 0; }
+
+    // classes that have HeapBytes methods
+    template <typename C>
+    std::size_t HeapBytes(const C& c, decltype(std::declval<const C&>().HeapBytes())* = nullptr)
+    { return c.HeapBytes(); }
+
+    inline std::size_t HeapBytes(const std::string& s) noexcept
+    { return s.capacity() > 15 ? s.capacity() + 1 : 0; }   // short strings are stored inline
+
+    template <typename A, typename B>
+    std::size_t HeapBytes(const std::pair<A, B>& p);
+    template <typename T>
+    std::size_t HeapBytes(const std::shared_ptr<T>& p);
+    template <typename T>
+    std::size_t HeapBytes(const std::unique_ptr<T>& p);
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::vector<T, A>& c);
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::deque<T, A>& c);
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::list<T, A>& c);
+    template <typename K, typename V, typename C, typename A>
+    std::size_t HeapBytes(const std::map<K, V, C, A>& c);
+    template <typename K, typename C, typename A>
+    std::size_t HeapBytes(const std::set<K, C, A>& c);
+    template <typename K, typename V, typename H, typename E, typename A>
+    std::size_t HeapBytes(const std::unordered_map<K, V, H, E, A>& c);
+    template <typename K, typename H, typename E, typename A>
+    std::size_t HeapBytes(const std::unordered_set<K, H, E, A>& c);
+    template <typename K, typename V, typename C, typename A>
+    std::size_t HeapBytes(const boost::container::flat_map<K, V, C, A>& c);
+    template <typename K, typename C, typename A>
+    std::size_t HeapBytes(const boost::container::flat_set<K, C, A>& c);
+
+    /** Sum of HeapBytes of the elements of \a c. */
+    template <typename C>
+    std::size_t ElementsHeapBytes(const C& c) {
+        std::size_t retval = 0;
+        if constexpr (!std::is_trivially_copyable_v<typename C::value_type>)
+            for (const auto& e : c)
+                retval += HeapBytes(e);
+        return retval;
+    }
+
+    template <typename A, typename B>
+    std::size_t HeapBytes(const std::pair<A, B>& p)
+    { return HeapBytes(p.first) + HeapBytes(p.second); }
+
+    // pointees are counted for each pointer to them, so shared objects are
+    // counted more than once
+    template <typename T>
+    std::size_t HeapBytes(const std::shared_ptr<T>& p)
+    { return p ? sizeof(T) + 2 * sizeof(void*) + HeapBytes(*p) : 0; }   // with the control block
+
+    template <typename T>
+    std::size_t HeapBytes(const std::unique_ptr<T>& p)
+    { return p ? sizeof(T) + HeapBytes(*p) : 0; }
+
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::vector<T, A>& c)
+    { return c.capacity() * sizeof(T) + ElementsHeapBytes(c); }
+
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::deque<T, A>& c)
+    { return c.size() * sizeof(T) + ElementsHeapBytes(c); }
+
+    template <typename T, typename A>
+    std::size_t HeapBytes(const std::list<T, A>& c)
+    { return c.size() * (sizeof(T) + NODE_OVERHEAD) + ElementsHeapBytes(c); }
+
+    template <typename K, typename V, typename C, typename A>
+    std::size_t HeapBytes(const std::map<K, V, C, A>& c)
+    { return c.size() * (sizeof(typename std::map<K, V, C, A>::value_type) + NODE_OVERHEAD) + ElementsHeapBytes(c); }
+
+    template <typename K, typename C, typename A>
+    std::size_t HeapBytes(const std::set<K, C, A>& c)
+    { return c.size() * (sizeof(K) + NODE_OVERHEAD) + ElementsHeapBytes(c); }
+
+    template <typename K, typename V, typename H, typename E, typename A>
+    std::size_t HeapBytes(const std::unordered_map<K, V, H, E, A>& c) {
+        return c.bucket_count() * sizeof(void*) +
+            c.size() * (sizeof(typename std::unordered_map<K, V, H, E, A>::value_type) + HASH_NODE_OVERHEAD) +
+            ElementsHeapBytes(c);
+    }
+
+    template <typename K, typename H, typename E, typename A>
+    std::size_t HeapBytes(const std::unordered_set<K, H, E, A>& c)
+    { return c.bucket_count() * sizeof(void*) + c.size() * (sizeof(K) + HASH_NODE_OVERHEAD) + ElementsHeapBytes(c); }
+
+    template <typename K, typename V, typename C, typename A>
+    std::size_t HeapBytes(const boost::container::flat_map<K, V, C, A>& c)
+    { return c.capacity() * sizeof(typename boost::container::flat_map<K, V, C, A>::value_type) + ElementsHeapBytes(c); }
+
+    template <typename K, typename C, typename A>
+    std::size_t HeapBytes(const boost::container::flat_set<K, C, A>& c)
+    { return c.capacity() * sizeof(K) + ElementsHeapBytes(c); }
+}
+
+
+#endif
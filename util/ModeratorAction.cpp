@@ -86,6 +86,7 @@ void Moderator::AddStarlane::Execute() const {
     }
     sys1->AddStarlane(m_id_2);
     sys2->AddStarlane(m_id_1);
+    GetUniverse().StarlaneTopologyChanged();
 }
 
 std::string Moderator::AddStarlane::Dump() const {
@@ -122,6 +123,7 @@ void Moderator::RemoveStarlane::Execute() const {
     }
     sys1->RemoveStarlane(m_id_2);
     sys2->RemoveStarlane(m_id_1);
+    GetUniverse().StarlaneTopologyChanged();
 }
 
 std::string Moderator::RemoveStarlane::Dump() const {
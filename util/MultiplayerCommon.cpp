@@ -28,16 +28,26 @@ namespace {
                             OrValidator<std::string>(LogLevelValidator(), DiscreteValidator<std::string>("")),  false);
         db.Add<std::string>("log-file",                     UserStringNop("OPTIONS_DB_LOG_FILE"),               "",
                             Validator<std::string>(),                                                           false);
+        db.Add<bool>("log-async",                           UserStringNop("OPTIONS_DB_LOG_ASYNC"),              false,
+                     Validator<bool>(),                                                                         false);
         // Default stringtable filename is deferred to i18n.cpp::InitStringtableFileName
         db.Add<std::string>("resource.stringtable.path",    UserStringNop("OPTIONS_DB_STRINGTABLE_FILENAME"),   "");
+        db.Add<std::string>("resource.parse-cache.path",    UserStringNop("OPTIONS_DB_PARSE_CACHE_DIR"),        PathToString(GetUserDataDir() / "parse_cache"));
         db.Add("save.format.binary.enabled",                UserStringNop("OPTIONS_DB_BINARY_SERIALIZATION"),   false);
         db.Add("save.format.xml.zlib.enabled",              UserStringNop("OPTIONS_DB_XML_ZLIB_SERIALIZATION"), true);
         db.Add("save.auto.hostless.enabled",                UserStringNop("OPTIONS_DB_AUTOSAVE_HOSTLESS"),      true);
         db.Add("save.auto.hostless.each-player.enabled",    UserStringNop("OPTIONS_DB_AUTOSAVE_HOSTLESS_EACH_PLAYER"), false);
         db.Add<int>("save.auto.interval",                   UserStringNop("OPTIONS_DB_AUTOSAVE_INTERVAL"),      0);
+        db.Add("save.auto.background.enabled",              UserStringNop("OPTIONS_DB_AUTOSAVE_BACKGROUND"),    false);
+        db.Add("save.auto.incremental.enabled",             UserStringNop("OPTIONS_DB_AUTOSAVE_INCREMENTAL"),   false);
+        db.Add("save.auto.incremental.base.interval",       UserStringNop("OPTIONS_DB_AUTOSAVE_INCREMENTAL_BASE_INTERVAL"),
+               10, RangedValidator<int>(1, 1000));
         db.Add<std::string>("load",                         UserStringNop("OPTIONS_DB_LOAD"),                   "",                     Validator<std::string>(), false);
         db.Add("save.auto.exit.enabled",                    UserStringNop("OPTIONS_DB_AUTOSAVE_GAME_CLOSE"),    true);
         db.AddFlag('q', "quickstart",                       UserStringNop("OPTIONS_DB_QUICKSTART"),             false);
+        db.AddFlag("parse-profile",                         UserStringNop("OPTIONS_DB_PARSE_PROFILE"),          false);
+        db.Add<std::string>("startup-trace.path",           UserStringNop("OPTIONS_DB_STARTUP_TRACE_PATH"),     "",                     Validator<std::string>(), false);
+        db.Add<std::string>("startup-trace.game-start.path",UserStringNop("OPTIONS_DB_STARTUP_TRACE_GAME_START_PATH"), "",                 Validator<std::string>(), false);
 
         // Common galaxy settings
         db.Add("setup.seed",                UserStringNop("OPTIONS_DB_GAMESETUP_SEED"),                         std::string("0"),                       Validator<std::string>());
@@ -59,6 +69,8 @@ namespace {
                             Validator<std::string>(), false);
         db.Add<std::string>("ai-config", UserStringNop("OPTIONS_DB_AI_CONFIG"), "",
                             Validator<std::string>(), false);
+        db.Add<double>("ai.turn.budget", UserStringNop("OPTIONS_DB_AI_TURN_BUDGET"), 0.0,
+                       RangedValidator<double>(0.0, 3600.0));
     }
     bool temp_bool = RegisterOptions(&AddOptions);
 
@@ -0,0 +1,32 @@
+#ifndef _ObjectDeltaBase_h_
+#define _ObjectDeltaBase_h_
+
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+
+//! Record of the objects in the last turn update sent to or received from the
+//! other end of a connection, against which the next turn update can be
+//! encoded as just the objects that have changed.
+//!
+//! The sender only needs to know which objects have changed, so it keeps a
+//! hash of each object's serialized data. The receiver needs to restore the
+//! objects that haven't changed, so it keeps the serialized data itself.
+struct ObjectDeltaBase {
+    //! Turn of the update that is recorded, or -1 if none is.
+    int                         turn = -1;
+
+    //! Sender only: whether the receiver is known to have applied the recorded
+    //! update, so that the next update can be encoded against it.
+    bool                        acknowledged = false;
+
+    std::map<int, std::size_t>  object_hashes;  ///< sender only: indexed by object id
+    std::map<int, std::string>  object_data;    ///< receiver only: indexed by object id
+
+    void Clear() { *this = ObjectDeltaBase{}; }
+};
+
+
+#endif
@@ -6,10 +6,17 @@
 #include "OptionValidators.h"
 #include "XMLDoc.h"
 
+#include <algorithm>
+#include <future>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/erase.hpp>
@@ -42,6 +49,160 @@ namespace {
             erase_last(str, "\"");
         }
     }
+
+    constexpr std::string_view CONFIG_TEXT_HEADER =
+        "# FreeOrion options, one name=value per line, with \\\\, \\n and \\r escaped\n";
+
+    /** Returns \a value with backslashes and line breaks escaped, so that it
+        fits on one line of a config file. */
+    std::string EscapeConfigValue(const std::string& value) {
+        std::string retval;
+        retval.reserve(value.size());
+        for (const char c : value) {
+            switch (c) {
+            case '\\': retval += "\\\\"; break;
+            case '\n': retval += "\\n";  break;
+            case '\r': retval += "\\r";  break;
+            default:   retval += c;      break;
+            }
+        }
+        return retval;
+    }
+
+    std::string UnescapeConfigValue(std::string_view value) {
+        std::string retval;
+        retval.reserve(value.size());
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            if (value[i] != '\\' || i + 1 == value.size()) {
+                retval += value[i];
+                continue;
+            }
+            switch (value[++i]) {
+            case 'n': retval += '\n';      break;
+            case 'r': retval += '\r';      break;
+            default:  retval += value[i];  break;
+            }
+        }
+        return retval;
+    }
+
+    /** Returns the option names and values in \a text, a config file in the
+        format written by OptionsDB::GetText, in the order they are given. */
+    std::vector<std::pair<std::string, std::string>> ParseConfigText(std::string_view text) {
+        std::vector<std::pair<std::string, std::string>> retval;
+        while (!text.empty()) {
+            const auto line_end = text.find('\n');
+            auto line = text.substr(0, line_end);
+            text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty() || line.front() == '#')
+                continue;
+
+            const auto equals = line.find('=');
+            if (equals == 0 || equals == std::string_view::npos) {
+                ErrorLogger() << "Ignoring malformed config file line: " << line;
+                continue;
+            }
+            retval.emplace_back(line.substr(0, equals), UnescapeConfigValue(line.substr(equals + 1)));
+        }
+        return retval;
+    }
+
+    /** Returns whether \a contents of a config file are xml rather than the
+        format written by OptionsDB::GetText. */
+    bool IsXMLConfig(std::string_view contents) {
+        const auto first = contents.find_first_not_of(" \t\r\n");
+        return first != std::string_view::npos && contents[first] == '<';
+    }
+
+    /** Writes the contents of config files, replacing any earlier file, on a
+        background thread.  While files are being written, later contents for
+        a file replace each other, so that only the latest is written once the
+        write in progress is done. */
+    class ConfigFileWriter {
+    public:
+        ~ConfigFileWriter()
+        { Wait(); }
+
+        void Write(const boost::filesystem::path& path, std::string contents) {
+            std::scoped_lock lock(m_mutex);
+            m_pending[path] = std::move(contents);
+            if (!m_writing) {
+                m_writing = true;
+                m_writer = std::async(std::launch::async, [this]() { WritePending(); });
+            }
+        }
+
+        /** Waits for pending writes to finish and returns whether the last of
+            them succeeded. */
+        bool Wait() {
+            std::future<void> writer;
+            {
+                std::scoped_lock lock(m_mutex);
+                writer = std::move(m_writer);
+            }
+            if (writer.valid())
+                writer.wait();
+            std::scoped_lock lock(m_mutex);
+            return m_last_write_succeeded;
+        }
+
+    private:
+        void WritePending() {
+            while (true) {
+                std::map<boost::filesystem::path, std::string> pending;
+                {
+                    std::scoped_lock lock(m_mutex);
+                    if (m_pending.empty()) {
+                        m_writing = false;
+                        return;
+                    }
+                    pending.swap(m_pending);
+                }
+
+                for (const auto& [path, contents] : pending) {
+                    const bool succeeded = WriteFile(path, contents);
+                    std::scoped_lock lock(m_mutex);
+                    m_last_write_succeeded = succeeded;
+                }
+            }
+        }
+
+        /** Writes \a contents to a temporary file that then replaces
+            \a path, so that the file at \a path is never partly written. */
+        static bool WriteFile(const boost::filesystem::path& path, const std::string& contents) {
+            auto temp_path = path;
+            temp_path += ".tmp";
+            try {
+                {
+                    boost::filesystem::ofstream ofs(temp_path, std::ios::binary);
+                    if (!ofs || !ofs.write(contents.data(), contents.size())) {
+                        ErrorLogger() << "Unable to write config file " << PathToString(path);
+                        return false;
+                    }
+                }
+                boost::filesystem::rename(temp_path, path);
+                return true;
+            } catch (const boost::filesystem::filesystem_error& ec) {
+                ErrorLogger() << "Error during file operations when writing config file "
+                              << PathToString(path) << " : " << ec.what();
+            }
+            return false;
+        }
+
+        std::mutex                                      m_mutex;
+        std::map<boost::filesystem::path, std::string>  m_pending;  ///< contents to be written, by path
+        std::future<void>                               m_writer;
+        bool                                            m_writing = false;
+        bool                                            m_last_write_succeeded = true;
+    };
+
+    ConfigFileWriter& GetConfigFileWriter() {
+        static ConfigFileWriter writer;
+        return writer;
+    }
 }
 
 /////////////////////////////////////////////
@@ -175,34 +336,34 @@ OptionsDB::OptionsDB() : m_dirty(false) {
 bool OptionsDB::Commit(bool only_if_dirty, bool only_non_default) {
     if (only_if_dirty && !m_dirty)
         return true;
-    boost::filesystem::ofstream ofs(GetConfigPath());
-    if (ofs) {
-        XMLDoc doc;
-        GetOptionsDB().GetXML(doc, only_non_default, true);
-        doc.WriteDoc(ofs);
-        m_dirty = false;
+    GetConfigFileWriter().Write(GetConfigPath(), GetText(only_non_default, true));
+    m_dirty = false;
+    return true;
+}
+
+bool OptionsDB::WaitForCommits() {
+    if (GetConfigFileWriter().Wait())
         return true;
-    } else {
-        std::cerr << UserString("UNABLE_TO_WRITE_CONFIG_XML") << std::endl;
-        std::cerr << PathToString(GetConfigPath()) << std::endl;
-        ErrorLogger() << UserString("UNABLE_TO_WRITE_CONFIG_XML");
-        ErrorLogger() << PathToString(GetConfigPath());
-        return false;
-    }
+    std::cerr << UserString("UNABLE_TO_WRITE_CONFIG_XML") << std::endl;
+    std::cerr << PathToString(GetConfigPath()) << std::endl;
+    ErrorLogger() << UserString("UNABLE_TO_WRITE_CONFIG_XML");
+    ErrorLogger() << PathToString(GetConfigPath());
+    return false;
 }
 
 bool OptionsDB::CommitPersistent() {
     bool retval = false;
     auto config_file = GetPersistentConfigPath();
-    XMLDoc doc;
-    GetOptionsDB().GetXML(doc, true, false);   // only output non-default options
+    const auto text = GetText(true, false);   // only output non-default options
     try {
-        // Remove any previously existing file
+        // Remove any previously existing file, including one from an earlier
+        // version, which would otherwise be read along with the new one
         boost::filesystem::remove(config_file);
+        boost::filesystem::remove(GetLegacyPersistentConfigPath());
 
-        boost::filesystem::ofstream ofs(GetPersistentConfigPath());
+        boost::filesystem::ofstream ofs(GetPersistentConfigPath(), std::ios::binary);
         if (ofs) {
-            doc.WriteDoc(ofs);
+            ofs << text;
             retval = true;
         } else {
             std::string err_msg = UserString("UNABLE_TO_WRITE_PERSISTENT_CONFIG_XML") + " : " + config_file.string();
@@ -527,51 +688,63 @@ void OptionsDB::GetUsage(std::ostream& os, const std::string& command_line, bool
     OverrideAllLoggersThresholds(boost::none);
 }
 
+bool OptionsDB::IsStored(std::map<std::string, Option>::const_iterator it,
+                         bool non_default_only, bool include_version) const
+{
+    const auto& [option_name, option] = *it;
+    if (!option.storable)
+        return false;
+
+    if (!option.recognized)
+        return false;
+
+    // "version.gl.check.done" is automatically set to true after other logic is performed
+    if (option_name == "version.gl.check.done")
+        return false;
+
+    // Skip unwanted config options
+    // BUG Some windows may be shown as a child of an other window, but not initially visible.
+    //   The OptionDB default of "*.visible" in these cases may be false, but setting the option to false
+    //   in a config file may prevent such windows from showing when requested.
+    std::string::size_type last_dot = option_name.find_last_of('.');
+    if (option_name.compare(last_dot == std::string::npos ? 0 : last_dot + 1, std::string::npos, "visible") == 0)
+        return false;
+
+    // Storing "version.string" in persistent config would render all config options invalid after a new build
+    if (!include_version && option_name == "version.string")
+        return false;
+
+    // do want to store version string if requested, regardless of whether
+    // it is default. for other strings, if storing non-default only,
+    // check if option is default and if it is, skip it.
+    if (non_default_only && option_name != "version.string") {
+        bool is_default_nonflag = !option.flag && IsDefaultValue(it);
+        if (is_default_nonflag)
+            return false;
+
+        // Default value of flag options will throw bad_any_cast, fortunately they always default to false
+        if (option.flag && !boost::any_cast<bool>(option.value))
+            return false;
+    }
+
+    return true;
+}
+
 void OptionsDB::GetXML(XMLDoc& doc, bool non_default_only, bool include_version) const {
     doc = XMLDoc();
 
     std::vector<XMLElement*> elem_stack;
     elem_stack.emplace_back(&doc.root_node);
 
-    for (const auto& option : m_options) {
-        if (!option.second.storable)
-            continue;
-
-        if (!option.second.recognized)
+    for (auto it = m_options.begin(); it != m_options.end(); ++it) {
+        const auto& option = *it;
+        if (!IsStored(it, non_default_only, include_version))
             continue;
 
         std::string::size_type last_dot = option.first.find_last_of('.');
         std::string section_name = last_dot == std::string::npos ? "" : option.first.substr(0, last_dot);
         std::string name = option.first.substr(last_dot == std::string::npos ? 0 : last_dot + 1);
 
-        // "version.gl.check.done" is automatically set to true after other logic is performed
-        if (option.first == "version.gl.check.done")
-            continue;
-
-        // Skip unwanted config options
-        // BUG Some windows may be shown as a child of an other window, but not initially visible.
-        //   The OptionDB default of "*.visible" in these cases may be false, but setting the option to false
-        //   in a config file may prevent such windows from showing when requested.
-        if (name == "visible")
-            continue;
-
-        // Storing "version.string" in persistent config would render all config options invalid after a new build
-        if (!include_version && option.first == "version.string")
-            continue;
-
-        // do want to store version string if requested, regardless of whether
-        // it is default. for other strings, if storing non-default only,
-        // check if option is default and if it is, skip it.
-        if (non_default_only && option.first != "version.string") {
-            bool is_default_nonflag = !option.second.flag && IsDefaultValue(m_options.find(option.first));
-            if (is_default_nonflag)
-                continue;
-
-            // Default value of flag options will throw bad_any_cast, fortunately they always default to false
-            if (option.second.flag && !boost::any_cast<bool>(option.second.value))
-                continue;
-        }
-
 
         while (1 < elem_stack.size()) {
             std::string prev_section = PreviousSectionName(elem_stack);
@@ -610,6 +783,23 @@ void OptionsDB::GetXML(XMLDoc& doc, bool non_default_only, bool include_version)
     }
 }
 
+std::string OptionsDB::GetText(bool non_default_only, bool include_version) const {
+    std::string retval{CONFIG_TEXT_HEADER};
+    for (auto it = m_options.begin(); it != m_options.end(); ++it) {
+        const auto& [name, option] = *it;
+        if (!IsStored(it, non_default_only, include_version))
+            continue;
+
+        if (option.validator) {
+            retval.append(name).append(1, '=').append(EscapeConfigValue(option.ValueToString())).append(1, '\n');
+        } else if (option.flag) {
+            if (boost::any_cast<bool>(option.value))
+                retval.append(name).append("=1\n");
+        }
+    }
+    return retval;
+}
+
 OptionsDB::OptionChangedSignalType& OptionsDB::OptionChangedSignal(const std::string& option) {
     auto it = m_options.find(option);
     if (it == m_options.end())
@@ -758,27 +948,59 @@ void OptionsDB::SetFromCommandLine(const std::vector<std::string>& args) {
 void OptionsDB::SetFromFile(const boost::filesystem::path& file_path,
                             const std::string& version)
 {
-    XMLDoc doc;
     try {
-        boost::filesystem::ifstream ifs(file_path);
-        if (ifs) {
-            doc.ReadDoc(ifs);
+        boost::filesystem::ifstream ifs(file_path, std::ios::binary);
+        if (!ifs)
+            return;
+        const std::string contents{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+        if (IsXMLConfig(contents)) {
+            XMLDoc doc;
+            doc.ReadDoc(contents);
             if (version.empty() || (doc.root_node.ContainsChild("version") &&
                                     doc.root_node.Child("version").ContainsChild("string") &&
                                     version == doc.root_node.Child("version").Child("string").Text()))
             { GetOptionsDB().SetFromXML(doc); }
+            return;
+        }
+
+        if (!version.empty()) {
+            const auto values = ParseConfigText(contents);
+            const auto version_it = std::find_if(values.begin(), values.end(),
+                                                 [](const auto& value) { return value.first == "version.string"; });
+            if (version_it == values.end() || version_it->second != version)
+                return;
         }
+        GetOptionsDB().SetFromText(contents);
+
     } catch (...) {
         std::cerr << UserString("UNABLE_TO_READ_CONFIG_XML")  << ": "
                   << file_path << std::endl;
     }
 }
 
+void OptionsDB::SetFromConfigFiles(const std::string& version) {
+    boost::system::error_code ec;
+    const auto config_path = GetConfigPath();
+    SetFromFile(boost::filesystem::exists(config_path, ec) ? config_path : GetLegacyConfigPath(), version);
+    SetFromFile(GetLegacyPersistentConfigPath());
+    SetFromFile(GetPersistentConfigPath());
+}
+
 void OptionsDB::SetFromXML(const XMLDoc& doc) {
     for (const XMLElement& child : doc.root_node.children)
     { SetFromXMLRecursive(child, ""); }
 }
 
+void OptionsDB::SetFromText(const std::string& text) {
+    for (const auto& [option_name, value] : ParseConfigText(text)) {
+        if (option_name == "version.string")
+            continue;
+        std::string::size_type last_dot = option_name.find_last_of('.');
+        SetFromStoredText(option_name, last_dot == std::string::npos ? "" : option_name.substr(0, last_dot), value);
+    }
+}
+
 void OptionsDB::SetFromXMLRecursive(const XMLElement& elem, const std::string& section_name) {
     std::string option_name = section_name + (section_name.empty() ? "" : ".") + elem.Tag();
     if (option_name == "version.string")
@@ -789,21 +1011,27 @@ void OptionsDB::SetFromXMLRecursive(const XMLElement& elem, const std::string& s
             SetFromXMLRecursive(child, option_name);
     }
 
+    SetFromStoredText(option_name, section_name, elem.Text());
+}
+
+void OptionsDB::SetFromStoredText(const std::string& option_name, const std::string& section_name,
+                                  const std::string& text)
+{
     auto it = m_options.find(option_name);
 
     if (it == m_options.end() || !it->second.recognized) {
-        if (elem.Text().length() == 0) {
-            // do not retain empty XML options
+        if (text.length() == 0) {
+            // do not retain empty options
             return;
         } else {
             // Store unrecognized option to be parsed later if this options is added.
             m_options[option_name] = Option(static_cast<char>(0), option_name,
-                                            elem.Text(), elem.Text(),
+                                            text, text,
                                             "", new Validator<std::string>(),
                                             true, false, false, section_name);
         }
 
-        TraceLogger() << "Option \"" << option_name << "\", was in config.xml but was not recognized.  It may not be registered yet or you may need to delete your config.xml if it is out of date.";
+        TraceLogger() << "Option \"" << option_name << "\", was in a config file but was not recognized.  It may not be registered yet or you may need to delete your config file if it is out of date.";
         m_dirty = true;
         return;
     }
@@ -816,13 +1044,13 @@ void OptionsDB::SetFromXMLRecursive(const XMLElement& elem, const std::string& s
 
     if (option.flag) {
         static auto lexical_true_str = boost::lexical_cast<std::string>(true);
-        option.value = static_cast<bool>(elem.Text() == lexical_true_str);
+        option.value = static_cast<bool>(text == lexical_true_str);
     } else {
         try {
-            m_dirty |= option.SetFromString(elem.Text());
+            m_dirty |= option.SetFromString(text);
         } catch (const std::exception& e) {
-            ErrorLogger() << "OptionsDB::SetFromXMLRecursive() : while processing config.xml the following exception was caught when attempting to set option \""
-                          << option_name << "\" to \"" << elem.Text() << "\": " << e.what();
+            ErrorLogger() << "OptionsDB::SetFromStoredText() : while processing a config file the following exception was caught when attempting to set option \""
+                          << option_name << "\" to \"" << text << "\": " << e.what();
         }
     }
 }
@@ -116,9 +116,18 @@ public:
     bool OptionExists(const std::string& name) const
     { return m_options.count(name) && m_options.at(name).recognized; }
 
-    /** write the optionDB's non-default state to the XML config file. */
+    /** write the optionDB's non-default state to the config file.  The file
+      * is written on a background thread, and commits made while it is being
+      * written are coalesced into one write of the latest state, so this is
+      * cheap to call after every change. */
     bool Commit(bool only_if_dirty = true, bool only_non_default = true);
 
+    /** Waits for config file writes started by Commit() to finish.
+     *
+     *  @returns bool If the last of them successfully wrote its file
+     */
+    bool WaitForCommits();
+
     /** Write any options that are not at default value to persistent config, replacing any existing file
      *
      *  @returns bool If file was successfully written
@@ -203,6 +212,12 @@ public:
      */
     void GetXML(XMLDoc& doc, bool non_default_only = false, bool include_version = true) const;
 
+    /** @brief  Returns the contents of the options DB in the config file
+     *          format, one "name=value" line per option.
+     *
+     * Takes the same parameters as GetXML() and stores the same options. */
+    std::string GetText(bool non_default_only = false, bool include_version = true) const;
+
     /** find all registered Options that begin with \a prefix and store them in
       * \a ret. If \p allow_unrecognized then include unrecognized options. */
     void FindOptions(std::set<std::string>& ret, const std::string& prefix, bool allow_unrecognized = false) const;
@@ -347,12 +362,20 @@ public:
         it->second.default_value = value;
     }
 
-    /** if an xml file exists at \a file_path and has the same version tag as \a version, fill the
-      * DB options contained in that file (read the file using XMLDoc, then fill the DB using SetFromXML)
-      * if the \a version string is empty, bypass that check */
+    /** if a config file exists at \a file_path and has the same version tag as \a version, fill the
+      * DB options contained in that file.  The file may be in the config file format written by
+      * Commit() (filling the DB using SetFromText) or an xml file (read using XMLDoc, then filling
+      * the DB using SetFromXML).  if the \a version string is empty, bypass that check */
     void SetFromFile(const boost::filesystem::path& file_path,
                      const std::string& version = "");
 
+    /** fills the DB from the config file and then the persistent config file,
+      * as SetFromFile() does, checking the config file against \a version.
+      * Reads the xml config files of earlier versions instead if there is no
+      * config file, and also reads the xml persistent config file if there is
+      * one, before the persistent config file so that it takes priority. */
+    void SetFromConfigFiles(const std::string& version);
+
     /** fills some or all of the options of the DB from values passed in from
       * the command line */
     void SetFromCommandLine(const std::vector<std::string>& args);
@@ -361,6 +384,10 @@ public:
       * XMLDoc \a doc */
     void SetFromXML(const XMLDoc& doc);
 
+    /** fills some or all of the options of the DB from values stored in
+      * \a text, in the format returned by GetText() */
+    void SetFromText(const std::string& text);
+
     struct FO_COMMON_API Option {
         Option();
         Option(char short_name_, const std::string& name_, const boost::any& value_,
@@ -433,6 +460,17 @@ private:
 
     void SetFromXMLRecursive(const XMLElement& elem, const std::string& section_name);
 
+    /** Sets the option \a option_name in section \a section_name to the
+      * value stored for it in a config file, \a text, or if it isn't
+      * registered yet, keeps \a text to be parsed when it is. */
+    void SetFromStoredText(const std::string& option_name, const std::string& section_name,
+                           const std::string& text);
+
+    /** Returns whether the option referenced by \a it is stored in config
+      * files written with the given GetXML() or GetText() parameters. */
+    bool IsStored(std::map<std::string, Option>::const_iterator it,
+                  bool non_default_only, bool include_version) const;
+
     /** Determine known option sections and which options each contains
      *  A special "root" section is added for determined top-level sections */
     std::unordered_map<std::string, std::set<std::string>> OptionsBySection(bool allow_unrecognized = false) const;
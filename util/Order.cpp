@@ -360,23 +360,50 @@ bool FleetMoveOrder::Check(int empire_id, int fleet_id, int dest_system_id, bool
     return true;
 }
 
+std::list<int> FleetMoveOrder::NewRoute(const Fleet& fleet) const {
+    std::list<int> route_list;
+
+    if (m_append && !fleet.TravelRoute().empty()) {
+        route_list = fleet.TravelRoute();       // copy existing route
+        route_list.erase(--route_list.end());   // remove last item as it should be the first in the appended route
+    }
+
+    std::copy(m_route.begin(), m_route.end(), std::back_inserter(route_list));
+
+    if (!route_list.empty() && route_list.front() == fleet.SystemID())
+        route_list.pop_front();
+
+    return route_list;
+}
+
+void FleetMoveOrder::CheckRange(const ScriptingContext& context) const {
+    m_range_check.reset();
+
+    auto fleet = context.ContextObjects().get<Fleet>(FleetID());
+    if (!fleet || !fleet->OwnedBy(EmpireID()))
+        return; // reported when executing
+
+    auto route_list = NewRoute(*fleet);
+    auto eta = fleet->ETA(fleet->MovePath(route_list, false, context));
+    m_range_check = RangeCheck{fleet->ShipIDs(), std::move(route_list),
+                               eta.first != Fleet::ETA_NEVER && eta.first != Fleet::ETA_OUT_OF_RANGE};
+}
+
 void FleetMoveOrder::ExecuteImpl() const { // TODO: pass in ScriptingContext?
     GetValidatedEmpire();
 
+    auto range_check = std::move(m_range_check);
+    m_range_check.reset();
+
     if (!Check(EmpireID(), m_fleet, m_dest_system))
         return;
 
-    // convert list of ids to list of System
-    std::list<int> route_list;
-
     auto fleet = Objects().get<Fleet>(FleetID());
 
     if (m_append && !fleet->TravelRoute().empty()) {
-        route_list = fleet->TravelRoute();      // copy existing route
-
         DebugLogger() << "FleetMoveOrder::ExecuteImpl appending initial" << [&]() {
             std::stringstream ss;
-            for (int waypoint : route_list)
+            for (int waypoint : fleet->TravelRoute())
                 ss << " " << waypoint;
             return ss.str();
         }() << "  with" << [&]() {
@@ -385,11 +412,10 @@ void FleetMoveOrder::ExecuteImpl() const { // TODO: pass in ScriptingContext?
                 ss << " " << waypoint;
             return ss.str();
         }();
-
-        route_list.erase(--route_list.end());   // remove last item as it should be the first in the appended route
     }
 
-    std::copy(m_route.begin(), m_route.end(), std::back_inserter(route_list));
+    // convert list of ids to list of System
+    std::list<int> route_list = NewRoute(*fleet);
     DebugLogger() << [fleet, route_list]() {
         std::stringstream ss;
         ss << "FleetMoveOrder::ExecuteImpl Setting route of fleet " << fleet->ID() << " at system " << fleet->SystemID() << " to: ";
@@ -400,15 +426,17 @@ void FleetMoveOrder::ExecuteImpl() const { // TODO: pass in ScriptingContext?
         return ss.str();
     }();
 
-    if (route_list.front() == fleet->SystemID()) {
-        DebugLogger() << "FleetMoveOrder::ExecuteImpl given route that starts with fleet " << fleet->ID() << "'s current system (" << route_list.front() << "); removing it";
-        route_list.pop_front();
+    // check destination validity: disallow movement that's out of range.
+    // earlier orders may have changed the fleet since the range was checked
+    bool in_range = false;
+    if (range_check && range_check->route == route_list && range_check->ship_ids == fleet->ShipIDs()) {
+        in_range = range_check->in_range;
+    } else {
+        ScriptingContext context;
+        auto eta = fleet->ETA(fleet->MovePath(route_list, false, context));
+        in_range = eta.first != Fleet::ETA_NEVER && eta.first != Fleet::ETA_OUT_OF_RANGE;
     }
-
-    // check destination validity: disallow movement that's out of range
-    ScriptingContext context;
-    auto eta = fleet->ETA(fleet->MovePath(route_list, false, context));
-    if (eta.first == Fleet::ETA_NEVER || eta.first == Fleet::ETA_OUT_OF_RANGE) {
+    if (!in_range) {
         DebugLogger() << "FleetMoveOrder::ExecuteImpl rejected out of range move order";
         return;
     }
@@ -1,6 +1,9 @@
 #ifndef _Order_h_
 #define _Order_h_
 
+#include <list>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 #include <boost/serialization/access.hpp>
@@ -12,7 +15,9 @@
 #include "../universe/EnumsFwd.h"
 
 
+class Fleet;
 class ShipDesign;
+struct ScriptingContext;
 
 /////////////////////////////////////////////////////
 // Order
@@ -79,6 +84,7 @@ private:
     /** Indicates that Execute() has occured, and so an undo is legal. */
     mutable bool m_executed = false;
 
+    friend class OrderSet; // for its compact encoding of some orders
     friend class boost::serialization::access;
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -210,9 +216,26 @@ public:
     { return m_route; }
 
     static bool Check(int empire_id, int fleet_id, int dest_fleet_id, bool append = false);
+
+    /** Checks whether the route this order would set is in range of the fleet
+      * as it is now, which is the costly part of executing it.  May be called
+      * for many orders concurrently before executing them, as long as nothing
+      * changes the universe meanwhile.  Execution uses the result if the
+      * fleet's ships and the route are still the same then. */
+    void CheckRange(const ScriptingContext& context) const;
+
 private:
     FleetMoveOrder() = default;
 
+    /** Returns the route this order sets for \a fleet. */
+    std::list<int> NewRoute(const Fleet& fleet) const;
+
+    struct RangeCheck {
+        ObjectIDSet     ship_ids;
+        std::list<int>  route;
+        bool            in_range = false;
+    };
+
     /**
      * Preconditions of execute:
      *    - m_fleet is a valid id of a fleet owned by the order-giving empire
@@ -230,7 +253,9 @@ private:
     int m_dest_system = INVALID_OBJECT_ID;
     std::vector<int> m_route;
     bool m_append = false;
+    mutable std::optional<RangeCheck> m_range_check;   ///< result of CheckRange, not serialized
 
+    friend class OrderSet;
     friend class boost::serialization::access;
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int version);
@@ -736,6 +761,7 @@ private:
     int m_object_id = INVALID_OBJECT_ID;
     FleetAggression m_aggression;
 
+    friend class OrderSet;
     friend class boost::serialization::access;
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int version);
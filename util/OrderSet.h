@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 
 class Order;
 
@@ -78,6 +79,16 @@ public:
     std::pair<OrderSet, std::set<int>> ExtractChanges(); ///< extract and clear changed orders
 
 private:
+    /** Returns the compact encoding of the orders in \a orders that have one,
+        which AIs issue many of each turn, and copies the rest to
+        \a other_orders.  Used in binary archives instead of serializing each
+        order polymorphically. */
+    static std::string EncodeCompactOrders(const OrderMap& orders, OrderMap& other_orders);
+
+    /** Adds the orders encoded in \a compact_orders by EncodeCompactOrders()
+        to \a orders.  Throws std::runtime_error if the encoding is corrupt. */
+    static void DecodeCompactOrders(const std::string& compact_orders, OrderMap& orders);
+
     OrderMap      m_orders;
     std::set<int> m_last_added_orders; ///< set of ids added/updated orders
     std::set<int> m_last_deleted_orders; ///< set of ids deleted orders
@@ -87,16 +98,5 @@ private:
     void serialize(Archive& ar, const unsigned int version);
 };
 
-// Template Implementations
-template <typename Archive>
-void OrderSet::serialize(Archive& ar, const unsigned int version)
-{
-    ar  & BOOST_SERIALIZATION_NVP(m_orders);
-    if (Archive::is_loading::value) {
-        m_last_added_orders.clear();
-        m_last_deleted_orders.clear();
-    }
-}
-
 
 #endif
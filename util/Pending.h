@@ -3,6 +3,7 @@
 
 #include "Export.h"
 #include "Logger.h"
+#include "ScopedTimer.h"
 
 #include <boost/filesystem/path.hpp>
 #include <boost/optional/optional.hpp>
@@ -54,8 +55,8 @@ namespace Pending {
                 DebugLogger() << "Waiting for parse of \"" << pending.filename << "\" to complete.";
 
             if (status == std::future_status::deferred) {
-                ErrorLogger() << "Pending parse is unable to handle deferred future.";
-                throw "deferred future not handled";
+                DebugLogger() << "Parsing \"" << pending.filename << "\" on demand.";
+                break;  // get() below parses on this thread
             }
             DebugLogger() << "WaitForPendingUnlocked another wait_for round";
         } while (status != std::future_status::ready);
@@ -124,8 +125,30 @@ namespace Pending {
     auto StartParsing(const Func& parser, const boost::filesystem::path& path)
         -> Pending<decltype(parser(path))>
     {
+        auto timed_parser = [parser, path]() {
+            ScopedTimer timer("StartParsing " + path.filename().string());
+            return parser(path);
+        };
         return Pending<decltype(parser(path))>(
-            std::async(std::launch::async, parser, path), path.filename().string());
+            std::async(std::launch::async, std::move(timed_parser)), path.filename().string());
+    }
+
+    /** Return a Pending<T> constructed with \p parser and \p path, that only
+        parses when its result is first waited for.*/
+    template <typename Func>
+    auto ParseOnDemand(const Func& parser, const boost::filesystem::path& path)
+        -> Pending<decltype(parser(path))>
+    {
+        return Pending<decltype(parser(path))>(
+            std::async(std::launch::deferred, parser, path), path.filename().string());
+    }
+
+    /** Return a Pending<T> that has already completed, with result \p value.*/
+    template <typename T>
+    Pending<T> Completed(T value, const std::string& name) {
+        std::promise<T> promise;
+        promise.set_value(std::move(value));
+        return Pending<T>(promise.get_future(), name);
     }
 }
 
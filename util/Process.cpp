@@ -16,6 +16,7 @@
 #include <locale>
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <psapi.h>
 #endif
 
 class Process::Impl {
@@ -199,6 +200,13 @@ void Process::Impl::Kill() {
     m_process_info.hThread = 0;
 }
 
+std::size_t PeakResidentMemoryKB() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize / 1024;
+}
+
 #elif defined(FREEORION_LINUX) || defined(FREEORION_MACOSX)
 
 #include <sys/types.h>
@@ -275,6 +283,17 @@ void Process::Impl::Kill() {
     DebugLogger() << "Process::Impl::Kill done";
 }
 
+std::size_t PeakResidentMemoryKB() {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(FREEORION_MACOSX)
+    return static_cast<std::size_t>(usage.ru_maxrss) / 1024;   // bytes on macOS
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss);          // kB on Linux
+#endif
+}
+
 #endif
 
 void Process::Impl::Free()
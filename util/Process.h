@@ -72,5 +72,9 @@ private:
     bool                    m_low_priority = false; ///< true if this process is set to low priority
 };
 
+/** Returns the peak resident memory of this process, in kB, or 0 if it can't
+    be determined. */
+FO_COMMON_API std::size_t PeakResidentMemoryKB();
+
 
 #endif
@@ -7,6 +7,7 @@
 #include <boost/random/uniform_smallint.hpp>
 
 #include <mutex>
+#include <type_traits>
 
 using GeneratorType = std::mt19937;
 
@@ -14,61 +15,102 @@ using GeneratorType = std::mt19937;
 namespace {
     GeneratorType gen{2462343}; // the one random number generator driving the distributions below. arbitrarily chosen default seed
     static std::mutex s_prng_mutex;
+
+    thread_local RandomStreamEngine* thread_gen = nullptr; // set by ScopedThreadRandomStream to use instead of gen on this thread
+
+    /** Calls \a fn with the generator to use on this thread, locking the
+      * shared generator if that is the one to use.  \a fn is called with
+      * either a GeneratorType or a RandomStreamEngine. */
+    template <typename Fn>
+    auto WithGenerator(Fn&& fn) {
+        if (thread_gen)
+            return fn(*thread_gen);
+        std::scoped_lock lock(s_prng_mutex);
+        return fn(gen);
+    }
 }
 
 void Seed(unsigned int seed) {
-    std::scoped_lock lock(s_prng_mutex);
-    gen.seed(static_cast<GeneratorType::result_type>(seed));
+    WithGenerator([seed](auto& g)
+                  { g.seed(static_cast<typename std::decay_t<decltype(g)>::result_type>(seed)); });
 }
 
 void ClockSeed() {
-    std::scoped_lock lock(s_prng_mutex);
     boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time().time_of_day();
-    gen.seed(static_cast<GeneratorType::result_type>(diff.total_milliseconds()));
+    WithGenerator([diff](auto& g)
+                  { g.seed(static_cast<typename std::decay_t<decltype(g)>::result_type>(diff.total_milliseconds())); });
 }
 
 int RandInt(int min, int max) {
     if (min >= max)
         return min;
-    {
-        std::scoped_lock lock(s_prng_mutex);
-        static boost::random::uniform_smallint<> dis;
-        return dis(gen, decltype(dis)::param_type{min, max});
-    }
+    return WithGenerator([min, max](auto& g) {
+        boost::random::uniform_smallint<> dis;
+        return dis(g, decltype(dis)::param_type{min, max});
+    });
 }
 
 double RandZeroToOne() {
-    std::scoped_lock lock(s_prng_mutex);
-    static boost::random::uniform_01<> dis;
-    return dis(gen);
+    return WithGenerator([](auto& g) {
+        boost::random::uniform_01<> dis;
+        return dis(g);
+    });
 }
 
 double RandDouble(double min, double max) {
     if (min >= max)
         return min;
-    {
-        std::scoped_lock lock(s_prng_mutex);
-        static boost::random::uniform_real_distribution<> dis;
-        return dis(gen, decltype(dis)::param_type{min, max});
-    }
+    return WithGenerator([min, max](auto& g) {
+        boost::random::uniform_real_distribution<> dis;
+        return dis(g, decltype(dis)::param_type{min, max});
+    });
 }
 
 double RandGaussian(double mean, double sigma) {
     if (sigma <= 0.0)
         return mean;
-    {
-        std::scoped_lock lock(s_prng_mutex);
-        static boost::random::normal_distribution<> dis;
-        return dis(gen, decltype(dis)::param_type{mean, sigma});
-    }
+    return WithGenerator([mean, sigma](auto& g) {
+        boost::random::normal_distribution<> dis;
+        return dis(g, decltype(dis)::param_type{mean, sigma});
+    });
 }
 
-void RandomShuffle(std::vector<bool>& c) {
-    std::scoped_lock lock(s_prng_mutex);
-    std::shuffle(c.begin(), c.end(), gen);
+void RandomShuffle(std::vector<bool>& c)
+{ WithGenerator([&c](auto& g) { std::shuffle(c.begin(), c.end(), g); }); }
+
+void RandomShuffle(std::vector<int>& c)
+{ WithGenerator([&c](auto& g) { std::shuffle(c.begin(), c.end(), g); }); }
+
+std::uint64_t SplitRandomSeed() {
+    return WithGenerator([](auto& g) {
+        const std::uint64_t high = g();
+        return (high << 32) | static_cast<std::uint64_t>(g());
+    });
 }
 
-void RandomShuffle(std::vector<int>& c) {
-    std::scoped_lock lock(s_prng_mutex);
-    std::shuffle(c.begin(), c.end(), gen);
+namespace {
+    /** SplitMix64 finalizer: a bijective mix of all bits of \a x. */
+    constexpr std::uint64_t Mix(std::uint64_t x) noexcept {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
 }
+
+std::uint64_t RandomStreamSeed(std::uint64_t base_seed, int turn, RandomStreamPhase phase,
+                               std::uint64_t id) noexcept
+{
+    std::uint64_t retval = Mix(base_seed);
+    retval = Mix(retval ^ static_cast<std::uint64_t>(static_cast<std::uint32_t>(turn)));
+    retval = Mix(retval ^ static_cast<std::uint64_t>(phase));
+    return Mix(retval ^ id);
+}
+
+ScopedThreadRandomStream::ScopedThreadRandomStream(std::uint64_t seed) :
+    m_gen(seed),
+    m_previous_gen(thread_gen)
+{ thread_gen = &m_gen; }
+
+ScopedThreadRandomStream::~ScopedThreadRandomStream()
+{ thread_gen = m_previous_gen; }
@@ -5,6 +5,8 @@
 #undef int64_t
 #endif
 
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <ctime>
 
@@ -15,6 +17,12 @@
  * A collection of robust and portable random number generation functions that
  * share an underlying random generator and which are guarded with locks for
  * thread safety.
+ *
+ * While a ScopedThreadRandomStream exists, these functions instead use its
+ * generator when called on the thread that created it, without locking.
+ * Tasks run in parallel can each be given such a stream, with a seed from
+ * RandomStreamSeed() that identifies the task, so that the numbers they draw
+ * don't depend on how they are scheduled.
  */
 
 /** seeds the underlying random number generator used to drive all random number distributions */
@@ -41,5 +49,67 @@ FO_COMMON_API double RandGaussian(double mean, double sigma);
 FO_COMMON_API void RandomShuffle(std::vector<bool>& c);
 FO_COMMON_API void RandomShuffle(std::vector<int>& c);
 
+/** The parts of a turn that draw random numbers in independent streams. */
+enum class RandomStreamPhase : std::uint8_t {
+    COMBAT,             ///< a stream for each combat, by system id
+    EFFECTS_TARGETS,    ///< a stream for each dispatched scope evaluation, by dispatch number
+    EFFECTS_EXECUTION   ///< a stream for each effects group execution, by priority and position
+};
+
+/** Returns a seed for a family of random streams, drawn from the generator
+  * the above functions use, so that it is reproducible whenever that generator
+  * was seeded reproducibly (eg. by RULE_RESEED_PRNG_SERVER on the server). */
+FO_COMMON_API std::uint64_t SplitRandomSeed();
+
+/** Returns the seed of the random stream identified by \a turn, \a phase and
+  * \a id within the family of streams seeded by \a base_seed.  Streams of
+  * different keys are independent of each other. */
+FO_COMMON_API std::uint64_t RandomStreamSeed(std::uint64_t base_seed, int turn,
+                                             RandomStreamPhase phase, std::uint64_t id) noexcept;
+
+/** A small and fast random number engine (SplitMix64) for random streams,
+  * which are often made for short tasks, so should be cheap to seed. */
+class RandomStreamEngine {
+public:
+    using result_type = std::uint32_t;
+
+    explicit RandomStreamEngine(std::uint64_t seed = 0) noexcept :
+        m_state(seed)
+    {}
+
+    void seed(std::uint64_t seed) noexcept { m_state = seed; }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() noexcept {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<result_type>((z ^ (z >> 31)) >> 32);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+/** Gives the thread that creates it its own random number generator, seeded
+  * with \a seed, which the above functions use instead of the shared one until
+  * it is destroyed.  This allows independent tasks run in parallel to each
+  * draw a reproducible sequence of random numbers, regardless of how they are
+  * scheduled.  Calling Seed() on the thread reseeds its own generator. */
+class FO_COMMON_API ScopedThreadRandomStream {
+public:
+    explicit ScopedThreadRandomStream(std::uint64_t seed);
+    ~ScopedThreadRandomStream();
+
+    ScopedThreadRandomStream(const ScopedThreadRandomStream&) = delete;
+    ScopedThreadRandomStream& operator=(const ScopedThreadRandomStream&) = delete;
+
+private:
+    RandomStreamEngine  m_gen;
+    RandomStreamEngine* m_previous_gen = nullptr;
+};
+
 
 #endif
@@ -7,6 +7,7 @@
 #include "Serialize.h"
 #include "Serialize.ipp"
 #include "ScopedTimer.h"
+#include "Version.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -20,7 +21,9 @@
 #include <boost/iostreams/stream.hpp>
 
 
+#include <cstdint>
 #include <fstream>
+#include <unordered_map>
 
 namespace fs = boost::filesystem;
 
@@ -102,6 +105,80 @@ namespace {
             return false;
         }
     }
+
+    /** Name of the file, in each directory of saves, that caches the previews
+      * of those saves. Its extension is not that of any save file. */
+    const std::string PREVIEW_INDEX_FILENAME("previews.index");
+
+    /** Cached previews of the saves in one directory, each with the last
+      * write time and size of its file when the preview was loaded, so that
+      * unchanged saves need not be opened to list their previews. */
+    struct PreviewIndex {
+        std::vector<FullPreview>    previews;
+        std::vector<std::int64_t>   write_times;
+        std::vector<std::uint64_t>  file_sizes;
+    };
+
+    /** Returns the index of previews in directory \a dir, or an empty index
+      * if there is none or it was written by another version of FreeOrion. */
+    PreviewIndex LoadPreviewIndex(const fs::path& dir) {
+        PreviewIndex index;
+        const fs::path path = dir / PREVIEW_INDEX_FILENAME;
+        try {
+            if (!fs::exists(path))
+                return index;
+            fs::ifstream ifs(path, std::ios_base::binary);
+            if (!ifs)
+                return index;
+
+            freeorion_bin_iarchive ia(ifs);
+            std::string freeorion_version;
+            ia >> BOOST_SERIALIZATION_NVP(freeorion_version);
+            if (freeorion_version != FreeOrionVersionString()) {
+                DebugLogger() << "LoadPreviewIndex: Ignoring index from another version of FreeOrion: " << path.string();
+                return index;
+            }
+            ia >> boost::serialization::make_nvp("previews", index.previews)
+               >> boost::serialization::make_nvp("write_times", index.write_times)
+               >> boost::serialization::make_nvp("file_sizes", index.file_sizes);
+        } catch (const std::exception& e) {
+            ErrorLogger() << "LoadPreviewIndex: Failed to read " << path.string() << " because: " << e.what();
+            return PreviewIndex{};
+        }
+
+        if (index.write_times.size() != index.previews.size() || index.file_sizes.size() != index.previews.size()) {
+            ErrorLogger() << "LoadPreviewIndex: Ignoring inconsistent index " << path.string();
+            return PreviewIndex{};
+        }
+        return index;
+    }
+
+    /** Writes \a index to directory \a dir. Failure to write it, such as in
+      * a read-only directory, only means that previews are reloaded next time. */
+    void WritePreviewIndex(const fs::path& dir, const PreviewIndex& index) {
+        const fs::path path = dir / PREVIEW_INDEX_FILENAME;
+        fs::path temp_path = path;
+        temp_path += ".tmp";
+        try {
+            {
+                fs::ofstream ofs(temp_path, std::ios_base::binary);
+                if (!ofs) {
+                    DebugLogger() << "WritePreviewIndex: Unable to open " << temp_path.string();
+                    return;
+                }
+                freeorion_bin_oarchive oa(ofs);
+                const std::string& freeorion_version = FreeOrionVersionString();
+                oa << BOOST_SERIALIZATION_NVP(freeorion_version)
+                   << boost::serialization::make_nvp("previews", index.previews)
+                   << boost::serialization::make_nvp("write_times", index.write_times)
+                   << boost::serialization::make_nvp("file_sizes", index.file_sizes);
+            }
+            // replace the old index only once the new one is complete
+            fs::rename(temp_path, path);
+        } catch (const std::exception& e) {
+            ErrorLogger() << "WritePreviewIndex: Failed to write " << path.string() << " because: " << e.what();
+        }
+    }
 }
 
 SaveGamePreviewData::SaveGamePreviewData() :
@@ -238,17 +315,47 @@ void LoadSaveGamePreviews(const fs::path& orig_path, const std::string& extensio
         return;
     }
 
+    ScopedTimer timer("LoadSaveGamePreviews: " + path.string(), true);
+
+    // previews of saves that have not changed since they were indexed are
+    // taken from the index, instead of being read from the save files
+    const PreviewIndex old_index = LoadPreviewIndex(path);
+    std::unordered_map<std::string, std::size_t> old_index_positions;
+    for (std::size_t idx = 0; idx < old_index.previews.size(); ++idx)
+        old_index_positions.emplace(old_index.previews[idx].filename, idx);
+
+    PreviewIndex new_index;
+    bool index_changed = false;
+
     for (fs::directory_iterator it(path); it != end_it; ++it) {
         try {
             if ((it->path().filename().extension() == extension) && !fs::is_directory(it->path())) {
-                FullPreview data;
-                if (LoadSaveGamePreviewData(*it, data)) {
-                    // Add preview entry to list
-                    previews.emplace_back(std::move(data));
+                const std::int64_t write_time = fs::last_write_time(it->path());
+                const std::uint64_t file_size = fs::file_size(it->path());
+
+                auto old_it = old_index_positions.find(PathToString(it->path().filename()));
+                if (old_it != old_index_positions.end() &&
+                    old_index.write_times[old_it->second] == write_time &&
+                    old_index.file_sizes[old_it->second] == file_size)
+                {
+                    new_index.previews.push_back(old_index.previews[old_it->second]);
+                } else {
+                    FullPreview data;
+                    if (!LoadSaveGamePreviewData(*it, data))
+                        continue;
+                    new_index.previews.push_back(std::move(data));
+                    index_changed = true;
                 }
+                new_index.write_times.push_back(write_time);
+                new_index.file_sizes.push_back(file_size);
             }
         } catch (const std::exception& e) {
             ErrorLogger() << "LoadSaveGamePreviews: Failed loading preview from " << it->path() << " because: " << e.what();
         }
     }
+
+    if (index_changed || new_index.previews.size() != old_index.previews.size())
+        WritePreviewIndex(path, new_index);
+
+    previews.insert(previews.end(), new_index.previews.begin(), new_index.previews.end());
 }
@@ -1,14 +1,452 @@
 #include "ScopedTimer.h"
 
+#include "AllocationCounter.h"
 #include "Logger.h"
 
 #include <boost/chrono.hpp>
+#include <boost/filesystem/fstream.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace {
     DeclareThreadSafeLogger(timer);
+
+    using trace_clock = std::chrono::high_resolution_clock;
+
+    /** Approximately when the process started, as the time that static
+        initialization of this library ran. */
+    const trace_clock::time_point PROCESS_START = trace_clock::now();
+
+    /** The most spans that are kept, so that recording in a process that
+        never finishes its trace stops eventually. */
+    constexpr std::size_t MAX_TRACED_SPANS = 1 << 16;
+
+    /** The most spans that each thread keeps for a turn profile.  Older spans
+        are overwritten once a thread has recorded this many in a turn. */
+    constexpr std::size_t MAX_TURN_PROFILE_SPANS_PER_THREAD = 1 << 15;
+
+    /** The lifetime of a ScopedTimer or section of a SectionedScopedTimer. */
+    struct Span {
+        std::string                 name;
+        trace_clock::time_point     start;
+        trace_clock::time_point     end;
+        unsigned int                thread = 0;
+        unsigned int                depth = 0;
+        AllocationCounts            allocations;    ///< made by the thread during the span
+    };
+
+    /** Appends the numbers of allocations in \a counts to \a os, if
+        allocations are counted. */
+    void FormatAllocations(std::ostream& os, const AllocationCounts& counts) {
+        if (AllocationCountingEnabled())
+            os << "  allocs: " << counts.allocations << " (" << (counts.bytes + 1023) / 1024 << " KiB)";
+    }
+
+    /** Returns a small number identifying the calling thread, in the order
+        that threads first record a span. */
+    unsigned int ThreadNumber() {
+        static std::atomic<unsigned int> next_thread_number = 1;
+        thread_local const unsigned int thread_number = next_thread_number++;
+        return thread_number;
+    }
+
+    void WriteEscaped(std::ostream& os, const std::string& text) {
+        os << '"';
+        for (const char c : text) {
+            if (c == '"' || c == '\\')
+                os << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+            else
+                os << c;
+        }
+        os << '"';
+    }
+
+    long long Microseconds(trace_clock::duration duration)
+    { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); }
+
+    /** Writes \a spans and the instant \a milestone to \a path in Chrome
+        trace format. */
+    void WriteChromeTrace(const boost::filesystem::path& path, const std::vector<Span>& spans,
+                          const Span& milestone)
+    {
+        boost::filesystem::ofstream ofs(path);
+        if (!ofs) {
+            std::cerr << "Unable to write trace to " << path.string() << std::endl;
+            return;
+        }
+
+        ofs << "{\"traceEvents\":[\n";
+        ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":";
+        WriteEscaped(ofs, path.stem().string());
+        ofs << "}}";
+
+        unsigned int max_thread = milestone.thread;
+        for (const auto& span : spans)
+            max_thread = std::max(max_thread, span.thread);
+        for (unsigned int thread = 1; thread <= max_thread; ++thread)
+            ofs << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+                << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+
+        for (const auto& span : spans) {
+            ofs << ",\n{\"name\":";
+            WriteEscaped(ofs, span.name);
+            ofs << ",\"cat\":\"timer\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread
+                << ",\"ts\":" << Microseconds(span.start - PROCESS_START)
+                << ",\"dur\":" << Microseconds(span.end - span.start)
+                << ",\"args\":{\"depth\":" << span.depth;
+            if (AllocationCountingEnabled())
+                ofs << ",\"allocations\":" << span.allocations.allocations
+                    << ",\"allocated_bytes\":" << span.allocations.bytes;
+            ofs << "}}";
+        }
+
+        ofs << ",\n{\"name\":";
+        WriteEscaped(ofs, milestone.name);
+        ofs << ",\"cat\":\"milestone\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << milestone.thread
+            << ",\"ts\":" << Microseconds(milestone.start - PROCESS_START) << "}";
+        ofs << "\n]}\n";
+    }
+
+    /** Records ScopedTimer lifetimes for FinishStartupTrace. */
+    class StartupTrace {
+    public:
+        ~StartupTrace() {
+            std::unique_lock lock(m_mutex);
+            if (m_finished && !m_written)
+                Write(lock);
+        }
+
+        static StartupTrace& Get() {
+            static StartupTrace trace;
+            return trace;
+        }
+
+        /** Returns whether the span of a timer being started should be
+            recorded, in which case End must be called when it ends. */
+        bool Begin() {
+            if (!m_recording.load(std::memory_order_relaxed))
+                return false;
+            std::scoped_lock lock(m_mutex);
+            if (!m_recording || m_spans.size() + m_open_spans >= MAX_TRACED_SPANS)
+                return false;
+            ++m_open_spans;
+            ++t_depth;
+            return true;
+        }
+
+        void End(std::string name, trace_clock::time_point start) {
+            const auto end = trace_clock::now();
+            --t_depth;
+            std::unique_lock lock(m_mutex);
+            m_spans.push_back({std::move(name), start, end, ThreadNumber(), t_depth});
+            if (--m_open_spans == 0 && m_finished && !m_written)
+                Write(lock);
+        }
+
+        void Finish(const std::string& milestone, const boost::filesystem::path& path) {
+            std::unique_lock lock(m_mutex);
+            if (!m_recording)
+                return;
+            m_recording = false;
+            if (path.empty()) {
+                m_spans.clear();
+                m_spans.shrink_to_fit();
+                m_written = true;
+                return;
+            }
+            m_finished = true;
+            m_milestone = {milestone, trace_clock::now(), trace_clock::now(), ThreadNumber(), t_depth};
+            m_path = path;
+            if (m_open_spans == 0)
+                Write(lock);
+        }
+
+        bool Restart() {
+            std::scoped_lock lock(m_mutex);
+            if (m_recording || !m_written)
+                return false;
+            m_finished = false;
+            m_written = false;
+            m_recording = true;
+            return true;
+        }
+
+    private:
+        StartupTrace() = default;
+
+        /** Writes the recorded spans to m_path.  Unlocks \a lock while the
+            file is written. */
+        void Write(std::unique_lock<std::mutex>& lock) {
+            m_written = true;
+            auto spans = std::move(m_spans);
+            const auto milestone = std::move(m_milestone);
+            const auto path = std::move(m_path);
+            lock.unlock();
+
+            WriteChromeTrace(path, spans, milestone);
+        }
+
+        static thread_local unsigned int    t_depth;
+
+        std::mutex                  m_mutex;
+        std::atomic<bool>           m_recording = true;
+        bool                        m_finished = false;
+        bool                        m_written = false;
+        std::size_t                 m_open_spans = 0;
+        std::vector<Span>           m_spans;
+        Span                        m_milestone;
+        boost::filesystem::path     m_path;
+    };
+
+    thread_local unsigned int StartupTrace::t_depth = 0;
+
+    /** Records ScopedTimer and section lifetimes during a turn, in a ring
+        buffer per thread, for BeginTurnProfile and EndTurnProfile. */
+    class TurnProfile {
+    public:
+        static TurnProfile& Get() {
+            static TurnProfile profile;
+            return profile;
+        }
+
+        void SetEnabled(bool enabled) {
+            if (m_enabled.exchange(enabled) != enabled)
+                InfoLogger(timer) << "Turn profiling " << (enabled ? "enabled" : "disabled");
+        }
+
+        bool Enabled() const
+        { return m_enabled.load(std::memory_order_relaxed); }
+
+        void AddReport(std::function<void ()> begin_turn, std::function<std::string ()> end_turn) {
+            std::scoped_lock lock(m_reports_mutex);
+            m_reports.emplace_back(std::move(begin_turn), std::move(end_turn));
+        }
+
+        /** Returns whether the span of a timer or section being started
+            should be recorded, in which case End must be called when it
+            ends. */
+        bool Begin() {
+            if (!m_recording.load(std::memory_order_relaxed))
+                return false;
+            ++t_depth;
+            return true;
+        }
+
+        void End(const std::string& name, trace_clock::time_point start,
+                 const AllocationCounts& allocations)
+        {
+            const auto end = trace_clock::now();
+            --t_depth;
+            ThreadSpans().Push(name, start, end, t_depth, allocations);
+        }
+
+        void BeginTurn(int turn) {
+            const bool recording = Enabled();
+            if (recording) {
+                {
+                    std::scoped_lock lock(m_threads_mutex);
+                    for (auto& thread_spans : m_threads)
+                        thread_spans->Take();
+                }
+                std::scoped_lock lock(m_reports_mutex);
+                for (const auto& report : m_reports)
+                    report.first();
+            }
+            m_turn = turn;
+            m_turn_start = trace_clock::now();
+            m_recording = recording;
+        }
+
+        void EndTurn(const boost::filesystem::path& path) {
+            if (!m_recording.exchange(false))
+                return;
+
+            std::vector<Span> spans;
+            std::size_t overwritten = 0;
+            {
+                std::scoped_lock lock(m_threads_mutex);
+                for (auto& thread_spans : m_threads)
+                    overwritten += thread_spans->Take(spans);
+            }
+            if (overwritten)
+                WarnLogger(timer) << "Turn " << m_turn << " profile is missing the " << overwritten
+                                  << " oldest spans, which were overwritten";
+
+            LogTree(spans);
+
+            {
+                std::scoped_lock lock(m_reports_mutex);
+                for (const auto& report : m_reports) {
+                    std::istringstream lines(report.second());
+                    for (std::string line; std::getline(lines, line);)
+                        DebugLogger(timer) << line;
+                }
+            }
+
+            if (!path.empty())
+                WriteChromeTrace(path, spans, {"turn " + std::to_string(m_turn), m_turn_start,
+                                               m_turn_start, ThreadNumber(), 0});
+        }
+
+    private:
+        /** Spans recorded by one thread.  Only that thread adds spans, so
+            m_mutex is uncontended except while a turn profile is collected. */
+        class ThreadRing {
+        public:
+            ThreadRing() :
+                m_thread(ThreadNumber())
+            {}
+
+            void Push(const std::string& name, trace_clock::time_point start,
+                      trace_clock::time_point end, unsigned int depth,
+                      const AllocationCounts& allocations)
+            {
+                std::scoped_lock lock(m_mutex);
+                if (m_spans.size() < MAX_TURN_PROFILE_SPANS_PER_THREAD) {
+                    m_spans.push_back({name, start, end, m_thread, depth, allocations});
+                    return;
+                }
+                auto& span = m_spans[m_oldest];
+                span.name.assign(name); // reuses the overwritten span's storage
+                span.start = start;
+                span.end = end;
+                span.depth = depth;
+                span.allocations = allocations;
+                m_oldest = (m_oldest + 1) % m_spans.size();
+                ++m_overwritten;
+            }
+
+            /** Moves the recorded spans, oldest first, to the end of \a out,
+                and returns how many were overwritten since the last call. */
+            std::size_t Take(std::vector<Span>& out) {
+                std::scoped_lock lock(m_mutex);
+                std::move(m_spans.begin() + m_oldest, m_spans.end(), std::back_inserter(out));
+                std::move(m_spans.begin(), m_spans.begin() + m_oldest, std::back_inserter(out));
+                m_spans.clear();
+                m_oldest = 0;
+                return std::exchange(m_overwritten, 0);
+            }
+
+            void Take() {
+                std::scoped_lock lock(m_mutex);
+                m_spans.clear();
+                m_oldest = 0;
+                m_overwritten = 0;
+            }
+
+        private:
+            std::mutex          m_mutex;
+            std::vector<Span>   m_spans;
+            std::size_t         m_oldest = 0;
+            std::size_t         m_overwritten = 0;
+            const unsigned int  m_thread;
+        };
+
+        /** Total time and count of the spans with the same name and the same
+            chain of enclosing span names. */
+        struct Node {
+            std::string                 name;
+            trace_clock::duration       total{0};
+            std::size_t                 count = 0;
+            AllocationCounts            allocations;
+            std::vector<Node>           children;
+
+            Node& Child(const std::string& child_name) {
+                for (auto& child : children)
+                    if (child.name == child_name)
+                        return child;
+                children.push_back(Node{child_name});
+                return children.back();
+            }
+        };
+
+        TurnProfile() = default;
+
+        ThreadRing& ThreadSpans() {
+            thread_local ThreadRing* t_spans = [this]() {
+                std::scoped_lock lock(m_threads_mutex);
+                m_threads.push_back(std::make_unique<ThreadRing>());
+                return m_threads.back().get();
+            }();
+            return *t_spans;
+        }
+
+        /** Aggregates \a spans into a tree by nesting and logs it, with the
+            most expensive spans first at each level.  Spans on different
+            threads are merged into the same tree, by name. */
+        void LogTree(std::vector<Span>& spans) const {
+            std::sort(spans.begin(), spans.end(), [](const Span& lhs, const Span& rhs) {
+                return std::tie(lhs.thread, lhs.start, lhs.depth) < std::tie(rhs.thread, rhs.start, rhs.depth);
+            });
+
+            Node root;
+            std::vector<std::pair<Node*, trace_clock::time_point>> open;
+            unsigned int thread = 0;
+            for (const auto& span : spans) {
+                if (span.thread != thread) {
+                    open.clear();
+                    thread = span.thread;
+                }
+                // close the spans that don't contain this one
+                while (!open.empty() && open.back().second < span.end)
+                    open.pop_back();
+                // Child may reallocate the parent's children, so the
+                // pointers in open are only to the parents of the new node
+                Node& node = (open.empty() ? root : *open.back().first).Child(span.name);
+                node.total += span.end - span.start;
+                ++node.count;
+                node.allocations += span.allocations;
+                open.emplace_back(&node, span.end);
+            }
+
+            DebugLogger(timer) << "Turn " << m_turn << " profile (total ms, count, self ms"
+                               << (AllocationCountingEnabled() ? ", allocations" : "") << "):";
+            LogNode(root, 0);
+        }
+
+        static void LogNode(Node& node, std::size_t depth) {
+            std::sort(node.children.begin(), node.children.end(),
+                      [](const Node& lhs, const Node& rhs) { return lhs.total > rhs.total; });
+            for (auto& child : node.children) {
+                auto self = child.total;
+                for (const auto& grandchild : child.children)
+                    self -= grandchild.total;
+                const auto ms = [](trace_clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+                std::stringstream ss;
+                ss << std::string(2 * depth + 2, ' ') << child.name << "  "
+                   << ms(child.total) << " ms  x" << child.count << "  " << ms(self) << " ms";
+                FormatAllocations(ss, child.allocations);
+                DebugLogger(timer) << ss.str();
+                LogNode(child, depth + 1);
+            }
+        }
+
+        static thread_local unsigned int    t_depth;
+
+        std::atomic<bool>                           m_enabled = false;
+        std::atomic<bool>                           m_recording = false;
+        int                                         m_turn = 0;
+        trace_clock::time_point                     m_turn_start;
+        std::mutex                                  m_threads_mutex;
+        std::vector<std::unique_ptr<ThreadRing>>    m_threads;
+        std::mutex                                  m_reports_mutex;
+        std::vector<std::pair<std::function<void ()>, std::function<std::string ()>>> m_reports;
+    };
+
+    thread_local unsigned int TurnProfile::t_depth = 0;
 }
 
 class ScopedTimer::Impl {
@@ -17,7 +455,10 @@ public:
         m_start(std::chrono::high_resolution_clock::now()),
         m_name(std::move(timed_name)),
         m_enable_output(enable_output),
-        m_threshold(threshold)
+        m_threshold(threshold),
+        m_traced(!m_name.empty() && StartupTrace::Get().Begin()),
+        m_profiled(!m_name.empty() && TurnProfile::Get().Begin()),
+        m_start_allocations(ThreadAllocationCounts())
     {}
 
     Impl(std::function<std::string ()> output_text_fn, bool enable_output,
@@ -25,10 +466,19 @@ public:
         m_start(std::chrono::high_resolution_clock::now()),
         m_output_text_fn(output_text_fn),
         m_enable_output(enable_output),
-        m_threshold(threshold)
+        m_threshold(threshold),
+        m_traced(m_output_text_fn && StartupTrace::Get().Begin()),
+        m_profiled(m_output_text_fn && TurnProfile::Get().Begin()),
+        m_start_allocations(ThreadAllocationCounts())
     {}
 
     ~Impl() {
+        if (m_profiled)
+            TurnProfile::Get().End(m_name.empty() ? m_output_text_fn() : m_name, m_start,
+                                   ThreadAllocationCounts() - m_start_allocations);
+        if (m_traced)
+            StartupTrace::Get().End(m_name.empty() ? m_output_text_fn() : m_name, m_start);
+
         if (!m_enable_output)
             return;
 
@@ -45,6 +495,7 @@ public:
         else
             ss << "time: ";
         FormatDuration(ss, duration);
+        FormatAllocations(ss, ThreadAllocationCounts() - m_start_allocations);
         DebugLogger(timer) << ss.str();
     }
 
@@ -111,6 +562,9 @@ public:
     std::function<std::string ()>                  m_output_text_fn;
     bool                                           m_enable_output;
     std::chrono::microseconds                      m_threshold;
+    const bool                                     m_traced;
+    const bool                                     m_profiled;
+    AllocationCounts                               m_start_allocations;    ///< of this thread when started
 };
 
 ScopedTimer::ScopedTimer(std::string timed_name, bool enable_output,
@@ -143,17 +597,46 @@ double ScopedTimer::duration() const
 std::string ScopedTimer::DurationString() const
 { return m_impl->DurationString(); }
 
+void FinishStartupTrace(const std::string& milestone, const boost::filesystem::path& path)
+{ StartupTrace::Get().Finish(milestone, path); }
+
+bool RestartStartupTrace()
+{ return StartupTrace::Get().Restart(); }
+
+void SetTurnProfilingEnabled(bool enabled)
+{ TurnProfile::Get().SetEnabled(enabled); }
+
+bool TurnProfilingEnabled()
+{ return TurnProfile::Get().Enabled(); }
+
+void BeginTurnProfile(int turn)
+{ TurnProfile::Get().BeginTurn(turn); }
+
+void EndTurnProfile(const boost::filesystem::path& path)
+{ TurnProfile::Get().EndTurn(path); }
+
+void AddTurnProfileReport(std::function<void ()> begin_turn, std::function<std::string ()> end_turn)
+{ TurnProfile::Get().AddReport(std::move(begin_turn), std::move(end_turn)); }
+
 
 
 class SectionedScopedTimer::Impl : public ScopedTimer::Impl {
+    /** Duration and allocations of the thread accumulated in a section. */
+    struct SectionTotals {
+        std::chrono::nanoseconds    duration{0};
+        AllocationCounts            allocations;
+    };
+
     /** Sections store a time and a duration for each section of the elapsed time report.*/
     struct Sections {
         Sections(const std::chrono::high_resolution_clock::time_point& now,
-                 const std::chrono::nanoseconds& time_from_start) :
-            m_section_start(now)
+                 const std::chrono::nanoseconds& time_from_start,
+                 const AllocationCounts& allocations_from_start) :
+            m_section_start(now),
+            m_section_start_allocations(ThreadAllocationCounts())
         {
             // Create a dummy "" section so that m_curr is always a valid iterator.
-            auto curr = m_table.emplace("", time_from_start);
+            auto curr = m_table.emplace("", SectionTotals{time_from_start, allocations_from_start});
             m_curr = curr.first;
         }
 
@@ -164,13 +647,22 @@ class SectionedScopedTimer::Impl : public ScopedTimer::Impl {
             if (m_curr->first == section_name)
                 return;
 
-            m_curr->second += (now - m_section_start);
+            const auto allocations_now = ThreadAllocationCounts();
+            const auto section_allocations = allocations_now - m_section_start_allocations;
+            m_curr->second.duration += (now - m_section_start);
+            m_curr->second.allocations += section_allocations;
+
+            // sections are profiled as children of their timer, so that
+            // timers created within a section are nested within it
+            if (m_profiled)
+                TurnProfile::Get().End(m_curr->first, m_section_start, section_allocations);
+            m_profiled = !section_name.empty() && TurnProfile::Get().Begin();
 
             m_section_start = now;
+            m_section_start_allocations = allocations_now;
 
             // Create a new section if needed and update m_curr.
-            auto maybe_new = m_table.emplace(
-                section_name, std::chrono::high_resolution_clock::duration::zero());
+            auto maybe_new = m_table.emplace(section_name, SectionTotals{});
             m_curr = maybe_new.first;
 
             // Insert succeed, so grab the new section name.
@@ -179,18 +671,24 @@ class SectionedScopedTimer::Impl : public ScopedTimer::Impl {
         }
 
         //Table of section durations
-        typedef std::unordered_map<std::string, std::chrono::nanoseconds> SectionTable;
+        typedef std::unordered_map<std::string, SectionTotals> SectionTable;
         SectionTable m_table;
 
         // Currently running section start time and iterator
         std::chrono::high_resolution_clock::time_point m_section_start;
 
+        // Allocations of the thread when the current section started
+        AllocationCounts m_section_start_allocations;
+
         // m_curr always points to the section currently accumulating
         // time or to the dummy "" blank section.
         SectionTable::iterator m_curr;
 
         // Names of the sections in order or creation.
         std::vector<std::string> m_section_names;
+
+        // Whether the current section is being recorded for a turn profile.
+        bool m_profiled = false;
     };
 
 public:
@@ -202,6 +700,13 @@ public:
 
     /** The destructor will print the table of accumulated times. */
     ~Impl() {
+        // end a profiled section before the timer that contains it
+        if (m_sections && m_sections->m_profiled) {
+            TurnProfile::Get().End(m_sections->m_curr->first, m_sections->m_section_start,
+                                   ThreadAllocationCounts() - m_sections->m_section_start_allocations);
+            m_sections->m_profiled = false;
+        }
+
         if (!m_enable_output || !m_sections)
             return;
 
@@ -223,7 +728,7 @@ public:
         std::chrono::nanoseconds longest_section_duration(0);
         for (const auto& section : m_sections->m_table) {
             longest_section_name = std::max(longest_section_name, section.first.size());
-            longest_section_duration = std::max(longest_section_duration, section.second);
+            longest_section_duration = std::max(longest_section_duration, section.second.duration);
         }
 
         // Output section names and times in order they were created
@@ -235,23 +740,24 @@ public:
             }
 
             // is duration yet long enough to output?
-            if (jt->second < m_threshold)
+            if (jt->second.duration < m_threshold)
                 continue;
 
             // Create a header with padding, so all times align.
             std::stringstream header, tail;
             if (m_unify_units) {
                 if (longest_section_duration < std::chrono::microseconds(10))
-                    FormatDurationFixedUnits<std::chrono::nanoseconds>(tail, jt->second);
+                    FormatDurationFixedUnits<std::chrono::nanoseconds>(tail, jt->second.duration);
                 else if (longest_section_duration < std::chrono::milliseconds(10))
-                    FormatDurationFixedUnits<std::chrono::microseconds>(tail, jt->second);
+                    FormatDurationFixedUnits<std::chrono::microseconds>(tail, jt->second.duration);
                 else if (longest_section_duration < std::chrono::seconds(10))
-                    FormatDurationFixedUnits<std::chrono::milliseconds>(tail, jt->second);
+                    FormatDurationFixedUnits<std::chrono::milliseconds>(tail, jt->second.duration);
                 else
-                    FormatDurationFixedUnits<std::chrono::seconds>(tail, jt->second);
+                    FormatDurationFixedUnits<std::chrono::seconds>(tail, jt->second.duration);
             } else {
-                FormatDuration(tail, jt->second);
+                FormatDuration(tail, jt->second.duration);
             }
+            FormatAllocations(tail, jt->second.allocations);
             header << m_name << " - "
                    << std::setw(longest_section_name) << std::left << section_name
                    << std::right << " time: "
@@ -262,6 +768,7 @@ public:
         // Create a header with padding, so all times align.
         std::stringstream header, tail;
         FormatDuration(tail, duration);
+        FormatAllocations(tail, ThreadAllocationCounts() - m_start_allocations);
         header << m_name
                << std::setw(longest_section_name + 3 + 7)
                << std::right << " time: "
@@ -288,7 +795,7 @@ public:
 private:
     /** CreateSections allow m_sections to only be initialized if it is used.*/
     Sections* CreateSections(const std::chrono::high_resolution_clock::time_point& now) {
-        m_sections.reset(new Sections(now, now - m_start));
+        m_sections.reset(new Sections(now, now - m_start, ThreadAllocationCounts() - m_start_allocations));
         return m_sections.get();
     }
 
@@ -7,6 +7,8 @@
 
 #include "Export.h"
 
+#include <boost/filesystem/path.hpp>
+
 #include <chrono>
 
 
@@ -58,6 +60,11 @@ private:
 //! section is only printed if its time is greater than the threshold.  The
 //! whole table is only printed if the total time is greater than the threshold.
 //!
+//! In builds that count allocations (see AllocationCountingEnabled()) the
+//! table, like turn profiles, also shows the heap allocations made in each
+//! section by the thread running the timer.  Allocations made by work that a
+//! section hands to other threads are attributed to timers on those threads.
+//!
 //! The following is a usage example.  It shows how to create timer with a
 //! section before a loop, two sections in a loop, a section after a loop and a
 //! section that will not be timed.
@@ -123,4 +130,55 @@ private:
 };
 
 
+//! Writes the lifetimes of the named ScopedTimer%s created since the process
+//! started, with their threads and nesting, to @p path as a Chrome trace
+//! format JSON file, which can be viewed with chrome://tracing or Perfetto.
+//!
+//! ScopedTimer%s are recorded whether or not they log their time, so an
+//! unlogged ScopedTimer can be used to mark a span of interest.  Those created
+//! after this is called are not recorded.  Those that exist when it is called
+//! are recorded when they end, and the file is written once the last of them
+//! has, or when the process exits.  If @p path is empty, recording stops and
+//! nothing is written.
+//!
+//! @p milestone names the instant of this call, which is marked in the trace.
+FO_COMMON_API void FinishStartupTrace(const std::string& milestone,
+                                      const boost::filesystem::path& path);
+
+//! Starts recording the lifetimes of named ScopedTimer%s again, for another
+//! trace to be written by the next FinishStartupTrace(), such as one of
+//! starting a game.  Returns false, and does nothing, if the previous trace
+//! is still recording or hasn't been written yet.
+FO_COMMON_API bool RestartStartupTrace();
+
+
+//! Enables or disables recording the lifetimes of named ScopedTimer%s and
+//! the sections of SectionedScopedTimer%s from the next BeginTurnProfile().
+//!
+//! Recording costs one atomic load per timer while disabled.  While enabled,
+//! each thread records into its own ring buffer, so that recording doesn't
+//! contend between threads.
+FO_COMMON_API void SetTurnProfilingEnabled(bool enabled);
+
+FO_COMMON_API bool TurnProfilingEnabled();
+
+//! Starts recording a profile of @p turn, if turn profiling is enabled.
+FO_COMMON_API void BeginTurnProfile(int turn);
+
+//! Stops recording the profile started by BeginTurnProfile(), logs it to the
+//! timer logger as a tree of the total times and counts of the timers and
+//! sections, nested as they were when they ran, and writes the recorded
+//! spans to @p path as a Chrome trace format JSON file, unless @p path is
+//! empty.  Timers and sections on other threads are merged into the tree by
+//! name.
+FO_COMMON_API void EndTurnProfile(const boost::filesystem::path& path);
+
+//! Adds a report to turn profiles.  @p begin_turn is called when a profile
+//! starts recording and @p end_turn when it stops, and the text it returns is
+//! logged after the tree of times.  Neither is called while turn profiling is
+//! disabled.
+FO_COMMON_API void AddTurnProfileReport(std::function<void ()> begin_turn,
+                                        std::function<std::string ()> end_turn);
+
+
 #endif
@@ -8,9 +8,15 @@
 #include <boost/serialization/version.hpp>
 
 #include <map>
+#include <string>
+#include <type_traits>
 
 #include "Export.h"
 
+class ObjectMap;
+class ObjectIDBitmap;
+class ObjectVisibilityTable;
+struct ObjectDeltaBase;
 class PopCenter;
 class OrderSet;
 class Universe;
@@ -25,9 +31,17 @@ typedef boost::archive::xml_oarchive freeorion_xml_oarchive;
 //! gamestate information, so that only the relevant info is serialized for the
 //! intended recieipient. This is implemented this way so that we don't need to
 //! write custom boost::serialization classes that implement empire-dependent
-//! visibility.
+//! visibility. The encoding empire is per-thread, so that gamestate can be
+//! serialized for several recipients concurrently; code that serializes on a
+//! worker thread must set it on that thread.
 FO_COMMON_API int& GlobalSerializationEncodingForEmpire();
 
+//! True for the binary archives, as opposed to the XML archives, which can
+//! only hold text.
+template <typename Archive>
+constexpr bool IsBinaryArchive = std::is_same_v<Archive, freeorion_bin_iarchive> ||
+                                 std::is_same_v<Archive, freeorion_bin_oarchive>;
+
 //! @warning
 //!     Do not try to serialize types that contain longs, since longs are
 //!     different sizes on 32- and 64-bit architectures.  Replace your longs
@@ -39,6 +53,39 @@ FO_COMMON_API int& GlobalSerializationEncodingForEmpire();
 template <typename Archive>
 FO_COMMON_API void Serialize(Archive& oa, const Universe& universe);
 
+//! Serialize @p universe to output archive @p oa for a turn update for turn
+//! @p turn. If @p use_delta is true, objects that are unchanged since the
+//! update recorded in @p delta_base are written as just their IDs. Afterwards,
+//! @p delta_base records this update, as not yet acknowledged.
+template <typename Archive>
+FO_COMMON_API void SerializeDelta(Archive& oa, const Universe& universe, ObjectDeltaBase& delta_base,
+                                  bool use_delta, int turn);
+
+//! Serialize @p universe to output archive @p oa, leaving out the empires'
+//! latest known objects. Those can instead be serialized one empire at a time,
+//! eg. in parallel, with SerializeEmpireKnownObjects.
+template <typename Archive>
+FO_COMMON_API void SerializeWithoutKnownObjects(Archive& oa, const Universe& universe);
+
+//! Serialize empire @p empire_id's latest known objects in @p universe to
+//! output archive @p oa.
+template <typename Archive>
+FO_COMMON_API void SerializeEmpireKnownObjects(Archive& oa, const Universe& universe, int empire_id);
+
+//! As SerializeDelta, but leaving out the empires' latest known objects,
+//! which can instead be serialized with SerializeEmpireKnownObjectsDelta.
+template <typename Archive>
+FO_COMMON_API void SerializeDeltaWithoutKnownObjects(Archive& oa, const Universe& universe, ObjectDeltaBase& delta_base,
+                                                     bool use_delta, int turn);
+
+//! Serialize empire @p empire_id's latest known objects in @p universe to
+//! output archive @p oa for turn @p turn. If @p use_delta is true, objects
+//! that are unchanged since those recorded in @p delta_base are written as
+//! just their IDs. Afterwards, @p delta_base records these objects.
+template <typename Archive>
+FO_COMMON_API void SerializeEmpireKnownObjectsDelta(Archive& oa, const Universe& universe, int empire_id,
+                                                    ObjectDeltaBase& delta_base, bool use_delta, int turn);
+
 //! Serialize @p object_map to output archive @p oa.
 template <typename Archive>
 void Serialize(Archive& oa, const std::map<int, std::shared_ptr<UniverseObject>>& objects);
@@ -51,6 +98,35 @@ void Serialize(Archive& oa, const OrderSet& order_set);
 template <typename Archive>
 FO_COMMON_API void Deserialize(Archive& ia, Universe& universe);
 
+//! Deserialize @p universe from input archive @p ia, as written by
+//! SerializeDelta for turn @p turn, restoring unchanged objects from
+//! @p delta_base. Afterwards, @p delta_base records this update.
+template <typename Archive>
+FO_COMMON_API void DeserializeDelta(Archive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+
+//! Deserialize @p universe from input archive @p ia, as written by
+//! SerializeWithoutKnownObjects. Its empires will know no objects until they
+//! are given them with Universe::SetEmpireKnownObjects.
+template <typename Archive>
+FO_COMMON_API void DeserializeWithoutKnownObjects(Archive& ia, Universe& universe);
+
+//! Deserialize one empire's latest known objects from input archive @p ia, as
+//! written by SerializeEmpireKnownObjects, into @p objects.
+template <typename Archive>
+FO_COMMON_API void DeserializeEmpireKnownObjects(Archive& ia, ObjectMap& objects);
+
+//! As DeserializeDelta, for a @p universe written by
+//! SerializeDeltaWithoutKnownObjects.
+template <typename Archive>
+FO_COMMON_API void DeserializeDeltaWithoutKnownObjects(Archive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+
+//! Deserialize one empire's latest known objects from input archive @p ia, as
+//! written by SerializeEmpireKnownObjectsDelta for turn @p turn, into
+//! @p objects, restoring unchanged objects from @p delta_base. Afterwards,
+//! @p delta_base records these objects.
+template <typename Archive>
+FO_COMMON_API void DeserializeEmpireKnownObjectsDelta(Archive& ia, ObjectMap& objects, ObjectDeltaBase& delta_base, int turn);
+
 //! Deserialize @p object_map from input archive @p ia.
 template <typename Archive>
 void Deserialize(Archive& ia, std::map<int, std::shared_ptr<UniverseObject>>& objects);
@@ -59,6 +135,20 @@ void Deserialize(Archive& ia, std::map<int, std::shared_ptr<UniverseObject>>& ob
 template <typename Archive>
 void Deserialize(Archive& ia, OrderSet& order_set);
 
+//! Serialize @p text to binary output archive @p oa, compressed with zlib if
+//! that makes it smaller.  Used for the save state strings of AI clients,
+//! which are large and repetitive.
+template <typename Archive>
+FO_COMMON_API void SerializeCompressible(Archive& oa, const std::string& text);
+
+//! Deserialize @p text, as written by SerializeCompressible, from binary
+//! input archive @p ia.
+template <typename Archive>
+FO_COMMON_API void DeserializeCompressible(Archive& ia, std::string& text);
+
+
+BOOST_CLASS_VERSION(OrderSet, 1);
+
 
 struct ChatHistoryEntity;
 
@@ -156,7 +246,7 @@ extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_x
 
 struct PlayerSaveGameData;
 
-BOOST_CLASS_VERSION(PlayerSaveGameData, 2);
+BOOST_CLASS_VERSION(PlayerSaveGameData, 3);
 
 template <typename Archive>
 void serialize(Archive&, PlayerSaveGameData&, unsigned int const);
@@ -204,6 +294,24 @@ extern template FO_COMMON_API void serialize<freeorion_xml_oarchive>(freeorion_x
 extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, PlayerSetupData&, unsigned int const);
 
 
+template <typename Archive>
+void serialize(Archive&, ObjectVisibilityTable&, unsigned int const);
+
+extern template FO_COMMON_API void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, ObjectVisibilityTable&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, ObjectVisibilityTable&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, ObjectVisibilityTable&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, ObjectVisibilityTable&, unsigned int const);
+
+
+template <typename Archive>
+void serialize(Archive&, ObjectIDBitmap&, unsigned int const);
+
+extern template FO_COMMON_API void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, ObjectIDBitmap&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, ObjectIDBitmap&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, ObjectIDBitmap&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, ObjectIDBitmap&, unsigned int const);
+
+
 template <typename Archive>
 void serialize(Archive&, PopCenter&, unsigned int const);
 
@@ -213,6 +321,17 @@ extern template FO_COMMON_API void serialize<freeorion_xml_oarchive>(freeorion_x
 extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, PopCenter&, unsigned int const);
 
 
+struct FullPreview;
+
+template<typename Archive>
+void serialize(Archive&, FullPreview&, unsigned int const);
+
+extern template FO_COMMON_API void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, FullPreview&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, FullPreview&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, FullPreview&, unsigned int const);
+extern template FO_COMMON_API void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, FullPreview&, unsigned int const);
+
+
 struct PreviewInformation;
 
 template<typename Archive>
@@ -4,6 +4,9 @@
 #include "../combat/CombatEvents.h"
 #include "../combat/CombatLogManager.h"
 
+#include <cstdint>
+#include <string_view>
+
 
 template<typename Archive>
 void serialize(Archive&, CombatEvent&, unsigned int const)
@@ -267,11 +270,90 @@ void serialize(Archive& ar, WeaponsPlatformEvent& obj, unsigned int const versio
 
     ar & make_nvp("bout", obj.bout)
        & make_nvp("attacker_id", obj.attacker_id)
-       & make_nvp("attacker_owner_id", obj.attacker_owner_id)
-       & make_nvp("events", obj.events);
+       & make_nvp("attacker_owner_id", obj.attacker_owner_id);
+
+    if (version < 5) {
+        ar & make_nvp("events", obj.events);
+        return;
+    }
+
+    // All the WeaponFireEvents of a platform share its bout, attacker and
+    // attacker owner, and usually a few weapon names, so rather than each
+    // being serialized as a separately tracked polymorphic object with its
+    // own copy of those, they are stored as columns of their other fields,
+    // with weapon names replaced by indices into a table of distinct names.
+    std::vector<std::string>    weapon_names;
+    std::vector<int>            target_ids;
+    std::vector<std::uint32_t>  target_counts;
+    std::vector<int>            rounds;
+    std::vector<std::uint32_t>  weapon_name_indices;
+    std::vector<float>          powers;
+    std::vector<float>          shields;
+    std::vector<float>          damages;
+    std::vector<int>            target_owner_ids;
+
+    if constexpr (Archive::is_saving::value) {
+        std::map<std::string_view, std::uint32_t> name_indices;
+        target_ids.reserve(obj.events.size());
+        target_counts.reserve(obj.events.size());
+        for (const auto& [target_id, target_events] : obj.events) {
+            target_ids.push_back(target_id);
+            target_counts.push_back(static_cast<std::uint32_t>(target_events.size()));
+            for (const auto& fire : target_events) {
+                const auto [it, inserted] = name_indices.emplace(
+                    fire->weapon_name, static_cast<std::uint32_t>(weapon_names.size()));
+                if (inserted)
+                    weapon_names.push_back(fire->weapon_name);
+                rounds.push_back(fire->round);
+                weapon_name_indices.push_back(it->second);
+                powers.push_back(fire->power);
+                shields.push_back(fire->shield);
+                damages.push_back(fire->damage);
+                target_owner_ids.push_back(fire->target_owner_id);
+            }
+        }
+    }
+
+    ar & make_nvp("n", weapon_names)
+       & make_nvp("t", target_ids)
+       & make_nvp("c", target_counts)
+       & make_nvp("r", rounds)
+       & make_nvp("w", weapon_name_indices)
+       & make_nvp("p", powers)
+       & make_nvp("s", shields)
+       & make_nvp("d", damages)
+       & make_nvp("to", target_owner_ids);
+
+    if constexpr (Archive::is_loading::value) {
+        obj.events.clear();
+        const auto num_fires = rounds.size();
+        if (target_ids.size() != target_counts.size() ||
+            weapon_name_indices.size() != num_fires || powers.size() != num_fires ||
+            shields.size() != num_fires || damages.size() != num_fires ||
+            target_owner_ids.size() != num_fires)
+        {
+            ErrorLogger() << "WeaponsPlatformEvent serialize got inconsistent weapon fire columns";
+            return;
+        }
+
+        std::size_t fire_idx = 0;
+        for (std::size_t target_idx = 0; target_idx < target_ids.size(); ++target_idx) {
+            const int target_id = target_ids[target_idx];
+            auto& target_events = obj.events[target_id];
+            target_events.reserve(target_counts[target_idx]);
+            for (std::uint32_t n = 0; n < target_counts[target_idx] && fire_idx < num_fires; ++n, ++fire_idx) {
+                const auto name_idx = weapon_name_indices[fire_idx];
+                target_events.push_back(std::make_shared<WeaponFireEvent>(
+                    obj.bout, rounds[fire_idx], obj.attacker_id, target_id,
+                    name_idx < weapon_names.size() ? weapon_names[name_idx] : std::string{},
+                    std::make_tuple(powers[fire_idx], shields[fire_idx], damages[fire_idx]),
+                    obj.attacker_owner_id, target_owner_ids[fire_idx]));
+            }
+        }
+    }
 }
 
-BOOST_CLASS_VERSION(WeaponsPlatformEvent, 4)
+BOOST_CLASS_VERSION(WeaponsPlatformEvent, 5)
 BOOST_CLASS_EXPORT(WeaponsPlatformEvent)
 
 template void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, WeaponsPlatformEvent&, unsigned int const);
@@ -341,6 +423,9 @@ void serialize(Archive& ar, CombatLogManager& obj, const unsigned int version)
         // TODO: filter logs by who should have access to them
         for (auto it = obj.m_logs.begin(); it != obj.m_logs.end(); ++it)
             logs.insert({it->first, it->second});
+        for (const auto& spilled : obj.m_spilled_logs)
+            if (auto log = obj.ReadSpilledLog(spilled.first))
+                logs.emplace(spilled.first, std::move(*log));
     }
 
     ar  & make_nvp("logs", logs)
@@ -348,8 +433,12 @@ void serialize(Archive& ar, CombatLogManager& obj, const unsigned int version)
 
     if (Archive::is_loading::value) {
         // copy new logs, but don't erase old ones
-        for (auto& log : logs)
+        for (auto& log : logs) {
+            obj.m_spilled_logs.erase(log.first);
             obj.m_logs[log.first] = log.second;
+        }
+        std::scoped_lock lock(obj.m_fetched_logs_mutex);
+        obj.m_fetched_logs.clear();
     }
 }
 
@@ -9,6 +9,7 @@
 #include "../universe/Universe.h"
 
 #include "GameRules.h"
+#include "OptionsDB.h"
 
 #include "Serialize.ipp"
 #include <boost/serialization/array.hpp>
@@ -117,6 +118,9 @@ void ProductionQueue::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_object_group_allocated_stockpile_pp)
         & BOOST_SERIALIZATION_NVP(m_expected_new_stockpile_amount)
         & BOOST_SERIALIZATION_NVP(m_empire_id);
+
+    if (Archive::is_loading::value)
+        m_projection_task.reset();
 }
 
 template void ProductionQueue::serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, const unsigned int);
@@ -255,8 +259,21 @@ void Empire::serialize(Archive& ar, const unsigned int version)
     if (visible) {
         try {
         ar  & boost::serialization::make_nvp("m_ship_designs", m_known_ship_designs);
-        ar  & BOOST_SERIALIZATION_NVP(m_sitrep_entries)
-            & BOOST_SERIALIZATION_NVP(m_resource_pools)
+
+        // sitreps older than the history sent to players are only kept in saved games
+        const int sitrep_history_turns = (Archive::is_saving::value && encoding_empire != ALL_EMPIRES) ?
+            GetOptionsDB().Get<int>("network.server.sitrep-history.turns") : 0;
+        if (sitrep_history_turns > 0) {
+            const int oldest_turn = CurrentTurn() - sitrep_history_turns;
+            std::vector<SitRepEntry> recent_sitreps;
+            std::copy_if(m_sitrep_entries.begin(), m_sitrep_entries.end(), std::back_inserter(recent_sitreps),
+                         [oldest_turn](const SitRepEntry& sitrep) { return sitrep.GetTurn() > oldest_turn; });
+            ar  & boost::serialization::make_nvp("m_sitrep_entries", recent_sitreps);
+        } else {
+            ar  & BOOST_SERIALIZATION_NVP(m_sitrep_entries);
+        }
+
+        ar  & BOOST_SERIALIZATION_NVP(m_resource_pools)
             & BOOST_SERIALIZATION_NVP(m_population_pool)
 
             & BOOST_SERIALIZATION_NVP(m_explored_systems)
@@ -311,6 +328,9 @@ void Empire::serialize(Archive& ar, const unsigned int version)
         ar  & BOOST_SERIALIZATION_NVP(m_auto_turn_count);
     }
 
+    if (Archive::is_loading::value)
+        UpdateResearchedTechIndices();
+
     TraceLogger() << "DONE serializing empire " << m_id << ": " << m_name;
 }
 
@@ -397,6 +417,8 @@ void serialize(Archive& ar, EmpireManager& em, unsigned int const version)
                 }
             }
         }
+
+        em.UpdateDiplomaticStatusMatrix();
     }
 }
 
@@ -430,6 +452,11 @@ void SupplyManager::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_empire_propagated_supply_ranges)
         & BOOST_SERIALIZATION_NVP(m_propagated_supply_distances)
         & BOOST_SERIALIZATION_NVP(m_empire_propagated_supply_distances);
+
+    if (Archive::is_loading::value) {
+        m_last_update_inputs_valid = false;
+        UpdateResourceSupplyGroupIDs();
+    }
 }
 
 template void SupplyManager::serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, const unsigned int);
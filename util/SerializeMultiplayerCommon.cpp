@@ -14,9 +14,10 @@
 #include <boost/serialization/array.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <zlib.h>
 
 int& GlobalSerializationEncodingForEmpire() {
-    static int s_encoding_empire = ALL_EMPIRES;
+    thread_local int s_encoding_empire = ALL_EMPIRES;
     return s_encoding_empire;
 }
 
@@ -285,9 +286,20 @@ void serialize(Archive& ar, PlayerSaveGameData& obj, unsigned int const version)
     ar  & make_nvp("m_name", obj.name)
         & make_nvp("m_empire_id", obj.empire_id)
         & make_nvp("m_orders", obj.orders)
-        & make_nvp("m_ui_data", obj.ui_data)
-        & make_nvp("m_save_state_string", obj.save_state_string)
-        & make_nvp("m_client_type", obj.client_type);
+        & make_nvp("m_ui_data", obj.ui_data);
+    if constexpr (IsBinaryArchive<Archive>) {
+        if (version >= 3) {
+            if constexpr (Archive::is_saving::value)
+                SerializeCompressible(ar, obj.save_state_string);
+            else
+                DeserializeCompressible(ar, obj.save_state_string);
+        } else {
+            ar  & make_nvp("m_save_state_string", obj.save_state_string);
+        }
+    } else {
+        ar  & make_nvp("m_save_state_string", obj.save_state_string);
+    }
+    ar  & make_nvp("m_client_type", obj.client_type);
     if (version == 1) {
         bool ready{false};
         ar & make_nvp("m_ready", ready);
@@ -300,6 +312,71 @@ template void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, PlayerS
 template void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, PlayerSaveGameData&, unsigned int const);
 
 
+namespace {
+    /** Shorter texts are not worth compressing. */
+    constexpr std::size_t MIN_COMPRESSIBLE_SIZE = 1024;
+}
+
+template <typename Archive>
+void SerializeCompressible(Archive& oa, const std::string& text)
+{
+    std::string compressed_text;
+    if (text.size() >= MIN_COMPRESSIBLE_SIZE) {
+        uLongf compressed_size = compressBound(static_cast<uLong>(text.size()));
+        compressed_text.resize(compressed_size);
+        const int result = compress2(reinterpret_cast<Bytef*>(compressed_text.data()), &compressed_size,
+                                     reinterpret_cast<const Bytef*>(text.data()),
+                                     static_cast<uLong>(text.size()), Z_BEST_SPEED);
+        if (result == Z_OK && compressed_size < text.size()) {
+            compressed_text.resize(compressed_size);
+        } else {
+            if (result != Z_OK)
+                ErrorLogger() << "SerializeCompressible failed to compress text: zlib error " << result;
+            compressed_text.clear();
+        }
+    }
+
+    bool compressed = !compressed_text.empty();
+    oa << BOOST_SERIALIZATION_NVP(compressed);
+    if (compressed) {
+        auto uncompressed_size = static_cast<std::uint32_t>(text.size());
+        oa << BOOST_SERIALIZATION_NVP(uncompressed_size)
+           << BOOST_SERIALIZATION_NVP(compressed_text);
+    } else {
+        oa << boost::serialization::make_nvp("text", text);
+    }
+}
+
+template FO_COMMON_API void SerializeCompressible<freeorion_bin_oarchive>(freeorion_bin_oarchive&, const std::string&);
+
+template <typename Archive>
+void DeserializeCompressible(Archive& ia, std::string& text)
+{
+    bool compressed = false;
+    ia >> BOOST_SERIALIZATION_NVP(compressed);
+    if (!compressed) {
+        ia >> boost::serialization::make_nvp("text", text);
+        return;
+    }
+
+    std::uint32_t uncompressed_size = 0;
+    std::string compressed_text;
+    ia >> BOOST_SERIALIZATION_NVP(uncompressed_size)
+       >> BOOST_SERIALIZATION_NVP(compressed_text);
+
+    text.resize(uncompressed_size);
+    uLongf decompressed_size = static_cast<uLongf>(uncompressed_size);
+    const int result = uncompress(reinterpret_cast<Bytef*>(text.data()), &decompressed_size,
+                                  reinterpret_cast<const Bytef*>(compressed_text.data()),
+                                  static_cast<uLong>(compressed_text.size()));
+    if (result != Z_OK || decompressed_size != uncompressed_size)
+        throw std::runtime_error("DeserializeCompressible: corrupt compressed text, zlib error " +
+                                 std::to_string(result));
+}
+
+template FO_COMMON_API void DeserializeCompressible<freeorion_bin_iarchive>(freeorion_bin_iarchive&, std::string&);
+
+
 template<typename Archive>
 void serialize(Archive& ar, PreviewInformation& pi, unsigned int const version)
 {
@@ -10,6 +10,10 @@
 #include <boost/uuid/nil_generator.hpp>
 #include "Logger.h"
 
+#include <cstdint>
+#include <stdexcept>
+#include <typeinfo>
+
 
 BOOST_CLASS_EXPORT(Order)
 BOOST_CLASS_VERSION(Order, 1)
@@ -286,6 +290,190 @@ void ForgetOrder::serialize(Archive& ar, const unsigned int version)
         & BOOST_SERIALIZATION_NVP(m_object_id);
 }
 
+namespace {
+    /** The kinds of record in the compact encoding of an OrderSet, each of
+        which holds all the orders of one type of one empire. */
+    enum class CompactRecord : unsigned char {
+        FLEET_MOVES = 1,
+        AGGRESSION = 2
+    };
+
+    /** Appends @p value to @p bytes as a zigzag varint, in which ids and
+        other numbers near zero, including INVALID_OBJECT_ID, take a byte or
+        two rather than four. */
+    void PutVarint(std::string& bytes, int value) {
+        auto zigzag = (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+        while (zigzag >= 0x80) {
+            bytes.push_back(static_cast<char>((zigzag & 0x7F) | 0x80));
+            zigzag >>= 7;
+        }
+        bytes.push_back(static_cast<char>(zigzag));
+    }
+
+    /** Reads the values written by PutVarint() from a string. */
+    class VarintReader {
+    public:
+        explicit VarintReader(const std::string& bytes) :
+            m_bytes(bytes)
+        {}
+
+        bool AtEnd() const
+        { return m_pos >= m_bytes.size(); }
+
+        int Get() {
+            std::uint32_t zigzag = 0;
+            for (unsigned int shift = 0; shift < 32; shift += 7) {
+                if (AtEnd())
+                    throw std::runtime_error("compact order encoding ends within a number");
+                const auto byte = static_cast<unsigned char>(m_bytes[m_pos++]);
+                zigzag |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return static_cast<int>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            }
+            throw std::runtime_error("compact order encoding has a number that is too long");
+        }
+
+        /** Returns a count of items that follow, which each take at least a
+            byte, so that a corrupt count can't cause a huge allocation. */
+        std::size_t GetCount() {
+            const int count = Get();
+            if (count < 0 || static_cast<std::size_t>(count) > m_bytes.size() - m_pos)
+                throw std::runtime_error("compact order encoding has an invalid count");
+            return static_cast<std::size_t>(count);
+        }
+
+    private:
+        const std::string&  m_bytes;
+        std::size_t         m_pos = 0;
+    };
+}
+
+std::string OrderSet::EncodeCompactOrders(const OrderMap& orders, OrderMap& other_orders)
+{
+    // the orders of each type are batched by empire, and written in order of
+    // their keys, as differences from the key before
+    std::map<int, std::vector<std::pair<int, const FleetMoveOrder*>>> fleet_moves;
+    std::map<int, std::vector<std::pair<int, const AggressiveOrder*>>> aggressions;
+    for (const auto& [key, order] : orders) {
+        if (!order) {
+            other_orders.emplace(key, order);
+        } else if (typeid(*order) == typeid(FleetMoveOrder)) {
+            const auto* move = static_cast<const FleetMoveOrder*>(order.get());
+            fleet_moves[move->EmpireID()].emplace_back(key, move);
+        } else if (typeid(*order) == typeid(AggressiveOrder)) {
+            const auto* aggression = static_cast<const AggressiveOrder*>(order.get());
+            aggressions[aggression->EmpireID()].emplace_back(key, aggression);
+        } else {
+            other_orders.emplace(key, order);
+        }
+    }
+
+    std::string bytes;
+    for (const auto& [empire_id, moves] : fleet_moves) {
+        bytes.push_back(static_cast<char>(CompactRecord::FLEET_MOVES));
+        PutVarint(bytes, empire_id);
+        PutVarint(bytes, static_cast<int>(moves.size()));
+        int previous_key = 0;
+        for (const auto& [key, move] : moves) {
+            PutVarint(bytes, key - previous_key);
+            previous_key = key;
+            PutVarint(bytes, move->m_fleet);
+            PutVarint(bytes, move->m_dest_system);
+            PutVarint(bytes, static_cast<int>(move->m_route.size()));
+            for (int system_id : move->m_route)
+                PutVarint(bytes, system_id);
+            PutVarint(bytes, move->m_append);
+        }
+    }
+    for (const auto& [empire_id, orders_of_empire] : aggressions) {
+        bytes.push_back(static_cast<char>(CompactRecord::AGGRESSION));
+        PutVarint(bytes, empire_id);
+        PutVarint(bytes, static_cast<int>(orders_of_empire.size()));
+        int previous_key = 0;
+        for (const auto& [key, aggression] : orders_of_empire) {
+            PutVarint(bytes, key - previous_key);
+            previous_key = key;
+            PutVarint(bytes, aggression->m_object_id);
+            PutVarint(bytes, static_cast<int>(aggression->m_aggression));
+        }
+    }
+    return bytes;
+}
+
+void OrderSet::DecodeCompactOrders(const std::string& compact_orders, OrderMap& orders)
+{
+    VarintReader reader(compact_orders);
+    while (!reader.AtEnd()) {
+        const auto record = static_cast<CompactRecord>(reader.Get());
+        const int empire_id = reader.Get();
+        const auto count = reader.GetCount();
+        int key = 0;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            key += reader.Get();
+            std::shared_ptr<Order> order;
+
+            if (record == CompactRecord::FLEET_MOVES) {
+                std::shared_ptr<FleetMoveOrder> move(new FleetMoveOrder());
+                move->m_fleet = reader.Get();
+                move->m_dest_system = reader.Get();
+                move->m_route.resize(reader.GetCount());
+                for (auto& system_id : move->m_route)
+                    system_id = reader.Get();
+                move->m_append = reader.Get() != 0;
+                order = std::move(move);
+
+            } else if (record == CompactRecord::AGGRESSION) {
+                std::shared_ptr<AggressiveOrder> aggression(new AggressiveOrder());
+                aggression->m_object_id = reader.Get();
+                aggression->m_aggression = static_cast<FleetAggression>(reader.Get());
+                order = std::move(aggression);
+
+            } else {
+                throw std::runtime_error("compact order encoding has an unknown record type");
+            }
+
+            order->m_empire = empire_id;
+            orders[key] = std::move(order);
+        }
+    }
+}
+
+template <typename Archive>
+void OrderSet::serialize(Archive& ar, const unsigned int version)
+{
+    if constexpr (IsBinaryArchive<Archive>) {
+        if (version >= 1) {
+            // AIs issue thousands of orders a turn, mostly of a few types,
+            // each of which would otherwise be written with the class id and
+            // tracking of a polymorphic pointer, and its ids at full size
+            std::string compact_orders;
+            OrderMap other_orders;
+            if constexpr (Archive::is_saving::value)
+                compact_orders = EncodeCompactOrders(m_orders, other_orders);
+            ar  & BOOST_SERIALIZATION_NVP(compact_orders)
+                & BOOST_SERIALIZATION_NVP(other_orders);
+            if constexpr (Archive::is_loading::value) {
+                m_orders = std::move(other_orders);
+                DecodeCompactOrders(compact_orders, m_orders);
+                m_last_added_orders.clear();
+                m_last_deleted_orders.clear();
+            }
+            return;
+        }
+    }
+
+    ar  & BOOST_SERIALIZATION_NVP(m_orders);
+    if (Archive::is_loading::value) {
+        m_last_added_orders.clear();
+        m_last_deleted_orders.clear();
+    }
+}
+
+template void OrderSet::serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, const unsigned int);
+template void OrderSet::serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, const unsigned int);
+template void OrderSet::serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, const unsigned int);
+template void OrderSet::serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, const unsigned int);
+
 template <typename Archive>
 void Serialize(Archive& oa, const OrderSet& order_set)
 { oa << BOOST_SERIALIZATION_NVP(order_set); }
@@ -1,6 +1,7 @@
 #include "Serialize.h"
 
 #include "Logger.h"
+#include "ObjectDeltaBase.h"
 #include "Serialize.ipp"
 
 #include "../universe/IDAllocator.h"
@@ -21,9 +22,14 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/nil_generator.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
 BOOST_CLASS_EXPORT(Field)
 BOOST_CLASS_EXPORT(Universe)
-BOOST_CLASS_VERSION(Universe, 1)
+BOOST_CLASS_VERSION(Universe, 3)
 
 template <typename Archive>
 void serialize(Archive& ar, PopCenter& p, unsigned int const version)
@@ -54,6 +60,111 @@ template void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, Resourc
 template void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, ResourceCenter&, unsigned int const);
 
 
+// written in the same format as the std::map<int, Visibility> that was used
+// previously, so that older saves can still be loaded
+template <typename Archive>
+void serialize(Archive& ar, ObjectVisibilityTable& table, unsigned int const version)
+{
+    using namespace boost::serialization;
+    using Entry = std::map<int, Visibility>::value_type;
+
+    if constexpr (Archive::is_loading::value) {
+        std::map<int, Visibility> entries;
+        load_map_collection(ar, entries);
+        table.clear();
+        for (const auto& [object_id, vis] : entries)
+            table[object_id] = vis;
+
+    } else {
+        const collection_size_type count(table.size());
+        const item_version_type item_version(boost::serialization::version<Entry>::value);
+        ar  << make_nvp("count", count)
+            << make_nvp("item_version", item_version);
+        for (const auto& [object_id, vis] : table) {
+            const Entry entry{object_id, vis};
+            ar << make_nvp("item", entry);
+        }
+    }
+}
+
+template void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, ObjectVisibilityTable&, unsigned int const);
+template void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, ObjectVisibilityTable&, unsigned int const);
+template void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, ObjectVisibilityTable&, unsigned int const);
+template void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, ObjectVisibilityTable&, unsigned int const);
+
+
+// written as the chunks of the bitmap, each the high 16 bits of its ids and
+// either the sorted low 16 bits of its ids or its bitmap words
+template <typename Archive>
+void serialize(Archive& ar, ObjectIDBitmap& ids, unsigned int const version)
+{
+    using namespace boost::serialization;
+
+    std::uint32_t num_chunks = static_cast<std::uint32_t>(ids.m_chunks.size());
+    ar  & make_nvp("num_chunks", num_chunks);
+    if constexpr (Archive::is_loading::value) {
+        if (num_chunks > ObjectIDBitmap::CHUNK_BITS)
+            throw std::runtime_error("ObjectIDBitmap has " + std::to_string(num_chunks) + " chunks");
+        ids.clear();
+        ids.m_chunks.resize(num_chunks);
+    }
+
+    for (auto& chunk : ids.m_chunks) {
+        ar  & make_nvp("high", chunk.high)
+            & make_nvp("values", chunk.values)
+            & make_nvp("words", chunk.words);
+    }
+
+    if constexpr (Archive::is_loading::value) {
+        for (std::size_t chunk_idx = 0; chunk_idx < ids.m_chunks.size(); ++chunk_idx) {
+            auto& chunk = ids.m_chunks[chunk_idx];
+            if (chunk_idx > 0 && chunk.high <= ids.m_chunks[chunk_idx - 1].high)
+                throw std::runtime_error("ObjectIDBitmap chunks are not in increasing order");
+
+            if (chunk.IsBitmap()) {
+                if (chunk.words.size() != ObjectIDBitmap::NUM_WORDS || !chunk.values.empty())
+                    throw std::runtime_error("ObjectIDBitmap chunk has " + std::to_string(chunk.words.size()) +
+                                             " bitmap words and " + std::to_string(chunk.values.size()) + " values");
+                for (const auto word : chunk.words)
+                    chunk.cardinality += ObjectIDBitmap::PopCount(word);
+            } else {
+                if (std::adjacent_find(chunk.values.begin(), chunk.values.end(), std::greater_equal<>()) != chunk.values.end())
+                    throw std::runtime_error("ObjectIDBitmap chunk values are not in increasing order");
+                chunk.cardinality = static_cast<std::uint32_t>(chunk.values.size());
+            }
+            if (chunk.cardinality == 0)
+                throw std::runtime_error("ObjectIDBitmap chunk is empty");
+            ids.m_size += chunk.cardinality;
+        }
+    }
+}
+
+template void serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive&, ObjectIDBitmap&, unsigned int const);
+template void serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive&, ObjectIDBitmap&, unsigned int const);
+template void serialize<freeorion_bin_iarchive>(freeorion_bin_iarchive&, ObjectIDBitmap&, unsigned int const);
+template void serialize<freeorion_xml_iarchive>(freeorion_xml_iarchive&, ObjectIDBitmap&, unsigned int const);
+
+namespace {
+    // before Universe version 3, destroyed and stale object ids were saved
+    // as std::set<int>
+    template <typename Archive>
+    void LoadLegacyObjectIDs(Archive& ar, const char* name, ObjectIDBitmap& ids) {
+        std::set<int> legacy_ids;
+        ar  & boost::serialization::make_nvp(name, legacy_ids);
+        ids = ObjectIDBitmap(legacy_ids.begin(), legacy_ids.end());
+    }
+
+    template <typename Archive>
+    void LoadLegacyObjectIDs(Archive& ar, const char* name, std::map<int, ObjectIDBitmap>& empire_ids) {
+        std::map<int, std::set<int>> legacy_empire_ids;
+        ar  & boost::serialization::make_nvp(name, legacy_empire_ids);
+        empire_ids.clear();
+        for (const auto& [empire_id, legacy_ids] : legacy_empire_ids)
+            empire_ids.emplace(empire_id, ObjectIDBitmap(legacy_ids.begin(), legacy_ids.end()));
+    }
+}
+
+
 template <typename Archive>
 void serialize(Archive& ar, ObjectMap& objmap, unsigned int const version)
 {
@@ -64,6 +175,121 @@ void serialize(Archive& ar, ObjectMap& objmap, unsigned int const version)
         objmap.CopyObjectsToSpecializedMaps();
 }
 
+namespace {
+    //! Set while a Universe is serialized by SerializeDelta or DeserializeDelta
+    struct DeltaEncoding {
+        ObjectDeltaBase&    base;
+        bool                use_delta = false;
+        int                 turn = -1;
+    };
+    thread_local DeltaEncoding* delta_encoding = nullptr;
+
+    //! Set while a Universe is serialized by SerializeWithoutKnownObjects or
+    //! DeserializeWithoutKnownObjects, to leave out empires' latest known objects
+    thread_local bool known_objects_separate = false;
+
+    std::string SerializedObjectData(const std::shared_ptr<UniverseObject>& obj) {
+        std::ostringstream os;
+        {
+            freeorion_bin_oarchive oa(os, boost::archive::no_header);
+            oa << BOOST_SERIALIZATION_NVP(obj);
+        }
+        return os.str();
+    }
+
+    std::shared_ptr<UniverseObject> ObjectFromSerializedData(const std::string& data) {
+        std::shared_ptr<UniverseObject> obj;
+        std::istringstream is(data);
+        freeorion_bin_iarchive ia(is, boost::archive::no_header);
+        ia >> BOOST_SERIALIZATION_NVP(obj);
+        return obj;
+    }
+
+    template <typename Archive>
+    void SaveObjectsDelta(Archive& ar, const ObjectMap& objects, DeltaEncoding& encoding)
+    {
+        using namespace boost::serialization;
+
+        auto& base = encoding.base;
+        std::map<int, std::size_t> object_hashes;
+        std::vector<int> unchanged_object_ids;
+        ObjectMap changed_objects;
+
+        for (auto& obj : objects.all()) {
+            const auto hash = std::hash<std::string>{}(SerializedObjectData(obj));
+            object_hashes.emplace(obj->ID(), hash);
+
+            auto base_it = base.object_hashes.find(obj->ID());
+            if (encoding.use_delta && base_it != base.object_hashes.end() && base_it->second == hash)
+                unchanged_object_ids.push_back(obj->ID());
+            else
+                changed_objects.insert(obj);
+        }
+
+        ar  << make_nvp("unchanged_object_ids", unchanged_object_ids)
+            << make_nvp("objects", changed_objects);
+        DebugLogger() << "Universe::serialize : serializing " << changed_objects.size()
+                      << " changed objects and " << unchanged_object_ids.size() << " unchanged object ids";
+
+        base.object_hashes.swap(object_hashes);
+        base.turn = encoding.turn;
+        base.acknowledged = false;
+    }
+
+    /** Loads objects encoded by SaveObjectsDelta.  Unchanged objects that are
+        still as they were received in the previous update are taken from
+        \a previous_objects, so they stay the same objects, and the ids of the
+        others are returned. */
+    template <typename Archive>
+    std::vector<int> LoadObjectsDelta(Archive& ar, ObjectMap& objects, DeltaEncoding& encoding,
+                                      ObjectMap& previous_objects)
+    {
+        using namespace boost::serialization;
+
+        auto& base = encoding.base;
+        std::vector<int> unchanged_object_ids;
+        ar  >> make_nvp("unchanged_object_ids", unchanged_object_ids)
+            >> make_nvp("objects", objects);
+        DebugLogger() << "Universe::serialize : deserializing " << objects.size()
+                      << " changed objects and " << unchanged_object_ids.size() << " unchanged object ids";
+
+        std::vector<int> updated_object_ids;
+        std::map<int, std::string> object_data;
+        for (const auto& obj : objects.all()) {
+            object_data.emplace(obj->ID(), SerializedObjectData(obj));
+            updated_object_ids.push_back(obj->ID());
+        }
+
+        std::size_t reused_count = 0;
+        for (int object_id : unchanged_object_ids) {
+            auto base_it = base.object_data.find(object_id);
+            if (base_it == base.object_data.end()) {
+                base.Clear();
+                throw std::runtime_error("Turn update has unchanged object " + std::to_string(object_id) +
+                                         " that is not in the previous update");
+            }
+            // orders and meter estimates may have changed the previous object
+            // since it was received
+            auto previous_obj = previous_objects.get(object_id);
+            if (previous_obj && SerializedObjectData(previous_obj) == base_it->second) {
+                objects.insert(std::move(previous_obj));
+                ++reused_count;
+            } else {
+                objects.insert(ObjectFromSerializedData(base_it->second));
+                updated_object_ids.push_back(object_id);
+            }
+            object_data.emplace(object_id, std::move(base_it->second));
+        }
+        DebugLogger() << "Universe::serialize : kept " << reused_count << " unchanged objects";
+
+        base.object_data.swap(object_data);
+        base.turn = encoding.turn;
+
+        std::sort(updated_object_ids.begin(), updated_object_ids.end());
+        return updated_object_ids;
+    }
+}
+
 template <typename Archive>
 void serialize(Archive& ar, Universe& u, unsigned int const version)
 {
@@ -71,7 +297,7 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
 
     std::unique_ptr<ObjectMap>                objects_ptr = std::make_unique<ObjectMap>();
     ObjectMap& objects =                     *objects_ptr;
-    std::set<int>                             destroyed_object_ids;
+    ObjectIDBitmap                            destroyed_object_ids;
     Universe::EmpireObjectMap                 empire_latest_known_objects;
     Universe::EmpireObjectVisibilityMap       empire_object_visibility;
     Universe::EmpireObjectVisibilityTurnMap   empire_object_visibility_turns;
@@ -90,7 +316,8 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
         timer.EnterSection("collecting data");
         u.GetObjectsToSerialize(              objects,                            GlobalSerializationEncodingForEmpire());
         u.GetDestroyedObjectsToSerialize(     destroyed_object_ids,               GlobalSerializationEncodingForEmpire());
-        u.GetEmpireKnownObjectsToSerialize(   empire_latest_known_objects,        GlobalSerializationEncodingForEmpire());
+        if (!known_objects_separate)
+            u.GetEmpireKnownObjectsToSerialize(empire_latest_known_objects,       GlobalSerializationEncodingForEmpire());
         u.GetEmpireObjectVisibilityMap(       empire_object_visibility,           GlobalSerializationEncodingForEmpire());
         u.GetEmpireObjectVisibilityTurnMap(   empire_object_visibility_turns,     GlobalSerializationEncodingForEmpire());
         u.GetEmpireKnownDestroyedObjects(     empire_known_destroyed_object_ids,  GlobalSerializationEncodingForEmpire());
@@ -99,10 +326,20 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
         timer.EnterSection("");
     }
 
+    std::unique_ptr<ObjectMap> previous_objects = std::make_unique<ObjectMap>();
     if (Archive::is_loading::value) {
+        // keep the objects, which a delta-encoded update reuses if they are
+        // unchanged, and the pathfinder, which only rebuilds its graphs if the
+        // systems or starlanes have changed
+        if (delta_encoding)
+            previous_objects.swap(u.m_objects);
+        auto pathfinder = u.m_pathfinder;
+
         // clean up any existing dynamically allocated contents before replacing
         // containers with deserialized data.
         u.Clear();
+
+        u.m_pathfinder = std::move(pathfinder);
     }
 
     ar  & make_nvp("m_universe_width", u.m_universe_width);
@@ -119,8 +356,13 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
     timer.EnterSection("vis / known");
     ar  & make_nvp("empire_object_visibility", empire_object_visibility);
     ar  & make_nvp("empire_object_visibility_turns", empire_object_visibility_turns);
-    ar  & make_nvp("empire_known_destroyed_object_ids", empire_known_destroyed_object_ids);
-    ar  & make_nvp("empire_stale_knowledge_object_ids", empire_stale_knowledge_object_ids);
+    if (Archive::is_loading::value && version < 3) {
+        LoadLegacyObjectIDs(ar, "empire_known_destroyed_object_ids", empire_known_destroyed_object_ids);
+        LoadLegacyObjectIDs(ar, "empire_stale_knowledge_object_ids", empire_stale_knowledge_object_ids);
+    } else {
+        ar  & make_nvp("empire_known_destroyed_object_ids", empire_known_destroyed_object_ids);
+        ar  & make_nvp("empire_stale_knowledge_object_ids", empire_stale_knowledge_object_ids);
+    }
     DebugLogger() << "Universe::serialize : " << serializing_label
                   << " empire object visibility for " << empire_object_visibility.size() << ", "
                   << empire_object_visibility_turns.size() << ", "
@@ -137,14 +379,28 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
     }
 
     timer.EnterSection("objects");
-    ar  & make_nvp("objects", objects);
+    if (!delta_encoding)
+        ar  & make_nvp("objects", objects);
+    else if constexpr (Archive::is_saving::value)
+        SaveObjectsDelta(ar, objects, *delta_encoding);
+    else
+        u.m_objects_updated_by_last_load = LoadObjectsDelta(ar, objects, *delta_encoding, *previous_objects);
     if (Archive::is_loading::value) {
+        if (!delta_encoding) {
+            u.m_objects_updated_by_last_load.clear();
+            for (const auto& obj : objects.all())
+                u.m_objects_updated_by_last_load.push_back(obj->ID());
+            std::sort(u.m_objects_updated_by_last_load.begin(), u.m_objects_updated_by_last_load.end());
+        }
         u.m_objects.swap(objects_ptr);
     }
     DebugLogger() << "Universe::" << serializing_label << " " << u.m_objects->size() << " objects";
 
     timer.EnterSection("destroyed ids");
-    ar  & make_nvp("destroyed_object_ids", destroyed_object_ids);
+    if (Archive::is_loading::value && version < 3)
+        LoadLegacyObjectIDs(ar, "destroyed_object_ids", destroyed_object_ids);
+    else
+        ar  & make_nvp("destroyed_object_ids", destroyed_object_ids);
     DebugLogger() << "Universe::serialize : " << serializing_label << " " << destroyed_object_ids.size() << " destroyed object ids";
     if (Archive::is_loading::value) {
         u.m_destroyed_object_ids.swap(destroyed_object_ids);
@@ -187,8 +443,21 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
 
     timer.EnterSection("stats");
     if (Archive::is_saving::value && GlobalSerializationEncodingForEmpire() != ALL_EMPIRES && (!GetOptionsDB().Get<bool>("network.server.publish-statistics"))) {
-        std::map<std::string, std::map<int, std::map<int, double>>> dummy_stat_records;
+        StatRecords dummy_stat_records;
         ar  & boost::serialization::make_nvp("m_stat_records", dummy_stat_records);
+    } else if (Archive::is_loading::value && version < 2) {
+        std::map<std::string, std::map<int, std::map<int, double>>> stat_records;
+        ar  & make_nvp("m_stat_records", stat_records);
+        u.m_stat_records.clear();
+        for (const auto& [stat_name, empire_values] : stat_records) {
+            auto& empire_series = u.m_stat_records[stat_name];
+            for (const auto& [empire_id, turn_values] : empire_values) {
+                auto& series = empire_series[empire_id];
+                for (const auto& [turn, value] : turn_values)
+                    series.Set(turn, value);
+            }
+        }
+        DebugLogger() << "Universe::serialize : " << serializing_label << " " << u.m_stat_records.size() << " types of statistic";
     } else {
         ar  & make_nvp("m_stat_records", u.m_stat_records);
         DebugLogger() << "Universe::serialize : " << serializing_label << " " << u.m_stat_records.size() << " types of statistic";
@@ -209,7 +478,48 @@ void serialize(Archive& ar, Universe& u, unsigned int const version)
 }
 
 BOOST_CLASS_EXPORT(UniverseObject)
-BOOST_CLASS_VERSION(UniverseObject, 2)
+BOOST_CLASS_VERSION(UniverseObject, 3)
+
+namespace {
+    /** Serializes \a meters as one array of meter types and one array of
+      * (current, initial) value pairs, which binary archives write and read
+      * in bulk rather than pair by pair through the map serializer. */
+    template <typename Archive>
+    void SerializeMeterArrays(Archive& ar, UniverseObject::MeterMap& meters)
+    {
+        using namespace boost::serialization;
+
+        std::vector<int8_t> meter_types;
+        std::vector<float> meter_values;
+        if constexpr (Archive::is_saving::value) {
+            meter_types.reserve(meters.size());
+            meter_values.reserve(meters.size() * 2);
+            for (const auto& [type, meter] : meters) {
+                meter_types.push_back(static_cast<int8_t>(type));
+                meter_values.push_back(meter.Current());
+                meter_values.push_back(meter.Initial());
+            }
+        }
+
+        ar  & make_nvp("meter_types", meter_types)
+            & make_nvp("meter_values", meter_values);
+
+        if constexpr (Archive::is_loading::value) {
+            if (meter_values.size() != meter_types.size() * 2)
+                throw std::runtime_error("UniverseObject meters have " + std::to_string(meter_types.size()) +
+                                         " types but " + std::to_string(meter_values.size()) + " values");
+            meters.clear();
+            meters.reserve(meter_types.size());
+            for (std::size_t idx = 0; idx < meter_types.size(); ++idx) {
+                const auto type = static_cast<MeterType>(meter_types[idx]);
+                if (!MeterMap::ValidType(type))
+                    throw std::runtime_error("UniverseObject meters have invalid meter type " +
+                                             std::to_string(meter_types[idx]));
+                meters.emplace(type, Meter(meter_values[2*idx], meter_values[2*idx + 1]));
+            }
+        }
+    }
+}
 
 template <typename Archive>
 void serialize(Archive& ar, UniverseObject& o, unsigned int const version)
@@ -228,13 +538,13 @@ void serialize(Archive& ar, UniverseObject& o, unsigned int const version)
         ar  & make_nvp("m_meters", meter_map);
         o.m_meters.reserve(meter_map.size());
         o.m_meters.insert(meter_map.begin(), meter_map.end());
+    } else if (version < 3) {
+        flat_map<MeterType, Meter> meter_map;
+        ar  & make_nvp("m_meters", meter_map);
+        o.m_meters.reserve(meter_map.size());
+        o.m_meters.insert(meter_map.begin(), meter_map.end());
     } else {
-        ar  & make_nvp("m_meters", o.m_meters);
-
-        // loading the internal vector, like so, was no faster than loading the map
-        //auto meters{m_meters.extract_sequence()};
-        //ar  & make_nvp("meters", o.meters);
-        //m_meters.adopt_sequence(std::move(meters));
+        SerializeMeterArrays(ar, o.m_meters);
     }
     ar  & make_nvp("m_created_on_turn", o.m_created_on_turn);
 }
@@ -399,9 +709,18 @@ void serialize(Archive& ar, Ship& obj, unsigned int const version)
         & make_nvp("m_ordered_scrapped", obj.m_ordered_scrapped)
         & make_nvp("m_ordered_colonize_planet_id", obj.m_ordered_colonize_planet_id)
         & make_nvp("m_ordered_invade_planet_id", obj.m_ordered_invade_planet_id)
-        & make_nvp("m_ordered_bombard_planet_id", obj.m_ordered_bombard_planet_id)
-        & make_nvp("m_part_meters", obj.m_part_meters)
-        & make_nvp("m_species_name", obj.m_species_name)
+        & make_nvp("m_ordered_bombard_planet_id", obj.m_ordered_bombard_planet_id);
+
+    // part meters are archived keyed by meter type and part name, as before
+    // they were stored densely, so that saves stay compatible
+    PartMeterMap::MapType part_meters;
+    if constexpr (Archive::is_saving::value)
+        part_meters = obj.m_part_meters.ToMap();
+    ar  & make_nvp("m_part_meters", part_meters);
+    if constexpr (Archive::is_loading::value)
+        obj.m_part_meters.Assign(part_meters);
+
+    ar  & make_nvp("m_species_name", obj.m_species_name)
         & make_nvp("m_produced_by_empire_id", obj.m_produced_by_empire_id)
         & make_nvp("m_arrived_on_turn", obj.m_arrived_on_turn);
     if (version >= 1) {
@@ -515,6 +834,107 @@ void Serialize(Archive& oa, const Universe& universe)
 template FO_COMMON_API void Serialize<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe);
 template FO_COMMON_API void Serialize<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe);
 
+template <typename Archive>
+void SerializeWithoutKnownObjects(Archive& oa, const Universe& universe)
+{
+    known_objects_separate = true;
+    try {
+        oa << BOOST_SERIALIZATION_NVP(universe);
+    } catch (...) {
+        known_objects_separate = false;
+        throw;
+    }
+    known_objects_separate = false;
+}
+template FO_COMMON_API void SerializeWithoutKnownObjects<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe);
+template FO_COMMON_API void SerializeWithoutKnownObjects<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe);
+
+template <typename Archive>
+void SerializeEmpireKnownObjects(Archive& oa, const Universe& universe, int empire_id)
+{
+    const ObjectMap& objects = universe.EmpireKnownObjects(empire_id);
+    oa << BOOST_SERIALIZATION_NVP(objects);
+}
+template FO_COMMON_API void SerializeEmpireKnownObjects<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe, int empire_id);
+template FO_COMMON_API void SerializeEmpireKnownObjects<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe, int empire_id);
+
+namespace {
+    //! Writes whether the following objects are encoded against @p delta_base,
+    //! which they can only be if it records an update, and the turn of that
+    //! update. Returns whether they are.
+    template <typename Archive>
+    bool SaveDeltaHeader(Archive& oa, const ObjectDeltaBase& delta_base, bool use_delta) {
+        use_delta = use_delta && delta_base.turn != -1;
+        int base_turn = delta_base.turn;
+        oa << BOOST_SERIALIZATION_NVP(use_delta)
+           << BOOST_SERIALIZATION_NVP(base_turn);
+        return use_delta;
+    }
+
+    //! Reads the header written by SaveDeltaHeader, and returns whether the
+    //! following objects are encoded against @p delta_base, which must then
+    //! record the same update they were encoded against.
+    template <typename Archive>
+    bool LoadDeltaHeader(Archive& ia, ObjectDeltaBase& delta_base) {
+        bool use_delta = false;
+        int base_turn = -1;
+        ia >> BOOST_SERIALIZATION_NVP(use_delta)
+           >> BOOST_SERIALIZATION_NVP(base_turn);
+        if (use_delta && base_turn != delta_base.turn) {
+            delta_base.Clear();
+            throw std::runtime_error("Turn update is relative to turn " + std::to_string(base_turn) +
+                                     " but the previous update received was for turn " + std::to_string(delta_base.turn));
+        }
+        return use_delta;
+    }
+}
+
+template <typename Archive>
+void SerializeDelta(Archive& oa, const Universe& universe, ObjectDeltaBase& delta_base,
+                    bool use_delta, int turn)
+{
+    use_delta = SaveDeltaHeader(oa, delta_base, use_delta);
+
+    DeltaEncoding encoding{delta_base, use_delta, turn};
+    delta_encoding = &encoding;
+    try {
+        oa << BOOST_SERIALIZATION_NVP(universe);
+    } catch (...) {
+        delta_encoding = nullptr;
+        throw;
+    }
+    delta_encoding = nullptr;
+}
+template FO_COMMON_API void SerializeDelta<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+template FO_COMMON_API void SerializeDelta<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+
+template <typename Archive>
+void SerializeDeltaWithoutKnownObjects(Archive& oa, const Universe& universe, ObjectDeltaBase& delta_base,
+                                       bool use_delta, int turn)
+{
+    known_objects_separate = true;
+    try {
+        SerializeDelta(oa, universe, delta_base, use_delta, turn);
+    } catch (...) {
+        known_objects_separate = false;
+        throw;
+    }
+    known_objects_separate = false;
+}
+template FO_COMMON_API void SerializeDeltaWithoutKnownObjects<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+template FO_COMMON_API void SerializeDeltaWithoutKnownObjects<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+
+template <typename Archive>
+void SerializeEmpireKnownObjectsDelta(Archive& oa, const Universe& universe, int empire_id,
+                                      ObjectDeltaBase& delta_base, bool use_delta, int turn)
+{
+    use_delta = SaveDeltaHeader(oa, delta_base, use_delta);
+    DeltaEncoding encoding{delta_base, use_delta, turn};
+    SaveObjectsDelta(oa, universe.EmpireKnownObjects(empire_id), encoding);
+}
+template FO_COMMON_API void SerializeEmpireKnownObjectsDelta<freeorion_bin_oarchive>(freeorion_bin_oarchive& oa, const Universe& universe, int empire_id, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+template FO_COMMON_API void SerializeEmpireKnownObjectsDelta<freeorion_xml_oarchive>(freeorion_xml_oarchive& oa, const Universe& universe, int empire_id, ObjectDeltaBase& delta_base, bool use_delta, int turn);
+
 template <typename Archive>
 void Serialize(Archive& oa, const std::map<int, std::shared_ptr<UniverseObject>>& objects)
 { oa << BOOST_SERIALIZATION_NVP(objects); }
@@ -527,6 +947,71 @@ void Deserialize(Archive& ia, Universe& universe)
 template FO_COMMON_API void Deserialize<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, Universe& universe);
 template FO_COMMON_API void Deserialize<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, Universe& universe);
 
+template <typename Archive>
+void DeserializeWithoutKnownObjects(Archive& ia, Universe& universe)
+{
+    known_objects_separate = true;
+    try {
+        ia >> BOOST_SERIALIZATION_NVP(universe);
+    } catch (...) {
+        known_objects_separate = false;
+        throw;
+    }
+    known_objects_separate = false;
+}
+template FO_COMMON_API void DeserializeWithoutKnownObjects<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, Universe& universe);
+template FO_COMMON_API void DeserializeWithoutKnownObjects<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, Universe& universe);
+
+template <typename Archive>
+void DeserializeEmpireKnownObjects(Archive& ia, ObjectMap& objects)
+{ ia >> BOOST_SERIALIZATION_NVP(objects); }
+template FO_COMMON_API void DeserializeEmpireKnownObjects<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, ObjectMap& objects);
+template FO_COMMON_API void DeserializeEmpireKnownObjects<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, ObjectMap& objects);
+
+template <typename Archive>
+void DeserializeDelta(Archive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn)
+{
+    const bool use_delta = LoadDeltaHeader(ia, delta_base);
+
+    DeltaEncoding encoding{delta_base, use_delta, turn};
+    delta_encoding = &encoding;
+    try {
+        ia >> BOOST_SERIALIZATION_NVP(universe);
+    } catch (...) {
+        delta_encoding = nullptr;
+        throw;
+    }
+    delta_encoding = nullptr;
+}
+template FO_COMMON_API void DeserializeDelta<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+template FO_COMMON_API void DeserializeDelta<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+
+template <typename Archive>
+void DeserializeDeltaWithoutKnownObjects(Archive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn)
+{
+    known_objects_separate = true;
+    try {
+        DeserializeDelta(ia, universe, delta_base, turn);
+    } catch (...) {
+        known_objects_separate = false;
+        throw;
+    }
+    known_objects_separate = false;
+}
+template FO_COMMON_API void DeserializeDeltaWithoutKnownObjects<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+template FO_COMMON_API void DeserializeDeltaWithoutKnownObjects<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, Universe& universe, ObjectDeltaBase& delta_base, int turn);
+
+template <typename Archive>
+void DeserializeEmpireKnownObjectsDelta(Archive& ia, ObjectMap& objects, ObjectDeltaBase& delta_base, int turn)
+{
+    const bool use_delta = LoadDeltaHeader(ia, delta_base);
+    DeltaEncoding encoding{delta_base, use_delta, turn};
+    ObjectMap no_previous_objects;
+    LoadObjectsDelta(ia, objects, encoding, no_previous_objects);
+}
+template FO_COMMON_API void DeserializeEmpireKnownObjectsDelta<freeorion_bin_iarchive>(freeorion_bin_iarchive& ia, ObjectMap& objects, ObjectDeltaBase& delta_base, int turn);
+template FO_COMMON_API void DeserializeEmpireKnownObjectsDelta<freeorion_xml_iarchive>(freeorion_xml_iarchive& ia, ObjectMap& objects, ObjectDeltaBase& delta_base, int turn);
+
 template <typename Archive>
 void Deserialize(Archive& ia, std::map<int, std::shared_ptr<UniverseObject>>& objects)
 { ia >> BOOST_SERIALIZATION_NVP(objects); }
@@ -547,6 +1032,19 @@ namespace serialization {
     void serialize(Archive& ar, flat_map<Key, Value>& m, const unsigned int file_version)
     { split_free(ar, m, file_version); }
 
+    // same archived format as std::set, so saves of either are interchangeable
+    template<class Archive, class Key>
+    void save(Archive& ar, const boost::container::flat_set<Key>& s, const unsigned int)
+    { stl::save_collection<Archive, boost::container::flat_set<Key>>(ar, s); }
+
+    template<class Archive, class Key>
+    void load(Archive& ar, boost::container::flat_set<Key>& s, const unsigned int)
+    { load_set_collection(ar, s); }
+
+    template<class Archive, class Key>
+    void serialize(Archive& ar, boost::container::flat_set<Key>& s, const unsigned int file_version)
+    { split_free(ar, s, file_version); }
+
 
     // Note: I tried loading the internal vector of a flat_map instead of
     //       loading it as a map and constructing elements on the stack.
@@ -2,6 +2,7 @@
 
 #include "i18n.h"
 #include "Logger.h"
+#include "MemoryUsage.h"
 #include "../universe/Building.h"
 #include "../universe/Planet.h"
 #include "../universe/System.h"
@@ -50,6 +51,9 @@ const std::string& SitRepEntry::GetDataString(const std::string& tag) const {
     return elem->second;
 }
 
+std::size_t SitRepEntry::HeapBytes() const
+{ return VarText::HeapBytes() + MemoryUsage::HeapBytes(m_icon) + MemoryUsage::HeapBytes(m_label); }
+
 std::string SitRepEntry::Dump() const {
     std::string retval = "SitRep template_string = \"" + m_template_string + "\"";
     for (const auto& variable : m_variables)
@@ -28,6 +28,7 @@ public:
     const std::string&  GetIcon() const         { return m_icon; }
     const std::string&  GetLabelString() const  { return m_label; }
     std::string         Dump() const;
+    std::size_t         HeapBytes() const;
 
 private:
     int         m_turn;
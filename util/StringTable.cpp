@@ -2,6 +2,7 @@
 
 #include "Logger.h"
 #include "Directories.h"
+#include "ScopedTimer.h"
 #include "../parse/Parse.h"
 
 #include <boost/filesystem/fstream.hpp>
@@ -28,23 +29,25 @@ StringTable::StringTable(const std::string& filename, std::shared_ptr<const Stri
 StringTable::~StringTable()
 {}
 
-bool StringTable::StringExists(const std::string& key) const {
-    std::scoped_lock lock(m_mutex);
-    return m_strings.count(key);
+bool StringTable::StringExists(const std::string& key) const
+{ return Find(key); }
+
+const std::string* StringTable::Find(std::string_view key) const {
+    auto it = m_index.find(key);
+    return it != m_index.end() ? it->second : nullptr;
 }
 
 const std::string& StringTable::operator[] (const std::string& key) const {
-    std::scoped_lock lock(m_mutex);
-
-    auto it = m_strings.find(key);
-    if (it != m_strings.end())
-        return it->second;
+    if (auto str = Find(key))
+        return *str;
 
+    std::scoped_lock lock(m_mutex);
     auto error = m_error_strings.insert(ERROR_STRING + key);
     return *(error.first);
 }
 
 void StringTable::Load(std::shared_ptr<const StringTable> fallback) {
+    ScopedTimer timer("StringTable::Load " + m_filename);
     std::scoped_lock lock(m_mutex);
 
     if (fallback && !fallback->m_initialized) {
@@ -151,6 +154,7 @@ void StringTable::Load(std::shared_ptr<const StringTable> fallback) {
         ErrorLogger() << "Last and prior keys matched: " << key << ", " << prev_key;
         std::cerr << "Exception caught regex parsing Stringtable: " << e.what() << std::endl;
         std::cerr << "Last and prior keys matched: " << key << ", " << prev_key << std::endl;
+        BuildIndex();
         m_initialized = true;
         return;
     }
@@ -262,5 +266,13 @@ void StringTable::Load(std::shared_ptr<const StringTable> fallback) {
         ErrorLogger() << "StringTable file \"" << m_filename << "\" is malformed around line " << std::count(file_contents.begin(), it, '\n');
     }
 
+    BuildIndex();
     m_initialized = true;
 }
+
+void StringTable::BuildIndex() {
+    m_index.clear();
+    m_index.reserve(m_strings.size());
+    for (const auto& [key, str] : m_strings)
+        m_index.emplace(key, &str);
+}
@@ -5,7 +5,9 @@
 //!     Declares the StringTable class.
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <mutex>
 #include <memory>
@@ -156,6 +158,15 @@ public:
     //!     True iff a translation with that key exists, false otherwise.
     bool StringExists(const std::string& key) const;
 
+    //! Returns the translation for @p key, if there is one.
+    //!
+    //! @param key
+    //!     The identifying key of a translation entry.
+    //!
+    //! @return
+    //!     The translation for @p key or nullptr if no translation was found.
+    const std::string* Find(std::string_view key) const;
+
     //! Returns the native language name of this StringTable.
     inline const std::string& Language() const
     { return m_language; }
@@ -175,6 +186,9 @@ private:
     //!     entries.
     void Load(std::shared_ptr<const StringTable> fallback = nullptr);
 
+    //! Indexes #m_strings in #m_index, once they are all loaded.
+    void BuildIndex();
+
     //! The filename this StringTable was loaded from.
     std::string m_filename;
 
@@ -184,6 +198,10 @@ private:
     //! Mapping of translation entry keys to translated strings.
     std::map<std::string, std::string> m_strings;
 
+    //! Hashed index of #m_strings, which is not modified after loading, for
+    //! lookups without locking or allocating a key.
+    std::unordered_map<std::string_view, const std::string*> m_index;
+
     //! Cache for missing translation keys to ensure the returned error
     //! reference string is not destroyed due local scope.
     mutable std::unordered_set<std::string> m_error_strings;
@@ -0,0 +1,224 @@
+#include "ThreadPool.h"
+
+#include "AppInterface.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    DeclareThreadSafeLogger(timer);
+
+    thread_local bool is_worker_thread = false;
+
+    double ToMilliseconds(std::chrono::nanoseconds duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); }
+}
+
+////////////////////////////////////////
+// ThreadPool                         //
+////////////////////////////////////////
+ThreadPool::ThreadPool(std::size_t num_threads)
+{ SetNumThreads(num_threads); }
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_target_num_threads = 0;
+    }
+    m_tasks_available.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+std::size_t ThreadPool::NumThreads() const {
+    std::scoped_lock lock(m_mutex);
+    return m_target_num_threads;
+}
+
+void ThreadPool::SetNumThreads(std::size_t num_threads) {
+    if (is_worker_thread)
+        return;
+    num_threads = std::max<std::size_t>(num_threads, 1);
+
+    std::scoped_lock resize_lock(m_resize_mutex);
+    if (num_threads == m_threads.size())
+        return;
+
+    {
+        std::scoped_lock lock(m_mutex);
+        m_target_num_threads = num_threads;
+    }
+
+    if (num_threads > m_threads.size()) {
+        m_threads.reserve(num_threads);
+        for (std::size_t idx = m_threads.size(); idx < num_threads; ++idx)
+            m_threads.emplace_back([this, idx]() { WorkerLoop(idx); });
+
+    } else {
+        // threads with indices past the new size exit when they notice
+        m_tasks_available.notify_all();
+        for (std::size_t idx = num_threads; idx < m_threads.size(); ++idx)
+            m_threads[idx].join();
+        m_threads.resize(num_threads);
+    }
+}
+
+void ThreadPool::Enqueue(Task task) {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_tasks_available.notify_one();
+}
+
+bool ThreadPool::RunQueuedTaskOf(const TaskBatch* batch) {
+    Task task;
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = std::find_if(m_tasks.begin(), m_tasks.end(),
+                               [batch](const Task& t) { return t.batch == batch; });
+        if (it == m_tasks.end())
+            return false;
+        task = std::move(*it);
+        m_tasks.erase(it);
+    }
+    Run(task);
+    return true;
+}
+
+void ThreadPool::WorkerLoop(std::size_t thread_idx) {
+    is_worker_thread = true;
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_tasks_available.wait(lock, [this, thread_idx]()
+                                   { return thread_idx >= m_target_num_threads || !m_tasks.empty(); });
+            if (thread_idx >= m_target_num_threads)
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        Run(task);
+    }
+}
+
+void ThreadPool::Run(Task& task) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    try {
+        task.function();
+    } catch (const std::exception& e) {
+        ErrorLogger() << "ThreadPool task threw exception: " << e.what();
+    } catch (...) {
+        ErrorLogger() << "ThreadPool task threw unknown exception";
+    }
+    const std::chrono::nanoseconds duration{std::chrono::high_resolution_clock::now() - start};
+    task.function = nullptr; // release captures before signalling completion
+    task.batch->TaskDone(task.label_idx, duration);
+}
+
+
+////////////////////////////////////////
+// TaskBatch                          //
+////////////////////////////////////////
+TaskBatch::TaskBatch(std::string name) :
+    TaskBatch(GetThreadPool(), std::move(name))
+{}
+
+TaskBatch::TaskBatch(ThreadPool& pool, std::string name) :
+    m_pool(pool),
+    m_name(std::move(name))
+{}
+
+TaskBatch::~TaskBatch()
+{ Wait(); }
+
+void TaskBatch::Post(std::function<void ()> task, const std::string& label) {
+    std::size_t label_idx = 0;
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = std::find_if(m_timings.begin(), m_timings.end(),
+                               [&label](const LabelTiming& lt) { return lt.label == label; });
+        label_idx = static_cast<std::size_t>(std::distance(m_timings.begin(), it));
+        if (it == m_timings.end())
+            m_timings.push_back(LabelTiming{label});
+        ++m_pending;
+    }
+    m_pool.Enqueue(ThreadPool::Task{std::move(task), this, label_idx});
+}
+
+void TaskBatch::Wait() {
+    while (true) {
+        {
+            std::scoped_lock lock(m_mutex);
+            if (m_pending == 0)
+                return;
+        }
+        // help out rather than idling, and so that nested batches can't
+        // deadlock by waiting on tasks that no free thread is available to run
+        if (!m_pool.RunQueuedTaskOf(this))
+            break;
+    }
+
+    // all remaining tasks are already running on worker threads
+    std::unique_lock lock(m_mutex);
+    m_all_done.wait(lock, [this]() { return m_pending == 0; });
+}
+
+std::vector<TaskBatch::LabelTiming> TaskBatch::Timings() const {
+    std::scoped_lock lock(m_mutex);
+    return m_timings;
+}
+
+void TaskBatch::LogTimings(std::chrono::microseconds threshold) const {
+    const auto timings = Timings();
+
+    std::chrono::nanoseconds total{0};
+    std::size_t count = 0;
+    for (const auto& lt : timings) {
+        total += lt.total;
+        count += lt.count;
+    }
+    if (total < threshold)
+        return;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << m_name << " tasks: " << count << " total: " << ToMilliseconds(total) << " ms";
+    for (const auto& lt : timings) {
+        ss << "\n    " << (lt.label.empty() ? "(unlabelled)" : lt.label)
+           << "  tasks: " << lt.count
+           << "  total: " << ToMilliseconds(lt.total) << " ms"
+           << "  longest: " << ToMilliseconds(lt.longest) << " ms";
+    }
+    DebugLogger(timer) << ss.str();
+}
+
+void TaskBatch::TaskDone(std::size_t label_idx, std::chrono::nanoseconds duration) {
+    // notify while locked, as a waiter that sees no pending tasks can return
+    // and destroy this batch as soon as the lock is released
+    std::scoped_lock lock(m_mutex);
+    auto& lt = m_timings[label_idx];
+    ++lt.count;
+    lt.total += duration;
+    lt.longest = std::max(lt.longest, duration);
+    if (--m_pending == 0)
+        m_all_done.notify_all();
+}
+
+
+////////////////////////////////////////
+// Free Functions                     //
+////////////////////////////////////////
+ThreadPool& GetThreadPool() {
+    auto num_threads = []() -> std::size_t {
+        if (IApp::GetApp())
+            return static_cast<std::size_t>(std::max(1, EffectsProcessingThreads()));
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    };
+    static ThreadPool pool(num_threads());
+    pool.SetNumThreads(num_threads());
+    return pool;
+}
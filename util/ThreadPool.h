@@ -0,0 +1,121 @@
+#ifndef _ThreadPool_h_
+#define _ThreadPool_h_
+
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Export.h"
+
+
+class TaskBatch;
+
+//! Pool of worker threads that persists between uses.
+//!
+//! Tasks are submitted to the pool in batches (see TaskBatch), rather than
+//! directly, so that the submitter can wait for just its own tasks to finish.
+//! A thread that is waiting for a batch also runs that batch's queued tasks
+//! itself, so waiting never leaves a thread idle while there is work for it,
+//! and tasks can safely submit and wait for batches of their own.
+//!
+//! Most code should use the process-wide pool returned by GetThreadPool()
+//! instead of creating its own pool, to avoid repeatedly creating and
+//! destroying threads.
+class FO_COMMON_API ThreadPool {
+public:
+    explicit ThreadPool(std::size_t num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] std::size_t NumThreads() const;
+
+    //! Starts or stops worker threads so that there are \a num_threads (at
+    //! least one) of them. Stopped threads finish their current task first.
+    //! Does nothing if called from a worker thread of any pool.
+    void SetNumThreads(std::size_t num_threads);
+
+private:
+    friend class TaskBatch;
+
+    struct Task {
+        std::function<void ()>  function;
+        TaskBatch*              batch = nullptr;
+        std::size_t             label_idx = 0;
+    };
+
+    void Enqueue(Task task);
+    bool RunQueuedTaskOf(const TaskBatch* batch);   //!< runs one queued task of \a batch, if any, on the calling thread
+    void WorkerLoop(std::size_t thread_idx);
+    static void Run(Task& task);
+
+    mutable std::mutex          m_mutex;
+    std::condition_variable     m_tasks_available;
+    std::deque<Task>            m_tasks;
+    std::vector<std::thread>    m_threads;
+    std::size_t                 m_target_num_threads = 0;
+    std::mutex                  m_resize_mutex;
+};
+
+//! A group of tasks submitted to a ThreadPool that can be waited on together.
+//!
+//! Records how long tasks took, grouped by a label passed when posting each
+//! task, which can be used to spot load imbalance between kinds of tasks.
+//! Destroying a batch waits for all its tasks to finish.
+class FO_COMMON_API TaskBatch {
+public:
+    struct LabelTiming {
+        std::string                 label;
+        std::size_t                 count = 0;
+        std::chrono::nanoseconds    total{0};
+        std::chrono::nanoseconds    longest{0};
+    };
+
+    //! Batch of tasks that will run on the process-wide pool, GetThreadPool()
+    explicit TaskBatch(std::string name = "");
+    TaskBatch(ThreadPool& pool, std::string name);
+    ~TaskBatch();
+
+    TaskBatch(const TaskBatch&) = delete;
+    TaskBatch& operator=(const TaskBatch&) = delete;
+
+    //! Queues \a task to be run by the pool. Exceptions thrown by \a task are
+    //! logged and otherwise ignored.
+    void Post(std::function<void ()> task, const std::string& label = "");
+
+    //! Blocks until all tasks posted to this batch so far have finished,
+    //! running queued tasks on the calling thread while waiting.
+    void Wait();
+
+    //! Timings of finished tasks, grouped by label, in order of first post.
+    [[nodiscard]] std::vector<LabelTiming> Timings() const;
+
+    //! Logs the timings for each label, if the batch's total task time is at least \a threshold.
+    void LogTimings(std::chrono::microseconds threshold = std::chrono::milliseconds(1)) const;
+
+private:
+    friend class ThreadPool;
+
+    void TaskDone(std::size_t label_idx, std::chrono::nanoseconds duration);
+
+    ThreadPool&                 m_pool;
+    const std::string           m_name;
+    mutable std::mutex          m_mutex;
+    std::condition_variable     m_all_done;
+    std::size_t                 m_pending = 0;
+    std::vector<LabelTiming>    m_timings;
+};
+
+//! Returns the process-wide ThreadPool, sized to EffectsProcessingThreads()
+//! as of the latest call.
+FO_COMMON_API ThreadPool& GetThreadPool();
+
+
+#endif
@@ -7,6 +7,7 @@
 #include "../Empire/Empire.h"
 #include "i18n.h"
 #include "Logger.h"
+#include "MemoryUsage.h"
 #include "AppInterface.h"
 
 #include <boost/xpressive/xpressive.hpp>
@@ -196,7 +197,7 @@ namespace {
     //! Looks up the given match in the Universe and returns the Universe
     //! entities value.
     struct Substitute {
-        Substitute(const std::map<std::string, std::string>& variables, bool& valid) :
+        Substitute(const boost::container::flat_map<std::string, std::string>& variables, bool& valid) :
             m_variables(variables),
             m_valid(valid)
         {}
@@ -227,7 +228,7 @@ namespace {
             return UserString("ERROR");
         }
 
-        const std::map<std::string, std::string>& m_variables;
+        const boost::container::flat_map<std::string, std::string>& m_variables;
         bool& m_valid;
     };
 }
@@ -295,6 +296,11 @@ std::vector<std::string> VarText::GetVariableTags() const {
     return retval;
 }
 
+std::size_t VarText::HeapBytes() const {
+    return MemoryUsage::HeapBytes(m_template_string) + MemoryUsage::HeapBytes(m_variables) +
+        MemoryUsage::HeapBytes(m_text);
+}
+
 void VarText::AddVariable(const std::string& tag, const std::string& data)
 { m_variables[tag] = data; }
 
@@ -302,6 +308,7 @@ void VarText::AddVariable(const std::string& tag, std::string&& data)
 { m_variables[tag] = std::move(data); }
 
 void VarText::AddVariables(std::vector<std::pair<std::string, std::string>>&& data) {
+    m_variables.reserve(m_variables.size() + data.size());
     for (auto& dat : data)
         m_variables.emplace(std::move(dat));
 }
@@ -318,6 +325,6 @@ void VarText::GenerateVarText() const {
     // get string into which to substitute variables
     std::string template_str = m_stringtable_lookup_flag ? UserString(m_template_string) : m_template_string;
 
-    xpr::sregex var = '%' >> (xpr::s1 = -+xpr::_w) >> !(':' >> (xpr::s2 = -+xpr::_w)) >> '%';
+    static const xpr::sregex var = '%' >> (xpr::s1 = -+xpr::_w) >> !(':' >> (xpr::s2 = -+xpr::_w)) >> '%';
     m_text = xpr::regex_replace(template_str, var, Substitute(m_variables, m_validated));
 }
@@ -6,10 +6,17 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <boost/container/flat_map.hpp>
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/map.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 #include "Export.h"
 
@@ -99,6 +106,10 @@ public:
     //! Return the variables available for substitution.
     std::vector<std::string> GetVariableTags() const;
 
+    //! Return the approximate number of bytes of memory allocated for the
+    //! template, variables and generated text.
+    std::size_t HeapBytes() const;
+
     //! Set the #m_template_string to the given @p template_string.
     //!
     //! @param  template_string  @see #m_template_string.
@@ -207,7 +218,10 @@ protected:
     bool m_stringtable_lookup_flag = false;
 
     //! Maps variable tags into values, which are used during text substitution.
-    std::map<std::string, std::string> m_variables;
+    //!
+    //! Kept in one sorted vector rather than a node per variable, as there are
+    //! many VarText in sitreps, each with only a few variables.
+    boost::container::flat_map<std::string, std::string> m_variables;
 
     //! #m_template_string with applied #m_variables substitute.
     mutable std::string m_text;
@@ -226,9 +240,27 @@ template <typename Archive>
 void VarText::serialize(Archive& ar, const unsigned int version)
 {
     ar  & BOOST_SERIALIZATION_NVP(m_template_string)
-        & BOOST_SERIALIZATION_NVP(m_stringtable_lookup_flag)
-        & BOOST_SERIALIZATION_NVP(m_variables);
+        & BOOST_SERIALIZATION_NVP(m_stringtable_lookup_flag);
+
+    if (Archive::is_loading::value && version < 1) {
+        std::map<std::string, std::string> variables;
+        ar  & boost::serialization::make_nvp("m_variables", variables);
+        m_variables.clear();
+        m_variables.insert(boost::container::ordered_unique_range, variables.begin(), variables.end());
+
+    } else if (Archive::is_loading::value) {
+        std::vector<std::pair<std::string, std::string>> variables;
+        ar  & boost::serialization::make_nvp("m_variables", variables);
+        m_variables.clear();
+        m_variables.insert(variables.begin(), variables.end());
+
+    } else {
+        std::vector<std::pair<std::string, std::string>> variables(m_variables.begin(), m_variables.end());
+        ar  & boost::serialization::make_nvp("m_variables", variables);
+    }
 }
 
+BOOST_CLASS_VERSION(VarText, 1)
+
 
 #endif
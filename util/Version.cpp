@@ -0,0 +1,16 @@
+#include "Version.h"
+
+//! @file
+//!     Implement a free function to access the application version.
+//!
+//! @warning
+//!     DON'T EDIT MANUALLY Version.cpp.  @e Version.cpp is generated from
+//!     @e Version.cpp.in by the @e cmake/make_versioncpp.py utility script
+//!     that is used or should be used by all build systems.
+
+namespace {
+    static const std::string retval = "v0.4.10+ [build 2026-10-14.10ed4a3] CMake";
+}
+
+const std::string& FreeOrionVersionString()
+{ return retval; }
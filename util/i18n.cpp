@@ -15,6 +15,17 @@ namespace {
     std::recursive_mutex                                       stringtable_access_mutex;
     bool                                                       stringtable_filename_init = false;
 
+    // currently configured and fallback stringtables, looked up once rather
+    // than on every UserString call. reset when either might change.
+    const StringTable*                                         current_stringtable = nullptr;
+    const StringTable*                                         fallback_stringtable = nullptr;
+
+    void ResetCurrentStringTables() {
+        std::scoped_lock<std::recursive_mutex> stringtable_lock(stringtable_access_mutex);
+        current_stringtable = nullptr;
+        fallback_stringtable = nullptr;
+    }
+
     // fallback stringtable to look up key in if entry is not found in currently configured stringtable
     boost::filesystem::path DevDefaultEnglishStringtablePath()
     { return GetResourceDir() / "stringtables/en.txt"; }
@@ -67,6 +78,9 @@ namespace {
     void InitStringtableFileName() {
         stringtable_filename_init = true;
 
+        GetOptionsDB().OptionChangedSignal("resource.stringtable.path").connect(&ResetCurrentStringTables);
+        GetOptionsDB().OptionChangedSignal("resource.path").connect(&ResetCurrentStringTables);
+
         // set option default value based on system locale
         auto default_stringtable_path = GetDefaultStringTableFileName();
         GetOptionsDB().SetDefault("resource.stringtable.path", PathToString(default_stringtable_path));
@@ -162,6 +176,14 @@ namespace {
 
     const StringTable& GetDevDefaultStringTable()
     { return GetStringTable(DevDefaultEnglishStringtablePath()); }
+
+    // sets current_stringtable and fallback_stringtable, if they are not set
+    void InitCurrentStringTables() {
+        if (current_stringtable && fallback_stringtable)
+            return;
+        current_stringtable = &GetStringTable();
+        fallback_stringtable = &GetDevDefaultStringTable();
+    }
 }
 
 std::locale GetLocale(const std::string& name) {
@@ -197,6 +219,7 @@ std::locale GetLocale(const std::string& name) {
 
 void FlushLoadedStringTables() {
     std::scoped_lock<std::recursive_mutex> stringtable_lock(stringtable_access_mutex);
+    ResetCurrentStringTables();
     stringtables.clear();
 }
 
@@ -210,9 +233,10 @@ const std::map<std::string, std::string>& AllStringtableEntries(bool default_tab
 
 const std::string& UserString(const std::string& str) {
     std::scoped_lock<std::recursive_mutex> stringtable_lock(stringtable_access_mutex);
-    if (GetStringTable().StringExists(str))
-        return GetStringTable()[str];
-    return GetDevDefaultStringTable()[str];
+    InitCurrentStringTables();
+    if (auto user_string = current_stringtable->Find(str))
+        return *user_string;
+    return (*fallback_stringtable)[str];
 }
 
 std::vector<std::string> UserStringList(const std::string& key) {
@@ -227,7 +251,8 @@ std::vector<std::string> UserStringList(const std::string& key) {
 
 bool UserStringExists(const std::string& str) {
     std::scoped_lock<std::recursive_mutex> stringtable_lock(stringtable_access_mutex);
-    return GetStringTable().StringExists(str) || GetDevDefaultStringTable().StringExists(str);
+    InitCurrentStringTables();
+    return current_stringtable->StringExists(str) || fallback_stringtable->StringExists(str);
 }
 
 boost::format FlexibleFormat(const std::string &string_to_format) {